@@ -31,6 +31,7 @@
 #include "itkPipeline.h"
 #include "itkInputImage.h"
 #include "itkOutputImage.h"
+#include "itkOutputTransform.h"
 
 // Software Guide : BeginLatex
 //
@@ -94,6 +95,25 @@
 #include "itkResampleImageFilter.h"
 #include "itkCastImageFilter.h"
 
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Gaussian sigma in pixels that anti-aliases shrinking by the factor, as
+// downsampleSigma in the downsample package:
+//
+//   sigma = sqrt((k^2 - 1^2)/(2*sqrt(2*ln(2)))^2)
+//
+static double
+downsampleSigma(unsigned int shrinkFactor)
+{
+  // denominator = (2 * ((2 * math.log(2)) ** 0.5)) ** 2
+  constexpr double denominator = 5.545177444479562;
+  return std::sqrt((shrinkFactor * shrinkFactor - 1) / denominator);
+}
+
 //  The following section of code implements a Command observer
 //  that will monitor the evolution of the registration process.
 //
@@ -156,8 +176,44 @@ main(int argc, char * argv[])
   IOOutputImageType ioOutputImage;
   pipeline.add_option("output-image", ioOutputImage, "Output image")->required()->type_name("OUTPUT_IMAGE");
 
+  using IOOutputTransformType = itk::wasm::OutputTransform<itk::VersorRigid3DTransform<double>>;
+  IOOutputTransformType ioOutputTransform;
+  pipeline.add_option("output-transform", ioOutputTransform, "Output fixed to moving transform")->required()->type_name("OUTPUT_TRANSFORM");
+
+  std::vector<unsigned int> shrinkFactors{ 4, 2, 1 };
+  pipeline.add_option("-s,--shrink-factors", shrinkFactors, "Shrink factor of each registration level, coarsest first")->expected(1, -1);
+
+  std::vector<double> smoothingSigmas;
+  pipeline.add_option("--smoothing-sigmas", smoothingSigmas, "Gaussian smoothing sigma in pixels of each level. Defaults to the anti-alias sigma of the level shrink factor.")->expected(1, -1);
+
+  std::string samplingStrategy = "none";
+  pipeline.add_option("--sampling-strategy", samplingStrategy, "Metric sampling strategy: none, to use every fixed image pixel, regular, or random")->check(CLI::IsMember({"none", "regular", "random"}));
+
+  double samplingPercentage = 1.0;
+  pipeline.add_option("--sampling-percentage", samplingPercentage, "Fraction of the fixed image pixels sampled by the regular or random strategy")->check(CLI::Range(0.0, 1.0));
+
+  int samplingSeed = 121212;
+  pipeline.add_option("--sampling-seed", samplingSeed, "Seed of the random sampling, for reproducible results");
+
+  unsigned int numberOfIterations = 200;
+  pipeline.add_option("-i,--iterations", numberOfIterations, "Maximum number of optimizer iterations of each level");
+
   ITK_WASM_PARSE(pipeline);
 
+  const unsigned int numberOfLevels = shrinkFactors.size();
+  if (!smoothingSigmas.empty() && smoothingSigmas.size() != numberOfLevels)
+  {
+    std::ostringstream ostrm;
+    ostrm << "Expected " << numberOfLevels << " smoothing sigmas, one for each shrink factor, got " << smoothingSigmas.size() << ".\n";
+    CLI::Error err("Runtime error", ostrm.str(), 1);
+    return pipeline.exit(err);
+  }
+  if (samplingStrategy != "none" && samplingPercentage <= 0.0)
+  {
+    CLI::Error err("Runtime error", "The sampling percentage must be greater than 0.\n", 1);
+    return pipeline.exit(err);
+  }
+
   //  Software Guide : BeginLatex
   //
   //  The Transform class is instantiated using the code below. The only
@@ -200,7 +256,7 @@ main(int argc, char * argv[])
   // Software Guide : EndCodeSnippet
 
   registration->SetFixedImage(fixedInputImage.Get());
-  registration->SetMovingImage(fixedInputImage.Get());
+  registration->SetMovingImage(movingInputImage.Get());
 
 
   //  Software Guide : BeginLatex
@@ -320,7 +376,7 @@ main(int argc, char * argv[])
   optimizerScales[4] = translationScale;
   optimizerScales[5] = translationScale;
   optimizer->SetScales(optimizerScales);
-  optimizer->SetNumberOfIterations(200);
+  optimizer->SetNumberOfIterations(numberOfIterations);
   optimizer->SetLearningRate(0.2);
   optimizer->SetMinimumStepLength(0.001);
   optimizer->SetReturnBestParametersAndValue(true);
@@ -330,36 +386,107 @@ main(int argc, char * argv[])
   auto observer = CommandIterationUpdate::New();
   optimizer->AddObserver(itk::IterationEvent(), observer);
 
-  // One level registration process without shrinking and smoothing.
+  // The registration progress is the fraction of the levels done, with the
+  // optimizer iterations of the current level, reported with --progress. An
+  // abort requested by the host stops the optimizer at the next iteration.
   //
-  constexpr unsigned int numberOfLevels = 1;
+  optimizer->AddObserver(itk::IterationEvent(), [&](const itk::EventObject &) {
+    const double levelProgress = std::min(1.0, static_cast<double>(optimizer->GetCurrentIteration() + 1) / std::max(1u, numberOfIterations));
+    registration->UpdateProgress(static_cast<float>((registration->GetCurrentLevel() + levelProgress) / numberOfLevels));
+    if (registration->GetAbortGenerateData())
+    {
+      itk::ProcessAborted aborted(__FILE__, __LINE__);
+      aborted.SetDescription("AbortGenerateData was called during the registration");
+      throw aborted;
+    }
+  });
+  pipeline.observe_progress(registration);
+  pipeline.abort_on_request(registration);
 
+  // Multi-resolution registration process, coarsest level first. Each level
+  // registers images smoothed and shrunk from the full resolution images,
+  // starting from the transform of the previous level.
+  //
   RegistrationType::ShrinkFactorsArrayType shrinkFactorsPerLevel;
-  shrinkFactorsPerLevel.SetSize(1);
-  shrinkFactorsPerLevel[0] = 1;
+  shrinkFactorsPerLevel.SetSize(numberOfLevels);
 
   RegistrationType::SmoothingSigmasArrayType smoothingSigmasPerLevel;
-  smoothingSigmasPerLevel.SetSize(1);
-  smoothingSigmasPerLevel[0] = 0;
+  smoothingSigmasPerLevel.SetSize(numberOfLevels);
+
+  for (unsigned int level = 0; level < numberOfLevels; ++level)
+  {
+    const unsigned int shrinkFactor = std::max(1u, shrinkFactors[level]);
+    shrinkFactorsPerLevel[level] = shrinkFactor;
+    smoothingSigmasPerLevel[level] = smoothingSigmas.empty() ? downsampleSigma(shrinkFactor) : smoothingSigmas[level];
+  }
 
   registration->SetNumberOfLevels(numberOfLevels);
   registration->SetSmoothingSigmasPerLevel(smoothingSigmasPerLevel);
+  registration->SetSmoothingSigmasAreSpecifiedInPhysicalUnits(false);
   registration->SetShrinkFactorsPerLevel(shrinkFactorsPerLevel);
 
-  try
+  // Evaluate the metric on a subset of the fixed image pixels
+  //
+  if (samplingStrategy == "regular")
   {
-    registration->Update();
-    std::cout << "Optimizer stop condition: "
-              << registration->GetOptimizer()->GetStopConditionDescription()
-              << std::endl;
+    registration->SetMetricSamplingStrategy(RegistrationType::MetricSamplingStrategyEnum::REGULAR);
   }
-  catch (const itk::ExceptionObject & err)
+  else if (samplingStrategy == "random")
   {
-    std::cerr << "ExceptionObject caught !" << std::endl;
-    std::cerr << err << std::endl;
-    return EXIT_FAILURE;
+    registration->SetMetricSamplingStrategy(RegistrationType::MetricSamplingStrategyEnum::RANDOM);
+  }
+  if (samplingStrategy != "none")
+  {
+    registration->SetMetricSamplingPercentage(samplingPercentage);
+    registration->MetricSamplingReinitializeSeed(samplingSeed);
   }
 
+  // The moving image resampled onto the fixed image grid with a transform
+  //
+  using ResampleFilterType =
+    itk::ResampleImageFilter<MovingImageType, FixedImageType>;
+  using CastFilterType =
+    itk::CastImageFilter<FixedImageType, OutputImageType>;
+  FixedImageType::ConstPointer fixedImage = fixedInputImage.Get();
+  const auto resampleMovingImage = [&](const TransformType * transform) {
+    auto resampler = ResampleFilterType::New();
+
+    resampler->SetTransform(transform);
+    resampler->SetInput(movingInputImage.Get());
+
+    resampler->SetSize(fixedImage->GetLargestPossibleRegion().GetSize());
+    resampler->SetOutputOrigin(fixedImage->GetOrigin());
+    resampler->SetOutputSpacing(fixedImage->GetSpacing());
+    resampler->SetOutputDirection(fixedImage->GetDirection());
+    resampler->SetDefaultPixelValue(100);
+
+    auto caster = CastFilterType::New();
+
+    caster->SetInput(resampler->GetOutput());
+    caster->Update();
+
+    OutputImageType::Pointer outputImage = caster->GetOutput();
+    return outputImage;
+  };
+
+  // With --progressive, publish the moving image resampled with the result of
+  // each level before the next level starts
+  //
+  if (itk::wasm::Pipeline::get_progressive())
+  {
+    registration->AddObserver(itk::MultiResolutionIterationEvent(), [&](const itk::EventObject &) {
+      if (registration->GetCurrentLevel() > 0)
+      {
+        ioOutputImage.Publish(resampleMovingImage(registration->GetOutput()->Get()));
+      }
+    });
+  }
+
+  ITK_WASM_CATCH_EXCEPTION(pipeline, registration->Update());
+  std::cout << "Optimizer stop condition: "
+            << registration->GetOptimizer()->GetStopConditionDescription()
+            << std::endl;
+
   const TransformType::ParametersType finalParameters =
     registration->GetOutput()->Get()->GetParameters();
 
@@ -369,7 +496,7 @@ main(int argc, char * argv[])
   const double       finalTranslationX = finalParameters[3];
   const double       finalTranslationY = finalParameters[4];
   const double       finalTranslationZ = finalParameters[5];
-  const unsigned int numberOfIterations = optimizer->GetCurrentIteration();
+  const unsigned int iterations = optimizer->GetCurrentIteration();
   const double       bestValue = optimizer->GetValue();
 
   // Print out results
@@ -382,7 +509,7 @@ main(int argc, char * argv[])
   std::cout << " Translation X = " << finalTranslationX << std::endl;
   std::cout << " Translation Y = " << finalTranslationY << std::endl;
   std::cout << " Translation Z = " << finalTranslationZ << std::endl;
-  std::cout << " Iterations    = " << numberOfIterations << std::endl;
+  std::cout << " Iterations    = " << iterations << std::endl;
   std::cout << " Metric value  = " << bestValue << std::endl;
 
   //  Software Guide : BeginLatex
@@ -446,6 +573,7 @@ main(int argc, char * argv[])
   finalTransform->SetFixedParameters(
     registration->GetOutput()->Get()->GetFixedParameters());
   finalTransform->SetParameters(finalParameters);
+  ioOutputTransform.Set(finalTransform);
 
   // Software Guide : BeginCodeSnippet
   TransformType::MatrixType matrix = finalTransform->GetMatrix();
@@ -551,32 +679,7 @@ main(int argc, char * argv[])
   //
   //  Software Guide : EndLatex
 
-  using ResampleFilterType =
-    itk::ResampleImageFilter<MovingImageType, FixedImageType>;
-
-  auto resampler = ResampleFilterType::New();
-
-  resampler->SetTransform(finalTransform);
-  resampler->SetInput(movingInputImage.Get());
-
-  FixedImageType::ConstPointer fixedImage = fixedInputImage.Get();
-
-  resampler->SetSize(fixedImage->GetLargestPossibleRegion().GetSize());
-  resampler->SetOutputOrigin(fixedImage->GetOrigin());
-  resampler->SetOutputSpacing(fixedImage->GetSpacing());
-  resampler->SetOutputDirection(fixedImage->GetDirection());
-  resampler->SetDefaultPixelValue(100);
-
-  using CastFilterType =
-    itk::CastImageFilter<FixedImageType, OutputImageType>;
-
-  auto caster = CastFilterType::New();
-
-  caster->SetInput(resampler->GetOutput());
-  caster->Update();
-
-  OutputImageType::Pointer outputImage = caster->GetOutput();
-  ioOutputImage.Set(outputImage);
+  ioOutputImage.Set(resampleMovingImage(finalTransform));
 
   return EXIT_SUCCESS;
 }
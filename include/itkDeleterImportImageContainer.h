@@ -0,0 +1,95 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkDeleterImportImageContainer_h
+#define itkDeleterImportImageContainer_h
+
+#include "itkImportImageContainer.h"
+
+#include <functional>
+
+namespace itk
+{
+/** \class DeleterImportImageContainer
+ * \brief ImportImageContainer that releases an imported buffer with a custom deleter.
+ *
+ * The container does not manage the imported memory itself. Instead, the
+ * deleter is called once, when the container is destroyed or when a new
+ * buffer is imported. This allows the owner of an externally allocated
+ * buffer, e.g. the memory IO input array store, to hand ownership of the
+ * buffer to an image.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+template <typename TElementIdentifier, typename TElement>
+class ITK_TEMPLATE_EXPORT DeleterImportImageContainer : public ImportImageContainer<TElementIdentifier, TElement>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(DeleterImportImageContainer);
+
+  /** Standard class type aliases. */
+  using Self = DeleterImportImageContainer;
+  using Superclass = ImportImageContainer<TElementIdentifier, TElement>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using ElementIdentifier = TElementIdentifier;
+  using Element = TElement;
+
+  using DeleterType = std::function<void()>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(DeleterImportImageContainer, ImportImageContainer);
+
+  /** Import ptr, which holds num elements. deleter is called when the
+   * buffer is no longer referenced by this container. */
+  void
+  SetImportPointer(TElement * ptr, TElementIdentifier num, DeleterType deleter)
+  {
+    this->ReleaseImportedBuffer();
+    Superclass::SetImportPointer(ptr, num, false);
+    m_Deleter = std::move(deleter);
+  }
+
+protected:
+  DeleterImportImageContainer() = default;
+  ~DeleterImportImageContainer() override
+  {
+    this->ReleaseImportedBuffer();
+  }
+
+  void
+  ReleaseImportedBuffer()
+  {
+    if (m_Deleter)
+    {
+      DeleterType deleter = std::move(m_Deleter);
+      m_Deleter = nullptr;
+      deleter();
+    }
+  }
+
+private:
+  DeleterType m_Deleter;
+};
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,269 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkGrowableStreamBuffer_h
+#define itkGrowableStreamBuffer_h
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <ios>
+#include <memory>
+#include <streambuf>
+
+#include "WebAssemblyInterfaceExport.h"
+
+namespace itk
+{
+namespace wasm
+{
+
+/**
+ *\class GrowableStreamBuffer
+ * \brief Output std::streambuf whose storage grows geometrically and can be
+ * handed to the memory store without a copy
+ *
+ * Unlike a std::stringstream, the written bytes are available in place with
+ * GetData and GetSize, and growth does not zero the new capacity. Reserve
+ * the expected size to avoid reallocation. Seeking within the written bytes
+ * is supported, e.g. for tellp.
+ *
+ * The buffer is also a rapidjson output stream, so JSON writers can target
+ * it directly, without the iostream layer.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT GrowableStreamBuffer : public std::streambuf
+{
+public:
+  /** rapidjson output stream character type. */
+  using Ch = char;
+
+  GrowableStreamBuffer() = default;
+  GrowableStreamBuffer(const GrowableStreamBuffer &) = delete;
+  GrowableStreamBuffer &
+  operator=(const GrowableStreamBuffer &) = delete;
+
+  /** Grow the capacity to at least capacity bytes. */
+  void
+  Reserve(size_t capacity)
+  {
+    if (capacity > m_Capacity)
+    {
+      this->Reallocate(capacity);
+    }
+  }
+
+  const char *
+  GetData() const
+  {
+    return m_Data.get();
+  }
+
+  /** Number of bytes written, including any after a backward seek. */
+  size_t
+  GetSize() const
+  {
+    return std::max(m_Size, this->GetPosition());
+  }
+
+  /** Write a null character after the written bytes, without counting it
+   * in the size, for hosts that read the bytes as a C string. */
+  void
+  Terminate()
+  {
+    const size_t size = this->GetSize();
+    this->Reserve(size + 1);
+    m_Data[size] = '\0';
+  }
+
+  void
+  Append(const char * data, size_t size)
+  {
+    if (static_cast<size_t>(this->epptr() - this->pptr()) < size)
+    {
+      this->Grow(size);
+    }
+    std::memcpy(this->pptr(), data, size);
+    this->Advance(size);
+  }
+
+  /** rapidjson output stream interface. */
+  void
+  Put(Ch character)
+  {
+    if (this->pptr() == this->epptr())
+    {
+      this->Grow(1);
+    }
+    *this->pptr() = character;
+    this->pbump(1);
+  }
+
+  void
+  Flush()
+  {}
+
+protected:
+  int_type
+  overflow(int_type character) override
+  {
+    if (traits_type::eq_int_type(character, traits_type::eof()))
+    {
+      return traits_type::not_eof(character);
+    }
+    this->Put(traits_type::to_char_type(character));
+    return character;
+  }
+
+  std::streamsize
+  xsputn(const char * data, std::streamsize size) override
+  {
+    this->Append(data, static_cast<size_t>(size));
+    return size;
+  }
+
+  pos_type
+  seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override
+  {
+    if (!(which & std::ios_base::out))
+    {
+      return pos_type(off_type(-1));
+    }
+    const size_t size = this->GetSize();
+    off_type base = 0;
+    if (direction == std::ios_base::cur)
+    {
+      base = static_cast<off_type>(this->GetPosition());
+    }
+    else if (direction == std::ios_base::end)
+    {
+      base = static_cast<off_type>(size);
+    }
+    const off_type position = base + offset;
+    if (position < 0 || static_cast<size_t>(position) > size)
+    {
+      return pos_type(off_type(-1));
+    }
+    m_Size = size;
+    this->SetPosition(static_cast<size_t>(position));
+    return pos_type(position);
+  }
+
+  pos_type
+  seekpos(pos_type position, std::ios_base::openmode which) override
+  {
+    return this->seekoff(off_type(position), std::ios_base::beg, which);
+  }
+
+private:
+  size_t
+  GetPosition() const
+  {
+    return static_cast<size_t>(this->pptr() - this->pbase());
+  }
+
+  // pbump takes an int
+  void
+  Advance(size_t size)
+  {
+    while (size > 0)
+    {
+      const int step = static_cast<int>(std::min<size_t>(size, INT_MAX));
+      this->pbump(step);
+      size -= static_cast<size_t>(step);
+    }
+  }
+
+  void
+  SetPosition(size_t position)
+  {
+    this->setp(m_Data.get(), m_Data.get() + m_Capacity);
+    this->Advance(position);
+  }
+
+  void
+  Grow(size_t extra)
+  {
+    this->Reallocate(std::max({ m_Capacity * 2, this->GetPosition() + extra, MinimumCapacity }));
+  }
+
+  void
+  Reallocate(size_t capacity)
+  {
+    const size_t position = this->GetPosition();
+    const size_t size = this->GetSize();
+    std::unique_ptr<char[]> data(new char[capacity]);
+    if (size > 0)
+    {
+      std::memcpy(data.get(), m_Data.get(), size);
+    }
+    m_Data = std::move(data);
+    m_Capacity = capacity;
+    m_Size = size;
+    this->SetPosition(position);
+  }
+
+  static constexpr size_t MinimumCapacity = 256;
+
+  std::unique_ptr<char[]> m_Data;
+  size_t m_Capacity{ 0 };
+  // Bytes written before the last seek or reallocation
+  size_t m_Size{ 0 };
+};
+
+/**
+ *\class StreamBufferJSONOutput
+ * \brief rapidjson output stream over any std::streambuf
+ *
+ * Characters go straight to the buffer with sputc, e.g. to the `rdbuf()`
+ * of a pipeline output stream, without the sentry of each
+ * std::ostream::put of rapidjson::OStreamWrapper or a
+ * rapidjson::StringBuffer copy.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class StreamBufferJSONOutput
+{
+public:
+  using Ch = char;
+
+  explicit StreamBufferJSONOutput(std::streambuf * buffer)
+    : m_Buffer(buffer)
+  {}
+
+  void
+  Put(Ch character)
+  {
+    m_Buffer->sputc(character);
+  }
+
+  void
+  Flush()
+  {
+    m_Buffer->pubsync();
+  }
+
+private:
+  std::streambuf * m_Buffer;
+};
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -20,6 +20,8 @@
 
 #include "itkProcessObject.h"
 #include "itkWasmImage.h"
+#include "itkWasmIntensityStatistics.h"
+#include "itkWasmMetaDataKeyFilter.h"
 
 namespace itk
 {
@@ -51,6 +53,7 @@ public:
   using DataObjectPointerArraySizeType = Superclass::DataObjectPointerArraySizeType;
 
   using ImageType = TImage;
+  using RegionType = typename ImageType::RegionType;
   using WasmImageType = WasmImage<ImageType>;
 
   /** Set/Get the path input of this process object.  */
@@ -75,6 +78,74 @@ public:
   WasmImageType *
   GetOutput(unsigned int idx);
 
+  /** Populate the output's fixed-layout binary descriptor instead of the JSON
+   * representation. Default: false. */
+  itkSetMacro(UseDescriptor, bool);
+  itkGetConstMacro(UseDescriptor, bool);
+  itkBooleanMacro(UseDescriptor);
+
+  /** Encode the descriptor metadata as a CBOR map, see
+   * wasm::WriteCBORMetaDataDictionary, instead of JSON text. Only used with
+   * UseDescriptor. Default: false. */
+  itkSetMacro(UseCBORMetaData, bool);
+  itkGetConstMacro(UseCBORMetaData, bool);
+  itkBooleanMacro(UseCBORMetaData);
+
+  /** Serialize the input image MetaDataDictionary. When disabled, the output
+   * has an empty metadata array. Default: true. */
+  itkSetMacro(ConvertMetaData, bool);
+  itkGetConstMacro(ConvertMetaData, bool);
+  itkBooleanMacro(ConvertMetaData);
+
+  /** Store the output pixel data with each component in its own plane,
+   * channel-first, instead of interleaved. The image of the output is then
+   * a planar copy of the input, transposed across threads; images with one
+   * component are not copied. Default: false. */
+  itkSetMacro(PlanarLayout, bool);
+  itkGetConstMacro(PlanarLayout, bool);
+  itkBooleanMacro(PlanarLayout);
+
+  /** Store the minimum, maximum, mean and histogram of each component in the
+   * intensityStatistics entry of the JSON representation, see
+   * wasm::ComputeIntensityStatistics, so viewers can set the window and
+   * level without another pass over the pixel data. Not used with
+   * UseDescriptor. Default: false. */
+  itkSetMacro(ComputeIntensityStatistics, bool);
+  itkGetConstMacro(ComputeIntensityStatistics, bool);
+  itkBooleanMacro(ComputeIntensityStatistics);
+
+  /** Number of bins of the histograms of the intensity statistics.
+   * Default: 64. */
+  itkSetMacro(IntensityHistogramBins, unsigned int);
+  itkGetConstMacro(IntensityHistogramBins, unsigned int);
+
+  /** Region of the input image that is output, inside its buffered region.
+   * Default: an empty region, for the buffered region. */
+  itkSetMacro(OutputRegion, RegionType);
+  itkGetConstReferenceMacro(OutputRegion, RegionType);
+
+  /** Output an OutputRegion smaller than the buffered region as a view of
+   * the input buffer, with the `strides` entry of the JSON representation,
+   * see wasm::ImageStridesType, instead of a contiguous copy. The intensity
+   * statistics are not computed for views. Not used with UseDescriptor or
+   * the PlanarLayout of multi-component images, which copy the region.
+   * Default: false. */
+  itkSetMacro(UseStrides, bool);
+  itkGetConstMacro(UseStrides, bool);
+  itkBooleanMacro(UseStrides);
+
+  /** Metadata keys of the input image that are serialized. Default: every
+   * key. */
+  void SetMetaDataKeyFilter(const wasm::MetaDataKeyFilter & keyFilter)
+  {
+    this->m_MetaDataKeyFilter = keyFilter;
+    this->Modified();
+  }
+  const wasm::MetaDataKeyFilter & GetMetaDataKeyFilter() const
+  {
+    return this->m_MetaDataKeyFilter;
+  }
+
 protected:
   ImageToWasmImageFilter();
   ~ImageToWasmImageFilter() override = default;
@@ -92,6 +163,16 @@ protected:
 
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+  bool m_UseDescriptor{false};
+  bool m_UseCBORMetaData{false};
+  bool m_ConvertMetaData{true};
+  bool m_PlanarLayout{false};
+  bool m_ComputeIntensityStatistics{false};
+  unsigned int m_IntensityHistogramBins{wasm::DefaultIntensityHistogramBins};
+  RegionType m_OutputRegion;
+  bool m_UseStrides{false};
+  wasm::MetaDataKeyFilter m_MetaDataKeyFilter;
 };
 } // end namespace itk
 
@@ -21,10 +21,17 @@
 #include "itkImageToWasmImageFilter.h"
 
 #include "itkDefaultConvertPixelTraits.h"
+#include "itkImageIOBase.h"
 #include "itkMetaDataDictionaryJSON.h"
+#include "itkMetaDataDictionaryCBOR.h"
 
+#include "itkWasmIntensityStatistics.h"
 #include "itkWasmMapComponentType.h"
 #include "itkWasmMapPixelType.h"
+#include "itkWasmJSONWriter.h"
+#include "itkWasmPlanarLayout.h"
+#include "itkWasmStridedView.h"
+#include "itkWasmTrace.h"
 
 #include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
@@ -131,93 +138,239 @@ void
 ImageToWasmImageFilter<TImage>
 ::GenerateData()
 {
+  ITK_WASM_TRACE_SCOPE("ImageToWasmImageFilter::GenerateData");
+
   // Get the input and output pointers
   const ImageType * image = this->GetInput();
   WasmImageType * imageJSON = this->GetOutput();
 
-  imageJSON->SetImage(image);
-
   using PointType = typename TImage::PointType;
   using PixelType = typename TImage::IOPixelType;
   using ConvertPixelTraits = DefaultConvertPixelTraits<PixelType>;
   using ComponentType = typename ConvertPixelTraits::ComponentType;
 
-  rapidjson::Document document;
-  document.SetObject();
-  rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
-
-  rapidjson::Value imageType;
-  imageType.SetObject();
+  const unsigned int numberOfComponents = image->GetNumberOfComponentsPerPixel();
 
-  const unsigned int dimension = image->GetImageDimension();
-  imageType.AddMember("dimension", rapidjson::Value(dimension).Move(), allocator );
+  // A sub-region of the buffer is output as a strided view or a copy
+  const RegionType bufferedRegion = image->GetBufferedRegion();
+  bool stridedView = false;
+  typename ImageType::Pointer regionImage;
+  if (this->m_OutputRegion.GetNumberOfPixels() > 0 && this->m_OutputRegion != bufferedRegion)
+  {
+    if (!bufferedRegion.IsInside(this->m_OutputRegion))
+    {
+      itkExceptionMacro("The output region " << this->m_OutputRegion << " is not inside the buffered region "
+                                             << bufferedRegion);
+    }
+    if (this->m_UseStrides && !this->m_UseDescriptor && !(this->m_PlanarLayout && numberOfComponents > 1))
+    {
+      stridedView = true;
+    }
+    else
+    {
+      regionImage = wasm::CopyImageRegion(image, this->m_OutputRegion);
+      image = regionImage.GetPointer();
+    }
+  }
 
-  rapidjson::Value componentType;
-  componentType.SetString( wasm::MapComponentType<ComponentType>::ComponentString.data(), allocator );
-  imageType.AddMember("componentType", componentType.Move(), allocator );
+  wasm::IntensityStatistics intensityStatistics;
+  if (this->m_ComputeIntensityStatistics && !this->m_UseDescriptor && !stridedView)
+  {
+    // Of the interleaved input components
+    intensityStatistics = wasm::ComputeIntensityStatistics(ImageIOBase::MapPixelType<ComponentType>::CType,
+                                                           image->GetBufferPointer(),
+                                                           numberOfComponents,
+                                                           image->GetBufferedRegion().GetNumberOfPixels(),
+                                                           this->m_IntensityHistogramBins,
+                                                           this->GetMultiThreader());
+  }
 
-  rapidjson::Value pixelType;
-  pixelType.SetString( wasm::MapPixelType<PixelType>::PixelString.data(), allocator );
-  imageType.AddMember("pixelType", pixelType.Move(), allocator );
+  if (this->m_PlanarLayout && numberOfComponents > 1)
+  {
+    // The output image buffer holds the planar pixel data
+    auto planarImage = ImageType::New();
+    planarImage->CopyInformation(image);
+    planarImage->SetBufferedRegion(image->GetBufferedRegion());
+    planarImage->SetNumberOfComponentsPerPixel(numberOfComponents);
+    planarImage->Allocate();
+    planarImage->SetMetaDataDictionary(image->GetMetaDataDictionary());
+    wasm::PlanarizeComponents(reinterpret_cast<const ComponentType *>(image->GetBufferPointer()),
+                              static_cast<SizeValueType>(image->GetBufferedRegion().GetNumberOfPixels()),
+                              numberOfComponents,
+                              reinterpret_cast<ComponentType *>(planarImage->GetBufferPointer()),
+                              this->GetMultiThreader(),
+                              this);
+    imageJSON->SetImage(planarImage);
+    image = planarImage.GetPointer();
+  }
+  else
+  {
+    imageJSON->SetImage(image);
+  }
 
-  imageType.AddMember("components", rapidjson::Value( ConvertPixelTraits::GetNumberOfComponents() ).Move(), allocator );
+  if (this->m_UseDescriptor)
+  {
+    wasm::WasmImageDescriptor descriptor;
+    const unsigned int dimension = image->GetImageDimension();
+    if (dimension > wasm::WasmImageDescriptorMaximumDimension)
+    {
+      itkExceptionMacro("Image dimension exceeds the maximum image descriptor dimension");
+    }
+    descriptor.dimension = dimension;
+    descriptor.components = ConvertPixelTraits::GetNumberOfComponents();
+    wasm::SetWasmImageDescriptorString(descriptor.componentType, wasm::MapComponentType<ComponentType>::ComponentString);
+    wasm::SetWasmImageDescriptorString(descriptor.pixelType, wasm::MapPixelType<PixelType>::PixelString);
+
+    const auto largestRegion = image->GetLargestPossibleRegion();
+    PointType imageOrigin;
+    image->TransformIndexToPhysicalPoint(largestRegion.GetIndex(), imageOrigin);
+    const auto imageSpacing = image->GetSpacing();
+    const auto imageSize = image->GetBufferedRegion().GetSize();
+    for( unsigned int ii = 0; ii < dimension; ++ii )
+      {
+      descriptor.origin[ii] = imageOrigin[ii];
+      descriptor.spacing[ii] = imageSpacing[ii];
+      descriptor.size[ii] = imageSize[ii];
+      }
+
+    descriptor.direction = reinterpret_cast< size_t >( image->GetDirection().GetVnlMatrix().begin() );
+    descriptor.data = reinterpret_cast< size_t >( image->GetBufferPointer() );
+    descriptor.dataSize = image->GetPixelContainer()->Size() * sizeof(ComponentType) * ConvertPixelTraits::GetNumberOfComponents();
+    imageJSON->SetDescriptor(descriptor);
+
+    const auto & dictionary = image->GetMetaDataDictionary();
+    if (this->m_ConvertMetaData && dictionary.Begin() != dictionary.End())
+    {
+      if (this->m_UseCBORMetaData)
+      {
+        std::string metadata;
+        wasm::MemoryCBORSink metadataSink(metadata);
+        wasm::WriteCBORMetaDataDictionary(metadataSink, dictionary, this->m_MetaDataKeyFilter);
+        imageJSON->SetDescriptorMetadata(metadata);
+      }
+      else
+      {
+        rapidjson::Document metadataDocument;
+        metadataDocument.SetArray();
+        wasm::ConvertMetaDataDictionaryToJSON(dictionary, metadataDocument, metadataDocument.GetAllocator(), this->m_MetaDataKeyFilter);
+        rapidjson::StringBuffer metadataBuffer;
+        rapidjson::Writer<rapidjson::StringBuffer> metadataWriter(metadataBuffer);
+        metadataDocument.Accept(metadataWriter);
+        imageJSON->SetDescriptorMetadata(std::string(metadataBuffer.GetString(), metadataBuffer.GetSize()));
+      }
+    }
+    return;
+  }
 
-  document.AddMember( "imageType", imageType.Move(), allocator );
+  rapidjson::StringBuffer & stringBuffer = wasm::GetWasmJSONStringBuffer();
+  wasm::WasmJSONWriterType writer(stringBuffer);
+  writer.StartObject();
 
-  rapidjson::Value origin(rapidjson::kArrayType);
+  writer.Key("imageType");
+  writer.StartObject();
+  const unsigned int dimension = image->GetImageDimension();
+  writer.Key("dimension");
+  writer.Uint(dimension);
+  writer.Key("componentType");
+  wasm::WriteWasmJSONString(writer, wasm::MapComponentType<ComponentType>::ComponentString);
+  writer.Key("pixelType");
+  wasm::WriteWasmJSONString(writer, wasm::MapPixelType<PixelType>::PixelString);
+  writer.Key("components");
+  writer.Uint(ConvertPixelTraits::GetNumberOfComponents());
+  writer.EndObject();
+
+  if (!intensityStatistics.IsEmpty())
+  {
+    rapidjson::Document statisticsDocument;
+    wasm::ConvertIntensityStatisticsToJSON(intensityStatistics, statisticsDocument, statisticsDocument.GetAllocator());
+    writer.Key("intensityStatistics");
+    statisticsDocument.Accept(writer);
+  }
 
   const auto largestRegion = image->GetLargestPossibleRegion();
   PointType imageOrigin;
-  image->TransformIndexToPhysicalPoint(largestRegion.GetIndex(), imageOrigin);
+  image->TransformIndexToPhysicalPoint(stridedView ? this->m_OutputRegion.GetIndex() : largestRegion.GetIndex(), imageOrigin);
+  writer.Key("origin");
+  writer.StartArray();
   for( unsigned int ii = 0; ii < dimension; ++ii )
     {
-    origin.PushBack(rapidjson::Value().SetDouble(imageOrigin[ii]), allocator);
+    writer.Double(imageOrigin[ii]);
     }
-  document.AddMember( "origin", origin.Move(), allocator );
+  writer.EndArray();
 
-  rapidjson::Value spacing(rapidjson::kArrayType);
   const auto imageSpacing = image->GetSpacing();
+  writer.Key("spacing");
+  writer.StartArray();
   for( unsigned int ii = 0; ii < dimension; ++ii )
     {
-    spacing.PushBack(rapidjson::Value().SetDouble(imageSpacing[ii]), allocator);
+    writer.Double(imageSpacing[ii]);
     }
-  document.AddMember( "spacing", spacing.Move(), allocator );
-
-  const auto direction = reinterpret_cast< size_t >( image->GetDirection().GetVnlMatrix().begin() );
-  std::ostringstream directionStream;
-  directionStream << "data:application/vnd.itk.address,0:";
-  directionStream << direction;
-  rapidjson::Value directionString;
-  directionString.SetString( directionStream.str().c_str(), allocator );
-  document.AddMember( "direction", directionString.Move(), allocator );
-
-  rapidjson::Value size(rapidjson::kArrayType);
-  const auto imageSize = image->GetBufferedRegion().GetSize();
+  writer.EndArray();
+
+  writer.Key("direction");
+  wasm::WriteWasmJSONAddress(writer, reinterpret_cast< size_t >( image->GetDirection().GetVnlMatrix().begin() ));
+
+  const auto imageSize = stridedView ? this->m_OutputRegion.GetSize() : image->GetBufferedRegion().GetSize();
+  writer.Key("size");
+  writer.StartArray();
   for( unsigned int ii = 0; ii < dimension; ++ii )
     {
-    size.PushBack(rapidjson::Value().SetInt(imageSize[ii]), allocator);
+    writer.Uint64(static_cast< uint64_t >( imageSize[ii] ));
     }
+  writer.EndArray();
 
-  document.AddMember( "size", size.Move(), allocator );
-
-  const auto data = reinterpret_cast< size_t >( image->GetBufferPointer() );
-  std::ostringstream dataStream;
-  dataStream << "data:application/vnd.itk.address,0:";
-  dataStream << data;
-  rapidjson::Value dataString;
-  dataString.SetString( dataStream.str().c_str(), allocator );
-  document.AddMember( "data", dataString.Move(), allocator );
+  writer.Key("data");
+  if (stridedView)
+  {
+    // The view starts at the first pixel of the region, and its rows are
+    // those of the buffer
+    std::vector<uint64_t> viewSize(dimension);
+    wasm::ImageStridesType strides(dimension);
+    const OffsetValueType * offsetTable = image->GetOffsetTable();
+    for (unsigned int ii = 0; ii < dimension; ++ii)
+    {
+      viewSize[ii] = static_cast<uint64_t>(imageSize[ii]);
+      strides[ii] = static_cast<uint64_t>(offsetTable[ii]) * numberOfComponents;
+    }
+    const auto * viewData = reinterpret_cast<const ComponentType *>(image->GetBufferPointer()) +
+                            image->ComputeOffset(this->m_OutputRegion.GetIndex()) * numberOfComponents;
+    const size_t viewAddress = reinterpret_cast<size_t>(viewData);
+    wasm::WriteWasmJSONAddress(writer, viewAddress);
+    imageJSON->SetDataView(viewAddress,
+                           wasm::StridedViewSpan(viewSize, strides, numberOfComponents) * sizeof(ComponentType));
+
+    writer.Key("strides");
+    writer.StartArray();
+    for (unsigned int ii = 0; ii < dimension; ++ii)
+    {
+      writer.Uint64(strides[ii]);
+    }
+    writer.EndArray();
+  }
+  else
+  {
+    wasm::WriteWasmJSONAddress(writer, reinterpret_cast< size_t >( image->GetBufferPointer() ));
+  }
 
-  auto dictionary = image->GetMetaDataDictionary();
-  rapidjson::Value metadataJson(rapidjson::kArrayType);
-  wasm::ConvertMetaDataDictionaryToJSON(dictionary, metadataJson, allocator);
-  document.AddMember( "metadata", metadataJson.Move(), allocator );
+  writer.Key("metadata");
+  const auto & dictionary = image->GetMetaDataDictionary();
+  if (this->m_ConvertMetaData && dictionary.Begin() != dictionary.End())
+  {
+    // Metadata entries are converted through a DOM
+    rapidjson::Document metadataDocument;
+    metadataDocument.SetArray();
+    wasm::ConvertMetaDataDictionaryToJSON(dictionary, metadataDocument, metadataDocument.GetAllocator(), this->m_MetaDataKeyFilter);
+    metadataDocument.Accept(writer);
+  }
+  else
+  {
+    writer.StartArray();
+    writer.EndArray();
+  }
 
-  rapidjson::StringBuffer stringBuffer;
-  rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
-  document.Accept(writer);
+  writer.EndObject();
 
-  imageJSON->SetJSON(stringBuffer.GetString());
+  imageJSON->SetJSON(std::string(stringBuffer.GetString(), stringBuffer.GetSize()));
 }
 
 template <typename TImage>
@@ -226,6 +379,14 @@ ImageToWasmImageFilter<TImage>
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "UseDescriptor: " << (m_UseDescriptor ? "On" : "Off") << std::endl;
+  os << indent << "UseCBORMetaData: " << (m_UseCBORMetaData ? "On" : "Off") << std::endl;
+  os << indent << "ConvertMetaData: " << (m_ConvertMetaData ? "On" : "Off") << std::endl;
+  os << indent << "PlanarLayout: " << (m_PlanarLayout ? "On" : "Off") << std::endl;
+  os << indent << "ComputeIntensityStatistics: " << (m_ComputeIntensityStatistics ? "On" : "Off") << std::endl;
+  os << indent << "IntensityHistogramBins: " << m_IntensityHistogramBins << std::endl;
+  os << indent << "OutputRegion: " << m_OutputRegion << std::endl;
+  os << indent << "UseStrides: " << (m_UseStrides ? "On" : "Off") << std::endl;
 }
 } // end namespace itk
 
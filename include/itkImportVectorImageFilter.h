@@ -19,6 +19,7 @@
 #define itkImportVectorImageFilter_h
 
 #include "itkImageSource.h"
+#include "itkDeleterImportImageContainer.h"
 
 namespace itk
 {
@@ -36,6 +37,7 @@ namespace itk
  * - It can be used on a itk::VectorImage in addition to itk::Image
  * - It is templated over the output image type
  * - The NumberOfComponentsPerPixel can be set
+ * - Planar (channel-first) buffers can be imported, see SetPlanarLayout
  *
  * \ingroup IOFilters
  * \ingroup WebAssemblyInterface
@@ -53,6 +55,8 @@ public:
   using SpacingType = typename OutputImageType::SpacingType;
   using OriginType = typename OutputImageType::PointType;
   using ImportImageContainerType = ImportImageContainer<SizeValueType, typename OutputImageType::InternalPixelType>;
+  using DeleterImportImageContainerType = DeleterImportImageContainer<SizeValueType, typename OutputImageType::InternalPixelType>;
+  using ImportPointerDeleterType = typename DeleterImportImageContainerType::DeleterType;
 
   /** Standard class type aliases. */
   using Self = ImportVectorImageFilter;
@@ -98,6 +102,15 @@ public:
    bool letImageContainerManageMemory,
    unsigned int vectorImageComponents = 1);
 
+  /** Set the pointer from which the image data is imported and transfer
+   * ownership of the buffer to the output image's pixel container. "deleter"
+   * is called when the pixel container releases the buffer. */
+  void
+  SetImportPointer(OutputImageInternalPixelType * ptr,
+   SizeValueType num,
+   ImportPointerDeleterType deleter,
+   unsigned int vectorImageComponents = 1);
+
   /** Set the region object that defines the size and starting index
    * for the imported image. This will serve as the LargestPossibleRegion,
    * the BufferedRegion, and the RequestedRegion.
@@ -145,6 +158,14 @@ public:
    * \sa SetDirection */
   itkGetConstReferenceMacro(Direction, DirectionType);
 
+  /** Whether the imported buffer stores each component of the pixels in its
+   * own plane, channel-first, instead of interleaved. The output is always
+   * interleaved: a planar buffer is transposed into a new pixel container,
+   * split across threads, instead of being adopted. Default: false. */
+  itkSetMacro(PlanarLayout, bool);
+  itkGetConstMacro(PlanarLayout, bool);
+  itkBooleanMacro(PlanarLayout);
+
 protected:
   ImportVectorImageFilter();
   ~ImportVectorImageFilter() override;
@@ -181,6 +202,7 @@ private:
   typename ImportImageContainerType::Pointer m_ImportImageContainer;
   SizeValueType                              m_Size{0};
   unsigned int                               m_VectorImageComponentsPerPixel{1};
+  bool                                       m_PlanarLayout{false};
 };
 
 } // end namespace itk
@@ -21,6 +21,8 @@
 #include "itkImportVectorImageFilter.h"
 #include "itkObjectFactory.h"
 #include "itkMath.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkWasmPlanarLayout.h"
 
 namespace itk
 {
@@ -80,6 +82,7 @@ ImportVectorImageFilter<TOutputImage>::PrintSelf(std::ostream & os, Indent inden
   }
   os << m_Origin[i] << "]" << std::endl;
   os << indent << "Direction: " << std::endl << this->GetDirection() << std::endl;
+  os << indent << "PlanarLayout: " << (m_PlanarLayout ? "On" : "Off") << std::endl;
 }
 
 template <typename TOutputImage>
@@ -99,6 +102,21 @@ ImportVectorImageFilter<TOutputImage>::SetImportPointer(OutputImageInternalPixel
   }
 }
 
+template <typename TOutputImage>
+void
+ImportVectorImageFilter<TOutputImage>::SetImportPointer(OutputImageInternalPixelType *  ptr,
+                                                        SizeValueType num,
+                                                        ImportPointerDeleterType deleter,
+                                                        unsigned int  vectorImageComponents)
+{
+  m_Size = num;
+  m_VectorImageComponentsPerPixel = vectorImageComponents;
+  auto container = DeleterImportImageContainerType::New();
+  container->SetImportPointer(ptr, m_Size*vectorImageComponents, std::move(deleter));
+  m_ImportImageContainer = container.GetPointer();
+  this->Modified();
+}
+
 template <typename TOutputImage>
 auto
 ImportVectorImageFilter<TOutputImage>::GetImportPointer() -> OutputImageInternalPixelType *
@@ -150,7 +168,8 @@ ImportVectorImageFilter<TOutputImage>::GenerateData()
 {
   // Normally, GenerateData() allocates memory.  However, the application
   // provides the memory for this filter via the SetImportPointer() method.
-  // Therefore, this filter does not call outputPtr->Allocate().
+  // Therefore, this filter does not call outputPtr->Allocate(), unless a
+  // planar buffer is interleaved.
 
   // get pointer to the output
   OutputImagePointer outputPtr = this->GetOutput();
@@ -159,6 +178,23 @@ ImportVectorImageFilter<TOutputImage>::GenerateData()
   // SetRegion() method.
   outputPtr->SetBufferedRegion(outputPtr->GetLargestPossibleRegion());
 
+  using InternalPixelTraits = DefaultConvertPixelTraits<OutputImageInternalPixelType>;
+  using ComponentType = typename InternalPixelTraits::ComponentType;
+  const unsigned int components = m_VectorImageComponentsPerPixel * InternalPixelTraits::GetNumberOfComponents();
+  if (m_PlanarLayout && components > 1 && m_Size > 0)
+  {
+    auto interleavedContainer = ImportImageContainerType::New();
+    interleavedContainer->Reserve(m_Size * m_VectorImageComponentsPerPixel);
+    wasm::InterleaveComponents(reinterpret_cast<const ComponentType *>(m_ImportImageContainer->GetImportPointer()),
+                               m_Size,
+                               components,
+                               reinterpret_cast<ComponentType *>(interleavedContainer->GetImportPointer()),
+                               this->GetMultiThreader(),
+                               this);
+    outputPtr->SetPixelContainer(interleavedContainer);
+    return;
+  }
+
   // pass the pointer down to the container during each Update() since
   // a call to Initialize() causes the container to forget the
   // pointer.  Note that we tell the container NOT to manage the
@@ -19,9 +19,12 @@
 #define itkInputBinaryStream_h
 
 #include "itkPipeline.h"
-#include "itkWasmStringStream.h"
+#include "itkMemoryStreamBuffer.h"
 
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <string_view>
 #ifndef ITK_WASM_NO_MEMORY_IO
 #include <sstream>
 #endif
@@ -42,6 +45,10 @@ namespace wasm
  *
  * This stream is read from the filesystem or memory when ITK_WASM_PARSE_ARGS is called.
  *
+ * With memory IO, the stream reads the input array of the memory store in
+ * place, without a copy. `GetData()` and `GetSize()` give direct access to
+ * those bytes, e.g. for decoders with their own memory buffer input.
+ *
  * Call `Get()` to get the std::istream & to use an input to a pipeline.
  *
  * \ingroup WebAssemblyInterface
@@ -53,19 +60,22 @@ public:
     return *m_IStream;
   }
 
-  void SetJSON(const std::string & json)
-  {
-    if (m_DeleteIStream && m_IStream != nullptr)
-    {
-      delete m_IStream;
-    }
-    m_DeleteIStream = false;
-    m_WasmStringStream = WasmStringStream::New();
-    m_WasmStringStream->SetJSON(json.c_str());
+  /** Bytes of a memory IO input, or nullptr when read from a file. */
+  const char * GetData() const {
+    return m_Data;
+  }
 
-    m_IStream = &(m_WasmStringStream->GetStringStream());
+  size_t GetSize() const {
+    return m_Size;
   }
 
+  /** The bytes of a memory IO input as a view, empty when read from a file. */
+  std::string_view GetView() const {
+    return std::string_view(m_Data, m_Size);
+  }
+
+  void SetJSON(const std::string & json);
+
   void SetFileName(const std::string & fileName)
   {
     if (m_DeleteIStream && m_IStream != nullptr)
@@ -74,6 +84,8 @@ public:
     }
     m_IStream = new std::ifstream(fileName, std::ifstream::in | std::ifstream::binary);
     m_DeleteIStream = true;
+    m_Data = nullptr;
+    m_Size = 0;
   }
 
   InputBinaryStream() = default;
@@ -88,7 +100,9 @@ protected:
   std::istream * m_IStream{nullptr};
   bool m_DeleteIStream{false};
 
-  WasmStringStream::Pointer m_WasmStringStream;
+  const char * m_Data{nullptr};
+  size_t m_Size{0};
+  std::unique_ptr<MemoryStreamBuffer> m_StreamBuffer;
 };
 
 
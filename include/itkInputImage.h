@@ -19,6 +19,17 @@
 #define itkInputImage_h
 
 #include "itkPipeline.h"
+#include "itkPipelineStageStore.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkExtractImageFilter.h"
+#include "itkWasmMapComponentType.h"
+#include "itkWasmMapPixelType.h"
+#include "itkWasmMetaDataKeyFilter.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
 
 #ifndef ITK_WASM_NO_MEMORY_IO
 #include "itkWasmExports.h"
@@ -27,6 +38,7 @@
 #endif
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
 #include "itkImageFileReader.h"
+#include "itkWasmLazyIOFactory.h"
 #endif
 
 namespace itk
@@ -51,20 +63,117 @@ public:
   using ImageType = TImage;
 
   void Set(const ImageType * image) {
-    this->m_Image = image;
+    this->m_Image = std::make_shared<typename TImage::ConstPointer>(image);
   }
 
   const ImageType * Get() const {
-    return this->m_Image.GetPointer();
+    return this->m_Image ? this->m_Image->GetPointer() : nullptr;
+  }
+
+  /** Image set by a read deferred with Pipeline::read_input once the
+   * command line is parsed. Copies of the InputImage, e.g. CLI11's
+   * std::vector elements, share it. */
+  std::shared_ptr<typename TImage::ConstPointer> DeferSet() {
+    this->m_Image = std::make_shared<typename TImage::ConstPointer>();
+    return this->m_Image;
+  }
+
+  /** Decode the metadata of a memory IO input into the image
+   * MetaDataDictionary. Disable before the command line is parsed to skip
+   * decoding metadata the pipeline does not use. Default: true. */
+  void SetConvertMetaData(bool convertMetaData) {
+    this->m_ConvertMetaData = convertMetaData;
+  }
+
+  bool GetConvertMetaData() const {
+    return this->m_ConvertMetaData;
+  }
+
+  /** Metadata keys of the input that are kept in the image
+   * MetaDataDictionary. Set before the command line is parsed. Default: the
+   * Pipeline --metadata-include and --metadata-exclude patterns. */
+  void SetMetaDataKeyFilter(const MetaDataKeyFilter & keyFilter) {
+    this->m_MetaDataKeyFilter = keyFilter;
+  }
+
+  const MetaDataKeyFilter & GetMetaDataKeyFilter() const {
+    return this->m_MetaDataKeyFilter ? *this->m_MetaDataKeyFilter : Pipeline::get_metadata_key_filter();
+  }
+
+  using RegionType = typename TImage::RegionType;
+
+  /** Import only this region of the input. The image has a zero index and
+   * the origin of the region. Memory IO inputs copy the region from the
+   * input array, and file inputs read it with ImageIO streaming when the
+   * ImageIO supports it. Set before the command line is parsed, or with
+   * AddInputRegionOption. Default: the whole image. */
+  void SetRegion(const RegionType & region) {
+    this->m_Region = region;
+  }
+
+  const std::optional<RegionType> & GetRegion() const {
+    return this->m_Region;
   }
 
   InputImage() = default;
   ~InputImage() = default;
 protected:
-  typename TImage::ConstPointer m_Image;
+  std::shared_ptr<typename TImage::ConstPointer> m_Image;
+  bool m_ConvertMetaData{true};
+  std::optional<MetaDataKeyFilter> m_MetaDataKeyFilter;
+  std::optional<RegionType> m_Region;
 };
 
 
+/** Add an option for the region of an InputImage to import, its index
+ * followed by its size, e.g. `--input-region 10 20 64 64` in 2D. */
+template <typename TImage>
+Option * AddInputRegionOption(Pipeline & pipeline, const std::string & name, InputImage<TImage> & inputImage, const std::string & description)
+{
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+  auto option = pipeline.add_option_function<std::vector<int64_t>>(name,
+    [name, &inputImage](const std::vector<int64_t> & values) {
+      typename InputImage<TImage>::RegionType region;
+      for (unsigned int ii = 0; ii < Dimension; ++ii)
+      {
+        if (values[Dimension + ii] < 0)
+        {
+          throw CLI::ValidationError(name, "The region size must not be negative");
+        }
+        region.SetIndex(ii, values[ii]);
+        region.SetSize(ii, values[Dimension + ii]);
+      }
+      inputImage.SetRegion(region);
+    }, description);
+  // Set the region before the input image option converts its value
+  option->expected(2 * Dimension)->trigger_on_parse();
+  return option;
+}
+
+
+/** Extract a region of an input image, as the InputImage region. Only the
+ * region is read when the source of the image streams. */
+template <typename TImage>
+typename TImage::Pointer ExtractInputRegion(const TImage * image, const typename TImage::RegionType & region)
+{
+  using ExtractFilterType = ExtractImageFilter<TImage, TImage>;
+  auto extractFilter = ExtractFilterType::New();
+  extractFilter->SetInput(image);
+  extractFilter->SetExtractionRegion(region);
+  extractFilter->SetDirectionCollapseToSubmatrix();
+  extractFilter->Update();
+
+  typename TImage::PointType origin;
+  image->TransformIndexToPhysicalPoint(region.GetIndex(), origin);
+  auto output = TImage::New();
+  output->Graft(extractFilter->GetOutput());
+  output->SetOrigin(origin);
+  output->SetRegions(typename TImage::RegionType(region.GetSize()));
+  output->SetMetaDataDictionary(image->GetMetaDataDictionary());
+  return output;
+}
+
+
 template <typename TImage>
 bool lexical_cast(const std::string &input, InputImage<TImage> &inputImage)
 {
@@ -73,18 +182,78 @@ bool lexical_cast(const std::string &input, InputImage<TImage> &inputImage)
     return false;
   }
 
+  if (IsStageIdentifier(input))
+  {
+    const ProfileScope profileScope("input-image " + input);
+    const auto stageImage = dynamic_cast<const TImage *>(GetStageDataObject(input));
+    if (stageImage == nullptr)
+    {
+      return false;
+    }
+    inputImage.Set(stageImage);
+    return true;
+  }
+
   if (wasm::Pipeline::get_use_memory_io())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
+    const ProfileScope profileScope("input-image " + input);
     using WasmImageToImageFilterType = WasmImageToImageFilter<TImage>;
     auto wasmImageToImageFilter = WasmImageToImageFilterType::New();
     auto wasmImage = WasmImageToImageFilterType::WasmImageType::New();
     const unsigned int index = std::stoi(input);
-    auto json = getMemoryStoreInputJSON(0, index);
-    wasmImage->SetJSON(json);
+    const auto memoryIndex = wasm::Pipeline::get_memory_index();
+    wasmImageToImageFilter->SetMemoryIndex(memoryIndex);
+    // Retained inputs own their arrays, which outlive the run
+    uint32_t retainHandle = 0;
+    const bool retain = getMemoryStoreInputRetainHandle(memoryIndex, index, retainHandle);
+    wasmImageToImageFilter->SetInputArrayHandoff(retain || getMemoryStoreInputArrayHandoff(memoryIndex));
+    wasmImageToImageFilter->SetConvertMetaData(inputImage.GetConvertMetaData());
+    wasmImageToImageFilter->SetMetaDataKeyFilter(inputImage.GetMetaDataKeyFilter());
+    wasmImageToImageFilter->SetComponentConversion(Pipeline::get_component_conversion());
+    wasmImageToImageFilter->SetPlanarLayout(getMemoryStoreUsePlanarLayout(memoryIndex));
+    const auto descriptor = getMemoryStoreInputImageDescriptor(memoryIndex, index);
+    if (descriptor != nullptr)
+    {
+      wasmImage->SetDescriptor(*descriptor);
+    }
+    else
+    {
+      auto document = Pipeline::get_input_json_document(index);
+      if (document)
+      {
+        wasmImageToImageFilter->SetJSONDocument(document);
+      }
+      else
+      {
+        auto json = getMemoryStoreInputJSON(memoryIndex, index);
+        wasmImage->SetJSON(json);
+      }
+    }
     wasmImageToImageFilter->SetInput(wasmImage);
     wasmImageToImageFilter->Update();
-    inputImage.Set(wasmImageToImageFilter->GetOutput());
+    if (retain)
+    {
+      using ConvertPixelTraits = DefaultConvertPixelTraits<typename TImage::PixelType>;
+      StageDataObjectType type;
+      type.dimension = TImage::ImageDimension;
+      type.componentType = MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString;
+      type.pixelType = MapPixelType<typename TImage::PixelType>::PixelString;
+      type.components = wasmImageToImageFilter->GetOutput()->GetNumberOfComponentsPerPixel();
+      SetStageDataObject(GetHandleIdentifier(retainHandle), wasmImageToImageFilter->GetOutput(), type);
+      SetStageImageBuffer(GetHandleIdentifier(retainHandle), MakeStageImageBuffer(wasmImageToImageFilter->GetOutput()));
+    }
+    if (inputImage.GetRegion())
+    {
+      // The import references the input array, only the region is copied
+      typename TImage::Pointer imported = wasmImageToImageFilter->GetOutput();
+      imported->DisconnectPipeline();
+      inputImage.Set(ExtractInputRegion<TImage>(imported, *inputImage.GetRegion()));
+    }
+    else
+    {
+      inputImage.Set(wasmImageToImageFilter->GetOutput());
+    }
 #else
     return false;
 #endif
@@ -92,8 +261,50 @@ bool lexical_cast(const std::string &input, InputImage<TImage> &inputImage)
   else
   {
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
-    auto image = itk::ReadImage<TImage>(input);
-    inputImage.Set(image);
+    // Skip the ImageIO factory lookup done during input type detection.
+    // An ImageIO is used by a single reader.
+    ImageIOBase::Pointer imageIO = Pipeline::get_input_image_io(input);
+    if (imageIO.IsNull())
+    {
+      imageIO = LazyImageIOFactory::CreateIO(input.c_str(), CommonEnums::IOFileMode::ReadMode);
+    }
+    else
+    {
+      Pipeline::set_input_image_io(input, nullptr);
+    }
+    if (imageIO.IsNotNull())
+    {
+      // Decoded concurrently with the other inputs, the factory lookup is not
+      Pipeline::read_input([input, imageIO, keyFilter = inputImage.GetMetaDataKeyFilter(), region = inputImage.GetRegion(), image = inputImage.DeferSet()]() {
+        const ProfileScope profileScope("input-image " + input);
+        using ReaderType = ImageFileReader<TImage>;
+        auto reader = ReaderType::New();
+        reader->SetFileName(input);
+        reader->SetImageIO(imageIO);
+        if (region)
+        {
+          // Only the extraction region is requested from the reader
+          auto extracted = ExtractInputRegion<TImage>(reader->GetOutput(), *region);
+          keyFilter.Apply(extracted->GetMetaDataDictionary());
+          *image = extracted;
+          return;
+        }
+        reader->Update();
+        keyFilter.Apply(reader->GetOutput()->GetMetaDataDictionary());
+        *image = reader->GetOutput();
+      });
+    }
+    else
+    {
+      const ProfileScope profileScope("input-image " + input);
+      typename TImage::Pointer image = itk::ReadImage<TImage>(input);
+      if (inputImage.GetRegion())
+      {
+        image = ExtractInputRegion<TImage>(image, *inputImage.GetRegion());
+      }
+      inputImage.GetMetaDataKeyFilter().Apply(image->GetMetaDataDictionary());
+      inputImage.Set(image);
+    }
 #else
     return false;
 #endif
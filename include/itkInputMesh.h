@@ -19,6 +19,12 @@
 #define itkInputMesh_h
 
 #include "itkPipeline.h"
+#include "itkPipelineStageStore.h"
+#include "itkWasmMapComponentType.h"
+#include "itkWasmMapPixelType.h"
+#include "itkMeshConvertPixelTraits.h"
+
+#include <memory>
 
 #ifndef ITK_WASM_NO_MEMORY_IO
 #include "itkWasmExports.h"
@@ -27,6 +33,7 @@
 #endif
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
 #include "itkMeshFileReader.h"
+#include "itkWasmLazyIOFactory.h"
 #endif
 
 namespace itk
@@ -51,17 +58,24 @@ public:
   using MeshType = TMesh;
 
   void Set(const MeshType * mesh) {
-    this->m_Mesh = mesh;
+    this->m_Mesh = std::make_shared<typename TMesh::ConstPointer>(mesh);
   }
 
   const MeshType * Get() const {
-    return this->m_Mesh.GetPointer();
+    return this->m_Mesh ? this->m_Mesh->GetPointer() : nullptr;
+  }
+
+  /** Mesh set by a read deferred with Pipeline::read_input once the command
+   * line is parsed. Copies of the InputMesh share it. */
+  std::shared_ptr<typename TMesh::ConstPointer> DeferSet() {
+    this->m_Mesh = std::make_shared<typename TMesh::ConstPointer>();
+    return this->m_Mesh;
   }
 
   InputMesh() = default;
   ~InputMesh() = default;
 protected:
-  typename TMesh::ConstPointer m_Mesh;
+  std::shared_ptr<typename TMesh::ConstPointer> m_Mesh;
 };
 
 
@@ -73,18 +87,51 @@ bool lexical_cast(const std::string &input, InputMesh<TMesh> &inputMesh)
     return false;
   }
 
+  if (IsStageIdentifier(input))
+  {
+    const ProfileScope profileScope("input-mesh " + input);
+    const auto stageMesh = dynamic_cast<const TMesh *>(GetStageDataObject(input));
+    if (stageMesh == nullptr)
+    {
+      return false;
+    }
+    inputMesh.Set(stageMesh);
+    return true;
+  }
+
   if (wasm::Pipeline::get_use_memory_io())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
+    const ProfileScope profileScope("input-mesh " + input);
     using WasmMeshToMeshFilterType = WasmMeshToMeshFilter<TMesh>;
     auto wasmMeshToMeshFilter = WasmMeshToMeshFilterType::New();
     auto wasmMesh = WasmMeshToMeshFilterType::WasmMeshType::New();
     const unsigned int index = std::stoi(input);
-    auto json = getMemoryStoreInputJSON(0, index);
-    wasmMesh->SetJSON(json);
+    auto document = Pipeline::get_input_json_document(index);
+    if (document)
+    {
+      wasmMeshToMeshFilter->SetJSONDocument(document);
+    }
+    else
+    {
+      auto json = getMemoryStoreInputJSON(wasm::Pipeline::get_memory_index(), index);
+      wasmMesh->SetJSON(json);
+    }
     wasmMeshToMeshFilter->SetInput(wasmMesh);
     wasmMeshToMeshFilter->Update();
     inputMesh.Set(wasmMeshToMeshFilter->GetOutput());
+    // The mesh is copied from the input arrays, so it can stay resident
+    uint32_t retainHandle = 0;
+    if (getMemoryStoreInputRetainHandle(wasm::Pipeline::get_memory_index(), index, retainHandle))
+    {
+      using ConvertPixelTraits = MeshConvertPixelTraits<typename TMesh::PixelType>;
+      StageDataObjectType type;
+      type.dimension = TMesh::PointDimension;
+      type.componentType = MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString;
+      type.pixelType = MapPixelType<typename TMesh::PixelType>::PixelString;
+      type.components = ConvertPixelTraits::GetNumberOfComponents();
+      SetStageDataObject(GetHandleIdentifier(retainHandle), wasmMeshToMeshFilter->GetOutput(), type);
+    }
 #else
     return false;
 #endif
@@ -92,12 +139,38 @@ bool lexical_cast(const std::string &input, InputMesh<TMesh> &inputMesh)
   else
   {
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
-    using ReaderType = MeshFileReader<TMesh>;
-    auto reader = ReaderType::New();
-    reader->SetFileName(input);
-    reader->Update();
-    auto mesh = reader->GetOutput();
-    inputMesh.Set(mesh);
+    // Skip the MeshIO factory lookup done during input type detection.
+    // A MeshIO is used by a single reader.
+    MeshIOBase::Pointer meshIO = Pipeline::get_input_mesh_io(input);
+    if (meshIO.IsNull())
+    {
+      meshIO = LazyMeshIOFactory::CreateIO(input.c_str(), CommonEnums::IOFileMode::ReadMode);
+    }
+    else
+    {
+      Pipeline::set_input_mesh_io(input, nullptr);
+    }
+    auto read = [input, meshIO, mesh = inputMesh.DeferSet()]() {
+      const ProfileScope profileScope("input-mesh " + input);
+      using ReaderType = MeshFileReader<TMesh>;
+      auto reader = ReaderType::New();
+      reader->SetFileName(input);
+      if (meshIO.IsNotNull())
+      {
+        reader->SetMeshIO(meshIO);
+      }
+      reader->Update();
+      *mesh = reader->GetOutput();
+    };
+    if (meshIO.IsNotNull())
+    {
+      // Decoded concurrently with the other inputs, the factory lookup is not
+      Pipeline::read_input(read);
+    }
+    else
+    {
+      read();
+    }
 #else
     return false;
 #endif
@@ -72,7 +72,7 @@ bool lexical_cast(const std::string &input, InputMeshIO &inputMeshIO)
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
     const unsigned int index = std::stoi(input);
-    auto json = getMemoryStoreInputJSON(0, index);
+    auto json = getMemoryStoreInputJSON(wasm::Pipeline::get_memory_index(), index);
     rapidjson::Document document;
     document.Parse(json.c_str());
 
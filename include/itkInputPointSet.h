@@ -0,0 +1,200 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkInputPointSet_h
+#define itkInputPointSet_h
+
+#include "itkPipeline.h"
+#include "itkPipelineStageStore.h"
+#include "itkWasmMapComponentType.h"
+#include "itkWasmMapPixelType.h"
+#include "itkMeshConvertPixelTraits.h"
+
+#include <memory>
+
+#ifndef ITK_WASM_NO_MEMORY_IO
+#include "itkWasmExports.h"
+#include "itkWasmPointSet.h"
+#include "itkWasmPointSetToPointSetFilter.h"
+#endif
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+#include "itkMesh.h"
+#include "itkMeshFileReader.h"
+#include "itkWasmLazyIOFactory.h"
+#endif
+
+namespace itk
+{
+namespace wasm
+{
+
+/**
+ *\class InputPointSet
+ * \brief Input point set for an itk::wasm::Pipeline
+ *
+ * This point set is read from the filesystem or memory when ITK_WASM_PARSE_ARGS is called.
+ *
+ * Call `Get()` to get the TPointSet * to use an input to a pipeline.
+ *
+ * Points and point data are read into the point set containers without the
+ * cell processing of an InputMesh. Mesh files are read as a point set from
+ * their points and point data.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+template <typename TPointSet>
+class ITK_TEMPLATE_EXPORT InputPointSet
+{
+public:
+  using PointSetType = TPointSet;
+
+  void Set(const PointSetType * pointSet) {
+    this->m_PointSet = std::make_shared<typename TPointSet::ConstPointer>(pointSet);
+  }
+
+  const PointSetType * Get() const {
+    return this->m_PointSet ? this->m_PointSet->GetPointer() : nullptr;
+  }
+
+  /** Point set set by a read deferred with Pipeline::read_input once the command
+   * line is parsed. Copies of the InputPointSet share it. */
+  std::shared_ptr<typename TPointSet::ConstPointer> DeferSet() {
+    this->m_PointSet = std::make_shared<typename TPointSet::ConstPointer>();
+    return this->m_PointSet;
+  }
+
+  InputPointSet() = default;
+  ~InputPointSet() = default;
+protected:
+  std::shared_ptr<typename TPointSet::ConstPointer> m_PointSet;
+};
+
+
+template <typename TPointSet>
+bool lexical_cast(const std::string &input, InputPointSet<TPointSet> &inputPointSet)
+{
+  if (input.empty())
+  {
+    return false;
+  }
+
+  if (IsStageIdentifier(input))
+  {
+    const ProfileScope profileScope("input-point-set " + input);
+    const auto stagePointSet = dynamic_cast<const TPointSet *>(GetStageDataObject(input));
+    if (stagePointSet == nullptr)
+    {
+      return false;
+    }
+    inputPointSet.Set(stagePointSet);
+    return true;
+  }
+
+  if (wasm::Pipeline::get_use_memory_io())
+  {
+#ifndef ITK_WASM_NO_MEMORY_IO
+    const ProfileScope profileScope("input-point-set " + input);
+    using WasmPointSetToPointSetFilterType = WasmPointSetToPointSetFilter<TPointSet>;
+    auto wasmPointSetToPointSetFilter = WasmPointSetToPointSetFilterType::New();
+    auto wasmPointSet = WasmPointSetToPointSetFilterType::WasmPointSetType::New();
+    const unsigned int index = std::stoi(input);
+    const auto memoryIndex = wasm::Pipeline::get_memory_index();
+    wasmPointSetToPointSetFilter->SetMemoryIndex(memoryIndex);
+    wasmPointSetToPointSetFilter->SetInputArrayHandoff(getMemoryStoreInputArrayHandoff(memoryIndex));
+    auto document = Pipeline::get_input_json_document(index);
+    if (document)
+    {
+      wasmPointSetToPointSetFilter->SetJSONDocument(document);
+    }
+    else
+    {
+      auto json = getMemoryStoreInputJSON(memoryIndex, index);
+      wasmPointSet->SetJSON(json);
+    }
+    wasmPointSetToPointSetFilter->SetInput(wasmPointSet);
+    wasmPointSetToPointSetFilter->Update();
+    inputPointSet.Set(wasmPointSetToPointSetFilter->GetOutput());
+    // The point set is copied from the input arrays, so it can stay resident
+    uint32_t retainHandle = 0;
+    if (getMemoryStoreInputRetainHandle(memoryIndex, index, retainHandle))
+    {
+      using ConvertPixelTraits = MeshConvertPixelTraits<typename TPointSet::PixelType>;
+      StageDataObjectType type;
+      type.dimension = TPointSet::PointDimension;
+      type.componentType = MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString;
+      type.pixelType = MapPixelType<typename TPointSet::PixelType>::PixelString;
+      type.components = ConvertPixelTraits::GetNumberOfComponents();
+      SetStageDataObject(GetHandleIdentifier(retainHandle), wasmPointSetToPointSetFilter->GetOutput(), type);
+    }
+#else
+    return false;
+#endif
+  }
+  else
+  {
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+    // Skip the MeshIO factory lookup done during input type detection.
+    // A MeshIO is used by a single reader.
+    MeshIOBase::Pointer meshIO = Pipeline::get_input_mesh_io(input);
+    if (meshIO.IsNull())
+    {
+      meshIO = LazyMeshIOFactory::CreateIO(input.c_str(), CommonEnums::IOFileMode::ReadMode);
+    }
+    else
+    {
+      Pipeline::set_input_mesh_io(input, nullptr);
+    }
+    auto read = [input, meshIO, pointSet = inputPointSet.DeferSet()]() {
+      const ProfileScope profileScope("input-point-set " + input);
+      // A mesh with the traits of the point set shares its containers
+      using MeshType = Mesh<typename TPointSet::PixelType, TPointSet::PointDimension, typename TPointSet::MeshTraits>;
+      using ReaderType = MeshFileReader<MeshType>;
+      auto reader = ReaderType::New();
+      reader->SetFileName(input);
+      if (meshIO.IsNotNull())
+      {
+        reader->SetMeshIO(meshIO);
+      }
+      reader->Update();
+      auto readPointSet = TPointSet::New();
+      readPointSet->SetPoints(reader->GetOutput()->GetPoints());
+      if (reader->GetOutput()->GetPointData() != nullptr)
+      {
+        readPointSet->SetPointData(reader->GetOutput()->GetPointData());
+      }
+      *pointSet = readPointSet;
+    };
+    if (meshIO.IsNotNull())
+    {
+      // Decoded concurrently with the other inputs, the factory lookup is not
+      Pipeline::read_input(read);
+    }
+    else
+    {
+      read();
+    }
+#else
+    return false;
+#endif
+  }
+  return true;
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
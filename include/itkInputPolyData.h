@@ -19,6 +19,7 @@
 #define itkInputPolyData_h
 
 #include "itkPipeline.h"
+#include "itkPipelineStageStore.h"
 
 #ifndef ITK_WASM_NO_MEMORY_IO
 #include "itkWasmExports.h"
@@ -29,6 +30,7 @@
 #include "itkMeshFileReader.h"
 #include "itkMeshToPolyDataFilter.h"
 #include "itkPolyDataToMeshFilter.h"
+#include "itkWasmLazyIOFactory.h"
 #endif
 
 namespace itk
@@ -74,6 +76,18 @@ bool lexical_cast(const std::string &input, InputPolyData<TPolyData> &inputPolyD
   {
     return false;
   }
+  const ProfileScope profileScope("input-polydata " + input);
+
+  if (IsStageIdentifier(input))
+  {
+    const auto stagePolyData = dynamic_cast<const TPolyData *>(GetStageDataObject(input));
+    if (stagePolyData == nullptr)
+    {
+      return false;
+    }
+    inputPolyData.Set(stagePolyData);
+    return true;
+  }
 
   if (wasm::Pipeline::get_use_memory_io())
   {
@@ -82,7 +96,7 @@ bool lexical_cast(const std::string &input, InputPolyData<TPolyData> &inputPolyD
     auto wasmPolyDataToPolyDataFilter = WasmPolyDataToPolyDataFilterType::New();
     auto wasmPolyData = WasmPolyDataToPolyDataFilterType::WasmPolyDataType::New();
     const unsigned int index = std::stoi(input);
-    auto json = getMemoryStoreInputJSON(0, index);
+    auto json = getMemoryStoreInputJSON(wasm::Pipeline::get_memory_index(), index);
     wasmPolyData->SetJSON(json);
     wasmPolyDataToPolyDataFilter->SetInput(wasmPolyData);
     wasmPolyDataToPolyDataFilter->Update();
@@ -99,6 +113,11 @@ bool lexical_cast(const std::string &input, InputPolyData<TPolyData> &inputPolyD
     using ReaderType = MeshFileReader<MeshType>;
     auto reader = ReaderType::New();
     reader->SetFileName(input);
+    auto meshIO = LazyMeshIOFactory::CreateIO(input.c_str(), CommonEnums::IOFileMode::ReadMode);
+    if (meshIO.IsNotNull())
+    {
+      reader->SetMeshIO(meshIO);
+    }
     using MeshToPolyDataFilterType = MeshToPolyDataFilter<MeshType>;
     auto meshToPolyData = MeshToPolyDataFilterType::New();
     meshToPolyData->SetInput(reader->GetOutput());
@@ -19,9 +19,12 @@
 #define itkInputTextStream_h
 
 #include "itkPipeline.h"
-#include "itkWasmStringStream.h"
+#include "itkMemoryStreamBuffer.h"
 
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <fstream>
 
@@ -38,6 +41,10 @@ namespace wasm
  *
  * This stream is read from the filesystem or memory when ITK_WASM_PARSE_ARGS is called.
  *
+ * With memory IO, the stream reads the input text of the memory store in
+ * place, without a copy. `GetView()` gives direct access to that text, e.g.
+ * for parsers of contiguous input.
+ *
  * Call `Get()` to get the std::istream & to use an input to a pipeline.
  *
  * \ingroup WebAssemblyInterface
@@ -53,19 +60,14 @@ public:
     return m_IStream;
   }
 
-  void SetJSON(const std::string & json)
-  {
-    if (m_DeleteIStream && m_IStream != nullptr)
-    {
-      delete m_IStream;
-    }
-    m_DeleteIStream = false;
-    m_WasmStringStream = WasmStringStream::New();
-    m_WasmStringStream->SetJSON(json.c_str());
-
-    m_IStream = &(m_WasmStringStream->GetStringStream());
+  /** Text of a memory IO input, without a null terminator, or empty when
+   * read from a file. */
+  std::string_view GetView() const {
+    return std::string_view(m_Data, m_Size);
   }
 
+  void SetJSON(const std::string & json);
+
   void SetFileName(const std::string & fileName)
   {
     if (m_DeleteIStream && m_IStream != nullptr)
@@ -74,6 +76,8 @@ public:
     }
     m_IStream = new std::ifstream(fileName, std::ifstream::in);
     m_DeleteIStream = true;
+    m_Data = nullptr;
+    m_Size = 0;
   }
 
   InputTextStream() = default;
@@ -88,7 +92,9 @@ protected:
   std::istream * m_IStream{nullptr};
   bool m_DeleteIStream{false};
 
-  WasmStringStream::Pointer m_WasmStringStream;
+  const char * m_Data{nullptr};
+  size_t m_Size{0};
+  std::unique_ptr<MemoryStreamBuffer> m_StreamBuffer;
 };
 
 
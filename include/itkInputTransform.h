@@ -0,0 +1,163 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkInputTransform_h
+#define itkInputTransform_h
+
+#include "itkPipeline.h"
+#include "itkPipelineStageStore.h"
+#include "itkWasmMapComponentType.h"
+#include "itkDataObjectDecorator.h"
+#include "itkTransformBase.h"
+
+#include <memory>
+
+#ifndef ITK_WASM_NO_MEMORY_IO
+#include "itkWasmExports.h"
+#include "itkWasmTransform.h"
+#include "itkWasmTransformToTransformFilter.h"
+#endif
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+#include "itkTransformFileReader.h"
+#endif
+
+namespace itk
+{
+namespace wasm
+{
+
+/**
+ *\class InputTransform
+ * \brief Input transform for an itk::wasm::Pipeline
+ *
+ * This transform is read from the filesystem or memory when ITK_WASM_PARSE_ARGS is called.
+ *
+ * Call `Get()` to get the TTransform * to use an input to a pipeline.
+ *
+ * TTransform may be a base class, e.g. itk::Transform<double, 3, 3>, to
+ * accept any transform with its dimensions and parameters value type. In
+ * memory, the displacement field of a displacement field transform is
+ * imported from its parameters array without a copy. Transform files hold a
+ * single transform.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+template <typename TTransform>
+class ITK_TEMPLATE_EXPORT InputTransform
+{
+public:
+  using TransformType = TTransform;
+
+  void Set(const TransformType * transform) {
+    this->m_Transform = std::make_shared<typename TTransform::ConstPointer>(transform);
+  }
+
+  const TransformType * Get() const {
+    return this->m_Transform ? this->m_Transform->GetPointer() : nullptr;
+  }
+
+  InputTransform() = default;
+  ~InputTransform() = default;
+protected:
+  std::shared_ptr<typename TTransform::ConstPointer> m_Transform;
+};
+
+
+template <typename TTransform>
+bool lexical_cast(const std::string &input, InputTransform<TTransform> &inputTransform)
+{
+  if (input.empty())
+  {
+    return false;
+  }
+
+  if (IsStageIdentifier(input))
+  {
+    const ProfileScope profileScope("input-transform " + input);
+    using TransformBaseType = TransformBaseTemplate<typename TTransform::ParametersValueType>;
+    const auto stageTransform = dynamic_cast<const DataObjectDecorator<TransformBaseType> *>(GetStageDataObject(input));
+    if (stageTransform == nullptr)
+    {
+      return false;
+    }
+    const auto transform = dynamic_cast<const TTransform *>(stageTransform->Get());
+    if (transform == nullptr)
+    {
+      return false;
+    }
+    inputTransform.Set(transform);
+    return true;
+  }
+
+  if (wasm::Pipeline::get_use_memory_io())
+  {
+#ifndef ITK_WASM_NO_MEMORY_IO
+    const ProfileScope profileScope("input-transform " + input);
+    using WasmTransformToTransformFilterType = WasmTransformToTransformFilter<TTransform>;
+    auto wasmTransformToTransformFilter = WasmTransformToTransformFilterType::New();
+    auto wasmTransform = WasmTransformToTransformFilterType::WasmTransformType::New();
+    const unsigned int index = std::stoi(input);
+    const auto memoryIndex = wasm::Pipeline::get_memory_index();
+    wasmTransformToTransformFilter->SetMemoryIndex(memoryIndex);
+    wasmTransformToTransformFilter->SetInputArrayHandoff(getMemoryStoreInputArrayHandoff(memoryIndex));
+    auto document = Pipeline::get_input_json_document(index);
+    if (document)
+    {
+      wasmTransformToTransformFilter->SetJSONDocument(document);
+    }
+    else
+    {
+      auto json = getMemoryStoreInputJSON(memoryIndex, index);
+      wasmTransform->SetJSON(json);
+    }
+    wasmTransformToTransformFilter->SetInput(wasmTransform);
+    wasmTransformToTransformFilter->Update();
+    inputTransform.Set(wasmTransformToTransformFilter->GetOutput()->Get());
+#else
+    return false;
+#endif
+  }
+  else
+  {
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+    const ProfileScope profileScope("input-transform " + input);
+    using ReaderType = TransformFileReaderTemplate<typename TTransform::ParametersValueType>;
+    auto reader = ReaderType::New();
+    reader->SetFileName(input);
+    reader->Update();
+    const auto * transformList = reader->GetTransformList();
+    if (transformList->empty())
+    {
+      return false;
+    }
+    const auto transform = dynamic_cast<const TTransform *>(transformList->front().GetPointer());
+    if (transform == nullptr)
+    {
+      return false;
+    }
+    inputTransform.Set(transform);
+#else
+    return false;
+#endif
+  }
+  return true;
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,85 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryStreamBuffer_h
+#define itkMemoryStreamBuffer_h
+
+#include <cstddef>
+#include <ios>
+#include <streambuf>
+
+#include "WebAssemblyInterfaceExport.h"
+
+namespace itk
+{
+namespace wasm
+{
+
+/**
+ *\class MemoryStreamBuffer
+ * \brief Read-only, seekable std::streambuf over bytes owned elsewhere
+ *
+ * The bytes are not copied, so they must outlive the buffer.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT MemoryStreamBuffer : public std::streambuf
+{
+public:
+  MemoryStreamBuffer(const char * data, size_t size)
+  {
+    char * begin = const_cast<char *>(data);
+    this->setg(begin, begin, begin + size);
+  }
+
+protected:
+  pos_type
+  seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override
+  {
+    if (!(which & std::ios_base::in))
+    {
+      return pos_type(off_type(-1));
+    }
+    off_type base = 0;
+    if (direction == std::ios_base::cur)
+    {
+      base = this->gptr() - this->eback();
+    }
+    else if (direction == std::ios_base::end)
+    {
+      base = this->egptr() - this->eback();
+    }
+    const off_type position = base + offset;
+    if (position < 0 || position > this->egptr() - this->eback())
+    {
+      return pos_type(off_type(-1));
+    }
+    this->setg(this->eback(), this->eback() + position, this->egptr());
+    return pos_type(position);
+  }
+
+  pos_type
+  seekpos(pos_type position, std::ios_base::openmode which) override
+  {
+    return this->seekoff(off_type(position), std::ios_base::beg, which);
+  }
+};
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
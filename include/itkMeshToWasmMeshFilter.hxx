@@ -24,8 +24,9 @@
 
 #include "itkWasmMapComponentType.h"
 #include "itkWasmMapPixelType.h"
+#include "itkWasmJSONWriter.h"
+#include "itkWasmTrace.h"
 
-#include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
@@ -130,139 +131,96 @@ void
 MeshToWasmMeshFilter<TMesh>
 ::GenerateData()
 {
+  ITK_WASM_TRACE_SCOPE("MeshToWasmMeshFilter::GenerateData");
+
   // Get the input and output pointers
   const MeshType * mesh = this->GetInput();
   WasmMeshType * wasmMesh = this->GetOutput();
 
   wasmMesh->SetMesh(mesh);
 
-  rapidjson::Document document;
-  document.SetObject();
-  rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
+  rapidjson::StringBuffer & stringBuffer = wasm::GetWasmJSONStringBuffer();
+  wasm::WasmJSONWriterType writer(stringBuffer);
+  writer.StartObject();
 
-  rapidjson::Value meshType;
-  meshType.SetObject();
+  writer.Key("meshType");
+  writer.StartObject();
 
   constexpr unsigned int dimension = MeshType::PointDimension;
-  meshType.AddMember("dimension", rapidjson::Value(dimension).Move(), allocator );
+  writer.Key("dimension");
+  writer.Uint(dimension);
 
-  rapidjson::Value pointComponentType;
-  pointComponentType.SetString( wasm::MapComponentType<typename MeshType::CoordRepType>::ComponentString.data(), allocator );
-  meshType.AddMember("pointComponentType", pointComponentType.Move(), allocator );
+  writer.Key("pointComponentType");
+  wasm::WriteWasmJSONString(writer, wasm::MapComponentType<typename MeshType::CoordRepType>::ComponentString);
 
   using PointPixelType = typename TMesh::PixelType;
   using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
-  rapidjson::Value pointPixelComponentType;
-  pointPixelComponentType.SetString( wasm::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::ComponentString.data(), allocator );
-  meshType.AddMember("pointPixelComponentType", pointPixelComponentType.Move(), allocator );
-
-  rapidjson::Value pointPixelType;
-  pointPixelType.SetString( wasm::MapPixelType<PointPixelType>::PixelString.data(), allocator );
-  meshType.AddMember("pointPixelType", pointPixelType.Move(), allocator );
+  writer.Key("pointPixelComponentType");
+  wasm::WriteWasmJSONString(writer, wasm::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::ComponentString);
+  writer.Key("pointPixelType");
+  wasm::WriteWasmJSONString(writer, wasm::MapPixelType<PointPixelType>::PixelString);
+  writer.Key("pointPixelComponents");
+  writer.Uint(ConvertPointPixelTraits::GetNumberOfComponents());
 
-  meshType.AddMember("pointPixelComponents", rapidjson::Value( ConvertPointPixelTraits::GetNumberOfComponents() ).Move(), allocator );
-
-  rapidjson::Value cellComponentType;
-  cellComponentType.SetString( wasm::MapComponentType<typename MeshType::CellsVectorContainer::Element>::ComponentString.data(),allocator );
-  meshType.AddMember("cellComponentType", cellComponentType.Move(), allocator );
+  writer.Key("cellComponentType");
+  wasm::WriteWasmJSONString(writer, wasm::MapComponentType<typename MeshType::CellsVectorContainer::Element>::ComponentString);
 
   using CellPixelType = typename TMesh::CellPixelType;
   using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
-  rapidjson::Value cellPixelComponentType;
-  cellPixelComponentType.SetString( wasm::MapComponentType<typename ConvertCellPixelTraits::ComponentType>::ComponentString.data(), allocator );
-  meshType.AddMember("cellPixelComponentType", cellPixelComponentType.Move(), allocator );
+  writer.Key("cellPixelComponentType");
+  wasm::WriteWasmJSONString(writer, wasm::MapComponentType<typename ConvertCellPixelTraits::ComponentType>::ComponentString);
+  writer.Key("cellPixelType");
+  wasm::WriteWasmJSONString(writer, wasm::MapPixelType<CellPixelType>::PixelString);
+  writer.Key("cellPixelComponents");
+  writer.Uint(ConvertCellPixelTraits::GetNumberOfComponents());
 
-  rapidjson::Value cellPixelType;
-  cellPixelType.SetString( wasm::MapPixelType<CellPixelType>::PixelString.data(), allocator );
-  meshType.AddMember("cellPixelType", cellPixelType, allocator );
+  writer.EndObject();
 
-  meshType.AddMember("cellPixelComponents", rapidjson::Value( ConvertCellPixelTraits::GetNumberOfComponents() ).Move(), allocator );
+  writer.Key("numberOfPoints");
+  writer.Uint64(static_cast< uint64_t >( mesh->GetNumberOfPoints() ));
 
-  document.AddMember( "meshType", meshType.Move(), allocator );
+  writer.Key("numberOfPointPixels");
+  writer.Uint64(mesh->GetPointData() == nullptr ? 0 : static_cast< uint64_t >( mesh->GetPointData()->Size() ));
 
-  rapidjson::Value numberOfPoints;
-  numberOfPoints.SetInt( mesh->GetNumberOfPoints() );
-  document.AddMember( "numberOfPoints", numberOfPoints.Move(), allocator );
+  writer.Key("numberOfCells");
+  writer.Uint64(static_cast< uint64_t >( mesh->GetNumberOfCells() ));
 
-  rapidjson::Value numberOfPointPixels;
-  if (mesh->GetPointData() == nullptr)
-  {
-    numberOfPointPixels.SetInt( 0 );
-  }
-  else
-  {
-    numberOfPointPixels.SetInt( mesh->GetPointData()->Size() );
-  }
-  document.AddMember( "numberOfPointPixels", numberOfPointPixels.Move(), allocator );
+  writer.Key("numberOfCellPixels");
+  writer.Uint64(mesh->GetCellData() == nullptr ? 0 : static_cast< uint64_t >( mesh->GetCellData()->Size() ));
 
-  rapidjson::Value numberOfCells;
-  numberOfCells.SetInt( mesh->GetNumberOfCells() );
-  document.AddMember( "numberOfCells", numberOfCells.Move(), allocator );
+  writer.Key("cellBufferSize");
+  writer.Uint64(static_cast< uint64_t >( wasmMesh->GetCellBuffer()->Size() ));
 
-  rapidjson::Value numberOfCellPixels;
-  if (mesh->GetCellData() == nullptr)
-  {
-    numberOfCellPixels.SetInt( 0 );
-  }
-  else
-  {
-    numberOfCellPixels.SetInt( mesh->GetCellData()->Size() );
-  }
-  document.AddMember( "numberOfCellPixels", numberOfCellPixels.Move(), allocator );
-
-  rapidjson::Value cellBufferSizeMember;
-  cellBufferSizeMember.SetInt( wasmMesh->GetCellBuffer()->Size() );
-  document.AddMember( "cellBufferSize", cellBufferSizeMember.Move(), allocator );
-
-  const auto pointsAddress = reinterpret_cast< size_t >( &(mesh->GetPoints()->at(0)) );
-  std::ostringstream pointsStream;
-  pointsStream << "data:application/vnd.itk.address,0:";
-  pointsStream << pointsAddress;
-  rapidjson::Value pointsString;
-  pointsString.SetString( pointsStream.str().c_str(), allocator );
-  document.AddMember( "points", pointsString.Move(), allocator );
+  writer.Key("points");
+  wasm::WriteWasmJSONAddress(writer, reinterpret_cast< size_t >( &(mesh->GetPoints()->at(0)) ));
 
   size_t cellsAddress = 0;
   if (mesh->GetNumberOfCells() > 0)
   {
     cellsAddress = reinterpret_cast< size_t >( &(wasmMesh->GetCellBuffer()->at(0)) );
   }
-  std::ostringstream cellsStream;
-  cellsStream << "data:application/vnd.itk.address,0:";
-  cellsStream << cellsAddress;
-  rapidjson::Value cellsString;
-  cellsString.SetString( cellsStream.str().c_str(), allocator );
-  document.AddMember( "cells", cellsString.Move(), allocator );
+  writer.Key("cells");
+  wasm::WriteWasmJSONAddress(writer, cellsAddress);
 
   size_t pointDataAddress = 0;
   if (mesh->GetPointData() != nullptr && mesh->GetPointData()->Size() > 0)
   {
     pointDataAddress = reinterpret_cast< size_t >( &(mesh->GetPointData()->at(0)) );
   }
-  std::ostringstream pointDataStream;
-  pointDataStream << "data:application/vnd.itk.address,0:";
-  pointDataStream << pointDataAddress;
-  rapidjson::Value pointDataString;
-  pointDataString.SetString( pointDataStream.str().c_str(), allocator );
-  document.AddMember( "pointData", pointDataString.Move(), allocator );
+  writer.Key("pointData");
+  wasm::WriteWasmJSONAddress(writer, pointDataAddress);
 
   size_t cellDataAddress = 0;
   if (mesh->GetCellData() != nullptr && mesh->GetCellData()->Size() > 0)
   {
     cellDataAddress = reinterpret_cast< size_t >( &(mesh->GetCellData()->at(0)) );
   }
-  std::ostringstream cellDataStream;
-  cellDataStream <<  "data:application/vnd.itk.address,0:";
-  cellDataStream << cellDataAddress;
-  rapidjson::Value cellDataString;
-  cellDataString.SetString( cellDataStream.str().c_str(), allocator );
-  document.AddMember( "cellData", cellDataString.Move(), allocator );
-
-  rapidjson::StringBuffer stringBuffer;
-  rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
-  document.Accept(writer);
-
-  wasmMesh->SetJSON(stringBuffer.GetString());
+  writer.Key("cellData");
+  wasm::WriteWasmJSONAddress(writer, cellDataAddress);
+
+  writer.EndObject();
+
+  wasmMesh->SetJSON(std::string(stringBuffer.GetString(), stringBuffer.GetSize()));
 }
 
 template <typename TMesh>
@@ -0,0 +1,86 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMetaDataDictionaryCBOR_h
+#define itkMetaDataDictionaryCBOR_h
+
+#include "itkMetaDataDictionary.h"
+#include "itkMetaDataObject.h"
+
+#include "itkWasmCBORSink.h"
+#include "itkWasmMetaDataKeyFilter.h"
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include <cstddef>
+#include <functional>
+#include <typeinfo>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/** Write the entries of a dictionary as a CBOR map of keys to values.
+ *
+ * Numbers and strings are CBOR numbers and strings. std::vector and Array
+ * values of numbers are RFC 8746 little-endian typed arrays, e.g. tag 86 on
+ * the float64 bytes of a std::vector<double>, so they are written and read
+ * without text formatting or parsing. Vectors of strings, vectors of vectors
+ * and Matrix rows are CBOR arrays. The converter of each entry is looked up
+ * by the type of its MetaDataObject. Entries without a registered
+ * converter, or whose key the keyFilter rejects, are skipped. */
+WebAssemblyInterface_EXPORT void WriteCBORMetaDataDictionary(CBORSink & sink, const MetaDataDictionary & dictionary, const MetaDataKeyFilter & keyFilter = MetaDataKeyFilter());
+
+/** Read a CBOR metadata map into dictionary entries.
+ *
+ * Integers are read as int, unsigned int, int64_t or uint64_t, like
+ * ConvertJSONToMetaDataDictionary, floats as float or double, and typed
+ * arrays as std::vector of their element type. Arrays of strings or of typed
+ * arrays of one type are std::vector<std::string> or
+ * std::vector<std::vector<T>>. Values of other types, and entries whose
+ * key the keyFilter rejects, are skipped without being decoded. Returns
+ * false if the data is not an encoded CBOR map with string keys. */
+WebAssemblyInterface_EXPORT bool ReadCBORMetaDataDictionary(const unsigned char * data, size_t size, MetaDataDictionary & dictionary, const MetaDataKeyFilter & keyFilter = MetaDataKeyFilter());
+
+/** Write the value of a MetaDataObject as one CBOR item. */
+using MetaDataObjectToCBORConverter = std::function<void(const MetaDataObjectBase & object, CBORSink & sink)>;
+
+/** Register the converter of MetaDataObjects of the given dynamic type, e.g.
+ * typeid(MetaDataObject<T>), replacing any converter registered for it.
+ *
+ * The types of RegisterMetaDataObjectToJSONConverter are registered by
+ * default. An empty converter skips MetaDataObjects of the type.
+ * Registration is not synchronized with conversion. */
+WebAssemblyInterface_EXPORT void RegisterMetaDataObjectToCBORConverter(const std::type_info & metaDataObjectType, MetaDataObjectToCBORConverter converter);
+
+/** Register the converter of MetaDataObject<TValue>. */
+template <typename TValue>
+void RegisterMetaDataObjectToCBORConverter(std::function<void(const TValue & value, CBORSink & sink)> converter)
+{
+  RegisterMetaDataObjectToCBORConverter(typeid(MetaDataObject<TValue>),
+    [converter](const MetaDataObjectBase & object, CBORSink & sink)
+    {
+      converter(static_cast<const MetaDataObject<TValue> &>(object).GetMetaDataObjectValue(), sink);
+    });
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -26,17 +26,93 @@
 
 #include "rapidjson/document.h"
 
+#include "itkWasmMetaDataKeyFilter.h"
+
 #include "WebAssemblyInterfaceExport.h"
 
+#include <functional>
+#include <string>
+#include <typeinfo>
+
 namespace itk
 {
 
 namespace wasm
 {
 
-WebAssemblyInterface_EXPORT void ConvertMetaDataDictionaryToJSON(const itk::MetaDataDictionary & dictionary, rapidjson::Value & metadataJson, rapidjson::Document::AllocatorType& allocator);
+/** Convert the entries of a dictionary to an array of [key, value] JSON
+ * arrays.
+ *
+ * The converter of each entry is looked up by the type of its
+ * MetaDataObject. Entries without a registered converter, or whose key the
+ * keyFilter rejects, are skipped. */
+WebAssemblyInterface_EXPORT void ConvertMetaDataDictionaryToJSON(const itk::MetaDataDictionary & dictionary, rapidjson::Value & metadataJson, rapidjson::Document::AllocatorType& allocator, const MetaDataKeyFilter & keyFilter = MetaDataKeyFilter());
+
+/** Convert an array of [key, value] JSON arrays to dictionary entries.
+ *
+ * The converter of each value is looked up by its JSONMetaDataShape.
+ * Values of other shapes, e.g. objects or nulls, and entries whose key the
+ * keyFilter rejects are skipped. */
+WebAssemblyInterface_EXPORT void ConvertJSONToMetaDataDictionary(const rapidjson::Value & metadataJson, itk::MetaDataDictionary & dictionary, const MetaDataKeyFilter & keyFilter = MetaDataKeyFilter());
+
+/** Set valueJson to the JSON value of a MetaDataObject. */
+using MetaDataObjectToJSONConverter = std::function<void(const MetaDataObjectBase & object, rapidjson::Value & valueJson, rapidjson::Document::AllocatorType & allocator)>;
+
+/** Register the converter of MetaDataObjects of the given dynamic type, e.g.
+ * typeid(MetaDataObject<T>), replacing any converter registered for it.
+ *
+ * The bool, integer, floating point, std::string, std::vector, Array and
+ * Matrix types that ITK stores in dictionaries are registered by default.
+ * An empty converter skips MetaDataObjects of the type. Registration is
+ * not synchronized with conversion, so register application types before
+ * dictionaries are converted concurrently. */
+WebAssemblyInterface_EXPORT void RegisterMetaDataObjectToJSONConverter(const std::type_info & metaDataObjectType, MetaDataObjectToJSONConverter converter);
+
+/** Register the converter of MetaDataObject<TValue>. */
+template <typename TValue>
+void RegisterMetaDataObjectToJSONConverter(std::function<void(const TValue & value, rapidjson::Value & valueJson, rapidjson::Document::AllocatorType & allocator)> converter)
+{
+  RegisterMetaDataObjectToJSONConverter(typeid(MetaDataObject<TValue>),
+    [converter](const MetaDataObjectBase & object, rapidjson::Value & valueJson, rapidjson::Document::AllocatorType & allocator)
+    {
+      converter(static_cast<const MetaDataObject<TValue> &>(object).GetMetaDataObjectValue(), valueJson, allocator);
+    });
+}
+
+/** Kind of a JSON metadata value, or of all the values of a JSON array.
+ * Integers have the first kind that holds them. In an array, integers of
+ * different kinds are widened to Int64 or Uint64, or to Double if neither
+ * holds them all. */
+enum class JSONMetaDataKind : unsigned int
+{
+  Bool,
+  Int,
+  Uint,
+  Int64,
+  Uint64,
+  Double,
+  String
+};
+
+/** Kind and array depth of a JSON metadata value: 0 for a scalar, 1 for an
+ * array, e.g. std::vector<int>, and 2 for an array of arrays, e.g.
+ * std::vector<std::vector<double>>. Empty arrays are arrays of strings. */
+struct JSONMetaDataShape
+{
+  JSONMetaDataKind kind;
+  unsigned int     depth;
+};
+
+constexpr unsigned int JSONMetaDataMaximumDepth = 2;
+
+/** Add the dictionary entry of a JSON value of the registered shape. */
+using JSONToMetaDataObjectConverter = std::function<void(const rapidjson::Value & valueJson, const std::string & key, MetaDataDictionary & dictionary)>;
 
-WebAssemblyInterface_EXPORT void ConvertJSONToMetaDataDictionary(const rapidjson::Value & metadataJson, itk::MetaDataDictionary & dictionary);
+/** Register the converter of JSON values of a shape, replacing the default,
+ * which encapsulates the bool, int, unsigned int, int64_t, uint64_t, double
+ * or std::string value, or std::vector of those. An empty converter skips
+ * values of the shape. Registration is not synchronized with conversion. */
+WebAssemblyInterface_EXPORT void RegisterJSONToMetaDataObjectConverter(JSONMetaDataShape shape, JSONToMetaDataObjectConverter converter);
 
 } // end namespace wasm
 } // end namespace itk
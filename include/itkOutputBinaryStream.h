@@ -19,8 +19,10 @@
 #define itkOutputBinaryStream_h
 
 #include "itkPipeline.h"
-#include "itkWasmStringStream.h"
+#include "itkGrowableStreamBuffer.h"
 
+#include <cstddef>
+#include <memory>
 #include <string>
 #ifndef ITK_WASM_NO_MEMORY_IO
 #include <sstream>
@@ -43,6 +45,11 @@ namespace wasm
  * This stream is written to the filesystem or memory when the object goes out of scope.
  * 
  * Call `Get()` to get the std::ostream & to use an output for a pipeline.
+ *
+ * With memory IO, the stream writes into a GrowableStreamBuffer whose bytes
+ * are handed to the host without a copy. `Reserve()` a known output size to
+ * avoid reallocation, and write JSON with a rapidjson writer of
+ * StreamBufferJSONOutput over `Get().rdbuf()` to bypass the iostream layer.
  * 
  * \ingroup WebAssemblyInterface
  */
@@ -63,9 +70,24 @@ public:
     m_DeleteOStream = true;
   }
 
+  /** Output size bytes at data instead of the stream contents. With memory
+   * IO the host reads them in place, without a copy, and owner, which keeps
+   * the bytes valid, lives with the output data object until the host frees
+   * the output. Otherwise they are written to the file. */
+  void SetData(const void * data, size_t size, std::shared_ptr<const void> owner);
+
   OutputBinaryStream() = default;
   ~OutputBinaryStream();
 
+  /** Expected output size in bytes, preallocated with memory IO. */
+  void Reserve(size_t size)
+  {
+    if (m_StreamBuffer)
+    {
+      m_StreamBuffer->Reserve(size);
+    }
+  }
+
   /** Output index. */
   void SetIdentifier(const std::string & identifier)
   {
@@ -73,10 +95,9 @@ public:
     {
       delete m_OStream;
     }
-    m_DeleteOStream = false;
-    m_WasmStringStream = WasmStringStream::New();
-
-    m_OStream = &(m_WasmStringStream->GetStringStream());
+    m_StreamBuffer = std::make_shared<GrowableStreamBuffer>();
+    m_OStream = new std::ostream(m_StreamBuffer.get());
+    m_DeleteOStream = true;
     this->m_Identifier = identifier;
   }
   const std::string & GetIdentifier() const
@@ -90,7 +111,11 @@ protected:
 
   std::string m_Identifier;
 
-  WasmStringStream::Pointer m_WasmStringStream;
+  std::shared_ptr<GrowableStreamBuffer> m_StreamBuffer;
+
+  const void * m_Data{nullptr};
+  size_t m_DataSize{0};
+  std::shared_ptr<const void> m_DataOwner;
 };
 
 
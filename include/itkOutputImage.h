@@ -19,14 +19,24 @@
 #define itkOutputImage_h
 
 #include "itkPipeline.h"
+#include "itkPipelineStageStore.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkWasmMapComponentType.h"
+#include "itkWasmMapPixelType.h"
+#include "itkWasmMetaDataKeyFilter.h"
+#include "itkWasmStridedView.h"
+
+#include <optional>
 
 #ifndef ITK_WASM_NO_MEMORY_IO
 #include "itkWasmExports.h"
 #include "itkWasmImage.h"
 #include "itkImageToWasmImageFilter.h"
+#include <cstring>
 #endif
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
 #include "itkImageFileWriter.h"
+#include "itkWasmLazyIOFactory.h"
 #endif
 
 namespace itk
@@ -48,6 +58,7 @@ class ITK_TEMPLATE_EXPORT OutputImage
 {
 public:
   using ImageType = TImage;
+  using RegionType = typename ImageType::RegionType;
 
   void Set(const ImageType * image) {
     this->m_Image = image;
@@ -57,6 +68,42 @@ public:
     return this->m_Image.GetPointer();
   }
 
+  /** Publish an intermediate version of the output, e.g. a coarse result,
+   * before the full result is Set, when the pipeline is run with
+   * --progressive. Otherwise it does nothing.
+   *
+   * The version is written immediately, to memory or to the output file,
+   * and signalled to the host with Pipeline::report_output_version. With
+   * memory IO, it is not written to the region bound with
+   * itk_wasm_output_array_bind, so a later version or the result that a
+   * filter writes in place is not overwritten. Returns the version number,
+   * from 1, or 0 if the version was not published. */
+  unsigned int Publish(const ImageType * image)
+  {
+    if (!Pipeline::get_progressive() || image == nullptr || this->m_Identifier.empty() || IsStageIdentifier(this->m_Identifier))
+    {
+      return 0;
+    }
+    if (wasm::Pipeline::get_use_memory_io())
+    {
+#ifndef ITK_WASM_NO_MEMORY_IO
+      WriteMemory(image, this->m_Identifier, this->m_ConvertMetaData, this->GetMetaDataKeyFilter(), wasm::Pipeline::get_memory_index(), false);
+#else
+      return 0;
+#endif
+    }
+    else
+    {
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+      WriteFile(image, this->m_Identifier, this->GetMetaDataKeyFilter());
+#else
+      return 0;
+#endif
+    }
+    Pipeline::report_output_version(this->m_Identifier, ++this->m_NumberOfVersions);
+    return this->m_NumberOfVersions;
+  }
+
   /** FileName or output index. */
   void SetIdentifier(const std::string & identifier)
   {
@@ -67,29 +114,114 @@ public:
     return this->m_Identifier;
   }
 
+  /** Direct the pixel buffer of an image to the destination region the host
+   * bound to this output with itk_wasm_output_array_bind.
+   *
+   * Call on the output of the final filter after the command line is parsed
+   * and before the filter is updated so the filter writes its result in
+   * place. Filters that replace their output pixel container, e.g. in-place
+   * filters, fall back to a copy into the bound region. Returns true if the
+   * image buffer was bound. */
+  bool BindBuffer(ImageType * image) const
+  {
+#ifndef ITK_WASM_NO_MEMORY_IO
+    if (!wasm::Pipeline::get_use_memory_io() || image == nullptr || this->m_Identifier.empty())
+    {
+      return false;
+    }
+    size_t boundAddress = 0;
+    size_t boundSize = 0;
+    const auto index = std::stoi(this->m_Identifier);
+    if (!getMemoryStoreOutputArrayBinding(wasm::Pipeline::get_memory_index(), index, 0, boundAddress, boundSize))
+    {
+      return false;
+    }
+    using ElementType = typename ImageType::PixelContainer::Element;
+    const bool letImageContainerManageMemory = false;
+    image->GetPixelContainer()->SetImportPointer(reinterpret_cast< ElementType * >(boundAddress), boundSize / sizeof(ElementType), letImageContainerManageMemory);
+    return true;
+#else
+    (void)image;
+    return false;
+#endif
+  }
+
+  /** Output only a region of the image buffered region, e.g. a crop of a
+   * resident image, instead of the buffered region. With memory IO, when
+   * the host enabled itk_wasm_use_strided_views, the region is published as
+   * a strided view of the image buffer without copying. Otherwise, and for
+   * files and pipeline stages, it is copied. Default: an empty region, for
+   * the buffered region. */
+  void SetRegion(const RegionType & region)
+  {
+    this->m_Region = region;
+  }
+  const RegionType & GetRegion() const
+  {
+    return this->m_Region;
+  }
+
+  /** Serialize the image MetaDataDictionary to memory IO outputs. Disable
+   * to skip serializing metadata the host does not use. Default: true. */
+  void SetConvertMetaData(bool convertMetaData)
+  {
+    this->m_ConvertMetaData = convertMetaData;
+  }
+  bool GetConvertMetaData() const
+  {
+    return this->m_ConvertMetaData;
+  }
+
+  /** Metadata keys of the image MetaDataDictionary that are written.
+   * Default: the Pipeline --metadata-include and --metadata-exclude
+   * patterns. */
+  void SetMetaDataKeyFilter(const MetaDataKeyFilter & keyFilter)
+  {
+    this->m_MetaDataKeyFilter = keyFilter;
+  }
+  const MetaDataKeyFilter & GetMetaDataKeyFilter() const
+  {
+    return this->m_MetaDataKeyFilter ? *this->m_MetaDataKeyFilter : Pipeline::get_metadata_key_filter();
+  }
+
   OutputImage() = default;
   ~OutputImage() {
+    Pipeline::mark_profile_compute();
+    if (IsStageIdentifier(this->m_Identifier))
+    {
+      // Passed to a later pipeline stage in the same process
+      const ProfileScope profileScope("output-image " + this->m_Identifier);
+      if (!this->m_Image.IsNull())
+      {
+        if (this->HasSubRegion())
+        {
+          this->m_Image = CopyImageRegion(this->m_Image.GetPointer(), this->m_Region);
+        }
+        using ConvertPixelTraits = DefaultConvertPixelTraits<typename ImageType::PixelType>;
+        StageDataObjectType type;
+        type.dimension = ImageType::ImageDimension;
+        type.componentType = MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString;
+        type.pixelType = MapPixelType<typename ImageType::PixelType>::PixelString;
+        type.components = this->m_Image->GetNumberOfComponentsPerPixel();
+        SetStageDataObject(this->m_Identifier, this->m_Image, type);
+        SetStageImageBuffer(this->m_Identifier, MakeStageImageBuffer(this->m_Image.GetPointer()));
+      }
+      return;
+    }
     if(wasm::Pipeline::get_use_memory_io())
     {
 #ifndef ITK_WASM_NO_MEMORY_IO
+    markMemoryPhase("compute");
     if (!this->m_Image.IsNull() && !this->m_Identifier.empty())
       {
-        using ImageToWasmImageFilterType = ImageToWasmImageFilter<ImageType>;
-        auto imageToWasmImageFilter = ImageToWasmImageFilterType::New();
-        imageToWasmImageFilter->SetInput(this->m_Image);
-        imageToWasmImageFilter->Update();
-        auto wasmImage = imageToWasmImageFilter->GetOutput();
-        const auto index = std::stoi(this->m_Identifier);
-        setMemoryStoreOutputDataObject(0, index, wasmImage);
-
-        const auto dataAddress = reinterpret_cast< size_t >( wasmImage->GetImage()->GetBufferPointer() );
-        using ConvertPixelTraits = DefaultConvertPixelTraits<typename ImageType::PixelType>;
-        const auto dataSize = wasmImage->GetImage()->GetPixelContainer()->Size() * sizeof(typename ConvertPixelTraits::ComponentType) * ConvertPixelTraits::GetNumberOfComponents();
-        setMemoryStoreOutputArray(0, index, 0, dataAddress, dataSize);
-
-        const auto directionAddress = reinterpret_cast< size_t >( wasmImage->GetImage()->GetDirection().GetVnlMatrix().begin() );
-        const auto directionSize = wasmImage->GetImage()->GetDirection().GetVnlMatrix().size() * sizeof(double);
-        setMemoryStoreOutputArray(0, index, 1, directionAddress, directionSize);
+      Pipeline::serialize_output([image = this->m_Image,
+                                  identifier = this->m_Identifier,
+                                  convertMetaData = this->m_ConvertMetaData,
+                                  keyFilter = this->GetMetaDataKeyFilter(),
+                                  memoryIndex = wasm::Pipeline::get_memory_index(),
+                                  region = this->m_Region]() {
+        WriteMemory(image, identifier, convertMetaData, keyFilter, memoryIndex, true, region);
+      });
       }
 #else
     std::cerr << "Memory IO not supported" << std::endl;
@@ -101,7 +233,9 @@ public:
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
     if (!this->m_Image.IsNull() && !this->m_Identifier.empty())
       {
-      itk::WriteImage(this->m_Image, this->m_Identifier);
+      Pipeline::serialize_output([image = this->m_Image, identifier = this->m_Identifier, keyFilter = this->GetMetaDataKeyFilter(), region = this->m_Region]() {
+        WriteFile(image, identifier, keyFilter, region);
+      });
       }
 #else
     std::cerr << "Filesystem IO not supported" << std::endl;
@@ -110,9 +244,111 @@ public:
     }
   }
 protected:
+  bool HasSubRegion() const
+  {
+    return !this->m_Image.IsNull() && this->m_Region.GetNumberOfPixels() > 0 && this->m_Region != this->m_Image->GetBufferedRegion();
+  }
+
+#ifndef ITK_WASM_NO_MEMORY_IO
+  static void WriteMemory(const ImageType * image, const std::string & identifier, bool convertMetaData, const MetaDataKeyFilter & keyFilter, uint32_t memoryIndex, bool useBinding = true, const RegionType & region = RegionType())
+  {
+    const ProfileScope profileScope("output-image " + identifier);
+    using ImageToWasmImageFilterType = ImageToWasmImageFilter<ImageType>;
+    auto imageToWasmImageFilter = ImageToWasmImageFilterType::New();
+    imageToWasmImageFilter->SetInput(image);
+    const bool useDescriptor = getMemoryStoreUseImageDescriptors(memoryIndex);
+    imageToWasmImageFilter->SetUseDescriptor(useDescriptor);
+    imageToWasmImageFilter->SetUseCBORMetaData(getMemoryStoreUseCBORMetadata(memoryIndex));
+    imageToWasmImageFilter->SetConvertMetaData(convertMetaData);
+    imageToWasmImageFilter->SetPlanarLayout(getMemoryStoreUsePlanarLayout(memoryIndex));
+    imageToWasmImageFilter->SetMetaDataKeyFilter(keyFilter);
+    imageToWasmImageFilter->SetOutputRegion(region);
+    imageToWasmImageFilter->SetUseStrides(getMemoryStoreUseStridedViews(memoryIndex));
+    imageToWasmImageFilter->Update();
+    auto wasmImage = imageToWasmImageFilter->GetOutput();
+    const auto index = std::stoi(identifier);
+    setMemoryStoreOutputDataObject(memoryIndex, index, wasmImage);
+
+    auto dataAddress = reinterpret_cast< size_t >( wasmImage->GetImage()->GetBufferPointer() );
+    using ConvertPixelTraits = DefaultConvertPixelTraits<typename ImageType::PixelType>;
+    auto dataSize = wasmImage->GetImage()->GetPixelContainer()->Size() * sizeof(typename ConvertPixelTraits::ComponentType) * ConvertPixelTraits::GetNumberOfComponents();
+    if (wasmImage->GetHasDataView())
+    {
+      // A strided view of the image buffer, which the output data object keeps
+      dataAddress = wasmImage->GetDataViewAddress();
+      dataSize = wasmImage->GetDataViewSize();
+      useBinding = false;
+    }
+    size_t boundAddress = 0;
+    size_t boundSize = 0;
+    if (useBinding && getMemoryStoreOutputArrayBinding(memoryIndex, index, 0, boundAddress, boundSize) && dataSize <= boundSize)
+    {
+      // The pixel buffer was not written in place, see BindBuffer
+      if (dataAddress != boundAddress)
+      {
+        std::memcpy(reinterpret_cast< void * >(boundAddress), reinterpret_cast< const void * >(dataAddress), dataSize);
+        ITK_WASM_COUNT_COPY(OutputStore, dataSize);
+        dataAddress = boundAddress;
+      }
+    }
+    setMemoryStoreOutputArray(memoryIndex, index, 0, dataAddress, dataSize);
+    if (useDescriptor)
+    {
+      wasm::WasmImageDescriptor descriptor = wasmImage->GetDescriptor();
+      descriptor.data = dataAddress;
+      setMemoryStoreOutputImageDescriptor(memoryIndex, index, descriptor);
+    }
+
+    const auto directionAddress = reinterpret_cast< size_t >( wasmImage->GetImage()->GetDirection().GetVnlMatrix().begin() );
+    const auto directionSize = wasmImage->GetImage()->GetDirection().GetVnlMatrix().size() * sizeof(double);
+    setMemoryStoreOutputArray(memoryIndex, index, 1, directionAddress, directionSize);
+  }
+#endif
+
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+  static void WriteFile(const ImageType * image, const std::string & fileName, const MetaDataKeyFilter & keyFilter, const RegionType & region = RegionType())
+  {
+    const ProfileScope profileScope("output-image " + fileName);
+    typename ImageType::Pointer regionImage;
+    if (region.GetNumberOfPixels() > 0 && region != image->GetBufferedRegion())
+      {
+      regionImage = CopyImageRegion(image, region);
+      image = regionImage.GetPointer();
+      }
+    using WriterType = ImageFileWriter<ImageType>;
+    auto writer = WriterType::New();
+    writer->SetFileName(fileName);
+    auto imageIO = LazyImageIOFactory::CreateIO(fileName.c_str(), CommonEnums::IOFileMode::WriteMode);
+    if (imageIO.IsNotNull())
+      {
+      writer->SetImageIO(imageIO);
+      }
+    if (keyFilter.IsEnabled())
+      {
+      // Write a view of the image with the accepted metadata
+      auto view = ImageType::New();
+      view->Graft(image);
+      MetaDataDictionary dictionary = image->GetMetaDataDictionary();
+      keyFilter.Apply(dictionary);
+      view->SetMetaDataDictionary(dictionary);
+      writer->SetInput(view);
+      writer->Update();
+      }
+    else
+      {
+      writer->SetInput(image);
+      writer->Update();
+      }
+  }
+#endif
+
   typename TImage::ConstPointer m_Image;
 
   std::string m_Identifier;
+  bool m_ConvertMetaData{true};
+  std::optional<MetaDataKeyFilter> m_MetaDataKeyFilter;
+  RegionType m_Region;
+  unsigned int m_NumberOfVersions{0};
 };
 
 template <typename TImage>
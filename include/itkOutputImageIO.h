@@ -52,6 +52,13 @@ public:
     this->m_InformationOnly = informationOnly;
   }
 
+  /** Set whether the image IO already read the image information, e.g. an
+   * image IO kept from an information-only read of the file, so it is not
+   * read again. */
+  void SetImageInformationRead(bool imageInformationRead) {
+    this->m_ImageInformationRead = imageInformationRead;
+  }
+
   void Set(ImageIOBase * imageIO) {
     this->m_ImageIO = imageIO;
   }
@@ -79,12 +86,14 @@ public:
     {
     const auto index = std::stoi(this->m_Identifier);
     auto wasmImageIOBase = itk::WasmImageIOBase::New();
+    wasmImageIOBase->SetReadPixelData(!this->m_InformationOnly);
+    wasmImageIOBase->SetImageInformationRead(this->m_ImageInformationRead);
     wasmImageIOBase->SetImageIO(this->m_ImageIO);
-    setMemoryStoreOutputDataObject(0, index, wasmImageIOBase);
+    setMemoryStoreOutputDataObject(wasm::Pipeline::get_memory_index(), index, wasmImageIOBase);
 
     const auto directionAddress = reinterpret_cast< size_t >( &(wasmImageIOBase->GetDirectionContainer()->at(0)) );
     const auto directionSize = wasmImageIOBase->GetDirectionContainer()->size() * sizeof(double);
-    setMemoryStoreOutputArray(0, index, 1, directionAddress, directionSize);
+    setMemoryStoreOutputArray(wasm::Pipeline::get_memory_index(), index, 1, directionAddress, directionSize);
 
     if (this->m_InformationOnly)
     {
@@ -93,7 +102,7 @@ public:
 
     const auto dataAddress = reinterpret_cast< size_t >( &(wasmImageIOBase->GetPixelDataContainer()->at(0)) );
     const auto dataSize = wasmImageIOBase->GetPixelDataContainer()->size();
-    setMemoryStoreOutputArray(0, index, 0, dataAddress, dataSize);
+    setMemoryStoreOutputArray(wasm::Pipeline::get_memory_index(), index, 0, dataAddress, dataSize);
 
     }
 #else
@@ -106,7 +115,10 @@ public:
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
     if (!this->m_ImageIO.IsNull() && !this->m_Identifier.empty())
     {
-      this->m_ImageIO->ReadImageInformation();
+      if (!this->m_ImageInformationRead)
+      {
+        this->m_ImageIO->ReadImageInformation();
+      }
 
       auto wasmImageIO = itk::WasmImageIO::New();
 
@@ -157,6 +169,7 @@ protected:
   std::string m_Identifier;
 
   bool m_InformationOnly{ false };
+  bool m_ImageInformationRead{ false };
 };
 
 bool lexical_cast(const std::string &input, OutputImageIO &outputImageIO)
@@ -19,6 +19,9 @@
 #define itkOutputMesh_h
 
 #include "itkPipeline.h"
+#include "itkPipelineStageStore.h"
+#include "itkWasmMapComponentType.h"
+#include "itkWasmMapPixelType.h"
 #include "itkMeshConvertPixelTraits.h"
 
 #ifndef ITK_WASM_NO_MEMORY_IO
@@ -28,6 +31,7 @@
 #endif
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
 #include "itkMeshFileWriter.h"
+#include "itkWasmLazyIOFactory.h"
 #endif
 
 namespace itk
@@ -70,50 +74,32 @@ public:
 
   OutputMesh() = default;
   ~OutputMesh() {
+    Pipeline::mark_profile_compute();
+    if (IsStageIdentifier(this->m_Identifier))
+    {
+      // Passed to a later pipeline stage in the same process
+      const ProfileScope profileScope("output-mesh " + this->m_Identifier);
+      if (!this->m_Mesh.IsNull())
+      {
+        using ConvertPixelTraits = MeshConvertPixelTraits<typename MeshType::PixelType>;
+        StageDataObjectType type;
+        type.dimension = MeshType::PointDimension;
+        type.componentType = MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString;
+        type.pixelType = MapPixelType<typename MeshType::PixelType>::PixelString;
+        type.components = ConvertPixelTraits::GetNumberOfComponents();
+        SetStageDataObject(this->m_Identifier, this->m_Mesh, type);
+      }
+      return;
+    }
     if(wasm::Pipeline::get_use_memory_io())
     {
 #ifndef ITK_WASM_NO_MEMORY_IO
+    markMemoryPhase("compute");
     if (!this->m_Mesh.IsNull() && !this->m_Identifier.empty())
       {
-        using MeshToWasmMeshFilterType = MeshToWasmMeshFilter<MeshType>;
-        auto meshToWasmMeshFilter = MeshToWasmMeshFilterType::New();
-        meshToWasmMeshFilter->SetInput(this->m_Mesh);
-        meshToWasmMeshFilter->Update();
-        auto wasmMesh = meshToWasmMeshFilter->GetOutput();
-        const auto index = std::stoi(this->m_Identifier);
-        setMemoryStoreOutputDataObject(0, index, wasmMesh);
-
-        if (this->m_Mesh->GetNumberOfPoints() > 0)
-        {
-          const auto pointsAddress = reinterpret_cast< size_t >( &(wasmMesh->GetMesh()->GetPoints()->at(0)) );
-          const auto pointsSize = wasmMesh->GetMesh()->GetPoints()->Size() * sizeof(typename MeshType::CoordRepType) * MeshType::PointDimension;
-          setMemoryStoreOutputArray(0, index, 0, pointsAddress, pointsSize);
-        }
-
-        if (this->m_Mesh->GetNumberOfCells() > 0)
-        {
-          const auto cellsAddress = reinterpret_cast< size_t >( &(wasmMesh->GetCellBuffer()->at(0)) );
-          const auto cellsSize = wasmMesh->GetCellBuffer()->Size() * sizeof(typename MeshType::CellIdentifier);
-          setMemoryStoreOutputArray(0, index, 1, cellsAddress, cellsSize);
-        }
-
-        if (this->m_Mesh->GetPointData() != nullptr && this->m_Mesh->GetPointData()->Size() > 0)
-        {
-          using PointPixelType = typename MeshType::PixelType;
-          using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
-          const auto pointDataAddress = reinterpret_cast< size_t >( &(wasmMesh->GetMesh()->GetPointData()->at(0)) );
-          const auto pointDataSize = wasmMesh->GetMesh()->GetPointData()->Size() * sizeof(typename ConvertPointPixelTraits::ComponentType) * ConvertPointPixelTraits::GetNumberOfComponents();
-          setMemoryStoreOutputArray(0, index, 2, pointDataAddress, pointDataSize);
-        }
-
-        if (this->m_Mesh->GetCellData() != nullptr && this->m_Mesh->GetCellData()->Size() > 0)
-        {
-          using CellPixelType = typename MeshType::CellPixelType;
-          using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
-          const auto cellDataAddress = reinterpret_cast< size_t >( &(wasmMesh->GetMesh()->GetCellData()->at(0)) );
-          const auto cellDataSize = wasmMesh->GetMesh()->GetCellData()->Size() * sizeof(typename ConvertCellPixelTraits::ComponentType) * ConvertCellPixelTraits::GetNumberOfComponents();
-          setMemoryStoreOutputArray(0, index, 3, cellDataAddress, cellDataSize);
-        }
+      Pipeline::serialize_output([mesh = this->m_Mesh, identifier = this->m_Identifier, memoryIndex = wasm::Pipeline::get_memory_index()]() {
+        WriteMemory(mesh, identifier, memoryIndex);
+      });
       }
 #else
     std::cerr << "Memory IO not supported" << std::endl;
@@ -125,11 +111,9 @@ public:
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
     if (!this->m_Mesh.IsNull() && !this->m_Identifier.empty())
       {
-      using MeshWriterType = itk::MeshFileWriter<TMesh>;
-      auto meshWriter = MeshWriterType::New();
-      meshWriter->SetFileName(this->m_Identifier);
-      meshWriter->SetInput(this->m_Mesh);
-      meshWriter->Update();
+      Pipeline::serialize_output([mesh = this->m_Mesh, identifier = this->m_Identifier]() {
+        WriteFile(mesh, identifier);
+      });
       }
 #else
     std::cerr << "Filesystem IO not supported" << std::endl;
@@ -138,6 +122,69 @@ public:
     }
   }
 protected:
+#ifndef ITK_WASM_NO_MEMORY_IO
+  static void WriteMemory(const MeshType * mesh, const std::string & identifier, uint32_t memoryIndex)
+  {
+    const ProfileScope profileScope("output-mesh " + identifier);
+    using MeshToWasmMeshFilterType = MeshToWasmMeshFilter<MeshType>;
+    auto meshToWasmMeshFilter = MeshToWasmMeshFilterType::New();
+    meshToWasmMeshFilter->SetInput(mesh);
+    meshToWasmMeshFilter->Update();
+    auto wasmMesh = meshToWasmMeshFilter->GetOutput();
+    const auto index = std::stoi(identifier);
+    setMemoryStoreOutputDataObject(memoryIndex, index, wasmMesh);
+
+    if (mesh->GetNumberOfPoints() > 0)
+    {
+      const auto pointsAddress = reinterpret_cast< size_t >( &(wasmMesh->GetMesh()->GetPoints()->at(0)) );
+      const auto pointsSize = wasmMesh->GetMesh()->GetPoints()->Size() * sizeof(typename MeshType::CoordRepType) * MeshType::PointDimension;
+      setMemoryStoreOutputArray(memoryIndex, index, 0, pointsAddress, pointsSize);
+    }
+
+    if (mesh->GetNumberOfCells() > 0)
+    {
+      const auto cellsAddress = reinterpret_cast< size_t >( &(wasmMesh->GetCellBuffer()->at(0)) );
+      const auto cellsSize = wasmMesh->GetCellBuffer()->Size() * sizeof(typename MeshType::CellIdentifier);
+      setMemoryStoreOutputArray(memoryIndex, index, 1, cellsAddress, cellsSize);
+    }
+
+    if (mesh->GetPointData() != nullptr && mesh->GetPointData()->Size() > 0)
+    {
+      using PointPixelType = typename MeshType::PixelType;
+      using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
+      const auto pointDataAddress = reinterpret_cast< size_t >( &(wasmMesh->GetMesh()->GetPointData()->at(0)) );
+      const auto pointDataSize = wasmMesh->GetMesh()->GetPointData()->Size() * sizeof(typename ConvertPointPixelTraits::ComponentType) * ConvertPointPixelTraits::GetNumberOfComponents();
+      setMemoryStoreOutputArray(memoryIndex, index, 2, pointDataAddress, pointDataSize);
+    }
+
+    if (mesh->GetCellData() != nullptr && mesh->GetCellData()->Size() > 0)
+    {
+      using CellPixelType = typename MeshType::CellPixelType;
+      using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
+      const auto cellDataAddress = reinterpret_cast< size_t >( &(wasmMesh->GetMesh()->GetCellData()->at(0)) );
+      const auto cellDataSize = wasmMesh->GetMesh()->GetCellData()->Size() * sizeof(typename ConvertCellPixelTraits::ComponentType) * ConvertCellPixelTraits::GetNumberOfComponents();
+      setMemoryStoreOutputArray(memoryIndex, index, 3, cellDataAddress, cellDataSize);
+    }
+  }
+#endif
+
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+  static void WriteFile(const MeshType * mesh, const std::string & fileName)
+  {
+    const ProfileScope profileScope("output-mesh " + fileName);
+    using MeshWriterType = itk::MeshFileWriter<TMesh>;
+    auto meshWriter = MeshWriterType::New();
+    meshWriter->SetFileName(fileName);
+    meshWriter->SetInput(mesh);
+    auto meshIO = LazyMeshIOFactory::CreateIO(fileName.c_str(), CommonEnums::IOFileMode::WriteMode);
+    if (meshIO.IsNotNull())
+    {
+      meshWriter->SetMeshIO(meshIO);
+    }
+    meshWriter->Update();
+  }
+#endif
+
   typename TMesh::ConstPointer m_Mesh;
 
   std::string m_Identifier;
@@ -79,7 +79,7 @@ public:
     const auto index = std::stoi(this->m_Identifier);
     auto wasmMeshIOBase = itk::WasmMeshIOBase::New();
     wasmMeshIOBase->SetMeshIO(this->m_MeshIO);
-    setMemoryStoreOutputDataObject(0, index, wasmMeshIOBase);
+    setMemoryStoreOutputDataObject(wasm::Pipeline::get_memory_index(), index, wasmMeshIOBase);
 
     if (this->m_InformationOnly)
     {
@@ -90,28 +90,28 @@ public:
     if (pointsSize)
     {
       const auto pointsAddress = reinterpret_cast< size_t >( &(wasmMeshIOBase->GetPointsContainer()->at(0)) );
-      setMemoryStoreOutputArray(0, index, 0, pointsAddress, pointsSize);
+      setMemoryStoreOutputArray(wasm::Pipeline::get_memory_index(), index, 0, pointsAddress, pointsSize);
     }
 
     const auto cellsSize = wasmMeshIOBase->GetCellsContainer()->size();
     if (cellsSize)
     {
       const auto cellsAddress = reinterpret_cast< size_t >( &(wasmMeshIOBase->GetCellsContainer()->at(0)) );
-      setMemoryStoreOutputArray(0, index, 1, cellsAddress, cellsSize);
+      setMemoryStoreOutputArray(wasm::Pipeline::get_memory_index(), index, 1, cellsAddress, cellsSize);
     }
 
     const auto pointDataSize = wasmMeshIOBase->GetPointDataContainer()->size();
     if (pointDataSize)
     {
       const auto pointDataAddress = reinterpret_cast< size_t >( &(wasmMeshIOBase->GetPointDataContainer()->at(0)) );
-      setMemoryStoreOutputArray(0, index, 2, pointDataAddress, pointDataSize);
+      setMemoryStoreOutputArray(wasm::Pipeline::get_memory_index(), index, 2, pointDataAddress, pointDataSize);
     }
 
     const auto cellDataSize = wasmMeshIOBase->GetCellDataContainer()->size();
     if (cellDataSize)
     {
       const auto cellDataAddress = reinterpret_cast< size_t >( &(wasmMeshIOBase->GetCellDataContainer()->at(0)) );
-      setMemoryStoreOutputArray(0, index, 3, cellDataAddress, cellDataSize);
+      setMemoryStoreOutputArray(wasm::Pipeline::get_memory_index(), index, 3, cellDataAddress, cellDataSize);
     }
 
     }
@@ -0,0 +1,200 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkOutputPointSet_h
+#define itkOutputPointSet_h
+
+#include "itkPipeline.h"
+#include "itkPipelineStageStore.h"
+#include "itkWasmMapComponentType.h"
+#include "itkWasmMapPixelType.h"
+#include "itkMeshConvertPixelTraits.h"
+
+#ifndef ITK_WASM_NO_MEMORY_IO
+#include "itkWasmExports.h"
+#include "itkWasmPointSet.h"
+#include "itkPointSetToWasmPointSetFilter.h"
+#endif
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+#include "itkMesh.h"
+#include "itkMeshFileWriter.h"
+#include "itkWasmLazyIOFactory.h"
+#endif
+
+namespace itk
+{
+namespace wasm
+{
+/**
+ *\class OutputPointSet
+ * \brief Output point set for an itk::wasm::Pipeline
+ *
+ * This point set is written to the filesystem or memory when it goes out of scope.
+ *
+ * Call `Get()` to get the TPointSet * to use an input to a pipeline.
+ *
+ * In memory, the points and point data are referenced in place, without a
+ * copy. Files are written as a mesh without cells that shares the point set
+ * containers.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+template <typename TPointSet>
+class ITK_TEMPLATE_EXPORT OutputPointSet
+{
+public:
+  using PointSetType = TPointSet;
+
+  void Set(const PointSetType * pointSet) {
+    this->m_PointSet = pointSet;
+  }
+
+  const PointSetType * Get() const {
+    return this->m_PointSet.GetPointer();
+  }
+
+  /** FileName or output index. */
+  void SetIdentifier(const std::string & identifier)
+  {
+    this->m_Identifier = identifier;
+  }
+  const std::string & GetIdentifier() const
+  {
+    return this->m_Identifier;
+  }
+
+  OutputPointSet() = default;
+  ~OutputPointSet() {
+    Pipeline::mark_profile_compute();
+    if (IsStageIdentifier(this->m_Identifier))
+    {
+      // Passed to a later pipeline stage in the same process
+      const ProfileScope profileScope("output-point-set " + this->m_Identifier);
+      if (!this->m_PointSet.IsNull())
+      {
+        using ConvertPixelTraits = MeshConvertPixelTraits<typename PointSetType::PixelType>;
+        StageDataObjectType type;
+        type.dimension = PointSetType::PointDimension;
+        type.componentType = MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString;
+        type.pixelType = MapPixelType<typename PointSetType::PixelType>::PixelString;
+        type.components = ConvertPixelTraits::GetNumberOfComponents();
+        SetStageDataObject(this->m_Identifier, this->m_PointSet, type);
+      }
+      return;
+    }
+    if(wasm::Pipeline::get_use_memory_io())
+    {
+#ifndef ITK_WASM_NO_MEMORY_IO
+    markMemoryPhase("compute");
+    if (!this->m_PointSet.IsNull() && !this->m_Identifier.empty())
+      {
+      Pipeline::serialize_output([pointSet = this->m_PointSet, identifier = this->m_Identifier, memoryIndex = wasm::Pipeline::get_memory_index()]() {
+        WriteMemory(pointSet, identifier, memoryIndex);
+      });
+      }
+#else
+    std::cerr << "Memory IO not supported" << std::endl;
+    abort();
+#endif
+    }
+    else
+    {
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+    if (!this->m_PointSet.IsNull() && !this->m_Identifier.empty())
+      {
+      Pipeline::serialize_output([pointSet = this->m_PointSet, identifier = this->m_Identifier]() {
+        WriteFile(pointSet, identifier);
+      });
+      }
+#else
+    std::cerr << "Filesystem IO not supported" << std::endl;
+    abort();
+#endif
+    }
+  }
+protected:
+#ifndef ITK_WASM_NO_MEMORY_IO
+  static void WriteMemory(const PointSetType * pointSet, const std::string & identifier, uint32_t memoryIndex)
+  {
+    const ProfileScope profileScope("output-point-set " + identifier);
+    using PointSetToWasmPointSetFilterType = PointSetToWasmPointSetFilter<PointSetType>;
+    auto pointSetToWasmPointSetFilter = PointSetToWasmPointSetFilterType::New();
+    pointSetToWasmPointSetFilter->SetInput(pointSet);
+    pointSetToWasmPointSetFilter->Update();
+    auto wasmPointSet = pointSetToWasmPointSetFilter->GetOutput();
+    const auto index = std::stoi(identifier);
+    setMemoryStoreOutputDataObject(memoryIndex, index, wasmPointSet);
+
+    if (pointSet->GetNumberOfPoints() > 0)
+    {
+      const auto pointsAddress = reinterpret_cast< size_t >( &(pointSet->GetPoints()->at(0)) );
+      const auto pointsSize = pointSet->GetPoints()->Size() * sizeof(typename PointSetType::CoordRepType) * PointSetType::PointDimension;
+      setMemoryStoreOutputArray(memoryIndex, index, 0, pointsAddress, pointsSize);
+    }
+
+    if (pointSet->GetPointData() != nullptr && pointSet->GetPointData()->Size() > 0)
+    {
+      using PointPixelType = typename PointSetType::PixelType;
+      using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
+      const auto pointDataAddress = reinterpret_cast< size_t >( &(pointSet->GetPointData()->at(0)) );
+      const auto pointDataSize = pointSet->GetPointData()->Size() * sizeof(typename ConvertPointPixelTraits::ComponentType) * ConvertPointPixelTraits::GetNumberOfComponents();
+      setMemoryStoreOutputArray(memoryIndex, index, 1, pointDataAddress, pointDataSize);
+    }
+  }
+#endif
+
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+  static void WriteFile(const PointSetType * pointSet, const std::string & fileName)
+  {
+    const ProfileScope profileScope("output-point-set " + fileName);
+    // The mesh shares the point set containers, so they are not copied
+    using MeshType = Mesh<typename PointSetType::PixelType, PointSetType::PointDimension, typename PointSetType::MeshTraits>;
+    auto mesh = MeshType::New();
+    mesh->SetPoints(const_cast<typename PointSetType::PointsContainer *>(pointSet->GetPoints()));
+    if (pointSet->GetPointData() != nullptr)
+    {
+      mesh->SetPointData(const_cast<typename PointSetType::PointDataContainer *>(pointSet->GetPointData()));
+    }
+    using MeshWriterType = itk::MeshFileWriter<MeshType>;
+    auto meshWriter = MeshWriterType::New();
+    meshWriter->SetFileName(fileName);
+    meshWriter->SetInput(mesh);
+    auto meshIO = LazyMeshIOFactory::CreateIO(fileName.c_str(), CommonEnums::IOFileMode::WriteMode);
+    if (meshIO.IsNotNull())
+    {
+      meshWriter->SetMeshIO(meshIO);
+    }
+    meshWriter->Update();
+  }
+#endif
+
+  typename TPointSet::ConstPointer m_PointSet;
+
+  std::string m_Identifier;
+};
+
+template <typename TPointSet>
+bool lexical_cast(const std::string &input, OutputPointSet<TPointSet> &outputPointSet)
+{
+  outputPointSet.SetIdentifier(input);
+  return true;
+}
+
+} // namespace wasm
+} // namespace itk
+
+#endif
@@ -19,6 +19,9 @@
 #define itkOutputPolyData_h
 
 #include "itkPipeline.h"
+#include "itkPipelineStageStore.h"
+#include "itkWasmMapComponentType.h"
+#include "itkWasmMapPixelType.h"
 #include "itkMeshConvertPixelTraits.h"
 
 #ifndef ITK_WASM_NO_MEMORY_IO
@@ -29,6 +32,7 @@
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
 #include "itkMeshFileWriter.h"
 #include "itkPolyDataToMeshFilter.h"
+#include "itkWasmLazyIOFactory.h"
 #endif
 
 namespace itk
@@ -71,71 +75,32 @@ public:
 
   OutputPolyData() = default;
   ~OutputPolyData() {
+    Pipeline::mark_profile_compute();
+    if (IsStageIdentifier(this->m_Identifier))
+    {
+      // Passed to a later pipeline stage in the same process
+      const ProfileScope profileScope("output-polydata " + this->m_Identifier);
+      if (!this->m_PolyData.IsNull())
+      {
+        using ConvertPixelTraits = MeshConvertPixelTraits<typename PolyDataType::PixelType>;
+        StageDataObjectType type;
+        type.dimension = 3;
+        type.componentType = MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString;
+        type.pixelType = MapPixelType<typename PolyDataType::PixelType>::PixelString;
+        type.components = ConvertPixelTraits::GetNumberOfComponents();
+        SetStageDataObject(this->m_Identifier, this->m_PolyData, type);
+      }
+      return;
+    }
     if(wasm::Pipeline::get_use_memory_io())
     {
 #ifndef ITK_WASM_NO_MEMORY_IO
+    markMemoryPhase("compute");
     if (!this->m_PolyData.IsNull() && !this->m_Identifier.empty())
       {
-        using PolyDataToWasmPolyDataFilterType = PolyDataToWasmPolyDataFilter<PolyDataType>;
-        auto polyDataToWasmPolyDataFilter = PolyDataToWasmPolyDataFilterType::New();
-        polyDataToWasmPolyDataFilter->SetInput(this->m_PolyData);
-        polyDataToWasmPolyDataFilter->Update();
-        auto wasmPolyData = polyDataToWasmPolyDataFilter->GetOutput();
-        const auto index = std::stoi(this->m_Identifier);
-        setMemoryStoreOutputDataObject(0, index, wasmPolyData);
-
-        if (this->m_PolyData->GetNumberOfPoints() > 0)
-        {
-          const auto pointsAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetPoints()->at(0)) );
-          const auto pointsSize = wasmPolyData->GetPolyData()->GetPoints()->Size() * PolyDataType::PointDimension * sizeof(typename PolyDataType::CoordRepType);
-          setMemoryStoreOutputArray(0, index, 0, pointsAddress, pointsSize);
-        }
-
-        if (this->m_PolyData->GetVertices() && this->m_PolyData->GetVertices()->Size() > 0)
-        {
-          const auto verticesAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetVertices()->at(0)) );
-          const auto verticesSize = wasmPolyData->GetPolyData()->GetVertices()->Size() * sizeof(uint32_t);
-          setMemoryStoreOutputArray(0, index, 1, verticesAddress, verticesSize);
-        }
-
-        if (this->m_PolyData->GetLines() && this->m_PolyData->GetLines()->Size() > 0)
-        {
-          const auto linesAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetLines()->at(0)) );
-          const auto linesSize = wasmPolyData->GetPolyData()->GetLines()->Size() * sizeof(uint32_t);
-          setMemoryStoreOutputArray(0, index, 2, linesAddress, linesSize);
-        }
-
-        if (this->m_PolyData->GetPolygons() && this->m_PolyData->GetPolygons()->Size() > 0)
-        {
-          const auto polygonsAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetPolygons()->at(0)) );
-          const auto polygonsSize = wasmPolyData->GetPolyData()->GetPolygons()->Size() * sizeof(uint32_t);
-          setMemoryStoreOutputArray(0, index, 3, polygonsAddress, polygonsSize);
-        }
-
-        if (this->m_PolyData->GetTriangleStrips() && this->m_PolyData->GetTriangleStrips()->Size() > 0)
-        {
-          const auto triangleStripsAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetTriangleStrips()->at(0)) );
-          const auto triangleStripsSize = wasmPolyData->GetPolyData()->GetTriangleStrips()->Size() * sizeof(uint32_t);
-          setMemoryStoreOutputArray(0, index, 4, triangleStripsAddress, triangleStripsSize);
-        }
-
-        if (this->m_PolyData->GetPointData() != nullptr && this->m_PolyData->GetPointData()->Size() > 0)
-        {
-          using PointPixelType = typename PolyDataType::PixelType;
-          using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
-          const auto pointDataAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetPointData()->at(0)) );
-          const auto pointDataSize = wasmPolyData->GetPolyData()->GetPointData()->Size() * sizeof(typename ConvertPointPixelTraits::ComponentType) * ConvertPointPixelTraits::GetNumberOfComponents();
-          setMemoryStoreOutputArray(0, index, 5, pointDataAddress, pointDataSize);
-        }
-
-        if (this->m_PolyData->GetCellData() != nullptr && this->m_PolyData->GetCellData()->Size() > 0)
-        {
-          using CellPixelType = typename PolyDataType::CellPixelType;
-          using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
-          const auto cellDataAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetCellData()->at(0)) );
-          const auto cellDataSize = wasmPolyData->GetPolyData()->GetCellData()->Size() * sizeof(typename ConvertCellPixelTraits::ComponentType) * ConvertCellPixelTraits::GetNumberOfComponents();
-          setMemoryStoreOutputArray(0, index, 6, cellDataAddress, cellDataSize);
-        }
+      Pipeline::serialize_output([polyData = this->m_PolyData, identifier = this->m_Identifier, memoryIndex = wasm::Pipeline::get_memory_index()]() {
+        WriteMemory(polyData, identifier, memoryIndex);
+      });
       }
 #else
     std::cerr << "Memory IO not supported" << std::endl;
@@ -147,15 +112,9 @@ public:
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
     if (!this->m_PolyData.IsNull() && !this->m_Identifier.empty())
       {
-      using PolyDataToMeshFilterType = PolyDataToMeshFilter<TPolyData>;
-      auto polyDataToMeshFilter = PolyDataToMeshFilterType::New();
-      polyDataToMeshFilter->SetInput(this->m_PolyData);
-      using MeshType = typename PolyDataToMeshFilterType::OutputMeshType;
-      using MeshWriterType = MeshFileWriter<MeshType>;
-      auto meshWriter = MeshWriterType::New();
-      meshWriter->SetFileName(this->m_Identifier);
-      meshWriter->SetInput(polyDataToMeshFilter->GetOutput());
-      meshWriter->Update();
+      Pipeline::serialize_output([polyData = this->m_PolyData, identifier = this->m_Identifier]() {
+        WriteFile(polyData, identifier);
+      });
       }
 #else
     std::cerr << "Filesystem IO not supported" << std::endl;
@@ -164,6 +123,94 @@ public:
     }
   }
 protected:
+#ifndef ITK_WASM_NO_MEMORY_IO
+  static void WriteMemory(const PolyDataType * polyData, const std::string & identifier, uint32_t memoryIndex)
+  {
+    const ProfileScope profileScope("output-polydata " + identifier);
+    using PolyDataToWasmPolyDataFilterType = PolyDataToWasmPolyDataFilter<PolyDataType>;
+    auto polyDataToWasmPolyDataFilter = PolyDataToWasmPolyDataFilterType::New();
+    polyDataToWasmPolyDataFilter->SetInput(polyData);
+    polyDataToWasmPolyDataFilter->Update();
+    auto wasmPolyData = polyDataToWasmPolyDataFilter->GetOutput();
+    const auto index = std::stoi(identifier);
+    setMemoryStoreOutputDataObject(memoryIndex, index, wasmPolyData);
+
+    if (polyData->GetNumberOfPoints() > 0)
+    {
+      const auto pointsAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetPoints()->at(0)) );
+      const auto pointsSize = wasmPolyData->GetPolyData()->GetPoints()->Size() * PolyDataType::PointDimension * sizeof(typename PolyDataType::CoordRepType);
+      setMemoryStoreOutputArray(memoryIndex, index, 0, pointsAddress, pointsSize);
+    }
+
+    if (polyData->GetVertices() && polyData->GetVertices()->Size() > 0)
+    {
+      const auto verticesAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetVertices()->at(0)) );
+      const auto verticesSize = wasmPolyData->GetPolyData()->GetVertices()->Size() * sizeof(uint32_t);
+      setMemoryStoreOutputArray(memoryIndex, index, 1, verticesAddress, verticesSize);
+    }
+
+    if (polyData->GetLines() && polyData->GetLines()->Size() > 0)
+    {
+      const auto linesAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetLines()->at(0)) );
+      const auto linesSize = wasmPolyData->GetPolyData()->GetLines()->Size() * sizeof(uint32_t);
+      setMemoryStoreOutputArray(memoryIndex, index, 2, linesAddress, linesSize);
+    }
+
+    if (polyData->GetPolygons() && polyData->GetPolygons()->Size() > 0)
+    {
+      const auto polygonsAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetPolygons()->at(0)) );
+      const auto polygonsSize = wasmPolyData->GetPolyData()->GetPolygons()->Size() * sizeof(uint32_t);
+      setMemoryStoreOutputArray(memoryIndex, index, 3, polygonsAddress, polygonsSize);
+    }
+
+    if (polyData->GetTriangleStrips() && polyData->GetTriangleStrips()->Size() > 0)
+    {
+      const auto triangleStripsAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetTriangleStrips()->at(0)) );
+      const auto triangleStripsSize = wasmPolyData->GetPolyData()->GetTriangleStrips()->Size() * sizeof(uint32_t);
+      setMemoryStoreOutputArray(memoryIndex, index, 4, triangleStripsAddress, triangleStripsSize);
+    }
+
+    if (polyData->GetPointData() != nullptr && polyData->GetPointData()->Size() > 0)
+    {
+      using PointPixelType = typename PolyDataType::PixelType;
+      using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
+      const auto pointDataAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetPointData()->at(0)) );
+      const auto pointDataSize = wasmPolyData->GetPolyData()->GetPointData()->Size() * sizeof(typename ConvertPointPixelTraits::ComponentType) * ConvertPointPixelTraits::GetNumberOfComponents();
+      setMemoryStoreOutputArray(memoryIndex, index, 5, pointDataAddress, pointDataSize);
+    }
+
+    if (polyData->GetCellData() != nullptr && polyData->GetCellData()->Size() > 0)
+    {
+      using CellPixelType = typename PolyDataType::CellPixelType;
+      using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
+      const auto cellDataAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetCellData()->at(0)) );
+      const auto cellDataSize = wasmPolyData->GetPolyData()->GetCellData()->Size() * sizeof(typename ConvertCellPixelTraits::ComponentType) * ConvertCellPixelTraits::GetNumberOfComponents();
+      setMemoryStoreOutputArray(memoryIndex, index, 6, cellDataAddress, cellDataSize);
+    }
+  }
+#endif
+
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+  static void WriteFile(const PolyDataType * polyData, const std::string & fileName)
+  {
+    const ProfileScope profileScope("output-polydata " + fileName);
+    using PolyDataToMeshFilterType = PolyDataToMeshFilter<TPolyData>;
+    auto polyDataToMeshFilter = PolyDataToMeshFilterType::New();
+    polyDataToMeshFilter->SetInput(polyData);
+    using MeshType = typename PolyDataToMeshFilterType::OutputMeshType;
+    using MeshWriterType = MeshFileWriter<MeshType>;
+    auto meshWriter = MeshWriterType::New();
+    meshWriter->SetFileName(fileName);
+    meshWriter->SetInput(polyDataToMeshFilter->GetOutput());
+    auto meshIO = LazyMeshIOFactory::CreateIO(fileName.c_str(), CommonEnums::IOFileMode::WriteMode);
+    if (meshIO.IsNotNull())
+    {
+      meshWriter->SetMeshIO(meshIO);
+    }
+    meshWriter->Update();
+  }
+#endif
+
   typename TPolyData::ConstPointer m_PolyData;
 
   std::string m_Identifier;
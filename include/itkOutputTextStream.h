@@ -19,8 +19,10 @@
 #define itkOutputTextStream_h
 
 #include "itkPipeline.h"
-#include "itkWasmStringStream.h"
+#include "itkGrowableStreamBuffer.h"
 
+#include <cstddef>
+#include <memory>
 #include <string>
 #ifndef ITK_WASM_NO_MEMORY_IO
 #include <sstream>
@@ -43,6 +45,11 @@ namespace wasm
  * This stream is written to the filesystem or memory when the object goes out of scope.
  * 
  * Call `Get()` to get the std::ostream & to use an output for a pipeline.
+ *
+ * With memory IO, the stream writes into a GrowableStreamBuffer whose bytes
+ * are handed to the host without a copy. `Reserve()` a known output size to
+ * avoid reallocation, and write JSON with a rapidjson writer of
+ * StreamBufferJSONOutput over `Get().rdbuf()` to bypass the iostream layer.
  * 
  * \ingroup WebAssemblyInterface
  */
@@ -66,6 +73,15 @@ public:
   OutputTextStream() = default;
   ~OutputTextStream();
 
+  /** Expected output size in bytes, preallocated with memory IO. */
+  void Reserve(size_t size)
+  {
+    if (m_StreamBuffer)
+    {
+      m_StreamBuffer->Reserve(size);
+    }
+  }
+
   /** Output index. */
   void SetIdentifier(const std::string & identifier)
   {
@@ -73,10 +89,9 @@ public:
     {
       delete m_OStream;
     }
-    m_DeleteOStream = false;
-    m_WasmStringStream = WasmStringStream::New();
-
-    m_OStream = &(m_WasmStringStream->GetStringStream());
+    m_StreamBuffer = std::make_shared<GrowableStreamBuffer>();
+    m_OStream = new std::ostream(m_StreamBuffer.get());
+    m_DeleteOStream = true;
     this->m_Identifier = identifier;
   }
   const std::string & GetIdentifier() const
@@ -90,7 +105,7 @@ protected:
 
   std::string m_Identifier;
 
-  WasmStringStream::Pointer m_WasmStringStream;
+  std::shared_ptr<GrowableStreamBuffer> m_StreamBuffer;
 };
 
 
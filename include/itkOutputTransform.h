@@ -0,0 +1,190 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkOutputTransform_h
+#define itkOutputTransform_h
+
+#include "itkPipeline.h"
+#include "itkPipelineStageStore.h"
+#include "itkWasmMapComponentType.h"
+#include "itkDataObjectDecorator.h"
+#include "itkTransformBase.h"
+
+#ifndef ITK_WASM_NO_MEMORY_IO
+#include "itkWasmExports.h"
+#include "itkWasmTransform.h"
+#include "itkTransformToWasmTransformFilter.h"
+#endif
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+#include "itkTransformFileWriter.h"
+#endif
+
+namespace itk
+{
+namespace wasm
+{
+/**
+ *\class OutputTransform
+ * \brief Output transform for an itk::wasm::Pipeline
+ *
+ * This transform is written to the filesystem or memory when it goes out of scope.
+ *
+ * Call `Get()` to get the TTransform * to use an input to a pipeline.
+ *
+ * In memory, the fixed parameters and parameters are referenced in place,
+ * without a copy, including the displacement field buffer of a displacement
+ * field transform.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+template <typename TTransform>
+class ITK_TEMPLATE_EXPORT OutputTransform
+{
+public:
+  using TransformType = TTransform;
+
+  void Set(const TransformType * transform) {
+    this->m_Transform = transform;
+  }
+
+  const TransformType * Get() const {
+    return this->m_Transform.GetPointer();
+  }
+
+  /** FileName or output index. */
+  void SetIdentifier(const std::string & identifier)
+  {
+    this->m_Identifier = identifier;
+  }
+  const std::string & GetIdentifier() const
+  {
+    return this->m_Identifier;
+  }
+
+  OutputTransform() = default;
+  ~OutputTransform() {
+    Pipeline::mark_profile_compute();
+    if (IsStageIdentifier(this->m_Identifier))
+    {
+      // Passed to a later pipeline stage in the same process
+      const ProfileScope profileScope("output-transform " + this->m_Identifier);
+      if (!this->m_Transform.IsNull())
+      {
+        // Decorated as a TransformBase, so later stages may take any
+        // transform base class
+        using TransformBaseType = TransformBaseTemplate<typename TransformType::ParametersValueType>;
+        auto decoratedTransform = DataObjectDecorator<TransformBaseType>::New();
+        decoratedTransform->Set(this->m_Transform.GetPointer());
+        StageDataObjectType type;
+        type.dimension = TransformType::InputSpaceDimension;
+        type.componentType = MapComponentType<typename TransformType::ParametersValueType>::ComponentString;
+        type.pixelType = this->m_Transform->GetNameOfClass();
+        type.components = TransformType::OutputSpaceDimension;
+        SetStageDataObject(this->m_Identifier, decoratedTransform, type);
+      }
+      return;
+    }
+    if(wasm::Pipeline::get_use_memory_io())
+    {
+#ifndef ITK_WASM_NO_MEMORY_IO
+    markMemoryPhase("compute");
+    if (!this->m_Transform.IsNull() && !this->m_Identifier.empty())
+      {
+      Pipeline::serialize_output([transform = this->m_Transform, identifier = this->m_Identifier, memoryIndex = wasm::Pipeline::get_memory_index()]() {
+        WriteMemory(transform, identifier, memoryIndex);
+      });
+      }
+#else
+    std::cerr << "Memory IO not supported" << std::endl;
+    abort();
+#endif
+    }
+    else
+    {
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+    if (!this->m_Transform.IsNull() && !this->m_Identifier.empty())
+      {
+      Pipeline::serialize_output([transform = this->m_Transform, identifier = this->m_Identifier]() {
+        WriteFile(transform, identifier);
+      });
+      }
+#else
+    std::cerr << "Filesystem IO not supported" << std::endl;
+    abort();
+#endif
+    }
+  }
+protected:
+#ifndef ITK_WASM_NO_MEMORY_IO
+  static void WriteMemory(const TransformType * transform, const std::string & identifier, uint32_t memoryIndex)
+  {
+    const ProfileScope profileScope("output-transform " + identifier);
+    using TransformToWasmTransformFilterType = TransformToWasmTransformFilter<TransformType>;
+    auto transformToWasmTransformFilter = TransformToWasmTransformFilterType::New();
+    transformToWasmTransformFilter->SetInput(transform);
+    transformToWasmTransformFilter->Update();
+    auto wasmTransform = transformToWasmTransformFilter->GetOutput();
+    const auto index = std::stoi(identifier);
+    setMemoryStoreOutputDataObject(memoryIndex, index, wasmTransform);
+
+    using ParametersValueType = typename TransformType::ParametersValueType;
+    const auto & fixedParameters = transform->GetFixedParameters();
+    if (fixedParameters.Size() > 0)
+    {
+      const auto fixedParametersAddress = reinterpret_cast< size_t >( fixedParameters.data_block() );
+      const auto fixedParametersSize = fixedParameters.Size() * sizeof(typename TransformType::FixedParametersValueType);
+      setMemoryStoreOutputArray(memoryIndex, index, 0, fixedParametersAddress, fixedParametersSize);
+    }
+
+    const auto & parameters = transform->GetParameters();
+    if (parameters.Size() > 0)
+    {
+      const auto parametersAddress = reinterpret_cast< size_t >( parameters.data_block() );
+      const auto parametersSize = parameters.Size() * sizeof(ParametersValueType);
+      setMemoryStoreOutputArray(memoryIndex, index, 1, parametersAddress, parametersSize);
+    }
+  }
+#endif
+
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+  static void WriteFile(const TransformType * transform, const std::string & fileName)
+  {
+    const ProfileScope profileScope("output-transform " + fileName);
+    using TransformWriterType = itk::TransformFileWriterTemplate<typename TransformType::ParametersValueType>;
+    auto transformWriter = TransformWriterType::New();
+    transformWriter->SetFileName(fileName);
+    transformWriter->SetInput(transform);
+    transformWriter->Update();
+  }
+#endif
+
+  typename TTransform::ConstPointer m_Transform;
+
+  std::string m_Identifier;
+};
+
+template <typename TTransform>
+bool lexical_cast(const std::string &input, OutputTransform<TTransform> &outputTransform)
+{
+  outputTransform.SetIdentifier(input);
+  return true;
+}
+
+} // namespace wasm
+} // namespace itk
+
+#endif
@@ -25,11 +25,23 @@
 #include "itkMacro.h"
 #include "itkImage.h"
 #include "itkVectorImage.h"
+#include "itkProcessObject.h"
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+#include "itkImageIOBase.h"
+#include "itkMeshIOBase.h"
+#endif
 
 #include "rapidjson/document.h"
 
+#include "itkWasmComponentConversion.h"
+#include "itkWasmMetaDataKeyFilter.h"
+
 #include "WebAssemblyInterfaceExport.h"
 
+#include <chrono>
+#include <functional>
+#include <memory>
+
 
 // Short circuit help output without raising an exception (currently not
 // available in WASI)
@@ -56,6 +68,10 @@
               std::exit(0); \
             } \
           } \
+        if ((pipeline).restore_cached_result()) \
+        { \
+          return EXIT_SUCCESS; \
+        } \
         (pipeline).parse(); \
     } catch(const CLI::ParseError &e) { \
         return (pipeline).exit(e); \
@@ -147,15 +163,139 @@ public:
     /** Exit. */
     auto exit(const CLI::Error &e) -> int;
 
-    void parse() {
-        CLI::App::parse(m_argc, m_argv);
-    }
+    void parse();
 
     static auto get_use_memory_io()
     {
       return m_UseMemoryIO;
     }
 
+    /** Whether per-phase wall-clock timings are reported, see ProfileScope. */
+    static auto get_profile()
+    {
+      return m_Profile;
+    }
+
+    /** Memory budget of the run in bytes, set with --max-memory, or 0 for no
+     * budget. Pipelines that can divide their work compare their estimated
+     * peak memory with the budget and, when it is over the budget, run in
+     * as many pieces as needed, see LargestPieceWithinBudget. */
+    static auto get_max_memory()
+    {
+      return m_MaxMemory;
+    }
+
+    /** Metadata keys of the images read and written with the
+     * --metadata-include and --metadata-exclude patterns, used by the
+     * InputImage's and OutputImage's without their own filter. */
+    static const MetaDataKeyFilter & get_metadata_key_filter()
+    {
+      return m_MetaDataKeyFilter;
+    }
+
+    /** Component types of memory IO input images converted on import, set
+     * by SupportInputImageTypes. ComponentConversion::None by default. */
+    static auto get_component_conversion()
+    {
+      return m_ComponentConversion;
+    }
+    static void set_component_conversion(ComponentConversion conversion)
+    {
+      m_ComponentConversion = conversion;
+    }
+
+    /** Report the progress of a filter while it runs when the pipeline is
+     * run with --progress. Call before the filter is updated.
+     *
+     * Progress is forwarded as a JSON line on stderr, e.g.
+     * `{"filter":"DiscreteGaussianImageFilter","progress":0.42}`, at most
+     * every 100 ms. WebAssembly builds with ITK_WASM_PROGRESS_IMPORT call
+     * the host function `itk_wasm.progress(memoryIndex, progress)` instead. */
+    void observe_progress(ProcessObject * filter);
+
+    /** Whether outputs publish intermediate versions, e.g. a coarse result
+     * before the full result, set with --progressive. See
+     * OutputImage::Publish. */
+    static auto get_progressive()
+    {
+      return m_Progressive;
+    }
+
+    /** Signal the host that a new version of an output was published. The
+     * identifier is the output index with memory IO or the file name
+     * otherwise, and versions count from 1.
+     *
+     * WebAssembly builds with ITK_WASM_PROGRESS_IMPORT call the host
+     * function `itk_wasm.output_version(memoryIndex, outputIndex, version)`
+     * with memory IO, during which the host can read the output with the
+     * itk_wasm_output_json_address and itk_wasm_output_array_address
+     * exports. Otherwise a JSON line is written on stderr, e.g.
+     * `{"output":"0","version":1}`. */
+    static void report_output_version(const std::string & identifier, unsigned int version);
+
+    /** Abort a filter at its next progress update when the host requests it
+     * with itk_wasm_request_abort. The filter then throws an
+     * itk::ProcessAborted exception that unwinds through
+     * ITK_WASM_CATCH_EXCEPTION, and the instance can be reused. Call before
+     * the filter is updated. */
+    void abort_on_request(ProcessObject * filter);
+
+    /** Add a timing to the --profile report. */
+    static void add_profile_event(const std::string & name, double seconds);
+
+    /** Record the time from the end of argument parsing to the first output
+     * serialization as the "compute" phase. Only the first call counts. The
+     * time from then until the outputs are written is the "outputs" phase. */
+    static void mark_profile_compute();
+
+    /** Serialize an output, called by the output destructors.
+     *
+     * In threaded builds, i.e. native builds and WebAssembly builds with
+     * ITK_WASM_THREADS, and with more than one ITK thread, the serialization
+     * starts on a background thread. The outputs of a run are then
+     * serialized concurrently, and file writes complete behind the rest of
+     * the run. The Pipeline waits for them when it is destroyed. Otherwise
+     * the serialization runs immediately. */
+    static void serialize_output(std::function<void()> serialization);
+
+    /** Wait for the outputs serialized in the background. Rethrows the first
+     * exception thrown by a serialization. */
+    static void wait_for_outputs();
+
+    /** Read an input, called by the input lexical_casts.
+     *
+     * In threaded builds, with more than one ITK thread, the file reads
+     * requested while the command line is parsed are queued, e.g. the
+     * elements of a std::vector<InputImage<TImage>> option, and run on a
+     * pool of at most the ITK default number of threads when parsing
+     * completes. parse() rethrows the first exception thrown by a read.
+     * Otherwise the read runs immediately. */
+    static void read_input(std::function<void()> read);
+
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+    /** ImageIO created for an input file during input type detection, reused
+     * when the input is read. nullptr if none is cached. */
+    static ImageIOBase * get_input_image_io(const std::string & fileName);
+    static void set_input_image_io(const std::string & fileName, ImageIOBase * imageIO);
+
+    /** MeshIO created for an input file during input type detection, with
+     * its mesh information read, reused when the input is read. nullptr if
+     * none is cached. */
+    static MeshIOBase * get_input_mesh_io(const std::string & fileName);
+    static void set_input_mesh_io(const std::string & fileName, MeshIOBase * meshIO);
+#endif
+
+    /** Memory IO input JSON parsed during input type detection, reused when
+     * the input is read. nullptr if none is cached. */
+    static std::shared_ptr<const rapidjson::Document> get_input_json_document(uint32_t index);
+    static void set_input_json_document(uint32_t index, std::shared_ptr<const rapidjson::Document> document);
+
+    /** Memory store session used by the memory IO inputs and outputs. */
+    static auto get_memory_index()
+    {
+      return m_MemoryIndex;
+    }
+
     int get_argc() const
     {
       return m_argc;
@@ -178,16 +318,88 @@ public:
 
     void interface_json();
 
+    /** Publish the outputs of an earlier memory IO run with the same
+     * pipeline name, parameters and inputs when a ResultCacheStore is set.
+     * Returns true on a hit, and the pipeline functor is skipped. On a miss
+     * the outputs of the run are stored when the pipeline is destroyed,
+     * unless it exited with an error or was aborted. Called by
+     * ITK_WASM_PARSE. */
+    bool restore_cached_result();
+
     ~Pipeline() override;
 private:
+    void write_profile_report() const;
+    void store_cached_result();
+
     static bool m_UseMemoryIO;
+    static uint32_t m_MemoryIndex;
+    static bool m_Profile;
+    static uint64_t m_MaxMemory;
+    static bool m_ReportProgress;
+    static bool m_Progressive;
+    static MetaDataKeyFilter m_MetaDataKeyFilter;
+    static ComponentConversion m_ComponentConversion;
     int m_argc;
     char **m_argv;
     std::string m_Version;
+    unsigned int m_NumberOfThreads{0};
+    std::string m_Threader;
+    std::string m_MaxMemoryText;
+    std::vector<std::string> m_MetaDataInclude;
+    std::vector<std::string> m_MetaDataExclude;
+    bool m_ResultCacheMiss{false};
+    uint64_t m_ResultCacheKey{0};
 };
 
 
+/** Signature of a pipeline main function, see RunBatch. */
+using PipelineMainType = int (*)(int argc, char * argv[]);
+
+/** Run a pipeline main function once per argument set of a batch manifest.
+ *
+ * When argv contains `--batch <manifest.json>`, the manifest is read as a
+ * JSON array whose entries are arrays of argument strings, e.g.
+ * `[["input1.nrrd", "output1.nrrd"], ["input2.nrrd", "output2.nrrd"]]`,
+ * and pipelineMain is called for each entry. The other arguments are
+ * prepended to every entry. Process startup, static initialization and
+ * input type dispatch tables are shared by all entries. All entries are
+ * run; the first nonzero exit code is returned. Without `--batch`,
+ * pipelineMain is called with argc and argv. */
+WebAssemblyInterface_EXPORT int RunBatch(int argc, char * argv[], PipelineMainType pipelineMain);
+
+/** Define main for a pipeline main function that supports --batch. */
+#define ITK_WASM_BATCH_MAIN(pipelineMain) \
+  int main(int argc, char * argv[]) \
+  { \
+    return itk::wasm::RunBatch(argc, argv, pipelineMain); \
+  }
+
+/**
+ *\class ProfileScope
+ * \brief Record the wall-clock duration of a scope in the --profile report
+ *
+ * Does nothing unless the Pipeline was run with --profile.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT ProfileScope
+{
+public:
+  explicit ProfileScope(std::string name);
+  ~ProfileScope();
+
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope & operator=(const ProfileScope &) = delete;
+private:
+  std::string m_Name;
+  std::chrono::steady_clock::time_point m_Start;
+};
+
 } // end namespace wasm
 } // end namespace itk
 
+#ifdef ITK_WASM_LAZY_IO_FACTORIES
+#include "itkWasmLazyIOFactoryRegisterManager.h"
+#endif
+
 #endif
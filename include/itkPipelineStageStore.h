@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineStageStore_h
+#define itkPipelineStageStore_h
+
+#include "itkDataObject.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "WebAssemblyInterfaceExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+namespace wasm
+{
+
+/** Interface type of a data object passed between pipeline stages. */
+struct StageDataObjectType
+{
+  unsigned int dimension{0};
+  std::string componentType;
+  std::string pixelType;
+  unsigned int components{0};
+};
+
+/** Pixel buffer of an image passed between stages or kept resident, patched
+ * in place with PatchStageImageRegion and PatchStageImageRuns. */
+struct StageImageBuffer
+{
+  void * data{nullptr};
+  /** Bytes per pixel, with all of its components. */
+  size_t pixelSize{0};
+  /** Buffered region, fastest dimension first. */
+  std::vector<int64_t> index;
+  std::vector<size_t> size;
+};
+
+template <typename TImage>
+StageImageBuffer MakeStageImageBuffer(const TImage * image)
+{
+  using ComponentType = typename DefaultConvertPixelTraits<typename TImage::PixelType>::ComponentType;
+  StageImageBuffer buffer;
+  buffer.data = const_cast<void *>(static_cast<const void *>(image->GetBufferPointer()));
+  buffer.pixelSize = sizeof(ComponentType) * image->GetNumberOfComponentsPerPixel();
+  const auto & region = image->GetBufferedRegion();
+  for (unsigned int ii = 0; ii < TImage::ImageDimension; ++ii)
+  {
+    buffer.index.push_back(region.GetIndex(ii));
+    buffer.size.push_back(region.GetSize(ii));
+  }
+  return buffer;
+}
+
+/** Whether an input or output identifier refers to a data object passed
+ * between pipeline stages in the same process, e.g. `stage:smoothed`, or to
+ * a resident data object, see IsHandleIdentifier.
+ *
+ * Several pipeline main functions can be linked into one composite binary
+ * and run in sequence. An output written by one stage to a stage identifier
+ * is kept in memory, and a later stage that reads the same stage identifier
+ * uses the data object directly, without serialization, in both filesystem
+ * and memory IO modes. Only the final outputs are written out. */
+WebAssemblyInterface_EXPORT bool IsStageIdentifier(const std::string & identifier);
+
+/** Whether an identifier refers to a resident data object by its handle,
+ * e.g. `handle:3`.
+ *
+ * In reactor mode the module instance runs several invocations. A data
+ * object written to a handle identifier, or a memory IO input retained
+ * with itk_wasm_input_retain, stays resident in the instance, and later
+ * invocations read it by its handle without transferring or importing it
+ * again. Handles are released with ReleaseHandleDataObject. */
+WebAssemblyInterface_EXPORT bool IsHandleIdentifier(const std::string & identifier);
+
+/** The identifier of a handle, `handle:<handle>`. */
+WebAssemblyInterface_EXPORT std::string GetHandleIdentifier(uint32_t handle);
+
+WebAssemblyInterface_EXPORT void SetStageDataObject(const std::string & identifier, const DataObject * dataObject, const StageDataObjectType & type);
+
+/** Set the pixel buffer of the image data object stored for a stage
+ * identifier, see MakeStageImageBuffer, so it can be patched. */
+WebAssemblyInterface_EXPORT void SetStageImageBuffer(const std::string & identifier, const StageImageBuffer & buffer);
+
+/** Copy the pixels of a region, its index and size in the image index
+ * space, into the image stored for a stage identifier. data holds the
+ * region pixels with the fastest dimension first, dataSize bytes. The image
+ * is marked Modified. Returns false if the identifier has no image
+ * buffer, the region is outside of it, or dataSize does not match. */
+WebAssemblyInterface_EXPORT bool PatchStageImageRegion(const std::string & identifier, const int64_t * regionIndex, const uint64_t * regionSize, const void * data, size_t dataSize);
+
+/** Fill runs of pixels of the image stored for a stage identifier. Each
+ * run is a little-endian uint64 pixel offset in the buffer, a uint64 pixel
+ * count, and the pixel value, pixelSize bytes. The image is marked
+ * Modified. Returns false if the identifier has no image buffer, a run is
+ * outside of it, or runsSize is not a whole number of runs. */
+WebAssemblyInterface_EXPORT bool PatchStageImageRuns(const std::string & identifier, const void * runs, size_t runsSize);
+
+/** The data object stored for a stage identifier, or nullptr. */
+WebAssemblyInterface_EXPORT const DataObject * GetStageDataObject(const std::string & identifier);
+
+/** The type of the data object stored for a stage identifier, or nullptr. */
+WebAssemblyInterface_EXPORT const StageDataObjectType * GetStageDataObjectType(const std::string & identifier);
+
+/** Release all data objects passed between stages. Resident data objects
+ * are kept. */
+WebAssemblyInterface_EXPORT void ClearStageDataObjects();
+
+/** Release the resident data object of a handle. */
+WebAssemblyInterface_EXPORT void ReleaseHandleDataObject(uint32_t handle);
+
+/** Release all resident data objects. */
+WebAssemblyInterface_EXPORT void ReleaseHandleDataObjects();
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
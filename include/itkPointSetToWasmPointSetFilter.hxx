@@ -0,0 +1,204 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPointSetToWasmPointSetFilter_hxx
+#define itkPointSetToWasmPointSetFilter_hxx
+
+#include "itkPointSetToWasmPointSetFilter.h"
+
+#include "itkMeshConvertPixelTraits.h"
+
+#include "itkWasmMapComponentType.h"
+#include "itkWasmMapPixelType.h"
+#include "itkWasmJSONWriter.h"
+#include "itkWasmTrace.h"
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+namespace itk
+{
+
+template <typename TPointSet>
+PointSetToWasmPointSetFilter<TPointSet>
+::PointSetToWasmPointSetFilter()
+{
+  this->SetNumberOfRequiredInputs(1);
+
+  typename WasmPointSetType::Pointer output = static_cast<WasmPointSetType *>(this->MakeOutput(0).GetPointer());
+  this->ProcessObject::SetNumberOfRequiredOutputs(1);
+  this->ProcessObject::SetNthOutput(0, output.GetPointer());
+}
+
+template <typename TPointSet>
+ProcessObject::DataObjectPointer
+PointSetToWasmPointSetFilter<TPointSet>
+::MakeOutput(ProcessObject::DataObjectPointerArraySizeType)
+{
+  return WasmPointSetType::New().GetPointer();
+}
+
+template <typename TPointSet>
+ProcessObject::DataObjectPointer
+PointSetToWasmPointSetFilter<TPointSet>
+::MakeOutput(const ProcessObject::DataObjectIdentifierType &)
+{
+  return WasmPointSetType::New().GetPointer();
+}
+
+template <typename TPointSet>
+auto
+PointSetToWasmPointSetFilter<TPointSet>
+::GetOutput() -> WasmPointSetType *
+{
+  // we assume that the first output is of the templated type
+  return itkDynamicCastInDebugMode<WasmPointSetType *>(this->GetPrimaryOutput());
+}
+
+template <typename TPointSet>
+auto
+PointSetToWasmPointSetFilter<TPointSet>
+::GetOutput() const -> const WasmPointSetType *
+{
+  // we assume that the first output is of the templated type
+  return itkDynamicCastInDebugMode<const WasmPointSetType *>(this->GetPrimaryOutput());
+}
+
+template <typename TPointSet>
+auto
+PointSetToWasmPointSetFilter<TPointSet>
+::GetOutput(unsigned int idx) -> WasmPointSetType *
+{
+  auto * out = dynamic_cast<WasmPointSetType *>(this->ProcessObject::GetOutput(idx));
+
+  if (out == nullptr && this->ProcessObject::GetOutput(idx) != nullptr)
+  {
+    itkWarningMacro(<< "Unable to convert output number " << idx << " to type " << typeid(WasmPointSetType).name());
+  }
+  return out;
+}
+
+template <typename TPointSet>
+void
+PointSetToWasmPointSetFilter<TPointSet>
+::SetInput(const PointSetType * input)
+{
+  // Process object is not const-correct so the const_cast is required here
+  this->ProcessObject::SetNthInput(0, const_cast<PointSetType *>(input));
+}
+
+template <typename TPointSet>
+void
+PointSetToWasmPointSetFilter<TPointSet>
+::SetInput(unsigned int index, const PointSetType * pointSet)
+{
+  // Process object is not const-correct so the const_cast is required here
+  this->ProcessObject::SetNthInput(index, const_cast<PointSetType *>(pointSet));
+}
+
+template <typename TPointSet>
+const typename PointSetToWasmPointSetFilter<TPointSet>::PointSetType *
+PointSetToWasmPointSetFilter<TPointSet>
+::GetInput()
+{
+  return itkDynamicCastInDebugMode<const PointSetType *>(this->GetPrimaryInput());
+}
+
+template <typename TPointSet>
+const typename PointSetToWasmPointSetFilter<TPointSet>::PointSetType *
+PointSetToWasmPointSetFilter<TPointSet>
+::GetInput(unsigned int idx)
+{
+  return itkDynamicCastInDebugMode<const PointSetType *>(this->ProcessObject::GetInput(idx));
+}
+
+template <typename TPointSet>
+void
+PointSetToWasmPointSetFilter<TPointSet>
+::GenerateData()
+{
+  ITK_WASM_TRACE_SCOPE("PointSetToWasmPointSetFilter::GenerateData");
+
+  // Get the input and output pointers
+  const PointSetType * pointSet = this->GetInput();
+  WasmPointSetType * wasmPointSet = this->GetOutput();
+
+  // The JSON references the point set containers, which are not copied
+  wasmPointSet->SetPointSet(pointSet);
+
+  rapidjson::StringBuffer & stringBuffer = wasm::GetWasmJSONStringBuffer();
+  wasm::WasmJSONWriterType writer(stringBuffer);
+  writer.StartObject();
+
+  writer.Key("pointSetType");
+  writer.StartObject();
+
+  constexpr unsigned int dimension = PointSetType::PointDimension;
+  writer.Key("dimension");
+  writer.Uint(dimension);
+
+  writer.Key("pointComponentType");
+  wasm::WriteWasmJSONString(writer, wasm::MapComponentType<typename PointSetType::CoordRepType>::ComponentString);
+
+  using PointPixelType = typename TPointSet::PixelType;
+  using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
+  writer.Key("pointPixelComponentType");
+  wasm::WriteWasmJSONString(writer, wasm::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::ComponentString);
+  writer.Key("pointPixelType");
+  wasm::WriteWasmJSONString(writer, wasm::MapPixelType<PointPixelType>::PixelString);
+  writer.Key("pointPixelComponents");
+  writer.Uint(ConvertPointPixelTraits::GetNumberOfComponents());
+
+  writer.EndObject();
+
+  writer.Key("numberOfPoints");
+  writer.Uint64(static_cast< uint64_t >( pointSet->GetNumberOfPoints() ));
+
+  writer.Key("numberOfPointPixels");
+  writer.Uint64(pointSet->GetPointData() == nullptr ? 0 : static_cast< uint64_t >( pointSet->GetPointData()->Size() ));
+
+  size_t pointsAddress = 0;
+  if (pointSet->GetNumberOfPoints() > 0)
+  {
+    pointsAddress = reinterpret_cast< size_t >( &(pointSet->GetPoints()->at(0)) );
+  }
+  writer.Key("points");
+  wasm::WriteWasmJSONAddress(writer, pointsAddress);
+
+  size_t pointDataAddress = 0;
+  if (pointSet->GetPointData() != nullptr && pointSet->GetPointData()->Size() > 0)
+  {
+    pointDataAddress = reinterpret_cast< size_t >( &(pointSet->GetPointData()->at(0)) );
+  }
+  writer.Key("pointData");
+  wasm::WriteWasmJSONAddress(writer, pointDataAddress);
+
+  writer.EndObject();
+
+  wasmPointSet->SetJSON(std::string(stringBuffer.GetString(), stringBuffer.GetSize()));
+}
+
+template <typename TPointSet>
+void
+PointSetToWasmPointSetFilter<TPointSet>
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+}
+} // end namespace itk
+
+#endif
@@ -24,8 +24,9 @@
 
 #include "itkWasmMapComponentType.h"
 #include "itkWasmMapPixelType.h"
+#include "itkWasmJSONWriter.h"
+#include "itkWasmTrace.h"
 
-#include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
@@ -130,204 +131,119 @@ void
 PolyDataToWasmPolyDataFilter<TPolyData>
 ::GenerateData()
 {
+  ITK_WASM_TRACE_SCOPE("PolyDataToWasmPolyDataFilter::GenerateData");
+
   // Get the input and output pointers
   const PolyDataType * polyData = this->GetInput();
   WasmPolyDataType * wasmPolyData = this->GetOutput();
 
   wasmPolyData->SetPolyData(polyData);
 
-  rapidjson::Document document;
-  document.SetObject();
-  rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
+  rapidjson::StringBuffer & stringBuffer = wasm::GetWasmJSONStringBuffer();
+  wasm::WasmJSONWriterType writer(stringBuffer);
+  writer.StartObject();
 
-  rapidjson::Value polyDataType;
-  polyDataType.SetObject();
+  writer.Key("polyDataType");
+  writer.StartObject();
 
   using PointPixelType = typename TPolyData::PixelType;
   using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
-  rapidjson::Value pointPixelComponentType;
-  pointPixelComponentType.SetString( wasm::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::ComponentString.data(), allocator );
-  polyDataType.AddMember("pointPixelComponentType", pointPixelComponentType.Move(), allocator );
-
-  rapidjson::Value pointPixelType;
-  pointPixelType.SetString( wasm::MapPixelType<PointPixelType>::PixelString.data(), allocator );
-  polyDataType.AddMember("pointPixelType", pointPixelType.Move(), allocator );
-
-  polyDataType.AddMember("pointPixelComponents", rapidjson::Value( ConvertPointPixelTraits::GetNumberOfComponents() ).Move(), allocator );
+  writer.Key("pointPixelComponentType");
+  wasm::WriteWasmJSONString(writer, wasm::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::ComponentString);
+  writer.Key("pointPixelType");
+  wasm::WriteWasmJSONString(writer, wasm::MapPixelType<PointPixelType>::PixelString);
+  writer.Key("pointPixelComponents");
+  writer.Uint(ConvertPointPixelTraits::GetNumberOfComponents());
 
   using CellPixelType = typename TPolyData::CellPixelType;
   using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
-  rapidjson::Value cellPixelComponentType;
-  cellPixelComponentType.SetString( wasm::MapComponentType<typename ConvertCellPixelTraits::ComponentType>::ComponentString.data(), allocator );
-  polyDataType.AddMember("cellPixelComponentType", cellPixelComponentType.Move(), allocator );
-
-  rapidjson::Value cellPixelType;
-  cellPixelType.SetString( wasm::MapPixelType<CellPixelType>::PixelString.data(), allocator );
-  polyDataType.AddMember("cellPixelType", cellPixelType, allocator );
-
-  polyDataType.AddMember("cellPixelComponents", rapidjson::Value( ConvertCellPixelTraits::GetNumberOfComponents() ).Move(), allocator );
-
-  document.AddMember( "polyDataType", polyDataType.Move(), allocator );
-
-  rapidjson::Value numberOfPoints;
-  numberOfPoints.SetInt( polyData->GetNumberOfPoints() );
-  document.AddMember( "numberOfPoints", numberOfPoints.Move(), allocator );
-
-  rapidjson::Value verticesBufferSize;
-  if (polyData->GetPointData() == nullptr)
-  {
-    verticesBufferSize.SetInt( 0 );
-  }
-  else
-  {
-    verticesBufferSize.SetInt( polyData->GetVertices()->Size() );
-  }
-  document.AddMember( "verticesBufferSize", verticesBufferSize.Move(), allocator );
-
-  rapidjson::Value linesBufferSize;
-  if (polyData->GetPointData() == nullptr)
-  {
-    linesBufferSize.SetInt( 0 );
-  }
-  else
-  {
-    linesBufferSize.SetInt( polyData->GetLines()->Size() );
-  }
-  document.AddMember( "linesBufferSize", linesBufferSize.Move(), allocator );
-
-  rapidjson::Value polygonsBufferSize;
-  if (polyData->GetPointData() == nullptr)
-  {
-    polygonsBufferSize.SetInt( 0 );
-  }
-  else
-  {
-    polygonsBufferSize.SetInt( polyData->GetPolygons()->Size() );
-  }
-  document.AddMember( "polygonsBufferSize", polygonsBufferSize.Move(), allocator );
-
-  rapidjson::Value triangleStripsBufferSize;
-  if (polyData->GetPointData() == nullptr)
-  {
-    triangleStripsBufferSize.SetInt( 0 );
-  }
-  else
-  {
-    triangleStripsBufferSize.SetInt( polyData->GetTriangleStrips()->Size() );
-  }
-  document.AddMember( "triangleStripsBufferSize", triangleStripsBufferSize.Move(), allocator );
-
-  rapidjson::Value numberOfPointPixels;
-  if (polyData->GetPointData() == nullptr)
-  {
-    numberOfPointPixels.SetInt( 0 );
-  }
-  else
-  {
-    numberOfPointPixels.SetInt( polyData->GetPointData()->Size() );
-  }
-  document.AddMember( "numberOfPointPixels", numberOfPointPixels.Move(), allocator );
-
-  rapidjson::Value numberOfCellPixels;
-  if (polyData->GetCellData() == nullptr)
-  {
-    numberOfCellPixels.SetInt( 0 );
-  }
-  else
-  {
-    numberOfCellPixels.SetInt( polyData->GetCellData()->Size() );
-  }
-  document.AddMember( "numberOfCellPixels", numberOfCellPixels.Move(), allocator );
+  writer.Key("cellPixelComponentType");
+  wasm::WriteWasmJSONString(writer, wasm::MapComponentType<typename ConvertCellPixelTraits::ComponentType>::ComponentString);
+  writer.Key("cellPixelType");
+  wasm::WriteWasmJSONString(writer, wasm::MapPixelType<CellPixelType>::PixelString);
+  writer.Key("cellPixelComponents");
+  writer.Uint(ConvertCellPixelTraits::GetNumberOfComponents());
+
+  writer.EndObject();
+
+  writer.Key("numberOfPoints");
+  writer.Uint64(static_cast< uint64_t >( polyData->GetNumberOfPoints() ));
+
+  // The buffers alias the PolyData containers, so each size is that of its
+  // own container
+  writer.Key("verticesBufferSize");
+  writer.Uint64(polyData->GetVertices() == nullptr ? 0 : static_cast< uint64_t >( polyData->GetVertices()->Size() ));
+  writer.Key("linesBufferSize");
+  writer.Uint64(polyData->GetLines() == nullptr ? 0 : static_cast< uint64_t >( polyData->GetLines()->Size() ));
+  writer.Key("polygonsBufferSize");
+  writer.Uint64(polyData->GetPolygons() == nullptr ? 0 : static_cast< uint64_t >( polyData->GetPolygons()->Size() ));
+  writer.Key("triangleStripsBufferSize");
+  writer.Uint64(polyData->GetTriangleStrips() == nullptr ? 0 : static_cast< uint64_t >( polyData->GetTriangleStrips()->Size() ));
+
+  writer.Key("numberOfPointPixels");
+  writer.Uint64(polyData->GetPointData() == nullptr ? 0 : static_cast< uint64_t >( polyData->GetPointData()->Size() ));
+  writer.Key("numberOfCellPixels");
+  writer.Uint64(polyData->GetCellData() == nullptr ? 0 : static_cast< uint64_t >( polyData->GetCellData()->Size() ));
 
   size_t pointsAddress = 0;
   if (polyData->GetNumberOfPoints())
   {
     pointsAddress = reinterpret_cast< size_t >( &(polyData->GetPoints()->at(0)) );
   }
-  std::ostringstream pointsStream;
-  pointsStream << "data:application/vnd.itk.address,0:";
-  pointsStream << pointsAddress;
-  rapidjson::Value pointsString;
-  pointsString.SetString( pointsStream.str().c_str(), allocator );
-  document.AddMember( "points", pointsString.Move(), allocator );
+  writer.Key("points");
+  wasm::WriteWasmJSONAddress(writer, pointsAddress);
 
   size_t verticesAddress = 0;
   if (polyData->GetVertices() != nullptr && polyData->GetVertices()->Size() > 0)
   {
     verticesAddress = reinterpret_cast< size_t >( &(polyData->GetVertices()->at(0)) );
   }
-  std::ostringstream verticesStream;
-  verticesStream << "data:application/vnd.itk.address,0:";
-  verticesStream << verticesAddress;
-  rapidjson::Value verticesString;
-  verticesString.SetString( verticesStream.str().c_str(), allocator );
-  document.AddMember( "vertices", verticesString.Move(), allocator );
+  writer.Key("vertices");
+  wasm::WriteWasmJSONAddress(writer, verticesAddress);
 
   size_t linesAddress = 0;
   if (polyData->GetLines() != nullptr && polyData->GetLines()->Size() > 0)
   {
     linesAddress = reinterpret_cast< size_t >( &(polyData->GetLines()->at(0)) );
   }
-  std::ostringstream linesStream;
-  linesStream << "data:application/vnd.itk.address,0:";
-  linesStream << linesAddress;
-  rapidjson::Value linesString;
-  linesString.SetString( linesStream.str().c_str(), allocator );
-  document.AddMember( "lines", linesString.Move(), allocator );
+  writer.Key("lines");
+  wasm::WriteWasmJSONAddress(writer, linesAddress);
 
   size_t polygonsAddress = 0;
   if (polyData->GetPolygons() != nullptr && polyData->GetPolygons()->Size() > 0)
   {
     polygonsAddress = reinterpret_cast< size_t >( &(polyData->GetPolygons()->at(0)) );
   }
-  std::ostringstream polygonsStream;
-  polygonsStream << "data:application/vnd.itk.address,0:";
-  polygonsStream << polygonsAddress;
-  rapidjson::Value polygonsString;
-  polygonsString.SetString( polygonsStream.str().c_str(), allocator );
-  document.AddMember( "polygons", polygonsString.Move(), allocator );
+  writer.Key("polygons");
+  wasm::WriteWasmJSONAddress(writer, polygonsAddress);
 
   size_t triangleStripsAddress = 0;
   if (polyData->GetTriangleStrips() != nullptr && polyData->GetTriangleStrips()->Size() > 0)
   {
     triangleStripsAddress = reinterpret_cast< size_t >( &(polyData->GetTriangleStrips()->at(0)) );
   }
-  std::ostringstream triangleStripsStream;
-  triangleStripsStream << "data:application/vnd.itk.address,0:";
-  triangleStripsStream << triangleStripsAddress;
-  rapidjson::Value triangleStripsString;
-  triangleStripsString.SetString( triangleStripsStream.str().c_str(), allocator );
-  document.AddMember( "triangleStrips", triangleStripsString.Move(), allocator );
+  writer.Key("triangleStrips");
+  wasm::WriteWasmJSONAddress(writer, triangleStripsAddress);
 
   size_t pointDataAddress = 0;
   if (polyData->GetPointData() != nullptr && polyData->GetPointData()->Size() > 0)
   {
     pointDataAddress = reinterpret_cast< size_t >( &(polyData->GetPointData()->at(0)) );
   }
-  std::ostringstream pointDataStream;
-  pointDataStream << "data:application/vnd.itk.address,0:";
-  pointDataStream << pointDataAddress;
-  rapidjson::Value pointDataString;
-  pointDataString.SetString( pointDataStream.str().c_str(), allocator );
-  document.AddMember( "pointData", pointDataString.Move(), allocator );
+  writer.Key("pointData");
+  wasm::WriteWasmJSONAddress(writer, pointDataAddress);
 
   size_t cellDataAddress = 0;
   if (polyData->GetCellData() != nullptr && polyData->GetCellData()->Size() > 0)
   {
     cellDataAddress = reinterpret_cast< size_t >( &(polyData->GetCellData()->at(0)) );
   }
-  std::ostringstream cellDataStream;
-  cellDataStream <<  "data:application/vnd.itk.address,0:";
-  cellDataStream << cellDataAddress;
-  rapidjson::Value cellDataString;
-  cellDataString.SetString( cellDataStream.str().c_str(), allocator );
-  document.AddMember( "cellData", cellDataString.Move(), allocator );
-
-  rapidjson::StringBuffer stringBuffer;
-  rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
-  document.Accept(writer);
-
-  wasmPolyData->SetJSON(stringBuffer.GetString());
+  writer.Key("cellData");
+  wasm::WriteWasmJSONAddress(writer, cellDataAddress);
+
+  writer.EndObject();
+
+  wasmPolyData->SetJSON(std::string(stringBuffer.GetString(), stringBuffer.GetSize()));
 }
 
 template <typename TPolyData>
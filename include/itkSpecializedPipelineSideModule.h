@@ -0,0 +1,62 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSpecializedPipelineSideModule_h
+#define itkSpecializedPipelineSideModule_h
+
+#include "itkPipeline.h"
+#include "itkSpecializedImagePipelineFunctor.h"
+#include "WebAssemblyInterfaceExport.h"
+
+#include <string>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+using SpecializedPipelineFunctionType = int (*)(Pipeline &);
+
+/** File name of the side module with the specialized pipeline for an input
+ * type, e.g. `downsample-3-uint8-Scalar-1.wasm`. The directory is taken from
+ * the ITK_WASM_SIDE_MODULE_PATH environment variable when set. */
+WebAssemblyInterface_EXPORT std::string
+SpecializedPipelineSideModuleName(const std::string & pipelineName, unsigned int dimension, const std::string & componentType, const std::string & pixelType, unsigned int components);
+
+/** Load the specialized pipeline for an input type from its side module.
+ *
+ * Returns nullptr when the module is not available or when the library was
+ * built without ITK_WASM_SIDE_MODULES. With emscripten, the main module is
+ * linked with `-sMAIN_MODULE=2` and the host writes the side module, linked
+ * with `-sSIDE_MODULE=1`, to the module filesystem before the run. */
+WebAssemblyInterface_EXPORT SpecializedPipelineFunctionType
+LoadSpecializedPipelineSideModule(const std::string & pipelineName, unsigned int dimension, const std::string & componentType, const std::string & pixelType, unsigned int components);
+
+} // end namespace wasm
+} // end namespace itk
+
+/** Define the entry point of a side module holding one specialized image
+ * pipeline. Build the pipeline source once per side module with this macro
+ * in place of main. */
+#define ITK_WASM_SPECIALIZED_IMAGE_PIPELINE_SIDE_MODULE(functor, dimension, pixel) \
+  extern "C" int itk_wasm_specialized_pipeline(itk::wasm::Pipeline & pipeline) \
+  { \
+    return itk::wasm::SpecializedImagePipelineFunctor<functor, dimension, pixel>()(pipeline); \
+  }
+
+#endif
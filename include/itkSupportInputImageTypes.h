@@ -23,14 +23,20 @@
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkWasmMapComponentType.h"
 #include "itkWasmMapPixelType.h"
+#include "itkWasmInterfaceTypeKey.h"
+#include "itkWasmComponentConversion.h"
 
 #include "itkImage.h"
 #include "itkVectorImage.h"
 #include "itkImageIOBase.h"
 #include "itkImageIOFactory.h"
 #include "itkSpecializedImagePipelineFunctor.h"
+#include "itkSpecializedPipelineSideModule.h"
 #include "WebAssemblyInterfaceExport.h"
 
+#include <tuple>
+#include <unordered_map>
+
 namespace itk
 {
 
@@ -86,6 +92,14 @@ main(int argc, char * argv[])
   ::Dimensions<2U,3U>("input-image", pipeline);
 }
 ```
+ *
+ * With a ComponentConversion, memory IO input images of other component
+ * types that the conversion maps to a supported component type are run
+ * with that specialization, and their pixel data is converted on import.
+ * For example, with `Dimensions<2U,3U>("input-image", pipeline,
+ * itk::wasm::ComponentConversion::ToFloat32)` and the pixel type `float`,
+ * integer and float64 images are also supported. Images read from files
+ * are converted by the ImageIO.
  *
  * \ingroup WebAssemblyInterface
  */
@@ -96,24 +110,14 @@ SupportInputImageTypes
 public:
   template<unsigned int ...VDimensions>
   static int
-  Dimensions(const std::string & inputImageOptionName, Pipeline & pipeline)
+  Dimensions(const std::string & inputImageOptionName, Pipeline & pipeline, ComponentConversion conversion = ComponentConversion::None)
   {
     InterfaceImageType imageType;
+    Pipeline::set_component_conversion(conversion);
 
-    const auto iwpArgc = pipeline.get_argc();
-    const auto iwpArgv = pipeline.get_argv();
-    bool passThrough = false;
-    for (int ii = 0; ii < iwpArgc; ++ii)
-      {
-        const std::string arg(iwpArgv[ii]);
-        if (arg == "-h" || arg == "--help" || arg == "--interface-json" || arg == "--version")
-        {
-          passThrough = true;
-        }
-      }
-    if (passThrough)
+    if (IsPassThrough(pipeline))
     {
-      return IterateDimensions<VDimensions...>(pipeline, imageType, passThrough);
+      return PassThrough<VDimensions...>(pipeline);
     }
 
     auto tempOption = pipeline.add_option(inputImageOptionName, imageType, "Read image type.");
@@ -122,53 +126,135 @@ public:
 
     pipeline.remove_option(tempOption);
 
-    return IterateDimensions<VDimensions...>(pipeline, imageType);
+    return Dispatch<VDimensions...>(pipeline, imageType, conversion);
   }
 
-private:
-  template<unsigned int VDimension, typename TPixel, typename ...TPixelsRest>
+  /** Run the specialization for imageType, e.g. an output image type that
+   * the caller derived from pre-parsed options, rather than the type of an
+   * input image. With ComponentConversion::Cast, the input images are
+   * converted on import to the component type of imageType. */
+  template<unsigned int ...VDimensions>
   static int
-  IteratePixelTypes(Pipeline & pipeline, const InterfaceImageType & imageType, bool passThrough = false)
+  Dimensions(const InterfaceImageType & imageType, Pipeline & pipeline, ComponentConversion conversion = ComponentConversion::None)
   {
-    constexpr unsigned int Dimension = VDimension;
-    using PixelType = TPixel;
-    using ConvertPixelTraits = DefaultConvertPixelTraits<PixelType>;
+    Pipeline::set_component_conversion(conversion);
 
-    if (passThrough ||
-        imageType.componentType == MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString &&
-        imageType.pixelType == MapPixelType<PixelType>::PixelString)
+    if (IsPassThrough(pipeline))
     {
-      if (passThrough || imageType.pixelType == "VariableLengthVector" || imageType.pixelType == "VariableSizeMatrix" || imageType.components == ConvertPixelTraits::GetNumberOfComponents() )
+      return PassThrough<VDimensions...>(pipeline);
+    }
+
+    return Dispatch<VDimensions...>(pipeline, imageType, conversion);
+  }
+
+  /** Whether the arguments only request the help, interface, or version,
+   * which any specialization produces, so no image type is pre-parsed. */
+  static bool
+  IsPassThrough(Pipeline & pipeline)
+  {
+    const auto iwpArgc = pipeline.get_argc();
+    const auto iwpArgv = pipeline.get_argv();
+    for (int ii = 0; ii < iwpArgc; ++ii)
       {
-        return SpecializedImagePipelineFunctor<TPipelineFunctor, Dimension, PixelType>()(pipeline);
+        const std::string arg(iwpArgv[ii]);
+        if (arg == "-h" || arg == "--help" || arg == "--interface-json" || arg == "--version")
+        {
+          return true;
+        }
       }
-    }
+    return false;
+  }
 
-    if constexpr (sizeof...(TPixelsRest) > 0) {
-      return IteratePixelTypes<VDimension, TPixelsRest...>(pipeline, imageType);
-    }
+private:
+  using PipelineFunctionType = int (*)(Pipeline &);
+  using DispatchTableType = std::unordered_map<uint64_t, PipelineFunctionType>;
 
-    std::ostringstream ostrm;
-    ostrm << "Unsupported pixel type: " << imageType.pixelType << " with component type: " << imageType.componentType << " and components: " << imageType.components;
-    CLI::Error err("Runtime error", ostrm.str(), 1);
-    return pipeline.exit(err);
+  template<unsigned int VDimension, typename TPixel>
+  static int
+  RunSpecialized(Pipeline & pipeline)
+  {
+    return SpecializedImagePipelineFunctor<TPipelineFunctor, VDimension, TPixel>()(pipeline);
+  }
+
+  template<unsigned int VDimension, typename TPixel>
+  static void
+  AddPixelType(DispatchTableType & table)
+  {
+    using ConvertPixelTraits = DefaultConvertPixelTraits<TPixel>;
+    constexpr std::string_view pixelString = MapPixelType<TPixel>::PixelString;
+    const unsigned int components = IsVariableLengthPixelType(pixelString) ? 0 : ConvertPixelTraits::GetNumberOfComponents();
+    const uint64_t key = InterfaceTypeKey(VDimension, MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString, pixelString, components);
+    // The first listed type wins if types are repeated
+    table.emplace(key, &RunSpecialized<VDimension, TPixel>);
+  }
+
+  template<unsigned int VDimension>
+  static void
+  AddDimension(DispatchTableType & table)
+  {
+    (AddPixelType<VDimension, TPixels>(table), ...);
+  }
+
+  /** Table from the packed interface type key to the specialized pipeline,
+   * generated once for all supported dimensions and pixel types. */
+  template<unsigned int ...VDimensions>
+  static const DispatchTableType &
+  GetDispatchTable()
+  {
+    static const DispatchTableType table = []() {
+      DispatchTableType dispatchTable;
+      (AddDimension<VDimensions>(dispatchTable), ...);
+      return dispatchTable;
+    }();
+    return table;
   }
 
   template<unsigned int VDimension, unsigned int ...VDimensions>
   static int
-  IterateDimensions(Pipeline & pipeline, const InterfaceImageType & imageType, bool passThrough = false)
+  PassThrough(Pipeline & pipeline)
   {
-    if (passThrough || VDimension == imageType.dimension)
+    return RunSpecialized<VDimension, std::tuple_element_t<0, std::tuple<TPixels...>>>(pipeline);
+  }
+
+  template<unsigned int ...VDimensions>
+  static int
+  Dispatch(Pipeline & pipeline, const InterfaceImageType & imageType, ComponentConversion conversion)
+  {
+    const unsigned int components = IsVariableLengthPixelType(imageType.pixelType) ? 0 : imageType.components;
+    const uint64_t key = InterfaceTypeKey(imageType.dimension, imageType.componentType, imageType.pixelType, components);
+    const auto & table = GetDispatchTable<VDimensions...>();
+    const auto it = table.find(key);
+    if (it != table.end())
+    {
+      return it->second(pipeline);
+    }
+
+    // Types that are not built in may be provided by a side module
+    const auto sideModulePipeline = LoadSpecializedPipelineSideModule(pipeline.get_name(), imageType.dimension, imageType.componentType, imageType.pixelType, components);
+    if (sideModulePipeline != nullptr)
     {
-      return IteratePixelTypes<VDimension, TPixels...>(pipeline, imageType, passThrough);
+      return sideModulePipeline(pipeline);
     }
 
-    if constexpr (sizeof...(VDimensions) > 0) {
-      return IterateDimensions<VDimensions...>(pipeline, imageType);
+    const std::string_view convertedComponentType = GetConvertedComponentType(conversion, imageType.componentType);
+    if (!convertedComponentType.empty())
+    {
+      const auto convertedIt = table.find(InterfaceTypeKey(imageType.dimension, convertedComponentType, imageType.pixelType, components));
+      if (convertedIt != table.end())
+      {
+        return convertedIt->second(pipeline);
+      }
     }
 
     std::ostringstream ostrm;
-    ostrm << "Unsupported image dimension: " << imageType.dimension;
+    if (((imageType.dimension == VDimensions) || ...))
+    {
+      ostrm << "Unsupported pixel type: " << imageType.pixelType << " with component type: " << imageType.componentType << " and components: " << imageType.components;
+    }
+    else
+    {
+      ostrm << "Unsupported image dimension: " << imageType.dimension;
+    }
     CLI::Error err("Runtime error", ostrm.str(), 1);
     return pipeline.exit(err);
   }
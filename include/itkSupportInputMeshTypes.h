@@ -23,12 +23,16 @@
 #include "itkMeshConvertPixelTraits.h"
 #include "itkWasmMapComponentType.h"
 #include "itkWasmMapPixelType.h"
+#include "itkWasmInterfaceTypeKey.h"
 
 #include "itkMesh.h"
 #include "itkMeshIOBase.h"
 #include "itkMeshIOFactory.h"
 #include "WebAssemblyInterfaceExport.h"
 
+#include <tuple>
+#include <unordered_map>
+
 namespace itk
 {
 
@@ -115,7 +119,7 @@ public:
       }
     if (passThrough)
     {
-      return IterateDimensions<VDimensions...>(pipeline, meshType, passThrough);
+      return PassThrough<VDimensions...>(pipeline);
     }
 
     auto tempOption = pipeline.add_option(inputMeshOptionName, meshType, "Read mesh type.");
@@ -124,64 +128,93 @@ public:
 
     pipeline.remove_option(tempOption);
 
-    return IterateDimensions<VDimensions...>(pipeline, meshType);
+    return Dispatch<VDimensions...>(pipeline, meshType);
   }
 
 private:
-  template<unsigned int VDimension, typename TPixel, typename ...TPixelsRest>
+  using PipelineFunctionType = int (*)(Pipeline &);
+  using DispatchTableType = std::unordered_map<uint64_t, PipelineFunctionType>;
+
+  template<unsigned int VDimension, typename TPixel>
   static int
-  IteratePixelTypes(Pipeline & pipeline, const InterfaceMeshType & meshType, bool passThrough = false)
+  RunSpecialized(Pipeline & pipeline)
   {
-    constexpr unsigned int Dimension = VDimension;
-    using PixelType = TPixel;
-    using ConvertPixelTraits = MeshConvertPixelTraits<PixelType>;
-
-    if (passThrough || meshType.components == 0
-     || meshType.componentType == MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString
-     && meshType.pixelType == MapPixelType<PixelType>::PixelString)
-    {
-      if (meshType.pixelType == "VariableLengthVector" || meshType.pixelType == "VariableSizeMatrix" )
-      {
-        // todo: VectorMesh support for ImportMeshFilter?
-        // using MeshType = itk::VectorMesh<typename ConvertPixelTraits::ComponentType, Dimension>;
+    using MeshType = Mesh<TPixel, VDimension>;
 
-        // using PipelineType = TPipelineFunctor<MeshType>;
-        // return PipelineType()(pipeline);
-      }
-      else if(passThrough || meshType.components == ConvertPixelTraits::GetNumberOfComponents() || meshType.components == 0 )
-      {
-        using MeshType = Mesh<PixelType, Dimension>;
+    using PipelineType = TPipelineFunctor<MeshType>;
+    return PipelineType()(pipeline);
+  }
 
-        using PipelineType = TPipelineFunctor<MeshType>;
-        return PipelineType()(pipeline);
-      }
+  template<unsigned int VDimension, typename TPixel>
+  static void
+  AddPixelType(DispatchTableType & table)
+  {
+    using ConvertPixelTraits = MeshConvertPixelTraits<TPixel>;
+    constexpr std::string_view pixelString = MapPixelType<TPixel>::PixelString;
+    // Meshes without pixel data use the first listed pixel type
+    table.emplace(InterfaceTypeKey(VDimension, "", "", 0), &RunSpecialized<VDimension, TPixel>);
+    // todo: VectorMesh support for ImportMeshFilter?
+    if (!IsVariableLengthPixelType(pixelString))
+    {
+      const uint64_t key = InterfaceTypeKey(VDimension, MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString, pixelString, ConvertPixelTraits::GetNumberOfComponents());
+      table.emplace(key, &RunSpecialized<VDimension, TPixel>);
     }
+  }
 
-    if constexpr (sizeof...(TPixelsRest) > 0) {
-      return IteratePixelTypes<VDimension, TPixelsRest...>(pipeline, meshType);
-    }
+  template<unsigned int VDimension>
+  static void
+  AddDimension(DispatchTableType & table)
+  {
+    (AddPixelType<VDimension, TPixels>(table), ...);
+  }
 
-    std::ostringstream ostrm;
-    ostrm << "Unsupported pixel type: " << meshType.pixelType << " with component type: " << meshType.componentType << " and components: " << meshType.components;
-    CLI::Error err("Runtime error", ostrm.str(), 1);
-    return pipeline.exit(err);
+  /** Table from the packed interface type key to the specialized pipeline,
+   * generated once for all supported dimensions and pixel types. */
+  template<unsigned int ...VDimensions>
+  static const DispatchTableType &
+  GetDispatchTable()
+  {
+    static const DispatchTableType table = []() {
+      DispatchTableType dispatchTable;
+      (AddDimension<VDimensions>(dispatchTable), ...);
+      return dispatchTable;
+    }();
+    return table;
   }
 
   template<unsigned int VDimension, unsigned int ...VDimensions>
   static int
-  IterateDimensions(Pipeline & pipeline, const InterfaceMeshType & meshType, bool passThrough = false)
+  PassThrough(Pipeline & pipeline)
   {
-    if (passThrough || VDimension == meshType.dimension)
-    {
-      return IteratePixelTypes<VDimension, TPixels...>(pipeline, meshType);
-    }
+    return RunSpecialized<VDimension, std::tuple_element_t<0, std::tuple<TPixels...>>>(pipeline);
+  }
 
-    if constexpr (sizeof...(VDimensions) > 0) {
-      return IterateDimensions<VDimensions...>(pipeline, meshType);
+  template<unsigned int ...VDimensions>
+  static int
+  Dispatch(Pipeline & pipeline, const InterfaceMeshType & meshType)
+  {
+    if (!IsVariableLengthPixelType(meshType.pixelType))
+    {
+      const uint64_t key = meshType.components == 0 ?
+        InterfaceTypeKey(meshType.dimension, "", "", 0) :
+        InterfaceTypeKey(meshType.dimension, meshType.componentType, meshType.pixelType, meshType.components);
+      const auto & table = GetDispatchTable<VDimensions...>();
+      const auto it = table.find(key);
+      if (it != table.end())
+      {
+        return it->second(pipeline);
+      }
     }
 
     std::ostringstream ostrm;
-    ostrm << "Unsupported mesh dimension: " << meshType.dimension;
+    if (((meshType.dimension == VDimensions) || ...))
+    {
+      ostrm << "Unsupported pixel type: " << meshType.pixelType << " with component type: " << meshType.componentType << " and components: " << meshType.components;
+    }
+    else
+    {
+      ostrm << "Unsupported mesh dimension: " << meshType.dimension;
+    }
     CLI::Error err("Runtime error", ostrm.str(), 1);
     return pipeline.exit(err);
   }
@@ -0,0 +1,204 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkTransformToWasmTransformFilter_hxx
+#define itkTransformToWasmTransformFilter_hxx
+
+#include "itkTransformToWasmTransformFilter.h"
+
+#include "itkWasmMapComponentType.h"
+#include "itkWasmJSONWriter.h"
+#include "itkWasmTrace.h"
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+namespace itk
+{
+
+template <typename TTransform>
+TransformToWasmTransformFilter<TTransform>
+::TransformToWasmTransformFilter()
+{
+  this->SetNumberOfRequiredInputs(1);
+
+  typename WasmTransformType::Pointer output = static_cast<WasmTransformType *>(this->MakeOutput(0).GetPointer());
+  this->ProcessObject::SetNumberOfRequiredOutputs(1);
+  this->ProcessObject::SetNthOutput(0, output.GetPointer());
+}
+
+template <typename TTransform>
+ProcessObject::DataObjectPointer
+TransformToWasmTransformFilter<TTransform>
+::MakeOutput(ProcessObject::DataObjectPointerArraySizeType)
+{
+  return WasmTransformType::New().GetPointer();
+}
+
+template <typename TTransform>
+ProcessObject::DataObjectPointer
+TransformToWasmTransformFilter<TTransform>
+::MakeOutput(const ProcessObject::DataObjectIdentifierType &)
+{
+  return WasmTransformType::New().GetPointer();
+}
+
+template <typename TTransform>
+auto
+TransformToWasmTransformFilter<TTransform>
+::GetOutput() -> WasmTransformType *
+{
+  // we assume that the first output is of the templated type
+  return itkDynamicCastInDebugMode<WasmTransformType *>(this->GetPrimaryOutput());
+}
+
+template <typename TTransform>
+auto
+TransformToWasmTransformFilter<TTransform>
+::GetOutput() const -> const WasmTransformType *
+{
+  // we assume that the first output is of the templated type
+  return itkDynamicCastInDebugMode<const WasmTransformType *>(this->GetPrimaryOutput());
+}
+
+template <typename TTransform>
+auto
+TransformToWasmTransformFilter<TTransform>
+::GetOutput(unsigned int idx) -> WasmTransformType *
+{
+  auto * out = dynamic_cast<WasmTransformType *>(this->ProcessObject::GetOutput(idx));
+
+  if (out == nullptr && this->ProcessObject::GetOutput(idx) != nullptr)
+  {
+    itkWarningMacro(<< "Unable to convert output number " << idx << " to type " << typeid(WasmTransformType).name());
+  }
+  return out;
+}
+
+template <typename TTransform>
+void
+TransformToWasmTransformFilter<TTransform>
+::SetInput(const TransformType * input)
+{
+  this->SetInput(0, input);
+}
+
+template <typename TTransform>
+void
+TransformToWasmTransformFilter<TTransform>
+::SetInput(unsigned int index, const TransformType * transform)
+{
+  // Transforms are not data objects, so they are decorated
+  auto decoratedTransform = DecoratedTransformType::New();
+  decoratedTransform->Set(transform);
+  this->ProcessObject::SetNthInput(index, decoratedTransform);
+}
+
+template <typename TTransform>
+const typename TransformToWasmTransformFilter<TTransform>::TransformType *
+TransformToWasmTransformFilter<TTransform>
+::GetInput()
+{
+  return this->GetInput(0);
+}
+
+template <typename TTransform>
+const typename TransformToWasmTransformFilter<TTransform>::TransformType *
+TransformToWasmTransformFilter<TTransform>
+::GetInput(unsigned int idx)
+{
+  const auto * decoratedTransform = itkDynamicCastInDebugMode<const DecoratedTransformType *>(this->ProcessObject::GetInput(idx));
+  return decoratedTransform == nullptr ? nullptr : decoratedTransform->Get();
+}
+
+template <typename TTransform>
+void
+TransformToWasmTransformFilter<TTransform>
+::GenerateData()
+{
+  ITK_WASM_TRACE_SCOPE("TransformToWasmTransformFilter::GenerateData");
+
+  // Get the input and output pointers
+  const TransformType * transform = this->GetInput();
+  WasmTransformType * wasmTransform = this->GetOutput();
+
+  // The JSON references the transform parameters, which are not copied. The
+  // parameters of a displacement field transform reference its field buffer.
+  wasmTransform->SetTransform(transform);
+
+  using ParametersValueType = typename TransformType::ParametersValueType;
+  const auto & fixedParameters = transform->GetFixedParameters();
+  const auto & parameters = transform->GetParameters();
+
+  rapidjson::StringBuffer & stringBuffer = wasm::GetWasmJSONStringBuffer();
+  wasm::WasmJSONWriterType writer(stringBuffer);
+  writer.StartObject();
+
+  writer.Key("transformType");
+  writer.StartObject();
+
+  writer.Key("transformName");
+  wasm::WriteWasmJSONString(writer, transform->GetNameOfClass());
+  writer.Key("parametersValueType");
+  wasm::WriteWasmJSONString(writer, wasm::MapComponentType<ParametersValueType>::ComponentString);
+  writer.Key("inputDimension");
+  writer.Uint(transform->GetInputSpaceDimension());
+  writer.Key("outputDimension");
+  writer.Uint(transform->GetOutputSpaceDimension());
+
+  writer.EndObject();
+
+  writer.Key("name");
+  wasm::WriteWasmJSONString(writer, transform->GetObjectName());
+
+  writer.Key("numberOfFixedParameters");
+  writer.Uint64(static_cast< uint64_t >( fixedParameters.Size() ));
+
+  writer.Key("numberOfParameters");
+  writer.Uint64(static_cast< uint64_t >( parameters.Size() ));
+
+  size_t fixedParametersAddress = 0;
+  if (fixedParameters.Size() > 0)
+  {
+    fixedParametersAddress = reinterpret_cast< size_t >( fixedParameters.data_block() );
+  }
+  writer.Key("fixedParameters");
+  wasm::WriteWasmJSONAddress(writer, fixedParametersAddress);
+
+  size_t parametersAddress = 0;
+  if (parameters.Size() > 0)
+  {
+    parametersAddress = reinterpret_cast< size_t >( parameters.data_block() );
+  }
+  writer.Key("parameters");
+  wasm::WriteWasmJSONAddress(writer, parametersAddress);
+
+  writer.EndObject();
+
+  wasmTransform->SetJSON(std::string(stringBuffer.GetString(), stringBuffer.GetSize()));
+}
+
+template <typename TTransform>
+void
+TransformToWasmTransformFilter<TTransform>
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+}
+} // end namespace itk
+
+#endif
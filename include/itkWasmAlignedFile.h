@@ -0,0 +1,157 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmAlignedFile_h
+#define itkWasmAlignedFile_h
+
+#include "itkWasmCBORSink.h"
+#include "itkWasmCBORSource.h"
+#include "itkWasmRangeReader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/** The .iwi.bin and .iwm.bin aligned files are an uncompressed, single file
+ * form of .iwi.cbor and .iwm.cbor for local caches, whose payloads can be
+ * memory mapped:
+ *
+ *   - an 8 byte magic, \x89IWI\r\n\x1a\n or \x89IWM\r\n\x1a\n
+ *   - the little endian uint64 size of the metadata
+ *   - the metadata, the .iwi.cbor or .iwm.cbor map whose typed array
+ *     entries are a tagged [offset, size] array instead of a byte string
+ *   - the payloads, at offsets from the start of the file that are
+ *     multiples of AlignedFilePayloadAlignment
+ */
+constexpr uint64_t AlignedFilePayloadAlignment = 4096;
+constexpr size_t AlignedFileHeaderSize = 16;
+constexpr std::string_view AlignedImageFileMagic{ "\x89IWI\r\n\x1a\n", 8 };
+constexpr std::string_view AlignedMeshFileMagic{ "\x89IWM\r\n\x1a\n", 8 };
+
+/** Whether the file name ends with the aligned file extension, e.g.
+ * .iwi.bin. */
+inline bool
+FileNameIsAligned(std::string_view fileName, std::string_view extension)
+{
+  return fileName.size() >= extension.size() && fileName.substr(fileName.size() - extension.size()) == extension;
+}
+
+/** The next payload offset at or after offset. */
+constexpr uint64_t
+AlignPayloadOffset(uint64_t offset)
+{
+  return (offset + AlignedFilePayloadAlignment - 1) / AlignedFilePayloadAlignment * AlignedFilePayloadAlignment;
+}
+
+/** Write the location of a payload as the value of a typed array entry,
+ * after its tag. */
+inline void
+WriteAlignedPayloadLocation(CBORSink & sink, uint64_t offset, uint64_t size)
+{
+  sink.WriteArray(2);
+  sink.WriteUInt(offset);
+  sink.WriteUInt(size);
+}
+
+/** Read the location of a payload after the head of its [offset, size]
+ * array. Returns false if the head does not start a location. */
+inline bool
+ReadAlignedPayloadLocation(CBORSource & source, const CBORHead & head, uint64_t & offset, uint64_t & size)
+{
+  CBORHead offsetHead;
+  CBORHead sizeHead;
+  if (head.majorType != 4 || head.argument != 2 || !ReadCBORHead(source, offsetHead) || offsetHead.majorType != 0 ||
+      !ReadCBORHead(source, sizeHead) || sizeHead.majorType != 0)
+  {
+    return false;
+  }
+  offset = offsetHead.argument;
+  size = sizeHead.argument;
+  return true;
+}
+
+/** Encode the metadata with encodeMetadata, which is called with the offset
+ * of the first payload, until the payloads start at the first aligned
+ * offset after the metadata. */
+template <typename TEncodeMetadata>
+std::string
+EncodeAlignedFileMetadata(TEncodeMetadata && encodeMetadata, uint64_t & firstPayloadOffset)
+{
+  std::string metadata;
+  firstPayloadOffset = 0;
+  while (true)
+  {
+    metadata.clear();
+    MemoryCBORSink sink(metadata);
+    encodeMetadata(static_cast<CBORSink &>(sink), firstPayloadOffset);
+    const uint64_t payloadOffset = AlignPayloadOffset(AlignedFileHeaderSize + metadata.size());
+    if (payloadOffset == firstPayloadOffset)
+    {
+      return metadata;
+    }
+    firstPayloadOffset = payloadOffset;
+  }
+}
+
+/** The fixed header of an aligned file with the metadata size. */
+inline std::string
+EncodeAlignedFileHeader(std::string_view magic, uint64_t metadataSize)
+{
+  std::string header(magic);
+  for (size_t ii = 0; ii < 8; ++ii)
+  {
+    header.push_back(static_cast<char>(metadataSize >> (8 * ii)));
+  }
+  return header;
+}
+
+/** Read the metadata of an aligned file. Returns false if the file does not
+ * start with the magic. */
+inline bool
+ReadAlignedFileMetadata(RangeReader & reader, std::string_view magic, std::vector<unsigned char> & metadata)
+{
+  unsigned char header[AlignedFileHeaderSize];
+  if (reader.GetSize() < AlignedFileHeaderSize || !reader.Read(0, header, AlignedFileHeaderSize) ||
+      std::string_view(reinterpret_cast<const char *>(header), magic.size()) != magic)
+  {
+    return false;
+  }
+  uint64_t metadataSize = 0;
+  for (size_t ii = 0; ii < 8; ++ii)
+  {
+    metadataSize |= static_cast<uint64_t>(header[magic.size() + ii]) << (8 * ii);
+  }
+  if (metadataSize > reader.GetSize() - AlignedFileHeaderSize)
+  {
+    return false;
+  }
+  metadata.resize(static_cast<size_t>(metadataSize));
+  return reader.Read(AlignedFileHeaderSize, metadata.data(), metadata.size());
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,80 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmAllocationStats_h
+#define itkWasmAllocationStats_h
+
+#include <cstddef>
+#include <cstdint>
+
+#include "WebAssemblyInterfaceExport.h"
+
+namespace itk
+{
+namespace wasm
+{
+
+/** Boundaries of the glue code where data is copied, counted by
+ * ITK_WASM_COUNT_COPY. */
+enum class CopyBoundary : unsigned int
+{
+  /** Memory store input arrays to images and meshes */
+  InputStore,
+  /** CBOR items and mapped files to IO buffers */
+  CBORToBuffer,
+  /** Decompressed and compressed zstd stream bytes */
+  Zstd,
+  /** WasmStringStream strings */
+  StringStream,
+  /** Outputs to memory store regions bound by the host */
+  OutputStore,
+  Count
+};
+
+#ifdef ITK_WASM_ALLOCATION_STATS
+/** Number of allocation size classes. Class i holds allocations of up to
+ * 16^(i + 1) bytes, the last one all larger allocations. */
+constexpr unsigned int NumberOfAllocationSizeClasses = 8;
+
+/** operator new calls and bytes by size class, and bytes copied at each
+ * CopyBoundary, since the last resetAllocationStats. */
+struct AllocationStats
+{
+  uint64_t allocations[NumberOfAllocationSizeClasses];
+  uint64_t allocatedBytes[NumberOfAllocationSizeClasses];
+  uint64_t copiedBytes[static_cast<unsigned int>(CopyBoundary::Count)];
+};
+
+/** Builds configured with ITK_WASM_ALLOCATION_STATS replace the global
+ * operator new and delete to count allocations, and count the bytes copied
+ * by the glue code. The Pipeline resets the counts, and
+ * itk_wasm_memory_stats reports them for the run. */
+WebAssemblyInterface_EXPORT void addCopiedBytes(CopyBoundary boundary, size_t bytes);
+WebAssemblyInterface_EXPORT AllocationStats getAllocationStats();
+WebAssemblyInterface_EXPORT void resetAllocationStats();
+WebAssemblyInterface_EXPORT const char * getCopyBoundaryName(CopyBoundary boundary);
+
+#  define ITK_WASM_COUNT_COPY(boundary, bytes) \
+    ::itk::wasm::addCopiedBytes(::itk::wasm::CopyBoundary::boundary, static_cast<size_t>(bytes))
+#else
+#  define ITK_WASM_COUNT_COPY(boundary, bytes) static_cast<void>(0)
+#endif
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,133 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmBundleFile_h
+#define itkWasmBundleFile_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkWasmRangeReader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/** The .iwi.bundle and .iwm.bundle files hold a batch or series of images or
+ * meshes, e.g. tiles or slices, so one file is opened, and members share
+ * their common metadata:
+ *
+ *   - an 8 byte magic, \x89IWB\r\n\x1a\n
+ *   - the little endian uint64 offset of the table of contents
+ *   - the members, each the bytes of a .iwi.cbor or .iwi.cbor.zst file, or
+ *     of a .iwm.cbor or .iwm.cbor.zst file
+ *   - the table of contents, a CBOR map with the entries
+ *     bundleType, "Image" or "Mesh",
+ *     metadata, the metadata map shared by the members, and
+ *     members, an array of { name, offset, size, encoding, sharedMetadata }
+ *     maps, where the encoding is "cbor" or "cbor.zst", with the level and
+ *     bounds of the spatial chunks of a chunked mesh, see PartitionMesh
+ *
+ * A member is read through a RangeReader of its bytes, without decoding
+ * the others. A member is appended in place of the table of contents,
+ * which is rewritten after it, so an interrupted append leaves a bundle
+ * without a table of contents.
+ */
+constexpr std::string_view BundleFileMagic{ "\x89IWB\r\n\x1a\n", 8 };
+constexpr size_t BundleFileHeaderSize = 16;
+
+struct BundleMember
+{
+  std::string name;
+  uint64_t offset{ 0 };
+  uint64_t size{ 0 };
+  std::string encoding{ "cbor" };
+  /** Whether the metadata of the bundle applies to the member, before its
+   * own metadata. */
+  bool sharedMetadata{ false };
+  /** Level of detail of a spatial chunk, 0 for the full resolution. */
+  uint32_t level{ 0 };
+  /** Bounding box of a spatial chunk, the minimum then the maximum of each
+   * axis. Empty for members that are not chunks. */
+  std::vector<double> bounds;
+};
+
+struct BundleTableOfContents
+{
+  std::string bundleType;
+  /** Encoded CBOR metadata map shared by the members. */
+  std::string metadata{ "\xa0" };
+  std::vector<BundleMember> members;
+  /** Offset of the table of contents in the file, where the next member is
+   * appended. */
+  uint64_t offset{ BundleFileHeaderSize };
+};
+
+/** Whether the file name ends with the bundle extension, e.g. .iwi.bundle. */
+inline bool
+FileNameIsBundle(std::string_view fileName, std::string_view extension)
+{
+  return fileName.size() >= extension.size() && fileName.substr(fileName.size() - extension.size()) == extension;
+}
+
+/** Read the table of contents of a bundle. Returns false if the reader is
+ * not a bundle. */
+WebAssemblyInterface_EXPORT bool
+ReadBundleTableOfContents(RangeReader & reader, BundleTableOfContents & tableOfContents);
+
+/** The member named name, or the member at index when name is empty.
+ * nullptr if there is no such member. */
+WebAssemblyInterface_EXPORT const BundleMember *
+FindBundleMember(const BundleTableOfContents & tableOfContents, const std::string & name, uint64_t index);
+
+/** A RangeReader of the bytes of a member of the bundle of reader. */
+WebAssemblyInterface_EXPORT std::unique_ptr<RangeReader>
+OpenBundleMember(std::unique_ptr<RangeReader> reader, const BundleMember & member);
+
+/** Read the table of contents of the bundle file a member is appended to.
+ * The table of contents is empty, of the bundleType, when append is false
+ * or the file does not exist. Returns false if the file is not a bundle of
+ * the bundleType. */
+WebAssemblyInterface_EXPORT bool
+ReadBundleForAppending(const std::string & fileName, std::string_view bundleType, bool append, BundleTableOfContents & tableOfContents);
+
+/** Prepare the bundle file to append a member after the members of the
+ * tableOfContents: the table of contents is removed from the file, or a new
+ * file is created for an empty bundle. The member is then written by opening
+ * the file for appending, e.g. fopen(fileName, "ab"). Returns false if the
+ * file cannot be written. */
+WebAssemblyInterface_EXPORT bool
+BeginBundleMember(const std::string & fileName, const BundleTableOfContents & tableOfContents);
+
+/** Add the member appended since BeginBundleMember to the table of
+ * contents, from its name, encoding and sharedMetadata, and write the table
+ * of contents after it. Returns false on a write error. */
+WebAssemblyInterface_EXPORT bool
+EndBundleMember(const std::string & fileName, BundleTableOfContents & tableOfContents, BundleMember member);
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
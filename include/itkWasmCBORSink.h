@@ -0,0 +1,319 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmCBORSink_h
+#define itkWasmCBORSink_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/**
+ *\class CBORSink
+ * \brief Streaming encoder of a .iwi.cbor or .iwm.cbor file
+ *
+ * Items are encoded with definite lengths and written to the sink as they
+ * are added, so byte strings, e.g. pixel data, are written directly from
+ * their buffer without building an item tree or an encoded copy. Write
+ * errors are recorded and reported by Finish.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class CBORSink
+{
+public:
+  virtual ~CBORSink() = default;
+
+  /** Number of bytes of an item head with the given argument. */
+  static constexpr size_t
+  GetHeadSize(uint64_t argument)
+  {
+    if (argument < 24)
+    {
+      return 1;
+    }
+    if (argument <= 0xff)
+    {
+      return 2;
+    }
+    if (argument <= 0xffff)
+    {
+      return 3;
+    }
+    if (argument <= 0xffffffff)
+    {
+      return 5;
+    }
+    return 9;
+  }
+
+  void
+  WriteHead(uint8_t majorType, uint64_t argument)
+  {
+    unsigned char bytes[9];
+    const size_t size = GetHeadSize(argument);
+    if (size == 1)
+    {
+      bytes[0] = static_cast<unsigned char>((majorType << 5) | argument);
+    }
+    else
+    {
+      static constexpr unsigned char additionalInformation[] = { 0, 0, 24, 25, 0, 26, 0, 0, 0, 27 };
+      bytes[0] = static_cast<unsigned char>((majorType << 5) | additionalInformation[size]);
+      for (size_t ii = 1; ii < size; ++ii)
+      {
+        bytes[ii] = static_cast<unsigned char>(argument >> (8 * (size - 1 - ii)));
+      }
+    }
+    this->Append(bytes, size);
+  }
+
+  void
+  WriteUInt(uint64_t value)
+  {
+    this->WriteHead(0, value);
+  }
+
+  void
+  WriteInt(int64_t value)
+  {
+    if (value < 0)
+    {
+      // -1 - value, without overflow at the minimum
+      this->WriteHead(1, ~static_cast<uint64_t>(value));
+    }
+    else
+    {
+      this->WriteHead(0, static_cast<uint64_t>(value));
+    }
+  }
+
+  void
+  WriteBool(bool value)
+  {
+    const unsigned char byte = value ? 0xf5 : 0xf4;
+    this->Append(&byte, 1);
+  }
+
+  void
+  WriteString(std::string_view value)
+  {
+    this->WriteHead(3, value.size());
+    this->Append(value.data(), value.size());
+  }
+
+  void
+  WriteDouble(double value)
+  {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    unsigned char bytes[9];
+    bytes[0] = 0xfb;
+    for (size_t ii = 1; ii < 9; ++ii)
+    {
+      bytes[ii] = static_cast<unsigned char>(bits >> (8 * (8 - ii)));
+    }
+    this->Append(bytes, sizeof(bytes));
+  }
+
+  void
+  WriteFloat(float value)
+  {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    unsigned char bytes[5];
+    bytes[0] = 0xfa;
+    for (size_t ii = 1; ii < 5; ++ii)
+    {
+      bytes[ii] = static_cast<unsigned char>(bits >> (8 * (4 - ii)));
+    }
+    this->Append(bytes, sizeof(bytes));
+  }
+
+  void
+  WriteByteString(const void * data, size_t size)
+  {
+    this->WriteHead(2, size);
+    this->Append(data, size);
+  }
+
+  /** Write the head of a byte string whose content is written in pieces
+   * with WriteByteStringContent. */
+  void
+  WriteByteStringHead(uint64_t size)
+  {
+    this->WriteHead(2, size);
+  }
+
+  void
+  WriteByteStringContent(const void * data, size_t size)
+  {
+    this->Append(data, size);
+  }
+
+  /** Whether the content of byte strings is discarded, e.g. when only the
+   * encoded size is counted, so it need not be produced. */
+  virtual bool
+  DiscardsContent() const
+  {
+    return false;
+  }
+
+  void
+  WriteArray(uint64_t count)
+  {
+    this->WriteHead(4, count);
+  }
+
+  void
+  WriteMap(uint64_t count)
+  {
+    this->WriteHead(5, count);
+  }
+
+  void
+  WriteTag(uint64_t tag)
+  {
+    this->WriteHead(6, tag);
+  }
+
+  /** Flush the encoded output. Returns false if any write failed. */
+  bool
+  Finish()
+  {
+    if (!m_Failed && !this->Flush())
+    {
+      m_Failed = true;
+    }
+    return !m_Failed;
+  }
+
+protected:
+  /** Write the next encoded bytes. Returns false on a write error. */
+  virtual bool
+  WriteBytes(const void * data, size_t size) = 0;
+
+  virtual bool
+  Flush()
+  {
+    return true;
+  }
+
+private:
+  void
+  Append(const void * data, size_t size)
+  {
+    if (!m_Failed && size > 0 && !this->WriteBytes(data, size))
+    {
+      m_Failed = true;
+    }
+  }
+
+  bool m_Failed{ false };
+};
+
+/** Counts the encoded bytes, e.g. to pledge the size of a compressed frame. */
+class CountingCBORSink : public CBORSink
+{
+public:
+  uint64_t
+  GetSize() const
+  {
+    return m_Size;
+  }
+
+  bool
+  DiscardsContent() const override
+  {
+    return true;
+  }
+
+protected:
+  bool
+  WriteBytes(const void *, size_t size) override
+  {
+    m_Size += size;
+    return true;
+  }
+
+private:
+  uint64_t m_Size{ 0 };
+};
+
+/** Appends the encoded bytes to a string. */
+class MemoryCBORSink : public CBORSink
+{
+public:
+  explicit MemoryCBORSink(std::string & encoded)
+    : m_Encoded(encoded)
+  {}
+
+protected:
+  bool
+  WriteBytes(const void * data, size_t size) override
+  {
+    m_Encoded.append(static_cast<const char *>(data), size);
+    return true;
+  }
+
+private:
+  std::string & m_Encoded;
+};
+
+/** Writes the encoded bytes to a file. The sink owns and closes the file. */
+class FileCBORSink : public CBORSink
+{
+public:
+  explicit FileCBORSink(FILE * file)
+    : m_File(file)
+  {}
+
+  ~FileCBORSink() override
+  {
+    fclose(m_File);
+  }
+
+protected:
+  bool
+  WriteBytes(const void * data, size_t size) override
+  {
+    return fwrite(data, 1, size, m_File) == size;
+  }
+
+  bool
+  Flush() override
+  {
+    return fflush(m_File) == 0;
+  }
+
+private:
+  FILE * m_File;
+};
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,238 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmCBORSource_h
+#define itkWasmCBORSource_h
+
+#include "itkWasmAllocationStats.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/**
+ *\class CBORSource
+ * \brief Sequential source of the encoded bytes of a .iwi.cbor file
+ *
+ * The CBOR readers decode the small entries of a file from a source and read
+ * large byte strings, e.g. pixel data, directly into their destination.
+ * Sources may be a file, a memory buffer, or a decompression stream.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class CBORSource
+{
+public:
+  virtual ~CBORSource() = default;
+
+  /** Read the next size bytes into data. Returns false if the input ends
+   * before size bytes are read. */
+  bool
+  Read(void * data, size_t size)
+  {
+    if (!this->ReadBytes(data, size))
+    {
+      return false;
+    }
+    m_Position += size;
+    return true;
+  }
+
+  /** Skip the next size bytes. */
+  bool
+  Skip(uint64_t size)
+  {
+    if (!this->SkipBytes(size))
+    {
+      return false;
+    }
+    m_Position += size;
+    return true;
+  }
+
+  /** Number of bytes read or skipped from the start of the encoded file. */
+  uint64_t
+  GetPosition() const
+  {
+    return m_Position;
+  }
+
+protected:
+  virtual bool
+  ReadBytes(void * data, size_t size) = 0;
+
+  virtual bool
+  SkipBytes(uint64_t size)
+  {
+    unsigned char scratch[4096];
+    while (size > 0)
+    {
+      const size_t chunkSize = static_cast<size_t>(std::min<uint64_t>(size, sizeof(scratch)));
+      if (!this->ReadBytes(scratch, chunkSize))
+      {
+        return false;
+      }
+      size -= chunkSize;
+    }
+    return true;
+  }
+
+private:
+  uint64_t m_Position{ 0 };
+};
+
+/**
+ *\class MemoryCBORSource
+ * \brief CBORSource of an encoded buffer in memory
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class MemoryCBORSource : public CBORSource
+{
+public:
+  MemoryCBORSource(const unsigned char * data, size_t size)
+    : m_Data(data)
+    , m_Remaining(size)
+  {}
+
+protected:
+  bool
+  ReadBytes(void * data, size_t size) override
+  {
+    if (size > m_Remaining)
+    {
+      return false;
+    }
+    if (size > 0)
+    {
+      std::memcpy(data, m_Data, size);
+      ITK_WASM_COUNT_COPY(CBORToBuffer, size);
+    }
+    return this->SkipBytes(size);
+  }
+
+  bool
+  SkipBytes(uint64_t size) override
+  {
+    if (size > m_Remaining)
+    {
+      return false;
+    }
+    m_Data += size;
+    m_Remaining -= size;
+    return true;
+  }
+
+private:
+  const unsigned char * m_Data;
+  size_t                m_Remaining;
+};
+
+/** Head of an encoded CBOR item: the major type and its argument */
+struct CBORHead
+{
+  uint8_t       majorType{ 0 };
+  uint64_t      argument{ 0 };
+  unsigned char bytes[9];
+  size_t        size{ 0 };
+};
+
+inline bool
+ReadCBORHead(CBORSource & source, CBORHead & head)
+{
+  if (!source.Read(head.bytes, 1))
+  {
+    return false;
+  }
+  head.majorType = head.bytes[0] >> 5;
+  const uint8_t additionalInformation = head.bytes[0] & 0x1f;
+  if (additionalInformation < 24)
+  {
+    head.argument = additionalInformation;
+    head.size = 1;
+    return true;
+  }
+  if (additionalInformation > 27)
+  {
+    // Indefinite lengths are not written by the Wasm IO's
+    return false;
+  }
+  const size_t argumentSize = size_t{ 1 } << (additionalInformation - 24);
+  if (!source.Read(head.bytes + 1, argumentSize))
+  {
+    return false;
+  }
+  head.argument = 0;
+  for (size_t ii = 1; ii <= argumentSize; ++ii)
+  {
+    head.argument = (head.argument << 8) | head.bytes[ii];
+  }
+  head.size = 1 + argumentSize;
+  return true;
+}
+
+/** Append the encoded bytes of the next CBOR item in the source */
+inline bool
+CopyCBORItem(CBORSource & source, std::vector<unsigned char> & encoded)
+{
+  CBORHead head;
+  if (!ReadCBORHead(source, head))
+  {
+    return false;
+  }
+  encoded.insert(encoded.end(), head.bytes, head.bytes + head.size);
+  switch (head.majorType)
+  {
+    case 2: // byte string
+    case 3: // text string
+    {
+      const size_t offset = encoded.size();
+      encoded.resize(offset + head.argument);
+      return source.Read(encoded.data() + offset, head.argument);
+    }
+    case 4: // array
+    case 5: // map
+    {
+      const uint64_t count = head.majorType == 5 ? 2 * head.argument : head.argument;
+      for (uint64_t ii = 0; ii < count; ++ii)
+      {
+        if (!CopyCBORItem(source, encoded))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    case 6: // tag
+      return CopyCBORItem(source, encoded);
+    default: // integers, floats and simple values
+      return true;
+  }
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,261 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmComponentConversion_h
+#define itkWasmComponentConversion_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__wasm_simd128__)
+#  include <wasm_simd128.h>
+#endif
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/** Component types of memory IO input images that are converted on import
+ * to the component type of a pipeline specialization, so a pipeline need
+ * not be instantiated for each of them.
+ *
+ * - IntegerToInt32: int8, uint8, int16 and uint16 to int32, exactly.
+ * - IntegerToFloat32: every integer type to float32. Integers beyond 24
+ *   bits are rounded.
+ * - ToFloat32: every integer type and float64 to float32.
+ * - ToFloat64: every integer type and float32 to float64. Integers beyond
+ *   53 bits are rounded.
+ * - Cast: every component type to the component type of the specialization,
+ *   for pipelines that dispatch on their output component type, e.g. a cast.
+ *
+ * Float to integer conversions truncate toward zero and wrap, and NaN and
+ * infinities convert to 0, as with JavaScript TypedArray's.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+enum class ComponentConversion : uint8_t
+{
+  None,
+  IntegerToInt32,
+  IntegerToFloat32,
+  ToFloat32,
+  ToFloat64,
+  Cast
+};
+
+WebAssemblyInterface_EXPORT std::ostream &
+operator<<(std::ostream & out, ComponentConversion conversion);
+
+/** Component type that an input with componentType is converted to, or an
+ * empty view if the conversion does not apply to it. Cast has no single
+ * converted type and returns an empty view. */
+WebAssemblyInterface_EXPORT std::string_view
+GetConvertedComponentType(ComponentConversion conversion, std::string_view componentType);
+
+/** Whether an input with componentType is converted to targetComponentType. */
+WebAssemblyInterface_EXPORT bool
+IsConvertedComponentType(ComponentConversion conversion, std::string_view componentType, std::string_view targetComponentType);
+
+/** Convert one component, with the float to integer semantics of
+ * ComponentConversion. */
+template <typename TComponent, typename TSource>
+TComponent
+ConvertComponent(TSource value)
+{
+  if constexpr (std::is_floating_point_v<TSource> && std::is_integral_v<TComponent>)
+  {
+    if (!std::isfinite(value))
+    {
+      return 0;
+    }
+    const double truncated = std::trunc(static_cast<double>(value));
+    if constexpr (sizeof(TComponent) <= 4)
+    {
+      // Within int64 after the modulo, then wrapped by the unsigned casts
+      const auto wrapped = static_cast<int64_t>(std::fmod(truncated, 4294967296.0));
+      return static_cast<TComponent>(static_cast<uint32_t>(wrapped));
+    }
+    else
+    {
+      // The magnitude after the modulo is within uint64, and negation wraps
+      const double wrapped = std::fmod(truncated, 18446744073709551616.0);
+      const auto magnitude = static_cast<uint64_t>(std::fabs(wrapped));
+      return static_cast<TComponent>(wrapped < 0.0 ? uint64_t{ 0 } - magnitude : magnitude);
+    }
+  }
+  else
+  {
+    return static_cast<TComponent>(value);
+  }
+}
+
+namespace detail
+{
+
+#if defined(__wasm_simd128__)
+/** Convert the leading components that are a multiple of the SIMD128 lane
+ * count with wasm SIMD128 instructions. Returns the number converted. */
+template <typename TSource, typename TComponent>
+size_t
+ConvertComponentsSIMD([[maybe_unused]] const TSource * source, [[maybe_unused]] size_t count, [[maybe_unused]] TComponent * destination)
+{
+  size_t ii = 0;
+  if constexpr (std::is_same_v<TComponent, float> && (std::is_same_v<TSource, uint8_t> || std::is_same_v<TSource, int8_t>))
+  {
+    for (; ii + 16 <= count; ii += 16)
+    {
+      const v128_t bytes = wasm_v128_load(source + ii);
+      const v128_t low = std::is_signed_v<TSource> ? wasm_i16x8_extend_low_i8x16(bytes) : wasm_u16x8_extend_low_u8x16(bytes);
+      const v128_t high = std::is_signed_v<TSource> ? wasm_i16x8_extend_high_i8x16(bytes) : wasm_u16x8_extend_high_u8x16(bytes);
+      // Every 16 bit lane is now sign or zero extended, so signed widening
+      // is exact for both
+      wasm_v128_store(destination + ii, wasm_f32x4_convert_i32x4(wasm_i32x4_extend_low_i16x8(low)));
+      wasm_v128_store(destination + ii + 4, wasm_f32x4_convert_i32x4(wasm_i32x4_extend_high_i16x8(low)));
+      wasm_v128_store(destination + ii + 8, wasm_f32x4_convert_i32x4(wasm_i32x4_extend_low_i16x8(high)));
+      wasm_v128_store(destination + ii + 12, wasm_f32x4_convert_i32x4(wasm_i32x4_extend_high_i16x8(high)));
+    }
+  }
+  else if constexpr (std::is_same_v<TComponent, float> && (std::is_same_v<TSource, uint16_t> || std::is_same_v<TSource, int16_t>))
+  {
+    for (; ii + 8 <= count; ii += 8)
+    {
+      const v128_t values = wasm_v128_load(source + ii);
+      const v128_t low = std::is_signed_v<TSource> ? wasm_i32x4_extend_low_i16x8(values) : wasm_u32x4_extend_low_u16x8(values);
+      const v128_t high = std::is_signed_v<TSource> ? wasm_i32x4_extend_high_i16x8(values) : wasm_u32x4_extend_high_u16x8(values);
+      wasm_v128_store(destination + ii, wasm_f32x4_convert_i32x4(low));
+      wasm_v128_store(destination + ii + 4, wasm_f32x4_convert_i32x4(high));
+    }
+  }
+  else if constexpr (std::is_same_v<TSource, float> && std::is_integral_v<TComponent> && sizeof(TComponent) <= 4)
+  {
+    // Lanes within the int32 range truncate exactly, and the low bytes of
+    // the int32 lanes wrap as the scalar conversion does. Vectors with other
+    // lanes, e.g. NaN's, take the scalar path.
+    const v128_t limit = wasm_f32x4_splat(2147483648.0f);
+    for (; ii + 4 <= count; ii += 4)
+    {
+      const v128_t values = wasm_v128_load(source + ii);
+      if (!wasm_i32x4_all_true(wasm_f32x4_lt(wasm_f32x4_abs(values), limit)))
+      {
+        for (size_t jj = ii; jj < ii + 4; ++jj)
+        {
+          destination[jj] = ConvertComponent<TComponent>(source[jj]);
+        }
+        continue;
+      }
+      const v128_t truncated = wasm_i32x4_trunc_sat_f32x4(values);
+      if constexpr (sizeof(TComponent) == 4)
+      {
+        wasm_v128_store(destination + ii, truncated);
+      }
+      else if constexpr (sizeof(TComponent) == 2)
+      {
+        wasm_v128_store64_lane(destination + ii, wasm_i8x16_shuffle(truncated, truncated, 0, 1, 4, 5, 8, 9, 12, 13, 0, 1, 4, 5, 8, 9, 12, 13), 0);
+      }
+      else
+      {
+        wasm_v128_store32_lane(destination + ii, wasm_i8x16_shuffle(truncated, truncated, 0, 4, 8, 12, 0, 4, 8, 12, 0, 4, 8, 12, 0, 4, 8, 12), 0);
+      }
+    }
+  }
+  return ii;
+}
+#endif
+
+template <typename TSource, typename TComponent>
+void
+ConvertComponentsFrom(const void * source, size_t count, TComponent * destination)
+{
+  const auto * sourceComponents = static_cast<const TSource *>(source);
+  size_t ii = 0;
+#if defined(__wasm_simd128__)
+  ii = ConvertComponentsSIMD(sourceComponents, count, destination);
+#endif
+  // The remainder, and other types in a plain loop, which compilers
+  // vectorize, e.g. with -O2 -msimd128
+  for (; ii < count; ++ii)
+  {
+    destination[ii] = ConvertComponent<TComponent>(sourceComponents[ii]);
+  }
+}
+} // end namespace detail
+
+/** Convert count components of componentType at source to destination.
+ * Returns false if componentType is unknown. */
+template <typename TComponent>
+bool
+ConvertComponents(std::string_view componentType, const void * source, size_t count, TComponent * destination)
+{
+  if (componentType == "int8")
+  {
+    detail::ConvertComponentsFrom<int8_t>(source, count, destination);
+  }
+  else if (componentType == "uint8")
+  {
+    detail::ConvertComponentsFrom<uint8_t>(source, count, destination);
+  }
+  else if (componentType == "int16")
+  {
+    detail::ConvertComponentsFrom<int16_t>(source, count, destination);
+  }
+  else if (componentType == "uint16")
+  {
+    detail::ConvertComponentsFrom<uint16_t>(source, count, destination);
+  }
+  else if (componentType == "int32")
+  {
+    detail::ConvertComponentsFrom<int32_t>(source, count, destination);
+  }
+  else if (componentType == "uint32")
+  {
+    detail::ConvertComponentsFrom<uint32_t>(source, count, destination);
+  }
+  else if (componentType == "int64")
+  {
+    detail::ConvertComponentsFrom<int64_t>(source, count, destination);
+  }
+  else if (componentType == "uint64")
+  {
+    detail::ConvertComponentsFrom<uint64_t>(source, count, destination);
+  }
+  else if (componentType == "float32")
+  {
+    detail::ConvertComponentsFrom<float>(source, count, destination);
+  }
+  else if (componentType == "float64")
+  {
+    detail::ConvertComponentsFrom<double>(source, count, destination);
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
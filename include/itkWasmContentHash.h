@@ -0,0 +1,217 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmContentHash_h
+#define itkWasmContentHash_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/**
+ *\class ContentHash
+ * \brief Streaming 64-bit XXH64 hash of binary content
+ *
+ * Used to key the pipeline result cache. Bytes can be added in any number of
+ * Update calls; the digest only depends on the concatenated content.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class ContentHash
+{
+public:
+  explicit ContentHash(uint64_t seed = 0)
+    : m_Accumulators{ seed + Prime1 + Prime2, seed + Prime2, seed, seed - Prime1 }
+    , m_Seed(seed)
+  {}
+
+  void
+  Update(const void * data, size_t size)
+  {
+    auto bytes = static_cast<const uint8_t *>(data);
+    m_TotalSize += size;
+
+    if (m_BufferSize + size < StripeSize)
+    {
+      if (size > 0)
+      {
+        std::memcpy(m_Buffer + m_BufferSize, bytes, size);
+      }
+      m_BufferSize += size;
+      return;
+    }
+
+    if (m_BufferSize > 0)
+    {
+      const size_t fill = StripeSize - m_BufferSize;
+      std::memcpy(m_Buffer + m_BufferSize, bytes, fill);
+      ConsumeStripe(m_Buffer);
+      bytes += fill;
+      size -= fill;
+      m_BufferSize = 0;
+    }
+
+    while (size >= StripeSize)
+    {
+      ConsumeStripe(bytes);
+      bytes += StripeSize;
+      size -= StripeSize;
+    }
+
+    if (size > 0)
+    {
+      std::memcpy(m_Buffer, bytes, size);
+    }
+    m_BufferSize = size;
+  }
+
+  void
+  Update(std::string_view content)
+  {
+    this->Update(content.data(), content.size());
+  }
+
+  /** Add a value with its size so adjacent fields cannot alias. */
+  template <typename TValue>
+  void
+  UpdateValue(const TValue & value)
+  {
+    this->Update(&value, sizeof(value));
+  }
+
+  void
+  UpdateField(std::string_view content)
+  {
+    this->UpdateValue(static_cast<uint64_t>(content.size()));
+    this->Update(content);
+  }
+
+  uint64_t
+  Digest() const
+  {
+    uint64_t hash;
+    if (m_TotalSize >= StripeSize)
+    {
+      hash = RotateLeft(m_Accumulators[0], 1) + RotateLeft(m_Accumulators[1], 7) + RotateLeft(m_Accumulators[2], 12) +
+             RotateLeft(m_Accumulators[3], 18);
+      for (const uint64_t accumulator : m_Accumulators)
+      {
+        hash = (hash ^ Round(0, accumulator)) * Prime1 + Prime4;
+      }
+    }
+    else
+    {
+      hash = m_Seed + Prime5;
+    }
+    hash += m_TotalSize;
+
+    const uint8_t * bytes = m_Buffer;
+    size_t size = m_BufferSize;
+    while (size >= 8)
+    {
+      hash ^= Round(0, Read64(bytes));
+      hash = RotateLeft(hash, 27) * Prime1 + Prime4;
+      bytes += 8;
+      size -= 8;
+    }
+    if (size >= 4)
+    {
+      hash ^= static_cast<uint64_t>(Read32(bytes)) * Prime1;
+      hash = RotateLeft(hash, 23) * Prime2 + Prime3;
+      bytes += 4;
+      size -= 4;
+    }
+    while (size > 0)
+    {
+      hash ^= (*bytes) * Prime5;
+      hash = RotateLeft(hash, 11) * Prime1;
+      ++bytes;
+      --size;
+    }
+
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    hash *= Prime3;
+    hash ^= hash >> 32;
+    return hash;
+  }
+
+private:
+  static constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+  static constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+  static constexpr uint64_t Prime3 = 0x165667B19E3779F9ull;
+  static constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+  static constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ull;
+  static constexpr size_t   StripeSize = 32;
+
+  static constexpr uint64_t
+  RotateLeft(uint64_t value, unsigned int bits)
+  {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+  static constexpr uint64_t
+  Round(uint64_t accumulator, uint64_t input)
+  {
+    return RotateLeft(accumulator + input * Prime2, 31) * Prime1;
+  }
+
+  // Little-endian loads, as on WebAssembly
+  static uint64_t
+  Read64(const uint8_t * bytes)
+  {
+    uint64_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+  }
+
+  static uint32_t
+  Read32(const uint8_t * bytes)
+  {
+    uint32_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+  }
+
+  void
+  ConsumeStripe(const uint8_t * stripe)
+  {
+    for (unsigned int ii = 0; ii < 4; ++ii)
+    {
+      m_Accumulators[ii] = Round(m_Accumulators[ii], Read64(stripe + 8 * ii));
+    }
+  }
+
+  uint64_t m_Accumulators[4];
+  uint64_t m_Seed;
+  uint64_t m_TotalSize{ 0 };
+  uint8_t  m_Buffer[StripeSize];
+  size_t   m_BufferSize{ 0 };
+};
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -22,6 +22,10 @@
 // WebAssembly exports for memory io
 
 #include "itkWasmDataObject.h"
+#include "itkWasmImageDescriptor.h"
+#include "itkWasmContentHash.h"
+#include "itkWasmResultCache.h"
+#include "itkWasmAllocationStats.h"
 
 #if defined(__EMSCRIPTEN__)
 #  include "emscripten/em_macros.h"
@@ -31,26 +35,141 @@
 
 #include "WebAssemblyInterfaceExport.h"
 
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace itk
 {
 namespace wasm
 {
 
+/** Allocator whose value-initialization, e.g. in std::vector::resize, leaves
+ * the elements uninitialized, so input arrays are not zero-filled before
+ * the host copies the data into them. */
+template <typename T>
+class DefaultInitAllocator : public std::allocator<T>
+{
+public:
+  template <typename U>
+  struct rebind
+  {
+    using other = DefaultInitAllocator<U>;
+  };
+
+  DefaultInitAllocator() = default;
+  template <typename U>
+  DefaultInitAllocator(const DefaultInitAllocator<U> &) noexcept
+  {}
+
+  template <typename U>
+  void construct(U * pointer) noexcept(std::is_nothrow_default_constructible<U>::value)
+  {
+    ::new (static_cast<void *>(pointer)) U;
+  }
+  template <typename U, typename... TArgs>
+  void construct(U * pointer, TArgs &&... args)
+  {
+    ::new (static_cast<void *>(pointer)) U(std::forward<TArgs>(args)...);
+  }
+};
+
 // dataset index, array index
 using InputArrayStoreKeyType = std::pair<uint32_t, uint32_t>;
-using InputArrayStoreValueType = std::vector<uint8_t>;
+using InputArrayStoreValueType = std::vector<uint8_t, DefaultInitAllocator<uint8_t>>;
 using InputArrayStoreType = std::map<InputArrayStoreKeyType, InputArrayStoreValueType>;
 
 // Function for the Pipeline Input's and Output's to set / get from the memory store
+//
+// The memoryIndex identifies a memory store session. Session 0 always
+// exists. Additional sessions are created with itk_wasm_memory_session_create
+// so a single module instance can stage inputs for one invocation while the
+// outputs of another invocation are still being read. Each session has its
+// own lock, so the stages of an invocation may read and write its stores from
+// multiple threads.
 
 WebAssemblyInterface_EXPORT const std::string & getMemoryStoreInputJSON(uint32_t memoryIndex, uint32_t index);
 
-WebAssemblyInterface_EXPORT const InputArrayStoreType & getMemoryInputArrayStore();
+/** The input arrays of a session. The store is not locked while the caller
+ * reads it, so inputs of the session must not be staged meanwhile. */
+WebAssemblyInterface_EXPORT const InputArrayStoreType & getMemoryInputArrayStore(uint32_t memoryIndex = 0);
+
+/** Whether input arrays of the session should be handed off to the data
+ * objects that import them instead of being referenced from the store. */
+WebAssemblyInterface_EXPORT bool getMemoryStoreInputArrayHandoff(uint32_t memoryIndex);
+
+/** Move the input array whose buffer starts at address out of the memory store.
+ *
+ * The buffer address is unchanged by the move. Returns false if no input array
+ * at that address is in the store. */
+WebAssemblyInterface_EXPORT bool takeMemoryStoreInputArray(uint32_t memoryIndex, size_t address, InputArrayStoreValueType & array);
+
+/** Handle to keep the data object imported from an input resident as, set
+ * with itk_wasm_input_retain. Returns false if the input is not retained. */
+WebAssemblyInterface_EXPORT bool getMemoryStoreInputRetainHandle(uint32_t memoryIndex, uint32_t index, uint32_t & handle);
+
+/** Binary image descriptor for an input, or nullptr if the input was provided as JSON. */
+WebAssemblyInterface_EXPORT const WasmImageDescriptor * getMemoryStoreInputImageDescriptor(uint32_t memoryIndex, uint32_t index);
+
+/** Whether image outputs of the session are published as binary descriptors instead of JSON. */
+WebAssemblyInterface_EXPORT bool getMemoryStoreUseImageDescriptors(uint32_t memoryIndex);
+
+/** Whether the metadata of image output descriptors is a CBOR map instead of JSON text. */
+WebAssemblyInterface_EXPORT bool getMemoryStoreUseCBORMetadata(uint32_t memoryIndex);
+
+/** Whether multi-component image pixel data of the session is planar, channel-first, instead of interleaved. */
+WebAssemblyInterface_EXPORT bool getMemoryStoreUsePlanarLayout(uint32_t memoryIndex);
+
+/** Whether image output sub-regions of the session are published as strided views into their source buffer. */
+WebAssemblyInterface_EXPORT bool getMemoryStoreUseStridedViews(uint32_t memoryIndex);
+
+WebAssemblyInterface_EXPORT void setMemoryStoreOutputImageDescriptor(uint32_t memoryIndex, uint32_t index, const WasmImageDescriptor & descriptor);
 
 WebAssemblyInterface_EXPORT void setMemoryStoreOutputDataObject(uint32_t memoryIndex, uint32_t index, const WasmDataObject * dataObject);
 
 WebAssemblyInterface_EXPORT void setMemoryStoreOutputArray(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t address, size_t size);
 
+/** Publish size bytes at data as a binary or text stream output, read by the
+ * host in place. owner, which keeps the bytes valid, lives with the output
+ * data object until the host frees the output. */
+WebAssemblyInterface_EXPORT void setMemoryStoreOutputBuffer(uint32_t memoryIndex, uint32_t index, const void * data, size_t size, std::shared_ptr<const void> owner);
+
+/** Whether the host requested the running pipeline to abort, see
+ * itk_wasm_request_abort. */
+WebAssemblyInterface_EXPORT bool getAbortRequested();
+WebAssemblyInterface_EXPORT void clearAbortRequested();
+
+/** Record the current heap size as the peak of a pipeline phase reported by
+ * itk_wasm_memory_stats, e.g. "parse", "compute", or "outputs". The first
+ * mark of a phase after resetMemoryPhases is kept. */
+WebAssemblyInterface_EXPORT void markMemoryPhase(const char * phase);
+WebAssemblyInterface_EXPORT void resetMemoryPhases();
+
+/** Destination region bound by the host for an output array with
+ * itk_wasm_output_array_bind. Returns false if the output array is not bound. */
+WebAssemblyInterface_EXPORT bool getMemoryStoreOutputArrayBinding(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t & address, size_t & size);
+
+/** Add the input JSON and input arrays of a session to a result cache key.
+ *
+ * Each input array is hashed once and its digest is kept until the array is
+ * reallocated or freed. Returns false for sessions that use binary image
+ * descriptors, which are not cached. */
+WebAssemblyInterface_EXPORT bool hashMemoryStoreInputs(uint32_t memoryIndex, ContentHash & hash);
+
+/** Start tracking the outputs set by a run for getMemoryStoreResultCacheEntry. */
+WebAssemblyInterface_EXPORT void resetMemoryStoreUpdatedOutputs(uint32_t memoryIndex);
+
+/** Copy the outputs set since resetMemoryStoreUpdatedOutputs into a result
+ * cache entry. Returns false if no outputs were set. */
+WebAssemblyInterface_EXPORT bool getMemoryStoreResultCacheEntry(uint32_t memoryIndex, ResultCacheEntry & entry);
+
+/** Publish the outputs of a result cache entry as if a run had set them.
+ * Arrays bound with itk_wasm_output_array_bind are copied to their region. */
+WebAssemblyInterface_EXPORT void setMemoryStoreResultCacheEntry(uint32_t memoryIndex, std::shared_ptr<const ResultCacheEntry> entry);
+
 
 } // end namespace wasm
 } // end namespace itk
@@ -59,15 +178,128 @@ extern "C"
 {
 
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_input_array_alloc(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t size);
+/** Reserve an empty input array with room for capacity bytes, to be filled in
+ * chunks with itk_wasm_input_array_append. Returns the address of the array,
+ * which does not move, since appends past the capacity are rejected. */
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_input_array_reserve(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t capacity);
+/** Grow an input array by size bytes within its reserved capacity and return
+ * the address to copy the chunk to. Returns 0, and does not grow the array,
+ * when the chunk does not fit in the capacity. */
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_input_array_append(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t size);
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_input_json_alloc(uint32_t memoryIndex, uint32_t index, size_t size);
 
+/** 1 when the pipeline set the output, 0 for an optional output it did not
+ * write, e.g. the image of a --lut-output run. The JSON address and size of
+ * an unset output are 0. */
+WebAssemblyInterface_EXPORT uint32_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_exists(uint32_t memoryIndex, uint32_t index);
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_json_address(uint32_t memoryIndex, uint32_t index);
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_json_size(uint32_t memoryIndex, uint32_t index);
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_array_address(uint32_t memoryIndex, uint32_t index, uint32_t subIndex);
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_array_size(uint32_t memoryIndex, uint32_t index, uint32_t subIndex);
 
+/** Bind an output array to a destination region in linear memory before the
+ * run. Outputs that support it are written directly into the region, and
+ * itk_wasm_output_array_address then returns its address. An address or size
+ * of 0 removes the binding. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_output_array_bind(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t address, size_t size);
+
 WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_free_all();
 
+/** Keep the outputs of memory IO runs in a result cache of up to capacity
+ * bytes in the module memory. Runs with the same pipeline, parameters and
+ * inputs as a cached run skip the pipeline functor and publish the cached
+ * outputs. A capacity of 0, the default, disables the cache. Only enable it
+ * for deterministic pipelines. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_result_cache_capacity(size_t capacity);
+
+/** Request the running pipeline to abort. Filters registered with
+ * Pipeline::abort_on_request stop at their next progress update. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_request_abort();
+/** Address of the 32-bit abort flag. A host thread that shares the module
+ * memory can set it to a nonzero value while the pipeline runs. */
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_abort_flag_address();
+
+/** Generate a JSON report of the bytes held by the memory stores of a session,
+ * the input array buffer pool, and the heap, and return its address. Builds
+ * with ITK_WASM_ALLOCATION_STATS add the allocations by size class and the
+ * bytes copied at each CopyBoundary during the run. The report is valid
+ * until the next call. */
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_memory_stats(uint32_t memoryIndex);
+/** Size of the report generated by the last itk_wasm_memory_stats call. */
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_memory_stats_size();
+
+/** Release a single input array. Its allocation is kept in a buffer pool and
+ * reused by a later itk_wasm_input_array_alloc of a similar size. Arrays
+ * released by itk_wasm_free_all are pooled too. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_free_input(uint32_t memoryIndex, uint32_t index, uint32_t subIndex);
+/** Release a single input JSON description. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_free_input_json(uint32_t memoryIndex, uint32_t index);
+/** Release an output data object and all of its output arrays. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_free_output(uint32_t memoryIndex, uint32_t index);
+/** Return the allocations held in the input array buffer pool to the heap. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_buffer_pool_clear();
+/** Limit the input array buffer pool to capacity bytes, 64 MiB by default.
+ * When a released array does not fit, the oldest pooled arrays are returned
+ * to the heap. Arrays larger than the capacity are not pooled. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_buffer_pool_capacity(size_t capacity);
+
+/** Size in bytes of the binary image descriptor, itk::wasm::WasmImageDescriptor. */
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_image_descriptor_size();
+/** Allocate a zero-initialized binary image descriptor for an input. The host fills it instead of providing input JSON. */
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_input_image_descriptor_alloc(uint32_t memoryIndex, uint32_t index);
+/** Address of the binary image descriptor for an image output. */
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_image_descriptor_address(uint32_t memoryIndex, uint32_t index);
+/** Publish image outputs of the session as binary descriptors instead of JSON. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_use_image_descriptors(uint32_t memoryIndex, uint32_t enable);
+/** Encode the metadata of image output descriptors as a CBOR map, see
+ * itk::wasm::WriteCBORMetaDataDictionary, instead of JSON text. Numeric
+ * arrays are then typed arrays, not formatted numbers. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_use_cbor_metadata(uint32_t memoryIndex, uint32_t enable);
+/** Exchange multi-component image pixel data of the session with each
+ * component in its own plane, channel-first, e.g. numpy arrays, instead of
+ * interleaved. Input images are interleaved on import and output images
+ * are planarized, both split across threads. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_use_planar_layout(uint32_t memoryIndex, uint32_t enable);
+/** Publish image outputs of the session that are a sub-region of a larger
+ * buffer, see OutputImage::SetRegion, as views with the `strides` entry of
+ * the image JSON instead of contiguous copies. For hosts that read strided
+ * data, e.g. numpy. Not used with image descriptors or the planar layout of
+ * multi-component images. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_use_strided_views(uint32_t memoryIndex, uint32_t enable);
+
+/** Enable or disable handing ownership of input arrays to the imported data
+ * objects, e.g. image pixel containers. When enabled, inputs are released with
+ * the data objects rather than by itk_wasm_free_all and peak memory is not
+ * doubled. Each input array can then only be imported once. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_input_array_handoff(uint32_t memoryIndex, uint32_t enable);
+
+/** Keep the data object imported from an input of the next run resident in
+ * the module instance as `handle:<handle>`, replacing the data object of
+ * the handle, see itk::wasm::IsHandleIdentifier. Later runs pass the handle
+ * identifier instead of the input index, and the input is not transferred
+ * or imported again. The input arrays are handed off to the data object,
+ * so they must be allocated with itk_wasm_input_array_alloc. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_input_retain(uint32_t memoryIndex, uint32_t index, uint32_t handle);
+/** Copy a region of pixels into a resident image, e.g. a brush stroke in a
+ * label map, instead of transferring the whole image again. The region at
+ * regionAddress is dimension int64 index values followed by dimension
+ * uint64 size values, and the dataSize bytes at dataAddress are its pixels.
+ * The image is marked Modified. Returns 0 on an invalid patch, see
+ * itk::wasm::PatchStageImageRegion. */
+WebAssemblyInterface_EXPORT uint32_t EMSCRIPTEN_KEEPALIVE itk_wasm_patch_image_region(uint32_t handle, size_t regionAddress, size_t dataAddress, size_t dataSize);
+/** Fill run-length coded pixels of a resident image, see
+ * itk::wasm::PatchStageImageRuns. Returns 0 on an invalid patch. */
+WebAssemblyInterface_EXPORT uint32_t EMSCRIPTEN_KEEPALIVE itk_wasm_patch_image_runs(uint32_t handle, size_t runsAddress, size_t runsSize);
+/** Release the resident data object of a handle. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_release_handle(uint32_t handle);
+/** Release all resident data objects. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_release_all_handles();
+
+/** Create a new memory store session and return its memoryIndex. */
+WebAssemblyInterface_EXPORT uint32_t EMSCRIPTEN_KEEPALIVE itk_wasm_memory_session_create();
+/** Release all inputs and outputs held by a memory store session. Session 0 is cleared but remains available. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_memory_session_destroy(uint32_t memoryIndex);
+
 } // end extern "C"
 
 #endif // ITK_WASM_NO_MEMORY_IO
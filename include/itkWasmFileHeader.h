@@ -0,0 +1,105 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmFileHeader_h
+#define itkWasmFileHeader_h
+
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/**
+ *\class FileHeader
+ * \brief The first bytes of a file, to match file format signatures
+ *
+ * Reads at most DefaultSize bytes, enough for the image and mesh IO
+ * signatures, e.g. the NIfTI magic at byte 344 or an HDF5 superblock at byte
+ * 2048. Files that cannot be opened have an empty header.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class FileHeader
+{
+public:
+  static constexpr size_t DefaultSize = 2048 + 8;
+
+  explicit FileHeader(const std::string & fileName, size_t size = DefaultSize)
+  {
+    std::ifstream stream(fileName, std::ios::in | std::ios::binary);
+    if (stream.is_open())
+    {
+      m_Bytes.resize(size);
+      stream.read(reinterpret_cast<char *>(m_Bytes.data()), m_Bytes.size());
+      m_Bytes.resize(static_cast<size_t>(stream.gcount()));
+    }
+  }
+
+  bool
+  Has(size_t offset, const void * signature, size_t size) const
+  {
+    return offset + size <= m_Bytes.size() && std::memcmp(m_Bytes.data() + offset, signature, size) == 0;
+  }
+
+  bool
+  Has(size_t offset, const char * signature) const
+  {
+    return this->Has(offset, signature, std::strlen(signature));
+  }
+
+  uint32_t
+  UInt32(size_t offset, bool bigEndian) const
+  {
+    if (offset + 4 > m_Bytes.size())
+    {
+      return 0;
+    }
+    const unsigned char * bytes = m_Bytes.data() + offset;
+    return bigEndian ? (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | bytes[3]
+                     : (uint32_t(bytes[3]) << 24) | (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[1]) << 8) | bytes[0];
+  }
+
+  /** Whether the first keyword of a text header, after leading whitespace,
+   * is keyword. */
+  bool
+  StartsWithKeyword(const char * keyword) const
+  {
+    size_t start = 0;
+    while (start < m_Bytes.size() && std::isspace(m_Bytes[start]))
+    {
+      ++start;
+    }
+    return this->Has(start, keyword);
+  }
+
+private:
+  std::vector<unsigned char> m_Bytes;
+};
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -19,6 +19,7 @@
 #define itkWasmImage_h
 
 #include "itkWasmDataObject.h"
+#include "itkWasmImageDescriptor.h"
 
 namespace itk
 {
@@ -35,6 +36,13 @@ namespace itk
  * - 0: Pixel buffer `data`
  * - 1: Orientation `direction`
  * 
+ * Alternatively, the image can be described with a fixed-layout
+ * wasm::WasmImageDescriptor, which avoids building and parsing JSON.
+ * 
+ * When the JSON has a `strides` entry, the pixel data is a view of a
+ * sub-region of the image buffer, see wasm::ImageStridesType, and the data
+ * address and size are those of the view.
+ * 
  * \ingroup WebAssemblyInterface
  */
 template <typename TImage>
@@ -63,9 +71,55 @@ public:
     return static_cast< const ImageType * >(this->GetDataObject());
   }
 
+  /** Get/Set the binary descriptor representation. When set, it is used
+   * instead of the JSON representation. */
+  void SetDescriptor(const wasm::WasmImageDescriptor & descriptor) {
+    this->m_Descriptor = descriptor;
+    this->m_UseDescriptor = true;
+    this->Modified();
+  }
+  const wasm::WasmImageDescriptor & GetDescriptor() const {
+    return this->m_Descriptor;
+  }
+  bool GetUseDescriptor() const {
+    return this->m_UseDescriptor;
+  }
+
+  /** Metadata JSON text referenced by the descriptor's metadata address. */
+  void SetDescriptorMetadata(const std::string & metadata) {
+    this->m_DescriptorMetadata = metadata;
+    this->m_Descriptor.metadata = reinterpret_cast< size_t >( this->m_DescriptorMetadata.data() );
+    this->m_Descriptor.metadataSize = this->m_DescriptorMetadata.size();
+  }
+
+  /** Address and size in bytes of the pixel data of a strided view, from
+   * its first pixel to its last, set instead of the image buffer. */
+  void SetDataView(size_t address, size_t size) {
+    this->m_DataViewAddress = address;
+    this->m_DataViewSize = size;
+    this->m_HasDataView = true;
+    this->Modified();
+  }
+  bool GetHasDataView() const {
+    return this->m_HasDataView;
+  }
+  size_t GetDataViewAddress() const {
+    return this->m_DataViewAddress;
+  }
+  size_t GetDataViewSize() const {
+    return this->m_DataViewSize;
+  }
+
 protected:
   WasmImage() = default;
   ~WasmImage() override = default;
+
+  wasm::WasmImageDescriptor m_Descriptor;
+  bool m_UseDescriptor{false};
+  std::string m_DescriptorMetadata;
+  bool m_HasDataView{false};
+  size_t m_DataViewAddress{0};
+  size_t m_DataViewSize{0};
 };
 
 } // namespace itk
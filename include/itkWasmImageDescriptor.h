@@ -0,0 +1,105 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmImageDescriptor_h
+#define itkWasmImageDescriptor_h
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+namespace itk
+{
+namespace wasm
+{
+
+/** "IWID" in little-endian byte order. */
+constexpr uint32_t WasmImageDescriptorMagic = 0x44495749;
+constexpr uint32_t WasmImageDescriptorVersion = 1;
+constexpr unsigned int WasmImageDescriptorMaximumDimension = 8;
+
+/**
+ * \brief Fixed-layout binary image descriptor for memory IO.
+ *
+ * An alternative to the image JSON representation that can be filled and
+ * read by the host without building or parsing a JSON document. All fields
+ * are little-endian. Addresses are offsets in the module's linear memory.
+ *
+ * Byte layout (296 bytes):
+ *
+ * - 0:   uint32 magic, WasmImageDescriptorMagic
+ * - 4:   uint32 version, WasmImageDescriptorVersion
+ * - 8:   uint32 dimension
+ * - 12:  uint32 components
+ * - 16:  char[16] componentType, NUL-terminated, e.g. "float32"
+ * - 32:  char[32] pixelType, NUL-terminated, e.g. "Scalar"
+ * - 64:  float64[8] origin
+ * - 128: float64[8] spacing
+ * - 192: uint64[8] size
+ * - 256: uint64 data address
+ * - 264: uint64 data size in bytes
+ * - 272: uint64 direction address, dimension x dimension float64 values
+ * - 280: uint64 metadata address, JSON metadata array text or an encoded
+ *        CBOR metadata map, 0 if absent. The formats are told apart by the
+ *        major type of the first byte: 5 for a CBOR map.
+ * - 288: uint64 metadata size in bytes
+ *
+ * \ingroup WebAssemblyInterface
+ */
+struct WasmImageDescriptor
+{
+  uint32_t magic{WasmImageDescriptorMagic};
+  uint32_t version{WasmImageDescriptorVersion};
+  uint32_t dimension{0};
+  uint32_t components{0};
+  char componentType[16]{};
+  char pixelType[32]{};
+  double origin[WasmImageDescriptorMaximumDimension]{};
+  double spacing[WasmImageDescriptorMaximumDimension]{};
+  uint64_t size[WasmImageDescriptorMaximumDimension]{};
+  uint64_t data{0};
+  uint64_t dataSize{0};
+  uint64_t direction{0};
+  uint64_t metadata{0};
+  uint64_t metadataSize{0};
+};
+
+static_assert(std::is_standard_layout_v<WasmImageDescriptor>, "WasmImageDescriptor must have a fixed layout");
+static_assert(sizeof(WasmImageDescriptor) == 296, "Unexpected WasmImageDescriptor size");
+
+/** Copy a type string into a fixed-size descriptor field. */
+template <size_t VLength>
+void
+SetWasmImageDescriptorString(char (&field)[VLength], std::string_view value)
+{
+  std::memset(field, 0, VLength);
+  std::memcpy(field, value.data(), value.size() < VLength ? value.size() : VLength - 1);
+}
+
+/** Read a type string out of a fixed-size descriptor field. */
+template <size_t VLength>
+std::string_view
+GetWasmImageDescriptorString(const char (&field)[VLength])
+{
+  return std::string_view(field, strnlen(field, VLength));
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
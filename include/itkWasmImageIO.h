@@ -20,7 +20,19 @@
 #include "WebAssemblyInterfaceExport.h"
 
 #include "itkStreamingImageIOBase.h"
+#include "itkWasmBundleFile.h"
+#include "itkWasmCBORSink.h"
+#include "itkWasmCBORSource.h"
+#include "itkWasmMetaDataKeyFilter.h"
+#include "itkWasmIntensityStatistics.h"
+#include "itkWasmPayloadFilter.h"
+#include <cstdio>
 #include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 #include "rapidjson/document.h"
 
 namespace itk
@@ -33,7 +45,12 @@ namespace itk
  * It reads and writes an itk-wasm Image object in a CbOR file on the
  * filesystem with JSON files and binary files for TypedArrays.
  * 
- * The file extensions used are .iwi and .iwi.cbor.
+ * The file extensions used are .iwi and .iwi.cbor, .iwi.bin for aligned
+ * files, and .iwi.bundle for bundles of images, see wasm::BundleMember.
+ *
+ * File names may also be http:// or https:// URLs in WebAssembly builds
+ * with the host range fetch import, see wasm::RangeReader. Only the byte
+ * ranges of the header and of the IORegion are then fetched.
  *
  * \ingroup IOFilters
  * \ingroup WebAssemblyInterface
@@ -69,6 +86,131 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   void Read(void *buffer) override;
 
+  /** Streamed reads are not supported for pixel data with payload
+   * filters. */
+  bool CanStreamRead() override;
+
+  /** Chunk size, in pixels per dimension, of the chunked layout of the .iwi
+   * directory format. When set before writing, the pixel data is stored in
+   * fixed-size N-D chunks, data/chunks/<level>/<i>.<j>.<k>.raw, addressed by
+   * their chunk index, instead of a contiguous data/data.raw. Region reads
+   * and writes only access the chunks of the IORegion, in parallel. Empty,
+   * the default, for the contiguous layout. Set from the index when reading
+   * the image information. */
+  void SetChunkSize(const std::vector<SizeValueType> & chunkSize)
+  {
+    m_ChunkSize = chunkSize;
+    this->Modified();
+  }
+  const std::vector<SizeValueType> & GetChunkSize() const
+  {
+    return m_ChunkSize;
+  }
+
+  /** Resolution level of a chunked .iwi directory to read or write. Level 0
+   * is the full resolution image. Level n > 0 is a downsampled image, e.g. an
+   * output of the downsample package, written to the directory of level 0
+   * after level n - 1. 0 by default. */
+  itkSetMacro(Level, unsigned int);
+  itkGetConstMacro(Level, unsigned int);
+
+  /** Number of resolution levels of the .iwi directory read. */
+  itkGetConstMacro(NumberOfLevels, unsigned int);
+
+  /** Number of neighbouring chunks, per dimension, around the IORegion that
+   * region reads of a chunked .iwi URL also fetch and keep for the next
+   * region, e.g. the next slice of a streamed read. 1 by default. Chunks of
+   * local files are read on demand. */
+  itkSetMacro(ChunkPrefetch, unsigned int);
+  itkGetConstMacro(ChunkPrefetch, unsigned int);
+
+  /** Write the pixel data of integer images to .iwi.cbor files as runs of
+   * equal pixels, e.g. label maps that are mostly background, which are
+   * then stored and transferred compactly. Runs are filled directly into the
+   * image buffer when read. Off by default. */
+  itkSetMacro(RunLengthPayload, bool);
+  itkGetConstMacro(RunLengthPayload, bool);
+  itkBooleanMacro(RunLengthPayload);
+
+  /** Number of resolution levels discarded when reading pixel data encoded
+   * with the resolution scalable htj2k payload codec, e.g. for previews.
+   * Each level halves the first two dimensions, rounding up, and doubles
+   * their spacing. Pixel data with other encodings is read at full
+   * resolution. 0 by default. */
+  itkSetMacro(ResolutionReduction, unsigned int);
+  itkGetConstMacro(ResolutionReduction, unsigned int);
+
+  /** Compute the minimum, maximum, mean and histogram of each component
+   * while writing, and store them in the header, so readers get them from
+   * ReadImageInformation, e.g. to set the window and level of a display
+   * before the pixel data is read. The header precedes the pixel data, so
+   * images are then written whole instead of in streamed pieces. Off by
+   * default. */
+  itkSetMacro(ComputeIntensityStatistics, bool);
+  itkGetConstMacro(ComputeIntensityStatistics, bool);
+  itkBooleanMacro(ComputeIntensityStatistics);
+
+  /** Number of bins of the histograms of the intensity statistics. 64 by
+   * default. */
+  itkSetMacro(IntensityHistogramBins, unsigned int);
+  itkGetConstMacro(IntensityHistogramBins, unsigned int);
+
+  /** Intensity statistics of the image last read or written, empty when its
+   * header did not store them. */
+  const wasm::IntensityStatistics & GetIntensityStatistics() const
+  {
+    return m_IntensityStatistics;
+  }
+
+  /** Payload filters of the pixel data of the .iwi.cbor file last read or
+   * written. */
+  const wasm::PayloadFilters & GetPayloadFilters() const
+  {
+    return m_PayloadFilters;
+  }
+
+  /** Metadata keys that are read into, and written from, the
+   * MetaDataDictionary. Default: every key. */
+  void SetMetaDataKeyFilter(const wasm::MetaDataKeyFilter & keyFilter)
+  {
+    m_MetaDataKeyFilter = keyFilter;
+  }
+  const wasm::MetaDataKeyFilter & GetMetaDataKeyFilter() const
+  {
+    return m_MetaDataKeyFilter;
+  }
+
+  /** Member of a .iwi.bundle file to read, by name, or by the
+   * BundleMemberIndex when the name is empty, the default. When writing,
+   * the name of the member appended to the bundle, by default its index. */
+  itkSetStringMacro(BundleMemberName);
+  itkGetStringMacro(BundleMemberName);
+  itkSetMacro(BundleMemberIndex, SizeValueType);
+  itkGetConstMacro(BundleMemberIndex, SizeValueType);
+
+  /** Append images written to an existing .iwi.bundle file, instead of
+   * replacing it. On by default. */
+  itkSetMacro(AppendToBundle, bool);
+  itkGetConstMacro(AppendToBundle, bool);
+  itkBooleanMacro(AppendToBundle);
+
+  /** Metadata keys stored once in the table of contents of a .iwi.bundle
+   * file and shared by its members, e.g. `0020|000e` and the other series
+   * attributes of DICOM slices. The first member written sets the shared
+   * values, and members with other values for the shared keys store all of
+   * their metadata. Without patterns, the default, no key is shared. */
+  void SetBundleMetaDataKeyFilter(const wasm::MetaDataKeyFilter & keyFilter)
+  {
+    m_BundleMetaDataKeyFilter = keyFilter;
+  }
+  const wasm::MetaDataKeyFilter & GetBundleMetaDataKeyFilter() const
+  {
+    return m_BundleMetaDataKeyFilter;
+  }
+
+  /** Names of the members of the .iwi.bundle file read, in order. */
+  std::vector<std::string> GetBundleMemberNames() const;
+
 #if !defined(ITK_WRAPPING_PARSER)
   /** Set the JSON representation of the image information. */
   void SetJSON(rapidjson::Document & json);
@@ -90,6 +232,12 @@ public:
    * that the IORegions has been set properly. */
   void Write(const void *buffer) override;
 
+  /** Streamed writes are supported without payload filters. Pieces of a
+   * streamed .iwi.cbor write must cover the image in file order, e.g. the
+   * slabs of an ImageFileWriter with NumberOfStreamDivisions, which are
+   * appended to the file as they are written. */
+  bool CanStreamWrite() override;
+
 protected:
   WasmImageIO();
   ~WasmImageIO() override;
@@ -101,10 +249,227 @@ protected:
   }
 
   void ReadCBOR(void * buffer = nullptr, unsigned char * cborBuffer = nullptr, size_t cborBufferLength = 0);
-  size_t WriteCBOR(const void * buffer = nullptr, unsigned char ** cborBuffer = nullptr, bool allocateCBORBuffer = false);
+
+  /** Decode a .iwi.cbor stream from a sequential source. The pixel data byte
+   * string is read from the source directly into the buffer, without an
+   * intermediate copy of the file or of the decoded item. When the buffer is
+   * nullptr, decoding stops once the image information is complete. */
+  void ReadCBOR(void * buffer, wasm::CBORSource & source);
+
+  /** Progress through the top-level map of a .iwi.cbor stream. */
+  struct CBORReadProgress
+  {
+    bool mapStarted{ false };
+    uint64_t numberOfEntries{ 0 };
+    uint64_t entriesRead{ 0 };
+    bool dataSkipped{ false };
+  };
+
+  /** Decode, or continue decoding, a .iwi.cbor stream from the entry the
+   * progress points at. After an information-only decode, a source that has
+   * not skipped the pixel data can continue with a buffer, so the header is
+   * not decoded twice. */
+  void ReadCBOR(void * buffer, wasm::CBORSource & source, CBORReadProgress & progress);
+
+  /** Read the pixel data byte string of dataSize bytes from the source into
+   * the buffer. Only the IORegion is copied when streaming, and the bytes
+   * outside of it are skipped. The source is left after the byte string. */
+  virtual void ReadCBORData(void * buffer, wasm::CBORSource & source, uint64_t dataSize);
+
+  /** Decode the run-length encoded pixel data byte string of dataSize bytes
+   * from the source into the buffer, in pieces. */
+  void ReadCBORRuns(void * buffer, wasm::CBORSource & source, uint64_t dataSize);
+
+  /** Write the .iwi.cbor file. */
+  void WriteCBOR(const void * buffer = nullptr);
+
+  /** Encode the .iwi.cbor items into a streaming sink. The pixel data is
+   * written as a definite-length byte string directly from the buffer. */
+  void WriteCBOR(const void * buffer, wasm::CBORSink & sink);
+
+  /** Encode the .iwi.cbor items before the pixel data byte string, through
+   * the tag of the data entry when withData is true. */
+  void WriteCBORHeader(wasm::CBORSink & sink, bool withData);
+
+  /** Compute the intensity statistics of a whole image buffer for the
+   * header written next, when ComputeIntensityStatistics is on, or clear
+   * them. */
+  void UpdateIntensityStatistics(const void * buffer);
+
+  /** Append the IORegion of a streamed write to the .iwi.cbor stream. The
+   * first piece starts the stream in a sink that is kept until the last
+   * pixel is written. */
+  void WriteCBORRegion(const void * buffer);
+
+  /** Sink of the encoded file, given the number of encoded bytes. A file
+   * sink by default. */
+  virtual std::unique_ptr<wasm::CBORSink> CreateCBORSink(uint64_t encodedSize) const;
+
+  /** Compression of the chunks written, "none" by default. */
+  virtual std::string GetChunkCompressionForWriting() const;
+
+  /** Compression of the chunks of the .iwi directory read or written. */
+  const std::string & GetChunkCompression() const
+  {
+    return m_ChunkCompression;
+  }
+
+  /** Read the chunk at chunkPath, without its file extension, into the size
+   * bytes of data. Returns false if the chunk file does not exist. */
+  virtual bool ReadChunkFile(const std::string & chunkPath, void * data, size_t size) const;
+
+  /** Write the size bytes of data to the chunk at chunkPath, without its
+   * file extension. */
+  virtual void WriteChunkFile(const std::string & chunkPath, const void * data, size_t size) const;
+
+  /** Path of a chunk of the Level, without its file extension. */
+  std::string GetChunkPath(const std::vector<uint64_t> & chunkIndex) const;
+
+  /** Read or write the chunks that overlap the IORegion. Partially covered
+   * chunks are read, updated and rewritten by streamed writes. */
+  void ReadChunks(void * buffer);
+  void WriteChunks(const void * buffer);
+
+  /** Payload filters to apply to the pixel data when writing a .iwi.cbor
+   * stream. The runLength filter for integer components with the
+   * RunLengthPayload, otherwise none, by default. */
+  virtual wasm::PayloadFilters GetPayloadFiltersForWriting() const;
+
+  /** Encode the pixel data in the buffer with the codec of the payload
+   * filters written. The codecs are implemented by subclasses, e.g.
+   * WasmZstdImageIO of the image-io package, and this throws. */
+  virtual void EncodePayloadCodec(const void * buffer, std::string & encoded) const;
+
+  /** Decode the size bytes of pixel data encoded with the codec of the
+   * payload filters read into the buffer, with the ResolutionReduction of
+   * resolution scalable codecs. This throws. */
+  virtual void DecodePayloadCodec(const unsigned char * encoded, size_t size, void * buffer);
+
+  /** Element layout of the pixel data for the payload filters. */
+  wasm::PayloadLayout GetPayloadLayout() const;
+
+  /** Reverse the payload filters of the pixel data in the buffer, in
+   * parallel over the filter blocks and rows. */
+  void DecodePayloadFilters(void * buffer);
+
+  /** Read the image information of a .iwi.cbor file without reading its
+   * pixel data. Only the entries of the top-level map before the image
+   * information is complete are read, and the pixel data entry is skipped
+   * by its encoded length. */
+  void ReadCBORInformation();
+
+  /** Memory-map the data.raw file of the directory format. Returns false
+   * where memory mapping is not available, and data is read with a stream. */
+  bool MapDataFile(const std::string & dataFile);
+  void UnmapDataFile();
+
+  /** Copy the IORegion from the mapped data file into the buffer. Only the
+   * pages of the region are loaded. The pixel data starts at dataOffset in
+   * the file. */
+  void ReadMappedRegion(void * buffer, uint64_t dataOffset = 0) const;
+
+  /** Read the image information of a .iwi.bin aligned file. */
+  void ReadAlignedInformation();
+
+  /** Read the IORegion of the pixel data of size bytes at offset in the
+   * .iwi.bin file, through a memory mapping where available. */
+  void ReadAlignedData(void * buffer, uint64_t offset, uint64_t size);
+
+  /** Write the .iwi.bin file, or the IORegion of a streamed write at its
+   * position in the file. The piece with the first pixel writes the header. */
+  void WriteAligned(const void * buffer);
+
+  /** Whether the file is a .iwi.bundle file. */
+  bool FileNameIsBundle() const;
+
+  /** Read the table of contents of a .iwi.bundle file and select the member
+   * to read, by BundleMemberName or BundleMemberIndex. */
+  void SelectBundleMember();
+
+  /** The member of the .iwi.bundle file selected by SelectBundleMember. */
+  const wasm::BundleMember & GetBundleMember() const
+  {
+    return m_BundleMember;
+  }
+
+  /** Open the file, or the selected member of a .iwi.bundle file, for range
+   * reads. */
+  std::unique_ptr<wasm::RangeReader> OpenRangeReader() const;
+
+  /** Open the file the encoded stream is written to, or the end of a
+   * .iwi.bundle file for the member appended. */
+  FILE * OpenCBORFile() const;
+
+  /** Encoding of the members appended to a .iwi.bundle file, "cbor" by
+   * default. */
+  virtual std::string GetBundleMemberEncodingForWriting() const;
+
+  /** Append the image to the .iwi.bundle file as a member. Its metadata
+   * shared with the bundle is not stored in the member. */
+  void WriteBundleMember(const void * buffer);
+
+  /** Call lineFunction with the byte offset in the pixel data of each line
+   * of the IORegion along the first dimension, in increasing order. */
+  void ForEachIORegionLine(const std::function<void(uint64_t offset, size_t lineBytes)> & lineFunction) const;
+
+  /** Call runFunction for each run of adjacent lines of the IORegion, e.g.
+   * a whole slice, so each run is a single read. */
+  void ForEachIORegionRun(const std::function<void(uint64_t offset, size_t runBytes)> & runFunction) const;
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(WasmImageIO);
+
+#if !defined(ITK_WRAPPING_PARSER)
+  /** Add the chunks entry of a chunked level 0 to the index. */
+  void SetChunksJSON(rapidjson::Document & document);
+
+  /** Add the Level to the chunks entry of the index of level 0. */
+  void SetChunkLevelJSON(rapidjson::Document & index);
+#endif
+
+  std::vector<SizeValueType> m_ChunkSize;
+  std::string m_ChunkCompression{ "none" };
+  unsigned int m_Level{ 0 };
+  unsigned int m_NumberOfLevels{ 1 };
+  unsigned int m_ChunkPrefetch{ 1 };
+
+  // Chunks fetched from a URL by the last region read, by chunk path
+  std::map<std::string, std::vector<unsigned char>> m_ChunkCache;
+
+  std::string m_BundleMemberName;
+  SizeValueType m_BundleMemberIndex{ 0 };
+  bool m_AppendToBundle{ true };
+  wasm::MetaDataKeyFilter m_BundleMetaDataKeyFilter;
+  wasm::BundleTableOfContents m_BundleTableOfContents;
+  wasm::BundleMember m_BundleMember;
+  // Metadata of the member written, without the shared metadata
+  MetaDataDictionary m_BundleMemberMetaData;
+  bool m_WritingBundleMember{ false };
+
+  // Metadata of the .iwi.bin file read
+  std::vector<unsigned char> m_AlignedMetadata;
+
+  std::string m_MappedFileName;
+  void * m_MappedData{nullptr};
+  size_t m_MappedSize{0};
+
+  wasm::PayloadFilters m_PayloadFilters;
+  bool m_RunLengthPayload{ false };
+  unsigned int m_ResolutionReduction{ 0 };
+
+  // Codec encoding of the pixel data, shared by the sinks of a write
+  std::string m_EncodedPayload;
+
+  bool m_ComputeIntensityStatistics{ false };
+  unsigned int m_IntensityHistogramBins{ wasm::DefaultIntensityHistogramBins };
+  wasm::IntensityStatistics m_IntensityStatistics;
+
+  wasm::MetaDataKeyFilter m_MetaDataKeyFilter;
+
+  // Stream of a streamed .iwi.cbor write, kept between its pieces
+  std::unique_ptr<wasm::CBORSink> m_StreamedWriteSink;
+  uint64_t m_StreamedWriteOffset{ 0 };
+  std::string m_StreamedWriteFileName;
 };
 } // end namespace itk
 
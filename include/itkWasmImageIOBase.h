@@ -59,6 +59,20 @@ public:
   using PixelDataContainerType = VectorContainer<SizeValueType, char>;
 
   void SetImageIO(ImageIOBase * imageIO, bool readImage = true);
+
+  /** Read the pixel data in SetImageIO. When disabled, e.g. for
+   * information-only reads, the pixel data container is empty and the data
+   * address is 0. Default: true. */
+  itkSetMacro(ReadPixelData, bool);
+  itkGetConstMacro(ReadPixelData, bool);
+  itkBooleanMacro(ReadPixelData);
+
+  /** The image IO already read the image information, so SetImageIO does not
+   * read it again, e.g. to continue from the header of a cached image IO.
+   * Default: false. */
+  itkSetMacro(ImageInformationRead, bool);
+  itkGetConstMacro(ImageInformationRead, bool);
+  itkBooleanMacro(ImageInformationRead);
   const ImageIOBase * GetImageIO() const {
     return m_ImageIOBase.GetPointer();
   }
@@ -92,6 +106,8 @@ protected:
   PixelDataContainerType::Pointer m_PixelDataContainer;
 
   ImageIOBase::ConstPointer m_ImageIOBase;
+  bool m_ReadPixelData{true};
+  bool m_ImageInformationRead{false};
 };
 
 } // namespace itk
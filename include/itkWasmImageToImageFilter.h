@@ -19,7 +19,13 @@
 #define itkWasmImageToImageFilter_h
 
 #include "itkProcessObject.h"
+#include "itkWasmComponentConversion.h"
 #include "itkWasmImage.h"
+#include "itkWasmMetaDataKeyFilter.h"
+
+#include "rapidjson/document.h"
+
+#include <memory>
 
 namespace itk
 {
@@ -77,6 +83,60 @@ public:
   ImageType *
   GetOutput(unsigned int idx);
 
+  /** Take ownership of the pixel buffer from the memory IO input array store
+   * of session MemoryIndex instead of referencing it. The buffer is then
+   * released with the output image pixel container. If the buffer is not in
+   * the store, it is referenced. Default: false. */
+  itkSetMacro(InputArrayHandoff, bool);
+  itkGetConstMacro(InputArrayHandoff, bool);
+  itkBooleanMacro(InputArrayHandoff);
+
+  /** Memory IO store session used with InputArrayHandoff. */
+  itkSetMacro(MemoryIndex, uint32_t);
+  itkGetConstMacro(MemoryIndex, uint32_t);
+
+  /** Decode the input metadata into the output image MetaDataDictionary.
+   * Disable for inputs whose metadata is not used, e.g. the hundreds of tags
+   * of a DICOM-derived image, to skip decoding it. Default: true. */
+  itkSetMacro(ConvertMetaData, bool);
+  itkGetConstMacro(ConvertMetaData, bool);
+  itkBooleanMacro(ConvertMetaData);
+
+  /** Convert inputs whose component type differs from the output image
+   * component type, when the conversion maps it to the output component
+   * type, instead of throwing. The converted pixel data is a copy. Default:
+   * wasm::ComponentConversion::None. */
+  itkSetEnumMacro(ComponentConversion, wasm::ComponentConversion);
+  itkGetEnumMacro(ComponentConversion, wasm::ComponentConversion);
+
+  /** Whether the input pixel data stores each component in its own plane,
+   * channel-first, e.g. a numpy array or a GPU readback. The output image is
+   * interleaved, see ImportVectorImageFilter::SetPlanarLayout. Default:
+   * false. */
+  itkSetMacro(PlanarLayout, bool);
+  itkGetConstMacro(PlanarLayout, bool);
+  itkBooleanMacro(PlanarLayout);
+
+  /** Metadata keys that are decoded into the output image. Other entries
+   * are skipped. Default: every key. */
+  void SetMetaDataKeyFilter(const wasm::MetaDataKeyFilter & keyFilter)
+  {
+    this->m_MetaDataKeyFilter = keyFilter;
+    this->Modified();
+  }
+  const wasm::MetaDataKeyFilter & GetMetaDataKeyFilter() const
+  {
+    return this->m_MetaDataKeyFilter;
+  }
+
+  /** Use an already parsed JSON representation of the input instead of
+   * parsing the input JSON again. */
+  void SetJSONDocument(std::shared_ptr<const rapidjson::Document> document)
+  {
+    this->m_JSONDocument = std::move(document);
+    this->Modified();
+  }
+
 protected:
   WasmImageToImageFilter();
   ~WasmImageToImageFilter() override = default;
@@ -94,6 +154,14 @@ protected:
 
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+  bool m_InputArrayHandoff{false};
+  bool m_ConvertMetaData{true};
+  wasm::ComponentConversion m_ComponentConversion{wasm::ComponentConversion::None};
+  bool m_PlanarLayout{false};
+  uint32_t m_MemoryIndex{0};
+  wasm::MetaDataKeyFilter m_MetaDataKeyFilter;
+  std::shared_ptr<const rapidjson::Document> m_JSONDocument;
 };
 } // end namespace itk
 
@@ -21,12 +21,21 @@
 #include "itkWasmImageToImageFilter.h"
 
 #include "itkMetaDataDictionaryJSON.h"
+#include "itkMetaDataDictionaryCBOR.h"
 #include "itkImportVectorImageFilter.h"
 #include <exception>
+#include <vector>
 #include "itkWasmMapComponentType.h"
 #include "itkWasmMapPixelType.h"
+#include "itkWasmTrace.h"
+#include "itkWasmAllocationStats.h"
+#include "itkWasmStridedView.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkMetaDataObject.h"
+#ifndef ITK_WASM_NO_MEMORY_IO
+#include "itkWasmExports.h"
+#include <memory>
+#endif
 
 #include "rapidjson/document.h"
 
@@ -131,9 +140,10 @@ void
 WasmImageToImageFilter<TImage>
 ::GenerateData()
 {
+  ITK_WASM_TRACE_SCOPE("WasmImageToImageFilter::GenerateData");
+
   // Get the input and output pointers
   const WasmImageType * imageJSON = this->GetInput();
-  const std::string json(imageJSON->GetJSON());
   ImageType * image = this->GetOutput();
 
   using IOPixelType = typename TImage::IOPixelType;
@@ -141,25 +151,136 @@ WasmImageToImageFilter<TImage>
   using ConvertPixelTraits = DefaultConvertPixelTraits<PixelType>;
   constexpr unsigned int Dimension = TImage::ImageDimension;
 
+  using OriginType = typename ImageType::PointType;
+  using SpacingType = typename ImageType::SpacingType;
+  using DirectionType = typename ImageType::DirectionType;
+  using SizeType = typename ImageType::SizeType;
+
+  unsigned int dimension = 0;
+  std::string componentType;
+  std::string pixelType;
+  unsigned int components = 0;
+  OriginType origin;
+  SpacingType spacing;
+  const double * directionPtr = nullptr;
+  SizeType size;
+  IOPixelType * dataPtr = nullptr;
+  wasm::ImageStridesType strides;
+
   rapidjson::Document document;
-  if (document.Parse(json.c_str()).HasParseError())
+  const char * metadataData = nullptr;
+  size_t metadataSize = 0;
+  const rapidjson::Value * metadataJsonPtr = nullptr;
+  rapidjson::Document metadataDocument;
+
+  if (imageJSON->GetUseDescriptor())
+  {
+    const wasm::WasmImageDescriptor & descriptor = imageJSON->GetDescriptor();
+    if (descriptor.magic != wasm::WasmImageDescriptorMagic || descriptor.version != wasm::WasmImageDescriptorVersion)
     {
-    throw std::runtime_error("Could not parse JSON");
+      throw std::runtime_error("Invalid image descriptor");
     }
-
-  const rapidjson::Value & imageType = document["imageType"];
-  const int dimension = imageType["dimension"].GetInt();
-  if (dimension != Dimension)
+    dimension = descriptor.dimension;
+    if (dimension != Dimension)
+    {
+      throw std::runtime_error("Unexpected dimension");
+    }
+    componentType = wasm::GetWasmImageDescriptorString(descriptor.componentType);
+    pixelType = wasm::GetWasmImageDescriptorString(descriptor.pixelType);
+    components = descriptor.components;
+    for (unsigned int ii = 0; ii < Dimension; ++ii)
+    {
+      origin[ii] = descriptor.origin[ii];
+      spacing[ii] = descriptor.spacing[ii];
+      size[ii] = descriptor.size[ii];
+    }
+    directionPtr = reinterpret_cast< const double * >( static_cast< size_t >(descriptor.direction) );
+    dataPtr = reinterpret_cast< IOPixelType * >( static_cast< size_t >(descriptor.data) );
+    metadataData = reinterpret_cast< const char * >( static_cast< size_t >(descriptor.metadata) );
+    metadataSize = descriptor.metadataSize;
+  }
+  else
   {
-    throw std::runtime_error("Unexpected dimension");
+    if (!this->m_JSONDocument)
+    {
+      const std::string json(imageJSON->GetJSON());
+      if (document.Parse(json.c_str()).HasParseError())
+        {
+        throw std::runtime_error("Could not parse JSON");
+        }
+    }
+    const rapidjson::Value & jsonDocument = this->m_JSONDocument ? static_cast< const rapidjson::Value & >(*this->m_JSONDocument) : static_cast< const rapidjson::Value & >(document);
+
+    const rapidjson::Value & imageType = jsonDocument["imageType"];
+    dimension = imageType["dimension"].GetInt();
+    if (dimension != Dimension)
+    {
+      throw std::runtime_error("Unexpected dimension");
+    }
+    componentType = imageType["componentType"].GetString();
+    pixelType = imageType["pixelType"].GetString();
+    components = imageType["components"].GetInt();
+
+    const rapidjson::Value & originJson = jsonDocument["origin"];
+    int count = 0;
+    for( rapidjson::Value::ConstValueIterator itr = originJson.Begin(); itr != originJson.End(); ++itr )
+      {
+      origin[count] = itr->GetDouble();
+      ++count;
+      }
+
+    const rapidjson::Value & spacingJson = jsonDocument["spacing"];
+    count = 0;
+    for( rapidjson::Value::ConstValueIterator itr = spacingJson.Begin(); itr != spacingJson.End(); ++itr )
+      {
+      spacing[count] = itr->GetDouble();
+      ++count;
+      }
+
+    const rapidjson::Value & directionJson = jsonDocument["direction"];
+    const std::string directionString( directionJson.GetString() );
+    directionPtr = reinterpret_cast< double * >( std::strtoull(directionString.substr(35).c_str(), nullptr, 10) );
+
+    const rapidjson::Value & sizeJson = jsonDocument["size"];
+    count = 0;
+    for( rapidjson::Value::ConstValueIterator itr = sizeJson.Begin(); itr != sizeJson.End(); ++itr )
+      {
+      size[count] = itr->GetUint64();
+      ++count;
+      }
+
+    const rapidjson::Value & dataJson = jsonDocument["data"];
+    const std::string dataString( dataJson.GetString() );
+    dataPtr = reinterpret_cast< IOPixelType * >( std::strtoull(dataString.substr(35).c_str(), nullptr, 10) );
+
+    if (jsonDocument.HasMember("strides"))
+    {
+      // A view of a sub-region of a larger buffer
+      const rapidjson::Value & stridesJson = jsonDocument["strides"];
+      for( rapidjson::Value::ConstValueIterator itr = stridesJson.Begin(); itr != stridesJson.End(); ++itr )
+        {
+        strides.push_back(itr->GetUint64());
+        }
+      if (strides.size() != Dimension)
+      {
+        throw std::runtime_error("Unexpected number of strides");
+      }
+    }
+
+    if (this->m_ConvertMetaData && jsonDocument.HasMember("metadata"))
+    {
+      metadataJsonPtr = &jsonDocument["metadata"];
+    }
   }
-  const std::string componentType( imageType["componentType"].GetString() );
-  if ( componentType != itk::wasm::MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString )
+
+  using ComponentType = typename ConvertPixelTraits::ComponentType;
+  constexpr std::string_view imageComponentType = itk::wasm::MapComponentType<ComponentType>::ComponentString;
+  const bool convertComponents = componentType != imageComponentType;
+  if ( convertComponents && !wasm::IsConvertedComponentType(this->m_ComponentConversion, componentType, imageComponentType) )
   {
     throw std::runtime_error("Unexpected component type");
   }
 
-  const std::string pixelType( imageType["pixelType"].GetString() );
   if ( pixelType != itk::wasm::MapPixelType<PixelType>::PixelString )
   {
     throw std::runtime_error("Unexpected pixel type");
@@ -169,78 +290,101 @@ WasmImageToImageFilter<TImage>
   auto filter = FilterType::New();
 
   // Don't throw when PixelType is VariableLengthPixel where number of components is 0
-  if (ConvertPixelTraits::GetNumberOfComponents() != 0 && imageType["components"].GetInt() != ConvertPixelTraits::GetNumberOfComponents() )
+  if (ConvertPixelTraits::GetNumberOfComponents() != 0 && components != ConvertPixelTraits::GetNumberOfComponents() )
   {
     throw std::runtime_error("Unexpected number of components");
   }
 
-  using OriginType = typename ImageType::PointType;
-  OriginType origin;
-  const rapidjson::Value & originJson = document["origin"];
-  int count = 0;
-  for( rapidjson::Value::ConstValueIterator itr = originJson.Begin(); itr != originJson.End(); ++itr )
-    {
-    origin[count] = itr->GetDouble();
-    ++count;
-    }
   filter->SetOrigin( origin );
-
-  using SpacingType = typename ImageType::SpacingType;
-  SpacingType spacing;
-  const rapidjson::Value & spacingJson = document["spacing"];
-  count = 0;
-  for( rapidjson::Value::ConstValueIterator itr = spacingJson.Begin(); itr != spacingJson.End(); ++itr )
-    {
-    spacing[count] = itr->GetDouble();
-    ++count;
-    }
   filter->SetSpacing( spacing );
 
-  using DirectionType = typename ImageType::DirectionType;
-  const rapidjson::Value & directionJson = document["direction"];
-  const std::string directionString( directionJson.GetString() );
-  const double * directionPtr = reinterpret_cast< double * >( std::strtoull(directionString.substr(35).c_str(), nullptr, 10) );
   using VnlMatrixType = typename DirectionType::InternalMatrixType;
   const VnlMatrixType vnlMatrix(directionPtr);
   const DirectionType direction(vnlMatrix);
   filter->SetDirection(direction);
 
-  using SizeType = typename ImageType::SizeType;
-  SizeType size;
-  const rapidjson::Value & sizeJson = document["size"];
-  count = 0;
   SizeValueType totalSize = 1;
-  for( rapidjson::Value::ConstValueIterator itr = sizeJson.Begin(); itr != sizeJson.End(); ++itr )
+  for (unsigned int ii = 0; ii < Dimension; ++ii)
     {
-    size[count] = itr->GetInt();
-    totalSize *= size[count];
-    ++count;
+    totalSize *= size[ii];
     }
   using RegionType = typename ImageType::RegionType;
   RegionType region;
   region.SetSize( size );
   filter->SetRegion( region );
+  filter->SetPlanarLayout( this->m_PlanarLayout );
 
-  const rapidjson::Value & dataJson = document["data"];
-  const std::string dataString( dataJson.GetString() );
-  IOPixelType * dataPtr = reinterpret_cast< IOPixelType * >( std::strtoull(dataString.substr(35).c_str(), nullptr, 10) );
   const bool letImageContainerManageMemory = false;
-  if (pixelType == "VariableLengthVector" || pixelType == "VariableSizeMatrix")
+  const unsigned int vectorImageComponents =
+    (pixelType == "VariableLengthVector" || pixelType == "VariableSizeMatrix") ? components : 1;
+  std::vector<uint64_t> viewSize(size.begin(), size.end());
+  if (!strides.empty() && !wasm::IsContiguousStrides(viewSize, strides, components))
+    {
+    if (convertComponents || this->m_PlanarLayout)
+      {
+      throw std::runtime_error("Strided image data with a component conversion or planar layout is not supported");
+      }
+    // The view is gathered into a contiguous buffer
+    const size_t componentCount = static_cast< size_t >(totalSize) * components;
+    auto gatheredArray = std::make_shared<std::vector<ComponentType>>(componentCount);
+    wasm::GatherStridedView(reinterpret_cast< const ComponentType * >(dataPtr), viewSize, strides, components, gatheredArray->data());
+    ITK_WASM_COUNT_COPY(InputStore, componentCount * sizeof(ComponentType));
+    filter->SetImportPointer( reinterpret_cast< IOPixelType * >(gatheredArray->data()), totalSize, [gatheredArray]() { gatheredArray->clear(); gatheredArray->shrink_to_fit(); }, vectorImageComponents);
+    }
+  else if (convertComponents)
     {
-    filter->SetImportPointer( dataPtr, totalSize, letImageContainerManageMemory, imageType["components"].GetInt());
+    const size_t componentCount = static_cast< size_t >(totalSize) * components;
+    auto convertedArray = std::make_shared<std::vector<ComponentType>>(componentCount);
+    wasm::ConvertComponents(componentType, dataPtr, componentCount, convertedArray->data());
+    ITK_WASM_COUNT_COPY(InputStore, componentCount * sizeof(ComponentType));
+#ifndef ITK_WASM_NO_MEMORY_IO
+    // The input array is not imported, so release it before the pipeline runs
+    wasm::InputArrayStoreValueType handoffArray;
+    if (this->m_InputArrayHandoff)
+      {
+      wasm::takeMemoryStoreInputArray(this->m_MemoryIndex, reinterpret_cast< size_t >(dataPtr), handoffArray);
+      }
+#endif
+    filter->SetImportPointer( reinterpret_cast< IOPixelType * >(convertedArray->data()), totalSize, [convertedArray]() { convertedArray->clear(); convertedArray->shrink_to_fit(); }, vectorImageComponents);
     }
   else
     {
-    filter->SetImportPointer( dataPtr, totalSize, letImageContainerManageMemory);
+#ifndef ITK_WASM_NO_MEMORY_IO
+    auto handoffArray = std::make_shared<wasm::InputArrayStoreValueType>();
+    if (this->m_InputArrayHandoff && wasm::takeMemoryStoreInputArray(this->m_MemoryIndex, reinterpret_cast< size_t >(dataPtr), *handoffArray))
+      {
+      // The lambda holds the moved store entry until the pixel container releases it
+      filter->SetImportPointer( dataPtr, totalSize, [handoffArray]() { handoffArray->clear(); handoffArray->shrink_to_fit(); }, vectorImageComponents);
+      }
+    else
+#endif
+      {
+      filter->SetImportPointer( dataPtr, totalSize, letImageContainerManageMemory, vectorImageComponents);
+      }
     }
   filter->Update();
   image->Graft(filter->GetOutput());
 
-  if (document.HasMember("metadata"))
+  if (this->m_ConvertMetaData && metadataData != nullptr && metadataSize > 0 &&
+      (static_cast< unsigned char >(metadataData[0]) >> 5) == 5)
+  {
+    // A CBOR metadata map
+    if (!wasm::ReadCBORMetaDataDictionary(reinterpret_cast< const unsigned char * >(metadataData), metadataSize, image->GetMetaDataDictionary(), this->m_MetaDataKeyFilter))
+    {
+      throw std::runtime_error("Could not decode CBOR metadata");
+    }
+  }
+  else if (this->m_ConvertMetaData && metadataData != nullptr && metadataSize > 0)
+  {
+    if (metadataDocument.Parse(metadataData, metadataSize).HasParseError())
+    {
+      throw std::runtime_error("Could not parse metadata JSON");
+    }
+    metadataJsonPtr = &metadataDocument;
+  }
+  if (metadataJsonPtr != nullptr)
   {
-    auto dictionary = image->GetMetaDataDictionary();
-    const rapidjson::Value & metadataJson = document["metadata"];
-    wasm::ConvertJSONToMetaDataDictionary(metadataJson, dictionary);
+    wasm::ConvertJSONToMetaDataDictionary(*metadataJsonPtr, image->GetMetaDataDictionary(), this->m_MetaDataKeyFilter);
   }
 
 }
@@ -251,6 +395,11 @@ WasmImageToImageFilter<TImage>
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "InputArrayHandoff: " << (m_InputArrayHandoff ? "On" : "Off") << std::endl;
+  os << indent << "ConvertMetaData: " << (m_ConvertMetaData ? "On" : "Off") << std::endl;
+  os << indent << "ComponentConversion: " << m_ComponentConversion << std::endl;
+  os << indent << "PlanarLayout: " << (m_PlanarLayout ? "On" : "Off") << std::endl;
+  os << indent << "MemoryIndex: " << m_MemoryIndex << std::endl;
 }
 } // end namespace itk
 
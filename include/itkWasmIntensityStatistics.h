@@ -0,0 +1,106 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmIntensityStatistics_h
+#define itkWasmIntensityStatistics_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkCommonEnums.h"
+#include "itkMultiThreaderBase.h"
+#include "itkWasmCBORSink.h"
+#include "cbor.h"
+#include "rapidjson/document.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace itk
+{
+namespace wasm
+{
+
+/** Default number of bins of the histograms of IntensityStatistics. */
+constexpr unsigned int DefaultIntensityHistogramBins = 64;
+
+/** Intensity statistics of one component of an image, e.g. to set the
+ * window and level of a display. Non-finite values of float components are
+ * not counted. */
+struct ComponentStatistics
+{
+  double minimum{ 0.0 };
+  double maximum{ 0.0 };
+  double mean{ 0.0 };
+  /** Counts of equal width bins from the minimum to the maximum. The maximum
+   * is counted in the last bin. */
+  std::vector<uint64_t> histogram;
+};
+
+/** Intensity statistics of each component of an image, stored in the
+ * intensityStatistics entry of its header so readers get them with the
+ * image information, before the pixel data. */
+struct IntensityStatistics
+{
+  std::vector<ComponentStatistics> components;
+
+  bool
+  IsEmpty() const
+  {
+    return components.empty();
+  }
+};
+
+/** Compute the statistics of numberOfPixels pixels of numberOfComponents
+ * interleaved components. Chunks of pixels are accumulated by the threads
+ * of the threader, a new threader when none is given. 8 and 16 bit
+ * components are counted by value in a single pass over the buffer, wider
+ * components take a second pass for the histogram once the range is
+ * known. */
+WebAssemblyInterface_EXPORT IntensityStatistics
+ComputeIntensityStatistics(IOComponentEnum componentType,
+                           const void * buffer,
+                           unsigned int numberOfComponents,
+                           uint64_t numberOfPixels,
+                           unsigned int bins = DefaultIntensityHistogramBins,
+                           MultiThreaderBase * threader = nullptr);
+
+/** Write the statistics as the value of an intensityStatistics map entry:
+ * [{ "minimum": 0.0, "maximum": 255.0, "mean": 81.5, "histogram": [...] }],
+ * one map per component. */
+WebAssemblyInterface_EXPORT void
+WriteIntensityStatistics(CBORSink & sink, const IntensityStatistics & statistics);
+
+/** Parse the value of an intensityStatistics map entry. Throws a
+ * std::runtime_error on an unexpected item. */
+WebAssemblyInterface_EXPORT IntensityStatistics
+ReadIntensityStatistics(const cbor_item_t * item);
+
+/** The JSON array of the intensityStatistics entry of an image JSON. */
+WebAssemblyInterface_EXPORT void
+ConvertIntensityStatisticsToJSON(const IntensityStatistics & statistics,
+                                 rapidjson::Value & statisticsJson,
+                                 rapidjson::Document::AllocatorType & allocator);
+
+/** Parse the intensityStatistics entry of an image JSON. Throws a
+ * std::runtime_error on an unexpected value. */
+WebAssemblyInterface_EXPORT IntensityStatistics
+ConvertJSONToIntensityStatistics(const rapidjson::Value & statisticsJson);
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,71 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmInterfaceTypeKey_h
+#define itkWasmInterfaceTypeKey_h
+
+#include <cstdint>
+#include <string_view>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/** Pack an interface data type into a single key for type dispatch tables.
+ *
+ * The key is a 64-bit FNV-1a hash of the dimension, component type, pixel
+ * type and number of components. Pass 0 components for pixel types with a
+ * run-time number of components, e.g. VariableLengthVector. */
+constexpr uint64_t
+InterfaceTypeKey(unsigned int dimension, std::string_view componentType, std::string_view pixelType, unsigned int components)
+{
+  constexpr uint64_t prime = 1099511628211ull;
+  uint64_t hash = 14695981039346656037ull;
+  for (unsigned int ii = 0; ii < 4; ++ii)
+  {
+    hash = (hash ^ ((dimension >> (8 * ii)) & 0xff)) * prime;
+  }
+  for (const char character : componentType)
+  {
+    hash = (hash ^ static_cast<uint8_t>(character)) * prime;
+  }
+  hash = (hash ^ '/') * prime;
+  for (const char character : pixelType)
+  {
+    hash = (hash ^ static_cast<uint8_t>(character)) * prime;
+  }
+  hash = (hash ^ '/') * prime;
+  for (unsigned int ii = 0; ii < 4; ++ii)
+  {
+    hash = (hash ^ ((components >> (8 * ii)) & 0xff)) * prime;
+  }
+  return hash;
+}
+
+/** Whether the number of components of a pixel type is only known at run time. */
+constexpr bool
+IsVariableLengthPixelType(std::string_view pixelType)
+{
+  return pixelType == "VariableLengthVector" || pixelType == "VariableSizeMatrix";
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
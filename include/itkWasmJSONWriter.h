@@ -0,0 +1,69 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmJSONWriter_h
+#define itkWasmJSONWriter_h
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/** Writer used by the data object to Wasm JSON serializers. */
+using WasmJSONWriterType = rapidjson::Writer<rapidjson::StringBuffer>;
+
+/** Cleared string buffer that keeps its capacity across the serializations
+ * of a thread, so serializing small data objects does not allocate it. */
+inline rapidjson::StringBuffer &
+GetWasmJSONStringBuffer()
+{
+  static thread_local rapidjson::StringBuffer stringBuffer;
+  stringBuffer.Clear();
+  return stringBuffer;
+}
+
+template <typename TWriter>
+void
+WriteWasmJSONString(TWriter & writer, std::string_view value)
+{
+  writer.String(value.data(), static_cast<rapidjson::SizeType>(value.size()));
+}
+
+/** Write a `data:application/vnd.itk.address,0:<address>` string. */
+template <typename TWriter>
+void
+WriteWasmJSONAddress(TWriter & writer, size_t address)
+{
+  constexpr std::string_view prefix = "data:application/vnd.itk.address,0:";
+  char buffer[prefix.size() + 20];
+  std::memcpy(buffer, prefix.data(), prefix.size());
+  const auto result = std::to_chars(buffer + prefix.size(), buffer + sizeof(buffer), address);
+  writer.String(buffer, static_cast<rapidjson::SizeType>(result.ptr - buffer));
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmLazyIOFactory_h
+#define itkWasmLazyIOFactory_h
+
+#include "itkImageIOFactory.h"
+#include "itkMeshIOFactory.h"
+#include "itkWasmFileHeader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/**
+ *\class LazyIOFactory
+ * \brief Registry of lightweight ImageIO or MeshIO stubs that construct the
+ * IO only for a file it may read or write
+ *
+ * ImageIOFactory::CreateImageIO and MeshIOFactory::CreateMeshIO construct
+ * every registered IO to ask it CanReadFile. A stub records the file
+ * extensions and the signature test of a format and how to create its IO.
+ * CreateIO constructs the IOs of the stubs that match the file, those with
+ * a matching signature and extension first, and returns the first that can
+ * read or write it. The IOs of the other stubs are only constructed when
+ * none of these can, and when no stub can, the ITK factories are asked.
+ *
+ * Pipelines register stubs instead of the ITK IO factories when built with
+ * ITK_WASM_LAZY_IO_FACTORIES, see itkWasmLazyIOFactoryRegisterManager.h.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+template <typename TIOBase>
+class LazyIOFactory
+{
+public:
+  using IOBasePointer = typename TIOBase::Pointer;
+  using CreateFunction = IOBasePointer (*)();
+  using SignatureFunction = bool (*)(const FileHeader &);
+
+  struct Stub
+  {
+    std::string name;
+    /** Lowercase, e.g. .nii.gz */
+    std::vector<std::string> extensions;
+    /** Whether the header has the format signature. nullptr when the format
+     * has no signature. */
+    SignatureFunction signature;
+    CreateFunction create;
+  };
+
+  /** Register a stub. Stubs with the name of a registered stub are ignored. */
+  static void
+  RegisterStub(Stub stub)
+  {
+    auto & stubs = GetStubs();
+    const auto registered = std::find_if(stubs.begin(), stubs.end(), [&](const Stub & other) { return other.name == stub.name; });
+    if (registered == stubs.end())
+    {
+      stubs.push_back(std::move(stub));
+    }
+  }
+
+  template <typename TIO>
+  static void
+  RegisterStub(const char * name, std::vector<std::string> extensions, SignatureFunction signature = nullptr)
+  {
+    RegisterStub(Stub{ name, std::move(extensions), signature, []() -> IOBasePointer { return TIO::New().GetPointer(); } });
+  }
+
+  static size_t
+  GetNumberOfStubs()
+  {
+    return GetStubs().size();
+  }
+
+  /** The IO to read or write the file, or nullptr if no IO can. */
+  static IOBasePointer
+  CreateIO(const char * path, CommonEnums::IOFileMode mode)
+  {
+    const auto & stubs = GetStubs();
+    if (!stubs.empty())
+    {
+      const bool read = mode == CommonEnums::IOFileMode::ReadMode;
+      std::string fileName(path);
+      std::transform(fileName.begin(), fileName.end(), fileName.begin(), [](unsigned char c) { return std::tolower(c); });
+
+      // Written files have no signature yet
+      std::optional<FileHeader> header;
+      if (read)
+      {
+        header.emplace(path);
+      }
+
+      // 0: signature and extension, 1: signature, 2: extension, 3: neither
+      std::vector<std::pair<int, size_t>> ranked;
+      for (size_t index = 0; index < stubs.size(); ++index)
+      {
+        const Stub & stub = stubs[index];
+        const bool signature = header && stub.signature != nullptr && stub.signature(*header);
+        const bool extension = std::any_of(stub.extensions.begin(), stub.extensions.end(), [&](const std::string & ext) {
+          return fileName.size() >= ext.size() && fileName.compare(fileName.size() - ext.size(), ext.size(), ext) == 0;
+        });
+        const int rank = signature ? (extension ? 0 : 1) : (extension ? 2 : 3);
+        ranked.emplace_back(rank, index);
+      }
+      std::stable_sort(ranked.begin(), ranked.end(), [](const auto & a, const auto & b) { return a.first < b.first; });
+
+      for (const auto & [rank, index] : ranked)
+      {
+        IOBasePointer io = stubs[index].create();
+        if (read ? io->CanReadFile(path) : io->CanWriteFile(path))
+        {
+          return io;
+        }
+      }
+    }
+
+    if constexpr (std::is_same_v<TIOBase, ImageIOBase>)
+    {
+      return ImageIOFactory::CreateImageIO(path, mode);
+    }
+    else
+    {
+      return MeshIOFactory::CreateMeshIO(path, mode);
+    }
+  }
+
+private:
+  static std::vector<Stub> &
+  GetStubs()
+  {
+    static std::vector<Stub> stubs;
+    return stubs;
+  }
+};
+
+using LazyImageIOFactory = LazyIOFactory<ImageIOBase>;
+using LazyMeshIOFactory = LazyIOFactory<MeshIOBase>;
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
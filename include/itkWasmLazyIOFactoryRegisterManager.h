@@ -0,0 +1,294 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmLazyIOFactoryRegisterManager_h
+#define itkWasmLazyIOFactoryRegisterManager_h
+
+#include "itkWasmLazyIOFactory.h"
+#include "itkWasmImageIO.h"
+#include "itkWasmMeshIO.h"
+
+// IO modules whose headers are on the include path, i.e. the ITK modules the
+// pipeline was configured with
+#if __has_include("itkPNGImageIO.h")
+#  include "itkPNGImageIO.h"
+#  define ITK_WASM_LAZY_PNG_IMAGE_IO
+#endif
+#if __has_include("itkMetaImageIO.h")
+#  include "itkMetaImageIO.h"
+#  define ITK_WASM_LAZY_META_IMAGE_IO
+#endif
+#if __has_include("itkTIFFImageIO.h")
+#  include "itkTIFFImageIO.h"
+#  define ITK_WASM_LAZY_TIFF_IMAGE_IO
+#endif
+#if __has_include("itkNiftiImageIO.h")
+#  include "itkNiftiImageIO.h"
+#  define ITK_WASM_LAZY_NIFTI_IMAGE_IO
+#endif
+#if __has_include("itkJPEGImageIO.h")
+#  include "itkJPEGImageIO.h"
+#  define ITK_WASM_LAZY_JPEG_IMAGE_IO
+#endif
+#if __has_include("itkNrrdImageIO.h")
+#  include "itkNrrdImageIO.h"
+#  define ITK_WASM_LAZY_NRRD_IMAGE_IO
+#endif
+#if __has_include("itkVTKImageIO.h")
+#  include "itkVTKImageIO.h"
+#  define ITK_WASM_LAZY_VTK_IMAGE_IO
+#endif
+#if __has_include("itkBMPImageIO.h")
+#  include "itkBMPImageIO.h"
+#  define ITK_WASM_LAZY_BMP_IMAGE_IO
+#endif
+#if __has_include("itkHDF5ImageIO.h")
+#  include "itkHDF5ImageIO.h"
+#  define ITK_WASM_LAZY_HDF5_IMAGE_IO
+#endif
+#if __has_include("itkMINCImageIO.h")
+#  include "itkMINCImageIO.h"
+#  define ITK_WASM_LAZY_MINC_IMAGE_IO
+#endif
+#if __has_include("itkMRCImageIO.h")
+#  include "itkMRCImageIO.h"
+#  define ITK_WASM_LAZY_MRC_IMAGE_IO
+#endif
+#if __has_include("itkLSMImageIO.h")
+#  include "itkLSMImageIO.h"
+#  define ITK_WASM_LAZY_LSM_IMAGE_IO
+#endif
+#if __has_include("itkMGHImageIO.h")
+#  include "itkMGHImageIO.h"
+#  define ITK_WASM_LAZY_MGH_IMAGE_IO
+#endif
+#if __has_include("itkBioRadImageIO.h")
+#  include "itkBioRadImageIO.h"
+#  define ITK_WASM_LAZY_BIO_RAD_IMAGE_IO
+#endif
+#if __has_include("itkGiplImageIO.h")
+#  include "itkGiplImageIO.h"
+#  define ITK_WASM_LAZY_GIPL_IMAGE_IO
+#endif
+#if __has_include("itkGE4ImageIO.h")
+#  include "itkGE4ImageIO.h"
+#  include "itkGE5ImageIO.h"
+#  include "itkGEAdwImageIO.h"
+#  define ITK_WASM_LAZY_GE_IMAGE_IO
+#endif
+#if __has_include("itkGDCMImageIO.h")
+#  include "itkGDCMImageIO.h"
+#  define ITK_WASM_LAZY_GDCM_IMAGE_IO
+#endif
+#if __has_include("itkScancoImageIO.h")
+#  include "itkScancoImageIO.h"
+#  define ITK_WASM_LAZY_SCANCO_IMAGE_IO
+#endif
+#if __has_include("itkFDFImageIO.h")
+#  include "itkFDFImageIO.h"
+#  define ITK_WASM_LAZY_FDF_IMAGE_IO
+#endif
+
+#if __has_include("itkBYUMeshIO.h")
+#  include "itkBYUMeshIO.h"
+#  define ITK_WASM_LAZY_BYU_MESH_IO
+#endif
+#if __has_include("itkFreeSurferAsciiMeshIO.h")
+#  include "itkFreeSurferAsciiMeshIO.h"
+#  include "itkFreeSurferBinaryMeshIO.h"
+#  define ITK_WASM_LAZY_FREE_SURFER_MESH_IO
+#endif
+#if __has_include("itkVTKPolyDataMeshIO.h")
+#  include "itkVTKPolyDataMeshIO.h"
+#  define ITK_WASM_LAZY_VTK_POLY_DATA_MESH_IO
+#endif
+#if __has_include("itkOBJMeshIO.h")
+#  include "itkOBJMeshIO.h"
+#  define ITK_WASM_LAZY_OBJ_MESH_IO
+#endif
+#if __has_include("itkOFFMeshIO.h")
+#  include "itkOFFMeshIO.h"
+#  define ITK_WASM_LAZY_OFF_MESH_IO
+#endif
+#if __has_include("itkSTLMeshIO.h")
+#  include "itkSTLMeshIO.h"
+#  define ITK_WASM_LAZY_STL_MESH_IO
+#endif
+#if __has_include("itkSWCMeshIO.h")
+#  include "itkSWCMeshIO.h"
+#  define ITK_WASM_LAZY_SWC_MESH_IO
+#endif
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/**
+ *\class LazyIOFactoryRegisterManager
+ * \brief Registers the LazyImageIOFactory and LazyMeshIOFactory stubs of a
+ * pipeline's IO modules
+ *
+ * Included by itkPipeline.h when the pipeline is built with
+ * ITK_WASM_LAZY_IO_FACTORIES, in place of the ITK IO factory register
+ * managers, which pipelines skip with
+ *
+ *   set(ITK_NO_IMAGEIO_FACTORY_REGISTER_MANAGER 1)
+ *   set(ITK_NO_MESHIO_FACTORY_REGISTER_MANAGER 1)
+ *
+ * before include(${ITK_USE_FILE}). Stubs are registered in the order of the
+ * ITK factory registration, more specific formats first, e.g. LSM before
+ * TIFF. The signatures follow read-image-probe.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class LazyIOFactoryRegisterManager
+{
+public:
+  LazyIOFactoryRegisterManager()
+  {
+    LazyImageIOFactory::RegisterStub<WasmImageIO>(
+      "wasm", { ".iwi", ".iwi/", ".iwi.cbor" }, [](const FileHeader & header) { return header.Has(1, "\x69imageType"); });
+#ifdef ITK_WASM_LAZY_PNG_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<PNGImageIO>(
+      "png", { ".png" }, [](const FileHeader & header) { return header.Has(0, "\x89PNG\r\n\x1a\n"); });
+#endif
+#ifdef ITK_WASM_LAZY_META_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<MetaImageIO>("meta", { ".mha", ".mhd" }, [](const FileHeader & header) {
+      return header.StartsWithKeyword("ObjectType") || header.StartsWithKeyword("NDims");
+    });
+#endif
+#ifdef ITK_WASM_LAZY_LSM_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<LSMImageIO>("lsm", { ".lsm" }, [](const FileHeader & header) {
+      return header.Has(0, "II*\0", 4) || header.Has(0, "MM\0*", 4);
+    });
+#endif
+#ifdef ITK_WASM_LAZY_TIFF_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<TIFFImageIO>("tiff", { ".tif", ".tiff" }, [](const FileHeader & header) {
+      return header.Has(0, "II*\0", 4) || header.Has(0, "MM\0*", 4) || header.Has(0, "II+\0", 4) ||
+             header.Has(0, "MM\0+", 4);
+    });
+#endif
+#ifdef ITK_WASM_LAZY_NIFTI_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<NiftiImageIO>(
+      "nifti", { ".nia", ".nii", ".nii.gz", ".hdr", ".img", ".img.gz" }, [](const FileHeader & header) {
+        return header.Has(344, "n+1\0", 4) || header.Has(344, "ni1\0", 4) || header.Has(4, "n+2\0", 4) ||
+               header.Has(4, "ni2\0", 4) || header.UInt32(0, false) == 348 || header.UInt32(0, true) == 348;
+      });
+#endif
+#ifdef ITK_WASM_LAZY_JPEG_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<JPEGImageIO>(
+      "jpeg", { ".jpg", ".jpeg" }, [](const FileHeader & header) { return header.Has(0, "\xff\xd8\xff"); });
+#endif
+#ifdef ITK_WASM_LAZY_NRRD_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<NrrdImageIO>(
+      "nrrd", { ".nrrd", ".nhdr" }, [](const FileHeader & header) { return header.Has(0, "NRRD000"); });
+#endif
+#ifdef ITK_WASM_LAZY_VTK_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<VTKImageIO>(
+      "vtk", { ".vtk" }, [](const FileHeader & header) { return header.Has(0, "# vtk DataFile"); });
+#endif
+#ifdef ITK_WASM_LAZY_BMP_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<BMPImageIO>(
+      "bmp", { ".bmp" }, [](const FileHeader & header) { return header.Has(0, "BM"); });
+#endif
+#ifdef ITK_WASM_LAZY_MINC_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<MINCImageIO>(
+      "minc", { ".mnc", ".mnc.gz", ".mnc2" }, [](const FileHeader & header) {
+        return header.Has(0, "CDF\x01") || header.Has(0, "CDF\x02") || header.Has(0, "\x89HDF\r\n\x1a\n");
+      });
+#endif
+#ifdef ITK_WASM_LAZY_HDF5_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<HDF5ImageIO>("hdf5", { ".hdf5", ".h5" }, [](const FileHeader & header) {
+      const char signature[] = "\x89HDF\r\n\x1a\n";
+      return header.Has(0, signature) || header.Has(512, signature) || header.Has(1024, signature) ||
+             header.Has(2048, signature);
+    });
+#endif
+#ifdef ITK_WASM_LAZY_MRC_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<MRCImageIO>(
+      "mrc", { ".mrc", ".rec" }, [](const FileHeader & header) { return header.Has(208, "MAP "); });
+#endif
+#ifdef ITK_WASM_LAZY_MGH_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<MGHImageIO>("mgh", { ".mgh", ".mgz", ".mgh.gz" });
+#endif
+#ifdef ITK_WASM_LAZY_BIO_RAD_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<BioRadImageIO>(
+      "bio-rad", { ".pic" }, [](const FileHeader & header) { return header.Has(54, "\x39\x30", 2); });
+#endif
+#ifdef ITK_WASM_LAZY_GIPL_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<GiplImageIO>("gipl", { ".gipl", ".gipl.gz" }, [](const FileHeader & header) {
+      return header.UInt32(252, true) == 0xefffe9b0 || header.UInt32(252, true) == 0x2ae389b8;
+    });
+#endif
+#ifdef ITK_WASM_LAZY_GE_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<GE5ImageIO>("ge5", {}, [](const FileHeader & header) { return header.Has(0, "IMGF"); });
+    LazyImageIOFactory::RegisterStub<GE4ImageIO>("ge4", {});
+    LazyImageIOFactory::RegisterStub<GEAdwImageIO>("ge-adw", {});
+#endif
+#ifdef ITK_WASM_LAZY_GDCM_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<GDCMImageIO>(
+      "gdcm", { ".dcm" }, [](const FileHeader & header) { return header.Has(128, "DICM"); });
+#endif
+#ifdef ITK_WASM_LAZY_SCANCO_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<ScancoImageIO>("scanco", { ".isq", ".aim" }, [](const FileHeader & header) {
+      return header.Has(0, "CTDATA-HEADER_V1") || header.Has(0, "AIMDATA_V030");
+    });
+#endif
+#ifdef ITK_WASM_LAZY_FDF_IMAGE_IO
+    LazyImageIOFactory::RegisterStub<FDFImageIO>(
+      "fdf", { ".fdf" }, [](const FileHeader & header) { return header.Has(0, "#!/usr/local/fdf/startup"); });
+#endif
+
+    LazyMeshIOFactory::RegisterStub<WasmMeshIO>(
+      "wasm", { ".iwm", ".iwm/", ".iwm.cbor" }, [](const FileHeader & header) { return header.Has(1, "\x68meshType"); });
+#ifdef ITK_WASM_LAZY_BYU_MESH_IO
+    LazyMeshIOFactory::RegisterStub<BYUMeshIO>("byu", { ".byu" });
+#endif
+#ifdef ITK_WASM_LAZY_FREE_SURFER_MESH_IO
+    LazyMeshIOFactory::RegisterStub<FreeSurferAsciiMeshIO>("free-surfer-ascii", { ".fsa" });
+    LazyMeshIOFactory::RegisterStub<FreeSurferBinaryMeshIO>(
+      "free-surfer-binary", { ".fsb" }, [](const FileHeader & header) { return header.Has(0, "\xff\xff\xfe"); });
+#endif
+#ifdef ITK_WASM_LAZY_VTK_POLY_DATA_MESH_IO
+    LazyMeshIOFactory::RegisterStub<VTKPolyDataMeshIO>(
+      "vtk-poly-data", { ".vtk" }, [](const FileHeader & header) { return header.Has(0, "# vtk DataFile"); });
+#endif
+#ifdef ITK_WASM_LAZY_OBJ_MESH_IO
+    LazyMeshIOFactory::RegisterStub<OBJMeshIO>("obj", { ".obj" });
+#endif
+#ifdef ITK_WASM_LAZY_OFF_MESH_IO
+    LazyMeshIOFactory::RegisterStub<OFFMeshIO>(
+      "off", { ".off" }, [](const FileHeader & header) { return header.StartsWithKeyword("OFF"); });
+#endif
+#ifdef ITK_WASM_LAZY_STL_MESH_IO
+    LazyMeshIOFactory::RegisterStub<STLMeshIO>(
+      "stl", { ".stl" }, [](const FileHeader & header) { return header.StartsWithKeyword("solid"); });
+#endif
+#ifdef ITK_WASM_LAZY_SWC_MESH_IO
+    LazyMeshIOFactory::RegisterStub<SWCMeshIO>("swc", { ".swc" });
+#endif
+  }
+};
+
+static LazyIOFactoryRegisterManager LazyIOFactoryRegisterManagerInstance;
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,130 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmMemoryBudget_h
+#define itkWasmMemoryBudget_h
+
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/** Parse a number of bytes with an optional K, M, G, or T suffix, powers of
+ * 1024, as taken by --max-memory, e.g. "512M". Returns false if the text is
+ * not a byte size. */
+inline bool
+ParseByteSize(const std::string & text, uint64_t & bytes)
+{
+  size_t position = 0;
+  uint64_t value = 0;
+  while (position < text.size() && std::isdigit(static_cast<unsigned char>(text[position])))
+  {
+    const uint64_t digit = static_cast<uint64_t>(text[position] - '0');
+    if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+    {
+      return false;
+    }
+    value = value * 10 + digit;
+    ++position;
+  }
+  if (position == 0)
+  {
+    return false;
+  }
+  unsigned int shift = 0;
+  if (position < text.size())
+  {
+    switch (std::toupper(static_cast<unsigned char>(text[position])))
+    {
+      case 'K':
+        shift = 10;
+        break;
+      case 'M':
+        shift = 20;
+        break;
+      case 'G':
+        shift = 30;
+        break;
+      case 'T':
+        shift = 40;
+        break;
+      default:
+        return false;
+    }
+    ++position;
+    // Also accept KB, MiB, ...
+    if (position < text.size() && std::toupper(static_cast<unsigned char>(text[position])) == 'I')
+    {
+      ++position;
+    }
+    if (position < text.size() && std::toupper(static_cast<unsigned char>(text[position])) == 'B')
+    {
+      ++position;
+    }
+  }
+  if (position != text.size() || (shift > 0 && value > (std::numeric_limits<uint64_t>::max() >> shift)))
+  {
+    return false;
+  }
+  bytes = value << shift;
+  return true;
+}
+
+/** The largest piece size, from 1 to maximumSize, whose estimated peak
+ * memory, bytes(size), is within budgetBytes, to divide a computation into
+ * pieces, e.g. a number of output slices. bytes must not decrease with the
+ * size. A budget of 0 is no budget, and maximumSize is returned. When even a
+ * piece of size 1 is over the budget, 1 is returned, and the computation runs
+ * in as many pieces as possible. */
+template <typename TBytes>
+size_t
+LargestPieceWithinBudget(size_t maximumSize, uint64_t budgetBytes, TBytes && bytes)
+{
+  if (maximumSize <= 1 || budgetBytes == 0 || bytes(maximumSize) <= budgetBytes)
+  {
+    return maximumSize > 0 ? maximumSize : 1;
+  }
+  // bytes(low) is within the budget, or low is 1, and bytes(high) is not
+  size_t low = 1;
+  size_t high = maximumSize;
+  while (high - low > 1)
+  {
+    const size_t middle = low + (high - low) / 2;
+    if (bytes(middle) <= budgetBytes)
+    {
+      low = middle;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+} // end namespace wasm
+
+} // end namespace itk
+
+#endif
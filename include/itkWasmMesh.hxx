@@ -19,6 +19,11 @@
 #define itkWasmMesh_hxx
 
 #include "itkWasmMesh.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
 
 namespace itk
 {
@@ -28,7 +33,57 @@ void
 WasmMesh<TMesh>
 ::SetMesh(const MeshType * mesh)
 {
-  this->m_CellBufferContainer = const_cast<MeshType *>(mesh)->GetCellsArray();
+  this->m_CellBufferContainer = CellBufferContainerType::New();
+  const auto * cells = mesh->GetCells();
+  if (cells != nullptr && cells->Size() > 0)
+  {
+    using CellType = typename MeshType::CellType;
+    using CellBufferElementType = typename CellBufferContainerType::Element;
+
+    std::vector<const CellType *> meshCells;
+    meshCells.reserve(cells->Size());
+    for (auto it = cells->Begin(); it != cells->End(); ++it)
+    {
+      meshCells.push_back(it.Value());
+    }
+    const SizeValueType numberOfCells = meshCells.size();
+
+    // Meshes of a single cell type and number of points, e.g. triangle
+    // surfaces or tetrahedral volumes, have a fixed stride. Otherwise, the
+    // offset of each cell is the prefix sum of the cell sizes.
+    const CellGeometryEnum cellType = meshCells[0]->GetType();
+    const unsigned int cellPoints = meshCells[0]->GetNumberOfPoints();
+    const bool homogeneous = std::all_of(meshCells.begin(), meshCells.end(), [&](const CellType * cell) {
+      return cell->GetType() == cellType && cell->GetNumberOfPoints() == cellPoints;
+    });
+    const SizeValueType stride = 2 + cellPoints;
+    std::vector<SizeValueType> offsets;
+    auto multiThreader = MultiThreaderBase::New();
+    if (!homogeneous)
+    {
+      offsets.resize(numberOfCells + 1);
+      multiThreader->ParallelizeArray(
+        0,
+        numberOfCells,
+        [&](SizeValueType ii) { offsets[ii + 1] = 2 + meshCells[ii]->GetNumberOfPoints(); },
+        nullptr);
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    }
+
+    this->m_CellBufferContainer->resize(homogeneous ? numberOfCells * stride : offsets[numberOfCells]);
+    CellBufferElementType * buffer = this->m_CellBufferContainer->data();
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfCells,
+      [&](SizeValueType ii) {
+        const CellType * cell = meshCells[ii];
+        CellBufferElementType * entry = buffer + (homogeneous ? ii * stride : offsets[ii]);
+        entry[0] = static_cast<CellBufferElementType>(cell->GetType());
+        entry[1] = static_cast<CellBufferElementType>(cell->GetNumberOfPoints());
+        std::copy(cell->PointIdsBegin(), cell->PointIdsEnd(), entry + 2);
+      },
+      nullptr);
+  }
   this->SetDataObject(const_cast<MeshType *>(mesh));
 }
 
@@ -0,0 +1,114 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmMeshChunks_h
+#define itkWasmMeshChunks_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkMeshIOBase.h"
+#include "itkWasmBundleFile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+class WasmMeshIO;
+
+namespace wasm
+{
+
+/** A spatial chunk of a mesh, with its buffers in the layout of the buffers
+ * of the MeshIOBase partitioned. Chunks are written as the members of a
+ * .iwm.bundle file, each encoded, and compressed, on its own, with their
+ * level and bounds in the table of contents. */
+struct MeshChunk
+{
+  /** Name of the bundle member, the level and the index of the chunk in
+   * the level, e.g. 0/12. */
+  std::string name;
+  /** Level of detail, 0 for the full resolution. */
+  uint32_t level{ 0 };
+  /** Bounding box of the points, the minimum then the maximum of each
+   * axis. */
+  std::vector<double> bounds;
+
+  uint64_t numberOfPoints{ 0 };
+  uint64_t numberOfCells{ 0 };
+  uint64_t cellBufferSize{ 0 };
+  uint64_t numberOfPointPixels{ 0 };
+  uint64_t numberOfCellPixels{ 0 };
+  std::vector<char> points;
+  std::vector<char> cells;
+  std::vector<char> pointData;
+  std::vector<char> cellData;
+};
+
+/** Partition the points, cells, point data, and cell data buffers of a mesh,
+ * in the layout of the buffers of meshIO, into the leaves of an octree over
+ * its first three axes.
+ *
+ * The cells are assigned to a leaf by their centroid, and the leaves are
+ * split until they use at most maximumPointsPerChunk points. A chunk holds
+ * the points of its cells, so the points on the boundaries of leaves are in
+ * each chunk that uses them, and points not used by a cell are dropped. A
+ * mesh without cells is partitioned by its points.
+ *
+ * Each of the numberOfLevels coarse levels clusters the points of the mesh
+ * on a grid whose cells are twice as large as those of the level before it,
+ * with the mean position, and the point data of the first point, of each
+ * cluster. Cells whose points fall in fewer clusters than they have points
+ * are dropped. The clustered mesh is then partitioned like the full
+ * resolution.
+ *
+ * Point data and cell data are kept when there is a pixel per point, or
+ * per cell. Chunks are in level order, then in octree order. Throws a
+ * std::runtime_error if the cell buffer is malformed. */
+WebAssemblyInterface_EXPORT std::vector<MeshChunk>
+PartitionMesh(const MeshIOBase * meshIO,
+              const std::vector<char> & points,
+              const std::vector<char> & cells,
+              const std::vector<char> & pointData,
+              const std::vector<char> & cellData,
+              uint64_t maximumPointsPerChunk,
+              unsigned int numberOfLevels);
+
+/** Write the chunk of a mesh partitioned by PartitionMesh with chunkIO,
+ * whose file name is a .iwm.bundle file, as the member of its name, level,
+ * and bounds. The types of the points, cells, and their data are those of
+ * meshIO. */
+WebAssemblyInterface_EXPORT void
+WriteMeshChunk(const MeshIOBase * meshIO, const MeshChunk & chunk, WasmMeshIO * chunkIO);
+
+/** The chunks of a chunked .iwm.bundle file at the level whose bounds
+ * intersect the bounds, the minimum then the maximum of each axis. Empty
+ * bounds select every chunk of the level. Axes that are not in both bounds
+ * are not compared. */
+WebAssemblyInterface_EXPORT std::vector<const BundleMember *>
+SelectMeshChunks(const BundleTableOfContents & tableOfContents, uint32_t level, const std::vector<double> & bounds);
+
+/** Number of levels of the chunks of a chunked .iwm.bundle file, 0 if it
+ * has no chunks. */
+WebAssemblyInterface_EXPORT uint32_t
+GetNumberOfMeshChunkLevels(const BundleTableOfContents & tableOfContents);
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
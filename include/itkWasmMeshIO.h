@@ -20,7 +20,18 @@
 #include "WebAssemblyInterfaceExport.h"
 
 #include "itkMeshIOBase.h"
+#include "itkWasmBundleFile.h"
+#include "itkWasmCBORSink.h"
+#include "itkWasmCBORSource.h"
+#include "itkWasmPayloadFilter.h"
+#include "itkWasmQuantization.h"
+#include <cstdio>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "rapidjson/document.h"
 #include "cbor.h"
@@ -37,6 +48,8 @@ namespace itk
  *
  * The format is experimental and subject to change. We mean it.
  *
+ * .iwm.bundle files hold several meshes, see wasm::BundleMember.
+ *
  * \ingroup IOFilters
  * \ingroup WebAssemblyInterface
  */
@@ -97,6 +110,55 @@ public:
 
   static size_t ITKComponentSize( const CommonEnums::IOComponent );
 
+  /** Quantize float and double points and point data written to a .iwm.cbor
+   * stream to 16 or 32 bit unsigned integers against their bounding box.
+   * 0, the default, writes them unquantized. Readers that predate
+   * quantization cannot read quantized files. */
+  itkSetMacro(QuantizationBits, unsigned int);
+  itkGetConstMacro(QuantizationBits, unsigned int);
+
+  /** Largest absolute error allowed in a quantized component. Writing fails
+   * if the bounding box of the points or the point data is too large for
+   * the QuantizationBits. 0, the default, does not limit the error. */
+  itkSetMacro(QuantizationMaximumError, double);
+  itkGetConstMacro(QuantizationMaximumError, double);
+
+  /** Member of a .iwm.bundle file to read, by name, or by the
+   * BundleMemberIndex when the name is empty, the default. When writing,
+   * the name of the member appended to the bundle, by default its index. */
+  itkSetStringMacro(BundleMemberName);
+  itkGetStringMacro(BundleMemberName);
+  itkSetMacro(BundleMemberIndex, SizeValueType);
+  itkGetConstMacro(BundleMemberIndex, SizeValueType);
+
+  /** Append meshes written to an existing .iwm.bundle file, instead of
+   * replacing it. On by default. */
+  itkSetMacro(AppendToBundle, bool);
+  itkGetConstMacro(AppendToBundle, bool);
+  itkBooleanMacro(AppendToBundle);
+
+  /** Level of detail and bounding box of the member appended to a
+   * .iwm.bundle file when it is a spatial chunk of a chunked mesh, see
+   * wasm::PartitionMesh. Empty bounds, the default, append a member that is
+   * not a chunk. */
+  itkSetMacro(BundleMemberLevel, unsigned int);
+  itkGetConstMacro(BundleMemberLevel, unsigned int);
+  void SetBundleMemberBounds(const std::vector<double> & bounds)
+  {
+    if (this->m_BundleMemberBounds != bounds)
+    {
+      this->m_BundleMemberBounds = bounds;
+      this->Modified();
+    }
+  }
+  const std::vector<double> & GetBundleMemberBounds() const
+  {
+    return this->m_BundleMemberBounds;
+  }
+
+  /** Names of the members of the .iwm.bundle file read, in order. */
+  std::vector<std::string> GetBundleMemberNames() const;
+
 protected:
   WasmMeshIO();
   ~WasmMeshIO() override;
@@ -137,19 +199,117 @@ protected:
   /** Convenient method to read a buffer as binary. Return true on success. */
   bool ReadBufferAsBinary(std::istream & os, void *buffer, SizeValueType numberOfBytesToBeRead);
 
+  /** Read a typed array of the directory layout, e.g. data/points.raw,
+   * through a memory mapping where available. */
+  void ReadDataFile(const char * dataPath, void * buffer, SizeValueType numberOfBytesToBeRead);
+
+  /** Whether the file is a .iwm.cbor file, or a .iwm.bin aligned file whose
+   * metadata is the .iwm.cbor map. */
   bool FileNameIsCBOR();
-  void ReadCBORBuffer(const char * dataName, void * buffer, SizeValueType numberOfBytesToBeRead);
-  void WriteCBORBuffer(const char * dataName, void * buffer, SizeValueType numberOfBytesToWrite, IOComponentEnum ioComponent);
+  bool FileNameIsAligned();
+  bool FileNameIsBundle() const;
+
+  /** Read the table of contents of a .iwm.bundle file and select the member
+   * to read, by BundleMemberName or BundleMemberIndex. */
+  void SelectBundleMember();
+
+  /** The member of the .iwm.bundle file selected by SelectBundleMember. */
+  const wasm::BundleMember & GetBundleMember() const
+  {
+    return m_BundleMember;
+  }
+
+  /** Open the file, or the selected member of a .iwm.bundle file, for range
+   * reads. */
+  std::unique_ptr<wasm::RangeReader> OpenRangeReader() const;
 
-  /** Reads in the mesh information and populates the related buffers. */
-  void ReadCBOR(void * buffer = nullptr, unsigned char * cborBuffer = nullptr, size_t cborBufferLength = 0);
-  /** Writes the buffers into the CBOR item and the buffer out to disk. */
+  /** Open the file the encoded stream is written to, or the end of a
+   * .iwm.bundle file for the member appended. */
+  FILE * OpenCBORFile() const;
+
+  /** Encoding of the members appended to a .iwm.bundle file, "cbor" by
+   * default. */
+  virtual std::string GetBundleMemberEncodingForWriting() const;
+  /** The components are the elements of the typed array, e.g. the point
+   * dimension, for the payload filters. */
+  void ReadCBORBuffer(const char * dataName, void * buffer, SizeValueType numberOfBytesToBeRead, IOComponentEnum ioComponent, unsigned int components);
+  void WriteCBORBuffer(const char * dataName, void * buffer, SizeValueType numberOfBytesToWrite, IOComponentEnum ioComponent, unsigned int components);
+
+  /** Payload filters of the typed arrays of the .iwm.cbor file last read or
+   * written. */
+  const wasm::PayloadFilters & GetPayloadFilters() const
+  {
+    return m_PayloadFilters;
+  }
+
+  /** Payload filters to apply to the typed arrays when writing a .iwm.cbor
+   * stream. None by default. */
+  virtual wasm::PayloadFilters GetPayloadFiltersForWriting() const;
+
+  /** Reads in the mesh information. The typed arrays are indexed, not
+   * decoded, and are read into the buffers of ReadCBORBuffer. */
+  void ReadCBOR();
+  /** Read the next entry of the .iwm.cbor map and return its key. */
+  std::string ReadCBOREntry();
+  void ReadCBORIndexItem(std::string_view key, const cbor_item_t * value);
+
+  /** Create a source of the encoded .iwm.cbor stream, from its start. */
+  virtual std::unique_ptr<wasm::CBORSource> CreateCBORSource();
+  /** Declare the typed arrays of the .iwm.cbor file. The header is written
+   * to the sink when the first typed array is streamed, or by Write. */
   void WriteCBOR();
+  void WriteCBORHeader(wasm::CBORSink & sink);
+  void OpenCBORSink();
 
-  cbor_item_t * m_CBORRoot{ nullptr };
+  /** Create the sink the .iwm.cbor file is streamed into. encodedSize is the
+   * total number of bytes that will be written. */
+  virtual std::unique_ptr<wasm::CBORSink> CreateCBORSink(uint64_t encodedSize);
+
+  /** Number of bytes of the typed arrays. */
+  SizeValueType GetPointsSizeInBytes() const;
+  SizeValueType GetCellsSizeInBytes() const;
+  SizeValueType GetPointDataSizeInBytes() const;
+  SizeValueType GetCellDataSizeInBytes() const;
+
+  /** Position and size of a typed array payload in the encoded stream. */
+  struct CBORPayload
+  {
+    uint64_t offset{ 0 };
+    uint64_t size{ 0 };
+    /** Whether the offset is in the .iwm.bin file, aligned, rather than in
+     * the encoded stream. */
+    bool aligned{ false };
+  };
+  std::map<std::string, CBORPayload, std::less<>> m_CBORPayloads;
+  /** Quantization of the typed arrays, by name, of the file last read. */
+  std::map<std::string, wasm::Quantization, std::less<>> m_CBORQuantizations;
+  std::unique_ptr<wasm::CBORSource> m_CBORSource;
+  /** Metadata of the .iwm.bin file read, decoded by the CBORSource. */
+  std::vector<unsigned char> m_AlignedMetadata;
+  uint64_t m_CBOREntriesRemaining{ 0 };
+  uint64_t m_CBORNextEntryPosition{ 0 };
+
+  std::unique_ptr<wasm::CBORSink> m_CBORSink;
+  uint64_t m_CBORNumberOfEntries{ 0 };
+  uint64_t m_CBOREncodedSize{ 0 };
+  /** Map entries streamed with the typed arrays, e.g. pointsQuantization. */
+  uint64_t m_CBORBufferEntries{ 0 };
+  uint64_t m_CBORBufferEntriesWritten{ 0 };
+  wasm::PayloadFilters m_PayloadFilters;
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(WasmMeshIO);
+
+  unsigned int m_QuantizationBits{ 0 };
+  double m_QuantizationMaximumError{ 0.0 };
+
+  std::string m_BundleMemberName;
+  SizeValueType m_BundleMemberIndex{ 0 };
+  bool m_AppendToBundle{ true };
+  unsigned int m_BundleMemberLevel{ 0 };
+  std::vector<double> m_BundleMemberBounds;
+  wasm::BundleTableOfContents m_BundleTableOfContents;
+  wasm::BundleMember m_BundleMember;
 };
 } // end namespace itk
 
@@ -0,0 +1,74 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmMeshReordering_h
+#define itkWasmMeshReordering_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkMeshIOBase.h"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace itk
+{
+namespace wasm
+{
+
+/** Order of the points of a reordered mesh. */
+enum class MeshPointOrder : uint8_t
+{
+  /** The input order. */
+  Input,
+  /** The order in which the cells first use the points, followed by the
+   * unused points. */
+  FirstUse,
+  /** The Morton, or Z-order, curve through the bounding box of the points. */
+  Morton
+};
+
+/** Parse "input", "first-use", or "morton". Throws a std::runtime_error for
+ * other names. */
+WebAssemblyInterface_EXPORT MeshPointOrder
+MeshPointOrderFromString(std::string_view name);
+
+/** Reorder the points, cells, point data, and cell data buffers of a mesh,
+ * in the layout of the buffers of meshIO, for locality.
+ *
+ * With optimizeVertexCache, the cells are ordered with Forsyth's linear-speed
+ * vertex cache optimization, so consecutive cells share points. The points
+ * are then ordered by pointOrder and the point ids of the cells remapped.
+ *
+ * Point data and cell data are permuted with their points and cells. A mesh
+ * whose number of point pixels, or cell pixels, is neither 0 nor the number
+ * of points, or cells, keeps the order of its points, or cells. Throws a
+ * std::runtime_error if the cell buffer is malformed. */
+WebAssemblyInterface_EXPORT void
+ReorderMesh(const MeshIOBase * meshIO,
+            bool optimizeVertexCache,
+            MeshPointOrder pointOrder,
+            std::vector<char> & points,
+            std::vector<char> & cells,
+            std::vector<char> & pointData,
+            std::vector<char> & cellData);
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
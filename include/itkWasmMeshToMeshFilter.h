@@ -21,6 +21,10 @@
 #include "itkProcessObject.h"
 #include "itkWasmMesh.h"
 
+#include "rapidjson/document.h"
+
+#include <memory>
+
 namespace itk
 {
 /**
@@ -77,6 +81,14 @@ public:
   MeshType *
   GetOutput(unsigned int idx);
 
+  /** Use an already parsed JSON representation of the input instead of
+   * parsing the input JSON again. */
+  void SetJSONDocument(std::shared_ptr<const rapidjson::Document> document)
+  {
+    this->m_JSONDocument = std::move(document);
+    this->Modified();
+  }
+
 protected:
   WasmMeshToMeshFilter();
   ~WasmMeshToMeshFilter() override = default;
@@ -94,6 +106,8 @@ protected:
 
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+  std::shared_ptr<const rapidjson::Document> m_JSONDocument;
 };
 } // end namespace itk
 
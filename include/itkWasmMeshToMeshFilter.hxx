@@ -23,6 +23,7 @@
 #include "itkCommonEnums.h"
 #include "itkHexahedronCell.h"
 #include "itkLineCell.h"
+#include "itkMultiThreaderBase.h"
 #include "itkPolygonCell.h"
 #include "itkQuadrilateralCell.h"
 #include "itkQuadraticEdgeCell.h"
@@ -32,8 +33,12 @@
 #include "itkVertexCell.h"
 
 #include <exception>
+#include <mutex>
+#include <vector>
 #include "itkWasmMapComponentType.h"
 #include "itkWasmMapPixelType.h"
+#include "itkWasmTrace.h"
+#include "itkWasmAllocationStats.h"
 #include "itkMeshConvertPixelTraits.h"
 
 #include "rapidjson/document.h"
@@ -41,218 +46,242 @@
 namespace
 {
 
-template<typename TMesh, typename TCellBufferType>
-void
-populateCells(TMesh * mesh, itk::SizeValueType cellBufferSize, TCellBufferType * cellsBufferPtr)
+template <typename TCell, typename TCellBufferType>
+TCell *
+newCell(const TCellBufferType * pointIds, unsigned int numberOfPoints)
 {
-  using MeshType = TMesh;
+  auto * cell = new TCell;
+  for (unsigned int jj = 0; jj < numberOfPoints; ++jj)
+  {
+    cell->SetPointId(jj, static_cast<typename TCell::PointIdentifier>(pointIds[jj]));
+  }
+  return cell;
+}
 
-  using CellIdentifier = typename MeshType::CellIdentifier;
-  using PointIdentifier = typename MeshType::PointIdentifier;
-  using CellType = typename MeshType::CellType;
-  using VertexCellType = itk::VertexCell<CellType>;
-  using LineCellType = itk::LineCell<CellType>;
-  using TriangleCellType = itk::TriangleCell<CellType>;
-  using PolygonCellType = itk::PolygonCell<CellType>;
-  using TetrahedronCellType = itk::TetrahedronCell<CellType>;
-  using HexahedronCellType = itk::HexahedronCell<CellType>;
-  using QuadrilateralCellType = itk::QuadrilateralCell<CellType>;
-  using QuadraticEdgeCellType = itk::QuadraticEdgeCell<CellType>;
-  using QuadraticTriangleCellType = itk::QuadraticTriangleCell<CellType>;
-  using CellAutoPointer = typename MeshType::CellAutoPointer;
-  itk::SizeValueType index = itk::NumericTraits<itk::SizeValueType>::ZeroValue();
-  CellIdentifier id = itk::NumericTraits<CellIdentifier>::ZeroValue();
-  while (index < cellBufferSize)
+// Number of mesh cells of a cell buffer entry, after its type and number of
+// points are validated. Polylines are loaded as individual edges.
+template <typename TMesh>
+itk::SizeValueType
+validateCell(itk::CellGeometryEnum type, unsigned int cellPoints)
+{
+  using CellType = typename TMesh::CellType;
+  switch (type)
   {
-    auto type = static_cast<itk::CellGeometryEnum>(static_cast<int>(cellsBufferPtr[index++]));
-    switch (type)
-    {
-      case itk::CellGeometryEnum::VERTEX_CELL:
+    case itk::CellGeometryEnum::VERTEX_CELL:
+      if (cellPoints != itk::VertexCell<CellType>::NumberOfPoints)
       {
-        auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
-        if (cellPoints != VertexCellType::NumberOfPoints)
-        {
-          throw std::runtime_error("Invalid Vertex Cell number of points");
-        }
-        CellAutoPointer cell;
-        auto *                vertexCell = new VertexCellType;
-        for (unsigned int jj = 0; jj < VertexCellType::NumberOfPoints; ++jj)
-        {
-          vertexCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
-        }
-
-        cell.TakeOwnership(vertexCell);
-        mesh->SetCell(id++, cell);
-        break;
+        throw std::runtime_error("Invalid Vertex Cell number of points");
       }
-      case itk::CellGeometryEnum::LINE_CELL:
+      return 1;
+    case itk::CellGeometryEnum::LINE_CELL:
+      if (cellPoints < 2)
       {
-        // for polylines will be loaded as individual edges.
-        auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
-        if (cellPoints < 2)
-        {
-          throw std::runtime_error("Invalid Line Cell number of points");
-        }
-        auto pointIDBuffer = static_cast<PointIdentifier>(cellsBufferPtr[index++]);
-        for (unsigned int jj = 1; jj < cellPoints; ++jj)
-        {
-          CellAutoPointer cell;
-          auto *                lineCell = new LineCellType;
-          lineCell->SetPointId(0, pointIDBuffer);
-          pointIDBuffer = static_cast<PointIdentifier>(cellsBufferPtr[index++]);
-          lineCell->SetPointId(1, pointIDBuffer);
-          cell.TakeOwnership(lineCell);
-          mesh->SetCell(id++, cell);
-        }
-        break;
+        throw std::runtime_error("Invalid Line Cell number of points");
       }
-      case itk::CellGeometryEnum::TRIANGLE_CELL:
+      return cellPoints - 1;
+    case itk::CellGeometryEnum::TRIANGLE_CELL:
+      if (cellPoints != itk::TriangleCell<CellType>::NumberOfPoints)
       {
-        auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
-        if (cellPoints != TriangleCellType::NumberOfPoints)
-        {
-          throw std::runtime_error("Invalid Triangle Cell number of points");
-        }
-
-        CellAutoPointer cell;
-        auto *                triangleCell = new TriangleCellType;
-        for (unsigned int jj = 0; jj < TriangleCellType::NumberOfPoints; ++jj)
-        {
-          triangleCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
-        }
-
-        cell.TakeOwnership(triangleCell);
-        mesh->SetCell(id++, cell);
-        break;
+        throw std::runtime_error("Invalid Triangle Cell number of points");
       }
-      case itk::CellGeometryEnum::QUADRILATERAL_CELL:
+      return 1;
+    case itk::CellGeometryEnum::QUADRILATERAL_CELL:
+      if (cellPoints != itk::QuadrilateralCell<CellType>::NumberOfPoints)
       {
-        auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
-        if (cellPoints != QuadrilateralCellType::NumberOfPoints)
-        {
-          throw std::runtime_error("Invalid Quadrilateral Cell with number of points");
-        }
-
-        CellAutoPointer cell;
-        auto *                quadrilateralCell = new QuadrilateralCellType;
-        for (unsigned int jj = 0; jj < QuadrilateralCellType::NumberOfPoints; ++jj)
-        {
-          quadrilateralCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
-        }
-
-        cell.TakeOwnership(quadrilateralCell);
-        mesh->SetCell(id++, cell);
-        break;
+        throw std::runtime_error("Invalid Quadrilateral Cell with number of points");
       }
-      case itk::CellGeometryEnum::POLYGON_CELL:
+      return 1;
+    case itk::CellGeometryEnum::POLYGON_CELL:
+      return 1;
+    case itk::CellGeometryEnum::TETRAHEDRON_CELL:
+      if (cellPoints != itk::TetrahedronCell<CellType>::NumberOfPoints)
       {
-        // For polyhedron, if the number of points is 3, then we treat it as
-        // triangle cell
-        CellAutoPointer cell;
-        auto                  cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
-        if (cellPoints == TriangleCellType::NumberOfPoints)
-        {
-          auto * triangleCell = new TriangleCellType;
-          for (unsigned int jj = 0; jj < TriangleCellType::NumberOfPoints; ++jj)
-          {
-            triangleCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
-          }
-          cell.TakeOwnership(triangleCell);
-        }
-        else
-        {
-          auto * polygonCell = new PolygonCellType;
-          for (unsigned int jj = 0; jj < cellPoints; ++jj)
-          {
-            polygonCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
-          }
-          cell.TakeOwnership(polygonCell);
-        }
-
-        mesh->SetCell(id++, cell);
-        break;
+        throw std::runtime_error("Invalid Tetrahedron Cell number of points");
       }
-      case itk::CellGeometryEnum::TETRAHEDRON_CELL:
+      return 1;
+    case itk::CellGeometryEnum::HEXAHEDRON_CELL:
+      if (cellPoints != itk::HexahedronCell<CellType>::NumberOfPoints)
       {
-        auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
-        if (cellPoints != TetrahedronCellType::NumberOfPoints)
-        {
-          throw std::runtime_error("Invalid Tetrahedron Cell number of points");
-        }
-
-        CellAutoPointer cell;
-        auto *                tetrahedronCell = new TetrahedronCellType;
-        for (unsigned int jj = 0; jj < TetrahedronCellType::NumberOfPoints; ++jj)
-        {
-          tetrahedronCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
-        }
-
-        cell.TakeOwnership(tetrahedronCell);
-        mesh->SetCell(id++, cell);
-        break;
+        throw std::runtime_error("Invalid Hexahedron Cell number of points");
       }
-      case itk::CellGeometryEnum::HEXAHEDRON_CELL:
+      return 1;
+    case itk::CellGeometryEnum::QUADRATIC_EDGE_CELL:
+      if (cellPoints != itk::QuadraticEdgeCell<CellType>::NumberOfPoints)
       {
-        auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
-        if (cellPoints != HexahedronCellType::NumberOfPoints)
-        {
-          throw std::runtime_error("Invalid Hexahedron Cell number of points");
-        }
-
-        CellAutoPointer cell;
-        auto *                hexahedronCell = new HexahedronCellType;
-        for (unsigned int jj = 0; jj < HexahedronCellType::NumberOfPoints; ++jj)
-        {
-          hexahedronCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
-        }
+        throw std::runtime_error("Invalid Quadratic edge Cell number of points");
+      }
+      return 1;
+    case itk::CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
+      if (cellPoints != itk::QuadraticTriangleCell<CellType>::NumberOfPoints)
+      {
+        throw std::runtime_error("Invalid Quadratic triangle Cell number of points");
+      }
+      return 1;
+    default:
+      throw std::runtime_error("Unknown cell type");
+  }
+}
 
-        cell.TakeOwnership(hexahedronCell);
-        mesh->SetCell(id++, cell);
-        break;
+// Construct the mesh cells of a validated cell buffer entry at cells
+template <typename TMesh, typename TCellBufferType>
+void
+constructCells(itk::CellGeometryEnum type, unsigned int cellPoints, const TCellBufferType * pointIds, typename TMesh::CellType ** cells)
+{
+  using CellType = typename TMesh::CellType;
+  switch (type)
+  {
+    case itk::CellGeometryEnum::VERTEX_CELL:
+      *cells = newCell<itk::VertexCell<CellType>>(pointIds, cellPoints);
+      break;
+    case itk::CellGeometryEnum::LINE_CELL:
+      for (unsigned int jj = 1; jj < cellPoints; ++jj)
+      {
+        *cells++ = newCell<itk::LineCell<CellType>>(pointIds + jj - 1, 2);
       }
-      case itk::CellGeometryEnum::QUADRATIC_EDGE_CELL:
+      break;
+    case itk::CellGeometryEnum::TRIANGLE_CELL:
+      *cells = newCell<itk::TriangleCell<CellType>>(pointIds, cellPoints);
+      break;
+    case itk::CellGeometryEnum::QUADRILATERAL_CELL:
+      *cells = newCell<itk::QuadrilateralCell<CellType>>(pointIds, cellPoints);
+      break;
+    case itk::CellGeometryEnum::POLYGON_CELL:
+      // For polyhedron, if the number of points is 3, then we treat it as
+      // triangle cell
+      if (cellPoints == itk::TriangleCell<CellType>::NumberOfPoints)
       {
-        auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
-        if (cellPoints != QuadraticEdgeCellType::NumberOfPoints)
-        {
-          throw std::runtime_error("Invalid Quadratic edge Cell number of points");
-        }
+        *cells = newCell<itk::TriangleCell<CellType>>(pointIds, cellPoints);
+      }
+      else
+      {
+        *cells = newCell<itk::PolygonCell<CellType>>(pointIds, cellPoints);
+      }
+      break;
+    case itk::CellGeometryEnum::TETRAHEDRON_CELL:
+      *cells = newCell<itk::TetrahedronCell<CellType>>(pointIds, cellPoints);
+      break;
+    case itk::CellGeometryEnum::HEXAHEDRON_CELL:
+      *cells = newCell<itk::HexahedronCell<CellType>>(pointIds, cellPoints);
+      break;
+    case itk::CellGeometryEnum::QUADRATIC_EDGE_CELL:
+      *cells = newCell<itk::QuadraticEdgeCell<CellType>>(pointIds, cellPoints);
+      break;
+    case itk::CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
+      *cells = newCell<itk::QuadraticTriangleCell<CellType>>(pointIds, cellPoints);
+      break;
+    default:
+      break;
+  }
+}
 
-        CellAutoPointer cell;
-        auto *                quadraticEdgeCell = new QuadraticEdgeCellType;
-        for (unsigned int jj = 0; jj < QuadraticEdgeCellType::NumberOfPoints; ++jj)
-        {
-          quadraticEdgeCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
-        }
+// The cell buffer is validated and indexed in a first pass, so the cells
+// container is sized once and the cells are constructed in parallel.
+template<typename TMesh, typename TCellBufferType>
+void
+populateCells(TMesh * mesh, itk::SizeValueType cellBufferSize, TCellBufferType * cellsBufferPtr)
+{
+  using MeshType = TMesh;
+  using CellType = typename MeshType::CellType;
+  using CellAutoPointer = typename MeshType::CellAutoPointer;
+
+  itk::SizeValueType numberOfEntries = itk::NumericTraits<itk::SizeValueType>::ZeroValue();
+  itk::SizeValueType numberOfCells = itk::NumericTraits<itk::SizeValueType>::ZeroValue();
 
-        cell.TakeOwnership(quadraticEdgeCell);
-        mesh->SetCell(id++, cell);
-        break;
+  // Buffers of a single cell type and number of points, e.g. triangle
+  // surfaces or tetrahedral volumes, have a fixed stride and are not indexed
+  itk::SizeValueType stride = itk::NumericTraits<itk::SizeValueType>::ZeroValue();
+  itk::SizeValueType cellsPerEntry = itk::NumericTraits<itk::SizeValueType>::ZeroValue();
+  if (cellBufferSize >= 2 && cellsBufferPtr[1] <= cellBufferSize - 2 && cellBufferSize % (2 + cellsBufferPtr[1]) == 0)
+  {
+    const itk::SizeValueType candidateStride = 2 + cellsBufferPtr[1];
+    bool homogeneous = true;
+    for (itk::SizeValueType offset = candidateStride; homogeneous && offset < cellBufferSize; offset += candidateStride)
+    {
+      homogeneous = cellsBufferPtr[offset] == cellsBufferPtr[0] && cellsBufferPtr[offset + 1] == cellsBufferPtr[1];
+    }
+    if (homogeneous)
+    {
+      stride = candidateStride;
+      cellsPerEntry = validateCell<MeshType>(static_cast<itk::CellGeometryEnum>(static_cast<int>(cellsBufferPtr[0])),
+                                             static_cast<unsigned int>(cellsBufferPtr[1]));
+      numberOfEntries = cellBufferSize / stride;
+      numberOfCells = numberOfEntries * cellsPerEntry;
+    }
+  }
+
+  // Otherwise, the offset in the cell buffer and first mesh cell id of each entry
+  struct Entry
+  {
+    itk::SizeValueType offset;
+    itk::SizeValueType firstCell;
+  };
+  std::vector<Entry> entries;
+  if (stride == 0)
+  {
+    itk::SizeValueType index = itk::NumericTraits<itk::SizeValueType>::ZeroValue();
+    while (index < cellBufferSize)
+    {
+      if (cellBufferSize - index < 2)
+      {
+        throw std::runtime_error("Truncated cell buffer");
       }
-      case itk::CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
+      const auto type = static_cast<itk::CellGeometryEnum>(static_cast<int>(cellsBufferPtr[index]));
+      const auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index + 1]);
+      if (cellBufferSize - index - 2 < cellPoints)
       {
-        auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
-        if (cellPoints != QuadraticTriangleCellType::NumberOfPoints)
-        {
-          throw std::runtime_error("Invalid Quadratic triangle Cell number of points");
-        }
-
-        CellAutoPointer cell;
-        auto *                quadraticTriangleCell = new QuadraticTriangleCellType;
-        for (unsigned int jj = 0; jj < QuadraticTriangleCellType::NumberOfPoints; ++jj)
-        {
-          quadraticTriangleCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
-        }
+        throw std::runtime_error("Truncated cell buffer");
+      }
+      entries.push_back({ index, numberOfCells });
+      numberOfCells += validateCell<MeshType>(type, cellPoints);
+      index += 2 + cellPoints;
+    }
+    numberOfEntries = entries.size();
+  }
 
-        cell.TakeOwnership(quadraticTriangleCell);
-        mesh->SetCell(id++, cell);
-        break;
+  std::vector<CellType *> cells(numberOfCells, nullptr);
+  std::exception_ptr constructionException;
+  std::mutex constructionExceptionMutex;
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfEntries,
+    [&](itk::SizeValueType ii) {
+      try
+      {
+        const TCellBufferType * entry = cellsBufferPtr + (stride ? ii * stride : entries[ii].offset);
+        constructCells<MeshType>(static_cast<itk::CellGeometryEnum>(static_cast<int>(entry[0])),
+                                 static_cast<unsigned int>(entry[1]),
+                                 entry + 2,
+                                 cells.data() + (stride ? ii * cellsPerEntry : entries[ii].firstCell));
       }
-      default:
+      catch (...)
       {
-        throw std::runtime_error("Unknown cell type");
+        const std::lock_guard<std::mutex> lock(constructionExceptionMutex);
+        if (!constructionException)
+        {
+          constructionException = std::current_exception();
+        }
       }
+    },
+    nullptr);
+  if (constructionException)
+  {
+    for (CellType * cell : cells)
+    {
+      delete cell;
     }
+    std::rethrow_exception(constructionException);
+  }
+
+  if (!mesh->GetCells())
+  {
+    mesh->SetCells(MeshType::CellsContainer::New());
+  }
+  mesh->GetCells()->Reserve(numberOfCells);
+  for (itk::SizeValueType id = 0; id < numberOfCells; ++id)
+  {
+    CellAutoPointer cell;
+    cell.TakeOwnership(cells[id]);
+    mesh->SetCell(static_cast<typename MeshType::CellIdentifier>(id), cell);
   }
 }
 
@@ -359,9 +388,10 @@ void
 WasmMeshToMeshFilter<TMesh>
 ::GenerateData()
 {
+  ITK_WASM_TRACE_SCOPE("WasmMeshToMeshFilter::GenerateData");
+
   // Get the input and output pointers
   const WasmMeshType * meshJSON = this->GetInput();
-  const std::string json(meshJSON->GetJSON());
   MeshType * mesh = this->GetOutput();
 
   using PointPixelType = typename MeshType::PixelType;
@@ -369,24 +399,29 @@ WasmMeshToMeshFilter<TMesh>
   using CellPixelType = typename MeshType::CellPixelType;
   using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
 
-  rapidjson::Document document;
-  if (document.Parse(json.c_str()).HasParseError())
+  rapidjson::Document parsedDocument;
+  if (!this->m_JSONDocument)
     {
-    throw std::runtime_error("Could not parse JSON");
+    const std::string json(meshJSON->GetJSON());
+    if (parsedDocument.Parse(json.c_str()).HasParseError())
+      {
+      throw std::runtime_error("Could not parse JSON");
+      }
     }
+  const rapidjson::Value & document = this->m_JSONDocument ? static_cast< const rapidjson::Value & >(*this->m_JSONDocument) : static_cast< const rapidjson::Value & >(parsedDocument);
 
   const rapidjson::Value & meshType = document["meshType"];
 
   const rapidjson::Value & numberOfPointsJson = document["numberOfPoints"];
-  const SizeValueType numberOfPoints = numberOfPointsJson.GetInt();
+  const SizeValueType numberOfPoints = numberOfPointsJson.GetUint64();
 
   const rapidjson::Value & numberOfPointPixelsJson = document["numberOfPointPixels"];
-  const SizeValueType numberOfPointPixels = numberOfPointPixelsJson.GetInt();
+  const SizeValueType numberOfPointPixels = numberOfPointPixelsJson.GetUint64();
   // const rapidjson::Value & pointPixelComponentsJson = meshType["pointPixelComponents"];
   // const SizeValueType pointPixelComponents = pointPixelComponentsJson.GetInt();
 
   const rapidjson::Value & numberOfCellPixelsJson = document["numberOfCellPixels"];
-  const SizeValueType numberOfCellPixels = numberOfCellPixelsJson.GetInt();
+  const SizeValueType numberOfCellPixels = numberOfCellPixelsJson.GetUint64();
   // const rapidjson::Value & cellPixelComponentsJson = meshType["cellPixelComponents"];
   // const SizeValueType cellPixelComponents = cellPixelComponentsJson.GetInt();
 
@@ -430,6 +465,7 @@ WasmMeshToMeshFilter<TMesh>
     {
       const auto * pointsPtr = reinterpret_cast< PointType * >( std::strtoull(pointsString.substr(35).c_str(), nullptr, 10) );
       mesh->GetPoints()->assign(pointsPtr, pointsPtr + numberOfPoints);
+      ITK_WASM_COUNT_COPY(InputStore, numberOfPoints * sizeof(PointType));
     }
     else if (pointComponentType == itk::wasm::MapComponentType<float>::ComponentString)
     {
@@ -437,6 +473,7 @@ WasmMeshToMeshFilter<TMesh>
       const size_t pointComponents = numberOfPoints * dimension;
       auto * pointsContainerPtr = reinterpret_cast<typename MeshType::CoordRepType *>(&(mesh->GetPoints()->at(0)) );
       std::copy(pointsPtr, pointsPtr + pointComponents, pointsContainerPtr);
+      ITK_WASM_COUNT_COPY(InputStore, pointComponents * sizeof(*pointsPtr));
     }
     else if (pointComponentType == itk::wasm::MapComponentType<double>::ComponentString)
     {
@@ -444,6 +481,7 @@ WasmMeshToMeshFilter<TMesh>
       const size_t pointComponents = numberOfPoints * dimension;
       auto * pointsContainerPtr = reinterpret_cast<typename MeshType::CoordRepType *>(&(mesh->GetPoints()->at(0)) );
       std::copy(pointsPtr, pointsPtr + pointComponents, pointsContainerPtr);
+      ITK_WASM_COUNT_COPY(InputStore, pointComponents * sizeof(*pointsPtr));
     }
     else
     {
@@ -453,7 +491,7 @@ WasmMeshToMeshFilter<TMesh>
 
 
   const rapidjson::Value & cellBufferSizeJson = document["cellBufferSize"];
-  const SizeValueType cellBufferSize = cellBufferSizeJson.GetInt();
+  const SizeValueType cellBufferSize = cellBufferSizeJson.GetUint64();
   const rapidjson::Value & cellsJson = document["cells"];
   const std::string cellsString( cellsJson.GetString() );
   using CellBufferType = typename WasmMeshType::CellBufferContainerType::Element;
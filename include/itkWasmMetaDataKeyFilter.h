@@ -0,0 +1,103 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmMetaDataKeyFilter_h
+#define itkWasmMetaDataKeyFilter_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkMetaDataDictionary.h"
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/**
+ *\class MetaDataKeyFilter
+ * \brief Select the MetaDataDictionary entries that cross an IO boundary
+ *
+ * Patterns are globs over the whole key: `*` matches any run of
+ * characters, `?` matches one character, and other characters match
+ * themselves. A key prefix is the pattern `prefix*`, e.g. `0010|*` for the
+ * DICOM patient group.
+ *
+ * A key is accepted if it matches an include pattern, or if there are no
+ * include patterns, and it matches no exclude pattern. Without patterns,
+ * every key is accepted.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT MetaDataKeyFilter
+{
+public:
+  void
+  SetIncludePatterns(std::vector<std::string> patterns)
+  {
+    m_IncludePatterns = std::move(patterns);
+  }
+  const std::vector<std::string> &
+  GetIncludePatterns() const
+  {
+    return m_IncludePatterns;
+  }
+
+  void
+  SetExcludePatterns(std::vector<std::string> patterns)
+  {
+    m_ExcludePatterns = std::move(patterns);
+  }
+  const std::vector<std::string> &
+  GetExcludePatterns() const
+  {
+    return m_ExcludePatterns;
+  }
+
+  /** Whether any pattern is set, so some keys may be rejected. */
+  bool
+  IsEnabled() const
+  {
+    return !m_IncludePatterns.empty() || !m_ExcludePatterns.empty();
+  }
+
+  bool
+  Accepts(std::string_view key) const;
+
+  /** Erase the entries whose key is not accepted, e.g. of an image read or
+   * written with an ImageIO. */
+  void
+  Apply(MetaDataDictionary & dictionary) const;
+
+  /** Whether the glob pattern matches the whole key. */
+  static bool
+  Matches(std::string_view pattern, std::string_view key);
+
+private:
+  std::vector<std::string> m_IncludePatterns;
+  std::vector<std::string> m_ExcludePatterns;
+};
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,207 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmPayloadFilter_h
+#define itkWasmPayloadFilter_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkWasmCBORSink.h"
+#include "cbor.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace itk
+{
+namespace wasm
+{
+
+/** Transposition of the bytes of a block of elements. */
+enum class PayloadShuffle : uint8_t
+{
+  None,
+  /** Group the bytes of the elements by significance, as Blosc shuffle. */
+  Byte,
+  /** Group the bits of the elements by significance, as Blosc bitshuffle. */
+  Bit
+};
+
+/** Lossless image codec of a typed array payload. */
+enum class PayloadCodec : uint8_t
+{
+  None,
+  /** High-throughput JPEG 2000, resolution scalable. */
+  HTJ2K,
+  /** JPEG XL, in its lossless modular mode. */
+  JPEGXL
+};
+
+/** Default bytes per shuffled block. */
+constexpr size_t DefaultPayloadFilterBlockSize = 256 * 1024;
+
+/** Reversible filters of a typed array payload, applied before compression.
+ *
+ * Delta replaces each component with its difference from the same component
+ * of the previous element in its row, in the unsigned integer arithmetic of
+ * the component size. The shuffle is then applied to independent blocks of
+ * blockSize bytes, so blocks can be filtered and reversed in parallel.
+ *
+ * Run length replaces the payload with runs of equal elements, each a
+ * little endian uint32 count followed by the element, e.g. for label maps
+ * that are mostly background. It changes the payload size, and is not
+ * combined with the other filters.
+ *
+ * A codec replaces the payload with a lossless encoding of its planes of 8
+ * or 16 bit integer components. The codecs are implemented by image IOs
+ * outside of the core, e.g. WasmZstdImageIO of the image-io package, and a
+ * codec is not combined with the other filters. */
+struct PayloadFilters
+{
+  bool delta{ false };
+  PayloadShuffle shuffle{ PayloadShuffle::None };
+  bool runLength{ false };
+  PayloadCodec codec{ PayloadCodec::None };
+  size_t blockSize{ DefaultPayloadFilterBlockSize };
+
+  bool
+  IsEnabled() const
+  {
+    return delta || shuffle != PayloadShuffle::None || runLength || codec != PayloadCodec::None;
+  }
+};
+
+/** Name of a codec in the payloadFilters entry: "htj2k" or "jpegxl". */
+WebAssemblyInterface_EXPORT const char *
+GetPayloadCodecName(PayloadCodec codec);
+
+/** Element layout of a typed array payload. */
+struct PayloadLayout
+{
+  /** Bytes per component: 1, 2, 4 or 8. */
+  size_t componentSize{ 1 };
+  /** Components per element, the stride of the delta. */
+  size_t components{ 1 };
+  /** Components per row, e.g. size[0] times the components of an image. */
+  uint64_t rowLength{ 1 };
+};
+
+/** Filters suited to a component size: byte shuffle for multi-byte
+ * components. */
+WebAssemblyInterface_EXPORT PayloadFilters
+AutomaticPayloadFilters(size_t componentSize);
+
+/** Throws a std::runtime_error if the filters cannot be applied to the layout. */
+WebAssemblyInterface_EXPORT void
+ValidatePayloadFilters(const PayloadFilters & filters, const PayloadLayout & layout);
+
+/** Filter size bytes of the payload, starting at offset, into output. The
+ * offset is a multiple of the block size, and size is the block size except
+ * for the last block. scratch is reused between calls. */
+WebAssemblyInterface_EXPORT void
+EncodePayloadBlock(const PayloadFilters & filters,
+                   const PayloadLayout & layout,
+                   const void * payload,
+                   uint64_t offset,
+                   size_t size,
+                   void * output,
+                   std::vector<unsigned char> & scratch);
+
+/** Reverse the shuffle of one block in place. */
+WebAssemblyInterface_EXPORT void
+DecodePayloadBlock(const PayloadFilters & filters,
+                   const PayloadLayout & layout,
+                   void * block,
+                   size_t size,
+                   std::vector<unsigned char> & scratch);
+
+/** Reverse the delta of numberOfRows rows, starting at firstRow, in place,
+ * after the blocks are decoded. */
+WebAssemblyInterface_EXPORT void
+DecodePayloadRows(const PayloadFilters & filters,
+                  const PayloadLayout & layout,
+                  void * payload,
+                  uint64_t firstRow,
+                  uint64_t numberOfRows);
+
+/** Reverse the filters of a whole payload of size bytes in place. */
+WebAssemblyInterface_EXPORT void
+DecodePayload(const PayloadFilters & filters, const PayloadLayout & layout, void * payload, uint64_t size);
+
+/** Number of bytes of the run-length encoding of size bytes of the payload. */
+WebAssemblyInterface_EXPORT uint64_t
+GetPayloadRunsSize(const PayloadLayout & layout, const void * payload, uint64_t size);
+
+/** Write the run-length encoding of size bytes of the payload as the content
+ * of a byte string of GetPayloadRunsSize bytes, whose head is written by the
+ * caller. */
+WebAssemblyInterface_EXPORT void
+EncodePayloadRuns(CBORSink & sink, const PayloadLayout & layout, const void * payload, uint64_t size);
+
+/**
+ *\class PayloadRunDecoder
+ * \brief Decode a run-length encoded payload in pieces
+ *
+ * The encoded bytes are passed as they are read, in pieces of any size, and
+ * runs are filled directly into the output payload.
+ */
+class WebAssemblyInterface_EXPORT PayloadRunDecoder
+{
+public:
+  PayloadRunDecoder(const PayloadLayout & layout, void * payload, uint64_t size);
+
+  /** Decode the next size bytes of the encoding. Returns false if the runs
+   * overflow the payload. */
+  bool
+  Decode(const void * encoded, size_t size);
+
+  /** Whether the runs filled the payload, and ended with a whole run. */
+  bool
+  IsComplete() const
+  {
+    return m_Offset == m_Size && m_Pending == 0;
+  }
+
+private:
+  bool
+  FillRun(const unsigned char * run);
+
+  unsigned char * m_Payload;
+  uint64_t m_Size;
+  uint64_t m_Offset{ 0 };
+  size_t m_ElementSize;
+  // The count and element of the run being read
+  std::vector<unsigned char> m_Run;
+  size_t m_Pending{ 0 };
+};
+
+/** Write the filters as the value of a payloadFilters map entry:
+ * { "filters": ["delta", "shuffle"], "blockSize": 262144 }, with a
+ * "codec": "htj2k" entry when a codec is set. */
+WebAssemblyInterface_EXPORT void
+WritePayloadFilters(CBORSink & sink, const PayloadFilters & filters);
+
+/** Parse the value of a payloadFilters map entry. Throws a
+ * std::runtime_error on unknown filters or codecs. */
+WebAssemblyInterface_EXPORT PayloadFilters
+ReadPayloadFilters(const cbor_item_t * item);
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,103 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmPlanarLayout_h
+#define itkWasmPlanarLayout_h
+
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/** Number of pixels transposed together by one work unit of
+ * InterleaveComponents and PlanarizeComponents. Each component plane of a
+ * block is read or written contiguously. */
+constexpr SizeValueType PlanarLayoutBlockSize = 4096;
+
+/** Interleave the components of numberOfPixels pixels, stored as
+ * numberOfComponents planes (channel-first), into pixel-major order. The
+ * blocks of pixels are split across the threads of the threader. The
+ * buffers must not overlap. */
+template <typename TComponent>
+void
+InterleaveComponents(const TComponent * planar,
+                     SizeValueType numberOfPixels,
+                     unsigned int numberOfComponents,
+                     TComponent * interleaved,
+                     MultiThreaderBase * threader,
+                     ProcessObject * filter = nullptr)
+{
+  const SizeValueType numberOfBlocks = (numberOfPixels + PlanarLayoutBlockSize - 1) / PlanarLayoutBlockSize;
+  threader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [=](SizeValueType block) {
+      const SizeValueType begin = block * PlanarLayoutBlockSize;
+      const SizeValueType end = std::min(begin + PlanarLayoutBlockSize, numberOfPixels);
+      for (unsigned int component = 0; component < numberOfComponents; ++component)
+      {
+        const TComponent * plane = planar + component * numberOfPixels;
+        TComponent * destination = interleaved + component;
+        for (SizeValueType pixel = begin; pixel < end; ++pixel)
+        {
+          destination[pixel * numberOfComponents] = plane[pixel];
+        }
+      }
+    },
+    filter);
+}
+
+/** Inverse of InterleaveComponents: store the components of pixel-major
+ * pixels as numberOfComponents planes. */
+template <typename TComponent>
+void
+PlanarizeComponents(const TComponent * interleaved,
+                    SizeValueType numberOfPixels,
+                    unsigned int numberOfComponents,
+                    TComponent * planar,
+                    MultiThreaderBase * threader,
+                    ProcessObject * filter = nullptr)
+{
+  const SizeValueType numberOfBlocks = (numberOfPixels + PlanarLayoutBlockSize - 1) / PlanarLayoutBlockSize;
+  threader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [=](SizeValueType block) {
+      const SizeValueType begin = block * PlanarLayoutBlockSize;
+      const SizeValueType end = std::min(begin + PlanarLayoutBlockSize, numberOfPixels);
+      for (unsigned int component = 0; component < numberOfComponents; ++component)
+      {
+        TComponent * plane = planar + component * numberOfPixels;
+        const TComponent * source = interleaved + component;
+        for (SizeValueType pixel = begin; pixel < end; ++pixel)
+        {
+          plane[pixel] = source[pixel * numberOfComponents];
+        }
+      }
+    },
+    filter);
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,133 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmPointSetToPointSetFilter_h
+#define itkWasmPointSetToPointSetFilter_h
+
+#include "itkProcessObject.h"
+#include "itkWasmPointSet.h"
+
+#include "rapidjson/document.h"
+
+#include <memory>
+
+namespace itk
+{
+/**
+ *\class WasmPointSetToPointSetFilter
+ * \brief Convert an WasmPointSet to an PointSet object.
+ *
+ * TPointSet must match the type stored in the JSON representation or an exception will be shown.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+template <typename TPointSet>
+class ITK_TEMPLATE_EXPORT WasmPointSetToPointSetFilter : public ProcessObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WasmPointSetToPointSetFilter);
+
+  /** Standard class type aliases. */
+  using Self = WasmPointSetToPointSetFilter;
+  using Superclass = ProcessObject;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WasmPointSetToPointSetFilter, ProcessObject);
+
+  using DataObjectIdentifierType = Superclass::DataObjectIdentifierType;
+  using DataObjectPointerArraySizeType = Superclass::DataObjectPointerArraySizeType;
+
+  using PointSetType = TPointSet;
+  using WasmPointSetType = WasmPointSet<PointSetType>;
+
+  /** Set/Get the path input of this process object.  */
+  using Superclass::SetInput;
+  virtual void
+  SetInput(const WasmPointSetType * pointSet);
+
+  virtual void
+  SetInput(unsigned int, const WasmPointSetType * pointSet);
+
+  const WasmPointSetType *
+  GetInput();
+
+  const WasmPointSetType *
+  GetInput(unsigned int idx);
+
+  PointSetType *
+  GetOutput();
+  const PointSetType *
+  GetOutput() const;
+
+  PointSetType *
+  GetOutput(unsigned int idx);
+
+  /** Release the points and point data arrays from the memory IO input array
+   * store of session MemoryIndex once they are in the output containers,
+   * instead of keeping them until the end of the run. Default: false. */
+  itkSetMacro(InputArrayHandoff, bool);
+  itkGetConstMacro(InputArrayHandoff, bool);
+  itkBooleanMacro(InputArrayHandoff);
+
+  /** Memory IO store session used with InputArrayHandoff. */
+  itkSetMacro(MemoryIndex, uint32_t);
+  itkGetConstMacro(MemoryIndex, uint32_t);
+
+  /** Use an already parsed JSON representation of the input instead of
+   * parsing the input JSON again. */
+  void SetJSONDocument(std::shared_ptr<const rapidjson::Document> document)
+  {
+    this->m_JSONDocument = std::move(document);
+    this->Modified();
+  }
+
+protected:
+  WasmPointSetToPointSetFilter();
+  ~WasmPointSetToPointSetFilter() override = default;
+
+  ProcessObject::DataObjectPointer
+  MakeOutput(ProcessObject::DataObjectPointerArraySizeType idx) override;
+  ProcessObject::DataObjectPointer
+  MakeOutput(const ProcessObject::DataObjectIdentifierType &) override;
+
+  void
+  GenerateOutputInformation() override
+  {} // do nothing
+  void
+  GenerateData() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  std::shared_ptr<const rapidjson::Document> m_JSONDocument;
+
+  bool m_InputArrayHandoff{false};
+
+  uint32_t m_MemoryIndex{0};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkWasmPointSetToPointSetFilter.hxx"
+#endif
+
+#endif
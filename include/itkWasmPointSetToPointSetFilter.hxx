@@ -0,0 +1,260 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmPointSetToPointSetFilter_hxx
+#define itkWasmPointSetToPointSetFilter_hxx
+
+#include "itkWasmPointSetToPointSetFilter.h"
+
+#include <algorithm>
+#include <exception>
+#include "itkWasmMapComponentType.h"
+#include "itkWasmMapPixelType.h"
+#include "itkWasmTrace.h"
+#include "itkWasmAllocationStats.h"
+#include "itkMeshConvertPixelTraits.h"
+
+#ifndef ITK_WASM_NO_MEMORY_IO
+#include "itkWasmExports.h"
+#endif
+
+#include "rapidjson/document.h"
+
+namespace itk
+{
+
+template <typename TPointSet>
+WasmPointSetToPointSetFilter<TPointSet>
+::WasmPointSetToPointSetFilter()
+{
+  this->SetNumberOfRequiredInputs(1);
+
+  typename PointSetType::Pointer output = static_cast<PointSetType *>(this->MakeOutput(0).GetPointer());
+  this->ProcessObject::SetNumberOfRequiredOutputs(1);
+  this->ProcessObject::SetNthOutput(0, output.GetPointer());
+}
+
+template <typename TPointSet>
+ProcessObject::DataObjectPointer
+WasmPointSetToPointSetFilter<TPointSet>
+::MakeOutput(ProcessObject::DataObjectPointerArraySizeType)
+{
+  return PointSetType::New().GetPointer();
+}
+
+template <typename TPointSet>
+ProcessObject::DataObjectPointer
+WasmPointSetToPointSetFilter<TPointSet>
+::MakeOutput(const ProcessObject::DataObjectIdentifierType &)
+{
+  return PointSetType::New().GetPointer();
+}
+
+template <typename TPointSet>
+auto
+WasmPointSetToPointSetFilter<TPointSet>
+::GetOutput() -> PointSetType *
+{
+  // we assume that the first output is of the templated type
+  return itkDynamicCastInDebugMode<PointSetType *>(this->GetPrimaryOutput());
+}
+
+template <typename TPointSet>
+auto
+WasmPointSetToPointSetFilter<TPointSet>
+::GetOutput() const -> const PointSetType *
+{
+  // we assume that the first output is of the templated type
+  return itkDynamicCastInDebugMode<const PointSetType *>(this->GetPrimaryOutput());
+}
+
+template <typename TPointSet>
+auto
+WasmPointSetToPointSetFilter<TPointSet>
+::GetOutput(unsigned int idx) -> PointSetType *
+{
+  auto * out = dynamic_cast<PointSetType *>(this->ProcessObject::GetOutput(idx));
+
+  if (out == nullptr && this->ProcessObject::GetOutput(idx) != nullptr)
+  {
+    itkWarningMacro(<< "Unable to convert output number " << idx << " to type " << typeid(PointSetType).name());
+  }
+  return out;
+}
+
+template <typename TPointSet>
+void
+WasmPointSetToPointSetFilter<TPointSet>
+::SetInput(const WasmPointSetType * input)
+{
+  // Process object is not const-correct so the const_cast is required here
+  this->ProcessObject::SetNthInput(0, const_cast<WasmPointSetType *>(input));
+}
+
+template <typename TPointSet>
+void
+WasmPointSetToPointSetFilter<TPointSet>
+::SetInput(unsigned int index, const WasmPointSetType * pointSet)
+{
+  // Process object is not const-correct so the const_cast is required here
+  this->ProcessObject::SetNthInput(index, const_cast<WasmPointSetType *>(pointSet));
+}
+
+template <typename TPointSet>
+const typename WasmPointSetToPointSetFilter<TPointSet>::WasmPointSetType *
+WasmPointSetToPointSetFilter<TPointSet>
+::GetInput()
+{
+  return itkDynamicCastInDebugMode<const WasmPointSetType *>(this->GetPrimaryInput());
+}
+
+template <typename TPointSet>
+const typename WasmPointSetToPointSetFilter<TPointSet>::WasmPointSetType *
+WasmPointSetToPointSetFilter<TPointSet>
+::GetInput(unsigned int idx)
+{
+  return itkDynamicCastInDebugMode<const WasmPointSetType *>(this->ProcessObject::GetInput(idx));
+}
+
+template <typename TPointSet>
+void
+WasmPointSetToPointSetFilter<TPointSet>
+::GenerateData()
+{
+  ITK_WASM_TRACE_SCOPE("WasmPointSetToPointSetFilter::GenerateData");
+
+  // Get the input and output pointers
+  const WasmPointSetType * pointSetJSON = this->GetInput();
+  PointSetType * pointSet = this->GetOutput();
+
+  using PointPixelType = typename PointSetType::PixelType;
+  using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
+
+  rapidjson::Document parsedDocument;
+  if (!this->m_JSONDocument)
+    {
+    const std::string json(pointSetJSON->GetJSON());
+    if (parsedDocument.Parse(json.c_str()).HasParseError())
+      {
+      throw std::runtime_error("Could not parse JSON");
+      }
+    }
+  const rapidjson::Value & document = this->m_JSONDocument ? static_cast< const rapidjson::Value & >(*this->m_JSONDocument) : static_cast< const rapidjson::Value & >(parsedDocument);
+
+  const rapidjson::Value & pointSetType = document["pointSetType"];
+
+  const SizeValueType numberOfPoints = document["numberOfPoints"].GetUint64();
+  const SizeValueType numberOfPointPixels = document["numberOfPointPixels"].GetUint64();
+
+  const int dimension = pointSetType["dimension"].GetInt();
+  if (dimension != PointSetType::PointDimension)
+  {
+    throw std::runtime_error("Unexpected dimension");
+  }
+  const std::string pointPixelComponentType( pointSetType["pointPixelComponentType"].GetString() );
+  if (numberOfPointPixels && pointPixelComponentType != itk::wasm::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::ComponentString )
+  {
+    throw std::runtime_error("Unexpected point pixel component type");
+  }
+
+  const std::string pointPixelType( pointSetType["pointPixelType"].GetString() );
+  if (numberOfPointPixels && pointPixelType != itk::wasm::MapPixelType<PointPixelType>::PixelString )
+  {
+    throw std::runtime_error("Unexpected point pixel type");
+  }
+
+  // Points and point data are moved into the containers with one bulk copy
+  // each, as there are no cells to build
+  using PointType = typename PointSetType::PointType;
+  using CoordRepType = typename PointSetType::CoordRepType;
+  const std::string pointsString( document["points"].GetString() );
+  const std::string pointComponentType( pointSetType["pointComponentType"].GetString() );
+  const size_t pointsAddress = std::strtoull(pointsString.substr(35).c_str(), nullptr, 10);
+  if (pointSet->GetPoints() == nullptr)
+  {
+    pointSet->SetPoints(PointSetType::PointsContainer::New());
+  }
+  auto & points = *pointSet->GetPoints();
+  if (numberOfPoints)
+  {
+    if (pointComponentType == itk::wasm::MapComponentType<CoordRepType>::ComponentString )
+    {
+      const auto * pointsPtr = reinterpret_cast< const PointType * >( pointsAddress );
+      points.assign(pointsPtr, pointsPtr + numberOfPoints);
+      ITK_WASM_COUNT_COPY(InputStore, numberOfPoints * sizeof(PointType));
+    }
+    else if (pointComponentType == itk::wasm::MapComponentType<float>::ComponentString)
+    {
+      const auto * pointsPtr = reinterpret_cast< const float * >( pointsAddress );
+      const size_t pointComponents = numberOfPoints * dimension;
+      points.resize(numberOfPoints);
+      std::copy(pointsPtr, pointsPtr + pointComponents, reinterpret_cast< CoordRepType * >( &(points.at(0)) ));
+      ITK_WASM_COUNT_COPY(InputStore, pointComponents * sizeof(*pointsPtr));
+    }
+    else if (pointComponentType == itk::wasm::MapComponentType<double>::ComponentString)
+    {
+      const auto * pointsPtr = reinterpret_cast< const double * >( pointsAddress );
+      const size_t pointComponents = numberOfPoints * dimension;
+      points.resize(numberOfPoints);
+      std::copy(pointsPtr, pointsPtr + pointComponents, reinterpret_cast< CoordRepType * >( &(points.at(0)) ));
+      ITK_WASM_COUNT_COPY(InputStore, pointComponents * sizeof(*pointsPtr));
+    }
+    else
+    {
+      throw std::runtime_error("Unexpected point component type");
+    }
+  }
+
+  const std::string pointDataString( document["pointData"].GetString() );
+  const size_t pointDataAddress = std::strtoull(pointDataString.substr(35).c_str(), nullptr, 10);
+  if (pointSet->GetPointData() == nullptr)
+  {
+    pointSet->SetPointData(PointSetType::PointDataContainer::New());
+  }
+  if (numberOfPointPixels)
+  {
+    const auto * pointDataPtr = reinterpret_cast< const PointPixelType * >( pointDataAddress );
+    pointSet->GetPointData()->assign(pointDataPtr, pointDataPtr + numberOfPointPixels);
+    ITK_WASM_COUNT_COPY(InputStore, numberOfPointPixels * sizeof(PointPixelType));
+  }
+
+#ifndef ITK_WASM_NO_MEMORY_IO
+  if (this->m_InputArrayHandoff)
+  {
+    wasm::InputArrayStoreValueType released;
+    for (const size_t address : { pointsAddress, pointDataAddress })
+    {
+      if (address != 0 && wasm::takeMemoryStoreInputArray(this->m_MemoryIndex, address, released))
+      {
+        released.clear();
+        released.shrink_to_fit();
+      }
+    }
+  }
+#endif
+}
+
+template <typename TPointSet>
+void
+WasmPointSetToPointSetFilter<TPointSet>
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+}
+} // end namespace itk
+
+#endif
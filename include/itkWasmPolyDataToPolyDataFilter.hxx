@@ -34,6 +34,7 @@
 #include <exception>
 #include "itkWasmMapComponentType.h"
 #include "itkWasmMapPixelType.h"
+#include "itkWasmTrace.h"
 #include "itkMeshConvertPixelTraits.h"
 
 #include "rapidjson/document.h"
@@ -139,6 +140,8 @@ void
 WasmPolyDataToPolyDataFilter<TPolyData>
 ::GenerateData()
 {
+  ITK_WASM_TRACE_SCOPE("WasmPolyDataToPolyDataFilter::GenerateData");
+
   // Get the input and output pointers
   const WasmPolyDataType * polyDataJSON = this->GetInput();
   const std::string json(polyDataJSON->GetJSON());
@@ -182,63 +185,60 @@ WasmPolyDataToPolyDataFilter<TPolyData>
   }
 
   const rapidjson::Value & numberOfPointsJson = document["numberOfPoints"];
-  const SizeValueType numberOfPoints = numberOfPointsJson.GetInt();
+  const SizeValueType numberOfPoints = numberOfPointsJson.GetUint64();
   if (numberOfPoints)
   {
     using PointType = typename PolyDataType::PointType;
     const rapidjson::Value & pointsJson = document["points"];
     const std::string pointsString( pointsJson.GetString() );
     const auto * pointsPtr = reinterpret_cast< PointType * >( std::strtoull(pointsString.substr(35).c_str(), nullptr, 10) );
-    polyData->GetPoints()->resize(numberOfPoints);
+    // The PolyData containers own their elements, so each array is copied
+    // once, without first value-initializing the container
     polyData->GetPoints()->assign(pointsPtr, pointsPtr + numberOfPoints);
   }
 
   const rapidjson::Value & verticesBufferSizeJson = document["verticesBufferSize"];
-  const SizeValueType verticesBufferSize = verticesBufferSizeJson.GetInt();
+  const SizeValueType verticesBufferSize = verticesBufferSizeJson.GetUint64();
   if (verticesBufferSize)
   {
     const rapidjson::Value & verticesJson = document["vertices"];
     const std::string verticesString( verticesJson.GetString() );
     auto verticesPtr = reinterpret_cast< uint32_t * >( std::strtoull(verticesString.substr(35).c_str(), nullptr, 10) );
-    polyData->GetVertices()->resize(verticesBufferSize);
     polyData->GetVertices()->assign(verticesPtr, verticesPtr + verticesBufferSize);
   }
 
   const rapidjson::Value & linesBufferSizeJson = document["linesBufferSize"];
-  const SizeValueType linesBufferSize = linesBufferSizeJson.GetInt();
+  const SizeValueType linesBufferSize = linesBufferSizeJson.GetUint64();
   if (linesBufferSize)
   {
     const rapidjson::Value & linesJson = document["lines"];
     const std::string linesString( linesJson.GetString() );
     auto linesPtr = reinterpret_cast< uint32_t * >( std::strtoull(linesString.substr(35).c_str(), nullptr, 10) );
-    polyData->GetLines()->resize(linesBufferSize);
     polyData->GetLines()->assign(linesPtr, linesPtr + linesBufferSize);
   }
 
   const rapidjson::Value & polygonsBufferSizeJson = document["polygonsBufferSize"];
-  const SizeValueType polygonsBufferSize = polygonsBufferSizeJson.GetInt();
+  const SizeValueType polygonsBufferSize = polygonsBufferSizeJson.GetUint64();
   if (polygonsBufferSize)
   {
     const rapidjson::Value & polygonsJson = document["polygons"];
     const std::string polygonsString( polygonsJson.GetString() );
     auto polygonsPtr = reinterpret_cast< uint32_t * >( std::strtoull(polygonsString.substr(35).c_str(), nullptr, 10) );
-    polyData->GetPolygons()->resize(polygonsBufferSize);
     polyData->GetPolygons()->assign(polygonsPtr, polygonsPtr + polygonsBufferSize);
   }
 
   const rapidjson::Value & triangleStripsBufferSizeJson = document["triangleStripsBufferSize"];
-  const SizeValueType triangleStripsBufferSize = triangleStripsBufferSizeJson.GetInt();
+  const SizeValueType triangleStripsBufferSize = triangleStripsBufferSizeJson.GetUint64();
   if (triangleStripsBufferSize)
   {
     const rapidjson::Value & triangleStripsJson = document["triangleStrips"];
     const std::string triangleStripsString( triangleStripsJson.GetString() );
     auto triangleStripsPtr = reinterpret_cast< uint32_t * >( std::strtoull(triangleStripsString.substr(35).c_str(), nullptr, 10) );
-    polyData->GetTriangleStrips()->resize(triangleStripsBufferSize);
     polyData->GetTriangleStrips()->assign(triangleStripsPtr, triangleStripsPtr + triangleStripsBufferSize);
   }
 
   const rapidjson::Value & numberOfPointPixelsJson = document["numberOfPointPixels"];
-  const SizeValueType numberOfPointPixels = numberOfPointPixelsJson.GetInt();
+  const SizeValueType numberOfPointPixels = numberOfPointPixelsJson.GetUint64();
   if (numberOfPointPixels)
   {
     const rapidjson::Value & pointPixelComponentsJson = polyDataType["pointPixelComponents"];
@@ -248,12 +248,15 @@ WasmPolyDataToPolyDataFilter<TPolyData>
     using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
     const std::string pointDataString( pointDataJson.GetString() );
     auto pointDataPtr = reinterpret_cast< typename ConvertPointPixelTraits::ComponentType * >( std::strtoull(pointDataString.substr(35).c_str(), nullptr, 10) );
-    polyData->GetPointData()->resize(numberOfPointPixels * pointPixelComponents);
+    if (polyData->GetPointData() == nullptr)
+    {
+      polyData->SetPointData(PolyDataType::PointDataContainer::New());
+    }
     polyData->GetPointData()->assign(pointDataPtr, pointDataPtr + numberOfPointPixels * pointPixelComponents);
   }
 
   const rapidjson::Value & numberOfCellPixelsJson = document["numberOfCellPixels"];
-  const SizeValueType numberOfCellPixels = numberOfCellPixelsJson.GetInt();
+  const SizeValueType numberOfCellPixels = numberOfCellPixelsJson.GetUint64();
   if (numberOfCellPixels)
   {
     const rapidjson::Value & cellPixelComponentsJson = polyDataType["cellPixelComponents"];
@@ -267,7 +270,6 @@ WasmPolyDataToPolyDataFilter<TPolyData>
     {
       polyData->SetCellData(PolyDataType::CellDataContainer::New());
     }
-    polyData->GetCellData()->resize(numberOfCellPixels * cellPixelComponents);
     polyData->GetCellData()->assign(cellDataPtr, cellDataPtr + numberOfCellPixels * cellPixelComponents);
   }
 }
@@ -0,0 +1,96 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmQuantization_h
+#define itkWasmQuantization_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkWasmCBORSink.h"
+#include "cbor.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace itk
+{
+namespace wasm
+{
+
+/** Bounding box quantization of a typed array of float or double components.
+ *
+ * Component c of each element is stored as the unsigned integer of bits
+ * bits nearest to (value - minimum[c]) / step(c), where
+ * step(c) = (maximum[c] - minimum[c]) / (2^bits - 1), so the restored value
+ * is within half a step. */
+struct Quantization
+{
+  /** 16 or 32, or 0 when the values are not quantized. */
+  unsigned int bits{ 0 };
+  std::vector<double> minimum;
+  std::vector<double> maximum;
+
+  bool
+  IsEnabled() const
+  {
+    return bits > 0;
+  }
+
+  /** Bytes per quantized component. */
+  size_t
+  GetComponentSize() const
+  {
+    return bits / 8;
+  }
+};
+
+/** Quantization of bits bits against the bounding box of each of the
+ * components of the numberOfValues values, whose componentSize is 4 for
+ * float or 8 for double. Non-finite values are not supported. */
+WebAssemblyInterface_EXPORT Quantization
+ComputeQuantization(unsigned int bits, size_t componentSize, unsigned int components, const void * values, uint64_t numberOfValues);
+
+/** Largest absolute error of a restored component, half the largest step. */
+WebAssemblyInterface_EXPORT double
+QuantizationError(const Quantization & quantization);
+
+/** Quantize the numberOfValues values into quantized, of
+ * numberOfValues * quantization.GetComponentSize() bytes. */
+WebAssemblyInterface_EXPORT void
+Quantize(const Quantization & quantization, size_t componentSize, const void * values, uint64_t numberOfValues, void * quantized);
+
+/** Restore values in place. The quantized components are at the start of
+ * buffer, which has room for the numberOfValues restored values of
+ * componentSize bytes. */
+WebAssemblyInterface_EXPORT void
+Dequantize(const Quantization & quantization, size_t componentSize, void * buffer, uint64_t numberOfValues);
+
+/** Write the quantization as the value of a map entry:
+ * { "bits": 16, "minimum": [...], "maximum": [...] } */
+WebAssemblyInterface_EXPORT void
+WriteQuantization(CBORSink & sink, const Quantization & quantization);
+
+/** Parse the value of a quantization map entry. Throws a std::runtime_error
+ * if it is malformed. */
+WebAssemblyInterface_EXPORT Quantization
+ReadQuantization(const cbor_item_t * item);
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,116 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmRangeReader_h
+#define itkWasmRangeReader_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkWasmCBORSource.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/**
+ *\class RangeReader
+ * \brief Random access to the bytes of a file or of a URL
+ *
+ * http:// and https:// URLs are read with the host functions
+ * `itk_wasm.range_size(url, urlLength)` and
+ * `itk_wasm.range_fetch(url, urlLength, offset, data, size)` in WebAssembly
+ * builds with ITK_WASM_RANGE_FETCH_IMPORT, e.g. with HTTP range requests to
+ * object storage, so only the byte ranges read are transferred. The host
+ * functions are synchronous and may be called from any thread. Other names
+ * are local files.
+ *
+ * Read may be called concurrently.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT RangeReader
+{
+public:
+  virtual ~RangeReader() = default;
+
+  /** Open a file or URL. Returns nullptr if it does not exist, or if it is a
+   * URL and the build has no range fetch import. */
+  static std::unique_ptr<RangeReader>
+  Open(const std::string & name);
+
+  /** Whether the name is an http:// or https:// URL. */
+  static bool
+  IsURL(const std::string & name);
+
+  /** Size in bytes. */
+  virtual uint64_t
+  GetSize() const = 0;
+
+  /** Read size bytes at offset into data. Returns false if fewer bytes are
+   * available. */
+  virtual bool
+  Read(uint64_t offset, void * data, size_t size) = 0;
+};
+
+/** Read the whole file or URL into contents. Returns false if it cannot be
+ * read. */
+WebAssemblyInterface_EXPORT bool
+ReadRangeResource(const std::string & name, std::vector<char> & contents);
+
+/**
+ *\class RangeCBORSource
+ * \brief Sequential CBORSource of a RangeReader
+ *
+ * Small reads are served from a buffer filled BufferSize bytes at a time.
+ * Large reads go directly to their destination, and skips past the buffer
+ * only move the offset, so skipped pixel data is not transferred.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT RangeCBORSource : public CBORSource
+{
+public:
+  static constexpr size_t BufferSize = 64 * 1024;
+
+  explicit RangeCBORSource(std::unique_ptr<RangeReader> reader);
+
+protected:
+  bool
+  ReadBytes(void * data, size_t size) override;
+
+  bool
+  SkipBytes(uint64_t size) override;
+
+private:
+  std::unique_ptr<RangeReader> m_Reader;
+  uint64_t m_Offset{ 0 };
+  std::vector<char> m_Buffer;
+  uint64_t m_BufferOffset{ 0 };
+};
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
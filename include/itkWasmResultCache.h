@@ -0,0 +1,113 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmResultCache_h
+#define itkWasmResultCache_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+namespace wasm
+{
+
+/** Memory IO output of a pipeline run: the output JSON and its arrays. */
+struct ResultCacheOutput
+{
+  std::string json;
+  // subIndex
+  std::map<uint32_t, std::vector<uint8_t>> arrays;
+};
+
+// output index
+using ResultCacheEntry = std::map<uint32_t, ResultCacheOutput>;
+
+/**
+ *\class ResultCacheStore
+ * \brief Store for the outputs of deterministic pipeline runs
+ *
+ * Entries are keyed by the ContentHash of the pipeline name, the parameter
+ * values, the input JSON and the input arrays of a memory IO run. When a
+ * store is set with setResultCacheStore, a run whose key is found skips the
+ * pipeline functor and publishes the stored outputs instead.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT ResultCacheStore
+{
+public:
+  virtual ~ResultCacheStore() = default;
+
+  /** The entry stored for key, or nullptr. */
+  virtual std::shared_ptr<const ResultCacheEntry> Get(uint64_t key) = 0;
+
+  virtual void Put(uint64_t key, std::shared_ptr<const ResultCacheEntry> entry) = 0;
+};
+
+/**
+ *\class MemoryResultCacheStore
+ * \brief ResultCacheStore that keeps entries in memory, evicting the least recently used
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT MemoryResultCacheStore : public ResultCacheStore
+{
+public:
+  /** Keep at most capacity bytes of output JSON and arrays. */
+  explicit MemoryResultCacheStore(size_t capacity);
+
+  std::shared_ptr<const ResultCacheEntry> Get(uint64_t key) override;
+
+  void Put(uint64_t key, std::shared_ptr<const ResultCacheEntry> entry) override;
+
+  size_t GetSize() const
+  {
+    return m_Size;
+  }
+
+private:
+  using EntryListType = std::list<std::pair<uint64_t, std::shared_ptr<const ResultCacheEntry>>>;
+
+  size_t m_Capacity;
+  size_t m_Size{0};
+  // most recently used first
+  EntryListType m_Entries;
+  std::unordered_map<uint64_t, EntryListType::iterator> m_Index;
+};
+
+/** Number of bytes of output JSON and arrays in an entry. */
+WebAssemblyInterface_EXPORT size_t GetResultCacheEntrySize(const ResultCacheEntry & entry);
+
+/** Set the store used by pipelines run with memory IO. nullptr, the default,
+ * disables the result cache. Only set a store for pipelines whose outputs
+ * depend on nothing but their parameters and inputs. */
+WebAssemblyInterface_EXPORT void setResultCacheStore(std::shared_ptr<ResultCacheStore> store);
+WebAssemblyInterface_EXPORT ResultCacheStore * getResultCacheStore();
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
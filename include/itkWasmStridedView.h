@@ -0,0 +1,160 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmStridedView_h
+#define itkWasmStridedView_h
+
+#include "itkImageAlgorithm.h"
+#include "itkMacro.h"
+#include "itkIntTypes.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/** Strides of the image interface JSON `strides` entry: for each dimension,
+ * first axis fastest, the distance in components between neighboring
+ * pixels of a view into a larger buffer. The components of a pixel are
+ * contiguous. */
+using ImageStridesType = std::vector<uint64_t>;
+
+/** Strides of a contiguous buffer of the given size. */
+inline ImageStridesType
+ContiguousStrides(const std::vector<uint64_t> & size, unsigned int numberOfComponents)
+{
+  ImageStridesType strides(size.size());
+  uint64_t stride = numberOfComponents;
+  for (size_t dim = 0; dim < size.size(); ++dim)
+  {
+    strides[dim] = stride;
+    stride *= size[dim];
+  }
+  return strides;
+}
+
+/** Whether a view with these strides is a contiguous buffer. */
+inline bool
+IsContiguousStrides(const std::vector<uint64_t> & size, const ImageStridesType & strides, unsigned int numberOfComponents)
+{
+  return strides == ContiguousStrides(size, numberOfComponents);
+}
+
+/** Number of components from the first to the last pixel of a view,
+ * i.e. the extent of the buffer it references. 0 for an empty view. */
+inline uint64_t
+StridedViewSpan(const std::vector<uint64_t> & size, const ImageStridesType & strides, unsigned int numberOfComponents)
+{
+  uint64_t last = 0;
+  for (size_t dim = 0; dim < size.size(); ++dim)
+  {
+    if (size[dim] == 0)
+    {
+      return 0;
+    }
+    last += (size[dim] - 1) * strides[dim];
+  }
+  return last + numberOfComponents;
+}
+
+/** Copy the pixels of a strided view into a contiguous buffer, a row of
+ * the first axis at a time when its pixels are contiguous. */
+template <typename TComponent>
+void
+GatherStridedView(const TComponent * view,
+                  const std::vector<uint64_t> & size,
+                  const ImageStridesType & strides,
+                  unsigned int numberOfComponents,
+                  TComponent * contiguous)
+{
+  const size_t dimension = size.size();
+  if (dimension == 0 || StridedViewSpan(size, strides, numberOfComponents) == 0)
+  {
+    return;
+  }
+  const bool contiguousRows = strides[0] == numberOfComponents;
+  const uint64_t rowComponents = size[0] * numberOfComponents;
+  std::vector<uint64_t> index(dimension, 0);
+  while (true)
+  {
+    uint64_t offset = 0;
+    for (size_t dim = 1; dim < dimension; ++dim)
+    {
+      offset += index[dim] * strides[dim];
+    }
+    const TComponent * row = view + offset;
+    if (contiguousRows)
+    {
+      std::copy(row, row + rowComponents, contiguous);
+    }
+    else
+    {
+      for (uint64_t ii = 0; ii < size[0]; ++ii)
+      {
+        std::copy(row + ii * strides[0], row + ii * strides[0] + numberOfComponents, contiguous + ii * numberOfComponents);
+      }
+    }
+    contiguous += rowComponents;
+
+    size_t dim = 1;
+    for (; dim < dimension; ++dim)
+    {
+      if (++index[dim] < size[dim])
+      {
+        break;
+      }
+      index[dim] = 0;
+    }
+    if (dim == dimension)
+    {
+      return;
+    }
+  }
+}
+
+/** Contiguous copy of a region of an image, with the same physical
+ * placement and metadata. */
+template <typename TImage>
+typename TImage::Pointer
+CopyImageRegion(const TImage * image, const typename TImage::RegionType & region)
+{
+  if (!image->GetBufferedRegion().IsInside(region))
+  {
+    itkGenericExceptionMacro("The region " << region << " is not inside the buffered region "
+                                           << image->GetBufferedRegion());
+  }
+  auto copy = TImage::New();
+  copy->CopyInformation(image);
+  copy->SetRegions(region);
+  copy->SetNumberOfComponentsPerPixel(image->GetNumberOfComponentsPerPixel());
+  copy->Allocate();
+  copy->SetMetaDataDictionary(image->GetMetaDataDictionary());
+  ImageAlgorithm::Copy(image, copy.GetPointer(), region, region);
+  return copy;
+}
+
+} // end namespace wasm
+
+} // end namespace itk
+
+#endif
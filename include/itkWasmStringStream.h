@@ -19,6 +19,7 @@
 #define itkWasmStringStream_h
 
 #include "itkWasmDataObject.h"
+#include "itkWasmAllocationStats.h"
 #include "rapidjson/document.h"
 #include <string_view>
 
@@ -59,11 +60,13 @@ public:
 
   void SetString(const std::string & string) {
     this->m_StringStream.str(string);
+    ITK_WASM_COUNT_COPY(StringStream, string.size());
     this->UpdateJSON();
   }
 
   const std::string & GetString() {
     this->m_String = m_StringStream.str();
+    ITK_WASM_COUNT_COPY(StringStream, this->m_String.size());
     return this->m_String;
   }
 
@@ -82,9 +85,10 @@ public:
     const rapidjson::Value & dataJson = document["data"];
     const std::string dataString( dataJson.GetString() );
     const char * dataPtr = reinterpret_cast< char * >( std::strtoull(dataString.substr(35).c_str(), nullptr, 10) );
-    size_t size = document["size"].GetInt();
+    const size_t size = static_cast<size_t>(document["size"].GetUint64());
     const std::string_view string(dataPtr, size);
     m_StringStream.str(std::string{string});
+    ITK_WASM_COUNT_COPY(StringStream, 2 * size);
 
     Superclass::SetJSON(jsonChar);
   }
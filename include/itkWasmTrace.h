@@ -0,0 +1,101 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmTrace_h
+#define itkWasmTrace_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#ifdef ITK_WASM_TRACE
+#include <chrono>
+#include <ostream>
+#include <string>
+#endif
+
+namespace itk
+{
+namespace wasm
+{
+
+#ifdef ITK_WASM_TRACE
+/**
+ *\class TraceScope
+ * \brief Record a scope as a span of a Chrome trace event file
+ *
+ * Builds configured with ITK_WASM_TRACE record spans, complete ("X") trace
+ * events, of the glue code when the Pipeline is run with --trace. The
+ * Pipeline writes them on stderr when it is destroyed as a JSON line,
+ * `{"traceEvents":[...]}`, that loads in Perfetto and chrome://tracing. Event
+ * timestamps are microseconds of the steady clock: CLOCK_MONOTONIC natively,
+ * as the browser's trace clock on Linux, and performance.now() of the worker
+ * in emscripten builds, so the spans line up with performance.mark and
+ * performance.measure entries of the worker. WebAssembly builds with
+ * ITK_WASM_TRACE_IMPORT call the host function
+ * `itk_wasm.trace_event(name, category, startMicroseconds,
+ * durationMicroseconds)`, with pointers to null terminated strings, as
+ * each span ends instead, e.g. to forward them to performance.measure.
+ *
+ * Without ITK_WASM_TRACE, ITK_WASM_TRACE_SCOPE compiles to nothing.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT TraceScope
+{
+public:
+  /** The name and category must outlive the scope, e.g. string literals. */
+  explicit TraceScope(const char * name, const char * category = "itk-wasm");
+  ~TraceScope();
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope & operator=(const TraceScope &) = delete;
+
+  /** Whether spans are recorded, set by the Pipeline's --trace flag. */
+  static bool
+  GetEnabled();
+  static void
+  SetEnabled(bool enabled);
+
+  /** Record a span that has ended, e.g. a --profile phase. */
+  static void
+  AddEvent(const std::string & name,
+           const char * category,
+           std::chrono::steady_clock::time_point start,
+           std::chrono::steady_clock::time_point end);
+
+  /** Write and clear the recorded spans as a trace event JSON object.
+   * processName names the process track. */
+  static void
+  WriteEvents(std::ostream & stream, const std::string & processName);
+
+  static void
+  ClearEvents();
+
+private:
+  const char * m_Name;
+  const char * m_Category;
+  std::chrono::steady_clock::time_point m_Start{};
+};
+
+#  define ITK_WASM_TRACE_SCOPE(name) const ::itk::wasm::TraceScope itkWasmTraceScope(name)
+#else
+#  define ITK_WASM_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
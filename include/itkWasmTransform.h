@@ -0,0 +1,81 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmTransform_h
+#define itkWasmTransform_h
+
+#include "itkWasmDataObject.h"
+#include "itkDataObjectDecorator.h"
+
+namespace itk
+{
+/**
+ *\class WasmTransform
+ * \brief JSON representation for an itk::Transform
+ *
+ * JSON representation for an itk::Transform for interfacing across programming languages and runtimes.
+ *
+ * Array buffer's are stored as strings with memory addresses or paths on disks or a virtual filesystem.
+ *
+ * - 0: Fixed parameters buffer
+ * - 1: Parameters buffer
+ *
+ * The parameters of a displacement field transform are its displacement
+ * field pixel buffer, and the fixed parameters its size, origin, spacing,
+ * and direction.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+template <typename TTransform>
+class ITK_TEMPLATE_EXPORT WasmTransform : public WasmDataObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WasmTransform);
+
+  /** Standard class type aliases. */
+  using Self = WasmTransform;
+  using Superclass = WasmDataObject;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WasmTransform, WasmDataObject);
+
+  using TransformType = TTransform;
+  /** Transforms are not data objects, so they are held in a decorator. */
+  using DecoratedTransformType = DataObjectDecorator<TransformType>;
+
+  void SetTransform(const TransformType * transform) {
+    auto decoratedTransform = DecoratedTransformType::New();
+    decoratedTransform->Set(transform);
+    this->SetDataObject(decoratedTransform);
+  }
+
+  const TransformType * GetTransform() const {
+    const auto * decoratedTransform = static_cast< const DecoratedTransformType * >(this->GetDataObject());
+    return decoratedTransform == nullptr ? nullptr : decoratedTransform->Get();
+  }
+
+protected:
+  WasmTransform() = default;
+  ~WasmTransform() override = default;
+};
+
+} // namespace itk
+
+#endif
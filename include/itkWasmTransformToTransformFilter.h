@@ -0,0 +1,141 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmTransformToTransformFilter_h
+#define itkWasmTransformToTransformFilter_h
+
+#include "itkProcessObject.h"
+#include "itkWasmTransform.h"
+
+#include "rapidjson/document.h"
+
+#include <memory>
+
+namespace itk
+{
+/**
+ *\class WasmTransformToTransformFilter
+ * \brief Convert an WasmTransform to an Transform object.
+ *
+ * The transform is created with the transform factory from the transform
+ * name in the JSON representation. It must be a TTransform, with the
+ * dimensions and parameters value type of TTransform, or an exception will be
+ * shown. The output is the decorated transform.
+ *
+ * The displacement field of a displacement field transform imports the
+ * parameters buffer without a copy.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+template <typename TTransform>
+class ITK_TEMPLATE_EXPORT WasmTransformToTransformFilter : public ProcessObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WasmTransformToTransformFilter);
+
+  /** Standard class type aliases. */
+  using Self = WasmTransformToTransformFilter;
+  using Superclass = ProcessObject;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WasmTransformToTransformFilter, ProcessObject);
+
+  using DataObjectIdentifierType = Superclass::DataObjectIdentifierType;
+  using DataObjectPointerArraySizeType = Superclass::DataObjectPointerArraySizeType;
+
+  using TransformType = TTransform;
+  using WasmTransformType = WasmTransform<TransformType>;
+  using DecoratedTransformType = typename WasmTransformType::DecoratedTransformType;
+
+  /** Set/Get the path input of this process object.  */
+  using Superclass::SetInput;
+  virtual void
+  SetInput(const WasmTransformType * transform);
+
+  virtual void
+  SetInput(unsigned int, const WasmTransformType * transform);
+
+  const WasmTransformType *
+  GetInput();
+
+  const WasmTransformType *
+  GetInput(unsigned int idx);
+
+  DecoratedTransformType *
+  GetOutput();
+  const DecoratedTransformType *
+  GetOutput() const;
+
+  DecoratedTransformType *
+  GetOutput(unsigned int idx);
+
+  /** Release the fixed parameters and parameters arrays from the memory IO
+   * input array store of session MemoryIndex once they are in the transform,
+   * instead of keeping them until the end of the run. The displacement field
+   * of a displacement field transform takes its array. Default: false. */
+  itkSetMacro(InputArrayHandoff, bool);
+  itkGetConstMacro(InputArrayHandoff, bool);
+  itkBooleanMacro(InputArrayHandoff);
+
+  /** Memory IO store session used with InputArrayHandoff. */
+  itkSetMacro(MemoryIndex, uint32_t);
+  itkGetConstMacro(MemoryIndex, uint32_t);
+
+  /** Use an already parsed JSON representation of the input instead of
+   * parsing the input JSON again. */
+  void SetJSONDocument(std::shared_ptr<const rapidjson::Document> document)
+  {
+    this->m_JSONDocument = std::move(document);
+    this->Modified();
+  }
+
+protected:
+  WasmTransformToTransformFilter();
+  ~WasmTransformToTransformFilter() override = default;
+
+  ProcessObject::DataObjectPointer
+  MakeOutput(ProcessObject::DataObjectPointerArraySizeType idx) override;
+  ProcessObject::DataObjectPointer
+  MakeOutput(const ProcessObject::DataObjectIdentifierType &) override;
+
+  void
+  GenerateOutputInformation() override
+  {} // do nothing
+  void
+  GenerateData() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  std::shared_ptr<const rapidjson::Document> m_JSONDocument;
+
+  bool m_InputArrayHandoff{false};
+
+  uint32_t m_MemoryIndex{0};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkWasmTransformToTransformFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,305 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmTransformToTransformFilter_hxx
+#define itkWasmTransformToTransformFilter_hxx
+
+#include "itkWasmTransformToTransformFilter.h"
+
+#include <algorithm>
+#include <exception>
+#include <sstream>
+#include <type_traits>
+#include "itkWasmMapComponentType.h"
+#include "itkDeleterImportImageContainer.h"
+#include "itkDisplacementFieldTransform.h"
+#include "itkTransformFactoryBase.h"
+#include "itkWasmTrace.h"
+#include "itkWasmAllocationStats.h"
+
+#ifndef ITK_WASM_NO_MEMORY_IO
+#include "itkWasmExports.h"
+#endif
+
+#include "rapidjson/document.h"
+
+namespace itk
+{
+
+template <typename TTransform>
+WasmTransformToTransformFilter<TTransform>
+::WasmTransformToTransformFilter()
+{
+  this->SetNumberOfRequiredInputs(1);
+
+  typename DecoratedTransformType::Pointer output = static_cast<DecoratedTransformType *>(this->MakeOutput(0).GetPointer());
+  this->ProcessObject::SetNumberOfRequiredOutputs(1);
+  this->ProcessObject::SetNthOutput(0, output.GetPointer());
+}
+
+template <typename TTransform>
+ProcessObject::DataObjectPointer
+WasmTransformToTransformFilter<TTransform>
+::MakeOutput(ProcessObject::DataObjectPointerArraySizeType)
+{
+  return DecoratedTransformType::New().GetPointer();
+}
+
+template <typename TTransform>
+ProcessObject::DataObjectPointer
+WasmTransformToTransformFilter<TTransform>
+::MakeOutput(const ProcessObject::DataObjectIdentifierType &)
+{
+  return DecoratedTransformType::New().GetPointer();
+}
+
+template <typename TTransform>
+auto
+WasmTransformToTransformFilter<TTransform>
+::GetOutput() -> DecoratedTransformType *
+{
+  // we assume that the first output is of the templated type
+  return itkDynamicCastInDebugMode<DecoratedTransformType *>(this->GetPrimaryOutput());
+}
+
+template <typename TTransform>
+auto
+WasmTransformToTransformFilter<TTransform>
+::GetOutput() const -> const DecoratedTransformType *
+{
+  // we assume that the first output is of the templated type
+  return itkDynamicCastInDebugMode<const DecoratedTransformType *>(this->GetPrimaryOutput());
+}
+
+template <typename TTransform>
+auto
+WasmTransformToTransformFilter<TTransform>
+::GetOutput(unsigned int idx) -> DecoratedTransformType *
+{
+  auto * out = dynamic_cast<DecoratedTransformType *>(this->ProcessObject::GetOutput(idx));
+
+  if (out == nullptr && this->ProcessObject::GetOutput(idx) != nullptr)
+  {
+    itkWarningMacro(<< "Unable to convert output number " << idx << " to type " << typeid(DecoratedTransformType).name());
+  }
+  return out;
+}
+
+template <typename TTransform>
+void
+WasmTransformToTransformFilter<TTransform>
+::SetInput(const WasmTransformType * input)
+{
+  // Process object is not const-correct so the const_cast is required here
+  this->ProcessObject::SetNthInput(0, const_cast<WasmTransformType *>(input));
+}
+
+template <typename TTransform>
+void
+WasmTransformToTransformFilter<TTransform>
+::SetInput(unsigned int index, const WasmTransformType * transform)
+{
+  // Process object is not const-correct so the const_cast is required here
+  this->ProcessObject::SetNthInput(index, const_cast<WasmTransformType *>(transform));
+}
+
+template <typename TTransform>
+const typename WasmTransformToTransformFilter<TTransform>::WasmTransformType *
+WasmTransformToTransformFilter<TTransform>
+::GetInput()
+{
+  return itkDynamicCastInDebugMode<const WasmTransformType *>(this->GetPrimaryInput());
+}
+
+template <typename TTransform>
+const typename WasmTransformToTransformFilter<TTransform>::WasmTransformType *
+WasmTransformToTransformFilter<TTransform>
+::GetInput(unsigned int idx)
+{
+  return itkDynamicCastInDebugMode<const WasmTransformType *>(this->ProcessObject::GetInput(idx));
+}
+
+template <typename TTransform>
+void
+WasmTransformToTransformFilter<TTransform>
+::GenerateData()
+{
+  ITK_WASM_TRACE_SCOPE("WasmTransformToTransformFilter::GenerateData");
+
+  // Get the input and output pointers
+  const WasmTransformType * transformJSON = this->GetInput();
+  DecoratedTransformType * decoratedTransform = this->GetOutput();
+
+  rapidjson::Document parsedDocument;
+  if (!this->m_JSONDocument)
+    {
+    const std::string json(transformJSON->GetJSON());
+    if (parsedDocument.Parse(json.c_str()).HasParseError())
+      {
+      throw std::runtime_error("Could not parse JSON");
+      }
+    }
+  const rapidjson::Value & document = this->m_JSONDocument ? static_cast< const rapidjson::Value & >(*this->m_JSONDocument) : static_cast< const rapidjson::Value & >(parsedDocument);
+
+  const rapidjson::Value & transformType = document["transformType"];
+
+  const unsigned int inputDimension = transformType["inputDimension"].GetUint();
+  const unsigned int outputDimension = transformType["outputDimension"].GetUint();
+  if (inputDimension != TransformType::InputSpaceDimension || outputDimension != TransformType::OutputSpaceDimension)
+  {
+    throw std::runtime_error("Unexpected dimension");
+  }
+  using ParametersValueType = typename TransformType::ParametersValueType;
+  const std::string parametersValueType( transformType["parametersValueType"].GetString() );
+  if (parametersValueType != itk::wasm::MapComponentType<ParametersValueType>::ComponentString)
+  {
+    throw std::runtime_error("Unexpected parameters value type");
+  }
+
+  // The transform factory names are those of Transform::GetTransformTypeAsString
+  const std::string transformName( transformType["transformName"].GetString() );
+  std::ostringstream factoryName;
+  factoryName << transformName << '_' << (std::is_same<ParametersValueType, float>::value ? "float" : "double") << '_'
+              << inputDimension << '_' << outputDimension;
+  TransformFactoryBase::RegisterDefaultTransforms();
+  LightObject::Pointer instance = ObjectFactoryBase::CreateInstance(factoryName.str().c_str());
+  typename TransformType::Pointer transform = dynamic_cast< TransformType * >(instance.GetPointer());
+  if (transform.IsNull())
+  {
+    throw std::runtime_error("Unsupported transform type: " + factoryName.str());
+  }
+  if (document.HasMember("name"))
+  {
+    transform->SetObjectName(document["name"].GetString());
+  }
+
+  const SizeValueType numberOfFixedParameters = document["numberOfFixedParameters"].GetUint64();
+  const SizeValueType numberOfParameters = document["numberOfParameters"].GetUint64();
+
+  const std::string fixedParametersString( document["fixedParameters"].GetString() );
+  const size_t fixedParametersAddress = std::strtoull(fixedParametersString.substr(35).c_str(), nullptr, 10);
+  const std::string parametersString( document["parameters"].GetString() );
+  const size_t parametersAddress = std::strtoull(parametersString.substr(35).c_str(), nullptr, 10);
+
+  using FixedParametersType = typename TransformType::FixedParametersType;
+  FixedParametersType fixedParameters(numberOfFixedParameters);
+  if (numberOfFixedParameters)
+  {
+    const auto * fixedParametersPtr = reinterpret_cast< const typename FixedParametersType::ValueType * >( fixedParametersAddress );
+    std::copy(fixedParametersPtr, fixedParametersPtr + numberOfFixedParameters, fixedParameters.data_block());
+  }
+
+  constexpr unsigned int Dimension = TransformType::InputSpaceDimension;
+  using DisplacementFieldTransformType = DisplacementFieldTransform<ParametersValueType, Dimension>;
+  auto * displacementFieldTransform = dynamic_cast< DisplacementFieldTransformType * >(transform.GetPointer());
+  bool parametersImported = false;
+  if (displacementFieldTransform != nullptr && numberOfParameters)
+  {
+    // The fixed parameters are the field size, origin, spacing, and direction
+    if (numberOfFixedParameters != Dimension * (Dimension + 3))
+    {
+      throw std::runtime_error("Unexpected number of displacement field fixed parameters");
+    }
+    using DisplacementFieldType = typename DisplacementFieldTransformType::DisplacementFieldType;
+    using DisplacementType = typename DisplacementFieldType::PixelType;
+    typename DisplacementFieldType::SizeType size;
+    typename DisplacementFieldType::PointType origin;
+    typename DisplacementFieldType::SpacingType spacing;
+    typename DisplacementFieldType::DirectionType direction;
+    SizeValueType numberOfPixels = 1;
+    for (unsigned int dd = 0; dd < Dimension; ++dd)
+    {
+      size[dd] = static_cast< SizeValueType >( fixedParameters[dd] );
+      origin[dd] = fixedParameters[Dimension + dd];
+      spacing[dd] = fixedParameters[2 * Dimension + dd];
+      for (unsigned int ee = 0; ee < Dimension; ++ee)
+      {
+        direction[dd][ee] = fixedParameters[3 * Dimension + dd * Dimension + ee];
+      }
+      numberOfPixels *= size[dd];
+    }
+    if (numberOfPixels * Dimension != numberOfParameters)
+    {
+      throw std::runtime_error("Unexpected number of displacement field parameters");
+    }
+
+    auto displacementField = DisplacementFieldType::New();
+    displacementField->SetRegions(size);
+    displacementField->SetOrigin(origin);
+    displacementField->SetSpacing(spacing);
+    displacementField->SetDirection(direction);
+
+    // The field pixel buffer is the parameters array, which is not copied
+    using PixelContainerType = DeleterImportImageContainer<SizeValueType, DisplacementType>;
+    auto pixelContainer = PixelContainerType::New();
+    auto * parametersPtr = reinterpret_cast< DisplacementType * >( parametersAddress );
+    typename PixelContainerType::DeleterType deleter;
+#ifndef ITK_WASM_NO_MEMORY_IO
+    auto handoffArray = std::make_shared<wasm::InputArrayStoreValueType>();
+    if (this->m_InputArrayHandoff && wasm::takeMemoryStoreInputArray(this->m_MemoryIndex, parametersAddress, *handoffArray))
+    {
+      // The lambda holds the moved store entry until the pixel container releases it
+      deleter = [handoffArray]() { handoffArray->clear(); handoffArray->shrink_to_fit(); };
+    }
+#endif
+    pixelContainer->SetImportPointer(parametersPtr, numberOfPixels, deleter);
+    displacementField->SetPixelContainer(pixelContainer);
+    displacementFieldTransform->SetDisplacementField(displacementField);
+    parametersImported = true;
+  }
+  else
+  {
+    transform->SetFixedParameters(fixedParameters);
+    if (numberOfParameters)
+    {
+      using ParametersType = typename TransformType::ParametersType;
+      const auto * parametersPtr = reinterpret_cast< const ParametersValueType * >( parametersAddress );
+      ParametersType parameters(numberOfParameters);
+      std::copy(parametersPtr, parametersPtr + numberOfParameters, parameters.data_block());
+      ITK_WASM_COUNT_COPY(InputStore, numberOfParameters * sizeof(ParametersValueType));
+      transform->SetParameters(parameters);
+    }
+  }
+
+#ifndef ITK_WASM_NO_MEMORY_IO
+  if (this->m_InputArrayHandoff)
+  {
+    wasm::InputArrayStoreValueType released;
+    for (const size_t address : { fixedParametersAddress, parametersImported ? size_t{0} : parametersAddress })
+    {
+      if (address != 0 && wasm::takeMemoryStoreInputArray(this->m_MemoryIndex, address, released))
+      {
+        released.clear();
+        released.shrink_to_fit();
+      }
+    }
+  }
+#endif
+
+  decoratedTransform->Set(transform);
+}
+
+template <typename TTransform>
+void
+WasmTransformToTransformFilter<TTransform>
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,431 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmZstdCBORStream_h
+#define itkWasmZstdCBORStream_h
+
+#include "itkWasmCBORSink.h"
+#include "itkWasmCBORSource.h"
+#include "itkWasmAllocationStats.h"
+#include "itkWasmRangeReader.h"
+#include "itkWasmZstdDictionary.h"
+
+#include "zstd.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/**
+ *\class ZstdCBORSource
+ * \brief Decompress a .cbor.zst file or URL on demand, straight into the
+ * destination of each read
+ *
+ * Only included by the zstd IO's, which link libzstd.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class ZstdCBORSource : public CBORSource
+{
+public:
+  explicit ZstdCBORSource(std::unique_ptr<RangeReader> reader)
+    : m_Reader(std::move(reader))
+    , m_Context(ZSTD_createDCtx())
+    , m_InputData(ZSTD_DStreamInSize())
+    , m_Input{ m_InputData.data(), 0, 0 }
+  {}
+
+  ~ZstdCBORSource() override
+  {
+    ZSTD_freeDCtx(m_Context);
+  }
+
+  /** Decompress frames compressed with the dictionary. Call before the
+   * first read. Returns false if the dictionary cannot be referenced. */
+  bool
+  SetDictionary(std::shared_ptr<const ZstdDictionary> dictionary)
+  {
+    m_Dictionary = std::move(dictionary);
+    return !ZSTD_isError(ZSTD_DCtx_refDDict(
+      m_Context, m_Dictionary ? m_Dictionary->GetDecompressionDictionary() : nullptr));
+  }
+
+  /** Set the frame offsets of a seekable file, with one more entry than the
+   * number of frames. Skips then jump over whole frames. */
+  void
+  SetSeekTable(std::vector<uint64_t> compressedOffsets, std::vector<uint64_t> decompressedOffsets)
+  {
+    m_CompressedOffsets = std::move(compressedOffsets);
+    m_DecompressedOffsets = std::move(decompressedOffsets);
+  }
+
+protected:
+  bool
+  ReadBytes(void * data, size_t size) override
+  {
+    ITK_WASM_COUNT_COPY(Zstd, size);
+    ZSTD_outBuffer output{ data, size, 0 };
+    while (output.pos < output.size)
+    {
+      const size_t previousPosition = output.pos;
+      const size_t result = ZSTD_decompressStream(m_Context, &output, &m_Input);
+      if (ZSTD_isError(result))
+      {
+        return false;
+      }
+      if (output.pos == previousPosition && m_Input.pos == m_Input.size)
+      {
+        const uint64_t fileSize = m_Reader->GetSize();
+        const size_t inputSize = static_cast<size_t>(
+          std::min<uint64_t>(m_InputData.size(), fileSize - std::min(m_InputOffset, fileSize)));
+        if (inputSize == 0 || !m_Reader->Read(m_InputOffset, m_InputData.data(), inputSize))
+        {
+          return false;
+        }
+        m_InputOffset += inputSize;
+        m_Input.size = inputSize;
+        m_Input.pos = 0;
+      }
+    }
+    return true;
+  }
+
+  bool
+  SkipBytes(uint64_t size) override
+  {
+    const uint64_t target = this->GetPosition() + size;
+    if (!m_DecompressedOffsets.empty())
+    {
+      const auto frameOf = [this](uint64_t position) {
+        return static_cast<size_t>(std::upper_bound(m_DecompressedOffsets.begin(), m_DecompressedOffsets.end(), position) -
+                                   m_DecompressedOffsets.begin()) - 1;
+      };
+      const size_t targetFrame = frameOf(target);
+      if (targetFrame > frameOf(this->GetPosition()) && targetFrame < m_CompressedOffsets.size())
+      {
+        // Start decoding at the independent frame that holds the target. The
+        // session reset keeps the dictionary.
+        m_InputOffset = m_CompressedOffsets[targetFrame];
+        ZSTD_DCtx_reset(m_Context, ZSTD_reset_session_only);
+        m_Input.size = 0;
+        m_Input.pos = 0;
+        return CBORSource::SkipBytes(target - m_DecompressedOffsets[targetFrame]);
+      }
+    }
+    return CBORSource::SkipBytes(size);
+  }
+
+private:
+  std::unique_ptr<RangeReader> m_Reader;
+  std::shared_ptr<const ZstdDictionary> m_Dictionary;
+  uint64_t m_InputOffset{ 0 };
+  ZSTD_DCtx * m_Context;
+  std::vector<char> m_InputData;
+  ZSTD_inBuffer m_Input;
+  std::vector<uint64_t> m_CompressedOffsets;
+  std::vector<uint64_t> m_DecompressedOffsets;
+};
+
+/**
+ *\class ZstdCBORSink
+ * \brief Compress the encoded items into a .cbor.zst file as they are written
+ *
+ * Extra memory is bounded by the zstd stream buffers. The frame content size
+ * is pledged when known, so single-shot decoders can size their output.
+ *
+ * With a seekable frame size, the output is split into independent frames of
+ * that many decompressed bytes, followed by a seek table in the zstd
+ * seekable format. Regular zstd decoders decompress the concatenated frames
+ * and skip the seek table.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class ZstdCBORSink : public CBORSink
+{
+public:
+  ZstdCBORSink(FILE * file, int compressionLevel, uint64_t pledgedSize = ZSTD_CONTENTSIZE_UNKNOWN)
+    : m_File(file)
+    , m_Context(ZSTD_createCCtx())
+    , m_OutputData(ZSTD_CStreamOutSize())
+    , m_CompressionLevel(compressionLevel)
+    , m_PledgedSize(pledgedSize)
+  {
+    ZSTD_CCtx_setParameter(m_Context, ZSTD_c_compressionLevel, compressionLevel);
+  }
+
+  ~ZstdCBORSink() override
+  {
+    ZSTD_freeCCtx(m_Context);
+    fclose(m_File);
+  }
+
+  /** Compress with worker threads while the caller encodes the next items.
+   * Returns false, and compression stays single threaded, when libzstd is
+   * built without ZSTD_MULTITHREAD. Call before the first write. */
+  bool
+  SetNumberOfWorkers(unsigned int numberOfWorkers)
+  {
+    return !ZSTD_isError(ZSTD_CCtx_setParameter(m_Context, ZSTD_c_nbWorkers, static_cast<int>(numberOfWorkers)));
+  }
+
+  /** Long-distance matching finds repeats across a large window, which helps
+   * volumes with repeated slices. Call before the first write. */
+  bool
+  SetLongDistanceMatching(bool enable)
+  {
+    return !ZSTD_isError(ZSTD_CCtx_setParameter(m_Context, ZSTD_c_enableLongDistanceMatching, enable ? 1 : 0));
+  }
+
+  /** Compress every frame with the dictionary, digested at the compression
+   * level. Frame headers record the dictionary ID. Call before the first
+   * write. Returns false if the dictionary cannot be referenced. */
+  bool
+  SetDictionary(std::shared_ptr<const ZstdDictionary> dictionary)
+  {
+    m_Dictionary = std::move(dictionary);
+    const ZSTD_CDict * compressionDictionary =
+      m_Dictionary ? m_Dictionary->GetCompressionDictionary(m_CompressionLevel) : nullptr;
+    if (m_Dictionary && compressionDictionary == nullptr)
+    {
+      return false;
+    }
+    return !ZSTD_isError(ZSTD_CCtx_refCDict(m_Context, compressionDictionary));
+  }
+
+  /** Decompressed bytes per independent frame, 0 for a single frame. Call
+   * before the first write. */
+  void
+  SetSeekableFrameSize(uint64_t frameSize)
+  {
+    // Seek table entries are 32-bit
+    m_SeekableFrameSize = std::min<uint64_t>(frameSize, MaximumSeekableFrameSize);
+  }
+
+  /** Magic numbers of the zstd seekable format seek table. */
+  static constexpr uint32_t SeekTableSkippableMagicNumber = 0x184D2A5E;
+  static constexpr uint32_t SeekableMagicNumber = 0x8F92EAB1;
+  static constexpr uint64_t MaximumSeekableFrameSize = uint64_t{ 1 } << 30;
+
+protected:
+  bool
+  WriteBytes(const void * data, size_t size) override
+  {
+    ITK_WASM_COUNT_COPY(Zstd, size);
+    const char * bytes = static_cast<const char *>(data);
+    while (size > 0)
+    {
+      size_t chunkSize = size;
+      if (m_SeekableFrameSize > 0)
+      {
+        chunkSize = static_cast<size_t>(std::min<uint64_t>(size, m_SeekableFrameSize - m_FrameDecompressedSize));
+      }
+      if (m_FrameDecompressedSize == 0 && !this->StartFrame())
+      {
+        return false;
+      }
+      ZSTD_inBuffer input{ bytes, chunkSize, 0 };
+      while (input.pos < input.size)
+      {
+        if (!this->Compress(input, ZSTD_e_continue))
+        {
+          return false;
+        }
+      }
+      m_FrameDecompressedSize += chunkSize;
+      m_TotalDecompressedSize += chunkSize;
+      bytes += chunkSize;
+      size -= chunkSize;
+      if (m_SeekableFrameSize > 0 && m_FrameDecompressedSize == m_SeekableFrameSize && !this->EndFrame())
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool
+  Flush() override
+  {
+    if ((m_FrameDecompressedSize > 0 || m_FrameSizes.empty()) && !this->EndFrame())
+    {
+      return false;
+    }
+    if (m_SeekableFrameSize > 0 && !this->WriteSeekTable())
+    {
+      return false;
+    }
+    return fflush(m_File) == 0;
+  }
+
+private:
+  bool
+  StartFrame()
+  {
+    uint64_t pledgedSize = m_PledgedSize;
+    if (m_PledgedSize != ZSTD_CONTENTSIZE_UNKNOWN && m_SeekableFrameSize > 0)
+    {
+      pledgedSize = std::min(m_SeekableFrameSize, m_PledgedSize - m_TotalDecompressedSize);
+    }
+    return !ZSTD_isError(ZSTD_CCtx_setPledgedSrcSize(m_Context, pledgedSize));
+  }
+
+  bool
+  EndFrame()
+  {
+    if (m_FrameDecompressedSize == 0 && !this->StartFrame())
+    {
+      return false;
+    }
+    ZSTD_inBuffer input{ nullptr, 0, 0 };
+    while (true)
+    {
+      ZSTD_outBuffer output{ m_OutputData.data(), m_OutputData.size(), 0 };
+      const size_t remaining = ZSTD_compressStream2(m_Context, &output, &input, ZSTD_e_end);
+      if (ZSTD_isError(remaining) || !this->WriteOutput(output))
+      {
+        return false;
+      }
+      if (remaining == 0)
+      {
+        break;
+      }
+    }
+    m_FrameSizes.emplace_back(static_cast<uint32_t>(m_FrameCompressedSize), static_cast<uint32_t>(m_FrameDecompressedSize));
+    m_FrameCompressedSize = 0;
+    m_FrameDecompressedSize = 0;
+    return true;
+  }
+
+  bool
+  WriteSeekTable()
+  {
+    std::vector<unsigned char> table;
+    const auto appendUInt32 = [&table](uint32_t value) {
+      for (unsigned int ii = 0; ii < 4; ++ii)
+      {
+        table.push_back(static_cast<unsigned char>(value >> (8 * ii)));
+      }
+    };
+    const uint32_t numberOfFrames = static_cast<uint32_t>(m_FrameSizes.size());
+    const uint32_t frameSize = numberOfFrames * 8 + 9;
+    appendUInt32(SeekTableSkippableMagicNumber);
+    appendUInt32(frameSize);
+    for (const auto & sizes : m_FrameSizes)
+    {
+      appendUInt32(sizes.first);
+      appendUInt32(sizes.second);
+    }
+    appendUInt32(numberOfFrames);
+    // Seek_Table_Descriptor: no checksums
+    table.push_back(0);
+    appendUInt32(SeekableMagicNumber);
+    return fwrite(table.data(), 1, table.size(), m_File) == table.size();
+  }
+
+  bool
+  Compress(ZSTD_inBuffer & input, ZSTD_EndDirective mode)
+  {
+    ZSTD_outBuffer output{ m_OutputData.data(), m_OutputData.size(), 0 };
+    const size_t result = ZSTD_compressStream2(m_Context, &output, &input, mode);
+    return !ZSTD_isError(result) && this->WriteOutput(output);
+  }
+
+  bool
+  WriteOutput(const ZSTD_outBuffer & output)
+  {
+    m_FrameCompressedSize += output.pos;
+    return fwrite(m_OutputData.data(), 1, output.pos, m_File) == output.pos;
+  }
+
+  FILE * m_File;
+  ZSTD_CCtx * m_Context;
+  std::vector<char> m_OutputData;
+  int m_CompressionLevel;
+  std::shared_ptr<const ZstdDictionary> m_Dictionary;
+  uint64_t m_PledgedSize;
+  uint64_t m_SeekableFrameSize{ 0 };
+  uint64_t m_FrameCompressedSize{ 0 };
+  uint64_t m_FrameDecompressedSize{ 0 };
+  uint64_t m_TotalDecompressedSize{ 0 };
+  std::vector<std::pair<uint32_t, uint32_t>> m_FrameSizes;
+};
+
+/** Read the seek table at the end of a zstd seekable format file into the
+ * compressed and decompressed frame offsets, with one more entry than the
+ * number of frames. Returns false if the file has no seek table. */
+inline bool
+ReadZstdSeekTable(RangeReader & reader, std::vector<uint64_t> & compressedOffsets, std::vector<uint64_t> & decompressedOffsets)
+{
+  compressedOffsets.clear();
+  decompressedOffsets.clear();
+  const auto readUInt32 = [](const unsigned char * bytes) {
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+  };
+
+  unsigned char footer[9];
+  const uint64_t fileSize = reader.GetSize();
+  if (fileSize < 17 || !reader.Read(fileSize - 9, footer, 9) ||
+      readUInt32(footer + 5) != ZstdCBORSink::SeekableMagicNumber)
+  {
+    return false;
+  }
+  const uint32_t numberOfFrames = readUInt32(footer);
+  const size_t entrySize = (footer[4] & 0x80) ? 12 : 8;
+  const uint64_t tableSize = 8 + numberOfFrames * entrySize + 9;
+  if (tableSize > fileSize)
+  {
+    return false;
+  }
+  std::vector<unsigned char> table(tableSize - 9);
+  if (!reader.Read(fileSize - tableSize, table.data(), table.size()) ||
+      readUInt32(table.data()) != ZstdCBORSink::SeekTableSkippableMagicNumber)
+  {
+    return false;
+  }
+
+  compressedOffsets.reserve(numberOfFrames + 1);
+  decompressedOffsets.reserve(numberOfFrames + 1);
+  compressedOffsets.push_back(0);
+  decompressedOffsets.push_back(0);
+  for (uint32_t ii = 0; ii < numberOfFrames; ++ii)
+  {
+    const unsigned char * entry = table.data() + 8 + ii * entrySize;
+    compressedOffsets.push_back(compressedOffsets.back() + readUInt32(entry));
+    decompressedOffsets.push_back(decompressedOffsets.back() + readUInt32(entry + 4));
+  }
+  if (compressedOffsets.back() != fileSize - tableSize)
+  {
+    compressedOffsets.clear();
+    decompressedOffsets.clear();
+    return false;
+  }
+  return true;
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,184 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmZstdDictionary_h
+#define itkWasmZstdDictionary_h
+
+#include "itkWasmRangeReader.h"
+
+#include "zstd.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/**
+ *\class ZstdDictionary
+ * \brief A zstd dictionary, digested for compression and decompression
+ *
+ * Dictionaries help the most with many small, similar payloads, e.g. label
+ * tiles or per-slice metadata, where a frame alone has too little history
+ * to find repeats. Digesting a dictionary costs more than compressing a
+ * small payload, so dictionaries are cached by content for the life of the
+ * process: the IO objects of a run, and the runs of a pipeline in reactor
+ * mode, share the digested ZSTD_CDict and ZSTD_DDict.
+ *
+ * Only included by the zstd IO's and pipelines, which link libzstd.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class ZstdDictionary
+{
+public:
+  /** The cached dictionary with this content. Returns nullptr if a
+   * decompression dictionary cannot be created. */
+  static std::shared_ptr<const ZstdDictionary>
+  Get(std::vector<char> content)
+  {
+    static std::mutex mutex;
+    // The most recently used first
+    static std::vector<std::shared_ptr<const ZstdDictionary>> cache;
+    const std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = cache.begin(); it != cache.end(); ++it)
+    {
+      const std::vector<char> & cached = (*it)->m_Content;
+      if (cached.size() == content.size() && std::memcmp(cached.data(), content.data(), content.size()) == 0)
+      {
+        std::shared_ptr<const ZstdDictionary> dictionary = *it;
+        cache.erase(it);
+        cache.insert(cache.begin(), dictionary);
+        return dictionary;
+      }
+    }
+
+    std::shared_ptr<const ZstdDictionary> dictionary(new ZstdDictionary(std::move(content)));
+    if (dictionary->m_DecompressionDictionary == nullptr)
+    {
+      return nullptr;
+    }
+    cache.insert(cache.begin(), dictionary);
+    if (cache.size() > CacheSize)
+    {
+      cache.pop_back();
+    }
+    return dictionary;
+  }
+
+  /** Read a dictionary file or URL. Returns nullptr if it cannot be read. */
+  static std::shared_ptr<const ZstdDictionary>
+  Read(const std::string & name)
+  {
+    std::vector<char> content;
+    if (!ReadRangeResource(name, content) || content.empty())
+    {
+      return nullptr;
+    }
+    return Get(std::move(content));
+  }
+
+  ~ZstdDictionary()
+  {
+    for (const auto & levelDictionary : m_CompressionDictionaries)
+    {
+      ZSTD_freeCDict(levelDictionary.second);
+    }
+    ZSTD_freeDDict(m_DecompressionDictionary);
+  }
+
+  ZstdDictionary(const ZstdDictionary &) = delete;
+  ZstdDictionary &
+  operator=(const ZstdDictionary &) = delete;
+
+  /** Dictionary ID recorded in the frame headers, 0 for a raw content
+   * dictionary without the zstd dictionary header. */
+  unsigned int
+  GetID() const
+  {
+    return ZSTD_getDictID_fromDict(m_Content.data(), m_Content.size());
+  }
+
+  /** The dictionary digested for compression at the level, created on first
+   * use. Returns nullptr on an allocation failure. */
+  const ZSTD_CDict *
+  GetCompressionDictionary(int compressionLevel) const
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    for (const auto & levelDictionary : m_CompressionDictionaries)
+    {
+      if (levelDictionary.first == compressionLevel)
+      {
+        return levelDictionary.second;
+      }
+    }
+    ZSTD_CDict * dictionary = ZSTD_createCDict(m_Content.data(), m_Content.size(), compressionLevel);
+    if (dictionary != nullptr)
+    {
+      m_CompressionDictionaries.emplace_back(compressionLevel, dictionary);
+    }
+    return dictionary;
+  }
+
+  const ZSTD_DDict *
+  GetDecompressionDictionary() const
+  {
+    return m_DecompressionDictionary;
+  }
+
+  static constexpr size_t CacheSize = 4;
+
+private:
+  explicit ZstdDictionary(std::vector<char> content)
+    : m_Content(std::move(content))
+    , m_DecompressionDictionary(ZSTD_createDDict(m_Content.data(), m_Content.size()))
+  {}
+
+  const std::vector<char> m_Content;
+  ZSTD_DDict * m_DecompressionDictionary;
+  mutable std::mutex m_Mutex;
+  mutable std::vector<std::pair<int, ZSTD_CDict *>> m_CompressionDictionaries;
+};
+
+/** Dictionary ID recorded in the header of the first zstd frame of the
+ * reader, 0 if the frame was compressed without a dictionary or does not
+ * record its ID. */
+inline unsigned int
+ReadZstdFrameDictionaryID(RangeReader & reader)
+{
+  // ZSTD_FRAMEHEADERSIZE_MAX
+  char header[18];
+  const size_t size = static_cast<size_t>(std::min<uint64_t>(sizeof(header), reader.GetSize()));
+  if (!reader.Read(0, header, size))
+  {
+    return 0;
+  }
+  return ZSTD_getDictID_fromFrame(header, size);
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
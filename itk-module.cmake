@@ -10,6 +10,9 @@ itk_module(WebAssemblyInterface
     ITKIOImageBase
     ITKIOMeshBase
   COMPILE_DEPENDS
+    ITKTransform
+    ITKDisplacementField
+    ITKIOTransformBase
     MeshToPolyData
     ITKImageFunction
   TEST_DEPENDS
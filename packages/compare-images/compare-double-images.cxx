@@ -16,6 +16,14 @@
  *
  *=========================================================================*/
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <tuple>
 #include <vector>
 
 #include "itkPipeline.h"
@@ -28,11 +36,301 @@
 #include "itkRescaleIntensityImageFilter.h"
 #include "itkExtractImageFilter.h"
 #include "itkTestingComparisonImageFilter.h"
+#include "itkConstNeighborhoodIterator.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNeighborhoodAlgorithm.h"
 
 #include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
+// Whether the images have the same geometry and bitwise identical pixels,
+// so every difference of a comparison is zero
+template<typename TImage>
+bool
+IdenticalImages(const TImage * image0, const TImage * image1)
+{
+  const auto region = image0->GetLargestPossibleRegion();
+  if (region != image1->GetLargestPossibleRegion() || region != image0->GetBufferedRegion() ||
+      region != image1->GetBufferedRegion() || image0->GetSpacing() != image1->GetSpacing() ||
+      image0->GetOrigin() != image1->GetOrigin() || image0->GetDirection() != image1->GetDirection())
+  {
+    return false;
+  }
+  const size_t bufferSize = region.GetNumberOfPixels() * sizeof(typename TImage::PixelType);
+  return image0->GetBufferPointer() == image1->GetBufferPointer() ||
+         std::memcmp(image0->GetBufferPointer(), image1->GetBufferPointer(), bufferSize) == 0;
+}
+
+// Compare as ComparisonImageFilter does, without a difference image. The
+// threads share the number of pixels with differences and stop once it
+// exceeds numberOfPixelsTolerance, so the number and the statistics are
+// only complete when the number is within the tolerance.
+template<typename TImage>
+std::tuple<uint64_t, double, double, double>
+CountPixelsWithDifferences(const TImage * validImage,
+                           const TImage * testImage,
+                           double differenceThreshold,
+                           unsigned int radiusTolerance,
+                           bool ignoreBoundaryPixels,
+                           uint64_t numberOfPixelsTolerance)
+{
+  using ImageType = TImage;
+  using RegionType = typename ImageType::RegionType;
+  using FacesCalculatorType = itk::NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<ImageType>;
+  using NeighborhoodIteratorType = itk::ConstNeighborhoodIterator<ImageType>;
+  using ValidIteratorType = itk::ImageRegionConstIterator<ImageType>;
+
+  typename NeighborhoodIteratorType::RadiusType radius;
+  radius.Fill(radiusTolerance);
+
+  std::atomic<uint64_t> numberOfPixelsWithDifferences{ 0 };
+  std::mutex statisticsMutex;
+  double minimumDifference = itk::NumericTraits<double>::max();
+  double maximumDifference = itk::NumericTraits<double>::NonpositiveMin();
+  double totalDifference = 0.0;
+
+  itk::MultiThreaderBase::New()->ParallelizeImageRegion<ImageType::ImageDimension>(
+    validImage->GetLargestPossibleRegion(),
+    [&](const RegionType & workRegion) {
+      double workMinimum = itk::NumericTraits<double>::max();
+      double workMaximum = itk::NumericTraits<double>::NonpositiveMin();
+      double workTotal = 0.0;
+
+      FacesCalculatorType facesCalculator;
+      const auto faceList = facesCalculator(testImage, workRegion, radius);
+      for (auto face = faceList.begin(); face != faceList.end(); ++face)
+      {
+        // The first face is the region away from the image boundary
+        if (ignoreBoundaryPixels && face != faceList.begin())
+        {
+          break;
+        }
+        NeighborhoodIteratorType test(radius, testImage, *face);
+        ValidIteratorType valid(validImage, *face);
+        const unsigned int neighborhoodSize = test.Size();
+        for (valid.GoToBegin(), test.GoToBegin(); !valid.IsAtEnd(); ++valid, ++test)
+        {
+          if (numberOfPixelsWithDifferences.load(std::memory_order_relaxed) > numberOfPixelsTolerance)
+          {
+            break;
+          }
+          const double t = static_cast<double>(valid.Get());
+          double difference = std::abs(t - static_cast<double>(test.GetCenterPixel()));
+          for (unsigned int ii = 0; ii < neighborhoodSize && difference > differenceThreshold; ++ii)
+          {
+            difference = std::min(difference, std::abs(t - static_cast<double>(test.GetPixel(ii))));
+          }
+          if (difference > differenceThreshold)
+          {
+            workMinimum = std::min(workMinimum, difference);
+            workMaximum = std::max(workMaximum, difference);
+            workTotal += difference;
+            numberOfPixelsWithDifferences.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      }
+
+      const std::lock_guard<std::mutex> lock(statisticsMutex);
+      minimumDifference = std::min(minimumDifference, workMinimum);
+      maximumDifference = std::max(maximumDifference, workMaximum);
+      totalDifference += workTotal;
+    },
+    nullptr);
+
+  return { numberOfPixelsWithDifferences.load(), minimumDifference, maximumDifference, totalDifference };
+}
+
+// Lower bound of each bin of the absolute difference histogram: zero, then
+// powers of ten from 1e-8 to 1e7
+constexpr unsigned int DifferenceHistogramSize = 17;
+
+double
+DifferenceHistogramLowerBound(unsigned int bin)
+{
+  return bin == 0 ? 0.0 : std::pow(10.0, static_cast<double>(bin) - 9.0);
+}
+
+unsigned int
+DifferenceHistogramBin(double difference)
+{
+  if (!(difference >= 1e-8))
+  {
+    return 0;
+  }
+  // The exponent is negative for differences below 1
+  const int bin = static_cast<int>(std::floor(std::log10(difference))) + 9;
+  return static_cast<unsigned int>(std::clamp(bin, 0, static_cast<int>(DifferenceHistogramSize) - 1));
+}
+
+struct ImageQualityMetrics
+{
+  double meanSquaredError{ 0.0 };
+  // Peak signal to noise ratio for the dynamic range of the test image.
+  // Not set when the images are equal or the test image is constant.
+  std::optional<double> peakSignalToNoiseRatio;
+  // Mean of the structural similarity of 8 pixel wide blocks along the
+  // first three axes
+  double structuralSimilarity{ 1.0 };
+  double dynamicRange{ 0.0 };
+  std::array<uint64_t, DifferenceHistogramSize> differenceHistogram{};
+};
+
+// Pixel by pixel image quality metrics of the test image with a baseline,
+// computed in one pass over tiles of both images on separate threads.
+// Returns nothing if the images are not on the same grid.
+template<typename TImage>
+std::optional<ImageQualityMetrics>
+ComputeImageQualityMetrics(const TImage * testImage, const TImage * baselineImage)
+{
+  using ImageType = TImage;
+  constexpr unsigned int Dimension = ImageType::ImageDimension;
+  using RegionType = typename ImageType::RegionType;
+  using IteratorType = itk::ImageRegionConstIterator<ImageType>;
+
+  const RegionType region = testImage->GetLargestPossibleRegion();
+  if (region != baselineImage->GetLargestPossibleRegion() || region != testImage->GetBufferedRegion() ||
+      region != baselineImage->GetBufferedRegion() || region.GetNumberOfPixels() == 0)
+  {
+    return std::nullopt;
+  }
+
+  constexpr itk::SizeValueType BlockWidth = 8;
+  typename RegionType::SizeType blockSize;
+  typename RegionType::SizeType numberOfBlocks;
+  itk::SizeValueType totalNumberOfBlocks = 1;
+  for (unsigned int dim = 0; dim < Dimension; ++dim)
+  {
+    blockSize[dim] = dim < 3 ? BlockWidth : 1;
+    numberOfBlocks[dim] = (region.GetSize(dim) + blockSize[dim] - 1) / blockSize[dim];
+    totalNumberOfBlocks *= numberOfBlocks[dim];
+  }
+
+  // The structural similarity depends on the dynamic range, which is only
+  // known after the pass, so the block moments are kept
+  struct BlockMoments
+  {
+    double meanTest;
+    double meanBaseline;
+    double varianceTest;
+    double varianceBaseline;
+    double covariance;
+  };
+  std::vector<BlockMoments> blockMoments(totalNumberOfBlocks);
+
+  // Chunks of blocks, reduced in order so the result does not depend on the
+  // number of threads
+  constexpr itk::SizeValueType ChunkSize = 64;
+  const itk::SizeValueType numberOfChunks = (totalNumberOfBlocks + ChunkSize - 1) / ChunkSize;
+  struct ChunkSums
+  {
+    double squaredError{ 0.0 };
+    double minimum{ itk::NumericTraits<double>::max() };
+    double maximum{ itk::NumericTraits<double>::NonpositiveMin() };
+    std::array<uint64_t, DifferenceHistogramSize> histogram{};
+  };
+  std::vector<ChunkSums> chunkSums(numberOfChunks);
+
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](itk::SizeValueType chunk) {
+      ChunkSums & sums = chunkSums[chunk];
+      const itk::SizeValueType endBlock = std::min(totalNumberOfBlocks, (chunk + 1) * ChunkSize);
+      for (itk::SizeValueType block = chunk * ChunkSize; block < endBlock; ++block)
+      {
+        RegionType blockRegion;
+        itk::SizeValueType remainder = block;
+        for (unsigned int dim = 0; dim < Dimension; ++dim)
+        {
+          const itk::SizeValueType blockIndex = remainder % numberOfBlocks[dim];
+          remainder /= numberOfBlocks[dim];
+          const itk::SizeValueType offset = blockIndex * blockSize[dim];
+          blockRegion.SetIndex(dim, region.GetIndex(dim) + static_cast<itk::IndexValueType>(offset));
+          blockRegion.SetSize(dim, std::min(blockSize[dim], region.GetSize(dim) - offset));
+        }
+
+        // Two passes over the block, which stays in cache, for the centered
+        // second moments
+        IteratorType test(testImage, blockRegion);
+        IteratorType baseline(baselineImage, blockRegion);
+        double sumTest = 0.0;
+        double sumBaseline = 0.0;
+        for (; !test.IsAtEnd(); ++test, ++baseline)
+        {
+          const double t = static_cast<double>(test.Get());
+          const double b = static_cast<double>(baseline.Get());
+          const double difference = t - b;
+          sums.squaredError += difference * difference;
+          sums.minimum = std::min(sums.minimum, t);
+          sums.maximum = std::max(sums.maximum, t);
+          ++sums.histogram[DifferenceHistogramBin(std::abs(difference))];
+          sumTest += t;
+          sumBaseline += b;
+        }
+        const double numberOfPixels = static_cast<double>(blockRegion.GetNumberOfPixels());
+        BlockMoments & moments = blockMoments[block];
+        moments.meanTest = sumTest / numberOfPixels;
+        moments.meanBaseline = sumBaseline / numberOfPixels;
+        moments.varianceTest = 0.0;
+        moments.varianceBaseline = 0.0;
+        moments.covariance = 0.0;
+        for (test.GoToBegin(), baseline.GoToBegin(); !test.IsAtEnd(); ++test, ++baseline)
+        {
+          const double t = static_cast<double>(test.Get()) - moments.meanTest;
+          const double b = static_cast<double>(baseline.Get()) - moments.meanBaseline;
+          moments.varianceTest += t * t;
+          moments.varianceBaseline += b * b;
+          moments.covariance += t * b;
+        }
+        moments.varianceTest /= numberOfPixels;
+        moments.varianceBaseline /= numberOfPixels;
+        moments.covariance /= numberOfPixels;
+      }
+    },
+    nullptr);
+
+  ImageQualityMetrics qualityMetrics;
+  double squaredError = 0.0;
+  double minimum = itk::NumericTraits<double>::max();
+  double maximum = itk::NumericTraits<double>::NonpositiveMin();
+  for (const ChunkSums & sums : chunkSums)
+  {
+    squaredError += sums.squaredError;
+    minimum = std::min(minimum, sums.minimum);
+    maximum = std::max(maximum, sums.maximum);
+    for (unsigned int bin = 0; bin < DifferenceHistogramSize; ++bin)
+    {
+      qualityMetrics.differenceHistogram[bin] += sums.histogram[bin];
+    }
+  }
+  qualityMetrics.meanSquaredError = squaredError / static_cast<double>(region.GetNumberOfPixels());
+  qualityMetrics.dynamicRange = maximum - minimum;
+  if (qualityMetrics.meanSquaredError > 0.0 && qualityMetrics.dynamicRange > 0.0)
+  {
+    qualityMetrics.peakSignalToNoiseRatio =
+      10.0 * std::log10(qualityMetrics.dynamicRange * qualityMetrics.dynamicRange / qualityMetrics.meanSquaredError);
+  }
+
+  // The stabilizing constants of Wang et al. 2004
+  const double c1 = (0.01 * qualityMetrics.dynamicRange) * (0.01 * qualityMetrics.dynamicRange);
+  const double c2 = (0.03 * qualityMetrics.dynamicRange) * (0.03 * qualityMetrics.dynamicRange);
+  double structuralSimilarity = 0.0;
+  for (const BlockMoments & moments : blockMoments)
+  {
+    const double numerator = (2.0 * moments.meanTest * moments.meanBaseline + c1) * (2.0 * moments.covariance + c2);
+    const double denominator =
+      (moments.meanTest * moments.meanTest + moments.meanBaseline * moments.meanBaseline + c1) *
+      (moments.varianceTest + moments.varianceBaseline + c2);
+    // Equal constant blocks of a constant test image
+    structuralSimilarity += denominator > 0.0 ? numerator / denominator : 1.0;
+  }
+  qualityMetrics.structuralSimilarity = structuralSimilarity / static_cast<double>(totalNumberOfBlocks);
+
+  return qualityMetrics;
+}
+
 template<typename TImage>
 int
 CompareImages(itk::wasm::Pipeline & pipeline, const TImage * testImage)
@@ -70,15 +368,18 @@ CompareImages(itk::wasm::Pipeline & pipeline, const TImage * testImage)
   bool ignoreBoundaryPixels = false;
   pipeline.add_flag("-i,--ignore-boundary-pixels", ignoreBoundaryPixels, "Ignore boundary pixels. Useful when resampling may have introduced difference pixel values along the image edge.");
 
+  bool failFast = false;
+  pipeline.add_flag("--fail-fast", failFast, "Stop comparing a baseline once the number of pixels tolerance is exceeded, and stop at the first baseline within the tolerance. The metrics of a failing comparison are partial. Difference images are only computed if requested.");
+
+  bool imageQualityMetrics = false;
+  pipeline.add_flag("--image-quality-metrics", imageQualityMetrics, "Add the mean squared error, peak signal to noise ratio, structural similarity, and absolute difference histogram of the closest baseline to the metrics.");
+
   ITK_WASM_PARSE(pipeline);
 
-  using DiffType = itk::Testing::ComparisonImageFilter<ImageType, ImageType>;
-  auto diff = DiffType::New();
-  diff->SetValidInput(testImage);
+  const bool differenceImageRequested = !differenceImage.GetIdentifier().empty();
+  const bool differenceUchar2DImageRequested = !differenceUchar2DImage.GetIdentifier().empty();
 
-  diff->SetDifferenceThreshold(differenceThreshold);
-  diff->SetToleranceRadius(radiusTolerance);
-  diff->SetIgnoreBoundaryPixels(ignoreBoundaryPixels);
+  using DiffType = itk::Testing::ComparisonImageFilter<ImageType, ImageType>;
 
   double minimumDifference = itk::NumericTraits<double>::max();
   double maximumDifference = itk::NumericTraits<double>::NonpositiveMin();
@@ -86,34 +387,95 @@ CompareImages(itk::wasm::Pipeline & pipeline, const TImage * testImage)
   double meanDifference = 0.0;
   uint64_t numberOfPixelsWithDifferences = itk::NumericTraits<uint64_t>::max();
 
-  size_t bestBaselineIndex = 0;
-  size_t baselineCount = 0;
-  for (auto baselineImage : baselineImages)
+  const auto compareBaseline = [&](const ImageType * baselineImage) {
+    auto baselineDiff = DiffType::New();
+    baselineDiff->SetValidInput(testImage);
+    baselineDiff->SetTestInput(baselineImage);
+    baselineDiff->SetDifferenceThreshold(differenceThreshold);
+    baselineDiff->SetToleranceRadius(radiusTolerance);
+    baselineDiff->SetIgnoreBoundaryPixels(ignoreBoundaryPixels);
+    baselineDiff->UpdateLargestPossibleRegion();
+    return baselineDiff;
+  };
+
+  // A baseline identical to the test image has no differences with any
+  // threshold or radius, so the tolerant comparisons are skipped
+  bool identical = false;
+  const ImageType * bestBaselineImage = nullptr;
+  for (const auto & baselineImage : baselineImages)
   {
-    diff->SetTestInput(baselineImage.Get());
-    ITK_WASM_CATCH_EXCEPTION(pipeline, diff->UpdateLargestPossibleRegion());
+    if (IdenticalImages<ImageType>(testImage, baselineImage.Get()))
+    {
+      identical = true;
+      bestBaselineImage = baselineImage.Get();
+      break;
+    }
+  }
 
-    if (diff->GetNumberOfPixelsWithDifferences() <= numberOfPixelsWithDifferences)
+  typename DiffType::Pointer diff;
+  if (identical)
+  {
+    // The statistics keep their initial values, as ComparisonImageFilter
+    // reports them when no pixel differs
+    numberOfPixelsWithDifferences = 0;
+  }
+  else if (failFast)
+  {
+    for (const auto & baselineImage : baselineImages)
     {
+      uint64_t baselineNumberOfPixelsWithDifferences = 0;
+      double baselineMinimumDifference = 0.0;
+      double baselineMaximumDifference = 0.0;
+      double baselineTotalDifference = 0.0;
+      ITK_WASM_CATCH_EXCEPTION(pipeline, std::tie(baselineNumberOfPixelsWithDifferences, baselineMinimumDifference, baselineMaximumDifference, baselineTotalDifference) =
+        CountPixelsWithDifferences<ImageType>(testImage, baselineImage.Get(), differenceThreshold, radiusTolerance, ignoreBoundaryPixels, numberOfPixelsTolerance));
+
+      if (baselineNumberOfPixelsWithDifferences <= numberOfPixelsWithDifferences)
+      {
+        numberOfPixelsWithDifferences = baselineNumberOfPixelsWithDifferences;
+        minimumDifference = baselineMinimumDifference;
+        maximumDifference = baselineMaximumDifference;
+        totalDifference = baselineTotalDifference;
+        meanDifference = numberOfPixelsWithDifferences > 0 ? totalDifference / numberOfPixelsWithDifferences : 0.0;
+        bestBaselineImage = baselineImage.Get();
+      }
+      if (numberOfPixelsWithDifferences <= numberOfPixelsTolerance)
+      {
+        break;
+      }
+    }
+
+    if (differenceImageRequested || differenceUchar2DImageRequested)
+    {
+      ITK_WASM_CATCH_EXCEPTION(pipeline, diff = compareBaseline(bestBaselineImage));
       minimumDifference = diff->GetMinimumDifference();
       maximumDifference = diff->GetMaximumDifference();
       totalDifference = diff->GetTotalDifference();
       meanDifference = diff->GetMeanDifference();
       numberOfPixelsWithDifferences = diff->GetNumberOfPixelsWithDifferences();
-      bestBaselineIndex = baselineCount;
     }
-    ++baselineCount;
   }
-
-  if (bestBaselineIndex != baselineCount)
+  else
   {
-    diff->SetTestInput(baselineImages[bestBaselineIndex].Get());
-    ITK_WASM_CATCH_EXCEPTION(pipeline, diff->UpdateLargestPossibleRegion());
-
-    minimumDifference = diff->GetMinimumDifference();
-    maximumDifference = diff->GetMaximumDifference();
-    totalDifference = diff->GetTotalDifference();
-    meanDifference = diff->GetMeanDifference();
+    // Each baseline has its own filter, and the filter of the best baseline
+    // so far is kept with its statistics and difference image, so the best
+    // baseline is not compared again.
+    for (const auto & baselineImage : baselineImages)
+    {
+      typename DiffType::Pointer baselineDiff;
+      ITK_WASM_CATCH_EXCEPTION(pipeline, baselineDiff = compareBaseline(baselineImage.Get()));
+
+      if (baselineDiff->GetNumberOfPixelsWithDifferences() <= numberOfPixelsWithDifferences)
+      {
+        minimumDifference = baselineDiff->GetMinimumDifference();
+        maximumDifference = baselineDiff->GetMaximumDifference();
+        totalDifference = baselineDiff->GetTotalDifference();
+        meanDifference = baselineDiff->GetMeanDifference();
+        numberOfPixelsWithDifferences = baselineDiff->GetNumberOfPixelsWithDifferences();
+        diff = baselineDiff;
+        bestBaselineImage = baselineImage.Get();
+      }
+    }
   }
 
   const bool almostEqual = (numberOfPixelsWithDifferences <= numberOfPixelsTolerance);
@@ -146,15 +508,75 @@ CompareImages(itk::wasm::Pipeline & pipeline, const TImage * testImage)
   meanDifferenceValue.SetDouble(meanDifference);
   metricsJson.AddMember("meanDifference", meanDifferenceValue, allocator);
 
+  if (imageQualityMetrics)
+  {
+    std::optional<ImageQualityMetrics> qualityMetrics;
+    ITK_WASM_CATCH_EXCEPTION(pipeline, qualityMetrics = ComputeImageQualityMetrics<ImageType>(testImage, bestBaselineImage));
+    if (qualityMetrics)
+    {
+      rapidjson::Value meanSquaredErrorValue;
+      meanSquaredErrorValue.SetDouble(qualityMetrics->meanSquaredError);
+      metricsJson.AddMember("meanSquaredError", meanSquaredErrorValue, allocator);
+
+      rapidjson::Value peakSignalToNoiseRatioValue;
+      if (qualityMetrics->peakSignalToNoiseRatio)
+      {
+        peakSignalToNoiseRatioValue.SetDouble(*qualityMetrics->peakSignalToNoiseRatio);
+      }
+      metricsJson.AddMember("peakSignalToNoiseRatio", peakSignalToNoiseRatioValue, allocator);
+
+      rapidjson::Value structuralSimilarityValue;
+      structuralSimilarityValue.SetDouble(qualityMetrics->structuralSimilarity);
+      metricsJson.AddMember("structuralSimilarity", structuralSimilarityValue, allocator);
+
+      rapidjson::Value dynamicRangeValue;
+      dynamicRangeValue.SetDouble(qualityMetrics->dynamicRange);
+      metricsJson.AddMember("dynamicRange", dynamicRangeValue, allocator);
+
+      rapidjson::Value differenceHistogramValue(rapidjson::kArrayType);
+      for (unsigned int bin = 0; bin < DifferenceHistogramSize; ++bin)
+      {
+        rapidjson::Value binValue(rapidjson::kObjectType);
+        binValue.AddMember("lowerBound", rapidjson::Value(DifferenceHistogramLowerBound(bin)), allocator);
+        binValue.AddMember("count", rapidjson::Value(qualityMetrics->differenceHistogram[bin]), allocator);
+        differenceHistogramValue.PushBack(binValue, allocator);
+      }
+      metricsJson.AddMember("differenceHistogram", differenceHistogramValue, allocator);
+    }
+  }
+
   rapidjson::StringBuffer stringBuffer;
   rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
   metricsJson.Accept(writer);
 
   metrics.Get() << stringBuffer.GetString();
 
-  typename ImageType::ConstPointer difference = diff->GetOutput();
+  typename ImageType::ConstPointer difference;
+  if (diff.IsNotNull())
+  {
+    difference = diff->GetOutput();
+  }
+  else if (identical && (differenceImageRequested || differenceUchar2DImageRequested))
+  {
+    auto zeroDifference = ImageType::New();
+    zeroDifference->CopyInformation(testImage);
+    zeroDifference->SetRegions(testImage->GetLargestPossibleRegion());
+    zeroDifference->Allocate(true);
+    difference = zeroDifference;
+  }
+  if (difference.IsNull())
+  {
+    // No difference images were requested
+    return EXIT_SUCCESS;
+  }
+
   differenceImage.Set(difference);
 
+  if (!differenceUchar2DImageRequested)
+  {
+    return EXIT_SUCCESS;
+  }
+
   using ExtractType = itk::ExtractImageFilter<ImageType, Image2DType>;
   using RescaleType = itk::RescaleIntensityImageFilter<Image2DType, Uchar2DImageType>;
 
@@ -165,7 +587,7 @@ CompareImages(itk::wasm::Pipeline & pipeline, const TImage * testImage)
   typename ImageType::SizeType size;
   size.Fill(0);
 
-  size = diff->GetOutput()->GetLargestPossibleRegion().GetSize();
+  size = difference->GetLargestPossibleRegion().GetSize();
   for (unsigned int i = 2; i < ImageType::ImageDimension; ++i)
   {
     index[i] = size[i] / 2;
@@ -177,7 +599,7 @@ CompareImages(itk::wasm::Pipeline & pipeline, const TImage * testImage)
   auto extract = ExtractType::New();
   extract->SetDirectionCollapseToSubmatrix();
 
-  extract->SetInput(diff->GetOutput());
+  extract->SetInput(difference);
   extract->SetExtractionRegion(region);
 
   auto rescale = RescaleType::New();
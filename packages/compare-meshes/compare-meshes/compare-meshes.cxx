@@ -28,7 +28,87 @@
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Whether the container elements are contiguous, as in a VectorContainer
+template <typename TContainer>
+constexpr bool IsContiguousContainer = std::is_base_of_v<std::vector<typename TContainer::Element>, TContainer>;
+
+// Reductions of the element differences of two contiguous buffers of
+// VComponents components per element: the squared Euclidean distance of
+// points, or the absolute difference of scalars. Chunks are reduced on
+// separate threads with branch free loops that the compiler vectorizes,
+// and combined in order, so the result does not depend on the number of
+// threads.
+template <unsigned int VComponents, typename TValue>
+std::tuple<uint64_t, double, double, double>
+compareBuffers(
+    const TValue *buffer0,
+    const TValue *buffer1,
+    const size_t numberOfElements,
+    const double differenceThreshold,
+    double *differences)
+{
+  constexpr size_t chunkSize = 16384;
+  const size_t numberOfChunks = (numberOfElements + chunkSize - 1) / chunkSize;
+  std::vector<uint64_t> chunkNumberOfDifferences(numberOfChunks, 0);
+  std::vector<double> chunkMinimum(numberOfChunks, itk::NumericTraits<double>::max());
+  std::vector<double> chunkMaximum(numberOfChunks, 0.0);
+  std::vector<double> chunkSum(numberOfChunks, 0.0);
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfChunks, [&](itk::SizeValueType chunk) {
+    const size_t begin = chunk * chunkSize;
+    const size_t end = std::min(numberOfElements, begin + chunkSize);
+    uint64_t numberOfDifferences = 0;
+    double minimum = itk::NumericTraits<double>::max();
+    double maximum = 0.0;
+    double sum = 0.0;
+    for (size_t ii = begin; ii < end; ++ii)
+    {
+      double difference = 0.0;
+      if constexpr (VComponents == 1)
+      {
+        difference = std::abs(static_cast<double>(buffer0[ii]) - static_cast<double>(buffer1[ii]));
+      }
+      else
+      {
+        for (unsigned int component = 0; component < VComponents; ++component)
+        {
+          const double componentDifference = static_cast<double>(buffer0[ii * VComponents + component]) - static_cast<double>(buffer1[ii * VComponents + component]);
+          difference += componentDifference * componentDifference;
+        }
+      }
+      differences[ii] = difference;
+      minimum = std::min(minimum, difference);
+      maximum = std::max(maximum, difference);
+      sum += difference;
+      numberOfDifferences += difference > differenceThreshold;
+    }
+    chunkNumberOfDifferences[chunk] = numberOfDifferences;
+    chunkMinimum[chunk] = minimum;
+    chunkMaximum[chunk] = maximum;
+    chunkSum[chunk] = sum;
+  }, nullptr);
+
+  uint64_t numberOfDifferences = 0;
+  double minimum = itk::NumericTraits<double>::max();
+  double maximum = 0.0;
+  double sum = 0.0;
+  for (size_t chunk = 0; chunk < numberOfChunks; ++chunk)
+  {
+    numberOfDifferences += chunkNumberOfDifferences[chunk];
+    minimum = std::min(minimum, chunkMinimum[chunk]);
+    maximum = std::max(maximum, chunkMaximum[chunk]);
+    sum += chunkSum[chunk];
+  }
+  return {numberOfDifferences, minimum, maximum, sum};
+}
 
 template <typename TMesh, typename TDifference>
 std::tuple<bool, uint64_t, double, double, double>
@@ -54,22 +134,37 @@ comparePoints(
       sameNumberOfPoints = true;
       pointsDifference->resize(points0->Size());
 
-      PointsContainerConstIterator pt0 = points0->Begin();
-      PointsContainerConstIterator pt1 = points1->Begin();
-
-      while ((pt0 != points0->End()) && (pt1 != points1->End()))
+      if constexpr (IsContiguousContainer<typename MeshType::PointsContainer> && IsContiguousContainer<TDifference>)
       {
-        const auto difference = pt0.Value().SquaredEuclideanDistanceTo(pt1.Value());
-        pointsMinimumDifference = std::min(pointsMinimumDifference, difference);
-        pointsMaximumDifference = std::max(pointsMaximumDifference, difference);
-        pointsMeanDifference += difference;
-        pointsDifference->SetElement(pt0.Index(), difference);
-        if (difference > pointsDifferenceThreshold)
+        using PointType = typename MeshType::PointType;
+        using CoordinateType = typename PointType::ValueType;
+        static_assert(sizeof(PointType) == PointType::Dimension * sizeof(CoordinateType));
+        std::tie(numberOfPointsWithDifferences, pointsMinimumDifference, pointsMaximumDifference, pointsMeanDifference) =
+            compareBuffers<PointType::Dimension>(reinterpret_cast<const CoordinateType *>(points0->CastToSTLConstContainer().data()),
+                                                 reinterpret_cast<const CoordinateType *>(points1->CastToSTLConstContainer().data()),
+                                                 points0->Size(),
+                                                 pointsDifferenceThreshold,
+                                                 pointsDifference->CastToSTLContainer().data());
+      }
+      else
+      {
+        PointsContainerConstIterator pt0 = points0->Begin();
+        PointsContainerConstIterator pt1 = points1->Begin();
+
+        while ((pt0 != points0->End()) && (pt1 != points1->End()))
         {
-          ++numberOfPointsWithDifferences;
+          const auto difference = pt0.Value().SquaredEuclideanDistanceTo(pt1.Value());
+          pointsMinimumDifference = std::min(pointsMinimumDifference, difference);
+          pointsMaximumDifference = std::max(pointsMaximumDifference, difference);
+          pointsMeanDifference += difference;
+          pointsDifference->SetElement(pt0.Index(), difference);
+          if (difference > pointsDifferenceThreshold)
+          {
+            ++numberOfPointsWithDifferences;
+          }
+          ++pt0;
+          ++pt1;
         }
-        ++pt0;
-        ++pt1;
       }
 
       pointsMeanDifference /= points0->Size();
@@ -92,13 +187,366 @@ comparePoints(
   return {sameNumberOfPoints, numberOfPointsWithDifferences, pointsMinimumDifference, pointsMaximumDifference, pointsMeanDifference};
 }
 
+// Uniform grid over points, with about two points per grid cell, for
+// nearest neighbour queries
+template <typename TPointsContainer, unsigned int VDimension>
+class PointGrid
+{
+public:
+  using PointType = typename TPointsContainer::Element;
+  using IdentifierType = typename TPointsContainer::ElementIdentifier;
+
+  explicit PointGrid(const TPointsContainer *points)
+  {
+    m_Points.reserve(points->Size());
+    m_Identifiers.reserve(points->Size());
+    for (auto it = points->Begin(); it != points->End(); ++it)
+    {
+      std::array<double, VDimension> point;
+      for (unsigned int dim = 0; dim < VDimension; ++dim)
+      {
+        point[dim] = static_cast<double>(it.Value()[dim]);
+      }
+      m_Points.push_back(point);
+      m_Identifiers.push_back(it.Index());
+    }
+
+    std::array<double, VDimension> extent;
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      m_Origin[dim] = itk::NumericTraits<double>::max();
+      double maximum = itk::NumericTraits<double>::NonpositiveMin();
+      for (const auto &point : m_Points)
+      {
+        m_Origin[dim] = std::min(m_Origin[dim], point[dim]);
+        maximum = std::max(maximum, point[dim]);
+      }
+      extent[dim] = m_Points.empty() ? 0.0 : maximum - m_Origin[dim];
+      m_Size[dim] = 1;
+      m_Spacing[dim] = 1.0;
+    }
+
+    // Axes too thin for a second grid cell are not divided, and the width
+    // is recomputed over the remaining axes
+    const double numberOfGridCells = std::max(1.0, m_Points.size() / 2.0);
+    std::array<bool, VDimension> divided;
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      divided[dim] = extent[dim] > 0.0;
+    }
+    double width = 1.0;
+    bool changed = true;
+    while (changed)
+    {
+      changed = false;
+      double volume = 1.0;
+      unsigned int numberOfDividedAxes = 0;
+      for (unsigned int dim = 0; dim < VDimension; ++dim)
+      {
+        if (divided[dim])
+        {
+          volume *= extent[dim];
+          ++numberOfDividedAxes;
+        }
+      }
+      if (numberOfDividedAxes == 0)
+      {
+        break;
+      }
+      width = std::pow(volume / numberOfGridCells, 1.0 / numberOfDividedAxes);
+      for (unsigned int dim = 0; dim < VDimension; ++dim)
+      {
+        if (divided[dim] && extent[dim] < width)
+        {
+          divided[dim] = false;
+          changed = true;
+        }
+      }
+    }
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      if (divided[dim])
+      {
+        m_Size[dim] = static_cast<size_t>(std::min(std::ceil(extent[dim] / width), numberOfGridCells));
+        m_Spacing[dim] = extent[dim] / m_Size[dim];
+      }
+      else if (extent[dim] > 0.0)
+      {
+        m_Spacing[dim] = extent[dim];
+      }
+    }
+
+    // Counting sort of the points by grid cell
+    size_t gridSize = 1;
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      gridSize *= m_Size[dim];
+    }
+    m_CellStart.assign(gridSize + 1, 0);
+    std::vector<size_t> pointCells(m_Points.size());
+    for (size_t ii = 0; ii < m_Points.size(); ++ii)
+    {
+      pointCells[ii] = this->ToOffset(this->ToCell(m_Points[ii]));
+      ++m_CellStart[pointCells[ii] + 1];
+    }
+    for (size_t cell = 0; cell < gridSize; ++cell)
+    {
+      m_CellStart[cell + 1] += m_CellStart[cell];
+    }
+    m_CellPoints.resize(m_Points.size());
+    std::vector<size_t> cellEnd(m_CellStart.begin(), m_CellStart.end() - 1);
+    for (size_t ii = 0; ii < m_Points.size(); ++ii)
+    {
+      m_CellPoints[cellEnd[pointCells[ii]]++] = ii;
+    }
+  }
+
+  size_t
+  Size() const
+  {
+    return m_Points.size();
+  }
+
+  IdentifierType
+  GetIdentifier(size_t index) const
+  {
+    return m_Identifiers[index];
+  }
+
+  /** Identifier of the closest point and its squared distance. The grid must
+   * not be empty. */
+  std::pair<IdentifierType, double>
+  FindClosestPoint(const PointType &query) const
+  {
+    std::array<double, VDimension> point;
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      point[dim] = static_cast<double>(query[dim]);
+    }
+    const std::array<size_t, VDimension> center = this->ToCell(point);
+
+    size_t closest = 0;
+    double closestDistance = itk::NumericTraits<double>::max();
+    for (size_t ring = 0;; ++ring)
+    {
+      // Visit the grid cells at Chebyshev distance ring from the center
+      std::array<size_t, VDimension> first;
+      std::array<size_t, VDimension> last;
+      for (unsigned int dim = 0; dim < VDimension; ++dim)
+      {
+        first[dim] = center[dim] > ring ? center[dim] - ring : 0;
+        last[dim] = std::min(center[dim] + ring, m_Size[dim] - 1);
+      }
+      std::array<size_t, VDimension> cell = first;
+      bool done = false;
+      while (!done)
+      {
+        bool onRing = false;
+        for (unsigned int dim = 0; dim < VDimension; ++dim)
+        {
+          const size_t distance = cell[dim] > center[dim] ? cell[dim] - center[dim] : center[dim] - cell[dim];
+          onRing = onRing || distance == ring;
+        }
+        if (onRing)
+        {
+          const size_t offset = this->ToOffset(cell);
+          for (size_t ii = m_CellStart[offset]; ii < m_CellStart[offset + 1]; ++ii)
+          {
+            const auto &candidate = m_Points[m_CellPoints[ii]];
+            double distance = 0.0;
+            for (unsigned int dim = 0; dim < VDimension; ++dim)
+            {
+              distance += (candidate[dim] - point[dim]) * (candidate[dim] - point[dim]);
+            }
+            if (distance < closestDistance || (distance == closestDistance && m_CellPoints[ii] < closest))
+            {
+              closest = m_CellPoints[ii];
+              closestDistance = distance;
+            }
+          }
+        }
+
+        done = true;
+        for (unsigned int dim = 0; dim < VDimension; ++dim)
+        {
+          if (cell[dim] < last[dim])
+          {
+            ++cell[dim];
+            done = false;
+            break;
+          }
+          cell[dim] = first[dim];
+        }
+      }
+
+      // Points in the next rings are at least ring grid cell widths away
+      // along an axis that has grid cells left
+      double bound = itk::NumericTraits<double>::max();
+      bool remaining = false;
+      for (unsigned int dim = 0; dim < VDimension; ++dim)
+      {
+        if (center[dim] + ring + 1 < m_Size[dim] || center[dim] >= ring + 1)
+        {
+          remaining = true;
+          bound = std::min(bound, ring * m_Spacing[dim]);
+        }
+      }
+      if (!remaining || closestDistance <= bound * bound)
+      {
+        break;
+      }
+    }
+
+    return {m_Identifiers[closest], closestDistance};
+  }
+
+private:
+  std::array<size_t, VDimension>
+  ToCell(const std::array<double, VDimension> &point) const
+  {
+    std::array<size_t, VDimension> cell;
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      const double index = std::floor((point[dim] - m_Origin[dim]) / m_Spacing[dim]);
+      cell[dim] = index <= 0.0 ? 0 : std::min(static_cast<size_t>(index), m_Size[dim] - 1);
+    }
+    return cell;
+  }
+
+  size_t
+  ToOffset(const std::array<size_t, VDimension> &cell) const
+  {
+    size_t offset = 0;
+    for (unsigned int dim = VDimension; dim > 0; --dim)
+    {
+      offset = offset * m_Size[dim - 1] + cell[dim - 1];
+    }
+    return offset;
+  }
+
+  std::vector<std::array<double, VDimension>> m_Points;
+  std::vector<IdentifierType> m_Identifiers;
+  std::array<double, VDimension> m_Origin;
+  std::array<double, VDimension> m_Spacing;
+  std::array<size_t, VDimension> m_Size;
+  std::vector<size_t> m_CellStart;
+  std::vector<size_t> m_CellPoints;
+};
+
+// Compare each point with the closest baseline point, regardless of the
+// point order. The closest baseline point identifiers are stored in
+// closestPoints by test point identifier. Also returns the symmetric Hausdorff
+// distance and the mean closest point distance.
+template <typename TMesh, typename TDifference>
+std::tuple<bool, uint64_t, double, double, double, double, double>
+compareClosestPoints(
+    const typename TMesh::PointsContainer *points0,
+    const typename TMesh::PointsContainer *points1,
+    const double pointsDifferenceThreshold,
+    TDifference *pointsDifference,
+    std::vector<typename TMesh::PointIdentifier> &closestPoints)
+{
+  using MeshType = TMesh;
+  using PointsContainerType = typename MeshType::PointsContainer;
+  using GridType = PointGrid<PointsContainerType, MeshType::PointDimension>;
+
+  bool sameNumberOfPoints = false;
+  uint64_t numberOfPointsWithDifferences = 0;
+  double pointsMinimumDifference = 0.0;
+  double pointsMaximumDifference = 0.0;
+  double pointsMeanDifference = 0.0;
+  double hausdorffDistance = 0.0;
+  double meanDistance = 0.0;
+  closestPoints.clear();
+
+  if (points0 == nullptr || points1 == nullptr)
+  {
+    sameNumberOfPoints = points0 == points1;
+    return {sameNumberOfPoints, numberOfPointsWithDifferences, pointsMinimumDifference, pointsMaximumDifference, pointsMeanDifference, hausdorffDistance, meanDistance};
+  }
+  sameNumberOfPoints = points0->Size() == points1->Size();
+  if (points0->Size() == 0 || points1->Size() == 0)
+  {
+    return {sameNumberOfPoints, numberOfPointsWithDifferences, pointsMinimumDifference, pointsMaximumDifference, pointsMeanDifference, hausdorffDistance, meanDistance};
+  }
+
+  const GridType grid0(points0);
+  const GridType grid1(points1);
+  const size_t numberOfPoints = grid0.Size();
+  pointsDifference->resize(numberOfPoints);
+  auto &differences = pointsDifference->CastToSTLContainer();
+  closestPoints.resize(numberOfPoints);
+
+  // Per chunk reductions, combined in order so the result does not depend on
+  // the number of threads
+  constexpr size_t chunkSize = 4096;
+  const size_t numberOfChunks = (numberOfPoints + chunkSize - 1) / chunkSize;
+  std::vector<uint64_t> chunkNumberOfDifferences(numberOfChunks, 0);
+  std::vector<double> chunkMinimum(numberOfChunks, itk::NumericTraits<double>::max());
+  std::vector<double> chunkMaximum(numberOfChunks, 0.0);
+  std::vector<double> chunkSum(numberOfChunks, 0.0);
+  std::vector<double> chunkDistanceSum(numberOfChunks, 0.0);
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfChunks, [&](itk::SizeValueType chunk) {
+    const size_t end = std::min(numberOfPoints, (chunk + 1) * chunkSize);
+    for (size_t ii = chunk * chunkSize; ii < end; ++ii)
+    {
+      const auto identifier = grid0.GetIdentifier(ii);
+      const auto [closest, difference] = grid1.FindClosestPoint(points0->ElementAt(identifier));
+      closestPoints[identifier] = closest;
+      differences[identifier] = difference;
+      chunkMinimum[chunk] = std::min(chunkMinimum[chunk], difference);
+      chunkMaximum[chunk] = std::max(chunkMaximum[chunk], difference);
+      chunkSum[chunk] += difference;
+      chunkDistanceSum[chunk] += std::sqrt(difference);
+      if (difference > pointsDifferenceThreshold)
+      {
+        ++chunkNumberOfDifferences[chunk];
+      }
+    }
+  }, nullptr);
+
+  // The baseline to test direction of the Hausdorff distance
+  const size_t numberOfBaselinePoints = grid1.Size();
+  const size_t numberOfBaselineChunks = (numberOfBaselinePoints + chunkSize - 1) / chunkSize;
+  std::vector<double> chunkBaselineMaximum(numberOfBaselineChunks, 0.0);
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfBaselineChunks, [&](itk::SizeValueType chunk) {
+    const size_t end = std::min(numberOfBaselinePoints, (chunk + 1) * chunkSize);
+    for (size_t ii = chunk * chunkSize; ii < end; ++ii)
+    {
+      const auto difference = grid0.FindClosestPoint(points1->ElementAt(grid1.GetIdentifier(ii))).second;
+      chunkBaselineMaximum[chunk] = std::max(chunkBaselineMaximum[chunk], difference);
+    }
+  }, nullptr);
+
+  pointsMinimumDifference = itk::NumericTraits<double>::max();
+  for (size_t chunk = 0; chunk < numberOfChunks; ++chunk)
+  {
+    numberOfPointsWithDifferences += chunkNumberOfDifferences[chunk];
+    pointsMinimumDifference = std::min(pointsMinimumDifference, chunkMinimum[chunk]);
+    pointsMaximumDifference = std::max(pointsMaximumDifference, chunkMaximum[chunk]);
+    pointsMeanDifference += chunkSum[chunk];
+    meanDistance += chunkDistanceSum[chunk];
+  }
+  pointsMeanDifference /= numberOfPoints;
+  meanDistance /= numberOfPoints;
+  double baselineMaximumDifference = 0.0;
+  for (const double maximum : chunkBaselineMaximum)
+  {
+    baselineMaximumDifference = std::max(baselineMaximumDifference, maximum);
+  }
+  hausdorffDistance = std::sqrt(std::max(pointsMaximumDifference, baselineMaximumDifference));
+
+  return {sameNumberOfPoints, numberOfPointsWithDifferences, pointsMinimumDifference, pointsMaximumDifference, pointsMeanDifference, hausdorffDistance, meanDistance};
+}
+
 template <typename TMesh, typename TDifference>
 std::tuple<uint64_t, double, double, double>
 comparePointData(
     const typename TMesh::PointDataContainer *pointData0,
     const typename TMesh::PointDataContainer *pointData1,
     const double pointDataDifferenceThreshold,
-    TDifference *pointDataDifference)
+    TDifference *pointDataDifference,
+    const std::vector<typename TMesh::PointIdentifier> *closestPoints = nullptr)
 {
   using MeshType = TMesh;
   using PointDataContainerConstIterator = typename MeshType::PointDataContainer::ConstIterator;
@@ -114,22 +562,40 @@ comparePointData(
     {
       pointDataDifference->resize(pointData0->Size());
 
-      PointDataContainerConstIterator pt0 = pointData0->Begin();
-      PointDataContainerConstIterator pt1 = pointData1->Begin();
-
-      while ((pt0 != pointData0->End()) && (pt1 != pointData1->End()))
+      bool compared = false;
+      if constexpr (IsContiguousContainer<typename MeshType::PointDataContainer> && IsContiguousContainer<TDifference> && std::is_arithmetic_v<typename MeshType::PointDataContainer::Element>)
       {
-        const auto difference = std::abs(static_cast<double>(pt0.Value()) - static_cast<double>(pt1.Value()));
-        pointDataMinimumDifference = std::min(pointDataMinimumDifference, difference);
-        pointDataMaximumDifference = std::max(pointDataMaximumDifference, difference);
-        pointDataMeanDifference += difference;
-        pointDataDifference->SetElement(pt0.Index(), difference);
-        if (difference > pointDataDifferenceThreshold)
+        if (closestPoints == nullptr)
         {
-          ++numberOfPointDataWithDifferences;
+          std::tie(numberOfPointDataWithDifferences, pointDataMinimumDifference, pointDataMaximumDifference, pointDataMeanDifference) =
+              compareBuffers<1>(pointData0->CastToSTLConstContainer().data(),
+                                pointData1->CastToSTLConstContainer().data(),
+                                pointData0->Size(),
+                                pointDataDifferenceThreshold,
+                                pointDataDifference->CastToSTLContainer().data());
+          compared = true;
+        }
+      }
+      if (!compared)
+      {
+        PointDataContainerConstIterator pt0 = pointData0->Begin();
+        PointDataContainerConstIterator pt1 = pointData1->Begin();
+
+        while ((pt0 != pointData0->End()) && (pt1 != pointData1->End()))
+        {
+          const auto baselineValue = closestPoints ? pointData1->ElementAt((*closestPoints)[pt0.Index()]) : pt1.Value();
+          const auto difference = std::abs(static_cast<double>(pt0.Value()) - static_cast<double>(baselineValue));
+          pointDataMinimumDifference = std::min(pointDataMinimumDifference, difference);
+          pointDataMaximumDifference = std::max(pointDataMaximumDifference, difference);
+          pointDataMeanDifference += difference;
+          pointDataDifference->SetElement(pt0.Index(), difference);
+          if (difference > pointDataDifferenceThreshold)
+          {
+            ++numberOfPointDataWithDifferences;
+          }
+          ++pt0;
+          ++pt1;
         }
-        ++pt0;
-        ++pt1;
       }
 
       pointDataMeanDifference /= pointData0->Size();
@@ -151,18 +617,46 @@ comparePointData(
   return {numberOfPointDataWithDifferences, pointDataMinimumDifference, pointDataMaximumDifference, pointDataMeanDifference};
 }
 
+// Whether the cell types differ, and the number of different point
+// identifiers. Cells with the same type and point identifiers, the common
+// case, are found with one comparison of the identifier arrays.
+template <typename TCell, typename TPointIdentifier>
+std::pair<bool, uint64_t>
+compareCell(const TCell *cell0, const TCell *cell1, const std::vector<TPointIdentifier> *closestPoints)
+{
+  const bool differentType = cell0->GetType() != cell1->GetType();
+  const auto numberOfPoints0 = static_cast<size_t>(cell0->GetNumberOfPoints());
+  const auto numberOfPoints1 = static_cast<size_t>(cell1->GetNumberOfPoints());
+  const auto pointIds0 = cell0->PointIdsBegin();
+  const auto pointIds1 = cell1->PointIdsBegin();
+  if (closestPoints == nullptr && numberOfPoints0 == numberOfPoints1 && std::equal(pointIds0, pointIds0 + numberOfPoints0, pointIds1))
+  {
+    return {differentType, 0};
+  }
+
+  // Point identifiers missing from the other cell are different
+  const size_t numberOfPoints = std::min(numberOfPoints0, numberOfPoints1);
+  uint64_t numberOfDifferentPoints = std::max(numberOfPoints0, numberOfPoints1) - numberOfPoints;
+  for (size_t ii = 0; ii < numberOfPoints; ++ii)
+  {
+    const auto pointId0 = closestPoints && pointIds0[ii] < closestPoints->size() ? (*closestPoints)[pointIds0[ii]] : pointIds0[ii];
+    numberOfDifferentPoints += pointId0 != pointIds1[ii];
+  }
+  return {differentType, numberOfDifferentPoints};
+}
+
 template <typename TMesh>
 std::tuple<bool, bool, uint64_t, bool, uint64_t>
-compareCellsContainer(const typename TMesh::CellsContainer *cells0, const typename TMesh::CellsContainer *cells1)
+compareCellsContainer(const typename TMesh::CellsContainer *cells0,
+                      const typename TMesh::CellsContainer *cells1,
+                      const std::vector<typename TMesh::PointIdentifier> *closestPoints = nullptr)
 {
   using MeshType = TMesh;
+  using CellsContainerType = typename MeshType::CellsContainer;
   using CellsContainerConstIterator = typename MeshType::CellsContainerConstIterator;
-  using CellPointIdIterator = typename MeshType::CellType::PointIdIterator;
 
   bool sameNumberOfCells = false;
-  bool sameCellTypes = true;
   uint64_t numberOfDifferentCellsTypes = 0;
-  bool sameCellPoints = true;
   uint64_t numberOfDifferentCellPoints = 0;
 
   if (cells0 != nullptr && cells1 != nullptr)
@@ -171,34 +665,50 @@ compareCellsContainer(const typename TMesh::CellsContainer *cells0, const typena
     {
       sameNumberOfCells = true;
 
-      CellsContainerConstIterator ceIt0 = cells0->Begin();
-      CellsContainerConstIterator ceIt1 = cells1->Begin();
-
-      while ((ceIt0 != cells0->End()) && (ceIt1 != cells1->End()))
+      if constexpr (IsContiguousContainer<CellsContainerType>)
       {
-        if (ceIt0.Value()->GetType() != ceIt1.Value()->GetType())
+        // Chunks of cells are compared on separate threads
+        const size_t numberOfCells = cells0->Size();
+        const auto &cellsVector0 = cells0->CastToSTLConstContainer();
+        const auto &cellsVector1 = cells1->CastToSTLConstContainer();
+        constexpr size_t chunkSize = 4096;
+        const size_t numberOfChunks = (numberOfCells + chunkSize - 1) / chunkSize;
+        std::vector<uint64_t> chunkNumberOfDifferentTypes(numberOfChunks, 0);
+        std::vector<uint64_t> chunkNumberOfDifferentPoints(numberOfChunks, 0);
+        itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfChunks, [&](itk::SizeValueType chunk) {
+          const size_t end = std::min(numberOfCells, (chunk + 1) * chunkSize);
+          for (size_t ii = chunk * chunkSize; ii < end; ++ii)
+          {
+            const auto [differentType, numberOfDifferentPoints] = compareCell(cellsVector0[ii], cellsVector1[ii], closestPoints);
+            chunkNumberOfDifferentTypes[chunk] += differentType;
+            chunkNumberOfDifferentPoints[chunk] += numberOfDifferentPoints;
+          }
+        }, nullptr);
+        for (size_t chunk = 0; chunk < numberOfChunks; ++chunk)
         {
-          sameCellTypes = false;
-          ++numberOfDifferentCellsTypes;
+          numberOfDifferentCellsTypes += chunkNumberOfDifferentTypes[chunk];
+          numberOfDifferentCellPoints += chunkNumberOfDifferentPoints[chunk];
         }
-        CellPointIdIterator pit0 = ceIt0.Value()->PointIdsBegin();
-        CellPointIdIterator pit1 = ceIt1.Value()->PointIdsBegin();
-        while (pit0 != ceIt0.Value()->PointIdsEnd())
+      }
+      else
+      {
+        CellsContainerConstIterator ceIt0 = cells0->Begin();
+        CellsContainerConstIterator ceIt1 = cells1->Begin();
+
+        while ((ceIt0 != cells0->End()) && (ceIt1 != cells1->End()))
         {
-          if (*pit0 != *pit1)
-          {
-            sameCellPoints = false;
-            ++numberOfDifferentCellPoints;
-          }
-          ++pit0;
-          ++pit1;
+          const auto [differentType, numberOfDifferentPoints] = compareCell(ceIt0.Value(), ceIt1.Value(), closestPoints);
+          numberOfDifferentCellsTypes += differentType;
+          numberOfDifferentCellPoints += numberOfDifferentPoints;
+          ++ceIt0;
+          ++ceIt1;
         }
-        ++ceIt0;
-        ++ceIt1;
       }
     }
   }
 
+  const bool sameCellTypes = numberOfDifferentCellsTypes == 0;
+  const bool sameCellPoints = numberOfDifferentCellPoints == 0;
   return {sameNumberOfCells, sameCellTypes, numberOfDifferentCellsTypes, sameCellPoints, numberOfDifferentCellPoints};
 }
 
@@ -224,22 +734,34 @@ compareCellData(
     {
       cellDataDifference->resize(cellData0->Size());
 
-      CellDataContainerConstIterator pt0 = cellData0->Begin();
-      CellDataContainerConstIterator pt1 = cellData1->Begin();
-
-      while ((pt0 != cellData0->End()) && (pt1 != cellData1->End()))
+      if constexpr (IsContiguousContainer<typename MeshType::CellDataContainer> && IsContiguousContainer<TDifference> && std::is_arithmetic_v<typename MeshType::CellDataContainer::Element>)
+      {
+        std::tie(numberOfCellDataWithDifferences, cellDataMinimumDifference, cellDataMaximumDifference, cellDataMeanDifference) =
+            compareBuffers<1>(cellData0->CastToSTLConstContainer().data(),
+                              cellData1->CastToSTLConstContainer().data(),
+                              cellData0->Size(),
+                              cellDataDifferenceThreshold,
+                              cellDataDifference->CastToSTLContainer().data());
+      }
+      else
       {
-        const auto difference = std::abs(static_cast<double>(pt0.Value()) - static_cast<double>(pt1.Value()));
-        cellDataMinimumDifference = std::min(cellDataMinimumDifference, difference);
-        cellDataMaximumDifference = std::max(cellDataMaximumDifference, difference);
-        cellDataMeanDifference += difference;
-        cellDataDifference->SetElement(pt0.Index(), difference);
-        if (difference > cellDataDifferenceThreshold)
+        CellDataContainerConstIterator pt0 = cellData0->Begin();
+        CellDataContainerConstIterator pt1 = cellData1->Begin();
+
+        while ((pt0 != cellData0->End()) && (pt1 != cellData1->End()))
         {
-          ++numberOfCellDataWithDifferences;
+          const auto difference = std::abs(static_cast<double>(pt0.Value()) - static_cast<double>(pt1.Value()));
+          cellDataMinimumDifference = std::min(cellDataMinimumDifference, difference);
+          cellDataMaximumDifference = std::max(cellDataMaximumDifference, difference);
+          cellDataMeanDifference += difference;
+          cellDataDifference->SetElement(pt0.Index(), difference);
+          if (difference > cellDataDifferenceThreshold)
+          {
+            ++numberOfCellDataWithDifferences;
+          }
+          ++pt0;
+          ++pt1;
         }
-        ++pt0;
-        ++pt1;
       }
 
       cellDataMeanDifference /= cellData0->Size();
@@ -291,6 +813,9 @@ int compareMeshes(itk::wasm::Pipeline &pipeline, const TMesh *testMesh)
   uint64_t numberOfCellDataTolerance = 0;
   pipeline.add_option("--number-of-cell-data-tolerance", numberOfCellDataTolerance, "Number of cell data that can exceed the difference threshold before the test fails.");
 
+  bool orderInvariantPoints = false;
+  pipeline.add_flag("--order-invariant-points", orderInvariantPoints, "Compare each point with the closest baseline point, regardless of the point order. Point data and cell points are compared through the closest baseline points. Also reports the Hausdorff and mean distances.");
+
   itk::wasm::OutputTextStream metrics;
   pipeline.add_option("metrics", metrics, "Metrics for the closest baseline.")->required()->type_name("OUTPUT_JSON");
 
@@ -314,6 +839,8 @@ int compareMeshes(itk::wasm::Pipeline &pipeline, const TMesh *testMesh)
   double pointsMinimumDifference = 0.0;
   double pointsMaximumDifference = 0.0;
   double pointsMeanDifference = 0.0;
+  double pointsHausdorffDistance = 0.0;
+  double pointsMeanDistance = 0.0;
 
   uint64_t numberOfPointDataWithDifferences = itk::NumericTraits<uint64_t>::max();
   double pointDataMinimumDifference = 0.0;
@@ -349,14 +876,40 @@ int compareMeshes(itk::wasm::Pipeline &pipeline, const TMesh *testMesh)
   for (unsigned int baselineIndex = 0; baselineIndex < baselineMeshes.size(); ++baselineIndex)
   {
     typename DifferenceMeshType::PointDataContainerPointer baselinePointsDifference = DifferenceMeshType::PointDataContainer::New();
-    const auto [baselineSameNumberOfPoints,
-                baselineNumberOfPointsWithDifferences,
-                baselinePointsMinimumDifference,
-                baselinePointsMaximumDifference,
-                baselinePointsMeanDifference] = comparePoints<MeshType, typename DifferenceMeshType::PointDataContainer>(testMesh->GetPoints(),
-                                                                                                                         baselineMeshes[baselineIndex].Get()->GetPoints(),
-                                                                                                                         pointsDifferenceThreshold,
-                                                                                                                         baselinePointsDifference);
+    std::vector<typename MeshType::PointIdentifier> closestPoints;
+    bool baselineSameNumberOfPoints = false;
+    uint64_t baselineNumberOfPointsWithDifferences = 0;
+    double baselinePointsMinimumDifference = 0.0;
+    double baselinePointsMaximumDifference = 0.0;
+    double baselinePointsMeanDifference = 0.0;
+    double baselinePointsHausdorffDistance = 0.0;
+    double baselinePointsMeanDistance = 0.0;
+    if (orderInvariantPoints)
+    {
+      std::tie(baselineSameNumberOfPoints,
+               baselineNumberOfPointsWithDifferences,
+               baselinePointsMinimumDifference,
+               baselinePointsMaximumDifference,
+               baselinePointsMeanDifference,
+               baselinePointsHausdorffDistance,
+               baselinePointsMeanDistance) = compareClosestPoints<MeshType, typename DifferenceMeshType::PointDataContainer>(testMesh->GetPoints(),
+                                                                                                                            baselineMeshes[baselineIndex].Get()->GetPoints(),
+                                                                                                                            pointsDifferenceThreshold,
+                                                                                                                            baselinePointsDifference,
+                                                                                                                            closestPoints);
+    }
+    else
+    {
+      std::tie(baselineSameNumberOfPoints,
+               baselineNumberOfPointsWithDifferences,
+               baselinePointsMinimumDifference,
+               baselinePointsMaximumDifference,
+               baselinePointsMeanDifference) = comparePoints<MeshType, typename DifferenceMeshType::PointDataContainer>(testMesh->GetPoints(),
+                                                                                                                        baselineMeshes[baselineIndex].Get()->GetPoints(),
+                                                                                                                        pointsDifferenceThreshold,
+                                                                                                                        baselinePointsDifference);
+    }
+    const std::vector<typename MeshType::PointIdentifier> *closestPointsPointer = orderInvariantPoints ? &closestPoints : nullptr;
     if (baselineSameNumberOfPoints && baselineNumberOfPointsWithDifferences <= numberOfPointsWithDifferences)
     {
       sameNumberOfPoints = baselineSameNumberOfPoints;
@@ -364,6 +917,8 @@ int compareMeshes(itk::wasm::Pipeline &pipeline, const TMesh *testMesh)
       pointsMinimumDifference = baselinePointsMinimumDifference;
       pointsMaximumDifference = baselinePointsMaximumDifference;
       pointsMeanDifference = baselinePointsMeanDifference;
+      pointsHausdorffDistance = baselinePointsHausdorffDistance;
+      pointsMeanDistance = baselinePointsMeanDistance;
       pointsDifference = baselinePointsDifference;
       pointsDifferenceMeshPointer->SetPointData(pointsDifference);
 
@@ -374,7 +929,8 @@ int compareMeshes(itk::wasm::Pipeline &pipeline, const TMesh *testMesh)
                   baselinePointDataMeanDifference] = comparePointData<MeshType, typename DifferenceMeshType::PointDataContainer>(testMesh->GetPointData(),
                                                                                                                                  baselineMeshes[baselineIndex].Get()->GetPointData(),
                                                                                                                                  pointDataDifferenceThreshold,
-                                                                                                                                 baselinePointDataDifference);
+                                                                                                                                 baselinePointDataDifference,
+                                                                                                                                 closestPointsPointer);
       if (baselineNumberOfPointDataWithDifferences <= numberOfPointDataWithDifferences)
       {
         numberOfPointDataWithDifferences = baselineNumberOfPointDataWithDifferences;
@@ -390,7 +946,8 @@ int compareMeshes(itk::wasm::Pipeline &pipeline, const TMesh *testMesh)
                   baselineNumberOfDifferentCellsTypes,
                   baselineSameCellPoints,
                   baselineNumberOfDifferentCellPoints] = compareCellsContainer<MeshType>(testMesh->GetCells(),
-                                                                                         baselineMeshes[baselineIndex].Get()->GetCells());
+                                                                                         baselineMeshes[baselineIndex].Get()->GetCells(),
+                                                                                         closestPointsPointer);
       if (baselineSameNumberOfCells)
       {
         if (baselineSameCellTypes)
@@ -493,6 +1050,17 @@ int compareMeshes(itk::wasm::Pipeline &pipeline, const TMesh *testMesh)
   pointsMeanDifferenceValue.SetDouble(pointsMeanDifference);
   pointObject.AddMember("meanDifference", pointsMeanDifferenceValue, allocator);
 
+  if (orderInvariantPoints)
+  {
+    rapidjson::Value pointsHausdorffDistanceValue;
+    pointsHausdorffDistanceValue.SetDouble(pointsHausdorffDistance);
+    pointObject.AddMember("hausdorffDistance", pointsHausdorffDistanceValue, allocator);
+
+    rapidjson::Value pointsMeanDistanceValue;
+    pointsMeanDistanceValue.SetDouble(pointsMeanDistance);
+    pointObject.AddMember("meanDistance", pointsMeanDistanceValue, allocator);
+  }
+
   metricsJson.AddMember("points", pointObject.Move(), allocator);
 
   rapidjson::Value cellsObject(rapidjson::kObjectType);
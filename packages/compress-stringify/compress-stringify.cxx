@@ -16,70 +16,57 @@
  *
  *=========================================================================*/
 
-#include <fstream>
 #include <string>
 #include <iostream>
-#include <sstream>
-#include <vector>
-#include <iterator>
 
-#include "zstd.h"
-#include "cpp-base64/base64.h"
+#include "compressStringifyStream.h"
 
 #include "itkPipeline.h"
 #include "itkInputBinaryStream.h"
 #include "itkOutputTextStream.h"
 #include "itkOutputBinaryStream.h"
 
-int compress(itk::wasm::Pipeline & pipeline, itk::wasm::InputBinaryStream & inputBinaryStream, int compressionLevel)
+int compress(itk::wasm::Pipeline & pipeline, itk::wasm::InputBinaryStream & inputBinaryStream, int compressionLevel, const std::string & dictionaryFileName)
 {
   itk::wasm::OutputBinaryStream outputBinaryStream;
   pipeline.add_option("output", outputBinaryStream, "Output compressed binary")->type_name("OUTPUT_BINARY_STREAM");
 
   ITK_WASM_PARSE(pipeline);
 
-  std::string inputBinary;
-  inputBinary.assign( (std::istreambuf_iterator<char>(inputBinaryStream.Get()) ), 
-                      (std::istreambuf_iterator<char>()) ); 
+  std::shared_ptr<const itk::wasm::ZstdDictionary> dictionary;
+  ITK_WASM_CATCH_EXCEPTION(pipeline, dictionary = readZstdDictionary(dictionaryFileName));
+  const ZSTD_CDict * compressionDictionary = dictionary ? dictionary->GetCompressionDictionary(compressionLevel) : nullptr;
 
-
-  const size_t compressedBufferSize = ZSTD_compressBound(inputBinary.size());
-  std::vector<char> compressedBinary(compressedBufferSize);
-
-  const size_t compressedSize = ZSTD_compress(compressedBinary.data(), compressedBufferSize, inputBinary.data(), inputBinary.size(), compressionLevel);
-  compressedBinary.resize(compressedSize);
-
-  std::ostream_iterator<char> oIt(outputBinaryStream.Get());
-  std::copy(compressedBinary.begin(), compressedBinary.end(), oIt);
+  // The compressed blocks are written as they are produced
+  std::ostream & output = outputBinaryStream.Get();
+  ITK_WASM_CATCH_EXCEPTION(pipeline, compressStream(inputBinaryStream.Get(), compressionLevel, compressionDictionary, [&](const char * data, size_t size) {
+    output.write(data, static_cast<std::streamsize>(size));
+  }));
 
   return EXIT_SUCCESS;
 }
 
-int compressStringify(itk::wasm::Pipeline & pipeline, itk::wasm::InputBinaryStream & inputBinaryStream, int compressionLevel, const std::string & dataURLPrefix)
+int compressStringify(itk::wasm::Pipeline & pipeline, itk::wasm::InputBinaryStream & inputBinaryStream, int compressionLevel, const std::string & dataURLPrefix, const std::string & dictionaryFileName)
 {
   itk::wasm::OutputTextStream outputTextStream;
   pipeline.add_option("output", outputTextStream, "Output dataURL+base64 compressed binary")->type_name("OUTPUT_TEXT_STREAM");
 
   ITK_WASM_PARSE(pipeline);
 
-  std::string inputBinary;
-  inputBinary.assign( (std::istreambuf_iterator<char>(inputBinaryStream.Get()) ), 
-                      (std::istreambuf_iterator<char>()) );
-
-
-  const size_t compressedBufferSize = ZSTD_compressBound(inputBinary.size());
-  std::string compressedBinary;
-  compressedBinary.resize(compressedBufferSize);
+  std::shared_ptr<const itk::wasm::ZstdDictionary> dictionary;
+  ITK_WASM_CATCH_EXCEPTION(pipeline, dictionary = readZstdDictionary(dictionaryFileName));
+  const ZSTD_CDict * compressionDictionary = dictionary ? dictionary->GetCompressionDictionary(compressionLevel) : nullptr;
 
-  const size_t compressedSize = ZSTD_compress(compressedBinary.data(), compressedBufferSize, inputBinary.data(), inputBinary.size(), compressionLevel);
-  compressedBinary.resize(compressedSize);
+  outputTextStream.Get() << dataURLPrefix;
 
   // Do we want/need this?
   constexpr bool urlFriendly = false;
-  auto outputText = base64_encode(compressedBinary, urlFriendly);
-
-  outputTextStream.Get() << dataURLPrefix;
-  outputTextStream.Get() << outputText;
+  // The compressed blocks are encoded as they are produced
+  Base64Encoder encoder(outputTextStream.Get(), urlFriendly);
+  ITK_WASM_CATCH_EXCEPTION(pipeline, compressStream(inputBinaryStream.Get(), compressionLevel, compressionDictionary, [&](const char * data, size_t size) {
+    encoder.Add(data, size);
+  }));
+  encoder.Finish();
 
   return EXIT_SUCCESS;
 }
@@ -100,11 +87,14 @@ int main(int argc, char * argv[])
   std::string dataURLPrefix("data:application/zstd;base64,");
   pipeline.add_option("-p,--data-url-prefix", dataURLPrefix, "dataURL prefix");
 
+  std::string dictionaryFileName;
+  pipeline.add_option("-d,--dictionary", dictionaryFileName, "zstd dictionary, e.g. from train-zstd-dictionary, for small inputs similar to its samples")->check(CLI::ExistingFile)->type_name("INPUT_BINARY_FILE");
+
   ITK_WASM_PRE_PARSE(pipeline);
 
   if(stringify)
   {
-    return compressStringify(pipeline, inputBinaryStream, compressionLevel, dataURLPrefix);
+    return compressStringify(pipeline, inputBinaryStream, compressionLevel, dataURLPrefix, dictionaryFileName);
   }
-  return compress(pipeline, inputBinaryStream, compressionLevel);
+  return compress(pipeline, inputBinaryStream, compressionLevel, dictionaryFileName);
 }
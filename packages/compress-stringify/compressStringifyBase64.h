@@ -0,0 +1,392 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef compressStringifyBase64_h
+#define compressStringifyBase64_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+// 16-byte vector kernels: SIMD128 in wasm builds with -msimd128, NEON on
+// AArch64, and SSSE3 on x86 with GCC or Clang, selected at run time
+#if defined(__wasm_simd128__)
+#  include <wasm_simd128.h>
+#  define COMPRESS_STRINGIFY_BASE64_SIMD
+#  define COMPRESS_STRINGIFY_BASE64_TARGET
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#  include <arm_neon.h>
+#  define COMPRESS_STRINGIFY_BASE64_SIMD
+#  define COMPRESS_STRINGIFY_BASE64_TARGET
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#  include <tmmintrin.h>
+#  define COMPRESS_STRINGIFY_BASE64_SIMD
+#  define COMPRESS_STRINGIFY_BASE64_TARGET __attribute__((target("ssse3")))
+#endif
+
+namespace base64Simd
+{
+
+#if defined(COMPRESS_STRINGIFY_BASE64_SIMD)
+
+#  if defined(__wasm_simd128__)
+using Vector = v128_t;
+
+inline Vector Load(const void * data) { return wasm_v128_load(data); }
+inline void Store(void * data, Vector value) { wasm_v128_store(data, value); }
+inline Vector Constant(const uint8_t (&bytes)[16]) { return wasm_v128_load(bytes); }
+inline Vector Splat8(uint8_t value) { return wasm_i8x16_splat(static_cast<int8_t>(value)); }
+inline Vector Splat32(uint32_t value) { return wasm_i32x4_splat(static_cast<int32_t>(value)); }
+// Bytes of table at the low 4 bits of indices, or 0 for indices of 16 or more
+inline Vector Shuffle(Vector table, Vector indices) { return wasm_i8x16_swizzle(table, indices); }
+inline Vector And(Vector a, Vector b) { return wasm_v128_and(a, b); }
+inline Vector Or(Vector a, Vector b) { return wasm_v128_or(a, b); }
+inline Vector Add8(Vector a, Vector b) { return wasm_i8x16_add(a, b); }
+inline Vector SubtractSaturated8(Vector a, Vector b) { return wasm_u8x16_sub_sat(a, b); }
+inline Vector Greater8(Vector a, Vector b) { return wasm_i8x16_gt(a, b); }
+inline Vector Equal8(Vector a, Vector b) { return wasm_i8x16_eq(a, b); }
+template <int VShift> inline Vector ShiftLeft32(Vector a) { return wasm_i32x4_shl(a, VShift); }
+template <int VShift> inline Vector ShiftRight32(Vector a) { return wasm_u32x4_shr(a, VShift); }
+inline bool AnyNonZero(Vector a) { return wasm_v128_any_true(a); }
+inline bool Supported() { return true; }
+#  elif defined(__aarch64__) && defined(__ARM_NEON)
+using Vector = uint8x16_t;
+
+inline Vector Load(const void * data) { return vld1q_u8(static_cast<const uint8_t *>(data)); }
+inline void Store(void * data, Vector value) { vst1q_u8(static_cast<uint8_t *>(data), value); }
+inline Vector Constant(const uint8_t (&bytes)[16]) { return vld1q_u8(bytes); }
+inline Vector Splat8(uint8_t value) { return vdupq_n_u8(value); }
+inline Vector Splat32(uint32_t value) { return vreinterpretq_u8_u32(vdupq_n_u32(value)); }
+inline Vector Shuffle(Vector table, Vector indices) { return vqtbl1q_u8(table, indices); }
+inline Vector And(Vector a, Vector b) { return vandq_u8(a, b); }
+inline Vector Or(Vector a, Vector b) { return vorrq_u8(a, b); }
+inline Vector Add8(Vector a, Vector b) { return vaddq_u8(a, b); }
+inline Vector SubtractSaturated8(Vector a, Vector b) { return vqsubq_u8(a, b); }
+inline Vector Greater8(Vector a, Vector b) { return vcgtq_s8(vreinterpretq_s8_u8(a), vreinterpretq_s8_u8(b)); }
+inline Vector Equal8(Vector a, Vector b) { return vceqq_u8(a, b); }
+template <int VShift> inline Vector ShiftLeft32(Vector a) { return vreinterpretq_u8_u32(vshlq_n_u32(vreinterpretq_u32_u8(a), VShift)); }
+template <int VShift> inline Vector ShiftRight32(Vector a) { return vreinterpretq_u8_u32(vshrq_n_u32(vreinterpretq_u32_u8(a), VShift)); }
+inline bool AnyNonZero(Vector a) { return vmaxvq_u8(a) != 0; }
+inline bool Supported() { return true; }
+#  else
+using Vector = __m128i;
+
+COMPRESS_STRINGIFY_BASE64_TARGET inline Vector Load(const void * data) { return _mm_loadu_si128(static_cast<const __m128i *>(data)); }
+COMPRESS_STRINGIFY_BASE64_TARGET inline void Store(void * data, Vector value) { _mm_storeu_si128(static_cast<__m128i *>(data), value); }
+COMPRESS_STRINGIFY_BASE64_TARGET inline Vector Constant(const uint8_t (&bytes)[16]) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes)); }
+COMPRESS_STRINGIFY_BASE64_TARGET inline Vector Splat8(uint8_t value) { return _mm_set1_epi8(static_cast<char>(value)); }
+COMPRESS_STRINGIFY_BASE64_TARGET inline Vector Splat32(uint32_t value) { return _mm_set1_epi32(static_cast<int>(value)); }
+// Indices of 16 or more in the shuffles below have their high bit set
+COMPRESS_STRINGIFY_BASE64_TARGET inline Vector Shuffle(Vector table, Vector indices) { return _mm_shuffle_epi8(table, indices); }
+COMPRESS_STRINGIFY_BASE64_TARGET inline Vector And(Vector a, Vector b) { return _mm_and_si128(a, b); }
+COMPRESS_STRINGIFY_BASE64_TARGET inline Vector Or(Vector a, Vector b) { return _mm_or_si128(a, b); }
+COMPRESS_STRINGIFY_BASE64_TARGET inline Vector Add8(Vector a, Vector b) { return _mm_add_epi8(a, b); }
+COMPRESS_STRINGIFY_BASE64_TARGET inline Vector SubtractSaturated8(Vector a, Vector b) { return _mm_subs_epu8(a, b); }
+COMPRESS_STRINGIFY_BASE64_TARGET inline Vector Greater8(Vector a, Vector b) { return _mm_cmpgt_epi8(a, b); }
+COMPRESS_STRINGIFY_BASE64_TARGET inline Vector Equal8(Vector a, Vector b) { return _mm_cmpeq_epi8(a, b); }
+template <int VShift> COMPRESS_STRINGIFY_BASE64_TARGET inline Vector ShiftLeft32(Vector a) { return _mm_slli_epi32(a, VShift); }
+template <int VShift> COMPRESS_STRINGIFY_BASE64_TARGET inline Vector ShiftRight32(Vector a) { return _mm_srli_epi32(a, VShift); }
+COMPRESS_STRINGIFY_BASE64_TARGET inline bool AnyNonZero(Vector a) { return _mm_movemask_epi8(_mm_cmpeq_epi8(a, _mm_setzero_si128())) != 0xffff; }
+inline bool Supported()
+{
+  static const bool supported = __builtin_cpu_supports("ssse3");
+  return supported;
+}
+#  endif
+
+/** Encode 12 bytes, from a 16-byte load, into 16 characters.
+ *
+ * The bytes of each group of three are spread over a 32-bit lane, whose
+ * four 6-bit indices are shifted into its bytes and offset into the
+ * alphabet with a shuffle of the offsets of its ranges. */
+COMPRESS_STRINGIFY_BASE64_TARGET inline void
+EncodeBlock(const unsigned char * bytes, char * encoded, bool urlFriendly)
+{
+  static constexpr uint8_t spread[16] = { 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10 };
+  static constexpr uint8_t offsets[16] = { static_cast<uint8_t>('a' - 26), static_cast<uint8_t>('0' - 52),
+                                           static_cast<uint8_t>('0' - 52), static_cast<uint8_t>('0' - 52),
+                                           static_cast<uint8_t>('0' - 52), static_cast<uint8_t>('0' - 52),
+                                           static_cast<uint8_t>('0' - 52), static_cast<uint8_t>('0' - 52),
+                                           static_cast<uint8_t>('0' - 52), static_cast<uint8_t>('0' - 52),
+                                           static_cast<uint8_t>('0' - 52), static_cast<uint8_t>('+' - 62),
+                                           static_cast<uint8_t>('/' - 63), static_cast<uint8_t>('A'), 0, 0 };
+  static constexpr uint8_t urlFriendlyOffsets[16] = { static_cast<uint8_t>('a' - 26), static_cast<uint8_t>('0' - 52),
+                                                      static_cast<uint8_t>('0' - 52), static_cast<uint8_t>('0' - 52),
+                                                      static_cast<uint8_t>('0' - 52), static_cast<uint8_t>('0' - 52),
+                                                      static_cast<uint8_t>('0' - 52), static_cast<uint8_t>('0' - 52),
+                                                      static_cast<uint8_t>('0' - 52), static_cast<uint8_t>('0' - 52),
+                                                      static_cast<uint8_t>('0' - 52), static_cast<uint8_t>('-' - 62),
+                                                      static_cast<uint8_t>('_' - 63), static_cast<uint8_t>('A'), 0, 0 };
+
+  const Vector lanes = Shuffle(Load(bytes), Constant(spread));
+  const Vector indices = Or(Or(And(ShiftRight32<10>(lanes), Splat32(0x0000003f)), And(ShiftLeft32<4>(lanes), Splat32(0x00003f00))),
+                            Or(And(ShiftRight32<6>(lanes), Splat32(0x003f0000)), And(ShiftLeft32<8>(lanes), Splat32(0x3f000000))));
+  // 0 for 26-51, 1-12 for 52-63, and 13 for 0-25
+  Vector ranges = SubtractSaturated8(indices, Splat8(51));
+  ranges = Or(ranges, And(Greater8(Splat8(26), indices), Splat8(13)));
+  Store(encoded, Add8(indices, Shuffle(Constant(urlFriendly ? urlFriendlyOffsets : offsets), ranges)));
+}
+
+/** Decode 16 characters of the standard alphabet into 12 bytes. Returns
+ * false, without decoding, if any character is outside of the alphabet,
+ * e.g. whitespace, padding, or the URL-friendly characters.
+ *
+ * The characters are classified by the shuffles of their low and high
+ * nibbles, offset to their 6-bit values, and packed from each 32-bit lane
+ * into three bytes. */
+COMPRESS_STRINGIFY_BASE64_TARGET inline bool
+DecodeBlock(const char * text, unsigned char * decoded)
+{
+  static constexpr uint8_t lowNibbleClasses[16] = { 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                                    0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a };
+  static constexpr uint8_t highNibbleClasses[16] = { 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                                     0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 };
+  static constexpr uint8_t offsets[16] = { 0, 16, 19, 4, 191, 191, 185, 185, 0, 0, 0, 0, 0, 0, 0, 0 };
+  static constexpr uint8_t pack[16] = { 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 0x80, 0x80, 0x80, 0x80 };
+
+  const Vector characters = Load(text);
+  const Vector highNibbles = And(ShiftRight32<4>(characters), Splat8(0x0f));
+  const Vector lowNibbles = And(characters, Splat8(0x0f));
+  if (AnyNonZero(And(Shuffle(Constant(lowNibbleClasses), lowNibbles), Shuffle(Constant(highNibbleClasses), highNibbles))))
+  {
+    return false;
+  }
+  // '/' shares its high nibble with '+', and takes the offset before it
+  const Vector slashes = Equal8(characters, Splat8('/'));
+  const Vector values = Add8(characters, Shuffle(Constant(offsets), Add8(slashes, highNibbles)));
+  const Vector packed = Or(Or(ShiftLeft32<18>(And(values, Splat32(0x0000003f))), ShiftLeft32<4>(And(values, Splat32(0x00003f00)))),
+                           Or(ShiftRight32<10>(And(values, Splat32(0x003f0000))), ShiftRight32<24>(And(values, Splat32(0x3f000000)))));
+  unsigned char block[16];
+  Store(block, Shuffle(packed, Constant(pack)));
+  std::memcpy(decoded, block, 12);
+  return true;
+}
+
+#else
+
+inline bool Supported() { return false; }
+
+inline void EncodeBlock(const unsigned char *, char *, bool) {}
+
+inline bool DecodeBlock(const char *, unsigned char *) { return false; }
+
+#endif
+
+} // end namespace base64Simd
+
+/** Incremental base64 encoder writing to an output stream.
+ *
+ * Bytes are encoded as they are added, in blocks, and at most two bytes are
+ * held back until the next Add or Finish. */
+class Base64Encoder
+{
+public:
+  explicit Base64Encoder(std::ostream & output, bool urlFriendly = false)
+    : m_Output(output)
+    , m_Alphabet(urlFriendly ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+                             : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/")
+    , m_Padding(urlFriendly ? '.' : '=')
+    , m_URLFriendly(urlFriendly)
+  {}
+
+  void
+  Add(const char * data, size_t size)
+  {
+    auto bytes = reinterpret_cast<const unsigned char *>(data);
+    while (m_PendingSize > 0 && m_PendingSize < 3 && size > 0)
+    {
+      m_Pending[m_PendingSize++] = *bytes++;
+      --size;
+    }
+    if (m_PendingSize == 3)
+    {
+      this->EncodeTriples(m_Pending, 3);
+      m_PendingSize = 0;
+    }
+    const size_t triplesSize = size - size % 3;
+    this->EncodeTriples(bytes, triplesSize);
+    for (size_t ii = triplesSize; ii < size; ++ii)
+    {
+      m_Pending[m_PendingSize++] = bytes[ii];
+    }
+    this->Flush();
+  }
+
+  /** Encode the bytes held back, with padding. */
+  void
+  Finish()
+  {
+    if (m_PendingSize > 0)
+    {
+      const unsigned int triple = (m_Pending[0] << 16) | (m_PendingSize > 1 ? m_Pending[1] << 8 : 0);
+      m_Encoded.push_back(m_Alphabet[(triple >> 18) & 0x3f]);
+      m_Encoded.push_back(m_Alphabet[(triple >> 12) & 0x3f]);
+      m_Encoded.push_back(m_PendingSize > 1 ? m_Alphabet[(triple >> 6) & 0x3f] : m_Padding);
+      m_Encoded.push_back(m_Padding);
+      m_PendingSize = 0;
+    }
+    this->Flush();
+  }
+
+private:
+  void
+  EncodeTriples(const unsigned char * bytes, size_t size)
+  {
+    const size_t start = m_Encoded.size();
+    m_Encoded.resize(start + size / 3 * 4);
+    char * encoded = m_Encoded.data() + start;
+    size_t ii = 0;
+    if (base64Simd::Supported())
+    {
+      // Each block loads 16 bytes and encodes the first 12
+      for (; ii + 16 <= size; ii += 12, encoded += 16)
+      {
+        base64Simd::EncodeBlock(bytes + ii, encoded, m_URLFriendly);
+      }
+    }
+    for (; ii < size; ii += 3)
+    {
+      const unsigned int triple = (bytes[ii] << 16) | (bytes[ii + 1] << 8) | bytes[ii + 2];
+      *encoded++ = m_Alphabet[triple >> 18];
+      *encoded++ = m_Alphabet[(triple >> 12) & 0x3f];
+      *encoded++ = m_Alphabet[(triple >> 6) & 0x3f];
+      *encoded++ = m_Alphabet[triple & 0x3f];
+    }
+  }
+
+  void
+  Flush()
+  {
+    m_Output.write(m_Encoded.data(), static_cast<std::streamsize>(m_Encoded.size()));
+    m_Encoded.clear();
+  }
+
+  std::ostream &    m_Output;
+  const char *      m_Alphabet;
+  char              m_Padding;
+  bool              m_URLFriendly;
+  unsigned char     m_Pending[3];
+  size_t            m_PendingSize{ 0 };
+  std::vector<char> m_Encoded;
+};
+
+/** Incremental base64 decoder of the standard and URL-friendly alphabets.
+ *
+ * Whitespace is skipped, and decoding stops at the first padding
+ * character. */
+class Base64Decoder
+{
+public:
+  Base64Decoder()
+  {
+    for (unsigned int ii = 0; ii < 256; ++ii)
+    {
+      m_Table[ii] = Invalid;
+    }
+    const char * alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (unsigned char ii = 0; ii < 64; ++ii)
+    {
+      m_Table[static_cast<unsigned char>(alphabet[ii])] = ii;
+    }
+    m_Table[static_cast<unsigned char>('-')] = 62;
+    m_Table[static_cast<unsigned char>('_')] = 63;
+    for (const char space : { ' ', '\t', '\n', '\r', '\f', '\v' })
+    {
+      m_Table[static_cast<unsigned char>(space)] = Skip;
+    }
+    m_Table[static_cast<unsigned char>('=')] = End;
+    m_Table[static_cast<unsigned char>('.')] = End;
+  }
+
+  /** Decode the characters into bytes, appended to decoded. Throws on
+   * characters outside of the alphabets. */
+  void
+  Add(const char * text, size_t size, std::vector<char> & decoded)
+  {
+    const bool simd = base64Simd::Supported();
+    for (size_t ii = 0; ii < size && !m_Ended; ++ii)
+    {
+      if (simd && m_QuadSize == 0)
+      {
+        // Whole quads of the standard alphabet, 16 characters at a time
+        unsigned char block[12];
+        while (ii + 16 <= size && base64Simd::DecodeBlock(text + ii, block))
+        {
+          decoded.insert(decoded.end(), block, block + sizeof(block));
+          ii += 16;
+        }
+        if (ii == size)
+        {
+          break;
+        }
+      }
+      const unsigned char value = m_Table[static_cast<unsigned char>(text[ii])];
+      if (value < 64)
+      {
+        m_Quad = (m_Quad << 6) | value;
+        if (++m_QuadSize == 4)
+        {
+          decoded.push_back(static_cast<char>(m_Quad >> 16));
+          decoded.push_back(static_cast<char>(m_Quad >> 8));
+          decoded.push_back(static_cast<char>(m_Quad));
+          m_Quad = 0;
+          m_QuadSize = 0;
+        }
+      }
+      else if (value == End)
+      {
+        m_Ended = true;
+      }
+      else if (value == Invalid)
+      {
+        throw std::runtime_error("Invalid base64 character");
+      }
+    }
+  }
+
+  /** Decode the bytes of a final, unpadded or padded, partial quad. */
+  void
+  Finish(std::vector<char> & decoded)
+  {
+    if (m_QuadSize >= 2)
+    {
+      const unsigned int quad = m_Quad << (6 * (4 - m_QuadSize));
+      decoded.push_back(static_cast<char>(quad >> 16));
+      if (m_QuadSize == 3)
+      {
+        decoded.push_back(static_cast<char>(quad >> 8));
+      }
+    }
+    m_Quad = 0;
+    m_QuadSize = 0;
+  }
+
+private:
+  static constexpr unsigned char Skip = 64;
+  static constexpr unsigned char End = 65;
+  static constexpr unsigned char Invalid = 66;
+
+  unsigned char m_Table[256];
+  unsigned int  m_Quad{ 0 };
+  unsigned int  m_QuadSize{ 0 };
+  bool          m_Ended{ false };
+};
+
+#endif
@@ -0,0 +1,198 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef compressStringifyStream_h
+#define compressStringifyStream_h
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "zstd.h"
+
+#include "compressStringifyBase64.h"
+
+#include "itkWasmZstdDictionary.h"
+
+/** The dictionary of the file, nullptr for an empty file name. Dictionaries
+ * are cached by content, so runs in reactor mode reuse the digested
+ * dictionary. Throws if the file cannot be read. */
+inline std::shared_ptr<const itk::wasm::ZstdDictionary>
+readZstdDictionary(const std::string & fileName)
+{
+  if (fileName.empty())
+  {
+    return nullptr;
+  }
+  std::shared_ptr<const itk::wasm::ZstdDictionary> dictionary = itk::wasm::ZstdDictionary::Read(fileName);
+  if (!dictionary)
+  {
+    throw std::runtime_error("Could not read the zstd dictionary " + fileName);
+  }
+  return dictionary;
+}
+
+/** Size of the remaining bytes of a seekable stream, or -1. */
+inline int64_t
+remainingStreamSize(std::istream & input)
+{
+  const std::streampos position = input.tellg();
+  if (position == std::streampos(-1) || !input.seekg(0, std::ios::end))
+  {
+    input.clear();
+    return -1;
+  }
+  const std::streampos end = input.tellg();
+  input.seekg(position);
+  return end == std::streampos(-1) ? -1 : static_cast<int64_t>(end - position);
+}
+
+/** Compress the input stream into a zstd frame, ZSTD_CStreamInSize bytes at a
+ * time, and pass each compressed block to the sink. The content size is
+ * recorded in the frame header when the input is seekable, as in a single
+ * shot ZSTD_compress. With a dictionary, which supersedes the compression
+ * level, its ID is recorded in the frame header. */
+template <typename TSink>
+void
+compressStream(std::istream & input, int compressionLevel, const ZSTD_CDict * dictionary, TSink && sink)
+{
+  ZSTD_CCtx * context = ZSTD_createCCtx();
+  if (context == nullptr)
+  {
+    throw std::runtime_error("Could not create the zstd compression context");
+  }
+  const auto check = [&](size_t result) {
+    if (ZSTD_isError(result))
+    {
+      const std::string message = ZSTD_getErrorName(result);
+      ZSTD_freeCCtx(context);
+      throw std::runtime_error("zstd compression failed: " + message);
+    }
+    return result;
+  };
+  check(ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, compressionLevel));
+  if (dictionary != nullptr)
+  {
+    check(ZSTD_CCtx_refCDict(context, dictionary));
+  }
+  const int64_t inputSize = remainingStreamSize(input);
+  if (inputSize >= 0)
+  {
+    check(ZSTD_CCtx_setPledgedSrcSize(context, static_cast<unsigned long long>(inputSize)));
+  }
+
+  std::vector<char> inputBuffer(ZSTD_CStreamInSize());
+  std::vector<char> outputBuffer(ZSTD_CStreamOutSize());
+  bool last = false;
+  while (!last)
+  {
+    input.read(inputBuffer.data(), static_cast<std::streamsize>(inputBuffer.size()));
+    const auto readSize = static_cast<size_t>(input.gcount());
+    last = readSize < inputBuffer.size();
+    const ZSTD_EndDirective mode = last ? ZSTD_e_end : ZSTD_e_continue;
+    ZSTD_inBuffer inBuffer = { inputBuffer.data(), readSize, 0 };
+    bool finished = false;
+    while (!finished)
+    {
+      ZSTD_outBuffer outBuffer = { outputBuffer.data(), outputBuffer.size(), 0 };
+      const size_t remaining = check(ZSTD_compressStream2(context, &outBuffer, &inBuffer, mode));
+      sink(outputBuffer.data(), outBuffer.pos);
+      finished = last ? remaining == 0 : inBuffer.pos == inBuffer.size;
+    }
+  }
+  ZSTD_freeCCtx(context);
+}
+
+/** Decompress zstd frames, fed in blocks of any size, to an output stream, a
+ * ZSTD_DStreamOutSize block at a time, optionally with the dictionary they
+ * were compressed with. */
+class DecompressStream
+{
+public:
+  explicit DecompressStream(std::ostream & output, const ZSTD_DDict * dictionary = nullptr)
+    : m_Output(output)
+    , m_Context(ZSTD_createDCtx())
+    , m_OutputBuffer(ZSTD_DStreamOutSize())
+  {
+    if (m_Context == nullptr)
+    {
+      throw std::runtime_error("Could not create the zstd decompression context");
+    }
+    if (dictionary != nullptr && ZSTD_isError(ZSTD_DCtx_refDDict(m_Context, dictionary)))
+    {
+      ZSTD_freeDCtx(m_Context);
+      throw std::runtime_error("Could not use the zstd dictionary");
+    }
+  }
+
+  ~DecompressStream()
+  {
+    ZSTD_freeDCtx(m_Context);
+  }
+
+  DecompressStream(const DecompressStream &) = delete;
+  DecompressStream &
+  operator=(const DecompressStream &) = delete;
+
+  void
+  Add(const char * data, size_t size)
+  {
+    ZSTD_inBuffer inBuffer = { data, size, 0 };
+    bool          outputFull = false;
+    // A full output buffer may leave decompressed bytes in the decoder
+    while (inBuffer.pos < inBuffer.size || outputFull)
+    {
+      ZSTD_outBuffer outBuffer = { m_OutputBuffer.data(), m_OutputBuffer.size(), 0 };
+      const size_t   inputPosition = inBuffer.pos;
+      const size_t   remaining = ZSTD_decompressStream(m_Context, &outBuffer, &inBuffer);
+      if (ZSTD_isError(remaining))
+      {
+        throw std::runtime_error(std::string("zstd decompression failed: ") + ZSTD_getErrorName(remaining));
+      }
+      // A flush that finds nothing left returns the size of the next frame
+      // header, which does not mean the last frame is incomplete
+      if (outBuffer.pos > 0 || inBuffer.pos > inputPosition)
+      {
+        m_Remaining = remaining;
+      }
+      m_Output.write(m_OutputBuffer.data(), static_cast<std::streamsize>(outBuffer.pos));
+      outputFull = outBuffer.pos == outBuffer.size;
+    }
+  }
+
+  /** Throws if the last frame is incomplete. */
+  void
+  Finish() const
+  {
+    if (m_Remaining != 0)
+    {
+      throw std::runtime_error("Truncated zstd frame");
+    }
+  }
+
+private:
+  std::ostream &    m_Output;
+  ZSTD_DCtx *       m_Context;
+  std::vector<char> m_OutputBuffer;
+  size_t            m_Remaining{ 0 };
+};
+
+#endif
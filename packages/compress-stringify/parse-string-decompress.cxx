@@ -16,22 +16,20 @@
  *
  *=========================================================================*/
 
-#include <fstream>
+#include <algorithm>
 #include <string>
+#include <string_view>
 #include <iostream>
-#include <sstream>
 #include <vector>
-#include <iterator>
 
-#include "zstd.h"
-#include "cpp-base64/base64.h"
+#include "compressStringifyStream.h"
 
 #include "itkPipeline.h"
 #include "itkInputBinaryStream.h"
 #include "itkInputTextStream.h"
 #include "itkOutputBinaryStream.h"
 
-int decompress(itk::wasm::Pipeline & pipeline)
+int decompress(itk::wasm::Pipeline & pipeline, const std::string & dictionaryFileName)
 {
   itk::wasm::InputBinaryStream inputBinaryStream;
   pipeline.add_option("input", inputBinaryStream, "Compressed input")->type_name("INPUT_BINARY_STREAM");
@@ -41,24 +39,32 @@ int decompress(itk::wasm::Pipeline & pipeline)
 
   ITK_WASM_PARSE(pipeline);
 
-  std::string inputBinary;
-  inputBinary.assign( (std::istreambuf_iterator<char>(inputBinaryStream.Get()) ), 
-                      (std::istreambuf_iterator<char>()) ); 
+  std::shared_ptr<const itk::wasm::ZstdDictionary> dictionary;
+  ITK_WASM_CATCH_EXCEPTION(pipeline, dictionary = readZstdDictionary(dictionaryFileName));
 
-
-  const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-  std::vector<char> decompressedBinary(decompressedBufferSize);
-
-  const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-  decompressedBinary.resize(decompressedSize);
-
-  std::ostream_iterator<char> oIt(outputBinaryStream.Get());
-  std::copy(decompressedBinary.begin(), decompressedBinary.end(), oIt);
+  DecompressStream decompressor(outputBinaryStream.Get(), dictionary ? dictionary->GetDecompressionDictionary() : nullptr);
+  if (inputBinaryStream.GetData() != nullptr)
+  {
+    // Memory IO input is decompressed in place
+    ITK_WASM_CATCH_EXCEPTION(pipeline, decompressor.Add(inputBinaryStream.GetData(), inputBinaryStream.GetSize()));
+  }
+  else
+  {
+    // Blocks are decompressed as they are read
+    std::istream & input = inputBinaryStream.Get();
+    std::vector<char> inputBlock(ZSTD_DStreamInSize());
+    while (input)
+    {
+      input.read(inputBlock.data(), static_cast<std::streamsize>(inputBlock.size()));
+      ITK_WASM_CATCH_EXCEPTION(pipeline, decompressor.Add(inputBlock.data(), static_cast<size_t>(input.gcount())));
+    }
+  }
+  ITK_WASM_CATCH_EXCEPTION(pipeline, decompressor.Finish());
 
   return EXIT_SUCCESS;
 }
 
-int decodeDecompress(itk::wasm::Pipeline & pipeline)
+int decodeDecompress(itk::wasm::Pipeline & pipeline, const std::string & dictionaryFileName)
 {
   itk::wasm::InputTextStream inputTextStream;
   pipeline.add_option("input", inputTextStream, "Compressed input")->type_name("INPUT_TEXT_STREAM");
@@ -68,28 +74,54 @@ int decodeDecompress(itk::wasm::Pipeline & pipeline)
 
   ITK_WASM_PARSE(pipeline);
 
+  std::shared_ptr<const itk::wasm::ZstdDictionary> dictionary;
+  ITK_WASM_CATCH_EXCEPTION(pipeline, dictionary = readZstdDictionary(dictionaryFileName));
+
   // Skip dataURLPrefix
-  auto inputTextIt = std::istream_iterator<char>(inputTextStream.Get());
-  while (*inputTextIt != ',')
+  std::istream & input = inputTextStream.Get();
+  std::string dataURLPrefix;
+  if (!std::getline(input, dataURLPrefix, ',') || input.eof())
   {
-    inputTextIt++;
+    CLI::Error err("Runtime error", "Expected a dataURL prefix ending with a comma", 1);
+    return pipeline.exit(err);
   }
-  inputTextIt++;
-
-  std::string inputText;
-  inputText.assign( (inputTextIt), 
-                    (std::istream_iterator<char>()) ); 
 
-  auto inputBinary = base64_decode(inputText);
-
-  const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-  std::vector<char> decompressedBinary(decompressedBufferSize);
-
-  const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-  decompressedBinary.resize(decompressedSize);
-
-  std::ostream_iterator<char> oIt(outputBinaryStream.Get());
-  std::copy(decompressedBinary.begin(), decompressedBinary.end(), oIt);
+  // Blocks are decoded and decompressed as they are read
+  DecompressStream decompressor(outputBinaryStream.Get(), dictionary ? dictionary->GetDecompressionDictionary() : nullptr);
+  Base64Decoder decoder;
+  std::vector<char> inputBinary;
+  const auto decodeBlock = [&](const char * text, size_t size, bool last) {
+    decoder.Add(text, size, inputBinary);
+    if (last)
+    {
+      decoder.Finish(inputBinary);
+    }
+    decompressor.Add(inputBinary.data(), inputBinary.size());
+    inputBinary.clear();
+  };
+  const size_t blockSize = 4 * ZSTD_DStreamInSize() / 3;
+  const std::string_view text = inputTextStream.GetView();
+  if (!text.empty())
+  {
+    // Memory IO text is decoded in place
+    size_t offset = static_cast<size_t>(input.tellg());
+    do
+    {
+      const size_t size = std::min(blockSize, text.size() - offset);
+      ITK_WASM_CATCH_EXCEPTION(pipeline, decodeBlock(text.data() + offset, size, offset + size == text.size()));
+      offset += size;
+    } while (offset < text.size());
+  }
+  else
+  {
+    std::vector<char> inputText(blockSize);
+    while (input)
+    {
+      input.read(inputText.data(), static_cast<std::streamsize>(inputText.size()));
+      ITK_WASM_CATCH_EXCEPTION(pipeline, decodeBlock(inputText.data(), static_cast<size_t>(input.gcount()), !input));
+    }
+  }
+  ITK_WASM_CATCH_EXCEPTION(pipeline, decompressor.Finish());
 
   return EXIT_SUCCESS;
 }
@@ -101,12 +133,15 @@ int main(int argc, char * argv[])
   bool parseString = false;
   pipeline.add_flag("-s,--parse-string", parseString, "Parse the input string before decompression");
 
+  std::string dictionaryFileName;
+  pipeline.add_option("-d,--dictionary", dictionaryFileName, "zstd dictionary the input was compressed with")->check(CLI::ExistingFile)->type_name("INPUT_BINARY_FILE");
+
   ITK_WASM_PRE_PARSE(pipeline);
 
   if(parseString)
   {
-    return decodeDecompress(pipeline);
+    return decodeDecompress(pipeline, dictionaryFileName);
   }
-  return decompress(pipeline);
+  return decompress(pipeline, dictionaryFileName);
 }
 
@@ -2,5 +2,6 @@
 
 from .compress_stringify_async import compress_stringify_async
 from .parse_string_decompress_async import parse_string_decompress_async
+from .train_zstd_dictionary_async import train_zstd_dictionary_async
 
 from ._version import __version__
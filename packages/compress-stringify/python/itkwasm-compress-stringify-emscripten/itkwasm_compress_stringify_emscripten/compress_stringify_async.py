@@ -14,6 +14,7 @@ from itkwasm.pyodide import (
 from itkwasm import (
     InterfaceTypes,
     BinaryStream,
+    BinaryFile,
 )
 
 async def compress_stringify_async(
@@ -21,6 +22,7 @@ async def compress_stringify_async(
     stringify: bool = False,
     compression_level: int = 3,
     data_url_prefix: str = "data:application/zstd;base64,",
+    dictionary: Optional[os.PathLike] = None,
 ) -> bytes:
     """Given a binary, compress and optionally base64 encode.
 
@@ -36,6 +38,9 @@ async def compress_stringify_async(
     :param data_url_prefix: dataURL prefix
     :type  data_url_prefix: str
 
+    :param dictionary: zstd dictionary, e.g. from train-zstd-dictionary, for small inputs similar to its samples
+    :type  dictionary: os.PathLike
+
     :return: Output compressed binary
     :rtype:  bytes
     """
@@ -49,6 +54,8 @@ async def compress_stringify_async(
         kwargs["compressionLevel"] = to_js(compression_level)
     if data_url_prefix:
         kwargs["dataUrlPrefix"] = to_js(data_url_prefix)
+    if dictionary is not None:
+        kwargs["dictionary"] = to_js(BinaryFile(dictionary))
 
     outputs = await js_module.compressStringify(to_js(input), webWorker=web_worker, noCopy=True, **kwargs)
 
@@ -0,0 +1,59 @@
+# Generated file. To retain edits, remove this comment.
+
+from pathlib import Path
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from .js_package import js_package
+
+from itkwasm.pyodide import (
+    to_js,
+    to_py,
+    js_resources
+)
+from itkwasm import (
+    InterfaceTypes,
+    BinaryStream,
+    BinaryFile,
+)
+
+async def train_zstd_dictionary_async(
+    samples: List[os.PathLike] = [],
+    maximum_dictionary_size: int = 112640,
+) -> bytes:
+    """Train a zstd dictionary on sample inputs, for compress-stringify and parse-string-decompress of many small, similar inputs.
+
+    :param samples: Sample inputs, each a typical input to compress
+    :type  samples: os.PathLike
+
+    :param maximum_dictionary_size: Maximum dictionary size in bytes, typically about 100 times smaller than the total sample size
+    :type  maximum_dictionary_size: int
+
+    :return: Output zstd dictionary
+    :rtype:  bytes
+    """
+    js_module = await js_package.js_module
+    web_worker = js_resources.web_worker
+
+    kwargs = {}
+    if samples is not None:
+        kwargs["samples"] = to_js(BinaryFile(samples))
+    if maximum_dictionary_size:
+        kwargs["maximumDictionarySize"] = to_js(maximum_dictionary_size)
+
+    outputs = await js_module.trainZstdDictionary(webWorker=web_worker, noCopy=True, **kwargs)
+
+    output_web_worker = None
+    output_list = []
+    outputs_object_map = outputs.as_object_map()
+    for output_name in outputs.object_keys():
+        if output_name == 'webWorker':
+            output_web_worker = outputs_object_map[output_name]
+        else:
+            output_list.append(to_py(outputs_object_map[output_name]))
+
+    js_resources.web_worker = output_web_worker
+
+    if len(output_list) == 1:
+        return output_list[0]
+    return tuple(output_list)
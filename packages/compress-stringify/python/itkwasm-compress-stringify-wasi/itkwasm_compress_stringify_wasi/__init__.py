@@ -2,5 +2,6 @@
 
 from .compress_stringify import compress_stringify
 from .parse_string_decompress import parse_string_decompress
+from .train_zstd_dictionary import train_zstd_dictionary
 
 from ._version import __version__
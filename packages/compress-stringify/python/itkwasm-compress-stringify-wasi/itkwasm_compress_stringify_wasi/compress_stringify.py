@@ -14,6 +14,7 @@ from itkwasm import (
     PipelineInput,
     Pipeline,
     BinaryStream,
+    BinaryFile,
 )
 
 def compress_stringify(
@@ -21,6 +22,7 @@ def compress_stringify(
     stringify: bool = False,
     compression_level: int = 3,
     data_url_prefix: str = "data:application/zstd;base64,",
+    dictionary: Optional[os.PathLike] = None,
 ) -> bytes:
     """Given a binary, compress and optionally base64 encode.
 
@@ -36,6 +38,9 @@ def compress_stringify(
     :param data_url_prefix: dataURL prefix
     :type  data_url_prefix: str
 
+    :param dictionary: zstd dictionary, e.g. from train-zstd-dictionary, for small inputs similar to its samples
+    :type  dictionary: os.PathLike
+
     :return: Output compressed binary
     :rtype:  bytes
     """
@@ -71,6 +76,12 @@ def compress_stringify(
         args.append('--data-url-prefix')
         args.append(str(data_url_prefix))
 
+    if dictionary is not None:
+        input_file = str(PurePosixPath(dictionary))
+        pipeline_inputs.append(PipelineInput(InterfaceTypes.BinaryFile, BinaryFile(dictionary)))
+        args.append('--dictionary')
+        args.append(input_file)
+
 
     outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
 
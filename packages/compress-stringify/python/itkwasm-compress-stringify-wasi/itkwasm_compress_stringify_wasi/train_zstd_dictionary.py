@@ -0,0 +1,72 @@
+# Generated file. To retain edits, remove this comment.
+
+from pathlib import Path, PurePosixPath
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from importlib_resources import files as file_resources
+
+_pipeline = None
+
+from itkwasm import (
+    InterfaceTypes,
+    PipelineOutput,
+    PipelineInput,
+    Pipeline,
+    BinaryStream,
+    BinaryFile,
+)
+
+def train_zstd_dictionary(
+    samples: List[os.PathLike] = [],
+    maximum_dictionary_size: int = 112640,
+) -> bytes:
+    """Train a zstd dictionary on sample inputs, for compress-stringify and parse-string-decompress of many small, similar inputs.
+
+    :param samples: Sample inputs, each a typical input to compress
+    :type  samples: os.PathLike
+
+    :param maximum_dictionary_size: Maximum dictionary size in bytes, typically about 100 times smaller than the total sample size
+    :type  maximum_dictionary_size: int
+
+    :return: Output zstd dictionary
+    :rtype:  bytes
+    """
+    global _pipeline
+    if _pipeline is None:
+        _pipeline = Pipeline(file_resources('itkwasm_compress_stringify_wasi').joinpath(Path('wasm_modules') / Path('train-zstd-dictionary.wasi.wasm')))
+
+    pipeline_outputs: List[PipelineOutput] = [
+        PipelineOutput(InterfaceTypes.BinaryStream),
+    ]
+
+    pipeline_inputs: List[PipelineInput] = [
+    ]
+
+    args: List[str] = ['--memory-io',]
+    # Inputs
+    # Outputs
+    dictionary_name = '0'
+    args.append(dictionary_name)
+
+    # Options
+    input_count = len(pipeline_inputs)
+    if len(samples) < 1:
+       raise ValueError('"samples" kwarg must have a length > 1')
+    if len(samples) > 0:
+        args.append('--samples')
+        for value in samples:
+            input_file = str(PurePosixPath(value))
+            pipeline_inputs.append(PipelineInput(InterfaceTypes.BinaryFile, BinaryFile(value)))
+            args.append(input_file)
+
+    if maximum_dictionary_size:
+        args.append('--maximum-dictionary-size')
+        args.append(str(maximum_dictionary_size))
+
+
+    outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
+
+    result = outputs[0].data.data
+    return result
+
@@ -0,0 +1,8 @@
+# Generated file. To retain edits, remove this comment.
+
+from itkwasm_compress_stringify_wasi import train_zstd_dictionary
+
+from .common import test_input_path, test_output_path
+
+def test_train_zstd_dictionary():
+    pass
@@ -4,6 +4,8 @@ from .compress_stringify_async import compress_stringify_async
 from .compress_stringify import compress_stringify
 from .parse_string_decompress_async import parse_string_decompress_async
 from .parse_string_decompress import parse_string_decompress
+from .train_zstd_dictionary_async import train_zstd_dictionary_async
+from .train_zstd_dictionary import train_zstd_dictionary
 
 from ._version import __version__
 
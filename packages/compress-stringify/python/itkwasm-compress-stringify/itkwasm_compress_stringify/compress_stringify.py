@@ -6,6 +6,7 @@ from typing import Dict, Tuple, Optional, List, Any
 from itkwasm import (
     environment_dispatch,
     BinaryStream,
+    BinaryFile,
 )
 
 def compress_stringify(
@@ -13,6 +14,7 @@ def compress_stringify(
     stringify: bool = False,
     compression_level: int = 3,
     data_url_prefix: str = "data:application/zstd;base64,",
+    dictionary: Optional[os.PathLike] = None,
 ) -> bytes:
     """Given a binary, compress and optionally base64 encode.
 
@@ -28,9 +30,12 @@ def compress_stringify(
     :param data_url_prefix: dataURL prefix
     :type  data_url_prefix: str
 
+    :param dictionary: zstd dictionary, e.g. from train-zstd-dictionary, for small inputs similar to its samples
+    :type  dictionary: os.PathLike
+
     :return: Output compressed binary
     :rtype:  bytes
     """
     func = environment_dispatch("itkwasm_compress_stringify", "compress_stringify")
-    output = func(input, stringify=stringify, compression_level=compression_level, data_url_prefix=data_url_prefix)
+    output = func(input, stringify=stringify, compression_level=compression_level, data_url_prefix=data_url_prefix, dictionary=dictionary)
     return output
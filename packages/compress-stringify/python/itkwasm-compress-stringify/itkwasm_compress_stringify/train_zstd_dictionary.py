@@ -0,0 +1,29 @@
+# Generated file. Do not edit.
+
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from itkwasm import (
+    environment_dispatch,
+    BinaryStream,
+    BinaryFile,
+)
+
+def train_zstd_dictionary(
+    samples: List[os.PathLike] = [],
+    maximum_dictionary_size: int = 112640,
+) -> bytes:
+    """Train a zstd dictionary on sample inputs, for compress-stringify and parse-string-decompress of many small, similar inputs.
+
+    :param samples: Sample inputs, each a typical input to compress
+    :type  samples: os.PathLike
+
+    :param maximum_dictionary_size: Maximum dictionary size in bytes, typically about 100 times smaller than the total sample size
+    :type  maximum_dictionary_size: int
+
+    :return: Output zstd dictionary
+    :rtype:  bytes
+    """
+    func = environment_dispatch("itkwasm_compress_stringify", "train_zstd_dictionary")
+    output = func(samples=samples, maximum_dictionary_size=maximum_dictionary_size)
+    return output
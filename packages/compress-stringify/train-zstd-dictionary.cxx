@@ -0,0 +1,71 @@
+/*=========================================================================
+
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "zdict.h"
+
+#include "itkPipeline.h"
+#include "itkOutputBinaryStream.h"
+
+int main(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("train-zstd-dictionary", "Train a zstd dictionary on sample inputs, for compress-stringify and parse-string-decompress of many small, similar inputs.", argc, argv);
+
+  std::vector<std::string> sampleFileNames;
+  pipeline.add_option("-s,--samples", sampleFileNames, "Sample inputs, each a typical input to compress")->required()->check(CLI::ExistingFile)->expected(1,-1)->type_name("INPUT_BINARY_FILE");
+
+  itk::wasm::OutputBinaryStream outputBinaryStream;
+  pipeline.add_option("dictionary", outputBinaryStream, "Output zstd dictionary")->required()->type_name("OUTPUT_BINARY_STREAM");
+
+  size_t maximumDictionarySize = 112640;
+  pipeline.add_option("-m,--maximum-dictionary-size", maximumDictionarySize, "Maximum dictionary size in bytes, typically about 100 times smaller than the total sample size");
+
+  ITK_WASM_PARSE(pipeline);
+
+  // The samples are concatenated for the trainer
+  std::vector<char> samples;
+  std::vector<size_t> sampleSizes;
+  sampleSizes.reserve(sampleFileNames.size());
+  for (const std::string & sampleFileName : sampleFileNames)
+  {
+    std::ifstream sampleStream(sampleFileName, std::ios::in | std::ios::binary);
+    const size_t previousSize = samples.size();
+    samples.insert(samples.end(), std::istreambuf_iterator<char>(sampleStream), std::istreambuf_iterator<char>());
+    if (!sampleStream.eof())
+    {
+      CLI::Error err("Runtime error", "Could not read " + sampleFileName, 1);
+      return pipeline.exit(err);
+    }
+    sampleSizes.push_back(samples.size() - previousSize);
+  }
+
+  std::vector<char> dictionary(maximumDictionarySize);
+  const size_t dictionarySize = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samples.data(), sampleSizes.data(), static_cast<unsigned int>(sampleSizes.size()));
+  if (ZDICT_isError(dictionarySize))
+  {
+    // e.g. too few or too small samples
+    CLI::Error err("Runtime error", std::string("Could not train the zstd dictionary: ") + ZDICT_getErrorName(dictionarySize), 1);
+    return pipeline.exit(err);
+  }
+  outputBinaryStream.Get().write(dictionary.data(), static_cast<std::streamsize>(dictionarySize));
+
+  return EXIT_SUCCESS;
+}
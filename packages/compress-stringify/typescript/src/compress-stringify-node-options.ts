@@ -1,5 +1,7 @@
 // Generated file. To retain edits, remove this comment.
 
+import { BinaryFile } from 'itk-wasm'
+
 interface CompressStringifyNodeOptions {
   /** Stringify the output */
   stringify?: boolean
@@ -10,6 +12,9 @@ interface CompressStringifyNodeOptions {
   /** dataURL prefix */
   dataUrlPrefix?: string
 
+  /** zstd dictionary, e.g. from train-zstd-dictionary, for small inputs similar to its samples */
+  dictionary?: string | File | BinaryFile
+
 }
 
 export default CompressStringifyNodeOptions
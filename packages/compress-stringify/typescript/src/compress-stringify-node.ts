@@ -27,6 +27,8 @@ async function compressStringifyNode(
   options: CompressStringifyNodeOptions = {}
 ) : Promise<CompressStringifyNodeResult> {
 
+  const mountDirs: Set<string> = new Set()
+
   const desiredOutputs: Array<PipelineOutput> = [
     { type: InterfaceTypes.BinaryStream },
   ]
@@ -56,6 +58,15 @@ async function compressStringifyNode(
   if (options.dataUrlPrefix) {
     args.push('--data-url-prefix', options.dataUrlPrefix.toString())
 
+  }
+  if (options.dictionary) {
+    const dictionary = options.dictionary
+    mountDirs.add(path.dirname(dictionary as string))
+    args.push('--dictionary')
+
+    const name = dictionary as string
+    args.push(name)
+
   }
 
   const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'compress-stringify')
@@ -64,7 +75,7 @@ async function compressStringifyNode(
     returnValue,
     stderr,
     outputs
-  } = await runPipelineNode(pipelinePath, args, desiredOutputs, inputs)
+  } = await runPipelineNode(pipelinePath, args, desiredOutputs, inputs, mountDirs)
   if (returnValue !== 0 && stderr !== "") {
     throw new Error(stderr)
   }
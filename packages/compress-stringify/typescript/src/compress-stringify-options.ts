@@ -1,6 +1,6 @@
 // Generated file. To retain edits, remove this comment.
 
-import { WorkerPoolFunctionOption } from 'itk-wasm'
+import { BinaryFile, WorkerPoolFunctionOption } from 'itk-wasm'
 
 interface CompressStringifyOptions extends WorkerPoolFunctionOption {
   /** Stringify the output */
@@ -12,6 +12,9 @@ interface CompressStringifyOptions extends WorkerPoolFunctionOption {
   /** dataURL prefix */
   dataUrlPrefix?: string
 
+  /** zstd dictionary, e.g. from train-zstd-dictionary, for small inputs similar to its samples */
+  dictionary?: string | File | BinaryFile
+
 }
 
 export default CompressStringifyOptions
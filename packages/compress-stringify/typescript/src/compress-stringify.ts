@@ -2,6 +2,7 @@
 
 import {
   BinaryStream,
+  BinaryFile,
   InterfaceTypes,
   PipelineOutput,
   PipelineInput,
@@ -58,6 +59,20 @@ async function compressStringify(
   if (options.dataUrlPrefix) {
     args.push('--data-url-prefix', options.dataUrlPrefix.toString())
 
+  }
+  if (options.dictionary) {
+    const dictionary = options.dictionary
+    let dictionaryFile = dictionary
+    if (dictionary instanceof File) {
+      const dictionaryBuffer = await dictionary.arrayBuffer()
+      dictionaryFile = { path: dictionary.name, data: new Uint8Array(dictionaryBuffer) }
+    }
+    args.push('--dictionary')
+
+    inputs.push({ type: InterfaceTypes.BinaryFile, data: dictionaryFile as BinaryFile })
+    const name = dictionary instanceof File ? dictionary.name : (dictionary as BinaryFile).path
+    args.push(name)
+
   }
 
   const pipelinePath = 'compress-stringify'
@@ -46,3 +46,12 @@ export type { ParseStringDecompressNodeOptions };
 
 import parseStringDecompressNode from "./parse-string-decompress-node.js";
 export { parseStringDecompressNode };
+
+import TrainZstdDictionaryNodeResult from "./train-zstd-dictionary-node-result.js";
+export type { TrainZstdDictionaryNodeResult };
+
+import TrainZstdDictionaryNodeOptions from "./train-zstd-dictionary-node-options.js";
+export type { TrainZstdDictionaryNodeOptions };
+
+import trainZstdDictionaryNode from "./train-zstd-dictionary-node.js";
+export { trainZstdDictionaryNode };
@@ -62,3 +62,12 @@ export type { ParseStringDecompressOptions };
 
 import parseStringDecompress from "./parse-string-decompress.js";
 export { parseStringDecompress };
+
+import TrainZstdDictionaryResult from "./train-zstd-dictionary-result.js";
+export type { TrainZstdDictionaryResult };
+
+import TrainZstdDictionaryOptions from "./train-zstd-dictionary-options.js";
+export type { TrainZstdDictionaryOptions };
+
+import trainZstdDictionary from "./train-zstd-dictionary.js";
+export { trainZstdDictionary };
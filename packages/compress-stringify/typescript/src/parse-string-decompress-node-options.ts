@@ -1,9 +1,14 @@
 // Generated file. To retain edits, remove this comment.
 
+import { BinaryFile } from 'itk-wasm'
+
 interface ParseStringDecompressNodeOptions {
   /** Parse the input string before decompression */
   parseString?: boolean
 
+  /** zstd dictionary the input was compressed with */
+  dictionary?: string | File | BinaryFile
+
 }
 
 export default ParseStringDecompressNodeOptions
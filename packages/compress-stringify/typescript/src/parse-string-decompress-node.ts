@@ -27,6 +27,8 @@ async function parseStringDecompressNode(
   options: ParseStringDecompressNodeOptions = {}
 ) : Promise<ParseStringDecompressNodeResult> {
 
+  const mountDirs: Set<string> = new Set()
+
   const desiredOutputs: Array<PipelineOutput> = [
     { type: InterfaceTypes.BinaryStream },
   ]
@@ -49,6 +51,15 @@ async function parseStringDecompressNode(
   if (options.parseString) {
     options.parseString && args.push('--parse-string')
   }
+  if (options.dictionary) {
+    const dictionary = options.dictionary
+    mountDirs.add(path.dirname(dictionary as string))
+    args.push('--dictionary')
+
+    const name = dictionary as string
+    args.push(name)
+
+  }
 
   const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'parse-string-decompress')
 
@@ -56,7 +67,7 @@ async function parseStringDecompressNode(
     returnValue,
     stderr,
     outputs
-  } = await runPipelineNode(pipelinePath, args, desiredOutputs, inputs)
+  } = await runPipelineNode(pipelinePath, args, desiredOutputs, inputs, mountDirs)
   if (returnValue !== 0 && stderr !== "") {
     throw new Error(stderr)
   }
@@ -0,0 +1,14 @@
+// Generated file. To retain edits, remove this comment.
+
+import { BinaryFile } from 'itk-wasm'
+
+interface TrainZstdDictionaryNodeOptions {
+  /** Sample inputs, each a typical input to compress */
+  samples: string[] | File[] | BinaryFile[]
+
+  /** Maximum dictionary size in bytes, typically about 100 times smaller than the total sample size */
+  maximumDictionarySize?: number
+
+}
+
+export default TrainZstdDictionaryNodeOptions
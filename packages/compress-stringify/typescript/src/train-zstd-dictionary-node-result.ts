@@ -0,0 +1,9 @@
+// Generated file. To retain edits, remove this comment.
+
+interface TrainZstdDictionaryNodeResult {
+  /** Output zstd dictionary */
+  dictionary: Uint8Array
+
+}
+
+export default TrainZstdDictionaryNodeResult
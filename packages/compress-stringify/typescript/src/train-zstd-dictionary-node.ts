@@ -0,0 +1,78 @@
+// Generated file. To retain edits, remove this comment.
+
+import {
+  BinaryStream,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipelineNode
+} from 'itk-wasm'
+
+import TrainZstdDictionaryNodeOptions from './train-zstd-dictionary-node-options.js'
+import TrainZstdDictionaryNodeResult from './train-zstd-dictionary-node-result.js'
+
+import path from 'path'
+import { fileURLToPath } from 'url'
+
+/**
+ * Train a zstd dictionary on sample inputs, for compress-stringify and parse-string-decompress of many small, similar inputs.
+ *
+ * @param {TrainZstdDictionaryNodeOptions} options - options object
+ *
+ * @returns {Promise<TrainZstdDictionaryNodeResult>} - result object
+ */
+async function trainZstdDictionaryNode(
+  options: TrainZstdDictionaryNodeOptions = { samples: [] as string[], }
+) : Promise<TrainZstdDictionaryNodeResult> {
+
+  const mountDirs: Set<string> = new Set()
+
+  const desiredOutputs: Array<PipelineOutput> = [
+    { type: InterfaceTypes.BinaryStream },
+  ]
+
+  const inputs: Array<PipelineInput> = [
+  ]
+
+  const args = []
+  // Inputs
+  // Outputs
+  const dictionaryName = '0'
+  args.push(dictionaryName)
+
+  // Options
+  args.push('--memory-io')
+  if (options.samples) {
+    if(options.samples.length < 1) {
+      throw new Error('"samples" option must have a length > 1')
+    }
+    args.push('--samples')
+
+    options.samples.forEach((value) => {
+      mountDirs.add(path.dirname(value as string))
+      args.push(value as string)
+    })
+  }
+  if (options.maximumDictionarySize) {
+    args.push('--maximum-dictionary-size', options.maximumDictionarySize.toString())
+
+  }
+
+  const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'train-zstd-dictionary')
+
+  const {
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipelineNode(pipelinePath, args, desiredOutputs, inputs, mountDirs)
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    dictionary: (outputs[0]?.data as BinaryStream).data,
+  }
+  return result
+}
+
+export default trainZstdDictionaryNode
@@ -0,0 +1,11 @@
+// Generated file. To retain edits, remove this comment.
+
+import { WorkerPoolFunctionResult } from 'itk-wasm'
+
+interface TrainZstdDictionaryResult extends WorkerPoolFunctionResult {
+  /** Output zstd dictionary */
+  dictionary: Uint8Array
+
+}
+
+export default TrainZstdDictionaryResult
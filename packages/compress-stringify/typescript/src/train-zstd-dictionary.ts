@@ -0,0 +1,91 @@
+// Generated file. To retain edits, remove this comment.
+
+import {
+  BinaryStream,
+  BinaryFile,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipeline
+} from 'itk-wasm'
+
+import TrainZstdDictionaryOptions from './train-zstd-dictionary-options.js'
+import TrainZstdDictionaryResult from './train-zstd-dictionary-result.js'
+
+import { getPipelinesBaseUrl } from './pipelines-base-url.js'
+import { getPipelineWorkerUrl } from './pipeline-worker-url.js'
+
+import { getDefaultWebWorker } from './default-web-worker.js'
+
+/**
+ * Train a zstd dictionary on sample inputs, for compress-stringify and parse-string-decompress of many small, similar inputs.
+ *
+ * @param {TrainZstdDictionaryOptions} options - options object
+ *
+ * @returns {Promise<TrainZstdDictionaryResult>} - result object
+ */
+async function trainZstdDictionary(
+  options: TrainZstdDictionaryOptions = { samples: [] as BinaryFile[] | File[] | string[], }
+) : Promise<TrainZstdDictionaryResult> {
+
+  const desiredOutputs: Array<PipelineOutput> = [
+    { type: InterfaceTypes.BinaryStream },
+  ]
+
+  const inputs: Array<PipelineInput> = [
+  ]
+
+  const args = []
+  // Inputs
+  // Outputs
+  const dictionaryName = '0'
+  args.push(dictionaryName)
+
+  // Options
+  args.push('--memory-io')
+  if (options.samples) {
+    if(options.samples.length < 1) {
+      throw new Error('"samples" option must have a length > 1')
+    }
+    args.push('--samples')
+
+    await Promise.all(options.samples.map(async (value) => {
+      let valueFile = value
+      if (value instanceof File) {
+        const valueBuffer = await value.arrayBuffer()
+        valueFile = { path: value.name, data: new Uint8Array(valueBuffer) }
+      }
+      inputs.push({ type: InterfaceTypes.BinaryFile, data: valueFile as BinaryFile })
+      const name = value instanceof File ? value.name : (valueFile as BinaryFile).path
+      args.push(name)
+    }))
+  }
+  if (options.maximumDictionarySize) {
+    args.push('--maximum-dictionary-size', options.maximumDictionarySize.toString())
+
+  }
+
+  const pipelinePath = 'train-zstd-dictionary'
+
+  let workerToUse = options?.webWorker
+  if (workerToUse === undefined) {
+    workerToUse = await getDefaultWebWorker()
+  }
+  const {
+    webWorker: usedWebWorker,
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipeline(pipelinePath, args, desiredOutputs, inputs, { pipelineBaseUrl: getPipelinesBaseUrl(), pipelineWorkerUrl: getPipelineWorkerUrl(), webWorker: workerToUse, noCopy: options?.noCopy })
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    webWorker: usedWebWorker as Worker,
+    dictionary: (outputs[0]?.data as BinaryStream).data,
+  }
+  return result
+}
+
+export default trainZstdDictionary
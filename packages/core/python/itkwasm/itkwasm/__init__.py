@@ -3,16 +3,19 @@
 __version__ = "1.0b175"
 
 from .interface_types import InterfaceTypes
-from .image import Image, ImageType, ImageRegion
+from .image import Image, ImageType, ImageRegion, ComponentStatistics
 from .pointset import PointSet, PointSetType
 from .mesh import Mesh, MeshType
 from .polydata import PolyData, PolyDataType
+from .transform import Transform, TransformType
 from .binary_file import BinaryFile
 from .binary_stream import BinaryStream
 from .text_file import TextFile
 from .text_stream import TextStream
 from .json_compatible import JsonCompatible
 from .pipeline import Pipeline
+from .pipeline_session import PipelineSession, ResidentHandle
+from .interface_json import read_interface_json
 from .pipeline_input import PipelineInput
 from .pipeline_output import PipelineOutput
 from .float_types import FloatTypes
@@ -21,6 +24,7 @@ from .pixel_types import PixelTypes
 from .environment_dispatch import environment_dispatch, function_factory
 from .cast_image import cast_image
 from .image_from_array import image_from_array
+from .map_image_chunks import map_image_chunks
 from .to_numpy_array import (
     array_like_to_numpy_array,
     array_like_to_bytes,
@@ -31,17 +35,23 @@ from .to_cupy_array import array_like_to_cupy_array
 __all__ = [
     "InterfaceTypes",
     "Pipeline",
+    "PipelineSession",
+    "ResidentHandle",
     "PipelineInput",
     "PipelineOutput",
+    "read_interface_json",
     "Image",
     "ImageType",
     "ImageRegion",
+    "ComponentStatistics",
     "PointSet",
     "PointSetType",
     "Mesh",
     "MeshType",
     "PolyData",
     "PolyDataType",
+    "Transform",
+    "TransformType",
     "BinaryFile",
     "BinaryStream",
     "TextFile",
@@ -54,6 +64,7 @@ __all__ = [
     "function_factory",
     "cast_image",
     "image_from_array",
+    "map_image_chunks",
     "array_like_to_numpy_array",
     "array_like_to_bytes",
     "array_like_to_cupy_array",
@@ -1,6 +1,6 @@
 from dataclasses import dataclass, field
 
-from typing import Sequence, Union, Dict, Optional
+from typing import Sequence, Union, Dict, List, Optional
 
 try:
     from numpy.typing import ArrayLike
@@ -31,6 +31,15 @@ class ImageRegion:
     size: Sequence[int] = field(default_factory=list)
 
 
+@dataclass
+class ComponentStatistics:
+    minimum: float = 0.0
+    maximum: float = 0.0
+    mean: float = 0.0
+    # Counts of equal width bins from the minimum to the maximum
+    histogram: Sequence[int] = field(default_factory=list)
+
+
 @dataclass
 class Image:
     imageType: Union[ImageType, Dict] = field(default_factory=ImageType)
@@ -42,10 +51,16 @@ class Image:
     metadata: Dict = field(default_factory=dict)
     data: Optional[ArrayLike] = None
     bufferedRegion: Optional[ImageRegion] = None
+    intensityStatistics: Optional[List[Union[ComponentStatistics, Dict]]] = None
 
     def __post_init__(self):
         if isinstance(self.imageType, dict):
             self.imageType = ImageType(**self.imageType)
+        if self.intensityStatistics is not None:
+            self.intensityStatistics = [
+                ComponentStatistics(**component) if isinstance(component, dict) else component
+                for component in self.intensityStatistics
+            ]
 
         dimension = self.imageType.dimension
         if len(self.origin) == 0:
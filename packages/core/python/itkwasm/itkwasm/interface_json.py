@@ -0,0 +1,51 @@
+import json
+from pathlib import Path
+from typing import Optional, Tuple, Union
+
+INTERFACE_SECTION_NAME = "itk-wasm.interface"
+
+
+def _decode_uleb128(data: bytes, offset: int) -> Tuple[int, int]:
+    value = 0
+    shift = 0
+    while True:
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, offset
+
+
+def read_interface_json(wasm: Union[str, Path, bytes]) -> Optional[dict]:
+    """Read the pipeline interface JSON embedded in a wasm binary.
+
+    Pipelines built with ITK_WASM_EMBED_INTERFACE_JSON carry their
+    --interface-json output in the itk-wasm.interface custom section. The
+    sections are walked without compiling or instantiating the module.
+
+    :param wasm: Path to, or contents of, the .wasm binary
+    :type  wasm: str | Path | bytes
+
+    :return: The interface, or None when the binary does not embed it
+    :rtype:  dict
+    """
+    data = wasm if isinstance(wasm, (bytes, bytearray, memoryview)) else Path(wasm).read_bytes()
+    data = bytes(data)
+    if len(data) < 8 or data[:4] != b"\0asm":
+        return None
+    offset = 8
+    while offset < len(data):
+        section_id = data[offset]
+        size, content_start = _decode_uleb128(data, offset + 1)
+        section_end = content_start + size
+        if section_id == 0:
+            name_length, name_start = _decode_uleb128(data, content_start)
+            name_end = name_start + name_length
+            if data[name_start:name_end].decode("utf-8", errors="replace") == INTERFACE_SECTION_NAME:
+                try:
+                    return json.loads(data[name_end:section_end].decode("utf-8"))
+                except ValueError:
+                    return None
+        offset = section_end
+    return None
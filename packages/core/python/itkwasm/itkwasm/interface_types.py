@@ -7,6 +7,8 @@ class InterfaceTypes(Enum):
     TextStream = "InterfaceTextStream"
     BinaryStream = "InterfaceBinaryStream"
     Image = "InterfaceImage"
+    PointSet = "InterfacePointSet"
     Mesh = "InterfaceMesh"
     PolyData = "InterfacePolyData"
+    Transform = "InterfaceTransform"
     JsonCompatible = "InterfaceJsonCompatible"
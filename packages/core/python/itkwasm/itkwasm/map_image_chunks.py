@@ -0,0 +1,224 @@
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import replace
+from itertools import product
+from typing import Callable, List, Optional, Sequence, Tuple
+import sys
+
+if sys.version_info < (3, 10):
+    from importlib_metadata import distribution
+else:
+    from importlib.metadata import distribution
+
+import numpy as np
+
+from .image import Image, ImageType
+from .pixel_types import PixelTypes
+
+try:
+    distribution("dask")
+    _DASK_AVAILABLE = True
+except:
+    _DASK_AVAILABLE = False
+
+
+def _is_dask_array(arr) -> bool:
+    if not _DASK_AVAILABLE:
+        return False
+    import dask.array as da
+
+    return isinstance(arr, da.Array)
+
+
+def _has_component_axis(image_type: ImageType) -> bool:
+    return image_type.components > 1 or image_type.pixelType == PixelTypes.VariableLengthVector
+
+
+def _chunk_slices(begin: Sequence[int], end: Sequence[int]) -> Tuple[slice, ...]:
+    """Array slices of an index region, in the reversed, numpy, axis order."""
+    return tuple(slice(b, e) for b, e in zip(reversed(begin), reversed(end)))
+
+
+class _ChunkGrid:
+    """The output chunks of a chunked run and the input windows that cover them with their halo."""
+
+    def __init__(self, image: Image, chunk_size: Sequence[int], halo: Sequence[int], shrink_factors: Sequence[int]):
+        dimension = image.imageType.dimension
+        self.size = list(image.size)
+        self.shrink_factors = list(shrink_factors)
+        # Chunk starts and halos are multiples of the shrink factors, so the
+        # first output sample of each chunk is on the output grid
+        self.halo = [-(-h // f) * f for h, f in zip(halo, self.shrink_factors)]
+        self.output_size = [s // f for s, f in zip(self.size, self.shrink_factors)]
+        self.output_chunk_size = [max(1, c // f) for c, f in zip(chunk_size, self.shrink_factors)]
+        self.counts = [-(-o // c) for o, c in zip(self.output_size, self.output_chunk_size)]
+        if len(self.halo) != dimension or len(self.output_chunk_size) != dimension:
+            raise ValueError(f"chunk_size, halo, and shrink_factors must have {dimension} elements")
+
+    def chunks(self) -> List[Tuple[int, ...]]:
+        """Chunk grid positions, with the first axis fastest."""
+        return [tuple(reversed(position)) for position in product(*[range(c) for c in reversed(self.counts)])]
+
+    def output_region(self, position: Sequence[int]) -> Tuple[List[int], List[int]]:
+        begin = [p * c for p, c in zip(position, self.output_chunk_size)]
+        end = [min(b + c, o) for b, c, o in zip(begin, self.output_chunk_size, self.output_size)]
+        return begin, end
+
+    def input_region(self, position: Sequence[int]) -> Tuple[List[int], List[int]]:
+        output_begin, output_end = self.output_region(position)
+        begin = [max(0, b * f - h) for b, f, h in zip(output_begin, self.shrink_factors, self.halo)]
+        end = [min(s, e * f + h) for e, f, h, s in zip(output_end, self.shrink_factors, self.halo, self.size)]
+        return begin, end
+
+
+def _chunk_image(image: Image, data, begin: Sequence[int], end: Sequence[int]) -> Image:
+    """The input window as an Image placed at its physical location."""
+    direction = np.asarray(image.direction, dtype=np.float64).reshape(image.imageType.dimension, image.imageType.dimension)
+    offset = direction @ (np.asarray(image.spacing, dtype=np.float64) * np.asarray(begin, dtype=np.float64))
+    return Image(
+        imageType=replace(image.imageType),
+        name=image.name,
+        origin=list(np.asarray(image.origin, dtype=np.float64) + offset),
+        spacing=list(image.spacing),
+        direction=direction.copy(),
+        size=[e - b for b, e in zip(begin, end)],
+        metadata=dict(image.metadata),
+        data=np.ascontiguousarray(np.asarray(data)),
+    )
+
+
+def _run_chunk(function: Callable[..., Image], image: Image, grid: _ChunkGrid, position, data, kwargs) -> Tuple[Image, np.ndarray]:
+    """Run the function on a chunk and keep the output pixels of the chunk, without the halo."""
+    input_begin, input_end = grid.input_region(position)
+    result = function(_chunk_image(image, data, input_begin, input_end), **kwargs)
+    output_begin, output_end = grid.output_region(position)
+    # The result starts at the first input sample of the window
+    first = [b // f for b, f in zip(input_begin, grid.shrink_factors)]
+    local_begin = [b - f for b, f in zip(output_begin, first)]
+    local_end = [e - f for e, f in zip(output_end, first)]
+    result_data = np.asarray(result.data)
+    shape = tuple(reversed(result.size))
+    if _has_component_axis(result.imageType):
+        shape = shape + (result.imageType.components,)
+    result_data = result_data.reshape(shape)
+    return result, result_data[_chunk_slices(local_begin, local_end)]
+
+
+def map_image_chunks(
+    function: Callable[..., Image],
+    image: Image,
+    chunk_size: Sequence[int],
+    halo: Optional[Sequence[int]] = None,
+    shrink_factors: Optional[Sequence[int]] = None,
+    max_workers: Optional[int] = None,
+    **kwargs,
+) -> Image:
+    """Run an image function, e.g. a pipeline binding, on overlapping chunks of an image and stitch the results.
+
+    Each output chunk is computed from the input window of its pixels and the
+    halo around them, e.g. the kernel radius of a filter, as given by
+    gaussian_kernel_radius for downsample. With a halo at least the reach of
+    the function, the stitched pixels equal those of a single run on the whole
+    image. Chunks of a numpy array run concurrently on a thread pool, and
+    pipelines reuse their warm instances. When the image data is a dask array,
+    e.g. from dask.array.from_zarr, the output data is a dask array with a task
+    per chunk that reads only its input window, to run on any dask scheduler or
+    cluster.
+
+    The function is called as function(chunk, **kwargs) and returns an Image
+    whose first pixel is at the first input pixel of the chunk, on a grid with
+    shrink_factors times the input spacing, e.g. downsample or
+    downsample_bin_shrink without cropping, or a filter with the input grid.
+
+    :param function: Image function, called with a chunk Image and kwargs
+    :type  function: Callable[..., Image]
+
+    :param image: Input image, whose data is a numpy array or an array-like, e.g. a dask or zarr array
+    :type  image: Image
+
+    :param chunk_size: Input chunk size, in pixels, with the first axis fastest, as Image.size
+    :type  chunk_size: List[int]
+
+    :param halo: Input pixels read around each chunk along each axis. Default: 0
+    :type  halo: List[int]
+
+    :param shrink_factors: Ratio of the input and output pixel grids along each axis. Default: 1
+    :type  shrink_factors: List[int]
+
+    :param max_workers: Number of chunks run concurrently for numpy data. Default: the ThreadPoolExecutor default
+    :type  max_workers: int
+
+    :return: The stitched output image, with the origin, spacing, and direction of the result for the first chunk
+    :rtype:  Image
+    """
+    dimension = image.imageType.dimension
+    halo = [0] * dimension if halo is None else list(halo)
+    shrink_factors = [1] * dimension if shrink_factors is None else [max(1, int(f)) for f in shrink_factors]
+    grid = _ChunkGrid(image, chunk_size, halo, shrink_factors)
+
+    data = image.data
+    shape = tuple(reversed(image.size))
+    if _has_component_axis(image.imageType):
+        shape = shape + (image.imageType.components,)
+    if not hasattr(data, "shape") or tuple(data.shape) != shape:
+        data = np.asarray(data).reshape(shape)
+
+    chunks = grid.chunks()
+    if len(chunks) == 0:
+        raise ValueError("The output image is empty")
+
+    def input_window(position):
+        begin, end = grid.input_region(position)
+        return data[_chunk_slices(begin, end)]
+
+    # The first chunk gives the output image type and grid
+    first_result, first_data = _run_chunk(function, image, grid, chunks[0], input_window(chunks[0]), kwargs)
+    output_shape = tuple(reversed(grid.output_size)) + first_data.shape[dimension:]
+
+    if _is_dask_array(data):
+        import dask
+        import dask.array as da
+
+        def chunk_array(position):
+            if position == chunks[0]:
+                return da.from_array(first_data, chunks=first_data.shape)
+            begin, end = grid.output_region(position)
+            chunk_shape = tuple(e - b for b, e in zip(reversed(begin), reversed(end))) + first_data.shape[dimension:]
+            task = dask.delayed(lambda window: _run_chunk(function, image, grid, position, window, kwargs)[1])(input_window(position))
+            return da.from_delayed(task, shape=chunk_shape, dtype=first_data.dtype)
+
+        # Nested lists of chunks for da.block, the last axis outermost
+        def nested(prefix: Tuple[int, ...], axis: int):
+            if axis < 0:
+                # The components are not divided
+                return [chunk_array(prefix)] if first_data.ndim > dimension else chunk_array(prefix)
+            return [nested((index,) + prefix, axis - 1) for index in range(grid.counts[axis])]
+
+        blocks = nested((), dimension - 1)
+        output_data = da.block(blocks)
+    else:
+        output_data = np.empty(output_shape, dtype=first_data.dtype)
+
+        def store(position, chunk_data):
+            begin, end = grid.output_region(position)
+            output_data[_chunk_slices(begin, end)] = chunk_data
+
+        def run(position):
+            # The input window is read by the worker, so only the windows of
+            # the running chunks are in memory
+            store(position, _run_chunk(function, image, grid, position, input_window(position), kwargs)[1])
+
+        store(chunks[0], first_data)
+        with ThreadPoolExecutor(max_workers=max_workers) as executor:
+            for future in [executor.submit(run, position) for position in chunks[1:]]:
+                future.result()
+
+    return Image(
+        imageType=replace(first_result.imageType),
+        name=first_result.name,
+        origin=list(first_result.origin),
+        spacing=list(first_result.spacing),
+        direction=np.asarray(first_result.direction, dtype=np.float64).copy(),
+        size=list(grid.output_size),
+        metadata=dict(first_result.metadata),
+        data=output_data,
+    )
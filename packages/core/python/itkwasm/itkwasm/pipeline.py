@@ -1,10 +1,14 @@
 import json
 from pathlib import Path, PurePosixPath
 from dataclasses import asdict
-from typing import List, Union, Dict, Tuple, Set
+from typing import Callable, List, Union, Dict, Tuple, Set, Optional
+from concurrent.futures import Executor
+import asyncio
 import ctypes
+import functools
 import sys
 import os
+import threading
 
 import numpy as np
 
@@ -23,19 +27,21 @@ from .binary_file import BinaryFile
 from .image import Image
 from .mesh import Mesh
 from .polydata import PolyData
+from .pointset import PointSet
+from .transform import Transform
 from .json_compatible import JsonCompatible
 from .int_types import IntTypes
 from .float_types import FloatTypes
 from .to_numpy_array import (
     buffer_to_numpy_array,
     array_like_to_numpy_array,
-    array_like_to_bytes,
 )
 
 if sys.platform != "emscripten":
     import zlib
     from platformdirs import user_cache_dir
 
+    import wasmtime
     from wasmtime import (
         Config,
         Store,
@@ -44,6 +50,8 @@ if sys.platform != "emscripten":
         WasiConfig,
         Linker,
         WasmtimeError,
+        FuncType,
+        ValType,
     )
 
     # Get the value of the ITKWASM_CACHE_DIR environment variable
@@ -52,12 +60,186 @@ if sys.platform != "emscripten":
     _module_store_dir = Path(_module_store_dir)
     _module_store_dir.mkdir(parents=True, exist_ok=True)
 
+    # One Engine, and one compiled Module per wasm binary, are shared by the
+    # Pipelines of a process. Each run has its own Store.
+    _engine = None
+    _modules: Dict[int, "Module"] = {}
+    _engine_lock = threading.Lock()
 
-def array_like_to_bytes(arr: ArrayLike) -> bytes:
-    """Convert a numpy array-like to bytes."""
-    if hasattr(arr, "tobytes"):
-        return arr.tobytes()
-    return array_like_to_numpy_array(arr).tobytes()
+
+def _threads_supported() -> bool:
+    """Whether wasmtime provides the shared memories that wasi-threads builds import."""
+    return hasattr(wasmtime, "SharedMemory") and hasattr(Config, "wasm_threads")
+
+
+def _preferred_variant(pipeline: Path) -> Path:
+    """The .threads.wasi.wasm build deployed next to a .wasi.wasm pipeline, when wasmtime supports it, otherwise the pipeline."""
+    name = pipeline.name
+    if not name.endswith(".wasi.wasm") or name.endswith(".threads.wasi.wasm") or not _threads_supported():
+        return pipeline
+    variant = pipeline.with_name(f"{name[:-len('.wasi.wasm')]}.threads.wasi.wasm")
+    return variant if variant.exists() else pipeline
+
+
+# Runs with more input bytes than this use a deployed .memory64.wasi.wasm
+# build, since wasm32 memory, which holds the inputs and outputs, is at most
+# 4 GB
+_memory64_input_bytes = 2**31
+
+
+def _memory64_variant(pipeline: Path) -> Optional[Path]:
+    """The .memory64.wasi.wasm build deployed next to a .wasi.wasm pipeline, if any."""
+    name = pipeline.name
+    if not name.endswith(".wasi.wasm") or name.endswith(".memory64.wasi.wasm"):
+        return None
+    variant = pipeline.with_name(f"{name[:-len('.wasi.wasm')]}.memory64.wasi.wasm")
+    return variant if variant.exists() else None
+
+
+def _input_bytes(inputs: List[PipelineInput]) -> int:
+    """Bytes of the input arrays, which are copied into linear memory."""
+
+    def nbytes(array) -> int:
+        if array is None:
+            return 0
+        if isinstance(array, (bytes, bytearray, memoryview, str)):
+            return len(array)
+        return int(getattr(array, "nbytes", 0))
+
+    total = 0
+    for input_ in inputs:
+        data = input_.data
+        if input_.type in (InterfaceTypes.TextStream, InterfaceTypes.BinaryStream):
+            total += nbytes(data.data)
+        elif input_.type == InterfaceTypes.Image:
+            total += nbytes(data.data) + nbytes(data.direction)
+        elif input_.type == InterfaceTypes.Transform:
+            total += sum(nbytes(getattr(data, field)) for field in ("fixedParameters", "parameters"))
+        elif input_.type == InterfaceTypes.PointSet:
+            total += sum(nbytes(getattr(data, field)) for field in ("points", "pointData"))
+        elif input_.type == InterfaceTypes.Mesh:
+            total += sum(nbytes(getattr(data, field)) for field in ("points", "cells", "pointData", "cellData"))
+        elif input_.type == InterfaceTypes.PolyData:
+            fields = ("points", "vertices", "lines", "polygons", "triangleStrips", "pointData", "cellData")
+            total += sum(nbytes(getattr(data, field)) for field in fields)
+    return total
+
+
+def _preopen_directories(outputs: List[PipelineOutput], inputs: List[Optional[PipelineInput]]) -> List[str]:
+    """Directories of the file inputs and outputs, which are preopened in the WASI instance."""
+    preopen_directories = set()
+    for input_ in inputs:
+        if input_ is not None and (input_.type == InterfaceTypes.TextFile or input_.type == InterfaceTypes.BinaryFile):
+            preopen_directories.add(str(PurePosixPath(input_.data.path).parent))
+    for output in outputs:
+        if output.type == InterfaceTypes.TextFile or output.type == InterfaceTypes.BinaryFile:
+            preopen_directories.add(str(PurePosixPath(output.data.path).parent))
+    return list(preopen_directories)
+
+
+def _shared_engine() -> "Engine":
+    global _engine
+    with _engine_lock:
+        if _engine is None:
+            config = Config()
+            config.wasm_bulk_memory = True
+            config.wasm_simd = True
+            config.wasm_memory64 = True
+            if _threads_supported():
+                config.wasm_threads = True
+            _engine = Engine(config)
+        return _engine
+
+
+def _compile_module(engine: "Engine", wasm_bytes: bytes) -> "Module":
+    """Compile the module once per process, using the on-disk module cache."""
+    checksum = zlib.adler32(wasm_bytes)
+    with _engine_lock:
+        module = _modules.get(checksum)
+    if module is not None:
+        return module
+
+    module_cache = _module_store_dir / Path(f"module-{checksum}")
+    module = None
+    if module_cache.exists():
+        try:
+            module = Module.deserialize_file(engine, str(module_cache))
+        except WasmtimeError:
+            module = None
+    if module is None:
+        module = Module(engine, wasm_bytes)
+        # Replace atomically, since other processes may read the cache
+        temporary_cache = module_cache.with_name(f"{module_cache.name}.{os.getpid()}.{threading.get_ident()}")
+        with temporary_cache.open("wb") as fp:
+            fp.write(module.serialize())
+        os.replace(temporary_cache, module_cache)
+
+    with _engine_lock:
+        return _modules.setdefault(checksum, module)
+
+
+def array_like_to_buffer(arr: ArrayLike) -> np.ndarray:
+    """View a numpy array-like, or buffer protocol object, as contiguous bytes, without a copy when it is a C-contiguous host array."""
+    if isinstance(arr, (bytes, bytearray, memoryview)):
+        return np.frombuffer(arr, dtype=np.uint8)
+    return np.ascontiguousarray(array_like_to_numpy_array(arr)).reshape(-1).view(np.uint8)
+
+
+class _OutputMemory:
+    """Keeps the instance of a run, and its memory io store, while numpy views over its linear memory are referenced."""
+
+    def __init__(self, release):
+        self._release = release
+
+    def __del__(self):
+        self._release()
+
+
+class _WasiThreads:
+    """Host of the wasi-threads builds of a module: their imported shared memory and wasi.thread-spawn.
+
+    Each spawned thread runs wasi_thread_start in a new instance of the module, with its own Store, on the shared memory.
+    """
+
+    def __init__(self, engine: "Engine", module: "Module"):
+        self._engine = engine
+        self._module = module
+        memory_type = next(imp.type for imp in module.imports if imp.module == "env" and imp.name == "memory")
+        self.memory = wasmtime.SharedMemory(engine, memory_type)
+        self._next_thread_id = 0
+        self._lock = threading.Lock()
+
+    @staticmethod
+    def imports_memory(module: "Module") -> bool:
+        return any(imp.module == "env" and imp.name == "memory" for imp in module.imports)
+
+    def linker(self, store: "Store") -> "Linker":
+        linker = Linker(self._engine)
+        linker.define_wasi()
+        linker.allow_shadowing = True
+        linker.define(store, "env", "memory", self.memory)
+        linker.define_func("wasi", "thread-spawn", FuncType([ValType.i32()], [ValType.i32()]), self._spawn)
+        return linker
+
+    def _spawn(self, start_arg: int) -> int:
+        with self._lock:
+            self._next_thread_id += 1
+            thread_id = self._next_thread_id
+        try:
+            threading.Thread(target=self._run, args=(thread_id, start_arg), daemon=True).start()
+        except RuntimeError:
+            return -1
+        return thread_id
+
+    def _run(self, thread_id: int, start_arg: int):
+        store = Store(self._engine)
+        wasi_config = WasiConfig()
+        wasi_config.inherit_env()
+        wasi_config.inherit_stderr()
+        wasi_config.inherit_stdout()
+        store.set_wasi(wasi_config)
+        instance = self.linker(store).instantiate(store, self._module)
+        instance.exports(store)["wasi_thread_start"](store, thread_id, start_arg)
 
 
 class RunInstance:
@@ -73,6 +255,7 @@ class RunInstance:
     ):
         self._store = Store(engine)
         store = self._store
+        self._preopen_directories = set(preopen_directories)
 
         wasi_config = WasiConfig()
         wasi_config.inherit_env()
@@ -86,10 +269,21 @@ class RunInstance:
 
         store.set_wasi(wasi_config)
 
+        # Threads builds import a shared memory, which is not owned by the store
+        self._threads = None
+        if _WasiThreads.imports_memory(module):
+            self._threads = _WasiThreads(engine, module)
+            linker = self._threads.linker(store)
+
         instance = linker.instantiate(store, module)
         self._instance = instance
 
         self._memory = instance.exports(store)["memory"]
+        # Addresses and sizes are size_t, unsigned i32 or i64 values
+        self._address_mask = 0xFFFFFFFF
+        if self._threads is None and self._memory.type(store).is_64:
+            self._address_mask = 0xFFFFFFFFFFFFFFFF
+        self.module = module
         self._input_array_alloc = instance.exports(store)["itk_wasm_input_array_alloc"]
         self._input_json_alloc = instance.exports(store)["itk_wasm_input_json_alloc"]
         self._output_array_address = instance.exports(store)["itk_wasm_output_array_address"]
@@ -97,31 +291,73 @@ class RunInstance:
         self._output_json_address = instance.exports(store)["itk_wasm_output_json_address"]
         self._output_json_size = instance.exports(store)["itk_wasm_output_json_size"]
 
-        _initialize = instance.exports(store)["_initialize"]
-        _initialize(store)
+        exports = instance.exports(store)
+        self._free_all = exports.get("itk_wasm_free_all")
+        self._reactor_args_alloc = exports.get("itk_wasm_reactor_args_alloc")
+        self._reactor_run = exports.get("itk_wasm_reactor_run")
+        self._use_strided_views = exports.get("itk_wasm_use_strided_views")
+        self._input_retain = exports.get("itk_wasm_input_retain")
+        self._release_handle = exports.get("itk_wasm_release_handle")
+        self._output_exists = exports.get("itk_wasm_output_exists")
+        self._release_all_handles = exports.get("itk_wasm_release_all_handles")
+
+        # Snapshot builds were initialized at build time
+        snapshotted = exports.get("itk_wasm_snapshotted")
+        if snapshotted is None or not snapshotted(store):
+            _initialize = instance.exports(store)["_initialize"]
+            _initialize(store)
+
+    def _memory_data(self):
+        """Base pointer and size in bytes of linear memory."""
+        if self._threads is not None:
+            memory = self._threads.memory
+            return memory.data_ptr(), memory.data_len()
+        return self._memory.data_ptr(self._store), self._memory.data_len(self._store)
 
     def wasmtime_lift(self, ptr: int, size: int):
-        ptr = ptr & 0xFFFFFFFF
-        size = size & 0xFFFFFFFF
-        if ptr + size > self._memory.data_len(self._store):
+        ptr = ptr & self._address_mask
+        size = size & self._address_mask
+        raw_base, data_len = self._memory_data()
+        if ptr + size > data_len:
             raise IndexError("attempting to lift of bounds")
-        raw_base = self._memory.data_ptr(self._store)
         base = ctypes.POINTER(ctypes.c_ubyte)(ctypes.c_ubyte.from_address(ctypes.addressof(raw_base.contents) + ptr))
         return ctypes.string_at(base, size)
 
-    def wasmtime_lower(self, ptr: int, data: Union[bytes, bytearray]):
-        ptr = ptr & 0xFFFFFFFF
-        size = len(data)
-        if ptr + size > self._memory.data_len(self._store):
+    def wasmtime_view(self, ptr: int, size: int, owner: _OutputMemory) -> memoryview:
+        """Read-only view of linear memory that keeps the owner referenced."""
+        ptr = ptr & self._address_mask
+        size = size & self._address_mask
+        raw_base, data_len = self._memory_data()
+        if ptr + size > data_len:
+            raise IndexError("attempting to view out of bounds")
+        view = (ctypes.c_ubyte * size).from_address(ctypes.addressof(raw_base.contents) + ptr)
+        view._owner = owner
+        return memoryview(view).cast("B").toreadonly()
+
+    def wasmtime_lower(self, ptr: int, data: Union[bytes, bytearray, np.ndarray]):
+        """Copy bytes, or a contiguous uint8 array, e.g. from array_like_to_buffer, into linear memory."""
+        ptr = ptr & self._address_mask
+        if not isinstance(data, np.ndarray):
+            data = np.frombuffer(data, dtype=np.uint8)
+        size = data.nbytes
+        raw_base, data_len = self._memory_data()
+        if ptr + size > data_len:
             raise IndexError("attempting to lower out of bounds")
-        raw_base = self._memory.data_ptr(self._store)
-        base = ctypes.POINTER(ctypes.c_ubyte)(ctypes.c_ubyte.from_address(ctypes.addressof(raw_base.contents) + ptr))
-        ctypes.memmove(base, data, size)
+        if size == 0:
+            return
+        ctypes.memmove(ctypes.addressof(raw_base.contents) + ptr, data.ctypes.data, size)
 
-    def set_input_array(self, data_array: Union[bytes, bytearray], input_index: int, sub_index: int) -> int:
+    def use_strided_views(self) -> None:
+        """Receive image output sub-regions as strided views of their source buffer instead of contiguous copies."""
+        if self._use_strided_views is not None:
+            self._use_strided_views(self._store, 0, 1)
+
+    def set_input_array(self, data_array: Union[bytes, bytearray, np.ndarray], input_index: int, sub_index: int) -> int:
         data_ptr = 0
-        if data_array != None:
-            data_ptr = self._input_array_alloc(self._store, 0, input_index, sub_index, len(data_array))
+        if data_array is not None:
+            if not isinstance(data_array, np.ndarray):
+                data_array = np.frombuffer(data_array, dtype=np.uint8)
+            data_ptr = self._input_array_alloc(self._store, 0, input_index, sub_index, data_array.nbytes)
             self.wasmtime_lower(data_ptr, data_array)
         return data_ptr
 
@@ -137,6 +373,13 @@ class RunInstance:
         json_result = json.loads(json_str)
         return json_result
 
+    def has_output(self, output_index: int) -> bool:
+        """Whether the pipeline set the data object output, which optional outputs may not."""
+        if self._output_exists is None:
+            # Modules built before itk_wasm_output_exists
+            return self._output_json_size(self._store, 0, output_index) > 0
+        return self._output_exists(self._store, 0, output_index) != 0
+
     def get_output_array_address(self, memory: int, output_index: int, output_sub_index: int) -> Dict:
         return self._output_array_address(self._store, memory, output_index, output_sub_index)
 
@@ -152,60 +395,180 @@ class RunInstance:
         func = self._instance.exports(self._store)["itk_wasm_delayed_exit"]
         func(self._store, return_code)
 
+    @property
+    def supports_reactor(self) -> bool:
+        """Whether the module can run main repeatedly in this instance."""
+        return self._reactor_run is not None and self._reactor_args_alloc is not None and self._free_all is not None
+
+    @property
+    def supports_handles(self) -> bool:
+        """Whether inputs can be kept resident in the instance and passed to later runs by handle."""
+        return self._input_retain is not None and self._release_handle is not None and self._release_all_handles is not None
+
+    def input_retain(self, input_index: int, handle: int) -> None:
+        """Keep the input of the next run resident in the instance as handle:<handle>."""
+        self._input_retain(self._store, 0, input_index, handle)
+
+    def release_handle(self, handle: int) -> None:
+        """Release a resident data object."""
+        self._release_handle(self._store, handle)
+
+    def release_all_handles(self) -> None:
+        """Release all the resident data objects."""
+        self._release_all_handles(self._store)
+
+    def can_reuse(self, module: "Module", preopen_directories: Set[str]) -> bool:
+        """Whether this instance can run an invocation of the module that requires the given preopened directories."""
+        return (
+            self.module is module
+            and self.supports_reactor
+            and set(preopen_directories).issubset(self._preopen_directories)
+        )
+
+    def reactor_run(self, args: List[str]) -> int:
+        """Run the pipeline's main in this instance with new arguments."""
+        args_data = b"".join(arg.encode() + b"\0" for arg in args)
+        args_ptr = self._reactor_args_alloc(self._store, len(args_data))
+        self.wasmtime_lower(args_ptr, args_data)
+        return self._reactor_run(self._store, len(args))
+
+    def free_all(self):
+        """Release all memory io inputs and outputs."""
+        self._free_all(self._store)
+
 
 class Pipeline:
     """Run an itk-wasm WASI pipeline."""
 
-    def __init__(self, pipeline: Union[str, Path, bytes]):
-        """Compile the pipeline."""
-        self.config = Config()
-        self.config.wasm_bulk_memory = True
-        self.config.wasm_simd = True
-        self.config.wasm_memory64 = True
-        self.engine = Engine(self.config)
-        if isinstance(pipeline, bytes):
-            wasm_bytes = pipeline
-        else:
-            with open(pipeline, "rb") as fp:
-                wasm_bytes = fp.read()
+    def __init__(self, pipeline: Union[str, Path, bytes], max_idle_instances: int = 4):
+        """Compile the pipeline.
+
+        A .threads.wasi.wasm build deployed next to a .wasi.wasm pipeline
+        is run instead when wasmtime supports WebAssembly threads. A
+        .memory64.wasi.wasm build deployed next to it runs inputs that do
+        not fit in wasm32 memory; it is compiled on first use.
+
+        Modules with the reactor exports keep up to max_idle_instances
+        initialized instances between runs, so repeated and concurrent runs
+        do not pay for instantiation, initialization, and memory growth.
+
+        run may be called concurrently from multiple threads. Each concurrent
+        run uses its own instance and Store, and wasmtime releases the GIL
+        while wasm executes, so runs scale across cores. run_async runs in
+        an executor for asyncio callers.
+        """
+        self.engine = _shared_engine()
         self.linker = Linker(self.engine)
         self.linker.define_wasi()
         self.linker.allow_shadowing = True
-        checksum = zlib.adler32(wasm_bytes)
-        module_cache = _module_store_dir / Path(f"module-{checksum}")
-        if module_cache.exists():
-            try:
-                self.module = Module.deserialize_file(self.engine, str(module_cache))
-            except WasmtimeError:
-                self.module = Module(self.engine, wasm_bytes)
-                with module_cache.open("wb") as fp:
-                    fp.write(self.module.serialize())
+        if isinstance(pipeline, bytes):
+            self.module = _compile_module(self.engine, pipeline)
         else:
-            self.module = Module(self.engine, wasm_bytes)
-            with module_cache.open("wb") as fp:
-                fp.write(self.module.serialize())
+            self.module = None
+            variant = _preferred_variant(Path(pipeline))
+            if variant != Path(pipeline):
+                try:
+                    with open(variant, "rb") as fp:
+                        self.module = _compile_module(self.engine, fp.read())
+                except WasmtimeError:
+                    self.module = None
+            if self.module is None:
+                with open(pipeline, "rb") as fp:
+                    self.module = _compile_module(self.engine, fp.read())
+        self._memory64_pipeline = None if isinstance(pipeline, bytes) else _memory64_variant(Path(pipeline))
+        self._memory64_module = None
+        self._memory64_lock = threading.Lock()
+        self._max_idle_instances = max_idle_instances
+        self._idle_instances: List[RunInstance] = []
+        self._idle_instances_lock = threading.Lock()
+
+    def _module_for(self, inputs: List[PipelineInput]) -> "Module":
+        """The memory64 module for inputs that do not fit in wasm32 memory, when deployed, otherwise the module."""
+        if self._memory64_pipeline is None or _input_bytes(inputs) <= _memory64_input_bytes:
+            return self.module
+        with self._memory64_lock:
+            if self._memory64_module is None:
+                with open(self._memory64_pipeline, "rb") as fp:
+                    self._memory64_module = _compile_module(self.engine, fp.read())
+            return self._memory64_module
+
+    def _acquire_instance(self, module: "Module", args: List[str], preopen_directories: List[str]) -> RunInstance:
+        """Take a warm instance of the module in reactor mode, if one can be reused, or create a new instance.
+
+        An instance runs one invocation at a time, so it is removed from the pool until released.
+        """
+        with self._idle_instances_lock:
+            for index in range(len(self._idle_instances) - 1, -1, -1):
+                if self._idle_instances[index].can_reuse(module, preopen_directories):
+                    return self._idle_instances.pop(index)
+        return RunInstance(self.engine, self.linker, module, args, preopen_directories)
+
+    def _release_instance(self, ri: RunInstance):
+        """Return an instance whose memory io store was freed to the pool, evicting the least recently used."""
+        with self._idle_instances_lock:
+            self._idle_instances.append(ri)
+            if len(self._idle_instances) > self._max_idle_instances:
+                self._idle_instances.pop(0)
+
+    def clear_instances(self):
+        """Release the idle warm instances."""
+        with self._idle_instances_lock:
+            self._idle_instances.clear()
 
     def run(
         self,
         args: List[str],
         outputs: List[PipelineOutput] = [],
         inputs: List[PipelineInput] = [],
+        copy_outputs: bool = True,
     ) -> Tuple[PipelineOutput]:
-        """Run the itk-wasm pipeline."""
+        """Run the itk-wasm pipeline.
 
-        preopen_directories = set()
-        for index, input_ in enumerate(inputs):
-            if input_.type == InterfaceTypes.TextFile or input_.type == InterfaceTypes.BinaryFile:
-                preopen_directories.add(str(PurePosixPath(input_.data.path).parent))
-        for index, output in enumerate(outputs):
-            if output.type == InterfaceTypes.TextFile or output.type == InterfaceTypes.BinaryFile:
-                preopen_directories.add(str(PurePosixPath(output.data.path).parent))
-        preopen_directories = list(preopen_directories)
+        Input arrays are copied once, directly into the instance's linear memory.
+
+        With copy_outputs=False, output image, mesh, and polydata arrays are
+        read-only numpy views over the instance's linear memory instead of
+        copies. The instance is not reused until the views are released;
+        call .copy() on arrays that should outlive them.
+        """
+
+        preopen_directories = _preopen_directories(outputs, inputs)
+        ri = self._acquire_instance(self._module_for(inputs), args, preopen_directories)
+
+        def release(return_code: int):
+            if ri.supports_reactor:
+                ri.free_all()
+                # Do not reuse an instance that may be in an inconsistent state
+                if return_code == 0:
+                    self._release_instance(ri)
+            else:
+                ri.delayed_exit(return_code)
 
-        ri = RunInstance(self.engine, self.linker, self.module, args, preopen_directories)
+        return self._run_in(ri, args, outputs, inputs, copy_outputs, release)
+
+    def _run_in(
+        self,
+        ri: RunInstance,
+        args: List[str],
+        outputs: List[PipelineOutput],
+        inputs: List[Optional[PipelineInput]],
+        copy_outputs: bool,
+        release: Callable[[int], None],
+        retained: Optional[Dict[int, int]] = None,
+    ) -> Tuple[PipelineOutput]:
+        """Run the pipeline in the instance, then call release with the return code once the outputs are read.
+
+        None inputs are not imported, e.g. inputs passed by handle. The
+        retained inputs, input index to handle, are kept resident in the
+        instance after the run.
+        """
+        # The memory store is reset by itk_wasm_free_all after each run
+        ri.use_strided_views()
 
         for index, input_ in enumerate(inputs):
-            if input_.type == InterfaceTypes.TextStream:
+            if input_ is None:
+                continue
+            elif input_.type == InterfaceTypes.TextStream:
                 data_array = input_.data.data.encode()
                 array_ptr = ri.set_input_array(data_array, index, 0)
                 data_json = {
@@ -227,9 +590,9 @@ class Pipeline:
                 pass
             elif input_.type == InterfaceTypes.Image:
                 image = input_.data
-                mv = array_like_to_bytes(image.data)
+                mv = array_like_to_buffer(image.data)
                 data_ptr = ri.set_input_array(mv, index, 0)
-                dv = array_like_to_bytes(image.direction)
+                dv = array_like_to_buffer(image.direction)
                 direction_ptr = ri.set_input_array(dv, index, 1)
                 image_json = {
                     "imageType": asdict(image.imageType),
@@ -241,25 +604,67 @@ class Pipeline:
                     "data": f"data:application/vnd.itk.address,0:{data_ptr}",
                 }
                 ri.set_input_json(image_json, index)
+            elif input_.type == InterfaceTypes.PointSet:
+                pointset = input_.data
+                if pointset.numberOfPoints:
+                    pv = array_like_to_buffer(pointset.points)
+                else:
+                    pv = bytes([])
+                points_ptr = ri.set_input_array(pv, index, 0)
+                if pointset.numberOfPointPixels:
+                    pdv = array_like_to_buffer(pointset.pointData)
+                else:
+                    pdv = bytes([])
+                point_data_ptr = ri.set_input_array(pdv, index, 1)
+                pointset_json = {
+                    "pointSetType": asdict(pointset.pointSetType),
+                    "name": pointset.name,
+                    "numberOfPoints": pointset.numberOfPoints,
+                    "points": f"data:application/vnd.itk.address,0:{points_ptr}",
+                    "numberOfPointPixels": pointset.numberOfPointPixels,
+                    "pointData": f"data:application/vnd.itk.address,0:{point_data_ptr}",
+                }
+                ri.set_input_json(pointset_json, index)
+            elif input_.type == InterfaceTypes.Transform:
+                transform = input_.data
+                if transform.numberOfFixedParameters:
+                    fpv = array_like_to_buffer(transform.fixedParameters)
+                else:
+                    fpv = bytes([])
+                fixed_parameters_ptr = ri.set_input_array(fpv, index, 0)
+                if transform.numberOfParameters:
+                    pv = array_like_to_buffer(transform.parameters)
+                else:
+                    pv = bytes([])
+                parameters_ptr = ri.set_input_array(pv, index, 1)
+                transform_json = {
+                    "transformType": asdict(transform.transformType),
+                    "name": transform.name,
+                    "numberOfFixedParameters": transform.numberOfFixedParameters,
+                    "fixedParameters": f"data:application/vnd.itk.address,0:{fixed_parameters_ptr}",
+                    "numberOfParameters": transform.numberOfParameters,
+                    "parameters": f"data:application/vnd.itk.address,0:{parameters_ptr}",
+                }
+                ri.set_input_json(transform_json, index)
             elif input_.type == InterfaceTypes.Mesh:
                 mesh = input_.data
                 if mesh.numberOfPoints:
-                    pv = array_like_to_bytes(mesh.points)
+                    pv = array_like_to_buffer(mesh.points)
                 else:
                     pv = bytes([])
                 points_ptr = ri.set_input_array(pv, index, 0)
                 if mesh.numberOfCells:
-                    cv = array_like_to_bytes(mesh.cells)
+                    cv = array_like_to_buffer(mesh.cells)
                 else:
                     cv = bytes([])
                 cells_ptr = ri.set_input_array(cv, index, 1)
                 if mesh.numberOfPointPixels:
-                    pdv = array_like_to_bytes(mesh.pointData)
+                    pdv = array_like_to_buffer(mesh.pointData)
                 else:
                     pdv = bytes([])
                 point_data_ptr = ri.set_input_array(pdv, index, 2)
                 if mesh.numberOfCellPixels:
-                    cdv = array_like_to_bytes(mesh.cellData)
+                    cdv = array_like_to_buffer(mesh.cellData)
                 else:
                     cdv = bytes([])
                 cell_data_ptr = ri.set_input_array(cdv, index, 3)
@@ -280,43 +685,43 @@ class Pipeline:
             elif input_.type == InterfaceTypes.PolyData:
                 polydata = input_.data
                 if polydata.numberOfPoints:
-                    pv = array_like_to_bytes(polydata.points)
+                    pv = array_like_to_buffer(polydata.points)
                 else:
                     pv = bytes([])
                 points_ptr = ri.set_input_array(pv, index, 0)
 
                 if polydata.verticesBufferSize:
-                    pv = array_like_to_bytes(polydata.vertices)
+                    pv = array_like_to_buffer(polydata.vertices)
                 else:
                     pv = bytes([])
                 vertices_ptr = ri.set_input_array(pv, index, 1)
 
                 if polydata.linesBufferSize:
-                    pv = array_like_to_bytes(polydata.lines)
+                    pv = array_like_to_buffer(polydata.lines)
                 else:
                     pv = bytes([])
                 lines_ptr = ri.set_input_array(pv, index, 2)
 
                 if polydata.polygonsBufferSize:
-                    pv = array_like_to_bytes(polydata.polygons)
+                    pv = array_like_to_buffer(polydata.polygons)
                 else:
                     pv = bytes([])
                 polygons_ptr = ri.set_input_array(pv, index, 3)
 
                 if polydata.triangleStripsBufferSize:
-                    pv = array_like_to_bytes(polydata.triangleStrips)
+                    pv = array_like_to_buffer(polydata.triangleStrips)
                 else:
                     pv = bytes([])
                 triangleStrips_ptr = ri.set_input_array(pv, index, 4)
 
                 if polydata.numberOfPointPixels:
-                    pv = array_like_to_bytes(polydata.pointData)
+                    pv = array_like_to_buffer(polydata.pointData)
                 else:
                     pv = bytes([])
                 pointData_ptr = ri.set_input_array(pv, index, 5)
 
                 if polydata.numberOfCellPixels:
-                    pv = array_like_to_bytes(polydata.cellData)
+                    pv = array_like_to_buffer(polydata.cellData)
                 else:
                     pv = bytes([])
                 cellData_ptr = ri.set_input_array(pv, index, 6)
@@ -351,13 +756,31 @@ class Pipeline:
             else:
                 raise ValueError(f"Unexpected/not yet supported input.type {input_.type}")
 
-        return_code = ri.delayed_start()
+        for index, handle in (retained or {}).items():
+            ri.input_retain(index, handle)
+
+        if ri.supports_reactor:
+            # An instance that raised is not returned to the pool
+            return_code = ri.reactor_run(args)
+        else:
+            return_code = ri.delayed_start()
+
+        if copy_outputs:
+            lift_array = ri.wasmtime_lift
+        else:
+            output_memory = _OutputMemory(lambda: release(return_code))
+
+            def lift_array(ptr: int, size: int) -> memoryview:
+                return ri.wasmtime_view(ptr, size, output_memory)
 
         populated_outputs: List[PipelineOutput] = []
         if len(outputs) and return_code == 0:
             for index, output in enumerate(outputs):
                 output_data = None
-                if output.type == InterfaceTypes.TextStream:
+                if output.type in (InterfaceTypes.Image, InterfaceTypes.PointSet, InterfaceTypes.Transform, InterfaceTypes.Mesh, InterfaceTypes.PolyData) and not ri.has_output(index):
+                    # An optional output that the pipeline did not set
+                    output_data = PipelineOutput(output.type)
+                elif output.type == InterfaceTypes.TextStream:
                     data_ptr = ri.get_output_array_address(0, index, 0)
                     data_size = ri.get_output_array_size(0, index, 0)
                     data_array = ri.wasmtime_lift(data_ptr, data_size)
@@ -373,6 +796,7 @@ class Pipeline:
                     output_data = PipelineOutput(InterfaceTypes.BinaryFile, BinaryFile(output.data.path))
                 elif output.type == InterfaceTypes.Image:
                     image_json = ri.get_output_json(index)
+                    strides = image_json.pop("strides", None)
 
                     image = Image(**image_json)
 
@@ -380,24 +804,87 @@ class Pipeline:
                     data_size = ri.get_output_array_size(0, index, 0)
                     data_array = buffer_to_numpy_array(
                         image.imageType.componentType,
-                        ri.wasmtime_lift(data_ptr, data_size),
+                        lift_array(data_ptr, data_size),
                     )
                     shape = list(image.size)[::-1]
                     if image.imageType.components > 1:
                         shape.append(image.imageType.components)
-                    image.data = data_array.reshape(tuple(shape))
+                    if data_array.size == 0 and np.prod(shape) != 0:
+                        # No pixel data, e.g. an information-only read
+                        image.data = data_array
+                    elif strides is None:
+                        image.data = data_array.reshape(tuple(shape))
+                    else:
+                        # A sub-region of a larger buffer, with strides in components, first axis fastest
+                        itemsize = data_array.itemsize
+                        byte_strides = [stride * itemsize for stride in reversed(strides)]
+                        if image.imageType.components > 1:
+                            byte_strides.append(itemsize)
+                        view = np.lib.stride_tricks.as_strided(data_array, shape=tuple(shape), strides=tuple(byte_strides), writeable=False)
+                        image.data = np.ascontiguousarray(view) if copy_outputs else view
 
                     direction_ptr = ri.get_output_array_address(0, index, 1)
                     direction_size = ri.get_output_array_size(0, index, 1)
                     direction_array = buffer_to_numpy_array(
                         FloatTypes.Float64,
-                        ri.wasmtime_lift(direction_ptr, direction_size),
+                        lift_array(direction_ptr, direction_size),
                     )
                     dimension = image.imageType.dimension
                     direction_array.shape = (dimension, dimension)
                     image.direction = direction_array
 
                     output_data = PipelineOutput(InterfaceTypes.Image, image)
+                elif output.type == InterfaceTypes.PointSet:
+                    pointset_json = ri.get_output_json(index)
+                    pointset = PointSet(**pointset_json)
+
+                    if pointset.numberOfPoints > 0:
+                        data_ptr = ri.get_output_array_address(0, index, 0)
+                        data_size = ri.get_output_array_size(0, index, 0)
+                        pointset.points = buffer_to_numpy_array(
+                            pointset.pointSetType.pointComponentType,
+                            lift_array(data_ptr, data_size),
+                        )
+                    else:
+                        pointset.points = buffer_to_numpy_array(pointset.pointSetType.pointComponentType, bytes([]))
+
+                    if pointset.numberOfPointPixels > 0:
+                        data_ptr = ri.get_output_array_address(0, index, 1)
+                        data_size = ri.get_output_array_size(0, index, 1)
+                        pointset.pointData = buffer_to_numpy_array(
+                            pointset.pointSetType.pointPixelComponentType,
+                            lift_array(data_ptr, data_size),
+                        )
+                    else:
+                        pointset.pointData = buffer_to_numpy_array(pointset.pointSetType.pointPixelComponentType, bytes([]))
+
+                    output_data = PipelineOutput(InterfaceTypes.PointSet, pointset)
+                elif output.type == InterfaceTypes.Transform:
+                    transform_json = ri.get_output_json(index)
+                    transform = Transform(**transform_json)
+
+                    # Fixed parameters are always float64
+                    if transform.numberOfFixedParameters > 0:
+                        data_ptr = ri.get_output_array_address(0, index, 0)
+                        data_size = ri.get_output_array_size(0, index, 0)
+                        transform.fixedParameters = buffer_to_numpy_array(
+                            FloatTypes.Float64,
+                            lift_array(data_ptr, data_size),
+                        )
+                    else:
+                        transform.fixedParameters = buffer_to_numpy_array(FloatTypes.Float64, bytes([]))
+
+                    if transform.numberOfParameters > 0:
+                        data_ptr = ri.get_output_array_address(0, index, 1)
+                        data_size = ri.get_output_array_size(0, index, 1)
+                        transform.parameters = buffer_to_numpy_array(
+                            transform.transformType.parametersValueType,
+                            lift_array(data_ptr, data_size),
+                        )
+                    else:
+                        transform.parameters = buffer_to_numpy_array(transform.transformType.parametersValueType, bytes([]))
+
+                    output_data = PipelineOutput(InterfaceTypes.Transform, transform)
                 elif output.type == InterfaceTypes.Mesh:
                     mesh_json = ri.get_output_json(index)
                     mesh = Mesh(**mesh_json)
@@ -407,7 +894,7 @@ class Pipeline:
                         data_size = ri.get_output_array_size(0, index, 0)
                         mesh.points = buffer_to_numpy_array(
                             mesh.meshType.pointComponentType,
-                            ri.wasmtime_lift(data_ptr, data_size),
+                            lift_array(data_ptr, data_size),
                         )
                     else:
                         mesh.points = buffer_to_numpy_array(mesh.meshType.pointComponentType, bytes([]))
@@ -417,7 +904,7 @@ class Pipeline:
                         data_size = ri.get_output_array_size(0, index, 1)
                         mesh.cells = buffer_to_numpy_array(
                             mesh.meshType.cellComponentType,
-                            ri.wasmtime_lift(data_ptr, data_size),
+                            lift_array(data_ptr, data_size),
                         )
                     else:
                         mesh.cells = buffer_to_numpy_array(mesh.meshType.cellComponentType, bytes([]))
@@ -426,7 +913,7 @@ class Pipeline:
                         data_size = ri.get_output_array_size(0, index, 2)
                         mesh.pointData = buffer_to_numpy_array(
                             mesh.meshType.pointPixelComponentType,
-                            ri.wasmtime_lift(data_ptr, data_size),
+                            lift_array(data_ptr, data_size),
                         )
                     else:
                         mesh.pointData = buffer_to_numpy_array(mesh.meshType.pointPixelComponentType, bytes([]))
@@ -436,7 +923,7 @@ class Pipeline:
                         data_size = ri.get_output_array_size(0, index, 3)
                         mesh.cellData = buffer_to_numpy_array(
                             mesh.meshType.cellPixelComponentType,
-                            ri.wasmtime_lift(data_ptr, data_size),
+                            lift_array(data_ptr, data_size),
                         )
                     else:
                         mesh.cellData = buffer_to_numpy_array(mesh.meshType.cellPixelComponentType, bytes([]))
@@ -450,7 +937,7 @@ class Pipeline:
                         data_ptr = ri.get_output_array_address(0, index, 0)
                         data_size = ri.get_output_array_size(0, index, 0)
                         polydata.points = buffer_to_numpy_array(
-                            FloatTypes.Float32, ri.wasmtime_lift(data_ptr, data_size)
+                            FloatTypes.Float32, lift_array(data_ptr, data_size)
                         )
                     else:
                         polydata.points = buffer_to_numpy_array(FloatTypes.Float32, bytes([]))
@@ -459,7 +946,7 @@ class Pipeline:
                         data_ptr = ri.get_output_array_address(0, index, 1)
                         data_size = ri.get_output_array_size(0, index, 1)
                         polydata.vertices = buffer_to_numpy_array(
-                            IntTypes.UInt32, ri.wasmtime_lift(data_ptr, data_size)
+                            IntTypes.UInt32, lift_array(data_ptr, data_size)
                         )
                     else:
                         polydata.vertices = buffer_to_numpy_array(IntTypes.UInt32, bytes([]))
@@ -467,7 +954,7 @@ class Pipeline:
                     if polydata.linesBufferSize > 0:
                         data_ptr = ri.get_output_array_address(0, index, 2)
                         data_size = ri.get_output_array_size(0, index, 2)
-                        polydata.lines = buffer_to_numpy_array(IntTypes.UInt32, ri.wasmtime_lift(data_ptr, data_size))
+                        polydata.lines = buffer_to_numpy_array(IntTypes.UInt32, lift_array(data_ptr, data_size))
                     else:
                         polydata.lines = buffer_to_numpy_array(IntTypes.UInt32, bytes([]))
 
@@ -475,7 +962,7 @@ class Pipeline:
                         data_ptr = ri.get_output_array_address(0, index, 3)
                         data_size = ri.get_output_array_size(0, index, 3)
                         polydata.polygons = buffer_to_numpy_array(
-                            IntTypes.UInt32, ri.wasmtime_lift(data_ptr, data_size)
+                            IntTypes.UInt32, lift_array(data_ptr, data_size)
                         )
                     else:
                         polydata.polygons = buffer_to_numpy_array(IntTypes.UInt32, bytes([]))
@@ -484,7 +971,7 @@ class Pipeline:
                         data_ptr = ri.get_output_array_address(0, index, 4)
                         data_size = ri.get_output_array_size(0, index, 4)
                         polydata.triangleStrips = buffer_to_numpy_array(
-                            IntTypes.UInt32, ri.wasmtime_lift(data_ptr, data_size)
+                            IntTypes.UInt32, lift_array(data_ptr, data_size)
                         )
                     else:
                         polydata.triangleStrips = buffer_to_numpy_array(IntTypes.UInt32, bytes([]))
@@ -494,7 +981,7 @@ class Pipeline:
                         data_size = ri.get_output_array_size(0, index, 5)
                         polydata.pointData = buffer_to_numpy_array(
                             polydata.polyDataType.pointPixelComponentType,
-                            ri.wasmtime_lift(data_ptr, data_size),
+                            lift_array(data_ptr, data_size),
                         )
                     else:
                         polydata.triangleStrips = buffer_to_numpy_array(
@@ -506,7 +993,7 @@ class Pipeline:
                         data_size = ri.get_output_array_size(0, index, 6)
                         polydata.cellData = buffer_to_numpy_array(
                             polydata.polyDataType.cellPixelComponentType,
-                            ri.wasmtime_lift(data_ptr, data_size),
+                            lift_array(data_ptr, data_size),
                         )
                     else:
                         polydata.triangleStrips = buffer_to_numpy_array(
@@ -524,7 +1011,26 @@ class Pipeline:
 
                 populated_outputs.append(output_data)
 
-        ri.delayed_exit(return_code)
+        if copy_outputs:
+            release(return_code)
+        else:
+            # Released now if no views were made, otherwise with the last view
+            del lift_array
+            del output_memory
 
         # Should we be returning the return_code?
         return tuple(populated_outputs)
+
+    async def run_async(
+        self,
+        args: List[str],
+        outputs: List[PipelineOutput] = [],
+        inputs: List[PipelineInput] = [],
+        copy_outputs: bool = True,
+        executor: Optional[Executor] = None,
+    ) -> Tuple[PipelineOutput]:
+        """Run the itk-wasm pipeline in the executor, the event loop's default thread pool by default."""
+        loop = asyncio.get_running_loop()
+        return await loop.run_in_executor(
+            executor, functools.partial(self.run, args, outputs, inputs, copy_outputs)
+        )
@@ -0,0 +1,183 @@
+from concurrent.futures import Executor
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional, Sequence, Set, Tuple, Union
+import asyncio
+import functools
+import itertools
+import threading
+
+from .interface_types import InterfaceTypes
+from .image import Image
+from .mesh import Mesh
+from .pointset import PointSet
+from .pipeline import Pipeline, RunInstance, _preopen_directories
+from .pipeline_input import PipelineInput
+from .pipeline_output import PipelineOutput
+
+_handle_counter = itertools.count(1)
+_handle_counter_lock = threading.Lock()
+
+
+class ResidentHandle:
+    """An Image, Mesh, or PointSet input that is uploaded to a session once and passed to later runs by reference.
+
+    The first run of a PipelineSession that takes the handle as an input
+    imports the data and keeps it resident in the session's instance. Later
+    runs of that session pass only its handle:<n> identifier, so the data is
+    not copied again. The handle references the data, so an instance that is
+    replaced, e.g. after a failed run, imports it again on its next use.
+    """
+
+    def __init__(self, data: Union[Image, Mesh, PointSet], interface_type: Optional[InterfaceTypes] = None):
+        if interface_type is None:
+            if isinstance(data, Image):
+                interface_type = InterfaceTypes.Image
+            elif isinstance(data, Mesh):
+                interface_type = InterfaceTypes.Mesh
+            elif isinstance(data, PointSet):
+                interface_type = InterfaceTypes.PointSet
+        if interface_type not in (InterfaceTypes.Image, InterfaceTypes.Mesh, InterfaceTypes.PointSet):
+            raise ValueError("Only Image, Mesh, and PointSet inputs can be kept resident")
+        with _handle_counter_lock:
+            self.handle = next(_handle_counter)
+        self.type = interface_type
+        self.data = data
+
+    @property
+    def identifier(self) -> str:
+        """The pipeline argument that references the resident data object."""
+        return f"handle:{self.handle}"
+
+
+class PipelineSession:
+    """Run a pipeline repeatedly on one warm instance that keeps uploaded inputs resident.
+
+    Inputs whose data is a ResidentHandle are imported on their first use
+    and referenced by handle afterwards. Runs of a session are serialized,
+    since they share one instance; use one session per thread to run
+    concurrently. As with Pipeline.run, inputs that do not fit in wasm32
+    memory run on the memory64 module, when deployed. Changing modules
+    replaces the instance and its resident data.
+    """
+
+    def __init__(self, pipeline: Union[Pipeline, str, Path, bytes]):
+        self.pipeline = pipeline if isinstance(pipeline, Pipeline) else Pipeline(pipeline)
+        self._instance: Optional[RunInstance] = None
+        self._resident: Set[int] = set()
+        self._lock = threading.Lock()
+
+    def _instance_for(self, module: "Module", args: List[str], preopen_directories: List[str]) -> RunInstance:
+        if self._instance is not None and self._instance.can_reuse(module, preopen_directories):
+            return self._instance
+        if self._instance is not None:
+            # The directories of an instance are fixed when it is created
+            preopen_directories = list(set(preopen_directories) | self._instance._preopen_directories)
+            self._discard_instance()
+        ri = RunInstance(self.pipeline.engine, self.pipeline.linker, module, args, preopen_directories)
+        if not ri.supports_reactor or not ri.supports_handles:
+            raise RuntimeError("The pipeline was not built with the reactor and resident handle exports a session requires")
+        self._instance = ri
+        return ri
+
+    def _discard_instance(self):
+        self._instance = None
+        self._resident.clear()
+
+    def upload(self, data: Union[Image, Mesh, PointSet], interface_type: Optional[InterfaceTypes] = None) -> ResidentHandle:
+        """A handle of the data, to pass in place of the data to the runs of this or other sessions."""
+        return ResidentHandle(data, interface_type)
+
+    def release(self, handle: ResidentHandle) -> None:
+        """Release the data object of the handle from the instance."""
+        with self._lock:
+            if self._instance is not None and handle.handle in self._resident:
+                self._instance.release_handle(handle.handle)
+            self._resident.discard(handle.handle)
+
+    def close(self) -> None:
+        """Release the resident data objects and the instance."""
+        with self._lock:
+            if self._instance is not None:
+                self._instance.release_all_handles()
+            self._discard_instance()
+
+    def __enter__(self) -> "PipelineSession":
+        return self
+
+    def __exit__(self, *exc_info) -> None:
+        self.close()
+
+    def run(
+        self,
+        args: List[str],
+        outputs: List[PipelineOutput] = [],
+        inputs: List[PipelineInput] = [],
+        input_args: Optional[Dict[int, int]] = None,
+    ) -> Tuple[PipelineOutput]:
+        """Run the pipeline on the session's instance, as Pipeline.run.
+
+        input_args maps input indices to the positions of their identifiers
+        in args, which are replaced with the handle of the resident inputs.
+        It is required when an input is a ResidentHandle.
+        """
+        with self._lock:
+            args = list(args)
+            run_inputs: List[Optional[PipelineInput]] = list(inputs)
+            handle_inputs = [(index, input_.data) for index, input_ in enumerate(inputs) if isinstance(input_.data, ResidentHandle)]
+            if handle_inputs and input_args is None:
+                raise ValueError("input_args are required to pass ResidentHandle inputs")
+
+            # Resident inputs count toward the memory of the instance, so a
+            # run with large inputs moves the session to the memory64 module
+            data_inputs = [PipelineInput(input_.type, input_.data.data) if isinstance(input_.data, ResidentHandle) else input_ for input_ in inputs]
+            module = self.pipeline._module_for(data_inputs)
+            ri = self._instance_for(module, args, _preopen_directories(outputs, inputs))
+            retained: Dict[int, int] = {}
+            for index, handle in handle_inputs:
+                if handle.type != inputs[index].type:
+                    raise ValueError(f"Input {index} is a {inputs[index].type} but the handle is a {handle.type}")
+                if handle.handle in self._resident:
+                    args[input_args[index]] = handle.identifier
+                    run_inputs[index] = None
+                else:
+                    run_inputs[index] = PipelineInput(handle.type, handle.data)
+                    retained[index] = handle.handle
+
+            return_codes: List[int] = []
+
+            def release(return_code: int):
+                ri.free_all()
+                return_codes.append(return_code)
+
+            try:
+                outputs = self.pipeline._run_in(ri, args, outputs, run_inputs, True, release, retained)
+            except Exception:
+                self._discard_instance()
+                raise
+            if return_codes and return_codes[0] == 0:
+                self._resident.update(retained.values())
+            else:
+                # Do not reuse an instance that may be in an inconsistent state
+                self._discard_instance()
+            return outputs
+
+    async def run_async(
+        self,
+        args: List[str],
+        outputs: List[PipelineOutput] = [],
+        inputs: List[PipelineInput] = [],
+        input_args: Optional[Dict[int, int]] = None,
+        executor: Optional[Executor] = None,
+    ) -> Tuple[PipelineOutput]:
+        """Run the pipeline in the executor, the event loop's default thread pool by default."""
+        loop = asyncio.get_running_loop()
+        return await loop.run_in_executor(executor, functools.partial(self.run, args, outputs, inputs, input_args))
+
+    async def run_batch_async(self, calls: Sequence[Callable[[], Any]], executor: Optional[Executor] = None) -> List[Any]:
+        """Make the calls, e.g. functools.partial's of session runs, in order in one executor job.
+
+        The runs of a session are serialized, so a batch pays for one
+        executor hand off instead of one per call.
+        """
+        loop = asyncio.get_running_loop()
+        return await loop.run_in_executor(executor, lambda: [call() for call in calls])
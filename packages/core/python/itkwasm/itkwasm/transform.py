@@ -0,0 +1,35 @@
+from dataclasses import dataclass, field
+
+from typing import Optional, Union, Dict
+
+try:
+    from numpy.typing import ArrayLike
+except ImportError:
+    from numpy import ndarray as ArrayLike
+
+from .float_types import FloatTypes
+
+
+@dataclass
+class TransformType:
+    transformName: str = "IdentityTransform"
+    parametersValueType: FloatTypes = FloatTypes.Float64
+    inputDimension: int = 3
+    outputDimension: int = 3
+
+
+@dataclass
+class Transform:
+    transformType: Union[TransformType, Dict] = field(default_factory=TransformType)
+
+    name: str = "Transform"
+
+    numberOfFixedParameters: int = 0
+    fixedParameters: Optional[ArrayLike] = None
+
+    numberOfParameters: int = 0
+    parameters: Optional[ArrayLike] = None
+
+    def __post_init__(self):
+        if isinstance(self.transformType, dict):
+            self.transformType = TransformType(**self.transformType)
@@ -0,0 +1,47 @@
+from pathlib import Path
+import json
+
+from itkwasm import read_interface_json
+
+test_input_dir = Path(__file__).resolve().parent / "input"
+
+
+def _uleb128(value: int) -> bytes:
+    result = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            result.append(byte | 0x80)
+        else:
+            result.append(byte)
+            return bytes(result)
+
+
+def _custom_section(name: str, payload: bytes) -> bytes:
+    name_bytes = name.encode("utf-8")
+    content = _uleb128(len(name_bytes)) + name_bytes + payload
+    return b"\0" + _uleb128(len(content)) + content
+
+
+def test_read_interface_json_not_embedded():
+    wasm = (test_input_dir / "median-filter-test.wasi.wasm").read_bytes()
+    wasm += _custom_section("other", b"{}")
+    assert read_interface_json(wasm) is None
+
+
+def test_read_interface_json(tmp_path):
+    interface = {
+        "name": "median-filter-test",
+        "description": "Apply a median filter to an image",
+        "inputs": [],
+        "outputs": [],
+        "parameters": [],
+    }
+    wasm = (test_input_dir / "median-filter-test.wasi.wasm").read_bytes()
+    wasm += _custom_section("itk-wasm.interface", json.dumps(interface).encode("utf-8"))
+    wasm_path = tmp_path / "median-filter-test.wasi.wasm"
+    wasm_path.write_bytes(wasm)
+
+    assert read_interface_json(wasm_path) == interface
+    assert read_interface_json(wasm) == interface
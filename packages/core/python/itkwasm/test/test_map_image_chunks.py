@@ -0,0 +1,85 @@
+from pathlib import Path
+from dataclasses import asdict
+
+import itk
+import numpy as np
+
+from itkwasm import (
+    InterfaceTypes,
+    PipelineInput,
+    PipelineOutput,
+    Pipeline,
+    Image,
+    map_image_chunks,
+)
+
+test_input_dir = Path(__file__).resolve().parent / "input"
+
+pipeline = Pipeline(test_input_dir / "median-filter-test.wasi.wasm")
+
+
+def median_filter(image: Image, radius: int = 2) -> Image:
+    pipeline_inputs = [
+        PipelineInput(InterfaceTypes.Image, image),
+    ]
+    pipeline_outputs = [
+        PipelineOutput(InterfaceTypes.Image),
+    ]
+    args = ["--memory-io", "0", "0", "--radius", str(radius)]
+    outputs = pipeline.run(args, pipeline_outputs, pipeline_inputs)
+    return outputs[0].data
+
+
+def subsample(image: Image) -> Image:
+    data = np.asarray(image.data)[::2, ::2]
+    return Image(
+        imageType=image.imageType,
+        origin=list(image.origin),
+        spacing=[s * 2 for s in image.spacing],
+        direction=image.direction,
+        size=list(data.shape[::-1]),
+        data=np.ascontiguousarray(data),
+    )
+
+
+def read_image() -> Image:
+    itk_image = itk.imread(test_input_dir / "cthead1.png", itk.UC)
+    return Image(**itk.dict_from_image(itk_image))
+
+
+def test_map_image_chunks_halo():
+    image = read_image()
+    expected = median_filter(image)
+
+    result = map_image_chunks(median_filter, image, chunk_size=[64, 100], halo=[2, 2], max_workers=4)
+
+    assert list(result.size) == list(expected.size)
+    assert np.allclose(result.origin, expected.origin)
+    assert np.array_equal(np.asarray(result.data), np.asarray(expected.data).reshape(result.data.shape))
+
+
+def test_map_image_chunks_shrink_factors():
+    image = read_image()
+    image.origin = [3.0, -2.0]
+    image.spacing = [0.5, 0.25]
+    expected = subsample(image)
+
+    result = map_image_chunks(subsample, image, chunk_size=[50, 64], shrink_factors=[2, 2])
+
+    assert list(result.size) == list(expected.size)
+    assert np.allclose(result.origin, expected.origin)
+    assert np.allclose(result.spacing, expected.spacing)
+    assert np.array_equal(result.data, expected.data)
+
+
+def test_map_image_chunks_dask():
+    from dask.array import from_array
+
+    image = read_image()
+    expected = median_filter(image)
+    image.data = from_array(image.data, chunks=(64, 64))
+
+    result = map_image_chunks(median_filter, image, chunk_size=[64, 64], halo=[2, 2])
+
+    assert hasattr(result.data, "compute")
+    assert np.array_equal(result.data.compute(), np.asarray(expected.data).reshape(result.data.shape))
@@ -1,4 +1,6 @@
 from pathlib import Path, PurePosixPath
+from concurrent.futures import ThreadPoolExecutor
+import asyncio
 import tempfile
 from dataclasses import asdict
 import sys
@@ -15,6 +17,7 @@ from itkwasm import (
     PipelineInput,
     PipelineOutput,
     Pipeline,
+    PipelineSession,
     TextFile,
     BinaryFile,
     Image,
@@ -33,6 +36,66 @@ def test_stdout_stderr():
     pipeline.run([])
 
 
+def test_pipeline_threads_variant(monkeypatch):
+    from itkwasm import pipeline as pipeline_module
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        baseline = Path(tmpdir) / "median-filter.wasi.wasm"
+        baseline.write_bytes(b"")
+        variant = Path(tmpdir) / "median-filter.threads.wasi.wasm"
+
+        monkeypatch.setattr(pipeline_module, "_threads_supported", lambda: True)
+        # The baseline when the variant was not deployed
+        assert pipeline_module._preferred_variant(baseline) == baseline
+
+        variant.write_bytes(b"")
+        assert pipeline_module._preferred_variant(baseline) == variant
+        assert pipeline_module._preferred_variant(variant) == variant
+
+        monkeypatch.setattr(pipeline_module, "_threads_supported", lambda: False)
+        assert pipeline_module._preferred_variant(baseline) == baseline
+
+
+def test_pipeline_memory64_variant():
+    from itkwasm import pipeline as pipeline_module
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        baseline = Path(tmpdir) / "median-filter.wasi.wasm"
+        baseline.write_bytes(b"")
+        assert pipeline_module._memory64_variant(baseline) is None
+
+        variant = Path(tmpdir) / "median-filter.memory64.wasi.wasm"
+        variant.write_bytes(b"")
+        assert pipeline_module._memory64_variant(baseline) == variant
+
+    image = Image(data=np.zeros((4, 8), dtype=np.float32))
+    inputs = [
+        PipelineInput(InterfaceTypes.Image, image),
+        PipelineInput(InterfaceTypes.BinaryStream, BinaryStream(b"12345")),
+    ]
+    assert pipeline_module._input_bytes(inputs) == 4 * 8 * 4 + image.direction.nbytes + 5
+
+
+def test_pipeline_concurrent_runs():
+    pipeline = Pipeline(test_input_dir / "stdout-stderr-test.wasi.wasm", max_idle_instances=2)
+    with ThreadPoolExecutor(max_workers=4) as executor:
+        for result in [executor.submit(pipeline.run, []) for _ in range(8)]:
+            result.result()
+    pipeline.clear_instances()
+    pipeline.run([])
+
+
+def test_pipeline_run_async():
+    pipeline = Pipeline(test_input_dir / "stdout-stderr-test.wasi.wasm")
+    # The compiled module is shared by the Pipelines of the process
+    assert Pipeline(test_input_dir / "stdout-stderr-test.wasi.wasm").module is pipeline.module
+
+    async def run_all():
+        return await asyncio.gather(*[pipeline.run_async([]) for _ in range(4)])
+
+    assert len(asyncio.run(run_all())) == 4
+
+
 def test_pipeline_bytes():
     pipeline_path = test_input_dir / "stdout-stderr-test.wasi.wasm"
     with open(pipeline_path, "rb") as fp:
@@ -170,6 +233,76 @@ def test_pipeline_write_read_image():
     assert difference == 0.0
 
 
+def test_pipeline_session_resident_input():
+    session = PipelineSession(test_input_dir / "median-filter-test.wasi.wasm")
+
+    data = test_input_dir / "cthead1.png"
+    itk_image = itk.imread(data, itk.UC)
+    itkwasm_image = Image(**itk.dict_from_image(itk_image))
+    image_handle = session.upload(itkwasm_image)
+
+    baseline = itk.imread(test_baseline_dir / "test_pipeline_write_read_image.png")
+    args = ["--memory-io", "0", "0", "--radius", "2"]
+    try:
+        # Imported on the first run, passed by handle on the second
+        for _ in range(2):
+            outputs = session.run(args, [PipelineOutput(InterfaceTypes.Image)], [PipelineInput(InterfaceTypes.Image, image_handle)], {0: 1})
+            out_image = itk.image_from_dict(asdict(outputs[0].data))
+            out_image.SetRegions([256, 256])
+            assert np.sum(itk.comparison_image_filter(out_image, baseline)) == 0.0
+    except RuntimeError:
+        pytest.skip("The test pipeline was built without the resident handle exports")
+
+    async def run_batch():
+        run = lambda: session.run(args, [PipelineOutput(InterfaceTypes.Image)], [PipelineInput(InterfaceTypes.Image, image_handle)], {0: 1})
+        return await session.run_batch_async([run, run])
+
+    results = asyncio.run(run_batch())
+    assert len(results) == 2
+    session.release(image_handle)
+    session.close()
+
+
+def test_pipeline_write_read_image_views():
+    pipeline = Pipeline(test_input_dir / "median-filter-test.wasi.wasm")
+
+    data = test_input_dir / "cthead1.png"
+    itk_image = itk.imread(data, itk.UC)
+    itk_image_dict = itk.dict_from_image(itk_image)
+    itkwasm_image = Image(**itk_image_dict)
+
+    pipeline_inputs = [
+        PipelineInput(InterfaceTypes.Image, itkwasm_image),
+    ]
+
+    pipeline_outputs = [
+        PipelineOutput(InterfaceTypes.Image),
+    ]
+
+    args = [
+        "--memory-io",
+        "0",
+        "0",
+        "--radius",
+        "2",
+    ]
+
+    outputs = pipeline.run(args, pipeline_outputs, pipeline_inputs, copy_outputs=False)
+    view = outputs[0].data.data
+    assert not view.flags.writeable
+
+    out_image = itk.image_from_dict(asdict(outputs[0].data))
+    out_image.SetRegions([256, 256])
+    baseline = itk.imread(test_baseline_dir / "test_pipeline_write_read_image.png")
+    difference = np.sum(itk.comparison_image_filter(out_image, baseline))
+    assert difference == 0.0
+
+    copied = view.copy()
+    del outputs, view, out_image
+    outputs = pipeline.run(args, pipeline_outputs, pipeline_inputs)
+    assert np.array_equal(outputs[0].data.data, copied)
+
+
 def test_pipeline_dask_array_input():
     pipeline = Pipeline(test_input_dir / "median-filter-test.wasi.wasm")
 
@@ -13,10 +13,14 @@ const interfaceJsonTypeToInterfaceType = new Map([
   ['OUTPUT_BINARY_STREAM', 'BinaryStream'],
   ['INPUT_IMAGE', 'Image'],
   ['OUTPUT_IMAGE', 'Image'],
+  ['INPUT_POINT_SET', 'PointSet'],
+  ['OUTPUT_POINT_SET', 'PointSet'],
   ['INPUT_MESH', 'Mesh'],
   ['OUTPUT_MESH', 'Mesh'],
   ['INPUT_POLYDATA', 'PolyData'],
   ['OUTPUT_POLYDATA', 'PolyData'],
+  ['INPUT_TRANSFORM', 'Transform'],
+  ['OUTPUT_TRANSFORM', 'Transform'],
   ['INPUT_JSON', 'JsonCompatible'],
   ['OUTPUT_JSON', 'JsonCompatible'],
 ])
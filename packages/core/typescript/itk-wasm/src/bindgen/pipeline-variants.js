@@ -0,0 +1,41 @@
+import fs from 'fs-extra'
+import path from 'path'
+
+// Pipelines built in the -threads and -memory64 build environment image tags
+// are named <pipeline>.<variant>.wasm or <pipeline>.<variant>.wasi.wasm.
+const variants = ['threads', 'memory64']
+
+function isPipelineVariant(wasmBinaryPath) {
+  return variants.some((variant) =>
+    new RegExp(`\\.${variant}(\\.wasi)?\\.wasm$`).test(wasmBinaryPath)
+  )
+}
+
+// The variant of a baseline binary, in the same build directory or in the
+// corresponding -<variant>-build directory, or null if it was not built.
+function pipelineVariantPath(buildDir, wasmBinaryPath, variant) {
+  const variantName = path
+    .basename(wasmBinaryPath)
+    .replace(/(\.wasi)?\.wasm$/, `.${variant}$1.wasm`)
+  const candidates = [path.join(path.dirname(wasmBinaryPath), variantName)]
+  const normalizedBuildDir = path.normalize(buildDir)
+  const relativePath = path.relative(normalizedBuildDir, wasmBinaryPath)
+  if (!relativePath.startsWith('..') && !path.isAbsolute(relativePath)) {
+    const variantBuildDir = normalizedBuildDir.endsWith('-build')
+      ? normalizedBuildDir.replace(/-build$/, `-${variant}-build`)
+      : `${normalizedBuildDir}-${variant}`
+    candidates.push(
+      path.join(variantBuildDir, path.dirname(relativePath), variantName)
+    )
+  }
+  return candidates.find((candidate) => fs.existsSync(candidate)) ?? null
+}
+
+// The variants built for a baseline binary
+function pipelineVariantPaths(buildDir, wasmBinaryPath) {
+  return variants
+    .map((variant) => pipelineVariantPath(buildDir, wasmBinaryPath, variant))
+    .filter((variantPath) => variantPath !== null)
+}
+
+export { isPipelineVariant, pipelineVariantPaths }
@@ -5,7 +5,7 @@ import snakeCase from "../snake-case.js"
 import wasmBinaryInterfaceJson from "../wasm-binary-interface-json.js"
 import writeIfOverrideNotPresent from '../write-if-override-not-present.js'
 
-function packageDunderInit(outputDir, buildDir, wasmBinaries, packageName, packageDescription, packageDir, pypackage, async, sync) {
+function packageDunderInit(outputDir, buildDir, wasmBinaries, packageName, packageDescription, packageDir, pypackage, async, sync, sessionClassName = null) {
   const functionNames = []
   wasmBinaries.forEach((wasmBinaryName) => {
     const { interfaceJson, parsedPath } = wasmBinaryInterfaceJson(outputDir, buildDir, wasmBinaryName)
@@ -17,7 +17,10 @@ function packageDunderInit(outputDir, buildDir, wasmBinaries, packageName, packa
     }
   })
 
-  const functionImports = functionNames.map(n => `from .${n} import ${n}`).join("\n")
+  let functionImports = functionNames.map(n => `from .${n} import ${n}`).join("\n")
+  if (sessionClassName !== null) {
+    functionImports += `\nfrom .session import ${sessionClassName}`
+  }
 
   const dunderInit = `"""${packageName}: ${packageDescription}"""
 
@@ -11,27 +11,10 @@ import interfaceJsonTypeToInterfaceType from '../../interface-json-type-to-inter
 import interfaceJsonTypeToPythonType from '../interface-json-type-to-python-type.js'
 import writeIfOverrideNotPresent from '../../write-if-override-not-present.js'
 
-function wasiFunctionModule(interfaceJson, pypackage, modulePath) {
-  const functionName = snakeCase(interfaceJson.name)
-  let moduleContent = `from pathlib import Path, PurePosixPath
-import os
-from typing import Dict, Tuple, Optional, List, Any
-
-from importlib_resources import files as file_resources
-
-_pipeline = None
-
-from itkwasm import (
-    InterfaceTypes,
-    PipelineOutput,
-    PipelineInput,
-    Pipeline,`
-
-  moduleContent += functionModuleImports(interfaceJson)
-  const functionArgs = functionModuleArgs(interfaceJson)
-  const returnType = functionModuleReturnType(interfaceJson)
-  const docstring = functionModuleDocstring(interfaceJson)
-
+// The pipeline outputs, inputs, and args preparation, and the result
+// formatting, of the function body. Session methods also record the
+// positions of the input identifiers in input_args.
+export function wasiFunctionParts(interfaceJson, session = false) {
   let pipelineOutputFilePrep = ''
   interfaceJson.outputs.forEach((output) => {
     if (interfaceJsonTypeToInterfaceType.has(output.type)) {
@@ -112,6 +95,10 @@ from itkwasm import (
   })
 
   let args = `    args: List[str] = ['--memory-io',]\n`
+  if (session) {
+    // Positions of the input identifiers, replaced by the handles of resident inputs
+    args += `    input_args: Dict[int, int] = {}\n`
+  }
   let inputCount = 0
   args += "    # Inputs\n"
   interfaceJson.inputs.forEach((input) => {
@@ -123,6 +110,9 @@ from itkwasm import (
         args += `        raise FileNotFoundError("${snakeName} does not exist")\n`
       }
       const name = interfaceType.includes('File') ? `str(PurePosixPath(${snakeName}))` : `'${inputCount.toString()}'`
+      if (session && !interfaceType.includes('File')) {
+        args += `    input_args[${inputCount}] = len(args)\n`
+      }
       args += `    args.append(${name})\n`
       inputCount++
     } else {
@@ -191,6 +181,9 @@ from itkwasm import (
         } else {
           // Image, Mesh, PolyData, JsonCompatible
           args += `            pipeline_inputs.append(PipelineInput(InterfaceTypes.${interfaceType}, value))\n`
+          if (session) {
+            args += `            input_args[input_count] = len(args)\n`
+          }
           args += `            args.append(str(input_count))\n`
           args += `            input_count += 1\n`
         }
@@ -217,6 +210,9 @@ from itkwasm import (
           // Image, Mesh, PolyData, JsonCompatible
           args += `        pipeline_inputs.append(PipelineInput(InterfaceTypes.${interfaceType}, ${snake}))\n`
           args += `        args.append('--${parameter.name}')\n`
+          if (session) {
+            args += `        input_args[input_count] = len(args)\n`
+          }
           args += `        args.append(str(input_count))\n`
           args += `        input_count += 1\n`
         }
@@ -300,6 +296,33 @@ from itkwasm import (
     postOutput += '    return result\n'
   }
 
+  return { pipelineOutputFilePrep, pipelineOutputs, pipelineOutputIndices, pipelineInputs, args, postOutput }
+}
+
+function wasiFunctionModule(interfaceJson, pypackage, modulePath) {
+  const functionName = snakeCase(interfaceJson.name)
+  let moduleContent = `from pathlib import Path, PurePosixPath
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from importlib_resources import files as file_resources
+
+_pipeline = None
+
+from itkwasm import (
+    InterfaceTypes,
+    PipelineOutput,
+    PipelineInput,
+    Pipeline,`
+
+  moduleContent += functionModuleImports(interfaceJson)
+  const functionArgs = functionModuleArgs(interfaceJson)
+  const returnType = functionModuleReturnType(interfaceJson)
+  const docstring = functionModuleDocstring(interfaceJson)
+
+  const { pipelineOutputFilePrep, pipelineOutputs, pipelineOutputIndices, pipelineInputs, args, postOutput } = wasiFunctionParts(interfaceJson)
+
+
   moduleContent += `def ${functionName}(
 ${functionArgs}) -> ${returnType}:
     ${docstring}
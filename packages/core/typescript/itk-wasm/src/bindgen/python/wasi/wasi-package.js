@@ -4,12 +4,15 @@ import path from 'path'
 import mkdirP from '../../mkdir-p.js'
 
 import snakeCase from '../../snake-case.js'
+import pascalCase from '../../pascal-case.js'
 
 import wasiPackageReadme from './wasi-package-readme.js'
 import packagePyProjectToml from '../package-py-project-toml.js'
 import packageVersion from '../package-version.js'
 import wasiFunctionModule from './wasi-function-module.js'
+import wasiSessionModule from './wasi-session-module.js'
 import wasmBinaryInterfaceJson from '../../wasm-binary-interface-json.js'
+import { pipelineVariantPaths } from '../../pipeline-variants.js'
 import packageDunderInit from '../package-dunder-init.js'
 import bindgenResource from '../bindgen-resource.js'
 import writeIfOverrideNotPresent from '../../write-if-override-not-present.js'
@@ -29,6 +32,7 @@ function wasiPackage(outputDir, buildDir, wasmBinaries, options) {
   packageVersion(packageDir, pypackage, options)
   const async = false
   const sync = true
+  const sessionClassName = `${pascalCase(options.packageName)}Session`
   packageDunderInit(
     outputDir,
     buildDir,
@@ -38,7 +42,8 @@ function wasiPackage(outputDir, buildDir, wasmBinaries, options) {
     packageDir,
     pypackage,
     async,
-    sync
+    sync,
+    sessionClassName
   )
 
   const testDir = path.join(packageDir, 'tests')
@@ -53,6 +58,7 @@ function wasiPackage(outputDir, buildDir, wasmBinaries, options) {
 
   const wasmModulesDir = path.join(packageDir, pypackage, 'wasm_modules')
   mkdirP(wasmModulesDir)
+  const interfaceJsons = []
   wasmBinaries.forEach((wasmBinaryName) => {
     const { interfaceJson, parsedPath } = wasmBinaryInterfaceJson(
       outputDir,
@@ -63,6 +69,17 @@ function wasiPackage(outputDir, buildDir, wasmBinaries, options) {
       path.join(parsedPath.dir, parsedPath.base),
       path.join(wasmModulesDir, parsedPath.base)
     )
+    // The threads and memory64 variants, loaded when wasmtime supports them
+    pipelineVariantPaths(
+      path.resolve(buildDir),
+      path.join(parsedPath.dir, parsedPath.base)
+    ).forEach((variantBinaryPath) => {
+      fs.copyFileSync(
+        variantBinaryPath,
+        path.join(wasmModulesDir, path.basename(variantBinaryPath))
+      )
+    })
+    interfaceJsons.push(interfaceJson)
     const functionName = snakeCase(interfaceJson.name)
     wasiFunctionModule(
       interfaceJson,
@@ -74,6 +91,14 @@ function wasiPackage(outputDir, buildDir, wasmBinaries, options) {
     const testContent = `from ${pypackage} import ${functionName}\n\nfrom .common import test_input_path, test_output_path\n\ndef test_${functionName}():\n    pass\n`
     writeIfOverrideNotPresent(testPath, testContent, '#')
   })
+
+  // One class whose methods run the pipelines on warm instances
+  wasiSessionModule(
+    interfaceJsons,
+    options.packageName,
+    pypackage,
+    path.join(packageDir, pypackage, 'session.py')
+  )
 }
 
 export default wasiPackage
@@ -0,0 +1,144 @@
+import snakeCase from '../../snake-case.js'
+import pascalCase from '../../pascal-case.js'
+
+import functionModuleReturnType from '../function-module-return-type.js'
+import functionModuleDocstring from '../function-module-docstring.js'
+import functionModuleArgs from '../function-module-args.js'
+import interfaceJsonTypeToInterfaceType from '../../interface-json-type-to-interface-type.js'
+import writeIfOverrideNotPresent from '../../write-if-override-not-present.js'
+import { wasiFunctionParts } from './wasi-function-module.js'
+
+function indent(text) {
+  return text
+    .split('\n')
+    .map((line) => (line.length > 0 ? `    ${line}` : line))
+    .join('\n')
+}
+
+function sessionMethods(interfaceJson) {
+  const functionName = snakeCase(interfaceJson.name)
+  const functionArgs = functionModuleArgs(interfaceJson)
+  const returnType = functionModuleReturnType(interfaceJson)
+  const docstring = functionModuleDocstring(interfaceJson)
+  const { pipelineOutputFilePrep, pipelineOutputs, pipelineOutputIndices, pipelineInputs, args, postOutput } =
+    wasiFunctionParts(interfaceJson, true)
+
+  const method = `def ${functionName}(
+    self,
+${functionArgs}) -> ${returnType}:
+    ${docstring}
+${pipelineOutputFilePrep}
+    pipeline_outputs: List[PipelineOutput] = [
+${pipelineOutputs}    ]
+${pipelineOutputIndices}
+    pipeline_inputs: List[PipelineInput] = [
+${pipelineInputs}    ]
+
+${args}
+    outputs = self._session('${interfaceJson.name}').run(args, pipeline_outputs, pipeline_inputs, input_args)
+
+${postOutput}
+async def ${functionName}_async(self, *args, **kwargs) -> ${returnType}:
+    """${functionName}, with the same arguments, in the event loop's default thread pool."""
+    loop = asyncio.get_running_loop()
+    return await loop.run_in_executor(None, functools.partial(self.${functionName}, *args, **kwargs))
+
+`
+  return indent(method)
+}
+
+function wasiSessionModule(interfaceJsons, packageName, pypackage, modulePath) {
+  const className = `${pascalCase(packageName)}Session`
+
+  const usedInterfaceTypes = new Set(['Image', 'Mesh', 'PointSet'])
+  const pipelineComponents = ['inputs', 'outputs', 'parameters']
+  interfaceJsons.forEach((interfaceJson) => {
+    pipelineComponents.forEach((pipelineComponent) => {
+      interfaceJson[pipelineComponent].forEach((value) => {
+        if (interfaceJsonTypeToInterfaceType.has(value.type)) {
+          const interfaceType = interfaceJsonTypeToInterfaceType.get(value.type)
+          if (interfaceType !== 'JsonCompatible') {
+            usedInterfaceTypes.add(interfaceType)
+          }
+        }
+      })
+    })
+  })
+  let interfaceTypeImports = ''
+  usedInterfaceTypes.forEach((interfaceType) => {
+    interfaceTypeImports += `\n    ${interfaceType},`
+  })
+
+  const methods = interfaceJsons.map(sessionMethods).join('')
+
+  const moduleContent = `from pathlib import Path, PurePosixPath
+import asyncio
+import functools
+import os
+import threading
+from typing import Dict, Tuple, Optional, List, Any, Callable, Sequence, Union
+
+from importlib_resources import files as file_resources
+
+from itkwasm import (
+    InterfaceTypes,
+    PipelineOutput,
+    PipelineInput,
+    PipelineSession,
+    ResidentHandle,${interfaceTypeImports}
+)
+
+
+class ${className}:
+    """Run the ${packageName} pipelines on warm instances that keep uploaded inputs resident.
+
+    Image, Mesh, and PointSet inputs may be handles returned by upload, whose
+    data is copied into the instance of each pipeline once. Runs of a session
+    are serialized; use one session per thread to run concurrently.
+    """
+
+    def __init__(self):
+        self._sessions: Dict[str, PipelineSession] = {}
+        self._sessions_lock = threading.Lock()
+
+    def _session(self, name: str) -> PipelineSession:
+        with self._sessions_lock:
+            if name not in self._sessions:
+                self._sessions[name] = PipelineSession(file_resources('${pypackage}').joinpath(Path('wasm_modules') / Path(f'{name}.wasi.wasm')))
+            return self._sessions[name]
+
+    def upload(self, data: Union[Image, Mesh, PointSet]) -> ResidentHandle:
+        """A handle of the data, to pass in place of the data to the methods of the session."""
+        return ResidentHandle(data)
+
+    def release(self, handle: ResidentHandle) -> None:
+        """Release the data of the handle from the pipeline instances."""
+        with self._sessions_lock:
+            sessions = list(self._sessions.values())
+        for session in sessions:
+            session.release(handle)
+
+    def close(self) -> None:
+        """Release the resident data and the pipeline instances."""
+        with self._sessions_lock:
+            sessions = list(self._sessions.values())
+            self._sessions.clear()
+        for session in sessions:
+            session.close()
+
+    def __enter__(self) -> "${className}":
+        return self
+
+    def __exit__(self, *exc_info) -> None:
+        self.close()
+
+    async def run_batch_async(self, calls: Sequence[Callable[[], Any]]) -> List[Any]:
+        """Make the calls, e.g. functools.partial's of the session methods, in order in one thread pool job."""
+        loop = asyncio.get_running_loop()
+        return await loop.run_in_executor(None, lambda: [call() for call in calls])
+
+${methods}`
+  writeIfOverrideNotPresent(modulePath, moduleContent, '#')
+}
+
+export default wasiSessionModule
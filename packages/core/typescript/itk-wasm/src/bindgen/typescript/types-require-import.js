@@ -1,3 +1,3 @@
-const typesRequireImport = ['Image', 'Mesh', 'PolyData', 'TextFile', 'BinaryFile', 'TextFile', 'BinaryFile', 'JsonCompatible']
+const typesRequireImport = ['Image', 'Mesh', 'PolyData', 'Transform', 'TextFile', 'BinaryFile', 'TextFile', 'BinaryFile', 'JsonCompatible']
 
 export default typesRequireImport
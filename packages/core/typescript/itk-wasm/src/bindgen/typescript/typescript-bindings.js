@@ -3,6 +3,7 @@ import path from 'path'
 import { fileURLToPath } from 'url'
 
 import wasmBinaryInterfaceJson from '../wasm-binary-interface-json.js'
+import { pipelineVariantPaths } from '../pipeline-variants.js'
 import camelCase from '../camel-case.js'
 
 import packageToBundleName from './package-to-bundle-name.js'
@@ -133,6 +134,31 @@ function typescriptBindings(
       path.join(distPipelinesDir, `${path.basename(prefix)}.js`)
     )
 
+    // The threads and memory64 variants, loaded when the runtime supports
+    // them
+    pipelineVariantPaths(buildDir, wasmBinaryRelativePath).forEach(
+      (variantBinaryPath) => {
+        const variantPrefix = variantBinaryPath.substring(
+          0,
+          variantBinaryPath.length - 5
+        )
+        const variantFiles = [
+          variantBinaryPath,
+          `${variantBinaryPath}.zst`,
+          `${variantPrefix}.js`,
+          `${variantPrefix}.worker.js`
+        ]
+        variantFiles
+          .filter((variantFile) => fs.existsSync(variantFile))
+          .forEach((variantFile) => {
+            fs.copyFileSync(
+              variantFile,
+              path.join(distPipelinesDir, path.basename(variantFile))
+            )
+          })
+      }
+    )
+
     const { interfaceJson, parsedPath } = wasmBinaryInterfaceJson(
       outputDir,
       buildDir,
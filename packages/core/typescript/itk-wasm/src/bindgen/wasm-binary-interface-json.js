@@ -3,6 +3,8 @@ import fs from 'fs-extra'
 import { spawnSync } from 'child_process'
 import { fileURLToPath } from 'url'
 
+import readWasmInterfaceSection from './wasm-interface-section.js'
+
 const currentScriptPath = path.dirname(fileURLToPath(import.meta.url))
 
 function wasmBinaryInterfaceJson(outputDir, buildDir, wasmBinaryName) {
@@ -13,7 +15,13 @@ function wasmBinaryInterfaceJson(outputDir, buildDir, wasmBinaryName) {
 
   let interfaceJson = ''
   const parsedPath = path.parse(path.resolve(wasmBinaryRelativePath))
-  if (parsedPath.name.endsWith('wasi')) {
+  // Binaries built with ITK_WASM_EMBED_INTERFACE_JSON carry their interface,
+  // others are run with --interface-json
+  const wasmPath = parsedPath.ext === '.wasm' ? path.resolve(wasmBinaryRelativePath) : path.join(parsedPath.dir, `${parsedPath.name}.wasm`)
+  const embeddedInterfaceJson = readWasmInterfaceSection(wasmPath)
+  if (embeddedInterfaceJson !== null) {
+    interfaceJson = embeddedInterfaceJson
+  } else if (parsedPath.name.endsWith('wasi')) {
     const runPipelineScriptPath = path.join(
       currentScriptPath,
       'interface-json-node-wasi.js'
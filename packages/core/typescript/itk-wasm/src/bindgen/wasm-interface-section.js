@@ -0,0 +1,52 @@
+import fs from 'fs-extra'
+
+// Name of the custom section in which the build embeds the --interface-json
+// output of a pipeline
+export const interfaceSectionName = 'itk-wasm.interface'
+
+function decodeULEB128(bytes, offset) {
+  let value = 0
+  let scale = 1
+  let byte = 0
+  do {
+    byte = bytes[offset++]
+    value += (byte & 0x7f) * scale
+    scale *= 128
+  } while (byte & 0x80)
+  return { value, offset }
+}
+
+// The embedded interface JSON of a wasm binary, or null when it has none.
+// The sections are walked without compiling the module.
+function readWasmInterfaceSection(wasmPath) {
+  let wasm = null
+  try {
+    wasm = fs.readFileSync(wasmPath)
+  } catch (error) {
+    return null
+  }
+  if (wasm.length < 8 || wasm.readUInt32LE(0) !== 0x6d736100) {
+    return null
+  }
+  let offset = 8
+  while (offset < wasm.length) {
+    const id = wasm[offset++]
+    const size = decodeULEB128(wasm, offset)
+    const sectionEnd = size.offset + size.value
+    if (id === 0) {
+      const nameLength = decodeULEB128(wasm, size.offset)
+      const nameEnd = nameLength.offset + nameLength.value
+      if (wasm.subarray(nameLength.offset, nameEnd).toString('utf8') === interfaceSectionName) {
+        try {
+          return JSON.parse(wasm.subarray(nameEnd, sectionEnd).toString('utf8'))
+        } catch (error) {
+          return null
+        }
+      }
+    }
+    offset = sectionEnd
+  }
+  return null
+}
+
+export default readWasmInterfaceSection
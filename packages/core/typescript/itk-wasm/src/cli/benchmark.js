@@ -0,0 +1,232 @@
+import fs from 'fs-extra'
+import os from 'os'
+import path from 'path'
+import { spawnSync } from 'child_process'
+
+import program from './program.js'
+import die from './die.js'
+
+const runtimes = ['native', 'wasi', 'emscripten']
+
+// Runs WASI pipelines under wasmtime with the itkwasm Python package, as
+// deployed. Reads { wasm, args, dirs, trials } on stdin and writes the
+// per-trial wall seconds on stdout.
+const wasiDriver = `
+import json
+import sys
+import time
+from pathlib import PurePosixPath
+
+from itkwasm import BinaryFile, InterfaceTypes, Pipeline, PipelineInput
+
+config = json.load(sys.stdin)
+# Preopen the corpus and output directories
+inputs = [PipelineInput(InterfaceTypes.BinaryFile, BinaryFile(PurePosixPath(d) / ".benchmark")) for d in config["dirs"]]
+trials = []
+for trial in range(config["trials"]):
+    start = time.perf_counter()
+    pipeline = Pipeline(config["wasm"])
+    pipeline.run(config["args"], [], inputs)
+    end = time.perf_counter()
+    sys.stderr.flush()
+    trials.append({"wall": end - start})
+json.dump(trials, sys.stdout)
+`
+
+function expandArgs (args, inputDir, outputDir) {
+  return args.map((arg) =>
+    arg.replaceAll('{input}', inputDir).replaceAll('{output}', outputDir)
+  )
+}
+
+// The --profile reports, in order, from a pipeline's stderr
+function parseProfiles (stderr) {
+  const profiles = []
+  for (const line of stderr.split('\n')) {
+    if (!line.startsWith('{')) {
+      continue
+    }
+    try {
+      const report = JSON.parse(line)
+      if (Array.isArray(report.profile)) {
+        profiles.push(report.profile)
+      }
+    } catch (err) {
+      // Not a profile report
+    }
+  }
+  return profiles
+}
+
+// Split a trial's wall time into the time to start and instantiate the
+// pipeline, to run it, and to read and write its inputs and outputs
+function breakdown (wall, profile) {
+  let run = 0
+  let io = 0
+  for (const event of profile ?? []) {
+    if (event.name === 'compute') {
+      run += event.seconds
+    } else {
+      io += event.seconds
+    }
+  }
+  const instantiate = Math.max(wall - run - io, 0)
+  return { wall, instantiate, run, io }
+}
+
+function percentile (sorted, p) {
+  const rank = Math.max(Math.ceil((p / 100) * sorted.length) - 1, 0)
+  return sorted[Math.min(rank, sorted.length - 1)]
+}
+
+function summarize (trials) {
+  const summary = {}
+  for (const phase of ['wall', 'instantiate', 'run', 'io']) {
+    const sorted = trials.map((trial) => trial[phase]).sort((a, b) => a - b)
+    const mean = sorted.reduce((sum, value) => sum + value, 0) / sorted.length
+    summary[phase] = {
+      min: sorted[0],
+      mean,
+      p50: percentile(sorted, 50),
+      p90: percentile(sorted, 90),
+      p99: percentile(sorted, 99),
+      max: sorted[sorted.length - 1]
+    }
+  }
+  return summary
+}
+
+function runNative (binary, args, trials) {
+  const results = []
+  for (let trial = 0; trial < trials; trial++) {
+    const start = process.hrtime.bigint()
+    const run = spawnSync(binary, args.concat(['--profile']), {
+      env: process.env,
+      encoding: 'utf-8',
+      maxBuffer: 1 << 30
+    })
+    const wall = Number(process.hrtime.bigint() - start) / 1e9
+    if (run.status !== 0) {
+      die(`${binary} failed:\n${run.error ?? run.stderr}`)
+    }
+    results.push(breakdown(wall, parseProfiles(run.stderr)[0]))
+  }
+  return results
+}
+
+function runWasi (wasm, args, dirs, trials, python) {
+  const config = {
+    wasm,
+    args: [path.basename(wasm)].concat(args, ['--profile']),
+    dirs,
+    trials
+  }
+  const run = spawnSync(python, ['-c', wasiDriver], {
+    env: process.env,
+    input: JSON.stringify(config),
+    encoding: 'utf-8',
+    maxBuffer: 1 << 30
+  })
+  if (run.status !== 0) {
+    die(`${wasm} failed:\n${run.error ?? run.stderr}`)
+  }
+  const profiles = parseProfiles(run.stderr)
+  return JSON.parse(run.stdout).map((trial, index) =>
+    breakdown(trial.wall, profiles[index])
+  )
+}
+
+async function runEmscripten (modulePath, args, dirs, trials) {
+  let runPipelineNode = null
+  try {
+    ;({ runPipelineNode } = await import('itk-wasm'))
+  } catch (err) {
+    die(`The itk-wasm package must be built to benchmark emscripten pipelines: ${err}`)
+  }
+  const results = []
+  for (let trial = 0; trial < trials; trial++) {
+    const start = process.hrtime.bigint()
+    const { returnValue, stderr } = await runPipelineNode(
+      modulePath,
+      args.concat(['--profile']),
+      [],
+      null,
+      new Set(dirs)
+    )
+    const wall = Number(process.hrtime.bigint() - start) / 1e9
+    if (returnValue !== 0) {
+      die(`${modulePath} failed:\n${stderr}`)
+    }
+    results.push(breakdown(wall, parseProfiles(stderr)[0]))
+  }
+  return results
+}
+
+async function benchmark (pipeline, options) {
+  const sourceDir = program.opts().sourceDir ?? '.'
+  if (!fs.existsSync(sourceDir)) {
+    die('The source directory: ' + sourceDir + ' does not exist!')
+  }
+  process.chdir(sourceDir)
+
+  const corpusPath = path.resolve(options.corpus)
+  const corpus = JSON.parse(fs.readFileSync(corpusPath, 'utf-8'))
+  const inputDir = path.resolve(path.dirname(corpusPath), corpus.inputDir ?? '.')
+  const outputDir = fs.mkdtempSync(path.join(os.tmpdir(), 'itk-wasm-benchmark-'))
+  const dirs = [inputDir, outputDir]
+
+  const trials = parseInt(options.trials ?? '10')
+  const warmup = parseInt(options.warmup ?? '1')
+  const selectedRuntimes = options.runtime ?? runtimes
+  const binaries = {
+    native: path.resolve(options.nativeBuildDir ?? 'native-build', pipeline),
+    wasi: path.resolve(options.wasiBuildDir ?? 'wasi-build', `${pipeline}.wasi.wasm`),
+    emscripten: path.resolve(options.emscriptenBuildDir ?? 'emscripten-build', pipeline)
+  }
+  const python = options.python ?? 'python3'
+
+  const report = { pipeline, trials, warmup, cases: [] }
+  for (const testCase of corpus.cases) {
+    const args = expandArgs(testCase.args, inputDir, outputDir)
+    const caseReport = { name: testCase.name, runtimes: {} }
+    for (const runtime of selectedRuntimes) {
+      const binary = binaries[runtime]
+      const exists =
+        runtime === 'emscripten' ? fs.existsSync(`${binary}.js`) : fs.existsSync(binary)
+      if (!exists) {
+        console.error(`Skipping the ${runtime} runtime, ${binary} was not found`)
+        continue
+      }
+      let results = null
+      switch (runtime) {
+        case 'native':
+          results = runNative(binary, args, warmup + trials)
+          break
+        case 'wasi':
+          results = runWasi(binary, args, dirs, warmup + trials, python)
+          break
+        case 'emscripten':
+          results = await runEmscripten(binary, args, dirs, warmup + trials)
+          break
+        default:
+          throw Error('unexpected runtime')
+      }
+      results = results.slice(warmup)
+      caseReport.runtimes[runtime] = { trials: results, summary: summarize(results) }
+
+      const { wall, instantiate, run, io } = caseReport.runtimes[runtime].summary
+      console.log(
+        `${testCase.name} ${runtime}: wall p50 ${wall.p50.toFixed(4)}s p90 ${wall.p90.toFixed(4)}s, ` +
+          `instantiate p50 ${instantiate.p50.toFixed(4)}s, run p50 ${run.p50.toFixed(4)}s, io p50 ${io.p50.toFixed(4)}s`
+      )
+    }
+    report.cases.push(caseReport)
+  }
+  fs.removeSync(outputDir)
+
+  if (options.output) {
+    fs.writeFileSync(options.output, JSON.stringify(report, null, 2))
+  }
+}
+
+export default benchmark
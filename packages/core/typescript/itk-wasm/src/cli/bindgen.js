@@ -10,6 +10,7 @@ import pythonBindgen from '../bindgen/python/python-bindgen.js'
 import pythonWebDemoBindgen from '../bindgen/python-web-demo/python-web-demo-bindgen.js'
 
 import program from './program.js'
+import { isPipelineVariant } from '../bindgen/pipeline-variants.js'
 
 function bindgen(options) {
   options.packageDescription = options.packageDescription.join(' ')
@@ -32,9 +33,11 @@ function bindgen(options) {
     if (err.code !== 'EE XIST') throw err
   }
 
-  // Filter libraries.
+  // Filter libraries, and the threads and memory64 variants, which are copied
+  // with their baseline binary.
   let filteredWasmBinaries = wasmBinaries.filter(
-    (binary) => !path.basename(binary).startsWith('lib')
+    (binary) =>
+      !path.basename(binary).startsWith('lib') && !isPipelineVariant(binary)
   )
 
   switch (iface) {
@@ -6,6 +6,10 @@ function getFileExtension (filePath: string): string {
   } else if (extension.toLowerCase() === 'cbor') {
     const index = filePath.slice(0, -5).lastIndexOf('.')
     extension = filePath.slice((index - 1 >>> 0) + 2)
+  } else if (/\.iw[im]\.(bin|bundle)$/i.test(filePath)) {
+    // .iwi.bin and .iwm.bin aligned files, .iwi.bundle and .iwm.bundle files
+    const index = filePath.slice(0, -(extension.length + 1)).lastIndexOf('.')
+    extension = filePath.slice((index - 1 >>> 0) + 2)
   } else if (extension.toLowerCase() === 'zst') {
     // .iwi.cbor.zstd
     const index = filePath.slice(0, -10).lastIndexOf('.')
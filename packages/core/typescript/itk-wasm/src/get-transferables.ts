@@ -7,7 +7,7 @@ function getTransferables (data?: any[] | null, noCopy?: boolean): ArrayBuffer[]
   const transferables: ArrayBuffer[] = []
   for (let i = 0; i < data.length; i++) {
     const transferable = getTransferable(data[i], noCopy)
-    if (transferable !== null) {
+    if (transferable !== null && !transferables.includes(transferable)) {
       transferables.push(transferable)
     }
   }
@@ -0,0 +1,14 @@
+// Intensity statistics of one image component, stored by writers that
+// compute them, e.g. to set the window and level of a display. The
+// histogram counts equal width bins from the minimum to the maximum.
+interface ComponentStatistics {
+  minimum: number
+
+  maximum: number
+
+  mean: number
+
+  histogram: number[]
+}
+
+export default ComponentStatistics
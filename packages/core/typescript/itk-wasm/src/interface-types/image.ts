@@ -2,6 +2,7 @@ import ImageType from './image-type.js'
 import type TypedArray from '../typed-array.js'
 import setMatrixElement from '../set-matrix-element.js'
 import Metadata from './metadata.js'
+import type ComponentStatistics from './component-statistics.js'
 
 class Image {
   name: string = 'image'
@@ -18,6 +19,9 @@ class Image {
 
   data: null | TypedArray
 
+  // One entry per component, when the image was serialized with them
+  intensityStatistics?: ComponentStatistics[]
+
   constructor (public readonly imageType = new ImageType()) {
     const dimension = imageType.dimension
     this.origin = new Array(dimension)
@@ -3,6 +3,7 @@
 export { default as IntTypes } from './int-types.js'
 export { default as FloatTypes } from './float-types.js'
 export type { default as Metadata } from './metadata.js'
+export type { default as ComponentStatistics } from './component-statistics.js'
 export { default as PixelTypes } from './pixel-types.js'
 
 export type { default as TextStream } from './text-stream.js'
@@ -20,4 +21,7 @@ export { default as MeshType } from './mesh-type.js'
 export { default as PolyData } from './poly-data.js'
 export { default as PolyDataType } from './poly-data-type.js'
 
+export { default as Transform } from './transform.js'
+export { default as TransformType } from './transform-type.js'
+
 export { default as InterfaceTypes } from './interface-types.js'
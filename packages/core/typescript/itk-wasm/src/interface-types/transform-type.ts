@@ -0,0 +1,11 @@
+import FloatTypes from './float-types.js'
+
+class TransformType {
+  constructor (
+    public readonly transformName: string = 'IdentityTransform',
+    public readonly parametersValueType: typeof FloatTypes[keyof typeof FloatTypes] = FloatTypes.Float64,
+    public readonly inputDimension: number = 3,
+    public readonly outputDimension: number = 3) {}
+}
+
+export default TransformType
@@ -0,0 +1,27 @@
+import TransformType from './transform-type.js'
+import TypedArray from '../typed-array.js'
+
+class Transform {
+  name: string = 'Transform'
+
+  numberOfFixedParameters: number
+  fixedParameters: Float64Array
+
+  // For a displacement field transform, the field pixel buffer
+  numberOfParameters: number
+  parameters: null | TypedArray
+
+  constructor (public readonly transformType = new TransformType()) {
+    this.transformType = transformType
+
+    this.name = 'Transform'
+
+    this.numberOfFixedParameters = 0
+    this.fixedParameters = new Float64Array()
+
+    this.numberOfParameters = 0
+    this.parameters = null
+  }
+}
+
+export default Transform
@@ -4,6 +4,7 @@ import { Option } from 'commander/esm.mjs'
 
 import build from './cli/build.js'
 import test from './cli/test.js'
+import benchmark from './cli/benchmark.js'
 import run from './cli/run.js'
 import bindgen from './cli/bindgen.js'
 import versionSync from './cli/version-sync.js'
@@ -16,7 +17,7 @@ async function main() {
   program
     .option('-i, --image <image>', 'build environment Docker image, defaults to itkwasm/emscripten -- another common image is itkwasm/wasi')
     .option('-s, --source-dir <source-directory>', 'path to source directory, defaults to "."')
-    .option('-b, --build-dir <build-directory>', 'build directory whose path is relative to the source directory, defaults to "wasi-build" for the "itkwasm/wasi" image and "emscripten-build" otherwise')
+    .option('-b, --build-dir <build-directory>', 'build directory whose path is relative to the source directory, defaults to "wasi-build" for the "itkwasm/wasi" image and "emscripten-build" otherwise, or e.g. "emscripten-threads-build" for the "-threads" and "-memory64" image tags')
 
   program
     .command('build')
@@ -31,6 +32,21 @@ async function main() {
     .description('Run the tests for the CMake project found in the build directory')
     .action(test)
 
+  program
+    .command('benchmark <pipeline>')
+    .requiredOption('-c, --corpus <corpus>', 'JSON input corpus, {"inputDir": ".", "cases": [{"name": "...", "args": [...]}]}. {input} and {output} in the args are replaced with the input directory, relative to the corpus, and a temporary output directory.')
+    .addOption(new Option('-r, --runtime <runtimes...>', 'runtimes to benchmark, defaults to all').choices(['native', 'wasi', 'emscripten']))
+    .option('-n, --trials <trials>', 'timed trials per case and runtime, defaults to 10')
+    .option('-w, --warmup <warmup>', 'untimed warmup trials per case and runtime, defaults to 1')
+    .option('--native-build-dir <native-build-dir>', 'native build directory, defaults to "native-build"')
+    .option('--wasi-build-dir <wasi-build-dir>', 'WASI build directory, defaults to "wasi-build"')
+    .option('--emscripten-build-dir <emscripten-build-dir>', 'Emscripten build directory, defaults to "emscripten-build"')
+    .option('--python <python>', 'Python interpreter with the itkwasm package to run WASI pipelines, defaults to "python3"')
+    .option('-o, --output <output>', 'JSON report of the trials and their percentiles')
+    .usage('[options] <pipeline>')
+    .description('time the pipeline, whose path is relative to each build directory, on an input corpus under the native, WASI, and Emscripten runtimes, with instantiate, run, and IO breakdowns from its --profile report')
+    .action(benchmark)
+
   program
     .command('run <wasmBinary>')
     .addOption(new Option('-r, --runtime <wasm-runtime>', 'wasm runtime to use for execution, defaults to "wasmtime"').choices(['wasmtime', 'wasmer', 'wasm3', 'wavm']))
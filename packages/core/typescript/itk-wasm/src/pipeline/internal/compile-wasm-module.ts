@@ -0,0 +1,69 @@
+// Compile WebAssembly binaries once per binary.
+//
+// Compiled modules are kept in memory by the SHA-256 hash of their binary.
+// The binaries are also persisted in the Cache API under their hash, and
+// compiled from there with WebAssembly.compileStreaming, so the browser
+// reuses its cached machine code for them on later page loads instead of
+// recompiling.
+
+const cacheName = 'itk-wasm-modules-v1'
+
+const hashToModule: Map<string, Promise<WebAssembly.Module>> = new Map()
+
+async function hashBinary (binary: ArrayBuffer): Promise<string> {
+  const digest = await crypto.subtle.digest('SHA-256', binary)
+  return Array.from(new Uint8Array(digest), (byte) => byte.toString(16).padStart(2, '0')).join('')
+}
+
+async function compileCached (hash: string, binary: ArrayBuffer): Promise<WebAssembly.Module> {
+  if (typeof caches !== 'undefined' && typeof WebAssembly.compileStreaming === 'function') {
+    try {
+      const key = new URL(`/itk-wasm-modules/${hash}.wasm`, globalThis.location.origin).href
+      const cache = await caches.open(cacheName)
+      let response = await cache.match(key)
+      if (response === undefined) {
+        await cache.put(key, new Response(binary, { headers: { 'Content-Type': 'application/wasm' } }))
+        response = await cache.match(key)
+      }
+      if (response !== undefined) {
+        return await WebAssembly.compileStreaming(response)
+      }
+    } catch (error) {
+      // The Cache API is not available, e.g. for opaque origins or when the
+      // storage quota is exceeded
+    }
+  }
+  return await WebAssembly.compile(binary)
+}
+
+async function compileWasmModule (binary: ArrayBuffer): Promise<WebAssembly.Module> {
+  let hash: string | null = null
+  try {
+    hash = await hashBinary(binary)
+  } catch (error) {
+    // crypto.subtle requires a secure context
+    return await WebAssembly.compile(binary)
+  }
+  let wasmModule = hashToModule.get(hash)
+  if (wasmModule === undefined) {
+    wasmModule = compileCached(hash, binary)
+    hashToModule.set(hash, wasmModule)
+    void wasmModule.catch(() => hashToModule.delete(hash as string))
+  }
+  return await wasmModule
+}
+
+// Emscripten module factory options that instantiate a compiled module
+// instead of compiling the wasmBinary
+export function instantiateWasmOptions (wasmModule: WebAssembly.Module): object {
+  return {
+    instantiateWasm: (imports: WebAssembly.Imports, successCallback: (instance: WebAssembly.Instance, module: WebAssembly.Module) => void) => {
+      void WebAssembly.instantiate(wasmModule, imports).then((instance) => {
+        successCallback(instance, wasmModule)
+      })
+      return {}
+    }
+  }
+}
+
+export default compileWasmModule
@@ -2,6 +2,9 @@ import axios from 'axios'
 
 import EmscriptenModule from '../itk-wasm-emscripten-module.js'
 import RunPipelineOptions from '../run-pipeline-options.js'
+import compileWasmModule, { instantiateWasmOptions } from './compile-wasm-module.js'
+import { loadPreferredVariant } from './threads-variant.js'
+import { isMemory64Prefix } from './memory64-variant.js'
 
 async function loadEmscriptenModuleMainThread (moduleRelativePathOrURL: string | URL, baseUrl?: string, queryParams?: RunPipelineOptions['pipelineQueryParams']): Promise<EmscriptenModule> {
   let modulePrefix: string = 'unknown'
@@ -18,13 +21,33 @@ async function loadEmscriptenModuleMainThread (moduleRelativePathOrURL: string |
   if (modulePrefix.endsWith('.wasm')) {
     modulePrefix = modulePrefix.substring(0, modulePrefix.length - 5)
   }
-  const wasmBinaryPath = `${modulePrefix}.wasm`
+  return await loadPreferredVariant(modulePrefix, async (prefix) => {
+    const wasmBinaryPath = `${prefix}.wasm`
+    const wasmModule = await compileStreamingOrFetch(wasmBinaryPath, queryParams)
+    const fullModulePath = `${prefix}.js`
+    const result = await import(/* webpackIgnore: true */ /* @vite-ignore */ fullModulePath)
+    const instantiated = result.default({ ...instantiateWasmOptions(wasmModule), memory64: isMemory64Prefix(prefix) }) as EmscriptenModule
+    instantiated.wasmModule = wasmModule
+    return instantiated
+  })
+}
+
+// Compile while the binary downloads when the server sends application/wasm
+async function compileStreamingOrFetch (wasmBinaryPath: string, queryParams?: RunPipelineOptions['pipelineQueryParams']): Promise<WebAssembly.Module> {
+  if (typeof WebAssembly.compileStreaming === 'function' && typeof fetch === 'function') {
+    const url = new URL(wasmBinaryPath, globalThis.location?.href)
+    Object.entries(queryParams ?? {}).forEach(([key, value]) => url.searchParams.set(key, value))
+    try {
+      const response = await fetch(url.href)
+      if (response.ok && response.headers.get('Content-Type')?.startsWith('application/wasm') === true) {
+        return await WebAssembly.compileStreaming(response)
+      }
+    } catch (error) {
+      // Fall back to fetching the binary
+    }
+  }
   const response = await axios.get(wasmBinaryPath, { responseType: 'arraybuffer', params: queryParams })
-  const wasmBinary = response.data
-  const fullModulePath = `${modulePrefix}.js`
-  const result = await import(/* webpackIgnore: true */ /* @vite-ignore */ fullModulePath)
-  const instantiated = result.default({ wasmBinary }) as EmscriptenModule
-  return instantiated
+  return await compileWasmModule(response.data)
 }
 
 export default loadEmscriptenModuleMainThread
@@ -1,6 +1,8 @@
 import fs from 'fs'
 import EmscriptenModule from '../itk-wasm-emscripten-module.js'
 import { pathToFileURL } from 'url'
+import { threadsVariantPrefix, threadsVariantSupported } from './threads-variant.js'
+import { isMemory64Prefix } from './memory64-variant.js'
 
 async function loadEmscriptenModuleNode (
   modulePath: string
@@ -12,13 +14,16 @@ async function loadEmscriptenModuleNode (
   if (modulePath.endsWith('.wasm')) {
     modulePrefix = modulePath.substring(0, modulePath.length - 5)
   }
+  if (!isMemory64Prefix(modulePrefix) && fs.existsSync(`${threadsVariantPrefix(modulePrefix)}.wasm`) && await threadsVariantSupported()) {
+    modulePrefix = threadsVariantPrefix(modulePrefix)
+  }
   const wasmBinaryPath = `${modulePrefix}.wasm`
   const wasmBinary = fs.readFileSync(wasmBinaryPath)
   const fullModulePath = pathToFileURL(`${modulePrefix}.js`).href
   const result = await import(
     /* webpackIgnore: true */ /* @vite-ignore */ fullModulePath
   )
-  const instantiated = result.default({ wasmBinary }) as EmscriptenModule
+  const instantiated = result.default({ wasmBinary, memory64: isMemory64Prefix(modulePrefix) }) as EmscriptenModule
   return instantiated
 }
 
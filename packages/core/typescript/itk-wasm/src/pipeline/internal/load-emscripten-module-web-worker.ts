@@ -4,6 +4,9 @@ import { ZSTDDecoder } from '@thewtex/zstddec'
 
 import ITKWasmEmscriptenModule from '../itk-wasm-emscripten-module.js'
 import RunPipelineOptions from '../run-pipeline-options.js'
+import compileWasmModule, { instantiateWasmOptions } from './compile-wasm-module.js'
+import { isThreadsModule, loadPreferredVariant, threadsVariantPrefix } from './threads-variant.js'
+import { isMemory64Prefix } from './memory64-variant.js'
 
 const decoder = new ZSTDDecoder()
 let decoderInitialized = false
@@ -12,7 +15,11 @@ let decoderInitialized = false
 //
 // baseUrl is usually taken from 'getPipelinesBaseUrl()', but a different value
 // could be passed.
-async function loadEmscriptenModuleWebWorker (moduleRelativePathOrURL: string | URL, baseUrl: string, queryParams?: RunPipelineOptions['pipelineQueryParams']): Promise<ITKWasmEmscriptenModule> {
+//
+// A wasmModule compiled by another worker is instantiated without fetching
+// the binary. Otherwise the binary is fetched and compiled once per binary,
+// preferring the threads variant when it is supported.
+async function loadEmscriptenModuleWebWorker (moduleRelativePathOrURL: string | URL, baseUrl: string, queryParams?: RunPipelineOptions['pipelineQueryParams'], wasmModule?: WebAssembly.Module): Promise<ITKWasmEmscriptenModule> {
   let modulePrefix = null
   if (typeof moduleRelativePathOrURL !== 'string') {
     modulePrefix = moduleRelativePathOrURL.href
@@ -27,17 +34,29 @@ async function loadEmscriptenModuleWebWorker (moduleRelativePathOrURL: string |
   if (modulePrefix.endsWith('.wasm')) {
     modulePrefix = modulePrefix.substring(0, modulePrefix.length - 5)
   }
-  const wasmBinaryPath = `${modulePrefix}.wasm`
-  const response = await axios.get(`${wasmBinaryPath}.zst`, { responseType: 'arraybuffer', params: queryParams })
-  if (!decoderInitialized) {
-    await decoder.init()
-    decoderInitialized = true
+  if (typeof wasmModule !== 'undefined') {
+    // The variant compiled by the other worker
+    const prefix = isThreadsModule(wasmModule) ? threadsVariantPrefix(modulePrefix) : modulePrefix
+    return await instantiate(prefix, wasmModule)
   }
-  const decompressedArray = decoder.decode(new Uint8Array(response.data))
-  const wasmBinary = decompressedArray.buffer
-  const modulePath = `${modulePrefix}.js`
+  return await loadPreferredVariant(modulePrefix, async (prefix) => {
+    const wasmBinaryPath = `${prefix}.wasm`
+    const response = await axios.get(`${wasmBinaryPath}.zst`, { responseType: 'arraybuffer', params: queryParams })
+    if (!decoderInitialized) {
+      await decoder.init()
+      decoderInitialized = true
+    }
+    const decompressedArray = decoder.decode(new Uint8Array(response.data))
+    const wasmBinary = decompressedArray.buffer
+    return await instantiate(prefix, await compileWasmModule(wasmBinary))
+  })
+}
+
+async function instantiate (prefix: string, wasmModule: WebAssembly.Module): Promise<ITKWasmEmscriptenModule> {
+  const modulePath = `${prefix}.js`
   const result = await import(/* webpackIgnore: true */ /* @vite-ignore */ modulePath)
-  const emscriptenModule = result.default({ wasmBinary }) as ITKWasmEmscriptenModule
+  const emscriptenModule = result.default({ ...instantiateWasmOptions(wasmModule), memory64: isMemory64Prefix(prefix) }) as ITKWasmEmscriptenModule
+  emscriptenModule.wasmModule = wasmModule
   return emscriptenModule
 }
 
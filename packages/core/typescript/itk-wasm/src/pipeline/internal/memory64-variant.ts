@@ -0,0 +1,89 @@
+import { memory64 } from 'wasm-feature-detect'
+
+import InterfaceTypes from '../../interface-types/interface-types.js'
+import BinaryStream from '../../interface-types/binary-stream.js'
+import BinaryFile from '../../interface-types/binary-file.js'
+import Image from '../../interface-types/image.js'
+import Mesh from '../../interface-types/mesh.js'
+import PolyData from '../../interface-types/poly-data.js'
+import Transform from '../../interface-types/transform.js'
+
+import PipelineInput from '../pipeline-input.js'
+import imageTransferables from './image-transferables.js'
+import meshTransferables from './mesh-transferables.js'
+import polyDataTransferables from './poly-data-transferables.js'
+import transformTransferables from './transform-transferables.js'
+
+// Pipelines built in the -memory64 build environment images are named
+// <pipeline>.memory64 and deployed next to the baseline build. wasm32 builds
+// address at most 4 GB, which must hold the inputs and the outputs, so runs
+// with more input bytes than this use the memory64 build when it is deployed
+// and WebAssembly memory64 is supported.
+export const memory64InputByteLength = 2 ** 31
+
+let memory64Supported: Promise<boolean> | null = null
+
+export async function memory64VariantSupported (): Promise<boolean> {
+  if (memory64Supported === null) {
+    memory64Supported = (async () => {
+      try {
+        return await memory64()
+      } catch (error) {
+        return false
+      }
+    })()
+  }
+  return await memory64Supported
+}
+
+export function memory64VariantPrefix (modulePrefix: string): string {
+  return `${modulePrefix}.memory64`
+}
+
+export function isMemory64Prefix (modulePrefix: string): boolean {
+  return modulePrefix.endsWith('.memory64')
+}
+
+export function inputByteLength (inputs: PipelineInput[] | null): number {
+  let byteLength = 0
+  inputs?.forEach((input) => {
+    let arrays: Array<{ byteLength: number } | null> = []
+    if (input.type === InterfaceTypes.BinaryStream) {
+      arrays = [(input.data as BinaryStream).data]
+    } else if (input.type === InterfaceTypes.BinaryFile) {
+      arrays = [(input.data as BinaryFile).data]
+    } else if (input.type === InterfaceTypes.Image) {
+      arrays = imageTransferables(input.data as Image)
+    } else if (input.type === InterfaceTypes.Mesh) {
+      arrays = meshTransferables(input.data as Mesh)
+    } else if (input.type === InterfaceTypes.PolyData) {
+      arrays = polyDataTransferables(input.data as PolyData)
+    } else if (input.type === InterfaceTypes.Transform) {
+      arrays = transformTransferables(input.data as Transform)
+    }
+    arrays.forEach((array) => { byteLength += array?.byteLength ?? 0 })
+  })
+  return byteLength
+}
+
+function stripModuleExtension (pipelinePath: string): string {
+  if (pipelinePath.endsWith('.js')) {
+    return pipelinePath.substring(0, pipelinePath.length - 3)
+  }
+  if (pipelinePath.endsWith('.wasm')) {
+    return pipelinePath.substring(0, pipelinePath.length - 5)
+  }
+  return pipelinePath
+}
+
+// The pipeline path to run the inputs with: the memory64 build for large
+// inputs when supported and deployed, otherwise the pipeline path.
+// variantDeployed is called with the memory64 module prefix.
+export async function selectMemory64Variant<T extends string | URL> (pipelinePath: T, inputs: PipelineInput[] | null, variantDeployed: (modulePrefix: string) => Promise<boolean>): Promise<string | T> {
+  const modulePrefix = stripModuleExtension(pipelinePath.toString())
+  if (isMemory64Prefix(modulePrefix) || inputByteLength(inputs) <= memory64InputByteLength || !await memory64VariantSupported()) {
+    return pipelinePath
+  }
+  const variantPrefix = memory64VariantPrefix(modulePrefix)
+  return await variantDeployed(variantPrefix) ? variantPrefix : pipelinePath
+}
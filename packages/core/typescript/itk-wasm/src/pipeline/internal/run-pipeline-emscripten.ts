@@ -8,6 +8,7 @@ import BinaryFile from '../../interface-types/binary-file.js'
 import Image from '../../interface-types/image.js'
 import Mesh from '../../interface-types/mesh.js'
 import PolyData from '../../interface-types/poly-data.js'
+import Transform from '../../interface-types/transform.js'
 import FloatTypes from '../../interface-types/float-types.js'
 import IntTypes from '../../interface-types/int-types.js'
 
@@ -50,10 +51,29 @@ function memoryUint8SharedArray (emscriptenModule: PipelineEmscriptenModule, byt
   return array
 }
 
+// size_t arguments of the memory IO exports, which are i64 in memory64 builds
+const sizeArguments: Record<string, number[]> = {
+  itk_wasm_input_array_alloc: [3],
+  itk_wasm_input_json_alloc: [2]
+}
+
+// Call a memory IO export. Its size_t arguments and result are BigInt in
+// memory64 builds.
+function memoryIOCall (emscriptenModule: PipelineEmscriptenModule, name: string, args: number[]): number {
+  const argTypes = args.map(() => 'number') as Emscripten.JSType[]
+  if (emscriptenModule.memory64 !== true) {
+    return emscriptenModule.ccall(name, 'number', argTypes, args)
+  }
+  const sizes = sizeArguments[name] ?? []
+  const wasmArgs = args.map((arg, index) => sizes.includes(index) ? BigInt(arg) : arg)
+  const result = emscriptenModule.ccall(name, 'number', argTypes, wasmArgs as unknown as number[]) as unknown
+  return Number(result)
+}
+
 function setPipelineModuleInputArray (emscriptenModule: PipelineEmscriptenModule, dataArray: TypedArray | null, inputIndex: number, subIndex: number): number {
   let dataPtr = 0
   if (dataArray !== null) {
-    dataPtr = emscriptenModule.ccall('itk_wasm_input_array_alloc', 'number', ['number', 'number', 'number', 'number'], [0, inputIndex, subIndex, dataArray.buffer.byteLength])
+    dataPtr = memoryIOCall(emscriptenModule, 'itk_wasm_input_array_alloc', [0, inputIndex, subIndex, dataArray.buffer.byteLength])
     emscriptenModule.HEAPU8.set(new Uint8Array(dataArray.buffer), dataPtr)
   }
   return dataPtr
@@ -62,20 +82,45 @@ function setPipelineModuleInputArray (emscriptenModule: PipelineEmscriptenModule
 function setPipelineModuleInputJSON (emscriptenModule: PipelineEmscriptenModule, dataObject: object, inputIndex: number): void {
   const dataJSON = JSON.stringify(dataObject)
   const length = emscriptenModule.lengthBytesUTF8(dataJSON) + 1
-  const jsonPtr = emscriptenModule.ccall('itk_wasm_input_json_alloc', 'number', ['number', 'number', 'number'], [0, inputIndex, length])
+  const jsonPtr = memoryIOCall(emscriptenModule, 'itk_wasm_input_json_alloc', [0, inputIndex, length])
   emscriptenModule.stringToUTF8(dataJSON, jsonPtr, length)
 }
 
-function getPipelineModuleOutputArray (emscriptenModule: PipelineEmscriptenModule, outputIndex: number, subIndex: number, componentType: typeof IntTypes[keyof typeof IntTypes] | typeof FloatTypes[keyof typeof FloatTypes]): TypedArray | Float32Array | Uint32Array | null {
-  const dataPtr = emscriptenModule.ccall('itk_wasm_output_array_address', 'number', ['number', 'number', 'number'], [0, outputIndex, subIndex])
-  const dataSize = emscriptenModule.ccall('itk_wasm_output_array_size', 'number', ['number', 'number', 'number'], [0, outputIndex, subIndex])
+// Copy an output array out of the module heap into the caller's destination
+// array, when it is large enough, rather than into a new buffer
+function memoryUint8Destination (emscriptenModule: PipelineEmscriptenModule, byteOffset: number, length: number, destination?: TypedArray | null): Uint8Array | null {
+  if (destination === undefined || destination === null || destination.byteLength < length) {
+    return null
+  }
+  const array = new Uint8Array(destination.buffer, destination.byteOffset, length)
+  array.set(new Uint8Array(emscriptenModule.HEAPU8.buffer, byteOffset, length))
+  return array
+}
+
+function getPipelineModuleOutputArray (emscriptenModule: PipelineEmscriptenModule, outputIndex: number, subIndex: number, componentType: typeof IntTypes[keyof typeof IntTypes] | typeof FloatTypes[keyof typeof FloatTypes], destination?: TypedArray | null): TypedArray | Float32Array | Uint32Array | null {
+  const dataPtr = memoryIOCall(emscriptenModule, 'itk_wasm_output_array_address', [0, outputIndex, subIndex])
+  const dataSize = memoryIOCall(emscriptenModule, 'itk_wasm_output_array_size', [0, outputIndex, subIndex])
+  if (memoryUint8Destination(emscriptenModule, dataPtr, dataSize, destination) !== null) {
+    const elementSize = (destination as TypedArray).BYTES_PER_ELEMENT
+    return (destination as TypedArray).subarray(0, dataSize / elementSize)
+  }
   const dataUint8 = memoryUint8SharedArray(emscriptenModule, dataPtr, dataSize)
   const data = bufferToTypedArray(componentType, dataUint8.buffer)
   return data
 }
 
+// Whether the pipeline set a data object output. Optional outputs, e.g. the
+// image of a run that only outputs information, are not set. Modules built
+// before the itk_wasm_output_exists export set every output.
+function pipelineModuleOutputExists (emscriptenModule: PipelineEmscriptenModule, outputIndex: number): boolean {
+  if (typeof emscriptenModule._itk_wasm_output_exists !== 'function') {
+    return true
+  }
+  return memoryIOCall(emscriptenModule, 'itk_wasm_output_exists', [0, outputIndex]) !== 0
+}
+
 function getPipelineModuleOutputJSON (emscriptenModule: PipelineEmscriptenModule, outputIndex: number): object {
-  const jsonPtr = emscriptenModule.ccall('itk_wasm_output_json_address', 'number', ['number', 'number'], [0, outputIndex])
+  const jsonPtr = memoryIOCall(emscriptenModule, 'itk_wasm_output_json_address', [0, outputIndex])
   const dataJSON = emscriptenModule.UTF8ToString(jsonPtr)
   const dataObject = JSON.parse(dataJSON)
   return dataObject
@@ -203,6 +248,24 @@ function runPipelineEmscripten (pipelineModule: PipelineEmscriptenModule, args:
           setPipelineModuleInputJSON(pipelineModule, polyDataJSON, index)
           break
         }
+        case InterfaceTypes.Transform:
+        {
+          const transform = input.data as Transform
+          const fixedParametersPtr = setPipelineModuleInputArray(pipelineModule, transform.fixedParameters, index, 0)
+          const parametersPtr = setPipelineModuleInputArray(pipelineModule, transform.parameters, index, 1)
+          const transformJSON = {
+            transformType: transform.transformType,
+            name: transform.name,
+
+            numberOfFixedParameters: transform.numberOfFixedParameters,
+            fixedParameters: `data:application/vnd.itk.address,0:${fixedParametersPtr}`,
+
+            numberOfParameters: transform.numberOfParameters,
+            parameters: `data:application/vnd.itk.address,0:${parametersPtr}`
+          }
+          setPipelineModuleInputJSON(pipelineModule, transformJSON, index)
+          break
+        }
         default:
           throw Error('Unsupported input InterfaceType')
       }
@@ -239,28 +302,35 @@ function runPipelineEmscripten (pipelineModule: PipelineEmscriptenModule, args:
   if (!(outputs == null) && outputs.length > 0 && returnValue === 0) {
     outputs.forEach(function (output, index) {
       let outputData: any = null
+      const dataObjectTypes: string[] = [InterfaceTypes.Image, InterfaceTypes.Mesh, InterfaceTypes.PolyData, InterfaceTypes.Transform]
+      if (dataObjectTypes.includes(output.type) && !pipelineModuleOutputExists(pipelineModule, index)) {
+        // An optional output that the pipeline did not set
+        populatedOutputs.push({ type: output.type, data: null })
+        return
+      }
       switch (output.type) {
         case InterfaceTypes.TextStream:
         {
-          const dataPtr = pipelineModule.ccall('itk_wasm_output_array_address', 'number', ['number', 'number', 'number'], [0, index, 0])
-          const dataSize = pipelineModule.ccall('itk_wasm_output_array_size', 'number', ['number', 'number', 'number'], [0, index, 0])
+          const dataPtr = memoryIOCall(pipelineModule, 'itk_wasm_output_array_address', [0, index, 0])
+          const dataSize = memoryIOCall(pipelineModule, 'itk_wasm_output_array_size', [0, index, 0])
           const dataArrayView = new Uint8Array(pipelineModule.HEAPU8.buffer, dataPtr, dataSize)
           outputData = { data: decoder.decode(dataArrayView) }
           break
         }
         case InterfaceTypes.JsonCompatible:
         {
-          const dataPtr = pipelineModule.ccall('itk_wasm_output_array_address', 'number', ['number', 'number', 'number'], [0, index, 0])
-          const dataSize = pipelineModule.ccall('itk_wasm_output_array_size', 'number', ['number', 'number', 'number'], [0, index, 0])
+          const dataPtr = memoryIOCall(pipelineModule, 'itk_wasm_output_array_address', [0, index, 0])
+          const dataSize = memoryIOCall(pipelineModule, 'itk_wasm_output_array_size', [0, index, 0])
           const dataArrayView = new Uint8Array(pipelineModule.HEAPU8.buffer, dataPtr, dataSize)
           outputData = JSON.parse(decoder.decode(dataArrayView))
           break
         }
         case InterfaceTypes.BinaryStream:
         {
-          const dataPtr = pipelineModule.ccall('itk_wasm_output_array_address', 'number', ['number', 'number', 'number'], [0, index, 0])
-          const dataSize = pipelineModule.ccall('itk_wasm_output_array_size', 'number', ['number', 'number', 'number'], [0, index, 0])
-          outputData = { data: memoryUint8SharedArray(pipelineModule, dataPtr, dataSize) }
+          const dataPtr = memoryIOCall(pipelineModule, 'itk_wasm_output_array_address', [0, index, 0])
+          const dataSize = memoryIOCall(pipelineModule, 'itk_wasm_output_array_size', [0, index, 0])
+          const destination = (output.data as BinaryStream | undefined)?.data
+          outputData = { data: memoryUint8Destination(pipelineModule, dataPtr, dataSize, destination) ?? memoryUint8SharedArray(pipelineModule, dataPtr, dataSize) }
           break
         }
         case InterfaceTypes.TextFile:
@@ -275,33 +345,35 @@ function runPipelineEmscripten (pipelineModule: PipelineEmscriptenModule, args:
         }
         case InterfaceTypes.Image:
         {
+          const destination = output.data as Image | undefined
           const image = getPipelineModuleOutputJSON(pipelineModule, index) as Image
-          image.data = getPipelineModuleOutputArray(pipelineModule, index, 0, image.imageType.componentType)
-          image.direction = getPipelineModuleOutputArray(pipelineModule, index, 1, FloatTypes.Float64) as Float64Array
+          image.data = getPipelineModuleOutputArray(pipelineModule, index, 0, image.imageType.componentType, destination?.data)
+          image.direction = getPipelineModuleOutputArray(pipelineModule, index, 1, FloatTypes.Float64, destination?.direction) as Float64Array
           image.metadata = new Map(image.metadata)
           outputData = image
           break
         }
         case InterfaceTypes.Mesh:
         {
+          const destination = output.data as Mesh | undefined
           const mesh = getPipelineModuleOutputJSON(pipelineModule, index) as Mesh
           if (mesh.numberOfPoints > 0) {
-            mesh.points = getPipelineModuleOutputArray(pipelineModule, index, 0, mesh.meshType.pointComponentType)
+            mesh.points = getPipelineModuleOutputArray(pipelineModule, index, 0, mesh.meshType.pointComponentType, destination?.points)
           } else {
             mesh.points = bufferToTypedArray(mesh.meshType.pointComponentType, new ArrayBuffer(0))
           }
           if (mesh.numberOfCells > 0) {
-            mesh.cells = getPipelineModuleOutputArray(pipelineModule, index, 1, mesh.meshType.cellComponentType)
+            mesh.cells = getPipelineModuleOutputArray(pipelineModule, index, 1, mesh.meshType.cellComponentType, destination?.cells)
           } else {
             mesh.cells = bufferToTypedArray(mesh.meshType.cellComponentType, new ArrayBuffer(0))
           }
           if (mesh.numberOfPointPixels > 0) {
-            mesh.pointData = getPipelineModuleOutputArray(pipelineModule, index, 2, mesh.meshType.pointPixelComponentType)
+            mesh.pointData = getPipelineModuleOutputArray(pipelineModule, index, 2, mesh.meshType.pointPixelComponentType, destination?.pointData)
           } else {
             mesh.pointData = bufferToTypedArray(mesh.meshType.pointPixelComponentType, new ArrayBuffer(0))
           }
           if (mesh.numberOfCellPixels > 0) {
-            mesh.cellData = getPipelineModuleOutputArray(pipelineModule, index, 3, mesh.meshType.cellPixelComponentType)
+            mesh.cellData = getPipelineModuleOutputArray(pipelineModule, index, 3, mesh.meshType.cellPixelComponentType, destination?.cellData)
           } else {
             mesh.cellData = bufferToTypedArray(mesh.meshType.cellPixelComponentType, new ArrayBuffer(0))
           }
@@ -310,45 +382,63 @@ function runPipelineEmscripten (pipelineModule: PipelineEmscriptenModule, args:
         }
         case InterfaceTypes.PolyData:
         {
+          const destination = output.data as PolyData | undefined
           const polyData = getPipelineModuleOutputJSON(pipelineModule, index) as PolyData
           if (polyData.numberOfPoints > 0) {
-            polyData.points = getPipelineModuleOutputArray(pipelineModule, index, 0, FloatTypes.Float32) as Float32Array
+            polyData.points = getPipelineModuleOutputArray(pipelineModule, index, 0, FloatTypes.Float32, destination?.points) as Float32Array
           } else {
             polyData.points = new Float32Array()
           }
           if (polyData.verticesBufferSize > 0) {
-            polyData.vertices = getPipelineModuleOutputArray(pipelineModule, index, 1, IntTypes.UInt32) as Uint32Array
+            polyData.vertices = getPipelineModuleOutputArray(pipelineModule, index, 1, IntTypes.UInt32, destination?.vertices) as Uint32Array
           } else {
             polyData.vertices = new Uint32Array()
           }
           if (polyData.linesBufferSize > 0) {
-            polyData.lines = getPipelineModuleOutputArray(pipelineModule, index, 2, IntTypes.UInt32) as Uint32Array
+            polyData.lines = getPipelineModuleOutputArray(pipelineModule, index, 2, IntTypes.UInt32, destination?.lines) as Uint32Array
           } else {
             polyData.lines = new Uint32Array()
           }
           if (polyData.polygonsBufferSize > 0) {
-            polyData.polygons = getPipelineModuleOutputArray(pipelineModule, index, 3, IntTypes.UInt32) as Uint32Array
+            polyData.polygons = getPipelineModuleOutputArray(pipelineModule, index, 3, IntTypes.UInt32, destination?.polygons) as Uint32Array
           } else {
             polyData.polygons = new Uint32Array()
           }
           if (polyData.triangleStripsBufferSize > 0) {
-            polyData.triangleStrips = getPipelineModuleOutputArray(pipelineModule, index, 4, IntTypes.UInt32) as Uint32Array
+            polyData.triangleStrips = getPipelineModuleOutputArray(pipelineModule, index, 4, IntTypes.UInt32, destination?.triangleStrips) as Uint32Array
           } else {
             polyData.triangleStrips = new Uint32Array()
           }
           if (polyData.numberOfPointPixels > 0) {
-            polyData.pointData = getPipelineModuleOutputArray(pipelineModule, index, 5, polyData.polyDataType.pointPixelComponentType)
+            polyData.pointData = getPipelineModuleOutputArray(pipelineModule, index, 5, polyData.polyDataType.pointPixelComponentType, destination?.pointData)
           } else {
             polyData.pointData = bufferToTypedArray(polyData.polyDataType.pointPixelComponentType, new ArrayBuffer(0))
           }
           if (polyData.numberOfCellPixels > 0) {
-            polyData.cellData = getPipelineModuleOutputArray(pipelineModule, index, 6, polyData.polyDataType.cellPixelComponentType)
+            polyData.cellData = getPipelineModuleOutputArray(pipelineModule, index, 6, polyData.polyDataType.cellPixelComponentType, destination?.cellData)
           } else {
             polyData.cellData = bufferToTypedArray(polyData.polyDataType.cellPixelComponentType, new ArrayBuffer(0))
           }
           outputData = polyData
           break
         }
+        case InterfaceTypes.Transform:
+        {
+          const destination = output.data as Transform | undefined
+          const transform = getPipelineModuleOutputJSON(pipelineModule, index) as Transform
+          if (transform.numberOfFixedParameters > 0) {
+            transform.fixedParameters = getPipelineModuleOutputArray(pipelineModule, index, 0, FloatTypes.Float64, destination?.fixedParameters) as Float64Array
+          } else {
+            transform.fixedParameters = new Float64Array()
+          }
+          if (transform.numberOfParameters > 0) {
+            transform.parameters = getPipelineModuleOutputArray(pipelineModule, index, 1, transform.transformType.parametersValueType, destination?.parameters)
+          } else {
+            transform.parameters = bufferToTypedArray(transform.transformType.parametersValueType, new ArrayBuffer(0))
+          }
+          outputData = transform
+          break
+        }
         default:
           throw Error('Unsupported output InterfaceType')
       }
@@ -360,6 +450,12 @@ function runPipelineEmscripten (pipelineModule: PipelineEmscriptenModule, args:
     })
   }
 
+  // Outputs have been copied out of the module heap. Release the memory io
+  // store so the cached module instance can be reused for the next run.
+  if (typeof pipelineModule._itk_wasm_free_all === 'function') {
+    pipelineModule._itk_wasm_free_all()
+  }
+
   return { returnValue, stdout, stderr, outputs: populatedOutputs }
 }
 
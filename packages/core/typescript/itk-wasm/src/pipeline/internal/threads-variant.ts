@@ -0,0 +1,54 @@
+import { threads } from 'wasm-feature-detect'
+
+import { isMemory64Prefix } from './memory64-variant.js'
+
+// Pipelines built in the -threads build environment images are named
+// <pipeline>.threads and deployed next to the baseline build. They are loaded
+// when the context can share memory with its pthread workers, i.e. it has
+// SharedArrayBuffer and is cross-origin isolated, and WebAssembly threads are
+// supported. Otherwise, or when the variant was not deployed, the baseline
+// build is loaded.
+
+let threadsSupported: Promise<boolean> | null = null
+
+export async function threadsVariantSupported (): Promise<boolean> {
+  if (threadsSupported === null) {
+    threadsSupported = (async () => {
+      if (typeof SharedArrayBuffer === 'undefined' || (globalThis as { crossOriginIsolated?: boolean }).crossOriginIsolated === false) {
+        return false
+      }
+      try {
+        return await threads()
+      } catch (error) {
+        return false
+      }
+    })()
+  }
+  return await threadsSupported
+}
+
+export function threadsVariantPrefix (modulePrefix: string): string {
+  return `${modulePrefix}.threads`
+}
+
+// Threads builds import their shared memory, baseline builds define it
+export function isThreadsModule (wasmModule: WebAssembly.Module): boolean {
+  return WebAssembly.Module.imports(wasmModule).some((moduleImport) => moduleImport.kind === 'memory')
+}
+
+// Prefixes whose threads variant was not deployed, so it is not requested again
+const missingVariants: Set<string> = new Set()
+
+// Load the threads variant when it is supported and deployed, otherwise the
+// baseline build
+export async function loadPreferredVariant<T> (modulePrefix: string, load: (prefix: string) => Promise<T>): Promise<T> {
+  // Memory64 builds are not also built with threads
+  if (!modulePrefix.endsWith('.threads') && !isMemory64Prefix(modulePrefix) && !missingVariants.has(modulePrefix) && await threadsVariantSupported()) {
+    try {
+      return await load(threadsVariantPrefix(modulePrefix))
+    } catch (error) {
+      missingVariants.add(modulePrefix)
+    }
+  }
+  return await load(modulePrefix)
+}
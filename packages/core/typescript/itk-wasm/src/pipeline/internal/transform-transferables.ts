@@ -0,0 +1,11 @@
+import Transform from '../../interface-types/transform.js'
+import TypedArray from '../../typed-array.js'
+
+function transformTransferables (transform: Transform): Array<ArrayBuffer | TypedArray | null> {
+  return [
+    transform.fixedParameters,
+    transform.parameters
+  ]
+}
+
+export default transformTransferables
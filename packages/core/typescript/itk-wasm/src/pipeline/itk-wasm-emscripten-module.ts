@@ -16,6 +16,14 @@ interface ItkWasmEmscriptenModule extends EmscriptenModule {
   fs_stat: (path: string) => { size: number }
   fs_close: (stream: object) => void
   fs_read: (stream: object, buffer: ArrayBufferView, offset: number, length: number, position?: number) => void
+
+  /** Compiled WebAssembly.Module, set by the browser loaders, that other web
+   * workers can instantiate without fetching and compiling the binary. */
+  wasmModule?: WebAssembly.Module
+
+  /** Whether the module is a memory64 build, whose memory IO exports take
+   * and return size_t values as BigInt. Set by the loaders. */
+  memory64?: boolean
 }
 
 export default ItkWasmEmscriptenModule
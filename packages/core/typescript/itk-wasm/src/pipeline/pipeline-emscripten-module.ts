@@ -25,6 +25,11 @@ interface PipelineEmscriptenModule extends EmscriptenModule {
   print: (text: string) => void
   printErr: (text: string) => void
 
+  // Memory io store release, present when the module links the
+  // WebAssemblyInterface memory io exports.
+  _itk_wasm_free_all?: () => void
+  _itk_wasm_output_exists?: (memoryIndex: number, index: number) => number
+
   // Note: Only available if the module was built with CMAKE_BUILD_TYPE set to
   // Debug. For example:
   //  itk-wasm-cli build my/project -- -DCMAKE_BUILD_TYPE:STRING=Debug
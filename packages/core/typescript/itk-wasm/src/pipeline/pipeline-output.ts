@@ -11,6 +11,11 @@ import JsonCompatible from '../interface-types/json-compatible.js'
 interface PipelineOutput {
   type:
   | (typeof InterfaceTypes)[keyof typeof InterfaceTypes]
+  /** Populated output data. When passed to a run, the typed arrays of a
+   * BinaryStream, Image, Mesh, or PolyData are destinations the output arrays
+   * are written into, when large enough, instead of newly allocated buffers.
+   * ArrayBuffer destinations are transferred to the web worker and back in
+   * the result; SharedArrayBuffer destinations are shared. */
   data?:
   | string
   | Uint8Array
@@ -1,7 +1,9 @@
+import fs from 'fs'
 import path from 'path'
 
 import loadEmscriptenModuleNode from './internal/load-emscripten-module-node.js'
 import runPipelineEmscripten from './internal/run-pipeline-emscripten.js'
+import { selectMemory64Variant } from './internal/memory64-variant.js'
 
 import PipelineEmscriptenModule from './pipeline-emscripten-module.js'
 import PipelineOutput from './pipeline-output.js'
@@ -46,6 +48,8 @@ async function runPipelineNode (
   inputs: PipelineInput[] | null,
   mountDirs?: Set<string>
 ): Promise<RunPipelineResult> {
+  // Inputs that do not fit in wasm32 memory run in the memory64 build
+  pipelinePath = await selectMemory64Variant(pipelinePath, inputs, async (modulePrefix) => fs.existsSync(`${modulePrefix}.wasm`))
   const Module = (await loadEmscriptenModuleNode(
     pipelinePath
   )) as PipelineEmscriptenModule
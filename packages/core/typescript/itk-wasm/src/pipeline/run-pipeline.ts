@@ -13,6 +13,7 @@ import BinaryFile from '../interface-types/binary-file.js'
 import Image from '../interface-types/image.js'
 import Mesh from '../interface-types/mesh.js'
 import PolyData from '../interface-types/poly-data.js'
+import Transform from '../interface-types/transform.js'
 
 import PipelineEmscriptenModule from './pipeline-emscripten-module.js'
 import PipelineOutput from './pipeline-output.js'
@@ -22,6 +23,8 @@ import RunPipelineOptions from './run-pipeline-options.js'
 import imageTransferables from './internal/image-transferables.js'
 import meshTransferables from './internal/mesh-transferables.js'
 import polyDataTransferables from './internal/poly-data-transferables.js'
+import transformTransferables from './internal/transform-transferables.js'
+import { selectMemory64Variant } from './internal/memory64-variant.js'
 import TypedArray from '../typed-array.js'
 import RunPipelineWorkerResult from './web-workers/run-pipeline-worker-result.js'
 import { getPipelinesBaseUrl } from './pipelines-base-url.js'
@@ -30,6 +33,21 @@ import { getPipelineWorkerUrl } from './pipeline-worker-url.js'
 
 // To cache loaded pipeline modules
 const pipelineToModule: Map<string, PipelineEmscriptenModule> = new Map()
+// Compiled modules of the pipelines run in web workers, shared with the
+// workers so each worker does not fetch and compile the binary
+const pipelineToWasmModule: Map<string, WebAssembly.Module> = new Map()
+
+// Whether a pipeline build is deployed, by module URL
+const deployedModules: Map<string, Promise<boolean>> = new Map()
+
+async function moduleDeployed (modulePrefix: string, pipelineBaseUrl: string, queryParams: RunPipelineOptions['pipelineQueryParams']): Promise<boolean> {
+  const url = new URL(modulePrefix.startsWith('http') ? `${modulePrefix}.wasm` : `${pipelineBaseUrl}/${modulePrefix}.wasm`, globalThis.location?.href)
+  Object.entries(queryParams ?? {}).forEach(([key, value]) => url.searchParams.set(key, value))
+  if (!deployedModules.has(url.href)) {
+    deployedModules.set(url.href, fetch(url.href, { method: 'HEAD' }).then((response) => response.ok, () => false))
+  }
+  return await (deployedModules.get(url.href) as Promise<boolean>)
+}
 
 function defaultPipelineWorkerUrl (): string | URL | null {
   let result = getPipelineWorkerUrl()
@@ -91,6 +109,10 @@ async function runPipeline (
     alert(simdErrorMessage)
     throw new Error(simdErrorMessage)
   }
+  // Inputs that do not fit in wasm32 memory run in the memory64 build
+  const pipelinesQueryParams = options?.pipelineQueryParams ?? defaultPipelinesQueryParams()
+  const deployedBaseUrl = (options?.pipelineBaseUrl ?? defaultPipelinesBaseUrl()).toString()
+  pipelinePath = await selectMemory64Variant(pipelinePath, inputs, async (modulePrefix) => await moduleDeployed(modulePrefix, deployedBaseUrl, pipelinesQueryParams))
   const webWorker = options?.webWorker ?? null
 
   if (webWorker === false) {
@@ -136,20 +158,49 @@ async function runPipeline (
         // PolyData data
         const polyData = input.data as PolyData
         transferables.push(...polyDataTransferables(polyData))
+      } else if (input.type === InterfaceTypes.Transform) {
+        transferables.push(...transformTransferables(input.data as Transform))
       }
     })
   }
   const pipelineBaseUrl = options?.pipelineBaseUrl ?? defaultPipelinesBaseUrl()
   const pipelineBaseUrlString = typeof pipelineBaseUrl !== 'string' && typeof pipelineBaseUrl?.href !== 'undefined' ? pipelineBaseUrl.href : pipelineBaseUrl
   const transferedInputs = (inputs != null) ? Comlink.transfer(inputs, getTransferables(transferables, options?.noCopy)) : null
+  // Move output destination arrays to the worker, which fills and transfers
+  // them back. SharedArrayBuffer destinations are shared.
+  const outputTransferables: Array<ArrayBuffer | TypedArray | null> = []
+  if (!(outputs == null) && outputs.length > 0) {
+    outputs.forEach(function (output) {
+      if (typeof output.data === 'undefined') {
+        return
+      }
+      if (output.type === InterfaceTypes.BinaryStream) {
+        outputTransferables.push((output.data as BinaryStream).data)
+      } else if (output.type === InterfaceTypes.Image) {
+        outputTransferables.push(...imageTransferables(output.data as Image))
+      } else if (output.type === InterfaceTypes.Mesh) {
+        outputTransferables.push(...meshTransferables(output.data as Mesh))
+      } else if (output.type === InterfaceTypes.PolyData) {
+        outputTransferables.push(...polyDataTransferables(output.data as PolyData))
+      } else if (output.type === InterfaceTypes.Transform) {
+        outputTransferables.push(...transformTransferables(output.data as Transform))
+      }
+    })
+  }
+  const transferedOutputs = (outputs != null) ? Comlink.transfer(outputs, getTransferables(outputTransferables, true)) : null
+  const wasmModuleKey = `${pipelineBaseUrlString as string}/${pipelinePath.toString()}`
   const result: RunPipelineWorkerResult = await workerProxy.runPipeline(
     pipelinePath.toString(),
     pipelineBaseUrlString as string,
     args,
-    outputs,
+    transferedOutputs,
     transferedInputs,
-    options?.pipelineQueryParams ?? defaultPipelinesQueryParams()
+    options?.pipelineQueryParams ?? defaultPipelinesQueryParams(),
+    pipelineToWasmModule.get(wasmModuleKey)
   )
+  if (typeof result.wasmModule !== 'undefined') {
+    pipelineToWasmModule.set(wasmModuleKey, result.wasmModule)
+  }
   return {
     returnValue: result.returnValue,
     stdout: result.stdout,
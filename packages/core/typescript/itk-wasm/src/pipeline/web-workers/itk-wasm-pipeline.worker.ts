@@ -8,9 +8,14 @@ import runPipeline from './run-pipeline.js'
 import RunPipelineOptions from '../run-pipeline-options.js'
 
 const workerOperations = {
-  runPipeline: async function (pipelinePath: string, pipelineBaseUrl: string, args: string[], outputs: PipelineOutput[] | null, inputs: PipelineInput[] | null, pipelineQueryParams?: RunPipelineOptions['pipelineQueryParams']): Promise<RunPipelineWorkerResult> {
-    const pipelineModule = await loadPipelineModule(pipelinePath, pipelineBaseUrl, pipelineQueryParams)
-    return await runPipeline(pipelineModule, args, outputs, inputs)
+  runPipeline: async function (pipelinePath: string, pipelineBaseUrl: string, args: string[], outputs: PipelineOutput[] | null, inputs: PipelineInput[] | null, pipelineQueryParams?: RunPipelineOptions['pipelineQueryParams'], wasmModule?: WebAssembly.Module): Promise<RunPipelineWorkerResult> {
+    const pipelineModule = await loadPipelineModule(pipelinePath, pipelineBaseUrl, pipelineQueryParams, wasmModule)
+    const result: RunPipelineWorkerResult = await runPipeline(pipelineModule, args, outputs, inputs)
+    if (typeof wasmModule === 'undefined') {
+      // Share the compiled module with the other workers
+      result.wasmModule = pipelineModule.wasmModule
+    }
+    return result
   }
 }
 
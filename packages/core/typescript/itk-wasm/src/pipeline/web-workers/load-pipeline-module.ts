@@ -5,7 +5,7 @@ import RunPipelineOptions from '../run-pipeline-options.js'
 // To cache loaded pipeline modules wrapped in a Promise
 const pipelineToModule: Map<string, Promise<PipelineEmscriptenModule>> = new Map()
 
-async function loadPipelineModule (pipelinePath: string | object, baseUrl: string, queryParams?: RunPipelineOptions['pipelineQueryParams']): Promise<PipelineEmscriptenModule> {
+async function loadPipelineModule (pipelinePath: string | object, baseUrl: string, queryParams?: RunPipelineOptions['pipelineQueryParams'], wasmModule?: WebAssembly.Module): Promise<PipelineEmscriptenModule> {
   let moduleRelativePathOrURL: string | URL = pipelinePath as string
   let pipeline = pipelinePath as string
   let pipelineModule = null
@@ -16,7 +16,7 @@ async function loadPipelineModule (pipelinePath: string | object, baseUrl: strin
   if (pipelineToModule.has(pipeline)) {
     pipelineModule = await pipelineToModule.get(pipeline) as PipelineEmscriptenModule
   } else {
-    pipelineToModule.set(pipeline, loadEmscriptenModule(moduleRelativePathOrURL, baseUrl, queryParams) as Promise<PipelineEmscriptenModule>)
+    pipelineToModule.set(pipeline, loadEmscriptenModule(moduleRelativePathOrURL, baseUrl, queryParams, wasmModule) as Promise<PipelineEmscriptenModule>)
     pipelineModule = await pipelineToModule.get(pipeline) as PipelineEmscriptenModule
   }
   return pipelineModule
@@ -4,6 +4,8 @@ interface RunPipelineWorkerResult {
   stdout: string
   stderr: string
   outputs: PipelineOutput[]
+  /** Compiled module of the pipeline, when the worker compiled it. */
+  wasmModule?: WebAssembly.Module
 }
 
 export default RunPipelineWorkerResult
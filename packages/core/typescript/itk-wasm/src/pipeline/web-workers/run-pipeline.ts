@@ -12,10 +12,12 @@ import InterfaceTypes from '../../interface-types/interface-types.js'
 import Image from '../../interface-types/image.js'
 import Mesh from '../../interface-types/mesh.js'
 import PolyData from '../../interface-types/poly-data.js'
+import Transform from '../../interface-types/transform.js'
 import TypedArray from '../../typed-array.js'
 import imageTransferables from '../internal/image-transferables.js'
 import meshTransferables from '../internal/mesh-transferables.js'
 import polyDataTransferables from '../internal/poly-data-transferables.js'
+import transformTransferables from '../internal/transform-transferables.js'
 
 async function runPipeline (pipelineModule: PipelineEmscriptenModule, args: string[], outputs: PipelineOutput[] | null, inputs: PipelineInput[] | null): Promise<RunPipelineResult> {
   const result = runPipelineEmscripten(pipelineModule, args, outputs, inputs)
@@ -36,6 +38,9 @@ async function runPipeline (pipelineModule: PipelineEmscriptenModule, args: stri
     } else if (output.type === InterfaceTypes.PolyData) {
       const polyData = output.data as PolyData
       transferables.push(...polyDataTransferables(polyData))
+    } else if (output.type === InterfaceTypes.Transform) {
+      const transform = output.data as Transform
+      transferables.push(...transformTransferables(transform))
     }
   })
 
@@ -4,7 +4,7 @@ import RunPipelineWorkerResult from './run-pipeline-worker-result.js'
 import RunPipelineOptions from '../run-pipeline-options.js'
 
 interface WorkerOperations {
-  runPipeline: (pipelinePath: string, pipelineBaseUrl: string, args: string[], outputs: PipelineOutput[] | null, inputs: PipelineInput[] | null, pipelineQueryParams?: RunPipelineOptions['pipelineQueryParams']) => RunPipelineWorkerResult
+  runPipeline: (pipelinePath: string, pipelineBaseUrl: string, args: string[], outputs: PipelineOutput[] | null, inputs: PipelineInput[] | null, pipelineQueryParams?: RunPipelineOptions['pipelineQueryParams'], wasmModule?: WebAssembly.Module) => RunPipelineWorkerResult
 }
 
 export default WorkerOperations
@@ -2,6 +2,7 @@
 
 export type { default as WorkerPoolFunctionResult } from './worker-pool-function-result.js'
 export type { default as WorkerPoolFunctionOption } from './worker-pool-function-option.js'
+export type { default as WorkerPoolOptions } from './worker-pool-options.js'
 
 export type { default as WorkerPoolProgressCallback } from './worker-pool-progress-callback.js'
 export type { default as WorkerPoolRunTasksResult } from './worker-pool-run-tasks-result.js'
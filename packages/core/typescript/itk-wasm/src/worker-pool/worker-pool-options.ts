@@ -0,0 +1,15 @@
+interface WorkerPoolOptions {
+  /** Key of the pipeline module that a task loads. Tasks are dispatched
+   * preferably to workers that already ran a task with the same key, so the
+   * module is warm. Defaults to the first task argument when it is a string
+   * or URL, e.g. the pipelinePath of runPipeline, and null otherwise. null
+   * keys have no affinity. */
+  affinity?: (taskArgs: any[]) => string | null
+
+  /** Called once for each key of a queued task that no worker has warm, to
+   * prefetch its module, e.g. fetch the pipeline binary, before a worker is
+   * free. */
+  prefetch?: (key: string) => void
+}
+
+export default WorkerPoolOptions
@@ -3,12 +3,18 @@
 import WorkerPoolProgressCallback from './worker-pool-progress-callback.js'
 import WorkerPoolRunTasksResult from './worker-pool-run-tasks-result.js'
 import WorkerPoolFunctionOption from './worker-pool-function-option.js'
+import WorkerPoolOptions from './worker-pool-options.js'
+
+interface QueuedTask {
+  resultIndex: number
+  taskArgs: any[]
+  key: string | null
+}
 
 interface RunInfo {
-  taskQueue: any[]
+  taskQueue: QueuedTask[]
   results: any[]
   addingTasks: boolean
-  postponed: boolean
   runningWorkers: number
   index: number
   completedTasks: number
@@ -18,6 +24,17 @@ interface RunInfo {
   reject?: (error: any) => void
 }
 
+function defaultAffinity (taskArgs: any[]): string | null {
+  const first = taskArgs[0]
+  if (typeof first === 'string') {
+    return first
+  }
+  if (first instanceof URL) {
+    return first.href
+  }
+  return null
+}
+
 class WorkerPool {
   fcn: Function
 
@@ -25,6 +42,16 @@ class WorkerPool {
 
   runInfo: RunInfo[]
 
+  private readonly affinity: (taskArgs: any[]) => string | null
+
+  private readonly prefetch: ((key: string) => void) | null
+
+  // Keys of the pipeline modules each worker has warm
+  private readonly workerKeys: WeakMap<Worker, Set<string>> = new WeakMap()
+
+  // Keys warm on any worker or already prefetched
+  private readonly knownKeys: Set<string> = new Set()
+
   /*
    * poolSize is the maximum number of web workers to create in the pool.
    *
@@ -34,9 +61,15 @@ class WorkerPool {
    * with the results of the computation and the used worker in the `webWorker`
    * property.
    *
+   * Tasks are dispatched preferably to a worker that has the task's pipeline
+   * module warm, see WorkerPoolOptions. A free worker takes a queued task of
+   * any run, so idle workers steal the tasks queued for other runs.
+   *
    **/
-  constructor (poolSize: number, fcn: Function) {
+  constructor (poolSize: number, fcn: Function, options?: WorkerPoolOptions) {
     this.fcn = fcn
+    this.affinity = options?.affinity ?? defaultAffinity
+    this.prefetch = options?.prefetch ?? null
 
     this.workerQueue = new Array(poolSize)
     this.workerQueue.fill(null)
@@ -61,7 +94,6 @@ class WorkerPool {
       taskQueue: [],
       results: [],
       addingTasks: false,
-      postponed: false,
       runningWorkers: 0,
       index: 0,
       completedTasks: 0,
@@ -96,6 +128,7 @@ class WorkerPool {
       }
       this.workerQueue[index] = null
     }
+    this.knownKeys.clear()
   }
 
   public cancel (runId: number): void {
@@ -114,50 +147,104 @@ class WorkerPool {
       return
     }
 
+    const task: QueuedTask = { resultIndex, taskArgs, key: this.affinity(taskArgs) }
     if (this.workerQueue.length > 0) {
-      const worker = this.workerQueue.pop() as Worker | null
-      info.runningWorkers++
-      taskArgs[taskArgs.length - 1].webWorker = worker as Worker
-      // @ts-expect-error: TS7031: Binding element 'webWorker' implicitly has an 'any' type.
-      this.fcn(...taskArgs).then(({ webWorker, ...result }) => {
-        this.workerQueue.push(webWorker)
-        // Check if this task was canceled while it was getting done
-        if (this.runInfo[infoIndex] !== null) {
-          info.runningWorkers--
-          info.results[resultIndex] = result
-          info.completedTasks++
-          if (info.progressCallback != null) {
-            info.progressCallback(info.completedTasks, info.results.length)
-          }
-
-          if (info.taskQueue.length > 0) {
-            const reTask = info.taskQueue.shift() as any[]
-            this.addTask(infoIndex, reTask[0], reTask[1])
-          } else if (!info.addingTasks && info.runningWorkers === 0) {
-            const results = info.results
-            info.resolve!(results)
-            this.clearTask(info.index)
-          }
-        }
-      // @ts-expect-error: TS7006: Parameter 'error' implicitly has an 'any' type.
-      }).catch((error) => {
-        info.reject!(error)
-        this.clearTask(info.index)
-      })
+      this.runTask(info, task, this.takeIdleWorker(task.key))
     } else {
-      if (info.runningWorkers !== 0 || info.postponed) {
-        // At least one worker is working on these tasks, and it will pick up
-        // the next item in the taskQueue when done.
-        info.taskQueue.push([resultIndex, taskArgs])
-      } else {
-        // Try again later.
-        info.postponed = true
-        setTimeout(() => {
-          info.postponed = false
-          this.addTask(info.index, resultIndex, taskArgs)
-        }, 50)
+      // A worker picks up the task when it is done with its current task
+      info.taskQueue.push(task)
+      if (task.key !== null && this.prefetch !== null && !this.knownKeys.has(task.key)) {
+        this.knownKeys.add(task.key)
+        this.prefetch(task.key)
+      }
+    }
+  }
+
+  private isWarm (worker: Worker | null, key: string | null): boolean {
+    return worker != null && key !== null && this.workerKeys.get(worker)?.has(key) === true
+  }
+
+  // An idle worker with the key warm, otherwise an idle worker that was
+  // already created, otherwise a slot for a new worker
+  private takeIdleWorker (key: string | null): Worker | null {
+    let index = this.workerQueue.findIndex((worker) => this.isWarm(worker, key))
+    if (index === -1) {
+      index = this.workerQueue.length - 1
+      while (index > 0 && this.workerQueue[index] == null) {
+        index--
       }
     }
+    return this.workerQueue.splice(index, 1)[0]
+  }
+
+  // The next queued task for a free worker: one of any run with its module
+  // warm on the worker, otherwise the first task of the oldest run
+  private takeQueuedTask (worker: Worker | null): [RunInfo, QueuedTask] | null {
+    let fallback: RunInfo | null = null
+    for (const info of this.runInfo) {
+      if (info.taskQueue.length === 0) {
+        continue
+      }
+      if (info.canceled === true) {
+        info.reject!('Remaining tasks canceled')
+        this.clearTask(info.index)
+        continue
+      }
+      const warmIndex = info.taskQueue.findIndex((task) => this.isWarm(worker, task.key))
+      if (warmIndex !== -1) {
+        return [info, info.taskQueue.splice(warmIndex, 1)[0]]
+      }
+      fallback = fallback ?? info
+    }
+    if (fallback !== null) {
+      return [fallback, fallback.taskQueue.shift() as QueuedTask]
+    }
+    return null
+  }
+
+  private workerDone (worker: Worker | null): void {
+    const next = this.takeQueuedTask(worker)
+    if (next !== null) {
+      this.runTask(next[0], next[1], worker)
+    } else {
+      this.workerQueue.push(worker)
+    }
+  }
+
+  private runTask (info: RunInfo, task: QueuedTask, worker: Worker | null): void {
+    const taskArgs = task.taskArgs
+    info.runningWorkers++
+    taskArgs[taskArgs.length - 1].webWorker = worker as Worker
+    // @ts-expect-error: TS7031: Binding element 'webWorker' implicitly has an 'any' type.
+    this.fcn(...taskArgs).then(({ webWorker, ...result }) => {
+      if (task.key !== null && webWorker != null) {
+        let keys = this.workerKeys.get(webWorker)
+        if (keys === undefined) {
+          keys = new Set()
+          this.workerKeys.set(webWorker, keys)
+        }
+        keys.add(task.key)
+        this.knownKeys.add(task.key)
+      }
+      info.runningWorkers--
+      info.results[task.resultIndex] = result
+      info.completedTasks++
+      if (info.progressCallback != null) {
+        info.progressCallback(info.completedTasks, info.results.length)
+      }
+      if (!info.addingTasks && info.runningWorkers === 0 && info.taskQueue.length === 0) {
+        const results = info.results
+        info.resolve!(results)
+        this.clearTask(info.index)
+      }
+      this.workerDone(webWorker)
+    // @ts-expect-error: TS7006: Parameter 'error' implicitly has an 'any' type.
+    }).catch((error) => {
+      info.reject!(error)
+      this.clearTask(info.index)
+      // The worker may be unusable, so its slot gets a new worker
+      this.workerDone(null)
+    })
   }
 
   private clearTask (clearIndex: number): void {
@@ -133,6 +133,27 @@ test('runPipelineNode writes and reads an itk.Image via memory io', async (t) =>
   verifyImage(outputs[0].data)
 })
 
+test('runPipelineNode writes an itk.Image output into a caller-owned buffer', async (t) => {
+  const image = readCthead1()
+  const pipelinePath = path.resolve('test', 'pipelines', 'emscripten-build', 'median-filter-pipeline', 'median-filter-test')
+  const args = [
+    '0',
+    '0',
+    '--radius', '4', '--memory-io']
+  const destination = new Uint8Array(new SharedArrayBuffer(65536 + 16))
+  const desiredOutputs = [
+    { type: InterfaceTypes.Image, data: { data: destination } }
+  ]
+  const inputs = [
+    { type: InterfaceTypes.Image, data: image }
+  ]
+  const { outputs } = await runPipelineNode(pipelinePath, args, desiredOutputs, inputs)
+  const outputImage = outputs[0].data
+  t.is(outputImage.data.buffer, destination.buffer, 'written into the destination')
+  t.is(outputImage.data.byteLength, 65536, 'data.byteLength')
+  t.is(outputImage.size[0], 256, 'size[0]')
+})
+
 test('runPipelineNode writes and reads an itk.Mesh via memory io', async (t) => {
   const verifyMesh = (mesh) => {
     t.is(mesh.meshType.dimension, 3)
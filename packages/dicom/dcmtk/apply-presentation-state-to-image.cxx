@@ -73,7 +73,7 @@
  *    the form of a JSON string.
  */
 
-#include "itkImportImageFilter.h"
+#include "itkImage.h"
 #include "itkOutputImage.h"
 #include "itkOutputTextStream.h"
 #include "itkPipeline.h"
@@ -129,7 +129,194 @@ void safeSetString(Value &v, const char *s, Document::AllocatorType& alloc)
   }
 }
 
-static void dumpPresentationState(STD_NAMESPACE ostream &out, DVPresentationState &ps, const char *pstName = NULL)
+/** Add the LUTDescriptor and the base64 encoded LUTData of a LUT item.
+ *  LUTData holds the raw little endian 16-bit words, so 8-bit tables have two
+ *  entries per word. The number of entries, 0 in the DICOM LUTDescriptor for
+ *  65536, is resolved. */
+static bool addLUTTable(Value &lut, DcmItem &item, Document::AllocatorType& alloc)
+{
+  Uint16 numberOfEntries = 0;
+  Uint16 bitsPerEntry = 0;
+  Sint32 firstMappedValue = 0;
+  Uint16 unsignedFirstMappedValue = 0;
+  Sint16 signedFirstMappedValue = 0;
+  if (item.findAndGetUint16(DCM_LUTDescriptor, numberOfEntries, 0).bad() ||
+      item.findAndGetUint16(DCM_LUTDescriptor, bitsPerEntry, 2).bad())
+  {
+    return false;
+  }
+  // The first mapped value is signed when the pixel representation is
+  if (item.findAndGetUint16(DCM_LUTDescriptor, unsignedFirstMappedValue, 1).good())
+  {
+    firstMappedValue = unsignedFirstMappedValue;
+  }
+  else if (item.findAndGetSint16(DCM_LUTDescriptor, signedFirstMappedValue, 1).good())
+  {
+    firstMappedValue = signedFirstMappedValue;
+  }
+  const Uint16 *lutData = NULL;
+  unsigned long lutDataCount = 0;
+  if (item.findAndGetUint16Array(DCM_LUTData, lutData, &lutDataCount).bad() || lutDataCount == 0)
+  {
+    return false;
+  }
+
+  Value descriptor(kArrayType);
+  descriptor.PushBack(Value(numberOfEntries == 0 ? 65536u : static_cast<uint32_t>(numberOfEntries)), alloc);
+  descriptor.PushBack(Value(firstMappedValue), alloc);
+  descriptor.PushBack(Value(static_cast<uint32_t>(bitsPerEntry)), alloc);
+  lut.AddMember("LUTDescriptor", descriptor, alloc);
+  OFString explanation;
+  if (item.findAndGetOFString(DCM_LUTExplanation, explanation).good())
+  {
+    lut.AddMember("LUTExplanation", Value(explanation.c_str(), alloc), alloc);
+  }
+  constexpr bool urlFriendly = false;
+  lut.AddMember("LUTData", Value(base64_encode(reinterpret_cast<const unsigned char *>(lutData), lutDataCount * sizeof(Uint16), urlFriendly).c_str(), alloc), alloc);
+  return true;
+}
+
+/** The item of a presentation state sequence, e.g. SoftcopyVOILUTSequence,
+ *  that applies to the frame of an image. Items without a
+ *  ReferencedImageSequence apply to all images, references without a
+ *  ReferencedFrameNumber to all frames. */
+static DcmItem *findReferencingItem(DcmItem &dataset, const DcmTagKey &sequenceTag, const OFString &sopInstanceUID, Sint32 frame)
+{
+  DcmSequenceOfItems *sequence = NULL;
+  if (dataset.findAndGetSequence(sequenceTag, sequence).bad() || sequence == NULL)
+  {
+    return NULL;
+  }
+  for (unsigned long itemIndex = 0; itemIndex < sequence->card(); ++itemIndex)
+  {
+    DcmItem *item = sequence->getItem(itemIndex);
+    DcmSequenceOfItems *references = NULL;
+    if (item->findAndGetSequence(DCM_ReferencedImageSequence, references).bad() || references == NULL || references->card() == 0)
+    {
+      return item;
+    }
+    for (unsigned long referenceIndex = 0; referenceIndex < references->card(); ++referenceIndex)
+    {
+      DcmItem *reference = references->getItem(referenceIndex);
+      OFString referencedSOPInstanceUID;
+      if (reference->findAndGetOFString(DCM_ReferencedSOPInstanceUID, referencedSOPInstanceUID).bad() || referencedSOPInstanceUID != sopInstanceUID)
+      {
+        continue;
+      }
+      Sint32 referencedFrame = 0;
+      if (reference->findAndGetSint32(DCM_ReferencedFrameNumber, referencedFrame, 0).bad())
+      {
+        return item;
+      }
+      for (unsigned long frameIndex = 0; reference->findAndGetSint32(DCM_ReferencedFrameNumber, referencedFrame, frameIndex).good(); ++frameIndex)
+      {
+        if (referencedFrame == frame)
+        {
+          return item;
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
+/** The modality, VOI, and presentation LUTs that the presentation state
+ *  applies to the stored pixel values of the current frame, in that order, for
+ *  a client to render the raw pixels itself, e.g. on the GPU. */
+static Value dumpLUTChain(DVPresentationState &ps, DcmItem &pstateDataset, DcmItem &imageDataset, Sint32 frame, Document::AllocatorType& alloc)
+{
+  Value lutChain(kObjectType);
+  lutChain.AddMember("Frame", Value(frame), alloc);
+
+  Uint16 bitsStored = 0;
+  imageDataset.findAndGetUint16(DCM_BitsStored, bitsStored);
+  lutChain.AddMember("BitsStored", Value(bitsStored), alloc);
+  Uint16 pixelRepresentation = 0;
+  imageDataset.findAndGetUint16(DCM_PixelRepresentation, pixelRepresentation);
+  lutChain.AddMember("PixelRepresentation", Value(pixelRepresentation), alloc);
+  OFString photometricInterpretation;
+  imageDataset.findAndGetOFString(DCM_PhotometricInterpretation, photometricInterpretation);
+  lutChain.AddMember("PhotometricInterpretation", Value(photometricInterpretation.c_str(), alloc), alloc);
+
+  // Modality LUT: the presentation state, when it has one, replaces that of the image
+  Value modalityLUT(kObjectType);
+  DcmItem *modalityDataset = &imageDataset;
+  if (pstateDataset.tagExists(DCM_RescaleSlope) || pstateDataset.tagExists(DCM_ModalityLUTSequence))
+  {
+    modalityDataset = &pstateDataset;
+  }
+  DcmItem *modalityLUTItem = NULL;
+  Float64 rescaleSlope = 1.0;
+  Float64 rescaleIntercept = 0.0;
+  OFString rescaleType;
+  if (modalityDataset->findAndGetSequenceItem(DCM_ModalityLUTSequence, modalityLUTItem, 0).good() && modalityLUTItem != NULL &&
+      addLUTTable(modalityLUT, *modalityLUTItem, alloc))
+  {
+    modalityLUTItem->findAndGetOFString(DCM_ModalityLUTType, rescaleType);
+  }
+  else
+  {
+    modalityDataset->findAndGetFloat64(DCM_RescaleSlope, rescaleSlope);
+    modalityDataset->findAndGetFloat64(DCM_RescaleIntercept, rescaleIntercept);
+    modalityDataset->findAndGetOFString(DCM_RescaleType, rescaleType);
+    modalityLUT.AddMember("RescaleSlope", Value(rescaleSlope), alloc);
+    modalityLUT.AddMember("RescaleIntercept", Value(rescaleIntercept), alloc);
+  }
+  if (!rescaleType.empty())
+  {
+    modalityLUT.AddMember("RescaleType", Value(rescaleType.c_str(), alloc), alloc);
+  }
+  lutChain.AddMember("ModalityLUT", modalityLUT, alloc);
+
+  // VOI LUT: the window resolved by the presentation state, or its table
+  OFString sopInstanceUID;
+  imageDataset.findAndGetOFString(DCM_SOPInstanceUID, sopInstanceUID);
+  DcmItem *softcopyVOILUTItem = findReferencingItem(pstateDataset, DCM_SoftcopyVOILUTSequence, sopInstanceUID, frame);
+  Value voiLUT(kObjectType);
+  if (ps.haveActiveVOIWindow())
+  {
+    double width=0.0, center=0.0;
+    ps.getCurrentWindowWidth(width);
+    ps.getCurrentWindowCenter(center);
+    voiLUT.AddMember("WindowCenter", Value(center), alloc);
+    voiLUT.AddMember("WindowWidth", Value(width), alloc);
+    OFString voiLUTFunction("LINEAR");
+    if (softcopyVOILUTItem != NULL)
+    {
+      softcopyVOILUTItem->findAndGetOFString(DCM_VOILUTFunction, voiLUTFunction);
+    }
+    voiLUT.AddMember("VOILUTFunction", Value(voiLUTFunction.c_str(), alloc), alloc);
+  }
+  else if (ps.haveActiveVOILUT())
+  {
+    DcmItem *voiLUTItem = NULL;
+    if (softcopyVOILUTItem == NULL || softcopyVOILUTItem->findAndGetSequenceItem(DCM_VOILUTSequence, voiLUTItem, 0).bad() ||
+        voiLUTItem == NULL || !addLUTTable(voiLUT, *voiLUTItem, alloc))
+    {
+      OFLOG_ERROR(appLogger, "unable to access VOI LUT data!");
+    }
+  }
+  lutChain.AddMember("VOILUT", voiLUT, alloc);
+
+  // Presentation LUT: a shape or a table
+  Value presentationLUT(kObjectType);
+  DcmItem *presentationLUTItem = NULL;
+  if (pstateDataset.findAndGetSequenceItem(DCM_PresentationLUTSequence, presentationLUTItem, 0).bad() || presentationLUTItem == NULL ||
+      !addLUTTable(presentationLUT, *presentationLUTItem, alloc))
+  {
+    OFString presentationLUTShape;
+    if (pstateDataset.findAndGetOFString(DCM_PresentationLUTShape, presentationLUTShape).bad() || presentationLUTShape.empty())
+    {
+      presentationLUTShape = photometricInterpretation == "MONOCHROME1" ? "INVERSE" : "IDENTITY";
+    }
+    presentationLUT.AddMember("PresentationLUTShape", Value(presentationLUTShape.c_str(), alloc), alloc);
+  }
+  lutChain.AddMember("PresentationLUT", presentationLUT, alloc);
+
+  return lutChain;
+}
+
+static void dumpPresentationState(STD_NAMESPACE ostream &out, DVPresentationState &ps, const char *pstName = NULL, const char *imgName = NULL, Sint32 frame = 1)
 {
   size_t i, j, max;
 
@@ -526,6 +713,19 @@ static void dumpPresentationState(STD_NAMESPACE ostream &out, DVPresentationStat
   }
   doc.AddMember("GraphicsLayers", graphicsLayersJsonArray, alloc); // GraphicsLayers[]
 
+  // LUT chain of the frame, when requested instead of the rendered bitmap
+  if (imgName)
+  {
+    DcmFileFormat pstateFF;
+    DcmFileFormat imgFF;
+    if (pstateFF.loadFile(pstName).good() && imgFF.loadFile(imgName).good())
+    {
+      doc.AddMember("LUTChain", dumpLUTChain(ps, *pstateFF.getDataset(), *imgFF.getDataset(), frame, alloc), alloc);
+    } else {
+      OFLOG_ERROR(appLogger, "unable to access LUT data!");
+    }
+  }
+
   // Pretty print the json into output stream.
   StringBuffer buffer;
   PrettyWriter<StringBuffer> writer(buffer);
@@ -542,32 +742,31 @@ using ColorPixelType = itk::RGBPixel<uint8_t>;
 using ColorImageType = itk::Image<ColorPixelType, Dimension>;
 using OutputColorImageType = itk::wasm::OutputImage<ColorImageType>;
 
+// The rendered frame is owned by the presentation state and freed with it,
+// before the output image is serialized, so it is copied once into the
+// pixel container of the output image. Serialization then references that
+// container without another copy.
 template<typename OutputImageType, typename PixelType, unsigned int Dim>
 int GenerateOutputImage(typename OutputImageType::Pointer & outputImage, const unsigned long width, const unsigned long height, const std::array<double, 2>& pixelSpacing, const void* pixelData)
 {
-  using ImportFilterType = itk::ImportImageFilter<PixelType, Dim>;
-  auto importFilter = itk::ImportImageFilter<PixelType, Dim>::New();
-  typename ImportFilterType::SizeType size;
+  typename OutputImageType::SizeType size;
   size[0] = width;
   size[1] = height;
 
-  typename itk::ImportImageFilter<PixelType, Dim>::IndexType start;
+  typename OutputImageType::IndexType start;
   start.Fill(0);
 
-  typename itk::ImportImageFilter<PixelType, Dim>::RegionType region;
+  typename OutputImageType::RegionType region;
   region.SetIndex(start);
   region.SetSize(size);
-  importFilter->SetRegion(region);
 
-  const itk::SpacePrecisionType origin[Dim] = { 0.0, 0.0 };
-  importFilter->SetOrigin(origin);
+  outputImage = OutputImageType::New();
+  outputImage->SetRegions(region);
   const itk::SpacePrecisionType spacing[Dim] = { pixelSpacing[0], pixelSpacing[1] };
-  importFilter->SetSpacing(spacing);
-  const unsigned int numberOfPixels = size[0] * size[1];
-  // ColorImageType::Internal
-  importFilter->SetImportPointer((PixelType*)pixelData, numberOfPixels, false);
-  importFilter->Update();
-  outputImage = importFilter->GetOutput();
+  outputImage->SetSpacing(spacing);
+  outputImage->Allocate();
+  const size_t numberOfPixels = region.GetNumberOfPixels();
+  std::memcpy(outputImage->GetBufferPointer(), pixelData, numberOfPixels * sizeof(PixelType));
   return EXIT_SUCCESS;
 }
 
@@ -609,6 +808,8 @@ int main(int argc, char *argv[])
   pipeline.add_flag("--no-presentation-state-output", noPstateOutput, "Do not get presentation state information in text stream.");
   bool noBitmapOutput{false};
   pipeline.add_flag("--no-bitmap-output", noBitmapOutput, "Do not get resulting image as bitmap output stream.");
+  bool lutOutput{false};
+  pipeline.add_flag("--lut-output", lutOutput, "Output the modality, VOI, and presentation LUTs of the frame in the presentation state information as LUTChain instead of the bitmap, to render the raw pixels on the client.");
 
   // Define output image and bind to CLI option
   OutputGrayImageType outputGrayImage;
@@ -644,6 +845,15 @@ int main(int argc, char *argv[])
   {
     OFLOG_FATAL(appLogger, "No output form requested. Do not specify both --no-presentation-state-output and --no-bitmap-output.");
   }
+  if (lutOutput)
+  {
+    if (noPstateOutput)
+    {
+      OFLOG_FATAL(appLogger, "The LUTs are output in the presentation state information. Do not specify both --lut-output and --no-presentation-state-output.");
+      return 10;
+    }
+    noBitmapOutput = true;
+  }
 
   if(!pstateFile.empty()) opt_pstName = pstateFile.c_str();
   if(!configFile.empty()) opt_cfgName = configFile.c_str();
@@ -682,7 +892,14 @@ int main(int argc, char *argv[])
 
   if (status == EC_Normal)
   {
-    if (!noPstateOutput) dumpPresentationState(pstateOutStream.Get(), dvi.getCurrentPState(), opt_pstName);
+    if (lutOutput)
+    {
+      // The VOI of the presentation state is resolved for the selected frame
+      if ((opt_frame > 0) && (dvi.getCurrentPState().selectImageFrameNumber(opt_frame) != EC_Normal))
+        OFLOG_ERROR(appLogger, "cannot select frame " << opt_frame);
+      dumpPresentationState(pstateOutStream.Get(), dvi.getCurrentPState(), opt_pstName, opt_imgName, static_cast<Sint32>(opt_frame));
+    }
+    else if (!noPstateOutput) dumpPresentationState(pstateOutStream.Get(), dvi.getCurrentPState(), opt_pstName);
     if (!noBitmapOutput)
     {
       unsigned long width = 0;
@@ -38,6 +38,8 @@
 #include "itkPipeline.h"
 #include "itkOutputBinaryStream.h"
 
+#include <memory>
+
 #include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
 
 BEGIN_EXTERN_C
@@ -188,12 +190,13 @@ int main(int argc, char *argv[])
     return 1;
   }
 
-  DcmFileFormat fileformat;
-  DcmDataset * dataset = fileformat.getDataset();
+  // Shared with the output, which references the element's value in place
+  auto fileformat = std::make_shared<DcmFileFormat>();
+  DcmDataset * dataset = fileformat->getDataset();
 
   OFLOG_DEBUG(dcm2pdfLogger, "open input file " << opt_ifname);
 
-  OFCondition error = fileformat.loadFile(opt_ifname, opt_ixfer, EGL_noChange, DCM_MaxReadLength, opt_readMode);
+  OFCondition error = fileformat->loadFile(opt_ifname, opt_ixfer, EGL_noChange, DCM_MaxReadLength, opt_readMode);
 
   if (error.bad())
   {
@@ -237,8 +240,7 @@ int main(int argc, char *argv[])
     --len;
   }
 
-  std::ostream_iterator<unsigned char> oIt(outputBinaryStream.Get());
-  std::copy(pdfDocument, (pdfDocument + len), oIt);
+  outputBinaryStream.SetData(pdfDocument, len, fileformat);
 
   OFLOG_DEBUG(dcm2pdfLogger, "PDF document size in bytes: " << len);
   OFLOG_DEBUG(dcm2pdfLogger, "conversion successful");
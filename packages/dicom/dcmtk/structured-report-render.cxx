@@ -0,0 +1,170 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkOutputTextStream.h"
+
+#include "dcmtk/config/osconfig.h"    /* make sure OS specific configuration is included first */
+
+// Fix warning for redefinition of __STDC_FORMAT_MACROS in the header include tree for dsrdoc.h
+#ifdef __STDC_FORMAT_MACROS
+  #undef __STDC_FORMAT_MACROS
+#endif
+#include "dcmtk/dcmsr/dsrdoc.h"       /* for main interface class DSRDocument */
+#include "dcmtk/dcmdata/dctk.h"       /* for typical set of "dcmdata" headers */
+
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include <cstdio>
+#include <memory>
+
+namespace
+{
+
+// [[tag, value], ...] of the string valued elements of the top-level data
+// set, with the "gggg|eeee" keys of read-dicom-tags
+void
+WriteTags(std::ostream & out, DcmItem & dataset)
+{
+  rapidjson::Document tagsArray;
+  tagsArray.SetArray();
+  rapidjson::Document::AllocatorType & allocator = tagsArray.GetAllocator();
+  for (unsigned long ii = 0; ii < dataset.card(); ++ii)
+  {
+    DcmElement * element = dataset.getElement(ii);
+    if (element == nullptr || !element->isaString())
+    {
+      continue;
+    }
+    OFString value;
+    if (element->getOFStringArray(value).bad())
+    {
+      continue;
+    }
+    const DcmTag & tag = element->getTag();
+    char tagString[10];
+    std::snprintf(tagString, sizeof(tagString), "%04x|%04x", tag.getGTag(), tag.getETag());
+
+    rapidjson::Value tagArray(rapidjson::kArrayType);
+    rapidjson::Value tagName;
+    tagName.SetString(tagString, allocator);
+    tagArray.PushBack(tagName, allocator);
+    rapidjson::Value tagValue;
+    tagValue.SetString(value.c_str(), static_cast<rapidjson::SizeType>(value.length()), allocator);
+    tagArray.PushBack(tagValue, allocator);
+    tagsArray.PushBack(tagArray.Move(), allocator);
+  }
+
+  rapidjson::StringBuffer stringBuffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
+  tagsArray.Accept(writer);
+  out << stringBuffer.GetString();
+}
+
+} // end anonymous namespace
+
+int main(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("structured-report-render", "Parse a DICOM structured report once and render its text, HTML and tags", argc, argv);
+
+  std::string dicomFileName;
+  pipeline.add_option("dicom-file", dicomFileName, "Input DICOM file")->required()->check(CLI::ExistingFile)->type_name("INPUT_BINARY_FILE");
+
+  itk::wasm::OutputTextStream outputText;
+  pipeline.add_option("output-text", outputText, "Output plain text, as structured-report-to-text")->required()->type_name("OUTPUT_TEXT_STREAM");
+
+  itk::wasm::OutputTextStream outputHTML;
+  pipeline.add_option("output-html", outputHTML, "Output HTML, as structured-report-to-html")->required()->type_name("OUTPUT_TEXT_STREAM");
+
+  itk::wasm::OutputTextStream outputTags;
+  pipeline.add_option("tags", outputTags, "Output tags of the data set, as read-dicom-tags. JSON array of [tag, value] arrays.")->required()->type_name("OUTPUT_JSON");
+
+  bool noText{false};
+  pipeline.add_flag("--no-text", noText, "Do not render the plain text output");
+
+  bool noHTML{false};
+  pipeline.add_flag("--no-html", noHTML, "Do not render the HTML output");
+
+  bool noTags{false};
+  pipeline.add_flag("--no-tags", noTags, "Do not write the tags output");
+
+  std::string urlPrefixValue;
+  pipeline.add_option("--url-prefix", urlPrefixValue, "URL: string. Append specificed URL prefix to hyperlinks of referenced composite objects in the HTML document.");
+
+  ITK_WASM_PARSE(pipeline);
+
+  std::unique_ptr<DcmFileFormat> dcmFile = std::make_unique<DcmFileFormat>();
+  OFCondition result = dcmFile->loadFile(dicomFileName.c_str(), EXS_Unknown);
+  if (result.bad())
+  {
+    std::cerr << "Error: \"" << result.text() << "\" while reading file: " << dicomFileName << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!noTags)
+  {
+    WriteTags(outputTags.Get(), *dcmFile->getDataset());
+  }
+
+  if (noText && noHTML)
+  {
+    return EXIT_SUCCESS;
+  }
+
+  // The document is parsed once for both renderings
+  std::unique_ptr<DSRDocument> dsrDoc = std::make_unique<DSRDocument>();
+  result = dsrDoc->read(*dcmFile->getDataset(), 0);
+  if (result.bad())
+  {
+    std::cerr << "Error: \"" << result.text() << "\" while parsing file: " << dicomFileName << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!noText)
+  {
+    result = dsrDoc->print(outputText.Get(), DSRTypes::PF_shortenLongItemValues);
+    outputText.Get() << std::endl;
+    if (result.bad())
+    {
+      std::cerr << "Error: \"" << result.text() << "\" while rendering text of file: " << dicomFileName << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (!noHTML)
+  {
+    // Rendered straight into the output stream
+    const size_t renderFlags = DSRTypes::HF_renderDcmtkFootnote;
+    if (urlPrefixValue.empty())
+    {
+      result = dsrDoc->renderHTML(outputHTML.Get(), renderFlags);
+    }
+    else
+    {
+      result = dsrDoc->renderHTML(outputHTML.Get(), renderFlags, NULL, urlPrefixValue);
+    }
+    if (result.bad())
+    {
+      std::cerr << "Error: \"" << result.text() << "\" while rendering HTML of file: " << dicomFileName << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
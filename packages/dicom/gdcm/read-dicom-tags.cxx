@@ -18,7 +18,9 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -28,9 +30,13 @@
 #include <iconv.h>
 
 #include "rapidjson/document.h"
-#include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
+#include "gdcmBase64.h"
+#include "gdcmDataSetHelper.h"
+#include "gdcmReader.h"
+#include "gdcmStringFilter.h"
+
 #include "itkCommonEnums.h"
 #include "itkGDCMImageIO.h"
 #include "itkGDCMSeriesFileNames.h"
@@ -545,6 +551,73 @@ public:
     return m_decoder.convertCharStringToUTF8(value);
   }
 
+  /** Read only the given tags, e.g. "0008|103e". The file is parsed up to
+   * the highest of them, so later elements, e.g. the pixel data, are not
+   * read. Tags that are not in the file are absent from the result. */
+  TagMapType
+  ReadTags(const std::vector<std::string> & tags)
+  {
+    gdcm::Tag specificCharacterSetTag(0x0008, 0x0005);
+    gdcm::Tag lastTag = specificCharacterSetTag;
+    std::set<gdcm::Tag> requestedTags;
+    for (const std::string & tagString : tags)
+    {
+      gdcm::Tag tag;
+      if (tag.ReadFromPipeSeparatedString(tagString.c_str()))
+      {
+        requestedTags.insert(tag);
+        lastTag = std::max(lastTag, tag);
+      }
+    }
+
+    gdcm::Reader reader;
+    reader.SetFileName(m_fileName.c_str());
+    if (!reader.ReadUpToTag(lastTag, std::set<gdcm::Tag>()))
+    {
+      itkGenericExceptionMacro("Could not read the DICOM file " << m_fileName);
+    }
+
+    // The values of the GDCMImageIO MetaDataDictionary
+    const gdcm::File &    file = reader.GetFile();
+    const gdcm::DataSet & dataSet = file.GetDataSet();
+    gdcm::StringFilter    stringFilter;
+    stringFilter.SetFile(file);
+    TagMapType values;
+    requestedTags.insert(specificCharacterSetTag);
+    for (const gdcm::Tag & tag : requestedTags)
+    {
+      if (!dataSet.FindDataElement(tag) || !tag.IsPublic())
+      {
+        continue;
+      }
+      const gdcm::DataElement & dataElement = dataSet.GetDataElement(tag);
+      const gdcm::VR            vr = gdcm::DataSetHelper::ComputeVR(file, dataSet, tag);
+      if (vr & (gdcm::VR::OB | gdcm::VR::OF | gdcm::VR::OW | gdcm::VR::SQ | gdcm::VR::UN))
+      {
+        const gdcm::ByteValue * byteValue = dataElement.GetByteValue();
+        if (!(vr & gdcm::VR::SQ) && byteValue != nullptr)
+        {
+          std::string encoded(gdcm::Base64::GetEncodeLength(byteValue->GetPointer(), byteValue->GetLength()), '\0');
+          const size_t encodedLength = gdcm::Base64::Encode(
+            &encoded[0], encoded.size(), byteValue->GetPointer(), byteValue->GetLength());
+          encoded.resize(encodedLength);
+          values[tag.PrintAsPipeSeparatedString()] = encoded;
+        }
+      }
+      else
+      {
+        values[tag.PrintAsPipeSeparatedString()] = stringFilter.ToString(tag);
+      }
+    }
+
+    CharStringToUTF8Converter decoder(values[specificCharacterSetTag.PrintAsPipeSeparatedString()]);
+    for (auto & value : values)
+    {
+      value.second = decoder.convertCharStringToUTF8(value.second);
+    }
+    return values;
+  }
+
   TagMapType
   ReadAllTags()
   {
@@ -579,37 +652,32 @@ private:
 
 } // end namespace itk
 
-int main( int argc, char * argv[] )
+namespace
 {
-  itk::wasm::Pipeline pipeline("read-dicom-tags", "Read the tags from a DICOM file", argc, argv);
-
-  std::string dicomFile;
-  pipeline.add_option("dicom-file", dicomFile, "Input DICOM file.")->required()->check(CLI::ExistingFile)->type_name("INPUT_BINARY_FILE");
-
-  itk::wasm::InputTextStream tagsToReadStream;
-  pipeline.add_option("--tags-to-read", tagsToReadStream, "A JSON object with a \"tags\" array of the tags to read. If not provided, all tags are read. Example tag: \"0008|103e\".")->type_name("INPUT_JSON");
-
-  itk::wasm::OutputTextStream tagsStream;
-  pipeline.add_option("tags", tagsStream, "Output tags in the file. JSON object an array of [tag, value] arrays. Values are encoded as UTF-8 strings.")->required()->type_name("OUTPUT_JSON");
-
-  ITK_WASM_PARSE(pipeline);
 
+// [[tag, value], ...] of one file
+int
+ReadFileTags(itk::wasm::Pipeline &             pipeline,
+             const std::string &               dicomFile,
+             const rapidjson::Value *          inputTagsArray,
+             rapidjson::Value &                tagsArray,
+             rapidjson::Document::AllocatorType & allocator)
+{
   itk::DICOMTagReader dicomTagReader;
 
   dicomTagReader.SetFileName(dicomFile);
   if (!dicomTagReader.CanReadFile(dicomFile))
   {
-    std::cerr << "Could not read the input DICOM file" << std::endl;
+    std::cerr << "Could not read the input DICOM file " << dicomFile << std::endl;
     return EXIT_FAILURE;
   }
 
-  if (tagsToReadStream.GetPointer() == nullptr)
+  tagsArray.SetArray();
+  if (inputTagsArray == nullptr)
   {
-    const auto dicomTags = dicomTagReader.ReadAllTags();
+    itk::DICOMTagReader::TagMapType dicomTags;
+    ITK_WASM_CATCH_EXCEPTION(pipeline, dicomTags = dicomTagReader.ReadAllTags());
 
-    rapidjson::Document tagsArray;
-    tagsArray.SetArray();
-    rapidjson::Document::AllocatorType& allocator = tagsArray.GetAllocator();
     for (const auto& [tag, value] : dicomTags) {
       rapidjson::Value tagArray(rapidjson::kArrayType);
 
@@ -623,16 +691,65 @@ int main( int argc, char * argv[] )
 
       tagsArray.PushBack(tagArray.Move(), allocator);
     }
+  }
+  else
+  {
+    std::vector<std::string> tagsLower;
+    for( rapidjson::Value::ConstValueIterator itr = inputTagsArray->Begin(); itr != inputTagsArray->End(); ++itr )
+    {
+      std::string tagLower(itr->GetString());
+      std::transform(tagLower.begin(), tagLower.end(), tagLower.begin(), ::tolower);
+      tagsLower.push_back(tagLower);
+    }
+    // Stop parsing at the highest requested tag
+    itk::DICOMTagReader::TagMapType dicomTags;
+    ITK_WASM_CATCH_EXCEPTION(pipeline, dicomTags = dicomTagReader.ReadTags(tagsLower));
+
+    size_t index = 0;
+    for( rapidjson::Value::ConstValueIterator itr = inputTagsArray->Begin(); itr != inputTagsArray->End(); ++itr, ++index )
+    {
+      rapidjson::Value tagArray(rapidjson::kArrayType);
+
+      const std::string tagString(itr->GetString());
+      rapidjson::Value tagName;
+      tagName.SetString(tagString.c_str(), allocator);
+      tagArray.PushBack(tagName, allocator);
 
-    rapidjson::StringBuffer stringBuffer;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
-    tagsArray.Accept(writer);
+      rapidjson::Value tagValue;
+      tagValue.SetString(dicomTags[tagsLower[index]].c_str(), allocator);
+      tagArray.PushBack(tagValue, allocator);
 
-    tagsStream.Get() << stringBuffer.GetString();
+      tagsArray.PushBack(tagArray.Move(), allocator);
+    }
   }
-  else
+
+  return EXIT_SUCCESS;
+}
+
+} // end anonymous namespace
+
+int main( int argc, char * argv[] )
+{
+  itk::wasm::Pipeline pipeline("read-dicom-tags", "Read the tags from a DICOM file", argc, argv);
+
+  std::string dicomFile;
+  pipeline.add_option("dicom-file", dicomFile, "Input DICOM file.")->required()->check(CLI::ExistingFile)->type_name("INPUT_BINARY_FILE");
+
+  std::vector<std::string> dicomFiles;
+  pipeline.add_option("--dicom-files", dicomFiles, "Additional input DICOM files. When given, tags is a JSON array of {\"file\": file name, \"tags\": [[tag, value], ...]} objects for dicom-file and these files.")->check(CLI::ExistingFile)->expected(1,-1)->type_name("INPUT_BINARY_FILE");
+
+  itk::wasm::InputTextStream tagsToReadStream;
+  pipeline.add_option("--tags-to-read", tagsToReadStream, "A JSON object with a \"tags\" array of the tags to read. If not provided, all tags are read. Example tag: \"0008|103e\".")->type_name("INPUT_JSON");
+
+  itk::wasm::OutputTextStream tagsStream;
+  pipeline.add_option("tags", tagsStream, "Output tags in the file. JSON object an array of [tag, value] arrays. Values are encoded as UTF-8 strings.")->required()->type_name("OUTPUT_JSON");
+
+  ITK_WASM_PARSE(pipeline);
+
+  rapidjson::Document inputTagsDocument;
+  const rapidjson::Value * inputTagsArray = nullptr;
+  if (tagsToReadStream.GetPointer() != nullptr)
   {
-    rapidjson::Document inputTagsDocument;
     const std::string inputTagsString((std::istreambuf_iterator<char>(tagsToReadStream.Get())),
                                        std::istreambuf_iterator<char>());
     if (inputTagsDocument.Parse(inputTagsString.c_str()).HasParseError())
@@ -645,36 +762,45 @@ int main( int argc, char * argv[] )
       CLI::Error err("Runtime error", "Input tags does not have expected \"tags\" member", 1);
       return pipeline.exit(err);
       }
+    inputTagsArray = &inputTagsDocument["tags"];
+  }
 
-    rapidjson::Document tagsArray;
-    tagsArray.SetArray();
-    rapidjson::Document::AllocatorType& allocator = tagsArray.GetAllocator();
-    const rapidjson::Value & inputTagsArray = inputTagsDocument["tags"];
-
-    for( rapidjson::Value::ConstValueIterator itr = inputTagsArray.Begin(); itr != inputTagsArray.End(); ++itr )
+  rapidjson::Document outputDocument;
+  rapidjson::Document::AllocatorType& allocator = outputDocument.GetAllocator();
+  if (dicomFiles.empty())
+  {
+    const int result = ReadFileTags(pipeline, dicomFile, inputTagsArray, outputDocument, allocator);
+    if (result != EXIT_SUCCESS)
     {
-      rapidjson::Value tagArray(rapidjson::kArrayType);
-
-      const std::string tagString(itr->GetString());
-      rapidjson::Value tagName;
-      tagName.SetString(tagString.c_str(), allocator);
-      tagArray.PushBack(tagName, allocator);
-
-      rapidjson::Value tagValue;
-      std::string tagLower(tagString);
-      std::transform(tagLower.begin(), tagLower.end(), tagLower.begin(), ::tolower);
-      tagValue.SetString(dicomTagReader.ReadTag(tagLower).c_str(), allocator);
-      tagArray.PushBack(tagValue, allocator);
-
-      tagsArray.PushBack(tagArray.Move(), allocator);
+      return result;
     }
+  }
+  else
+  {
+    dicomFiles.insert(dicomFiles.begin(), dicomFile);
+    outputDocument.SetArray();
+    for (const std::string & fileName : dicomFiles)
+    {
+      rapidjson::Value tagsArray;
+      const int result = ReadFileTags(pipeline, fileName, inputTagsArray, tagsArray, allocator);
+      if (result != EXIT_SUCCESS)
+      {
+        return result;
+      }
 
-    rapidjson::StringBuffer stringBuffer;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
-    tagsArray.Accept(writer);
-
-    tagsStream.Get() << stringBuffer.GetString();
+      rapidjson::Value fileResult(rapidjson::kObjectType);
+      rapidjson::Value fileNameValue;
+      fileNameValue.SetString(fileName.c_str(), allocator);
+      fileResult.AddMember("file", fileNameValue, allocator);
+      fileResult.AddMember("tags", tagsArray, allocator);
+      outputDocument.PushBack(fileResult.Move(), allocator);
+    }
   }
 
+  // Written straight to the output buffer
+  itk::wasm::StreamBufferJSONOutput tagsOutput(tagsStream.Get().rdbuf());
+  rapidjson::Writer<itk::wasm::StreamBufferJSONOutput> writer(tagsOutput);
+  outputDocument.Accept(writer);
+
   return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -15,180 +15,64 @@
  *  limitations under the License.
  *
  *=========================================================================*/
+#include <iterator>
 #include <string>
 #include <vector>
-#include <fstream>
-#include <memory>
 
 #include "itkCommonEnums.h"
-#include "gdcmSerieHelper.h"
-#include "itkImageIOBase.h"
-#include "itkImageSeriesReader.h"
 #include "itkGDCMImageIO.h"
 #include "itkImage.h"
-#include "itksys/SystemTools.hxx"
+#include "itkBinShrinkImageFilter.h"
 
 #include "itkPipeline.h"
 #include "itkOutputImage.h"
+#include "itkInputTextStream.h"
 #include "itkOutputTextStream.h"
+#include "itkIOComponentEnumFromWasmComponentType.h"
 
 #include "rapidjson/document.h"
 #include "rapidjson/prettywriter.h"
-#include "rapidjson/ostreamwrapper.h"
 
-class CustomSerieHelper: public gdcm::SerieHelper
-{
-public:
-  void AddFileName(std::string const &fileName)
-  {
-    SerieHelper::AddFileName(fileName);
-  }
-};
+#include "readDICOMSeries.h"
 
-namespace itk
+namespace
 {
 
-template <typename TOutputImage>
-class ITK_TEMPLATE_EXPORT QuickDICOMImageSeriesReader : public ImageSeriesReader<TOutputImage>
+// The sorted file names of the first series, by series identifier
+std::vector<std::string>
+SortFirstSeries(const std::vector<std::string> & fileNames, const std::string & scanCacheJSON)
 {
-public:
-  ITK_DISALLOW_COPY_AND_ASSIGN(QuickDICOMImageSeriesReader);
-
-  /** Standard class type aliases. */
-  using Self = QuickDICOMImageSeriesReader;
-  using Superclass = ImageSeriesReader<TOutputImage>;
-  using Pointer = SmartPointer<Self>;
-
-  /** Method for creation through the object factory. */
-  itkNewMacro(Self);
-
-  /** Run-time type information (and related methods). */
-  itkTypeMacro(QuickDICOMImageSeriesReader, ImageSeriesReader);
-
-  /** The size of the output image. */
-  using SizeType = typename TOutputImage::SizeType;
-
-  /** The index of the output image. */
-  using IndexType = typename TOutputImage::IndexType;
-
-  /** The region of the output image. */
-  using ImageRegionType = typename TOutputImage::RegionType;
-
-  /** The pixel type of the output image. */
-  using OutputImagePixelType = typename TOutputImage::PixelType;
-
-protected:
-  QuickDICOMImageSeriesReader()
-    {
-    }
-
-  ~QuickDICOMImageSeriesReader() override
-    {
-    }
-
-  /** Does the real work. */
-  void
-  GenerateData() override
-    {
-      TOutputImage * output = this->GetOutput();
-
-      ImageRegionType requestedRegion = output->GetRequestedRegion();
-      ImageRegionType largestRegion = output->GetLargestPossibleRegion();
-      ImageRegionType sliceRegionToRequest = output->GetRequestedRegion();
-
-      // Each file must have the same size.
-      SizeType validSize = largestRegion.GetSize();
-
-      // If more than one file is being read, then the input dimension
-      // will be less than the output dimension.  In this case, set
-      // the last dimension that is other than 1 of validSize to 1.  However, if the
-      // input and output have the same number of dimensions, this should
-      // not be done because it will lower the dimension of the output image.
-      if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-      {
-        validSize[this->m_NumberOfDimensionsInImage] = 1;
-        sliceRegionToRequest.SetSize(this->m_NumberOfDimensionsInImage, 1);
-        sliceRegionToRequest.SetIndex(this->m_NumberOfDimensionsInImage, 0);
-      }
-
-      ImageIORegion imageIORegion(this->m_NumberOfDimensionsInImage);
-      for (unsigned int dim = 0; dim < this->m_NumberOfDimensionsInImage; ++dim) {
-        imageIORegion.SetSize(dim, sliceRegionToRequest.GetSize(dim));
-        imageIORegion.SetIndex(dim, sliceRegionToRequest.GetIndex(dim));
-      }
-      // the size of the buffer is computed based on the actual number of
-      // pixels to be read and the actual size of the pixels to be read
-      // (as opposed to the sizes of the output)
-      const size_t sizeOfActualIORegion =
-        imageIORegion.GetNumberOfPixels() * (this->m_ImageIO->GetComponentSize() * this->m_ImageIO->GetNumberOfComponents());
-
-
-      // Allocate the output buffer
-      output->SetBufferedRegion(requestedRegion);
-      output->Allocate();
-
-      // progress reported on a per slice basis
-      ProgressReporter progress(this, 0, requestedRegion.GetSize(TOutputImage::ImageDimension - 1), 100);
-
-      const bool needToUpdateMetaDataDictionaryArray = false;
-
-      typename TOutputImage::InternalPixelType * outputBuffer = output->GetBufferPointer();
-      IndexType                                  sliceStartIndex = requestedRegion.GetIndex();
-      const auto                                 numberOfFiles = static_cast<int>(this->m_FileNames.size());
-
-      typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
-      typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
-      double                             maxSpacingDeviation = 0.0;
-      bool                               prevSliceIsValid = false;
-
-      for (int i = 0; i != numberOfFiles; ++i)
-      {
-        if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-        {
-          sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
-        }
-
-        const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-        const int  iFileName = i;
-        bool       nonUniformSampling = false;
-        double     spacingDeviation = 0.0;
-
-        // check if we need this slice
-        if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
-        {
-          continue;
-        }
-
-        this->m_ImageIO->SetFileName(this->m_FileNames[iFileName].c_str());
-        this->m_ImageIO->SetIORegion(imageIORegion);
-
-        const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
-
-        using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
-        const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
-
-
-        const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-                                        ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
-                                        : 0;
-
-        const ptrdiff_t numberOfPixelComponentsUpToSlice =
-          numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
-
-        typename TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
-        this->m_ImageIO->Read(outputSliceBuffer);
-
-        // report progress for read slices
-        progress.CompletedPixel();
+  return SortSeries(fileNames, scanCacheJSON).begin()->second.fileNames;
+}
 
-      } // end per slice loop
-    } // end GenerateData
+struct SeriesOptions
+{
+  std::string  scanCacheJSON;
+  unsigned int previewSlices{ 0 };
+  unsigned int previewShrinkFactor{ 1 };
+  bool         storedValues{ false };
 };
 
-} // end namespace itk
+// Evenly spaced slices, centered in the series, e.g. the middle slice for one
+std::vector<std::string>
+PickPreviewSlices(const std::vector<std::string> & fileNames, size_t previewSlices)
+{
+  if (previewSlices >= fileNames.size())
+  {
+    return fileNames;
+  }
+  std::vector<std::string> picked;
+  for (size_t ii = 0; ii < previewSlices; ++ii)
+  {
+    picked.push_back(fileNames[(2 * ii + 1) * fileNames.size() / (2 * previewSlices)]);
+  }
+  return picked;
+}
+
+} // end anonymous namespace
 
 template <typename TImage>
-int runPipeline(itk::wasm::Pipeline & pipeline, std::vector<std::string> & inputFileNames)
+int runPipeline(itk::wasm::Pipeline & pipeline, std::vector<std::string> & inputFileNames, const SeriesOptions & seriesOptions)
 {
   using ImageType = TImage;
 
@@ -207,69 +91,18 @@ int runPipeline(itk::wasm::Pipeline & pipeline, std::vector<std::string> & input
   typedef itk::QuickDICOMImageSeriesReader< ImageType > ReaderType;
   typename ReaderType::Pointer reader = ReaderType::New();
   reader->SetMetaDataDictionaryArrayUpdate(false);
+  reader->SetStoredValues(seriesOptions.storedValues);
 
+  std::vector<std::string> fileNames = inputFileNames;
   if (!singleSortedSeries)
   {
-    std::unique_ptr<CustomSerieHelper> serieHelper(new CustomSerieHelper());
-    for (const std::string & fileName: inputFileNames)
-    {
-      serieHelper->AddFileName(fileName);
-    }
-    serieHelper->SetUseSeriesDetails(true);
-    // Add the default restrictions to refine the file set into multiple series.
-    serieHelper->CreateDefaultUniqueSeriesIdentifier();
-    using SeriesIdContainer = std::vector<std::string>;
-    SeriesIdContainer seriesUIDs;
-    // Accessing the first serie found (assume there is at least one)
-    gdcm::FileList * flist = serieHelper->GetFirstSingleSerieUIDFileSet();
-    while (flist)
-    {
-      if (!flist->empty()) // make sure we have at leat one serie
-      {
-        gdcm::File * file = (*flist)[0]; // for example take the first one
-
-        // Create its unique series ID
-        const std::string id( serieHelper->CreateUniqueSeriesIdentifier(file));
-
-        seriesUIDs.push_back(id);
-      }
-      flist = serieHelper->GetNextSingleSerieUIDFileSet();
-    }
-
-    using FileNamesContainer = std::vector<std::string>;
-    FileNamesContainer fileNames;
-    flist = serieHelper->GetFirstSingleSerieUIDFileSet();
-    const std::string serie = seriesUIDs[0];
-    bool found = false;
-    while (flist && !found)
-    {
-      if (!flist->empty()) // make sure we have at leat one serie
-      {
-        gdcm::File * file = (*flist)[0]; // for example take the first one
-        const std::string id( serieHelper->CreateUniqueSeriesIdentifier(file));
-        if (id == serie)
-        {
-          found = true; // we found a match
-          break;
-        }
-      }
-      flist = serieHelper->GetNextSingleSerieUIDFileSet();
-    }
-    serieHelper->OrderFileList(flist);
-
-    gdcm::FileList::iterator it;
-    for (it = flist->begin(); it != flist->end(); ++it)
-    {
-      gdcm::FileWithName * header = *it;
-      fileNames.push_back(header->filename);
-    }
-
-    reader->SetFileNames(fileNames);
+    ITK_WASM_CATCH_EXCEPTION(pipeline, fileNames = SortFirstSeries(inputFileNames, seriesOptions.scanCacheJSON));
   }
-  else
+  if (seriesOptions.previewSlices > 0)
   {
-    reader->SetFileNames(inputFileNames);
+    fileNames = PickPreviewSlices(fileNames, seriesOptions.previewSlices);
   }
+  reader->SetFileNames(fileNames);
 
   // copy sorted filenames as additional output
   rapidjson::Document document(rapidjson::kArrayType);
@@ -281,12 +114,31 @@ int runPipeline(itk::wasm::Pipeline & pipeline, std::vector<std::string> & input
     value.SetString((*f).c_str(), allocator);
     document.PushBack(value, allocator);
   }
-  rapidjson::OStreamWrapper ostreamWrapper( sortedFilenames.Get() );
-  rapidjson::PrettyWriter< rapidjson::OStreamWrapper > writer( ostreamWrapper );
+  itk::wasm::StreamBufferJSONOutput sortedFilenamesOutput( sortedFilenames.Get().rdbuf() );
+  rapidjson::PrettyWriter< itk::wasm::StreamBufferJSONOutput > writer( sortedFilenamesOutput );
   document.Accept( writer );
 
   auto gdcmImageIO = itk::GDCMImageIO::New();
   reader->SetImageIO(gdcmImageIO);
+  pipeline.observe_progress(reader);
+  pipeline.abort_on_request(reader);
+
+  if (seriesOptions.previewShrinkFactor > 1)
+  {
+    // Shrink in-plane only, so the preview keeps its slices
+    using ShrinkFilterType = itk::BinShrinkImageFilter<ImageType, ImageType>;
+    auto shrinkFilter = ShrinkFilterType::New();
+    shrinkFilter->SetInput(reader->GetOutput());
+    for (unsigned int dim = 0; dim < ImageType::ImageDimension - 1; ++dim)
+    {
+      shrinkFilter->SetShrinkFactor(dim, seriesOptions.previewShrinkFactor);
+    }
+    pipeline.observe_progress(shrinkFilter);
+    pipeline.abort_on_request(shrinkFilter);
+    ITK_WASM_CATCH_EXCEPTION(pipeline, shrinkFilter->UpdateLargestPossibleRegion());
+    outputImage.Set(shrinkFilter->GetOutput());
+    return EXIT_SUCCESS;
+  }
 
   ITK_WASM_CATCH_EXCEPTION(pipeline, reader->Update());
   outputImage.Set(reader->GetOutput());
@@ -295,7 +147,7 @@ int runPipeline(itk::wasm::Pipeline & pipeline, std::vector<std::string> & input
 }
 
 template <typename TComp>
-int runPipeline(itk::wasm::Pipeline & pipeline, std::vector<std::string> & inputFileNames, int numberOfComponents)
+int runPipeline(itk::wasm::Pipeline & pipeline, std::vector<std::string> & inputFileNames, const SeriesOptions & seriesOptions, int numberOfComponents)
 {
   using ComponentType = TComp;
   static constexpr unsigned int ImageDimension = 3;
@@ -305,25 +157,25 @@ int runPipeline(itk::wasm::Pipeline & pipeline, std::vector<std::string> & input
       {
       typedef itk::Vector< ComponentType, 4> PixelType;
       typedef itk::Image<PixelType, ImageDimension> ImageType;
-      return runPipeline<ImageType>(pipeline, inputFileNames);
+      return runPipeline<ImageType>(pipeline, inputFileNames, seriesOptions);
       }
     case 3:
       {
       typedef itk::Vector< ComponentType, 3> PixelType;
       typedef itk::Image<PixelType, ImageDimension> ImageType;
-      return runPipeline<ImageType>(pipeline, inputFileNames);
+      return runPipeline<ImageType>(pipeline, inputFileNames, seriesOptions);
       }
     case 2:
       {
       typedef itk::Vector< ComponentType, 2> PixelType;
       typedef itk::Image<PixelType, ImageDimension> ImageType;
-      return runPipeline<ImageType>(pipeline, inputFileNames);
+      return runPipeline<ImageType>(pipeline, inputFileNames, seriesOptions);
       }
     case 1:
     default:
       {
       typedef itk::Image<TComp, ImageDimension> ImageType;
-      return runPipeline<ImageType>(pipeline, inputFileNames);
+      return runPipeline<ImageType>(pipeline, inputFileNames, seriesOptions);
       }
     }
 }
@@ -336,6 +188,21 @@ int main (int argc, char * argv[])
   std::vector<std::string> inputFileNames;
   pipeline.add_option("-i,--input-images", inputFileNames, "File names in the series")->required()->check(CLI::ExistingFile)->expected(1,-1)->type_name("INPUT_BINARY_FILE");
 
+  itk::wasm::InputTextStream scanCacheStream;
+  pipeline.add_option("--scan-cache", scanCacheStream, "Sort tags of files scanned before, as {\"files\": [{\"path\": file name, \"size\": bytes, \"tags\": {\"0020|000e\": value, ...}}]}, e.g. from read-dicom-tags. Files whose path and size match are not scanned.")->type_name("INPUT_JSON");
+
+  unsigned int previewSlices = 0;
+  pipeline.add_option("--preview-slices", previewSlices, "Read only this many evenly spaced slices of the sorted series, e.g. 1 for the middle slice of a thumbnail. 0 reads all slices.");
+
+  unsigned int previewShrinkFactor = 1;
+  pipeline.add_option("--preview-shrink-factor", previewShrinkFactor, "Bin shrink the slices in-plane by this factor")->check(CLI::PositiveNumber);
+
+  std::string rescalePolicy = "rescaled";
+  pipeline.add_option("--rescale-policy", rescalePolicy, "rescaled: apply the rescale slope and intercept of the slices. stored: the stored values, e.g. to rescale them later.")->check(CLI::IsMember({"rescaled", "stored"}));
+
+  std::string outputComponentType;
+  pipeline.add_option("--output-component-type", outputComponentType, "Component type of the output image, e.g. int16 or float32, converted slice by slice as it is read. Float values are truncated toward zero. By default, that of the rescaled or stored values.")->check(CLI::IsMember({"int8", "uint8", "int16", "uint16", "int32", "uint32", "int64", "uint64", "float32", "float64"}));
+
   // Type is not important here, its just a dummy placeholder to be added and then removed.
   std::string outputImage;
   auto outputImageOption = pipeline.add_option("output-image", outputImage, "Output image volume")->required()->type_name("OUTPUT_IMAGE");
@@ -351,6 +218,15 @@ int main (int argc, char * argv[])
 
   ITK_WASM_PARSE(pipeline);
 
+  SeriesOptions seriesOptions;
+  seriesOptions.previewSlices = previewSlices;
+  seriesOptions.previewShrinkFactor = previewShrinkFactor;
+  seriesOptions.storedValues = rescalePolicy == "stored";
+  if (scanCacheStream.GetPointer() != nullptr)
+  {
+    seriesOptions.scanCacheJSON.assign(std::istreambuf_iterator<char>(scanCacheStream.Get()), std::istreambuf_iterator<char>());
+  }
+
   // Remove added dummy options. runPipeline will add the real options later.
   pipeline.remove_option(sortedOption);
   pipeline.remove_option(outputImageOption);
@@ -360,7 +236,13 @@ int main (int argc, char * argv[])
 
   gdcmImageIO->SetFileName(inputFileNames[0]);
   gdcmImageIO->ReadImageInformation();
-  const auto ioComponentType = gdcmImageIO->GetComponentType();
+  // The component type of the rescaled values, of the stored values, or the
+  // requested output component type
+  auto ioComponentType = seriesOptions.storedValues ? gdcmImageIO->GetInternalComponentType() : gdcmImageIO->GetComponentType();
+  if (!outputComponentType.empty())
+  {
+    ioComponentType = itk::IOComponentEnumFromWasmComponentType(outputComponentType);
+  }
   // Todo: work with the ioPixelType
   // const auto ioPixelType = gdcmImageIO->GetPixelType();
   const auto numberOfComponents = gdcmImageIO->GetNumberOfComponents();
@@ -370,51 +252,51 @@ int main (int argc, char * argv[])
     {
     case itk::CommonEnums::IOComponent::UCHAR:
       {
-      return runPipeline< unsigned char>(pipeline, inputFileNames, numberOfComponents);
+      return runPipeline< unsigned char>(pipeline, inputFileNames, seriesOptions, numberOfComponents);
       }
     case itk::CommonEnums::IOComponent::CHAR:
       {
-      return runPipeline< char>(pipeline, inputFileNames, numberOfComponents);
+      return runPipeline< char>(pipeline, inputFileNames, seriesOptions, numberOfComponents);
       }
     case itk::CommonEnums::IOComponent::USHORT:
       {
-      return runPipeline< unsigned short>(pipeline, inputFileNames, numberOfComponents);
+      return runPipeline< unsigned short>(pipeline, inputFileNames, seriesOptions, numberOfComponents);
       }
     case itk::CommonEnums::IOComponent::SHORT:
       {
-      return runPipeline< short>(pipeline, inputFileNames, numberOfComponents);
+      return runPipeline< short>(pipeline, inputFileNames, seriesOptions, numberOfComponents);
       }
     case itk::CommonEnums::IOComponent::UINT:
       {
-      return runPipeline< unsigned int>(pipeline, inputFileNames, numberOfComponents);
+      return runPipeline< unsigned int>(pipeline, inputFileNames, seriesOptions, numberOfComponents);
       }
     case itk::CommonEnums::IOComponent::INT:
       {
-      return runPipeline< int>(pipeline, inputFileNames, numberOfComponents);
+      return runPipeline< int>(pipeline, inputFileNames, seriesOptions, numberOfComponents);
       }
     case itk::CommonEnums::IOComponent::ULONG:
       {
-      return runPipeline< unsigned long>(pipeline, inputFileNames, numberOfComponents);
+      return runPipeline< unsigned long>(pipeline, inputFileNames, seriesOptions, numberOfComponents);
       }
     case itk::CommonEnums::IOComponent::LONG:
       {
-      return runPipeline< long>(pipeline, inputFileNames, numberOfComponents);
+      return runPipeline< long>(pipeline, inputFileNames, seriesOptions, numberOfComponents);
       }
     case itk::CommonEnums::IOComponent::ULONGLONG:
       {
-      return runPipeline< unsigned long long>(pipeline, inputFileNames, numberOfComponents);
+      return runPipeline< unsigned long long>(pipeline, inputFileNames, seriesOptions, numberOfComponents);
       }
     case itk::CommonEnums::IOComponent::LONGLONG:
       {
-      return runPipeline< long long>(pipeline, inputFileNames, numberOfComponents);
+      return runPipeline< long long>(pipeline, inputFileNames, seriesOptions, numberOfComponents);
       }
     case itk::CommonEnums::IOComponent::FLOAT:
       {
-      return runPipeline< float>(pipeline, inputFileNames, numberOfComponents);
+      return runPipeline< float>(pipeline, inputFileNames, seriesOptions, numberOfComponents);
       }
     case itk::CommonEnums::IOComponent::DOUBLE:
       {
-      return runPipeline< double>(pipeline, inputFileNames, numberOfComponents);
+      return runPipeline< double>(pipeline, inputFileNames, seriesOptions, numberOfComponents);
       }
     case itk::CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE:
     default:
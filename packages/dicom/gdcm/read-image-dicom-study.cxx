@@ -0,0 +1,220 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "itkCommonEnums.h"
+#include "itkGDCMImageIO.h"
+#include "itkImage.h"
+#include "itkVector.h"
+
+#include "itkPipeline.h"
+#include "itkOutputImage.h"
+#include "itkInputTextStream.h"
+#include "itkOutputTextStream.h"
+#include "itkIOComponentEnumFromWasmComponentType.h"
+
+#include "rapidjson/document.h"
+#include "rapidjson/prettywriter.h"
+
+#include "readDICOMSeries.h"
+
+namespace
+{
+
+// Read a sorted series into its output image. The output is serialized when
+// it goes out of scope, in threaded builds on a background thread while the
+// next series is decoded.
+template <typename TImage>
+void
+ReadSeriesVolume(const std::vector<std::string> & fileNames, bool storedValues, const std::string & identifier)
+{
+  using ReaderType = itk::QuickDICOMImageSeriesReader<TImage>;
+  auto reader = ReaderType::New();
+  reader->SetMetaDataDictionaryArrayUpdate(false);
+  reader->SetStoredValues(storedValues);
+  reader->SetImageIO(itk::GDCMImageIO::New());
+  reader->SetFileNames(fileNames);
+  reader->Update();
+
+  itk::wasm::OutputImage<TImage> outputImage;
+  outputImage.SetIdentifier(identifier);
+  outputImage.Set(reader->GetOutput());
+}
+
+template <typename TComponent>
+void
+ReadSeriesVolume(const std::vector<std::string> & fileNames, bool storedValues, const std::string & identifier, unsigned int numberOfComponents)
+{
+  static constexpr unsigned int ImageDimension = 3;
+  switch (numberOfComponents)
+  {
+    case 4:
+      ReadSeriesVolume<itk::Image<itk::Vector<TComponent, 4>, ImageDimension>>(fileNames, storedValues, identifier);
+      break;
+    case 3:
+      ReadSeriesVolume<itk::Image<itk::Vector<TComponent, 3>, ImageDimension>>(fileNames, storedValues, identifier);
+      break;
+    case 2:
+      ReadSeriesVolume<itk::Image<itk::Vector<TComponent, 2>, ImageDimension>>(fileNames, storedValues, identifier);
+      break;
+    case 1:
+    default:
+      ReadSeriesVolume<itk::Image<TComponent, ImageDimension>>(fileNames, storedValues, identifier);
+      break;
+  }
+}
+
+// The volume of a series with the component type of the rescaled or stored
+// values of its first file, or outputComponentType
+void
+ReadSeriesVolume(const std::vector<std::string> & fileNames, bool storedValues, const std::string & outputComponentType, const std::string & identifier)
+{
+  auto gdcmImageIO = itk::GDCMImageIO::New();
+  gdcmImageIO->SetFileName(fileNames[0]);
+  gdcmImageIO->ReadImageInformation();
+  auto ioComponentType = storedValues ? gdcmImageIO->GetInternalComponentType() : gdcmImageIO->GetComponentType();
+  if (!outputComponentType.empty())
+  {
+    ioComponentType = itk::IOComponentEnumFromWasmComponentType(outputComponentType);
+  }
+  const unsigned int numberOfComponents = gdcmImageIO->GetNumberOfComponents();
+
+  switch (ioComponentType)
+  {
+    case itk::CommonEnums::IOComponent::UCHAR:
+      ReadSeriesVolume<unsigned char>(fileNames, storedValues, identifier, numberOfComponents);
+      break;
+    case itk::CommonEnums::IOComponent::CHAR:
+      ReadSeriesVolume<char>(fileNames, storedValues, identifier, numberOfComponents);
+      break;
+    case itk::CommonEnums::IOComponent::USHORT:
+      ReadSeriesVolume<unsigned short>(fileNames, storedValues, identifier, numberOfComponents);
+      break;
+    case itk::CommonEnums::IOComponent::SHORT:
+      ReadSeriesVolume<short>(fileNames, storedValues, identifier, numberOfComponents);
+      break;
+    case itk::CommonEnums::IOComponent::UINT:
+      ReadSeriesVolume<unsigned int>(fileNames, storedValues, identifier, numberOfComponents);
+      break;
+    case itk::CommonEnums::IOComponent::INT:
+      ReadSeriesVolume<int>(fileNames, storedValues, identifier, numberOfComponents);
+      break;
+    case itk::CommonEnums::IOComponent::ULONG:
+      ReadSeriesVolume<unsigned long>(fileNames, storedValues, identifier, numberOfComponents);
+      break;
+    case itk::CommonEnums::IOComponent::LONG:
+      ReadSeriesVolume<long>(fileNames, storedValues, identifier, numberOfComponents);
+      break;
+    case itk::CommonEnums::IOComponent::ULONGLONG:
+      ReadSeriesVolume<unsigned long long>(fileNames, storedValues, identifier, numberOfComponents);
+      break;
+    case itk::CommonEnums::IOComponent::LONGLONG:
+      ReadSeriesVolume<long long>(fileNames, storedValues, identifier, numberOfComponents);
+      break;
+    case itk::CommonEnums::IOComponent::FLOAT:
+      ReadSeriesVolume<float>(fileNames, storedValues, identifier, numberOfComponents);
+      break;
+    case itk::CommonEnums::IOComponent::DOUBLE:
+      ReadSeriesVolume<double>(fileNames, storedValues, identifier, numberOfComponents);
+      break;
+    case itk::CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE:
+    default:
+      throw std::runtime_error("Unknown image pixel component type in " + fileNames[0]);
+  }
+}
+
+} // end anonymous namespace
+
+int main (int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("read-image-dicom-study", "Read every DICOM image series in the input files, with one scan of their headers, and return the image volume of each series", argc, argv);
+
+  std::vector<std::string> inputFileNames;
+  pipeline.add_option("-i,--input-images", inputFileNames, "File names in the study")->required()->check(CLI::ExistingFile)->expected(1,-1)->type_name("INPUT_BINARY_FILE");
+
+  itk::wasm::InputTextStream scanCacheStream;
+  pipeline.add_option("--scan-cache", scanCacheStream, "Sort tags of files scanned before, as {\"files\": [{\"path\": file name, \"size\": bytes, \"tags\": {\"0020|000e\": value, ...}}]}, e.g. from read-dicom-tags. Files whose path and size match are not scanned.")->type_name("INPUT_JSON");
+
+  std::string rescalePolicy = "rescaled";
+  pipeline.add_option("--rescale-policy", rescalePolicy, "rescaled: apply the rescale slope and intercept of the slices. stored: the stored values, e.g. to rescale them later.")->check(CLI::IsMember({"rescaled", "stored"}));
+
+  std::string outputComponentType;
+  pipeline.add_option("--output-component-type", outputComponentType, "Component type of the output images, e.g. int16 or float32, converted slice by slice as they are read. Float values are truncated toward zero. By default, that of the rescaled or stored values of each series.")->check(CLI::IsMember({"int8", "uint8", "int16", "uint16", "int32", "uint32", "int64", "uint64", "float32", "float64"}));
+
+  itk::wasm::OutputTextStream study;
+  pipeline.add_option("study", study, "Series of the study, ordered by series instance UID and split by series number, sequence name, slice thickness, rows and columns, as [{\"seriesInstanceUID\": uid, \"sortedFilenames\": [file name, ...], \"seriesImage\": index in series-images, or null when there are more series than series-images}]")->required()->type_name("OUTPUT_JSON");
+
+  std::vector<std::string> seriesImages;
+  pipeline.add_option("series-images", seriesImages, "Output image volume of each series, in the order of study. Outputs past the number of series are not set.")->required()->expected(1,-1)->type_name("OUTPUT_IMAGE");
+
+  ITK_WASM_PARSE(pipeline);
+
+  std::string scanCacheJSON;
+  if (scanCacheStream.GetPointer() != nullptr)
+  {
+    scanCacheJSON.assign(std::istreambuf_iterator<char>(scanCacheStream.Get()), std::istreambuf_iterator<char>());
+  }
+
+  // One scan of the headers groups and sorts every series
+  std::map<std::string, SortedSeries> series;
+  ITK_WASM_CATCH_EXCEPTION(pipeline, series = SortSeries(inputFileNames, scanCacheJSON));
+
+  rapidjson::Document document(rapidjson::kArrayType);
+  rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
+  size_t seriesIndex = 0;
+  for (const auto & entry : series)
+  {
+    rapidjson::Value seriesJson(rapidjson::kObjectType);
+    seriesJson.AddMember("seriesInstanceUID", rapidjson::Value(entry.second.seriesInstanceUID.c_str(), allocator), allocator);
+    rapidjson::Value fileNamesJson(rapidjson::kArrayType);
+    for (const std::string & fileName : entry.second.fileNames)
+    {
+      fileNamesJson.PushBack(rapidjson::Value(fileName.c_str(), allocator), allocator);
+    }
+    seriesJson.AddMember("sortedFilenames", fileNamesJson, allocator);
+    rapidjson::Value seriesImage;
+    if (seriesIndex < seriesImages.size())
+    {
+      seriesImage.SetUint64(seriesIndex);
+    }
+    seriesJson.AddMember("seriesImage", seriesImage, allocator);
+    document.PushBack(seriesJson, allocator);
+    ++seriesIndex;
+  }
+  itk::wasm::StreamBufferJSONOutput studyOutput( study.Get().rdbuf() );
+  rapidjson::PrettyWriter< itk::wasm::StreamBufferJSONOutput > writer( studyOutput );
+  document.Accept( writer );
+
+  // The slices of each series are decoded in parallel, and each volume is
+  // serialized while the next series is decoded
+  const bool storedValues = rescalePolicy == "stored";
+  seriesIndex = 0;
+  for (const auto & entry : series)
+  {
+    if (seriesIndex == seriesImages.size())
+    {
+      break;
+    }
+    ITK_WASM_CATCH_EXCEPTION(pipeline, ReadSeriesVolume(entry.second.fileNames, storedValues, outputComponentType, seriesImages[seriesIndex]));
+    ++seriesIndex;
+  }
+
+  return EXIT_SUCCESS;
+}
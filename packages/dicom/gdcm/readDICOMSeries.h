@@ -0,0 +1,632 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef readDICOMSeries_h
+#define readDICOMSeries_h
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gdcmScanner.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkGDCMImageIO.h"
+#include "itkImageIOBase.h"
+#include "itkImageSeriesReader.h"
+#include "itkTotalProgressReporter.h"
+#include "itksys/SystemTools.hxx"
+
+#include "itkWasmComponentConversion.h"
+#include "itkWasmComponentTypeFromIOComponentEnum.h"
+
+#include "rapidjson/document.h"
+
+// The tags needed to sort the files into a series, as in gdcm::SerieHelper
+const gdcm::Tag SeriesInstanceUIDTag(0x0020, 0x000e);
+const gdcm::Tag ImagePositionPatientTag(0x0020, 0x0032);
+const gdcm::Tag ImageOrientationPatientTag(0x0020, 0x0037);
+const gdcm::Tag InstanceNumberTag(0x0020, 0x0013);
+// The series details of gdcm::SerieHelper::CreateDefaultUniqueSeriesIdentifier,
+// which split a series instance UID into series of one image geometry
+const gdcm::Tag SeriesNumberTag(0x0020, 0x0011);
+const gdcm::Tag SequenceNameTag(0x0018, 0x0024);
+const gdcm::Tag SliceThicknessTag(0x0018, 0x0050);
+const gdcm::Tag RowsTag(0x0028, 0x0010);
+const gdcm::Tag ColumnsTag(0x0028, 0x0011);
+const gdcm::Tag SeriesDetailTags[] = { SeriesNumberTag, SequenceNameTag, SliceThicknessTag, RowsTag, ColumnsTag };
+const gdcm::Tag SortTags[] = { SeriesInstanceUIDTag, ImagePositionPatientTag, ImageOrientationPatientTag, InstanceNumberTag,
+                               SeriesNumberTag,      SequenceNameTag,         SliceThicknessTag,          RowsTag,
+                               ColumnsTag };
+
+using SortTagValues = std::map<gdcm::Tag, std::string>;
+
+// Tag values of a --scan-cache entry, if its path and size match the file
+using ScanCache = std::map<std::string, std::pair<unsigned long, SortTagValues>>;
+
+inline ScanCache
+ParseScanCache(const std::string & scanCacheJSON)
+{
+  ScanCache scanCache;
+  rapidjson::Document document;
+  if (document.Parse(scanCacheJSON.c_str()).HasParseError() || !document.HasMember("files") ||
+      !document["files"].IsArray())
+  {
+    throw std::runtime_error("Could not parse the scan cache JSON");
+  }
+  for (const auto & file : document["files"].GetArray())
+  {
+    if (!file.HasMember("path") || !file.HasMember("size") || !file.HasMember("tags") || !file["path"].IsString() ||
+        !file["size"].IsUint64() || !file["tags"].IsObject())
+    {
+      throw std::runtime_error("Scan cache files must have a path, size and tags object");
+    }
+    SortTagValues values;
+    const rapidjson::Value & tags = file["tags"];
+    for (const gdcm::Tag & tag : SortTags)
+    {
+      const std::string key = tag.PrintAsPipeSeparatedString();
+      if (tags.HasMember(key.c_str()) && tags[key.c_str()].IsString())
+      {
+        values[tag] = tags[key.c_str()].GetString();
+      }
+    }
+    scanCache[file["path"].GetString()] = { static_cast<unsigned long>(file["size"].GetUint64()), values };
+  }
+  return scanCache;
+}
+
+inline std::string
+TrimValue(const char * value)
+{
+  std::string trimmed(value == nullptr ? "" : value);
+  while (!trimmed.empty() && (trimmed.back() == ' ' || trimmed.back() == '\0'))
+  {
+    trimmed.pop_back();
+  }
+  return trimmed;
+}
+
+// Backslash separated decimal strings
+template <unsigned int VCount>
+bool
+ParseDecimals(const SortTagValues & values, const gdcm::Tag & tag, double (&decimals)[VCount])
+{
+  const auto value = values.find(tag);
+  if (value == values.end())
+  {
+    return false;
+  }
+  std::istringstream stream(value->second);
+  for (unsigned int ii = 0; ii < VCount; ++ii)
+  {
+    if (ii > 0 && stream.get() != '\\')
+    {
+      return false;
+    }
+    if (!(stream >> decimals[ii]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The series instance UID followed by the series details, keeping only
+// alphanumeric characters and dots, as
+// gdcm::SerieHelper::CreateUniqueSeriesIdentifier with series details
+inline std::string
+SeriesIdentifier(const SortTagValues & values)
+{
+  const auto uidValue = values.find(SeriesInstanceUIDTag);
+  const std::string uid = uidValue == values.end() ? std::string() : TrimValue(uidValue->second.c_str());
+  std::string identifier = uid;
+  for (const gdcm::Tag & tag : SeriesDetailTags)
+  {
+    const auto value = values.find(tag);
+    const std::string detail = value == values.end() ? std::string() : value->second;
+    if (identifier == uid && !detail.empty())
+    {
+      identifier += '.';
+    }
+    identifier += detail;
+  }
+  identifier.erase(std::remove_if(identifier.begin(),
+                                  identifier.end(),
+                                  [](char c) {
+                                    return !(c == '.' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                                             (c >= '0' && c <= '9'));
+                                  }),
+                   identifier.end());
+  return identifier;
+}
+
+struct Slice
+{
+  std::string fileName;
+  SortTagValues values;
+};
+
+// Order the slices by image position along the slice normal, else by
+// instance number, else by file name, as gdcm::SerieHelper::OrderFileList.
+// Slices at the same position are not ordered by position.
+inline void
+OrderSlices(std::vector<Slice> & slices)
+{
+  std::vector<std::pair<double, size_t>> keys;
+  double firstOrientation[6];
+  if (!slices.empty() && ParseDecimals(slices[0].values, ImageOrientationPatientTag, firstOrientation))
+  {
+    const double normal[3] = { firstOrientation[1] * firstOrientation[5] - firstOrientation[2] * firstOrientation[4],
+                               firstOrientation[2] * firstOrientation[3] - firstOrientation[0] * firstOrientation[5],
+                               firstOrientation[0] * firstOrientation[4] - firstOrientation[1] * firstOrientation[3] };
+    for (size_t ii = 0; ii < slices.size(); ++ii)
+    {
+      double orientation[6];
+      double position[3];
+      if (!ParseDecimals(slices[ii].values, ImageOrientationPatientTag, orientation) ||
+          !std::equal(orientation, orientation + 6, firstOrientation) ||
+          !ParseDecimals(slices[ii].values, ImagePositionPatientTag, position))
+      {
+        keys.clear();
+        break;
+      }
+      keys.emplace_back(normal[0] * position[0] + normal[1] * position[1] + normal[2] * position[2], ii);
+    }
+    std::vector<double> distances;
+    distances.reserve(keys.size());
+    for (const auto & key : keys)
+    {
+      distances.push_back(key.first);
+    }
+    std::sort(distances.begin(), distances.end());
+    if (std::adjacent_find(distances.begin(), distances.end()) != distances.end())
+    {
+      // Two slices with the same position
+      keys.clear();
+    }
+  }
+
+  if (keys.empty())
+  {
+    for (size_t ii = 0; ii < slices.size(); ++ii)
+    {
+      double instanceNumber[1];
+      if (!ParseDecimals(slices[ii].values, InstanceNumberTag, instanceNumber))
+      {
+        keys.clear();
+        break;
+      }
+      keys.emplace_back(instanceNumber[0], ii);
+    }
+    const auto sameKey = [](const std::pair<double, size_t> & a, const std::pair<double, size_t> & b) {
+      return a.first == b.first;
+    };
+    if (!keys.empty() && std::adjacent_find(keys.begin(), keys.end(), std::not_fn(sameKey)) == keys.end())
+    {
+      // All images have the same number
+      keys.clear();
+    }
+  }
+
+  if (keys.empty())
+  {
+    std::sort(slices.begin(), slices.end(), [](const Slice & a, const Slice & b) { return a.fileName < b.fileName; });
+    return;
+  }
+  std::stable_sort(keys.begin(), keys.end(), [](const std::pair<double, size_t> & a, const std::pair<double, size_t> & b) {
+    return a.first < b.first;
+  });
+  std::vector<Slice> ordered;
+  ordered.reserve(slices.size());
+  for (const auto & key : keys)
+  {
+    ordered.push_back(std::move(slices[key.second]));
+  }
+  slices = std::move(ordered);
+}
+
+struct SortedSeries
+{
+  std::string              seriesInstanceUID;
+  std::vector<std::string> fileNames;
+};
+
+// The sorted file names of each series, by series identifier, see
+// SeriesIdentifier, in one scan of the files. Only the sort tags are scanned,
+// and scanning stops before the pixel data. Files with a matching
+// --scan-cache entry are not read.
+inline std::map<std::string, SortedSeries>
+SortSeries(const std::vector<std::string> & fileNames, const std::string & scanCacheJSON)
+{
+  const ScanCache scanCache = scanCacheJSON.empty() ? ScanCache{} : ParseScanCache(scanCacheJSON);
+
+  std::map<std::string, SortTagValues> fileValues;
+  gdcm::Directory::FilenamesType filesToScan;
+  for (const std::string & fileName : fileNames)
+  {
+    const auto cached = scanCache.find(fileName);
+    if (cached != scanCache.end() && cached->second.first == itksys::SystemTools::FileLength(fileName))
+    {
+      fileValues[fileName] = cached->second.second;
+    }
+    else
+    {
+      filesToScan.push_back(fileName);
+    }
+  }
+
+  if (!filesToScan.empty())
+  {
+    gdcm::Scanner scanner;
+    for (const gdcm::Tag & tag : SortTags)
+    {
+      scanner.AddTag(tag);
+    }
+    if (!scanner.Scan(filesToScan))
+    {
+      throw std::runtime_error("Could not scan the input DICOM files");
+    }
+    for (const std::string & fileName : filesToScan)
+    {
+      if (!scanner.IsKey(fileName.c_str()))
+      {
+        // Not a DICOM file
+        continue;
+      }
+      SortTagValues & values = fileValues[fileName];
+      for (const gdcm::Tag & tag : SortTags)
+      {
+        const char * value = scanner.GetValue(fileName.c_str(), tag);
+        if (value != nullptr)
+        {
+          values[tag] = value;
+        }
+      }
+    }
+  }
+
+  std::map<std::string, std::vector<Slice>> series;
+  for (const std::string & fileName : fileNames)
+  {
+    const auto values = fileValues.find(fileName);
+    if (values == fileValues.end())
+    {
+      continue;
+    }
+    series[SeriesIdentifier(values->second)].push_back(Slice{ fileName, values->second });
+  }
+  if (series.empty())
+  {
+    throw std::runtime_error("No DICOM series found in the input files");
+  }
+
+  std::map<std::string, SortedSeries> sortedSeries;
+  for (auto & entry : series)
+  {
+    OrderSlices(entry.second);
+    SortedSeries & sorted = sortedSeries[entry.first];
+    const auto uid = entry.second.front().values.find(SeriesInstanceUIDTag);
+    sorted.seriesInstanceUID = uid == entry.second.front().values.end() ? std::string() : TrimValue(uid->second.c_str());
+    for (const Slice & slice : entry.second)
+    {
+      sorted.fileNames.push_back(slice.fileName);
+    }
+  }
+  return sortedSeries;
+}
+
+template <typename TComponent, typename TSource>
+void
+RestoreStoredComponentsFrom(const void * source, size_t count, double slope, double intercept, TComponent * destination)
+{
+  const auto * sourceComponents = static_cast<const TSource *>(source);
+  const double scale = 1.0 / slope;
+  const double offset = -intercept / slope;
+  for (size_t ii = 0; ii < count; ++ii)
+  {
+    destination[ii] = itk::wasm::ConvertComponent<TComponent>(std::round(sourceComponents[ii] * scale + offset));
+  }
+}
+
+// Restore the stored values, (value - intercept) / slope, of count rescaled
+// components while converting them to the output component type. Returns
+// false if componentType is unknown.
+template <typename TComponent>
+bool
+RestoreStoredComponents(itk::IOComponentEnum componentType, const void * source, size_t count, double slope, double intercept, TComponent * destination)
+{
+  switch (componentType)
+  {
+    case itk::IOComponentEnum::UCHAR:
+      RestoreStoredComponentsFrom<TComponent, unsigned char>(source, count, slope, intercept, destination);
+      return true;
+    case itk::IOComponentEnum::CHAR:
+      RestoreStoredComponentsFrom<TComponent, signed char>(source, count, slope, intercept, destination);
+      return true;
+    case itk::IOComponentEnum::USHORT:
+      RestoreStoredComponentsFrom<TComponent, unsigned short>(source, count, slope, intercept, destination);
+      return true;
+    case itk::IOComponentEnum::SHORT:
+      RestoreStoredComponentsFrom<TComponent, short>(source, count, slope, intercept, destination);
+      return true;
+    case itk::IOComponentEnum::UINT:
+      RestoreStoredComponentsFrom<TComponent, unsigned int>(source, count, slope, intercept, destination);
+      return true;
+    case itk::IOComponentEnum::INT:
+      RestoreStoredComponentsFrom<TComponent, int>(source, count, slope, intercept, destination);
+      return true;
+    case itk::IOComponentEnum::ULONG:
+      RestoreStoredComponentsFrom<TComponent, unsigned long>(source, count, slope, intercept, destination);
+      return true;
+    case itk::IOComponentEnum::LONG:
+      RestoreStoredComponentsFrom<TComponent, long>(source, count, slope, intercept, destination);
+      return true;
+    case itk::IOComponentEnum::ULONGLONG:
+      RestoreStoredComponentsFrom<TComponent, unsigned long long>(source, count, slope, intercept, destination);
+      return true;
+    case itk::IOComponentEnum::LONGLONG:
+      RestoreStoredComponentsFrom<TComponent, long long>(source, count, slope, intercept, destination);
+      return true;
+    case itk::IOComponentEnum::FLOAT:
+      RestoreStoredComponentsFrom<TComponent, float>(source, count, slope, intercept, destination);
+      return true;
+    case itk::IOComponentEnum::DOUBLE:
+      RestoreStoredComponentsFrom<TComponent, double>(source, count, slope, intercept, destination);
+      return true;
+    default:
+      return false;
+  }
+}
+
+namespace itk
+{
+
+template <typename TOutputImage>
+class ITK_TEMPLATE_EXPORT QuickDICOMImageSeriesReader : public ImageSeriesReader<TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(QuickDICOMImageSeriesReader);
+
+  /** Standard class type aliases. */
+  using Self = QuickDICOMImageSeriesReader;
+  using Superclass = ImageSeriesReader<TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(QuickDICOMImageSeriesReader, ImageSeriesReader);
+
+  /** The size of the output image. */
+  using SizeType = typename TOutputImage::SizeType;
+
+  /** The index of the output image. */
+  using IndexType = typename TOutputImage::IndexType;
+
+  /** The region of the output image. */
+  using ImageRegionType = typename TOutputImage::RegionType;
+
+  /** The pixel type of the output image. */
+  using OutputImagePixelType = typename TOutputImage::PixelType;
+
+  /** The component type of the output image. */
+  using OutputComponentType = typename DefaultConvertPixelTraits<OutputImagePixelType>::ComponentType;
+
+  /** Restore the stored values of slices with a rescale slope or intercept,
+   * instead of the rescaled values read by GDCMImageIO. Off by default. */
+  itkSetMacro(StoredValues, bool);
+  itkGetConstMacro(StoredValues, bool);
+  itkBooleanMacro(StoredValues);
+
+protected:
+  QuickDICOMImageSeriesReader()
+    {
+    }
+
+  ~QuickDICOMImageSeriesReader() override
+    {
+    }
+
+  /** Does the real work. */
+  void
+  GenerateData() override
+    {
+      TOutputImage * output = this->GetOutput();
+
+      ImageRegionType requestedRegion = output->GetRequestedRegion();
+      ImageRegionType largestRegion = output->GetLargestPossibleRegion();
+      ImageRegionType sliceRegionToRequest = output->GetRequestedRegion();
+
+      // Each file must have the same size.
+      SizeType validSize = largestRegion.GetSize();
+
+      // If more than one file is being read, then the input dimension
+      // will be less than the output dimension.  In this case, set
+      // the last dimension that is other than 1 of validSize to 1.  However, if the
+      // input and output have the same number of dimensions, this should
+      // not be done because it will lower the dimension of the output image.
+      if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+      {
+        validSize[this->m_NumberOfDimensionsInImage] = 1;
+        sliceRegionToRequest.SetSize(this->m_NumberOfDimensionsInImage, 1);
+        sliceRegionToRequest.SetIndex(this->m_NumberOfDimensionsInImage, 0);
+      }
+
+      ImageIORegion imageIORegion(this->m_NumberOfDimensionsInImage);
+      for (unsigned int dim = 0; dim < this->m_NumberOfDimensionsInImage; ++dim) {
+        imageIORegion.SetSize(dim, sliceRegionToRequest.GetSize(dim));
+        imageIORegion.SetIndex(dim, sliceRegionToRequest.GetIndex(dim));
+      }
+      // the size of the buffer is computed based on the actual number of
+      // pixels to be read and the actual size of the pixels to be read
+      // (as opposed to the sizes of the output)
+      const size_t sizeOfActualIORegion =
+        imageIORegion.GetNumberOfPixels() * (this->m_ImageIO->GetComponentSize() * this->m_ImageIO->GetNumberOfComponents());
+
+
+      // Allocate the output buffer
+      output->SetBufferedRegion(requestedRegion);
+      output->Allocate();
+
+      typename TOutputImage::InternalPixelType * outputBuffer = output->GetBufferPointer();
+      const auto                                 numberOfFiles = static_cast<SizeValueType>(this->m_FileNames.size());
+
+      // Slices in the requested region are read in parallel. Each work unit
+      // reads a contiguous run of slices with its own ImageIO, whose header
+      // state is that of the ImageIO of the first file, as in a sequential
+      // read, and decodes each slice into its offset in the output buffer.
+      std::vector<SizeValueType> slices;
+      for (SizeValueType i = 0; i != numberOfFiles; ++i)
+      {
+        IndexType sliceStartIndex = requestedRegion.GetIndex();
+        if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+        {
+          sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
+        }
+        if (requestedRegion.IsInside(sliceStartIndex))
+        {
+          slices.push_back(i);
+        }
+      }
+
+      const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
+      using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
+      const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
+
+      const SizeValueType numberOfRuns =
+        std::min<SizeValueType>(slices.size(), std::max<SizeValueType>(this->GetNumberOfWorkUnits(), 1));
+      std::mutex         errorMutex;
+      std::exception_ptr error;
+      this->GetMultiThreader()->ParallelizeArray(
+        0,
+        numberOfRuns,
+        [&](SizeValueType run) {
+          // progress reported on a per slice basis
+          TotalProgressReporter progress(this, slices.size(), 100);
+          try
+          {
+            ImageIOBase::Pointer imageIO =
+              dynamic_cast<ImageIOBase *>(this->m_ImageIO->CreateAnother().GetPointer());
+            if (imageIO.IsNull())
+            {
+              itkExceptionMacro("Could not create an ImageIO for " << this->m_ImageIO->GetNameOfClass());
+            }
+            imageIO->SetFileName(this->m_FileNames[0].c_str());
+            imageIO->ReadImageInformation();
+
+            // Slices of another component type than the output, or whose
+            // stored values are restored, are read into a slice buffer and
+            // converted as they are copied into the output buffer, instead of
+            // in a pass over the volume after it is read
+            const auto * gdcmImageIO = dynamic_cast<const GDCMImageIO *>(imageIO.GetPointer());
+            const bool   restoreStoredValues = this->m_StoredValues && gdcmImageIO != nullptr &&
+                                           (gdcmImageIO->GetRescaleSlope() != 1.0 || gdcmImageIO->GetRescaleIntercept() != 0.0);
+            const bool   convertSlices =
+              restoreStoredValues || imageIO->GetComponentType() != ImageIOBase::MapPixelType<OutputComponentType>::CType;
+            const std::string sliceComponentType = WasmComponentTypeFromIOComponentEnum(imageIO->GetComponentType());
+            const size_t      numberOfComponentsInSlice = numberOfPixelsInSlice * imageIO->GetNumberOfComponents();
+            std::unique_ptr<char[]> sliceBuffer;
+            if (convertSlices)
+            {
+              sliceBuffer.reset(new char[sizeOfActualIORegion]);
+            }
+
+            const size_t firstSlice = slices.size() * run / numberOfRuns;
+            const size_t lastSlice = slices.size() * (run + 1) / numberOfRuns;
+            for (size_t slice = firstSlice; slice != lastSlice; ++slice)
+            {
+              {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (error)
+                {
+                  return;
+                }
+              }
+              const SizeValueType i = slices[slice];
+              imageIO->SetFileName(this->m_FileNames[i].c_str());
+              imageIO->SetIORegion(imageIORegion);
+
+              const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+                                              ? (static_cast<ptrdiff_t>(i) - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
+                                              : 0;
+
+              const ptrdiff_t numberOfPixelComponentsUpToSlice =
+                numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
+
+              typename TOutputImage::InternalPixelType * outputSliceBuffer =
+                outputBuffer + numberOfPixelComponentsUpToSlice;
+              if (!convertSlices)
+              {
+                imageIO->Read(outputSliceBuffer);
+              }
+              else
+              {
+                imageIO->Read(sliceBuffer.get());
+                auto * outputComponents = reinterpret_cast<OutputComponentType *>(outputSliceBuffer);
+                // The rescale slope and intercept applied to this slice
+                const bool rescaled = restoreStoredValues &&
+                                      (gdcmImageIO->GetRescaleSlope() != 1.0 || gdcmImageIO->GetRescaleIntercept() != 0.0);
+                const bool converted =
+                  rescaled ? RestoreStoredComponents(imageIO->GetComponentType(),
+                                                     sliceBuffer.get(),
+                                                     numberOfComponentsInSlice,
+                                                     gdcmImageIO->GetRescaleSlope(),
+                                                     gdcmImageIO->GetRescaleIntercept(),
+                                                     outputComponents)
+                           : wasm::ConvertComponents(sliceComponentType, sliceBuffer.get(), numberOfComponentsInSlice, outputComponents);
+                if (!converted)
+                {
+                  itkExceptionMacro("Cannot convert the " << sliceComponentType << " components of " << this->m_FileNames[i]);
+                }
+              }
+
+              // report progress for read slices
+              progress.CompletedPixel();
+            }
+          }
+          catch (...)
+          {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error)
+            {
+              error = std::current_exception();
+            }
+          }
+        },
+        nullptr);
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+    } // end GenerateData
+
+private:
+  bool m_StoredValues{ false };
+};
+
+} // end namespace itk
+
+#endif // readDICOMSeries_h
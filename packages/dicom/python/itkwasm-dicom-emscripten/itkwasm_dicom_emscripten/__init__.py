@@ -2,8 +2,11 @@
 
 from .apply_presentation_state_to_image_async import apply_presentation_state_to_image_async
 from .read_dicom_encapsulated_pdf_async import read_dicom_encapsulated_pdf_async
+from .structured_report_render_async import structured_report_render_async
 from .structured_report_to_html_async import structured_report_to_html_async
 from .structured_report_to_text_async import structured_report_to_text_async
 from .read_image_dicom_file_series_async import read_image_dicom_file_series_async
+from .read_dicom_tags_async import read_dicom_tags_async
+from .read_image_dicom_study_async import read_image_dicom_study_async
 
 from ._version import __version__
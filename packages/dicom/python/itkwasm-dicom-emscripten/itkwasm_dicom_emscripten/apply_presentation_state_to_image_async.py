@@ -23,6 +23,7 @@ async def apply_presentation_state_to_image_async(
     frame: int = 1,
     no_presentation_state_output: bool = False,
     no_bitmap_output: bool = False,
+    lut_output: bool = False,
 ) -> Tuple[Dict, Image]:
     """Apply a presentation state to a given DICOM image and render output as bitmap, or dicom file.
 
@@ -47,6 +48,9 @@ async def apply_presentation_state_to_image_async(
     :param no_bitmap_output: Do not get resulting image as bitmap output stream.
     :type  no_bitmap_output: bool
 
+    :param lut_output: Output the modality, VOI, and presentation LUTs of the frame in the presentation state information as LUTChain instead of the bitmap, to render the raw pixels on the client.
+    :type  lut_output: bool
+
     :return: Output overlay information
     :rtype:  Dict
 
@@ -67,6 +71,8 @@ async def apply_presentation_state_to_image_async(
         kwargs["noPresentationStateOutput"] = to_js(no_presentation_state_output)
     if no_bitmap_output:
         kwargs["noBitmapOutput"] = to_js(no_bitmap_output)
+    if lut_output:
+        kwargs["lutOutput"] = to_js(lut_output)
 
     outputs = await js_module.applyPresentationStateToImage(to_js(BinaryFile(image_in)), to_js(BinaryFile(presentation_state_file)), webWorker=web_worker, noCopy=True, **kwargs)
 
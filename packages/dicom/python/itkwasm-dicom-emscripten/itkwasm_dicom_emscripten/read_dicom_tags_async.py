@@ -0,0 +1,62 @@
+# Generated file. To retain edits, remove this comment.
+
+from pathlib import Path
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from .js_package import js_package
+
+from itkwasm.pyodide import (
+    to_js,
+    to_py,
+    js_resources
+)
+from itkwasm import (
+    InterfaceTypes,
+    BinaryFile,
+)
+
+async def read_dicom_tags_async(
+    dicom_file: os.PathLike,
+    dicom_files: Optional[os.PathLike] = None,
+    tags_to_read: Optional[Any] = None,
+) -> Any:
+    """Read the tags from a DICOM file
+
+    :param dicom_file: Input DICOM file.
+    :type  dicom_file: os.PathLike
+
+    :param dicom_files: Additional input DICOM files. When given, tags is a JSON array of {"file": file name, "tags": [[tag, value], ...]} objects for dicom-file and these files.
+    :type  dicom_files: os.PathLike
+
+    :param tags_to_read: A JSON object with a "tags" array of the tags to read. If not provided, all tags are read. Example tag: "0008|103e".
+    :type  tags_to_read: Any
+
+    :return: Output tags in the file. JSON object an array of [tag, value] arrays. Values are encoded as UTF-8 strings.
+    :rtype:  Any
+    """
+    js_module = await js_package.js_module
+    web_worker = js_resources.web_worker
+
+    kwargs = {}
+    if dicom_files is not None:
+        kwargs["dicomFiles"] = to_js(BinaryFile(dicom_files))
+    if tags_to_read is not None:
+        kwargs["tagsToRead"] = to_js(tags_to_read)
+
+    outputs = await js_module.readDicomTags(to_js(BinaryFile(dicom_file)), webWorker=web_worker, noCopy=True, **kwargs)
+
+    output_web_worker = None
+    output_list = []
+    outputs_object_map = outputs.as_object_map()
+    for output_name in outputs.object_keys():
+        if output_name == 'webWorker':
+            output_web_worker = outputs_object_map[output_name]
+        else:
+            output_list.append(to_py(outputs_object_map[output_name]))
+
+    js_resources.web_worker = output_web_worker
+
+    if len(output_list) == 1:
+        return output_list[0]
+    return tuple(output_list)
@@ -1,6 +1,6 @@
 from pathlib import Path
 import os
-from typing import Dict, Tuple, Optional, List
+from typing import Dict, Tuple, Optional, List, Any
 
 from .js_package import js_package
 
@@ -17,6 +17,11 @@ from itkwasm import (
 
 async def read_image_dicom_file_series_async(
     input_images: List[os.PathLike] = [],
+    scan_cache: Optional[Any] = None,
+    preview_slices: int = 0,
+    preview_shrink_factor: int = 1,
+    rescale_policy: str = "rescaled",
+    output_component_type: str = "",
     single_sorted_series: bool = False,
 ) -> Tuple[Image, List[str]]:
     """Read a DICOM image series and return the associated image volume
@@ -24,6 +29,21 @@ async def read_image_dicom_file_series_async(
     :param input_images: File names in the series
     :type  input_images: os.PathLike
 
+    :param scan_cache: Sort tags of files scanned before, as {"files": [{"path": file name, "size": bytes, "tags": {"0020|000e": value, ...}}]}, e.g. from read-dicom-tags. Files whose path and size match are not scanned.
+    :type  scan_cache: Any
+
+    :param preview_slices: Read only this many evenly spaced slices of the sorted series, e.g. 1 for the middle slice of a thumbnail. 0 reads all slices.
+    :type  preview_slices: int
+
+    :param preview_shrink_factor: Bin shrink the slices in-plane by this factor
+    :type  preview_shrink_factor: int
+
+    :param rescale_policy: rescaled: apply the rescale slope and intercept of the slices. stored: the stored values, e.g. to rescale them later.
+    :type  rescale_policy: str
+
+    :param output_component_type: Component type of the output image, e.g. int16 or float32, converted slice by slice as it is read. Float values are truncated toward zero. By default, that of the rescaled or stored values.
+    :type  output_component_type: str
+
     :param single_sorted_series: The input files are a single sorted series
     :type  single_sorted_series: bool
 
@@ -39,6 +59,16 @@ async def read_image_dicom_file_series_async(
     kwargs = {}
     if input_images is not None:
         kwargs["inputImages"] = to_js(BinaryFile(input_images))
+    if scan_cache is not None:
+        kwargs["scanCache"] = to_js(scan_cache)
+    if preview_slices:
+        kwargs["previewSlices"] = to_js(preview_slices)
+    if preview_shrink_factor:
+        kwargs["previewShrinkFactor"] = to_js(preview_shrink_factor)
+    if rescale_policy:
+        kwargs["rescalePolicy"] = to_js(rescale_policy)
+    if output_component_type:
+        kwargs["outputComponentType"] = to_js(output_component_type)
     if single_sorted_series:
         kwargs["singleSortedSeries"] = to_js(single_sorted_series)
 
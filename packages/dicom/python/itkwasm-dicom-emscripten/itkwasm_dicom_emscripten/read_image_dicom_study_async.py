@@ -0,0 +1,78 @@
+from pathlib import Path
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from .js_package import js_package
+
+from itkwasm.pyodide import (
+    to_js,
+    to_py,
+    js_resources
+)
+from itkwasm import (
+    InterfaceTypes,
+    Image,
+    BinaryFile,
+)
+
+async def read_image_dicom_study_async(
+    input_images: List[os.PathLike] = [],
+    scan_cache: Optional[Any] = None,
+    rescale_policy: str = "rescaled",
+    output_component_type: str = "",
+    max_series: Optional[int] = None,
+) -> Tuple[Any, List[Image]]:
+    """Read every DICOM image series in the input files, with one scan of their headers, and return the image volume of each series
+
+    :param input_images: File names in the study
+    :type  input_images: os.PathLike
+
+    :param scan_cache: Sort tags of files scanned before, as {"files": [{"path": file name, "size": bytes, "tags": {"0020|000e": value, ...}}]}, e.g. from read-dicom-tags. Files whose path and size match are not scanned.
+    :type  scan_cache: Any
+
+    :param rescale_policy: rescaled: apply the rescale slope and intercept of the slices. stored: the stored values, e.g. to rescale them later.
+    :type  rescale_policy: str
+
+    :param output_component_type: Component type of the output images, e.g. int16 or float32, converted slice by slice as they are read. Float values are truncated toward zero. By default, that of the rescaled or stored values of each series.
+    :type  output_component_type: str
+
+    :param max_series: Number of series image outputs. By default, the number of input images, so every series is read. Series past it have a null seriesImage in the study.
+    :type  max_series: int
+
+    :return: Series of the study, ordered by series instance UID and split by series number, sequence name, slice thickness, rows and columns, as [{"seriesInstanceUID": uid, "sortedFilenames": [file name, ...], "seriesImage": index in series-images, or null when there are more series than series-images}]
+    :rtype:  Any
+
+    :return: Output image volume of each series, in the order of study. Outputs past the number of series are not set.
+    :rtype:  List[Image]
+    """
+    js_module = await js_package.js_module
+    web_worker = js_resources.web_worker
+
+    kwargs = {}
+    if input_images is not None:
+        kwargs["inputImages"] = to_js(BinaryFile(input_images))
+    if scan_cache is not None:
+        kwargs["scanCache"] = to_js(scan_cache)
+    if rescale_policy:
+        kwargs["rescalePolicy"] = to_js(rescale_policy)
+    if output_component_type:
+        kwargs["outputComponentType"] = to_js(output_component_type)
+    if max_series is not None:
+        kwargs["maxSeries"] = to_js(max_series)
+
+    outputs = await js_module.readImageDicomStudy(webWorker=web_worker, noCopy=True, **kwargs)
+
+    output_web_worker = None
+    output_list = []
+    outputs_object_map = outputs.as_object_map()
+    for output_name in outputs.object_keys():
+        if output_name == 'webWorker':
+            output_web_worker = outputs_object_map[output_name]
+        else:
+            output_list.append(to_py(outputs_object_map[output_name]))
+
+    js_resources.web_worker = output_web_worker
+
+    if len(output_list) == 1:
+        return output_list[0]
+    return tuple(output_list)
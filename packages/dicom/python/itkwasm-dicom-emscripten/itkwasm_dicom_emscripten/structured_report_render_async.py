@@ -0,0 +1,81 @@
+# Generated file. To retain edits, remove this comment.
+
+from pathlib import Path
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from .js_package import js_package
+
+from itkwasm.pyodide import (
+    to_js,
+    to_py,
+    js_resources
+)
+from itkwasm import (
+    InterfaceTypes,
+    BinaryFile,
+    TextStream,
+)
+
+async def structured_report_render_async(
+    dicom_file: os.PathLike,
+    no_text: bool = False,
+    no_html: bool = False,
+    no_tags: bool = False,
+    url_prefix: str = "",
+) -> Tuple[str, str, Any]:
+    """Parse a DICOM structured report once and render its text, HTML and tags
+
+    :param dicom_file: Input DICOM file
+    :type  dicom_file: os.PathLike
+
+    :param no_text: Do not render the plain text output
+    :type  no_text: bool
+
+    :param no_html: Do not render the HTML output
+    :type  no_html: bool
+
+    :param no_tags: Do not write the tags output
+    :type  no_tags: bool
+
+    :param url_prefix: URL: string. Append specificed URL prefix to hyperlinks of referenced composite objects in the HTML document.
+    :type  url_prefix: str
+
+    :return: Output plain text, as structured-report-to-text
+    :rtype:  str
+
+    :return: Output HTML, as structured-report-to-html
+    :rtype:  str
+
+    :return: Output tags of the data set, as read-dicom-tags. JSON array of [tag, value] arrays.
+    :rtype:  Any
+    """
+    js_module = await js_package.js_module
+    web_worker = js_resources.web_worker
+
+    kwargs = {}
+    if no_text:
+        kwargs["noText"] = to_js(no_text)
+    if no_html:
+        kwargs["noHtml"] = to_js(no_html)
+    if no_tags:
+        kwargs["noTags"] = to_js(no_tags)
+    if url_prefix:
+        kwargs["urlPrefix"] = to_js(url_prefix)
+
+    outputs = await js_module.structuredReportRender(to_js(BinaryFile(dicom_file)), webWorker=web_worker, noCopy=True, **kwargs)
+
+    output_web_worker = None
+    output_list = []
+    outputs_object_map = outputs.as_object_map()
+    for output_name in outputs.object_keys():
+        if output_name == 'webWorker':
+            output_web_worker = outputs_object_map[output_name]
+        else:
+            output_list.append(to_py(outputs_object_map[output_name]))
+
+    js_resources.web_worker = output_web_worker
+
+    if len(output_list) == 1:
+        return output_list[0]
+    return tuple(output_list)
@@ -23,6 +23,7 @@ def apply_presentation_state_to_image(
     frame: int = 1,
     no_presentation_state_output: bool = False,
     no_bitmap_output: bool = False,
+    lut_output: bool = False,
 ) -> Tuple[Dict, Image]:
     """Apply a presentation state to a given DICOM image and render output as bitmap, or dicom file.
 
@@ -47,6 +48,9 @@ def apply_presentation_state_to_image(
     :param no_bitmap_output: Do not get resulting image as bitmap output stream.
     :type  no_bitmap_output: bool
 
+    :param lut_output: Output the modality, VOI, and presentation LUTs of the frame in the presentation state information as LUTChain instead of the bitmap, to render the raw pixels on the client.
+    :type  lut_output: bool
+
     :return: Output overlay information
     :rtype:  Dict
 
@@ -96,6 +100,9 @@ def apply_presentation_state_to_image(
     if no_bitmap_output:
         args.append('--no-bitmap-output')
 
+    if lut_output:
+        args.append('--lut-output')
+
 
     outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
 
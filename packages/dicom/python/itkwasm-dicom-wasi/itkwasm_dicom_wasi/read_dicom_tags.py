@@ -0,0 +1,78 @@
+from pathlib import Path, PurePosixPath
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from importlib_resources import files as file_resources
+
+_pipeline = None
+
+from itkwasm import (
+    InterfaceTypes,
+    PipelineOutput,
+    PipelineInput,
+    Pipeline,
+    BinaryFile,
+)
+
+def read_dicom_tags(
+    dicom_file: os.PathLike,
+    dicom_files: Optional[os.PathLike] = None,
+    tags_to_read: Optional[Any] = None,
+) -> Any:
+    """Read the tags from a DICOM file
+
+    :param dicom_file: Input DICOM file.
+    :type  dicom_file: os.PathLike
+
+    :param dicom_files: Additional input DICOM files. When given, tags is a JSON array of {"file": file name, "tags": [[tag, value], ...]} objects for dicom-file and these files.
+    :type  dicom_files: os.PathLike
+
+    :param tags_to_read: A JSON object with a "tags" array of the tags to read. If not provided, all tags are read. Example tag: "0008|103e".
+    :type  tags_to_read: Any
+
+    :return: Output tags in the file. JSON object an array of [tag, value] arrays. Values are encoded as UTF-8 strings.
+    :rtype:  Any
+    """
+    global _pipeline
+    if _pipeline is None:
+        _pipeline = Pipeline(file_resources('itkwasm_dicom_wasi').joinpath(Path('wasm_modules') / Path('read-dicom-tags.wasi.wasm')))
+
+    pipeline_outputs: List[PipelineOutput] = [
+        PipelineOutput(InterfaceTypes.JsonCompatible),
+    ]
+
+    pipeline_inputs: List[PipelineInput] = [
+        PipelineInput(InterfaceTypes.BinaryFile, BinaryFile(PurePosixPath(dicom_file))),
+    ]
+
+    args: List[str] = ['--memory-io',]
+    # Inputs
+    if not Path(dicom_file).exists():
+        raise FileNotFoundError("dicom_file does not exist")
+    args.append(str(PurePosixPath(dicom_file)))
+    # Outputs
+    tags_name = '0'
+    args.append(tags_name)
+
+    # Options
+    if dicom_files is not None and len(dicom_files) < 1:
+       raise ValueError('"dicom-files" kwarg must have a length > 1')
+    if dicom_files is not None and len(dicom_files) > 0:
+        args.append('--dicom-files')
+        for value in dicom_files:
+            input_file = str(PurePosixPath(value))
+            pipeline_inputs.append(PipelineInput(InterfaceTypes.BinaryFile, BinaryFile(value)))
+            args.append(input_file)
+
+    if tags_to_read is not None:
+        input_count_string = str(len(pipeline_inputs))
+        pipeline_inputs.append(PipelineInput(InterfaceTypes.JsonCompatible, tags_to_read))
+        args.append('--tags-to-read')
+        args.append(input_count_string)
+
+
+    outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
+
+    result = outputs[0].data
+    return result
+
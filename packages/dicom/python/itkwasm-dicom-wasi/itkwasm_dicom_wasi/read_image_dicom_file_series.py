@@ -1,6 +1,6 @@
 from pathlib import Path, PurePosixPath
 import os
-from typing import Dict, Tuple, Optional, List
+from typing import Dict, Tuple, Optional, List, Any
 
 from importlib_resources import files as file_resources
 
@@ -17,6 +17,11 @@ from itkwasm import (
 
 def read_image_dicom_file_series(
     input_images: List[os.PathLike] = [],
+    scan_cache: Optional[Any] = None,
+    preview_slices: int = 0,
+    preview_shrink_factor: int = 1,
+    rescale_policy: str = "rescaled",
+    output_component_type: str = "",
     single_sorted_series: bool = False,
 ) -> Tuple[Image, List[str]]:
     """Read a DICOM image series and return the associated image volume
@@ -24,6 +29,21 @@ def read_image_dicom_file_series(
     :param input_images: File names in the series
     :type  input_images: os.PathLike
 
+    :param scan_cache: Sort tags of files scanned before, as {"files": [{"path": file name, "size": bytes, "tags": {"0020|000e": value, ...}}]}, e.g. from read-dicom-tags. Files whose path and size match are not scanned.
+    :type  scan_cache: Any
+
+    :param preview_slices: Read only this many evenly spaced slices of the sorted series, e.g. 1 for the middle slice of a thumbnail. 0 reads all slices.
+    :type  preview_slices: int
+
+    :param preview_shrink_factor: Bin shrink the slices in-plane by this factor
+    :type  preview_shrink_factor: int
+
+    :param rescale_policy: rescaled: apply the rescale slope and intercept of the slices. stored: the stored values, e.g. to rescale them later.
+    :type  rescale_policy: str
+
+    :param output_component_type: Component type of the output image, e.g. int16 or float32, converted slice by slice as it is read. Float values are truncated toward zero. By default, that of the rescaled or stored values.
+    :type  output_component_type: str
+
     :param single_sorted_series: The input files are a single sorted series
     :type  single_sorted_series: bool
 
@@ -60,6 +80,28 @@ def read_image_dicom_file_series(
             pipeline_inputs.append(PipelineInput(InterfaceTypes.BinaryFile, BinaryFile(value)))
             args.append(input_file)
 
+    if scan_cache is not None:
+        input_count_string = str(len(pipeline_inputs))
+        pipeline_inputs.append(PipelineInput(InterfaceTypes.JsonCompatible, scan_cache))
+        args.append('--scan-cache')
+        args.append(input_count_string)
+
+    if preview_slices:
+        args.append('--preview-slices')
+        args.append(str(preview_slices))
+
+    if preview_shrink_factor:
+        args.append('--preview-shrink-factor')
+        args.append(str(preview_shrink_factor))
+
+    if rescale_policy:
+        args.append('--rescale-policy')
+        args.append(str(rescale_policy))
+
+    if output_component_type:
+        args.append('--output-component-type')
+        args.append(str(output_component_type))
+
     if single_sorted_series:
         args.append('--single-sorted-series')
 
@@ -0,0 +1,106 @@
+from pathlib import Path, PurePosixPath
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from importlib_resources import files as file_resources
+
+_pipeline = None
+
+from itkwasm import (
+    InterfaceTypes,
+    PipelineOutput,
+    PipelineInput,
+    Pipeline,
+    Image,
+    BinaryFile,
+)
+
+def read_image_dicom_study(
+    input_images: List[os.PathLike] = [],
+    scan_cache: Optional[Any] = None,
+    rescale_policy: str = "rescaled",
+    output_component_type: str = "",
+    max_series: Optional[int] = None,
+) -> Tuple[Any, List[Image]]:
+    """Read every DICOM image series in the input files, with one scan of their headers, and return the image volume of each series
+
+    :param input_images: File names in the study
+    :type  input_images: os.PathLike
+
+    :param scan_cache: Sort tags of files scanned before, as {"files": [{"path": file name, "size": bytes, "tags": {"0020|000e": value, ...}}]}, e.g. from read-dicom-tags. Files whose path and size match are not scanned.
+    :type  scan_cache: Any
+
+    :param rescale_policy: rescaled: apply the rescale slope and intercept of the slices. stored: the stored values, e.g. to rescale them later.
+    :type  rescale_policy: str
+
+    :param output_component_type: Component type of the output images, e.g. int16 or float32, converted slice by slice as they are read. Float values are truncated toward zero. By default, that of the rescaled or stored values of each series.
+    :type  output_component_type: str
+
+    :param max_series: Number of series image outputs. By default, the number of input images, so every series is read. Series past it have a null seriesImage in the study.
+    :type  max_series: int
+
+    :return: Series of the study, ordered by series instance UID and split by series number, sequence name, slice thickness, rows and columns, as [{"seriesInstanceUID": uid, "sortedFilenames": [file name, ...], "seriesImage": index in series-images, or null when there are more series than series-images}]
+    :rtype:  Any
+
+    :return: Output image volume of each series, in the order of study. Outputs past the number of series are not set.
+    :rtype:  List[Image]
+    """
+    global _pipeline
+    if _pipeline is None:
+        _pipeline = Pipeline(file_resources('itkwasm_dicom_wasi').joinpath(Path('wasm_modules') / Path('read-image-dicom-study.wasi.wasm')))
+
+    # Each series has at least one file, so there are at most as many series
+    # as input images. Outputs past the number of series are not set.
+    if max_series is None:
+        max_series = len(input_images)
+    pipeline_outputs: List[PipelineOutput] = [
+        PipelineOutput(InterfaceTypes.JsonCompatible),
+    ]
+    for _ in range(max_series):
+        pipeline_outputs.append(PipelineOutput(InterfaceTypes.Image))
+
+    pipeline_inputs: List[PipelineInput] = [
+    ]
+
+    args: List[str] = ['--memory-io',]
+    # Inputs
+    # Outputs
+    study_name = '0'
+    args.append(study_name)
+
+    for index in range(1, max_series + 1):
+        args.append(str(index))
+
+    # Options
+    if len(input_images) < 1:
+       raise ValueError('"input-images" kwarg must have a length > 1')
+    if len(input_images) > 0:
+        args.append('--input-images')
+        for value in input_images:
+            input_file = str(PurePosixPath(value))
+            pipeline_inputs.append(PipelineInput(InterfaceTypes.BinaryFile, BinaryFile(value)))
+            args.append(input_file)
+
+    if scan_cache is not None:
+        input_count_string = str(len(pipeline_inputs))
+        pipeline_inputs.append(PipelineInput(InterfaceTypes.JsonCompatible, scan_cache))
+        args.append('--scan-cache')
+        args.append(input_count_string)
+
+    if rescale_policy:
+        args.append('--rescale-policy')
+        args.append(str(rescale_policy))
+
+    if output_component_type:
+        args.append('--output-component-type')
+        args.append(str(output_component_type))
+
+
+    outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
+
+    result = (
+        outputs[0].data,
+        [output.data for output in outputs[1:] if output.data is not None],
+    )
+    return result
+
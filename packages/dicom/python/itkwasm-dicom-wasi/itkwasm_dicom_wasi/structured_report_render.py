@@ -0,0 +1,106 @@
+# Generated file. To retain edits, remove this comment.
+
+from pathlib import Path, PurePosixPath
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from importlib_resources import files as file_resources
+
+_pipeline = None
+
+from itkwasm import (
+    InterfaceTypes,
+    PipelineOutput,
+    PipelineInput,
+    Pipeline,
+    BinaryFile,
+    TextStream,
+)
+
+def structured_report_render(
+    dicom_file: os.PathLike,
+    no_text: bool = False,
+    no_html: bool = False,
+    no_tags: bool = False,
+    url_prefix: str = "",
+) -> Tuple[str, str, Any]:
+    """Parse a DICOM structured report once and render its text, HTML and tags
+
+    :param dicom_file: Input DICOM file
+    :type  dicom_file: os.PathLike
+
+    :param no_text: Do not render the plain text output
+    :type  no_text: bool
+
+    :param no_html: Do not render the HTML output
+    :type  no_html: bool
+
+    :param no_tags: Do not write the tags output
+    :type  no_tags: bool
+
+    :param url_prefix: URL: string. Append specificed URL prefix to hyperlinks of referenced composite objects in the HTML document.
+    :type  url_prefix: str
+
+    :return: Output plain text, as structured-report-to-text
+    :rtype:  str
+
+    :return: Output HTML, as structured-report-to-html
+    :rtype:  str
+
+    :return: Output tags of the data set, as read-dicom-tags. JSON array of [tag, value] arrays.
+    :rtype:  Any
+    """
+    global _pipeline
+    if _pipeline is None:
+        _pipeline = Pipeline(file_resources('itkwasm_dicom_wasi').joinpath(Path('wasm_modules') / Path('structured-report-render.wasi.wasm')))
+
+    pipeline_outputs: List[PipelineOutput] = [
+        PipelineOutput(InterfaceTypes.TextStream),
+        PipelineOutput(InterfaceTypes.TextStream),
+        PipelineOutput(InterfaceTypes.JsonCompatible),
+    ]
+
+    pipeline_inputs: List[PipelineInput] = [
+        PipelineInput(InterfaceTypes.BinaryFile, BinaryFile(PurePosixPath(dicom_file))),
+    ]
+
+    args: List[str] = ['--memory-io',]
+    # Inputs
+    if not Path(dicom_file).exists():
+        raise FileNotFoundError("dicom_file does not exist")
+    args.append(str(PurePosixPath(dicom_file)))
+    # Outputs
+    output_text_name = '0'
+    args.append(output_text_name)
+
+    output_html_name = '1'
+    args.append(output_html_name)
+
+    tags_name = '2'
+    args.append(tags_name)
+
+    # Options
+    input_count = len(pipeline_inputs)
+    if no_text:
+        args.append('--no-text')
+
+    if no_html:
+        args.append('--no-html')
+
+    if no_tags:
+        args.append('--no-tags')
+
+    if url_prefix:
+        args.append('--url-prefix')
+        args.append(str(url_prefix))
+
+
+    outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
+
+    result = (
+        outputs[0].data.data,
+        outputs[1].data.data,
+        outputs[2].data,
+    )
+    return result
+
@@ -1,8 +1,24 @@
-# Generated file. To retain edits, remove this comment.
-
 from itkwasm_dicom_wasi import apply_presentation_state_to_image
 
 from .common import test_input_path, test_output_path
 
 def test_apply_presentation_state_to_image():
     pass
+
+def test_apply_presentation_state_to_image_lut_output():
+    image_in = test_input_path / 'gsps-pstate-test-input-image.dcm'
+    presentation_state_file = test_input_path / 'gsps-pstate-test-input-pstate.dcm'
+
+    presentation_state_out_stream, output_image = apply_presentation_state_to_image(image_in, presentation_state_file, lut_output=True)
+
+    # The LUTs replace the rendered bitmap
+    assert output_image is None
+
+    lut_chain = presentation_state_out_stream['LUTChain']
+    assert lut_chain['Frame'] == 1
+    assert lut_chain['BitsStored'] > 0
+    assert 'ModalityLUT' in lut_chain
+    assert 'PresentationLUT' in lut_chain
+    if 'CurrentWindowCenter' in presentation_state_out_stream:
+        assert lut_chain['VOILUT']['WindowCenter'] == presentation_state_out_stream['CurrentWindowCenter']
+        assert lut_chain['VOILUT']['WindowWidth'] == presentation_state_out_stream['CurrentWindowWidth']
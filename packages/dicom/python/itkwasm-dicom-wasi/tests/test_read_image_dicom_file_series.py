@@ -1,8 +1,47 @@
-# Generated file. To retain edits, remove this comment.
+import re
+import shutil
 
 from itkwasm_dicom_wasi import read_image_dicom_file_series
 
 from .common import test_input_path, test_output_path
 
+test_series_files = sorted((test_input_path / "DicomImageOrientationTest").glob("*.dcm"))
+
 def test_read_image_dicom_file_series():
-    pass
+    output_image, sorted_filenames = read_image_dicom_file_series(input_images=test_series_files)
+    assert output_image.size == [256, 256, 3]
+    assert [str(f).split("/")[-1] for f in sorted_filenames] == ["1.dcm", "2.dcm", "3.dcm"]
+
+def copy_with_series_number(input_file, output_file):
+    """A copy of a file with another series number, 0020|0011, in explicit or implicit VR."""
+    data = bytearray(input_file.read_bytes())
+    tag_offset = data.index(b"\x20\x00\x11\x00", 132)
+    explicit_vr = data[tag_offset + 4:tag_offset + 6] == b"IS"
+    if explicit_vr:
+        length = int.from_bytes(data[tag_offset + 6:tag_offset + 8], "little")
+    else:
+        length = int.from_bytes(data[tag_offset + 4:tag_offset + 8], "little")
+    value_offset = tag_offset + 8
+    value = data[value_offset:value_offset + length].decode("latin-1")
+    value = re.sub(r"[0-9]", lambda digit: "8" if digit.group(0) == "9" else "9", value, count=1)
+    data[value_offset:value_offset + length] = value.encode("latin-1")
+    output_file.write_bytes(bytes(data))
+
+def test_read_image_dicom_file_series_split_by_series_number():
+    output_directory = test_output_path / "mixed-series"
+    shutil.rmtree(output_directory, ignore_errors=True)
+    output_directory.mkdir(parents=True)
+    other_series_file = output_directory / "other-series.dcm"
+    copy_with_series_number(test_series_files[0], other_series_file)
+
+    output_image, sorted_filenames = read_image_dicom_file_series(input_images=test_series_files + [other_series_file])
+
+    # The copy shares the series instance UID and the position of 1.dcm, but
+    # it is not stacked with the other slices
+    names = [str(f).split("/")[-1] for f in sorted_filenames]
+    if len(names) == 1:
+        assert names == ["other-series.dcm"]
+        assert output_image.size[2] == 1
+    else:
+        assert names == ["1.dcm", "2.dcm", "3.dcm"]
+        assert output_image.size[2] == 3
@@ -0,0 +1,8 @@
+# Generated file. To retain edits, remove this comment.
+
+from itkwasm_dicom_wasi import read_image_dicom_study
+
+from .common import test_input_path, test_output_path
+
+def test_read_image_dicom_study():
+    pass
@@ -4,11 +4,17 @@ from .apply_presentation_state_to_image_async import apply_presentation_state_to
 from .apply_presentation_state_to_image import apply_presentation_state_to_image
 from .read_dicom_encapsulated_pdf_async import read_dicom_encapsulated_pdf_async
 from .read_dicom_encapsulated_pdf import read_dicom_encapsulated_pdf
+from .structured_report_render_async import structured_report_render_async
+from .structured_report_render import structured_report_render
 from .structured_report_to_html_async import structured_report_to_html_async
 from .structured_report_to_html import structured_report_to_html
 from .structured_report_to_text_async import structured_report_to_text_async
 from .structured_report_to_text import structured_report_to_text
 from .read_image_dicom_file_series_async import read_image_dicom_file_series_async
 from .read_image_dicom_file_series import read_image_dicom_file_series
+from .read_dicom_tags_async import read_dicom_tags_async
+from .read_dicom_tags import read_dicom_tags
+from .read_image_dicom_study_async import read_image_dicom_study_async
+from .read_image_dicom_study import read_image_dicom_study
 
 from ._version import __version__
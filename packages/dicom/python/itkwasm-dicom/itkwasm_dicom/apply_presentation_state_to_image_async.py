@@ -17,6 +17,7 @@ async def apply_presentation_state_to_image_async(
     frame: int = 1,
     no_presentation_state_output: bool = False,
     no_bitmap_output: bool = False,
+    lut_output: bool = False,
 ) -> Tuple[Any, Image]:
     """Apply a presentation state to a given DICOM image and render output as bitmap, or dicom file.
 
@@ -41,6 +42,9 @@ async def apply_presentation_state_to_image_async(
     :param no_bitmap_output: Do not get resulting image as bitmap output stream.
     :type  no_bitmap_output: bool
 
+    :param lut_output: Output the modality, VOI, and presentation LUTs of the frame in the presentation state information as LUTChain instead of the bitmap, to render the raw pixels on the client.
+    :type  lut_output: bool
+
     :return: Output overlay information
     :rtype:  Any
 
@@ -48,5 +52,5 @@ async def apply_presentation_state_to_image_async(
     :rtype:  Image
     """
     func = environment_dispatch("itkwasm_dicom", "apply_presentation_state_to_image_async")
-    output = await func(image_in, presentation_state_file, color_output=color_output, config_file=config_file, frame=frame, no_presentation_state_output=no_presentation_state_output, no_bitmap_output=no_bitmap_output)
+    output = await func(image_in, presentation_state_file, color_output=color_output, config_file=config_file, frame=frame, no_presentation_state_output=no_presentation_state_output, no_bitmap_output=no_bitmap_output, lut_output=lut_output)
     return output
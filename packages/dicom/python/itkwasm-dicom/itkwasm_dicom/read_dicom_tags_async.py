@@ -0,0 +1,32 @@
+# Generated file. Do not edit.
+
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from itkwasm import (
+    environment_dispatch,
+    BinaryFile,
+)
+
+async def read_dicom_tags_async(
+    dicom_file: os.PathLike,
+    dicom_files: Optional[os.PathLike] = None,
+    tags_to_read: Optional[Any] = None,
+) -> Any:
+    """Read the tags from a DICOM file
+
+    :param dicom_file: Input DICOM file.
+    :type  dicom_file: os.PathLike
+
+    :param dicom_files: Additional input DICOM files. When given, tags is a JSON array of {"file": file name, "tags": [[tag, value], ...]} objects for dicom-file and these files.
+    :type  dicom_files: os.PathLike
+
+    :param tags_to_read: A JSON object with a "tags" array of the tags to read. If not provided, all tags are read. Example tag: "0008|103e".
+    :type  tags_to_read: Any
+
+    :return: Output tags in the file. JSON object an array of [tag, value] arrays. Values are encoded as UTF-8 strings.
+    :rtype:  Any
+    """
+    func = environment_dispatch("itkwasm_dicom", "read_dicom_tags_async")
+    output = await func(dicom_file, dicom_files=dicom_files, tags_to_read=tags_to_read)
+    return output
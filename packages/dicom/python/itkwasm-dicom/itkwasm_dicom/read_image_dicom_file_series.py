@@ -11,6 +11,11 @@ from itkwasm import (
 
 def read_image_dicom_file_series(
     input_images: List[os.PathLike] = [],
+    scan_cache: Optional[Any] = None,
+    preview_slices: int = 0,
+    preview_shrink_factor: int = 1,
+    rescale_policy: str = "rescaled",
+    output_component_type: str = "",
     single_sorted_series: bool = False,
 ) -> Tuple[Image, Any]:
     """Read a DICOM image series and return the associated image volume
@@ -18,6 +23,21 @@ def read_image_dicom_file_series(
     :param input_images: File names in the series
     :type  input_images: os.PathLike
 
+    :param scan_cache: Sort tags of files scanned before, as {"files": [{"path": file name, "size": bytes, "tags": {"0020|000e": value, ...}}]}, e.g. from read-dicom-tags. Files whose path and size match are not scanned.
+    :type  scan_cache: Any
+
+    :param preview_slices: Read only this many evenly spaced slices of the sorted series, e.g. 1 for the middle slice of a thumbnail. 0 reads all slices.
+    :type  preview_slices: int
+
+    :param preview_shrink_factor: Bin shrink the slices in-plane by this factor
+    :type  preview_shrink_factor: int
+
+    :param rescale_policy: rescaled: apply the rescale slope and intercept of the slices. stored: the stored values, e.g. to rescale them later.
+    :type  rescale_policy: str
+
+    :param output_component_type: Component type of the output image, e.g. int16 or float32, converted slice by slice as it is read. Float values are truncated toward zero. By default, that of the rescaled or stored values.
+    :type  output_component_type: str
+
     :param single_sorted_series: The input files are a single sorted series
     :type  single_sorted_series: bool
 
@@ -28,5 +48,5 @@ def read_image_dicom_file_series(
     :rtype:  Any
     """
     func = environment_dispatch("itkwasm_dicom", "read_image_dicom_file_series")
-    output = func(input_images=input_images, single_sorted_series=single_sorted_series)
+    output = func(input_images=input_images, scan_cache=scan_cache, preview_slices=preview_slices, preview_shrink_factor=preview_shrink_factor, rescale_policy=rescale_policy, output_component_type=output_component_type, single_sorted_series=single_sorted_series)
     return output
@@ -0,0 +1,42 @@
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from itkwasm import (
+    environment_dispatch,
+    Image,
+    BinaryFile,
+)
+
+def read_image_dicom_study(
+    input_images: List[os.PathLike] = [],
+    scan_cache: Optional[Any] = None,
+    rescale_policy: str = "rescaled",
+    output_component_type: str = "",
+    max_series: Optional[int] = None,
+) -> Tuple[Any, List[Image]]:
+    """Read every DICOM image series in the input files, with one scan of their headers, and return the image volume of each series
+
+    :param input_images: File names in the study
+    :type  input_images: os.PathLike
+
+    :param scan_cache: Sort tags of files scanned before, as {"files": [{"path": file name, "size": bytes, "tags": {"0020|000e": value, ...}}]}, e.g. from read-dicom-tags. Files whose path and size match are not scanned.
+    :type  scan_cache: Any
+
+    :param rescale_policy: rescaled: apply the rescale slope and intercept of the slices. stored: the stored values, e.g. to rescale them later.
+    :type  rescale_policy: str
+
+    :param output_component_type: Component type of the output images, e.g. int16 or float32, converted slice by slice as they are read. Float values are truncated toward zero. By default, that of the rescaled or stored values of each series.
+    :type  output_component_type: str
+
+    :param max_series: Number of series image outputs. By default, the number of input images, so every series is read. Series past it have a null seriesImage in the study.
+    :type  max_series: int
+
+    :return: Series of the study, ordered by series instance UID and split by series number, sequence name, slice thickness, rows and columns, as [{"seriesInstanceUID": uid, "sortedFilenames": [file name, ...], "seriesImage": index in series-images, or null when there are more series than series-images}]
+    :rtype:  Any
+
+    :return: Output image volume of each series, in the order of study. Outputs past the number of series are not set.
+    :rtype:  List[Image]
+    """
+    func = environment_dispatch("itkwasm_dicom", "read_image_dicom_study")
+    output = func(input_images=input_images, scan_cache=scan_cache, rescale_policy=rescale_policy, output_component_type=output_component_type, max_series=max_series)
+    return output
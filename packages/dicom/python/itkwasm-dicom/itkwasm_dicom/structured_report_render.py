@@ -0,0 +1,47 @@
+# Generated file. Do not edit.
+
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from itkwasm import (
+    environment_dispatch,
+    BinaryFile,
+    TextStream,
+)
+
+def structured_report_render(
+    dicom_file: os.PathLike,
+    no_text: bool = False,
+    no_html: bool = False,
+    no_tags: bool = False,
+    url_prefix: str = "",
+) -> Tuple[str, str, Any]:
+    """Parse a DICOM structured report once and render its text, HTML and tags
+
+    :param dicom_file: Input DICOM file
+    :type  dicom_file: os.PathLike
+
+    :param no_text: Do not render the plain text output
+    :type  no_text: bool
+
+    :param no_html: Do not render the HTML output
+    :type  no_html: bool
+
+    :param no_tags: Do not write the tags output
+    :type  no_tags: bool
+
+    :param url_prefix: URL: string. Append specificed URL prefix to hyperlinks of referenced composite objects in the HTML document.
+    :type  url_prefix: str
+
+    :return: Output plain text, as structured-report-to-text
+    :rtype:  str
+
+    :return: Output HTML, as structured-report-to-html
+    :rtype:  str
+
+    :return: Output tags of the data set, as read-dicom-tags. JSON array of [tag, value] arrays.
+    :rtype:  Any
+    """
+    func = environment_dispatch("itkwasm_dicom", "structured_report_render")
+    output = func(dicom_file, no_text=no_text, no_html=no_html, no_tags=no_tags, url_prefix=url_prefix)
+    return output
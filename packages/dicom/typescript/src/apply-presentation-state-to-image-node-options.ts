@@ -16,6 +16,9 @@ interface ApplyPresentationStateToImageNodeOptions {
   /** Do not get resulting image as bitmap output stream. */
   noBitmapOutput?: boolean
 
+  /** Output the modality, VOI, and presentation LUTs of the frame in the presentation state information as LUTChain instead of the bitmap, to render the raw pixels on the client. */
+  lutOutput?: boolean
+
 }
 
 export default ApplyPresentationStateToImageNodeOptions
@@ -78,6 +78,9 @@ async function applyPresentationStateToImageNode(
   if (options.noBitmapOutput) {
     options.noBitmapOutput && args.push('--no-bitmap-output')
   }
+  if (options.lutOutput) {
+    options.lutOutput && args.push('--lut-output')
+  }
 
   const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'apply-presentation-state-to-image')
 
@@ -87,6 +87,9 @@ async function applyPresentationStateToImage(
   if (options.noBitmapOutput) {
     options.noBitmapOutput && args.push('--no-bitmap-output')
   }
+  if (options.lutOutput) {
+    options.lutOutput && args.push('--lut-output')
+  }
 
   const pipelinePath = 'apply-presentation-state-to-image'
 
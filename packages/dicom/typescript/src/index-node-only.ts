@@ -22,6 +22,16 @@ import readDicomEncapsulatedPdfNode from './read-dicom-encapsulated-pdf-node.js'
 export { readDicomEncapsulatedPdfNode }
 
 
+import StructuredReportRenderNodeResult from './structured-report-render-node-result.js'
+export type { StructuredReportRenderNodeResult }
+
+import StructuredReportRenderNodeOptions from './structured-report-render-node-options.js'
+export type { StructuredReportRenderNodeOptions }
+
+import structuredReportRenderNode from './structured-report-render-node.js'
+export { structuredReportRenderNode }
+
+
 import StructuredReportToHtmlNodeResult from './structured-report-to-html-node-result.js'
 export type { StructuredReportToHtmlNodeResult }
 
@@ -60,3 +70,13 @@ export type { ReadImageDicomFileSeriesNodeOptions }
 
 import readImageDicomFileSeriesNode from './read-image-dicom-file-series-node.js'
 export { readImageDicomFileSeriesNode }
+
+
+import ReadImageDicomStudyNodeResult from './read-image-dicom-study-node-result.js'
+export type { ReadImageDicomStudyNodeResult }
+
+import ReadImageDicomStudyNodeOptions from './read-image-dicom-study-node-options.js'
+export type { ReadImageDicomStudyNodeOptions }
+
+import readImageDicomStudyNode from './read-image-dicom-study-node.js'
+export { readImageDicomStudyNode }
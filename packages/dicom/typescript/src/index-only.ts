@@ -23,6 +23,16 @@ import readDicomEncapsulatedPdf from './read-dicom-encapsulated-pdf.js'
 export { readDicomEncapsulatedPdf }
 
 
+import StructuredReportRenderResult from './structured-report-render-result.js'
+export type { StructuredReportRenderResult }
+
+import StructuredReportRenderOptions from './structured-report-render-options.js'
+export type { StructuredReportRenderOptions }
+
+import structuredReportRender from './structured-report-render.js'
+export { structuredReportRender }
+
+
 import StructuredReportToHtmlResult from './structured-report-to-html-result.js'
 export type { StructuredReportToHtmlResult }
 
@@ -63,6 +73,16 @@ import readImageDicomFileSeries from './read-image-dicom-file-series.js'
 export { readImageDicomFileSeries }
 
 
+import ReadImageDicomStudyResult from './read-image-dicom-study-result.js'
+export type { ReadImageDicomStudyResult }
+
+import ReadImageDicomStudyOptions from './read-image-dicom-study-options.js'
+export type { ReadImageDicomStudyOptions }
+
+import readImageDicomStudy from './read-image-dicom-study.js'
+export { readImageDicomStudy }
+
+
 
 import readImageDicomFileSeriesWorkerFunction from './read-image-dicom-file-series-worker-function.js'
 export { readImageDicomFileSeriesWorkerFunction }
@@ -1,8 +1,11 @@
 // Generated file. To retain edits, remove this comment.
 
-import { JsonCompatible } from 'itk-wasm'
+import { BinaryFile,JsonCompatible } from 'itk-wasm'
 
 interface ReadDicomTagsNodeOptions {
+  /** Additional input DICOM files. When given, tags is a JSON array of {"file": file name, "tags": [[tag, value], ...]} objects for dicom-file and these files. */
+  dicomFiles?: string[] | File[] | BinaryFile[]
+
   /** A JSON object with a "tags" array of the tags to read. If not provided, all tags are read. Example tag: "0008|103e". */
   tagsToRead?: JsonCompatible
 
@@ -6,7 +6,7 @@ import {
   runPipelineNode
 } from 'itk-wasm'
 
-import ReadDicomTagsOptions from './read-dicom-tags-options.js'
+import ReadDicomTagsNodeOptions from './read-dicom-tags-node-options.js'
 import ReadDicomTagsNodeResult from './read-dicom-tags-node-result.js'
 
 
@@ -16,13 +16,13 @@ import path from 'path'
  * Read the tags from a DICOM file
  *
  * @param {string} dicomFile - Input DICOM file.
- * @param {ReadDicomTagsOptions} options - options object
+ * @param {ReadDicomTagsNodeOptions} options - options object
  *
  * @returns {Promise<ReadDicomTagsNodeResult>} - result object
  */
 async function readDicomTagsNode(
   dicomFile: string,
-  options: ReadDicomTagsOptions = {}
+  options: ReadDicomTagsNodeOptions = {}
 ) : Promise<ReadDicomTagsNodeResult> {
 
   const mountDirs: Set<string> = new Set()
@@ -46,6 +46,17 @@ async function readDicomTagsNode(
 
   // Options
   args.push('--memory-io')
+  if (options.dicomFiles) {
+    if(options.dicomFiles.length < 1) {
+      throw new Error('"dicom-files" option must have a length > 1')
+    }
+    args.push('--dicom-files')
+
+    options.dicomFiles.forEach((value) => {
+      mountDirs.add(path.dirname(value as string))
+      args.push(value as string)
+    })
+  }
   if (typeof options.tagsToRead !== "undefined") {
     const inputCountString = inputs.length.toString()
     inputs.push({ type: InterfaceTypes.JsonCompatible, data: options.tagsToRead as JsonCompatible })
@@ -1,6 +1,9 @@
-import { WorkerPoolFunctionOption } from "itk-wasm"
+import { BinaryFile, WorkerPoolFunctionOption } from "itk-wasm"
 
 interface ReadDicomTagsOptions extends WorkerPoolFunctionOption {
+  /** Additional input DICOM files. When given, tags is a JSON array of {"file": file name, "tags": [[tag, value], ...]} objects for dicom-file and these files. */
+  dicomFiles?: string[] | File[] | BinaryFile[]
+
   /** A JSON object with a "tags" array of the tags to read. If not provided, all tags are read. Example tag: "0008|103e". */
   tagsToRead?: { tags: Array<string> }
 }
@@ -50,6 +50,23 @@ async function readDicomTags(
 
   // Options
   args.push('--memory-io')
+  if (options.dicomFiles) {
+    if(options.dicomFiles.length < 1) {
+      throw new Error('"dicom-files" option must have a length > 1')
+    }
+    args.push('--dicom-files')
+
+    await Promise.all(options.dicomFiles.map(async (value) => {
+      let valueFile = value
+      if (value instanceof File) {
+        const valueBuffer = await value.arrayBuffer()
+        valueFile = { path: value.name, data: new Uint8Array(valueBuffer) }
+      }
+      inputs.push({ type: InterfaceTypes.BinaryFile, data: valueFile as BinaryFile })
+      const name = value instanceof File ? value.name : (valueFile as BinaryFile).path
+      args.push(name)
+    }))
+  }
   if (typeof options.tagsToRead !== "undefined") {
     const inputCountString = inputs.length.toString()
     inputs.push({ type: InterfaceTypes.JsonCompatible, data: options.tagsToRead })
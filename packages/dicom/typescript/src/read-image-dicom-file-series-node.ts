@@ -58,6 +58,28 @@ async function readImageDicomFileSeriesNode(
       args.push(value as string)
     })
   }
+  if (options.scanCache) {
+    const inputCountString = inputs.length.toString()
+    inputs.push({ type: InterfaceTypes.JsonCompatible, data: options.scanCache as JsonCompatible })
+    args.push('--scan-cache', inputCountString)
+
+  }
+  if (options.previewSlices) {
+    args.push('--preview-slices', options.previewSlices.toString())
+
+  }
+  if (options.previewShrinkFactor) {
+    args.push('--preview-shrink-factor', options.previewShrinkFactor.toString())
+
+  }
+  if (options.rescalePolicy) {
+    args.push('--rescale-policy', options.rescalePolicy.toString())
+
+  }
+  if (options.outputComponentType) {
+    args.push('--output-component-type', options.outputComponentType.toString())
+
+  }
   if (options.singleSortedSeries) {
     options.singleSortedSeries && args.push('--single-sorted-series')
   }
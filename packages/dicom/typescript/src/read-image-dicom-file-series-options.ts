@@ -1,9 +1,24 @@
-import { BinaryFile, WorkerPoolFunctionOption, WorkerPool } from 'itk-wasm'
+import { BinaryFile, JsonCompatible, WorkerPoolFunctionOption, WorkerPool } from 'itk-wasm'
 
 interface ReadImageDicomFileSeriesOptions extends WorkerPoolFunctionOption {
   /** File names in the series */
   inputImages: string[] | File[] | BinaryFile[]
 
+  /** Sort tags of files scanned before, as {"files": [{"path": file name, "size": bytes, "tags": {"0020|000e": value, ...}}]}, e.g. from read-dicom-tags. Files whose path and size match are not scanned. */
+  scanCache?: JsonCompatible
+
+  /** Read only this many evenly spaced slices of the sorted series, e.g. 1 for the middle slice of a thumbnail. 0 reads all slices. */
+  previewSlices?: number
+
+  /** Bin shrink the slices in-plane by this factor */
+  previewShrinkFactor?: number
+
+  /** rescaled: apply the rescale slope and intercept of the slices. stored: the stored values, e.g. to rescale them later. */
+  rescalePolicy?: string
+
+  /** Component type of the output image, e.g. int16 or float32, converted slice by slice as it is read. Float values are truncated toward zero. By default, that of the rescaled or stored values. */
+  outputComponentType?: string
+
   /** The input files are a single sorted series */
   singleSortedSeries?: boolean
 
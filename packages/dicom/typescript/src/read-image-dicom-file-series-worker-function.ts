@@ -5,12 +5,30 @@ import {
   PipelineInput,
   InterfaceTypes,
   Image,
+  JsonCompatible,
   WorkerPoolFunctionOption
 } from 'itk-wasm'
 
 import { getPipelinesBaseUrl } from './pipelines-base-url.js'
 import { getPipelineWorkerUrl } from './pipeline-worker-url.js'
 
+interface WorkerFunctionOptions extends WorkerPoolFunctionOption {
+  /** Sort tags of files scanned before, e.g. from read-dicom-tags */
+  scanCache?: JsonCompatible
+
+  /** Read only this many evenly spaced slices of the sorted series */
+  previewSlices?: number
+
+  /** Bin shrink the slices in-plane by this factor */
+  previewShrinkFactor?: number
+
+  /** rescaled or stored values */
+  rescalePolicy?: string
+
+  /** Component type of the output image, e.g. int16 or float32 */
+  outputComponentType?: string
+}
+
 interface WorkerFunctionResult {
   webWorker: Worker
   outputImage: Image
@@ -20,7 +38,7 @@ interface WorkerFunctionResult {
 async function readImageDicomFileSeriesWorkerFunction(
   inputImages: BinaryFile[],
   singleSortedSeries: boolean = false,
-  options: WorkerPoolFunctionOption = {}
+  options: WorkerFunctionOptions = {}
 ): Promise<WorkerFunctionResult> {
 
   const desiredOutputs: Array<PipelineOutput> = [
@@ -47,6 +65,23 @@ async function readImageDicomFileSeriesWorkerFunction(
     inputs.push({ type: InterfaceTypes.BinaryFile, data: value as BinaryFile })
     args.push(value.path)
   })
+  if (options.scanCache) {
+    const inputCountString = inputs.length.toString()
+    inputs.push({ type: InterfaceTypes.JsonCompatible, data: options.scanCache as JsonCompatible })
+    args.push('--scan-cache', inputCountString)
+  }
+  if (options.previewSlices) {
+    args.push('--preview-slices', options.previewSlices.toString())
+  }
+  if (options.previewShrinkFactor) {
+    args.push('--preview-shrink-factor', options.previewShrinkFactor.toString())
+  }
+  if (options.rescalePolicy) {
+    args.push('--rescale-policy', options.rescalePolicy.toString())
+  }
+  if (options.outputComponentType) {
+    args.push('--output-component-type', options.outputComponentType.toString())
+  }
   if (typeof singleSortedSeries !== "undefined") {
     singleSortedSeries && args.push('--single-sorted-series')
   }
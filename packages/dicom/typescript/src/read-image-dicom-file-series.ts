@@ -27,6 +27,14 @@ async function readImageDicomFileSeries(
     workerPool = new WorkerPool(numberOfWorkers, readImageDicomFileSeriesWorkerFunction)
   }
 
+  const pipelineOptions = {
+    scanCache: options.scanCache,
+    previewSlices: options.previewSlices,
+    previewShrinkFactor: options.previewShrinkFactor,
+    rescalePolicy: options.rescalePolicy,
+    outputComponentType: options.outputComponentType,
+  }
+
   const inputs: Array<BinaryFile> = [
   ]
   if(options.inputImages.length < 1) {
@@ -42,11 +50,13 @@ async function readImageDicomFileSeries(
     inputs.push(valueFile as BinaryFile)
   }))
 
-  if (options.singleSortedSeries) {
+  // Preview slices are picked from the whole sorted series, so it is read in
+  // one task
+  if (options.singleSortedSeries && !options.previewSlices) {
     const taskArgsArray = []
     for (let index = 0; index < inputs.length; index += seriesBlockSize) {
       const block = inputs.slice(index, index + seriesBlockSize)
-      taskArgsArray.push([block, options.singleSortedSeries, {}])
+      taskArgsArray.push([block, options.singleSortedSeries, { ...pipelineOptions }])
     }
     const results = await workerPool.runTasks(taskArgsArray).promise
     const images = results.map((result) => result.outputImage)
@@ -54,7 +64,7 @@ async function readImageDicomFileSeries(
     let stacked = stackImages(images)
     return { outputImage: stacked, webWorkerPool: workerPool, sortedFilenames }
   } else {
-    const taskArgsArray = [[inputs, options.singleSortedSeries, {}]]
+    const taskArgsArray = [[inputs, options.singleSortedSeries, { ...pipelineOptions }]]
     const results = await workerPool.runTasks(taskArgsArray).promise
     let image = results[0].outputImage
     return { outputImage: image, webWorkerPool: workerPool, sortedFilenames: results[0].sortedFilenames }
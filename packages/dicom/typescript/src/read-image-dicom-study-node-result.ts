@@ -0,0 +1,14 @@
+// Generated file. To retain edits, remove this comment.
+
+import { JsonCompatible, Image } from 'itk-wasm'
+
+interface ReadImageDicomStudyNodeResult {
+  /** Series of the study, ordered by series instance UID and split by series number, sequence name, slice thickness, rows and columns, as [{"seriesInstanceUID": uid, "sortedFilenames": [file name, ...], "seriesImage": index in series-images, or null when there are more series than series-images}] */
+  study: JsonCompatible
+
+  /** Output image volume of each series, in the order of study. Outputs past the number of series are not set. */
+  seriesImages: Image[]
+
+}
+
+export default ReadImageDicomStudyNodeResult
@@ -0,0 +1,98 @@
+import {
+  JsonCompatible,
+  Image,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipelineNode
+} from 'itk-wasm'
+
+import ReadImageDicomStudyNodeOptions from './read-image-dicom-study-node-options.js'
+import ReadImageDicomStudyNodeResult from './read-image-dicom-study-node-result.js'
+
+import path from 'path'
+import { fileURLToPath } from 'url'
+
+/**
+ * Read every DICOM image series in the input files, with one scan of their headers, and return the image volume of each series
+ *
+ * @param {ReadImageDicomStudyNodeOptions} options - options object
+ *
+ * @returns {Promise<ReadImageDicomStudyNodeResult>} - result object
+ */
+async function readImageDicomStudyNode(
+  options: ReadImageDicomStudyNodeOptions = { inputImages: [] as string[], }
+) : Promise<ReadImageDicomStudyNodeResult> {
+
+  const mountDirs: Set<string> = new Set()
+
+  // Each series has at least one file, so there are at most as many series
+  // as input images. Outputs past the number of series are not set.
+  const maxSeries = options.maxSeries ?? options.inputImages.length
+  const desiredOutputs: Array<PipelineOutput> = [
+    { type: InterfaceTypes.JsonCompatible },
+  ]
+  for (let index = 0; index < maxSeries; index++) {
+    desiredOutputs.push({ type: InterfaceTypes.Image })
+  }
+
+  const inputs: Array<PipelineInput> = [
+  ]
+
+  const args = []
+  // Inputs
+  // Outputs
+  const studyName = '0'
+  args.push(studyName)
+
+  for (let index = 1; index <= maxSeries; index++) {
+    args.push(index.toString())
+  }
+
+  // Options
+  args.push('--memory-io')
+  if (options.inputImages) {
+    if(options.inputImages.length < 1) {
+      throw new Error('"input-images" option must have a length > 1')
+    }
+    args.push('--input-images')
+
+    options.inputImages.forEach((value) => {
+      mountDirs.add(path.dirname(value as string))
+      args.push(value as string)
+    })
+  }
+  if (options.scanCache) {
+    const inputCountString = inputs.length.toString()
+    inputs.push({ type: InterfaceTypes.JsonCompatible, data: options.scanCache as JsonCompatible })
+    args.push('--scan-cache', inputCountString)
+
+  }
+  if (options.rescalePolicy) {
+    args.push('--rescale-policy', options.rescalePolicy.toString())
+
+  }
+  if (options.outputComponentType) {
+    args.push('--output-component-type', options.outputComponentType.toString())
+
+  }
+
+  const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'read-image-dicom-study')
+
+  const {
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipelineNode(pipelinePath, args, desiredOutputs, inputs, mountDirs)
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    study: outputs[0]?.data as JsonCompatible,
+    seriesImages: outputs.slice(1).filter((output) => output.data !== null).map((output) => output.data as Image),
+  }
+  return result
+}
+
+export default readImageDicomStudyNode
@@ -0,0 +1,21 @@
+import { BinaryFile,JsonCompatible, WorkerPoolFunctionOption } from 'itk-wasm'
+
+interface ReadImageDicomStudyOptions extends WorkerPoolFunctionOption {
+  /** File names in the study */
+  inputImages: string[] | File[] | BinaryFile[]
+
+  /** Sort tags of files scanned before, as {"files": [{"path": file name, "size": bytes, "tags": {"0020|000e": value, ...}}]}, e.g. from read-dicom-tags. Files whose path and size match are not scanned. */
+  scanCache?: JsonCompatible
+
+  /** rescaled: apply the rescale slope and intercept of the slices. stored: the stored values, e.g. to rescale them later. */
+  rescalePolicy?: string
+
+  /** Component type of the output images, e.g. int16 or float32, converted slice by slice as they are read. Float values are truncated toward zero. By default, that of the rescaled or stored values of each series. */
+  outputComponentType?: string
+
+  /** Number of series image outputs. By default, the number of input images, so every series is read. Series past it have a null seriesImage in the study. */
+  maxSeries?: number
+
+}
+
+export default ReadImageDicomStudyOptions
@@ -0,0 +1,111 @@
+import {
+  JsonCompatible,
+  Image,
+  BinaryFile,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipeline
+} from 'itk-wasm'
+
+import ReadImageDicomStudyOptions from './read-image-dicom-study-options.js'
+import ReadImageDicomStudyResult from './read-image-dicom-study-result.js'
+
+import { getPipelinesBaseUrl } from './pipelines-base-url.js'
+import { getPipelineWorkerUrl } from './pipeline-worker-url.js'
+
+import { getDefaultWebWorker } from './default-web-worker.js'
+
+/**
+ * Read every DICOM image series in the input files, with one scan of their headers, and return the image volume of each series
+ *
+ * @param {ReadImageDicomStudyOptions} options - options object
+ *
+ * @returns {Promise<ReadImageDicomStudyResult>} - result object
+ */
+async function readImageDicomStudy(
+  options: ReadImageDicomStudyOptions = { inputImages: [] as BinaryFile[] | File[] | string[], }
+) : Promise<ReadImageDicomStudyResult> {
+
+  // Each series has at least one file, so there are at most as many series
+  // as input images. Outputs past the number of series are not set.
+  const maxSeries = options.maxSeries ?? options.inputImages.length
+  const desiredOutputs: Array<PipelineOutput> = [
+    { type: InterfaceTypes.JsonCompatible },
+  ]
+  for (let index = 0; index < maxSeries; index++) {
+    desiredOutputs.push({ type: InterfaceTypes.Image })
+  }
+
+  const inputs: Array<PipelineInput> = [
+  ]
+
+  const args = []
+  // Inputs
+  // Outputs
+  const studyName = '0'
+  args.push(studyName)
+
+  for (let index = 1; index <= maxSeries; index++) {
+    args.push(index.toString())
+  }
+
+  // Options
+  args.push('--memory-io')
+  if (options.inputImages) {
+    if(options.inputImages.length < 1) {
+      throw new Error('"input-images" option must have a length > 1')
+    }
+    args.push('--input-images')
+
+    await Promise.all(options.inputImages.map(async (value) => {
+      let valueFile = value
+      if (value instanceof File) {
+        const valueBuffer = await value.arrayBuffer()
+        valueFile = { path: value.name, data: new Uint8Array(valueBuffer) }
+      }
+      inputs.push({ type: InterfaceTypes.BinaryFile, data: valueFile as BinaryFile })
+      const name = value instanceof File ? value.name : (valueFile as BinaryFile).path
+      args.push(name)
+    }))
+  }
+  if (options.scanCache) {
+    const inputCountString = inputs.length.toString()
+    inputs.push({ type: InterfaceTypes.JsonCompatible, data: options.scanCache as JsonCompatible })
+    args.push('--scan-cache', inputCountString)
+
+  }
+  if (options.rescalePolicy) {
+    args.push('--rescale-policy', options.rescalePolicy.toString())
+
+  }
+  if (options.outputComponentType) {
+    args.push('--output-component-type', options.outputComponentType.toString())
+
+  }
+
+  const pipelinePath = 'read-image-dicom-study'
+
+  let workerToUse = options?.webWorker
+  if (workerToUse === undefined) {
+    workerToUse = await getDefaultWebWorker()
+  }
+  const {
+    webWorker: usedWebWorker,
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipeline(pipelinePath, args, desiredOutputs, inputs, { pipelineBaseUrl: getPipelinesBaseUrl(), pipelineWorkerUrl: getPipelineWorkerUrl(), webWorker: workerToUse, noCopy: options?.noCopy })
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    webWorker: usedWebWorker as Worker,
+    study: outputs[0]?.data as JsonCompatible,
+    seriesImages: outputs.slice(1).filter((output) => output.data !== null).map((output) => output.data as Image),
+  }
+  return result
+}
+
+export default readImageDicomStudy
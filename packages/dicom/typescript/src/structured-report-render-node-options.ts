@@ -0,0 +1,18 @@
+// Generated file. To retain edits, remove this comment.
+
+interface StructuredReportRenderNodeOptions {
+  /** Do not render the plain text output */
+  noText?: boolean
+
+  /** Do not render the HTML output */
+  noHtml?: boolean
+
+  /** Do not write the tags output */
+  noTags?: boolean
+
+  /** URL: string. Append specificed URL prefix to hyperlinks of referenced composite objects in the HTML document. */
+  urlPrefix?: string
+
+}
+
+export default StructuredReportRenderNodeOptions
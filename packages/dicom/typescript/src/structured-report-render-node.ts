@@ -0,0 +1,94 @@
+// Generated file. To retain edits, remove this comment.
+
+import {
+  TextStream,
+  JsonCompatible,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipelineNode
+} from 'itk-wasm'
+
+import StructuredReportRenderNodeOptions from './structured-report-render-node-options.js'
+import StructuredReportRenderNodeResult from './structured-report-render-node-result.js'
+
+import path from 'path'
+import { fileURLToPath } from 'url'
+
+/**
+ * Parse a DICOM structured report once and render its text, HTML and tags
+ *
+ * @param {string} dicomFile - Input DICOM file
+ * @param {StructuredReportRenderNodeOptions} options - options object
+ *
+ * @returns {Promise<StructuredReportRenderNodeResult>} - result object
+ */
+async function structuredReportRenderNode(
+  dicomFile: string,
+  options: StructuredReportRenderNodeOptions = {}
+) : Promise<StructuredReportRenderNodeResult> {
+
+  const mountDirs: Set<string> = new Set()
+
+  const desiredOutputs: Array<PipelineOutput> = [
+    { type: InterfaceTypes.TextStream },
+    { type: InterfaceTypes.TextStream },
+    { type: InterfaceTypes.JsonCompatible },
+  ]
+
+  mountDirs.add(path.dirname(dicomFile as string))
+  const inputs: Array<PipelineInput> = [
+  ]
+
+  const args = []
+  // Inputs
+  const dicomFileName = dicomFile
+  args.push(dicomFileName)
+  mountDirs.add(path.dirname(dicomFileName))
+
+  // Outputs
+  const outputTextName = '0'
+  args.push(outputTextName)
+
+  const outputHtmlName = '1'
+  args.push(outputHtmlName)
+
+  const tagsName = '2'
+  args.push(tagsName)
+
+  // Options
+  args.push('--memory-io')
+  if (options.noText) {
+    options.noText && args.push('--no-text')
+  }
+  if (options.noHtml) {
+    options.noHtml && args.push('--no-html')
+  }
+  if (options.noTags) {
+    options.noTags && args.push('--no-tags')
+  }
+  if (options.urlPrefix) {
+    args.push('--url-prefix', options.urlPrefix.toString())
+
+  }
+
+  const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'structured-report-render')
+
+  const {
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipelineNode(pipelinePath, args, desiredOutputs, inputs, mountDirs)
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    outputText: (outputs[0]?.data as TextStream).data,
+    outputHtml: (outputs[1]?.data as TextStream).data,
+    tags: outputs[2]?.data as JsonCompatible,
+  }
+  return result
+}
+
+export default structuredReportRenderNode
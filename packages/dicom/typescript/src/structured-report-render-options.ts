@@ -0,0 +1,20 @@
+// Generated file. To retain edits, remove this comment.
+
+import { WorkerPoolFunctionOption } from 'itk-wasm'
+
+interface StructuredReportRenderOptions extends WorkerPoolFunctionOption {
+  /** Do not render the plain text output */
+  noText?: boolean
+
+  /** Do not render the HTML output */
+  noHtml?: boolean
+
+  /** Do not write the tags output */
+  noTags?: boolean
+
+  /** URL: string. Append specificed URL prefix to hyperlinks of referenced composite objects in the HTML document. */
+  urlPrefix?: string
+
+}
+
+export default StructuredReportRenderOptions
@@ -0,0 +1,17 @@
+// Generated file. To retain edits, remove this comment.
+
+import { JsonCompatible, WorkerPoolFunctionResult } from 'itk-wasm'
+
+interface StructuredReportRenderResult extends WorkerPoolFunctionResult {
+  /** Output plain text, as structured-report-to-text */
+  outputText: string
+
+  /** Output HTML, as structured-report-to-html */
+  outputHtml: string
+
+  /** Output tags of the data set, as read-dicom-tags. JSON array of [tag, value] arrays. */
+  tags: JsonCompatible
+
+}
+
+export default StructuredReportRenderResult
@@ -0,0 +1,105 @@
+// Generated file. To retain edits, remove this comment.
+
+import {
+  BinaryFile,
+  TextStream,
+  JsonCompatible,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipeline
+} from 'itk-wasm'
+
+import StructuredReportRenderOptions from './structured-report-render-options.js'
+import StructuredReportRenderResult from './structured-report-render-result.js'
+
+import { getPipelinesBaseUrl } from './pipelines-base-url.js'
+import { getPipelineWorkerUrl } from './pipeline-worker-url.js'
+
+import { getDefaultWebWorker } from './default-web-worker.js'
+
+/**
+ * Parse a DICOM structured report once and render its text, HTML and tags
+ *
+ * @param {File | BinaryFile} dicomFile - Input DICOM file
+ * @param {StructuredReportRenderOptions} options - options object
+ *
+ * @returns {Promise<StructuredReportRenderResult>} - result object
+ */
+async function structuredReportRender(
+  dicomFile: File | BinaryFile,
+  options: StructuredReportRenderOptions = {}
+) : Promise<StructuredReportRenderResult> {
+
+  const desiredOutputs: Array<PipelineOutput> = [
+    { type: InterfaceTypes.TextStream },
+    { type: InterfaceTypes.TextStream },
+    { type: InterfaceTypes.JsonCompatible },
+  ]
+
+  let dicomFileFile = dicomFile
+  if (dicomFile instanceof File) {
+    const dicomFileBuffer = await dicomFile.arrayBuffer()
+    dicomFileFile = { path: dicomFile.name, data: new Uint8Array(dicomFileBuffer) }
+  }
+  const inputs: Array<PipelineInput> = [
+    { type: InterfaceTypes.BinaryFile, data: dicomFileFile as BinaryFile },
+  ]
+
+  const args = []
+  // Inputs
+  const dicomFileName = (dicomFileFile as BinaryFile).path
+  args.push(dicomFileName)
+
+  // Outputs
+  const outputTextName = '0'
+  args.push(outputTextName)
+
+  const outputHtmlName = '1'
+  args.push(outputHtmlName)
+
+  const tagsName = '2'
+  args.push(tagsName)
+
+  // Options
+  args.push('--memory-io')
+  if (options.noText) {
+    options.noText && args.push('--no-text')
+  }
+  if (options.noHtml) {
+    options.noHtml && args.push('--no-html')
+  }
+  if (options.noTags) {
+    options.noTags && args.push('--no-tags')
+  }
+  if (options.urlPrefix) {
+    args.push('--url-prefix', options.urlPrefix.toString())
+
+  }
+
+  const pipelinePath = 'structured-report-render'
+
+  let workerToUse = options?.webWorker
+  if (workerToUse === undefined) {
+    workerToUse = await getDefaultWebWorker()
+  }
+  const {
+    webWorker: usedWebWorker,
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipeline(pipelinePath, args, desiredOutputs, inputs, { pipelineBaseUrl: getPipelinesBaseUrl(), pipelineWorkerUrl: getPipelineWorkerUrl(), webWorker: workerToUse, noCopy: options?.noCopy })
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    webWorker: usedWebWorker as Worker,
+    outputText: (outputs[0]?.data as TextStream).data,
+    outputHtml: (outputs[1]?.data as TextStream).data,
+    tags: outputs[2]?.data as JsonCompatible,
+  }
+  return result
+}
+
+export default structuredReportRender
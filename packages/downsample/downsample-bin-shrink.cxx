@@ -23,6 +23,8 @@
 
 #include "itkBinShrinkImageFilter.h"
 
+#include "downsampleBinShrink.h"
+
 template<typename TImage>
 class PipelineFunctor
 {
@@ -54,18 +56,28 @@ public:
     for (unsigned int i = 0; i < ImageDimension; ++i)
     {
       filter->SetShrinkFactor(i, shrinkFactors[i]);
+      shrinkFactors[i] = filter->GetShrinkFactors()[i];
     }
 
-    if (informationOnly)
-    {
-      ITK_WASM_CATCH_EXCEPTION(pipeline, filter->UpdateOutputInformation());
-    }
-    else
+    ITK_WASM_CATCH_EXCEPTION(pipeline, filter->UpdateOutputInformation());
+    typename ImageType::ConstPointer result = filter->GetOutput();
+    if (!informationOnly)
     {
-      ITK_WASM_CATCH_EXCEPTION(pipeline, filter->UpdateLargestPossibleRegion());
+      // Common pixel types and shrink factors have a kernel that vectorizes,
+      // with the pixels of the filter
+      auto downsampled = ImageType::New();
+      downsampled->CopyInformation(filter->GetOutput());
+      bool specialized = false;
+      ITK_WASM_CATCH_EXCEPTION(pipeline, specialized = downsampleBinShrink<ImageType>(inputImage.Get(), shrinkFactors, downsampled));
+      if (specialized)
+      {
+        result = downsampled.GetPointer();
+      }
+      else
+      {
+        ITK_WASM_CATCH_EXCEPTION(pipeline, filter->UpdateLargestPossibleRegion());
+      }
     }
-
-    typename ImageType::ConstPointer result = filter->GetOutput();
     downsampledImage.Set(result);
 
     return EXIT_SUCCESS;
@@ -21,11 +21,7 @@
 #include "itkOutputImage.h"
 #include "itkSupportInputImageTypes.h"
 
-#include "itkLabelImageGenericInterpolateImageFunction.h"
-#include "itkLinearInterpolateImageFunction.h"
-#include "itkResampleImageFilter.h"
-
-#include "downsampleSigma.h"
+#include "downsampleLabelImage.h"
 
 template<typename TImage>
 class PipelineFunctor
@@ -46,44 +42,31 @@ public:
     std::vector<unsigned int> cropRadius;
     pipeline.add_option("-r,--crop-radius", cropRadius, "Optional crop radius in pixel units.")->type_size(ImageDimension);
 
+    bool blockMode = false;
+    pipeline.add_flag("-b,--block-mode", blockMode, "Set each output pixel to the most frequent label of its shrink factors block instead of the label at its sample.");
+
     using OutputImageType = itk::wasm::OutputImage<ImageType>;
     OutputImageType downsampledImage;
     pipeline.add_option("downsampled", downsampledImage, "Output downsampled image")->required()->type_name("OUTPUT_IMAGE");
 
     ITK_WASM_PARSE(pipeline);
 
-    const auto inputOrigin = inputImage.Get()->GetOrigin();
-    const auto inputSpacing = inputImage.Get()->GetSpacing();
     const auto inputSize = inputImage.Get()->GetLargestPossibleRegion().GetSize();
 
-    typename ImageType::PointType outputOrigin;
-    typename ImageType::SpacingType outputSpacing;
     typename ImageType::SizeType outputSize;
     for (unsigned int i = 0; i < ImageDimension; ++i)
     {
       const double cropRadiusValue = cropRadius.size() ? cropRadius[i] : 0.0;
 
-      outputOrigin[i] = inputOrigin[i] + cropRadiusValue * inputSpacing[i];
-      outputSpacing[i] = inputSpacing[i] * shrinkFactors[i];
       outputSize[i] = std::max<itk::SizeValueType>(0, (inputSize[i] - 2 * cropRadiusValue) / shrinkFactors[i]);
     }
 
-    using InterpolatorType = itk::LabelImageGenericInterpolateImageFunction<ImageType, itk::LinearInterpolateImageFunction>;
-    auto interpolator = InterpolatorType::New();
-
-    using ResampleFilterType = itk::ResampleImageFilter<ImageType, ImageType>;
-    auto shrinkFilter = ResampleFilterType::New();
-    shrinkFilter->SetInput(inputImage.Get());
-    shrinkFilter->SetInterpolator(interpolator);
-    shrinkFilter->SetOutputOrigin(outputOrigin);
-    shrinkFilter->SetOutputSpacing(outputSpacing);
-    shrinkFilter->SetOutputDirection(inputImage.Get()->GetDirection());
-    shrinkFilter->SetSize(outputSize);
-    shrinkFilter->SetOutputStartIndex(inputImage.Get()->GetLargestPossibleRegion().GetIndex());
-
-    ITK_WASM_CATCH_EXCEPTION(pipeline, shrinkFilter->UpdateLargestPossibleRegion());
+    // Labels are gathered from the input buffer, without interpolating each
+    // label separately at every output sample
+    typename ImageType::Pointer downsampled;
+    ITK_WASM_CATCH_EXCEPTION(pipeline, downsampled = downsampleLabelImage<ImageType>(inputImage.Get(), shrinkFactors, cropRadius, outputSize, blockMode));
 
-    typename ImageType::ConstPointer result = shrinkFilter->GetOutput();
+    typename ImageType::ConstPointer result = downsampled.GetPointer();
     downsampledImage.Set(result);
 
     return EXIT_SUCCESS;
@@ -0,0 +1,108 @@
+/*=========================================================================
+
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkInputImage.h"
+#include "itkOutputImage.h"
+#include "itkSupportInputImageTypes.h"
+#include "itkRGBPixel.h"
+#include "itkRGBAPixel.h"
+
+#include "downsampleGaussian.h"
+
+template<typename TImage>
+class PipelineFunctor
+{
+public:
+  int operator()(itk::wasm::Pipeline & pipeline)
+  {
+    using ImageType = TImage;
+    constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+
+    using InputImageType = itk::wasm::InputImage<ImageType>;
+    InputImageType inputImage;
+    pipeline.add_option("input", inputImage, "Input image")->required()->type_name("INPUT_IMAGE");
+
+    std::vector<unsigned int> shrinkFactors(ImageDimension, 2);
+    pipeline.add_option("-s,--shrink-factors", shrinkFactors, "Shrink factors of each level relative to the previous level. Either one factor per dimension for all levels, or one factor per dimension for each level, finest level first.")->expected(1, -1);
+
+    unsigned int minimumSize = 1;
+    pipeline.add_option("-m,--minimum-size", minimumSize, "Minimum size in pixels. A dimension is not shrunk further when it would become smaller.");
+
+    using OutputImageType = itk::wasm::OutputImage<ImageType>;
+    std::vector<OutputImageType> levels;
+    pipeline.add_option("levels", levels, "Output pyramid levels, finest first, each downsampled from the previous level")->required()->expected(1, -1)->type_name("OUTPUT_IMAGE");
+
+    ITK_WASM_PARSE(pipeline);
+
+    const size_t numberOfLevels = levels.size();
+    if (shrinkFactors.size() != ImageDimension && shrinkFactors.size() != ImageDimension * numberOfLevels)
+    {
+      std::ostringstream ostrm;
+      ostrm << "Expected " << ImageDimension << " or " << ImageDimension * numberOfLevels << " shrink factors for " << numberOfLevels << " levels, got " << shrinkFactors.size() << ".\n";
+      CLI::Error err("Runtime error", ostrm.str(), 1);
+      return pipeline.exit(err);
+    }
+
+    // Each level is smoothed with the incremental sigma of its shrink
+    // factors relative to the previous level, which already carries the
+    // smoothing of the finer levels
+    typename ImageType::ConstPointer previous = inputImage.Get();
+    for (size_t level = 0; level < numberOfLevels; ++level)
+    {
+      const auto previousSize = previous->GetLargestPossibleRegion().GetSize();
+      ShrinkFactorsType levelShrinkFactors(ImageDimension);
+      typename ImageType::SizeType levelSize;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        const unsigned int shrinkFactor = std::max(1u, shrinkFactors[(shrinkFactors.size() == ImageDimension ? 0 : level * ImageDimension) + i]);
+        levelShrinkFactors[i] = previousSize[i] / shrinkFactor < minimumSize ? 1 : shrinkFactor;
+        levelSize[i] = previousSize[i] / levelShrinkFactors[i];
+      }
+
+      const std::vector<unsigned int> cropRadius;
+      typename ImageType::Pointer downsampled;
+      ITK_WASM_CATCH_EXCEPTION(pipeline, downsampled = downsampleGaussian<ImageType>(previous, levelShrinkFactors, cropRadius, levelSize));
+
+      previous = downsampled.GetPointer();
+      levels[level].Set(previous);
+    }
+
+    return EXIT_SUCCESS;
+  }
+};
+
+int main(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("downsample-pyramid", "Generate a multiscale pyramid, each level smoothed with an anti-alias filter and subsampled from the previous level.", argc, argv);
+
+  return itk::wasm::SupportInputImageTypes<PipelineFunctor,
+    uint8_t,
+    int8_t,
+    uint16_t,
+    int16_t,
+    uint32_t,
+    int32_t,
+    uint64_t,
+    int64_t,
+    float,
+    double,
+    itk::RGBPixel<uint8_t>,
+    itk::RGBAPixel<uint8_t>
+    >
+  ::Dimensions<2U, 3U, 4U, 5U>("input", pipeline);
+}
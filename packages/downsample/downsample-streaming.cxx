@@ -0,0 +1,334 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkWasmImageIO.h"
+#include "itkWasmMemoryBudget.h"
+
+#include "downsampleGaussian.h"
+
+namespace
+{
+
+struct StreamingArguments
+{
+  itk::wasm::Pipeline &     pipeline;
+  itk::WasmImageIO *        inputImageIO;
+  std::string               outputFileName;
+  std::vector<unsigned int> shrinkFactors;
+  std::vector<unsigned int> cropRadius;
+  unsigned int              slabSize;
+  bool                      slabSizeFromBudget;
+};
+
+/** Downsample the input file one slab of output slices along the last axis
+ * at a time, or one volume at a time for a time series that is not shrunk
+ * along its trailing axes, see downsampleVolumeDimension.
+ *
+ * Each slab reads the input slices that its samples and their kernels
+ * cover, the halo, so its pixels equal those of the whole image
+ * downsample, and the slab is appended to the output file. Only one input
+ * slab and one output slab are in memory. */
+template <typename TPixel, unsigned int VDimension>
+int
+downsampleStreaming(const StreamingArguments & arguments)
+{
+  using ImageType = itk::Image<TPixel, VDimension>;
+  constexpr unsigned int ImageDimension = VDimension;
+  constexpr unsigned int SlabAxis = ImageDimension - 1;
+  itk::WasmImageIO * inputImageIO = arguments.inputImageIO;
+  const auto & shrinkFactors = arguments.shrinkFactors;
+  const auto & cropRadius = arguments.cropRadius;
+
+  // The input image information, without pixels
+  auto inputInformation = ImageType::New();
+  typename ImageType::RegionType inputRegion;
+  typename ImageType::SpacingType inputSpacing;
+  typename ImageType::PointType inputOrigin;
+  typename ImageType::DirectionType inputDirection;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    inputRegion.SetSize(dim, inputImageIO->GetDimensions(dim));
+    inputSpacing[dim] = inputImageIO->GetSpacing(dim);
+    inputOrigin[dim] = inputImageIO->GetOrigin(dim);
+    const std::vector<double> direction = inputImageIO->GetDirection(dim);
+    for (unsigned int row = 0; row < ImageDimension; ++row)
+    {
+      inputDirection[row][dim] = direction[row];
+    }
+  }
+  inputInformation->SetRegions(inputRegion);
+  inputInformation->SetSpacing(inputSpacing);
+  inputInformation->SetOrigin(inputOrigin);
+  inputInformation->SetDirection(inputDirection);
+
+  typename ImageType::SizeType outputSize;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    const double cropRadiusValue = cropRadius.size() ? cropRadius[i] : 0.0;
+
+    outputSize[i] = std::max<itk::SizeValueType>(0, (inputRegion.GetSize(i) - 2 * cropRadiusValue) / shrinkFactors[i]);
+  }
+  const auto outputInformation = downsampleOutputInformation<ImageType>(inputInformation, inputRegion, shrinkFactors, cropRadius, outputSize);
+  const auto outputRegion = outputInformation->GetLargestPossibleRegion();
+
+  auto outputImageIO = itk::WasmImageIO::New();
+  if (!outputImageIO->CanWriteFile(arguments.outputFileName.c_str()) || !outputImageIO->CanStreamWrite())
+  {
+    std::cerr << "Streamed writes are not supported for: " << arguments.outputFileName << std::endl;
+    return EXIT_FAILURE;
+  }
+  outputImageIO->SetFileName(arguments.outputFileName);
+  outputImageIO->SetNumberOfDimensions(ImageDimension);
+  outputImageIO->SetPixelTypeInfo(static_cast<const TPixel *>(nullptr));
+  typename ImageType::PointType outputOrigin;
+  outputInformation->TransformIndexToPhysicalPoint(outputRegion.GetIndex(), outputOrigin);
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    outputImageIO->SetDimensions(dim, outputSize[dim]);
+    outputImageIO->SetSpacing(dim, outputInformation->GetSpacing()[dim]);
+    outputImageIO->SetOrigin(dim, outputOrigin[dim]);
+    std::vector<double> direction(ImageDimension);
+    for (unsigned int row = 0; row < ImageDimension; ++row)
+    {
+      direction[row] = inputDirection[row][dim];
+    }
+    outputImageIO->SetDirection(dim, direction);
+  }
+
+  if (outputRegion.GetNumberOfPixels() == 0)
+  {
+    itk::ImageIORegion ioRegion(ImageDimension);
+    outputImageIO->SetIORegion(ioRegion);
+    ITK_WASM_CATCH_EXCEPTION(arguments.pipeline, outputImageIO->Write(nullptr));
+    return EXIT_SUCCESS;
+  }
+
+  const auto sigma = downsampleSigma(shrinkFactors);
+  std::vector<size_t> radius(ImageDimension);
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    radius[dim] = downsampleCachedGaussianKernels(sigma[dim])->kernel.size() / 2;
+  }
+
+  // Without --slab-size, the largest slab whose input window, temporary
+  // buffers, and output are within --max-memory
+  size_t slabSize = std::max(1U, arguments.slabSize);
+  if (arguments.slabSizeFromBudget)
+  {
+    uint64_t inputSliceBytes = sizeof(TPixel);
+    for (unsigned int dim = 0; dim < SlabAxis; ++dim)
+    {
+      inputSliceBytes *= inputRegion.GetSize(dim);
+    }
+    slabSize = itk::wasm::LargestPieceWithinBudget(outputSize[SlabAxis], itk::wasm::Pipeline::get_max_memory(), [&](size_t slices) {
+      typename ImageType::SizeType slabOutputSize = outputSize;
+      slabOutputSize[SlabAxis] = slices;
+      typename ImageType::SizeType slabInputSize = inputRegion.GetSize();
+      slabInputSize[SlabAxis] = std::min<size_t>(inputRegion.GetSize(SlabAxis), (slices - 1) * shrinkFactors[SlabAxis] + 1 + 2 * radius[SlabAxis]);
+      std::vector<unsigned int> slabCropRadius(ImageDimension, 0);
+      if (!cropRadius.empty())
+      {
+        slabCropRadius = cropRadius;
+      }
+      slabCropRadius[SlabAxis] = static_cast<unsigned int>(std::min<size_t>(radius[SlabAxis], slabInputSize[SlabAxis] - 1 - (slices - 1) * shrinkFactors[SlabAxis]));
+      return inputSliceBytes * slabInputSize[SlabAxis] + downsampleGaussianBytes<ImageType>(slabInputSize, shrinkFactors, slabCropRadius, slabOutputSize);
+    });
+  }
+  // Read the input window of the output piece from outputBegin, its samples
+  // and their kernels, downsample it, and append the piece to the output
+  const auto downsamplePiece = [&](const std::vector<size_t> & outputBegin, const typename ImageType::SizeType & pieceOutputSize) -> int {
+    typename ImageType::RegionType pieceInputRegion;
+    std::vector<unsigned int> pieceCropRadius(ImageDimension);
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      const size_t first = (cropRadius.empty() ? 0 : cropRadius[dim]) + outputBegin[dim] * shrinkFactors[dim];
+      const size_t last = first + (pieceOutputSize[dim] - 1) * shrinkFactors[dim];
+      const size_t begin = first > radius[dim] ? first - radius[dim] : 0;
+      const size_t end = std::min<size_t>(inputRegion.GetSize(dim) - 1, last + radius[dim]) + 1;
+      pieceInputRegion.SetIndex(dim, static_cast<itk::IndexValueType>(begin));
+      pieceInputRegion.SetSize(dim, end - begin);
+      pieceCropRadius[dim] = static_cast<unsigned int>(first - begin);
+    }
+
+    auto pieceInput = ImageType::New();
+    pieceInput->CopyInformation(inputInformation);
+    pieceInput->SetRegions(pieceInputRegion);
+    pieceInput->Allocate();
+    itk::ImageIORegion inputIORegion(ImageDimension);
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      inputIORegion.SetIndex(dim, pieceInputRegion.GetIndex(dim));
+      inputIORegion.SetSize(dim, pieceInputRegion.GetSize(dim));
+    }
+    inputImageIO->SetIORegion(inputIORegion);
+    ITK_WASM_CATCH_EXCEPTION(arguments.pipeline, inputImageIO->Read(pieceInput->GetBufferPointer()));
+
+    typename ImageType::Pointer pieceOutput;
+    ITK_WASM_CATCH_EXCEPTION(arguments.pipeline, pieceOutput = downsampleGaussian<ImageType>(pieceInput, shrinkFactors, pieceCropRadius, pieceOutputSize));
+    pieceInput = nullptr;
+
+    itk::ImageIORegion outputIORegion(ImageDimension);
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      outputIORegion.SetIndex(dim, outputBegin[dim]);
+      outputIORegion.SetSize(dim, pieceOutputSize[dim]);
+    }
+    outputImageIO->SetIORegion(outputIORegion);
+    ITK_WASM_CATCH_EXCEPTION(arguments.pipeline, outputImageIO->Write(pieceOutput->GetBufferPointer()));
+    return EXIT_SUCCESS;
+  };
+
+  // A time series that is not shrunk along its trailing axes is read and
+  // written one volume at a time, in file order, each from one input volume
+  const unsigned int volumeDimension = downsampleVolumeDimension(shrinkFactors);
+  if (volumeDimension < ImageDimension)
+  {
+    typename ImageType::SizeType volumeOutputSize = outputSize;
+    size_t numberOfVolumes = 1;
+    for (unsigned int dim = volumeDimension; dim < ImageDimension; ++dim)
+    {
+      volumeOutputSize[dim] = 1;
+      numberOfVolumes *= outputSize[dim];
+    }
+    std::vector<size_t> outputBegin(ImageDimension, 0);
+    for (size_t volume = 0; volume < numberOfVolumes; ++volume)
+    {
+      size_t outer = volume;
+      for (unsigned int dim = volumeDimension; dim < ImageDimension; ++dim)
+      {
+        outputBegin[dim] = outer % outputSize[dim];
+        outer /= outputSize[dim];
+      }
+      const int result = downsamplePiece(outputBegin, volumeOutputSize);
+      if (result != EXIT_SUCCESS)
+      {
+        return result;
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  for (size_t slabBegin = 0; slabBegin < outputSize[SlabAxis]; slabBegin += slabSize)
+  {
+    typename ImageType::SizeType slabOutputSize = outputSize;
+    slabOutputSize[SlabAxis] = std::min<size_t>(slabSize, outputSize[SlabAxis] - slabBegin);
+    std::vector<size_t> outputBegin(ImageDimension, 0);
+    outputBegin[SlabAxis] = slabBegin;
+    const int result = downsamplePiece(outputBegin, slabOutputSize);
+    if (result != EXIT_SUCCESS)
+    {
+      return result;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+template <typename TPixel, unsigned int VDimension>
+bool
+downsampleStreamingIfPixelType(const StreamingArguments & arguments, int & result)
+{
+  if (arguments.inputImageIO->GetComponentType() != itk::ImageIOBase::MapPixelType<TPixel>::CType)
+  {
+    return false;
+  }
+  result = downsampleStreaming<TPixel, VDimension>(arguments);
+  return true;
+}
+
+template <unsigned int VDimension>
+bool
+downsampleStreamingIfDimension(const StreamingArguments & arguments, int & result)
+{
+  if (arguments.inputImageIO->GetNumberOfDimensions() != VDimension)
+  {
+    return false;
+  }
+  return downsampleStreamingIfPixelType<uint8_t, VDimension>(arguments, result) ||
+         downsampleStreamingIfPixelType<int8_t, VDimension>(arguments, result) ||
+         downsampleStreamingIfPixelType<uint16_t, VDimension>(arguments, result) ||
+         downsampleStreamingIfPixelType<int16_t, VDimension>(arguments, result) ||
+         downsampleStreamingIfPixelType<uint32_t, VDimension>(arguments, result) ||
+         downsampleStreamingIfPixelType<int32_t, VDimension>(arguments, result) ||
+         downsampleStreamingIfPixelType<uint64_t, VDimension>(arguments, result) ||
+         downsampleStreamingIfPixelType<int64_t, VDimension>(arguments, result) ||
+         downsampleStreamingIfPixelType<float, VDimension>(arguments, result) ||
+         downsampleStreamingIfPixelType<double, VDimension>(arguments, result);
+}
+
+} // end anonymous namespace
+
+int main(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("downsample-streaming", "Apply a smoothing anti-alias filter and subsample an input image file, one slab at a time, with memory bounded by the slab size.", argc, argv);
+
+  std::string inputFileName;
+  pipeline.add_option("serialized-input", inputFileName, "Input image, a .iwi directory or .iwi.cbor file read by slab")->required()->check(CLI::ExistingPath)->type_name("INPUT_BINARY_FILE");
+
+  std::vector<unsigned int> shrinkFactors;
+  pipeline.add_option("-s,--shrink-factors", shrinkFactors, "Shrink factors")->required()->expected(1, -1);
+
+  std::vector<unsigned int> cropRadius;
+  pipeline.add_option("-r,--crop-radius", cropRadius, "Optional crop radius in pixel units.")->expected(1, -1);
+
+  unsigned int slabSize = 16;
+  auto * slabSizeOption = pipeline.add_option("--slab-size", slabSize, "Number of output slices along the last axis computed and written at a time. Defaults to the largest slab within --max-memory when it is given, otherwise 16. Not used for images past 3D that are not shrunk along their trailing axes, which are computed one volume at a time.");
+
+  std::string outputFileName;
+  pipeline.add_option("serialized-downsampled", outputFileName, "Output downsampled image, a .iwi directory or .iwi.cbor file written by slab")->required()->type_name("OUTPUT_BINARY_FILE");
+
+  ITK_WASM_PARSE(pipeline);
+
+  auto inputImageIO = itk::WasmImageIO::New();
+  if (!inputImageIO->CanReadFile(inputFileName.c_str()))
+  {
+    std::cerr << "Streamed reads are not supported for: " << inputFileName << std::endl;
+    return EXIT_FAILURE;
+  }
+  inputImageIO->SetFileName(inputFileName);
+  ITK_WASM_CATCH_EXCEPTION(pipeline, inputImageIO->ReadImageInformation());
+  if (!inputImageIO->CanStreamRead())
+  {
+    std::cerr << "Streamed reads are not supported for: " << inputFileName << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const unsigned int dimension = inputImageIO->GetNumberOfDimensions();
+  if (inputImageIO->GetNumberOfComponents() != 1)
+  {
+    std::cerr << "Only scalar images are supported." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (shrinkFactors.size() != dimension || (!cropRadius.empty() && cropRadius.size() != dimension))
+  {
+    std::cerr << "Expected " << dimension << " shrink factors and crop radii." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const bool slabSizeFromBudget = itk::wasm::Pipeline::get_max_memory() > 0 && slabSizeOption->count() == 0;
+  const StreamingArguments arguments{ pipeline, inputImageIO, outputFileName, shrinkFactors, cropRadius, slabSize, slabSizeFromBudget };
+  int result = EXIT_FAILURE;
+  if (!downsampleStreamingIfDimension<2>(arguments, result) && !downsampleStreamingIfDimension<3>(arguments, result) &&
+      !downsampleStreamingIfDimension<4>(arguments, result) && !downsampleStreamingIfDimension<5>(arguments, result))
+  {
+    std::cerr << "Unsupported image type: " << dimension << "D " << itk::ImageIOBase::GetComponentTypeAsString(inputImageIO->GetComponentType()) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return result;
+}
@@ -20,12 +20,11 @@
 #include "itkInputImage.h"
 #include "itkOutputImage.h"
 #include "itkSupportInputImageTypes.h"
+#include "itkWasmMemoryBudget.h"
+#include "itkRGBPixel.h"
+#include "itkRGBAPixel.h"
 
-#include "itkDiscreteGaussianImageFilter.h"
-#include "itkLinearInterpolateImageFunction.h"
-#include "itkResampleImageFilter.h"
-
-#include "downsampleSigma.h"
+#include "downsampleGaussian.h"
 
 template<typename TImage>
 class PipelineFunctor
@@ -52,51 +51,55 @@ public:
 
     ITK_WASM_PARSE(pipeline);
 
-    auto sigmaValues = downsampleSigma(shrinkFactors);
-
-    using GaussianFilterType = itk::DiscreteGaussianImageFilter<ImageType, ImageType>;
-    auto gaussianFilter = GaussianFilterType::New();
-    gaussianFilter->SetInput(inputImage.Get());
-    typename GaussianFilterType::ArrayType sigmaArray;
-    for (unsigned int i = 0; i < ImageDimension; ++i)
-    {
-      sigmaArray[i] = sigmaValues[i];
-    }
-    gaussianFilter->SetSigmaArray(sigmaArray);
-    gaussianFilter->SetUseImageSpacingOff();
-
-    const auto inputOrigin = inputImage.Get()->GetOrigin();
-    const auto inputSpacing = inputImage.Get()->GetSpacing();
     const auto inputSize = inputImage.Get()->GetLargestPossibleRegion().GetSize();
 
-    typename ImageType::PointType outputOrigin;
-    typename ImageType::SpacingType outputSpacing;
     typename ImageType::SizeType outputSize;
     for (unsigned int i = 0; i < ImageDimension; ++i)
     {
       const double cropRadiusValue = cropRadius.size() ? cropRadius[i] : 0.0;
 
-      outputOrigin[i] = inputOrigin[i] + cropRadiusValue * inputSpacing[i];
-      outputSpacing[i] = inputSpacing[i] * shrinkFactors[i];
       outputSize[i] = std::max<itk::SizeValueType>(0, (inputSize[i] - 2 * cropRadiusValue) / shrinkFactors[i]);
     }
 
-    using InterpolatorType = itk::LinearInterpolateImageFunction<ImageType, double>;
-    auto interpolator = InterpolatorType::New();
-
-    using ResampleFilterType = itk::ResampleImageFilter<ImageType, ImageType>;
-    auto shrinkFilter = ResampleFilterType::New();
-    shrinkFilter->SetInput(gaussianFilter->GetOutput());
-    shrinkFilter->SetInterpolator(interpolator);
-    shrinkFilter->SetOutputOrigin(outputOrigin);
-    shrinkFilter->SetOutputSpacing(outputSpacing);
-    shrinkFilter->SetOutputDirection(inputImage.Get()->GetDirection());
-    shrinkFilter->SetSize(outputSize);
-    shrinkFilter->SetOutputStartIndex(inputImage.Get()->GetLargestPossibleRegion().GetIndex());
+    // With --max-memory, slabs of output slices along the last axis are
+    // computed at a time when the temporary buffers of the whole image are
+    // over the budget. The input is already in memory.
+    const auto * input = inputImage.Get();
+    const uint64_t inputBytes = static_cast<uint64_t>(input->GetBufferedRegion().GetNumberOfPixels()) * sizeof(typename ImageType::PixelType);
+    const uint64_t outputBytes = static_cast<uint64_t>(typename ImageType::RegionType(outputSize).GetNumberOfPixels()) * sizeof(typename ImageType::PixelType);
+    const size_t slabSize = itk::wasm::LargestPieceWithinBudget(outputSize[ImageDimension - 1], itk::wasm::Pipeline::get_max_memory(), [&](size_t slices) {
+      typename ImageType::SizeType slabOutputSize = outputSize;
+      slabOutputSize[ImageDimension - 1] = slices;
+      // The slab output is copied to the whole output
+      const uint64_t slabBytes = downsampleGaussianBytes<ImageType>(input->GetBufferedRegion().GetSize(), shrinkFactors, cropRadius, slabOutputSize);
+      return inputBytes + outputBytes + (slices < outputSize[ImageDimension - 1] ? slabBytes : slabBytes - outputBytes);
+    });
+
+    // With --progressive, the unsmoothed samples are published first
+    if (itk::wasm::Pipeline::get_progressive())
+    {
+      ITK_WASM_CATCH_EXCEPTION(pipeline, downsampledImage.Publish(downsampleSubsample<ImageType>(input, shrinkFactors, cropRadius, outputSize)));
+    }
 
-    ITK_WASM_CATCH_EXCEPTION(pipeline, shrinkFilter->UpdateLargestPossibleRegion());
+    // The Gaussian is only evaluated at the output samples, without
+    // DiscreteGaussianImageFilter's full resolution output or a resampling.
+    // The volumes of a time series that is not shrunk along time are
+    // downsampled one at a time.
+    auto progress = DownsampleProgress::New();
+    pipeline.observe_progress(progress);
+    pipeline.abort_on_request(progress);
+    typename ImageType::Pointer downsampled;
+    const unsigned int volumeDimension = downsampleVolumeDimension(shrinkFactors);
+    if (volumeDimension < ImageDimension)
+    {
+      ITK_WASM_CATCH_EXCEPTION(pipeline, downsampled = downsampleGaussianVolumes<ImageType>(input, shrinkFactors, cropRadius, outputSize, volumeDimension, progress));
+    }
+    else
+    {
+      ITK_WASM_CATCH_EXCEPTION(pipeline, downsampled = downsampleGaussianSlabs<ImageType>(input, shrinkFactors, cropRadius, outputSize, slabSize, progress));
+    }
 
-    typename ImageType::ConstPointer result = shrinkFilter->GetOutput();
+    typename ImageType::ConstPointer result = downsampled.GetPointer();
     downsampledImage.Set(result);
 
     return EXIT_SUCCESS;
@@ -117,7 +120,9 @@ int main(int argc, char * argv[])
     uint64_t,
     int64_t,
     float,
-    double
+    double,
+    itk::RGBPixel<uint8_t>,
+    itk::RGBAPixel<uint8_t>
     >
   ::Dimensions<2U, 3U, 4U, 5U>("input", pipeline);
 }
\ No newline at end of file
@@ -0,0 +1,221 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef downsampleBinShrink_h
+#define downsampleBinShrink_h
+
+#include "itkImage.h"
+#include "itkMath.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/** Accumulator of the bin sums of a pixel type with a specialized bin shrink
+ * kernel. Integer sums are exact while the bin has at most MaximumBinSize
+ * pixels. */
+template <typename TPixel>
+struct BinShrinkAccumulator
+{
+  static constexpr bool Supported = false;
+};
+
+template <>
+struct BinShrinkAccumulator<uint8_t>
+{
+  static constexpr bool Supported = true;
+  static constexpr size_t MaximumBinSize = 1 << 23;
+  using Type = uint32_t;
+};
+
+template <>
+struct BinShrinkAccumulator<int8_t>
+{
+  static constexpr bool Supported = true;
+  static constexpr size_t MaximumBinSize = 1 << 23;
+  using Type = int32_t;
+};
+
+template <>
+struct BinShrinkAccumulator<uint16_t>
+{
+  static constexpr bool Supported = true;
+  static constexpr size_t MaximumBinSize = 1 << 15;
+  using Type = uint32_t;
+};
+
+template <>
+struct BinShrinkAccumulator<int16_t>
+{
+  static constexpr bool Supported = true;
+  static constexpr size_t MaximumBinSize = 1 << 15;
+  using Type = int32_t;
+};
+
+template <>
+struct BinShrinkAccumulator<float>
+{
+  static constexpr bool Supported = true;
+  static constexpr size_t MaximumBinSize = static_cast<size_t>(-1);
+  using Type = double;
+};
+
+/** Add the bins of an input line, VFactor pixels wide, to the accumulators.
+ * The pixels of a bin are added in order, as in BinShrinkImageFilter, so
+ * floating point sums round the same way. With a constant factor the loop
+ * vectorizes. */
+template <unsigned int VFactor, typename TPixel, typename TAccumulator>
+void
+binShrinkAccumulateLine(const TPixel * input, size_t outputSize, TAccumulator * accumulators)
+{
+  for (size_t ii = 0; ii < outputSize; ++ii)
+  {
+    for (unsigned int jj = 0; jj < VFactor; ++jj)
+    {
+      accumulators[ii] += input[ii * VFactor + jj];
+    }
+  }
+}
+
+/** Allocate and fill the output, which has the output information of a
+ * BinShrinkImageFilter, with the bin averages of the input.
+ *
+ * Specialized for the pixel types of BinShrinkAccumulator and shrink
+ * factors of 1, 2, or 4 along the first axis. Returns false, without
+ * touching the output, for other images, which go through the filter. The
+ * pixels match BinShrinkImageFilter: each bin of the output index times the
+ * shrink factors is summed, multiplied by the inverse of its size, and
+ * rounded with itk::Math::Round for integer pixels. */
+template <typename TImage>
+bool
+downsampleBinShrink(const TImage * input, const std::vector<unsigned int> & shrinkFactors, TImage * output)
+{
+  using ImageType = TImage;
+  using PixelType = typename ImageType::PixelType;
+  constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+
+  if constexpr (!BinShrinkAccumulator<PixelType>::Supported)
+  {
+    return false;
+  }
+  else
+  {
+    using AccumulatorType = typename BinShrinkAccumulator<PixelType>::Type;
+
+    size_t binSize = 1;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      binSize *= shrinkFactors[dim];
+    }
+    const unsigned int factor = shrinkFactors[0];
+    if ((factor != 1 && factor != 2 && factor != 4) || binSize > BinShrinkAccumulator<PixelType>::MaximumBinSize ||
+        input->GetBufferedRegion() != input->GetLargestPossibleRegion())
+    {
+      return false;
+    }
+
+    const auto inputRegion = input->GetBufferedRegion();
+    const auto outputRegion = output->GetLargestPossibleRegion();
+    output->SetBufferedRegion(outputRegion);
+    output->Allocate();
+    const size_t numberOfPixels = outputRegion.GetNumberOfPixels();
+    if (numberOfPixels == 0)
+    {
+      return true;
+    }
+
+    std::vector<size_t> strides(ImageDimension);
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      strides[dim] = dim == 0 ? 1 : strides[dim - 1] * inputRegion.GetSize(dim - 1);
+    }
+    const PixelType * inputBuffer = input->GetBufferPointer();
+    PixelType *       outputBuffer = output->GetBufferPointer();
+    const size_t      outputLineSize = outputRegion.GetSize(0);
+    const size_t      linesPerBin = binSize / factor;
+    const double      inverseBinSize = 1.0 / static_cast<double>(binSize);
+
+    const size_t numberOfLines = numberOfPixels / outputLineSize;
+    const size_t linesPerTask = std::max<size_t>(1, 16384 / (outputLineSize * binSize));
+    const size_t numberOfTasks = (numberOfLines + linesPerTask - 1) / linesPerTask;
+    itk::MultiThreaderBase::New()->ParallelizeArray(
+      0,
+      numberOfTasks,
+      [&](itk::SizeValueType task) {
+        std::vector<AccumulatorType> accumulators(outputLineSize);
+        const size_t                 endLine = std::min(numberOfLines, (task + 1) * linesPerTask);
+        for (size_t line = task * linesPerTask; line < endLine; ++line)
+        {
+          // Offset of the first input line of the bins
+          size_t remainingLine = line;
+          size_t lineOffset = (outputRegion.GetIndex(0) * factor - inputRegion.GetIndex(0)) * strides[0];
+          for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+          {
+            const auto outputIndex = outputRegion.GetIndex(dim) + static_cast<itk::OffsetValueType>(remainingLine % outputRegion.GetSize(dim));
+            remainingLine /= outputRegion.GetSize(dim);
+            lineOffset += (outputIndex * shrinkFactors[dim] - inputRegion.GetIndex(dim)) * strides[dim];
+          }
+
+          std::fill(accumulators.begin(), accumulators.end(), AccumulatorType{});
+          for (size_t binLine = 0; binLine < linesPerBin; ++binLine)
+          {
+            // The input lines of the bins, with the second axis fastest
+            size_t binOffset = lineOffset;
+            size_t remainder = binLine;
+            for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+            {
+              binOffset += remainder % shrinkFactors[dim] * strides[dim];
+              remainder /= shrinkFactors[dim];
+            }
+            const PixelType * inputLine = inputBuffer + binOffset;
+            switch (factor)
+            {
+              case 1:
+                binShrinkAccumulateLine<1>(inputLine, outputLineSize, accumulators.data());
+                break;
+              case 2:
+                binShrinkAccumulateLine<2>(inputLine, outputLineSize, accumulators.data());
+                break;
+              default:
+                binShrinkAccumulateLine<4>(inputLine, outputLineSize, accumulators.data());
+                break;
+            }
+          }
+
+          PixelType * outputLine = outputBuffer + line * outputLineSize;
+          for (size_t ii = 0; ii < outputLineSize; ++ii)
+          {
+            if constexpr (std::is_integral_v<PixelType>)
+            {
+              outputLine[ii] = itk::Math::Round<PixelType>(accumulators[ii] * inverseBinSize);
+            }
+            else
+            {
+              outputLine[ii] = static_cast<PixelType>(accumulators[ii] * inverseBinSize);
+            }
+          }
+        }
+      },
+      nullptr);
+
+    return true;
+  }
+}
+
+#endif
@@ -0,0 +1,593 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef downsampleGaussian_h
+#define downsampleGaussian_h
+
+#include "itkGaussianOperator.h"
+#include "itkImage.h"
+#include "itkMultiThreaderBase.h"
+#include "itkPixelTraits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "downsampleOutputImage.h"
+#include "downsampleProgress.h"
+#include "downsampleSigma.h"
+
+/** Discrete Gaussian kernel of the downsample smoothing for a sigma in
+ * pixel units, with the maximum error and kernel width of downsample. */
+inline std::vector<double>
+downsampleGaussianKernel(double sigma)
+{
+  itk::GaussianOperator<double, 1> gaussianOperator;
+  gaussianOperator.SetDirection(0);
+  gaussianOperator.SetMaximumError(0.01);
+  gaussianOperator.SetMaximumKernelWidth(32);
+  gaussianOperator.SetVariance(sigma * sigma);
+  gaussianOperator.CreateDirectional();
+  return std::vector<double>(gaussianOperator.Begin(), gaussianOperator.End());
+}
+
+/** A table of the downsample passes, built once per key and shared by the
+ * passes of repeated runs, e.g. the slabs, volumes, and batch runs of a
+ * reactor instance. Each call site has its own cache, which is bounded since
+ * the tables grow with the output size. */
+template <typename TValue, typename TKey, typename TBuild>
+std::shared_ptr<const TValue>
+downsampleCachedTable(const TKey & key, TBuild && build)
+{
+  static std::map<TKey, std::shared_ptr<const TValue>> cache;
+  static std::mutex                                     cacheMutex;
+  constexpr size_t                                      MaximumNumberOfTables = 64;
+  {
+    const std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.find(key);
+    if (it != cache.end())
+    {
+      return it->second;
+    }
+  }
+  auto table = std::make_shared<const TValue>(build());
+  const std::lock_guard<std::mutex> lock(cacheMutex);
+  if (cache.size() >= MaximumNumberOfTables)
+  {
+    cache.clear();
+  }
+  cache.emplace(key, table);
+  return table;
+}
+
+/** Input positions along an axis of the taps of a kernel of taps weights,
+ * centered on every shrinkFactor pixel from offset, for outputSize samples,
+ * with the taps of a sample contiguous. Positions beyond the ends of the axis
+ * are the nearest pixel, as with the ZeroFluxNeumannBoundaryCondition of
+ * DiscreteGaussianImageFilter. */
+inline std::shared_ptr<const std::vector<size_t>>
+downsampleTapPositions(size_t taps, size_t axisSize, size_t shrinkFactor, size_t offset, size_t outputSize)
+{
+  return downsampleCachedTable<std::vector<size_t>>(std::make_tuple(taps, axisSize, shrinkFactor, offset, outputSize), [&]() {
+    std::vector<size_t> positions(outputSize * taps);
+    const auto          radius = static_cast<std::ptrdiff_t>(taps / 2);
+    const auto          last = static_cast<std::ptrdiff_t>(axisSize) - 1;
+    for (size_t sample = 0; sample < outputSize; ++sample)
+    {
+      const auto center = static_cast<std::ptrdiff_t>(offset + sample * shrinkFactor);
+      for (size_t tap = 0; tap < taps; ++tap)
+      {
+        positions[sample * taps + tap] = static_cast<size_t>(std::clamp<std::ptrdiff_t>(center + static_cast<std::ptrdiff_t>(tap) - radius, 0, last));
+      }
+    }
+    return positions;
+  });
+}
+
+/** Smooth one axis of a buffer with a discrete Gaussian kernel, evaluated only
+ * at the outputSize samples whose tap positions along the axis are in
+ * positions, see downsampleTapPositions.
+ *
+ * The buffer has the size inputSize, with the first axis fastest. Along the
+ * axes after axis, only the window of outerSize pixels from outerBegin is
+ * smoothed. The result has outputSize pixels along the axis, the window size
+ * along the later axes, and the input size along the earlier axes.
+ *
+ * With integer weights, the sums are integers, and each result is the sum
+ * plus bias, shifted right by shift bits. */
+template <typename TInput, typename TOutput, typename TWeight = double>
+void
+downsampleGaussianAxis(const TInput * input,
+                       const std::vector<size_t> & inputSize,
+                       unsigned int axis,
+                       const std::vector<TWeight> & kernel,
+                       const std::vector<size_t> & positions,
+                       size_t outputSize,
+                       const std::vector<size_t> & outerBegin,
+                       const std::vector<size_t> & outerSize,
+                       TOutput * output,
+                       unsigned int shift = 0,
+                       TWeight bias = 0)
+{
+  size_t stride = 1;
+  for (unsigned int dim = 0; dim < axis; ++dim)
+  {
+    stride *= inputSize[dim];
+  }
+  size_t numberOfOuterLines = 1;
+  for (size_t dim = axis + 1; dim < inputSize.size(); ++dim)
+  {
+    numberOfOuterLines *= outerSize[dim];
+  }
+  const size_t axisSize = inputSize[axis];
+  const size_t taps = kernel.size();
+
+  // Each line is the stride contiguous pixels of one output sample, and the
+  // inner loop over them vectorizes
+  const size_t numberOfLines = numberOfOuterLines * outputSize;
+  const size_t linesPerTask = std::max<size_t>(1, 4096 / stride);
+  const size_t numberOfTasks = (numberOfLines + linesPerTask - 1) / linesPerTask;
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfTasks, [&](itk::SizeValueType task) {
+    std::vector<TWeight> sums(stride);
+    const size_t endLine = std::min(numberOfLines, (task + 1) * linesPerTask);
+    for (size_t line = task * linesPerTask; line < endLine; ++line)
+    {
+      // Offset of the outer window line in the input
+      size_t outer = line / outputSize;
+      size_t inputOffset = 0;
+      size_t inputStride = stride * axisSize;
+      for (size_t dim = axis + 1; dim < inputSize.size(); ++dim)
+      {
+        inputOffset += (outerBegin[dim] + outer % outerSize[dim]) * inputStride;
+        outer /= outerSize[dim];
+        inputStride *= inputSize[dim];
+      }
+      const TInput * inputLines = input + inputOffset;
+      const size_t * samplePositions = positions.data() + (line % outputSize) * taps;
+      std::fill(sums.begin(), sums.end(), TWeight{});
+      for (size_t tap = 0; tap < taps; ++tap)
+      {
+        const TInput * inputLine = inputLines + samplePositions[tap] * stride;
+        const TWeight weight = kernel[tap];
+        for (size_t ii = 0; ii < stride; ++ii)
+        {
+          sums[ii] += weight * static_cast<TWeight>(inputLine[ii]);
+        }
+      }
+      TOutput * outputLine = output + line * stride;
+      for (size_t ii = 0; ii < stride; ++ii)
+      {
+        if constexpr (std::is_integral_v<TWeight>)
+        {
+          outputLine[ii] = static_cast<TOutput>((sums[ii] + bias) >> shift);
+        }
+        else
+        {
+          outputLine[ii] = static_cast<TOutput>(sums[ii]);
+        }
+      }
+    }
+  }, nullptr);
+}
+
+/** Number of fractional bits of the fixed point kernel weights. */
+constexpr unsigned int DownsampleKernelFractionBits = 14;
+
+/** Number of fractional bits of the 16-bit fixed point buffers between the
+ * axis passes of uint8 components. */
+constexpr unsigned int DownsampleBufferFractionBits = 8;
+
+/** Fixed point weights of a kernel, rounded, with the center weight
+ * adjusted so they sum to exactly one. */
+inline std::vector<int32_t>
+downsampleFixedPointKernel(const std::vector<double> & kernel)
+{
+  std::vector<int32_t> fixedPointKernel(kernel.size());
+  int32_t sum = 0;
+  for (size_t tap = 0; tap < kernel.size(); ++tap)
+  {
+    fixedPointKernel[tap] = static_cast<int32_t>(std::lround(kernel[tap] * (1 << DownsampleKernelFractionBits)));
+    sum += fixedPointKernel[tap];
+  }
+  fixedPointKernel[kernel.size() / 2] += (1 << DownsampleKernelFractionBits) - sum;
+  return fixedPointKernel;
+}
+
+/** The floating and fixed point kernels of a sigma. */
+struct DownsampleKernels
+{
+  std::vector<double>  kernel;
+  std::vector<int32_t> fixedPointKernel;
+};
+
+inline std::shared_ptr<const DownsampleKernels>
+downsampleCachedGaussianKernels(double sigma)
+{
+  return downsampleCachedTable<DownsampleKernels>(sigma, [&]() {
+    DownsampleKernels kernels;
+    kernels.kernel = downsampleGaussianKernel(sigma);
+    kernels.fixedPointKernel = downsampleFixedPointKernel(kernels.kernel);
+    return kernels;
+  });
+}
+
+/** Smooth with the separable kernels of DiscreteGaussianImageFilter and keep
+ * every shrinkFactors pixel from cropRadius, one axis at a time.
+ *
+ * Only the kept samples of each axis are smoothed, within the window of the
+ * input that their kernels cover, so the largest temporary buffer is at most
+ * the input size divided by the first shrink factor, instead of full
+ * resolution buffers for each axis, and a cropped input costs in proportion
+ * to the crop. The result has the pixels of the
+ * DiscreteGaussianImageFilter output at the kept samples, on the grid of
+ * downsampleOutputImage.
+ *
+ * The components of RGB and RGBA pixels are smoothed together, as the
+ * fastest axis of the buffers. uint8 components are smoothed in fixed point,
+ * with 16-bit buffers between the axes and 32-bit sums, which is within one
+ * of the floating point result and moves a quarter of the bytes.
+ *
+ * After each axis pass, the progress process object, if any, is updated
+ * within [progressBegin, progressEnd]. */
+template <typename TImage>
+typename TImage::Pointer
+downsampleGaussian(const TImage * input,
+                   const ShrinkFactorsType & shrinkFactors,
+                   const std::vector<unsigned int> & cropRadius,
+                   const typename TImage::SizeType & outputSize,
+                   itk::ProcessObject * progress = nullptr,
+                   float progressBegin = 0.0f,
+                   float progressEnd = 1.0f)
+{
+  using ImageType = TImage;
+  using PixelType = typename ImageType::PixelType;
+  using ComponentType = typename itk::PixelTraits<PixelType>::ValueType;
+  constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+  constexpr unsigned int Components = itk::PixelTraits<PixelType>::Dimension;
+  // The components are the first axis of the buffers
+  constexpr unsigned int ComponentAxes = Components > 1 ? 1 : 0;
+  constexpr unsigned int BufferDimension = ImageDimension + ComponentAxes;
+  constexpr bool         FixedPoint = Components > 1 && std::is_same_v<ComponentType, uint8_t>;
+  using BufferType = std::conditional_t<FixedPoint, uint16_t, double>;
+
+  const SigmaType sigma = downsampleSigma(shrinkFactors);
+  const auto inputRegion = input->GetBufferedRegion();
+  std::vector<size_t> size(BufferDimension, Components);
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    size[dim + ComponentAxes] = inputRegion.GetSize(dim);
+  }
+
+  auto output = downsampleOutputImage<ImageType>(input, shrinkFactors, cropRadius, outputSize);
+  const auto outputRegion = output->GetBufferedRegion();
+  if (outputRegion.GetNumberOfPixels() == 0)
+  {
+    return output;
+  }
+
+  // The kernels and the window of each axis that the kept samples and their
+  // kernels cover, so the cropped part of the input is not smoothed
+  std::vector<std::shared_ptr<const DownsampleKernels>> kernels(ImageDimension);
+  std::vector<size_t> offsets(ImageDimension);
+  std::vector<size_t> windowBegin(BufferDimension, 0);
+  std::vector<size_t> windowSize(BufferDimension, Components);
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    kernels[dim] = downsampleCachedGaussianKernels(sigma[dim]);
+
+    const unsigned int axis = dim + ComponentAxes;
+    const size_t radius = kernels[dim]->kernel.size() / 2;
+    const size_t first = cropRadius.empty() ? 0 : cropRadius[dim];
+    const size_t last = first + (outputSize[dim] - 1) * shrinkFactors[dim];
+    windowBegin[axis] = first > radius ? first - radius : 0;
+    windowSize[axis] = std::min(size[axis] - 1, last + radius) + 1 - windowBegin[axis];
+    offsets[dim] = first - windowBegin[axis];
+  }
+
+  // The first axis pass reads the window of the input. The later passes read
+  // the previous pass, which only has the windows of the later axes.
+  const auto * inputBuffer = reinterpret_cast<const ComponentType *>(input->GetBufferPointer());
+  auto *       outputBuffer = reinterpret_cast<ComponentType *>(output->GetBufferPointer());
+  std::vector<BufferType> current;
+  std::vector<BufferType> next;
+  const std::vector<size_t> fullBegin(BufferDimension, 0);
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    const unsigned int axis = dim + ComponentAxes;
+    std::vector<size_t> nextSize = dim == 0 ? windowSize : size;
+    nextSize[axis] = outputSize[dim];
+    const bool lastAxis = dim + 1 == ImageDimension;
+    if (!lastAxis)
+    {
+      size_t nextNumberOfPixels = 1;
+      for (const size_t nextAxisSize : nextSize)
+      {
+        nextNumberOfPixels *= nextAxisSize;
+      }
+      next.resize(nextNumberOfPixels);
+    }
+    const auto smoothAxis = [&](const auto * source, size_t offset, const std::vector<size_t> & outerBegin, const std::vector<size_t> & outerSize) {
+      const auto positionsPointer = downsampleTapPositions(kernels[dim]->kernel.size(), size[axis], shrinkFactors[dim], offset, outputSize[dim]);
+      const std::vector<size_t> & positions = *positionsPointer;
+      const std::vector<int32_t> & fixedPointKernel = kernels[dim]->fixedPointKernel;
+      const std::vector<double> &  kernel = kernels[dim]->kernel;
+      if constexpr (FixedPoint)
+      {
+        // Sums of the 8-bit input or 16-bit buffer fractions and the kernel
+        // fractions, rounded to the buffer fractions or truncated to the output
+        const unsigned int inputFractionBits = dim == 0 ? 0 : DownsampleBufferFractionBits;
+        const unsigned int outputFractionBits = lastAxis ? 0 : DownsampleBufferFractionBits;
+        const unsigned int shift = DownsampleKernelFractionBits + inputFractionBits - outputFractionBits;
+        const int32_t      bias = lastAxis ? 0 : 1 << (shift - 1);
+        if (lastAxis)
+        {
+          downsampleGaussianAxis(source, size, axis, fixedPointKernel, positions, outputSize[dim], outerBegin, outerSize, outputBuffer, shift, bias);
+        }
+        else
+        {
+          downsampleGaussianAxis(source, size, axis, fixedPointKernel, positions, outputSize[dim], outerBegin, outerSize, next.data(), shift, bias);
+        }
+      }
+      else
+      {
+        if (lastAxis)
+        {
+          downsampleGaussianAxis(source, size, axis, kernel, positions, outputSize[dim], outerBegin, outerSize, outputBuffer);
+        }
+        else
+        {
+          downsampleGaussianAxis(source, size, axis, kernel, positions, outputSize[dim], outerBegin, outerSize, next.data());
+        }
+      }
+    };
+    if (dim == 0)
+    {
+      smoothAxis(inputBuffer, windowBegin[axis] + offsets[0], windowBegin, windowSize);
+    }
+    else
+    {
+      smoothAxis(current.data(), offsets[dim], fullBegin, size);
+    }
+    current.swap(next);
+    next.clear();
+    next.shrink_to_fit();
+    size = nextSize;
+    downsampleUpdateProgress(progress, progressBegin + (progressEnd - progressBegin) * (dim + 1) / ImageDimension);
+  }
+
+  return output;
+}
+
+
+/** Estimated peak memory, in bytes, of downsampleGaussian of an input with
+ * the inputSize buffered region: its temporary buffers between the axis
+ * passes and its output, without the input. */
+template <typename TImage>
+uint64_t
+downsampleGaussianBytes(const typename TImage::SizeType & inputSize,
+                        const ShrinkFactorsType & shrinkFactors,
+                        const std::vector<unsigned int> & cropRadius,
+                        const typename TImage::SizeType & outputSize)
+{
+  using PixelType = typename TImage::PixelType;
+  using ComponentType = typename itk::PixelTraits<PixelType>::ValueType;
+  constexpr unsigned int ImageDimension = TImage::ImageDimension;
+  constexpr unsigned int Components = itk::PixelTraits<PixelType>::Dimension;
+  constexpr bool         FixedPoint = Components > 1 && std::is_same_v<ComponentType, uint8_t>;
+  using BufferType = std::conditional_t<FixedPoint, uint16_t, double>;
+
+  uint64_t outputPixels = 1;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    outputPixels *= outputSize[dim];
+  }
+  const uint64_t outputBytes = outputPixels * sizeof(PixelType);
+  if (outputPixels == 0)
+  {
+    return outputBytes;
+  }
+
+  // The buffer of each pass has the output size along the axes done, the
+  // window size along the first axis, and the input size along the others
+  const SigmaType sigma = downsampleSigma(shrinkFactors);
+  std::vector<uint64_t> size(ImageDimension);
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    size[dim] = inputSize[dim];
+  }
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    const uint64_t radius = downsampleCachedGaussianKernels(sigma[dim])->kernel.size() / 2;
+    const uint64_t first = cropRadius.empty() ? 0 : cropRadius[dim];
+    const uint64_t last = first + (outputSize[dim] - 1) * shrinkFactors[dim];
+    const uint64_t begin = first > radius ? first - radius : 0;
+    size[dim] = std::min<uint64_t>(size[dim] - 1, last + radius) + 1 - begin;
+  }
+  uint64_t peak = 0;
+  uint64_t current = 0;
+  for (unsigned int dim = 0; dim + 1 < ImageDimension; ++dim)
+  {
+    size[dim] = outputSize[dim];
+    uint64_t next = Components;
+    for (const uint64_t axisSize : size)
+    {
+      next *= axisSize;
+    }
+    next *= sizeof(BufferType);
+    peak = std::max(peak, current + next);
+    current = next;
+  }
+  return std::max(peak, current) + outputBytes;
+}
+
+/** downsampleGaussian in slabs of at most slabSize output slices along the
+ * last axis, each smoothed from the input window that its samples and their
+ * kernels cover, so the temporary buffers are those of one slab. The pixels
+ * equal those of a single downsampleGaussian. Each slab reports its share of
+ * the progress. */
+template <typename TImage>
+typename TImage::Pointer
+downsampleGaussianSlabs(const TImage * input,
+                        const ShrinkFactorsType & shrinkFactors,
+                        const std::vector<unsigned int> & cropRadius,
+                        const typename TImage::SizeType & outputSize,
+                        size_t slabSize,
+                        itk::ProcessObject * progress = nullptr)
+{
+  using ImageType = TImage;
+  constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+  constexpr unsigned int SlabAxis = ImageDimension - 1;
+
+  if (slabSize >= outputSize[SlabAxis])
+  {
+    return downsampleGaussian<ImageType>(input, shrinkFactors, cropRadius, outputSize, progress);
+  }
+
+  auto output = downsampleOutputImage<ImageType>(input, shrinkFactors, cropRadius, outputSize);
+  size_t pixelsPerSlice = 1;
+  for (unsigned int dim = 0; dim < SlabAxis; ++dim)
+  {
+    pixelsPerSlice *= outputSize[dim];
+  }
+  std::vector<unsigned int> slabCropRadius(ImageDimension, 0);
+  if (!cropRadius.empty())
+  {
+    slabCropRadius = cropRadius;
+  }
+  const unsigned int firstSample = slabCropRadius[SlabAxis];
+  slabSize = std::max<size_t>(1, slabSize);
+  for (size_t slabBegin = 0; slabBegin < outputSize[SlabAxis]; slabBegin += slabSize)
+  {
+    typename ImageType::SizeType slabOutputSize = outputSize;
+    slabOutputSize[SlabAxis] = std::min<size_t>(slabSize, outputSize[SlabAxis] - slabBegin);
+    slabCropRadius[SlabAxis] = static_cast<unsigned int>(firstSample + slabBegin * shrinkFactors[SlabAxis]);
+    const float slabProgressBegin = static_cast<float>(slabBegin) / outputSize[SlabAxis];
+    const float slabProgressEnd = static_cast<float>(slabBegin + slabOutputSize[SlabAxis]) / outputSize[SlabAxis];
+    const auto  slab = downsampleGaussian<ImageType>(input, shrinkFactors, slabCropRadius, slabOutputSize, progress, slabProgressBegin, slabProgressEnd);
+    std::copy_n(slab->GetBufferPointer(), pixelsPerSlice * slabOutputSize[SlabAxis], output->GetBufferPointer() + slabBegin * pixelsPerSlice);
+  }
+
+  return output;
+}
+
+/** Number of leading axes of the volumes of an image that are downsampled
+ * independently: the axes up to the last one that is shrunk, and at least
+ * three. Along the trailing axes after them, e.g. time or channels of a 4D
+ * or 5D image, the shrink factor is one, so the kernels have one tap and
+ * each output volume is computed from one input volume. Returns the image
+ * dimension when there are no such trailing axes. */
+inline unsigned int
+downsampleVolumeDimension(const ShrinkFactorsType & shrinkFactors)
+{
+  auto volumeDimension = static_cast<unsigned int>(shrinkFactors.size());
+  while (volumeDimension > 3 && shrinkFactors[volumeDimension - 1] == 1)
+  {
+    --volumeDimension;
+  }
+  return volumeDimension;
+}
+
+/** downsampleGaussian one volume of the volumeDimension leading axes at a
+ * time, for each index along the trailing axes that are not shrunk, see
+ * downsampleVolumeDimension. Each volume is smoothed in place from a view of
+ * the input buffer, so the temporary buffers are those of one volume,
+ * instead of the whole time series. The pixels equal those of a single
+ * downsampleGaussian. Each volume reports its share of the progress. */
+template <typename TImage>
+typename TImage::Pointer
+downsampleGaussianVolumes(const TImage * input,
+                          const ShrinkFactorsType & shrinkFactors,
+                          const std::vector<unsigned int> & cropRadius,
+                          const typename TImage::SizeType & outputSize,
+                          unsigned int volumeDimension,
+                          itk::ProcessObject * progress = nullptr)
+{
+  using ImageType = TImage;
+  using PixelType = typename ImageType::PixelType;
+  constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+
+  if (volumeDimension >= ImageDimension)
+  {
+    return downsampleGaussian<ImageType>(input, shrinkFactors, cropRadius, outputSize, progress);
+  }
+
+  auto output = downsampleOutputImage<ImageType>(input, shrinkFactors, cropRadius, outputSize);
+  if (output->GetBufferedRegion().GetNumberOfPixels() == 0)
+  {
+    return output;
+  }
+
+  const auto inputSize = input->GetBufferedRegion().GetSize();
+  typename ImageType::SizeType volumeInputSize = inputSize;
+  typename ImageType::SizeType volumeOutputSize = outputSize;
+  std::vector<unsigned int> volumeCropRadius(ImageDimension, 0);
+  size_t inputVolumePixels = 1;
+  size_t outputVolumePixels = 1;
+  size_t numberOfVolumes = 1;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    if (dim < volumeDimension)
+    {
+      volumeCropRadius[dim] = cropRadius.empty() ? 0 : cropRadius[dim];
+      inputVolumePixels *= inputSize[dim];
+      outputVolumePixels *= outputSize[dim];
+    }
+    else
+    {
+      volumeInputSize[dim] = 1;
+      volumeOutputSize[dim] = 1;
+      numberOfVolumes *= outputSize[dim];
+    }
+  }
+
+  auto * inputBuffer = const_cast<PixelType *>(input->GetBufferPointer());
+  for (size_t volume = 0; volume < numberOfVolumes; ++volume)
+  {
+    // The input volume at the cropped trailing index of the output volume
+    size_t outer = volume;
+    size_t inputVolume = 0;
+    size_t inputVolumeStride = 1;
+    for (unsigned int dim = volumeDimension; dim < ImageDimension; ++dim)
+    {
+      const size_t first = cropRadius.empty() ? 0 : cropRadius[dim];
+      inputVolume += (first + outer % outputSize[dim]) * inputVolumeStride;
+      outer /= outputSize[dim];
+      inputVolumeStride *= inputSize[dim];
+    }
+
+    auto volumeInput = ImageType::New();
+    volumeInput->CopyInformation(input);
+    volumeInput->SetRegions(typename ImageType::RegionType(volumeInputSize));
+    const bool letImageContainerManageMemory = false;
+    volumeInput->GetPixelContainer()->SetImportPointer(inputBuffer + inputVolume * inputVolumePixels, inputVolumePixels, letImageContainerManageMemory);
+
+    const float volumeProgressBegin = static_cast<float>(volume) / numberOfVolumes;
+    const float volumeProgressEnd = static_cast<float>(volume + 1) / numberOfVolumes;
+    const auto  volumeOutput = downsampleGaussian<ImageType>(volumeInput, shrinkFactors, volumeCropRadius, volumeOutputSize, progress, volumeProgressBegin, volumeProgressEnd);
+    std::copy_n(volumeOutput->GetBufferPointer(), outputVolumePixels, output->GetBufferPointer() + volume * outputVolumePixels);
+  }
+
+  return output;
+}
+
+#endif
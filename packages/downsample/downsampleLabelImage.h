@@ -0,0 +1,162 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef downsampleLabelImage_h
+#define downsampleLabelImage_h
+
+#include "itkImage.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "downsampleOutputImage.h"
+
+/** Downsample a label image by every shrinkFactors pixel from cropRadius.
+ *
+ * Without blockMode, each output pixel is the label of its input sample,
+ * which is the label LabelImageGenericInterpolateImageFunction selects at a
+ * pixel center. With blockMode, it is the most frequent label of the
+ * shrinkFactors block around its sample, clamped to the image, with ties
+ * going to the label of the sample and then to the smallest label. The
+ * block labels are counted by sorting a per-task copy, so the time does not
+ * depend on the number of labels in the image. */
+template <typename TImage>
+typename TImage::Pointer
+downsampleLabelImage(const TImage * input,
+                     const std::vector<unsigned int> & shrinkFactors,
+                     const std::vector<unsigned int> & cropRadius,
+                     const typename TImage::SizeType & outputSize,
+                     bool blockMode)
+{
+  using ImageType = TImage;
+  using PixelType = typename ImageType::PixelType;
+  constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+
+  auto output = downsampleOutputImage<ImageType>(input, shrinkFactors, cropRadius, outputSize);
+  const size_t numberOfPixels = output->GetBufferedRegion().GetNumberOfPixels();
+  if (numberOfPixels == 0)
+  {
+    return output;
+  }
+
+  const auto inputSize = input->GetBufferedRegion().GetSize();
+  std::vector<size_t> strides(ImageDimension);
+  size_t blockSize = 1;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    strides[dim] = dim == 0 ? 1 : strides[dim - 1] * inputSize[dim - 1];
+    blockSize *= blockMode ? shrinkFactors[dim] : 1;
+  }
+  const PixelType * inputBuffer = input->GetBufferPointer();
+  PixelType *       outputBuffer = output->GetBufferPointer();
+
+  // Each line is the output pixels along the first axis
+  const size_t numberOfLines = numberOfPixels / outputSize[0];
+  const size_t linesPerTask = std::max<size_t>(1, 4096 / (outputSize[0] * blockSize));
+  const size_t numberOfTasks = (numberOfLines + linesPerTask - 1) / linesPerTask;
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfTasks,
+    [&](itk::SizeValueType task) {
+      std::vector<PixelType> block(blockSize);
+      std::vector<size_t>    blockBegin(ImageDimension);
+      std::vector<size_t>    blockEnd(ImageDimension);
+      std::vector<size_t>    blockIndex(ImageDimension);
+      const size_t           endLine = std::min(numberOfLines, (task + 1) * linesPerTask);
+      for (size_t line = task * linesPerTask; line < endLine; ++line)
+      {
+        size_t outputIndex = line;
+        size_t lineOffset = 0;
+        for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+        {
+          const size_t sample = (cropRadius.empty() ? 0 : cropRadius[dim]) + outputIndex % outputSize[dim] * shrinkFactors[dim];
+          outputIndex /= outputSize[dim];
+          lineOffset += sample * strides[dim];
+          // Blocks are centered on their sample, rounding down for even shrink factors
+          blockBegin[dim] = sample - std::min<size_t>(sample, (shrinkFactors[dim] - 1) / 2);
+          blockEnd[dim] = std::min<size_t>(inputSize[dim], sample + shrinkFactors[dim] / 2 + 1);
+        }
+        PixelType * outputLine = outputBuffer + line * outputSize[0];
+        for (size_t ii = 0; ii < outputSize[0]; ++ii)
+        {
+          const size_t    sample = (cropRadius.empty() ? 0 : cropRadius[0]) + ii * shrinkFactors[0];
+          const PixelType sampleLabel = inputBuffer[lineOffset + sample];
+          if (!blockMode)
+          {
+            outputLine[ii] = sampleLabel;
+            continue;
+          }
+
+          blockBegin[0] = sample - std::min<size_t>(sample, (shrinkFactors[0] - 1) / 2);
+          blockEnd[0] = std::min<size_t>(inputSize[0], sample + shrinkFactors[0] / 2 + 1);
+          size_t count = 0;
+          blockIndex = blockBegin;
+          while (true)
+          {
+            size_t offset = 0;
+            for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+            {
+              offset += blockIndex[dim] * strides[dim];
+            }
+            const PixelType * blockLine = inputBuffer + offset;
+            for (size_t jj = blockBegin[0]; jj < blockEnd[0]; ++jj)
+            {
+              block[count++] = blockLine[jj];
+            }
+            unsigned int dim = 1;
+            for (; dim < ImageDimension; ++dim)
+            {
+              if (++blockIndex[dim] < blockEnd[dim])
+              {
+                break;
+              }
+              blockIndex[dim] = blockBegin[dim];
+            }
+            if (dim == ImageDimension)
+            {
+              break;
+            }
+          }
+
+          std::sort(block.begin(), block.begin() + count);
+          PixelType mode = sampleLabel;
+          size_t    modeCount = 0;
+          for (size_t begin = 0; begin < count;)
+          {
+            size_t end = begin + 1;
+            while (end < count && block[end] == block[begin])
+            {
+              ++end;
+            }
+            if (end - begin > modeCount || (end - begin == modeCount && block[begin] == sampleLabel))
+            {
+              mode = block[begin];
+              modeCount = end - begin;
+            }
+            begin = end;
+          }
+          outputLine[ii] = mode;
+        }
+      }
+    },
+    nullptr);
+
+  return output;
+}
+
+#endif
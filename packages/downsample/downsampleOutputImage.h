@@ -0,0 +1,119 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef downsampleOutputImage_h
+#define downsampleOutputImage_h
+
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include <vector>
+
+/** Create the image information of the samples kept when downsampling the
+ * inputRegion of the input, every shrinkFactors pixel from cropRadius,
+ * without allocating its pixels.
+ *
+ * Its start index is the start index of the input region, and its origin,
+ * spacing, and direction place each pixel at the physical point of its input
+ * sample. */
+template <typename TImage>
+typename TImage::Pointer
+downsampleOutputInformation(const TImage * input,
+                            const typename TImage::RegionType & inputRegion,
+                            const std::vector<unsigned int> & shrinkFactors,
+                            const std::vector<unsigned int> & cropRadius,
+                            const typename TImage::SizeType & outputSize)
+{
+  using ImageType = TImage;
+  constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+
+  auto output = ImageType::New();
+  typename ImageType::RegionType outputRegion;
+  outputRegion.SetIndex(inputRegion.GetIndex());
+  outputRegion.SetSize(outputSize);
+  output->SetRegions(outputRegion);
+  output->SetDirection(input->GetDirection());
+  typename ImageType::SpacingType outputSpacing;
+  typename ImageType::IndexType firstSample;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    outputSpacing[dim] = input->GetSpacing()[dim] * shrinkFactors[dim];
+    firstSample[dim] = inputRegion.GetIndex(dim) + (cropRadius.empty() ? 0 : cropRadius[dim]);
+  }
+  output->SetSpacing(outputSpacing);
+  // The output start index is at the first sample
+  typename ImageType::PointType firstSamplePoint;
+  input->TransformIndexToPhysicalPoint(firstSample, firstSamplePoint);
+  typename ImageType::PointType outputOrigin = firstSamplePoint;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    for (unsigned int row = 0; row < ImageDimension; ++row)
+    {
+      outputOrigin[row] -= input->GetDirection()[row][dim] * outputSpacing[dim] * outputRegion.GetIndex(dim);
+    }
+  }
+  output->SetOrigin(outputOrigin);
+
+  return output;
+}
+
+/** Allocate the image of the samples kept when downsampling the buffered
+ * region of the input, see downsampleOutputInformation. */
+template <typename TImage>
+typename TImage::Pointer
+downsampleOutputImage(const TImage * input,
+                      const std::vector<unsigned int> & shrinkFactors,
+                      const std::vector<unsigned int> & cropRadius,
+                      const typename TImage::SizeType & outputSize)
+{
+  auto output = downsampleOutputInformation<TImage>(input, input->GetBufferedRegion(), shrinkFactors, cropRadius, outputSize);
+  output->Allocate();
+
+  return output;
+}
+
+
+/** The input samples kept when downsampling, without smoothing, on the grid
+ * of downsampleOutputImage. A coarse preview of a downsampled image that
+ * costs a copy of the output pixels. */
+template <typename TImage>
+typename TImage::Pointer
+downsampleSubsample(const TImage * input,
+                    const std::vector<unsigned int> & shrinkFactors,
+                    const std::vector<unsigned int> & cropRadius,
+                    const typename TImage::SizeType & outputSize)
+{
+  using ImageType = TImage;
+  constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+
+  auto output = downsampleOutputImage<ImageType>(input, shrinkFactors, cropRadius, outputSize);
+  const auto inputIndex = input->GetBufferedRegion().GetIndex();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(output, output->GetBufferedRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    typename ImageType::IndexType sample;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      const auto first = inputIndex[dim] + (cropRadius.empty() ? 0 : cropRadius[dim]);
+      sample[dim] = first + (it.GetIndex()[dim] - inputIndex[dim]) * shrinkFactors[dim];
+    }
+    it.Set(input->GetPixel(sample));
+  }
+
+  return output;
+}
+
+#endif
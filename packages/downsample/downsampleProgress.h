@@ -0,0 +1,65 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef downsampleProgress_h
+#define downsampleProgress_h
+
+#include "itkMacro.h"
+#include "itkProcessObject.h"
+
+/** The downsample passes are not ITK filters. This process object carries
+ * their progress and abort requests, so it can be registered with
+ * itk::wasm::Pipeline::observe_progress and
+ * itk::wasm::Pipeline::abort_on_request. */
+class DownsampleProgress : public itk::ProcessObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(DownsampleProgress);
+
+  using Self = DownsampleProgress;
+  using Superclass = itk::ProcessObject;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+  itkTypeMacro(DownsampleProgress, ProcessObject);
+
+protected:
+  DownsampleProgress() = default;
+  ~DownsampleProgress() override = default;
+};
+
+/** Report that the fraction progress of the work is done, when there is a
+ * progress process object. Throws itk::ProcessAborted, as the ITK progress
+ * reporters do, when the process object was aborted. */
+inline void
+downsampleUpdateProgress(itk::ProcessObject * progress, float fraction)
+{
+  if (progress == nullptr)
+  {
+    return;
+  }
+  progress->UpdateProgress(fraction);
+  if (progress->GetAbortGenerateData())
+  {
+    itk::ProcessAborted aborted(__FILE__, __LINE__);
+    aborted.SetDescription("AbortGenerateData was called during downsample");
+    throw aborted;
+  }
+}
+
+#endif
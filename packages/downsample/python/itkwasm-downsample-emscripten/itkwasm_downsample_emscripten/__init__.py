@@ -4,6 +4,8 @@
 
 from .downsample_bin_shrink_async import downsample_bin_shrink_async
 from .downsample_label_image_async import downsample_label_image_async
+from .downsample_pyramid_async import downsample_pyramid_async
+from .downsample_streaming_async import downsample_streaming_async
 from .downsample_sigma_async import downsample_sigma_async
 from .downsample_async import downsample_async
 from .gaussian_kernel_radius_async import gaussian_kernel_radius_async
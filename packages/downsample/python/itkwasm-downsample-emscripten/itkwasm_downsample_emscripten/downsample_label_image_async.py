@@ -20,6 +20,7 @@ async def downsample_label_image_async(
     input: Image,
     shrink_factors: List[int] = [],
     crop_radius: Optional[List[int]] = None,
+    block_mode: bool = False,
 ) -> Image:
     """Subsample the input label image a according to weighted voting of local labels.
 
@@ -32,6 +33,9 @@ async def downsample_label_image_async(
     :param crop_radius: Optional crop radius in pixel units.
     :type  crop_radius: int
 
+    :param block_mode: Set each output pixel to the most frequent label of its shrink factors block instead of the label at its sample.
+    :type  block_mode: bool
+
     :return: Output downsampled image
     :rtype:  Image
     """
@@ -43,6 +47,8 @@ async def downsample_label_image_async(
         kwargs["shrinkFactors"] = to_js(shrink_factors)
     if crop_radius:
         kwargs["cropRadius"] = to_js(crop_radius)
+    if block_mode:
+        kwargs["blockMode"] = to_js(block_mode)
 
     outputs = await js_module.downsampleLabelImage(to_js(input), webWorker=web_worker, noCopy=True, **kwargs)
 
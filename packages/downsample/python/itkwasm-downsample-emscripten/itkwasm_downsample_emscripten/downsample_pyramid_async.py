@@ -0,0 +1,66 @@
+from pathlib import Path
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from .js_package import js_package
+
+from itkwasm.pyodide import (
+    to_js,
+    to_py,
+    js_resources
+)
+from itkwasm import (
+    InterfaceTypes,
+    Image,
+)
+
+async def downsample_pyramid_async(
+    input: Image,
+    shrink_factors: Optional[List[int]] = None,
+    minimum_size: int = 1,
+    number_of_levels: Optional[int] = None,
+) -> List[Image]:
+    """Generate a multiscale pyramid, each level smoothed with an anti-alias filter and subsampled from the previous level.
+
+    :param input: Input image
+    :type  input: Image
+
+    :param shrink_factors: Shrink factors of each level relative to the previous level. Either one factor per dimension for all levels, or one factor per dimension for each level, finest level first.
+    :type  shrink_factors: int
+
+    :param minimum_size: Minimum size in pixels. A dimension is not shrunk further when it would become smaller.
+    :type  minimum_size: int
+
+    :param number_of_levels: Number of pyramid levels. By default, one level per set of shrink factors when there is one factor per dimension for each level, otherwise 1.
+    :type  number_of_levels: int
+
+    :return: Output pyramid levels, finest first, each downsampled from the previous level
+    :rtype:  List[Image]
+    """
+    js_module = await js_package.js_module
+    web_worker = js_resources.web_worker
+
+    kwargs = {}
+    if shrink_factors:
+        kwargs["shrinkFactors"] = to_js(shrink_factors)
+    if minimum_size:
+        kwargs["minimumSize"] = to_js(minimum_size)
+    if number_of_levels is not None:
+        kwargs["numberOfLevels"] = to_js(number_of_levels)
+
+    outputs = await js_module.downsamplePyramid(to_js(input), webWorker=web_worker, noCopy=True, **kwargs)
+
+    output_web_worker = None
+    output_list = []
+    outputs_object_map = outputs.as_object_map()
+    for output_name in outputs.object_keys():
+        if output_name == 'webWorker':
+            output_web_worker = outputs_object_map[output_name]
+        else:
+            output_list.append(to_py(outputs_object_map[output_name]))
+
+    js_resources.web_worker = output_web_worker
+
+    if len(output_list) == 1:
+        return output_list[0]
+    return tuple(output_list)
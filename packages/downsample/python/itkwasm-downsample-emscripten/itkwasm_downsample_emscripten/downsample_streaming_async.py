@@ -0,0 +1,69 @@
+# Generated file. To retain edits, remove this comment.
+
+from pathlib import Path
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from .js_package import js_package
+
+from itkwasm.pyodide import (
+    to_js,
+    to_py,
+    js_resources
+)
+from itkwasm import (
+    InterfaceTypes,
+    BinaryFile,
+)
+
+async def downsample_streaming_async(
+    serialized_input: os.PathLike,
+    serialized_downsampled: str,
+    shrink_factors: List[int] = [],
+    crop_radius: Optional[List[int]] = None,
+    slab_size: int = 16,
+) -> os.PathLike:
+    """Apply a smoothing anti-alias filter and subsample an input image file, one slab at a time, with memory bounded by the slab size.
+
+    :param serialized_input: Input image, a .iwi directory or .iwi.cbor file read by slab
+    :type  serialized_input: os.PathLike
+
+    :param serialized_downsampled: Output downsampled image, a .iwi directory or .iwi.cbor file written by slab
+    :type  serialized_downsampled: str
+
+    :param shrink_factors: Shrink factors
+    :type  shrink_factors: int
+
+    :param crop_radius: Optional crop radius in pixel units.
+    :type  crop_radius: int
+
+    :param slab_size: Number of output slices along the last axis computed and written at a time. Defaults to the largest slab within --max-memory when it is given, otherwise 16. Not used for images past 3D that are not shrunk along their trailing axes, which are computed one volume at a time.
+    :type  slab_size: int
+    """
+    js_module = await js_package.js_module
+    web_worker = js_resources.web_worker
+
+    kwargs = {}
+    if shrink_factors:
+        kwargs["shrinkFactors"] = to_js(shrink_factors)
+    if crop_radius:
+        kwargs["cropRadius"] = to_js(crop_radius)
+    if slab_size:
+        kwargs["slabSize"] = to_js(slab_size)
+
+    outputs = await js_module.downsampleStreaming(to_js(BinaryFile(serialized_input)), to_js(serialized_downsampled), webWorker=web_worker, noCopy=True, **kwargs)
+
+    output_web_worker = None
+    output_list = []
+    outputs_object_map = outputs.as_object_map()
+    for output_name in outputs.object_keys():
+        if output_name == 'webWorker':
+            output_web_worker = outputs_object_map[output_name]
+        else:
+            output_list.append(to_py(outputs_object_map[output_name]))
+
+    js_resources.web_worker = output_web_worker
+
+    if len(output_list) == 1:
+        return output_list[0]
+    return tuple(output_list)
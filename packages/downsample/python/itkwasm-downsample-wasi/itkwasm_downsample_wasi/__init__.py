@@ -4,6 +4,8 @@
 
 from .downsample_bin_shrink import downsample_bin_shrink
 from .downsample_label_image import downsample_label_image
+from .downsample_pyramid import downsample_pyramid
+from .downsample_streaming import downsample_streaming
 from .downsample_sigma import downsample_sigma
 from .downsample import downsample
 from .gaussian_kernel_radius import gaussian_kernel_radius
@@ -20,6 +20,7 @@ def downsample_label_image(
     input: Image,
     shrink_factors: List[int] = [],
     crop_radius: Optional[List[int]] = None,
+    block_mode: bool = False,
 ) -> Image:
     """Subsample the input label image a according to weighted voting of local labels.
 
@@ -32,6 +33,9 @@ def downsample_label_image(
     :param crop_radius: Optional crop radius in pixel units.
     :type  crop_radius: int
 
+    :param block_mode: Set each output pixel to the most frequent label of its shrink factors block instead of the label at its sample.
+    :type  block_mode: bool
+
     :return: Output downsampled image
     :rtype:  Image
     """
@@ -70,6 +74,9 @@ def downsample_label_image(
         for value in crop_radius:
             args.append(str(value))
 
+    if block_mode:
+        args.append('--block-mode')
+
 
     outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
 
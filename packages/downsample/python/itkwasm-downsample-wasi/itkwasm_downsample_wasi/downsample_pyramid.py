@@ -0,0 +1,81 @@
+from pathlib import Path, PurePosixPath
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from importlib_resources import files as file_resources
+
+_pipeline = None
+
+from itkwasm import (
+    InterfaceTypes,
+    PipelineOutput,
+    PipelineInput,
+    Pipeline,
+    Image,
+)
+
+def downsample_pyramid(
+    input: Image,
+    shrink_factors: Optional[List[int]] = None,
+    minimum_size: int = 1,
+    number_of_levels: Optional[int] = None,
+) -> List[Image]:
+    """Generate a multiscale pyramid, each level smoothed with an anti-alias filter and subsampled from the previous level.
+
+    :param input: Input image
+    :type  input: Image
+
+    :param shrink_factors: Shrink factors of each level relative to the previous level. Either one factor per dimension for all levels, or one factor per dimension for each level, finest level first.
+    :type  shrink_factors: int
+
+    :param minimum_size: Minimum size in pixels. A dimension is not shrunk further when it would become smaller.
+    :type  minimum_size: int
+
+    :param number_of_levels: Number of pyramid levels. By default, one level per set of shrink factors when there is one factor per dimension for each level, otherwise 1.
+    :type  number_of_levels: int
+
+    :return: Output pyramid levels, finest first, each downsampled from the previous level
+    :rtype:  List[Image]
+    """
+    global _pipeline
+    if _pipeline is None:
+        _pipeline = Pipeline(file_resources('itkwasm_downsample_wasi').joinpath(Path('wasm_modules') / Path('downsample-pyramid.wasi.wasm')))
+
+    # The pipeline writes one level per output
+    if number_of_levels is None:
+        dimension = input.imageType.dimension
+        number_of_levels = len(shrink_factors) // dimension if shrink_factors is not None and len(shrink_factors) > dimension else 1
+    pipeline_outputs: List[PipelineOutput] = [
+        PipelineOutput(InterfaceTypes.Image) for _ in range(number_of_levels)
+    ]
+
+    pipeline_inputs: List[PipelineInput] = [
+        PipelineInput(InterfaceTypes.Image, input),
+    ]
+
+    args: List[str] = ['--memory-io',]
+    # Inputs
+    args.append('0')
+    # Outputs
+    for index in range(number_of_levels):
+        args.append(str(index))
+
+    # Options
+    input_count = len(pipeline_inputs)
+    if shrink_factors is not None and len(shrink_factors) < 1:
+       raise ValueError('"shrink-factors" kwarg must have a length > 1')
+    if shrink_factors is not None and len(shrink_factors) > 0:
+        args.append('--shrink-factors')
+        for value in shrink_factors:
+            args.append(str(value))
+
+    if minimum_size:
+        args.append('--minimum-size')
+        args.append(str(minimum_size))
+
+
+    outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
+
+    result = [output.data for output in outputs]
+    return result
+
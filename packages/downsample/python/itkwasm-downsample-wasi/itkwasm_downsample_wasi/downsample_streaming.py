@@ -0,0 +1,87 @@
+# Generated file. To retain edits, remove this comment.
+
+from pathlib import Path, PurePosixPath
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from importlib_resources import files as file_resources
+
+_pipeline = None
+
+from itkwasm import (
+    InterfaceTypes,
+    PipelineOutput,
+    PipelineInput,
+    Pipeline,
+    BinaryFile,
+)
+
+def downsample_streaming(
+    serialized_input: os.PathLike,
+    serialized_downsampled: str,
+    shrink_factors: List[int] = [],
+    crop_radius: Optional[List[int]] = None,
+    slab_size: int = 16,
+) -> os.PathLike:
+    """Apply a smoothing anti-alias filter and subsample an input image file, one slab at a time, with memory bounded by the slab size.
+
+    :param serialized_input: Input image, a .iwi directory or .iwi.cbor file read by slab
+    :type  serialized_input: os.PathLike
+
+    :param serialized_downsampled: Output downsampled image, a .iwi directory or .iwi.cbor file written by slab
+    :type  serialized_downsampled: str
+
+    :param shrink_factors: Shrink factors
+    :type  shrink_factors: int
+
+    :param crop_radius: Optional crop radius in pixel units.
+    :type  crop_radius: int
+
+    :param slab_size: Number of output slices along the last axis computed and written at a time. Defaults to the largest slab within --max-memory when it is given, otherwise 16. Not used for images past 3D that are not shrunk along their trailing axes, which are computed one volume at a time.
+    :type  slab_size: int
+    """
+    global _pipeline
+    if _pipeline is None:
+        _pipeline = Pipeline(file_resources('itkwasm_downsample_wasi').joinpath(Path('wasm_modules') / Path('downsample-streaming.wasi.wasm')))
+
+    pipeline_outputs: List[PipelineOutput] = [
+        PipelineOutput(InterfaceTypes.BinaryFile, BinaryFile(PurePosixPath(serialized_downsampled))),
+    ]
+
+    pipeline_inputs: List[PipelineInput] = [
+        PipelineInput(InterfaceTypes.BinaryFile, BinaryFile(PurePosixPath(serialized_input))),
+    ]
+
+    args: List[str] = ['--memory-io',]
+    # Inputs
+    if not Path(serialized_input).exists():
+        raise FileNotFoundError("serialized_input does not exist")
+    args.append(str(PurePosixPath(serialized_input)))
+    # Outputs
+    serialized_downsampled_name = str(PurePosixPath(serialized_downsampled))
+    args.append(serialized_downsampled_name)
+
+    # Options
+    input_count = len(pipeline_inputs)
+    if len(shrink_factors) < 1:
+       raise ValueError('"shrink-factors" kwarg must have a length > 1')
+    if len(shrink_factors) > 0:
+        args.append('--shrink-factors')
+        for value in shrink_factors:
+            args.append(str(value))
+
+    if crop_radius is not None and len(crop_radius) < 1:
+       raise ValueError('"crop-radius" kwarg must have a length > 1')
+    if crop_radius is not None and len(crop_radius) > 0:
+        args.append('--crop-radius')
+        for value in crop_radius:
+            args.append(str(value))
+
+    if slab_size:
+        args.append('--slab-size')
+        args.append(str(slab_size))
+
+
+    outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
+
+
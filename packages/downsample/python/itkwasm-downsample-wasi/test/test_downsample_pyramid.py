@@ -0,0 +1,17 @@
+from itkwasm_image_io import read_image
+
+from itkwasm_downsample_wasi import downsample_pyramid
+
+from .common import test_input_path
+
+def test_downsample_pyramid():
+    test_input_file_path = test_input_path / 'cthead1.png'
+
+    image = read_image(test_input_file_path)
+    levels = downsample_pyramid(image, shrink_factors=[2, 2], number_of_levels=3)
+
+    assert len(levels) == 3
+    size = image.size
+    for level in levels:
+        size = [s // 2 for s in size]
+        assert list(level.size) == size
@@ -1,8 +1,19 @@
-# Generated file. To retain edits, remove this comment.
+import numpy as np
+
+from itkwasm import image_from_array
 
 from itkwasm_downsample_wasi import downsample
 
 from .common import test_input_path, test_output_path
 
-def test_downsample():
-    pass
+def test_downsample_time_series():
+    rng = np.random.default_rng(0)
+    time_series = rng.random((3, 6, 8, 10), dtype=np.float32)
+
+    # Not shrunk along time, so each volume is downsampled on its own
+    downsampled = downsample(image_from_array(time_series), shrink_factors=[2, 2, 2, 1])
+    assert list(downsampled.size) == [5, 4, 3, 3]
+
+    for timepoint in range(time_series.shape[0]):
+        volume = downsample(image_from_array(np.ascontiguousarray(time_series[timepoint])), shrink_factors=[2, 2, 2])
+        np.testing.assert_allclose(downsampled.data[timepoint], volume.data)
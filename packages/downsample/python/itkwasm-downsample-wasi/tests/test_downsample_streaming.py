@@ -0,0 +1,8 @@
+# Generated file. To retain edits, remove this comment.
+
+from itkwasm_downsample_wasi import downsample_streaming
+
+from .common import test_input_path, test_output_path
+
+def test_downsample_streaming():
+    pass
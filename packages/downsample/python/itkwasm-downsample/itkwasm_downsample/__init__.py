@@ -6,6 +6,10 @@ from .downsample_bin_shrink_async import downsample_bin_shrink_async
 from .downsample_bin_shrink import downsample_bin_shrink
 from .downsample_label_image_async import downsample_label_image_async
 from .downsample_label_image import downsample_label_image
+from .downsample_pyramid_async import downsample_pyramid_async
+from .downsample_pyramid import downsample_pyramid
+from .downsample_streaming_async import downsample_streaming_async
+from .downsample_streaming import downsample_streaming
 from .downsample_sigma_async import downsample_sigma_async
 from .downsample_sigma import downsample_sigma
 from .downsample_async import downsample_async
@@ -12,6 +12,7 @@ async def downsample_label_image_async(
     input: Image,
     shrink_factors: List[int] = [],
     crop_radius: Optional[List[int]] = None,
+    block_mode: bool = False,
 ) -> Image:
     """Subsample the input label image a according to weighted voting of local labels.
 
@@ -24,9 +25,12 @@ async def downsample_label_image_async(
     :param crop_radius: Optional crop radius in pixel units.
     :type  crop_radius: int
 
+    :param block_mode: Set each output pixel to the most frequent label of its shrink factors block instead of the label at its sample.
+    :type  block_mode: bool
+
     :return: Output downsampled image
     :rtype:  Image
     """
     func = environment_dispatch("itkwasm_downsample", "downsample_label_image_async")
-    output = await func(input, shrink_factors=shrink_factors, crop_radius=crop_radius)
+    output = await func(input, shrink_factors=shrink_factors, crop_radius=crop_radius, block_mode=block_mode)
     return output
@@ -0,0 +1,34 @@
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from itkwasm import (
+    environment_dispatch,
+    Image,
+)
+
+def downsample_pyramid(
+    input: Image,
+    shrink_factors: Optional[List[int]] = None,
+    minimum_size: int = 1,
+    number_of_levels: Optional[int] = None,
+) -> List[Image]:
+    """Generate a multiscale pyramid, each level smoothed with an anti-alias filter and subsampled from the previous level.
+
+    :param input: Input image
+    :type  input: Image
+
+    :param shrink_factors: Shrink factors of each level relative to the previous level. Either one factor per dimension for all levels, or one factor per dimension for each level, finest level first.
+    :type  shrink_factors: int
+
+    :param minimum_size: Minimum size in pixels. A dimension is not shrunk further when it would become smaller.
+    :type  minimum_size: int
+
+    :param number_of_levels: Number of pyramid levels. By default, one level per set of shrink factors when there is one factor per dimension for each level, otherwise 1.
+    :type  number_of_levels: int
+
+    :return: Output pyramid levels, finest first, each downsampled from the previous level
+    :rtype:  List[Image]
+    """
+    func = environment_dispatch("itkwasm_downsample", "downsample_pyramid")
+    output = func(input, shrink_factors=shrink_factors, minimum_size=minimum_size, number_of_levels=number_of_levels)
+    return output
@@ -0,0 +1,37 @@
+# Generated file. Do not edit.
+
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from itkwasm import (
+    environment_dispatch,
+    BinaryFile,
+)
+
+async def downsample_streaming_async(
+    serialized_input: os.PathLike,
+    serialized_downsampled: str,
+    shrink_factors: List[int] = [],
+    crop_radius: Optional[List[int]] = None,
+    slab_size: int = 16,
+) -> os.PathLike:
+    """Apply a smoothing anti-alias filter and subsample an input image file, one slab at a time, with memory bounded by the slab size.
+
+    :param serialized_input: Input image, a .iwi directory or .iwi.cbor file read by slab
+    :type  serialized_input: os.PathLike
+
+    :param serialized_downsampled: Output downsampled image, a .iwi directory or .iwi.cbor file written by slab
+    :type  serialized_downsampled: str
+
+    :param shrink_factors: Shrink factors
+    :type  shrink_factors: int
+
+    :param crop_radius: Optional crop radius in pixel units.
+    :type  crop_radius: int
+
+    :param slab_size: Number of output slices along the last axis computed and written at a time. Defaults to the largest slab within --max-memory when it is given, otherwise 16. Not used for images past 3D that are not shrunk along their trailing axes, which are computed one volume at a time.
+    :type  slab_size: int
+    """
+    func = environment_dispatch("itkwasm_downsample", "downsample_streaming_async")
+    output = await func(serialized_input, serialized_downsampled, shrink_factors=shrink_factors, crop_radius=crop_radius, slab_size=slab_size)
+    return output
@@ -1,5 +1,3 @@
-// Generated file. To retain edits, remove this comment.
-
 import {
   Image,
   InterfaceTypes,
@@ -15,6 +13,7 @@ import { getPipelinesBaseUrl } from './pipelines-base-url.js'
 import { getPipelineWorkerUrl } from './pipeline-worker-url.js'
 
 import { getDefaultWebWorker } from './default-web-worker.js'
+import { downsampleBinShrinkWebGPU } from './downsample-webgpu.js'
 
 /**
  * Apply local averaging and subsample the input image.
@@ -63,6 +62,13 @@ async function downsampleBinShrink(
     options.informationOnly && args.push('--information-only')
   }
 
+  if (options.webgpu !== false && !options.informationOnly) {
+    const downsampled = await downsampleBinShrinkWebGPU(input, options.shrinkFactors)
+    if (downsampled !== null) {
+      return { webWorker: (options.webWorker ?? null) as Worker, downsampled }
+    }
+  }
+
   const pipelinePath = 'downsample-bin-shrink'
 
   let workerToUse = options?.webWorker
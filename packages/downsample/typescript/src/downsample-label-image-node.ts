@@ -68,6 +68,9 @@ async function downsampleLabelImageNode(
 
     })
   }
+  if (options.blockMode) {
+    options.blockMode && args.push('--block-mode')
+  }
 
   const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'downsample-label-image')
 
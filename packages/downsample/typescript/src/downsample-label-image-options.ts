@@ -9,6 +9,9 @@ interface DownsampleLabelImageOptions extends WorkerPoolFunctionOption {
   /** Optional crop radius in pixel units. */
   cropRadius?: number[]
 
+  /** Set each output pixel to the most frequent label of its shrink factors block instead of the label at its sample. */
+  blockMode?: boolean
+
 }
 
 export default DownsampleLabelImageOptions
@@ -70,6 +70,9 @@ async function downsampleLabelImage(
 
     }))
   }
+  if (options.blockMode) {
+    options.blockMode && args.push('--block-mode')
+  }
 
   const pipelinePath = 'downsample-label-image'
 
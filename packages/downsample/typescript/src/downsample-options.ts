@@ -1,5 +1,3 @@
-// Generated file. To retain edits, remove this comment.
-
 import { WorkerPoolFunctionOption } from 'itk-wasm'
 
 interface DownsampleOptions extends WorkerPoolFunctionOption {
@@ -9,6 +7,9 @@ interface DownsampleOptions extends WorkerPoolFunctionOption {
   /** Optional crop radius in pixel units. */
   cropRadius?: number[]
 
+  /** Smooth and subsample on the GPU when a WebGPU device is available. Defaults to true. Otherwise, or when the image is not supported, the pipeline runs. */
+  webgpu?: boolean
+
 }
 
 export default DownsampleOptions
@@ -0,0 +1,15 @@
+// Generated file. To retain edits, remove this comment.
+
+interface DownsamplePyramidNodeOptions {
+  /** Shrink factors of each level relative to the previous level. Either one factor per dimension for all levels, or one factor per dimension for each level, finest level first. */
+  shrinkFactors?: number[]
+
+  /** Minimum size in pixels. A dimension is not shrunk further when it would become smaller. */
+  minimumSize?: number
+
+  /** Number of pyramid levels. By default, one level per set of shrink factors when there is one factor per dimension for each level, otherwise 1. */
+  numberOfLevels?: number
+
+}
+
+export default DownsamplePyramidNodeOptions
@@ -0,0 +1,11 @@
+// Generated file. To retain edits, remove this comment.
+
+import { Image } from 'itk-wasm'
+
+interface DownsamplePyramidNodeResult {
+  /** Output pyramid levels, finest first, each downsampled from the previous level */
+  levels: Image[]
+
+}
+
+export default DownsamplePyramidNodeResult
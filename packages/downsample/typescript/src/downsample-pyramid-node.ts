@@ -0,0 +1,86 @@
+import {
+  Image,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipelineNode
+} from 'itk-wasm'
+
+import DownsamplePyramidNodeOptions from './downsample-pyramid-node-options.js'
+import DownsamplePyramidNodeResult from './downsample-pyramid-node-result.js'
+
+import path from 'path'
+import { fileURLToPath } from 'url'
+
+/**
+ * Generate a multiscale pyramid, each level smoothed with an anti-alias filter and subsampled from the previous level.
+ *
+ * @param {Image} input - Input image
+ * @param {DownsamplePyramidNodeOptions} options - options object
+ *
+ * @returns {Promise<DownsamplePyramidNodeResult>} - result object
+ */
+async function downsamplePyramidNode(
+  input: Image,
+  options: DownsamplePyramidNodeOptions = {}
+) : Promise<DownsamplePyramidNodeResult> {
+
+  // The pipeline writes one level per output
+  const dimension = input.imageType.dimension
+  const shrinkFactorsLength = options.shrinkFactors?.length ?? 0
+  const numberOfLevels = options.numberOfLevels ?? (shrinkFactorsLength > dimension ? Math.floor(shrinkFactorsLength / dimension) : 1)
+  const desiredOutputs: Array<PipelineOutput> = []
+  for (let index = 0; index < numberOfLevels; index++) {
+    desiredOutputs.push({ type: InterfaceTypes.Image })
+  }
+
+  const inputs: Array<PipelineInput> = [
+    { type: InterfaceTypes.Image, data: input },
+  ]
+
+  const args = []
+  // Inputs
+  const inputName = '0'
+  args.push(inputName)
+
+  // Outputs
+  for (let index = 0; index < numberOfLevels; index++) {
+    args.push(index.toString())
+  }
+
+  // Options
+  args.push('--memory-io')
+  if (options.shrinkFactors) {
+    if(options.shrinkFactors.length < 1) {
+      throw new Error('"shrink-factors" option must have a length > 1')
+    }
+    args.push('--shrink-factors')
+
+    options.shrinkFactors.forEach((value) => {
+      args.push(value.toString())
+
+    })
+  }
+  if (options.minimumSize) {
+    args.push('--minimum-size', options.minimumSize.toString())
+
+  }
+
+  const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'downsample-pyramid')
+
+  const {
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipelineNode(pipelinePath, args, desiredOutputs, inputs)
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    levels: outputs.map((output) => output.data as Image),
+  }
+  return result
+}
+
+export default downsamplePyramidNode
@@ -0,0 +1,11 @@
+// Generated file. To retain edits, remove this comment.
+
+import { Image, WorkerPoolFunctionResult } from 'itk-wasm'
+
+interface DownsamplePyramidResult extends WorkerPoolFunctionResult {
+  /** Output pyramid levels, finest first, each downsampled from the previous level */
+  levels: Image[]
+
+}
+
+export default DownsamplePyramidResult
@@ -0,0 +1,94 @@
+import {
+  Image,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipeline
+} from 'itk-wasm'
+
+import DownsamplePyramidOptions from './downsample-pyramid-options.js'
+import DownsamplePyramidResult from './downsample-pyramid-result.js'
+
+import { getPipelinesBaseUrl } from './pipelines-base-url.js'
+import { getPipelineWorkerUrl } from './pipeline-worker-url.js'
+
+import { getDefaultWebWorker } from './default-web-worker.js'
+
+/**
+ * Generate a multiscale pyramid, each level smoothed with an anti-alias filter and subsampled from the previous level.
+ *
+ * @param {Image} input - Input image
+ * @param {DownsamplePyramidOptions} options - options object
+ *
+ * @returns {Promise<DownsamplePyramidResult>} - result object
+ */
+async function downsamplePyramid(
+  input: Image,
+  options: DownsamplePyramidOptions = {}
+) : Promise<DownsamplePyramidResult> {
+
+  // The pipeline writes one level per output
+  const dimension = input.imageType.dimension
+  const shrinkFactorsLength = options.shrinkFactors?.length ?? 0
+  const numberOfLevels = options.numberOfLevels ?? (shrinkFactorsLength > dimension ? Math.floor(shrinkFactorsLength / dimension) : 1)
+  const desiredOutputs: Array<PipelineOutput> = []
+  for (let index = 0; index < numberOfLevels; index++) {
+    desiredOutputs.push({ type: InterfaceTypes.Image })
+  }
+
+  const inputs: Array<PipelineInput> = [
+    { type: InterfaceTypes.Image, data: input },
+  ]
+
+  const args = []
+  // Inputs
+  const inputName = '0'
+  args.push(inputName)
+
+  // Outputs
+  for (let index = 0; index < numberOfLevels; index++) {
+    args.push(index.toString())
+  }
+
+  // Options
+  args.push('--memory-io')
+  if (options.shrinkFactors) {
+    if(options.shrinkFactors.length < 1) {
+      throw new Error('"shrink-factors" option must have a length > 1')
+    }
+    args.push('--shrink-factors')
+
+    await Promise.all(options.shrinkFactors.map(async (value) => {
+      args.push(value.toString())
+
+    }))
+  }
+  if (options.minimumSize) {
+    args.push('--minimum-size', options.minimumSize.toString())
+
+  }
+
+  const pipelinePath = 'downsample-pyramid'
+
+  let workerToUse = options?.webWorker
+  if (workerToUse === undefined) {
+    workerToUse = await getDefaultWebWorker()
+  }
+  const {
+    webWorker: usedWebWorker,
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipeline(pipelinePath, args, desiredOutputs, inputs, { pipelineBaseUrl: getPipelinesBaseUrl(), pipelineWorkerUrl: getPipelineWorkerUrl(), webWorker: workerToUse, noCopy: options?.noCopy })
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    webWorker: usedWebWorker as Worker,
+    levels: outputs.map((output) => output.data as Image),
+  }
+  return result
+}
+
+export default downsamplePyramid
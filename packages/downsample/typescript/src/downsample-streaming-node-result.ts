@@ -0,0 +1,7 @@
+// Generated file. To retain edits, remove this comment.
+
+interface DownsampleStreamingNodeResult {
+  /** Output downsampled image, a .iwi directory or .iwi.cbor file written by slab */
+}
+
+export default DownsampleStreamingNodeResult
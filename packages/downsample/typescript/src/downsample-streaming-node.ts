@@ -0,0 +1,94 @@
+// Generated file. To retain edits, remove this comment.
+
+import {
+  PipelineOutput,
+  PipelineInput,
+  runPipelineNode
+} from 'itk-wasm'
+
+import DownsampleStreamingNodeOptions from './downsample-streaming-node-options.js'
+import DownsampleStreamingNodeResult from './downsample-streaming-node-result.js'
+
+import path from 'path'
+import { fileURLToPath } from 'url'
+
+/**
+ * Apply a smoothing anti-alias filter and subsample an input image file, one slab at a time, with memory bounded by the slab size.
+ *
+ * @param {string} serializedInput - Input image, a .iwi directory or .iwi.cbor file read by slab
+ * @param {string} serializedDownsampled - Output downsampled image, a .iwi directory or .iwi.cbor file written by slab
+ * @param {DownsampleStreamingNodeOptions} options - options object
+ *
+ * @returns {Promise<DownsampleStreamingNodeResult>} - result object
+ */
+async function downsampleStreamingNode(
+  serializedInput: string,
+  serializedDownsampled: string,
+  options: DownsampleStreamingNodeOptions = { shrinkFactors: [] as number[], }
+) : Promise<DownsampleStreamingNodeResult> {
+
+  const mountDirs: Set<string> = new Set()
+
+  const desiredOutputs: Array<PipelineOutput> = [
+  ]
+
+  mountDirs.add(path.dirname(serializedInput as string))
+  const inputs: Array<PipelineInput> = [
+  ]
+
+  const args = []
+  // Inputs
+  const serializedInputName = serializedInput
+  args.push(serializedInputName)
+  mountDirs.add(path.dirname(serializedInputName))
+
+  // Outputs
+  const serializedDownsampledName = serializedDownsampled
+  args.push(serializedDownsampledName)
+  mountDirs.add(path.dirname(serializedDownsampledName))
+
+  // Options
+  args.push('--memory-io')
+  if (options.shrinkFactors) {
+    if(options.shrinkFactors.length < 1) {
+      throw new Error('"shrink-factors" option must have a length > 1')
+    }
+    args.push('--shrink-factors')
+
+    options.shrinkFactors.forEach((value) => {
+      args.push(value.toString())
+
+    })
+  }
+  if (options.cropRadius) {
+    if(options.cropRadius.length < 1) {
+      throw new Error('"crop-radius" option must have a length > 1')
+    }
+    args.push('--crop-radius')
+
+    options.cropRadius.forEach((value) => {
+      args.push(value.toString())
+
+    })
+  }
+  if (options.slabSize) {
+    args.push('--slab-size', options.slabSize.toString())
+
+  }
+
+  const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'downsample-streaming')
+
+  const {
+    returnValue,
+    stderr,
+  } = await runPipelineNode(pipelinePath, args, desiredOutputs, inputs, mountDirs)
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+  }
+  return result
+}
+
+export default downsampleStreamingNode
@@ -0,0 +1,17 @@
+// Generated file. To retain edits, remove this comment.
+
+import { WorkerPoolFunctionOption } from 'itk-wasm'
+
+interface DownsampleStreamingOptions extends WorkerPoolFunctionOption {
+  /** Shrink factors */
+  shrinkFactors: number[]
+
+  /** Optional crop radius in pixel units. */
+  cropRadius?: number[]
+
+  /** Number of output slices along the last axis computed and written at a time. Defaults to the largest slab within --max-memory when it is given, otherwise 16. Not used for images past 3D that are not shrunk along their trailing axes, which are computed one volume at a time. */
+  slabSize?: number
+
+}
+
+export default DownsampleStreamingOptions
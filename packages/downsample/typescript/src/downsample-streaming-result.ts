@@ -0,0 +1,11 @@
+// Generated file. To retain edits, remove this comment.
+
+import { BinaryFile, WorkerPoolFunctionResult } from 'itk-wasm'
+
+interface DownsampleStreamingResult extends WorkerPoolFunctionResult {
+  /** Output downsampled image, a .iwi directory or .iwi.cbor file written by slab */
+  serializedDownsampled: BinaryFile
+
+}
+
+export default DownsampleStreamingResult
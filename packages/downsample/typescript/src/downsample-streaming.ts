@@ -0,0 +1,108 @@
+// Generated file. To retain edits, remove this comment.
+
+import {
+  BinaryFile,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipeline
+} from 'itk-wasm'
+
+import DownsampleStreamingOptions from './downsample-streaming-options.js'
+import DownsampleStreamingResult from './downsample-streaming-result.js'
+
+import { getPipelinesBaseUrl } from './pipelines-base-url.js'
+import { getPipelineWorkerUrl } from './pipeline-worker-url.js'
+
+import { getDefaultWebWorker } from './default-web-worker.js'
+
+/**
+ * Apply a smoothing anti-alias filter and subsample an input image file, one slab at a time, with memory bounded by the slab size.
+ *
+ * @param {File | BinaryFile} serializedInput - Input image, a .iwi directory or .iwi.cbor file read by slab
+ * @param {string} serializedDownsampled - Output downsampled image, a .iwi directory or .iwi.cbor file written by slab
+ * @param {DownsampleStreamingOptions} options - options object
+ *
+ * @returns {Promise<DownsampleStreamingResult>} - result object
+ */
+async function downsampleStreaming(
+  serializedInput: File | BinaryFile,
+  serializedDownsampled: string,
+  options: DownsampleStreamingOptions = { shrinkFactors: [] as number[], }
+) : Promise<DownsampleStreamingResult> {
+
+  const desiredOutputs: Array<PipelineOutput> = [
+    { type: InterfaceTypes.BinaryFile, data: { path: serializedDownsampled, data: new Uint8Array() }},
+  ]
+
+  let serializedInputFile = serializedInput
+  if (serializedInput instanceof File) {
+    const serializedInputBuffer = await serializedInput.arrayBuffer()
+    serializedInputFile = { path: serializedInput.name, data: new Uint8Array(serializedInputBuffer) }
+  }
+  const inputs: Array<PipelineInput> = [
+    { type: InterfaceTypes.BinaryFile, data: serializedInputFile as BinaryFile },
+  ]
+
+  const args = []
+  // Inputs
+  const serializedInputName = (serializedInputFile as BinaryFile).path
+  args.push(serializedInputName)
+
+  // Outputs
+  const serializedDownsampledName = serializedDownsampled
+  args.push(serializedDownsampledName)
+
+  // Options
+  args.push('--memory-io')
+  if (options.shrinkFactors) {
+    if(options.shrinkFactors.length < 1) {
+      throw new Error('"shrink-factors" option must have a length > 1')
+    }
+    args.push('--shrink-factors')
+
+    await Promise.all(options.shrinkFactors.map(async (value) => {
+      args.push(value.toString())
+
+    }))
+  }
+  if (options.cropRadius) {
+    if(options.cropRadius.length < 1) {
+      throw new Error('"crop-radius" option must have a length > 1')
+    }
+    args.push('--crop-radius')
+
+    await Promise.all(options.cropRadius.map(async (value) => {
+      args.push(value.toString())
+
+    }))
+  }
+  if (options.slabSize) {
+    args.push('--slab-size', options.slabSize.toString())
+
+  }
+
+  const pipelinePath = 'downsample-streaming'
+
+  let workerToUse = options?.webWorker
+  if (workerToUse === undefined) {
+    workerToUse = await getDefaultWebWorker()
+  }
+  const {
+    webWorker: usedWebWorker,
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipeline(pipelinePath, args, desiredOutputs, inputs, { pipelineBaseUrl: getPipelinesBaseUrl(), pipelineWorkerUrl: getPipelineWorkerUrl(), webWorker: workerToUse, noCopy: options?.noCopy })
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    webWorker: usedWebWorker as Worker,
+    serializedDownsampled: outputs[0]?.data as BinaryFile,
+  }
+  return result
+}
+
+export default downsampleStreaming
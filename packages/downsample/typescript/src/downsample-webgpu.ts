@@ -0,0 +1,442 @@
+// WebGPU compute backend of downsample and downsampleBinShrink
+//
+// The pipelines run on the CPU in WebAssembly. When a WebGPU device is
+// available, the browser functions smooth and decimate on the GPU instead:
+// the input pixel buffer is uploaded as is, the separable Gaussian or the bin
+// averages are computed in float32 compute shaders, and the result is read
+// back into the output image buffer. Images that the device cannot hold, and
+// 64-bit components, which WGSL cannot load, return null so the caller runs
+// the pipeline.
+
+import {
+  Image,
+  ImageType,
+  IntTypes,
+  FloatTypes,
+  PixelTypes,
+  bufferToTypedArray,
+  TypedArray
+} from 'itk-wasm'
+
+import gaussianKernelWeights from './gaussian-kernel-weights.js'
+import {
+  GPUBuffer,
+  GPUBufferUsage,
+  GPUCommandEncoder,
+  GPUDevice,
+  GPUMapMode,
+  GPUShaderModule,
+  navigatorGPU
+} from './webgpu-types.js'
+
+// Maximum buffer dimension: the image dimension and the components
+const maximumDimension = 8
+
+const workgroupSize = 64
+
+let devicePromise: Promise<GPUDevice | null> | null = null
+
+/**
+ * Set the WebGPU device of the downsample functions, e.g. the device of a
+ * viewer, so they share its memory. null disables the WebGPU backend.
+ */
+export function setDownsampleWebGPUDevice (device: GPUDevice | null): void {
+  devicePromise = Promise.resolve(device)
+}
+
+/**
+ * The WebGPU device of the downsample functions, requested with the largest
+ * storage buffers of the adapter, or null when WebGPU is not available.
+ */
+export async function getDownsampleWebGPUDevice (): Promise<GPUDevice | null> {
+  if (devicePromise === null) {
+    devicePromise = (async () => {
+      const gpu = navigatorGPU()
+      if (gpu === undefined) {
+        return null
+      }
+      try {
+        const adapter = await gpu.requestAdapter()
+        if (adapter === null) {
+          return null
+        }
+        const device = await adapter.requestDevice({
+          requiredLimits: {
+            maxStorageBufferBindingSize: adapter.limits.maxStorageBufferBindingSize,
+            maxBufferSize: adapter.limits.maxBufferSize
+          }
+        })
+        device.lost.then(() => { devicePromise = null }).catch(() => {})
+        return device
+      } catch (error) {
+        return null
+      }
+    })()
+  }
+  return await devicePromise
+}
+
+// WGSL expression of component index i of the input words
+function componentLoader (componentType: string): string | null {
+  switch (componentType) {
+    case IntTypes.UInt8:
+      return 'f32(extractBits(input[i / 4u], (i % 4u) * 8u, 8u))'
+    case IntTypes.Int8:
+      return 'f32(extractBits(bitcast<i32>(input[i / 4u]), (i % 4u) * 8u, 8u))'
+    case IntTypes.UInt16:
+      return 'f32(extractBits(input[i / 2u], (i % 2u) * 16u, 16u))'
+    case IntTypes.Int16:
+      return 'f32(extractBits(bitcast<i32>(input[i / 2u]), (i % 2u) * 16u, 16u))'
+    case IntTypes.UInt32:
+      return 'f32(input[i])'
+    case IntTypes.Int32:
+      return 'f32(bitcast<i32>(input[i]))'
+    case FloatTypes.Float32:
+      return 'bitcast<f32>(input[i])'
+    default:
+      return null
+  }
+}
+
+// The parameters of a shader: a header of 8 words, then arrays of
+// maximumDimension words
+function parameters (header: number[], ...arrays: number[][]): Uint32Array {
+  const words = new Uint32Array(8 + arrays.length * maximumDimension)
+  words.set(header)
+  arrays.forEach((array, index) => { words.set(array, 8 + index * maximumDimension) })
+  return words
+}
+
+function storageBuffer (device: GPUDevice, data: ArrayBufferView): GPUBuffer {
+  // Buffer sizes and writes are multiples of 4 bytes
+  const alignedSize = Math.ceil(data.byteLength / 4) * 4
+  const buffer = device.createBuffer({ size: Math.max(alignedSize, 4), usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST })
+  const bulkSize = Math.floor(data.byteLength / 4) * 4
+  if (bulkSize > 0) {
+    device.queue.writeBuffer(buffer, 0, data.buffer, data.byteOffset, bulkSize)
+  }
+  if (bulkSize < data.byteLength) {
+    const tail = new Uint8Array(4)
+    tail.set(new Uint8Array(data.buffer, data.byteOffset + bulkSize, data.byteLength - bulkSize))
+    device.queue.writeBuffer(buffer, bulkSize, tail)
+  }
+  return buffer
+}
+
+function outputBuffer (device: GPUDevice, numberOfElements: number): GPUBuffer {
+  return device.createBuffer({ size: Math.max(numberOfElements, 1) * 4, usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC })
+}
+
+// Dispatch one invocation per output element, in rows of at most 65535
+// workgroups
+function dispatch (device: GPUDevice, encoder: GPUCommandEncoder, module: GPUShaderModule, buffers: GPUBuffer[], numberOfElements: number): void {
+  const pipeline = device.createComputePipeline({ layout: 'auto', compute: { module, entryPoint: 'main' } })
+  const bindGroup = device.createBindGroup({
+    layout: pipeline.getBindGroupLayout(0),
+    entries: buffers.map((buffer, binding) => ({ binding, resource: { buffer } }))
+  })
+  const pass = encoder.beginComputePass()
+  pass.setPipeline(pipeline)
+  pass.setBindGroup(0, bindGroup)
+  const workgroups = Math.max(Math.ceil(numberOfElements / workgroupSize), 1)
+  const rowWorkgroups = Math.min(workgroups, 65535)
+  pass.dispatchWorkgroups(rowWorkgroups, Math.ceil(workgroups / rowWorkgroups))
+  pass.end()
+}
+
+async function readBack (device: GPUDevice, encoder: GPUCommandEncoder, buffer: GPUBuffer, numberOfElements: number): Promise<Float32Array> {
+  const staging = device.createBuffer({ size: buffer.size, usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST })
+  encoder.copyBufferToBuffer(buffer, 0, staging, 0, buffer.size)
+  device.queue.submit([encoder.finish()])
+  await staging.mapAsync(GPUMapMode.READ)
+  const result = new Float32Array(staging.getMappedRange().slice(0, numberOfElements * 4))
+  staging.unmap()
+  staging.destroy()
+  return result
+}
+
+// Whether the device can bind the buffers of a pass
+function fits (device: GPUDevice, ...byteLengths: number[]): boolean {
+  return byteLengths.every((byteLength) => byteLength <= device.limits.maxStorageBufferBindingSize && byteLength <= device.limits.maxBufferSize)
+}
+
+// Run the commands of a shader pass, or null when it throws or the device
+// reports an error, e.g. it runs out of memory
+async function withErrorScopes<T> (device: GPUDevice, run: (buffers: GPUBuffer[]) => Promise<T | null>): Promise<T | null> {
+  device.pushErrorScope('out-of-memory')
+  device.pushErrorScope('validation')
+  const buffers: GPUBuffer[] = []
+  let result: T | null = null
+  try {
+    result = await run(buffers)
+  } catch (error) {
+    result = null
+  } finally {
+    buffers.forEach((buffer) => buffer.destroy())
+  }
+  const validationError = await device.popErrorScope()
+  const memoryError = await device.popErrorScope()
+  return validationError === null && memoryError === null ? result : null
+}
+
+function typedOutput (componentType: string, values: Float32Array): TypedArray {
+  // Integer components are truncated, as the static_cast of the pipelines
+  const output = bufferToTypedArray(componentType as ImageType['componentType'], new ArrayBuffer(values.length * bytesPerComponent(componentType))) as Exclude<TypedArray, BigInt64Array | BigUint64Array>
+  output.set(values)
+  return output
+}
+
+function bytesPerComponent (componentType: string): number {
+  switch (componentType) {
+    case IntTypes.UInt8:
+    case IntTypes.Int8:
+      return 1
+    case IntTypes.UInt16:
+    case IntTypes.Int16:
+      return 2
+    default:
+      return 4
+  }
+}
+
+function outputImage (input: Image, size: number[], spacing: number[], firstSample: number[], data: TypedArray): Image {
+  const output = new Image(input.imageType)
+  const dimension = input.imageType.dimension
+  output.size = size
+  output.spacing = spacing
+  output.direction = new Float64Array(input.direction)
+  // The origin is the physical point of the first sample
+  output.origin = input.origin.map((origin, row) => {
+    let point = origin
+    for (let column = 0; column < dimension; column++) {
+      point += input.direction[column + row * dimension] * input.spacing[column] * firstSample[column]
+    }
+    return point
+  })
+  output.data = data
+  return output
+}
+
+// Smooth one buffer axis, evaluated at every shrink factor sample from the
+// offset, as downsampleGaussianAxis. Samples beyond the ends of the axis are
+// the nearest sample.
+function gaussianAxisShader (loader: string): string {
+  return /* wgsl */ `
+@group(0) @binding(0) var<storage, read> params: array<u32>;
+@group(0) @binding(1) var<storage, read> kernel: array<f32>;
+@group(0) @binding(2) var<storage, read> input: array<u32>;
+@group(0) @binding(3) var<storage, read_write> output: array<f32>;
+
+fn load(i: u32) -> f32 {
+  return ${loader};
+}
+
+@compute @workgroup_size(${workgroupSize})
+fn main(@builtin(global_invocation_id) id: vec3<u32>, @builtin(num_workgroups) groups: vec3<u32>) {
+  let index = id.x + id.y * groups.x * ${workgroupSize}u;
+  if (index >= params[6]) {
+    return;
+  }
+  let dimension = params[0];
+  let axis = params[1];
+  var rest = index;
+  var base = 0u;
+  var stride = 1u;
+  var axisStride = 1u;
+  var center = 0i;
+  for (var d = 0u; d < dimension; d++) {
+    let coordinate = rest % params[16u + d];
+    rest = rest / params[16u + d];
+    if (d == axis) {
+      axisStride = stride;
+      center = i32(params[3] + coordinate * params[2]);
+    } else {
+      base += (params[24u + d] + coordinate) * stride;
+    }
+    stride *= params[8u + d];
+  }
+  let last = i32(params[8u + axis]) - 1;
+  let radius = i32(params[4]);
+  var sum = 0.0;
+  for (var tap = 0u; tap < params[5]; tap++) {
+    let position = clamp(center + i32(tap) - radius, 0, last);
+    sum += kernel[tap] * load(base + u32(position) * axisStride);
+  }
+  output[index] = sum;
+}
+`
+}
+
+/**
+ * Smooth with the separable kernels of the downsample pipeline and keep every
+ * shrinkFactors pixel from cropRadius, one axis at a time on the GPU. Only the
+ * window of the input that the kept samples cover is smoothed. The result is
+ * within float32 rounding of the pipeline, which accumulates in float64, and
+ * within one for integer components. Returns null when WebGPU is not
+ * available or the image is not supported.
+ */
+export async function downsampleWebGPU (input: Image, shrinkFactors: number[], cropRadius?: number[]): Promise<Image | null> {
+  const loader = componentLoader(input.imageType.componentType)
+  const dimension = input.imageType.dimension
+  const components = input.imageType.components
+  const componentAxes = components > 1 ? 1 : 0
+  const bufferDimension = dimension + componentAxes
+  if (loader === null || input.data === null || bufferDimension > maximumDimension) {
+    return null
+  }
+  const device = await getDownsampleWebGPUDevice()
+  if (device === null) {
+    return null
+  }
+
+  const outputSize = input.size.map((size, dim) => Math.max(0, Math.floor((size - 2 * (cropRadius?.[dim] ?? 0)) / shrinkFactors[dim])))
+  const outputSpacing = input.spacing.map((spacing, dim) => spacing * shrinkFactors[dim])
+  const firstSample = input.size.map((_, dim) => cropRadius?.[dim] ?? 0)
+  const numberOfOutputElements = outputSize.reduce((a, b) => a * b, 1) * components
+  if (numberOfOutputElements === 0) {
+    return outputImage(input, outputSize, outputSpacing, firstSample, typedOutput(input.imageType.componentType, new Float32Array(0)))
+  }
+
+  // The window of each axis that the kept samples and their kernels cover
+  const size = [...(componentAxes === 1 ? [components] : []), ...input.size]
+  const kernels = input.size.map((_, dim) => gaussianKernelWeights(Math.sqrt((shrinkFactors[dim] ** 2 - 1) / 5.545177444479562)))
+  const windowBegin = new Array(bufferDimension).fill(0)
+  const windowSize = [...size]
+  const offsets = kernels.map((kernel, dim) => {
+    const axis = dim + componentAxes
+    const radius = (kernel.length - 1) / 2
+    const first = firstSample[dim]
+    const last = first + (outputSize[dim] - 1) * shrinkFactors[dim]
+    windowBegin[axis] = first > radius ? first - radius : 0
+    windowSize[axis] = Math.min(size[axis] - 1, last + radius) + 1 - windowBegin[axis]
+    return first - windowBegin[axis]
+  })
+
+  return await withErrorScopes(device, async (buffers) => {
+    const encoder = device.createCommandEncoder()
+    let current = storageBuffer(device, input.data as ArrayBufferView)
+    buffers.push(current)
+    let currentSize = size
+    let numberOfElements = 0
+    for (let dim = 0; dim < dimension; dim++) {
+      const axis = dim + componentAxes
+      const nextSize = dim === 0 ? [...windowSize] : [...currentSize]
+      nextSize[axis] = outputSize[dim]
+      numberOfElements = nextSize.reduce((a, b) => a * b, 1)
+      if (!fits(device, current.size, numberOfElements * 4)) {
+        return null
+      }
+      const outerBegin = dim === 0 ? windowBegin : new Array(bufferDimension).fill(0)
+      const offset = dim === 0 ? windowBegin[axis] + offsets[0] : offsets[dim]
+      const kernel = kernels[dim]
+      const params = parameters(
+        [bufferDimension, axis, shrinkFactors[dim], offset, (kernel.length - 1) / 2, kernel.length, numberOfElements, 0],
+        currentSize, nextSize, outerBegin)
+      const next = outputBuffer(device, numberOfElements)
+      const paramsBuffer = storageBuffer(device, params)
+      const kernelBuffer = storageBuffer(device, new Float32Array(kernel))
+      buffers.push(next, paramsBuffer, kernelBuffer)
+      // Passes after the first read the float32 output of the previous pass
+      const module = device.createShaderModule({ code: gaussianAxisShader(dim === 0 ? loader : 'bitcast<f32>(input[i])') })
+      dispatch(device, encoder, module, [paramsBuffer, kernelBuffer, current, next], numberOfElements)
+      current = next
+      currentSize = nextSize
+    }
+    const values = await readBack(device, encoder, current, numberOfElements)
+    return outputImage(input, outputSize, outputSpacing, firstSample, typedOutput(input.imageType.componentType, values))
+  })
+}
+
+// Average each bin of the shrink factors, as BinShrinkImageFilter. Integer
+// components are rounded half up, as itk::Math::Round.
+function binShrinkShader (loader: string, round: boolean): string {
+  return /* wgsl */ `
+@group(0) @binding(0) var<storage, read> params: array<u32>;
+@group(0) @binding(1) var<storage, read> input: array<u32>;
+@group(0) @binding(2) var<storage, read_write> output: array<f32>;
+
+fn load(i: u32) -> f32 {
+  return ${loader};
+}
+
+@compute @workgroup_size(${workgroupSize})
+fn main(@builtin(global_invocation_id) id: vec3<u32>, @builtin(num_workgroups) groups: vec3<u32>) {
+  let index = id.x + id.y * groups.x * ${workgroupSize}u;
+  if (index >= params[6]) {
+    return;
+  }
+  let dimension = params[0];
+  var rest = index;
+  var base = 0u;
+  var stride = 1u;
+  for (var d = 0u; d < dimension; d++) {
+    let coordinate = rest % params[16u + d];
+    rest = rest / params[16u + d];
+    base += coordinate * params[24u + d] * stride;
+    stride *= params[8u + d];
+  }
+  let binSize = params[5];
+  var sum = 0.0;
+  for (var pixel = 0u; pixel < binSize; pixel++) {
+    var remainder = pixel;
+    var offset = 0u;
+    var binStride = 1u;
+    for (var d = 0u; d < dimension; d++) {
+      offset += (remainder % params[24u + d]) * binStride;
+      remainder = remainder / params[24u + d];
+      binStride *= params[8u + d];
+    }
+    sum += load(base + offset);
+  }
+  let average = sum / f32(binSize);
+  output[index] = ${round ? 'floor(average + 0.5)' : 'average'};
+}
+`
+}
+
+/**
+ * Average the bins of the shrink factors and keep one pixel per bin on the
+ * GPU, with the output information of BinShrinkImageFilter. The sums are
+ * float32, so bins of large integers are within one of the pipeline.
+ * Returns null when WebGPU is not available or the image is not supported.
+ */
+export async function downsampleBinShrinkWebGPU (input: Image, shrinkFactors: number[]): Promise<Image | null> {
+  const loader = componentLoader(input.imageType.componentType)
+  const dimension = input.imageType.dimension
+  if (loader === null || input.data === null || input.imageType.pixelType !== PixelTypes.Scalar || dimension > maximumDimension) {
+    return null
+  }
+  const factors = shrinkFactors.map((factor) => Math.max(1, factor))
+  const outputSize = input.size.map((size, dim) => Math.floor(size / factors[dim]))
+  if (outputSize.some((size) => size < 1)) {
+    // The pipeline reports that an output pixel does not map to a whole bin
+    return null
+  }
+  const device = await getDownsampleWebGPUDevice()
+  if (device === null) {
+    return null
+  }
+
+  const numberOfElements = outputSize.reduce((a, b) => a * b, 1)
+  const binSize = factors.reduce((a, b) => a * b, 1)
+  const inputByteLength = (input.data as ArrayBufferView).byteLength
+  if (!fits(device, inputByteLength, numberOfElements * 4)) {
+    return null
+  }
+
+  return await withErrorScopes(device, async (buffers) => {
+    const encoder = device.createCommandEncoder()
+    const inputBuffer = storageBuffer(device, input.data as ArrayBufferView)
+    const paramsBuffer = storageBuffer(device, parameters([dimension, 0, 0, 0, 0, binSize, numberOfElements, 0], input.size, outputSize, factors))
+    const output = outputBuffer(device, numberOfElements)
+    buffers.push(inputBuffer, paramsBuffer, output)
+    const round = input.imageType.componentType !== FloatTypes.Float32
+    const module = device.createShaderModule({ code: binShrinkShader(loader, round) })
+    dispatch(device, encoder, module, [paramsBuffer, inputBuffer, output], numberOfElements)
+    const values = await readBack(device, encoder, output, numberOfElements)
+    // The center of the first bin
+    const firstSample = factors.map((factor) => 0.5 * (factor - 1))
+    const outputSpacing = input.spacing.map((spacing, dim) => spacing * factors[dim])
+    return outputImage(input, outputSize, outputSpacing, firstSample, typedOutput(input.imageType.componentType, values))
+  })
+}
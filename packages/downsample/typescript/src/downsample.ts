@@ -1,5 +1,3 @@
-// Generated file. To retain edits, remove this comment.
-
 import {
   Image,
   InterfaceTypes,
@@ -15,6 +13,7 @@ import { getPipelinesBaseUrl } from './pipelines-base-url.js'
 import { getPipelineWorkerUrl } from './pipeline-worker-url.js'
 
 import { getDefaultWebWorker } from './default-web-worker.js'
+import { downsampleWebGPU } from './downsample-webgpu.js'
 
 /**
  * Apply a smoothing anti-alias filter and subsample the input image.
@@ -71,6 +70,13 @@ async function downsample(
     }))
   }
 
+  if (options.webgpu !== false) {
+    const downsampled = await downsampleWebGPU(input, options.shrinkFactors, options.cropRadius)
+    if (downsampled !== null) {
+      return { webWorker: (options.webWorker ?? null) as Worker, downsampled }
+    }
+  }
+
   const pipelinePath = 'downsample'
 
   let workerToUse = options?.webWorker
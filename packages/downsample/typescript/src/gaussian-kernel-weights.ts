@@ -0,0 +1,87 @@
+// Discrete Gaussian kernel weights, as itk::GaussianOperator, so the WebGPU
+// downsample smooths with the taps of the downsample pipeline
+
+function modifiedBesselI0 (y: number): number {
+  const m = Math.abs(y)
+  if (m < 3.75) {
+    let d = y / 3.75
+    d *= d
+    return 1.0 + d * (3.5156229 + d * (3.0899424 + d * (1.2067492 + d * (0.2659732 + d * (0.360768e-1 + d * 0.45813e-2)))))
+  }
+  const d = 3.75 / m
+  return (Math.exp(m) / Math.sqrt(m)) * (0.39894228 + d * (0.1328592e-1 + d * (0.225319e-2 + d * (-0.157565e-2 + d * (0.916281e-2 +
+    d * (-0.2057706e-1 + d * (0.2635537e-1 + d * (-0.1647633e-1 + d * 0.392377e-2))))))))
+}
+
+function modifiedBesselI1 (y: number): number {
+  const m = Math.abs(y)
+  let accumulator = 0
+  if (m < 3.75) {
+    let d = y / 3.75
+    d *= d
+    accumulator = m * (0.5 + d * (0.87890594 + d * (0.51498869 + d * (0.15084934 + d * (0.2658733e-1 + d * (0.301532e-2 + d * 0.32411e-3))))))
+  } else {
+    const d = 3.75 / m
+    accumulator = 0.2282967e-1 + d * (-0.2895312e-1 + d * (0.1787654e-1 - d * 0.420059e-2))
+    accumulator = 0.39894228 + d * (-0.3988024e-1 + d * (-0.362018e-2 + d * (0.163801e-2 + d * (-0.1031555e-1 + d * accumulator))))
+    accumulator *= Math.exp(m) / Math.sqrt(m)
+  }
+  return y < 0 ? -accumulator : accumulator
+}
+
+function modifiedBesselI (n: number, y: number): number {
+  if (y === 0.0) {
+    return 0.0
+  }
+  const accuracy = 40.0
+  const toy = 2.0 / Math.abs(y)
+  let qip = 0.0
+  let qi = 1.0
+  let accumulator = 0.0
+  for (let j = 2 * (n + Math.trunc(Math.sqrt(accuracy * n))); j > 0; j--) {
+    const qim = qip + j * toy * qi
+    qip = qi
+    qi = qim
+    if (Math.abs(qi) > 1.0e10) {
+      accumulator *= 1.0e-10
+      qi *= 1.0e-10
+      qip *= 1.0e-10
+    }
+    if (j === n) {
+      accumulator = qip
+    }
+  }
+  accumulator *= modifiedBesselI0(y) / qi
+  return y < 0.0 && (n & 1) === 1 ? -accumulator : accumulator
+}
+
+/**
+ * Weights of the discrete Gaussian kernel of a sigma in pixel units,
+ * normalized to sum to one, with the maximum error and kernel width of
+ * itk::GaussianOperator. The kernel has an odd number of taps, centered on
+ * the middle tap.
+ */
+function gaussianKernelWeights (sigma: number, maximumError = 0.01, maximumKernelWidth = 32): number[] {
+  const variance = sigma * sigma
+  const et = Math.exp(-variance)
+  const cap = 1.0 - maximumError
+
+  const half = [et * modifiedBesselI0(variance), et * modifiedBesselI1(variance)]
+  let sum = half[0] + half[1] * 2.0
+  for (let i = 2; sum < cap; i++) {
+    half.push(et * modifiedBesselI(i, variance))
+    sum += half[i] * 2.0
+    if (half[i] < sum * Number.EPSILON) {
+      // The kernel is no longer changing
+      break
+    }
+    if (half.length > maximumKernelWidth) {
+      break
+    }
+  }
+
+  const normalized = half.map((weight) => weight / sum)
+  return normalized.slice(1).reverse().concat(normalized)
+}
+
+export default gaussianKernelWeights
@@ -1,6 +1,5 @@
-// Generated file. To retain edits, remove this comment.
-
 export { default as version } from './version.js'
+export { default as gaussianKernelWeights } from './gaussian-kernel-weights.js'
 
 export type { Image } from 'itk-wasm'
 export type { JsonCompatible } from 'itk-wasm'
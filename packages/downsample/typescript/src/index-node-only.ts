@@ -22,6 +22,26 @@ import downsampleLabelImageNode from './downsample-label-image-node.js'
 export { downsampleLabelImageNode }
 
 
+import DownsamplePyramidNodeResult from './downsample-pyramid-node-result.js'
+export type { DownsamplePyramidNodeResult }
+
+import DownsamplePyramidNodeOptions from './downsample-pyramid-node-options.js'
+export type { DownsamplePyramidNodeOptions }
+
+import downsamplePyramidNode from './downsample-pyramid-node.js'
+export { downsamplePyramidNode }
+
+
+import DownsampleStreamingNodeResult from './downsample-streaming-node-result.js'
+export type { DownsampleStreamingNodeResult }
+
+import DownsampleStreamingNodeOptions from './downsample-streaming-node-options.js'
+export type { DownsampleStreamingNodeOptions }
+
+import downsampleStreamingNode from './downsample-streaming-node.js'
+export { downsampleStreamingNode }
+
+
 import DownsampleSigmaNodeResult from './downsample-sigma-node-result.js'
 export type { DownsampleSigmaNodeResult }
 
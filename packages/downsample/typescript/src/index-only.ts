@@ -1,8 +1,7 @@
-// Generated file. To retain edits, remove this comment.
-
 export * from './pipelines-base-url.js'
 export * from './pipeline-worker-url.js'
 export * from './default-web-worker.js'
+export { setDownsampleWebGPUDevice } from './downsample-webgpu.js'
 
 
 import DownsampleBinShrinkResult from './downsample-bin-shrink-result.js'
@@ -25,6 +24,26 @@ import downsampleLabelImage from './downsample-label-image.js'
 export { downsampleLabelImage }
 
 
+import DownsamplePyramidResult from './downsample-pyramid-result.js'
+export type { DownsamplePyramidResult }
+
+import DownsamplePyramidOptions from './downsample-pyramid-options.js'
+export type { DownsamplePyramidOptions }
+
+import downsamplePyramid from './downsample-pyramid.js'
+export { downsamplePyramid }
+
+
+import DownsampleStreamingResult from './downsample-streaming-result.js'
+export type { DownsampleStreamingResult }
+
+import DownsampleStreamingOptions from './downsample-streaming-options.js'
+export type { DownsampleStreamingOptions }
+
+import downsampleStreaming from './downsample-streaming.js'
+export { downsampleStreaming }
+
+
 import DownsampleSigmaResult from './downsample-sigma-result.js'
 export type { DownsampleSigmaResult }
 
@@ -0,0 +1,100 @@
+// The subset of the WebGPU API used by the downsample WebGPU backend, so the
+// package builds without WebGPU type declarations. A GPUDevice of the
+// browser, or of @webgpu/types, satisfies these interfaces.
+
+// GPUBufferUsage and GPUMapMode flags
+export const GPUBufferUsage = {
+  MAP_READ: 0x0001,
+  COPY_SRC: 0x0004,
+  COPY_DST: 0x0008,
+  STORAGE: 0x0080
+} as const
+
+export const GPUMapMode = {
+  READ: 0x0001
+} as const
+
+export interface GPUSupportedLimits {
+  readonly maxStorageBufferBindingSize: number
+  readonly maxBufferSize: number
+}
+
+export interface GPUBuffer {
+  readonly size: number
+  mapAsync: (mode: number, offset?: number, size?: number) => Promise<void>
+  getMappedRange: (offset?: number, size?: number) => ArrayBuffer
+  unmap: () => void
+  destroy: () => void
+}
+
+export interface GPUShaderModule {
+  readonly label: string
+}
+
+export interface GPUBindGroupLayout {
+  readonly label: string
+}
+
+export interface GPUBindGroup {
+  readonly label: string
+}
+
+export interface GPUComputePipeline {
+  getBindGroupLayout: (index: number) => GPUBindGroupLayout
+}
+
+export interface GPUComputePassEncoder {
+  setPipeline: (pipeline: GPUComputePipeline) => void
+  setBindGroup: (index: number, bindGroup: GPUBindGroup) => void
+  dispatchWorkgroups: (x: number, y?: number, z?: number) => void
+  end: () => void
+}
+
+export interface GPUCommandBuffer {
+  readonly label: string
+}
+
+export interface GPUCommandEncoder {
+  beginComputePass: () => GPUComputePassEncoder
+  copyBufferToBuffer: (source: GPUBuffer, sourceOffset: number, destination: GPUBuffer, destinationOffset: number, size: number) => void
+  finish: () => GPUCommandBuffer
+}
+
+export interface GPUQueue {
+  writeBuffer: (buffer: GPUBuffer, bufferOffset: number, data: ArrayBufferLike | ArrayBufferView, dataOffset?: number, size?: number) => void
+  submit: (commandBuffers: GPUCommandBuffer[]) => void
+}
+
+export interface GPUError {
+  readonly message: string
+}
+
+export interface GPUDevice {
+  readonly limits: GPUSupportedLimits
+  readonly queue: GPUQueue
+  readonly lost: Promise<unknown>
+  createBuffer: (descriptor: { size: number, usage: number }) => GPUBuffer
+  createShaderModule: (descriptor: { code: string }) => GPUShaderModule
+  createComputePipeline: (descriptor: { layout: 'auto', compute: { module: GPUShaderModule, entryPoint: string } }) => GPUComputePipeline
+  createBindGroup: (descriptor: { layout: GPUBindGroupLayout, entries: Array<{ binding: number, resource: { buffer: GPUBuffer } }> }) => GPUBindGroup
+  createCommandEncoder: () => GPUCommandEncoder
+  pushErrorScope: (filter: 'validation' | 'out-of-memory' | 'internal') => void
+  popErrorScope: () => Promise<GPUError | null>
+}
+
+export interface GPUAdapter {
+  readonly limits: GPUSupportedLimits
+  requestDevice: (descriptor?: { requiredLimits?: Record<string, number> }) => Promise<GPUDevice>
+}
+
+export interface GPU {
+  requestAdapter: () => Promise<GPUAdapter | null>
+}
+
+// navigator.gpu, when the browser supports WebGPU
+export function navigatorGPU (): GPU | undefined {
+  if (typeof navigator === 'undefined') {
+    return undefined
+  }
+  return (navigator as Navigator & { gpu?: GPU }).gpu
+}
@@ -1,6 +1,6 @@
 import test from 'ava'
 
-import { gaussianKernelRadiusNode } from '../../dist/index-node.js'
+import { gaussianKernelRadiusNode, gaussianKernelWeights } from '../../dist/index-node.js'
 
 test('Test gaussianKernelRadiusNode', async t => {
   const { radius } = await gaussianKernelRadiusNode({ size: [64, 64, 32], sigma: [2.0, 4.0, 2.0] })
@@ -8,3 +8,13 @@ test('Test gaussianKernelRadiusNode', async t => {
   t.is(radius[1], 10)
   t.is(radius[2], 5)
 })
+
+test('gaussianKernelWeights matches the radius of the pipeline kernels', async t => {
+  const { radius } = await gaussianKernelRadiusNode({ size: [64, 64], sigma: [2.0, 4.0] })
+  const weights = [gaussianKernelWeights(2.0), gaussianKernelWeights(4.0)]
+  weights.forEach((kernel, dim) => {
+    t.is(kernel.length, 2 * radius[dim] + 1)
+    t.true(Math.abs(kernel.reduce((a, b) => a + b, 0) - 1.0) < 1e-12)
+    t.is(kernel[0], kernel[kernel.length - 1])
+  })
+})
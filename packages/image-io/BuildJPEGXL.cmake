@@ -0,0 +1,32 @@
+include(FetchContent)
+option(JPEGXL_ENABLE_TOOLS "ENABLE_TOOLS" OFF)
+option(JPEGXL_ENABLE_EXAMPLES "ENABLE_EXAMPLES" OFF)
+option(JPEGXL_ENABLE_BENCHMARK "ENABLE_BENCHMARK" OFF)
+option(JPEGXL_ENABLE_MANPAGES "ENABLE_MANPAGES" OFF)
+option(JPEGXL_ENABLE_DOXYGEN "ENABLE_DOXYGEN" OFF)
+option(JPEGXL_ENABLE_JNI "ENABLE_JNI" OFF)
+option(JPEGXL_ENABLE_JPEGLI "ENABLE_JPEGLI" OFF)
+option(JPEGXL_ENABLE_SJPEG "ENABLE_SJPEG" OFF)
+option(JPEGXL_ENABLE_OPENEXR "ENABLE_OPENEXR" OFF)
+option(JPEGXL_ENABLE_PLUGINS "ENABLE_PLUGINS" OFF)
+option(JPEGXL_ENABLE_TRANSCODE_JPEG "ENABLE_TRANSCODE_JPEG" OFF)
+option(JPEGXL_BUNDLE_LIBPNG "BUNDLE_LIBPNG" OFF)
+option(JPEGXL_ENABLE_SKCMS "ENABLE_SKCMS" ON)
+set(jpegxl_GIT_REPOSITORY "https://github.com/libjxl/libjxl.git")
+set(jpegxl_GIT_TAG "v0.11.1")
+FetchContent_Declare(
+  jpegxl_lib
+  GIT_REPOSITORY ${jpegxl_GIT_REPOSITORY}
+  GIT_TAG        ${jpegxl_GIT_TAG}
+  GIT_SHALLOW TRUE
+  # The bundled dependencies of the library
+  GIT_SUBMODULES third_party/brotli third_party/highway third_party/skcms
+)
+
+set(_jpegxl_build_shared_libs ${BUILD_SHARED_LIBS})
+set(_jpegxl_build_testing ${BUILD_TESTING})
+set(BUILD_SHARED_LIBS OFF)
+set(BUILD_TESTING OFF)
+FetchContent_MakeAvailable(jpegxl_lib)
+set(BUILD_SHARED_LIBS ${_jpegxl_build_shared_libs})
+set(BUILD_TESTING ${_jpegxl_build_testing})
@@ -0,0 +1,23 @@
+include(FetchContent)
+option(OJPH_BUILD_EXECUTABLES "BUILD_EXECUTABLES" OFF)
+option(OJPH_BUILD_TESTS "BUILD_TESTS" OFF)
+option(OJPH_ENABLE_TIFF_SUPPORT "ENABLE_TIFF_SUPPORT" OFF)
+# The x86 and ARM kernels are not built for wasm
+if(EMSCRIPTEN OR WASI)
+  option(OJPH_DISABLE_SIMD "DISABLE_SIMD" ON)
+endif()
+set(openjph_GIT_REPOSITORY "https://github.com/aous72/OpenJPH.git")
+set(openjph_GIT_TAG "0.18.0")
+FetchContent_Declare(
+  openjph_lib
+  GIT_REPOSITORY ${openjph_GIT_REPOSITORY}
+  GIT_TAG        ${openjph_GIT_TAG}
+  GIT_SHALLOW TRUE
+)
+
+set(_openjph_build_shared_libs ${BUILD_SHARED_LIBS})
+set(BUILD_SHARED_LIBS OFF)
+FetchContent_MakeAvailable(openjph_lib)
+set(BUILD_SHARED_LIBS ${_openjph_build_shared_libs})
+# openjph/ojph_*.h
+include_directories("${openjph_lib_SOURCE_DIR}/src/core")
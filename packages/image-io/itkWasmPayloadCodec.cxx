@@ -0,0 +1,515 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmPayloadCodec.h"
+
+#include "itkMultiThreaderBase.h"
+
+#include "openjph/ojph_arch.h"
+#include "openjph/ojph_codestream.h"
+#include "openjph/ojph_file.h"
+#include "openjph/ojph_mem.h"
+#include "openjph/ojph_params.h"
+
+#include "jxl/decode.h"
+#include "jxl/decode_cxx.h"
+#include "jxl/encode.h"
+#include "jxl/encode_cxx.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+
+constexpr size_t PlaneSizeBytes = 8;
+
+uint64_t
+GetPlaneBytes(const PayloadCodecImage & image)
+{
+  return image.width * image.height * image.components * image.componentSize;
+}
+
+// Call function with a value of the component type of the image
+template <typename TFunction>
+void
+DispatchComponent(const PayloadCodecImage & image, TFunction && function)
+{
+  if (image.componentSize == 1 && image.isSigned)
+  {
+    function(int8_t{});
+  }
+  else if (image.componentSize == 1)
+  {
+    function(uint8_t{});
+  }
+  else if (image.isSigned)
+  {
+    function(int16_t{});
+  }
+  else
+  {
+    function(uint16_t{});
+  }
+}
+
+// Run planeFunction for each plane in parallel, and rethrow the first error
+void
+ParallelizePlanes(uint64_t planes, const std::function<void(uint64_t)> & planeFunction)
+{
+  std::vector<std::string> errors(static_cast<size_t>(planes));
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(
+    0,
+    static_cast<SizeValueType>(planes),
+    [&](SizeValueType plane) {
+      try
+      {
+        planeFunction(plane);
+      }
+      catch (const std::exception & error)
+      {
+        errors[plane] = error.what();
+        if (errors[plane].empty())
+        {
+          errors[plane] = "Unknown error";
+        }
+      }
+    },
+    nullptr);
+  for (const std::string & error : errors)
+  {
+    if (!error.empty())
+    {
+      throw std::runtime_error(error);
+    }
+  }
+}
+
+// Decomposition levels, at most 5, that leave each level at least a pixel
+// wide
+ojph::ui32
+GetHTJ2KDecompositions(uint64_t width, uint64_t height)
+{
+  const uint64_t smallest = std::min(width, height);
+  ojph::ui32 decompositions = 0;
+  while (decompositions < 5 && (smallest >> (decompositions + 1)) > 0)
+  {
+    ++decompositions;
+  }
+  return decompositions;
+}
+
+void
+EncodeHTJ2KPlane(const PayloadCodecImage & image, const unsigned char * plane, std::string & encoded)
+{
+  const auto width = static_cast<ojph::ui32>(image.width);
+  const auto height = static_cast<ojph::ui32>(image.height);
+  ojph::codestream codestream;
+  ojph::param_siz siz = codestream.access_siz();
+  siz.set_image_extent(ojph::point(width, height));
+  siz.set_num_components(image.components);
+  for (unsigned int component = 0; component < image.components; ++component)
+  {
+    siz.set_component(component, ojph::point(1, 1), static_cast<ojph::ui32>(8 * image.componentSize), image.isSigned);
+  }
+  siz.set_image_offset(ojph::point(0, 0));
+  siz.set_tile_size(ojph::size(width, height));
+  siz.set_tile_offset(ojph::point(0, 0));
+
+  ojph::param_cod cod = codestream.access_cod();
+  cod.set_num_decomposition(GetHTJ2KDecompositions(image.width, image.height));
+  cod.set_block_dims(64, 64);
+  // Resolution major, so reduced resolutions are a prefix of the codestream
+  cod.set_progression_order("RPCL");
+  cod.set_color_transform(false);
+  cod.set_reversible(true);
+  codestream.set_planar(true);
+
+  ojph::mem_outfile output;
+  output.open();
+  codestream.write_headers(&output);
+
+  // Planar lines are exchanged component by component
+  const size_t rowBytes = static_cast<size_t>(image.width) * image.components * image.componentSize;
+  std::vector<uint64_t> rows(image.components, 0);
+  ojph::ui32 component = 0;
+  ojph::line_buf * line = codestream.exchange(nullptr, component);
+  for (uint64_t ii = 0; ii < image.height * image.components; ++ii)
+  {
+    const unsigned char * row = plane + rows[component]++ * rowBytes;
+    DispatchComponent(image, [&](auto componentValue) {
+      using ComponentType = decltype(componentValue);
+      const auto values = reinterpret_cast<const ComponentType *>(row);
+      for (uint64_t xx = 0; xx < image.width; ++xx)
+      {
+        line->i32[xx] = values[xx * image.components + component];
+      }
+    });
+    line = codestream.exchange(line, component);
+  }
+  codestream.flush();
+  encoded.assign(reinterpret_cast<const char *>(output.get_data()), static_cast<size_t>(output.tell()));
+  codestream.close();
+}
+
+void
+DecodeHTJ2KPlane(const PayloadCodecImage & image,
+                 unsigned int resolutionReduction,
+                 const unsigned char * encoded,
+                 size_t size,
+                 unsigned char * plane)
+{
+  ojph::mem_infile input;
+  input.open(encoded, size);
+  ojph::codestream codestream;
+  codestream.read_headers(&input);
+
+  ojph::param_siz siz = codestream.access_siz();
+  if (siz.get_num_components() != image.components)
+  {
+    throw std::runtime_error("The number of components of an htj2k plane does not match the image");
+  }
+  if (resolutionReduction > codestream.access_cod().get_num_decompositions())
+  {
+    throw std::runtime_error("The resolution reduction is larger than the decompositions of an htj2k plane");
+  }
+  codestream.restrict_input_resolution(resolutionReduction, resolutionReduction);
+  for (unsigned int component = 0; component < image.components; ++component)
+  {
+    if (siz.get_bit_depth(component) != 8 * image.componentSize || siz.is_signed(component) != image.isSigned ||
+        siz.get_recon_width(component) != image.width || siz.get_recon_height(component) != image.height)
+    {
+      throw std::runtime_error("The layout of an htj2k plane does not match the image");
+    }
+  }
+  codestream.set_planar(true);
+  codestream.create();
+
+  // Lines are pulled straight into the plane of the image buffer
+  const size_t rowBytes = static_cast<size_t>(image.width) * image.components * image.componentSize;
+  std::vector<uint64_t> rows(image.components, 0);
+  for (uint64_t ii = 0; ii < image.height * image.components; ++ii)
+  {
+    ojph::ui32 component = 0;
+    const ojph::line_buf * line = codestream.pull(component);
+    unsigned char * row = plane + rows[component]++ * rowBytes;
+    DispatchComponent(image, [&](auto componentValue) {
+      using ComponentType = decltype(componentValue);
+      const auto values = reinterpret_cast<ComponentType *>(row);
+      for (uint64_t xx = 0; xx < image.width; ++xx)
+      {
+        values[xx * image.components + component] = static_cast<ComponentType>(line->i32[xx]);
+      }
+    });
+  }
+  codestream.close();
+}
+
+// JPEG XL samples are unsigned. Flipping the sign bit maps signed
+// components to unsigned ones in order, and back.
+void
+FlipSignBits(const PayloadCodecImage & image, unsigned char * plane)
+{
+  const uint64_t numberOfComponents = image.width * image.height * image.components;
+  if (image.componentSize == 1)
+  {
+    for (uint64_t ii = 0; ii < numberOfComponents; ++ii)
+    {
+      plane[ii] ^= 0x80;
+    }
+    return;
+  }
+  auto values = reinterpret_cast<uint16_t *>(plane);
+  for (uint64_t ii = 0; ii < numberOfComponents; ++ii)
+  {
+    values[ii] ^= 0x8000;
+  }
+}
+
+JxlPixelFormat
+GetJPEGXLPixelFormat(const PayloadCodecImage & image)
+{
+  return { image.components, image.componentSize == 1 ? JXL_TYPE_UINT8 : JXL_TYPE_UINT16, JXL_NATIVE_ENDIAN, 0 };
+}
+
+void
+EncodeJPEGXLPlane(const PayloadCodecImage & image, const unsigned char * plane, std::string & encoded)
+{
+  if (image.components > 4)
+  {
+    throw std::runtime_error("The jpegxl payload codec supports at most 4 components");
+  }
+  JxlEncoderPtr encoder = JxlEncoderMake(nullptr);
+
+  // Gray or RGB, with an alpha channel for 2 or 4 components
+  const bool alpha = image.components == 2 || image.components == 4;
+  JxlBasicInfo info;
+  JxlEncoderInitBasicInfo(&info);
+  info.xsize = static_cast<uint32_t>(image.width);
+  info.ysize = static_cast<uint32_t>(image.height);
+  info.bits_per_sample = static_cast<uint32_t>(8 * image.componentSize);
+  info.exponent_bits_per_sample = 0;
+  info.num_color_channels = image.components >= 3 ? 3 : 1;
+  info.num_extra_channels = alpha ? 1 : 0;
+  info.alpha_bits = alpha ? info.bits_per_sample : 0;
+  info.uses_original_profile = JXL_TRUE;
+  if (JxlEncoderSetBasicInfo(encoder.get(), &info) != JXL_ENC_SUCCESS)
+  {
+    throw std::runtime_error("Could not set the jpegxl basic info");
+  }
+  if (alpha)
+  {
+    JxlExtraChannelInfo extraChannelInfo;
+    JxlEncoderInitExtraChannelInfo(JXL_CHANNEL_ALPHA, &extraChannelInfo);
+    extraChannelInfo.bits_per_sample = info.bits_per_sample;
+    if (JxlEncoderSetExtraChannelInfo(encoder.get(), 0, &extraChannelInfo) != JXL_ENC_SUCCESS)
+    {
+      throw std::runtime_error("Could not set the jpegxl alpha channel info");
+    }
+  }
+  JxlColorEncoding colorEncoding;
+  JxlColorEncodingSetToLinearSRGB(&colorEncoding, info.num_color_channels == 1 ? JXL_TRUE : JXL_FALSE);
+  if (JxlEncoderSetColorEncoding(encoder.get(), &colorEncoding) != JXL_ENC_SUCCESS)
+  {
+    throw std::runtime_error("Could not set the jpegxl color encoding");
+  }
+
+  JxlEncoderFrameSettings * frameSettings = JxlEncoderFrameSettingsCreate(encoder.get(), nullptr);
+  if (JxlEncoderSetFrameLossless(frameSettings, JXL_TRUE) != JXL_ENC_SUCCESS)
+  {
+    throw std::runtime_error("Could not set the jpegxl lossless mode");
+  }
+  const JxlPixelFormat pixelFormat = GetJPEGXLPixelFormat(image);
+  const size_t planeBytes = static_cast<size_t>(GetPlaneBytes(image));
+  std::vector<unsigned char> unsignedPlane;
+  const unsigned char * pixels = plane;
+  if (image.isSigned)
+  {
+    unsignedPlane.assign(plane, plane + planeBytes);
+    FlipSignBits(image, unsignedPlane.data());
+    pixels = unsignedPlane.data();
+  }
+  if (JxlEncoderAddImageFrame(frameSettings, &pixelFormat, pixels, planeBytes) != JXL_ENC_SUCCESS)
+  {
+    throw std::runtime_error("Could not encode a jpegxl frame");
+  }
+  JxlEncoderCloseInput(encoder.get());
+
+  encoded.resize(std::max<size_t>(planeBytes / 2, 4096));
+  size_t used = 0;
+  for (;;)
+  {
+    auto next = reinterpret_cast<uint8_t *>(encoded.data()) + used;
+    size_t available = encoded.size() - used;
+    const JxlEncoderStatus status = JxlEncoderProcessOutput(encoder.get(), &next, &available);
+    used = static_cast<size_t>(next - reinterpret_cast<uint8_t *>(encoded.data()));
+    if (status == JXL_ENC_SUCCESS)
+    {
+      break;
+    }
+    if (status != JXL_ENC_NEED_MORE_OUTPUT)
+    {
+      throw std::runtime_error("Could not encode a jpegxl plane");
+    }
+    encoded.resize(encoded.size() * 2);
+  }
+  encoded.resize(used);
+}
+
+void
+DecodeJPEGXLPlane(const PayloadCodecImage & image, const unsigned char * encoded, size_t size, unsigned char * plane)
+{
+  JxlDecoderPtr decoder = JxlDecoderMake(nullptr);
+  if (JxlDecoderSubscribeEvents(decoder.get(), JXL_DEC_BASIC_INFO | JXL_DEC_FULL_IMAGE) != JXL_DEC_SUCCESS ||
+      JxlDecoderSetKeepOrientation(decoder.get(), JXL_TRUE) != JXL_DEC_SUCCESS ||
+      JxlDecoderSetInput(decoder.get(), encoded, size) != JXL_DEC_SUCCESS)
+  {
+    throw std::runtime_error("Could not start decoding a jpegxl plane");
+  }
+  JxlDecoderCloseInput(decoder.get());
+
+  const JxlPixelFormat pixelFormat = GetJPEGXLPixelFormat(image);
+  const size_t planeBytes = static_cast<size_t>(GetPlaneBytes(image));
+  for (;;)
+  {
+    const JxlDecoderStatus status = JxlDecoderProcessInput(decoder.get());
+    if (status == JXL_DEC_SUCCESS)
+    {
+      break;
+    }
+    if (status == JXL_DEC_BASIC_INFO)
+    {
+      JxlBasicInfo info;
+      if (JxlDecoderGetBasicInfo(decoder.get(), &info) != JXL_DEC_SUCCESS || info.xsize != image.width ||
+          info.ysize != image.height || info.num_color_channels + info.num_extra_channels != image.components ||
+          info.bits_per_sample != 8 * image.componentSize)
+      {
+        throw std::runtime_error("The layout of a jpegxl plane does not match the image");
+      }
+    }
+    else if (status == JXL_DEC_NEED_IMAGE_OUT_BUFFER)
+    {
+      // Decoded straight into the plane of the image buffer
+      size_t bufferSize = 0;
+      if (JxlDecoderImageOutBufferSize(decoder.get(), &pixelFormat, &bufferSize) != JXL_DEC_SUCCESS ||
+          bufferSize != planeBytes ||
+          JxlDecoderSetImageOutBuffer(decoder.get(), &pixelFormat, plane, planeBytes) != JXL_DEC_SUCCESS)
+      {
+        throw std::runtime_error("The size of a jpegxl plane does not match the image");
+      }
+    }
+    else if (status != JXL_DEC_FULL_IMAGE)
+    {
+      throw std::runtime_error("Could not decode a jpegxl plane");
+    }
+  }
+  if (image.isSigned)
+  {
+    FlipSignBits(image, plane);
+  }
+}
+
+} // end anonymous namespace
+
+
+void
+EncodePayloadCodec(PayloadCodec codec, const PayloadCodecImage & image, const void * payload, std::string & encoded)
+{
+  if (image.componentSize != 1 && image.componentSize != 2)
+  {
+    throw std::runtime_error(std::string("The ") + GetPayloadCodecName(codec) + " payload codec requires 8 or 16 bit integer components");
+  }
+  if (image.width > std::numeric_limits<uint32_t>::max() || image.height > std::numeric_limits<uint32_t>::max())
+  {
+    throw std::runtime_error(std::string("The planes are too large for the ") + GetPayloadCodecName(codec) + " payload codec");
+  }
+
+  const uint64_t planeBytes = GetPlaneBytes(image);
+  const auto payloadBytes = static_cast<const unsigned char *>(payload);
+  std::vector<std::string> planes(static_cast<size_t>(image.planes));
+  ParallelizePlanes(image.planes, [&](uint64_t plane) {
+    const unsigned char * planePayload = payloadBytes + plane * planeBytes;
+    switch (codec)
+    {
+      case PayloadCodec::HTJ2K:
+        EncodeHTJ2KPlane(image, planePayload, planes[plane]);
+        break;
+      case PayloadCodec::JPEGXL:
+        EncodeJPEGXLPlane(image, planePayload, planes[plane]);
+        break;
+      default:
+        throw std::runtime_error("Unexpected payload codec");
+    }
+  });
+
+  size_t size = 0;
+  for (const std::string & plane : planes)
+  {
+    size += PlaneSizeBytes + plane.size();
+  }
+  encoded.clear();
+  encoded.reserve(size);
+  for (const std::string & plane : planes)
+  {
+    char planeSize[PlaneSizeBytes];
+    for (size_t ii = 0; ii < PlaneSizeBytes; ++ii)
+    {
+      planeSize[ii] = static_cast<char>(static_cast<uint64_t>(plane.size()) >> (8 * ii));
+    }
+    encoded.append(planeSize, PlaneSizeBytes);
+    encoded.append(plane);
+  }
+}
+
+
+void
+DecodePayloadCodec(PayloadCodec codec,
+                   const PayloadCodecImage & image,
+                   unsigned int resolutionReduction,
+                   const unsigned char * encoded,
+                   size_t size,
+                   void * payload)
+{
+  if (image.componentSize != 1 && image.componentSize != 2)
+  {
+    throw std::runtime_error(std::string("The ") + GetPayloadCodecName(codec) + " payload codec requires 8 or 16 bit integer components");
+  }
+  if (resolutionReduction > 0 && codec != PayloadCodec::HTJ2K)
+  {
+    throw std::runtime_error(std::string("The ") + GetPayloadCodecName(codec) + " payload codec is not resolution scalable");
+  }
+
+  // Locate the planes, then decode them independently
+  std::vector<size_t> offsets;
+  std::vector<size_t> sizes;
+  size_t offset = 0;
+  while (offset < size)
+  {
+    if (size - offset < PlaneSizeBytes)
+    {
+      throw std::runtime_error("Truncated payload codec plane size");
+    }
+    uint64_t planeSize = 0;
+    for (size_t ii = 0; ii < PlaneSizeBytes; ++ii)
+    {
+      planeSize |= static_cast<uint64_t>(encoded[offset + ii]) << (8 * ii);
+    }
+    offset += PlaneSizeBytes;
+    if (planeSize > size - offset)
+    {
+      throw std::runtime_error("Truncated payload codec plane");
+    }
+    offsets.push_back(offset);
+    sizes.push_back(static_cast<size_t>(planeSize));
+    offset += static_cast<size_t>(planeSize);
+  }
+  if (offsets.size() != image.planes)
+  {
+    throw std::runtime_error("The number of payload codec planes does not match the image");
+  }
+
+  const uint64_t planeBytes = GetPlaneBytes(image);
+  auto payloadBytes = static_cast<unsigned char *>(payload);
+  ParallelizePlanes(image.planes, [&](uint64_t plane) {
+    unsigned char * planePayload = payloadBytes + plane * planeBytes;
+    switch (codec)
+    {
+      case PayloadCodec::HTJ2K:
+        DecodeHTJ2KPlane(image, resolutionReduction, encoded + offsets[plane], sizes[plane], planePayload);
+        break;
+      case PayloadCodec::JPEGXL:
+        DecodeJPEGXLPlane(image, encoded + offsets[plane], sizes[plane], planePayload);
+        break;
+      default:
+        throw std::runtime_error("Unexpected payload codec");
+    }
+  });
+}
+
+} // end namespace wasm
+} // end namespace itk
@@ -0,0 +1,72 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmPayloadCodec_h
+#define itkWasmPayloadCodec_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkWasmPayloadFilter.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace itk
+{
+namespace wasm
+{
+
+/** Layout of the pixel data encoded with a payload codec. Each plane of
+ * width by height pixels, along the first two dimensions, is encoded
+ * separately. */
+struct PayloadCodecImage
+{
+  /** Bytes per component: 1 or 2. */
+  size_t componentSize{ 1 };
+  bool isSigned{ false };
+  unsigned int components{ 1 };
+  uint64_t width{ 1 };
+  uint64_t height{ 1 };
+  /** Number of planes, the product of the higher dimensions. */
+  uint64_t planes{ 1 };
+};
+
+/** Encode the pixel data with the codec. The encoding is the encoded
+ * planes, in order, each a little endian uint64 size followed by an HTJ2K
+ * codestream or a JPEG XL file. The planes are encoded in parallel. Throws a
+ * std::runtime_error if the codec does not support the layout. */
+WebAssemblyInterface_EXPORT void
+EncodePayloadCodec(PayloadCodec codec, const PayloadCodecImage & image, const void * payload, std::string & encoded);
+
+/** Decode the encoded planes in parallel, directly into the payload. The
+ * image is the decoded layout, whose width and height are those of the
+ * encoded planes reduced by resolutionReduction levels. Only HTJ2K supports
+ * a resolutionReduction. Throws a std::runtime_error on an invalid
+ * encoding. */
+WebAssemblyInterface_EXPORT void
+DecodePayloadCodec(PayloadCodec codec,
+                   const PayloadCodecImage & image,
+                   unsigned int resolutionReduction,
+                   const unsigned char * encoded,
+                   size_t size,
+                   void * payload);
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -17,16 +17,31 @@
  *=========================================================================*/
 
 #include "itkWasmZstdImageIO.h"
-#include "zstd.h"
+#include "itkWasmZstdCBORStream.h"
+#include "itkWasmZstdDictionary.h"
+#include "itkWasmPayloadCodec.h"
+#include "itkWasmTrace.h"
+#include "itkMultiThreaderBase.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
 
 namespace itk
 {
 
+
 WasmZstdImageIO
 ::WasmZstdImageIO()
 {
   this->AddSupportedWriteExtension(".iwi.cbor.zst");
   this->AddSupportedReadExtension(".iwi.cbor.zst");
+
+  this->SetMaximumCompressionLevel(ZSTD_maxCLevel());
+  this->SetCompressionLevel(3);
 }
 
 
@@ -68,28 +83,49 @@ WasmZstdImageIO
 
   const std::string path = this->GetFileName();
 
-  std::string::size_type zstdPos = path.rfind(".zst");
-  if ( ( zstdPos != std::string::npos )
-       && ( zstdPos == path.length() - 4 ) )
+  this->m_InformationSource.reset();
+  this->m_InformationFileName.clear();
+  this->m_DictionaryID = 0;
+  this->SelectBundleMember();
+
+  if (this->IsZstdInput())
   {
-    std::ifstream dataStream;
-    this->OpenFileForReading( dataStream, this->GetFileName() );
+    std::unique_ptr<wasm::RangeReader> reader = this->OpenRangeReader();
+    if (!reader)
+    {
+      itkExceptionMacro("Could not read file: " << this->GetFileName());
+    }
+    wasm::ReadZstdSeekTable(*reader, this->m_FrameCompressedOffsets, this->m_FrameDecompressedOffsets);
+    this->m_DictionaryID = wasm::ReadZstdFrameDictionaryID(*reader);
 
-    std::ostringstream ostrm;
-    ostrm << dataStream.rdbuf();
-    auto inputBinary = ostrm.str();
+    // Only the frame prefix up to the image information is decompressed
+    this->ReadZstdCBOR(nullptr);
+    return;
+  }
 
-    const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-    std::vector<char> decompressedBinary(decompressedBufferSize);
+  this->m_FrameCompressedOffsets.clear();
+  this->m_FrameDecompressedOffsets.clear();
+  if (this->FileNameIsBundle())
+  {
+    // A member without compression, already selected
+    this->ReadCBORInformation();
+    return;
+  }
+  Superclass::ReadImageInformation();
+}
 
-    const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-    decompressedBinary.resize(decompressedSize);
 
-    this->ReadCBOR(nullptr, reinterpret_cast< unsigned char *>(&(decompressedBinary.at(0))), decompressedSize);
-    return;
+bool
+WasmZstdImageIO
+::CanStreamRead()
+{
+  if (this->IsZstdInput())
+  {
+    // Without a seek table, every region would decompress the file up to it
+    return !this->m_FrameDecompressedOffsets.empty() && !this->GetPayloadFilters().IsEnabled();
   }
 
-  Superclass::ReadImageInformation();
+  return Superclass::CanStreamRead();
 }
 
 
@@ -97,30 +133,435 @@ void
 WasmZstdImageIO
 ::Read( void *buffer )
 {
+  if (this->IsZstdInput())
+  {
+    this->ReadZstdCBOR(buffer);
+    return;
+  }
+
+  Superclass::Read(buffer);
+}
+
+
+void
+WasmZstdImageIO
+::ReadZstdCBOR( void *buffer )
+{
+  ITK_WASM_TRACE_SCOPE("WasmZstdImageIO::Decompress");
+  if (buffer != nullptr && this->m_InformationSource && this->m_InformationFileName == this->GetFileName())
+  {
+    // Continue the stream after the image information, once
+    std::unique_ptr<wasm::CBORSource> source = std::move(this->m_InformationSource);
+    this->m_InformationFileName.clear();
+    this->ReadCBOR(buffer, *source, this->m_InformationProgress);
+    return;
+  }
+  this->m_InformationSource.reset();
+  this->m_InformationFileName.clear();
+
+  std::unique_ptr<wasm::RangeReader> reader = this->OpenRangeReader();
+  if (!reader)
+  {
+    itkExceptionMacro("Could not read file: " << this->GetFileName());
+  }
+  auto source = std::make_unique<wasm::ZstdCBORSource>(std::move(reader));
+  if (!source->SetDictionary(this->GetDictionary(this->m_DictionaryID, this->GetFileName())))
+  {
+    itkExceptionMacro("Could not use the zstd dictionary " << this->m_DictionaryFileName);
+  }
+  if (!this->m_FrameDecompressedOffsets.empty())
+  {
+    source->SetSeekTable(this->m_FrameCompressedOffsets, this->m_FrameDecompressedOffsets);
+  }
+  CBORReadProgress progress;
+  this->ReadCBOR(buffer, *source, progress);
+  if (buffer == nullptr && !progress.dataSkipped)
+  {
+    this->m_InformationSource = std::move(source);
+    this->m_InformationProgress = progress;
+    this->m_InformationFileName = this->GetFileName();
+  }
+}
+
+
+void
+WasmZstdImageIO
+::ReadCBORData( void *buffer, wasm::CBORSource & source, uint64_t dataSize )
+{
+  if (this->m_FrameDecompressedOffsets.empty())
+  {
+    Superclass::ReadCBORData(buffer, source, dataSize);
+    return;
+  }
+
+  const SizeValueType numberOfBytesToBeRead =
+    static_cast< SizeValueType >( this->GetImageSizeInBytes() );
+  if (dataSize < numberOfBytesToBeRead)
+  {
+    itkExceptionMacro("Read failed: the cbor data of " << this->GetFileName() << " is smaller than the image");
+  }
+
+  // Split the lines of the IORegion into segments of the frames that hold them
+  struct FrameSegment
+  {
+    uint64_t frameOffset;
+    uint64_t bufferOffset;
+    size_t size;
+  };
+  const std::vector<uint64_t> & decompressedOffsets = this->m_FrameDecompressedOffsets;
+  const std::vector<uint64_t> & compressedOffsets = this->m_FrameCompressedOffsets;
+  const size_t numberOfFrames = decompressedOffsets.size() - 1;
+  std::vector<std::vector<FrameSegment>> frameSegments(numberOfFrames);
+  const uint64_t dataOffset = source.GetPosition();
+  size_t frame = 0;
+  uint64_t bufferOffset = 0;
+  const auto addSegments = [&](uint64_t offset, size_t size) {
+    offset += dataOffset;
+    while (size > 0)
+    {
+      while (frame < numberOfFrames && decompressedOffsets[frame + 1] <= offset)
+      {
+        ++frame;
+      }
+      if (frame == numberOfFrames)
+      {
+        itkExceptionMacro("Read failed: the frames of " << this->GetFileName() << " are smaller than the image");
+      }
+      const size_t segmentSize = static_cast<size_t>(std::min<uint64_t>(size, decompressedOffsets[frame + 1] - offset));
+      frameSegments[frame].push_back({ offset - decompressedOffsets[frame], bufferOffset, segmentSize });
+      offset += segmentSize;
+      bufferOffset += segmentSize;
+      size -= segmentSize;
+    }
+  };
+  if (this->RequestedToStream())
+  {
+    this->ForEachIORegionLine(addSegments);
+  }
+  else
+  {
+    addSegments(0, numberOfBytesToBeRead);
+  }
+
+  // Frames are independent, and are fetched and decompressed in parallel
+  const std::string path = this->GetFileName();
+  std::unique_ptr<wasm::RangeReader> reader = this->OpenRangeReader();
+  if (!reader)
+  {
+    itkExceptionMacro("Could not read file: " << path);
+  }
+  const std::shared_ptr<const wasm::ZstdDictionary> dictionary = this->GetDictionary(this->m_DictionaryID, path);
+  const auto decompress = [&dictionary](void * destination, size_t size, const std::vector<char> & compressed) {
+    if (!dictionary)
+    {
+      return ZSTD_decompress(destination, size, compressed.data(), compressed.size());
+    }
+    ZSTD_DCtx * context = ZSTD_createDCtx();
+    const size_t result = ZSTD_decompress_usingDDict(context, destination, size, compressed.data(), compressed.size(), dictionary->GetDecompressionDictionary());
+    ZSTD_freeDCtx(context);
+    return result;
+  };
+  auto bufferBytes = static_cast<char *>(buffer);
+  std::atomic<bool> failed{ false };
+  const auto decompressFrame = [&](SizeValueType frameIndex) {
+    const std::vector<FrameSegment> & segments = frameSegments[frameIndex];
+    if (segments.empty() || failed)
+    {
+      return;
+    }
+    const size_t compressedSize = compressedOffsets[frameIndex + 1] - compressedOffsets[frameIndex];
+    const size_t decompressedSize = decompressedOffsets[frameIndex + 1] - decompressedOffsets[frameIndex];
+    std::vector<char> compressed(compressedSize);
+    if (!reader->Read(compressedOffsets[frameIndex], compressed.data(), compressedSize))
+    {
+      failed = true;
+      return;
+    }
+
+    if (segments.size() == 1 && segments[0].size == decompressedSize)
+    {
+      // The whole frame is in the region
+      const size_t result = decompress(bufferBytes + segments[0].bufferOffset, decompressedSize, compressed);
+      if (ZSTD_isError(result) || result != decompressedSize)
+      {
+        failed = true;
+      }
+      return;
+    }
+
+    std::vector<char> decompressed(decompressedSize);
+    const size_t result = decompress(decompressed.data(), decompressedSize, compressed);
+    if (ZSTD_isError(result) || result != decompressedSize)
+    {
+      failed = true;
+      return;
+    }
+    for (const FrameSegment & segment : segments)
+    {
+      std::memcpy(bufferBytes + segment.bufferOffset, decompressed.data() + segment.frameOffset, segment.size);
+    }
+  };
+  MultiThreaderBase::New()->ParallelizeArray(0, numberOfFrames, decompressFrame, nullptr);
+  if (failed)
+  {
+    itkExceptionMacro("Could not decompress the frames of " << path);
+  }
+
+  // Continue after the byte string, skipping whole frames
+  if (!source.Skip(dataSize))
+  {
+    itkExceptionMacro("Could not successfully read " << path);
+  }
+}
+
+
+namespace
+{
+wasm::PayloadCodecImage
+GetPayloadCodecImage(const ImageIOBase & imageIO)
+{
+  wasm::PayloadCodecImage image;
+  image.componentSize = imageIO.GetComponentSize();
+  image.isSigned = imageIO.GetComponentType() == IOComponentEnum::CHAR || imageIO.GetComponentType() == IOComponentEnum::SHORT;
+  image.components = imageIO.GetNumberOfComponents();
+  const unsigned int dimension = imageIO.GetNumberOfDimensions();
+  image.width = dimension > 0 ? imageIO.GetDimensions(0) : 1;
+  image.height = dimension > 1 ? imageIO.GetDimensions(1) : 1;
+  for (unsigned int dim = 2; dim < dimension; ++dim)
+  {
+    image.planes *= imageIO.GetDimensions(dim);
+  }
+  return image;
+}
+} // end anonymous namespace
+
+
+void
+WasmZstdImageIO
+::EncodePayloadCodec(const void * buffer, std::string & encoded) const
+{
+  ITK_WASM_TRACE_SCOPE("WasmZstdImageIO::EncodePayloadCodec");
+  try
+  {
+    wasm::EncodePayloadCodec(this->GetPayloadFilters().codec, GetPayloadCodecImage(*this), buffer, encoded);
+  }
+  catch (const std::runtime_error & error)
+  {
+    itkExceptionMacro("Could not write " << this->GetFileName() << ": " << error.what());
+  }
+}
+
+
+void
+WasmZstdImageIO
+::DecodePayloadCodec(const unsigned char * encoded, size_t size, void * buffer)
+{
+  ITK_WASM_TRACE_SCOPE("WasmZstdImageIO::DecodePayloadCodec");
+  try
+  {
+    wasm::DecodePayloadCodec(this->GetPayloadFilters().codec, GetPayloadCodecImage(*this), this->GetResolutionReduction(), encoded, size, buffer);
+  }
+  catch (const std::runtime_error & error)
+  {
+    itkExceptionMacro("Could not read " << this->GetFileName() << ": " << error.what());
+  }
+}
+
+
+wasm::PayloadFilters
+WasmZstdImageIO
+::GetPayloadFiltersForWriting() const
+{
+  switch (this->GetComponentType())
+  {
+    case IOComponentEnum::UCHAR:
+    case IOComponentEnum::CHAR:
+    case IOComponentEnum::USHORT:
+    case IOComponentEnum::SHORT:
+      if (this->m_PayloadCodecForWriting != wasm::PayloadCodec::None)
+      {
+        wasm::PayloadFilters filters;
+        filters.codec = this->m_PayloadCodecForWriting;
+        return filters;
+      }
+      break;
+    default:
+      break;
+  }
+  if (!this->IsZstdOutput())
+  {
+    return Superclass::GetPayloadFiltersForWriting();
+  }
+
+  // The RunLengthPayload takes precedence over the other filters
+  const wasm::PayloadFilters runLengthFilters = Superclass::GetPayloadFiltersForWriting();
+  if (runLengthFilters.runLength)
+  {
+    return runLengthFilters;
+  }
+  if (this->m_AutomaticPayloadFilters)
+  {
+    return wasm::AutomaticPayloadFilters(this->GetComponentSize());
+  }
+  return this->m_PayloadFiltersForWriting;
+}
+
+
+std::string
+WasmZstdImageIO
+::GetBundleMemberEncodingForWriting() const
+{
+  return "cbor.zst";
+}
+
+
+bool
+WasmZstdImageIO
+::IsZstdInput() const
+{
+  if (this->FileNameIsBundle())
+  {
+    return this->GetBundleMember().encoding == "cbor.zst";
+  }
   const std::string path = this->GetFileName();
   std::string::size_type zstdPos = path.rfind(".zst");
-  if ( ( zstdPos != std::string::npos )
-       && ( zstdPos == path.length() - 4 ) )
+  return zstdPos != std::string::npos && zstdPos == path.length() - 4;
+}
+
+
+bool
+WasmZstdImageIO
+::IsZstdOutput() const
+{
+  // Bundle members are compressed
+  if (this->FileNameIsBundle())
   {
-    std::ifstream dataStream;
-    this->OpenFileForReading( dataStream, this->GetFileName() );
+    return true;
+  }
+  const std::string path = this->GetFileName();
+  std::string::size_type zstdPos = path.rfind(".zst");
+  return zstdPos != std::string::npos && zstdPos == path.length() - 4;
+}
+
 
-    std::ostringstream ostrm;
-    ostrm << dataStream.rdbuf();
-    auto inputBinary = ostrm.str();
+std::string
+WasmZstdImageIO
+::GetChunkCompressionForWriting() const
+{
+  return this->m_CompressChunks ? "zstd" : Superclass::GetChunkCompressionForWriting();
+}
 
 
-    const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-    std::vector<char> decompressedBinary(decompressedBufferSize);
+bool
+WasmZstdImageIO
+::ReadChunkFile(const std::string & chunkPath, void * data, size_t size) const
+{
+  if (this->GetChunkCompression() != "zstd")
+  {
+    return Superclass::ReadChunkFile(chunkPath, data, size);
+  }
+
+  ITK_WASM_TRACE_SCOPE("WasmZstdImageIO::DecompressChunk");
+  const std::string fileName = chunkPath + ".raw.zst";
+  std::unique_ptr<wasm::RangeReader> reader = wasm::RangeReader::Open(fileName);
+  if (!reader)
+  {
+    return false;
+  }
+  std::vector<char> compressed(static_cast<size_t>(reader->GetSize()));
+  if (!reader->Read(0, compressed.data(), compressed.size()))
+  {
+    itkExceptionMacro("Could not read " << fileName);
+  }
+  const std::shared_ptr<const wasm::ZstdDictionary> dictionary =
+    this->GetDictionary(ZSTD_getDictID_fromFrame(compressed.data(), compressed.size()), fileName);
+  size_t result = 0;
+  if (dictionary)
+  {
+    ZSTD_DCtx * context = ZSTD_createDCtx();
+    result = ZSTD_decompress_usingDDict(context, data, size, compressed.data(), compressed.size(), dictionary->GetDecompressionDictionary());
+    ZSTD_freeDCtx(context);
+  }
+  else
+  {
+    result = ZSTD_decompress(data, size, compressed.data(), compressed.size());
+  }
+  if (ZSTD_isError(result) || result != size)
+  {
+    itkExceptionMacro("Could not decompress " << fileName);
+  }
+  return true;
+}
 
-    const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-    decompressedBinary.resize(decompressedSize);
 
-    this->ReadCBOR(buffer, reinterpret_cast< unsigned char *>(&(decompressedBinary.at(0))), decompressedSize);
+void
+WasmZstdImageIO
+::WriteChunkFile(const std::string & chunkPath, const void * data, size_t size) const
+{
+  if (this->GetChunkCompression() != "zstd")
+  {
+    Superclass::WriteChunkFile(chunkPath, data, size);
     return;
   }
 
-  Superclass::Read(buffer);
+  // Chunks are compressed in parallel, one frame each
+  ITK_WASM_TRACE_SCOPE("WasmZstdImageIO::CompressChunk");
+  const std::string fileName = chunkPath + ".raw.zst";
+  std::vector<char> compressed(ZSTD_compressBound(size));
+  const std::shared_ptr<const wasm::ZstdDictionary> dictionary = this->GetDictionary(0, fileName);
+  size_t compressedSize = 0;
+  if (dictionary)
+  {
+    const ZSTD_CDict * compressionDictionary = dictionary->GetCompressionDictionary(this->GetCompressionLevel());
+    if (compressionDictionary == nullptr)
+    {
+      itkExceptionMacro("Could not use the zstd dictionary " << this->m_DictionaryFileName);
+    }
+    ZSTD_CCtx * context = ZSTD_createCCtx();
+    compressedSize = ZSTD_compress_usingCDict(context, compressed.data(), compressed.size(), data, size, compressionDictionary);
+    ZSTD_freeCCtx(context);
+  }
+  else
+  {
+    compressedSize = ZSTD_compress(compressed.data(), compressed.size(), data, size, this->GetCompressionLevel());
+  }
+  if (ZSTD_isError(compressedSize))
+  {
+    itkExceptionMacro("Could not compress " << fileName);
+  }
+  std::ofstream chunkStream(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  chunkStream.write(compressed.data(), compressedSize);
+  if (!chunkStream)
+  {
+    itkExceptionMacro("Could not write " << fileName);
+  }
+}
+
+
+std::shared_ptr<const wasm::ZstdDictionary>
+WasmZstdImageIO
+::GetDictionary(unsigned int recordedID, const std::string & fileName) const
+{
+  if (this->m_DictionaryFileName.empty())
+  {
+    if (recordedID != 0)
+    {
+      itkExceptionMacro(<< fileName << " was compressed with the zstd dictionary " << recordedID << ", and no DictionaryFileName is set");
+    }
+    return nullptr;
+  }
+
+  std::shared_ptr<const wasm::ZstdDictionary> dictionary = wasm::ZstdDictionary::Read(this->m_DictionaryFileName);
+  if (!dictionary)
+  {
+    itkExceptionMacro("Could not read the zstd dictionary " << this->m_DictionaryFileName);
+  }
+  if (recordedID != 0 && dictionary->GetID() != recordedID)
+  {
+    itkExceptionMacro(<< fileName << " was compressed with the zstd dictionary " << recordedID << ", not "
+                      << this->m_DictionaryFileName << ", whose ID is " << dictionary->GetID());
+  }
+  return dictionary;
 }
 
 
@@ -160,6 +601,36 @@ WasmZstdImageIO
 }
 
 
+std::unique_ptr<wasm::CBORSink>
+WasmZstdImageIO
+::CreateCBORSink(uint64_t encodedSize) const
+{
+  if (!this->IsZstdOutput())
+  {
+    return Superclass::CreateCBORSink(encodedSize);
+  }
+
+  const std::string path(this->GetFileName());
+  FILE * file = this->OpenCBORFile();
+  if (file == NULL)
+  {
+    itkExceptionMacro("Could not open file for writing: " << path);
+  }
+  // Pledge the frame content size for single-shot decoders
+  auto sink = std::make_unique<wasm::ZstdCBORSink>(file, this->GetCompressionLevel(), encodedSize);
+  const unsigned int numberOfWorkers = this->m_NumberOfWorkers > 0 ? this->m_NumberOfWorkers : MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  // One worker would only move compression off the calling thread
+  sink->SetNumberOfWorkers(numberOfWorkers > 1 ? numberOfWorkers : 0);
+  sink->SetLongDistanceMatching(this->m_LongDistanceMatching);
+  sink->SetSeekableFrameSize(this->m_SeekableFrameSize);
+  if (!sink->SetDictionary(this->GetDictionary(0, path)))
+  {
+    itkExceptionMacro("Could not use the zstd dictionary " << this->m_DictionaryFileName);
+  }
+  return sink;
+}
+
+
 void
 WasmZstdImageIO
 ::Write( const void *buffer )
@@ -170,21 +641,15 @@ WasmZstdImageIO
   if ( ( cborPos != std::string::npos )
        && ( cborPos == path.length() - 4 ) )
   {
-    unsigned char * inputBinary;
-    const size_t inputBinarySize = this->WriteCBOR(buffer, &inputBinary, true);
-
-    const size_t compressedBufferSize = ZSTD_compressBound(inputBinarySize);
-    std::vector<char> compressedBinary(compressedBufferSize);
-
-    constexpr int compressionLevel = 3;
-    const size_t compressedSize = ZSTD_compress(compressedBinary.data(), compressedBufferSize, inputBinary, inputBinarySize, compressionLevel);
-    free(inputBinary);
-    compressedBinary.resize(compressedSize);
-
-    std::ofstream outputStream;
-    this->OpenFileForWriting( outputStream, path.c_str(), true, false );
-    std::ostream_iterator<char> oIt(outputStream);
-    std::copy(compressedBinary.begin(), compressedBinary.end(), oIt);
+    ITK_WASM_TRACE_SCOPE("WasmZstdImageIO::Compress");
+    if (this->RequestedToStream())
+    {
+      this->WriteCBORRegion(buffer);
+    }
+    else
+    {
+      this->WriteCBOR(buffer);
+    }
     return;
   }
 
@@ -21,8 +21,17 @@
 
 #include "itkWasmImageIO.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace itk
 {
+namespace wasm
+{
+class ZstdDictionary;
+}
+
 /** \class WasmZstdImageIO
  *
  * \brief Read and write an itk::Image in a web-friendly format.
@@ -32,8 +41,11 @@ namespace itk
  * filesystem with JSON files and binary files for TypedArrays.
  * 
  * This class extends WasmImageIO by adding support for zstandard compression.
+ * The zstd compression level is the ImageIOBase CompressionLevel, 3 by
+ * default.
  *
- * The file extensions used are .iwi, .iwi.cbor, and .iwi.cbor.zstd.
+ * The file extensions used are .iwi, .iwi.cbor, and .iwi.cbor.zstd. The
+ * members of .iwi.bundle files written are compressed.
  * 
  * \ingroup IOFilters
  * \ingroup WebAssemblyInterface
@@ -52,10 +64,87 @@ public:
   /** Run-time type information (and related methods). */
   itkTypeMacro(WasmZstdImageIO, WasmImageIO);
 
+  /** Number of zstd worker threads used to compress. 0 uses the global
+   * default number of threads, which is set by the pipeline --threads
+   * option. Compression is single threaded when libzstd is built without
+   * multithreading support. */
+  itkSetMacro(NumberOfWorkers, unsigned int);
+  itkGetConstMacro(NumberOfWorkers, unsigned int);
+
+  /** Enable zstd long-distance matching. Off by default. */
+  itkSetMacro(LongDistanceMatching, bool);
+  itkGetConstMacro(LongDistanceMatching, bool);
+  itkBooleanMacro(LongDistanceMatching);
+
+  /** Decompressed bytes per independent zstd frame when writing, 0 for a
+   * single frame. Non-zero sizes write the zstd seekable format: a seek
+   * table after the frames lets readers decompress only the frames of the
+   * requested region. Off by default, since decoders that only read the
+   * first frame's content size cannot read multiple frames. */
+  itkSetMacro(SeekableFrameSize, SizeValueType);
+  itkGetConstMacro(SeekableFrameSize, SizeValueType);
+
+  /** Reversible filters of the pixel data before compression, e.g. a byte
+   * shuffle, which groups the high and low bytes of int16 CT or float
+   * pixels so they compress better. The filters are recorded in the file
+   * and reversed on read. None by default, since older readers do not
+   * reverse them. */
+  void SetPayloadFiltersForWriting(const wasm::PayloadFilters & filters)
+  {
+    m_PayloadFiltersForWriting = filters;
+    this->Modified();
+  }
+
+  /** Lossless image codec of the pixel data of 8 and 16 bit integer images
+   * when writing, e.g. htj2k, which is resolution scalable, see the
+   * ResolutionReduction, or jpegxl. The codec takes precedence over the
+   * other payload filters, and is used in .iwi.cbor and .iwi.cbor.zst files
+   * and bundle members. None by default, since readers without the codecs,
+   * e.g. the core WasmImageIO, cannot decode it. */
+  void SetPayloadCodecForWriting(wasm::PayloadCodec codec)
+  {
+    m_PayloadCodecForWriting = codec;
+    this->Modified();
+  }
+  wasm::PayloadCodec GetPayloadCodecForWriting() const
+  {
+    return m_PayloadCodecForWriting;
+  }
+
+  /** Select the payload filters by component type when writing, instead of
+   * the PayloadFiltersForWriting: a byte shuffle for multi-byte
+   * components. Off by default. */
+  itkSetMacro(AutomaticPayloadFilters, bool);
+  itkGetConstMacro(AutomaticPayloadFilters, bool);
+  itkBooleanMacro(AutomaticPayloadFilters);
+
+  /** Compress each chunk of a chunked .iwi directory with zstd, at the
+   * CompressionLevel, when writing. Off by default, since WasmImageIO
+   * cannot read compressed chunks. */
+  itkSetMacro(CompressChunks, bool);
+  itkGetConstMacro(CompressChunks, bool);
+  itkBooleanMacro(CompressChunks);
+
+  /** zstd dictionary file of .zst files and chunks, e.g. one trained with
+   * the compress-stringify train-zstd-dictionary pipeline on similar small
+   * images. Writing records its dictionary ID in the frame headers, and
+   * reading requires the dictionary with the recorded ID. Empty, for no
+   * dictionary, by default. */
+  itkSetStringMacro(DictionaryFileName);
+  itkGetStringMacro(DictionaryFileName);
+
+  /** Dictionary ID recorded in the .zst file read by ReadImageInformation,
+   * 0 if it was compressed without a dictionary. */
+  itkGetConstMacro(DictionaryID, unsigned int);
+
   /** Determine the file type. Returns true if this ImageIO can read the
    * file specified. */
   bool CanReadFile(const char *) override;
 
+  /** Streamed reads of .zst files are supported when the file has a seek
+   * table and no payload filters. */
+  bool CanStreamRead() override;
+
   /** Set the spacing and dimension information for the set filename. */
   void ReadImageInformation() override;
 
@@ -77,8 +166,72 @@ protected:
   WasmZstdImageIO();
   ~WasmZstdImageIO() override;
 
+  /** Decode the .iwi.cbor.zst file with a streaming decompressor. The pixel
+   * data is decompressed directly into the buffer. A decode that continues
+   * the stream of ReadImageInformation does not decompress the header
+   * again. */
+  void ReadZstdCBOR(void * buffer);
+
+  /** Decompress the frames of a seekable file that overlap the IORegion in
+   * parallel. */
+  void ReadCBORData(void * buffer, wasm::CBORSource & source, uint64_t dataSize) override;
+
+  /** Encode and decode the planes of the pixel data with the HTJ2K or
+   * JPEG XL payload codec, in parallel. Planes are decoded directly into
+   * the buffer. */
+  void EncodePayloadCodec(const void * buffer, std::string & encoded) const override;
+  void DecodePayloadCodec(const unsigned char * encoded, size_t size, void * buffer) override;
+
+  /** The payload codec of 8 and 16 bit integer images, otherwise the
+   * payload filters of .zst files. */
+  wasm::PayloadFilters GetPayloadFiltersForWriting() const override;
+
+  /** A zstd sink for .zst files. Streamed writes compress each piece as it
+   * is appended. */
+  std::unique_ptr<wasm::CBORSink> CreateCBORSink(uint64_t encodedSize) const override;
+
+  /** "cbor.zst": bundle members are compressed like .iwi.cbor.zst files. */
+  std::string GetBundleMemberEncodingForWriting() const override;
+
+  /** "zstd" when CompressChunks is on. */
+  std::string GetChunkCompressionForWriting() const override;
+
+  /** Read and write .raw.zst chunks, one zstd frame per chunk. */
+  bool ReadChunkFile(const std::string & chunkPath, void * data, size_t size) const override;
+  void WriteChunkFile(const std::string & chunkPath, const void * data, size_t size) const override;
+
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(WasmZstdImageIO);
+
+  /** Whether the file, or the selected member of a .iwi.bundle file, read or
+   * written is zstd compressed. */
+  bool IsZstdInput() const;
+  bool IsZstdOutput() const;
+
+  /** The cached DictionaryFileName dictionary, nullptr without one. Throws
+   * if it cannot be read, or if a dictionary ID is recorded in the frames of
+   * the file and it is not that dictionary. */
+  std::shared_ptr<const wasm::ZstdDictionary> GetDictionary(unsigned int recordedID, const std::string & fileName) const;
+
+  unsigned int m_NumberOfWorkers{ 0 };
+  bool m_LongDistanceMatching{ false };
+  SizeValueType m_SeekableFrameSize{ 0 };
+  wasm::PayloadFilters m_PayloadFiltersForWriting;
+  bool m_AutomaticPayloadFilters{ false };
+  wasm::PayloadCodec m_PayloadCodecForWriting{ wasm::PayloadCodec::None };
+  bool m_CompressChunks{ false };
+  std::string m_DictionaryFileName;
+  unsigned int m_DictionaryID{ 0 };
+
+  // Frame offsets from the seek table of the file being read
+  std::vector<uint64_t> m_FrameCompressedOffsets;
+  std::vector<uint64_t> m_FrameDecompressedOffsets;
+
+  // Decompression stream left after the image information by
+  // ReadImageInformation, which the next Read of the file continues
+  std::unique_ptr<wasm::CBORSource> m_InformationSource;
+  CBORReadProgress m_InformationProgress;
+  std::string m_InformationFileName;
 };
 } // end namespace itk
 
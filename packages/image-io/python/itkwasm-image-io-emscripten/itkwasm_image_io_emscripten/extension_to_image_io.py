@@ -15,7 +15,9 @@ extension_to_image_io = OrderedDict([
 
   ('.iwi', 'wasm'),
   ('.iwi.cbor', 'wasm'),
+  ('.iwi.bin', 'wasm'),
   ('.iwi.cbor.zst', 'wasmZstd'),
+  ('.iwi.bundle', 'wasmZstd'),
 
   ('.lsm', 'lsm'),
 
@@ -15,7 +15,9 @@ extension_to_image_io = OrderedDict([
 
   ('.iwi', 'wasm'),
   ('.iwi.cbor', 'wasm'),
+  ('.iwi.bin', 'wasm'),
   ('.iwi.cbor.zst', 'wasm_zstd'),
+  ('.iwi.bundle', 'wasm_zstd'),
 
   ('.lsm', 'lsm'),
 
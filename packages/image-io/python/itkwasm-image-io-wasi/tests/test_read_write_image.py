@@ -29,6 +29,16 @@ def test_read_image():
     image = read_image(test_input_file_path)
     verify_image(image)
 
+def test_read_image_information_only():
+    information = read_image(test_input_file_path, information_only=True)
+    assert information.size == [256, 256]
+    assert information.imageType.components == 3
+    assert information.data.size == 0
+
+    # The pixel read that follows continues from the kept header
+    image = read_image(test_input_file_path)
+    verify_image(image)
+
 def test_read_image_pixel_type():
     image = read_image(test_input_file_path, pixel_type=PixelTypes.Vector)
     assert image.imageType.pixelType == "Vector"
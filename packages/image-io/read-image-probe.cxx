@@ -0,0 +1,278 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkOutputTextStream.h"
+#include "itkWasmFileHeader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// The IMAGE_IO_CLASS ids and kebab names of CMakeLists.txt
+struct ImageIO
+{
+  unsigned int id;
+  const char * name;
+};
+
+constexpr ImageIO PNG{ 0, "png" };
+constexpr ImageIO Meta{ 1, "meta" };
+constexpr ImageIO TIFF{ 2, "tiff" };
+constexpr ImageIO NIfTI{ 3, "nifti" };
+constexpr ImageIO JPEG{ 4, "jpeg" };
+constexpr ImageIO NRRD{ 5, "nrrd" };
+constexpr ImageIO VTK{ 6, "vtk" };
+constexpr ImageIO BMP{ 7, "bmp" };
+constexpr ImageIO HDF5{ 8, "hdf5" };
+constexpr ImageIO MINC{ 9, "minc" };
+constexpr ImageIO MRC{ 10, "mrc" };
+constexpr ImageIO LSM{ 11, "lsm" };
+constexpr ImageIO MGH{ 12, "mgh" };
+constexpr ImageIO BioRad{ 13, "bio-rad" };
+constexpr ImageIO GIPL{ 14, "gipl" };
+constexpr ImageIO GE4{ 15, "ge4" };
+constexpr ImageIO GE5{ 16, "ge5" };
+constexpr ImageIO GEAdw{ 17, "ge-adw" };
+constexpr ImageIO GDCM{ 18, "gdcm" };
+constexpr ImageIO Scanco{ 19, "scanco" };
+constexpr ImageIO FDF{ 20, "fdf" };
+constexpr ImageIO Wasm{ 21, "wasm" };
+constexpr ImageIO WasmZstd{ 22, "wasm-zstd" };
+
+using itk::wasm::FileHeader;
+
+// Image IOs whose signature is in the header, most specific first
+std::vector<ImageIO>
+MagicMatches(const FileHeader & header)
+{
+  std::vector<ImageIO> matches;
+  if (header.Has(0, "\x89PNG\r\n\x1a\n"))
+  {
+    matches.push_back(PNG);
+  }
+  if (header.Has(0, "\xff\xd8\xff"))
+  {
+    matches.push_back(JPEG);
+  }
+  if (header.Has(0, "II*\0", 4) || header.Has(0, "MM\0*", 4) || header.Has(0, "II+\0", 4) || header.Has(0, "MM\0+", 4))
+  {
+    // LSM files are TIFF files
+    matches.push_back(TIFF);
+    matches.push_back(LSM);
+  }
+  if (header.Has(344, "n+1\0", 4) || header.Has(344, "ni1\0", 4) || header.Has(4, "n+2\0", 4) ||
+      header.Has(4, "ni2\0", 4) || header.UInt32(0, false) == 348 || header.UInt32(0, true) == 348)
+  {
+    // NIfTI-1, NIfTI-2, or an Analyze 7.5 header
+    matches.push_back(NIfTI);
+  }
+  if (header.Has(0, "NRRD000"))
+  {
+    matches.push_back(NRRD);
+  }
+  if (header.Has(0, "# vtk DataFile"))
+  {
+    matches.push_back(VTK);
+  }
+  if (header.Has(128, "DICM"))
+  {
+    matches.push_back(GDCM);
+  }
+  const char hdf5Signature[] = "\x89HDF\r\n\x1a\n";
+  if (header.Has(0, hdf5Signature) || header.Has(512, hdf5Signature) || header.Has(1024, hdf5Signature) ||
+      header.Has(2048, hdf5Signature))
+  {
+    // MINC2 files are HDF5 files
+    matches.push_back(HDF5);
+    matches.push_back(MINC);
+  }
+  if (header.Has(0, "CDF\x01") || header.Has(0, "CDF\x02"))
+  {
+    // MINC1 netCDF
+    matches.push_back(MINC);
+  }
+  if (header.Has(208, "MAP "))
+  {
+    matches.push_back(MRC);
+  }
+  if (header.Has(54, "\x39\x30", 2))
+  {
+    // The file id, 12345, of a little endian Bio-Rad PIC header
+    matches.push_back(BioRad);
+  }
+  if (header.UInt32(252, true) == 0xefffe9b0 || header.UInt32(252, true) == 0x2ae389b8)
+  {
+    matches.push_back(GIPL);
+  }
+  if (header.Has(0, "IMGF"))
+  {
+    matches.push_back(GE5);
+  }
+  if (header.Has(0, "CTDATA-HEADER_V1") || header.Has(0, "AIMDATA_V030"))
+  {
+    matches.push_back(Scanco);
+  }
+  if (header.Has(0, "#!/usr/local/fdf/startup"))
+  {
+    matches.push_back(FDF);
+  }
+  if (header.Has(0, "\x28\xb5\x2f\xfd"))
+  {
+    matches.push_back(WasmZstd);
+  }
+  if (header.Has(0, "\x89IWI\r\n\x1a\n"))
+  {
+    // A .iwi.bin aligned file
+    matches.push_back(Wasm);
+  }
+  if (header.Has(0, "\x89IWB\r\n\x1a\n"))
+  {
+    // A .iwi.bundle file, whose members may be compressed
+    matches.push_back(WasmZstd);
+    matches.push_back(Wasm);
+  }
+  if (header.Has(1, "\x69imageType"))
+  {
+    // A .iwi.cbor map whose first key is imageType
+    matches.push_back(Wasm);
+  }
+  if (header.StartsWithKeyword("ObjectType") || header.StartsWithKeyword("NDims"))
+  {
+    matches.push_back(Meta);
+  }
+  if (header.Has(0, "BM"))
+  {
+    matches.push_back(BMP);
+  }
+  return matches;
+}
+
+// Image IOs of the file extension, as in extension-to-image-io.ts
+std::vector<ImageIO>
+ExtensionMatches(std::string fileName)
+{
+  std::transform(fileName.begin(), fileName.end(), fileName.begin(), [](unsigned char c) { return std::tolower(c); });
+  while (!fileName.empty() && (fileName.back() == '/' || fileName.back() == '\\'))
+  {
+    // .iwi directories
+    fileName.pop_back();
+  }
+
+  struct Extension
+  {
+    const char * extension;
+    ImageIO imageIO;
+  };
+  static const Extension extensions[] = {
+    { ".bmp", BMP },       { ".dcm", GDCM },     { ".gipl", GIPL },       { ".gipl.gz", GIPL },
+    { ".hdf5", HDF5 },     { ".jpg", JPEG },     { ".jpeg", JPEG },       { ".iwi", Wasm },
+    { ".iwi.cbor", Wasm }, { ".iwi.cbor.zst", WasmZstd }, { ".iwi.bin", Wasm }, { ".iwi.bundle", WasmZstd }, { ".lsm", LSM },
+    { ".mnc", MINC },      { ".mnc.gz", MINC },  { ".mnc2", MINC },       { ".mgh", MGH },
+    { ".mgz", MGH },       { ".mgh.gz", MGH },   { ".mha", Meta },        { ".mhd", Meta },
+    { ".mrc", MRC },       { ".nia", NIfTI },    { ".nii", NIfTI },       { ".nii.gz", NIfTI },
+    { ".hdr", NIfTI },     { ".nrrd", NRRD },    { ".nhdr", NRRD },
+    { ".png", PNG },       { ".pic", BioRad },   { ".tif", TIFF },        { ".tiff", TIFF },
+    { ".vtk", VTK },       { ".isq", Scanco },   { ".aim", Scanco },      { ".fdf", FDF },
+  };
+
+  std::vector<ImageIO> matches;
+  for (const Extension & extension : extensions)
+  {
+    const size_t size = std::strlen(extension.extension);
+    if (fileName.size() >= size && fileName.compare(fileName.size() - size, size, extension.extension) == 0)
+    {
+      matches.push_back(extension.imageIO);
+    }
+  }
+  return matches;
+}
+
+bool
+Contains(const std::vector<ImageIO> & imageIOs, const ImageIO & imageIO)
+{
+  return std::any_of(imageIOs.begin(), imageIOs.end(), [&](const ImageIO & other) { return other.id == imageIO.id; });
+}
+
+} // end anonymous namespace
+
+int
+main(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("read-image-probe",
+                               "Rank the image IOs that may read a file by its magic bytes and extension",
+                               argc,
+                               argv);
+
+  std::string inputFileName;
+  pipeline.add_option("serialized-image", inputFileName, "Input image serialized in the file format")
+    ->required()
+    ->check(CLI::ExistingPath)
+    ->type_name("INPUT_BINARY_FILE");
+
+  itk::wasm::OutputTextStream imageIOs;
+  pipeline
+    .add_option("image-ios",
+                imageIOs,
+                "Ranked image IOs to try, as [{\"id\": IMAGE_IO_CLASS, \"name\": kebab name}]. Empty if the file is not recognized.")
+    ->required()
+    ->type_name("OUTPUT_JSON");
+
+  ITK_WASM_PARSE(pipeline);
+
+  // A signature that agrees with the extension ranks first, then other
+  // signatures, then the extension alone
+  const std::vector<ImageIO> magicMatches = MagicMatches(FileHeader(inputFileName));
+  const std::vector<ImageIO> extensionMatches = ExtensionMatches(inputFileName);
+  std::vector<ImageIO> ranked;
+  for (const ImageIO & imageIO : magicMatches)
+  {
+    if (Contains(extensionMatches, imageIO) && !Contains(ranked, imageIO))
+    {
+      ranked.push_back(imageIO);
+    }
+  }
+  for (const ImageIO & imageIO : magicMatches)
+  {
+    if (!Contains(ranked, imageIO))
+    {
+      ranked.push_back(imageIO);
+    }
+  }
+  for (const ImageIO & imageIO : extensionMatches)
+  {
+    if (!Contains(ranked, imageIO))
+    {
+      ranked.push_back(imageIO);
+    }
+  }
+
+  imageIOs.Get() << "[";
+  for (size_t ii = 0; ii < ranked.size(); ++ii)
+  {
+    imageIOs.Get() << (ii > 0 ? ", " : "") << "{\"id\": " << ranked[ii].id << ", \"name\": \"" << ranked[ii].name << "\"}";
+  }
+  imageIOs.Get() << "]\n";
+
+  return EXIT_SUCCESS;
+}
@@ -74,6 +74,7 @@
 #error "Unsupported IMAGE_IO_CLASS"
 #endif
 #include "itkWasmImageIO.h"
+#include "itkWasmRangeReader.h"
 
 #define VALUE(string) #string
 #define TO_LITERAL(string) VALUE(string)
@@ -81,26 +82,117 @@
 #include "itkPipeline.h"
 #include "itkOutputImage.h"
 
+#include <chrono>
+#include <cstdint>
+#include <sys/stat.h>
+
+namespace
+{
+
+// In reactor mode the module instance runs several invocations, e.g. an
+// --information-only read and the pixel read that follows. The image IO of
+// an information-only read is kept with its header state, e.g. the
+// decompression stream of a .zst file, so the next read of the same file
+// continues from it instead of creating, opening, and parsing again. Only
+// the most recent local file is kept, for a short time.
+struct CachedImageIO
+{
+  std::string fileName;
+  int64_t fileSize{ 0 };
+  int64_t fileModified{ 0 };
+  itk::ImageIOBase::Pointer imageIO;
+  std::chrono::steady_clock::time_point cached;
+};
+
+constexpr std::chrono::seconds cachedImageIOLifetime{ 30 };
+
+CachedImageIO cachedImageIO;
+
+// The size and modification time of a local file, to detect that it changed
+bool fileIdentity(const std::string & fileName, int64_t & fileSize, int64_t & fileModified)
+{
+  struct stat status;
+  if (stat(fileName.c_str(), &status) != 0 || !S_ISREG(status.st_mode))
+  {
+    return false;
+  }
+  fileSize = static_cast<int64_t>(status.st_size);
+  fileModified = static_cast<int64_t>(status.st_mtime);
+  return true;
+}
+
+// The kept image IO of the file, once
+itk::ImageIOBase::Pointer takeCachedImageIO(const std::string & fileName)
+{
+  itk::ImageIOBase::Pointer imageIO = cachedImageIO.imageIO;
+  cachedImageIO.imageIO = nullptr;
+  int64_t fileSize = 0;
+  int64_t fileModified = 0;
+  if (imageIO.IsNull() || cachedImageIO.fileName != fileName ||
+      std::chrono::steady_clock::now() - cachedImageIO.cached > cachedImageIOLifetime ||
+      !fileIdentity(fileName, fileSize, fileModified) || fileSize != cachedImageIO.fileSize ||
+      fileModified != cachedImageIO.fileModified)
+  {
+    return nullptr;
+  }
+  return imageIO;
+}
+
+void cacheImageIO(const std::string & fileName, itk::ImageIOBase * imageIO)
+{
+  CachedImageIO cached;
+  if (!fileIdentity(fileName, cached.fileSize, cached.fileModified))
+  {
+    // URLs are not kept
+    return;
+  }
+  cached.fileName = fileName;
+  cached.imageIO = imageIO;
+  cached.cached = std::chrono::steady_clock::now();
+  cachedImageIO = cached;
+}
+
+} // end anonymous namespace
+
 template <typename TImageIO>
 int readImage(const std::string & inputFileName, itk::wasm::OutputTextStream & couldRead, itk::wasm::OutputImageIO & outputImageIO, bool informationOnly)
 {
   using ImageIOType = TImageIO;
 
-  auto imageIO = ImageIOType::New();
-
   outputImageIO.SetInformationOnly(informationOnly);
 
-  if (imageIO->CanReadFile(inputFileName.c_str()))
+  typename ImageIOType::Pointer imageIO = dynamic_cast<ImageIOType *>(takeCachedImageIO(inputFileName).GetPointer());
+  bool informationRead = imageIO.IsNotNull();
+  if (!informationRead)
   {
-    couldRead.Get() << "true\n";
+    imageIO = ImageIOType::New();
+    if (!imageIO->CanReadFile(inputFileName.c_str()))
+    {
+      couldRead.Get() << "false\n";
+      return EXIT_FAILURE;
+    }
+    imageIO->SetFileName(inputFileName);
   }
-  else
+  couldRead.Get() << "true\n";
+
+  if (informationOnly)
   {
-    couldRead.Get() << "false\n";
-    return EXIT_FAILURE;
+    try
+    {
+      if (!informationRead)
+      {
+        imageIO->ReadImageInformation();
+        informationRead = true;
+      }
+      cacheImageIO(inputFileName, imageIO);
+    }
+    catch (const itk::ExceptionObject &)
+    {
+      // Read again, and reported, by the output
+    }
   }
 
-  imageIO->SetFileName(inputFileName);
+  outputImageIO.SetImageInformationRead(informationRead);
   outputImageIO.Set(imageIO);
 
   return EXIT_SUCCESS;
@@ -111,8 +203,12 @@ int main (int argc, char * argv[])
   const char * pipelineName = TO_LITERAL(IMAGE_IO_KEBAB_NAME) "-read-image";
   itk::wasm::Pipeline pipeline(pipelineName, "Read an image file format and convert it to the itk-wasm file format", argc, argv);
 
+  // .iwi files can also be fetched by range from a URL with the host range fetch import
+  const CLI::Validator urlValidator([](std::string & name) {
+    return itk::wasm::RangeReader::IsURL(name) ? std::string() : std::string("Not a URL: ") + name;
+  }, "URL");
   std::string inputFileName;
-  pipeline.add_option("serialized-image", inputFileName, "Input image serialized in the file format")->required()->check(CLI::ExistingFile)->type_name("INPUT_BINARY_FILE");
+  pipeline.add_option("serialized-image", inputFileName, "Input image serialized in the file format")->required()->check(CLI::ExistingFile | urlValidator)->type_name("INPUT_BINARY_FILE");
 
   itk::wasm::OutputTextStream couldRead;
   pipeline.add_option("could-read", couldRead, "Whether the input could be read. If false, the output image is not valid.")->required()->type_name("OUTPUT_JSON");
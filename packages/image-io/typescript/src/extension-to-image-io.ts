@@ -13,7 +13,9 @@ const extensionToImageIo = new Map([
 
   ['iwi', 'wasm'],
   ['iwi.cbor', 'wasm'],
+  ['iwi.bin', 'wasm'],
   ['iwi.cbor.zst', 'wasmZstd'],
+  ['iwi.bundle', 'wasmZstd'],
 
   ['lsm', 'lsm'],
 
@@ -0,0 +1,367 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkInputImageIO.h"
+#include "itkOutputTextStream.h"
+#include "itkWasmImageIOBase.h"
+#include "itkImageIOBase.h"
+
+// The FAN_OUT_IMAGE_IO_<IMAGE_IO_CLASS> definitions of CMakeLists.txt
+#ifdef FAN_OUT_IMAGE_IO_0
+#include "itkPNGImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_1
+#include "itkMetaImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_2
+#include "itkTIFFImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_3
+#include "itkNiftiImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_4
+#include "itkJPEGImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_5
+#include "itkNrrdImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_6
+#include "itkVTKImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_7
+#include "itkBMPImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_8
+#include "itkHDF5ImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_9
+#include "itkMINCImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_10
+#include "itkMRCImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_11
+#include "itkLSMImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_12
+#include "itkMGHImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_13
+#include "itkBioRadImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_14
+#include "itkGiplImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_15
+#include "itkGE4ImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_16
+#include "itkGE5ImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_17
+#include "itkGEAdwImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_18
+#include "itkGDCMImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_19
+#include "itkScancoImageIO.h"
+#endif
+#ifdef FAN_OUT_IMAGE_IO_22
+#include "itkWasmZstdImageIO.h"
+#endif
+#include "itkWasmImageIO.h"
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+template <typename TImageIO>
+itk::ImageIOBase::Pointer
+CreateImageIO()
+{
+  return TImageIO::New();
+}
+
+struct ImageIOEntry
+{
+  const char * name;
+  itk::ImageIOBase::Pointer (*create)();
+};
+
+// The kebab names of CMakeLists.txt, in the order the image IOs are tried
+// when --image-io is not given
+const std::vector<ImageIOEntry> &
+ImageIOEntries()
+{
+  static const std::vector<ImageIOEntry> entries = {
+#ifdef FAN_OUT_IMAGE_IO_0
+    { "png", CreateImageIO<itk::PNGImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_1
+    { "meta", CreateImageIO<itk::MetaImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_2
+    { "tiff", CreateImageIO<itk::TIFFImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_3
+    { "nifti", CreateImageIO<itk::NiftiImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_4
+    { "jpeg", CreateImageIO<itk::JPEGImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_5
+    { "nrrd", CreateImageIO<itk::NrrdImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_6
+    { "vtk", CreateImageIO<itk::VTKImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_7
+    { "bmp", CreateImageIO<itk::BMPImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_8
+    { "hdf5", CreateImageIO<itk::HDF5ImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_9
+    { "minc", CreateImageIO<itk::MINCImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_10
+    { "mrc", CreateImageIO<itk::MRCImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_11
+    { "lsm", CreateImageIO<itk::LSMImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_12
+    { "mgh", CreateImageIO<itk::MGHImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_13
+    { "bio-rad", CreateImageIO<itk::BioRadImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_14
+    { "gipl", CreateImageIO<itk::GiplImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_15
+    { "ge4", CreateImageIO<itk::GE4ImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_16
+    { "ge5", CreateImageIO<itk::GE5ImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_17
+    { "ge-adw", CreateImageIO<itk::GEAdwImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_18
+    { "gdcm", CreateImageIO<itk::GDCMImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_19
+    { "scanco", CreateImageIO<itk::ScancoImageIO> },
+#endif
+#ifdef FAN_OUT_IMAGE_IO_22
+    { "wasm-zstd", CreateImageIO<itk::WasmZstdImageIO> },
+#endif
+    { "wasm", CreateImageIO<itk::WasmImageIO> },
+  };
+  return entries;
+}
+
+// A file to write and the image IO that writes it
+struct Target
+{
+  std::string fileName;
+  std::string imageIOName;
+  itk::ImageIOBase::Pointer imageIO;
+};
+
+// Find the image IO of a target, by name or, without a name, the first that
+// can write its file. The image IO is nullptr if none can.
+void
+SelectImageIO(Target & target)
+{
+  for (const ImageIOEntry & entry : ImageIOEntries())
+  {
+    if (!target.imageIOName.empty() && target.imageIOName != entry.name)
+    {
+      continue;
+    }
+    itk::ImageIOBase::Pointer imageIO = entry.create();
+    if (imageIO->CanWriteFile(target.fileName.c_str()))
+    {
+      target.imageIOName = entry.name;
+      target.imageIO = imageIO;
+      return;
+    }
+    if (!target.imageIOName.empty())
+    {
+      return;
+    }
+  }
+}
+
+// As in writeImage of write-image.cxx
+void
+WriteTarget(const Target & target, const itk::WasmImageIOBase * inputWasmImageIOBase, bool informationOnly, bool useCompression)
+{
+  itk::ImageIOBase * imageIO = target.imageIO;
+  imageIO->SetFileName(target.fileName);
+  imageIO->SetUseCompression(useCompression);
+
+  const itk::ImageIOBase * inputImageIOBase = inputWasmImageIOBase->GetImageIO();
+
+  const unsigned int dimension = inputImageIOBase->GetNumberOfDimensions();
+  imageIO->SetNumberOfDimensions(dimension);
+  imageIO->SetComponentType(inputImageIOBase->GetComponentType());
+  imageIO->SetNumberOfComponents(inputImageIOBase->GetNumberOfComponents());
+  imageIO->SetPixelType(inputImageIOBase->GetPixelType());
+  std::vector<double> direction(dimension);
+  const auto directionContainer = inputWasmImageIOBase->GetDirectionContainer();
+  for (unsigned int dim = 0; dim < dimension; ++dim)
+  {
+    for (unsigned int dd = 0; dd < dimension; ++dd)
+    {
+      direction[dd] = directionContainer->GetElement(dim + dimension * dd);
+    }
+    imageIO->SetDirection(dim, direction);
+    imageIO->SetOrigin(dim, inputImageIOBase->GetOrigin(dim));
+    imageIO->SetSpacing(dim, inputImageIOBase->GetSpacing(dim));
+    imageIO->SetDimensions(dim, inputImageIOBase->GetDimensions(dim));
+  }
+  itk::ImageIORegion ioRegion(dimension);
+  for (unsigned int dim = 0; dim < dimension; ++dim)
+  {
+    ioRegion.SetSize(dim, inputImageIOBase->GetDimensions(dim));
+  }
+  imageIO->SetIORegion(ioRegion);
+
+  imageIO->WriteImageInformation();
+  if (!informationOnly)
+  {
+    imageIO->Write(reinterpret_cast<const void *>(&(inputWasmImageIOBase->GetPixelDataContainer()->at(0))));
+  }
+}
+
+} // end anonymous namespace
+
+int
+main(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("write-image-fan-out",
+                               "Write an itk-wasm file format converted to several image files and formats",
+                               argc,
+                               argv);
+
+  itk::wasm::InputImageIO inputImageIO;
+  pipeline.add_option("image", inputImageIO, "Input image")->required()->type_name("INPUT_IMAGE");
+
+  itk::wasm::OutputTextStream couldWrite;
+  pipeline
+    .add_option("could-write",
+                couldWrite,
+                "Whether each output could be written, as a JSON array of booleans. If any is false, no output is written.")
+    ->type_name("OUTPUT_JSON");
+
+  std::vector<std::string> outputFileNames;
+  pipeline.add_option("serialized-images", outputFileNames, "Output images serialized in their file formats.")
+    ->required()
+    ->expected(1, -1)
+    ->type_name("OUTPUT_BINARY_FILE");
+
+  std::vector<std::string> imageIONames;
+  pipeline
+    .add_option("--image-io",
+                imageIONames,
+                "Kebab name of the image IO of each output, e.g. wasm-zstd, png, or nifti. By default, the first image IO "
+                "that can write the output file name.")
+    ->expected(1, -1)
+    ->type_name("TEXT");
+
+  bool informationOnly = false;
+  pipeline.add_flag("-i,--information-only", informationOnly, "Only write image metadata -- do not write pixel data.");
+
+  bool useCompression = false;
+  pipeline.add_flag("-c,--use-compression", useCompression, "Use compression in the written files");
+
+  ITK_WASM_PARSE(pipeline);
+
+  if (!imageIONames.empty() && imageIONames.size() != outputFileNames.size())
+  {
+    std::cerr << "One --image-io is required for each of the " << outputFileNames.size() << " serialized images" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<Target> targets(outputFileNames.size());
+  bool canWrite = true;
+  couldWrite.Get() << "[";
+  for (size_t ii = 0; ii < targets.size(); ++ii)
+  {
+    targets[ii].fileName = outputFileNames[ii];
+    if (!imageIONames.empty())
+    {
+      targets[ii].imageIOName = imageIONames[ii];
+    }
+    SelectImageIO(targets[ii]);
+    canWrite = canWrite && targets[ii].imageIO;
+    couldWrite.Get() << (ii > 0 ? ", " : "") << (targets[ii].imageIO ? "true" : "false");
+  }
+  couldWrite.Get() << "]\n";
+  if (!canWrite)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The targets of an image IO are written in turn, since some file format
+  // libraries are not reentrant, and the image IOs are written concurrently
+  // in threaded builds.
+  std::map<std::string, std::vector<const Target *>> imageIOTargets;
+  for (const Target & target : targets)
+  {
+    imageIOTargets[target.imageIOName].push_back(&target);
+  }
+  const itk::WasmImageIOBase * inputWasmImageIOBase = inputImageIO.Get();
+  try
+  {
+    for (const auto & entry : imageIOTargets)
+    {
+      itk::wasm::Pipeline::serialize_output(
+        [&ioTargets = entry.second, inputWasmImageIOBase, informationOnly, useCompression]() {
+          for (const Target * target : ioTargets)
+          {
+            WriteTarget(*target, inputWasmImageIOBase, informationOnly, useCompression);
+          }
+        });
+    }
+    itk::wasm::Pipeline::wait_for_outputs();
+  }
+  catch (const std::exception & error)
+  {
+    try
+    {
+      // The writes that already started
+      itk::wasm::Pipeline::wait_for_outputs();
+    }
+    catch (const std::exception &)
+    {
+    }
+    std::cerr << "Could not write an output: " << error.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkInputImage.h"
+#include "itkOutputImage.h"
+#include "itkSupportInputImageTypes.h"
+
+#include "itkImage.h"
+#include "itkVectorImage.h"
+
+template<typename TImage>
+class PipelineFunctor
+{
+public:
+  int operator()(itk::wasm::Pipeline & pipeline)
+  {
+    using ImageType = TImage;
+
+    // Input components are converted to the output component type on import,
+    // so the image is only passed through
+    using InputImageType = itk::wasm::InputImage<ImageType>;
+    InputImageType inputImage;
+    pipeline.add_option("input", inputImage, "Input image")->required()->type_name("INPUT_IMAGE");
+
+    std::string componentType;
+    pipeline.add_option("-c,--component-type", componentType, "Output component type, e.g. uint8 or float32. Defaults to the input component type.");
+
+    using OutputImageType = itk::wasm::OutputImage<ImageType>;
+    OutputImageType outputImage;
+    pipeline.add_option("output", outputImage, "Output image")->required()->type_name("OUTPUT_IMAGE");
+
+    ITK_WASM_PARSE(pipeline);
+
+    outputImage.Set(inputImage.Get());
+
+    return EXIT_SUCCESS;
+  }
+};
+
+int main(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("cast-image", "Cast an image to another component type. Float to integer casts truncate and wrap as with JavaScript TypedArray's.", argc, argv);
+
+  using SupportedImageTypes = itk::wasm::SupportInputImageTypes<PipelineFunctor,
+    uint8_t,
+    int8_t,
+    uint16_t,
+    int16_t,
+    uint32_t,
+    int32_t,
+    uint64_t,
+    int64_t,
+    float,
+    double,
+    itk::VariableLengthVector<uint8_t>,
+    itk::VariableLengthVector<int8_t>,
+    itk::VariableLengthVector<uint16_t>,
+    itk::VariableLengthVector<int16_t>,
+    itk::VariableLengthVector<uint32_t>,
+    itk::VariableLengthVector<int32_t>,
+    itk::VariableLengthVector<uint64_t>,
+    itk::VariableLengthVector<int64_t>,
+    itk::VariableLengthVector<float>,
+    itk::VariableLengthVector<double>
+    >;
+
+  // Dispatch on the output image type: the input image type with the
+  // requested component type
+  itk::wasm::InterfaceImageType imageType;
+  if (!SupportedImageTypes::IsPassThrough(pipeline))
+  {
+    auto inputOption = pipeline.add_option("input", imageType, "Read image type.");
+    std::string componentType;
+    auto componentTypeOption = pipeline.add_option("-c,--component-type", componentType, "Read component type.");
+
+    ITK_WASM_PRE_PARSE(pipeline);
+
+    pipeline.remove_option(inputOption);
+    pipeline.remove_option(componentTypeOption);
+    if (!componentType.empty())
+    {
+      imageType.componentType = componentType;
+    }
+  }
+
+  return SupportedImageTypes::Dimensions<2U, 3U, 4U>(imageType, pipeline, itk::wasm::ComponentConversion::Cast);
+}
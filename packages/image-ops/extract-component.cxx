@@ -0,0 +1,107 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkInputImage.h"
+#include "itkOutputImage.h"
+#include "itkSupportInputImageTypes.h"
+
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkImage.h"
+#include "itkMultiThreaderBase.h"
+#include "itkRGBAPixel.h"
+#include "itkRGBPixel.h"
+#include "itkVectorImage.h"
+
+#include "imageOpsExtractComponent.h"
+
+#include <algorithm>
+
+template<typename TImage>
+class PipelineFunctor
+{
+public:
+  int operator()(itk::wasm::Pipeline & pipeline)
+  {
+    using ImageType = TImage;
+    using ComponentType = typename itk::DefaultConvertPixelTraits<typename ImageType::PixelType>::ComponentType;
+    using ScalarImageType = itk::Image<ComponentType, ImageType::ImageDimension>;
+
+    using InputImageType = itk::wasm::InputImage<ImageType>;
+    InputImageType inputImage;
+    pipeline.add_option("input", inputImage, "Input multi-component image")->required()->type_name("INPUT_IMAGE");
+
+    unsigned int component = 0;
+    pipeline.add_option("-c,--component", component, "Index of the component to extract");
+
+    using OutputImageType = itk::wasm::OutputImage<ScalarImageType>;
+    OutputImageType componentImage;
+    pipeline.add_option("component-image", componentImage, "Output scalar image of the component")->required()->type_name("OUTPUT_IMAGE");
+
+    ITK_WASM_PARSE(pipeline);
+
+    const ImageType * image = inputImage.Get();
+    const unsigned int numberOfComponents = image->GetNumberOfComponentsPerPixel();
+    if (component >= numberOfComponents)
+    {
+      CLI::Error err("Runtime error", "The component index must be less than the number of components", 1);
+      return pipeline.exit(err);
+    }
+
+    auto extracted = ScalarImageType::New();
+    extracted->CopyInformation(image);
+    extracted->SetRegions(image->GetBufferedRegion());
+    const size_t numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+    if (!componentImage.BindBuffer(extracted) || extracted->GetPixelContainer()->Size() < numberOfPixels)
+    {
+      ITK_WASM_CATCH_EXCEPTION(pipeline, extracted->Allocate());
+    }
+
+    const auto * pixels = reinterpret_cast<const ComponentType *>(image->GetBufferPointer());
+    ComponentType * extractedBuffer = extracted->GetBufferPointer();
+    constexpr size_t chunkSize = 64 * 1024;
+    const size_t numberOfChunks = (numberOfPixels + chunkSize - 1) / chunkSize;
+    itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfChunks, [&](itk::SizeValueType chunk) {
+      const size_t begin = chunk * chunkSize;
+      ExtractComponent(pixels, numberOfComponents, component, extractedBuffer, begin, std::min(numberOfPixels, begin + chunkSize));
+    }, nullptr);
+
+    typename ScalarImageType::ConstPointer constExtracted = extracted.GetPointer();
+    componentImage.Set(constExtracted);
+
+    return EXIT_SUCCESS;
+  }
+};
+
+int main(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("extract-component", "Extract one component of a multi-component image as a scalar image.", argc, argv);
+
+  return itk::wasm::SupportInputImageTypes<PipelineFunctor,
+    itk::VariableLengthVector<uint8_t>,
+    itk::VariableLengthVector<int8_t>,
+    itk::VariableLengthVector<uint16_t>,
+    itk::VariableLengthVector<int16_t>,
+    itk::VariableLengthVector<uint32_t>,
+    itk::VariableLengthVector<int32_t>,
+    itk::VariableLengthVector<float>,
+    itk::VariableLengthVector<double>,
+    itk::RGBPixel<uint8_t>,
+    itk::RGBAPixel<uint8_t>
+    >
+  ::Dimensions<2U, 3U, 4U>("input", pipeline);
+}
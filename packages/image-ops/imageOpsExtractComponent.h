@@ -0,0 +1,108 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef imageOpsExtractComponent_h
+#define imageOpsExtractComponent_h
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__wasm_simd128__)
+#  include <wasm_simd128.h>
+#endif
+
+// Extract one component of interleaved pixels with a component count known
+// at compile time, so the compiler unrolls the stride and vectorizes
+template <unsigned int VComponents, typename TComponent>
+void
+ExtractComponent(const TComponent * pixels, unsigned int component, TComponent * extracted, size_t begin, size_t end)
+{
+  size_t pixel = begin;
+#if defined(__wasm_simd128__)
+  if constexpr (sizeof(TComponent) == 1 && VComponents == 4)
+  {
+    // Four RGBA-like pixels per vector, one byte of each
+    const auto select = static_cast<uint8_t>(component);
+    const v128_t indices = wasm_i8x16_add(wasm_i8x16_splat(select),
+                                          wasm_i8x16_make(0, 4, 8, 12, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16));
+    for (; pixel + 16 <= end; pixel += 16)
+    {
+      const auto * source = pixels + pixel * 4;
+      // Out of range swizzle indices select 0, so each vector fills its own
+      // four lanes and the results are merged with an or
+      const v128_t a = wasm_i8x16_swizzle(wasm_v128_load(source), indices);
+      const v128_t b = wasm_i8x16_swizzle(wasm_v128_load(source + 16), indices);
+      const v128_t c = wasm_i8x16_swizzle(wasm_v128_load(source + 32), indices);
+      const v128_t d = wasm_i8x16_swizzle(wasm_v128_load(source + 48), indices);
+      const v128_t ab = wasm_i8x16_shuffle(a, b, 0, 1, 2, 3, 16, 17, 18, 19, 0, 0, 0, 0, 0, 0, 0, 0);
+      const v128_t cd = wasm_i8x16_shuffle(c, d, 0, 1, 2, 3, 16, 17, 18, 19, 0, 0, 0, 0, 0, 0, 0, 0);
+      wasm_v128_store(extracted + pixel, wasm_i64x2_shuffle(ab, cd, 0, 2));
+    }
+  }
+  else if constexpr (sizeof(TComponent) == 1 && VComponents == 3)
+  {
+    // Five RGB-like pixels per 16 byte load
+    const auto select = static_cast<uint8_t>(component);
+    const v128_t indices = wasm_i8x16_add(wasm_i8x16_splat(select),
+                                          wasm_i8x16_make(0, 3, 6, 9, 12, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16));
+    for (; pixel + 5 <= end && (end - pixel) * 3 >= 16; pixel += 5)
+    {
+      const v128_t selected = wasm_i8x16_swizzle(wasm_v128_load(pixels + pixel * 3), indices);
+      wasm_v128_store32_lane(extracted + pixel, selected, 0);
+      extracted[pixel + 4] = static_cast<TComponent>(wasm_u8x16_extract_lane(selected, 4));
+    }
+  }
+#endif
+  for (; pixel < end; ++pixel)
+  {
+    extracted[pixel] = pixels[pixel * VComponents + component];
+  }
+}
+
+template <typename TComponent>
+void
+ExtractComponent(const TComponent * pixels,
+                 unsigned int       numberOfComponents,
+                 unsigned int       component,
+                 TComponent *       extracted,
+                 size_t             begin,
+                 size_t             end)
+{
+  switch (numberOfComponents)
+  {
+    case 1:
+      ExtractComponent<1>(pixels, component, extracted, begin, end);
+      return;
+    case 2:
+      ExtractComponent<2>(pixels, component, extracted, begin, end);
+      return;
+    case 3:
+      ExtractComponent<3>(pixels, component, extracted, begin, end);
+      return;
+    case 4:
+      ExtractComponent<4>(pixels, component, extracted, begin, end);
+      return;
+    default:
+      for (size_t pixel = begin; pixel < end; ++pixel)
+      {
+        extracted[pixel] = pixels[pixel * numberOfComponents + component];
+      }
+  }
+}
+
+#endif
@@ -0,0 +1,549 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef imageOpsMedian_h
+#define imageOpsMedian_h
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#if defined(__wasm_simd128__)
+#  include <wasm_simd128.h>
+#endif
+
+// Median filters of a buffered image with a box kernel of radius r, i.e.
+// (2r + 1) pixels, in each dimension. Pixels outside the image are those of
+// the nearest edge, as the zero flux Neumann boundary condition of
+// itk::MedianImageFilter, and the median is the element of rank N / 2 of the
+// N kernel pixels. Each filter writes the rows [rowBegin, rowEnd) of a plane
+// of the output, i.e. lines along the fastest dimension at fixed higher
+// indices, so work units of rows run in parallel. The output buffer starts at
+// the linear index outputBegin of the image, e.g. a split along the slowest
+// dimension.
+
+template <unsigned int VDimension>
+class MedianGeometry
+{
+public:
+  MedianGeometry(const std::array<size_t, VDimension> & size, const std::array<unsigned int, VDimension> & radius)
+    : m_Size(size)
+    , m_Radius(radius)
+  {
+    size_t stride = 1;
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      m_Stride[dim] = stride;
+      stride *= m_Size[dim];
+    }
+  }
+
+  size_t
+  GetSize(unsigned int dim) const
+  {
+    return m_Size[dim];
+  }
+
+  long long
+  GetRadius(unsigned int dim) const
+  {
+    return m_Radius[dim];
+  }
+
+  size_t
+  GetStride(unsigned int dim) const
+  {
+    return m_Stride[dim];
+  }
+
+  size_t
+  GetNumberOfPlanes() const
+  {
+    size_t planes = 1;
+    for (unsigned int dim = 2; dim < VDimension; ++dim)
+    {
+      planes *= m_Size[dim];
+    }
+    return planes;
+  }
+
+  size_t
+  GetKernelSize() const
+  {
+    size_t kernelSize = 1;
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      kernelSize *= 2 * m_Radius[dim] + 1;
+    }
+    return kernelSize;
+  }
+
+  static size_t
+  Clamp(long long index, size_t size)
+  {
+    return static_cast<size_t>(std::clamp<long long>(index, 0, static_cast<long long>(size) - 1));
+  }
+
+  // Offset of the first pixel of the plane
+  size_t
+  GetPlaneOffset(size_t plane) const
+  {
+    return plane * (VDimension > 1 ? m_Stride[1] * m_Size[1] : m_Size[0]);
+  }
+
+  // Offsets of the kernel pixels in the dimensions above the rows, for the
+  // pixels of the plane, with edge pixels repeated for the out of image ones
+  std::vector<size_t>
+  GetPlaneWindowOffsets(size_t plane) const
+  {
+    std::vector<size_t> offsets{ 0 };
+    for (unsigned int dim = 2; dim < VDimension; ++dim)
+    {
+      const long long index = static_cast<long long>(plane % m_Size[dim]);
+      plane /= m_Size[dim];
+      std::vector<size_t> expanded;
+      expanded.reserve(offsets.size() * (2 * m_Radius[dim] + 1));
+      for (long long delta = -GetRadius(dim); delta <= GetRadius(dim); ++delta)
+      {
+        const size_t offset = Clamp(index + delta, m_Size[dim]) * m_Stride[dim];
+        for (size_t previous : offsets)
+        {
+          expanded.push_back(previous + offset);
+        }
+      }
+      offsets.swap(expanded);
+    }
+    return offsets;
+  }
+
+  // Offsets of the kernel pixels in the dimensions above the fastest, for the
+  // pixels of a row of the plane
+  std::vector<size_t>
+  GetRowWindowOffsets(const std::vector<size_t> & planeWindowOffsets, size_t row) const
+  {
+    std::vector<size_t> offsets;
+    offsets.reserve(planeWindowOffsets.size() * (2 * m_Radius[1] + 1));
+    for (long long delta = -GetRadius(1); delta <= GetRadius(1); ++delta)
+    {
+      const size_t offset = Clamp(static_cast<long long>(row) + delta, m_Size[1]) * m_Stride[1];
+      for (size_t planeOffset : planeWindowOffsets)
+      {
+        offsets.push_back(planeOffset + offset);
+      }
+    }
+    return offsets;
+  }
+
+private:
+  std::array<size_t, VDimension> m_Size;
+  std::array<unsigned int, VDimension> m_Radius;
+  std::array<size_t, VDimension> m_Stride;
+};
+
+// Histogram bins of 8 and 16 bit integer pixels. Signed values are offset so
+// bins are in value order.
+template <typename TPixel>
+struct MedianHistogramTraits
+{
+  static_assert(std::is_integral_v<TPixel> && sizeof(TPixel) <= 2, "Histograms of 8 and 16 bit integers");
+  using UnsignedType = std::make_unsigned_t<TPixel>;
+  static constexpr size_t Bins = size_t(1) << (8 * sizeof(TPixel));
+  // Bins per coarse bin, so both levels are searched in about sqrt(Bins) steps
+  static constexpr unsigned int FineBits = 4 * sizeof(TPixel);
+  static constexpr size_t CoarseBins = Bins >> FineBits;
+  static constexpr UnsignedType SignOffset = std::is_signed_v<TPixel> ? UnsignedType(Bins >> 1) : UnsignedType(0);
+
+  static size_t
+  ToBin(TPixel value)
+  {
+    return static_cast<UnsignedType>(static_cast<UnsignedType>(value) ^ SignOffset);
+  }
+
+  static TPixel
+  FromBin(size_t bin)
+  {
+    return static_cast<TPixel>(static_cast<UnsignedType>(bin) ^ SignOffset);
+  }
+
+  // The bin of the element of the rank in a two level histogram
+  static size_t
+  FindRank(const uint32_t * fine, const uint32_t * coarse, size_t rank)
+  {
+    size_t count = 0;
+    size_t coarseBin = 0;
+    while (count + coarse[coarseBin] <= rank)
+    {
+      count += coarse[coarseBin];
+      ++coarseBin;
+    }
+    size_t bin = coarseBin << FineBits;
+    while (count + fine[bin] <= rank)
+    {
+      count += fine[bin];
+      ++bin;
+    }
+    return bin;
+  }
+};
+
+// Perreault and Hebert, Median Filtering in Constant Time, 2007, for 8 bit
+// pixels. A histogram of each column, the kernel pixels at an index of the
+// fastest dimension, slides along the rows. The kernel histogram slides
+// along a row by adding the entering column histogram and subtracting the
+// leaving one, a constant number of bins whatever the radius.
+template <typename TPixel, unsigned int VDimension>
+void
+ColumnHistogramMedian(const TPixel *                      input,
+                      TPixel *                            output,
+                      const MedianGeometry<VDimension> & geometry,
+                      size_t                              plane,
+                      size_t                              rowBegin,
+                      size_t                              rowEnd,
+                      size_t                              outputBegin)
+{
+  using Traits = MedianHistogramTraits<TPixel>;
+  constexpr size_t Bins = Traits::Bins;
+  constexpr size_t CoarseBins = Traits::CoarseBins;
+  constexpr unsigned int FineBits = Traits::FineBits;
+
+  const size_t width = geometry.GetSize(0);
+  const size_t height = geometry.GetSize(1);
+  const long long radius0 = geometry.GetRadius(0);
+  const long long radius1 = geometry.GetRadius(1);
+  const size_t rank = geometry.GetKernelSize() / 2;
+  const size_t rowStride = geometry.GetStride(1);
+  const std::vector<size_t> planeWindowOffsets = geometry.GetPlaneWindowOffsets(plane);
+  const size_t planeOffset = geometry.GetPlaneOffset(plane);
+
+  std::vector<uint32_t> columns(width * Bins, 0);
+  std::vector<uint32_t> coarseColumns(width * CoarseBins, 0);
+  // Add, 1, or remove, -1 in modular arithmetic, a row of the column kernels
+  auto updateColumns = [&](size_t row, uint32_t increment) {
+    const TPixel * rowPixels = input + row * rowStride;
+    for (size_t offset : planeWindowOffsets)
+    {
+      for (size_t x = 0; x < width; ++x)
+      {
+        const size_t bin = Traits::ToBin(rowPixels[offset + x]);
+        columns[x * Bins + bin] += increment;
+        coarseColumns[x * CoarseBins + (bin >> FineBits)] += increment;
+      }
+    }
+  };
+  for (long long delta = -radius1; delta <= radius1; ++delta)
+  {
+    updateColumns(MedianGeometry<VDimension>::Clamp(static_cast<long long>(rowBegin) + delta, height), 1);
+  }
+
+  std::array<uint32_t, Bins> kernel;
+  std::array<uint32_t, CoarseBins> coarseKernel;
+  for (size_t row = rowBegin; row < rowEnd; ++row)
+  {
+    if (row > rowBegin)
+    {
+      updateColumns(MedianGeometry<VDimension>::Clamp(static_cast<long long>(row) - 1 - radius1, height), uint32_t(-1));
+      updateColumns(MedianGeometry<VDimension>::Clamp(static_cast<long long>(row) + radius1, height), 1);
+    }
+
+    kernel.fill(0);
+    coarseKernel.fill(0);
+    for (long long delta = -radius0; delta <= radius0; ++delta)
+    {
+      const size_t column = MedianGeometry<VDimension>::Clamp(delta, width);
+      const uint32_t * columnBins = columns.data() + column * Bins;
+      const uint32_t * coarseColumnBins = coarseColumns.data() + column * CoarseBins;
+      for (size_t bin = 0; bin < Bins; ++bin)
+      {
+        kernel[bin] += columnBins[bin];
+      }
+      for (size_t bin = 0; bin < CoarseBins; ++bin)
+      {
+        coarseKernel[bin] += coarseColumnBins[bin];
+      }
+    }
+
+    TPixel * outputRow = output + (planeOffset + row * rowStride - outputBegin);
+    for (size_t x = 0; x < width; ++x)
+    {
+      if (x > 0)
+      {
+        const size_t entering = MedianGeometry<VDimension>::Clamp(static_cast<long long>(x) + radius0, width);
+        const size_t leaving = MedianGeometry<VDimension>::Clamp(static_cast<long long>(x) - 1 - radius0, width);
+        if (entering != leaving)
+        {
+          // Whole histogram updates, vectorized by the compiler
+          const uint32_t * enteringBins = columns.data() + entering * Bins;
+          const uint32_t * leavingBins = columns.data() + leaving * Bins;
+          for (size_t bin = 0; bin < Bins; ++bin)
+          {
+            kernel[bin] += enteringBins[bin] - leavingBins[bin];
+          }
+          const uint32_t * enteringCoarse = coarseColumns.data() + entering * CoarseBins;
+          const uint32_t * leavingCoarse = coarseColumns.data() + leaving * CoarseBins;
+          for (size_t bin = 0; bin < CoarseBins; ++bin)
+          {
+            coarseKernel[bin] += enteringCoarse[bin] - leavingCoarse[bin];
+          }
+        }
+      }
+      outputRow[x] = Traits::FromBin(Traits::FindRank(kernel.data(), coarseKernel.data(), rank));
+    }
+  }
+}
+
+// Huang, Yang, and Tang, A Fast Two-Dimensional Median Filtering Algorithm,
+// 1979, generalized to N dimensions, for 16 bit pixels, whose column
+// histograms would be too large. The kernel histogram slides along a row by
+// adding and removing the kernel pixels at the entering and leaving indices.
+template <typename TPixel, unsigned int VDimension>
+void
+SlidingHistogramMedian(const TPixel *                      input,
+                       TPixel *                            output,
+                       const MedianGeometry<VDimension> & geometry,
+                       size_t                              plane,
+                       size_t                              rowBegin,
+                       size_t                              rowEnd,
+                       size_t                              outputBegin)
+{
+  using Traits = MedianHistogramTraits<TPixel>;
+  constexpr unsigned int FineBits = Traits::FineBits;
+
+  const size_t width = geometry.GetSize(0);
+  const long long radius0 = geometry.GetRadius(0);
+  const size_t rank = geometry.GetKernelSize() / 2;
+  const std::vector<size_t> planeWindowOffsets = geometry.GetPlaneWindowOffsets(plane);
+  const size_t planeOffset = geometry.GetPlaneOffset(plane);
+
+  std::vector<uint32_t> kernel(Traits::Bins, 0);
+  std::vector<uint32_t> coarseKernel(Traits::CoarseBins, 0);
+  for (size_t row = rowBegin; row < rowEnd; ++row)
+  {
+    const std::vector<size_t> rowWindowOffsets = geometry.GetRowWindowOffsets(planeWindowOffsets, row);
+    auto update = [&](size_t x, uint32_t increment) {
+      for (size_t offset : rowWindowOffsets)
+      {
+        const size_t bin = Traits::ToBin(input[offset + x]);
+        kernel[bin] += increment;
+        coarseKernel[bin >> FineBits] += increment;
+      }
+    };
+
+    for (long long delta = -radius0; delta <= radius0; ++delta)
+    {
+      update(MedianGeometry<VDimension>::Clamp(delta, width), 1);
+    }
+    TPixel * outputRow = output + (planeOffset + row * geometry.GetStride(1) - outputBegin);
+    for (size_t x = 0; x < width; ++x)
+    {
+      if (x > 0)
+      {
+        update(MedianGeometry<VDimension>::Clamp(static_cast<long long>(x) - 1 - radius0, width), uint32_t(-1));
+        update(MedianGeometry<VDimension>::Clamp(static_cast<long long>(x) + radius0, width), 1);
+      }
+      outputRow[x] = Traits::FromBin(Traits::FindRank(kernel.data(), coarseKernel.data(), rank));
+    }
+    // Back to empty histograms for the next row
+    for (long long delta = -radius0; delta <= radius0; ++delta)
+    {
+      update(MedianGeometry<VDimension>::Clamp(static_cast<long long>(width) - 1 + delta, width), uint32_t(-1));
+    }
+  }
+}
+
+// Selection of the median of the gathered kernel pixels, for floating point
+// pixels
+template <typename TPixel, unsigned int VDimension>
+void
+SelectionMedian(const TPixel *                      input,
+                TPixel *                            output,
+                const MedianGeometry<VDimension> & geometry,
+                size_t                              plane,
+                size_t                              rowBegin,
+                size_t                              rowEnd,
+                size_t                              outputBegin)
+{
+  const size_t width = geometry.GetSize(0);
+  const long long radius0 = geometry.GetRadius(0);
+  const size_t rank = geometry.GetKernelSize() / 2;
+  const std::vector<size_t> planeWindowOffsets = geometry.GetPlaneWindowOffsets(plane);
+  const size_t planeOffset = geometry.GetPlaneOffset(plane);
+
+  std::vector<TPixel> values(geometry.GetKernelSize());
+  for (size_t row = rowBegin; row < rowEnd; ++row)
+  {
+    const std::vector<size_t> rowWindowOffsets = geometry.GetRowWindowOffsets(planeWindowOffsets, row);
+    TPixel * outputRow = output + (planeOffset + row * geometry.GetStride(1) - outputBegin);
+    for (size_t x = 0; x < width; ++x)
+    {
+      auto value = values.begin();
+      for (long long delta = -radius0; delta <= radius0; ++delta)
+      {
+        const size_t column = MedianGeometry<VDimension>::Clamp(static_cast<long long>(x) + delta, width);
+        for (size_t offset : rowWindowOffsets)
+        {
+          *value++ = input[offset + column];
+        }
+      }
+      std::nth_element(values.begin(), values.begin() + rank, values.end());
+      outputRow[x] = values[rank];
+    }
+  }
+}
+
+// Devillard's median of 9 sorting network, 19 compare and exchanges, on
+// scalars or on vectors of pixels
+template <typename TValue, typename TMin, typename TMax>
+TValue
+Median9(TValue p[9], TMin min, TMax max)
+{
+  auto sort = [&](int a, int b) {
+    const TValue low = min(p[a], p[b]);
+    p[b] = max(p[a], p[b]);
+    p[a] = low;
+  };
+  sort(1, 2);
+  sort(4, 5);
+  sort(7, 8);
+  sort(0, 1);
+  sort(3, 4);
+  sort(6, 7);
+  sort(1, 2);
+  sort(4, 5);
+  sort(7, 8);
+  sort(0, 3);
+  sort(5, 8);
+  sort(4, 7);
+  sort(3, 6);
+  sort(1, 4);
+  sort(2, 5);
+  sort(4, 7);
+  sort(4, 2);
+  sort(6, 4);
+  sort(4, 2);
+  return p[4];
+}
+
+#if defined(__wasm_simd128__)
+template <typename TPixel>
+v128_t
+VectorMin(v128_t a, v128_t b)
+{
+  if constexpr (std::is_same_v<TPixel, uint8_t>)
+    return wasm_u8x16_min(a, b);
+  else if constexpr (std::is_same_v<TPixel, int8_t>)
+    return wasm_i8x16_min(a, b);
+  else if constexpr (std::is_same_v<TPixel, uint16_t>)
+    return wasm_u16x8_min(a, b);
+  else if constexpr (std::is_same_v<TPixel, int16_t>)
+    return wasm_i16x8_min(a, b);
+  else if constexpr (std::is_same_v<TPixel, float>)
+    return wasm_f32x4_pmin(a, b);
+  else
+    return wasm_f64x2_pmin(a, b);
+}
+
+template <typename TPixel>
+v128_t
+VectorMax(v128_t a, v128_t b)
+{
+  if constexpr (std::is_same_v<TPixel, uint8_t>)
+    return wasm_u8x16_max(a, b);
+  else if constexpr (std::is_same_v<TPixel, int8_t>)
+    return wasm_i8x16_max(a, b);
+  else if constexpr (std::is_same_v<TPixel, uint16_t>)
+    return wasm_u16x8_max(a, b);
+  else if constexpr (std::is_same_v<TPixel, int16_t>)
+    return wasm_i16x8_max(a, b);
+  else if constexpr (std::is_same_v<TPixel, float>)
+    return wasm_f32x4_pmax(a, b);
+  else
+    return wasm_f64x2_pmax(a, b);
+}
+#endif
+
+// 3x3 median of 2D images with the sorting network, 16 bytes of pixels at a
+// time with SIMD128
+template <typename TPixel>
+void
+Median3x3(const TPixel * input,
+          TPixel *       output,
+          size_t         width,
+          size_t         height,
+          size_t         rowBegin,
+          size_t         rowEnd,
+          size_t         outputBegin)
+{
+  auto scalarMin = [](TPixel a, TPixel b) { return b < a ? b : a; };
+  auto scalarMax = [](TPixel a, TPixel b) { return a < b ? b : a; };
+  for (size_t row = rowBegin; row < rowEnd; ++row)
+  {
+    const TPixel * rows[3] = { input + MedianGeometry<2>::Clamp(static_cast<long long>(row) - 1, height) * width,
+                               input + row * width,
+                               input + MedianGeometry<2>::Clamp(static_cast<long long>(row) + 1, height) * width };
+    TPixel * outputRow = output + (row * width - outputBegin);
+    auto scalarMedian = [&](size_t x) {
+      const size_t columns[3] = { MedianGeometry<2>::Clamp(static_cast<long long>(x) - 1, width),
+                                  x,
+                                  MedianGeometry<2>::Clamp(static_cast<long long>(x) + 1, width) };
+      TPixel p[9];
+      for (unsigned int ii = 0; ii < 9; ++ii)
+      {
+        p[ii] = rows[ii / 3][columns[ii % 3]];
+      }
+      outputRow[x] = Median9(p, scalarMin, scalarMax);
+    };
+
+    if (width < 3)
+    {
+      for (size_t x = 0; x < width; ++x)
+      {
+        scalarMedian(x);
+      }
+      continue;
+    }
+    scalarMedian(0);
+    size_t x = 1;
+#if defined(__wasm_simd128__)
+    constexpr size_t Lanes = 16 / sizeof(TPixel);
+    for (; x + Lanes < width; x += Lanes)
+    {
+      v128_t p[9];
+      for (unsigned int ii = 0; ii < 9; ++ii)
+      {
+        p[ii] = wasm_v128_load(rows[ii / 3] + x + ii % 3 - 1);
+      }
+      wasm_v128_store(outputRow + x, Median9(p, VectorMin<TPixel>, VectorMax<TPixel>));
+    }
+#endif
+    for (; x < width - 1; ++x)
+    {
+      const TPixel * center[3] = { rows[0] + x, rows[1] + x, rows[2] + x };
+      TPixel p[9];
+      for (unsigned int ii = 0; ii < 9; ++ii)
+      {
+        p[ii] = center[ii / 3][static_cast<long long>(ii % 3) - 1];
+      }
+      outputRow[x] = Median9(p, scalarMin, scalarMax);
+    }
+    scalarMedian(width - 1);
+  }
+}
+
+#endif
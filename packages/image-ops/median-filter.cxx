@@ -0,0 +1,233 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkInputImage.h"
+#include "itkOutputImage.h"
+#include "itkSupportInputImageTypes.h"
+
+#include "itkImage.h"
+#include "itkImageRegionSplitterSlowDimension.h"
+#include "itkMultiThreaderBase.h"
+#include "itkRGBPixel.h"
+#include "itkRGBToLuminanceImageFilter.h"
+
+#include "imageOpsMedian.h"
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+// The median filter of the median-filter test pipeline, whose interface it
+// keeps, without the per pixel neighborhood sort of itk::MedianImageFilter:
+// a sorting network for 3x3 kernels, constant time column histograms for 8 bit
+// pixels, sliding histograms for 16 bit pixels, and selection otherwise.
+template<typename TImage>
+int
+MedianFilter(itk::wasm::Pipeline & pipeline, const TImage * inputImage)
+{
+  using ImageType = TImage;
+  using PixelType = typename ImageType::PixelType;
+  constexpr unsigned int Dimension = ImageType::ImageDimension;
+
+  pipeline.get_option("input-image")->required()->type_name("INPUT_IMAGE");
+
+  using OutputImageType = itk::wasm::OutputImage<ImageType>;
+  OutputImageType outputImage;
+  pipeline.add_option("output-image", outputImage, "The output image")->required()->type_name("OUTPUT_IMAGE");
+
+  unsigned int radius = 1;
+  pipeline.add_option("-r,--radius", radius, "Kernel radius in pixels");
+
+  unsigned int maxTotalSplits = 1;
+  pipeline.add_option("-m,--max-splits", maxTotalSplits, "Max total processing splits");
+
+  unsigned int split = 1;
+  pipeline.add_option("-s,--split", split, "Split to process");
+
+  ITK_WASM_PARSE(pipeline);
+
+  using RegionType = typename ImageType::RegionType;
+  const RegionType largestRegion = inputImage->GetBufferedRegion();
+  RegionType requestedRegion = largestRegion;
+  if (maxTotalSplits > 1)
+  {
+    auto splitter = itk::ImageRegionSplitterSlowDimension::New();
+    const unsigned int numberOfSplits = splitter->GetNumberOfSplits(largestRegion, maxTotalSplits);
+    if (split >= numberOfSplits)
+    {
+      std::cerr << "Error: requested split: " << split << " is outside the number of splits: " << numberOfSplits << std::endl;
+      return EXIT_FAILURE;
+    }
+    splitter->GetSplit(split, numberOfSplits, requestedRegion);
+  }
+
+  auto filtered = ImageType::New();
+  filtered->CopyInformation(inputImage);
+  filtered->SetRegions(requestedRegion);
+  const size_t numberOfPixels = requestedRegion.GetNumberOfPixels();
+  if (!outputImage.BindBuffer(filtered) || filtered->GetPixelContainer()->Size() < numberOfPixels)
+  {
+    ITK_WASM_CATCH_EXCEPTION(pipeline, filtered->Allocate());
+  }
+
+  const PixelType * input = inputImage->GetBufferPointer();
+  const auto filterMedian = [&](unsigned int kernelRadius, PixelType * output) {
+    std::array<size_t, Dimension> size;
+    std::array<unsigned int, Dimension> radii;
+    for (unsigned int dim = 0; dim < Dimension; ++dim)
+    {
+      size[dim] = largestRegion.GetSize(dim);
+      radii[dim] = kernelRadius;
+    }
+    const MedianGeometry<Dimension> geometry(size, radii);
+
+    // The requested region is a slab of the slowest dimension: rows of the
+    // first plane in 2D, whole planes otherwise
+    const size_t slabBegin = requestedRegion.GetIndex(Dimension - 1) - largestRegion.GetIndex(Dimension - 1);
+    const size_t slabEnd = slabBegin + requestedRegion.GetSize(Dimension - 1);
+    const size_t outputBegin = slabBegin * geometry.GetStride(Dimension - 1);
+    const size_t height = geometry.GetSize(1);
+    size_t planeBegin = 0;
+    size_t planeEnd = 1;
+    size_t rowBegin = slabBegin;
+    size_t rowEnd = slabEnd;
+    if (Dimension > 2)
+    {
+      const size_t planesPerSlab = geometry.GetNumberOfPlanes() / geometry.GetSize(Dimension - 1);
+      planeBegin = slabBegin * planesPerSlab;
+      planeEnd = slabEnd * planesPerSlab;
+      rowBegin = 0;
+      rowEnd = height;
+    }
+
+    // Work units of rows of a plane. Histogram filters set up their histograms
+    // once per unit, so units are a few per thread.
+    const size_t numberOfPlanes = planeEnd - planeBegin;
+    const size_t numberOfRows = rowEnd - rowBegin;
+    const size_t targetUnits = 4 * static_cast<size_t>(itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+    const size_t unitsPerPlane = std::min(numberOfRows, std::max<size_t>(1, (targetUnits + numberOfPlanes - 1) / numberOfPlanes));
+    const size_t rowsPerUnit = (numberOfRows + unitsPerPlane - 1) / unitsPerPlane;
+
+    itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfPlanes * unitsPerPlane, [&](itk::SizeValueType unit) {
+      const size_t plane = planeBegin + unit / unitsPerPlane;
+      const size_t unitRowBegin = rowBegin + (unit % unitsPerPlane) * rowsPerUnit;
+      const size_t unitRowEnd = std::min(rowEnd, unitRowBegin + rowsPerUnit);
+      if (unitRowBegin >= unitRowEnd)
+      {
+        return;
+      }
+      if (Dimension == 2 && kernelRadius == 1)
+      {
+        Median3x3(input, output, geometry.GetSize(0), height, unitRowBegin, unitRowEnd, outputBegin);
+      }
+      else if constexpr (std::is_integral_v<PixelType> && sizeof(PixelType) == 1)
+      {
+        ColumnHistogramMedian(input, output, geometry, plane, unitRowBegin, unitRowEnd, outputBegin);
+      }
+      else if constexpr (std::is_integral_v<PixelType> && sizeof(PixelType) == 2)
+      {
+        SlidingHistogramMedian(input, output, geometry, plane, unitRowBegin, unitRowEnd, outputBegin);
+      }
+      else
+      {
+        SelectionMedian(input, output, geometry, plane, unitRowBegin, unitRowEnd, outputBegin);
+      }
+    }, nullptr);
+  };
+
+  // With --progressive, publish the cheaper radius 1 median of the requested
+  // region first
+  if (itk::wasm::Pipeline::get_progressive() && radius > 1)
+  {
+    auto coarse = ImageType::New();
+    coarse->CopyInformation(inputImage);
+    coarse->SetRegions(requestedRegion);
+    ITK_WASM_CATCH_EXCEPTION(pipeline, coarse->Allocate());
+    filterMedian(1, coarse->GetBufferPointer());
+    ITK_WASM_CATCH_EXCEPTION(pipeline, outputImage.Publish(coarse));
+  }
+
+  filterMedian(radius, filtered->GetBufferPointer());
+
+  typename ImageType::ConstPointer constFiltered = filtered.GetPointer();
+  outputImage.Set(constFiltered);
+
+  return EXIT_SUCCESS;
+}
+
+template<typename TImage>
+class PipelineFunctor
+{
+public:
+  int operator()(itk::wasm::Pipeline & pipeline)
+  {
+    using ImageType = TImage;
+
+    using InputImageType = itk::wasm::InputImage<ImageType>;
+    InputImageType inputImage;
+    pipeline.add_option("input-image", inputImage, "The input image");
+
+    ITK_WASM_PRE_PARSE(pipeline);
+
+    typename ImageType::ConstPointer image = inputImage.Get();
+    return MedianFilter<ImageType>(pipeline, image);
+  }
+};
+
+template<unsigned int VDimension>
+class PipelineFunctor<itk::Image<itk::RGBPixel<uint8_t>, VDimension>>
+{
+public:
+  int operator()(itk::wasm::Pipeline & pipeline)
+  {
+    constexpr unsigned int Dimension = VDimension;
+    using PixelType = itk::RGBPixel<uint8_t>;
+    using ImageType = itk::Image<PixelType, Dimension>;
+
+    using InputImageType = itk::wasm::InputImage<ImageType>;
+    InputImageType inputImage;
+    pipeline.add_option("input-image", inputImage, "The input image");
+
+    ITK_WASM_PRE_PARSE(pipeline);
+
+    using ScalarImageType = itk::Image<uint8_t, Dimension>;
+
+    using LuminanceFilterType = itk::RGBToLuminanceImageFilter<ImageType, ScalarImageType>;
+    auto luminanceFilter = LuminanceFilterType::New();
+    luminanceFilter->SetInput(inputImage.Get());
+    ITK_WASM_CATCH_EXCEPTION(pipeline, luminanceFilter->Update());
+
+    return MedianFilter<ScalarImageType>(pipeline, luminanceFilter->GetOutput());
+  }
+};
+
+int main(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("median-filter", "Apply a median filter to an image", argc, argv);
+
+  return itk::wasm::SupportInputImageTypes<PipelineFunctor,
+    uint8_t,
+    int8_t,
+    uint16_t,
+    int16_t,
+    float,
+    double,
+    itk::RGBPixel<uint8_t>
+    >
+  ::Dimensions<2U, 3U>("input-image", pipeline);
+}
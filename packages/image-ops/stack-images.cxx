@@ -0,0 +1,126 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkInputImage.h"
+#include "itkOutputImage.h"
+#include "itkSupportInputImageTypes.h"
+
+#include "itkImage.h"
+#include "itkMultiThreaderBase.h"
+#include "itkVectorImage.h"
+
+#include <cstring>
+#include <vector>
+
+template<typename TImage>
+class PipelineFunctor
+{
+public:
+  int operator()(itk::wasm::Pipeline & pipeline)
+  {
+    using ImageType = TImage;
+    constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+    constexpr unsigned int StackOn = ImageDimension - 1;
+
+    using InputImageType = itk::wasm::InputImage<ImageType>;
+    std::vector<InputImageType> slabs;
+    pipeline.add_option("-s,--slabs", slabs, "Sequential image slabs, stacked on the last dimension")->required()->expected(1,-1)->type_name("INPUT_IMAGE");
+
+    using OutputImageType = itk::wasm::OutputImage<ImageType>;
+    OutputImageType stackedImage;
+    pipeline.add_option("stacked", stackedImage, "Stacked image")->required()->type_name("OUTPUT_IMAGE");
+
+    ITK_WASM_PARSE(pipeline);
+
+    const ImageType * firstSlab = slabs.front().Get();
+    const unsigned int numberOfComponents = firstSlab->GetNumberOfComponentsPerPixel();
+    auto size = firstSlab->GetBufferedRegion().GetSize();
+    size[StackOn] = 0;
+    std::vector<size_t> offsets;
+    for (const auto & slab : slabs)
+    {
+      const auto slabSize = slab.Get()->GetBufferedRegion().GetSize();
+      for (unsigned int dimension = 0; dimension < StackOn; ++dimension)
+      {
+        if (slabSize[dimension] != size[dimension] || slab.Get()->GetNumberOfComponentsPerPixel() != numberOfComponents)
+        {
+          CLI::Error err("Runtime error", "The slabs must have the same size, except on the last dimension, and components", 1);
+          return pipeline.exit(err);
+        }
+      }
+      offsets.push_back(static_cast<size_t>(size[StackOn]));
+      size[StackOn] += slabSize[StackOn];
+    }
+
+    auto stacked = ImageType::New();
+    stacked->CopyInformation(firstSlab);
+    typename ImageType::RegionType region(firstSlab->GetBufferedRegion().GetIndex(), size);
+    stacked->SetRegions(region);
+    stacked->SetNumberOfComponentsPerPixel(numberOfComponents);
+    // Write directly into the output region the host bound, if it is large
+    // enough
+    const size_t numberOfStackedComponents = region.GetNumberOfPixels() * numberOfComponents;
+    if (!stackedImage.BindBuffer(stacked) || stacked->GetPixelContainer()->Size() < numberOfStackedComponents)
+    {
+      ITK_WASM_CATCH_EXCEPTION(pipeline, stacked->Allocate());
+    }
+
+    // Each slab of the last dimension is contiguous in the stacked buffer,
+    // so slabs are copied with one memcpy, i.e. a wasm memory.copy, each
+    size_t sliceBytes = numberOfComponents * sizeof(typename ImageType::InternalPixelType);
+    for (unsigned int dimension = 0; dimension < StackOn; ++dimension)
+    {
+      sliceBytes *= size[dimension];
+    }
+    auto * stackedBuffer = reinterpret_cast<char *>(stacked->GetBufferPointer());
+    itk::MultiThreaderBase::New()->ParallelizeArray(0, slabs.size(), [&](itk::SizeValueType index) {
+      const ImageType * slab = slabs[index].Get();
+      const size_t slabBytes = sliceBytes * slab->GetBufferedRegion().GetSize()[StackOn];
+      std::memcpy(stackedBuffer + offsets[index] * sliceBytes, slab->GetBufferPointer(), slabBytes);
+    }, nullptr);
+
+    typename ImageType::ConstPointer constStacked = stacked.GetPointer();
+    stackedImage.Set(constStacked);
+
+    return EXIT_SUCCESS;
+  }
+};
+
+int main(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("stack-images", "Join sequential image slabs, e.g. from a DICOM series, into a single image.", argc, argv);
+
+  return itk::wasm::SupportInputImageTypes<PipelineFunctor,
+    uint8_t,
+    int8_t,
+    uint16_t,
+    int16_t,
+    uint32_t,
+    int32_t,
+    uint64_t,
+    int64_t,
+    float,
+    double,
+    itk::VariableLengthVector<uint8_t>,
+    itk::VariableLengthVector<uint16_t>,
+    itk::VariableLengthVector<int16_t>,
+    itk::VariableLengthVector<float>,
+    itk::VariableLengthVector<double>
+    >
+  ::Dimensions<2U, 3U, 4U>("--slabs", pipeline);
+}
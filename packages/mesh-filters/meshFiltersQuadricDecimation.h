@@ -0,0 +1,662 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef meshFiltersQuadricDecimation_h
+#define meshFiltersQuadricDecimation_h
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Quadric error decimation of a triangle surface (Garland and Heckbert) to a
+// series of decreasing triangle counts in one pass. Each edge collapse moves
+// the surviving vertex to the position that minimizes the sum of the squared
+// distances to the planes of the triangles merged into it. The collapse
+// queues are kept from one level to the next, so each level continues from
+// the previous one instead of starting over from the input.
+//
+// The vertices are divided by recursive bisection of their bounding boxes
+// into spatial partitions, each with its own queue. A vertex with a neighbor
+// in another partition is locked. The partitions collapse the edges between
+// their unlocked vertices concurrently: such a collapse only reads and writes
+// the vertices and triangles of its own partition. Each partition removes its
+// share of the triangles of a level, then the edges between partitions and
+// the remainder are collapsed serially from the lowest cost edge of all the
+// queues. The result depends on the number of partitions, not on the number
+// of threads.
+
+class QuadricDecimation
+{
+public:
+  using Position = std::array<double, 3>;
+  using Triangle = std::array<uint32_t, 3>;
+
+  QuadricDecimation(std::vector<Position> positions, std::vector<Triangle> triangles, unsigned int numberOfPartitions)
+    : m_Positions(std::move(positions))
+    , m_Triangles(std::move(triangles))
+    , m_NumberOfPartitions(std::max(1u, numberOfPartitions))
+  {
+    const size_t numberOfVertices = m_Positions.size();
+    m_Quadrics.assign(numberOfVertices, Quadric{});
+    m_VertexVersion.assign(numberOfVertices, 0);
+    m_VertexAlive.assign(numberOfVertices, 0);
+    m_VertexLocked.assign(numberOfVertices, 0);
+    m_VertexTriangles.resize(numberOfVertices);
+    m_TriangleAlive.assign(m_Triangles.size(), 1);
+    m_NumberOfTriangles = m_Triangles.size();
+
+    for (uint32_t triangle = 0; triangle < m_Triangles.size(); ++triangle)
+    {
+      const Triangle & vertices = m_Triangles[triangle];
+      const Position normal = Normal(m_Positions[vertices[0]], m_Positions[vertices[1]], m_Positions[vertices[2]]);
+      const double area = std::sqrt(Dot(normal, normal));
+      if (area > 0.0)
+      {
+        const Position unit{ normal[0] / area, normal[1] / area, normal[2] / area };
+        const Quadric quadric = PlaneQuadric(unit, -Dot(unit, m_Positions[vertices[0]]), 0.5 * area);
+        for (uint32_t vertex : vertices)
+        {
+          m_Quadrics[vertex] += quadric;
+        }
+      }
+      for (uint32_t vertex : vertices)
+      {
+        m_VertexTriangles[vertex].push_back(triangle);
+        m_VertexAlive[vertex] = 1;
+      }
+    }
+
+    this->AddBorderQuadrics();
+    this->Partition();
+
+    // Unique edges, each in the queue of its owner
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    edges.reserve(3 * m_Triangles.size());
+    for (const Triangle & vertices : m_Triangles)
+    {
+      for (unsigned int ii = 0; ii < 3; ++ii)
+      {
+        const uint32_t a = vertices[ii];
+        const uint32_t b = vertices[(ii + 1) % 3];
+        edges.emplace_back(std::min(a, b), std::max(a, b));
+      }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    std::vector<std::vector<Collapse>> queued(m_NumberOfPartitions + 1);
+    for (const auto & edge : edges)
+    {
+      if (edge.first != edge.second)
+      {
+        queued[this->Owner(edge.first, edge.second)].push_back(this->ComputeCollapse(edge.first, edge.second));
+      }
+    }
+    m_Queues.reserve(m_NumberOfPartitions + 1);
+    for (auto & collapses : queued)
+    {
+      m_Queues.emplace_back(CollapseGreater{}, std::move(collapses));
+    }
+  }
+
+  /** Decimate to each of the decreasing targetTriangles in turn, and call
+   * level(index) with the surface at each target. parallelize(count, work)
+   * calls work(partition) for partition in [0, count), possibly
+   * concurrently. A target is not reached when no valid collapse is left. */
+  template <typename TParallelize, typename TLevel>
+  void
+  Run(const std::vector<size_t> & targetTriangles, TParallelize && parallelize, TLevel && level)
+  {
+    for (size_t index = 0; index < targetTriangles.size(); ++index)
+    {
+      const size_t target = targetTriangles[index];
+      if (target < m_NumberOfTriangles)
+      {
+        this->DecimatePartitions(target, parallelize);
+        this->DecimateSerially(target);
+      }
+      level(index);
+    }
+  }
+
+  size_t
+  GetNumberOfTriangles() const
+  {
+    return m_NumberOfTriangles;
+  }
+
+  const std::vector<Position> &
+  GetPositions() const
+  {
+    return m_Positions;
+  }
+
+  /** Call visit(triangle, vertices) for the remaining triangles, where
+   * triangle is the index of the input triangle. The surviving vertices
+   * keep their input indices. */
+  template <typename TVisit>
+  void
+  ForEachTriangle(TVisit && visit) const
+  {
+    for (uint32_t triangle = 0; triangle < m_Triangles.size(); ++triangle)
+    {
+      if (m_TriangleAlive[triangle])
+      {
+        visit(triangle, m_Triangles[triangle]);
+      }
+    }
+  }
+
+private:
+  // Symmetric 4x4 matrix, xx xy xz xw yy yz yw zz zw ww
+  struct Quadric
+  {
+    std::array<double, 10> m{};
+
+    Quadric &
+    operator+=(const Quadric & other)
+    {
+      for (unsigned int ii = 0; ii < 10; ++ii)
+      {
+        m[ii] += other.m[ii];
+      }
+      return *this;
+    }
+
+    double
+    Error(const Position & p) const
+    {
+      const double x = p[0];
+      const double y = p[1];
+      const double z = p[2];
+      return m[0] * x * x + 2.0 * m[1] * x * y + 2.0 * m[2] * x * z + 2.0 * m[3] * x + m[4] * y * y +
+             2.0 * m[5] * y * z + 2.0 * m[6] * y + m[7] * z * z + 2.0 * m[8] * z + m[9];
+    }
+  };
+
+  struct Collapse
+  {
+    double   cost;
+    uint32_t u;
+    uint32_t v;
+    uint32_t versionU;
+    uint32_t versionV;
+    Position position;
+  };
+
+  // Lowest cost first, ties by vertex index for reproducible results
+  struct CollapseGreater
+  {
+    bool
+    operator()(const Collapse & a, const Collapse & b) const
+    {
+      if (a.cost != b.cost)
+      {
+        return a.cost > b.cost;
+      }
+      return a.u != b.u ? a.u > b.u : a.v > b.v;
+    }
+  };
+
+  using CollapseQueue = std::priority_queue<Collapse, std::vector<Collapse>, CollapseGreater>;
+
+  static double
+  Dot(const Position & a, const Position & b)
+  {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  }
+
+  static Position
+  Cross(const Position & a, const Position & b)
+  {
+    return { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+  }
+
+  static Position
+  Subtract(const Position & a, const Position & b)
+  {
+    return { a[0] - b[0], a[1] - b[1], a[2] - b[2] };
+  }
+
+  // Twice the area times the unit normal
+  static Position
+  Normal(const Position & a, const Position & b, const Position & c)
+  {
+    return Cross(Subtract(b, a), Subtract(c, a));
+  }
+
+  static Quadric
+  PlaneQuadric(const Position & n, double d, double weight)
+  {
+    Quadric quadric;
+    quadric.m = { n[0] * n[0], n[0] * n[1], n[0] * n[2], n[0] * d, n[1] * n[1],
+                  n[1] * n[2], n[1] * d,    n[2] * n[2], n[2] * d, d * d };
+    for (double & value : quadric.m)
+    {
+      value *= weight;
+    }
+    return quadric;
+  }
+
+  // Planes through the open border edges, perpendicular to their triangle,
+  // so that the borders keep their shape
+  void
+  AddBorderQuadrics()
+  {
+    constexpr double borderWeight = 1000.0;
+    for (uint32_t triangle = 0; triangle < m_Triangles.size(); ++triangle)
+    {
+      const Triangle & vertices = m_Triangles[triangle];
+      const Position normal = Normal(m_Positions[vertices[0]], m_Positions[vertices[1]], m_Positions[vertices[2]]);
+      for (unsigned int ii = 0; ii < 3; ++ii)
+      {
+        const uint32_t a = vertices[ii];
+        const uint32_t b = vertices[(ii + 1) % 3];
+        if (this->NumberOfEdgeTriangles(a, b) != 1)
+        {
+          continue;
+        }
+        const Position edge = Subtract(m_Positions[b], m_Positions[a]);
+        Position perpendicular = Cross(edge, normal);
+        const double length = std::sqrt(Dot(perpendicular, perpendicular));
+        if (length == 0.0)
+        {
+          continue;
+        }
+        for (double & value : perpendicular)
+        {
+          value /= length;
+        }
+        const Quadric quadric =
+          PlaneQuadric(perpendicular, -Dot(perpendicular, m_Positions[a]), borderWeight * Dot(edge, edge));
+        m_Quadrics[a] += quadric;
+        m_Quadrics[b] += quadric;
+      }
+    }
+  }
+
+  // Recursive bisection of the vertices along the longest axis of their
+  // bounding box, into partitions with close to the same number of vertices
+  void
+  Partition()
+  {
+    m_VertexPartition.assign(m_Positions.size(), 0);
+    std::vector<uint32_t> vertices(m_Positions.size());
+    std::iota(vertices.begin(), vertices.end(), 0);
+    this->Bisect(vertices.begin(), vertices.end(), 0, m_NumberOfPartitions);
+  }
+
+  void
+  Bisect(std::vector<uint32_t>::iterator begin,
+         std::vector<uint32_t>::iterator end,
+         unsigned int                    firstPartition,
+         unsigned int                    numberOfPartitions)
+  {
+    if (numberOfPartitions == 1 || end - begin < 2)
+    {
+      for (auto it = begin; it != end; ++it)
+      {
+        m_VertexPartition[*it] = firstPartition;
+      }
+      return;
+    }
+    Position lower = m_Positions[*begin];
+    Position upper = lower;
+    for (auto it = begin; it != end; ++it)
+    {
+      for (unsigned int dim = 0; dim < 3; ++dim)
+      {
+        lower[dim] = std::min(lower[dim], m_Positions[*it][dim]);
+        upper[dim] = std::max(upper[dim], m_Positions[*it][dim]);
+      }
+    }
+    unsigned int axis = 0;
+    for (unsigned int dim = 1; dim < 3; ++dim)
+    {
+      if (upper[dim] - lower[dim] > upper[axis] - lower[axis])
+      {
+        axis = dim;
+      }
+    }
+    const unsigned int lowerPartitions = numberOfPartitions / 2;
+    const auto middle = begin + (end - begin) * lowerPartitions / numberOfPartitions;
+    std::nth_element(begin, middle, end, [this, axis](uint32_t a, uint32_t b) {
+      return m_Positions[a][axis] != m_Positions[b][axis] ? m_Positions[a][axis] < m_Positions[b][axis] : a < b;
+    });
+    this->Bisect(begin, middle, firstPartition, lowerPartitions);
+    this->Bisect(middle, end, firstPartition + lowerPartitions, numberOfPartitions - lowerPartitions);
+  }
+
+  // The queue of an edge: its partition, or the last queue for the edges
+  // between partitions
+  unsigned int
+  Owner(uint32_t a, uint32_t b) const
+  {
+    return m_VertexPartition[a] == m_VertexPartition[b] ? m_VertexPartition[a] : m_NumberOfPartitions;
+  }
+
+  template <typename TVisit>
+  void
+  ForEachNeighbor(uint32_t vertex, TVisit && visit) const
+  {
+    for (uint32_t triangle : m_VertexTriangles[vertex])
+    {
+      for (uint32_t other : m_Triangles[triangle])
+      {
+        if (other != vertex)
+        {
+          visit(other);
+        }
+      }
+    }
+  }
+
+  std::vector<uint32_t>
+  Neighbors(uint32_t vertex) const
+  {
+    std::vector<uint32_t> neighbors;
+    this->ForEachNeighbor(vertex, [&neighbors](uint32_t other) { neighbors.push_back(other); });
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    return neighbors;
+  }
+
+  size_t
+  NumberOfEdgeTriangles(uint32_t a, uint32_t b) const
+  {
+    size_t count = 0;
+    for (uint32_t triangle : m_VertexTriangles[a])
+    {
+      const Triangle & vertices = m_Triangles[triangle];
+      count += vertices[0] == b || vertices[1] == b || vertices[2] == b;
+    }
+    return count;
+  }
+
+  void
+  ComputeLocks()
+  {
+    for (uint32_t vertex = 0; vertex < m_Positions.size(); ++vertex)
+    {
+      bool locked = false;
+      if (m_VertexAlive[vertex])
+      {
+        this->ForEachNeighbor(vertex, [&](uint32_t other) {
+          locked = locked || m_VertexPartition[other] != m_VertexPartition[vertex];
+        });
+      }
+      m_VertexLocked[vertex] = locked;
+    }
+  }
+
+  Collapse
+  ComputeCollapse(uint32_t u, uint32_t v) const
+  {
+    Quadric quadric = m_Quadrics[u];
+    quadric += m_Quadrics[v];
+    const auto & m = quadric.m;
+
+    // Solve A x = -b for the minimum, by Cramer's rule
+    const double a00 = m[0], a01 = m[1], a02 = m[2], a11 = m[4], a12 = m[5], a22 = m[7];
+    const double b0 = -m[3], b1 = -m[6], b2 = -m[8];
+    const double c00 = a11 * a22 - a12 * a12;
+    const double c01 = a02 * a12 - a01 * a22;
+    const double c02 = a01 * a12 - a02 * a11;
+    const double determinant = a00 * c00 + a01 * c01 + a02 * c02;
+    const double scale = std::abs(a00) + std::abs(a11) + std::abs(a22);
+
+    Collapse collapse{ 0.0, u, v, m_VertexVersion[u], m_VertexVersion[v], {} };
+    if (std::abs(determinant) > 1e-12 * scale * scale * scale && scale > 0.0)
+    {
+      const double c11 = a00 * a22 - a02 * a02;
+      const double c12 = a01 * a02 - a00 * a12;
+      const double c22 = a00 * a11 - a01 * a01;
+      collapse.position = { (c00 * b0 + c01 * b1 + c02 * b2) / determinant,
+                            (c01 * b0 + c11 * b1 + c12 * b2) / determinant,
+                            (c02 * b0 + c12 * b1 + c22 * b2) / determinant };
+      collapse.cost = quadric.Error(collapse.position);
+    }
+    else
+    {
+      // Singular, e.g. a flat region: the best of the endpoints and midpoint
+      const Position & pu = m_Positions[u];
+      const Position & pv = m_Positions[v];
+      const Position midpoint{ 0.5 * (pu[0] + pv[0]), 0.5 * (pu[1] + pv[1]), 0.5 * (pu[2] + pv[2]) };
+      collapse.position = midpoint;
+      collapse.cost = quadric.Error(midpoint);
+      for (const Position & candidate : { pu, pv })
+      {
+        const double cost = quadric.Error(candidate);
+        if (cost < collapse.cost)
+        {
+          collapse.cost = cost;
+          collapse.position = candidate;
+        }
+      }
+    }
+    collapse.cost = std::max(0.0, collapse.cost);
+    return collapse;
+  }
+
+  bool
+  IsCurrent(const Collapse & collapse) const
+  {
+    return m_VertexAlive[collapse.u] && m_VertexAlive[collapse.v] && m_VertexVersion[collapse.u] == collapse.versionU &&
+           m_VertexVersion[collapse.v] == collapse.versionV;
+  }
+
+  // The collapse keeps the surface manifold, i.e. the endpoints share only
+  // the vertices opposite the edge, and flips no triangle
+  bool
+  IsValid(const Collapse & collapse) const
+  {
+    const std::vector<uint32_t> neighborsU = this->Neighbors(collapse.u);
+    const std::vector<uint32_t> neighborsV = this->Neighbors(collapse.v);
+    std::vector<uint32_t> shared;
+    std::set_intersection(
+      neighborsU.begin(), neighborsU.end(), neighborsV.begin(), neighborsV.end(), std::back_inserter(shared));
+    const size_t edgeTriangles = this->NumberOfEdgeTriangles(collapse.u, collapse.v);
+    if (edgeTriangles == 0 || shared.size() != edgeTriangles)
+    {
+      return false;
+    }
+
+    for (uint32_t endpoint : { collapse.u, collapse.v })
+    {
+      const uint32_t other = endpoint == collapse.u ? collapse.v : collapse.u;
+      for (uint32_t triangle : m_VertexTriangles[endpoint])
+      {
+        const Triangle & vertices = m_Triangles[triangle];
+        if (vertices[0] == other || vertices[1] == other || vertices[2] == other)
+        {
+          continue;
+        }
+        std::array<Position, 3> moved{ m_Positions[vertices[0]], m_Positions[vertices[1]], m_Positions[vertices[2]] };
+        for (unsigned int ii = 0; ii < 3; ++ii)
+        {
+          if (vertices[ii] == endpoint)
+          {
+            moved[ii] = collapse.position;
+          }
+        }
+        const Position before = Normal(m_Positions[vertices[0]], m_Positions[vertices[1]], m_Positions[vertices[2]]);
+        const Position after = Normal(moved[0], moved[1], moved[2]);
+        if (Dot(before, after) <= 0.0)
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  // Merge the collapsed edge into the endpoint closest to the new position,
+  // whose point data the vertex keeps. Returns the removed triangles.
+  size_t
+  Apply(const Collapse & collapse)
+  {
+    const double distanceU = Dot(Subtract(m_Positions[collapse.u], collapse.position),
+                                 Subtract(m_Positions[collapse.u], collapse.position));
+    const double distanceV = Dot(Subtract(m_Positions[collapse.v], collapse.position),
+                                 Subtract(m_Positions[collapse.v], collapse.position));
+    const uint32_t kept = distanceU <= distanceV ? collapse.u : collapse.v;
+    const uint32_t removed = kept == collapse.u ? collapse.v : collapse.u;
+
+    m_Positions[kept] = collapse.position;
+    m_Quadrics[kept] += m_Quadrics[removed];
+
+    size_t removedTriangles = 0;
+    for (uint32_t triangle : m_VertexTriangles[removed])
+    {
+      Triangle & vertices = m_Triangles[triangle];
+      if (vertices[0] == kept || vertices[1] == kept || vertices[2] == kept)
+      {
+        m_TriangleAlive[triangle] = 0;
+        ++removedTriangles;
+        for (uint32_t other : vertices)
+        {
+          if (other != removed)
+          {
+            auto & triangles = m_VertexTriangles[other];
+            triangles.erase(std::find(triangles.begin(), triangles.end(), triangle));
+          }
+        }
+      }
+      else
+      {
+        std::replace(vertices.begin(), vertices.end(), removed, kept);
+        m_VertexTriangles[kept].push_back(triangle);
+      }
+    }
+    m_VertexTriangles[removed].clear();
+    m_VertexTriangles[removed].shrink_to_fit();
+    m_VertexAlive[removed] = 0;
+    ++m_VertexVersion[kept];
+
+    for (uint32_t neighbor : this->Neighbors(kept))
+    {
+      const uint32_t a = std::min(kept, neighbor);
+      const uint32_t b = std::max(kept, neighbor);
+      m_Queues[this->Owner(a, b)].push(this->ComputeCollapse(a, b));
+    }
+    return removedTriangles;
+  }
+
+  // Each partition removes its share of the triangles to remove, from the
+  // triangles whose vertices are all in the partition
+  template <typename TParallelize>
+  void
+  DecimatePartitions(size_t target, TParallelize && parallelize)
+  {
+    if (m_NumberOfPartitions < 2)
+    {
+      return;
+    }
+    this->ComputeLocks();
+    std::vector<size_t> owned(m_NumberOfPartitions, 0);
+    this->ForEachTriangle([&](uint32_t, const Triangle & vertices) {
+      const unsigned int partition = m_VertexPartition[vertices[0]];
+      if (m_VertexPartition[vertices[1]] == partition && m_VertexPartition[vertices[2]] == partition)
+      {
+        ++owned[partition];
+      }
+    });
+    const double removedFraction = 1.0 - static_cast<double>(target) / static_cast<double>(m_NumberOfTriangles);
+
+    std::vector<size_t> removed(m_NumberOfPartitions, 0);
+    std::vector<std::vector<Collapse>> deferred(m_NumberOfPartitions);
+    parallelize(m_NumberOfPartitions, [&](size_t partition) {
+      const size_t share = static_cast<size_t>(std::floor(removedFraction * static_cast<double>(owned[partition])));
+      CollapseQueue & queue = m_Queues[partition];
+      while (removed[partition] + 2 <= share && !queue.empty())
+      {
+        const Collapse collapse = queue.top();
+        queue.pop();
+        if (!this->IsCurrent(collapse))
+        {
+          continue;
+        }
+        if (m_VertexLocked[collapse.u] || m_VertexLocked[collapse.v])
+        {
+          // Collapsed serially
+          deferred[partition].push_back(collapse);
+          continue;
+        }
+        if (this->IsValid(collapse))
+        {
+          removed[partition] += this->Apply(collapse);
+        }
+      }
+    });
+
+    for (unsigned int partition = 0; partition < m_NumberOfPartitions; ++partition)
+    {
+      m_NumberOfTriangles -= removed[partition];
+      for (const Collapse & collapse : deferred[partition])
+      {
+        m_Queues[partition].push(collapse);
+      }
+    }
+  }
+
+  void
+  DecimateSerially(size_t target)
+  {
+    while (m_NumberOfTriangles > target)
+    {
+      CollapseQueue * lowest = nullptr;
+      for (CollapseQueue & queue : m_Queues)
+      {
+        if (!queue.empty() && (lowest == nullptr || CollapseGreater{}(lowest->top(), queue.top())))
+        {
+          lowest = &queue;
+        }
+      }
+      if (lowest == nullptr)
+      {
+        break;
+      }
+      const Collapse collapse = lowest->top();
+      lowest->pop();
+      if (this->IsCurrent(collapse) && this->IsValid(collapse))
+      {
+        m_NumberOfTriangles -= this->Apply(collapse);
+      }
+    }
+  }
+
+  std::vector<Position>              m_Positions;
+  std::vector<Triangle>              m_Triangles;
+  unsigned int                       m_NumberOfPartitions;
+  std::vector<Quadric>               m_Quadrics;
+  std::vector<uint32_t>              m_VertexVersion;
+  std::vector<uint8_t>               m_VertexAlive;
+  std::vector<uint8_t>               m_VertexLocked;
+  std::vector<unsigned int>          m_VertexPartition;
+  std::vector<std::vector<uint32_t>> m_VertexTriangles;
+  std::vector<uint8_t>               m_TriangleAlive;
+  size_t                             m_NumberOfTriangles{ 0 };
+  std::vector<CollapseQueue>         m_Queues;
+};
+
+#endif // meshFiltersQuadricDecimation_h
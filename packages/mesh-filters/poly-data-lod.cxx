@@ -0,0 +1,279 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkInputPolyData.h"
+#include "itkOutputPolyData.h"
+#include "itkSupportInputPolyDataTypes.h"
+
+#include "itkMultiThreaderBase.h"
+
+#include "meshFiltersQuadricDecimation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Triangles of the polygons and triangle strips of a polydata, with the index
+// of the cell each comes from, in the vertices, lines, polygons, strips order
+// of the cell data
+template <typename TPolyData>
+void
+polyDataTriangles(const TPolyData *                          polyData,
+                  std::vector<QuadricDecimation::Triangle> & triangles,
+                  std::vector<size_t> &                      triangleCells)
+{
+  size_t cell = 0;
+  for (const auto * cells : { polyData->GetVertices(), polyData->GetLines() })
+  {
+    for (size_t ii = 0; cells != nullptr && ii < cells->Size(); ii += cells->at(ii) + 1)
+    {
+      ++cell;
+    }
+  }
+
+  auto addTriangle = [&](uint32_t a, uint32_t b, uint32_t c) {
+    if (a != b && b != c && a != c)
+    {
+      triangles.push_back({ a, b, c });
+      triangleCells.push_back(cell);
+    }
+  };
+  const auto * polygons = polyData->GetPolygons();
+  for (size_t ii = 0; polygons != nullptr && ii < polygons->Size(); ii += polygons->at(ii) + 1, ++cell)
+  {
+    // Fan triangulation
+    const size_t numberOfPoints = polygons->at(ii);
+    for (size_t jj = 2; jj < numberOfPoints; ++jj)
+    {
+      addTriangle(polygons->at(ii + 1), polygons->at(ii + jj), polygons->at(ii + jj + 1));
+    }
+  }
+  const auto * strips = polyData->GetTriangleStrips();
+  for (size_t ii = 0; strips != nullptr && ii < strips->Size(); ii += strips->at(ii) + 1, ++cell)
+  {
+    // Every other triangle of a strip is reversed to keep the orientation
+    const size_t numberOfPoints = strips->at(ii);
+    for (size_t jj = 2; jj < numberOfPoints; ++jj)
+    {
+      const uint32_t a = strips->at(ii + jj - 1);
+      const uint32_t b = strips->at(ii + jj);
+      const uint32_t c = strips->at(ii + jj + 1);
+      if (jj % 2 == 0)
+      {
+        addTriangle(a, b, c);
+      }
+      else
+      {
+        addTriangle(b, a, c);
+      }
+    }
+  }
+}
+
+template <typename TPolyData>
+class PipelineFunctor
+{
+public:
+  int
+  operator()(itk::wasm::Pipeline & pipeline)
+  {
+    using PolyDataType = TPolyData;
+
+    using InputPolyDataType = itk::wasm::InputPolyData<PolyDataType>;
+    InputPolyDataType inputPolyData;
+    pipeline.add_option("input-poly-data", inputPolyData, "Input polydata")->required()->type_name("INPUT_POLYDATA");
+
+    using OutputPolyDataType = itk::wasm::OutputPolyData<PolyDataType>;
+    std::vector<OutputPolyDataType> outputPolyData;
+    pipeline
+      .add_option("output-poly-data", outputPolyData, "Levels of detail, from the finest to the coarsest, as triangle polygons")
+      ->required()
+      ->expected(1, -1)
+      ->type_name("OUTPUT_POLYDATA");
+
+    std::vector<double> targetFractions;
+    pipeline
+      .add_option("--target-fractions",
+                  targetFractions,
+                  "Fraction of the input triangles kept in each level of detail. Default: 1/2, 1/4, 1/8, ...")
+      ->expected(1, -1);
+
+    std::vector<uint64_t> targetTriangles;
+    pipeline
+      .add_option("--target-triangles",
+                  targetTriangles,
+                  "Number of triangles of each level of detail. Overrides --target-fractions.")
+      ->expected(1, -1);
+
+    unsigned int partitions = 16;
+    pipeline.add_option(
+      "--partitions",
+      partitions,
+      "Spatial partitions decimated concurrently. The levels depend on the number of partitions, not on the number of threads.");
+
+    ITK_WASM_PARSE(pipeline);
+
+    const PolyDataType * polyData = inputPolyData.Get();
+
+    std::vector<QuadricDecimation::Triangle> triangles;
+    std::vector<size_t>                      triangleCells;
+    polyDataTriangles(polyData, triangles, triangleCells);
+
+    const size_t numberOfLevels = outputPolyData.size();
+    std::vector<size_t> targets(numberOfLevels);
+    if (!targetTriangles.empty())
+    {
+      if (targetTriangles.size() != numberOfLevels)
+      {
+        CLI::Error err("Runtime error", "--target-triangles must have a count for each output-poly-data level", 1);
+        return pipeline.exit(err);
+      }
+      std::copy(targetTriangles.begin(), targetTriangles.end(), targets.begin());
+    }
+    else
+    {
+      if (targetFractions.empty())
+      {
+        for (size_t level = 0; level < numberOfLevels; ++level)
+        {
+          targetFractions.push_back(std::ldexp(1.0, -static_cast<int>(level + 1)));
+        }
+      }
+      if (targetFractions.size() != numberOfLevels)
+      {
+        CLI::Error err("Runtime error", "--target-fractions must have a fraction for each output-poly-data level", 1);
+        return pipeline.exit(err);
+      }
+      for (size_t level = 0; level < numberOfLevels; ++level)
+      {
+        targets[level] = static_cast<size_t>(std::llround(targetFractions[level] * triangles.size()));
+      }
+    }
+    for (size_t level = 1; level < numberOfLevels; ++level)
+    {
+      if (targets[level] > targets[level - 1])
+      {
+        CLI::Error err("Runtime error", "The levels of detail must have a decreasing number of triangles", 1);
+        return pipeline.exit(err);
+      }
+    }
+
+    const auto * points = polyData->GetPoints();
+    std::vector<QuadricDecimation::Position> positions(polyData->GetNumberOfPoints());
+    for (size_t ii = 0; ii < positions.size(); ++ii)
+    {
+      const auto & point = points->at(ii);
+      positions[ii] = { point[0], point[1], point[2] };
+    }
+
+    const auto * pointData = polyData->GetPointData();
+    const bool   hasPointData = pointData != nullptr && pointData->Size() == positions.size();
+    size_t       numberOfCells = 0;
+    for (const auto * cells : { polyData->GetVertices(), polyData->GetLines(), polyData->GetPolygons(), polyData->GetTriangleStrips() })
+    {
+      for (size_t ii = 0; cells != nullptr && ii < cells->Size(); ii += cells->at(ii) + 1)
+      {
+        ++numberOfCells;
+      }
+    }
+    const auto * cellData = polyData->GetCellData();
+    const bool   hasCellData = cellData != nullptr && cellData->Size() == numberOfCells && numberOfCells > 0;
+
+    QuadricDecimation decimation(std::move(positions), std::move(triangles), partitions);
+    auto parallelize = [](size_t count, const auto & work) {
+      itk::MultiThreaderBase::New()->ParallelizeArray(0, count, [&work](itk::SizeValueType partition) { work(partition); }, nullptr);
+    };
+    decimation.Run(targets, parallelize, [&](size_t level) {
+      // The vertices of the remaining triangles, in input order
+      const auto & decimatedPositions = decimation.GetPositions();
+      std::vector<uint32_t> pointIds(decimatedPositions.size(), 0);
+      decimation.ForEachTriangle([&pointIds](uint32_t, const QuadricDecimation::Triangle & vertices) {
+        for (uint32_t vertex : vertices)
+        {
+          pointIds[vertex] = 1;
+        }
+      });
+
+      auto lod = PolyDataType::New();
+      auto & lodPoints = *lod->GetPoints();
+      if (hasPointData)
+      {
+        lod->SetPointData(PolyDataType::PointDataContainer::New());
+      }
+      uint32_t numberOfPoints = 0;
+      for (size_t vertex = 0; vertex < pointIds.size(); ++vertex)
+      {
+        if (pointIds[vertex])
+        {
+          pointIds[vertex] = numberOfPoints++;
+          typename PolyDataType::PointType point;
+          for (unsigned int dim = 0; dim < 3; ++dim)
+          {
+            point[dim] = decimatedPositions[vertex][dim];
+          }
+          lodPoints.push_back(point);
+          if (hasPointData)
+          {
+            lod->GetPointData()->push_back(pointData->at(vertex));
+          }
+        }
+      }
+
+      auto & lodPolygons = *lod->GetPolygons();
+      lodPolygons.reserve(4 * decimation.GetNumberOfTriangles());
+      if (hasCellData)
+      {
+        lod->SetCellData(PolyDataType::CellDataContainer::New());
+        lod->GetCellData()->reserve(decimation.GetNumberOfTriangles());
+      }
+      decimation.ForEachTriangle([&](uint32_t triangle, const QuadricDecimation::Triangle & vertices) {
+        lodPolygons.push_back(3);
+        for (uint32_t vertex : vertices)
+        {
+          lodPolygons.push_back(pointIds[vertex]);
+        }
+        if (hasCellData)
+        {
+          lod->GetCellData()->push_back(cellData->at(triangleCells[triangle]));
+        }
+      });
+
+      outputPolyData[level].Set(lod);
+    });
+
+    return EXIT_SUCCESS;
+  }
+};
+
+int
+main(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("poly-data-lod",
+                               "Generate levels of detail of a polydata surface by quadric error decimation",
+                               argc,
+                               argv);
+
+  return itk::wasm::SupportInputPolyDataTypes<PipelineFunctor>::PixelTypes<uint8_t,
+                                                                           int8_t,
+                                                                           uint16_t,
+                                                                           int16_t,
+                                                                           uint32_t,
+                                                                           int32_t,
+                                                                           float,
+                                                                           double>("input-poly-data", pipeline);
+}
@@ -5,7 +5,12 @@ option(ZSTD_BUILD_SHARED "BUILD_SHARED" OFF)
 option(ZSTD_BUILD_STATIC "BUILD_STATIC" ON)
 option(ZSTD_BUILD_TESTS "BUILD_TESTS" OFF)
 option(ZSTD_BUILD_LEGACY_SUPPORT "BUILD_LEGACY_SUPPORT" OFF)
-option(ZSTD_MULTITHREAD_SUPPORT "BUILD_MULTITHREAD_SUPPORT" OFF)
+# Parallel compression with ZSTD_c_nbWorkers in native and threaded wasm builds
+if(ITK_WASM_THREADS OR NOT (EMSCRIPTEN OR WASI))
+  option(ZSTD_MULTITHREAD_SUPPORT "BUILD_MULTITHREAD_SUPPORT" ON)
+else()
+  option(ZSTD_MULTITHREAD_SUPPORT "BUILD_MULTITHREAD_SUPPORT" OFF)
+endif()
 option(ZSTD_BUILD_PROGRAMS_LINK_SHARED "BUILD_PROGRAMS_LINK_SHARED" OFF)
 option(ZSTD_BUILD_LZ4 "BUILD_LZ4" OFF)
 option(ZSTD_BUILD_LZMA "BUILD_LZMA" OFF)
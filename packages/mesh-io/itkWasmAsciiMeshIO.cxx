@@ -0,0 +1,660 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmAsciiMeshIO.h"
+
+#include "itkCommonEnums.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <functional>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+
+// Chunks of about a megabyte are parsed in parallel
+constexpr size_t ChunkSize = 1 << 20;
+
+struct Range
+{
+  const char * begin;
+  const char * end;
+};
+
+bool
+IsSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+bool
+IsWhitespace(char c)
+{
+  return IsSpace(c) || c == '\n';
+}
+
+const char *
+SkipSpace(const char * p, const char * end)
+{
+  while (p < end && IsSpace(*p))
+  {
+    ++p;
+  }
+  return p;
+}
+
+const char *
+SkipWhitespace(const char * p, const char * end)
+{
+  while (p < end && IsWhitespace(*p))
+  {
+    ++p;
+  }
+  return p;
+}
+
+const char *
+SkipToken(const char * p, const char * end)
+{
+  while (p < end && !IsWhitespace(*p))
+  {
+    ++p;
+  }
+  return p;
+}
+
+// The start of the next line
+const char *
+NextLine(const char * p, const char * end)
+{
+  const auto * newline = static_cast<const char *>(std::memchr(p, '\n', end - p));
+  return newline == nullptr ? end : newline + 1;
+}
+
+template <typename T>
+bool
+ParseValue(const char *& p, const char * end, T & value)
+{
+  if (p < end && *p == '+')
+  {
+    ++p;
+  }
+  const std::from_chars_result result = std::from_chars(p, end, value);
+  if (result.ec != std::errc())
+  {
+    return false;
+  }
+  p = result.ptr;
+  return true;
+}
+
+// Split the range in chunks that end at line ends
+std::vector<Range>
+SplitLines(const char * begin, const char * end)
+{
+  const size_t count = std::clamp<size_t>((end - begin) / ChunkSize, 1, 16 * MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  std::vector<Range> chunks;
+  const char * start = begin;
+  for (size_t ii = 1; ii <= count && start < end; ++ii)
+  {
+    const char * stop = ii == count ? end : std::max(start, begin + (end - begin) * ii / count);
+    stop = stop == end ? end : NextLine(stop, end);
+    chunks.push_back({ start, stop });
+    start = stop;
+  }
+  return chunks;
+}
+
+// Run function for each chunk with the global default number of threads.
+// Returns false if it returned false for any chunk.
+bool
+ParallelizeChunks(const std::vector<Range> & chunks, const std::function<bool(size_t)> & function)
+{
+  std::vector<char> succeeded(chunks.size(), 0);
+  MultiThreaderBase::New()->ParallelizeArray(
+    0, chunks.size(), [&](SizeValueType chunk) { succeeded[chunk] = function(chunk); }, nullptr);
+  return std::all_of(succeeded.begin(), succeeded.end(), [](char chunkSucceeded) { return chunkSucceeded != 0; });
+}
+
+// Offsets of each chunk from their counts, and the total count
+template <typename TCount>
+TCount
+ExclusiveScan(std::vector<TCount> & counts)
+{
+  TCount total = 0;
+  for (TCount & count : counts)
+  {
+    const TCount chunkCount = count;
+    count = total;
+    total += chunkCount;
+  }
+  return total;
+}
+
+// Parse the count whitespace separated numbers of the range into values
+template <typename T>
+bool
+ParseNumbers(const char * begin, const char * end, size_t count, T * values)
+{
+  const std::vector<Range> chunks = SplitLines(begin, end);
+  std::vector<size_t> offsets(chunks.size(), 0);
+  ParallelizeChunks(chunks, [&](size_t chunk) {
+    size_t tokens = 0;
+    for (const char * p = SkipWhitespace(chunks[chunk].begin, chunks[chunk].end); p < chunks[chunk].end;
+         p = SkipWhitespace(SkipToken(p, chunks[chunk].end), chunks[chunk].end))
+    {
+      ++tokens;
+    }
+    offsets[chunk] = tokens;
+    return true;
+  });
+  if (ExclusiveScan(offsets) != count)
+  {
+    return false;
+  }
+  return ParallelizeChunks(chunks, [&](size_t chunk) {
+    T * value = values + offsets[chunk];
+    const char * p = SkipWhitespace(chunks[chunk].begin, chunks[chunk].end);
+    while (p < chunks[chunk].end)
+    {
+      if (!ParseValue(p, chunks[chunk].end, *value++) || (p < chunks[chunk].end && !IsWhitespace(*p)))
+      {
+        return false;
+      }
+      p = SkipWhitespace(p, chunks[chunk].end);
+    }
+    return true;
+  });
+}
+
+bool
+ReadFile(const std::string & fileName, std::string & contents)
+{
+  FILE * file = fopen(fileName.c_str(), "rb");
+  if (file == nullptr)
+  {
+    return false;
+  }
+  bool succeeded = fseek(file, 0, SEEK_END) == 0;
+  const long size = succeeded ? ftell(file) : -1;
+  succeeded = size >= 0 && fseek(file, 0, SEEK_SET) == 0;
+  if (succeeded)
+  {
+    contents.resize(static_cast<size_t>(size));
+    succeeded = fread(contents.data(), 1, contents.size(), file) == contents.size();
+  }
+  fclose(file);
+  return succeeded;
+}
+
+void
+AllocatePoints(AsciiMesh & mesh, IOComponentEnum componentType, SizeValueType numberOfPoints)
+{
+  mesh.pointComponentType = componentType;
+  mesh.numberOfPoints = numberOfPoints;
+  const size_t componentSize = componentType == IOComponentEnum::DOUBLE ? sizeof(double) : sizeof(float);
+  mesh.points.reset(new char[numberOfPoints * 3 * componentSize]);
+}
+
+// v, vn, and f lines. Face vertices are v, v/vt, v//vn, or v/vt/vn with
+// positive indices; other lines, e.g. vt, g, and usemtl, are skipped.
+bool
+ReadOBJ(const std::string & contents, AsciiMesh & mesh)
+{
+  const char * const begin = contents.data();
+  const char * const end = begin + contents.size();
+  const std::vector<Range> chunks = SplitLines(begin, end);
+
+  enum LineType
+  {
+    Vertex,
+    Normal,
+    Face,
+    Other
+  };
+  const auto lineType = [](const char *& p, const char * lineEnd) {
+    p = SkipSpace(p, lineEnd);
+    if (p + 1 < lineEnd && p[0] == 'v' && IsSpace(p[1]))
+    {
+      p += 2;
+      return Vertex;
+    }
+    if (p + 2 < lineEnd && p[0] == 'v' && p[1] == 'n' && IsSpace(p[2]))
+    {
+      p += 3;
+      return Normal;
+    }
+    if (p + 1 < lineEnd && p[0] == 'f' && IsSpace(p[1]))
+    {
+      p += 2;
+      return Face;
+    }
+    return Other;
+  };
+
+  std::vector<SizeValueType> points(chunks.size(), 0);
+  std::vector<SizeValueType> normals(chunks.size(), 0);
+  std::vector<SizeValueType> faces(chunks.size(), 0);
+  std::vector<SizeValueType> cellBuffer(chunks.size(), 0);
+  ParallelizeChunks(chunks, [&](size_t chunk) {
+    for (const char * line = chunks[chunk].begin; line < chunks[chunk].end;)
+    {
+      const char * lineEnd = NextLine(line, chunks[chunk].end);
+      const char * p = line;
+      switch (lineType(p, lineEnd))
+      {
+        case Vertex:
+          ++points[chunk];
+          break;
+        case Normal:
+          ++normals[chunk];
+          break;
+        case Face:
+          ++faces[chunk];
+          cellBuffer[chunk] += 2;
+          for (p = SkipWhitespace(p, lineEnd); p < lineEnd; p = SkipWhitespace(SkipToken(p, lineEnd), lineEnd))
+          {
+            ++cellBuffer[chunk];
+          }
+          break;
+        case Other:
+          break;
+      }
+      line = lineEnd;
+    }
+    return true;
+  });
+  const SizeValueType numberOfPoints = ExclusiveScan(points);
+  const SizeValueType numberOfNormals = ExclusiveScan(normals);
+  if (numberOfNormals != 0 && numberOfNormals != numberOfPoints)
+  {
+    return false;
+  }
+  AllocatePoints(mesh, IOComponentEnum::FLOAT, numberOfPoints);
+  mesh.numberOfPointPixels = numberOfNormals;
+  mesh.pointData.reset(new float[numberOfNormals * 3]);
+  mesh.numberOfCells = ExclusiveScan(faces);
+  mesh.cellBufferSize = ExclusiveScan(cellBuffer);
+  mesh.cells.reset(new uint32_t[mesh.cellBufferSize]);
+
+  const auto parseVector = [](const char *& p, const char * lineEnd, float *& values) {
+    for (unsigned int component = 0; component < 3; ++component)
+    {
+      p = SkipSpace(p, lineEnd);
+      if (!ParseValue(p, lineEnd, *values++))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+  auto * pointsBuffer = reinterpret_cast<float *>(mesh.points.get());
+  return ParallelizeChunks(chunks, [&](size_t chunk) {
+    float * point = pointsBuffer + 3 * points[chunk];
+    float * normal = mesh.pointData.get() + 3 * normals[chunk];
+    uint32_t * cell = mesh.cells.get() + cellBuffer[chunk];
+    for (const char * line = chunks[chunk].begin; line < chunks[chunk].end;)
+    {
+      const char * lineEnd = NextLine(line, chunks[chunk].end);
+      const char * p = line;
+      switch (lineType(p, lineEnd))
+      {
+        case Vertex:
+          if (!parseVector(p, lineEnd, point))
+          {
+            return false;
+          }
+          break;
+        case Normal:
+          if (!parseVector(p, lineEnd, normal))
+          {
+            return false;
+          }
+          break;
+        case Face:
+        {
+          uint32_t * header = cell;
+          cell += 2;
+          header[0] = static_cast<uint32_t>(CellGeometryEnum::POLYGON_CELL);
+          for (p = SkipWhitespace(p, lineEnd); p < lineEnd; p = SkipWhitespace(SkipToken(p, lineEnd), lineEnd))
+          {
+            uint64_t index = 0;
+            if (!ParseValue(p, lineEnd, index) || index == 0 || index > numberOfPoints)
+            {
+              return false;
+            }
+            *cell++ = static_cast<uint32_t>(index - 1);
+          }
+          header[1] = static_cast<uint32_t>(cell - header - 2);
+          break;
+        }
+        case Other:
+          break;
+      }
+      line = lineEnd;
+    }
+    return true;
+  });
+}
+
+// The next line other than a blank or # comment line
+const char *
+NextDataLine(const char * p, const char * end)
+{
+  while (p < end)
+  {
+    const char * token = SkipSpace(p, end);
+    if (token < end && *token != '\n' && *token != '#')
+    {
+      return p;
+    }
+    p = NextLine(p, end);
+  }
+  return end;
+}
+
+// OFF files with a vertex of 3 coordinates per line and faces of a count
+// and point ids per line, whose trailing colors are skipped
+bool
+ReadOFF(const std::string & contents, AsciiMesh & mesh)
+{
+  const char * const end = contents.data() + contents.size();
+  const char * p = SkipWhitespace(NextDataLine(contents.data(), end), end);
+  if (end - p < 3 || std::string_view(p, 3) != "OFF" || (p + 3 < end && !IsWhitespace(p[3])))
+  {
+    return false;
+  }
+  p = NextDataLine(SkipWhitespace(p + 3, end), end);
+  uint64_t counts[3];
+  for (uint64_t & count : counts)
+  {
+    p = SkipSpace(p, end);
+    if (!ParseValue(p, end, count))
+    {
+      return false;
+    }
+  }
+  const SizeValueType numberOfPoints = counts[0];
+  mesh.numberOfCells = counts[1];
+
+  // The vertex lines, found without parsing them
+  const char * const verticesBegin = NextDataLine(NextLine(p, end), end);
+  const char * verticesEnd = verticesBegin;
+  for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+  {
+    if (verticesEnd == end)
+    {
+      return false;
+    }
+    verticesEnd = NextDataLine(NextLine(verticesEnd, end), end);
+  }
+  AllocatePoints(mesh, IOComponentEnum::FLOAT, numberOfPoints);
+  if (!ParseNumbers(verticesBegin, verticesEnd, numberOfPoints * 3, reinterpret_cast<float *>(mesh.points.get())))
+  {
+    return false;
+  }
+
+  const std::vector<Range> chunks = SplitLines(verticesEnd, end);
+  std::vector<SizeValueType> faces(chunks.size(), 0);
+  std::vector<SizeValueType> cellBuffer(chunks.size(), 0);
+  const bool counted = ParallelizeChunks(chunks, [&](size_t chunk) {
+    for (const char * line = NextDataLine(chunks[chunk].begin, chunks[chunk].end); line < chunks[chunk].end;
+         line = NextDataLine(NextLine(line, chunks[chunk].end), chunks[chunk].end))
+    {
+      const char * q = SkipSpace(line, chunks[chunk].end);
+      uint64_t facePoints = 0;
+      if (!ParseValue(q, chunks[chunk].end, facePoints))
+      {
+        return false;
+      }
+      ++faces[chunk];
+      cellBuffer[chunk] += 2 + facePoints;
+    }
+    return true;
+  });
+  if (!counted || ExclusiveScan(faces) != mesh.numberOfCells)
+  {
+    return false;
+  }
+  mesh.cellBufferSize = ExclusiveScan(cellBuffer);
+  mesh.cells.reset(new uint32_t[mesh.cellBufferSize]);
+  return ParallelizeChunks(chunks, [&](size_t chunk) {
+    uint32_t * cell = mesh.cells.get() + cellBuffer[chunk];
+    for (const char * line = NextDataLine(chunks[chunk].begin, chunks[chunk].end); line < chunks[chunk].end;
+         line = NextDataLine(NextLine(line, chunks[chunk].end), chunks[chunk].end))
+    {
+      const char * lineEnd = NextLine(line, chunks[chunk].end);
+      const char * q = SkipSpace(line, lineEnd);
+      uint32_t facePoints = 0;
+      ParseValue(q, lineEnd, facePoints);
+      *cell++ = static_cast<uint32_t>(CellGeometryEnum::POLYGON_CELL);
+      *cell++ = facePoints;
+      for (uint32_t ii = 0; ii < facePoints; ++ii)
+      {
+        q = SkipSpace(q, lineEnd);
+        if (!ParseValue(q, lineEnd, *cell) || *cell >= numberOfPoints)
+        {
+          return false;
+        }
+        ++cell;
+      }
+    }
+    return true;
+  });
+}
+
+// The keyword line at p, and the start of the line after it
+std::string_view
+ReadLine(const char *& p, const char * end)
+{
+  const char * lineEnd = NextLine(p, end);
+  std::string_view line(p, lineEnd - p);
+  while (!line.empty() && IsWhitespace(line.back()))
+  {
+    line.remove_suffix(1);
+  }
+  p = lineEnd;
+  return line;
+}
+
+// The section of the numbers after a keyword line, up to the next line that
+// starts with a letter
+const char *
+SectionEnd(const char * p, const char * end)
+{
+  while (p < end)
+  {
+    const char * token = SkipSpace(p, end);
+    if (token < end && ((*token >= 'A' && *token <= 'Z') || (*token >= 'a' && *token <= 'z')))
+    {
+      return p;
+    }
+    p = NextLine(p, end);
+  }
+  return end;
+}
+
+// Legacy ASCII POLYDATA with POINTS, VERTICES, LINES, and POLYGONS sections
+bool
+ReadVTK(const std::string & contents, AsciiMesh & mesh)
+{
+  const char * const end = contents.data() + contents.size();
+  const char * p = contents.data();
+  const std::string_view version = ReadLine(p, end);
+  if (version.substr(0, 22) != "# vtk DataFile Version")
+  {
+    return false;
+  }
+  ReadLine(p, end);
+  if (ReadLine(p, end) != "ASCII")
+  {
+    return false;
+  }
+  p = NextDataLine(p, end);
+  if (ReadLine(p, end) != "DATASET POLYDATA")
+  {
+    return false;
+  }
+
+  std::vector<uint32_t> cells;
+  std::vector<uint32_t> sectionCells;
+  while ((p = NextDataLine(p, end)) < end)
+  {
+    char keyword[32] = {};
+    char type[32] = {};
+    unsigned long long count = 0;
+    unsigned long long size = 0;
+    const std::string line(ReadLine(p, end));
+    if (line == "METADATA")
+    {
+      // Array information, up to a blank line
+      while (p < end && SkipSpace(p, end) < end && *SkipSpace(p, end) != '\n')
+      {
+        p = NextLine(p, end);
+      }
+      continue;
+    }
+    if (std::sscanf(line.c_str(), "%31s %llu %31s", keyword, &count, type) == 3 && std::string_view(keyword) == "POINTS")
+    {
+      const std::string_view pointType(type);
+      if (mesh.points || (pointType != "float" && pointType != "double"))
+      {
+        return false;
+      }
+      const char * sectionEnd = SectionEnd(p, end);
+      AllocatePoints(mesh, pointType == "double" ? IOComponentEnum::DOUBLE : IOComponentEnum::FLOAT, count);
+      const bool parsed = pointType == "double"
+                            ? ParseNumbers(p, sectionEnd, count * 3, reinterpret_cast<double *>(mesh.points.get()))
+                            : ParseNumbers(p, sectionEnd, count * 3, reinterpret_cast<float *>(mesh.points.get()));
+      if (!parsed)
+      {
+        return false;
+      }
+      p = sectionEnd;
+      continue;
+    }
+    if (std::sscanf(line.c_str(), "%15s %llu %llu", keyword, &count, &size) != 3)
+    {
+      return false;
+    }
+    const std::string_view section(keyword);
+    if (section != "VERTICES" && section != "LINES" && section != "POLYGONS")
+    {
+      // Triangle strips, point or cell data, and VTK 5 OFFSETS
+      // CONNECTIVITY cells are read by the ITK mesh IO
+      return false;
+    }
+    const char * sectionEnd = SectionEnd(p, end);
+    sectionCells.resize(size);
+    if (!ParseNumbers(p, sectionEnd, size, sectionCells.data()))
+    {
+      return false;
+    }
+    p = sectionEnd;
+
+    // [number of points, point ids...] to [cell type, number of points,
+    // point ids...]
+    const size_t offset = cells.size();
+    cells.resize(offset + size + count);
+    uint32_t * cell = cells.data() + offset;
+    size_t index = 0;
+    for (unsigned long long ii = 0; ii < count; ++ii)
+    {
+      if (index >= size || index + sectionCells[index] >= size)
+      {
+        return false;
+      }
+      const uint32_t cellPoints = sectionCells[index++];
+      CellGeometryEnum cellType = CellGeometryEnum::POLYGON_CELL;
+      if (section == "VERTICES")
+      {
+        cellType = CellGeometryEnum::VERTEX_CELL;
+      }
+      else if (section == "LINES")
+      {
+        cellType = cellPoints == 2 ? CellGeometryEnum::LINE_CELL : CellGeometryEnum::POLYLINE_CELL;
+      }
+      *cell++ = static_cast<uint32_t>(cellType);
+      *cell++ = cellPoints;
+      cell = std::copy_n(sectionCells.data() + index, cellPoints, cell);
+      index += cellPoints;
+    }
+    if (index != size)
+    {
+      return false;
+    }
+    mesh.numberOfCells += count;
+  }
+  if (!mesh.points)
+  {
+    return false;
+  }
+  for (size_t ii = 0; ii < cells.size(); ii += 2 + cells[ii + 1])
+  {
+    if (std::any_of(cells.data() + ii + 2, cells.data() + ii + 2 + cells[ii + 1], [&](uint32_t id) { return id >= mesh.numberOfPoints; }))
+    {
+      return false;
+    }
+  }
+  mesh.cellBufferSize = cells.size();
+  mesh.cells.reset(new uint32_t[cells.size()]);
+  std::copy(cells.begin(), cells.end(), mesh.cells.get());
+  return true;
+}
+
+} // end anonymous namespace
+
+bool
+ReadAsciiMesh(const std::string & fileName, AsciiMeshFormat format, AsciiMesh & mesh)
+{
+  std::string contents;
+  if (!ReadFile(fileName, contents))
+  {
+    return false;
+  }
+  bool parsed = false;
+  switch (format)
+  {
+    case AsciiMeshFormat::OBJ:
+      parsed = ReadOBJ(contents, mesh);
+      break;
+    case AsciiMeshFormat::OFF:
+      parsed = ReadOFF(contents, mesh);
+      break;
+    case AsciiMeshFormat::VTK:
+      parsed = ReadVTK(contents, mesh);
+      break;
+  }
+  if (!parsed)
+  {
+    mesh = AsciiMesh();
+  }
+  return parsed;
+}
+
+} // end namespace wasm
+} // end namespace itk
@@ -0,0 +1,188 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmAsciiMeshIO_h
+#define itkWasmAsciiMeshIO_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkMeshIOBase.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace itk
+{
+namespace wasm
+{
+
+enum class AsciiMeshFormat : uint8_t
+{
+  OBJ,
+  OFF,
+  VTK
+};
+
+/** Points, cells, and point data of an ASCII mesh file, in the layout of the
+ * MeshIOBase buffers: 3D points of the pointComponentType, and cells as
+ * [CellGeometryEnum, number of points, point ids...] of uint32. */
+struct AsciiMesh
+{
+  IOComponentEnum pointComponentType{ IOComponentEnum::FLOAT };
+  SizeValueType numberOfPoints{ 0 };
+  std::unique_ptr<char[]> points;
+  SizeValueType numberOfCells{ 0 };
+  SizeValueType cellBufferSize{ 0 };
+  std::unique_ptr<uint32_t[]> cells;
+  /** OBJ vertex normals, 3 float components per point. */
+  SizeValueType numberOfPointPixels{ 0 };
+  std::unique_ptr<float[]> pointData;
+};
+
+/** Parse an OBJ, OFF, or legacy ASCII VTK polydata file. The file is read
+ * at once and split in chunks at line boundaries, whose numbers are counted
+ * then parsed in parallel straight into their offset in the mesh buffers.
+ *
+ * Returns false if the file cannot be read, or if it uses a feature the
+ * parser does not support, e.g. a binary VTK file, VTK point or cell data,
+ * triangle strips, or relative OBJ indices, so the ITK mesh IO reads it. */
+WebAssemblyInterface_EXPORT bool
+ReadAsciiMesh(const std::string & fileName, AsciiMeshFormat format, AsciiMesh & mesh);
+
+} // end namespace wasm
+
+/** \class WasmAsciiMeshIO
+ *
+ * \brief Fast reader of the ASCII files of an ITK mesh IO.
+ *
+ * Reads OBJMeshIO, OFFMeshIO, or VTKPolyDataMeshIO files with
+ * wasm::ReadAsciiMesh instead of token by token with iostreams. Files it does
+ * not support, and writing, are handled by the TMeshIO superclass.
+ *
+ * \ingroup IOFilters
+ * \ingroup WebAssemblyInterface
+ */
+template <typename TMeshIO, wasm::AsciiMeshFormat VFormat>
+class WasmAsciiMeshIO : public TMeshIO
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(WasmAsciiMeshIO);
+
+  /** Standard class typedefs. */
+  typedef WasmAsciiMeshIO      Self;
+  typedef TMeshIO              Superclass;
+  typedef SmartPointer< Self > Pointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WasmAsciiMeshIO, TMeshIO);
+
+  void
+  ReadMeshInformation() override
+  {
+    this->m_Mesh = wasm::AsciiMesh();
+    this->m_Parsed = wasm::ReadAsciiMesh(this->GetFileName(), VFormat, this->m_Mesh);
+    if (!this->m_Parsed)
+    {
+      Superclass::ReadMeshInformation();
+      return;
+    }
+
+    this->m_FileType = IOFileEnum::ASCII;
+    this->m_PointDimension = 3;
+    this->m_NumberOfPoints = this->m_Mesh.numberOfPoints;
+    this->m_PointComponentType = this->m_Mesh.pointComponentType;
+    this->m_UpdatePoints = this->m_NumberOfPoints > 0;
+    this->m_NumberOfCells = this->m_Mesh.numberOfCells;
+    this->m_CellBufferSize = this->m_Mesh.cellBufferSize;
+    this->m_CellComponentType = IOComponentEnum::UINT;
+    this->m_UpdateCells = this->m_NumberOfCells > 0;
+    this->m_NumberOfPointPixels = this->m_Mesh.numberOfPointPixels;
+    this->m_UpdatePointData = this->m_NumberOfPointPixels > 0;
+    if (this->m_UpdatePointData)
+    {
+      this->m_PointPixelType = IOPixelEnum::VECTOR;
+      this->m_PointPixelComponentType = IOComponentEnum::FLOAT;
+      this->m_NumberOfPointPixelComponents = 3;
+    }
+    this->m_NumberOfCellPixels = 0;
+    this->m_UpdateCellData = false;
+  }
+
+  /** The buffers are released once they are read. */
+  void
+  ReadPoints(void * buffer) override
+  {
+    if (!this->m_Parsed)
+    {
+      Superclass::ReadPoints(buffer);
+      return;
+    }
+    const size_t componentSize = this->m_Mesh.pointComponentType == IOComponentEnum::DOUBLE ? sizeof(double) : sizeof(float);
+    std::memcpy(buffer, this->m_Mesh.points.get(), this->m_Mesh.numberOfPoints * 3 * componentSize);
+    this->m_Mesh.points.reset();
+  }
+
+  void
+  ReadCells(void * buffer) override
+  {
+    if (!this->m_Parsed)
+    {
+      Superclass::ReadCells(buffer);
+      return;
+    }
+    std::memcpy(buffer, this->m_Mesh.cells.get(), this->m_Mesh.cellBufferSize * sizeof(uint32_t));
+    this->m_Mesh.cells.reset();
+  }
+
+  void
+  ReadPointData(void * buffer) override
+  {
+    if (!this->m_Parsed)
+    {
+      Superclass::ReadPointData(buffer);
+      return;
+    }
+    std::memcpy(buffer, this->m_Mesh.pointData.get(), this->m_Mesh.numberOfPointPixels * 3 * sizeof(float));
+    this->m_Mesh.pointData.reset();
+  }
+
+  void
+  ReadCellData(void * buffer) override
+  {
+    if (!this->m_Parsed)
+    {
+      Superclass::ReadCellData(buffer);
+    }
+  }
+
+protected:
+  WasmAsciiMeshIO() = default;
+  ~WasmAsciiMeshIO() override = default;
+
+private:
+  bool m_Parsed{ false };
+  wasm::AsciiMesh m_Mesh;
+};
+
+} // end namespace itk
+
+#endif // itkWasmAsciiMeshIO_h
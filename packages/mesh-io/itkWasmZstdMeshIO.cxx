@@ -17,7 +17,12 @@
  *=========================================================================*/
 
 #include "itkWasmZstdMeshIO.h"
-#include "zstd.h"
+#include "itkWasmZstdCBORStream.h"
+#include "itkWasmZstdDictionary.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <vector>
 
 namespace itk
 {
@@ -67,25 +72,15 @@ WasmZstdMeshIO
   this->SetByteOrderToLittleEndian();
 
   const std::string path = this->GetFileName();
+  this->m_DictionaryID = 0;
 
   std::string::size_type zstdPos = path.rfind(".zst");
   if ( ( zstdPos != std::string::npos )
        && ( zstdPos == path.length() - 4 ) )
   {
-    std::ifstream dataStream;
-    this->OpenFileForReading( dataStream, this->GetFileName() );
-
-    std::ostringstream ostrm;
-    ostrm << dataStream.rdbuf();
-    auto inputBinary = ostrm.str();
-
-    const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-    std::vector<char> decompressedBinary(decompressedBufferSize);
-
-    const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-    decompressedBinary.resize(decompressedSize);
-
-    this->ReadCBOR(nullptr, reinterpret_cast< unsigned char *>(&(decompressedBinary.at(0))), decompressedSize);
+    // Only the stream prefix up to the mesh information is decompressed.
+    // The typed arrays are decompressed into their buffers as they are read.
+    this->ReadCBOR();
     return;
   }
 
@@ -121,38 +116,150 @@ WasmZstdMeshIO
 }
 
 
-void
+std::unique_ptr<wasm::CBORSink>
 WasmZstdMeshIO
-::Write()
+::CreateCBORSink(uint64_t encodedSize)
 {
   const std::string path(this->GetFileName());
 
-  std::string::size_type cborPos = path.rfind(".zst");
-  if ( ( cborPos != std::string::npos )
-       && ( cborPos == path.length() - 4 ) )
+  if (this->IsZstdOutput())
   {
-    unsigned char* cborBuffer;
-    size_t cborBufferSize;
-    size_t length = cbor_serialize_alloc(this->m_CBORRoot, &cborBuffer, &cborBufferSize);
+    FILE * file = this->OpenCBORFile();
+    if (file == NULL)
+    {
+      itkExceptionMacro("Could not open file for writing: " << path);
+    }
+    // The typed arrays are compressed as they are streamed by the Write* methods
+    auto sink = std::make_unique<wasm::ZstdCBORSink>(file, this->m_CompressionLevel, encodedSize);
+    const unsigned int numberOfWorkers = this->m_NumberOfWorkers > 0 ? this->m_NumberOfWorkers : MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+    // One worker would only move compression off the calling thread
+    sink->SetNumberOfWorkers(numberOfWorkers > 1 ? numberOfWorkers : 0);
+    sink->SetLongDistanceMatching(this->m_LongDistanceMatching);
+    if (!sink->SetDictionary(this->GetDictionary(0)))
+    {
+      itkExceptionMacro("Could not use the zstd dictionary " << this->m_DictionaryFileName);
+    }
+    return sink;
+  }
 
-    const size_t compressedBufferSize = ZSTD_compressBound(cborBufferSize);
-    std::vector<char> compressedBinary(compressedBufferSize);
+  return Superclass::CreateCBORSink(encodedSize);
+}
 
-    constexpr int compressionLevel = 3;
-    const size_t compressedSize = ZSTD_compress(compressedBinary.data(), compressedBufferSize, cborBuffer, cborBufferSize, compressionLevel);
-    free(cborBuffer);
-    cbor_decref(&(this->m_CBORRoot));
 
-    compressedBinary.resize(compressedSize);
+std::unique_ptr<wasm::CBORSource>
+WasmZstdMeshIO
+::CreateCBORSource()
+{
+  if (this->IsZstdInput())
+  {
+    std::unique_ptr<wasm::RangeReader> reader = this->OpenRangeReader();
+    if (!reader)
+    {
+      itkExceptionMacro("Could not read file: " << this->GetFileName());
+    }
+    std::vector<uint64_t> compressedOffsets;
+    std::vector<uint64_t> decompressedOffsets;
+    const bool seekable = wasm::ReadZstdSeekTable(*reader, compressedOffsets, decompressedOffsets);
+    this->m_DictionaryID = wasm::ReadZstdFrameDictionaryID(*reader);
+    auto source = std::make_unique<wasm::ZstdCBORSource>(std::move(reader));
+    if (!source->SetDictionary(this->GetDictionary(this->m_DictionaryID)))
+    {
+      itkExceptionMacro("Could not use the zstd dictionary " << this->m_DictionaryFileName);
+    }
+    if (seekable)
+    {
+      // Skips jump over whole frames
+      source->SetSeekTable(std::move(compressedOffsets), std::move(decompressedOffsets));
+    }
+    return source;
+  }
 
-    std::ofstream outputStream;
-    this->OpenFileForWriting( outputStream, path.c_str(), true, false );
-    std::ostream_iterator<char> oIt(outputStream);
-    std::copy(compressedBinary.begin(), compressedBinary.end(), oIt);
-    return;
+  return Superclass::CreateCBORSource();
+}
+
+
+std::string
+WasmZstdMeshIO
+::GetBundleMemberEncodingForWriting() const
+{
+  return "cbor.zst";
+}
+
+
+bool
+WasmZstdMeshIO
+::IsZstdInput() const
+{
+  if (this->FileNameIsBundle())
+  {
+    return this->GetBundleMember().encoding == "cbor.zst";
   }
+  const std::string path(this->GetFileName());
+  std::string::size_type zstdPos = path.rfind(".zst");
+  return zstdPos != std::string::npos && zstdPos == path.length() - 4;
+}
+
+
+bool
+WasmZstdMeshIO
+::IsZstdOutput() const
+{
+  // Bundle members are compressed
+  if (this->FileNameIsBundle())
+  {
+    return true;
+  }
+  const std::string path(this->GetFileName());
+  std::string::size_type zstdPos = path.rfind(".zst");
+  return zstdPos != std::string::npos && zstdPos == path.length() - 4;
+}
+
 
-  Superclass::Write();
+std::shared_ptr<const wasm::ZstdDictionary>
+WasmZstdMeshIO
+::GetDictionary(unsigned int recordedID) const
+{
+  if (this->m_DictionaryFileName.empty())
+  {
+    if (recordedID != 0)
+    {
+      itkExceptionMacro(<< this->GetFileName() << " was compressed with the zstd dictionary " << recordedID << ", and no DictionaryFileName is set");
+    }
+    return nullptr;
+  }
+
+  std::shared_ptr<const wasm::ZstdDictionary> dictionary = wasm::ZstdDictionary::Read(this->m_DictionaryFileName);
+  if (!dictionary)
+  {
+    itkExceptionMacro("Could not read the zstd dictionary " << this->m_DictionaryFileName);
+  }
+  if (recordedID != 0 && dictionary->GetID() != recordedID)
+  {
+    itkExceptionMacro(<< this->GetFileName() << " was compressed with the zstd dictionary " << recordedID << ", not "
+                      << this->m_DictionaryFileName << ", whose ID is " << dictionary->GetID());
+  }
+  return dictionary;
+}
+
+
+wasm::PayloadFilters
+WasmZstdMeshIO
+::GetPayloadFiltersForWriting() const
+{
+  if (!this->IsZstdOutput())
+  {
+    return wasm::PayloadFilters();
+  }
+
+  if (this->m_AutomaticPayloadFilters)
+  {
+    const size_t componentSize = std::max({ ITKComponentSize( this->GetPointComponentType() ),
+                                            ITKComponentSize( this->GetCellComponentType() ),
+                                            ITKComponentSize( this->GetPointPixelComponentType() ),
+                                            ITKComponentSize( this->GetCellPixelComponentType() ) });
+    return wasm::AutomaticPayloadFilters(componentSize);
+  }
+  return this->m_PayloadFiltersForWriting;
 }
 
 } // end namespace itk
@@ -21,8 +21,16 @@
 
 #include "itkWasmMeshIO.h"
 
+#include <memory>
+#include <string>
+
 namespace itk
 {
+namespace wasm
+{
+class ZstdDictionary;
+}
+
 /** \class WasmZstdMeshIO
  *
  * \brief Read and write an itk::Mesh in a web-friendly format.
@@ -33,7 +41,8 @@ namespace itk
  * 
  * This class extends WasmMeshIO by adding support for zstandard compression.
  *
- * The file extensions used are .iwm, .iwm.cbor, and .iwm.cbor.zst.
+ * The file extensions used are .iwm, .iwm.cbor, and .iwm.cbor.zst. The
+ * members of .iwm.bundle files written are compressed.
  * 
  * \ingroup IOFilters
  * \ingroup WebAssemblyInterface
@@ -52,6 +61,55 @@ public:
   /** Run-time type information (and related methods). */
   itkTypeMacro(WasmZstdMeshIO, WasmMeshIO);
 
+  /** zstd compression level, 3 by default. */
+  itkSetMacro(CompressionLevel, int);
+  itkGetConstMacro(CompressionLevel, int);
+
+  /** Number of zstd worker threads used to compress. 0 uses the global
+   * default number of threads, which is set by the pipeline --threads
+   * option. Compression is single threaded when libzstd is built without
+   * multithreading support. */
+  itkSetMacro(NumberOfWorkers, unsigned int);
+  itkGetConstMacro(NumberOfWorkers, unsigned int);
+
+  /** Enable zstd long-distance matching. Off by default. */
+  itkSetMacro(LongDistanceMatching, bool);
+  itkGetConstMacro(LongDistanceMatching, bool);
+  itkBooleanMacro(LongDistanceMatching);
+
+  /** Reversible filters of the typed arrays before compression, e.g. a
+   * byte shuffle, which groups the bytes of float point coordinates by
+   * significance so they compress better. The filters are recorded in the
+   * file and reversed on read. None by default, since older readers do not
+   * reverse them. */
+  void SetPayloadFiltersForWriting(const wasm::PayloadFilters & filters)
+  {
+    m_PayloadFiltersForWriting = filters;
+    this->Modified();
+  }
+
+  /** Select the payload filters by component type when writing, instead of
+   * the PayloadFiltersForWriting: a byte shuffle when the typed arrays have
+   * multi-byte components. Off by default. */
+  itkSetMacro(AutomaticPayloadFilters, bool);
+  itkGetConstMacro(AutomaticPayloadFilters, bool);
+  itkBooleanMacro(AutomaticPayloadFilters);
+
+  /** zstd dictionary file of .zst files, e.g. one trained with the
+   * compress-stringify train-zstd-dictionary pipeline on similar small
+   * meshes. Writing records its dictionary ID in the frame headers, and
+   * reading requires the dictionary with the recorded ID. Empty, for no
+   * dictionary, by default. */
+  itkSetStringMacro(DictionaryFileName);
+  itkGetStringMacro(DictionaryFileName);
+
+  /** Dictionary ID recorded in the .zst file read by ReadMeshInformation, 0
+   * if it was compressed without a dictionary. */
+  itkGetConstMacro(DictionaryID, unsigned int);
+
+  /** The payload filters of .zst files. */
+  wasm::PayloadFilters GetPayloadFiltersForWriting() const override;
+
   /** Determine the file type. Returns true if this MeshIO can read the
    * file specified. */
   bool CanReadFile(const char *) override;
@@ -63,14 +121,40 @@ public:
    * file specified. */
   bool CanWriteFile(const char *) override;
 
-  void Write() override;
-
 protected:
   WasmZstdMeshIO();
   ~WasmZstdMeshIO() override;
 
+  /** Compress the .iwm.cbor.zst file as it is streamed. */
+  std::unique_ptr<wasm::CBORSink> CreateCBORSink(uint64_t encodedSize) override;
+
+  /** Decompress the .iwm.cbor.zst file as it is read, straight into the
+   * destination of each read. */
+  std::unique_ptr<wasm::CBORSource> CreateCBORSource() override;
+
+  /** "cbor.zst": bundle members are compressed like .iwm.cbor.zst files. */
+  std::string GetBundleMemberEncodingForWriting() const override;
+
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(WasmZstdMeshIO);
+
+  /** Whether the file, or the selected member of a .iwm.bundle file, read or
+   * written is zstd compressed. */
+  bool IsZstdInput() const;
+  bool IsZstdOutput() const;
+
+  /** The cached DictionaryFileName dictionary, nullptr without one. Throws
+   * if it cannot be read, or if a dictionary ID is recorded in the frames of
+   * the file and it is not that dictionary. */
+  std::shared_ptr<const wasm::ZstdDictionary> GetDictionary(unsigned int recordedID) const;
+
+  int m_CompressionLevel{ 3 };
+  unsigned int m_NumberOfWorkers{ 0 };
+  bool m_LongDistanceMatching{ false };
+  wasm::PayloadFilters m_PayloadFiltersForWriting;
+  bool m_AutomaticPayloadFilters{ false };
+  std::string m_DictionaryFileName;
+  unsigned int m_DictionaryID{ 0 };
 };
 } // end namespace itk
 
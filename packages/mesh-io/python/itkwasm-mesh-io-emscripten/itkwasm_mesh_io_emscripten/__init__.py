@@ -23,5 +23,7 @@ from .wasm_read_mesh_async import wasm_read_mesh_async
 from .wasm_write_mesh_async import wasm_write_mesh_async
 from .wasm_zstd_read_mesh_async import wasm_zstd_read_mesh_async
 from .wasm_zstd_write_mesh_async import wasm_zstd_write_mesh_async
+from .write_mesh_chunks_async import write_mesh_chunks_async
+from .read_mesh_chunk_index_async import read_mesh_chunk_index_async
 
 from ._version import __version__
@@ -11,6 +11,8 @@ extension_to_mesh_io = OrderedDict([
     ('.swc', 'swc'),
     ('.iwm', 'wasm'),
     ('.iwm.cbor', 'wasm'),
+    ('.iwm.bin', 'wasm'),
     ('.iwm.cbor.zst', 'wasmZstd'),
+    ('.iwm.bundle', 'wasmZstd'),
     ('.bmp', 'bmp'),
 ])
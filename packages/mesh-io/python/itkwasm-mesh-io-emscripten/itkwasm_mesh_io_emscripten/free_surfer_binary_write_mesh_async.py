@@ -23,6 +23,10 @@ async def free_surfer_binary_write_mesh_async(
     information_only: bool = False,
     use_compression: bool = False,
     binary_file_type: bool = False,
+    quantization_bits: int = 0,
+    quantization_maximum_error: float = 0,
+    optimize_vertex_cache: bool = False,
+    point_order: str = "input",
 ) -> Tuple[Any]:
     """Write an itk-wasm file format converted to an mesh file format
 
@@ -41,6 +45,18 @@ async def free_surfer_binary_write_mesh_async(
     :param binary_file_type: Use a binary file type in the written file, if supported
     :type  binary_file_type: bool
 
+    :param quantization_bits: Quantize float points and point data to 16 or 32 bit integers against their bounding box, if supported
+    :type  quantization_bits: int
+
+    :param quantization_maximum_error: Fail if a quantized component would have a larger absolute error. 0 does not limit the error.
+    :type  quantization_maximum_error: float
+
+    :param optimize_vertex_cache: Reorder the cells so consecutive cells share points
+    :type  optimize_vertex_cache: bool
+
+    :param point_order: Order of the written points: input, first-use by the cells, or morton
+    :type  point_order: str
+
     :return: Whether the input could be written. If false, the output mesh is not valid.
     :rtype:  Any
     """
@@ -54,6 +70,14 @@ async def free_surfer_binary_write_mesh_async(
         kwargs["useCompression"] = to_js(use_compression)
     if binary_file_type:
         kwargs["binaryFileType"] = to_js(binary_file_type)
+    if quantization_bits:
+        kwargs["quantizationBits"] = to_js(quantization_bits)
+    if quantization_maximum_error:
+        kwargs["quantizationMaximumError"] = to_js(quantization_maximum_error)
+    if optimize_vertex_cache:
+        kwargs["optimizeVertexCache"] = to_js(optimize_vertex_cache)
+    if point_order:
+        kwargs["pointOrder"] = to_js(point_order)
 
     outputs = await js_module.freeSurferBinaryWriteMesh(to_js(mesh), to_js(serialized_mesh), webWorker=web_worker, noCopy=True, **kwargs)
 
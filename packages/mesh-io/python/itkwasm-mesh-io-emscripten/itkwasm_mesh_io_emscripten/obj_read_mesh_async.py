@@ -20,6 +20,7 @@ from itkwasm import (
 async def obj_read_mesh_async(
     serialized_mesh: os.PathLike,
     information_only: bool = False,
+    bundle_member: str = "",
 ) -> Tuple[Any, Mesh]:
     """Read a mesh file format and convert it to the itk-wasm file format
 
@@ -29,6 +30,9 @@ async def obj_read_mesh_async(
     :param information_only: Only read image metadata -- do not read pixel data.
     :type  information_only: bool
 
+    :param bundle_member: Name of the member of a .iwm.bundle file to read, e.g. a chunk of read-mesh-chunk-index, if supported. By default, the first member.
+    :type  bundle_member: str
+
     :return: Whether the input could be read. If false, the output mesh is not valid.
     :rtype:  Any
 
@@ -41,6 +45,8 @@ async def obj_read_mesh_async(
     kwargs = {}
     if information_only:
         kwargs["informationOnly"] = to_js(information_only)
+    if bundle_member:
+        kwargs["bundleMember"] = to_js(bundle_member)
 
     outputs = await js_module.objReadMesh(to_js(BinaryFile(serialized_mesh)), webWorker=web_worker, noCopy=True, **kwargs)
 
@@ -0,0 +1,62 @@
+# Generated file. To retain edits, remove this comment.
+
+from pathlib import Path
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from .js_package import js_package
+
+from itkwasm.pyodide import (
+    to_js,
+    to_py,
+    js_resources
+)
+from itkwasm import (
+    InterfaceTypes,
+    BinaryFile,
+)
+
+async def read_mesh_chunk_index_async(
+    serialized_mesh: os.PathLike,
+    level: int = 0,
+    bounds: Optional[List[float]] = None,
+) -> Any:
+    """Select the chunks of a level in a bounding box from the table of contents of a .iwm.bundle file written by write-mesh-chunks
+
+    :param serialized_mesh: Input .iwm.bundle file
+    :type  serialized_mesh: os.PathLike
+
+    :param level: Level of detail of the chunks, 0 for the full resolution
+    :type  level: int
+
+    :param bounds: Bounding box of the chunks, the minimum then the maximum of each axis. By default, every chunk of the level.
+    :type  bounds: float
+
+    :return: The number of levels and the selected chunks, as {"numberOfLevels", "chunks": [{"name", "level", "bounds", "encoding", "size"}]}. A chunk is read as the bundle member of its name with the wasm or wasm-zstd read-mesh --bundle-member option.
+    :rtype:  Any
+    """
+    js_module = await js_package.js_module
+    web_worker = js_resources.web_worker
+
+    kwargs = {}
+    if level:
+        kwargs["level"] = to_js(level)
+    if bounds:
+        kwargs["bounds"] = to_js(bounds)
+
+    outputs = await js_module.readMeshChunkIndex(to_js(BinaryFile(serialized_mesh)), webWorker=web_worker, noCopy=True, **kwargs)
+
+    output_web_worker = None
+    output_list = []
+    outputs_object_map = outputs.as_object_map()
+    for output_name in outputs.object_keys():
+        if output_name == 'webWorker':
+            output_web_worker = outputs_object_map[output_name]
+        else:
+            output_list.append(to_py(outputs_object_map[output_name]))
+
+    js_resources.web_worker = output_web_worker
+
+    if len(output_list) == 1:
+        return output_list[0]
+    return tuple(output_list)
@@ -0,0 +1,85 @@
+# Generated file. To retain edits, remove this comment.
+
+from pathlib import Path
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from .js_package import js_package
+
+from itkwasm.pyodide import (
+    to_js,
+    to_py,
+    js_resources
+)
+from itkwasm import (
+    InterfaceTypes,
+    Mesh,
+    BinaryFile,
+)
+
+async def write_mesh_chunks_async(
+    mesh: Mesh,
+    serialized_mesh: str,
+    maximum_points_per_chunk: int = 65536,
+    levels: int = 0,
+    use_compression: bool = False,
+    quantization_bits: int = 0,
+    quantization_maximum_error: float = 0,
+) -> Tuple[Any]:
+    """Write a mesh as the spatial chunks of an octree, with coarse levels of detail, in a .iwm.bundle file
+
+    :param mesh: Input mesh
+    :type  mesh: Mesh
+
+    :param serialized_mesh: Output .iwm.bundle file
+    :type  serialized_mesh: str
+
+    :param maximum_points_per_chunk: Octree leaves are split until their cells use at most this many points
+    :type  maximum_points_per_chunk: int
+
+    :param levels: Number of coarse levels of detail, each with half the resolution of the level before it
+    :type  levels: int
+
+    :param use_compression: Compress each chunk with zstd
+    :type  use_compression: bool
+
+    :param quantization_bits: Quantize float points and point data to 16 or 32 bit integers against the bounding box of each chunk
+    :type  quantization_bits: int
+
+    :param quantization_maximum_error: Fail if a quantized component would have a larger absolute error. 0 does not limit the error.
+    :type  quantization_maximum_error: float
+
+    :return: Chunks written, as [{"name", "level", "bounds", "numberOfPoints", "numberOfCells"}], where the bounds are the minimum then the maximum of each axis
+    :rtype:  Any
+    """
+    js_module = await js_package.js_module
+    web_worker = js_resources.web_worker
+
+    kwargs = {}
+    if maximum_points_per_chunk:
+        kwargs["maximumPointsPerChunk"] = to_js(maximum_points_per_chunk)
+    if levels:
+        kwargs["levels"] = to_js(levels)
+    if use_compression:
+        kwargs["useCompression"] = to_js(use_compression)
+    if quantization_bits:
+        kwargs["quantizationBits"] = to_js(quantization_bits)
+    if quantization_maximum_error:
+        kwargs["quantizationMaximumError"] = to_js(quantization_maximum_error)
+
+    outputs = await js_module.writeMeshChunks(to_js(mesh), to_js(serialized_mesh), webWorker=web_worker, noCopy=True, **kwargs)
+
+    output_web_worker = None
+    output_list = []
+    outputs_object_map = outputs.as_object_map()
+    for output_name in outputs.object_keys():
+        if output_name == 'webWorker':
+            output_web_worker = outputs_object_map[output_name]
+        else:
+            output_list.append(to_py(outputs_object_map[output_name]))
+
+    js_resources.web_worker = output_web_worker
+
+    if len(output_list) == 1:
+        return output_list[0]
+    return tuple(output_list)
@@ -23,5 +23,7 @@ from .wasm_read_mesh import wasm_read_mesh
 from .wasm_write_mesh import wasm_write_mesh
 from .wasm_zstd_read_mesh import wasm_zstd_read_mesh
 from .wasm_zstd_write_mesh import wasm_zstd_write_mesh
+from .write_mesh_chunks import write_mesh_chunks
+from .read_mesh_chunk_index import read_mesh_chunk_index
 
 from ._version import __version__
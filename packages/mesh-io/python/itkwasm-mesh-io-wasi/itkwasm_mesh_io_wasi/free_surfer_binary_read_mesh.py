@@ -20,6 +20,7 @@ from itkwasm import (
 def free_surfer_binary_read_mesh(
     serialized_mesh: os.PathLike,
     information_only: bool = False,
+    bundle_member: str = "",
 ) -> Tuple[Any, Mesh]:
     """Read a mesh file format and convert it to the itk-wasm file format
 
@@ -29,6 +30,9 @@ def free_surfer_binary_read_mesh(
     :param information_only: Only read image metadata -- do not read pixel data.
     :type  information_only: bool
 
+    :param bundle_member: Name of the member of a .iwm.bundle file to read, e.g. a chunk of read-mesh-chunk-index, if supported. By default, the first member.
+    :type  bundle_member: str
+
     :return: Whether the input could be read. If false, the output mesh is not valid.
     :rtype:  Any
 
@@ -65,6 +69,10 @@ def free_surfer_binary_read_mesh(
     if information_only:
         args.append('--information-only')
 
+    if bundle_member:
+        args.append('--bundle-member')
+        args.append(str(bundle_member))
+
 
     outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
 
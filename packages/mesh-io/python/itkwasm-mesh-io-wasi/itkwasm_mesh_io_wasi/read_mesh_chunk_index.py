@@ -0,0 +1,77 @@
+# Generated file. To retain edits, remove this comment.
+
+from pathlib import Path, PurePosixPath
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from importlib_resources import files as file_resources
+
+_pipeline = None
+
+from itkwasm import (
+    InterfaceTypes,
+    PipelineOutput,
+    PipelineInput,
+    Pipeline,
+    BinaryFile,
+)
+
+def read_mesh_chunk_index(
+    serialized_mesh: os.PathLike,
+    level: int = 0,
+    bounds: Optional[List[float]] = None,
+) -> Any:
+    """Select the chunks of a level in a bounding box from the table of contents of a .iwm.bundle file written by write-mesh-chunks
+
+    :param serialized_mesh: Input .iwm.bundle file
+    :type  serialized_mesh: os.PathLike
+
+    :param level: Level of detail of the chunks, 0 for the full resolution
+    :type  level: int
+
+    :param bounds: Bounding box of the chunks, the minimum then the maximum of each axis. By default, every chunk of the level.
+    :type  bounds: float
+
+    :return: The number of levels and the selected chunks, as {"numberOfLevels", "chunks": [{"name", "level", "bounds", "encoding", "size"}]}. A chunk is read as the bundle member of its name with the wasm or wasm-zstd read-mesh --bundle-member option.
+    :rtype:  Any
+    """
+    global _pipeline
+    if _pipeline is None:
+        _pipeline = Pipeline(file_resources('itkwasm_mesh_io_wasi').joinpath(Path('wasm_modules') / Path('read-mesh-chunk-index.wasi.wasm')))
+
+    pipeline_outputs: List[PipelineOutput] = [
+        PipelineOutput(InterfaceTypes.JsonCompatible),
+    ]
+
+    pipeline_inputs: List[PipelineInput] = [
+        PipelineInput(InterfaceTypes.BinaryFile, BinaryFile(PurePosixPath(serialized_mesh))),
+    ]
+
+    args: List[str] = ['--memory-io',]
+    # Inputs
+    if not Path(serialized_mesh).exists():
+        raise FileNotFoundError("serialized_mesh does not exist")
+    args.append(str(PurePosixPath(serialized_mesh)))
+    # Outputs
+    chunk_index_name = '0'
+    args.append(chunk_index_name)
+
+    # Options
+    input_count = len(pipeline_inputs)
+    if level:
+        args.append('--level')
+        args.append(str(level))
+
+    if bounds is not None and len(bounds) < 1:
+       raise ValueError('"bounds" kwarg must have a length > 1')
+    if bounds is not None and len(bounds) > 0:
+        args.append('--bounds')
+        for value in bounds:
+            args.append(str(value))
+
+
+    outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
+
+    result = outputs[0].data
+    return result
+
@@ -0,0 +1,104 @@
+# Generated file. To retain edits, remove this comment.
+
+from pathlib import Path, PurePosixPath
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from importlib_resources import files as file_resources
+
+_pipeline = None
+
+from itkwasm import (
+    InterfaceTypes,
+    PipelineOutput,
+    PipelineInput,
+    Pipeline,
+    Mesh,
+    BinaryFile,
+)
+
+def write_mesh_chunks(
+    mesh: Mesh,
+    serialized_mesh: str,
+    maximum_points_per_chunk: int = 65536,
+    levels: int = 0,
+    use_compression: bool = False,
+    quantization_bits: int = 0,
+    quantization_maximum_error: float = 0,
+) -> Tuple[Any]:
+    """Write a mesh as the spatial chunks of an octree, with coarse levels of detail, in a .iwm.bundle file
+
+    :param mesh: Input mesh
+    :type  mesh: Mesh
+
+    :param serialized_mesh: Output .iwm.bundle file
+    :type  serialized_mesh: str
+
+    :param maximum_points_per_chunk: Octree leaves are split until their cells use at most this many points
+    :type  maximum_points_per_chunk: int
+
+    :param levels: Number of coarse levels of detail, each with half the resolution of the level before it
+    :type  levels: int
+
+    :param use_compression: Compress each chunk with zstd
+    :type  use_compression: bool
+
+    :param quantization_bits: Quantize float points and point data to 16 or 32 bit integers against the bounding box of each chunk
+    :type  quantization_bits: int
+
+    :param quantization_maximum_error: Fail if a quantized component would have a larger absolute error. 0 does not limit the error.
+    :type  quantization_maximum_error: float
+
+    :return: Chunks written, as [{"name", "level", "bounds", "numberOfPoints", "numberOfCells"}], where the bounds are the minimum then the maximum of each axis
+    :rtype:  Any
+    """
+    global _pipeline
+    if _pipeline is None:
+        _pipeline = Pipeline(file_resources('itkwasm_mesh_io_wasi').joinpath(Path('wasm_modules') / Path('write-mesh-chunks.wasi.wasm')))
+
+    pipeline_outputs: List[PipelineOutput] = [
+        PipelineOutput(InterfaceTypes.JsonCompatible),
+        PipelineOutput(InterfaceTypes.BinaryFile, BinaryFile(PurePosixPath(serialized_mesh))),
+    ]
+
+    pipeline_inputs: List[PipelineInput] = [
+        PipelineInput(InterfaceTypes.Mesh, mesh),
+    ]
+
+    args: List[str] = ['--memory-io',]
+    # Inputs
+    args.append('0')
+    # Outputs
+    chunks_name = '0'
+    args.append(chunks_name)
+
+    serialized_mesh_name = str(PurePosixPath(serialized_mesh))
+    args.append(serialized_mesh_name)
+
+    # Options
+    input_count = len(pipeline_inputs)
+    if maximum_points_per_chunk:
+        args.append('--maximum-points-per-chunk')
+        args.append(str(maximum_points_per_chunk))
+
+    if levels:
+        args.append('--levels')
+        args.append(str(levels))
+
+    if use_compression:
+        args.append('--use-compression')
+
+    if quantization_bits:
+        args.append('--quantization-bits')
+        args.append(str(quantization_bits))
+
+    if quantization_maximum_error:
+        args.append('--quantization-maximum-error')
+        args.append(str(quantization_maximum_error))
+
+
+    outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
+
+    result = outputs[0].data
+    return result
+
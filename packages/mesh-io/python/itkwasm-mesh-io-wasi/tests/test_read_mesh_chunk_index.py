@@ -0,0 +1,8 @@
+# Generated file. To retain edits, remove this comment.
+
+from itkwasm_mesh_io_wasi import read_mesh_chunk_index
+
+from .common import test_input_path, test_output_path
+
+def test_read_mesh_chunk_index():
+    pass
@@ -0,0 +1,8 @@
+# Generated file. To retain edits, remove this comment.
+
+from itkwasm_mesh_io_wasi import write_mesh_chunks
+
+from .common import test_input_path, test_output_path
+
+def test_write_mesh_chunks():
+    pass
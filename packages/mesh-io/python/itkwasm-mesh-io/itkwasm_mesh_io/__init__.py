@@ -45,5 +45,9 @@ from .wasm_zstd_read_mesh_async import wasm_zstd_read_mesh_async
 from .wasm_zstd_read_mesh import wasm_zstd_read_mesh
 from .wasm_zstd_write_mesh_async import wasm_zstd_write_mesh_async
 from .wasm_zstd_write_mesh import wasm_zstd_write_mesh
+from .write_mesh_chunks_async import write_mesh_chunks_async
+from .write_mesh_chunks import write_mesh_chunks
+from .read_mesh_chunk_index_async import read_mesh_chunk_index_async
+from .read_mesh_chunk_index import read_mesh_chunk_index
 
 from ._version import __version__
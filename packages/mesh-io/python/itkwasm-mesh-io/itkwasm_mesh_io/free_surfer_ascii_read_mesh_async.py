@@ -12,6 +12,7 @@ from itkwasm import (
 async def free_surfer_ascii_read_mesh_async(
     serialized_mesh: os.PathLike,
     information_only: bool = False,
+    bundle_member: str = "",
 ) -> Tuple[Any, Mesh]:
     """Read a mesh file format and convert it to the itk-wasm file format
 
@@ -21,6 +22,9 @@ async def free_surfer_ascii_read_mesh_async(
     :param information_only: Only read image metadata -- do not read pixel data.
     :type  information_only: bool
 
+    :param bundle_member: Name of the member of a .iwm.bundle file to read, e.g. a chunk of read-mesh-chunk-index, if supported. By default, the first member.
+    :type  bundle_member: str
+
     :return: Whether the input could be read. If false, the output mesh is not valid.
     :rtype:  Any
 
@@ -28,5 +32,5 @@ async def free_surfer_ascii_read_mesh_async(
     :rtype:  Mesh
     """
     func = environment_dispatch("itkwasm_mesh_io", "free_surfer_ascii_read_mesh_async")
-    output = await func(serialized_mesh, information_only=information_only)
+    output = await func(serialized_mesh, information_only=information_only, bundle_member=bundle_member)
     return output
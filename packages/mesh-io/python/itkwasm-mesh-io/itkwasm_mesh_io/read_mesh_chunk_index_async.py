@@ -0,0 +1,32 @@
+# Generated file. Do not edit.
+
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from itkwasm import (
+    environment_dispatch,
+    BinaryFile,
+)
+
+async def read_mesh_chunk_index_async(
+    serialized_mesh: os.PathLike,
+    level: int = 0,
+    bounds: Optional[List[float]] = None,
+) -> Any:
+    """Select the chunks of a level in a bounding box from the table of contents of a .iwm.bundle file written by write-mesh-chunks
+
+    :param serialized_mesh: Input .iwm.bundle file
+    :type  serialized_mesh: os.PathLike
+
+    :param level: Level of detail of the chunks, 0 for the full resolution
+    :type  level: int
+
+    :param bounds: Bounding box of the chunks, the minimum then the maximum of each axis. By default, every chunk of the level.
+    :type  bounds: float
+
+    :return: The number of levels and the selected chunks, as {"numberOfLevels", "chunks": [{"name", "level", "bounds", "encoding", "size"}]}. A chunk is read as the bundle member of its name with the wasm or wasm-zstd read-mesh --bundle-member option.
+    :rtype:  Any
+    """
+    func = environment_dispatch("itkwasm_mesh_io", "read_mesh_chunk_index_async")
+    output = await func(serialized_mesh, level=level, bounds=bounds)
+    return output
@@ -0,0 +1,49 @@
+# Generated file. Do not edit.
+
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from itkwasm import (
+    environment_dispatch,
+    Mesh,
+    BinaryFile,
+)
+
+async def write_mesh_chunks_async(
+    mesh: Mesh,
+    serialized_mesh: str,
+    maximum_points_per_chunk: int = 65536,
+    levels: int = 0,
+    use_compression: bool = False,
+    quantization_bits: int = 0,
+    quantization_maximum_error: float = 0,
+) -> Tuple[Any]:
+    """Write a mesh as the spatial chunks of an octree, with coarse levels of detail, in a .iwm.bundle file
+
+    :param mesh: Input mesh
+    :type  mesh: Mesh
+
+    :param serialized_mesh: Output .iwm.bundle file
+    :type  serialized_mesh: str
+
+    :param maximum_points_per_chunk: Octree leaves are split until their cells use at most this many points
+    :type  maximum_points_per_chunk: int
+
+    :param levels: Number of coarse levels of detail, each with half the resolution of the level before it
+    :type  levels: int
+
+    :param use_compression: Compress each chunk with zstd
+    :type  use_compression: bool
+
+    :param quantization_bits: Quantize float points and point data to 16 or 32 bit integers against the bounding box of each chunk
+    :type  quantization_bits: int
+
+    :param quantization_maximum_error: Fail if a quantized component would have a larger absolute error. 0 does not limit the error.
+    :type  quantization_maximum_error: float
+
+    :return: Chunks written, as [{"name", "level", "bounds", "numberOfPoints", "numberOfCells"}], where the bounds are the minimum then the maximum of each axis
+    :rtype:  Any
+    """
+    func = environment_dispatch("itkwasm_mesh_io", "write_mesh_chunks_async")
+    output = await func(mesh, serialized_mesh, maximum_points_per_chunk=maximum_points_per_chunk, levels=levels, use_compression=use_compression, quantization_bits=quantization_bits, quantization_maximum_error=quantization_maximum_error)
+    return output
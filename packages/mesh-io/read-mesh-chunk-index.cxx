@@ -0,0 +1,78 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkOutputTextStream.h"
+#include "itkWasmBundleFile.h"
+#include "itkWasmMeshChunks.h"
+#include "itkWasmRangeReader.h"
+
+#include <vector>
+
+int main (int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("read-mesh-chunk-index", "Select the chunks of a level in a bounding box from the table of contents of a .iwm.bundle file written by write-mesh-chunks", argc, argv);
+
+  // The table of contents can also be fetched by range from a URL with the host range fetch import
+  const CLI::Validator urlValidator([](std::string & name) {
+    return itk::wasm::RangeReader::IsURL(name) ? std::string() : std::string("Not a URL: ") + name;
+  }, "URL");
+  std::string inputFileName;
+  pipeline.add_option("serialized-mesh", inputFileName, "Input .iwm.bundle file")->required()->check(CLI::ExistingFile | urlValidator)->type_name("INPUT_BINARY_FILE");
+
+  itk::wasm::OutputTextStream chunkIndex;
+  pipeline.add_option("chunk-index", chunkIndex, "The number of levels and the selected chunks, as {\"numberOfLevels\", \"chunks\": [{\"name\", \"level\", \"bounds\", \"encoding\", \"size\"}]}. A chunk is read as the bundle member of its name with the wasm or wasm-zstd read-mesh --bundle-member option.")->required()->type_name("OUTPUT_JSON");
+
+  unsigned int level = 0;
+  pipeline.add_option("-l,--level", level, "Level of detail of the chunks, 0 for the full resolution");
+
+  std::vector<double> bounds;
+  pipeline.add_option("-b,--bounds", bounds, "Bounding box of the chunks, the minimum then the maximum of each axis. By default, every chunk of the level.");
+
+  ITK_WASM_PARSE(pipeline);
+
+  if (bounds.size() % 2 != 0)
+  {
+    CLI::Error err("Runtime error", "The bounds must have a minimum and a maximum for each axis", 1);
+    return pipeline.exit(err);
+  }
+
+  // Only the table of contents is read
+  itk::wasm::BundleTableOfContents tableOfContents;
+  std::unique_ptr<itk::wasm::RangeReader> reader = itk::wasm::RangeReader::Open(inputFileName);
+  if (!reader || !itk::wasm::ReadBundleTableOfContents(*reader, tableOfContents) || tableOfContents.bundleType != "Mesh")
+  {
+    CLI::Error err("Runtime error", "Expected a mesh bundle: " + inputFileName, 1);
+    return pipeline.exit(err);
+  }
+
+  const std::vector<const itk::wasm::BundleMember *> chunks = itk::wasm::SelectMeshChunks(tableOfContents, level, bounds);
+  chunkIndex.Get() << "{\"numberOfLevels\": " << itk::wasm::GetNumberOfMeshChunkLevels(tableOfContents) << ", \"chunks\": [";
+  for (size_t ii = 0; ii < chunks.size(); ++ii)
+  {
+    const itk::wasm::BundleMember & chunk = *chunks[ii];
+    chunkIndex.Get() << (ii > 0 ? ", " : "") << "{\"name\": \"" << chunk.name << "\", \"level\": " << chunk.level << ", \"bounds\": [";
+    for (size_t jj = 0; jj < chunk.bounds.size(); ++jj)
+    {
+      chunkIndex.Get() << (jj > 0 ? ", " : "") << chunk.bounds[jj];
+    }
+    chunkIndex.Get() << "], \"encoding\": \"" << chunk.encoding << "\", \"size\": " << chunk.size << "}";
+  }
+  chunkIndex.Get() << "]}\n";
+
+  return EXIT_SUCCESS;
+}
@@ -33,10 +33,13 @@
 #include "itkFreeSurferBinaryMeshIO.h"
 #elif MESH_IO_CLASS == 3
 #include "itkVTKPolyDataMeshIO.h"
+#include "itkWasmAsciiMeshIO.h"
 #elif MESH_IO_CLASS == 4
 #include "itkOBJMeshIO.h"
+#include "itkWasmAsciiMeshIO.h"
 #elif MESH_IO_CLASS == 5
 #include "itkOFFMeshIO.h"
+#include "itkWasmAsciiMeshIO.h"
 #elif MESH_IO_CLASS == 6
 #include "itkSTLMeshIO.h"
 #elif MESH_IO_CLASS == 7
@@ -55,12 +58,18 @@
 #include "itkPipeline.h"
 #include "itkOutputMesh.h"
 
+#include <type_traits>
+
 template <typename TMeshIO>
-int readMesh(const std::string & inputFileName, itk::wasm::OutputTextStream & couldRead, itk::wasm::OutputMeshIO & outputMeshIO, bool informationOnly)
+int readMesh(const std::string & inputFileName, itk::wasm::OutputTextStream & couldRead, itk::wasm::OutputMeshIO & outputMeshIO, bool informationOnly, const std::string & bundleMember)
 {
   using MeshIOType = TMeshIO;
 
   auto meshIO = MeshIOType::New();
+  if constexpr (std::is_base_of_v<itk::WasmMeshIO, MeshIOType>)
+  {
+    meshIO->SetBundleMemberName(bundleMember);
+  }
 
   outputMeshIO.SetInformationOnly(informationOnly);
 
@@ -97,28 +106,31 @@ int main (int argc, char * argv[])
   bool informationOnly = false;
   pipeline.add_flag("-i,--information-only", informationOnly, "Only read image metadata -- do not read pixel data.");
 
+  std::string bundleMember;
+  pipeline.add_option("--bundle-member", bundleMember, "Name of the member of a .iwm.bundle file to read, e.g. a chunk of read-mesh-chunk-index, if supported. By default, the first member.");
+
   ITK_WASM_PARSE(pipeline);
 
 #if MESH_IO_CLASS == 0
-  return readMesh<itk::BYUMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly);
+  return readMesh<itk::BYUMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly, bundleMember);
 #elif MESH_IO_CLASS == 1
-  return readMesh<itk::FreeSurferAsciiMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly);
+  return readMesh<itk::FreeSurferAsciiMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly, bundleMember);
 #elif MESH_IO_CLASS == 2
-  return readMesh<itk::FreeSurferBinaryMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly);
+  return readMesh<itk::FreeSurferBinaryMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly, bundleMember);
 #elif MESH_IO_CLASS == 3
-  return readMesh<itk::VTKPolyDataMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly);
+  return readMesh<itk::WasmAsciiMeshIO<itk::VTKPolyDataMeshIO, itk::wasm::AsciiMeshFormat::VTK>>(inputFileName, couldRead, outputMeshIO, informationOnly, bundleMember);
 #elif MESH_IO_CLASS == 4
-  return readMesh<itk::OBJMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly);
+  return readMesh<itk::WasmAsciiMeshIO<itk::OBJMeshIO, itk::wasm::AsciiMeshFormat::OBJ>>(inputFileName, couldRead, outputMeshIO, informationOnly, bundleMember);
 #elif MESH_IO_CLASS == 5
-  return readMesh<itk::OFFMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly);
+  return readMesh<itk::WasmAsciiMeshIO<itk::OFFMeshIO, itk::wasm::AsciiMeshFormat::OFF>>(inputFileName, couldRead, outputMeshIO, informationOnly, bundleMember);
 #elif MESH_IO_CLASS == 6
-  return readMesh<itk::STLMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly);
+  return readMesh<itk::STLMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly, bundleMember);
 #elif MESH_IO_CLASS == 7
-  return readMesh<itk::SWCMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly);
+  return readMesh<itk::SWCMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly, bundleMember);
 #elif MESH_IO_CLASS == 8
-  return readMesh<itk::WasmMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly);
+  return readMesh<itk::WasmMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly, bundleMember);
 #elif MESH_IO_CLASS == 9
-  return readMesh<itk::WasmZstdMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly);
+  return readMesh<itk::WasmZstdMeshIO>(inputFileName, couldRead, outputMeshIO, informationOnly, bundleMember);
 #else
 #error "Unsupported MESH_IO_CLASS"
 #endif
@@ -57,6 +57,10 @@ async function byuReadMeshNode(
   if (options.informationOnly) {
     options.informationOnly && args.push('--information-only')
   }
+  if (options.bundleMember) {
+    args.push('--bundle-member', options.bundleMember.toString())
+
+  }
 
   const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'byu-read-mesh')
 
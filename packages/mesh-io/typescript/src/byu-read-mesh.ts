@@ -62,6 +62,10 @@ async function byuReadMesh(
   if (options.informationOnly) {
     options.informationOnly && args.push('--information-only')
   }
+  if (options.bundleMember) {
+    args.push('--bundle-member', options.bundleMember.toString())
+
+  }
 
   const pipelinePath = 'byu-read-mesh'
 
@@ -12,6 +12,18 @@ interface ByuWriteMeshOptions extends WorkerPoolFunctionOption {
   /** Use a binary file type in the written file, if supported */
   binaryFileType?: boolean
 
+  /** Quantize float points and point data to 16 or 32 bit integers against their bounding box, if supported */
+  quantizationBits?: number
+
+  /** Fail if a quantized component would have a larger absolute error. 0 does not limit the error. */
+  quantizationMaximumError?: number
+
+  /** Reorder the cells so consecutive cells share points */
+  optimizeVertexCache?: boolean
+
+  /** Order of the written points: input, first-use by the cells, or morton */
+  pointOrder?: string
+
 }
 
 export default ByuWriteMeshOptions
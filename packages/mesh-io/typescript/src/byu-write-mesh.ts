@@ -65,6 +65,21 @@ async function byuWriteMesh(
   if (options.binaryFileType) {
     options.binaryFileType && args.push('--binary-file-type')
   }
+  if (options.quantizationBits) {
+    args.push('--quantization-bits', options.quantizationBits.toString())
+
+  }
+  if (options.quantizationMaximumError) {
+    args.push('--quantization-maximum-error', options.quantizationMaximumError.toString())
+
+  }
+  if (options.optimizeVertexCache) {
+    options.optimizeVertexCache && args.push('--optimize-vertex-cache')
+  }
+  if (options.pointOrder) {
+    args.push('--point-order', options.pointOrder.toString())
+
+  }
 
   const pipelinePath = 'byu-write-mesh'
 
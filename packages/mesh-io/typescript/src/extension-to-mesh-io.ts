@@ -9,7 +9,9 @@ const extensionToMeshIo = new Map([
   ['swc', 'swc'],
   ['iwm', 'wasm'],
   ['iwm.cbor', 'wasm'],
-  ['iwm.cbor.zst', 'wasm-zstd']
+  ['iwm.bin', 'wasm'],
+  ['iwm.cbor.zst', 'wasm-zstd'],
+  ['iwm.bundle', 'wasm-zstd']
 ])
 
 export default extensionToMeshIo
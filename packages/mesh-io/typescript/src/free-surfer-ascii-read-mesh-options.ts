@@ -6,6 +6,9 @@ interface FreeSurferAsciiReadMeshOptions extends WorkerPoolFunctionOption {
   /** Only read image metadata -- do not read pixel data. */
   informationOnly?: boolean
 
+  /** Name of the member of a .iwm.bundle file to read, e.g. a chunk of read-mesh-chunk-index, if supported. By default, the first member. */
+  bundleMember?: string
+
 }
 
 export default FreeSurferAsciiReadMeshOptions
@@ -64,6 +64,21 @@ async function freeSurferAsciiWriteMeshNode(
   if (options.binaryFileType) {
     options.binaryFileType && args.push('--binary-file-type')
   }
+  if (options.quantizationBits) {
+    args.push('--quantization-bits', options.quantizationBits.toString())
+
+  }
+  if (options.quantizationMaximumError) {
+    args.push('--quantization-maximum-error', options.quantizationMaximumError.toString())
+
+  }
+  if (options.optimizeVertexCache) {
+    options.optimizeVertexCache && args.push('--optimize-vertex-cache')
+  }
+  if (options.pointOrder) {
+    args.push('--point-order', options.pointOrder.toString())
+
+  }
 
   const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'free-surfer-ascii-write-mesh')
 
@@ -4,6 +4,9 @@ interface FreeSurferBinaryReadMeshNodeOptions {
   /** Only read image metadata -- do not read pixel data. */
   informationOnly?: boolean
 
+  /** Name of the member of a .iwm.bundle file to read, e.g. a chunk of read-mesh-chunk-index, if supported. By default, the first member. */
+  bundleMember?: string
+
 }
 
 export default FreeSurferBinaryReadMeshNodeOptions
@@ -144,3 +144,23 @@ export type { WasmZstdWriteMeshNodeResult }
 
 import wasmZstdWriteMeshNode from './wasm-zstd-write-mesh-node.js'
 export { wasmZstdWriteMeshNode }
+
+
+import WriteMeshChunksNodeResult from './write-mesh-chunks-node-result.js'
+export type { WriteMeshChunksNodeResult }
+
+import WriteMeshChunksNodeOptions from './write-mesh-chunks-node-options.js'
+export type { WriteMeshChunksNodeOptions }
+
+import writeMeshChunksNode from './write-mesh-chunks-node.js'
+export { writeMeshChunksNode }
+
+
+import ReadMeshChunkIndexNodeResult from './read-mesh-chunk-index-node-result.js'
+export type { ReadMeshChunkIndexNodeResult }
+
+import ReadMeshChunkIndexNodeOptions from './read-mesh-chunk-index-node-options.js'
+export type { ReadMeshChunkIndexNodeOptions }
+
+import readMeshChunkIndexNode from './read-mesh-chunk-index-node.js'
+export { readMeshChunkIndexNode }
@@ -156,3 +156,23 @@ export type { WasmZstdWriteMeshResult }
 
 import wasmZstdWriteMesh from './wasm-zstd-write-mesh.js'
 export { wasmZstdWriteMesh }
+
+
+import WriteMeshChunksResult from './write-mesh-chunks-result.js'
+export type { WriteMeshChunksResult }
+
+import WriteMeshChunksOptions from './write-mesh-chunks-options.js'
+export type { WriteMeshChunksOptions }
+
+import writeMeshChunks from './write-mesh-chunks.js'
+export { writeMeshChunks }
+
+
+import ReadMeshChunkIndexResult from './read-mesh-chunk-index-result.js'
+export type { ReadMeshChunkIndexResult }
+
+import ReadMeshChunkIndexOptions from './read-mesh-chunk-index-options.js'
+export type { ReadMeshChunkIndexOptions }
+
+import readMeshChunkIndex from './read-mesh-chunk-index.js'
+export { readMeshChunkIndex }
@@ -0,0 +1,12 @@
+// Generated file. To retain edits, remove this comment.
+
+interface ReadMeshChunkIndexNodeOptions {
+  /** Level of detail of the chunks, 0 for the full resolution */
+  level?: number
+
+  /** Bounding box of the chunks, the minimum then the maximum of each axis. By default, every chunk of the level. */
+  bounds?: number[]
+
+}
+
+export default ReadMeshChunkIndexNodeOptions
@@ -0,0 +1,11 @@
+// Generated file. To retain edits, remove this comment.
+
+import { JsonCompatible } from 'itk-wasm'
+
+interface ReadMeshChunkIndexNodeResult {
+  /** The number of levels and the selected chunks, as {"numberOfLevels", "chunks": [{"name", "level", "bounds", "encoding", "size"}]}. A chunk is read as the bundle member of its name with the wasm or wasm-zstd read-mesh --bundle-member option. */
+  chunkIndex: JsonCompatible
+
+}
+
+export default ReadMeshChunkIndexNodeResult
@@ -0,0 +1,85 @@
+// Generated file. To retain edits, remove this comment.
+
+import {
+  JsonCompatible,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipelineNode
+} from 'itk-wasm'
+
+import ReadMeshChunkIndexNodeOptions from './read-mesh-chunk-index-node-options.js'
+import ReadMeshChunkIndexNodeResult from './read-mesh-chunk-index-node-result.js'
+
+import path from 'path'
+import { fileURLToPath } from 'url'
+
+/**
+ * Select the chunks of a level in a bounding box from the table of contents of a .iwm.bundle file written by write-mesh-chunks
+ *
+ * @param {string} serializedMesh - Input .iwm.bundle file
+ * @param {ReadMeshChunkIndexNodeOptions} options - options object
+ *
+ * @returns {Promise<ReadMeshChunkIndexNodeResult>} - result object
+ */
+async function readMeshChunkIndexNode(
+  serializedMesh: string,
+  options: ReadMeshChunkIndexNodeOptions = {}
+) : Promise<ReadMeshChunkIndexNodeResult> {
+
+  const mountDirs: Set<string> = new Set()
+
+  const desiredOutputs: Array<PipelineOutput> = [
+    { type: InterfaceTypes.JsonCompatible },
+  ]
+
+  mountDirs.add(path.dirname(serializedMesh as string))
+  const inputs: Array<PipelineInput> = [
+  ]
+
+  const args = []
+  // Inputs
+  const serializedMeshName = serializedMesh
+  args.push(serializedMeshName)
+  mountDirs.add(path.dirname(serializedMeshName))
+
+  // Outputs
+  const chunkIndexName = '0'
+  args.push(chunkIndexName)
+
+  // Options
+  args.push('--memory-io')
+  if (options.level) {
+    args.push('--level', options.level.toString())
+
+  }
+  if (options.bounds) {
+    if(options.bounds.length < 1) {
+      throw new Error('"bounds" option must have a length > 1')
+    }
+    args.push('--bounds')
+
+    options.bounds.forEach((value) => {
+      args.push(value.toString())
+
+    })
+  }
+
+  const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'read-mesh-chunk-index')
+
+  const {
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipelineNode(pipelinePath, args, desiredOutputs, inputs, mountDirs)
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    chunkIndex: outputs[0]?.data as JsonCompatible,
+  }
+  return result
+}
+
+export default readMeshChunkIndexNode
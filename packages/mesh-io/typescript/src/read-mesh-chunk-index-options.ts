@@ -0,0 +1,14 @@
+// Generated file. To retain edits, remove this comment.
+
+import { WorkerPoolFunctionOption } from 'itk-wasm'
+
+interface ReadMeshChunkIndexOptions extends WorkerPoolFunctionOption {
+  /** Level of detail of the chunks, 0 for the full resolution */
+  level?: number
+
+  /** Bounding box of the chunks, the minimum then the maximum of each axis. By default, every chunk of the level. */
+  bounds?: number[]
+
+}
+
+export default ReadMeshChunkIndexOptions
@@ -0,0 +1,96 @@
+// Generated file. To retain edits, remove this comment.
+
+import {
+  BinaryFile,
+  JsonCompatible,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipeline
+} from 'itk-wasm'
+
+import ReadMeshChunkIndexOptions from './read-mesh-chunk-index-options.js'
+import ReadMeshChunkIndexResult from './read-mesh-chunk-index-result.js'
+
+import { getPipelinesBaseUrl } from './pipelines-base-url.js'
+import { getPipelineWorkerUrl } from './pipeline-worker-url.js'
+
+import { getDefaultWebWorker } from './default-web-worker.js'
+
+/**
+ * Select the chunks of a level in a bounding box from the table of contents of a .iwm.bundle file written by write-mesh-chunks
+ *
+ * @param {File | BinaryFile} serializedMesh - Input .iwm.bundle file
+ * @param {ReadMeshChunkIndexOptions} options - options object
+ *
+ * @returns {Promise<ReadMeshChunkIndexResult>} - result object
+ */
+async function readMeshChunkIndex(
+  serializedMesh: File | BinaryFile,
+  options: ReadMeshChunkIndexOptions = {}
+) : Promise<ReadMeshChunkIndexResult> {
+
+  const desiredOutputs: Array<PipelineOutput> = [
+    { type: InterfaceTypes.JsonCompatible },
+  ]
+
+  let serializedMeshFile = serializedMesh
+  if (serializedMesh instanceof File) {
+    const serializedMeshBuffer = await serializedMesh.arrayBuffer()
+    serializedMeshFile = { path: serializedMesh.name, data: new Uint8Array(serializedMeshBuffer) }
+  }
+  const inputs: Array<PipelineInput> = [
+    { type: InterfaceTypes.BinaryFile, data: serializedMeshFile as BinaryFile },
+  ]
+
+  const args = []
+  // Inputs
+  const serializedMeshName = (serializedMeshFile as BinaryFile).path
+  args.push(serializedMeshName)
+
+  // Outputs
+  const chunkIndexName = '0'
+  args.push(chunkIndexName)
+
+  // Options
+  args.push('--memory-io')
+  if (options.level) {
+    args.push('--level', options.level.toString())
+
+  }
+  if (options.bounds) {
+    if(options.bounds.length < 1) {
+      throw new Error('"bounds" option must have a length > 1')
+    }
+    args.push('--bounds')
+
+    await Promise.all(options.bounds.map(async (value) => {
+      args.push(value.toString())
+
+    }))
+  }
+
+  const pipelinePath = 'read-mesh-chunk-index'
+
+  let workerToUse = options?.webWorker
+  if (workerToUse === undefined) {
+    workerToUse = await getDefaultWebWorker()
+  }
+  const {
+    webWorker: usedWebWorker,
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipeline(pipelinePath, args, desiredOutputs, inputs, { pipelineBaseUrl: getPipelinesBaseUrl(), pipelineWorkerUrl: getPipelineWorkerUrl(), webWorker: workerToUse, noCopy: options?.noCopy })
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    webWorker: usedWebWorker as Worker,
+    chunkIndex: outputs[0]?.data as JsonCompatible,
+  }
+  return result
+}
+
+export default readMeshChunkIndex
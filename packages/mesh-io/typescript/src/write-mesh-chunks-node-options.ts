@@ -0,0 +1,21 @@
+// Generated file. To retain edits, remove this comment.
+
+interface WriteMeshChunksNodeOptions {
+  /** Octree leaves are split until their cells use at most this many points */
+  maximumPointsPerChunk?: number
+
+  /** Number of coarse levels of detail, each with half the resolution of the level before it */
+  levels?: number
+
+  /** Compress each chunk with zstd */
+  useCompression?: boolean
+
+  /** Quantize float points and point data to 16 or 32 bit integers against the bounding box of each chunk */
+  quantizationBits?: number
+
+  /** Fail if a quantized component would have a larger absolute error. 0 does not limit the error. */
+  quantizationMaximumError?: number
+
+}
+
+export default WriteMeshChunksNodeOptions
@@ -0,0 +1,12 @@
+// Generated file. To retain edits, remove this comment.
+
+import { JsonCompatible } from 'itk-wasm'
+
+interface WriteMeshChunksNodeResult {
+  /** Chunks written, as [{"name", "level", "bounds", "numberOfPoints", "numberOfCells"}], where the bounds are the minimum then the maximum of each axis */
+  chunks: JsonCompatible
+
+  /** Output .iwm.bundle file */
+}
+
+export default WriteMeshChunksNodeResult
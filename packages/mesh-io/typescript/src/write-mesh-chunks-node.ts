@@ -0,0 +1,95 @@
+// Generated file. To retain edits, remove this comment.
+
+import {
+  Mesh,
+  JsonCompatible,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipelineNode
+} from 'itk-wasm'
+
+import WriteMeshChunksNodeOptions from './write-mesh-chunks-node-options.js'
+import WriteMeshChunksNodeResult from './write-mesh-chunks-node-result.js'
+
+import path from 'path'
+import { fileURLToPath } from 'url'
+
+/**
+ * Write a mesh as the spatial chunks of an octree, with coarse levels of detail, in a .iwm.bundle file
+ *
+ * @param {Mesh} mesh - Input mesh
+ * @param {string} serializedMesh - Output .iwm.bundle file
+ * @param {WriteMeshChunksNodeOptions} options - options object
+ *
+ * @returns {Promise<WriteMeshChunksNodeResult>} - result object
+ */
+async function writeMeshChunksNode(
+  mesh: Mesh,
+  serializedMesh: string,
+  options: WriteMeshChunksNodeOptions = {}
+) : Promise<WriteMeshChunksNodeResult> {
+
+  const mountDirs: Set<string> = new Set()
+
+  const desiredOutputs: Array<PipelineOutput> = [
+    { type: InterfaceTypes.JsonCompatible },
+  ]
+
+  const inputs: Array<PipelineInput> = [
+    { type: InterfaceTypes.Mesh, data: mesh },
+  ]
+
+  const args = []
+  // Inputs
+  const meshName = '0'
+  args.push(meshName)
+
+  // Outputs
+  const chunksName = '0'
+  args.push(chunksName)
+
+  const serializedMeshName = serializedMesh
+  args.push(serializedMeshName)
+  mountDirs.add(path.dirname(serializedMeshName))
+
+  // Options
+  args.push('--memory-io')
+  if (options.maximumPointsPerChunk) {
+    args.push('--maximum-points-per-chunk', options.maximumPointsPerChunk.toString())
+
+  }
+  if (options.levels) {
+    args.push('--levels', options.levels.toString())
+
+  }
+  if (options.useCompression) {
+    options.useCompression && args.push('--use-compression')
+  }
+  if (options.quantizationBits) {
+    args.push('--quantization-bits', options.quantizationBits.toString())
+
+  }
+  if (options.quantizationMaximumError) {
+    args.push('--quantization-maximum-error', options.quantizationMaximumError.toString())
+
+  }
+
+  const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'write-mesh-chunks')
+
+  const {
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipelineNode(pipelinePath, args, desiredOutputs, inputs, mountDirs)
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    chunks: outputs[0]?.data as JsonCompatible,
+  }
+  return result
+}
+
+export default writeMeshChunksNode
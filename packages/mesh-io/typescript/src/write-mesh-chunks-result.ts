@@ -0,0 +1,14 @@
+// Generated file. To retain edits, remove this comment.
+
+import { JsonCompatible, BinaryFile, WorkerPoolFunctionResult } from 'itk-wasm'
+
+interface WriteMeshChunksResult extends WorkerPoolFunctionResult {
+  /** Chunks written, as [{"name", "level", "bounds", "numberOfPoints", "numberOfCells"}], where the bounds are the minimum then the maximum of each axis */
+  chunks: JsonCompatible
+
+  /** Output .iwm.bundle file */
+  serializedMesh: BinaryFile
+
+}
+
+export default WriteMeshChunksResult
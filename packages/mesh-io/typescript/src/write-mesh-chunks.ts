@@ -0,0 +1,103 @@
+// Generated file. To retain edits, remove this comment.
+
+import {
+  Mesh,
+  JsonCompatible,
+  BinaryFile,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipeline
+} from 'itk-wasm'
+
+import WriteMeshChunksOptions from './write-mesh-chunks-options.js'
+import WriteMeshChunksResult from './write-mesh-chunks-result.js'
+
+import { getPipelinesBaseUrl } from './pipelines-base-url.js'
+import { getPipelineWorkerUrl } from './pipeline-worker-url.js'
+
+import { getDefaultWebWorker } from './default-web-worker.js'
+
+/**
+ * Write a mesh as the spatial chunks of an octree, with coarse levels of detail, in a .iwm.bundle file
+ *
+ * @param {Mesh} mesh - Input mesh
+ * @param {string} serializedMesh - Output .iwm.bundle file
+ * @param {WriteMeshChunksOptions} options - options object
+ *
+ * @returns {Promise<WriteMeshChunksResult>} - result object
+ */
+async function writeMeshChunks(
+  mesh: Mesh,
+  serializedMesh: string,
+  options: WriteMeshChunksOptions = {}
+) : Promise<WriteMeshChunksResult> {
+
+  const desiredOutputs: Array<PipelineOutput> = [
+    { type: InterfaceTypes.JsonCompatible },
+    { type: InterfaceTypes.BinaryFile, data: { path: serializedMesh, data: new Uint8Array() }},
+  ]
+
+  const inputs: Array<PipelineInput> = [
+    { type: InterfaceTypes.Mesh, data: mesh },
+  ]
+
+  const args = []
+  // Inputs
+  const meshName = '0'
+  args.push(meshName)
+
+  // Outputs
+  const chunksName = '0'
+  args.push(chunksName)
+
+  const serializedMeshName = serializedMesh
+  args.push(serializedMeshName)
+
+  // Options
+  args.push('--memory-io')
+  if (options.maximumPointsPerChunk) {
+    args.push('--maximum-points-per-chunk', options.maximumPointsPerChunk.toString())
+
+  }
+  if (options.levels) {
+    args.push('--levels', options.levels.toString())
+
+  }
+  if (options.useCompression) {
+    options.useCompression && args.push('--use-compression')
+  }
+  if (options.quantizationBits) {
+    args.push('--quantization-bits', options.quantizationBits.toString())
+
+  }
+  if (options.quantizationMaximumError) {
+    args.push('--quantization-maximum-error', options.quantizationMaximumError.toString())
+
+  }
+
+  const pipelinePath = 'write-mesh-chunks'
+
+  let workerToUse = options?.webWorker
+  if (workerToUse === undefined) {
+    workerToUse = await getDefaultWebWorker()
+  }
+  const {
+    webWorker: usedWebWorker,
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipeline(pipelinePath, args, desiredOutputs, inputs, { pipelineBaseUrl: getPipelinesBaseUrl(), pipelineWorkerUrl: getPipelineWorkerUrl(), webWorker: workerToUse, noCopy: options?.noCopy })
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    webWorker: usedWebWorker as Worker,
+    chunks: outputs[0]?.data as JsonCompatible,
+    serializedMesh: outputs[1]?.data as BinaryFile,
+  }
+  return result
+}
+
+export default writeMeshChunks
@@ -14,6 +14,10 @@ import WriteMeshOptions from './write-mesh-options.js'
 interface WriterOptions {
   useCompression?: boolean
   binaryFileType?: boolean
+  quantizationBits?: number
+  quantizationMaximumError?: number
+  optimizeVertexCache?: boolean
+  pointOrder?: string
 }
 interface WriterResult {
   couldWrite: boolean
@@ -40,6 +44,14 @@ async function writeMeshNode(
   const extension = getFileExtension(absoluteFilePath)
 
   let inputMesh = mesh
+  const writerOptions: WriterOptions = {
+    useCompression: options.useCompression,
+    binaryFileType: options.binaryFileType,
+    quantizationBits: options.quantizationBits,
+    quantizationMaximumError: options.quantizationMaximumError,
+    optimizeVertexCache: options.optimizeVertexCache,
+    pointOrder: options.pointOrder,
+  }
 
   let io = null
   if (typeof mimeType !== 'undefined' && mimeToMeshIo.has(mimeType)) {
@@ -49,7 +61,7 @@ async function writeMeshNode(
   } else {
     for (const readerWriter of meshIoIndexNode.values()) {
       if (readerWriter[1] !== null) {
-        let { couldWrite } = await (readerWriter[1] as Writer)(inputMesh, absoluteFilePath, { useCompression: options.useCompression, binaryFileType: options.binaryFileType })
+        let { couldWrite } = await (readerWriter[1] as Writer)(inputMesh, absoluteFilePath, writerOptions)
         if (couldWrite) {
           return
         }
@@ -62,7 +74,7 @@ async function writeMeshNode(
   const readerWriter = meshIoIndexNode.get(io as string)
 
   const writer = (readerWriter as Array<Writer>)[1]
-  let { couldWrite } = await writer(inputMesh, absoluteFilePath, { useCompression: options.useCompression })
+  let { couldWrite } = await writer(inputMesh, absoluteFilePath, writerOptions)
   if (!couldWrite) {
     throw Error('Could not write: ' + absoluteFilePath)
   }
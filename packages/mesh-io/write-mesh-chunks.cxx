@@ -0,0 +1,118 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkInputMeshIO.h"
+#include "itkOutputTextStream.h"
+#include "itkWasmMeshChunks.h"
+#include "itkWasmMeshIO.h"
+#include "itkWasmMeshIOBase.h"
+#include "itkWasmZstdMeshIO.h"
+
+#include <vector>
+
+// Write the spatial chunks of a mesh, and of its coarse levels, as the
+// members of a .iwm.bundle file, so readers load the chunks of a level in a
+// bounding box, with read-mesh-chunk-index, without decoding the others
+template <typename TMeshIO>
+int writeMeshChunks(itk::wasm::Pipeline & pipeline, itk::wasm::InputMeshIO & inputMeshIO, itk::wasm::OutputTextStream & chunksJSON, const std::string & outputFileName, uint64_t maximumPointsPerChunk, unsigned int numberOfLevels, unsigned int quantizationBits, double quantizationMaximumError)
+{
+  const itk::WasmMeshIOBase * inputWasmMeshIOBase = inputMeshIO.Get();
+  const itk::MeshIOBase * inputMeshIOBase = inputWasmMeshIOBase->GetMeshIO();
+  const auto buffer = [](const itk::WasmMeshIOBase::DataContainerType * container) -> const std::vector<char> & {
+    return container->CastToSTLConstContainer();
+  };
+
+  std::vector<itk::wasm::MeshChunk> chunks;
+  ITK_WASM_CATCH_EXCEPTION(pipeline, chunks = itk::wasm::PartitionMesh(inputMeshIOBase, buffer(inputWasmMeshIOBase->GetPointsContainer()), buffer(inputWasmMeshIOBase->GetCellsContainer()), buffer(inputWasmMeshIOBase->GetPointDataContainer()), buffer(inputWasmMeshIOBase->GetCellDataContainer()), maximumPointsPerChunk, numberOfLevels));
+  if (chunks.empty())
+  {
+    CLI::Error err("Runtime error", "The mesh has no points to write", 1);
+    return pipeline.exit(err);
+  }
+
+  bool append = false;
+  for (const itk::wasm::MeshChunk & chunk : chunks)
+  {
+    auto meshIO = TMeshIO::New();
+    meshIO->SetFileName(outputFileName);
+    // The first chunk replaces the file
+    meshIO->SetAppendToBundle(append);
+    append = true;
+    meshIO->SetQuantizationBits(quantizationBits);
+    meshIO->SetQuantizationMaximumError(quantizationMaximumError);
+    ITK_WASM_CATCH_EXCEPTION(pipeline, itk::wasm::WriteMeshChunk(inputMeshIOBase, chunk, meshIO));
+  }
+
+  chunksJSON.Get() << "[";
+  for (size_t ii = 0; ii < chunks.size(); ++ii)
+  {
+    const itk::wasm::MeshChunk & chunk = chunks[ii];
+    chunksJSON.Get() << (ii > 0 ? ", " : "") << "{\"name\": \"" << chunk.name << "\", \"level\": " << chunk.level << ", \"bounds\": [";
+    for (size_t jj = 0; jj < chunk.bounds.size(); ++jj)
+    {
+      chunksJSON.Get() << (jj > 0 ? ", " : "") << chunk.bounds[jj];
+    }
+    chunksJSON.Get() << "], \"numberOfPoints\": " << chunk.numberOfPoints << ", \"numberOfCells\": " << chunk.numberOfCells << "}";
+  }
+  chunksJSON.Get() << "]\n";
+
+  return EXIT_SUCCESS;
+}
+
+int main (int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("write-mesh-chunks", "Write a mesh as the spatial chunks of an octree, with coarse levels of detail, in a .iwm.bundle file", argc, argv);
+
+  itk::wasm::InputMeshIO inputMeshIO;
+  pipeline.add_option("mesh", inputMeshIO, "Input mesh")->required()->type_name("INPUT_MESH");
+
+  itk::wasm::OutputTextStream chunksJSON;
+  pipeline.add_option("chunks", chunksJSON, "Chunks written, as [{\"name\", \"level\", \"bounds\", \"numberOfPoints\", \"numberOfCells\"}], where the bounds are the minimum then the maximum of each axis")->required()->type_name("OUTPUT_JSON");
+
+  std::string outputFileName;
+  pipeline.add_option("serialized-mesh", outputFileName, "Output .iwm.bundle file")->required()->type_name("OUTPUT_BINARY_FILE");
+
+  uint64_t maximumPointsPerChunk = 65536;
+  pipeline.add_option("--maximum-points-per-chunk", maximumPointsPerChunk, "Octree leaves are split until their cells use at most this many points")->check(CLI::PositiveNumber);
+
+  unsigned int numberOfLevels = 0;
+  pipeline.add_option("--levels", numberOfLevels, "Number of coarse levels of detail, each with half the resolution of the level before it");
+
+  bool useCompression = false;
+  pipeline.add_flag("-c,--use-compression", useCompression, "Compress each chunk with zstd");
+
+  unsigned int quantizationBits = 0;
+  pipeline.add_option("--quantization-bits", quantizationBits, "Quantize float points and point data to 16 or 32 bit integers against the bounding box of each chunk");
+
+  double quantizationMaximumError = 0.0;
+  pipeline.add_option("--quantization-maximum-error", quantizationMaximumError, "Fail if a quantized component would have a larger absolute error. 0 does not limit the error.");
+
+  ITK_WASM_PARSE(pipeline);
+
+  if (!itk::wasm::FileNameIsBundle(outputFileName, ".iwm.bundle"))
+  {
+    CLI::Error err("Runtime error", "The output file must be a .iwm.bundle file: " + outputFileName, 1);
+    return pipeline.exit(err);
+  }
+
+  if (useCompression)
+  {
+    return writeMeshChunks<itk::WasmZstdMeshIO>(pipeline, inputMeshIO, chunksJSON, outputFileName, maximumPointsPerChunk, numberOfLevels, quantizationBits, quantizationMaximumError);
+  }
+  return writeMeshChunks<itk::WasmMeshIO>(pipeline, inputMeshIO, chunksJSON, outputFileName, maximumPointsPerChunk, numberOfLevels, quantizationBits, quantizationMaximumError);
+}
@@ -55,10 +55,14 @@
 #include "itkPipeline.h"
 #include "itkOutputMesh.h"
 #include "itkWasmMeshIOBase.h"
+#include "itkWasmMeshReordering.h"
 #include "itkMeshIOBase.h"
 
+#include <type_traits>
+#include <vector>
+
 template <typename TMeshIO>
-int writeMesh(itk::wasm::InputMeshIO & inputMeshIO, itk::wasm::OutputTextStream & couldWrite, const std::string & outputFileName, bool informationOnly, bool useCompression, bool binaryFileType)
+int writeMesh(itk::wasm::Pipeline & pipeline, itk::wasm::InputMeshIO & inputMeshIO, itk::wasm::OutputTextStream & couldWrite, const std::string & outputFileName, bool informationOnly, bool useCompression, bool binaryFileType, unsigned int quantizationBits, double quantizationMaximumError, bool optimizeVertexCache, itk::wasm::MeshPointOrder pointOrder)
 {
   using MeshIOType = TMeshIO;
 
@@ -80,6 +84,11 @@ int writeMesh(itk::wasm::InputMeshIO & inputMeshIO, itk::wasm::OutputTextStream
     meshIO->SetFileTypeToBinary();
   }
   meshIO->SetByteOrderToLittleEndian();
+  if constexpr (std::is_base_of_v<itk::WasmMeshIO, MeshIOType>)
+  {
+    meshIO->SetQuantizationBits(quantizationBits);
+    meshIO->SetQuantizationMaximumError(quantizationMaximumError);
+  }
 
   meshIO->SetFileName(outputFileName);
 
@@ -122,21 +131,38 @@ int writeMesh(itk::wasm::InputMeshIO & inputMeshIO, itk::wasm::OutputTextStream
 
   if (!informationOnly)
   {
+    // The buffers are copied only when they are reordered
+    std::vector<char> points;
+    std::vector<char> cells;
+    std::vector<char> pointData;
+    std::vector<char> cellData;
+    if (optimizeVertexCache || pointOrder != itk::wasm::MeshPointOrder::Input)
+    {
+      points = inputWasmMeshIOBase->GetPointsContainer()->CastToSTLConstContainer();
+      cells = inputWasmMeshIOBase->GetCellsContainer()->CastToSTLConstContainer();
+      pointData = inputWasmMeshIOBase->GetPointDataContainer()->CastToSTLConstContainer();
+      cellData = inputWasmMeshIOBase->GetCellDataContainer()->CastToSTLConstContainer();
+      ITK_WASM_CATCH_EXCEPTION(pipeline, itk::wasm::ReorderMesh(inputMeshIOBase, optimizeVertexCache, pointOrder, points, cells, pointData, cellData));
+    }
+    const auto buffer = [](std::vector<char> & reordered, const itk::WasmMeshIOBase::DataContainerType * container) {
+      return reinterpret_cast< void * >( reordered.empty() ? const_cast< char * >(&(container->at(0))) : reordered.data() );
+    };
+
     if (meshIO->GetNumberOfPoints())
     {
-      meshIO->WritePoints( reinterpret_cast< void * >( const_cast< char * >(&(inputWasmMeshIOBase->GetPointsContainer()->at(0))) ));
+      meshIO->WritePoints( buffer(points, inputWasmMeshIOBase->GetPointsContainer()) );
     }
     if (meshIO->GetNumberOfCells())
     {
-      meshIO->WriteCells( reinterpret_cast< void * >( const_cast< char * >(&(inputWasmMeshIOBase->GetCellsContainer()->at(0))) ));
+      meshIO->WriteCells( buffer(cells, inputWasmMeshIOBase->GetCellsContainer()) );
     }
     if (meshIO->GetNumberOfPointPixels())
     {
-      meshIO->WritePointData( reinterpret_cast< void * >( const_cast< char * >(&(inputWasmMeshIOBase->GetPointDataContainer()->at(0))) ));
+      meshIO->WritePointData( buffer(pointData, inputWasmMeshIOBase->GetPointDataContainer()) );
     }
     if (meshIO->GetNumberOfCellPixels())
     {
-      meshIO->WriteCellData( reinterpret_cast< void * >( const_cast< char * >(&(inputWasmMeshIOBase->GetCellDataContainer()->at(0))) ));
+      meshIO->WriteCellData( buffer(cellData, inputWasmMeshIOBase->GetCellDataContainer()) );
     }
 
     meshIO->Write();
@@ -168,28 +194,42 @@ int main (int argc, char * argv[])
   bool binaryFileType = false;
   pipeline.add_flag("-b,--binary-file-type", binaryFileType, "Use a binary file type in the written file, if supported");
 
+  unsigned int quantizationBits = 0;
+  pipeline.add_option("--quantization-bits", quantizationBits, "Quantize float points and point data to 16 or 32 bit integers against their bounding box, if supported");
+
+  double quantizationMaximumError = 0.0;
+  pipeline.add_option("--quantization-maximum-error", quantizationMaximumError, "Fail if a quantized component would have a larger absolute error. 0 does not limit the error.");
+
+  bool optimizeVertexCache = false;
+  pipeline.add_flag("--optimize-vertex-cache", optimizeVertexCache, "Reorder the cells so consecutive cells share points");
+
+  std::string pointOrderName = "input";
+  pipeline.add_option("--point-order", pointOrderName, "Order of the written points: input, first-use by the cells, or morton")->check(CLI::IsMember({"input", "first-use", "morton"}));
+
   ITK_WASM_PARSE(pipeline);
 
+  const itk::wasm::MeshPointOrder pointOrder = itk::wasm::MeshPointOrderFromString(pointOrderName);
+
 #if MESH_IO_CLASS == 0
-  return writeMesh<itk::BYUMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::BYUMeshIO>(pipeline, inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, quantizationBits, quantizationMaximumError, optimizeVertexCache, pointOrder);
 #elif MESH_IO_CLASS == 1
-  return writeMesh<itk::FreeSurferAsciiMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::FreeSurferAsciiMeshIO>(pipeline, inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, quantizationBits, quantizationMaximumError, optimizeVertexCache, pointOrder);
 #elif MESH_IO_CLASS == 2
-  return writeMesh<itk::FreeSurferBinaryMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::FreeSurferBinaryMeshIO>(pipeline, inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, quantizationBits, quantizationMaximumError, optimizeVertexCache, pointOrder);
 #elif MESH_IO_CLASS == 3
-  return writeMesh<itk::VTKPolyDataMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::VTKPolyDataMeshIO>(pipeline, inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, quantizationBits, quantizationMaximumError, optimizeVertexCache, pointOrder);
 #elif MESH_IO_CLASS == 4
-  return writeMesh<itk::OBJMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::OBJMeshIO>(pipeline, inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, quantizationBits, quantizationMaximumError, optimizeVertexCache, pointOrder);
 #elif MESH_IO_CLASS == 5
-  return writeMesh<itk::OFFMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::OFFMeshIO>(pipeline, inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, quantizationBits, quantizationMaximumError, optimizeVertexCache, pointOrder);
 #elif MESH_IO_CLASS == 6
-  return writeMesh<itk::STLMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::STLMeshIO>(pipeline, inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, quantizationBits, quantizationMaximumError, optimizeVertexCache, pointOrder);
 #elif MESH_IO_CLASS == 7
-  return writeMesh<itk::SWCMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::SWCMeshIO>(pipeline, inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, quantizationBits, quantizationMaximumError, optimizeVertexCache, pointOrder);
 #elif MESH_IO_CLASS == 8
-  return writeMesh<itk::WasmMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::WasmMeshIO>(pipeline, inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, quantizationBits, quantizationMaximumError, optimizeVertexCache, pointOrder);
 #elif MESH_IO_CLASS == 9
-  return writeMesh<itk::WasmZstdMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::WasmZstdMeshIO>(pipeline, inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, quantizationBits, quantizationMaximumError, optimizeVertexCache, pointOrder);
 #else
 #error "Unsupported MESH_IO_CLASS"
 #endif
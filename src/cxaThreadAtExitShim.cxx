@@ -18,7 +18,8 @@
 // Workaround for current lack of this function in the wasi toolchain
 // Ref: https://github.com/llvm/llvm-project/blob/80e2c26dfdd2e5ab1bbbf747ebff8c316399653c/libcxxabi/src/cxa_thread_atexit.cpp#L4
 
-#ifdef __cplusplus
+// Threaded builds link the libc++abi implementation
+#if defined(__cplusplus) && !defined(_REENTRANT)
 
 namespace __cxxabiv1 {
 
@@ -36,4 +37,4 @@ int __cxa_thread_atexit(__cxxabiv1::Dtor dtor, void* obj, void* dso_symbol) thro
 
 }
 
-#endif // __cplusplus
+#endif // __cplusplus && !_REENTRANT
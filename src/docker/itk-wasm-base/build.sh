@@ -13,6 +13,8 @@ BUILD_DATE=$(date -u +"%Y-%m-%dT%H:%M:%SZ")
 
 debug=false
 wasi=false
+threads=false
+memory64=false
 version_tag=false
 build_cmd="build"
 tag_flag="--tag"
@@ -22,6 +24,10 @@ for param; do
     debug=true
   elif [[ $param == '--with-wasi' ]]; then
     wasi=true
+  elif [[ $param == '--with-threads' ]]; then
+    threads=true
+  elif [[ $param == '--with-memory64' ]]; then
+    memory64=true
   elif [[ $param == '--multiarch' ]]; then
     # Newer buildah (1.28.2) required for multiarch
     exe=buildah
@@ -45,6 +51,15 @@ emscripten_debug_c_flags="-fno-lto -Wno-warn-absolute-paths"
 wasi_debug_ld_flags="-fno-lto -lwasi-emulated-process-clocks -lwasi-emulated-signal -lc-printscan-long-double"
 wasi_debug_c_flags="-fno-lto -D_WASI_EMULATED_PROCESS_CLOCKS -D_WASI_EMULATED_SIGNAL"
 
+emscripten_threads_ld_flags="-pthread -flto -s ALLOW_MEMORY_GROWTH=1 -s MAXIMUM_MEMORY=4GB"
+emscripten_threads_c_flags="-pthread -msimd128 -flto -Wno-warn-absolute-paths -DITK_WASM_NO_FILESYSTEM_IO"
+
+wasi_threads_ld_flags="-pthread ${wasi_ld_flags}"
+wasi_threads_c_flags="-pthread ${wasi_c_flags}"
+
+emscripten_memory64_ld_flags="-s MEMORY64=1 -flto -s ALLOW_MEMORY_GROWTH=1 -s MAXIMUM_MEMORY=16GB"
+emscripten_memory64_c_flags="-s MEMORY64=1 -msimd128 -flto -Wno-warn-absolute-paths -DITK_WASM_NO_FILESYSTEM_IO"
+
 if $create_manifest; then
   for list in itkwasm/emscripten-base:latest \
       itkwasm/emscripten-base:${TAG} \
@@ -53,7 +68,13 @@ if $create_manifest; then
       itkwasm/wasi-base:latest \
       itkwasm/wasi-base:${TAG} \
       itkwasm/wasi-base:latest-debug \
-      itkwasm/wasi-base:${TAG}-debug; do
+      itkwasm/wasi-base:${TAG}-debug \
+      itkwasm/emscripten-base:latest-threads \
+      itkwasm/emscripten-base:${TAG}-threads \
+      itkwasm/wasi-base:latest-threads \
+      itkwasm/wasi-base:${TAG}-threads \
+      itkwasm/emscripten-base:latest-memory64 \
+      itkwasm/emscripten-base:${TAG}-memory64; do
     if $(buildah manifest exists $list); then
       buildah manifest rm $list
     fi
@@ -156,3 +177,83 @@ if $debug; then
     fi
   fi
 fi
+
+if $threads; then
+  $exe $build_cmd $tag_flag itkwasm/emscripten-base:latest-threads \
+          --build-arg IMAGE=itkwasm/emscripten-base \
+          --build-arg CMAKE_BUILD_TYPE=Release \
+          --build-arg ITK_WASM_THREADS=ON \
+          --build-arg VCS_REF=${VCS_REF} \
+          --build-arg VCS_URL=${VCS_URL} \
+          --build-arg BUILD_DATE=${BUILD_DATE} \
+          --build-arg LDFLAGS="${emscripten_threads_ld_flags}" \
+          --build-arg CFLAGS="${emscripten_threads_c_flags}" \
+          $script_dir $@
+  if $version_tag; then
+        $exe $build_cmd $tag_flag itkwasm/emscripten-base:${TAG}-threads \
+                --build-arg IMAGE=itkwasm/emscripten-base \
+                --build-arg CMAKE_BUILD_TYPE=Release \
+                --build-arg ITK_WASM_THREADS=ON \
+                --build-arg VERSION=${TAG}-threads \
+                --build-arg VCS_REF=${VCS_REF} \
+                --build-arg VCS_URL=${VCS_URL} \
+                --build-arg BUILD_DATE=${BUILD_DATE} \
+                --build-arg LDFLAGS="${emscripten_threads_ld_flags}" \
+                --build-arg CFLAGS="${emscripten_threads_c_flags}" \
+                $script_dir $@
+  fi
+  if $wasi; then
+    $exe $build_cmd $tag_flag itkwasm/wasi-base:latest-threads \
+            --build-arg IMAGE=itkwasm/wasi-base \
+            --build-arg CMAKE_BUILD_TYPE=Release \
+            --build-arg ITK_WASM_THREADS=ON \
+            --build-arg VCS_REF=${VCS_REF} \
+            --build-arg VCS_URL=${VCS_URL} \
+            --build-arg BUILD_DATE=${BUILD_DATE} \
+            --build-arg BASE_IMAGE=docker.io/dockcross/web-wasi \
+            --build-arg LDFLAGS="${wasi_threads_ld_flags}" \
+            --build-arg CFLAGS="${wasi_threads_c_flags}" \
+            $script_dir $@
+    if $version_tag; then
+        $exe $build_cmd $tag_flag itkwasm/wasi-base:${TAG}-threads \
+                --build-arg IMAGE=itkwasm/wasi-base \
+                --build-arg CMAKE_BUILD_TYPE=Release \
+                --build-arg ITK_WASM_THREADS=ON \
+                --build-arg VERSION=${TAG}-threads \
+                --build-arg VCS_REF=${VCS_REF} \
+                --build-arg VCS_URL=${VCS_URL} \
+                --build-arg BUILD_DATE=${BUILD_DATE} \
+                --build-arg BASE_IMAGE=docker.io/dockcross/web-wasi \
+                --build-arg LDFLAGS="${wasi_threads_ld_flags}" \
+                --build-arg CFLAGS="${wasi_threads_c_flags}" \
+                $script_dir $@
+    fi
+  fi
+fi
+
+# wasi-sdk does not provide a wasm64 sysroot, so memory64 builds are emscripten only
+if $memory64; then
+  $exe $build_cmd $tag_flag itkwasm/emscripten-base:latest-memory64 \
+          --build-arg IMAGE=itkwasm/emscripten-base \
+          --build-arg CMAKE_BUILD_TYPE=Release \
+          --build-arg ITK_WASM_MEMORY64=ON \
+          --build-arg VCS_REF=${VCS_REF} \
+          --build-arg VCS_URL=${VCS_URL} \
+          --build-arg BUILD_DATE=${BUILD_DATE} \
+          --build-arg LDFLAGS="${emscripten_memory64_ld_flags}" \
+          --build-arg CFLAGS="${emscripten_memory64_c_flags}" \
+          $script_dir $@
+  if $version_tag; then
+        $exe $build_cmd $tag_flag itkwasm/emscripten-base:${TAG}-memory64 \
+                --build-arg IMAGE=itkwasm/emscripten-base \
+                --build-arg CMAKE_BUILD_TYPE=Release \
+                --build-arg ITK_WASM_MEMORY64=ON \
+                --build-arg VERSION=${TAG}-memory64 \
+                --build-arg VCS_REF=${VCS_REF} \
+                --build-arg VCS_URL=${VCS_URL} \
+                --build-arg BUILD_DATE=${BUILD_DATE} \
+                --build-arg LDFLAGS="${emscripten_memory64_ld_flags}" \
+                --build-arg CFLAGS="${emscripten_memory64_c_flags}" \
+                $script_dir $@
+  fi
+fi
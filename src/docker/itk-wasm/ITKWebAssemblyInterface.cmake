@@ -6,6 +6,82 @@ set(CMAKE_CXX_STANDARD_COMPUTED_DEFAULT 20)
 
 if(NOT _ITKWebAssemblyInterface_INCLUDED)
 
+# Build with WebAssembly threads: pthreads on a SharedArrayBuffer with
+# emscripten, wasi-threads with WASI. ITK and its dependencies must be built
+# with the same setting, e.g. in the itkwasm/emscripten:latest-threads and
+# itkwasm/wasi:latest-threads images, which set the ITK_WASM_THREADS
+# environment variable. Threaded pipelines are named <pipeline>.threads so
+# they can be deployed next to the baseline build, and the runtimes load them
+# when the host supports WebAssembly threads.
+if(DEFINED ENV{ITK_WASM_THREADS} AND "$ENV{ITK_WASM_THREADS}")
+  set(_itk_wasm_threads_default ON)
+else()
+  set(_itk_wasm_threads_default OFF)
+endif()
+option(ITK_WASM_THREADS "Build with WebAssembly threads" ${_itk_wasm_threads_default})
+if(ITK_WASM_THREADS)
+  string(APPEND CMAKE_C_FLAGS " -pthread")
+  string(APPEND CMAKE_CXX_FLAGS " -pthread")
+  if(EMSCRIPTEN)
+    set(_itk_wasm_threads_link_flags " -pthread -s PTHREAD_POOL_SIZE=navigator.hardwareConcurrency")
+  else()
+    set(_itk_wasm_threads_link_flags " -pthread -Wl,--import-memory -Wl,--export-memory -Wl,--max-memory=4294967296")
+  endif()
+endif()
+
+# Build with 64-bit linear memory, to address more than 4 GB, e.g. for large
+# volumes. Emscripten only: wasi-sdk does not provide a wasm64 sysroot. ITK
+# and its dependencies must be built with the same setting, as in the
+# itkwasm/emscripten:latest-memory64 image, which sets the ITK_WASM_MEMORY64
+# environment variable. Memory64 pipelines are named <pipeline>.memory64, and
+# the runtimes load them when the inputs do not fit in wasm32 memory.
+if(DEFINED ENV{ITK_WASM_MEMORY64} AND "$ENV{ITK_WASM_MEMORY64}")
+  set(_itk_wasm_memory64_default ON)
+else()
+  set(_itk_wasm_memory64_default OFF)
+endif()
+option(ITK_WASM_MEMORY64 "Build with WebAssembly memory64" ${_itk_wasm_memory64_default})
+if(ITK_WASM_MEMORY64 AND EMSCRIPTEN)
+  string(APPEND CMAKE_C_FLAGS " -s MEMORY64=1")
+  string(APPEND CMAKE_CXX_FLAGS " -s MEMORY64=1")
+  set(_itk_wasm_memory64_link_flags " -s MEMORY64=1 -s MAXIMUM_MEMORY=16GB")
+endif()
+
+# Run pipeline initialization, i.e. static constructors and ITK object
+# factory registration, at build time. WASI pipelines are snapshotted after
+# itk_wasm_snapshot_initialize with Wizer, and the runtimes skip _initialize
+# when itk_wasm_snapshotted returns 1. Emscripten pipelines evaluate their
+# static constructors at link time. Not available with ITK_WASM_THREADS:
+# Wizer does not snapshot shared memory.
+if(DEFINED ENV{ITK_WASM_SNAPSHOT} AND "$ENV{ITK_WASM_SNAPSHOT}")
+  set(_itk_wasm_snapshot_default ON)
+else()
+  set(_itk_wasm_snapshot_default OFF)
+endif()
+option(ITK_WASM_SNAPSHOT "Snapshot initialized pipelines at build time" ${_itk_wasm_snapshot_default})
+if(ITK_WASM_SNAPSHOT AND NOT ITK_WASM_THREADS)
+  if(EMSCRIPTEN)
+    set(_itk_wasm_snapshot_link_flags " -s EVAL_CTORS=1")
+  else()
+    find_program(ITK_WASM_WIZER_EXECUTABLE wizer)
+    if(NOT ITK_WASM_WIZER_EXECUTABLE)
+      message(WARNING "ITK_WASM_SNAPSHOT requires wizer, pipelines will not be snapshotted")
+    endif()
+  endif()
+endif()
+
+# Embed the --interface-json output of each pipeline in its .wasm binary as
+# the itk-wasm.interface custom section, read by bindgen and other tools
+# without instantiating the module. Requires Node.js at build time.
+option(ITK_WASM_EMBED_INTERFACE_JSON "Embed the pipeline interface JSON in a wasm custom section" ON)
+set(_itk_wasm_embed_interface_json_script "${CMAKE_CURRENT_LIST_DIR}/embed-interface-json.mjs")
+if(ITK_WASM_EMBED_INTERFACE_JSON)
+  find_program(ITK_WASM_NODE_EXECUTABLE node)
+  if(NOT ITK_WASM_NODE_EXECUTABLE OR NOT EXISTS "${_itk_wasm_embed_interface_json_script}")
+    message(WARNING "ITK_WASM_EMBED_INTERFACE_JSON requires node and embed-interface-json.mjs, the interface JSON will not be embedded")
+  endif()
+endif()
+
 function(kebab_to_camel kebab camel)
   set(result "${kebab}")
   while(result MATCHES "-([a-z])")
@@ -36,11 +112,16 @@ set(_add_executable add_executable)
 function(add_executable target)
   set(wasm_target ${target})
   _add_executable(${wasm_target} ${ARGN})
+  if(ITK_WASM_MEMORY64 AND EMSCRIPTEN)
+    set_property(TARGET ${wasm_target} PROPERTY OUTPUT_NAME "${target}.memory64")
+  elseif(ITK_WASM_THREADS)
+    set_property(TARGET ${wasm_target} PROPERTY OUTPUT_NAME "${target}.threads")
+  endif()
   if(EMSCRIPTEN)
     kebab_to_camel(${target} targetCamel)
     get_property(_link_flags TARGET ${target} PROPERTY LINK_FLAGS)
     set(common_link_flags " -s FORCE_FILESYSTEM=1 -s
-    EXPORTED_RUNTIME_METHODS='[\"callMain\",\"cwrap\",\"ccall\",\"writeArrayToMemory\",\"lengthBytesUTF8\",\"stringToUTF8\",\"UTF8ToString\", \"stackSave\", \"stackRestore\"]' -flto -s  ALLOW_MEMORY_GROWTH=1 -s MAXIMUM_MEMORY=4GB -s WASM=1 -lnodefs.js -s WASM_ASYNC_COMPILATION=1 -s EXPORT_NAME=${targetCamel} -s MODULARIZE=1 -s EXIT_RUNTIME=0 -s INVOKE_RUN=0 --pre-js /ITKWebAssemblyInterface/src/emscripten-module/itkJSPipelinePre.js --post-js /ITKWebAssemblyInterface/src/emscripten-module/itkJSPost.js -s ERROR_ON_UNDEFINED_SYMBOLS=0 -s EXPORTED_FUNCTIONS='[\"_main\"]' ${_link_flags}")
+    EXPORTED_RUNTIME_METHODS='[\"callMain\",\"cwrap\",\"ccall\",\"writeArrayToMemory\",\"lengthBytesUTF8\",\"stringToUTF8\",\"UTF8ToString\", \"stackSave\", \"stackRestore\"]' -flto -s  ALLOW_MEMORY_GROWTH=1 -s MAXIMUM_MEMORY=4GB -s WASM=1 -lnodefs.js -s WASM_ASYNC_COMPILATION=1 -s EXPORT_NAME=${targetCamel} -s MODULARIZE=1 -s EXIT_RUNTIME=0 -s INVOKE_RUN=0 --pre-js /ITKWebAssemblyInterface/src/emscripten-module/itkJSPipelinePre.js --post-js /ITKWebAssemblyInterface/src/emscripten-module/itkJSPost.js -s ERROR_ON_UNDEFINED_SYMBOLS=0 -s EXPORTED_FUNCTIONS='[\"_main\"]'${_itk_wasm_threads_link_flags}${_itk_wasm_memory64_link_flags}${_itk_wasm_snapshot_link_flags} ${_link_flags}")
     set_property(TARGET ${wasm_target} PROPERTY LINK_FLAGS "${common_link_flags} -s EXPORT_ES6=1 -s USE_ES6_IMPORT_META=1")
 
     get_property(_include_dirs TARGET ${target} PROPERTY INCLUDE_DIRECTORIES)
@@ -50,6 +131,13 @@ function(add_executable target)
 
     get_property(_is_imported TARGET ${target} PROPERTY IMPORTED)
     if (NOT ${_is_imported})
+      if(ITK_WASM_EMBED_INTERFACE_JSON AND ITK_WASM_NODE_EXECUTABLE AND EXISTS "${_itk_wasm_embed_interface_json_script}")
+        # Before the compressed copy is made
+        add_custom_command(TARGET ${target}
+          POST_BUILD
+          COMMAND ${ITK_WASM_NODE_EXECUTABLE} "${_itk_wasm_embed_interface_json_script}" "$<TARGET_FILE_DIR:${target}>/$<TARGET_FILE_BASE_NAME:${target}>.wasm"
+          )
+      endif()
       add_custom_command(TARGET ${target}
         POST_BUILD
         COMMAND /usr/bin/zstd -f "$<TARGET_FILE_DIR:${target}>/$<TARGET_FILE_BASE_NAME:${target}>.wasm" -o "$<TARGET_FILE_DIR:${target}>/$<TARGET_FILE_BASE_NAME:${target}>.wasm.zst"
@@ -66,7 +154,21 @@ function(add_executable target)
       _target_link_libraries(${target} PRIVATE $<$<LINK_LANGUAGE:CXX>:wasi-itk-extras>)
       get_property(_link_flags TARGET ${wasm_target} PROPERTY LINK_FLAGS)
       set_property(TARGET ${wasm_target} PROPERTY LINK_FLAGS
-        "-mexec-model=reactor -Wl,--export-if-defined=itk_wasm_input_array_alloc -Wl,--export-if-defined=itk_wasm_input_json_alloc -Wl,--export-if-defined=itk_wasm_output_json_address -Wl,--export-if-defined=itk_wasm_output_json_size -Wl,--export-if-defined=itk_wasm_output_array_address -Wl,--export-if-defined=itk_wasm_output_array_size -Wl,--export-if-defined=itk_wasm_free_all -Wl,--export-if-defined=_start -Wl,--export-if-defined=itk_wasm_delayed_start -Wl,--export-if-defined=itk_wasm_delayed_exit ${_link_flags}")
+        "-mexec-model=reactor -Wl,--export-if-defined=itk_wasm_input_array_alloc -Wl,--export-if-defined=itk_wasm_input_array_reserve -Wl,--export-if-defined=itk_wasm_input_array_append -Wl,--export-if-defined=itk_wasm_input_json_alloc -Wl,--export-if-defined=itk_wasm_output_exists -Wl,--export-if-defined=itk_wasm_output_json_address -Wl,--export-if-defined=itk_wasm_output_json_size -Wl,--export-if-defined=itk_wasm_output_array_address -Wl,--export-if-defined=itk_wasm_output_array_size -Wl,--export-if-defined=itk_wasm_output_array_bind -Wl,--export-if-defined=itk_wasm_free_all -Wl,--export-if-defined=itk_wasm_result_cache_capacity -Wl,--export-if-defined=itk_wasm_memory_stats -Wl,--export-if-defined=itk_wasm_request_abort -Wl,--export-if-defined=itk_wasm_abort_flag_address -Wl,--export-if-defined=itk_wasm_memory_stats_size -Wl,--export-if-defined=itk_wasm_free_input -Wl,--export-if-defined=itk_wasm_free_input_json -Wl,--export-if-defined=itk_wasm_free_output -Wl,--export-if-defined=itk_wasm_buffer_pool_clear -Wl,--export-if-defined=itk_wasm_buffer_pool_capacity -Wl,--export-if-defined=itk_wasm_image_descriptor_size -Wl,--export-if-defined=itk_wasm_input_image_descriptor_alloc -Wl,--export-if-defined=itk_wasm_output_image_descriptor_address -Wl,--export-if-defined=itk_wasm_use_image_descriptors -Wl,--export-if-defined=itk_wasm_use_cbor_metadata -Wl,--export-if-defined=itk_wasm_use_planar_layout -Wl,--export-if-defined=itk_wasm_use_strided_views -Wl,--export-if-defined=itk_wasm_input_array_handoff -Wl,--export-if-defined=itk_wasm_input_retain -Wl,--export-if-defined=itk_wasm_patch_image_region -Wl,--export-if-defined=itk_wasm_patch_image_runs -Wl,--export-if-defined=itk_wasm_release_handle -Wl,--export-if-defined=itk_wasm_release_all_handles -Wl,--export-if-defined=itk_wasm_memory_session_create -Wl,--export-if-defined=itk_wasm_memory_session_destroy -Wl,--export-if-defined=_start -Wl,--export-if-defined=itk_wasm_delayed_start -Wl,--export-if-defined=itk_wasm_delayed_exit -Wl,--export-if-defined=itk_wasm_reactor_args_alloc -Wl,--export-if-defined=itk_wasm_reactor_run -Wl,--export-if-defined=itk_wasm_snapshot_initialize -Wl,--export-if-defined=itk_wasm_snapshotted ${_itk_wasm_threads_link_flags} ${_link_flags}")
+      if(ITK_WASM_SNAPSHOT AND NOT ITK_WASM_THREADS AND ITK_WASM_WIZER_EXECUTABLE)
+        add_custom_command(TARGET ${wasm_target}
+          POST_BUILD
+          COMMAND ${ITK_WASM_WIZER_EXECUTABLE} --allow-wasi --wasm-bulk-memory true --wasm-simd true --init-func itk_wasm_snapshot_initialize -o "$<TARGET_FILE:${wasm_target}>.snapshot" "$<TARGET_FILE:${wasm_target}>"
+          COMMAND ${CMAKE_COMMAND} -E rename "$<TARGET_FILE:${wasm_target}>.snapshot" "$<TARGET_FILE:${wasm_target}>"
+          )
+      endif()
+      if(ITK_WASM_EMBED_INTERFACE_JSON AND ITK_WASM_NODE_EXECUTABLE AND EXISTS "${_itk_wasm_embed_interface_json_script}")
+        # After the snapshot, which does not keep custom sections
+        add_custom_command(TARGET ${wasm_target}
+          POST_BUILD
+          COMMAND ${ITK_WASM_NODE_EXECUTABLE} "${_itk_wasm_embed_interface_json_script}" "$<TARGET_FILE:${wasm_target}>"
+          )
+      endif()
       if(NOT ITK_WASM_NO_INTERFACE_LINK)
         if(NOT TARGET WebAssemblyInterface)
           find_package(ITK QUIET COMPONENTS WebAssemblyInterface)
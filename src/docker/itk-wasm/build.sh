@@ -23,6 +23,8 @@ BUILD_DATE=$(date -u +"%Y-%m-%dT%H:%M:%SZ")
 
 debug=false
 wasi=false
+threads=false
+memory64=false
 version_tag=false
 build_cmd="build"
 tag_flag="--tag"
@@ -32,6 +34,10 @@ for param; do
     debug=true
   elif [[ $param == '--with-wasi' ]]; then
     wasi=true
+  elif [[ $param == '--with-threads' ]]; then
+    threads=true
+  elif [[ $param == '--with-memory64' ]]; then
+    memory64=true
   elif [[ $param == '--multiarch' ]]; then
     # Newer buildah (1.28.2) required for multiarch
     exe=buildah
@@ -54,7 +60,13 @@ if $create_manifest; then
       itk-wasm/wasi:latest \
       itk-wasm/wasi:${TAG} \
       itk-wasm/wasi:latest-debug \
-      itk-wasm/wasi:${TAG}-debug; do
+      itk-wasm/wasi:${TAG}-debug \
+      itk-wasm/emscripten:latest-threads \
+      itk-wasm/emscripten:${TAG}-threads \
+      itk-wasm/wasi:latest-threads \
+      itk-wasm/wasi:${TAG}-threads \
+      itk-wasm/emscripten:latest-memory64 \
+      itk-wasm/emscripten:${TAG}-memory64; do
     if $(buildah manifest exists $list); then
       buildah manifest rm $list
     fi
@@ -149,5 +161,79 @@ if $debug; then
   fi
 fi
 
+if $threads; then
+  $exe $build_cmd --pull=false $tag_flag itkwasm/emscripten:latest-threads \
+          --build-arg IMAGE=itkwasm/emscripten \
+          --build-arg CMAKE_BUILD_TYPE=Release \
+          --build-arg BASE_IMAGE=itkwasm/emscripten-base \
+          --build-arg BASE_TAG=latest-threads \
+          --build-arg VERSION=latest-threads \
+          --build-arg VCS_REF=${VCS_REF} \
+          --build-arg VCS_URL=${VCS_URL} \
+          --build-arg BUILD_DATE=${BUILD_DATE} \
+          $script_dir $@
+  if $version_tag; then
+        $exe $build_cmd --pull=false $tag_flag itkwasm/emscripten:${TAG}-threads \
+                --build-arg IMAGE=itkwasm/emscripten \
+                --build-arg CMAKE_BUILD_TYPE=Release \
+                --build-arg BASE_IMAGE=itkwasm/emscripten-base \
+                --build-arg BASE_TAG=${TAG}-threads \
+                --build-arg VERSION=${TAG}-threads \
+                --build-arg VCS_REF=${VCS_REF} \
+                --build-arg VCS_URL=${VCS_URL} \
+                --build-arg BUILD_DATE=${BUILD_DATE} \
+                $script_dir $@
+  fi
+  if $wasi; then
+    $exe $build_cmd --pull=false $tag_flag itkwasm/wasi:latest-threads \
+            --build-arg IMAGE=itkwasm/wasi \
+            --build-arg CMAKE_BUILD_TYPE=Release \
+            --build-arg BASE_IMAGE=itkwasm/wasi-base \
+            --build-arg BASE_TAG=latest-threads \
+            --build-arg VERSION=latest-threads \
+            --build-arg VCS_REF=${VCS_REF} \
+            --build-arg VCS_URL=${VCS_URL} \
+            --build-arg BUILD_DATE=${BUILD_DATE} \
+            $script_dir $@
+    if $version_tag; then
+        $exe $build_cmd --pull=false $tag_flag itkwasm/wasi:${TAG}-threads \
+                --build-arg IMAGE=itkwasm/wasi \
+                --build-arg CMAKE_BUILD_TYPE=Release \
+                --build-arg BASE_IMAGE=itkwasm/wasi-base \
+                --build-arg BASE_TAG=${TAG}-threads \
+                --build-arg VERSION=${TAG}-threads \
+                --build-arg VCS_REF=${VCS_REF} \
+                --build-arg VCS_URL=${VCS_URL} \
+                --build-arg BUILD_DATE=${BUILD_DATE} \
+                $script_dir $@
+    fi
+  fi
+fi
+
+if $memory64; then
+  $exe $build_cmd --pull=false $tag_flag itkwasm/emscripten:latest-memory64 \
+          --build-arg IMAGE=itkwasm/emscripten \
+          --build-arg CMAKE_BUILD_TYPE=Release \
+          --build-arg BASE_IMAGE=itkwasm/emscripten-base \
+          --build-arg BASE_TAG=latest-memory64 \
+          --build-arg VERSION=latest-memory64 \
+          --build-arg VCS_REF=${VCS_REF} \
+          --build-arg VCS_URL=${VCS_URL} \
+          --build-arg BUILD_DATE=${BUILD_DATE} \
+          $script_dir $@
+  if $version_tag; then
+        $exe $build_cmd --pull=false $tag_flag itkwasm/emscripten:${TAG}-memory64 \
+                --build-arg IMAGE=itkwasm/emscripten \
+                --build-arg CMAKE_BUILD_TYPE=Release \
+                --build-arg BASE_IMAGE=itkwasm/emscripten-base \
+                --build-arg BASE_TAG=${TAG}-memory64 \
+                --build-arg VERSION=${TAG}-memory64 \
+                --build-arg VCS_REF=${VCS_REF} \
+                --build-arg VCS_URL=${VCS_URL} \
+                --build-arg BUILD_DATE=${BUILD_DATE} \
+                $script_dir $@
+  fi
+fi
+
 
 rm -rf ITKWebAssemblyInterfaceModuleCopy median-filter-pipelineCopy
@@ -0,0 +1,148 @@
+// Embed the --interface-json output of a pipeline in its .wasm binary as the
+// itk-wasm.interface custom section, so tools read the interface without
+// instantiating the module.
+//
+// Usage: node embed-interface-json.mjs <pipeline.wasm | pipeline.wasi.wasm>
+//
+// Emscripten pipelines run from the .js module next to the .wasm, WASI
+// pipelines with the Node.js WASI. When the interface cannot be generated,
+// e.g. the executable is not an itk::wasm::Pipeline, a warning is printed and
+// the binary is not changed.
+
+import fs from 'node:fs'
+import path from 'node:path'
+import { spawnSync } from 'node:child_process'
+import { fileURLToPath, pathToFileURL } from 'node:url'
+
+const sectionName = 'itk-wasm.interface'
+
+function encodeULEB128 (value) {
+  const bytes = []
+  do {
+    let byte = value & 0x7f
+    value = Math.floor(value / 128)
+    if (value !== 0) {
+      byte |= 0x80
+    }
+    bytes.push(byte)
+  } while (value !== 0)
+  return Buffer.from(bytes)
+}
+
+function decodeULEB128 (bytes, offset) {
+  let value = 0
+  let scale = 1
+  let byte = 0
+  do {
+    byte = bytes[offset++]
+    value += (byte & 0x7f) * scale
+    scale *= 128
+  } while (byte & 0x80)
+  return { value, offset }
+}
+
+// The binary without its itk-wasm.interface sections
+function withoutInterfaceSections (wasm) {
+  const pieces = [wasm.subarray(0, 8)]
+  let offset = 8
+  while (offset < wasm.length) {
+    const sectionStart = offset
+    const id = wasm[offset++]
+    const size = decodeULEB128(wasm, offset)
+    const contentStart = size.offset
+    const sectionEnd = contentStart + size.value
+    let keep = true
+    if (id === 0) {
+      const nameLength = decodeULEB128(wasm, contentStart)
+      const name = wasm.subarray(nameLength.offset, nameLength.offset + nameLength.value).toString('utf8')
+      keep = name !== sectionName
+    }
+    if (keep) {
+      pieces.push(wasm.subarray(sectionStart, sectionEnd))
+    }
+    offset = sectionEnd
+  }
+  return Buffer.concat(pieces)
+}
+
+function customSection (name, payload) {
+  const nameBytes = Buffer.from(name, 'utf8')
+  const content = Buffer.concat([encodeULEB128(nameBytes.length), nameBytes, payload])
+  return Buffer.concat([Buffer.from([0]), encodeULEB128(content.length), content])
+}
+
+// Run in a child process so a pipeline that exits or hangs does not take the
+// build step with it
+function interfaceJson (wasmPath) {
+  const run = spawnSync(process.execPath, ['--experimental-wasi-unstable-preview1', '--no-warnings', fileURLToPath(import.meta.url), '--print', wasmPath], {
+    encoding: 'utf8',
+    stdio: ['ignore', 'pipe', 'pipe'],
+    timeout: 120000,
+    maxBuffer: 1 << 26
+  })
+  const output = run.stdout ?? ''
+  const begin = output.indexOf('{')
+  const end = output.lastIndexOf('}')
+  if (begin < 0 || end < begin) {
+    return null
+  }
+  try {
+    return JSON.parse(output.substring(begin, end + 1))
+  } catch (error) {
+    return null
+  }
+}
+
+async function printInterfaceJson (wasmPath) {
+  if (wasmPath.endsWith('.wasi.wasm')) {
+    const { WASI } = await import('node:wasi')
+    const wasi = new WASI({ version: 'preview1', args: [path.basename(wasmPath), '--interface-json'], env: {}, preopens: {} })
+    const module = await WebAssembly.compile(fs.readFileSync(wasmPath))
+    // Host imports of optional features, e.g. progress, are not called
+    const importObject = { wasi_snapshot_preview1: wasi.wasiImport }
+    for (const moduleImport of WebAssembly.Module.imports(module)) {
+      if (moduleImport.module !== 'wasi_snapshot_preview1' && moduleImport.kind === 'function') {
+        importObject[moduleImport.module] ??= {}
+        importObject[moduleImport.module][moduleImport.name] = () => 0
+      }
+    }
+    const instance = await WebAssembly.instantiate(module, importObject)
+    if (instance.exports._start !== undefined) {
+      wasi.start(instance)
+    } else {
+      wasi.initialize(instance)
+      instance.exports['']()
+    }
+    return
+  }
+  const jsPath = wasmPath.replace(/\.wasm$/, '.js')
+  const { default: factory } = await import(pathToFileURL(jsPath).href)
+  const lines = []
+  const pipelineModule = await factory({ print: (line) => lines.push(line), printErr: () => {}, noInitialRun: true })
+  try {
+    pipelineModule.callMain(['--interface-json'])
+  } catch (error) {
+    // The pipeline exits after printing the interface
+  }
+  process.stdout.write(lines.join('\n'))
+}
+
+const args = process.argv.slice(2)
+if (args[0] === '--print') {
+  try {
+    await printInterfaceJson(path.resolve(args[1]))
+  } catch (error) {
+    // The pipeline exits after printing the interface
+  }
+  process.exit(0)
+}
+
+const wasmPath = path.resolve(args[0])
+const json = interfaceJson(wasmPath)
+if (json === null) {
+  console.warn(`Could not generate the interface of ${wasmPath}, the ${sectionName} section is not embedded`)
+  process.exit(0)
+}
+const wasm = withoutInterfaceSections(fs.readFileSync(wasmPath))
+const payload = Buffer.from(JSON.stringify(json), 'utf8')
+fs.writeFileSync(wasmPath, Buffer.concat([wasm, customSection(sectionName, payload)]))
@@ -24,9 +24,14 @@ extern "C" {
 #endif // __cplusplus
 
 #include <wasi/api.h>
+#include <stdlib.h>
+#include <string.h>
 extern void __wasm_call_ctors(void);
 extern int __main_void(void);
 extern void __wasm_call_dtors(void);
+// The application's `main(int argc, char *argv[])`. Weak because modules
+// with a zero-argument `main` do not define it.
+extern int __main_argc_argv(int argc, char *argv[]) __attribute__((weak));
 
 // No longer present with WASI SDK 19 -> 20 ?
 //extern void _initialize(void);
@@ -59,6 +64,35 @@ void _initialize_local(void) {
     __wasm_call_ctors();
 }
 
+// Snapshot builds: Wizer calls `itk_wasm_snapshot_initialize` at build time
+// and saves the initialized memory in the module, so hosts do not call
+// `_initialize` when `itk_wasm_snapshotted` returns 1. The environment and
+// preopened directories seen during initialization are those of the build, so
+// they are reset to be read again at run time.
+extern void __wasilibc_deinitialize_environ(void) __attribute__((weak));
+extern void __wasilibc_reset_preopens(void) __attribute__((weak));
+static int snapshotted = 0;
+
+__attribute__((export_name("itk_wasm_snapshot_initialize")))
+void itk_wasm_snapshot_initialize(void)
+{
+  _initialize_local();
+
+  if (__wasilibc_deinitialize_environ != NULL) {
+    __wasilibc_deinitialize_environ();
+  }
+  if (__wasilibc_reset_preopens != NULL) {
+    __wasilibc_reset_preopens();
+  }
+  snapshotted = 1;
+}
+
+__attribute__((export_name("itk_wasm_snapshotted")))
+int itk_wasm_snapshotted(void)
+{
+  return snapshotted;
+}
+
 __attribute__((export_name("itk_wasm_delayed_exit")))
 void itk_wasm_delayed_exit(int returnCode)
 {
@@ -83,11 +117,55 @@ int itk_wasm_delayed_start(void)
   return r;
 }
 
+// Reactor mode: run the pipeline's main repeatedly in the same instance.
+//
+// The host writes the NUL-terminated arguments back to back into the buffer
+// returned by `itk_wasm_reactor_args_alloc`, then calls `itk_wasm_reactor_run`
+// with the number of arguments. Constructors, the heap, and registered
+// object factories are kept between runs. `itk_wasm_delayed_exit` is not
+// called; release the memory IO store, e.g. with `itk_wasm_free_all`, after
+// the outputs have been read.
+static char * reactorArgs = NULL;
+
+__attribute__((export_name("itk_wasm_reactor_args_alloc")))
+char * itk_wasm_reactor_args_alloc(size_t size)
+{
+  free(reactorArgs);
+  reactorArgs = (char *)calloc(size + 1, 1);
+  return reactorArgs;
+}
+
+__attribute__((export_name("itk_wasm_reactor_run")))
+int itk_wasm_reactor_run(int argc)
+{
+  if (__main_argc_argv == NULL || reactorArgs == NULL) {
+    return 1;
+  }
+
+  char ** argv = (char **)calloc(argc + 1, sizeof(char *));
+  char * arg = reactorArgs;
+  for (int ii = 0; ii < argc; ++ii) {
+    argv[ii] = arg;
+    arg += strlen(arg) + 1;
+  }
+  argv[argc] = NULL;
+
+  const int returnCode = __main_argc_argv(argc, argv);
+
+  free(argv);
+  free(reactorArgs);
+  reactorArgs = NULL;
+
+  return returnCode;
+}
+
 __attribute__((export_name("")))
 void _start(void)
 {
   //_initialize();
-  _initialize_local();
+  if (!snapshotted) {
+    _initialize_local();
+  }
 
   const int returnCode = itk_wasm_delayed_start();
 
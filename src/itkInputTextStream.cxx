@@ -17,16 +17,46 @@
  *=========================================================================*/
 #include "itkInputTextStream.h"
 
+#include <cstdlib>
+#include <stdexcept>
 #include <string>
 #ifndef ITK_WASM_NO_MEMORY_IO
 #include "itkWasmExports.h"
 #endif
 
+#include "rapidjson/document.h"
+
 namespace itk
 {
 namespace wasm
 {
 
+void InputTextStream::SetJSON(const std::string & json)
+{
+  rapidjson::Document document;
+  if (document.Parse(json.c_str()).HasParseError())
+  {
+    throw std::runtime_error("Could not parse JSON");
+  }
+  // data:application/vnd.itk.address,0:<address>
+  const std::string dataString(document["data"].GetString());
+  const std::string::size_type addressStart = dataString.find(':', dataString.find(',') + 1);
+  if (addressStart == std::string::npos)
+  {
+    throw std::runtime_error("Could not parse the text stream address");
+  }
+
+  if (m_DeleteIStream && m_IStream != nullptr)
+  {
+    delete m_IStream;
+  }
+  m_Data = reinterpret_cast<const char *>(std::strtoull(dataString.c_str() + addressStart + 1, nullptr, 10));
+  m_Size = static_cast<size_t>(document["size"].GetUint64());
+  m_StreamBuffer = std::make_unique<MemoryStreamBuffer>(m_Data, m_Size);
+  m_IStream = new std::istream(m_StreamBuffer.get());
+  m_DeleteIStream = true;
+}
+
 bool lexical_cast(const std::string &input, InputTextStream &inputStream)
 {
   if (input.empty())
@@ -37,7 +67,7 @@ bool lexical_cast(const std::string &input, InputTextStream &inputStream)
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
     const unsigned int index = std::stoi(input);
-    const auto json = getMemoryStoreInputJSON(0, index);
+    const auto json = getMemoryStoreInputJSON(wasm::Pipeline::get_memory_index(), index);
     inputStream.SetJSON(json);
 #else
     return false;
@@ -0,0 +1,604 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMetaDataDictionaryCBOR.h"
+#include "itkArray.h"
+#include "itkMatrix.h"
+
+#include "itkWasmCBORSource.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+namespace
+{
+
+// RFC 8746 tag of a little-endian typed array of the element type
+template <typename TElement>
+constexpr uint64_t
+GetTypedArrayTag()
+{
+  constexpr uint64_t sizeBits = sizeof(TElement) == 1 ? 0 : sizeof(TElement) == 2 ? 1 : sizeof(TElement) == 4 ? 2 : 3;
+  if constexpr (std::is_floating_point_v<TElement>)
+  {
+    // The size bits of float16 are 0
+    return 64 + 16 + 4 + sizeBits - 1;
+  }
+  else
+  {
+    // 8-bit arrays have no byte order
+    return 64 + (std::is_signed_v<TElement> ? 8 : 0) + (sizeof(TElement) > 1 ? 4 : 0) + sizeBits;
+  }
+}
+
+template <typename TElement>
+constexpr bool IsTypedArrayElement = std::is_arithmetic_v<TElement> && !std::is_same_v<TElement, bool>;
+
+template <typename TElement>
+void WriteTypedArray(CBORSink & sink, const TElement * data, size_t size)
+{
+  sink.WriteTag(GetTypedArrayTag<TElement>());
+  sink.WriteByteString(data, size * sizeof(TElement));
+}
+
+// CBOR values of the types ITK stores in a MetaDataDictionary
+template <typename TValue>
+std::enable_if_t<std::is_arithmetic_v<TValue>>
+WriteCBORValue(CBORSink & sink, TValue value)
+{
+  if constexpr (std::is_same_v<TValue, bool>)
+  {
+    sink.WriteBool(value);
+  }
+  else if constexpr (std::is_same_v<TValue, float>)
+  {
+    sink.WriteFloat(value);
+  }
+  else if constexpr (std::is_floating_point_v<TValue>)
+  {
+    sink.WriteDouble(static_cast<double>(value));
+  }
+  else if constexpr (std::is_signed_v<TValue>)
+  {
+    sink.WriteInt(static_cast<int64_t>(value));
+  }
+  else
+  {
+    sink.WriteUInt(static_cast<uint64_t>(value));
+  }
+}
+
+void WriteCBORValue(CBORSink & sink, const std::string & value)
+{
+  sink.WriteString(value);
+}
+
+template <typename TElement>
+void WriteCBORValue(CBORSink & sink, const std::vector<TElement> & value)
+{
+  if constexpr (IsTypedArrayElement<TElement>)
+  {
+    WriteTypedArray(sink, value.data(), value.size());
+  }
+  else
+  {
+    sink.WriteArray(value.size());
+    for (const auto & element : value)
+    {
+      WriteCBORValue(sink, element);
+    }
+  }
+}
+
+template <typename TElement>
+void WriteCBORValue(CBORSink & sink, const Array<TElement> & value)
+{
+  WriteTypedArray(sink, value.data_block(), value.size());
+}
+
+// Rows of columns
+template <typename TElement, unsigned int VRows, unsigned int VColumns>
+void WriteCBORValue(CBORSink & sink, const Matrix<TElement, VRows, VColumns> & value)
+{
+  sink.WriteArray(VRows);
+  for (unsigned int ii = 0; ii < VRows; ++ii)
+  {
+    TElement row[VColumns];
+    for (unsigned int jj = 0; jj < VColumns; ++jj)
+    {
+      row[jj] = value(ii, jj);
+    }
+    WriteTypedArray(sink, row, VColumns);
+  }
+}
+
+using ToCBORConverters = std::unordered_map<std::type_index, MetaDataObjectToCBORConverter>;
+
+template <typename TValue>
+void AddToCBORConverter(ToCBORConverters & converters)
+{
+  converters[std::type_index(typeid(MetaDataObject<TValue>))] = [](const MetaDataObjectBase & object, CBORSink & sink)
+  {
+    WriteCBORValue(sink, static_cast<const MetaDataObject<TValue> &>(object).GetMetaDataObjectValue());
+  };
+}
+
+// Built once, on first use
+ToCBORConverters & GetToCBORConverters()
+{
+  static ToCBORConverters converters = []()
+  {
+    ToCBORConverters defaults;
+    AddToCBORConverter<bool>(defaults);
+    AddToCBORConverter<char>(defaults);
+    AddToCBORConverter<signed char>(defaults);
+    AddToCBORConverter<unsigned char>(defaults);
+    AddToCBORConverter<short>(defaults);
+    AddToCBORConverter<unsigned short>(defaults);
+    AddToCBORConverter<int>(defaults);
+    AddToCBORConverter<unsigned int>(defaults);
+    AddToCBORConverter<long>(defaults);
+    AddToCBORConverter<unsigned long>(defaults);
+    AddToCBORConverter<long long>(defaults);
+    AddToCBORConverter<unsigned long long>(defaults);
+    AddToCBORConverter<float>(defaults);
+    AddToCBORConverter<double>(defaults);
+    AddToCBORConverter<std::string>(defaults);
+    AddToCBORConverter<std::vector<int>>(defaults);
+    AddToCBORConverter<std::vector<unsigned int>>(defaults);
+    AddToCBORConverter<std::vector<int64_t>>(defaults);
+    AddToCBORConverter<std::vector<uint64_t>>(defaults);
+    AddToCBORConverter<std::vector<float>>(defaults);
+    AddToCBORConverter<std::vector<double>>(defaults);
+    AddToCBORConverter<std::vector<std::string>>(defaults);
+    AddToCBORConverter<std::vector<std::vector<int>>>(defaults);
+    AddToCBORConverter<std::vector<std::vector<unsigned int>>>(defaults);
+    AddToCBORConverter<std::vector<std::vector<int64_t>>>(defaults);
+    AddToCBORConverter<std::vector<std::vector<uint64_t>>>(defaults);
+    AddToCBORConverter<std::vector<std::vector<float>>>(defaults);
+    AddToCBORConverter<std::vector<std::vector<double>>>(defaults);
+    AddToCBORConverter<std::vector<std::vector<std::string>>>(defaults);
+    AddToCBORConverter<Array<char>>(defaults);
+    AddToCBORConverter<Array<int>>(defaults);
+    AddToCBORConverter<Array<float>>(defaults);
+    AddToCBORConverter<Array<double>>(defaults);
+    AddToCBORConverter<Matrix<float, 4, 4>>(defaults);
+    AddToCBORConverter<Matrix<double>>(defaults);
+    return defaults;
+  }();
+  return converters;
+}
+
+// Reads the items of an encoded buffer
+class CBORCursor
+{
+public:
+  CBORCursor(const unsigned char * data, size_t size)
+    : m_Data(data)
+    , m_Remaining(size)
+  {}
+
+  bool
+  ReadHead(CBORHead & head)
+  {
+    MemoryCBORSource source(m_Data, m_Remaining);
+    return ReadCBORHead(source, head) && this->ReadBytes(head.size) != nullptr;
+  }
+
+  // The next size bytes, or nullptr if fewer remain
+  const unsigned char *
+  ReadBytes(uint64_t size)
+  {
+    if (size > m_Remaining)
+    {
+      return nullptr;
+    }
+    const unsigned char * bytes = m_Data;
+    m_Data += size;
+    m_Remaining -= static_cast<size_t>(size);
+    return bytes;
+  }
+
+  bool
+  SkipItem()
+  {
+    CBORHead head;
+    if (!this->ReadHead(head))
+    {
+      return false;
+    }
+    switch (head.majorType)
+    {
+      case 2: // byte string
+      case 3: // text string
+        return this->ReadBytes(head.argument) != nullptr;
+      case 4: // array
+      case 5: // map
+      {
+        if (head.argument > m_Remaining)
+        {
+          // Each item is at least one byte
+          return false;
+        }
+        const uint64_t count = head.majorType == 5 ? 2 * head.argument : head.argument;
+        for (uint64_t ii = 0; ii < count; ++ii)
+        {
+          if (!this->SkipItem())
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+      case 6: // tag
+        return this->SkipItem();
+      default: // integers, floats and simple values
+        return true;
+    }
+  }
+
+private:
+  const unsigned char * m_Data;
+  size_t                m_Remaining;
+};
+
+template <typename TElement>
+struct ElementType
+{
+  using Type = TElement;
+};
+
+// Call function with the ElementType of a typed array tag. Returns false for
+// other tags.
+template <typename TFunction>
+bool VisitTypedArrayTag(uint64_t tag, TFunction && function)
+{
+  switch (tag)
+  {
+    case GetTypedArrayTag<uint8_t>():
+      return function(ElementType<uint8_t>{});
+    case GetTypedArrayTag<int8_t>():
+      return function(ElementType<int8_t>{});
+    case GetTypedArrayTag<uint16_t>():
+      return function(ElementType<uint16_t>{});
+    case GetTypedArrayTag<int16_t>():
+      return function(ElementType<int16_t>{});
+    case GetTypedArrayTag<uint32_t>():
+      return function(ElementType<unsigned int>{});
+    case GetTypedArrayTag<int32_t>():
+      return function(ElementType<int>{});
+    case GetTypedArrayTag<uint64_t>():
+      return function(ElementType<uint64_t>{});
+    case GetTypedArrayTag<int64_t>():
+      return function(ElementType<int64_t>{});
+    case GetTypedArrayTag<float>():
+      return function(ElementType<float>{});
+    case GetTypedArrayTag<double>():
+      return function(ElementType<double>{});
+    default:
+      return false;
+  }
+}
+
+// The byte string of a typed array, after its tag
+template <typename TElement>
+bool ReadTypedArrayContent(CBORCursor & cursor, std::vector<TElement> & values)
+{
+  CBORHead head;
+  if (!cursor.ReadHead(head) || head.majorType != 2 || head.argument % sizeof(TElement) != 0)
+  {
+    return false;
+  }
+  const unsigned char * bytes = cursor.ReadBytes(head.argument);
+  if (bytes == nullptr)
+  {
+    return false;
+  }
+  values.resize(static_cast<size_t>(head.argument / sizeof(TElement)));
+  if (!values.empty())
+  {
+    std::memcpy(values.data(), bytes, static_cast<size_t>(head.argument));
+  }
+  return true;
+}
+
+bool ReadString(CBORCursor & cursor, std::string & value)
+{
+  CBORHead head;
+  if (!cursor.ReadHead(head) || head.majorType != 3)
+  {
+    return false;
+  }
+  const unsigned char * bytes = cursor.ReadBytes(head.argument);
+  if (bytes == nullptr)
+  {
+    return false;
+  }
+  value.assign(reinterpret_cast<const char *>(bytes), static_cast<size_t>(head.argument));
+  return true;
+}
+
+bool ReadStrings(CBORCursor & cursor, uint64_t count, std::vector<std::string> & values)
+{
+  values.resize(static_cast<size_t>(count));
+  for (auto & value : values)
+  {
+    if (!ReadString(cursor, value))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The elements of an array, whose kind is that of the first element
+bool ReadArray(CBORCursor & cursor, uint64_t count, const std::string & key, MetaDataDictionary & dictionary)
+{
+  if (count == 0)
+  {
+    EncapsulateMetaData<std::vector<std::string>>(dictionary, key, std::vector<std::string>());
+    return true;
+  }
+  CBORHead firstHead;
+  CBORCursor firstCursor = cursor;
+  if (!firstCursor.ReadHead(firstHead))
+  {
+    return false;
+  }
+
+  switch (firstHead.majorType)
+  {
+    case 3:
+    {
+      std::vector<std::string> values;
+      if (!ReadStrings(cursor, count, values))
+      {
+        return false;
+      }
+      EncapsulateMetaData<std::vector<std::string>>(dictionary, key, values);
+      return true;
+    }
+    case 4:
+    {
+      std::vector<std::vector<std::string>> values(static_cast<size_t>(count));
+      for (auto & value : values)
+      {
+        CBORHead head;
+        if (!cursor.ReadHead(head) || head.majorType != 4 || !ReadStrings(cursor, head.argument, value))
+        {
+          return false;
+        }
+      }
+      EncapsulateMetaData<std::vector<std::vector<std::string>>>(dictionary, key, values);
+      return true;
+    }
+    case 6:
+    {
+      const uint64_t tag = firstHead.argument;
+      return VisitTypedArrayTag(tag, [&](auto elementType)
+      {
+        using Element = typename decltype(elementType)::Type;
+        std::vector<std::vector<Element>> values(static_cast<size_t>(count));
+        for (auto & value : values)
+        {
+          CBORHead head;
+          if (!cursor.ReadHead(head) || head.majorType != 6 || head.argument != tag || !ReadTypedArrayContent(cursor, value))
+          {
+            return false;
+          }
+        }
+        EncapsulateMetaData<std::vector<std::vector<Element>>>(dictionary, key, values);
+        return true;
+      });
+    }
+    default:
+      return false;
+  }
+}
+
+// Returns false for unsupported values
+bool ReadValue(CBORCursor & cursor, const std::string & key, MetaDataDictionary & dictionary)
+{
+  CBORHead head;
+  if (!cursor.ReadHead(head))
+  {
+    return false;
+  }
+  switch (head.majorType)
+  {
+    case 0:
+      if (head.argument <= static_cast<uint64_t>(std::numeric_limits<int>::max()))
+      {
+        EncapsulateMetaData<int>(dictionary, key, static_cast<int>(head.argument));
+      }
+      else if (head.argument <= std::numeric_limits<unsigned int>::max())
+      {
+        EncapsulateMetaData<unsigned int>(dictionary, key, static_cast<unsigned int>(head.argument));
+      }
+      else if (head.argument <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+      {
+        EncapsulateMetaData<int64_t>(dictionary, key, static_cast<int64_t>(head.argument));
+      }
+      else
+      {
+        EncapsulateMetaData<uint64_t>(dictionary, key, head.argument);
+      }
+      return true;
+    case 1:
+      // The value is -1 - argument
+      if (head.argument <= static_cast<uint64_t>(std::numeric_limits<int>::max()))
+      {
+        EncapsulateMetaData<int>(dictionary, key, -1 - static_cast<int>(head.argument));
+      }
+      else if (head.argument <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+      {
+        EncapsulateMetaData<int64_t>(dictionary, key, -1 - static_cast<int64_t>(head.argument));
+      }
+      else
+      {
+        return false;
+      }
+      return true;
+    case 3:
+    {
+      const unsigned char * bytes = cursor.ReadBytes(head.argument);
+      if (bytes == nullptr)
+      {
+        return false;
+      }
+      EncapsulateMetaData<std::string>(dictionary, key, std::string(reinterpret_cast<const char *>(bytes), static_cast<size_t>(head.argument)));
+      return true;
+    }
+    case 4:
+      return ReadArray(cursor, head.argument, key, dictionary);
+    case 6:
+      return VisitTypedArrayTag(head.argument, [&](auto elementType)
+      {
+        using Element = typename decltype(elementType)::Type;
+        std::vector<Element> values;
+        if (!ReadTypedArrayContent(cursor, values))
+        {
+          return false;
+        }
+        EncapsulateMetaData<std::vector<Element>>(dictionary, key, values);
+        return true;
+      });
+    case 7:
+      switch (head.bytes[0] & 0x1f)
+      {
+        case 20:
+        case 21:
+          EncapsulateMetaData<bool>(dictionary, key, head.argument == 21);
+          return true;
+        case 26:
+        {
+          const auto bits = static_cast<uint32_t>(head.argument);
+          float value;
+          std::memcpy(&value, &bits, sizeof(value));
+          EncapsulateMetaData<float>(dictionary, key, value);
+          return true;
+        }
+        case 27:
+        {
+          double value;
+          std::memcpy(&value, &head.argument, sizeof(value));
+          EncapsulateMetaData<double>(dictionary, key, value);
+          return true;
+        }
+        default:
+          // Half floats, nulls and undefined
+          return false;
+      }
+    default:
+      // Byte strings and maps
+      return false;
+  }
+}
+
+} // end anonymous namespace
+
+void WriteCBORMetaDataDictionary(CBORSink & sink, const MetaDataDictionary & dictionary, const MetaDataKeyFilter & keyFilter)
+{
+  struct Entry
+  {
+    const std::string *                   key;
+    const MetaDataObjectBase *            object;
+    const MetaDataObjectToCBORConverter * converter;
+  };
+  const ToCBORConverters & converters = GetToCBORConverters();
+  const bool filtered = keyFilter.IsEnabled();
+  std::vector<Entry> entries;
+  for (auto itr = dictionary.Begin(); itr != dictionary.End(); ++itr)
+  {
+    const MetaDataObjectBase * object = itr->second.GetPointer();
+    if (object == nullptr || (filtered && !keyFilter.Accepts(itr->first)))
+    {
+      continue;
+    }
+    const auto converter = converters.find(std::type_index(typeid(*object)));
+    if (converter != converters.end())
+    {
+      entries.push_back({ &itr->first, object, &converter->second });
+    }
+  }
+
+  sink.WriteMap(entries.size());
+  for (const Entry & entry : entries)
+  {
+    sink.WriteString(*entry.key);
+    (*entry.converter)(*entry.object, sink);
+  }
+}
+
+bool ReadCBORMetaDataDictionary(const unsigned char * data, size_t size, MetaDataDictionary & dictionary, const MetaDataKeyFilter & keyFilter)
+{
+  CBORCursor cursor(data, size);
+  CBORHead mapHead;
+  if (!cursor.ReadHead(mapHead) || mapHead.majorType != 5)
+  {
+    return false;
+  }
+  const bool filtered = keyFilter.IsEnabled();
+  std::string key;
+  for (uint64_t ii = 0; ii < mapHead.argument; ++ii)
+  {
+    if (!ReadString(cursor, key))
+    {
+      return false;
+    }
+    // Rejected and unsupported values are skipped past their extent
+    CBORCursor valueCursor = cursor;
+    if (!cursor.SkipItem())
+    {
+      return false;
+    }
+    if (!filtered || keyFilter.Accepts(key))
+    {
+      ReadValue(valueCursor, key, dictionary);
+    }
+  }
+  return true;
+}
+
+void RegisterMetaDataObjectToCBORConverter(const std::type_info & metaDataObjectType, MetaDataObjectToCBORConverter converter)
+{
+  ToCBORConverters & converters = GetToCBORConverters();
+  if (converter)
+  {
+    converters[std::type_index(metaDataObjectType)] = std::move(converter);
+  }
+  else
+  {
+    converters.erase(std::type_index(metaDataObjectType));
+  }
+}
+
+} // end namespace wasm
+} // end namespace itk
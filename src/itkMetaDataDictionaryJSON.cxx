@@ -16,6 +16,15 @@
  *
  *=========================================================================*/
 #include "itkMetaDataDictionaryJSON.h"
+#include "itkWasmTrace.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace itk
 {
@@ -23,782 +32,428 @@ namespace itk
 namespace wasm
 {
 
-void ConvertMetaDataDictionaryToJSON(const itk::MetaDataDictionary & dictionary, rapidjson::Value & metadataJson, rapidjson::Document::AllocatorType& allocator)
+namespace
 {
-  auto itr = dictionary.Begin();
-  auto end = dictionary.End();
-  while (itr != end)
-  {
-    // rapidjson types
-    using MetaDataBoolType = MetaDataObject<bool>;
-    using MetaDataIntType = MetaDataObject<int>;
-    using MetaDataUintType = MetaDataObject<unsigned int>;
-    using MetaDataInt64Type = MetaDataObject<int64_t>;
-    using MetaDataUint64Type = MetaDataObject<uint64_t>;
-    using MetaDataFloatType = MetaDataObject<float>;
-    using MetaDataDoubleType = MetaDataObject<double>;
-    using MetaDataStringType = MetaDataObject<std::string>;
-    using MetaDataVectorIntType = MetaDataObject<std::vector<int>>;
-    using MetaDataVectorUintType = MetaDataObject<std::vector<unsigned int>>;
-    using MetaDataVectorInt64Type = MetaDataObject<std::vector<int64_t>>;
-    using MetaDataVectorUint64Type = MetaDataObject<std::vector<uint64_t>>;
-    using MetaDataVectorFloatType = MetaDataObject<std::vector<float>>;
-    using MetaDataVectorDoubleType = MetaDataObject<std::vector<double>>;
-    using MetaDataVectorStringType = MetaDataObject<std::vector<std::string>>;
-    using MetaDataVectorVectorIntType = MetaDataObject<std::vector<std::vector<int>>>;
-    using MetaDataVectorVectorUintType = MetaDataObject<std::vector<std::vector<unsigned int>>>;
-    using MetaDataVectorVectorInt64Type = MetaDataObject<std::vector<std::vector<int64_t>>>;
-    using MetaDataVectorVectorUint64Type = MetaDataObject<std::vector<std::vector<uint64_t>>>;
-    using MetaDataVectorVectorFloatType = MetaDataObject<std::vector<std::vector<float>>>;
-    using MetaDataVectorVectorDoubleType = MetaDataObject<std::vector<std::vector<double>>>;
-
-    // Additional ITK used MetaDataDictionary types
-    // see ITK/Modules/Core/Common/src/itkMetaDataObject.cxx
-    using MetaDataUcharType = MetaDataObject<unsigned char>;
-    using MetaDataCharType = MetaDataObject<char>;
-    using MetaDataSignedCharType = MetaDataObject<signed char>;
-    using MetaDataUshortType = MetaDataObject<unsigned short>;
-    using MetaDataShortType = MetaDataObject<short>;
-    using MetaDataUlongType = MetaDataObject<unsigned long>;
-    using MetaDataLongType = MetaDataObject<long>;
-    using MetaDataUlongLongType = MetaDataObject<unsigned long long>;
-    using MetaDataLongLongType = MetaDataObject<long long>;
-    using MetaDataArrayCharType = MetaDataObject<Array<char>>;
-    using MetaDataArrayIntType = MetaDataObject<Array<int>>;
-    using MetaDataArrayFloatType = MetaDataObject<Array<float>>;
-    using MetaDataArrayDoubleType = MetaDataObject<Array<double>>;
-    using MetaDataMatrixFloat44Type = MetaDataObject<Matrix<float, 4, 4>>;
-    using MetaDataMatrixDoubleType = MetaDataObject<Matrix<double>>;
-
-    MetaDataObjectBase::Pointer entry = itr->second;
-    rapidjson::Value entryJson(rapidjson::kArrayType);
-    const std::string key = itr->first;
-    entryJson.PushBack(rapidjson::Value().SetString(key.c_str(), allocator), allocator);
 
-    const auto boolValue = dynamic_cast<MetaDataBoolType *>(entry.GetPointer());
-    if (boolValue)
-    {
-      const bool value = boolValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetBool(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto intValue = dynamic_cast<MetaDataIntType *>(entry.GetPointer());
-    if (intValue)
-    {
-      const int value = intValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetInt(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto uintValue = dynamic_cast<MetaDataUintType *>(entry.GetPointer());
-    if (uintValue)
-    {
-      const unsigned int value = uintValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetUint(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto int64Value = dynamic_cast<MetaDataInt64Type *>(entry.GetPointer());
-    if (int64Value)
-    {
-      const int64_t value = int64Value->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetInt64(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto uint64Value = dynamic_cast<MetaDataUint64Type *>(entry.GetPointer());
-    if (uint64Value)
-    {
-      const uint64_t value = uint64Value->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetUint64(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto doubleValue = dynamic_cast<MetaDataDoubleType *>(entry.GetPointer());
-    if (doubleValue)
-    {
-      const double value = doubleValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetDouble(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto floatValue = dynamic_cast<MetaDataFloatType *>(entry.GetPointer());
-    if (floatValue)
-    {
-      const float value = floatValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetFloat(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto stringValue = dynamic_cast<MetaDataStringType *>(entry.GetPointer());
-    if (stringValue)
-    {
-      const std::string value = stringValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetString(value.c_str(), allocator), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
+using AllocatorType = rapidjson::Document::AllocatorType;
 
-    const auto intVectorValue = dynamic_cast<MetaDataVectorIntType *>(entry.GetPointer());
-    if (intVectorValue)
-    {
-      const std::vector<int> value = intVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetInt(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto uintVectorValue = dynamic_cast<MetaDataVectorUintType *>(entry.GetPointer());
-    if (uintVectorValue)
-    {
-      const std::vector<unsigned int> value = uintVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetUint(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto int64VectorValue = dynamic_cast<MetaDataVectorInt64Type *>(entry.GetPointer());
-    if (int64VectorValue)
-    {
-      const std::vector<int64_t> value = int64VectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetInt64(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto uint64VectorValue = dynamic_cast<MetaDataVectorUint64Type *>(entry.GetPointer());
-    if (uint64VectorValue)
-    {
-      const std::vector<uint64_t> value = uint64VectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetUint64(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto doubleVectorValue = dynamic_cast<MetaDataVectorDoubleType *>(entry.GetPointer());
-    if (doubleVectorValue)
-    {
-      const std::vector<double> value = doubleVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetDouble(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto floatVectorValue = dynamic_cast<MetaDataVectorFloatType *>(entry.GetPointer());
-    if (floatVectorValue)
-    {
-      const std::vector<float> value = floatVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetFloat(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto stringVectorValue = dynamic_cast<MetaDataVectorStringType *>(entry.GetPointer());
-    if (stringVectorValue)
+// JSON values of the types ITK stores in a MetaDataDictionary,
+// see ITK/Modules/Core/Common/src/itkMetaDataObject.cxx
+void SetJSONValue(bool value, rapidjson::Value & valueJson, AllocatorType &) { valueJson.SetBool(value); }
+void SetJSONValue(char value, rapidjson::Value & valueJson, AllocatorType &) { valueJson.SetInt(value); }
+void SetJSONValue(signed char value, rapidjson::Value & valueJson, AllocatorType &) { valueJson.SetInt(value); }
+void SetJSONValue(unsigned char value, rapidjson::Value & valueJson, AllocatorType &) { valueJson.SetUint(value); }
+void SetJSONValue(short value, rapidjson::Value & valueJson, AllocatorType &) { valueJson.SetInt(value); }
+void SetJSONValue(unsigned short value, rapidjson::Value & valueJson, AllocatorType &) { valueJson.SetUint(value); }
+void SetJSONValue(int value, rapidjson::Value & valueJson, AllocatorType &) { valueJson.SetInt(value); }
+void SetJSONValue(unsigned int value, rapidjson::Value & valueJson, AllocatorType &) { valueJson.SetUint(value); }
+void SetJSONValue(long value, rapidjson::Value & valueJson, AllocatorType &) { valueJson.SetInt64(value); }
+void SetJSONValue(unsigned long value, rapidjson::Value & valueJson, AllocatorType &) { valueJson.SetUint64(value); }
+void SetJSONValue(long long value, rapidjson::Value & valueJson, AllocatorType &) { valueJson.SetInt64(value); }
+void SetJSONValue(unsigned long long value, rapidjson::Value & valueJson, AllocatorType &) { valueJson.SetUint64(value); }
+void SetJSONValue(float value, rapidjson::Value & valueJson, AllocatorType &) { valueJson.SetFloat(value); }
+void SetJSONValue(double value, rapidjson::Value & valueJson, AllocatorType &) { valueJson.SetDouble(value); }
+
+void SetJSONValue(const std::string & value, rapidjson::Value & valueJson, AllocatorType & allocator)
+{
+  valueJson.SetString(value.data(), static_cast<rapidjson::SizeType>(value.size()), allocator);
+}
+
+template <typename TIterator>
+void SetJSONArray(TIterator begin, TIterator end, rapidjson::SizeType size, rapidjson::Value & valueJson, AllocatorType & allocator);
+
+template <typename TElement>
+void SetJSONValue(const std::vector<TElement> & value, rapidjson::Value & valueJson, AllocatorType & allocator)
+{
+  SetJSONArray(value.begin(), value.end(), static_cast<rapidjson::SizeType>(value.size()), valueJson, allocator);
+}
+
+template <typename TElement>
+void SetJSONValue(const Array<TElement> & value, rapidjson::Value & valueJson, AllocatorType & allocator)
+{
+  SetJSONArray(value.begin(), value.end(), static_cast<rapidjson::SizeType>(value.size()), valueJson, allocator);
+}
+
+// Rows of columns
+template <typename TElement, unsigned int VRows, unsigned int VColumns>
+void SetJSONValue(const Matrix<TElement, VRows, VColumns> & value, rapidjson::Value & valueJson, AllocatorType & allocator)
+{
+  valueJson.SetArray();
+  valueJson.Reserve(VRows, allocator);
+  for (unsigned int ii = 0; ii < VRows; ++ii)
+  {
+    rapidjson::Value rowJson(rapidjson::kArrayType);
+    rowJson.Reserve(VColumns, allocator);
+    for (unsigned int jj = 0; jj < VColumns; ++jj)
     {
-      const std::vector<std::string> value = stringVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetString(vv.c_str(), allocator), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      rapidjson::Value elementJson;
+      SetJSONValue(value(ii, jj), elementJson, allocator);
+      rowJson.PushBack(elementJson, allocator);
     }
+    valueJson.PushBack(rowJson, allocator);
+  }
+}
+
+template <typename TIterator>
+void SetJSONArray(TIterator begin, TIterator end, rapidjson::SizeType size, rapidjson::Value & valueJson, AllocatorType & allocator)
+{
+  valueJson.SetArray();
+  valueJson.Reserve(size, allocator);
+  for (TIterator it = begin; it != end; ++it)
+  {
+    rapidjson::Value elementJson;
+    SetJSONValue(*it, elementJson, allocator);
+    valueJson.PushBack(elementJson, allocator);
+  }
+}
+
+using ToJSONConverters = std::unordered_map<std::type_index, MetaDataObjectToJSONConverter>;
 
-    const auto intVectorVectorValue = dynamic_cast<MetaDataVectorVectorIntType *>(entry.GetPointer());
-    if (intVectorVectorValue)
+template <typename TValue>
+void AddToJSONConverter(ToJSONConverters & converters)
+{
+  converters[std::type_index(typeid(MetaDataObject<TValue>))] =
+    [](const MetaDataObjectBase & object, rapidjson::Value & valueJson, AllocatorType & allocator)
     {
-      const std::vector<std::vector<int>> value = intVectorVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto aa: value)
-      {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(auto vv: value)
-        {
-          for(auto uu: vv)
-          {
-          vvJson.PushBack(rapidjson::Value().SetInt(uu), allocator);
-          }
-        }
-        valueJson.PushBack(vvJson, allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto uintVectorVectorValue = dynamic_cast<MetaDataVectorVectorUintType *>(entry.GetPointer());
-    if (uintVectorVectorValue)
+      SetJSONValue(static_cast<const MetaDataObject<TValue> &>(object).GetMetaDataObjectValue(), valueJson, allocator);
+    };
+}
+
+// Built once, on first use
+ToJSONConverters & GetToJSONConverters()
+{
+  static ToJSONConverters converters = []()
+  {
+    ToJSONConverters defaults;
+    AddToJSONConverter<bool>(defaults);
+    AddToJSONConverter<char>(defaults);
+    AddToJSONConverter<signed char>(defaults);
+    AddToJSONConverter<unsigned char>(defaults);
+    AddToJSONConverter<short>(defaults);
+    AddToJSONConverter<unsigned short>(defaults);
+    AddToJSONConverter<int>(defaults);
+    AddToJSONConverter<unsigned int>(defaults);
+    AddToJSONConverter<long>(defaults);
+    AddToJSONConverter<unsigned long>(defaults);
+    AddToJSONConverter<long long>(defaults);
+    AddToJSONConverter<unsigned long long>(defaults);
+    AddToJSONConverter<float>(defaults);
+    AddToJSONConverter<double>(defaults);
+    AddToJSONConverter<std::string>(defaults);
+    AddToJSONConverter<std::vector<int>>(defaults);
+    AddToJSONConverter<std::vector<unsigned int>>(defaults);
+    AddToJSONConverter<std::vector<int64_t>>(defaults);
+    AddToJSONConverter<std::vector<uint64_t>>(defaults);
+    AddToJSONConverter<std::vector<float>>(defaults);
+    AddToJSONConverter<std::vector<double>>(defaults);
+    AddToJSONConverter<std::vector<std::string>>(defaults);
+    AddToJSONConverter<std::vector<std::vector<int>>>(defaults);
+    AddToJSONConverter<std::vector<std::vector<unsigned int>>>(defaults);
+    AddToJSONConverter<std::vector<std::vector<int64_t>>>(defaults);
+    AddToJSONConverter<std::vector<std::vector<uint64_t>>>(defaults);
+    AddToJSONConverter<std::vector<std::vector<float>>>(defaults);
+    AddToJSONConverter<std::vector<std::vector<double>>>(defaults);
+    AddToJSONConverter<std::vector<std::vector<std::string>>>(defaults);
+    AddToJSONConverter<Array<char>>(defaults);
+    AddToJSONConverter<Array<int>>(defaults);
+    AddToJSONConverter<Array<float>>(defaults);
+    AddToJSONConverter<Array<double>>(defaults);
+    AddToJSONConverter<Matrix<float, 4, 4>>(defaults);
+    AddToJSONConverter<Matrix<double>>(defaults);
+    return defaults;
+  }();
+  return converters;
+}
+
+// Values of JSON metadata of each kind, where integers of a wider kind hold
+// the narrower kinds
+void GetJSONValue(const rapidjson::Value & valueJson, bool & value) { value = valueJson.GetBool(); }
+void GetJSONValue(const rapidjson::Value & valueJson, double & value) { value = valueJson.GetDouble(); }
+
+void GetJSONValue(const rapidjson::Value & valueJson, std::string & value)
+{
+  value.assign(valueJson.GetString(), valueJson.GetStringLength());
+}
+
+template <typename TInteger>
+void GetJSONInteger(const rapidjson::Value & valueJson, TInteger & value)
+{
+  value = valueJson.IsInt64() ? static_cast<TInteger>(valueJson.GetInt64()) : static_cast<TInteger>(valueJson.GetUint64());
+}
+
+void GetJSONValue(const rapidjson::Value & valueJson, int & value) { GetJSONInteger(valueJson, value); }
+void GetJSONValue(const rapidjson::Value & valueJson, unsigned int & value) { GetJSONInteger(valueJson, value); }
+void GetJSONValue(const rapidjson::Value & valueJson, int64_t & value) { GetJSONInteger(valueJson, value); }
+void GetJSONValue(const rapidjson::Value & valueJson, uint64_t & value) { GetJSONInteger(valueJson, value); }
+
+template <typename TElement>
+void GetJSONValue(const rapidjson::Value & valueJson, std::vector<TElement> & value)
+{
+  value.resize(valueJson.Size());
+  for (rapidjson::SizeType ii = 0; ii < valueJson.Size(); ++ii)
+  {
+    TElement element;
+    GetJSONValue(valueJson[ii], element);
+    value[ii] = std::move(element);
+  }
+}
+
+template <typename TValue>
+void EncapsulateJSONValue(const rapidjson::Value & valueJson, const std::string & key, MetaDataDictionary & dictionary)
+{
+  TValue value;
+  GetJSONValue(valueJson, value);
+  EncapsulateMetaData<TValue>(dictionary, key, value);
+}
+
+constexpr unsigned int NumberOfJSONMetaDataKinds = static_cast<unsigned int>(JSONMetaDataKind::String) + 1;
+
+using FromJSONConverters = std::array<std::array<JSONToMetaDataObjectConverter, NumberOfJSONMetaDataKinds>, JSONMetaDataMaximumDepth + 1>;
+
+template <typename TValue>
+void AddFromJSONConverters(FromJSONConverters & converters, JSONMetaDataKind kind, bool arrays = true)
+{
+  const auto kindIndex = static_cast<unsigned int>(kind);
+  converters[0][kindIndex] = &EncapsulateJSONValue<TValue>;
+  if (arrays)
+  {
+    converters[1][kindIndex] = &EncapsulateJSONValue<std::vector<TValue>>;
+    converters[2][kindIndex] = &EncapsulateJSONValue<std::vector<std::vector<TValue>>>;
+  }
+}
+
+// Built once, on first use
+FromJSONConverters & GetFromJSONConverters()
+{
+  static FromJSONConverters converters = []()
+  {
+    FromJSONConverters defaults;
+    AddFromJSONConverters<bool>(defaults, JSONMetaDataKind::Bool, false);
+    AddFromJSONConverters<int>(defaults, JSONMetaDataKind::Int);
+    AddFromJSONConverters<unsigned int>(defaults, JSONMetaDataKind::Uint);
+    AddFromJSONConverters<int64_t>(defaults, JSONMetaDataKind::Int64);
+    AddFromJSONConverters<uint64_t>(defaults, JSONMetaDataKind::Uint64);
+    AddFromJSONConverters<double>(defaults, JSONMetaDataKind::Double);
+    AddFromJSONConverters<std::string>(defaults, JSONMetaDataKind::String);
+    return defaults;
+  }();
+  return converters;
+}
+
+// Kind of a scalar value. Returns false for other values, e.g. nulls.
+bool GetScalarKind(const rapidjson::Value & valueJson, JSONMetaDataKind & kind)
+{
+  if (valueJson.IsBool())
+  {
+    kind = JSONMetaDataKind::Bool;
+  }
+  else if (valueJson.IsInt())
+  {
+    kind = JSONMetaDataKind::Int;
+  }
+  else if (valueJson.IsUint())
+  {
+    kind = JSONMetaDataKind::Uint;
+  }
+  else if (valueJson.IsInt64())
+  {
+    kind = JSONMetaDataKind::Int64;
+  }
+  else if (valueJson.IsUint64())
+  {
+    kind = JSONMetaDataKind::Uint64;
+  }
+  else if (valueJson.IsNumber())
+  {
+    kind = JSONMetaDataKind::Double;
+  }
+  else if (valueJson.IsString())
+  {
+    kind = JSONMetaDataKind::String;
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+// Kind of values of both kinds. Returns false if numbers are mixed with
+// bools or strings.
+bool CombineKinds(JSONMetaDataKind first, JSONMetaDataKind second, JSONMetaDataKind & kind)
+{
+  if (first == second)
+  {
+    kind = first;
+    return true;
+  }
+  if (first == JSONMetaDataKind::Bool || first == JSONMetaDataKind::String || second == JSONMetaDataKind::Bool ||
+      second == JSONMetaDataKind::String)
+  {
+    return false;
+  }
+  const JSONMetaDataKind narrower = std::min(first, second);
+  const JSONMetaDataKind wider = std::max(first, second);
+  switch (wider)
+  {
+    case JSONMetaDataKind::Uint:
+    case JSONMetaDataKind::Int64:
+      // Int and Uint, or either with Int64
+      kind = JSONMetaDataKind::Int64;
+      break;
+    case JSONMetaDataKind::Uint64:
+      kind = narrower == JSONMetaDataKind::Uint ? JSONMetaDataKind::Uint64 : JSONMetaDataKind::Double;
+      break;
+    default:
+      kind = JSONMetaDataKind::Double;
+      break;
+  }
+  return true;
+}
+
+// Shape of a value of at most maximumDepth, where hasKind is false for empty
+// arrays, or arrays of empty arrays. Returns false for values of no shape,
+// e.g. objects, deeper arrays, or arrays whose elements differ in depth or
+// mix numbers with bools or strings.
+bool GetShape(const rapidjson::Value & valueJson, unsigned int maximumDepth, JSONMetaDataShape & shape, bool & hasKind)
+{
+  if (!valueJson.IsArray())
+  {
+    shape.depth = 0;
+    hasKind = true;
+    return GetScalarKind(valueJson, shape.kind);
+  }
+  if (maximumDepth == 0)
+  {
+    return false;
+  }
+
+  shape.depth = 1;
+  hasKind = false;
+  for (rapidjson::SizeType ii = 0; ii < valueJson.Size(); ++ii)
+  {
+    JSONMetaDataShape elementShape;
+    bool elementHasKind = false;
+    if (!GetShape(valueJson[ii], maximumDepth - 1, elementShape, elementHasKind))
     {
-      const std::vector<std::vector<unsigned int>> value = uintVectorVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto aa: value)
-      {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(auto vv: value)
-        {
-          for(auto uu: vv)
-          {
-          vvJson.PushBack(rapidjson::Value().SetUint(uu), allocator);
-          }
-        }
-        valueJson.PushBack(vvJson, allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      return false;
     }
-    const auto int64VectorVectorValue = dynamic_cast<MetaDataVectorVectorInt64Type *>(entry.GetPointer());
-    if (int64VectorVectorValue)
+    if (ii == 0)
     {
-      const std::vector<std::vector<int64_t>> value = int64VectorVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto aa: value)
-      {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(auto vv: value)
-        {
-          for(auto uu: vv)
-          {
-          vvJson.PushBack(rapidjson::Value().SetInt64(uu), allocator);
-          }
-        }
-        valueJson.PushBack(vvJson, allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      shape.depth = elementShape.depth + 1;
     }
-    const auto uint64VectorVectorValue = dynamic_cast<MetaDataVectorVectorUint64Type *>(entry.GetPointer());
-    if (int64VectorVectorValue)
+    else if (elementShape.depth + 1 != shape.depth)
     {
-      const std::vector<std::vector<uint64_t>> value = uint64VectorVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto aa: value)
-      {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(auto vv: value)
-        {
-          for(auto uu: vv)
-          {
-          vvJson.PushBack(rapidjson::Value().SetUint64(uu), allocator);
-          }
-        }
-        valueJson.PushBack(vvJson, allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      return false;
     }
-    const auto doubleVectorVectorValue = dynamic_cast<MetaDataVectorVectorDoubleType *>(entry.GetPointer());
-    if (doubleVectorVectorValue)
+    if (elementHasKind)
     {
-      const std::vector<std::vector<double>> value = doubleVectorVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto aa: value)
+      if (!hasKind)
       {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(auto vv: value)
-        {
-          for(auto uu: vv)
-          {
-          vvJson.PushBack(rapidjson::Value().SetDouble(uu), allocator);
-          }
-        }
-        valueJson.PushBack(vvJson, allocator);
+        shape.kind = elementShape.kind;
+        hasKind = true;
       }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto floatVectorVectorValue = dynamic_cast<MetaDataVectorVectorFloatType *>(entry.GetPointer());
-    if (floatVectorVectorValue)
-    {
-      const std::vector<std::vector<float>> value = floatVectorVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto aa: value)
+      else if (!CombineKinds(shape.kind, elementShape.kind, shape.kind))
       {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(auto vv: value)
-        {
-          for(auto uu: vv)
-          {
-          vvJson.PushBack(rapidjson::Value().SetFloat(uu), allocator);
-          }
-        }
-        valueJson.PushBack(vvJson, allocator);
+        return false;
       }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
     }
+  }
+  return true;
+}
 
-    const auto ucharValue = dynamic_cast<MetaDataUcharType *>(entry.GetPointer());
-    if (ucharValue)
-    {
-      const unsigned char value = ucharValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetUint(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto charValue = dynamic_cast<MetaDataCharType *>(entry.GetPointer());
-    if (charValue)
-    {
-      const char value = charValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetInt(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto signedCharValue = dynamic_cast<MetaDataSignedCharType *>(entry.GetPointer());
-    if (signedCharValue)
-    {
-      const signed char value = signedCharValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetInt(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto ushortValue = dynamic_cast<MetaDataUshortType *>(entry.GetPointer());
-    if (ushortValue)
-    {
-      const unsigned short value = ushortValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetUint(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto shortValue = dynamic_cast<MetaDataShortType *>(entry.GetPointer());
-    if (shortValue)
-    {
-      const short value = shortValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetInt(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto ulongValue = dynamic_cast<MetaDataUlongType *>(entry.GetPointer());
-    if (ulongValue)
-    {
-      const unsigned long value = ulongValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetUint64(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto longValue = dynamic_cast<MetaDataLongType *>(entry.GetPointer());
-    if (longValue)
-    {
-      const long value = longValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetInt64(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto ulongLongValue = dynamic_cast<MetaDataUlongLongType *>(entry.GetPointer());
-    if (ulongLongValue)
-    {
-      const unsigned long long value = ulongLongValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetUint64(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto longLongValue = dynamic_cast<MetaDataLongLongType *>(entry.GetPointer());
-    if (longLongValue)
+} // end anonymous namespace
+
+void ConvertMetaDataDictionaryToJSON(const itk::MetaDataDictionary & dictionary, rapidjson::Value & metadataJson, rapidjson::Document::AllocatorType& allocator, const MetaDataKeyFilter & keyFilter)
+{
+  ITK_WASM_TRACE_SCOPE("ConvertMetaDataDictionaryToJSON");
+  const ToJSONConverters & converters = GetToJSONConverters();
+  const bool filtered = keyFilter.IsEnabled();
+  for (auto itr = dictionary.Begin(); itr != dictionary.End(); ++itr)
+  {
+    const MetaDataObjectBase * entry = itr->second.GetPointer();
+    if (entry == nullptr || (filtered && !keyFilter.Accepts(itr->first)))
     {
-      const long long value = longLongValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetInt64(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
       continue;
     }
-    const auto arrayCharValue = dynamic_cast<MetaDataArrayCharType *>(entry.GetPointer());
-    if (arrayCharValue)
+    const auto converter = converters.find(std::type_index(typeid(*entry)));
+    if (converter == converters.end())
     {
-      const Array<char> value = arrayCharValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetInt(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
       continue;
     }
-    const auto arrayFloatValue = dynamic_cast<MetaDataArrayFloatType *>(entry.GetPointer());
-    if (arrayFloatValue)
+
+    const std::string & key = itr->first;
+    rapidjson::Value entryJson(rapidjson::kArrayType);
+    entryJson.Reserve(2, allocator);
+    rapidjson::Value keyJson(key.data(), static_cast<rapidjson::SizeType>(key.size()), allocator);
+    entryJson.PushBack(keyJson, allocator);
+    rapidjson::Value valueJson;
+    converter->second(*entry, valueJson, allocator);
+    entryJson.PushBack(valueJson, allocator);
+    metadataJson.PushBack(entryJson, allocator);
+  }
+}
+
+void ConvertJSONToMetaDataDictionary(const rapidjson::Value & metadataJson, itk::MetaDataDictionary & dictionary, const MetaDataKeyFilter & keyFilter)
+{
+  if (!metadataJson.IsArray())
+  {
+    return;
+  }
+
+  const FromJSONConverters & converters = GetFromJSONConverters();
+  const bool filtered = keyFilter.IsEnabled();
+  std::string key;
+  for (rapidjson::SizeType ii = 0; ii < metadataJson.Size(); ++ii)
+  {
+    const rapidjson::Value & entry = metadataJson[ii];
+    if (!entry.IsArray() || entry.Size() < 2 || !entry[0].IsString() ||
+        (filtered && !keyFilter.Accepts(std::string_view(entry[0].GetString(), entry[0].GetStringLength()))))
     {
-      const Array<float> value = arrayFloatValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetFloat(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
       continue;
     }
-    const auto arrayDoubleValue = dynamic_cast<MetaDataArrayDoubleType *>(entry.GetPointer());
-    if (arrayDoubleValue)
+    const rapidjson::Value & value = entry[1];
+
+    JSONMetaDataShape shape;
+    bool hasKind = false;
+    if (!GetShape(value, JSONMetaDataMaximumDepth, shape, hasKind))
     {
-      const Array<double> value = arrayDoubleValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetDouble(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
       continue;
     }
-    const auto matrixFloat44Value = dynamic_cast<MetaDataMatrixFloat44Type *>(entry.GetPointer());
-    if (matrixFloat44Value)
+    if (!hasKind)
     {
-      const Matrix<float, 4, 4> value = matrixFloat44Value->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(unsigned int ii = 0; ii < 4; ii++)
-      {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(unsigned int jj = 0; jj < 4; jj++)
-        {
-          vvJson.PushBack(rapidjson::Value().SetFloat(value(ii, jj)), allocator);
-        }
-        valueJson.PushBack(vvJson, allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      shape.kind = JSONMetaDataKind::String;
     }
-    const auto matrixDoubleValue = dynamic_cast<MetaDataMatrixDoubleType *>(entry.GetPointer());
-    if (matrixDoubleValue)
+    const JSONToMetaDataObjectConverter & converter = converters[shape.depth][static_cast<unsigned int>(shape.kind)];
+    if (converter)
     {
-      const Matrix<double, 3, 3> value = matrixDoubleValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(unsigned int ii = 0; ii < 3; ii++)
-      {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(unsigned int jj = 0; jj < 3; jj++)
-        {
-          vvJson.PushBack(rapidjson::Value().SetDouble(value(ii, jj)), allocator);
-        }
-        valueJson.PushBack(vvJson, allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      key.assign(entry[0].GetString(), entry[0].GetStringLength());
+      converter(value, key, dictionary);
     }
-
-    ++itr;
   }
+}
 
+void RegisterMetaDataObjectToJSONConverter(const std::type_info & metaDataObjectType, MetaDataObjectToJSONConverter converter)
+{
+  ToJSONConverters & converters = GetToJSONConverters();
+  if (converter)
+  {
+    converters[std::type_index(metaDataObjectType)] = std::move(converter);
+  }
+  else
+  {
+    converters.erase(std::type_index(metaDataObjectType));
+  }
 }
 
-void ConvertJSONToMetaDataDictionary(const rapidjson::Value & metadataJson, itk::MetaDataDictionary & dictionary)
+void RegisterJSONToMetaDataObjectConverter(JSONMetaDataShape shape, JSONToMetaDataObjectConverter converter)
 {
-  if (metadataJson.IsArray())
+  const auto kindIndex = static_cast<unsigned int>(shape.kind);
+  if (shape.depth > JSONMetaDataMaximumDepth || kindIndex >= NumberOfJSONMetaDataKinds)
   {
-    for(rapidjson::SizeType ii = 0; ii < metadataJson.Size(); ++ii)
-      {
-      const rapidjson::Value & entry = metadataJson[ii];
-      const auto key = entry[0].GetString();
-      std::cout << "Read key: " << key << std::endl;
-      const rapidjson::Value & value = entry[1];
-      if (value.IsBool())
-        {
-        EncapsulateMetaData<bool>(dictionary, key, value.GetBool());
-        }
-      else if (value.IsInt())
-        {
-        EncapsulateMetaData<int>(dictionary, key, value.GetInt());
-        }
-      else if (value.IsUint())
-        {
-        EncapsulateMetaData<unsigned int>(dictionary, key, value.GetUint());
-        }
-      else if (value.IsInt64())
-        {
-        EncapsulateMetaData<int64_t>(dictionary, key, value.GetInt64());
-        }
-      else if (value.IsUint64())
-        {
-        EncapsulateMetaData<uint64_t>(dictionary, key, value.GetUint64());
-        }
-      else if (value.IsDouble())
-        {
-        EncapsulateMetaData<double>(dictionary, key, value.GetDouble());
-        }
-      else if (value.IsFloat())
-        {
-        EncapsulateMetaData<float>(dictionary, key, value.GetFloat());
-        }
-      else if (value.IsString())
-        {
-          std::cout << "encapsulating: " << key << " , "  << value.GetString() << std::endl;
-        EncapsulateMetaData<std::string>(dictionary, key, value.GetString());
-        }
-      else if (value.IsArray())
-        {
-        if (value.Size() == 0)
-        {
-          using ValueType = std::vector<std::string>;
-          ValueType val;
-          EncapsulateMetaData<ValueType>(dictionary, key, val);
-          continue;
-        }
-        if (value[0].IsString())
-          {
-          using ValueType = std::vector<std::string>;
-          ValueType val;
-          for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-            {
-            val.push_back(value[jj].GetString());
-            }
-          EncapsulateMetaData<ValueType>(dictionary, key, val);
-          }
-        else if (value[0].IsNumber())
-          {
-          if (value[0].IsArray())
-            {
-            if (value[0].Size() == 0 || value[0][0].IsString())
-              {
-              using ValueType = std::vector<std::vector<std::string>>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value[jj].Size(); ++jj)
-                {
-                std::vector<std::string> ve;
-                for(rapidjson::SizeType kk = 0; kk < value[jj][kk].Size(); ++kk)
-                  {
-                  ve.push_back(value[jj][kk].GetString());
-                  }
-                val.push_back(ve);
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            else if (value[0][0].IsNumber())
-              {
-              if (value.IsInt())
-                {
-                using ValueType = std::vector<std::vector<int>>;
-                ValueType val;
-                for(rapidjson::SizeType jj = 0; jj < value[jj].Size(); ++jj)
-                  {
-                  std::vector<int> ve;
-                  for(rapidjson::SizeType kk = 0; kk < value[jj][kk].Size(); ++kk)
-                    {
-                    ve.push_back(value[jj][kk].GetInt());
-                    }
-                  val.push_back(ve);
-                  }
-                EncapsulateMetaData<ValueType>(dictionary, key, val);
-                }
-              else if (value.IsUint())
-                {
-                using ValueType = std::vector<std::vector<unsigned int>>;
-                ValueType val;
-                for(rapidjson::SizeType jj = 0; jj < value[jj].Size(); ++jj)
-                  {
-                  std::vector<unsigned int> ve;
-                  for(rapidjson::SizeType kk = 0; kk < value[jj][kk].Size(); ++kk)
-                    {
-                    ve.push_back(value[jj][kk].GetUint());
-                    }
-                  val.push_back(ve);
-                  }
-                EncapsulateMetaData<ValueType>(dictionary, key, val);
-                }
-              else if (value.IsInt64())
-                {
-                using ValueType = std::vector<std::vector<int64_t>>;
-                ValueType val;
-                for(rapidjson::SizeType jj = 0; jj < value[jj].Size(); ++jj)
-                  {
-                  std::vector<int64_t> ve;
-                  for(rapidjson::SizeType kk = 0; kk < value[jj][kk].Size(); ++kk)
-                    {
-                    ve.push_back(value[jj][kk].GetInt64());
-                    }
-                  val.push_back(ve);
-                  }
-                EncapsulateMetaData<ValueType>(dictionary, key, val);
-                }
-              else if (value.IsUint64())
-                {
-                using ValueType = std::vector<std::vector<uint64_t>>;
-                ValueType val;
-                for(rapidjson::SizeType jj = 0; jj < value[jj].Size(); ++jj)
-                  {
-                  std::vector<uint64_t> ve;
-                  for(rapidjson::SizeType kk = 0; kk < value[jj][kk].Size(); ++kk)
-                    {
-                    ve.push_back(value[jj][kk].GetUint64());
-                    }
-                  val.push_back(ve);
-                  }
-                EncapsulateMetaData<ValueType>(dictionary, key, val);
-                }
-              else if (value.IsDouble())
-                {
-                using ValueType = std::vector<std::vector<double>>;
-                ValueType val;
-                for(rapidjson::SizeType jj = 0; jj < value[jj].Size(); ++jj)
-                  {
-                  std::vector<double> ve;
-                  for(rapidjson::SizeType kk = 0; kk < value[jj][kk].Size(); ++kk)
-                    {
-                    ve.push_back(value[jj][kk].GetDouble());
-                    }
-                  val.push_back(ve);
-                  }
-                EncapsulateMetaData<ValueType>(dictionary, key, val);
-                }
-              else if (value.IsFloat())
-                {
-                using ValueType = std::vector<std::vector<float>>;
-                ValueType val;
-                for(rapidjson::SizeType jj = 0; jj < value[jj].Size(); ++jj)
-                  {
-                  std::vector<float> ve;
-                  for(rapidjson::SizeType kk = 0; kk < value[jj][kk].Size(); ++kk)
-                    {
-                    ve.push_back(value[jj][kk].GetFloat());
-                    }
-                  val.push_back(ve);
-                  }
-                EncapsulateMetaData<ValueType>(dictionary, key, val);
-                }
-              }
-            }
-          else
-            {
-            if (value.IsInt())
-              {
-              using ValueType = std::vector<int>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-                {
-                val.push_back(value[jj].GetInt());
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            else if (value.IsUint())
-              {
-              using ValueType = std::vector<unsigned int>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-                {
-                val.push_back(value[jj].GetUint());
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            else if (value.IsInt64())
-              {
-              using ValueType = std::vector<int64_t>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-                {
-                val.push_back(value[jj].GetInt64());
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            else if (value.IsUint64())
-              {
-              using ValueType = std::vector<uint64_t>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-                {
-                val.push_back(value[jj].GetUint64());
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            else if (value.IsDouble())
-              {
-              using ValueType = std::vector<double>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-                {
-                val.push_back(value[jj].GetDouble());
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            else if (value.IsFloat())
-              {
-              using ValueType = std::vector<float>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-                {
-                val.push_back(value[jj].GetFloat());
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            else if (value.IsString())
-              {
-              using ValueType = std::vector<std::string>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-                {
-                val.push_back(value[jj].GetString());
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            }
-          }
-        }
-      }
+    itkGenericExceptionMacro("Unexpected JSON metadata shape, depth: " << shape.depth << ", kind: " << kindIndex);
   }
+  GetFromJSONConverters()[shape.depth][kindIndex] = std::move(converter);
 }
 
 } // end namespace wasm
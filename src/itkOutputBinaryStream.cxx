@@ -20,9 +20,6 @@
 #include <string>
 #ifndef ITK_WASM_NO_MEMORY_IO
 #include "itkWasmExports.h"
-#include <sstream>
-#include "rapidjson/document.h"
-#include "itkWasmStringStream.h"
 #endif
 
 namespace itk
@@ -30,23 +27,48 @@ namespace itk
 namespace wasm
 {
 
+void
+OutputBinaryStream
+::SetData(const void * data, size_t size, std::shared_ptr<const void> owner)
+{
+  if(wasm::Pipeline::get_use_memory_io())
+  {
+    m_Data = data;
+    m_DataSize = size;
+    m_DataOwner = std::move(owner);
+  }
+  else
+  {
+    m_OStream->write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+  }
+}
+
 OutputBinaryStream
 ::~OutputBinaryStream()
 {
   if(wasm::Pipeline::get_use_memory_io())
   {
+    if (m_DeleteOStream && m_OStream != nullptr)
+      {
+      delete m_OStream;
+      }
     if (this->m_Identifier.empty())
       {
       return;
       }
 #ifndef ITK_WASM_NO_MEMORY_IO
     const auto index = std::stoi(this->m_Identifier);
-    setMemoryStoreOutputDataObject(0, index, this->m_WasmStringStream);
-
-    const std::string & string = this->m_WasmStringStream->GetString();
-    const auto dataAddress = reinterpret_cast< size_t >( string.data() );
-    const auto dataSize = string.size();
-    setMemoryStoreOutputArray(0, index, 0, dataAddress, dataSize);
+    if (m_Data != nullptr)
+      {
+      setMemoryStoreOutputBuffer(wasm::Pipeline::get_memory_index(), index, m_Data, m_DataSize, std::move(m_DataOwner));
+      return;
+      }
+    // The host reads the stream buffer in place, at a valid address even
+    // when it is empty
+    m_StreamBuffer->Reserve(1);
+    const char * data = m_StreamBuffer->GetData();
+    const size_t size = m_StreamBuffer->GetSize();
+    setMemoryStoreOutputBuffer(wasm::Pipeline::get_memory_index(), index, data, size, std::move(m_StreamBuffer));
 #else
     std::cerr << "Memory IO not supported" << std::endl;
     abort();
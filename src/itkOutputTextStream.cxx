@@ -20,9 +20,6 @@
 #include <string>
 #ifndef ITK_WASM_NO_MEMORY_IO
 #include "itkWasmExports.h"
-#include <sstream>
-#include "rapidjson/document.h"
-#include "itkWasmStringStream.h"
 #endif
 
 namespace itk
@@ -35,18 +32,23 @@ OutputTextStream
 {
   if(wasm::Pipeline::get_use_memory_io())
   {
+    if (m_DeleteOStream && m_OStream != nullptr)
+      {
+      delete m_OStream;
+      }
 #ifndef ITK_WASM_NO_MEMORY_IO
     if (this->m_Identifier.empty())
       {
       return;
       }
     const auto index = std::stoi(this->m_Identifier);
-    setMemoryStoreOutputDataObject(0, index, this->m_WasmStringStream);
-
-    const std::string & string = this->m_WasmStringStream->GetString();
-    const auto dataAddress = reinterpret_cast< size_t >( string.data() );
-    const auto dataSize = string.size();
-    setMemoryStoreOutputArray(0, index, 0, dataAddress, dataSize);
+    // The host reads the stream buffer in place. The text is null
+    // terminated, as the std::string data it replaces, but the terminator is
+    // not part of the size.
+    m_StreamBuffer->Terminate();
+    const char * data = m_StreamBuffer->GetData();
+    const size_t size = m_StreamBuffer->GetSize();
+    setMemoryStoreOutputBuffer(wasm::Pipeline::get_memory_index(), index, data, size, std::move(m_StreamBuffer));
 #else
     std::cerr << "Memory IO not supported" << std::endl;
     abort();
@@ -16,6 +16,14 @@
  *
  *=========================================================================*/
 #include "itkPipeline.h"
+#include "itkMultiThreaderBase.h"
+#include "itkPipelineStageStore.h"
+#include "itkWasmTrace.h"
+#include "itkWasmAllocationStats.h"
+#ifndef ITK_WASM_NO_MEMORY_IO
+#include "itkWasmExports.h"
+#include "itkWasmMemoryBudget.h"
+#endif
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
 #include <rang.hpp>
 #endif
@@ -23,12 +31,135 @@
 #include "rapidjson/document.h"
 #include "rapidjson/prettywriter.h"
 #include "rapidjson/ostreamwrapper.h"
+#include "rapidjson/writer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace itk
 {
 namespace wasm
 {
 
+using ProfileClockType = std::chrono::steady_clock;
+
+#if defined(ITK_WASM_PROGRESS_IMPORT) && defined(__wasm__)
+extern "C" __attribute__((import_module("itk_wasm"), import_name("progress"))) void itk_wasm_progress(uint32_t memoryIndex, float progress);
+extern "C" __attribute__((import_module("itk_wasm"), import_name("output_version"))) void itk_wasm_output_version(uint32_t memoryIndex, uint32_t outputIndex, uint32_t version);
+#endif
+
+// Outputs are serialized on background threads where threads are available
+#if !defined(__wasm__) || defined(_REENTRANT)
+#define ITK_WASM_BACKGROUND_OUTPUTS
+#endif
+
+// name, seconds, added from the output serialization threads
+static std::mutex profileMutex;
+static std::vector<std::pair<std::string, double>> profileEvents;
+static ProfileClockType::time_point profileParseEnd;
+static ProfileClockType::time_point profileComputeEnd;
+static bool profileComputeRecorded = false;
+
+// Inputs inspected during input type detection, cleared for every Pipeline
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+static std::map<std::string, ImageIOBase::Pointer> inputImageIOCache;
+static std::map<std::string, MeshIOBase::Pointer> inputMeshIOCache;
+#endif
+static std::map<uint32_t, std::shared_ptr<const rapidjson::Document>> inputJSONDocumentCache;
+
+static void clearInputCaches()
+{
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+  inputImageIOCache.clear();
+  inputMeshIOCache.clear();
+#endif
+  inputJSONDocumentCache.clear();
+}
+
+// Apply --threads and --threader, restoring the defaults when they are not given
+static void configureMultiThreading(unsigned int numberOfThreads, const std::string & threader)
+{
+  static const auto defaultThreader = MultiThreaderBase::GetGlobalDefaultThreader();
+  static const auto defaultNumberOfThreads = MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+
+  auto threaderEnum = defaultThreader;
+  if (!threader.empty())
+  {
+    threaderEnum = MultiThreaderBase::ThreaderTypeFromString(threader);
+    if (threaderEnum == MultiThreaderBase::ThreaderEnum::Unknown)
+    {
+      throw CLI::ValidationError("--threader", "Unknown threader: " + threader);
+    }
+  }
+  MultiThreaderBase::SetGlobalDefaultThreader(threaderEnum);
+  MultiThreaderBase::SetGlobalDefaultNumberOfThreads(numberOfThreads == 0 ? defaultNumberOfThreads : numberOfThreads);
+}
+
+// File input reads queued while the command line is parsed, see
+// Pipeline::read_input
+static bool deferInputReads = false;
+static std::vector<std::function<void()>> deferredInputReads;
+
+static void readDeferredInputs()
+{
+  std::vector<std::function<void()>> reads;
+  reads.swap(deferredInputReads);
+  std::atomic<size_t> next{ 0 };
+  std::mutex exceptionMutex;
+  std::exception_ptr exception;
+  auto readInputs = [&]() {
+    for (size_t ii = next++; ii < reads.size(); ii = next++)
+    {
+      try
+      {
+        reads[ii]();
+      }
+      catch (...)
+      {
+        const std::lock_guard<std::mutex> lock(exceptionMutex);
+        if (!exception)
+        {
+          exception = std::current_exception();
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+#ifdef ITK_WASM_BACKGROUND_OUTPUTS
+  const size_t numberOfThreads = std::min<size_t>(reads.size(), MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  for (size_t ii = 1; ii < numberOfThreads; ++ii)
+  {
+    try
+    {
+      threads.emplace_back(readInputs);
+    }
+    catch (const std::system_error &)
+    {
+      // No more threads available, read with the started ones
+      break;
+    }
+  }
+#endif
+  readInputs();
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
 Pipeline
 ::Pipeline(std::string name, std::string description, int argc, char **argv):
   App(description, name),
@@ -41,12 +172,47 @@ Pipeline
   this->positionals_at_end(false);
 
   this->add_flag("--memory-io", m_UseMemoryIO, "Use itk-wasm memory IO")->group("");
+  this->add_option("--memory-index", m_MemoryIndex, "itk-wasm memory IO session index")->group("");
+  this->add_flag("--profile", m_Profile, "Report per-phase wall-clock timings to stderr")->group("");
+  this->add_flag("--progress", m_ReportProgress, "Report filter progress")->group("");
+  this->add_flag("--progressive", m_Progressive, "Publish intermediate versions of the outputs")->group("");
+#ifdef ITK_WASM_TRACE
+  this->add_flag("--trace", "Write Chrome trace event spans to stderr")->group("");
+#endif
+  this->add_option("--threads", m_NumberOfThreads, "Number of threads used by ITK filters, 0 for the default");
+  this->add_option("--threader", m_Threader, "ITK multi-threader backend: Platform, Pool, or TBB");
+  this->add_option("--max-memory", m_MaxMemoryText, "Memory budget in bytes, with an optional K, M, or G suffix, e.g. 512M. Pipelines that can divide their work run in pieces to stay within it.")
+    ->check([](const std::string & text) {
+      uint64_t bytes = 0;
+      return ParseByteSize(text, bytes) ? std::string() : "Not a byte size: " + text;
+    });
+  this->add_option("--metadata-include", m_MetaDataInclude, "Only pass image metadata keys that match these glob patterns, e.g. '0010|*'")
+    ->expected(1)
+    ->take_all();
+  this->add_option("--metadata-exclude", m_MetaDataExclude, "Do not pass image metadata keys that match these glob patterns")
+    ->expected(1)
+    ->take_all();
   this->set_version_flag("--version", m_Version);
 
   // Set m_UseMemoryIO before it is used by other memory parsers
   this->preparse_callback([this](size_t arg)
    {
    m_UseMemoryIO = false;
+   m_MemoryIndex = 0;
+   m_Profile = false;
+   m_MaxMemory = 0;
+   m_ReportProgress = false;
+   m_Progressive = false;
+   profileEvents.clear();
+   profileComputeRecorded = false;
+#ifdef ITK_WASM_TRACE
+   TraceScope::SetEnabled(false);
+   TraceScope::ClearEvents();
+#endif
+   unsigned int numberOfThreads = 0;
+   std::string threader;
+   std::vector<std::string> metadataInclude;
+   std::vector<std::string> metadataExclude;
     for (int ii = 0; ii < this->m_argc; ++ii)
     {
       const std::string arg(this->m_argv[ii]);
@@ -54,7 +220,56 @@ Pipeline
       {
         m_UseMemoryIO = true;
       }
+      if (arg == "--profile")
+      {
+        m_Profile = true;
+      }
+      if (arg == "--progress")
+      {
+        m_ReportProgress = true;
+      }
+      if (arg == "--progressive")
+      {
+        m_Progressive = true;
+      }
+#ifdef ITK_WASM_TRACE
+      if (arg == "--trace")
+      {
+        TraceScope::SetEnabled(true);
+      }
+#endif
+      if (arg == "--memory-index" && ii + 1 < this->m_argc)
+      {
+        m_MemoryIndex = static_cast<uint32_t>(std::stoul(this->m_argv[ii + 1]));
+      }
+      if (arg == "--threads" && ii + 1 < this->m_argc)
+      {
+        numberOfThreads = static_cast<unsigned int>(std::stoul(this->m_argv[ii + 1]));
+      }
+      if (arg == "--max-memory" && ii + 1 < this->m_argc)
+      {
+        // Invalid sizes are reported by the option check
+        uint64_t bytes = 0;
+        m_MaxMemory = ParseByteSize(this->m_argv[ii + 1], bytes) ? bytes : 0;
+      }
+      if (arg == "--threader" && ii + 1 < this->m_argc)
+      {
+        threader = this->m_argv[ii + 1];
+      }
+      if (arg == "--metadata-include" && ii + 1 < this->m_argc)
+      {
+        metadataInclude.emplace_back(this->m_argv[ii + 1]);
+      }
+      if (arg == "--metadata-exclude" && ii + 1 < this->m_argc)
+      {
+        metadataExclude.emplace_back(this->m_argv[ii + 1]);
+      }
     }
+    // Set the metadata key filter before inputs are read during the parse
+    m_MetaDataKeyFilter.SetIncludePatterns(std::move(metadataInclude));
+    m_MetaDataKeyFilter.SetExcludePatterns(std::move(metadataExclude));
+    // Configure threading before inputs are read during the parse
+    configureMultiThreading(numberOfThreads, threader);
    });
 
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
@@ -62,12 +277,51 @@ Pipeline
   rang::setControlMode(rang::control::Force);
 #endif
 #endif
+
+#ifndef ITK_WASM_NO_MEMORY_IO
+  resetMemoryPhases();
+  clearAbortRequested();
+#endif
+#ifdef ITK_WASM_ALLOCATION_STATS
+  resetAllocationStats();
+#endif
+  clearInputCaches();
+  m_ComponentConversion = ComponentConversion::None;
+}
+
+void
+Pipeline
+::parse()
+{
+  {
+  ProfileScope parseScope("parse");
+  deferInputReads = true;
+  try
+  {
+    CLI::App::parse(m_argc, m_argv);
+  }
+  catch (...)
+  {
+    deferInputReads = false;
+    deferredInputReads.clear();
+    throw;
+  }
+  deferInputReads = false;
+  readDeferredInputs();
+  }
+  profileParseEnd = ProfileClockType::now();
+#ifndef ITK_WASM_NO_MEMORY_IO
+  markMemoryPhase("parse");
+#endif
 }
 
 auto
 Pipeline
 ::exit(const CLI::Error &e) -> int
 {
+  // Do not cache the outputs of a failed run
+  m_ResultCacheMiss = false;
+
   /// Avoid printing anything if this is a CLI::RuntimeError
   if(e.get_name() == "RuntimeError")
       return e.get_exit_code();
@@ -279,7 +533,461 @@ Pipeline
 Pipeline
 ::~Pipeline()
 {
+  try
+  {
+    wait_for_outputs();
+  }
+  catch (const std::exception & error)
+  {
+    std::cerr << "Could not write an output: " << error.what() << std::endl;
+    std::terminate();
+  }
+#ifndef ITK_WASM_NO_MEMORY_IO
+  // Outputs declared after the pipeline have been serialized
+  markMemoryPhase("outputs");
+#endif
+  if (m_ResultCacheMiss)
+  {
+    this->store_cached_result();
+  }
+  if (m_Profile)
+  {
+    if (profileComputeRecorded)
+    {
+      // From the first output serialization until all outputs are written
+      const std::chrono::duration<double> elapsed = ProfileClockType::now() - profileComputeEnd;
+      add_profile_event("outputs", elapsed.count());
+    }
+    this->write_profile_report();
+  }
+#ifdef ITK_WASM_TRACE
+  if (TraceScope::GetEnabled())
+  {
+    TraceScope::WriteEvents(std::cerr, this->get_name());
+  }
+#endif
+  clearInputCaches();
+}
+
+bool
+Pipeline
+::restore_cached_result()
+{
+  m_ResultCacheMiss = false;
+#ifndef ITK_WASM_NO_MEMORY_IO
+  ResultCacheStore * store = getResultCacheStore();
+  if (store == nullptr)
+  {
+    return false;
+  }
+
+  // The options are not parsed yet
+  bool useMemoryIO = false;
+  uint32_t memoryIndex = 0;
+  ContentHash hash;
+  hash.UpdateField(this->get_name());
+  for (int ii = 1; ii < this->m_argc; ++ii)
+  {
+    const std::string arg(this->m_argv[ii]);
+    if (arg == "--memory-io")
+    {
+      useMemoryIO = true;
+    }
+    if (arg == "--memory-index" && ii + 1 < this->m_argc)
+    {
+      memoryIndex = static_cast<uint32_t>(std::stoul(this->m_argv[ii + 1]));
+      ++ii;
+      continue;
+    }
+    if (arg == "--profile" || arg == "--progress" || arg == "--trace")
+    {
+      continue;
+    }
+    if (IsStageIdentifier(arg))
+    {
+      // Stage and resident inputs are not in the memory store
+      return false;
+    }
+    hash.UpdateField(arg);
+  }
+  if (!useMemoryIO || !hashMemoryStoreInputs(memoryIndex, hash))
+  {
+    return false;
+  }
+  m_ResultCacheKey = hash.Digest();
+  resetMemoryStoreUpdatedOutputs(memoryIndex);
+
+  auto entry = store->Get(m_ResultCacheKey);
+  if (entry == nullptr)
+  {
+    m_ResultCacheMiss = true;
+    return false;
+  }
+  setMemoryStoreResultCacheEntry(memoryIndex, std::move(entry));
+  return true;
+#else
+  return false;
+#endif
+}
+
+void
+Pipeline
+::store_cached_result()
+{
+#ifndef ITK_WASM_NO_MEMORY_IO
+  m_ResultCacheMiss = false;
+  ResultCacheStore * store = getResultCacheStore();
+  if (store == nullptr || getAbortRequested())
+  {
+    return;
+  }
+  auto entry = std::make_shared<ResultCacheEntry>();
+  if (getMemoryStoreResultCacheEntry(m_MemoryIndex, *entry))
+  {
+    store->Put(m_ResultCacheKey, std::move(entry));
+  }
+#endif
+}
 
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+ImageIOBase *
+Pipeline
+::get_input_image_io(const std::string & fileName)
+{
+  auto it = inputImageIOCache.find(fileName);
+  if (it == inputImageIOCache.end())
+  {
+    return nullptr;
+  }
+  return it->second.GetPointer();
+}
+
+void
+Pipeline
+::set_input_image_io(const std::string & fileName, ImageIOBase * imageIO)
+{
+  inputImageIOCache[fileName] = imageIO;
+}
+
+MeshIOBase *
+Pipeline
+::get_input_mesh_io(const std::string & fileName)
+{
+  auto it = inputMeshIOCache.find(fileName);
+  if (it == inputMeshIOCache.end())
+  {
+    return nullptr;
+  }
+  return it->second.GetPointer();
+}
+
+void
+Pipeline
+::set_input_mesh_io(const std::string & fileName, MeshIOBase * meshIO)
+{
+  inputMeshIOCache[fileName] = meshIO;
+}
+#endif
+
+std::shared_ptr<const rapidjson::Document>
+Pipeline
+::get_input_json_document(uint32_t index)
+{
+  auto it = inputJSONDocumentCache.find(index);
+  if (it == inputJSONDocumentCache.end())
+  {
+    return nullptr;
+  }
+  return it->second;
+}
+
+void
+Pipeline
+::set_input_json_document(uint32_t index, std::shared_ptr<const rapidjson::Document> document)
+{
+  inputJSONDocumentCache[index] = std::move(document);
+}
+
+void
+Pipeline
+::observe_progress(ProcessObject * filter)
+{
+  if (!m_ReportProgress || filter == nullptr)
+  {
+    return;
+  }
+
+  auto lastReport = std::make_shared<ProfileClockType::time_point>();
+  filter->AddObserver(ProgressEvent(), [filter, lastReport](const EventObject &)
+    {
+      const float progress = filter->GetProgress();
+      const auto now = ProfileClockType::now();
+      if (progress < 1.0f && now - *lastReport < std::chrono::milliseconds(100))
+      {
+        return;
+      }
+      *lastReport = now;
+#if defined(ITK_WASM_PROGRESS_IMPORT) && defined(__wasm__)
+      itk_wasm_progress(m_MemoryIndex, progress);
+#else
+      std::cerr << "{\"filter\":\"" << filter->GetNameOfClass() << "\",\"progress\":" << progress << "}" << std::endl;
+#endif
+    });
+}
+
+void
+Pipeline
+::report_output_version(const std::string & identifier, unsigned int version)
+{
+#if defined(ITK_WASM_PROGRESS_IMPORT) && defined(__wasm__)
+  if (m_UseMemoryIO)
+  {
+    itk_wasm_output_version(m_MemoryIndex, static_cast<uint32_t>(std::stoul(identifier)), version);
+    return;
+  }
+#endif
+  std::cerr << "{\"output\":\"" << identifier << "\",\"version\":" << version << "}" << std::endl;
+}
+
+void
+Pipeline
+::abort_on_request(ProcessObject * filter)
+{
+#ifndef ITK_WASM_NO_MEMORY_IO
+  if (filter == nullptr)
+  {
+    return;
+  }
+  filter->AddObserver(ProgressEvent(), [filter](const EventObject &)
+    {
+      if (getAbortRequested())
+      {
+        filter->AbortGenerateDataOn();
+      }
+    });
+#else
+  (void)filter;
+#endif
+}
+
+void
+Pipeline
+::add_profile_event(const std::string & name, double seconds)
+{
+  if (m_Profile)
+  {
+    const std::lock_guard<std::mutex> lock(profileMutex);
+    profileEvents.emplace_back(name, seconds);
+  }
+}
+
+void
+Pipeline
+::mark_profile_compute()
+{
+  if (!m_Profile || profileComputeRecorded)
+  {
+    return;
+  }
+  profileComputeRecorded = true;
+  profileComputeEnd = ProfileClockType::now();
+  const std::chrono::duration<double> elapsed = profileComputeEnd - profileParseEnd;
+  add_profile_event("compute", elapsed.count());
+}
+
+#ifdef ITK_WASM_BACKGROUND_OUTPUTS
+static std::mutex outputMutex;
+static std::vector<std::thread> outputThreads;
+static std::exception_ptr outputException;
+#endif
+
+void
+Pipeline
+::serialize_output(std::function<void()> serialization)
+{
+#ifdef ITK_WASM_BACKGROUND_OUTPUTS
+  if (MultiThreaderBase::GetGlobalDefaultNumberOfThreads() > 1)
+  {
+    auto run = [serialization]() {
+      try
+      {
+        serialization();
+      }
+      catch (...)
+      {
+        const std::lock_guard<std::mutex> lock(outputMutex);
+        if (!outputException)
+        {
+          outputException = std::current_exception();
+        }
+      }
+    };
+    try
+    {
+      const std::lock_guard<std::mutex> lock(outputMutex);
+      outputThreads.emplace_back(run);
+      return;
+    }
+    catch (const std::system_error &)
+    {
+      // No thread available, serialize in this thread
+    }
+  }
+#endif
+  serialization();
+}
+
+void
+Pipeline
+::read_input(std::function<void()> read)
+{
+#ifdef ITK_WASM_BACKGROUND_OUTPUTS
+  if (deferInputReads && MultiThreaderBase::GetGlobalDefaultNumberOfThreads() > 1)
+  {
+    deferredInputReads.push_back(std::move(read));
+    return;
+  }
+#endif
+  read();
+}
+
+void
+Pipeline
+::wait_for_outputs()
+{
+#ifdef ITK_WASM_BACKGROUND_OUTPUTS
+  std::vector<std::thread> threads;
+  {
+    const std::lock_guard<std::mutex> lock(outputMutex);
+    threads.swap(outputThreads);
+  }
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+  std::exception_ptr exception;
+  {
+    const std::lock_guard<std::mutex> lock(outputMutex);
+    std::swap(exception, outputException);
+  }
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+#endif
+}
+
+void
+Pipeline
+::write_profile_report() const
+{
+  rapidjson::Document document;
+  document.SetObject();
+  rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
+
+  rapidjson::Value name;
+  name.SetString(this->get_name().c_str(), allocator);
+  document.AddMember("name", name.Move(), allocator);
+
+  rapidjson::Value events(rapidjson::kArrayType);
+  for (const auto & entry : profileEvents)
+  {
+    rapidjson::Value event(rapidjson::kObjectType);
+    rapidjson::Value eventName;
+    eventName.SetString(entry.first.c_str(), allocator);
+    event.AddMember("name", eventName.Move(), allocator);
+    event.AddMember("seconds", rapidjson::Value(entry.second), allocator);
+    events.PushBack(event, allocator);
+  }
+  document.AddMember("profile", events, allocator);
+
+  rapidjson::OStreamWrapper ostreamWrapper( std::cerr );
+  rapidjson::Writer<rapidjson::OStreamWrapper> writer( ostreamWrapper );
+  document.Accept(writer);
+  std::cerr << std::endl;
+}
+
+int
+RunBatch(int argc, char * argv[], PipelineMainType pipelineMain)
+{
+  std::vector<std::string> commonArgs;
+  std::string manifestFileName;
+  for (int ii = 0; ii < argc; ++ii)
+  {
+    const std::string arg(argv[ii]);
+    if (arg == "--batch" && ii + 1 < argc)
+    {
+      manifestFileName = argv[++ii];
+      continue;
+    }
+    commonArgs.push_back(arg);
+  }
+  if (manifestFileName.empty())
+  {
+    return pipelineMain(argc, argv);
+  }
+
+#ifndef ITK_WASM_NO_FILESYSTEM_IO
+  std::ifstream manifestStream(manifestFileName);
+  const std::string manifest{ std::istreambuf_iterator<char>(manifestStream),
+                              std::istreambuf_iterator<char>() };
+  rapidjson::Document document;
+  if (!manifestStream || document.Parse(manifest.c_str()).HasParseError() || !document.IsArray())
+  {
+    std::cerr << "Could not read batch manifest: " << manifestFileName << std::endl;
+    return 1;
+  }
+
+  int result = 0;
+  for (const auto & entry : document.GetArray())
+  {
+    if (!entry.IsArray())
+    {
+      std::cerr << "Batch manifest entries must be arrays of arguments" << std::endl;
+      return 1;
+    }
+    std::vector<std::string> entryArgs(commonArgs);
+    for (const auto & arg : entry.GetArray())
+    {
+      entryArgs.emplace_back(arg.IsString() ? arg.GetString() : "");
+    }
+    std::vector<char *> entryArgv;
+    for (auto & arg : entryArgs)
+    {
+      entryArgv.push_back(arg.data());
+    }
+    entryArgv.push_back(nullptr);
+    const int entryResult = pipelineMain(static_cast<int>(entryArgs.size()), entryArgv.data());
+    if (result == 0 && entryResult != 0)
+    {
+      result = entryResult;
+    }
+  }
+  return result;
+#else
+  std::cerr << "Batch manifests require filesystem IO" << std::endl;
+  return 1;
+#endif
+}
+
+ProfileScope
+::ProfileScope(std::string name):
+  m_Name(std::move(name)),
+  m_Start(ProfileClockType::now())
+{
+}
+
+ProfileScope
+::~ProfileScope()
+{
+  if (Pipeline::get_profile())
+  {
+    const std::chrono::duration<double> elapsed = ProfileClockType::now() - m_Start;
+    Pipeline::add_profile_event(m_Name, elapsed.count());
+  }
+#ifdef ITK_WASM_TRACE
+  TraceScope::AddEvent(m_Name, "itk-wasm-phase", m_Start, ProfileClockType::now());
+#endif
 }
 
 void
@@ -314,7 +1022,9 @@ Pipeline
     option.AddMember("description", optionDescription.Move(), allocator);
 
     auto singleName = opt->get_single_name();
-    if (singleName == "help")
+    if (singleName == "help" || singleName == "memory-index" || singleName == "profile" || singleName == "progress" || singleName == "progressive" || singleName == "trace" ||
+        singleName == "threads" || singleName == "threader" || singleName == "max-memory" || singleName == "metadata-include" ||
+        singleName == "metadata-exclude")
     {
       continue;
     }
@@ -388,6 +1098,13 @@ Pipeline
 }
 
 bool Pipeline::m_UseMemoryIO{false};
+uint32_t Pipeline::m_MemoryIndex{0};
+bool Pipeline::m_Profile{false};
+uint64_t Pipeline::m_MaxMemory{0};
+bool Pipeline::m_ReportProgress{false};
+bool Pipeline::m_Progressive{false};
+MetaDataKeyFilter Pipeline::m_MetaDataKeyFilter;
+ComponentConversion Pipeline::m_ComponentConversion{ComponentConversion::None};
 
 } // end namespace wasm
 } // end namespace itk
@@ -0,0 +1,260 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineStageStore.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <string_view>
+#include <utility>
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+struct StageDataObject
+{
+  DataObject::ConstPointer dataObject;
+  StageDataObjectType type;
+  StageImageBuffer buffer;
+};
+
+// identifier
+std::map<std::string, StageDataObject> stageDataObjects;
+
+constexpr std::string_view StageIdentifierPrefix = "stage:";
+constexpr std::string_view HandleIdentifierPrefix = "handle:";
+} // namespace
+
+bool IsStageIdentifier(const std::string & identifier)
+{
+  return (identifier.size() > StageIdentifierPrefix.size() && identifier.compare(0, StageIdentifierPrefix.size(), StageIdentifierPrefix) == 0) ||
+         IsHandleIdentifier(identifier);
+}
+
+bool IsHandleIdentifier(const std::string & identifier)
+{
+  if (identifier.size() <= HandleIdentifierPrefix.size() || identifier.compare(0, HandleIdentifierPrefix.size(), HandleIdentifierPrefix) != 0)
+  {
+    return false;
+  }
+  return std::all_of(identifier.begin() + HandleIdentifierPrefix.size(), identifier.end(), [](unsigned char c) { return std::isdigit(c); });
+}
+
+std::string GetHandleIdentifier(uint32_t handle)
+{
+  return std::string(HandleIdentifierPrefix) + std::to_string(handle);
+}
+
+void SetStageDataObject(const std::string & identifier, const DataObject * dataObject, const StageDataObjectType & type)
+{
+  auto & stageDataObject = stageDataObjects[identifier];
+  stageDataObject.dataObject = dataObject;
+  stageDataObject.type = type;
+  stageDataObject.buffer = StageImageBuffer();
+}
+
+void SetStageImageBuffer(const std::string & identifier, const StageImageBuffer & buffer)
+{
+  auto it = stageDataObjects.find(identifier);
+  if (it != stageDataObjects.end())
+  {
+    it->second.buffer = buffer;
+  }
+}
+
+namespace
+{
+// The stored image with a pixel buffer, or nullptr
+StageDataObject * GetStageImage(const std::string & identifier)
+{
+  auto it = stageDataObjects.find(identifier);
+  if (it == stageDataObjects.end() || it->second.buffer.data == nullptr || it->second.buffer.pixelSize == 0)
+  {
+    return nullptr;
+  }
+  return &(it->second);
+}
+
+uint64_t ReadUInt64(const unsigned char * bytes)
+{
+  uint64_t value = 0;
+  for (unsigned int ii = 0; ii < 8; ++ii)
+  {
+    value |= static_cast<uint64_t>(bytes[ii]) << (8 * ii);
+  }
+  return value;
+}
+} // namespace
+
+bool PatchStageImageRegion(const std::string & identifier, const int64_t * regionIndex, const uint64_t * regionSize, const void * data, size_t dataSize)
+{
+  StageDataObject * stageImage = GetStageImage(identifier);
+  if (stageImage == nullptr)
+  {
+    return false;
+  }
+  const StageImageBuffer & buffer = stageImage->buffer;
+  const size_t dimension = buffer.size.size();
+  size_t numberOfPixels = 1;
+  for (size_t ii = 0; ii < dimension; ++ii)
+  {
+    const int64_t start = regionIndex[ii] - buffer.index[ii];
+    if (start < 0 || static_cast<uint64_t>(start) > buffer.size[ii] || regionSize[ii] > buffer.size[ii] - static_cast<uint64_t>(start))
+    {
+      return false;
+    }
+    numberOfPixels *= regionSize[ii];
+  }
+  if (numberOfPixels * buffer.pixelSize != dataSize)
+  {
+    return false;
+  }
+
+  if (numberOfPixels > 0)
+  {
+    // Copy row by row along the fastest dimension
+    auto * pixels = static_cast<unsigned char *>(buffer.data);
+    const auto * source = static_cast<const unsigned char *>(data);
+    const size_t rowSize = regionSize[0] * buffer.pixelSize;
+    std::vector<uint64_t> position(dimension, 0);
+    for (size_t row = 0; row < numberOfPixels / regionSize[0]; ++row)
+    {
+      size_t offset = 0;
+      size_t stride = 1;
+      for (size_t ii = 0; ii < dimension; ++ii)
+      {
+        offset += (regionIndex[ii] - buffer.index[ii] + position[ii]) * stride;
+        stride *= buffer.size[ii];
+      }
+      std::memcpy(pixels + offset * buffer.pixelSize, source, rowSize);
+      source += rowSize;
+      for (size_t ii = 1; ii < dimension; ++ii)
+      {
+        if (++position[ii] < regionSize[ii])
+        {
+          break;
+        }
+        position[ii] = 0;
+      }
+    }
+  }
+  const_cast<DataObject *>(stageImage->dataObject.GetPointer())->Modified();
+  return true;
+}
+
+bool PatchStageImageRuns(const std::string & identifier, const void * runs, size_t runsSize)
+{
+  StageDataObject * stageImage = GetStageImage(identifier);
+  if (stageImage == nullptr)
+  {
+    return false;
+  }
+  const StageImageBuffer & buffer = stageImage->buffer;
+  const size_t runSize = 16 + buffer.pixelSize;
+  if (runsSize % runSize != 0)
+  {
+    return false;
+  }
+  uint64_t numberOfPixels = 1;
+  for (const size_t size : buffer.size)
+  {
+    numberOfPixels *= size;
+  }
+
+  // Validate all runs before the image is changed
+  const auto * bytes = static_cast<const unsigned char *>(runs);
+  for (size_t position = 0; position < runsSize; position += runSize)
+  {
+    const uint64_t offset = ReadUInt64(bytes + position);
+    const uint64_t count = ReadUInt64(bytes + position + 8);
+    if (offset > numberOfPixels || count > numberOfPixels - offset)
+    {
+      return false;
+    }
+  }
+
+  auto * pixels = static_cast<unsigned char *>(buffer.data);
+  for (size_t position = 0; position < runsSize; position += runSize)
+  {
+    const uint64_t offset = ReadUInt64(bytes + position);
+    const uint64_t count = ReadUInt64(bytes + position + 8);
+    const unsigned char * value = bytes + position + 16;
+    unsigned char * destination = pixels + offset * buffer.pixelSize;
+    if (buffer.pixelSize == 1)
+    {
+      std::memset(destination, *value, count);
+      continue;
+    }
+    for (uint64_t ii = 0; ii < count; ++ii)
+    {
+      std::memcpy(destination + ii * buffer.pixelSize, value, buffer.pixelSize);
+    }
+  }
+  const_cast<DataObject *>(stageImage->dataObject.GetPointer())->Modified();
+  return true;
+}
+
+const DataObject * GetStageDataObject(const std::string & identifier)
+{
+  auto it = stageDataObjects.find(identifier);
+  if (it == stageDataObjects.end())
+  {
+    return nullptr;
+  }
+  return it->second.dataObject.GetPointer();
+}
+
+const StageDataObjectType * GetStageDataObjectType(const std::string & identifier)
+{
+  auto it = stageDataObjects.find(identifier);
+  if (it == stageDataObjects.end())
+  {
+    return nullptr;
+  }
+  return &(it->second.type);
+}
+
+void ClearStageDataObjects()
+{
+  for (auto it = stageDataObjects.begin(); it != stageDataObjects.end();)
+  {
+    it = IsHandleIdentifier(it->first) ? std::next(it) : stageDataObjects.erase(it);
+  }
+}
+
+void ReleaseHandleDataObject(uint32_t handle)
+{
+  stageDataObjects.erase(GetHandleIdentifier(handle));
+}
+
+void ReleaseHandleDataObjects()
+{
+  for (auto it = stageDataObjects.begin(); it != stageDataObjects.end();)
+  {
+    it = IsHandleIdentifier(it->first) ? stageDataObjects.erase(it) : std::next(it);
+  }
+}
+
+} // end namespace wasm
+} // end namespace itk
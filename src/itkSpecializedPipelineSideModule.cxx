@@ -0,0 +1,73 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkSpecializedPipelineSideModule.h"
+
+#include <cstdlib>
+#include <sstream>
+
+#ifdef ITK_WASM_SIDE_MODULES
+#include <dlfcn.h>
+#endif
+
+namespace itk
+{
+namespace wasm
+{
+
+std::string
+SpecializedPipelineSideModuleName(const std::string & pipelineName, unsigned int dimension, const std::string & componentType, const std::string & pixelType, unsigned int components)
+{
+  std::ostringstream ostrm;
+  const char * sideModulePath = std::getenv("ITK_WASM_SIDE_MODULE_PATH");
+  if (sideModulePath != nullptr && sideModulePath[0] != '\0')
+  {
+    ostrm << sideModulePath << '/';
+  }
+  ostrm << pipelineName << '-' << dimension << '-' << componentType << '-' << pixelType << '-' << components;
+#if defined(__EMSCRIPTEN__) || defined(__wasi__)
+  ostrm << ".wasm";
+#else
+  ostrm << ".so";
+#endif
+  return ostrm.str();
+}
+
+SpecializedPipelineFunctionType
+LoadSpecializedPipelineSideModule(const std::string & pipelineName, unsigned int dimension, const std::string & componentType, const std::string & pixelType, unsigned int components)
+{
+#ifdef ITK_WASM_SIDE_MODULES
+  const std::string fileName = SpecializedPipelineSideModuleName(pipelineName, dimension, componentType, pixelType, components);
+  // The module stays loaded for the lifetime of the process
+  void * handle = dlopen(fileName.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (handle == nullptr)
+  {
+    return nullptr;
+  }
+  return reinterpret_cast< SpecializedPipelineFunctionType >(dlsym(handle, "itk_wasm_specialized_pipeline"));
+#else
+  (void)pipelineName;
+  (void)dimension;
+  (void)componentType;
+  (void)pixelType;
+  (void)components;
+  return nullptr;
+#endif
+}
+
+} // end namespace wasm
+} // end namespace itk
@@ -16,10 +16,14 @@
  *
  *=========================================================================*/
 #include "itkSupportInputImageTypes.h"
+#include "itkPipelineStageStore.h"
 #include "itkWasmExports.h"
+#include "itkWasmLazyIOFactory.h"
 
 #include "rapidjson/document.h"
 
+#include <memory>
+
 namespace itk
 {
 
@@ -28,18 +32,42 @@ namespace wasm
 
 bool lexical_cast(const std::string &input, InterfaceImageType & imageType)
 {
+  if (IsStageIdentifier(input))
+  {
+    const StageDataObjectType * stageType = GetStageDataObjectType(input);
+    if (stageType == nullptr)
+    {
+      return false;
+    }
+    imageType.dimension = stageType->dimension;
+    imageType.componentType = stageType->componentType;
+    imageType.pixelType = stageType->pixelType;
+    imageType.components = stageType->components;
+    return true;
+  }
+
   if (wasm::Pipeline::get_use_memory_io())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
     const unsigned int index = std::stoi(input);
-    auto json = getMemoryStoreInputJSON(0, index);
-    rapidjson::Document document;
-    if (document.Parse(json.c_str()).HasParseError())
+    const auto descriptor = getMemoryStoreInputImageDescriptor(wasm::Pipeline::get_memory_index(), index);
+    if (descriptor != nullptr)
+    {
+      imageType.dimension = descriptor->dimension;
+      imageType.componentType = GetWasmImageDescriptorString(descriptor->componentType);
+      imageType.pixelType = GetWasmImageDescriptorString(descriptor->pixelType);
+      imageType.components = descriptor->components;
+      return true;
+    }
+    auto json = getMemoryStoreInputJSON(wasm::Pipeline::get_memory_index(), index);
+    auto document = std::make_shared<rapidjson::Document>();
+    if (document->Parse(json.c_str()).HasParseError())
       {
       throw std::runtime_error("Could not parse JSON");
       }
+    Pipeline::set_input_json_document(index, document);
 
-    const rapidjson::Value & jsonImageType = document["imageType"];
+    const rapidjson::Value & jsonImageType = (*document)["imageType"];
     imageType.dimension = jsonImageType["dimension"].GetInt();
     imageType.componentType = jsonImageType["componentType"].GetString();
     imageType.pixelType = jsonImageType["pixelType"].GetString();
@@ -51,7 +79,7 @@ bool lexical_cast(const std::string &input, InterfaceImageType & imageType)
   else
   {
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
-    ImageIOBase::Pointer imageIO = ImageIOFactory::CreateImageIO(input.c_str(), CommonEnums::IOFileMode::ReadMode);
+    ImageIOBase::Pointer imageIO = LazyImageIOFactory::CreateIO(input.c_str(), CommonEnums::IOFileMode::ReadMode);
     if (imageIO.IsNull())
     {
       std::cerr << "IO not available for: " << input << std::endl;
@@ -59,6 +87,7 @@ bool lexical_cast(const std::string &input, InterfaceImageType & imageType)
     }
     imageIO->SetFileName(input);
     imageIO->ReadImageInformation();
+    Pipeline::set_input_image_io(input, imageIO);
 
     imageType.dimension = imageIO->GetNumberOfDimensions();
 
@@ -16,10 +16,14 @@
  *
  *=========================================================================*/
 #include "itkSupportInputMeshTypes.h"
+#include "itkPipelineStageStore.h"
 #include "itkWasmExports.h"
+#include "itkWasmLazyIOFactory.h"
 
 #include "rapidjson/document.h"
 
+#include <memory>
+
 namespace itk
 {
 
@@ -28,18 +32,33 @@ namespace wasm
 
 bool lexical_cast(const std::string &input, InterfaceMeshType & meshType)
 {
+  if (IsStageIdentifier(input))
+  {
+    const StageDataObjectType * stageType = GetStageDataObjectType(input);
+    if (stageType == nullptr)
+    {
+      return false;
+    }
+    meshType.dimension = stageType->dimension;
+    meshType.componentType = stageType->componentType;
+    meshType.pixelType = stageType->pixelType;
+    meshType.components = stageType->components;
+    return true;
+  }
+
   if (wasm::Pipeline::get_use_memory_io())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
     const unsigned int index = std::stoi(input);
-    auto json = getMemoryStoreInputJSON(0, index);
-    rapidjson::Document document;
-    if (document.Parse(json.c_str()).HasParseError())
+    auto json = getMemoryStoreInputJSON(wasm::Pipeline::get_memory_index(), index);
+    auto document = std::make_shared<rapidjson::Document>();
+    if (document->Parse(json.c_str()).HasParseError())
       {
       throw std::runtime_error("Could not parse JSON");
       }
+    Pipeline::set_input_json_document(index, document);
 
-    const rapidjson::Value & jsonMeshType = document["meshType"];
+    const rapidjson::Value & jsonMeshType = (*document)["meshType"];
     meshType.dimension = jsonMeshType["dimension"].GetInt();
     meshType.componentType = jsonMeshType["pointPixelComponentType"].GetString();
     meshType.pixelType = jsonMeshType["pointPixelType"].GetString();
@@ -55,14 +74,16 @@ bool lexical_cast(const std::string &input, InterfaceMeshType & meshType)
   else
   {
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
-    MeshIOBase::Pointer meshIO = MeshIOFactory::CreateMeshIO(input.c_str(), CommonEnums::IOFileMode::ReadMode);
+    MeshIOBase::Pointer meshIO = LazyMeshIOFactory::CreateIO(input.c_str(), CommonEnums::IOFileMode::ReadMode);
     if (meshIO.IsNull())
     {
       std::cerr << "IO not available for: " << input << std::endl;
       return false;
     }
     meshIO->SetFileName(input);
+    // For .iwm.cbor files, only the entries before the typed arrays are read
     meshIO->ReadMeshInformation();
+    Pipeline::set_input_mesh_io(input, meshIO);
 
     meshType.dimension = meshIO->GetPointDimension();
 
@@ -77,7 +98,7 @@ bool lexical_cast(const std::string &input, InterfaceMeshType & meshType)
     meshType.components = meshIO->GetNumberOfPointPixelComponents();
     if (meshType.components == 0)
     {
-      meshType.components = meshIO->GetNumberOfPointPixelComponents();
+      meshType.components = meshIO->GetNumberOfCellPixelComponents();
     }
 #else
     return false;
@@ -16,7 +16,9 @@
  *
  *=========================================================================*/
 #include "itkSupportInputPolyDataTypes.h"
+#include "itkPipelineStageStore.h"
 #include "itkWasmExports.h"
+#include "itkWasmLazyIOFactory.h"
 
 #include "rapidjson/document.h"
 
@@ -28,11 +30,24 @@ namespace wasm
 
 bool lexical_cast(const std::string &input, InterfacePolyDataType & polyDataType)
 {
+  if (IsStageIdentifier(input))
+  {
+    const StageDataObjectType * stageType = GetStageDataObjectType(input);
+    if (stageType == nullptr)
+    {
+      return false;
+    }
+    polyDataType.componentType = stageType->componentType;
+    polyDataType.pixelType = stageType->pixelType;
+    polyDataType.components = stageType->components;
+    return true;
+  }
+
   if (wasm::Pipeline::get_use_memory_io())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
     const unsigned int index = std::stoi(input);
-    auto json = getMemoryStoreInputJSON(0, index);
+    auto json = getMemoryStoreInputJSON(wasm::Pipeline::get_memory_index(), index);
     rapidjson::Document document;
     if (document.Parse(json.c_str()).HasParseError())
       {
@@ -54,7 +69,7 @@ bool lexical_cast(const std::string &input, InterfacePolyDataType & polyDataType
   else
   {
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
-    MeshIOBase::Pointer meshIO = MeshIOFactory::CreateMeshIO(input.c_str(), CommonEnums::IOFileMode::ReadMode);
+    MeshIOBase::Pointer meshIO = LazyMeshIOFactory::CreateIO(input.c_str(), CommonEnums::IOFileMode::ReadMode);
     if (meshIO.IsNull())
     {
       std::cerr << "IO not available for: " << input << std::endl;
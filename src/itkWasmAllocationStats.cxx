@@ -0,0 +1,256 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmAllocationStats.h"
+
+#ifdef ITK_WASM_ALLOCATION_STATS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+
+std::atomic<uint64_t> allocationCounts[NumberOfAllocationSizeClasses];
+std::atomic<uint64_t> allocationBytes[NumberOfAllocationSizeClasses];
+std::atomic<uint64_t> copyBytes[static_cast<unsigned int>(CopyBoundary::Count)];
+
+unsigned int
+GetSizeClass(size_t size)
+{
+  unsigned int sizeClass = 0;
+  size_t limit = 16;
+  while (size > limit && sizeClass + 1 < NumberOfAllocationSizeClasses)
+  {
+    limit *= 16;
+    ++sizeClass;
+  }
+  return sizeClass;
+}
+
+void
+CountAllocation(size_t size)
+{
+  const unsigned int sizeClass = GetSizeClass(size);
+  allocationCounts[sizeClass].fetch_add(1, std::memory_order_relaxed);
+  allocationBytes[sizeClass].fetch_add(size, std::memory_order_relaxed);
+}
+
+void *
+Allocate(size_t size)
+{
+  CountAllocation(size);
+  void * pointer = std::malloc(size == 0 ? 1 : size);
+  if (pointer == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void *
+AllocateAligned(size_t size, std::align_val_t alignment)
+{
+  CountAllocation(size);
+  const size_t alignmentBytes = static_cast<size_t>(alignment);
+  // aligned_alloc sizes are multiples of the alignment
+  const size_t alignedSize = (size + alignmentBytes - 1) / alignmentBytes * alignmentBytes;
+#ifdef _MSC_VER
+  void * pointer = _aligned_malloc(alignedSize == 0 ? alignmentBytes : alignedSize, alignmentBytes);
+#else
+  void * pointer = std::aligned_alloc(alignmentBytes, alignedSize == 0 ? alignmentBytes : alignedSize);
+#endif
+  if (pointer == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void
+FreeAligned(void * pointer)
+{
+#ifdef _MSC_VER
+  _aligned_free(pointer);
+#else
+  std::free(pointer);
+#endif
+}
+
+} // end anonymous namespace
+
+void addCopiedBytes(CopyBoundary boundary, size_t bytes)
+{
+  copyBytes[static_cast<unsigned int>(boundary)].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+AllocationStats getAllocationStats()
+{
+  AllocationStats stats;
+  for (unsigned int ii = 0; ii < NumberOfAllocationSizeClasses; ++ii)
+  {
+    stats.allocations[ii] = allocationCounts[ii].load(std::memory_order_relaxed);
+    stats.allocatedBytes[ii] = allocationBytes[ii].load(std::memory_order_relaxed);
+  }
+  for (unsigned int ii = 0; ii < static_cast<unsigned int>(CopyBoundary::Count); ++ii)
+  {
+    stats.copiedBytes[ii] = copyBytes[ii].load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
+void resetAllocationStats()
+{
+  for (unsigned int ii = 0; ii < NumberOfAllocationSizeClasses; ++ii)
+  {
+    allocationCounts[ii].store(0, std::memory_order_relaxed);
+    allocationBytes[ii].store(0, std::memory_order_relaxed);
+  }
+  for (auto & bytes : copyBytes)
+  {
+    bytes.store(0, std::memory_order_relaxed);
+  }
+}
+
+const char * getCopyBoundaryName(CopyBoundary boundary)
+{
+  switch (boundary)
+  {
+    case CopyBoundary::InputStore:
+      return "inputStore";
+    case CopyBoundary::CBORToBuffer:
+      return "cborToBuffer";
+    case CopyBoundary::Zstd:
+      return "zstd";
+    case CopyBoundary::StringStream:
+      return "stringStream";
+    case CopyBoundary::OutputStore:
+      return "outputStore";
+    default:
+      return "unknown";
+  }
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+// The replacements are linked with the rest of this object file, which the
+// memory stats reference
+void *
+operator new(size_t size)
+{
+  return itk::wasm::Allocate(size);
+}
+
+void *
+operator new[](size_t size)
+{
+  return itk::wasm::Allocate(size);
+}
+
+void *
+operator new(size_t size, const std::nothrow_t &) noexcept
+{
+  try
+  {
+    return itk::wasm::Allocate(size);
+  }
+  catch (...)
+  {
+    return nullptr;
+  }
+}
+
+void *
+operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+  try
+  {
+    return itk::wasm::Allocate(size);
+  }
+  catch (...)
+  {
+    return nullptr;
+  }
+}
+
+void *
+operator new(size_t size, std::align_val_t alignment)
+{
+  return itk::wasm::AllocateAligned(size, alignment);
+}
+
+void *
+operator new[](size_t size, std::align_val_t alignment)
+{
+  return itk::wasm::AllocateAligned(size, alignment);
+}
+
+void
+operator delete(void * pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void
+operator delete[](void * pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void
+operator delete(void * pointer, size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void
+operator delete[](void * pointer, size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void
+operator delete(void * pointer, std::align_val_t) noexcept
+{
+  itk::wasm::FreeAligned(pointer);
+}
+
+void
+operator delete[](void * pointer, std::align_val_t) noexcept
+{
+  itk::wasm::FreeAligned(pointer);
+}
+
+void
+operator delete(void * pointer, size_t, std::align_val_t) noexcept
+{
+  itk::wasm::FreeAligned(pointer);
+}
+
+void
+operator delete[](void * pointer, size_t, std::align_val_t) noexcept
+{
+  itk::wasm::FreeAligned(pointer);
+}
+
+#endif
@@ -0,0 +1,449 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmBundleFile.h"
+#include "itkWasmCBORSink.h"
+#include "itkWasmCBORSource.h"
+
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+
+class BundleMemberRangeReader : public RangeReader
+{
+public:
+  BundleMemberRangeReader(std::unique_ptr<RangeReader> reader, uint64_t offset, uint64_t size)
+    : m_Reader(std::move(reader))
+    , m_Offset(offset)
+    , m_Size(size)
+  {}
+
+  uint64_t
+  GetSize() const override
+  {
+    return m_Size;
+  }
+
+  bool
+  Read(uint64_t offset, void * data, size_t size) override
+  {
+    if (offset > m_Size || size > m_Size - offset)
+    {
+      return false;
+    }
+    return m_Reader->Read(m_Offset + offset, data, size);
+  }
+
+private:
+  std::unique_ptr<RangeReader> m_Reader;
+  uint64_t                     m_Offset;
+  uint64_t                     m_Size;
+};
+
+bool
+ReadString(CBORSource & source, std::string & value)
+{
+  CBORHead head;
+  if (!ReadCBORHead(source, head) || head.majorType != 3)
+  {
+    return false;
+  }
+  value.resize(static_cast<size_t>(head.argument));
+  return source.Read(value.data(), value.size());
+}
+
+bool
+ReadUInt(CBORSource & source, uint64_t & value)
+{
+  CBORHead head;
+  if (!ReadCBORHead(source, head) || head.majorType != 0)
+  {
+    return false;
+  }
+  value = head.argument;
+  return true;
+}
+
+bool
+ReadBool(CBORSource & source, bool & value)
+{
+  CBORHead head;
+  if (!ReadCBORHead(source, head) || head.majorType != 7 || (head.argument != 20 && head.argument != 21))
+  {
+    return false;
+  }
+  value = head.argument == 21;
+  return true;
+}
+
+bool
+ReadDouble(CBORSource & source, double & value)
+{
+  CBORHead head;
+  // Single or double precision floats
+  if (!ReadCBORHead(source, head) || head.majorType != 7 || (head.size != 5 && head.size != 9))
+  {
+    return false;
+  }
+  if (head.size == 5)
+  {
+    float single = 0.0f;
+    const uint32_t bits = static_cast<uint32_t>(head.argument);
+    std::memcpy(&single, &bits, sizeof(single));
+    value = single;
+    return true;
+  }
+  std::memcpy(&value, &head.argument, sizeof(value));
+  return true;
+}
+
+bool
+ReadBounds(CBORSource & source, std::vector<double> & bounds)
+{
+  CBORHead head;
+  if (!ReadCBORHead(source, head) || head.majorType != 4)
+  {
+    return false;
+  }
+  bounds.resize(static_cast<size_t>(head.argument));
+  for (double & bound : bounds)
+  {
+    if (!ReadDouble(source, bound))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+SkipItem(CBORSource & source)
+{
+  std::vector<unsigned char> skipped;
+  return CopyCBORItem(source, skipped);
+}
+
+bool
+ReadMember(CBORSource & source, BundleMember & member)
+{
+  CBORHead mapHead;
+  if (!ReadCBORHead(source, mapHead) || mapHead.majorType != 5)
+  {
+    return false;
+  }
+  std::string key;
+  for (uint64_t ii = 0; ii < mapHead.argument; ++ii)
+  {
+    if (!ReadString(source, key))
+    {
+      return false;
+    }
+    bool read = false;
+    if (key == "name")
+    {
+      read = ReadString(source, member.name);
+    }
+    else if (key == "offset")
+    {
+      read = ReadUInt(source, member.offset);
+    }
+    else if (key == "size")
+    {
+      read = ReadUInt(source, member.size);
+    }
+    else if (key == "encoding")
+    {
+      read = ReadString(source, member.encoding);
+    }
+    else if (key == "sharedMetadata")
+    {
+      read = ReadBool(source, member.sharedMetadata);
+    }
+    else if (key == "level")
+    {
+      uint64_t level = 0;
+      read = ReadUInt(source, level);
+      member.level = static_cast<uint32_t>(level);
+    }
+    else if (key == "bounds")
+    {
+      read = ReadBounds(source, member.bounds);
+    }
+    else
+    {
+      read = SkipItem(source);
+    }
+    if (!read)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string
+EncodeTableOfContents(const BundleTableOfContents & tableOfContents)
+{
+  std::string encoded;
+  MemoryCBORSink sink(encoded);
+  sink.WriteMap(3);
+  sink.WriteString("bundleType");
+  sink.WriteString(tableOfContents.bundleType);
+  sink.WriteString("metadata");
+  // The metadata map is already encoded
+  encoded.append(tableOfContents.metadata);
+  sink.WriteString("members");
+  sink.WriteArray(tableOfContents.members.size());
+  for (const BundleMember & member : tableOfContents.members)
+  {
+    // Members that are not chunks keep the entries of earlier readers
+    const bool chunk = !member.bounds.empty();
+    sink.WriteMap(chunk ? 7 : 5);
+    sink.WriteString("name");
+    sink.WriteString(member.name);
+    sink.WriteString("offset");
+    sink.WriteUInt(member.offset);
+    sink.WriteString("size");
+    sink.WriteUInt(member.size);
+    sink.WriteString("encoding");
+    sink.WriteString(member.encoding);
+    sink.WriteString("sharedMetadata");
+    sink.WriteBool(member.sharedMetadata);
+    if (chunk)
+    {
+      sink.WriteString("level");
+      sink.WriteUInt(member.level);
+      sink.WriteString("bounds");
+      sink.WriteArray(member.bounds.size());
+      for (const double bound : member.bounds)
+      {
+        sink.WriteDouble(bound);
+      }
+    }
+  }
+  return encoded;
+}
+
+void
+EncodeOffset(uint64_t offset, unsigned char * bytes)
+{
+  for (size_t ii = 0; ii < 8; ++ii)
+  {
+    bytes[ii] = static_cast<unsigned char>(offset >> (8 * ii));
+  }
+}
+
+bool
+TruncateFile(FILE * file, uint64_t size)
+{
+#if defined(_WIN32)
+  return _chsize_s(_fileno(file), static_cast<__int64>(size)) == 0;
+#else
+  return ftruncate(fileno(file), static_cast<off_t>(size)) == 0;
+#endif
+}
+
+} // end anonymous namespace
+
+bool
+ReadBundleTableOfContents(RangeReader & reader, BundleTableOfContents & tableOfContents)
+{
+  unsigned char header[BundleFileHeaderSize];
+  if (reader.GetSize() < BundleFileHeaderSize || !reader.Read(0, header, BundleFileHeaderSize) ||
+      std::memcmp(header, BundleFileMagic.data(), BundleFileMagic.size()) != 0)
+  {
+    return false;
+  }
+  uint64_t offset = 0;
+  for (size_t ii = 0; ii < 8; ++ii)
+  {
+    offset |= static_cast<uint64_t>(header[BundleFileMagic.size() + ii]) << (8 * ii);
+  }
+  if (offset < BundleFileHeaderSize || offset >= reader.GetSize())
+  {
+    return false;
+  }
+
+  std::vector<unsigned char> encoded(static_cast<size_t>(reader.GetSize() - offset));
+  if (!reader.Read(offset, encoded.data(), encoded.size()))
+  {
+    return false;
+  }
+  MemoryCBORSource source(encoded.data(), encoded.size());
+  CBORHead mapHead;
+  if (!ReadCBORHead(source, mapHead) || mapHead.majorType != 5)
+  {
+    return false;
+  }
+  tableOfContents = BundleTableOfContents();
+  tableOfContents.offset = offset;
+  std::string key;
+  for (uint64_t ii = 0; ii < mapHead.argument; ++ii)
+  {
+    if (!ReadString(source, key))
+    {
+      return false;
+    }
+    if (key == "bundleType")
+    {
+      if (!ReadString(source, tableOfContents.bundleType))
+      {
+        return false;
+      }
+    }
+    else if (key == "metadata")
+    {
+      std::vector<unsigned char> metadata;
+      if (!CopyCBORItem(source, metadata) || (metadata[0] >> 5) != 5)
+      {
+        return false;
+      }
+      tableOfContents.metadata.assign(metadata.begin(), metadata.end());
+    }
+    else if (key == "members")
+    {
+      CBORHead arrayHead;
+      if (!ReadCBORHead(source, arrayHead) || arrayHead.majorType != 4)
+      {
+        return false;
+      }
+      for (uint64_t jj = 0; jj < arrayHead.argument; ++jj)
+      {
+        BundleMember member;
+        if (!ReadMember(source, member) || member.offset < BundleFileHeaderSize || member.offset > offset ||
+            member.size > offset - member.offset)
+        {
+          return false;
+        }
+        tableOfContents.members.push_back(std::move(member));
+      }
+    }
+    else if (!SkipItem(source))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+const BundleMember *
+FindBundleMember(const BundleTableOfContents & tableOfContents, const std::string & name, uint64_t index)
+{
+  if (name.empty())
+  {
+    return index < tableOfContents.members.size() ? &tableOfContents.members[static_cast<size_t>(index)] : nullptr;
+  }
+  for (const BundleMember & member : tableOfContents.members)
+  {
+    if (member.name == name)
+    {
+      return &member;
+    }
+  }
+  return nullptr;
+}
+
+std::unique_ptr<RangeReader>
+OpenBundleMember(std::unique_ptr<RangeReader> reader, const BundleMember & member)
+{
+  return std::make_unique<BundleMemberRangeReader>(std::move(reader), member.offset, member.size);
+}
+
+bool
+ReadBundleForAppending(const std::string & fileName, std::string_view bundleType, bool append, BundleTableOfContents & tableOfContents)
+{
+  tableOfContents = BundleTableOfContents();
+  tableOfContents.bundleType = bundleType;
+  std::unique_ptr<RangeReader> reader = append && !RangeReader::IsURL(fileName) ? RangeReader::Open(fileName) : nullptr;
+  if (!reader || reader->GetSize() == 0)
+  {
+    return true;
+  }
+  return ReadBundleTableOfContents(*reader, tableOfContents) && tableOfContents.bundleType == bundleType;
+}
+
+bool
+BeginBundleMember(const std::string & fileName, const BundleTableOfContents & tableOfContents)
+{
+  if (!tableOfContents.members.empty())
+  {
+    // The next member replaces the table of contents
+    FILE * file = fopen(fileName.c_str(), "r+b");
+    if (file == nullptr)
+    {
+      return false;
+    }
+    const bool truncated = TruncateFile(file, tableOfContents.offset);
+    return fclose(file) == 0 && truncated;
+  }
+
+  FILE * file = fopen(fileName.c_str(), "wb");
+  if (file == nullptr)
+  {
+    return false;
+  }
+  unsigned char header[BundleFileHeaderSize];
+  std::memcpy(header, BundleFileMagic.data(), BundleFileMagic.size());
+  EncodeOffset(BundleFileHeaderSize, header + BundleFileMagic.size());
+  const bool written = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+  return fclose(file) == 0 && written;
+}
+
+bool
+EndBundleMember(const std::string & fileName, BundleTableOfContents & tableOfContents, BundleMember member)
+{
+  FILE * file = fopen(fileName.c_str(), "r+b");
+  if (file == nullptr)
+  {
+    return false;
+  }
+  const long end = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : -1;
+  if (end < 0 || static_cast<uint64_t>(end) < tableOfContents.offset)
+  {
+    fclose(file);
+    return false;
+  }
+  member.offset = tableOfContents.offset;
+  member.size = static_cast<uint64_t>(end) - tableOfContents.offset;
+  tableOfContents.members.push_back(std::move(member));
+  tableOfContents.offset = static_cast<uint64_t>(end);
+
+  // The header points at the table of contents once it is written
+  const std::string encoded = EncodeTableOfContents(tableOfContents);
+  unsigned char offset[8];
+  EncodeOffset(tableOfContents.offset, offset);
+  const bool written = fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size() && fflush(file) == 0 &&
+                       fseek(file, static_cast<long>(BundleFileMagic.size()), SEEK_SET) == 0 &&
+                       fwrite(offset, 1, sizeof(offset), file) == sizeof(offset);
+  return fclose(file) == 0 && written;
+}
+
+} // end namespace wasm
+} // end namespace itk
@@ -0,0 +1,112 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmComponentConversion.h"
+
+namespace itk
+{
+namespace wasm
+{
+
+std::ostream &
+operator<<(std::ostream & out, ComponentConversion conversion)
+{
+  switch (conversion)
+  {
+    case ComponentConversion::None:
+      return out << "None";
+    case ComponentConversion::IntegerToInt32:
+      return out << "IntegerToInt32";
+    case ComponentConversion::IntegerToFloat32:
+      return out << "IntegerToFloat32";
+    case ComponentConversion::ToFloat32:
+      return out << "ToFloat32";
+    case ComponentConversion::ToFloat64:
+      return out << "ToFloat64";
+    case ComponentConversion::Cast:
+      return out << "Cast";
+  }
+  return out << "Unknown";
+}
+
+namespace
+{
+
+bool
+IsSmallInteger(std::string_view componentType)
+{
+  return componentType == "int8" || componentType == "uint8" || componentType == "int16" || componentType == "uint16";
+}
+
+bool
+IsInteger(std::string_view componentType)
+{
+  return IsSmallInteger(componentType) || componentType == "int32" || componentType == "uint32" ||
+         componentType == "int64" || componentType == "uint64";
+}
+
+} // end anonymous namespace
+
+std::string_view
+GetConvertedComponentType(ComponentConversion conversion, std::string_view componentType)
+{
+  switch (conversion)
+  {
+    case ComponentConversion::None:
+      break;
+    case ComponentConversion::IntegerToInt32:
+      if (IsSmallInteger(componentType))
+      {
+        return "int32";
+      }
+      break;
+    case ComponentConversion::IntegerToFloat32:
+      if (IsInteger(componentType))
+      {
+        return "float32";
+      }
+      break;
+    case ComponentConversion::ToFloat32:
+      if (IsInteger(componentType) || componentType == "float64")
+      {
+        return "float32";
+      }
+      break;
+    case ComponentConversion::ToFloat64:
+      if (IsInteger(componentType) || componentType == "float32")
+      {
+        return "float64";
+      }
+      break;
+    case ComponentConversion::Cast:
+      break;
+  }
+  return {};
+}
+
+bool
+IsConvertedComponentType(ComponentConversion conversion, std::string_view componentType, std::string_view targetComponentType)
+{
+  if (conversion == ComponentConversion::Cast)
+  {
+    return IsInteger(componentType) || componentType == "float32" || componentType == "float64";
+  }
+  return !targetComponentType.empty() && GetConvertedComponentType(conversion, componentType) == targetComponentType;
+}
+
+} // end namespace wasm
+} // end namespace itk
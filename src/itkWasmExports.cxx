@@ -20,52 +20,526 @@
 
 #ifndef ITK_WASM_NO_MEMORY_IO
 
+#include "itkPipelineStageStore.h"
+#include "itkWasmContentHash.h"
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#if defined(__EMSCRIPTEN__) || defined(__wasi__)
+#include <unistd.h>
+#endif
+
 namespace itk
 {
 namespace wasm
 {
 
-static InputArrayStoreType inputArrayStore;
-
 // index
 using InputJSONStoreType = std::map<uint32_t, std::string>;
-static InputJSONStoreType inputJSONStore;
+
+using OutputWasmDataObjectStoreType = std::map<uint32_t, WasmDataObject::ConstPointer>;
+
+// dataset index, array index
+using OutputArrayStoreKeyType = std::pair<uint32_t, uint32_t>;
+// address, size
+using OutputArrayStoreValueType = std::pair<size_t, size_t>;
+using OutputArrayStoreType = std::map<OutputArrayStoreKeyType, OutputArrayStoreValueType>;
+
+// index
+using ImageDescriptorStoreType = std::map<uint32_t, WasmImageDescriptor>;
+
+/** Inputs and outputs for one memory store session.
+ *
+ * The stores are guarded by the session's mutex, so the stages of one
+ * invocation may stage inputs and publish outputs from multiple threads, e.g.
+ * parallel output serialization, without contending with other sessions. The
+ * flags are set by the host between invocations. */
+struct MemoryStore
+{
+  std::mutex mutex;
+  InputArrayStoreType inputArrayStore;
+  InputJSONStoreType inputJSONStore;
+  OutputWasmDataObjectStoreType outputWasmDataObjectStore;
+  OutputArrayStoreType outputArrayStore;
+  OutputArrayStoreType outputArrayBindingStore;
+  ImageDescriptorStoreType inputImageDescriptorStore;
+  ImageDescriptorStoreType outputImageDescriptorStore;
+  // Content hashes of input arrays, dropped when an array is reallocated or freed
+  std::map<InputArrayStoreKeyType, uint64_t> inputArrayHashStore;
+  // Outputs set since resetMemoryStoreUpdatedOutputs
+  std::set<uint32_t> updatedOutputs;
+  // Result cache entries that own the arrays of restored outputs
+  std::map<uint32_t, std::shared_ptr<const ResultCacheEntry>> restoredOutputStore;
+  // index, handle of the inputs kept resident, see itk_wasm_input_retain
+  std::map<uint32_t, uint32_t> inputRetainStore;
+  bool inputArrayHandoff{false};
+  bool useImageDescriptors{false};
+  bool useCBORMetadata{false};
+  bool usePlanarLayout{false};
+  bool useStridedViews{false};
+};
+
+// memoryIndex
+using MemoryStoreMapType = std::map<uint32_t, MemoryStore>;
+static MemoryStoreMapType memoryStores;
+// Guards the session map. Its nodes are stable, so a store is used without it
+// once found. Sessions are destroyed by the host between invocations.
+static std::shared_mutex memoryStoresMutex;
+
+using MemoryStoreLock = std::lock_guard<std::mutex>;
+
+static MemoryStore & getMemoryStore(uint32_t memoryIndex)
+{
+  {
+    const std::shared_lock<std::shared_mutex> lock(memoryStoresMutex);
+    auto it = memoryStores.find(memoryIndex);
+    if (it != memoryStores.end())
+    {
+      return it->second;
+    }
+  }
+  const std::unique_lock<std::shared_mutex> lock(memoryStoresMutex);
+  return memoryStores[memoryIndex];
+}
+
+// Released input arrays, keyed by capacity, so repeated runs with same-sized
+// inputs reuse allocations instead of growing and fragmenting the heap. The
+// pool keeps up to bufferPoolCapacity bytes, and the oldest buffers are
+// returned to the heap past it. The pool is shared by the sessions and is
+// locked after a session's mutex.
+struct PooledInputArray
+{
+  uint64_t                 sequence;
+  InputArrayStoreValueType array;
+};
+using BufferPoolType = std::multimap<size_t, PooledInputArray>;
+static BufferPoolType bufferPool;
+static size_t bufferPoolBytes = 0;
+static size_t bufferPoolCapacity = size_t{ 64 } << 20;
+static uint64_t bufferPoolSequence = 0;
+static std::mutex bufferPoolMutex;
+
+// Called with bufferPoolMutex locked
+static void trimBufferPool()
+{
+  while (bufferPoolBytes > bufferPoolCapacity)
+  {
+    const auto oldest = std::min_element(bufferPool.begin(), bufferPool.end(), [](const BufferPoolType::value_type & a, const BufferPoolType::value_type & b) {
+      return a.second.sequence < b.second.sequence;
+    });
+    bufferPoolBytes -= oldest->first;
+    bufferPool.erase(oldest);
+  }
+}
+
+static void recycleInputArray(InputArrayStoreValueType && array)
+{
+  InputArrayStoreValueType released(std::move(array));
+  const size_t capacity = released.capacity();
+  if (capacity == 0)
+  {
+    return;
+  }
+  const std::lock_guard<std::mutex> lock(bufferPoolMutex);
+  if (capacity > bufferPoolCapacity)
+  {
+    return;
+  }
+  bufferPool.emplace(capacity, PooledInputArray{ bufferPoolSequence++, std::move(released) });
+  bufferPoolBytes += capacity;
+  trimBufferPool();
+}
+
+static void recycleInputArrays(InputArrayStoreType & inputArrayStore)
+{
+  for (auto & entry : inputArrayStore)
+  {
+    recycleInputArray(std::move(entry.second));
+  }
+  inputArrayStore.clear();
+}
+
+// Get a buffer with room for capacity bytes from the pool or allocate a new
+// one, and resize it to size bytes. Pooled buffers are only reused if they
+// are at most twice as large as requested.
+static InputArrayStoreValueType acquireInputArray(size_t capacity, size_t size)
+{
+  InputArrayStoreValueType array;
+  {
+    const std::lock_guard<std::mutex> lock(bufferPoolMutex);
+    auto it = bufferPool.lower_bound(capacity);
+    if (capacity > 0 && it != bufferPool.end() && it->first <= 2 * capacity)
+    {
+      array = std::move(it->second.array);
+      bufferPoolBytes -= it->first;
+      bufferPool.erase(it);
+    }
+  }
+  // The allocator does not initialize the bytes, so resizing does not write
+  array.reserve(capacity);
+  array.resize(size);
+  return array;
+}
+
+// phase, heap size
+using MemoryPhaseStoreType = std::vector<std::pair<std::string, size_t>>;
+static MemoryPhaseStoreType memoryPhases;
+static size_t heapHighWaterMark = 0;
+static std::string memoryStatsJSON;
+// Guards the phases, the high water mark, and the stats JSON
+static std::mutex memoryPhasesMutex;
+
+// Current program break, 0 when not running in WebAssembly. Called with
+// memoryPhasesMutex locked.
+static size_t getHeapSize()
+{
+#if defined(__EMSCRIPTEN__) || defined(__wasi__)
+  const size_t heapSize = reinterpret_cast< size_t >(sbrk(0));
+#else
+  const size_t heapSize = 0;
+#endif
+  if (heapSize > heapHighWaterMark)
+  {
+    heapHighWaterMark = heapSize;
+  }
+  return heapSize;
+}
+
+// Set by the host, possibly from another thread sharing the memory
+static std::atomic<uint32_t> abortFlag{0};
+static_assert(sizeof(abortFlag) == sizeof(uint32_t), "The abort flag must be a 32-bit word");
+
+bool getAbortRequested()
+{
+  return abortFlag.load(std::memory_order_relaxed) != 0;
+}
+
+void clearAbortRequested()
+{
+  abortFlag.store(0, std::memory_order_relaxed);
+}
+
+void markMemoryPhase(const char * phase)
+{
+  const std::lock_guard<std::mutex> lock(memoryPhasesMutex);
+  for (const auto & entry : memoryPhases)
+  {
+    if (entry.first == phase)
+    {
+      return;
+    }
+  }
+  memoryPhases.emplace_back(phase, getHeapSize());
+}
+
+void resetMemoryPhases()
+{
+  const std::lock_guard<std::mutex> lock(memoryPhasesMutex);
+  memoryPhases.clear();
+}
 
 const std::string & getMemoryStoreInputJSON(uint32_t memoryIndex, uint32_t index)
 {
-  return inputJSONStore[index];
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  return store.inputJSONStore[index];
 }
 
-const InputArrayStoreType & getMemoryInputArrayStore()
+const InputArrayStoreType & getMemoryInputArrayStore(uint32_t memoryIndex)
 {
-  return inputArrayStore;
+  return getMemoryStore(memoryIndex).inputArrayStore;
 }
 
-using OutputWasmDataObjectStoreType = std::map<uint32_t, WasmDataObject::ConstPointer>;
-static OutputWasmDataObjectStoreType outputWasmDataObjectStore;
+bool getMemoryStoreInputArrayHandoff(uint32_t memoryIndex)
+{
+  return getMemoryStore(memoryIndex).inputArrayHandoff;
+}
+
+bool getMemoryStoreInputRetainHandle(uint32_t memoryIndex, uint32_t index, uint32_t & handle)
+{
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  const auto & inputRetainStore = store.inputRetainStore;
+  auto it = inputRetainStore.find(index);
+  if (it == inputRetainStore.end())
+  {
+    return false;
+  }
+  handle = it->second;
+  return true;
+}
+
+bool takeMemoryStoreInputArray(uint32_t memoryIndex, size_t address, InputArrayStoreValueType & array)
+{
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  auto & inputArrayStore = store.inputArrayStore;
+  for (auto it = inputArrayStore.begin(); it != inputArrayStore.end(); ++it)
+  {
+    if (!it->second.empty() && reinterpret_cast< size_t >(it->second.data()) == address)
+    {
+      store.inputArrayHashStore.erase(it->first);
+      array = std::move(it->second);
+      inputArrayStore.erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
+const WasmImageDescriptor * getMemoryStoreInputImageDescriptor(uint32_t memoryIndex, uint32_t index)
+{
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  auto & inputImageDescriptorStore = store.inputImageDescriptorStore;
+  auto it = inputImageDescriptorStore.find(index);
+  if (it == inputImageDescriptorStore.end())
+  {
+    return nullptr;
+  }
+  return &(it->second);
+}
+
+bool getMemoryStoreUseImageDescriptors(uint32_t memoryIndex)
+{
+  return getMemoryStore(memoryIndex).useImageDescriptors;
+}
+
+bool getMemoryStoreUseCBORMetadata(uint32_t memoryIndex)
+{
+  return getMemoryStore(memoryIndex).useCBORMetadata;
+}
+
+bool getMemoryStoreUsePlanarLayout(uint32_t memoryIndex)
+{
+  return getMemoryStore(memoryIndex).usePlanarLayout;
+}
+
+bool getMemoryStoreUseStridedViews(uint32_t memoryIndex)
+{
+  return getMemoryStore(memoryIndex).useStridedViews;
+}
+
+// Outputs are set from the output serialization threads, see
+// Pipeline::serialize_output
+void setMemoryStoreOutputImageDescriptor(uint32_t memoryIndex, uint32_t index, const WasmImageDescriptor & descriptor)
+{
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  store.outputImageDescriptorStore[index] = descriptor;
+}
 
 void setMemoryStoreOutputDataObject(uint32_t memoryIndex, uint32_t index, const WasmDataObject * dataObject)
 {
   WasmDataObject::ConstPointer smartPointer(dataObject);
-  outputWasmDataObjectStore[index] = smartPointer;
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  store.outputWasmDataObjectStore[index] = smartPointer;
+  store.restoredOutputStore.erase(index);
+  store.updatedOutputs.insert(index);
 }
 
-// dataset index, array index
-using OutputArrayStoreKeyType = std::pair<uint32_t, uint32_t>;
-// address, size
-using OutputArrayStoreValueType = std::pair<size_t, size_t>;
-using OutputArrayStoreType = std::map<OutputArrayStoreKeyType, OutputArrayStoreValueType>;
-static OutputArrayStoreType outputArrayStore;
-
 void setMemoryStoreOutputArray(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t address, size_t size)
 {
   const auto key = std::make_pair(index, subIndex);
   const auto value = std::make_pair(address, size);
-  outputArrayStore[key] = value;
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  store.outputArrayStore[key] = value;
+}
+
+namespace
+{
+
+// Keeps the owner of the bytes of a buffer output alive with the output data
+// object
+class ExternalDataObject : public WasmDataObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ExternalDataObject);
+
+  using Self = ExternalDataObject;
+  using Superclass = WasmDataObject;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  itkNewMacro(Self);
+  itkTypeMacro(ExternalDataObject, WasmDataObject);
+
+  void SetOwner(std::shared_ptr<const void> owner)
+  {
+    m_Owner = std::move(owner);
+  }
+
+protected:
+  ExternalDataObject() = default;
+  ~ExternalDataObject() override = default;
+
+  std::shared_ptr<const void> m_Owner;
+};
+
+} // end anonymous namespace
+
+void setMemoryStoreOutputBuffer(uint32_t memoryIndex, uint32_t index, const void * data, size_t size, std::shared_ptr<const void> owner)
+{
+  auto dataObject = ExternalDataObject::New();
+  dataObject->SetOwner(std::move(owner));
+  std::ostringstream jsonStream;
+  jsonStream << "{ \"data\": \"data:application/vnd.itk.address,0:" << reinterpret_cast< size_t >( data )
+             << "\", \"size\": " << size << "}";
+  dataObject->SetJSON(jsonStream.str());
+  setMemoryStoreOutputDataObject(memoryIndex, index, dataObject);
+  setMemoryStoreOutputArray(memoryIndex, index, 0, reinterpret_cast< size_t >( data ), size);
+}
+
+bool getMemoryStoreOutputArrayBinding(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t & address, size_t & size)
+{
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  const auto & outputArrayBindingStore = store.outputArrayBindingStore;
+  auto it = outputArrayBindingStore.find(std::make_pair(index, subIndex));
+  if (it == outputArrayBindingStore.end())
+  {
+    return false;
+  }
+  address = it->second.first;
+  size = it->second.second;
+  return true;
+}
+
+static void hashInputJSON(ContentHash & hash, const std::string & json)
+{
+  // Array addresses differ between runs with the same content. The arrays
+  // are hashed separately.
+  constexpr std::string_view addressPrefix = "data:application/vnd.itk.address,";
+  size_t position = 0;
+  while (position < json.size())
+  {
+    const size_t found = json.find(addressPrefix.data(), position, addressPrefix.size());
+    if (found == std::string::npos)
+    {
+      hash.Update(json.data() + position, json.size() - position);
+      break;
+    }
+    const size_t addressStart = found + addressPrefix.size();
+    hash.Update(json.data() + position, addressStart - position);
+    position = json.find('"', addressStart);
+  }
+}
+
+bool hashMemoryStoreInputs(uint32_t memoryIndex, ContentHash & hash)
+{
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  if (store.useImageDescriptors || !store.inputImageDescriptorStore.empty())
+  {
+    return false;
+  }
+
+  // The layout of the input and output pixel data
+  hash.UpdateValue(static_cast<uint8_t>(store.usePlanarLayout));
+  hash.UpdateValue(static_cast<uint8_t>(store.useStridedViews));
+  for (const auto & inputJSON : store.inputJSONStore)
+  {
+    hash.UpdateValue(inputJSON.first);
+    hash.UpdateValue(static_cast<uint64_t>(inputJSON.second.size()));
+    hashInputJSON(hash, inputJSON.second);
+  }
+
+  for (const auto & inputArray : store.inputArrayStore)
+  {
+    auto hashIt = store.inputArrayHashStore.find(inputArray.first);
+    if (hashIt == store.inputArrayHashStore.end())
+    {
+      ContentHash arrayHash;
+      arrayHash.Update(inputArray.second.data(), inputArray.second.size());
+      hashIt = store.inputArrayHashStore.emplace(inputArray.first, arrayHash.Digest()).first;
+    }
+    hash.UpdateValue(inputArray.first.first);
+    hash.UpdateValue(inputArray.first.second);
+    hash.UpdateValue(static_cast<uint64_t>(inputArray.second.size()));
+    hash.UpdateValue(hashIt->second);
+  }
+  return true;
+}
+
+void resetMemoryStoreUpdatedOutputs(uint32_t memoryIndex)
+{
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  store.updatedOutputs.clear();
+}
+
+bool getMemoryStoreResultCacheEntry(uint32_t memoryIndex, ResultCacheEntry & entry)
+{
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  if (store.updatedOutputs.empty())
+  {
+    return false;
+  }
+  for (const uint32_t index : store.updatedOutputs)
+  {
+    auto & output = entry[index];
+    output.json = store.outputWasmDataObjectStore.at(index)->GetJSON();
+    const auto arraysBegin = store.outputArrayStore.lower_bound(std::make_pair(index, uint32_t{0}));
+    const auto arraysEnd = store.outputArrayStore.upper_bound(std::make_pair(index, std::numeric_limits<uint32_t>::max()));
+    for (auto it = arraysBegin; it != arraysEnd; ++it)
+    {
+      const auto bytes = reinterpret_cast<const uint8_t *>(it->second.first);
+      if (bytes != nullptr)
+      {
+        output.arrays[it->first.second].assign(bytes, bytes + it->second.second);
+      }
+      else
+      {
+        output.arrays[it->first.second];
+      }
+    }
+  }
+  return true;
+}
+
+void setMemoryStoreResultCacheEntry(uint32_t memoryIndex, std::shared_ptr<const ResultCacheEntry> entry)
+{
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  for (const auto & output : *entry)
+  {
+    const uint32_t index = output.first;
+    auto wasmDataObject = WasmDataObject::New();
+    wasmDataObject->SetJSON(output.second.json);
+    store.outputWasmDataObjectStore[index] = wasmDataObject.GetPointer();
+    store.updatedOutputs.insert(index);
+    for (const auto & array : output.second.arrays)
+    {
+      const auto key = std::make_pair(index, array.first);
+      size_t address = reinterpret_cast<size_t>(array.second.data());
+      auto bindingIt = store.outputArrayBindingStore.find(key);
+      if (bindingIt != store.outputArrayBindingStore.end() && bindingIt->second.second >= array.second.size())
+      {
+        std::memcpy(reinterpret_cast<void *>(bindingIt->second.first), array.second.data(), array.second.size());
+        ITK_WASM_COUNT_COPY(OutputStore, array.second.size());
+        address = bindingIt->second.first;
+      }
+      store.outputArrayStore[key] = std::make_pair(address, array.second.size());
+    }
+    store.restoredOutputStore[index] = entry;
+  }
 }
 
 } // end namespace wasm
@@ -74,21 +548,53 @@ void setMemoryStoreOutputArray(uint32_t memoryIndex, uint32_t index, uint32_t su
 size_t itk_wasm_input_array_alloc(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t size)
 {
   using namespace itk::wasm;
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
   const auto key = std::make_pair(index, subIndex);
-  if (inputArrayStore.count(key))
-  {
-    inputArrayStore[key] = InputArrayStoreValueType(size);
-  }
-  else
+  store.inputArrayHashStore.erase(key);
+  auto & array = store.inputArrayStore[key];
+  recycleInputArray(std::move(array));
+  array = acquireInputArray(size, size);
+  return reinterpret_cast< size_t >(array.data());
+}
+
+size_t itk_wasm_input_array_reserve(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t capacity)
+{
+  using namespace itk::wasm;
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  const auto key = std::make_pair(index, subIndex);
+  store.inputArrayHashStore.erase(key);
+  auto & array = store.inputArrayStore[key];
+  recycleInputArray(std::move(array));
+  array = acquireInputArray(capacity, 0);
+  return reinterpret_cast< size_t >(array.data());
+}
+
+size_t itk_wasm_input_array_append(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t size)
+{
+  using namespace itk::wasm;
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  const auto key = std::make_pair(index, subIndex);
+  store.inputArrayHashStore.erase(key);
+  auto & array = store.inputArrayStore[key];
+  const size_t offset = array.size();
+  if (size > array.capacity() - offset)
   {
-    inputArrayStore[key].resize(size);
+    // Growing would move the array and copy the chunks appended so far
+    return 0;
   }
-  return reinterpret_cast< size_t >(inputArrayStore[key].data());
+  array.resize(offset + size);
+  return reinterpret_cast< size_t >(array.data() + offset);
 }
 
 size_t itk_wasm_input_json_alloc(uint32_t memoryIndex, uint32_t index, size_t size)
 {
   using namespace itk::wasm;
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  auto & inputJSONStore = store.inputJSONStore;
   if (inputJSONStore.count(index))
   {
     inputJSONStore[index] = std::string(size, ' ');
@@ -100,23 +606,48 @@ size_t itk_wasm_input_json_alloc(uint32_t memoryIndex, uint32_t index, size_t si
   return reinterpret_cast< size_t >(inputJSONStore[index].data());
 }
 
+uint32_t itk_wasm_output_exists(uint32_t memoryIndex, uint32_t index)
+{
+  using namespace itk::wasm;
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  const auto it = store.outputWasmDataObjectStore.find(index);
+  return it != store.outputWasmDataObjectStore.end() && it->second.IsNotNull();
+}
+
 size_t itk_wasm_output_json_address(uint32_t memoryIndex, uint32_t index)
 {
   using namespace itk::wasm;
-  return reinterpret_cast< size_t >(outputWasmDataObjectStore[index]->GetJSON().data());
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  const auto it = store.outputWasmDataObjectStore.find(index);
+  if (it == store.outputWasmDataObjectStore.end() || it->second.IsNull())
+  {
+    return 0;
+  }
+  return reinterpret_cast< size_t >(it->second->GetJSON().data());
 }
 
 size_t itk_wasm_output_json_size(uint32_t memoryIndex, uint32_t index)
 {
   using namespace itk::wasm;
-  return outputWasmDataObjectStore[index]->GetJSON().size();
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  const auto it = store.outputWasmDataObjectStore.find(index);
+  if (it == store.outputWasmDataObjectStore.end() || it->second.IsNull())
+  {
+    return 0;
+  }
+  return it->second->GetJSON().size();
 }
 
 size_t itk_wasm_output_array_address(uint32_t memoryIndex, uint32_t index, uint32_t subIndex)
 {
   using namespace itk::wasm;
   const auto key = std::make_pair(index, subIndex);
-  const auto value = outputArrayStore[key];
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  const auto value = store.outputArrayStore[key];
   return value.first;
 }
 
@@ -124,17 +655,353 @@ size_t itk_wasm_output_array_size(uint32_t memoryIndex, uint32_t index, uint32_t
 {
   using namespace itk::wasm;
   const auto key = std::make_pair(index, subIndex);
-  const auto value = outputArrayStore[key];
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  const auto value = store.outputArrayStore[key];
   return value.second;
 }
 
+void itk_wasm_output_array_bind(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t address, size_t size)
+{
+  using namespace itk::wasm;
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  auto & outputArrayBindingStore = store.outputArrayBindingStore;
+  const auto key = std::make_pair(index, subIndex);
+  if (address == 0 || size == 0)
+  {
+    outputArrayBindingStore.erase(key);
+    return;
+  }
+  outputArrayBindingStore[key] = std::make_pair(address, size);
+}
+
 void itk_wasm_free_all()
 {
   using namespace itk::wasm;
-  inputJSONStore.clear();
-  inputArrayStore.clear();
-  outputWasmDataObjectStore.clear();
-  outputArrayStore.clear();
+  const std::unique_lock<std::shared_mutex> lock(memoryStoresMutex);
+  for (auto & entry : memoryStores)
+  {
+    recycleInputArrays(entry.second.inputArrayStore);
+  }
+  memoryStores.clear();
+}
+
+void itk_wasm_request_abort()
+{
+  using namespace itk::wasm;
+  abortFlag.store(1, std::memory_order_relaxed);
+}
+
+size_t itk_wasm_abort_flag_address()
+{
+  using namespace itk::wasm;
+  return reinterpret_cast< size_t >(&abortFlag);
+}
+
+size_t itk_wasm_memory_stats(uint32_t memoryIndex)
+{
+  using namespace itk::wasm;
+
+  auto & store = getMemoryStore(memoryIndex);
+  std::unique_lock<std::mutex> storeLock(store.mutex);
+  size_t inputArrayBytes = 0;
+  for (const auto & entry : store.inputArrayStore)
+  {
+    inputArrayBytes += entry.second.capacity();
+  }
+  size_t inputJSONBytes = 0;
+  for (const auto & entry : store.inputJSONStore)
+  {
+    inputJSONBytes += entry.second.capacity();
+  }
+  size_t outputDataObjectBytes = 0;
+  for (const auto & entry : store.outputWasmDataObjectStore)
+  {
+    outputDataObjectBytes += entry.second->GetJSON().capacity();
+  }
+  size_t outputArrayBytes = 0;
+  for (const auto & entry : store.outputArrayStore)
+  {
+    outputArrayBytes += entry.second.second;
+  }
+  storeLock.unlock();
+  size_t pooledBytes = 0;
+  {
+    const std::lock_guard<std::mutex> lock(bufferPoolMutex);
+    pooledBytes = bufferPoolBytes;
+  }
+  const std::lock_guard<std::mutex> phasesLock(memoryPhasesMutex);
+  const size_t heapSize = getHeapSize();
+#if defined(__wasm__)
+  const size_t linearMemorySize = __builtin_wasm_memory_size(0) * 65536;
+#else
+  const size_t linearMemorySize = 0;
+#endif
+
+  rapidjson::StringBuffer stringBuffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
+  writer.StartObject();
+  writer.Key("inputArrayStore");
+  writer.Uint64(inputArrayBytes);
+  writer.Key("inputJSONStore");
+  writer.Uint64(inputJSONBytes);
+  writer.Key("outputWasmDataObjectStore");
+  writer.Uint64(outputDataObjectBytes);
+  writer.Key("outputArrayStore");
+  writer.Uint64(outputArrayBytes);
+  writer.Key("bufferPool");
+  writer.Uint64(pooledBytes);
+  writer.Key("heapSize");
+  writer.Uint64(heapSize);
+  writer.Key("heapHighWaterMark");
+  writer.Uint64(heapHighWaterMark);
+  writer.Key("linearMemorySize");
+  writer.Uint64(linearMemorySize);
+  writer.Key("phases");
+  writer.StartObject();
+  for (const auto & entry : memoryPhases)
+  {
+    writer.Key(entry.first.c_str());
+    writer.Uint64(entry.second);
+  }
+  writer.EndObject();
+#ifdef ITK_WASM_ALLOCATION_STATS
+  // operator new calls by size class, and bytes copied by the glue code,
+  // since the pipeline started
+  const AllocationStats allocationStats = getAllocationStats();
+  writer.Key("allocations");
+  writer.StartArray();
+  uint64_t sizeClassLimit = 16;
+  for (unsigned int ii = 0; ii < NumberOfAllocationSizeClasses; ++ii)
+  {
+    writer.StartObject();
+    writer.Key("maxSize");
+    if (ii + 1 < NumberOfAllocationSizeClasses)
+    {
+      writer.Uint64(sizeClassLimit);
+    }
+    else
+    {
+      writer.Null();
+    }
+    writer.Key("count");
+    writer.Uint64(allocationStats.allocations[ii]);
+    writer.Key("bytes");
+    writer.Uint64(allocationStats.allocatedBytes[ii]);
+    writer.EndObject();
+    sizeClassLimit *= 16;
+  }
+  writer.EndArray();
+  writer.Key("copies");
+  writer.StartObject();
+  for (unsigned int ii = 0; ii < static_cast<unsigned int>(CopyBoundary::Count); ++ii)
+  {
+    writer.Key(getCopyBoundaryName(static_cast<CopyBoundary>(ii)));
+    writer.Uint64(allocationStats.copiedBytes[ii]);
+  }
+  writer.EndObject();
+#endif
+  writer.EndObject();
+
+  memoryStatsJSON.assign(stringBuffer.GetString(), stringBuffer.GetSize());
+  return reinterpret_cast< size_t >(memoryStatsJSON.data());
+}
+
+size_t itk_wasm_memory_stats_size()
+{
+  using namespace itk::wasm;
+  const std::lock_guard<std::mutex> lock(memoryPhasesMutex);
+  return memoryStatsJSON.size();
+}
+
+void itk_wasm_free_input(uint32_t memoryIndex, uint32_t index, uint32_t subIndex)
+{
+  using namespace itk::wasm;
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  auto & inputArrayStore = store.inputArrayStore;
+  const auto key = std::make_pair(index, subIndex);
+  store.inputArrayHashStore.erase(key);
+  auto it = inputArrayStore.find(key);
+  if (it != inputArrayStore.end())
+  {
+    recycleInputArray(std::move(it->second));
+    inputArrayStore.erase(it);
+  }
+}
+
+void itk_wasm_free_input_json(uint32_t memoryIndex, uint32_t index)
+{
+  using namespace itk::wasm;
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  store.inputJSONStore.erase(index);
+  store.inputImageDescriptorStore.erase(index);
+}
+
+void itk_wasm_free_output(uint32_t memoryIndex, uint32_t index)
+{
+  using namespace itk::wasm;
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  store.outputWasmDataObjectStore.erase(index);
+  store.outputImageDescriptorStore.erase(index);
+  store.restoredOutputStore.erase(index);
+  store.updatedOutputs.erase(index);
+  auto & outputArrayStore = store.outputArrayStore;
+  outputArrayStore.erase(outputArrayStore.lower_bound(std::make_pair(index, uint32_t{0})),
+                         outputArrayStore.upper_bound(std::make_pair(index, std::numeric_limits<uint32_t>::max())));
+  auto & outputArrayBindingStore = store.outputArrayBindingStore;
+  outputArrayBindingStore.erase(outputArrayBindingStore.lower_bound(std::make_pair(index, uint32_t{0})),
+                                outputArrayBindingStore.upper_bound(std::make_pair(index, std::numeric_limits<uint32_t>::max())));
+}
+
+void itk_wasm_buffer_pool_clear()
+{
+  using namespace itk::wasm;
+  const std::lock_guard<std::mutex> lock(bufferPoolMutex);
+  bufferPool.clear();
+  bufferPoolBytes = 0;
+}
+
+void itk_wasm_buffer_pool_capacity(size_t capacity)
+{
+  using namespace itk::wasm;
+  const std::lock_guard<std::mutex> lock(bufferPoolMutex);
+  bufferPoolCapacity = capacity;
+  trimBufferPool();
+}
+
+size_t itk_wasm_image_descriptor_size()
+{
+  return sizeof(itk::wasm::WasmImageDescriptor);
+}
+
+size_t itk_wasm_input_image_descriptor_alloc(uint32_t memoryIndex, uint32_t index)
+{
+  using namespace itk::wasm;
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  auto & descriptor = store.inputImageDescriptorStore[index];
+  descriptor = WasmImageDescriptor();
+  return reinterpret_cast< size_t >(&descriptor);
+}
+
+size_t itk_wasm_output_image_descriptor_address(uint32_t memoryIndex, uint32_t index)
+{
+  using namespace itk::wasm;
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  return reinterpret_cast< size_t >(&(store.outputImageDescriptorStore[index]));
+}
+
+void itk_wasm_use_image_descriptors(uint32_t memoryIndex, uint32_t enable)
+{
+  using namespace itk::wasm;
+  getMemoryStore(memoryIndex).useImageDescriptors = enable != 0;
+}
+
+void itk_wasm_use_cbor_metadata(uint32_t memoryIndex, uint32_t enable)
+{
+  using namespace itk::wasm;
+  getMemoryStore(memoryIndex).useCBORMetadata = enable != 0;
+}
+
+void itk_wasm_use_planar_layout(uint32_t memoryIndex, uint32_t enable)
+{
+  using namespace itk::wasm;
+  getMemoryStore(memoryIndex).usePlanarLayout = enable != 0;
+}
+
+void itk_wasm_use_strided_views(uint32_t memoryIndex, uint32_t enable)
+{
+  using namespace itk::wasm;
+  getMemoryStore(memoryIndex).useStridedViews = enable != 0;
+}
+
+void itk_wasm_result_cache_capacity(size_t capacity)
+{
+  using namespace itk::wasm;
+  if (capacity == 0)
+  {
+    setResultCacheStore(nullptr);
+    return;
+  }
+  setResultCacheStore(std::make_shared<MemoryResultCacheStore>(capacity));
+}
+
+void itk_wasm_input_array_handoff(uint32_t memoryIndex, uint32_t enable)
+{
+  using namespace itk::wasm;
+  getMemoryStore(memoryIndex).inputArrayHandoff = enable != 0;
+}
+
+void itk_wasm_input_retain(uint32_t memoryIndex, uint32_t index, uint32_t handle)
+{
+  using namespace itk::wasm;
+  auto & store = getMemoryStore(memoryIndex);
+  const MemoryStoreLock lock(store.mutex);
+  store.inputRetainStore[index] = handle;
+}
+
+uint32_t itk_wasm_patch_image_region(uint32_t handle, size_t regionAddress, size_t dataAddress, size_t dataSize)
+{
+  using namespace itk::wasm;
+  const std::string identifier = GetHandleIdentifier(handle);
+  const StageDataObjectType * type = GetStageDataObjectType(identifier);
+  if (type == nullptr)
+  {
+    return 0;
+  }
+  std::vector<int64_t> regionIndex(type->dimension);
+  std::vector<uint64_t> regionSize(type->dimension);
+  const auto * region = reinterpret_cast< const unsigned char * >(regionAddress);
+  std::memcpy(regionIndex.data(), region, type->dimension * sizeof(int64_t));
+  std::memcpy(regionSize.data(), region + type->dimension * sizeof(int64_t), type->dimension * sizeof(uint64_t));
+  return PatchStageImageRegion(identifier, regionIndex.data(), regionSize.data(), reinterpret_cast< const void * >(dataAddress), dataSize) ? 1 : 0;
+}
+
+uint32_t itk_wasm_patch_image_runs(uint32_t handle, size_t runsAddress, size_t runsSize)
+{
+  using namespace itk::wasm;
+  return PatchStageImageRuns(GetHandleIdentifier(handle), reinterpret_cast< const void * >(runsAddress), runsSize) ? 1 : 0;
+}
+
+void itk_wasm_release_handle(uint32_t handle)
+{
+  itk::wasm::ReleaseHandleDataObject(handle);
+}
+
+void itk_wasm_release_all_handles()
+{
+  itk::wasm::ReleaseHandleDataObjects();
+}
+
+uint32_t itk_wasm_memory_session_create()
+{
+  using namespace itk::wasm;
+  // Session 0 is the default session and is always available
+  const std::unique_lock<std::shared_mutex> lock(memoryStoresMutex);
+  uint32_t memoryIndex = 1;
+  while (memoryStores.count(memoryIndex))
+  {
+    ++memoryIndex;
+  }
+  memoryStores[memoryIndex];
+  return memoryIndex;
+}
+
+void itk_wasm_memory_session_destroy(uint32_t memoryIndex)
+{
+  using namespace itk::wasm;
+  const std::unique_lock<std::shared_mutex> lock(memoryStoresMutex);
+  auto it = memoryStores.find(memoryIndex);
+  if (it != memoryStores.end())
+  {
+    recycleInputArrays(it->second.inputArrayStore);
+    memoryStores.erase(it);
+  }
 }
 
 #endif // ITK_WASM_NO_MEMORY_IO
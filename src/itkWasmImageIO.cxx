@@ -23,8 +23,17 @@
 #include "itkWasmPixelTypeFromIOPixelEnum.h"
 #include "itkIOPixelEnumFromWasmPixelType.h"
 #include "itkMetaDataDictionaryJSON.h"
+#include "itkMetaDataDictionaryCBOR.h"
+#include "itkWasmAlignedFile.h"
+#include "itkWasmCBORSink.h"
+#include "itkWasmCBORSource.h"
+#include "itkWasmPayloadFilter.h"
+#include "itkWasmRangeReader.h"
+#include "itkWasmTrace.h"
+#include "itkWasmAllocationStats.h"
 
 #include "itkMetaDataObject.h"
+#include "itkMultiThreaderBase.h"
 #include "itkIOCommon.h"
 #include "itksys/SystemTools.hxx"
 
@@ -35,6 +44,26 @@
 
 #include "cbor.h"
 
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__) && !defined(__wasi__)
+#  define ITK_WASM_IMAGE_IO_MMAP
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 namespace itk
 {
 
@@ -44,448 +73,1821 @@ WasmImageIO
   this->SetNumberOfDimensions(3);
   this->AddSupportedWriteExtension(".iwi");
   this->AddSupportedWriteExtension(".iwi.cbor");
+  this->AddSupportedWriteExtension(".iwi.bin");
+  this->AddSupportedWriteExtension(".iwi.bundle");
   this->AddSupportedReadExtension(".iwi");
   this->AddSupportedReadExtension(".iwi.cbor");
+  this->AddSupportedReadExtension(".iwi.bin");
+  this->AddSupportedReadExtension(".iwi.bundle");
 }
 
 
 WasmImageIO
 ::~WasmImageIO()
 {
+  this->UnmapDataFile();
 }
 
 
 bool
 WasmImageIO
-::SupportsDimension(unsigned long itkNotUsed(dimension))
+::MapDataFile(const std::string & dataFile)
 {
+#ifdef ITK_WASM_IMAGE_IO_MMAP
+  if (this->m_MappedData != nullptr && this->m_MappedFileName == dataFile)
+  {
+    return true;
+  }
+  this->UnmapDataFile();
+
+  const int fileDescriptor = open(dataFile.c_str(), O_RDONLY);
+  if (fileDescriptor < 0)
+  {
+    return false;
+  }
+  struct stat fileStatus;
+  if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size <= 0)
+  {
+    close(fileDescriptor);
+    return false;
+  }
+  const size_t mappedSize = static_cast< size_t >( fileStatus.st_size );
+  void * mappedData = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+  // The mapping stays valid after the descriptor is closed
+  close(fileDescriptor);
+  if (mappedData == MAP_FAILED)
+  {
+    return false;
+  }
+  this->m_MappedFileName = dataFile;
+  this->m_MappedData = mappedData;
+  this->m_MappedSize = mappedSize;
   return true;
+#else
+  (void)dataFile;
+  return false;
+#endif
 }
 
 
 void
 WasmImageIO
-::PrintSelf(std::ostream & os, Indent indent) const
+::UnmapDataFile()
 {
-  Superclass::PrintSelf(os, indent);
+#ifdef ITK_WASM_IMAGE_IO_MMAP
+  if (this->m_MappedData != nullptr)
+  {
+    munmap(this->m_MappedData, this->m_MappedSize);
+  }
+#endif
+  this->m_MappedFileName.clear();
+  this->m_MappedData = nullptr;
+  this->m_MappedSize = 0;
 }
 
 
-bool
+void
 WasmImageIO
-::CanReadFile(const char *filename)
+::ForEachIORegionLine(const std::function< void(uint64_t offset, size_t lineBytes) > & lineFunction) const
 {
-  std::string fname = filename;
+  const ImageIORegion & ioRegion = this->GetIORegion();
+  const unsigned int fileDimension = this->GetNumberOfDimensions();
+  const unsigned int regionDimension = std::min(ioRegion.GetImageDimension(), fileDimension);
+  const size_t pixelSize = this->GetPixelSize();
 
-  bool extensionFound = false;
-  std::string::size_type extensionPos = fname.rfind(".iwi");
-  if ( extensionPos != std::string::npos )
+  if (regionDimension == 0 || ioRegion.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // Byte strides of the file layout
+  std::vector< uint64_t > strides(fileDimension);
+  strides[0] = pixelSize;
+  for (unsigned int dim = 1; dim < fileDimension; ++dim)
+  {
+    strides[dim] = strides[dim - 1] * this->GetDimensions(dim - 1);
+  }
+
+  // One contiguous line along the first dimension at a time
+  const size_t lineBytes = ioRegion.GetSize(0) * pixelSize;
+  const size_t numberOfLines = ioRegion.GetNumberOfPixels() / ioRegion.GetSize(0);
+  std::vector< SizeValueType > lineIndex(regionDimension, 0);
+  for (size_t line = 0; line < numberOfLines; ++line)
+  {
+    uint64_t offset = ioRegion.GetIndex(0) * strides[0];
+    for (unsigned int dim = 1; dim < regionDimension; ++dim)
     {
-    extensionFound = true;
+      offset += (ioRegion.GetIndex(dim) + lineIndex[dim]) * strides[dim];
     }
+    lineFunction(offset, lineBytes);
 
-  if ( !extensionFound )
+    for (unsigned int dim = 1; dim < regionDimension; ++dim)
     {
-    itkDebugMacro(<< "The filename extension is not recognized");
-    return false;
+      if (++lineIndex[dim] < ioRegion.GetSize(dim))
+      {
+        break;
+      }
+      lineIndex[dim] = 0;
     }
+  }
+}
 
-  std::string::size_type zstdPos = fname.rfind(".zst");
-  // WasmZstdImageIO is required
-  if ( zstdPos != std::string::npos )
+
+void
+WasmImageIO
+::ForEachIORegionRun(const std::function< void(uint64_t offset, size_t runBytes) > & runFunction) const
+{
+  uint64_t runOffset = 0;
+  size_t runBytes = 0;
+  this->ForEachIORegionLine([&](uint64_t offset, size_t lineBytes) {
+    if (runBytes > 0 && offset == runOffset + runBytes)
     {
-    return false;
+      runBytes += lineBytes;
+      return;
+    }
+    if (runBytes > 0)
+    {
+      runFunction(runOffset, runBytes);
     }
+    runOffset = offset;
+    runBytes = lineBytes;
+  });
+  if (runBytes > 0)
+  {
+    runFunction(runOffset, runBytes);
+  }
+}
 
-  return true;
+
+void
+WasmImageIO
+::ReadMappedRegion(void * buffer, uint64_t dataOffset) const
+{
+  const auto mappedBytes = static_cast< const char * >( this->m_MappedData ) + dataOffset;
+  auto bufferBytes = static_cast< char * >( buffer );
+  this->ForEachIORegionLine([&](uint64_t offset, size_t lineBytes) {
+    if (dataOffset + offset + lineBytes > this->m_MappedSize)
+    {
+      itkExceptionMacro(<< "Read failed: " << this->m_MappedFileName << " is smaller than the image region");
+    }
+    std::memcpy(bufferBytes, mappedBytes + offset, lineBytes);
+    ITK_WASM_COUNT_COPY(CBORToBuffer, lineBytes);
+    bufferBytes += lineBytes;
+  });
+}
+
+
+namespace
+{
+// Box of pixel indices in the file dimension
+struct PixelBox
+{
+  std::vector< uint64_t > index;
+  std::vector< uint64_t > size;
+
+  uint64_t
+  GetNumberOfPixels() const
+  {
+    uint64_t numberOfPixels = 1;
+    for (const uint64_t extent : size)
+    {
+      numberOfPixels *= extent;
+    }
+    return numberOfPixels;
+  }
+};
+
+PixelBox
+IORegionBox(const ImageIORegion & ioRegion, unsigned int fileDimension)
+{
+  PixelBox box;
+  box.index.assign(fileDimension, 0);
+  box.size.assign(fileDimension, 1);
+  for (unsigned int dim = 0; dim < std::min(ioRegion.GetImageDimension(), fileDimension); ++dim)
+  {
+    box.index[dim] = ioRegion.GetIndex(dim);
+    box.size[dim] = ioRegion.GetSize(dim);
+  }
+  return box;
+}
+
+// Pixels of a chunk, truncated at the image boundary
+PixelBox
+ChunkBox(const std::vector< uint64_t > & chunkIndex, const std::vector< SizeValueType > & chunkSize, const std::vector< uint64_t > & imageSize)
+{
+  PixelBox box;
+  for (size_t dim = 0; dim < chunkIndex.size(); ++dim)
+  {
+    box.index.push_back(chunkIndex[dim] * chunkSize[dim]);
+    box.size.push_back(std::min< uint64_t >(chunkSize[dim], imageSize[dim] - box.index.back()));
+  }
+  return box;
+}
+
+// Indices of the chunks that overlap the region
+std::vector< std::vector< uint64_t > >
+RegionChunks(const PixelBox & region, const std::vector< SizeValueType > & chunkSize)
+{
+  std::vector< std::vector< uint64_t > > chunks;
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return chunks;
+  }
+  const size_t dimension = region.index.size();
+  std::vector< uint64_t > first(dimension);
+  std::vector< uint64_t > last(dimension);
+  for (size_t dim = 0; dim < dimension; ++dim)
+  {
+    first[dim] = region.index[dim] / chunkSize[dim];
+    last[dim] = (region.index[dim] + region.size[dim] - 1) / chunkSize[dim];
+  }
+  std::vector< uint64_t > chunk = first;
+  while (true)
+  {
+    chunks.push_back(chunk);
+    size_t dim = 0;
+    for (; dim < dimension; ++dim)
+    {
+      if (++chunk[dim] <= last[dim])
+      {
+        break;
+      }
+      chunk[dim] = first[dim];
+    }
+    if (dim == dimension)
+    {
+      return chunks;
+    }
+  }
 }
 
+// Copy the lines of the intersection of two boxes between their layouts
+void
+CopyBoxIntersection(const PixelBox & source, const unsigned char * sourceData, const PixelBox & destination, unsigned char * destinationData, size_t pixelSize)
+{
+  const size_t dimension = source.index.size();
+  PixelBox intersection;
+  for (size_t dim = 0; dim < dimension; ++dim)
+  {
+    const uint64_t start = std::max(source.index[dim], destination.index[dim]);
+    const uint64_t end = std::min(source.index[dim] + source.size[dim], destination.index[dim] + destination.size[dim]);
+    if (end <= start)
+    {
+      return;
+    }
+    intersection.index.push_back(start);
+    intersection.size.push_back(end - start);
+  }
+
+  std::vector< uint64_t > sourceStrides(dimension, pixelSize);
+  std::vector< uint64_t > destinationStrides(dimension, pixelSize);
+  for (size_t dim = 1; dim < dimension; ++dim)
+  {
+    sourceStrides[dim] = sourceStrides[dim - 1] * source.size[dim - 1];
+    destinationStrides[dim] = destinationStrides[dim - 1] * destination.size[dim - 1];
+  }
+
+  const size_t lineBytes = intersection.size[0] * pixelSize;
+  const uint64_t numberOfLines = intersection.GetNumberOfPixels() / intersection.size[0];
+  std::vector< uint64_t > lineIndex(dimension, 0);
+  for (uint64_t line = 0; line < numberOfLines; ++line)
+  {
+    uint64_t sourceOffset = 0;
+    uint64_t destinationOffset = 0;
+    for (size_t dim = 0; dim < dimension; ++dim)
+    {
+      const uint64_t position = intersection.index[dim] + lineIndex[dim];
+      sourceOffset += (position - source.index[dim]) * sourceStrides[dim];
+      destinationOffset += (position - destination.index[dim]) * destinationStrides[dim];
+    }
+    std::memcpy(destinationData + destinationOffset, sourceData + sourceOffset, lineBytes);
+    ITK_WASM_COUNT_COPY(CBORToBuffer, lineBytes);
+
+    for (size_t dim = 1; dim < dimension; ++dim)
+    {
+      if (++lineIndex[dim] < intersection.size[dim])
+      {
+        break;
+      }
+      lineIndex[dim] = 0;
+    }
+  }
+}
 
+// Run the chunk function in parallel, rethrowing the first exception
 void
+ParallelizeChunks(size_t numberOfChunks, const std::function< void(size_t) > & chunkFunction)
+{
+  std::mutex errorMutex;
+  std::exception_ptr error;
+  MultiThreaderBase::New()->ParallelizeArray(0, numberOfChunks, [&](SizeValueType chunk) {
+    {
+      std::lock_guard< std::mutex > lock(errorMutex);
+      if (error)
+      {
+        return;
+      }
+    }
+    try
+    {
+      chunkFunction(chunk);
+    }
+    catch (...)
+    {
+      std::lock_guard< std::mutex > lock(errorMutex);
+      if (!error)
+      {
+        error = std::current_exception();
+      }
+    }
+  }, nullptr);
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+} // end anonymous namespace
+
+
+std::string
 WasmImageIO
-::SetJSON(rapidjson::Document & document)
+::GetChunkPath(const std::vector< uint64_t > & chunkIndex) const
 {
-  const rapidjson::Value & imageType = document["imageType"];
-  const unsigned int dimension = imageType["dimension"].GetInt();
-  this->SetNumberOfDimensions( dimension );
+  std::string chunkPath = std::string(this->GetFileName()) + "/data/chunks/" + std::to_string(this->m_Level) + "/";
+  for (size_t dim = 0; dim < chunkIndex.size(); ++dim)
+  {
+    if (dim > 0)
+    {
+      chunkPath += ".";
+    }
+    chunkPath += std::to_string(chunkIndex[dim]);
+  }
+  return chunkPath;
+}
 
-  const std::string componentType( imageType["componentType"].GetString() );
-  const ImageIOBase::IOComponentEnum ioComponentType = IOComponentEnumFromWasmComponentType( componentType );
-  this->SetComponentType( ioComponentType );
 
-  const std::string pixelType( imageType["pixelType"].GetString() );
-  const IOPixelEnum ioPixelType = IOPixelEnumFromWasmPixelType( pixelType );
-  this->SetPixelType( ioPixelType );
+std::string
+WasmImageIO
+::GetChunkCompressionForWriting() const
+{
+  return "none";
+}
 
-  this->SetNumberOfComponents( imageType["components"].GetInt() );
 
-  const rapidjson::Value & origin = document["origin"];
-  int count = 0;
-  for( rapidjson::Value::ConstValueIterator itr = origin.Begin(); itr != origin.End(); ++itr )
+bool
+WasmImageIO
+::ReadChunkFile(const std::string & chunkPath, void * data, size_t size) const
+{
+  if (this->m_ChunkCompression != "none")
+  {
+    itkExceptionMacro("Unsupported chunk compression: " << this->m_ChunkCompression);
+  }
+  std::unique_ptr< wasm::RangeReader > reader = wasm::RangeReader::Open(chunkPath + ".raw");
+  if (!reader)
+  {
+    return false;
+  }
+  if (!reader->Read(0, data, size))
+  {
+    itkExceptionMacro("Read failed: " << chunkPath << ".raw is smaller than its chunk");
+  }
+  return true;
+}
+
+
+void
+WasmImageIO
+::WriteChunkFile(const std::string & chunkPath, const void * data, size_t size) const
+{
+  if (this->m_ChunkCompression != "none")
+  {
+    itkExceptionMacro("Unsupported chunk compression: " << this->m_ChunkCompression);
+  }
+  std::ofstream chunkStream(chunkPath + ".raw", std::ios::out | std::ios::binary | std::ios::trunc);
+  chunkStream.write(static_cast< const char * >( data ), size);
+  if (!chunkStream)
+  {
+    itkExceptionMacro("Could not write " << chunkPath << ".raw");
+  }
+}
+
+
+void
+WasmImageIO
+::ReadChunks(void * buffer)
+{
+  const unsigned int dimension = this->GetNumberOfDimensions();
+  std::vector< uint64_t > imageSize(dimension);
+  for (unsigned int dim = 0; dim < dimension; ++dim)
+  {
+    imageSize[dim] = this->GetDimensions(dim);
+  }
+  const PixelBox regionBox = IORegionBox(this->GetIORegion(), dimension);
+  const bool remote = wasm::RangeReader::IsURL(this->GetFileName());
+  PixelBox fetchBox = regionBox;
+  if (remote)
+  {
+    // Each chunk is a request: also fetch the neighbouring chunks, e.g. of
+    // the next slice of a streamed read, and keep them for the next region
+    for (unsigned int dim = 0; dim < dimension; ++dim)
     {
-    this->SetOrigin( count, itr->GetDouble() );
-    ++count;
+      const uint64_t halo = static_cast< uint64_t >( this->m_ChunkPrefetch ) * this->m_ChunkSize[dim];
+      const uint64_t start = fetchBox.index[dim] > halo ? fetchBox.index[dim] - halo : 0;
+      const uint64_t end = std::min(fetchBox.index[dim] + fetchBox.size[dim] + halo, imageSize[dim]);
+      fetchBox.index[dim] = start;
+      fetchBox.size[dim] = end - start;
+    }
+  }
+  const std::vector< std::vector< uint64_t > > chunks = RegionChunks(fetchBox, this->m_ChunkSize);
+  const size_t pixelSize = this->GetPixelSize();
+  auto bufferBytes = static_cast< unsigned char * >( buffer );
+
+  std::map< std::string, std::vector< unsigned char > > previousCache;
+  previousCache.swap(this->m_ChunkCache);
+  std::vector< std::string > chunkPaths(chunks.size());
+  std::vector< std::vector< unsigned char > > chunkData(chunks.size());
+  // The chunks fill disjoint parts of the buffer
+  ParallelizeChunks(chunks.size(), [&](size_t chunk) {
+    const PixelBox chunkBox = ChunkBox(chunks[chunk], this->m_ChunkSize, imageSize);
+    bool inRegion = true;
+    for (unsigned int dim = 0; dim < dimension; ++dim)
+    {
+      inRegion = inRegion && chunkBox.index[dim] < regionBox.index[dim] + regionBox.size[dim] &&
+                 regionBox.index[dim] < chunkBox.index[dim] + chunkBox.size[dim];
     }
+    chunkPaths[chunk] = this->GetChunkPath(chunks[chunk]);
+    const auto cached = previousCache.find(chunkPaths[chunk]);
+    if (cached != previousCache.end())
+    {
+      chunkData[chunk] = std::move(cached->second);
+    }
+    else
+    {
+      chunkData[chunk].resize(chunkBox.GetNumberOfPixels() * pixelSize);
+      if (!this->ReadChunkFile(chunkPaths[chunk], chunkData[chunk].data(), chunkData[chunk].size()))
+      {
+        if (inRegion)
+        {
+          itkExceptionMacro("Read failed: missing chunk " << chunkPaths[chunk]);
+        }
+        chunkData[chunk].clear();
+      }
+    }
+    if (inRegion)
+    {
+      CopyBoxIntersection(chunkBox, chunkData[chunk].data(), regionBox, bufferBytes, pixelSize);
+    }
+    if (!remote)
+    {
+      chunkData[chunk] = std::vector< unsigned char >();
+    }
+  });
 
-  const rapidjson::Value & spacing = document["spacing"];
-  count = 0;
-  for( rapidjson::Value::ConstValueIterator itr = spacing.Begin(); itr != spacing.End(); ++itr )
+  if (remote)
+  {
+    for (size_t chunk = 0; chunk < chunks.size(); ++chunk)
     {
-    this->SetSpacing( count, itr->GetDouble() );
-    ++count;
+      if (!chunkData[chunk].empty())
+      {
+        this->m_ChunkCache[chunkPaths[chunk]] = std::move(chunkData[chunk]);
+      }
     }
+  }
+}
 
-  const rapidjson::Value & size = document["size"];
-  count = 0;
-  for( rapidjson::Value::ConstValueIterator itr = size.Begin(); itr != size.End(); ++itr )
+
+void
+WasmImageIO
+::WriteChunks(const void * buffer)
+{
+  const std::string levelPath = std::string(this->GetFileName()) + "/data/chunks/" + std::to_string(this->m_Level);
+  if ( !itksys::SystemTools::FileExists(levelPath, false) )
+  {
+    itksys::SystemTools::MakeDirectory(levelPath);
+  }
+
+  const unsigned int dimension = this->GetNumberOfDimensions();
+  std::vector< uint64_t > imageSize(dimension);
+  for (unsigned int dim = 0; dim < dimension; ++dim)
+  {
+    imageSize[dim] = this->GetDimensions(dim);
+  }
+  const PixelBox regionBox = IORegionBox(this->GetIORegion(), dimension);
+  const std::vector< std::vector< uint64_t > > chunks = RegionChunks(regionBox, this->m_ChunkSize);
+  const size_t pixelSize = this->GetPixelSize();
+  auto bufferBytes = static_cast< const unsigned char * >( buffer );
+
+  ParallelizeChunks(chunks.size(), [&](size_t chunk) {
+    const PixelBox chunkBox = ChunkBox(chunks[chunk], this->m_ChunkSize, imageSize);
+    std::vector< unsigned char > chunkData(chunkBox.GetNumberOfPixels() * pixelSize);
+    const std::string chunkPath = this->GetChunkPath(chunks[chunk]);
+    bool covered = true;
+    for (unsigned int dim = 0; dim < dimension; ++dim)
     {
-    this->SetDimensions( count, itr->GetInt() );
-    ++count;
+      covered = covered && chunkBox.index[dim] >= regionBox.index[dim] &&
+                chunkBox.index[dim] + chunkBox.size[dim] <= regionBox.index[dim] + regionBox.size[dim];
+    }
+    if (!covered)
+    {
+      // Keep the pixels of the chunk outside of the region, or zeros
+      this->ReadChunkFile(chunkPath, chunkData.data(), chunkData.size());
     }
+    CopyBoxIntersection(regionBox, bufferBytes, chunkBox, chunkData.data(), pixelSize);
+    this->WriteChunkFile(chunkPath, chunkData.data(), chunkData.size());
+  });
+}
 
-  if (document.HasMember("metadata"))
+
+void
+WasmImageIO
+::SetChunksJSON(rapidjson::Document & document)
+{
+  const unsigned int dimension = this->GetNumberOfDimensions();
+  if (this->m_ChunkSize.size() != dimension ||
+      std::find(this->m_ChunkSize.begin(), this->m_ChunkSize.end(), 0) != this->m_ChunkSize.end())
   {
-    auto dictionary = this->GetMetaDataDictionary();
-    const rapidjson::Value & metadataJson = document["metadata"];
-    wasm::ConvertJSONToMetaDataDictionary(metadataJson, dictionary);
-    this->SetMetaDataDictionary(dictionary);
+    itkExceptionMacro("The chunk size must have a non-zero size for each of the " << dimension << " dimensions");
+  }
+  this->m_ChunkCompression = this->GetChunkCompressionForWriting();
+
+  rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
+  rapidjson::Value chunks(rapidjson::kObjectType);
+  rapidjson::Value chunkSize(rapidjson::kArrayType);
+  for (const SizeValueType extent : this->m_ChunkSize)
+  {
+    chunkSize.PushBack(rapidjson::Value().SetUint64(extent), allocator);
+  }
+  chunks.AddMember("chunkSize", chunkSize.Move(), allocator);
+  rapidjson::Value compression;
+  compression.SetString(this->m_ChunkCompression.c_str(), allocator);
+  chunks.AddMember("compression", compression.Move(), allocator);
+  chunks.AddMember("levels", rapidjson::Value(rapidjson::kArrayType).Move(), allocator);
+  document.AddMember("chunks", chunks.Move(), allocator);
+
+  document["data"].SetString("data:application/vnd.itk.path,data/chunks", allocator);
+}
+
+
+void
+WasmImageIO
+::SetChunkLevelJSON(rapidjson::Document & index)
+{
+  if (!index.HasMember("chunks"))
+  {
+    itkExceptionMacro("Levels can only be added to a chunked .iwi directory: " << this->GetFileName());
+  }
+  rapidjson::Document::AllocatorType& allocator = index.GetAllocator();
+  rapidjson::Document levelDocument = this->GetJSON();
+  if (levelDocument["imageType"] != index["imageType"])
+  {
+    itkExceptionMacro("The image type of level " << this->m_Level << " differs from level 0 of " << this->GetFileName());
+  }
+
+  rapidjson::Value & chunks = index["chunks"];
+  this->m_ChunkSize.clear();
+  const rapidjson::Value & chunkSize = chunks["chunkSize"];
+  for( rapidjson::Value::ConstValueIterator itr = chunkSize.Begin(); itr != chunkSize.End(); ++itr )
+  {
+    this->m_ChunkSize.push_back(itr->GetUint64());
+  }
+  this->m_ChunkCompression = chunks.HasMember("compression") ? chunks["compression"].GetString() : "none";
+  if (!chunks.HasMember("levels"))
+  {
+    chunks.AddMember("levels", rapidjson::Value(rapidjson::kArrayType).Move(), allocator);
+  }
+  rapidjson::Value & levels = chunks["levels"];
+  if (this->m_Level > levels.Size() + 1)
+  {
+    itkExceptionMacro("Write level " << levels.Size() + 1 << " of " << this->GetFileName() << " before level " << this->m_Level);
+  }
+
+  rapidjson::Value level(rapidjson::kObjectType);
+  level.AddMember("origin", rapidjson::Value(levelDocument["origin"], allocator).Move(), allocator);
+  level.AddMember("spacing", rapidjson::Value(levelDocument["spacing"], allocator).Move(), allocator);
+  level.AddMember("size", rapidjson::Value(levelDocument["size"], allocator).Move(), allocator);
+  if (this->m_Level == levels.Size() + 1)
+  {
+    levels.PushBack(level.Move(), allocator);
+  }
+  else
+  {
+    levels[this->m_Level - 1] = level.Move();
+  }
+}
+
+
+bool
+WasmImageIO
+::SupportsDimension(unsigned long itkNotUsed(dimension))
+{
+  return true;
+}
+
+
+void
+WasmImageIO
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+}
+
+
+bool
+WasmImageIO
+::CanReadFile(const char *filename)
+{
+  std::string fname = filename;
+
+  bool extensionFound = false;
+  std::string::size_type extensionPos = fname.rfind(".iwi");
+  if ( extensionPos != std::string::npos )
+    {
+    extensionFound = true;
+    }
+
+  if ( !extensionFound )
+    {
+    itkDebugMacro(<< "The filename extension is not recognized");
+    return false;
+    }
+
+  std::string::size_type zstdPos = fname.rfind(".zst");
+  // WasmZstdImageIO is required
+  if ( zstdPos != std::string::npos )
+    {
+    return false;
+    }
+
+  return true;
+}
+
+
+void
+WasmImageIO
+::SetJSON(rapidjson::Document & document)
+{
+  const rapidjson::Value & imageType = document["imageType"];
+  const unsigned int dimension = imageType["dimension"].GetInt();
+  this->SetNumberOfDimensions( dimension );
+
+  const std::string componentType( imageType["componentType"].GetString() );
+  const ImageIOBase::IOComponentEnum ioComponentType = IOComponentEnumFromWasmComponentType( componentType );
+  this->SetComponentType( ioComponentType );
+
+  const std::string pixelType( imageType["pixelType"].GetString() );
+  const IOPixelEnum ioPixelType = IOPixelEnumFromWasmPixelType( pixelType );
+  this->SetPixelType( ioPixelType );
+
+  this->SetNumberOfComponents( imageType["components"].GetInt() );
+
+  const rapidjson::Value & origin = document["origin"];
+  int count = 0;
+  for( rapidjson::Value::ConstValueIterator itr = origin.Begin(); itr != origin.End(); ++itr )
+    {
+    this->SetOrigin( count, itr->GetDouble() );
+    ++count;
+    }
+
+  const rapidjson::Value & spacing = document["spacing"];
+  count = 0;
+  for( rapidjson::Value::ConstValueIterator itr = spacing.Begin(); itr != spacing.End(); ++itr )
+    {
+    this->SetSpacing( count, itr->GetDouble() );
+    ++count;
+    }
+
+  const rapidjson::Value & size = document["size"];
+  count = 0;
+  for( rapidjson::Value::ConstValueIterator itr = size.Begin(); itr != size.End(); ++itr )
+    {
+    this->SetDimensions( count, itr->GetUint64() );
+    ++count;
+    }
+
+  this->m_IntensityStatistics = wasm::IntensityStatistics();
+  if (document.HasMember("intensityStatistics"))
+  {
+    try
+    {
+      this->m_IntensityStatistics = wasm::ConvertJSONToIntensityStatistics(document["intensityStatistics"]);
+    }
+    catch (const std::runtime_error & error)
+    {
+      itkExceptionMacro("Could not read " << this->GetFileName() << ": " << error.what());
+    }
+  }
+
+  if (document.HasMember("metadata"))
+  {
+    auto dictionary = this->GetMetaDataDictionary();
+    const rapidjson::Value & metadataJson = document["metadata"];
+    wasm::ConvertJSONToMetaDataDictionary(metadataJson, dictionary, m_MetaDataKeyFilter);
+    this->SetMetaDataDictionary(dictionary);
+  }
+}
+
+
+namespace
+{
+// Apply one entry of the top-level .iwi.cbor map
+void
+ReadCBORIndexItem(WasmImageIO * imageIO, std::string_view key, const cbor_item_t * value)
+{
+  if (key == "imageType")
+  {
+    const cbor_item_t * imageTypeItem = value;
+    const size_t imageTypeCount = cbor_map_size(imageTypeItem);
+    const struct cbor_pair * imageTypeHandle = cbor_map_handle(imageTypeItem);
+    for (size_t jj = 0; jj < imageTypeCount; ++jj)
+    {
+      const std::string_view imageTypeKey(reinterpret_cast<char *>(cbor_string_handle(imageTypeHandle[jj].key)), cbor_string_length(imageTypeHandle[jj].key));
+      if (imageTypeKey == "dimension")
+      {
+        const auto dimension = static_cast< unsigned int >( cbor_get_int(imageTypeHandle[jj].value) );
+        imageIO->SetNumberOfDimensions( dimension );
+      }
+      else if (imageTypeKey == "componentType")
+      {
+        const std::string componentType(reinterpret_cast<char *>(cbor_string_handle(imageTypeHandle[jj].value)), cbor_string_length(imageTypeHandle[jj].value));
+        const ImageIOBase::IOComponentEnum ioComponentType = IOComponentEnumFromWasmComponentType( componentType );
+        imageIO->SetComponentType( ioComponentType );
+      }
+      else if (imageTypeKey == "pixelType")
+      {
+        const std::string pixelType(reinterpret_cast<char *>(cbor_string_handle(imageTypeHandle[jj].value)), cbor_string_length(imageTypeHandle[jj].value));
+        const IOPixelEnum ioPixelType = IOPixelEnumFromWasmPixelType( pixelType );
+        imageIO->SetPixelType( ioPixelType );
+      }
+      else if (imageTypeKey == "components")
+      {
+        const auto components = static_cast< unsigned int >( cbor_get_int(imageTypeHandle[jj].value) );
+        imageIO->SetNumberOfComponents( components );
+      }
+      else
+      {
+        itkGenericExceptionMacro("Unexpected imageType cbor map key: " << imageTypeKey);
+      }
+    }
+  }
+  else if (key == "origin")
+  {
+    const auto originHandle = cbor_array_handle(value);
+    const size_t originSize = cbor_array_size(value);
+    for( int dim = 0; dim < originSize; ++dim )
+      {
+      const auto item = originHandle[dim];
+      imageIO->SetOrigin( dim, cbor_float_get_float(item) );
+      }
+  }
+  else if (key == "spacing")
+  {
+    const auto spacingHandle = cbor_array_handle(value);
+    const size_t spacingSize = cbor_array_size(value);
+    for( int dim = 0; dim < spacingSize; ++dim )
+      {
+      const auto item = spacingHandle[dim];
+      imageIO->SetSpacing( dim, cbor_float_get_float(item) );
+      }
+  }
+  else if (key == "size")
+  {
+    const auto sizeHandle = cbor_array_handle(value);
+    const size_t sizeSize = cbor_array_size(value);
+    for( int dim = 0; dim < sizeSize; ++dim )
+      {
+      const auto item = sizeHandle[dim];
+      imageIO->SetDimensions( dim, cbor_get_int(item) );
+      }
+  }
+  else if (key == "direction")
+  {
+    cbor_item_t * directionItem = cbor_tag_item(value);
+    const double * directionHandle = reinterpret_cast< double * >( cbor_bytestring_handle(directionItem) );
+    const size_t directionSize = cbor_bytestring_length(directionItem);
+    const unsigned int dimension = std::sqrt( directionSize / sizeof(double) );
+    for( unsigned int jj = 0; jj < dimension; ++jj )
+      {
+      std::vector< double > direction( dimension );
+      for( unsigned int kk = 0; kk < dimension; ++kk )
+        {
+        direction[kk] = directionHandle[kk + jj*dimension];
+        }
+      imageIO->SetDirection( jj, direction );
+      }
+  }
+  else
+  {
+    itkGenericExceptionMacro("Unexpected cbor map key: " << key);
+  }
+}
+
+// Apply the resolution levels discarded by a decode to the spacing or the
+// size of the first two dimensions
+void
+ReduceCBORIndexResolution(WasmImageIO * imageIO, std::string_view key, unsigned int resolutionReduction)
+{
+  if (resolutionReduction == 0)
+  {
+    return;
+  }
+  const unsigned int reducedDimensions = std::min(imageIO->GetNumberOfDimensions(), 2u);
+  for (unsigned int dim = 0; dim < reducedDimensions; ++dim)
+  {
+    if (key == "spacing")
+    {
+      imageIO->SetSpacing(dim, imageIO->GetSpacing(dim) * static_cast< double >( uint64_t{ 1 } << resolutionReduction ));
+    }
+    else
+    {
+      const uint64_t size = imageIO->GetDimensions(dim);
+      imageIO->SetDimensions(dim, ( size + ( uint64_t{ 1 } << resolutionReduction ) - 1 ) >> resolutionReduction);
+    }
+  }
+}
+
+} // end anonymous namespace
+
+
+void
+WasmImageIO
+::ReadCBORInformation()
+{
+  this->ReadCBOR(nullptr);
+}
+
+
+void
+WasmImageIO
+::ReadCBOR( void *buffer, unsigned char * cborBuffer, size_t cborBufferLength )
+{
+  if (cborBuffer != nullptr)
+  {
+    wasm::MemoryCBORSource source(cborBuffer, cborBufferLength);
+    this->ReadCBOR(buffer, source);
+    return;
+  }
+
+  std::unique_ptr< wasm::RangeReader > reader = this->OpenRangeReader();
+  if (!reader)
+  {
+    itkExceptionMacro("Could not read file: " << this->GetFileName());
+  }
+  wasm::RangeCBORSource source(std::move(reader));
+  this->ReadCBOR(buffer, source);
+}
+
+
+void
+WasmImageIO
+::ReadCBOR( void *buffer, wasm::CBORSource & source )
+{
+  CBORReadProgress progress;
+  this->ReadCBOR(buffer, source, progress);
+}
+
+
+void
+WasmImageIO
+::ReadCBOR( void *buffer, wasm::CBORSource & source, CBORReadProgress & progress )
+{
+  ITK_WASM_TRACE_SCOPE("WasmImageIO::ReadCBOR");
+  if (!progress.mapStarted)
+  {
+    wasm::CBORHead indexHead;
+    if (!wasm::ReadCBORHead(source, indexHead) || indexHead.majorType != 5)
+    {
+      itkExceptionMacro("Expected a definite-length cbor map in " << this->GetFileName());
+    }
+    progress.mapStarted = true;
+    this->m_PayloadFilters = wasm::PayloadFilters();
+    this->m_IntensityStatistics = wasm::IntensityStatistics();
+    progress.numberOfEntries = indexHead.argument;
+    progress.entriesRead = 0;
+    progress.dataSkipped = false;
+  }
+
+  const std::string_view informationKeys[] = { "imageType", "origin", "spacing", "direction", "size", "metadata" };
+  size_t informationKeysRead = 0;
+  std::vector< unsigned char > itemBuffer;
+  for (; progress.entriesRead < progress.numberOfEntries; ++progress.entriesRead)
+  {
+    if (buffer == nullptr && informationKeysRead == std::size(informationKeys))
+    {
+      // The image information is complete
+      break;
+    }
+
+    wasm::CBORHead keyHead;
+    if (!wasm::ReadCBORHead(source, keyHead) || keyHead.majorType != 3)
+    {
+      itkExceptionMacro("Unexpected cbor map key in " << this->GetFileName());
+    }
+    std::string key(keyHead.argument, '\0');
+    if (!source.Read(key.data(), key.size()))
+    {
+      itkExceptionMacro("Could not successfully read " << this->GetFileName());
+    }
+
+    if (key == "data")
+    {
+      // The tagged byte string payload is read straight into the image buffer
+      wasm::CBORHead tagHead;
+      wasm::CBORHead dataHead;
+      if (!wasm::ReadCBORHead(source, tagHead) || tagHead.majorType != 6 || !wasm::ReadCBORHead(source, dataHead) || (dataHead.majorType != 2 && dataHead.majorType != 4))
+      {
+        itkExceptionMacro("Unexpected cbor data entry in " << this->GetFileName());
+      }
+      if (dataHead.majorType == 4)
+      {
+        // The pixel data of a .iwi.bin file is at an aligned offset after
+        // the metadata
+        uint64_t dataOffset = 0;
+        uint64_t dataSize = 0;
+        if (!wasm::ReadAlignedPayloadLocation(source, dataHead, dataOffset, dataSize))
+        {
+          itkExceptionMacro("Unexpected cbor data entry in " << this->GetFileName());
+        }
+        if (buffer != nullptr)
+        {
+          this->ReadAlignedData(buffer, dataOffset, dataSize);
+        }
+        continue;
+      }
+      if (buffer == nullptr)
+      {
+        if (!source.Skip(dataHead.argument))
+        {
+          itkExceptionMacro("Could not successfully read " << this->GetFileName());
+        }
+        progress.dataSkipped = true;
+        continue;
+      }
+      if (this->m_PayloadFilters.IsEnabled() && this->RequestedToStream())
+      {
+        itkExceptionMacro("Streamed reads of filtered pixel data are not supported: " << this->GetFileName());
+      }
+      if (this->m_PayloadFilters.runLength)
+      {
+        this->ReadCBORRuns(buffer, source, dataHead.argument);
+        continue;
+      }
+      if (this->m_PayloadFilters.codec != wasm::PayloadCodec::None)
+      {
+        // Encoded planes are decoded into the buffer as a whole
+        std::vector< unsigned char > encoded(static_cast< size_t >( dataHead.argument ));
+        if (!source.Read(encoded.data(), encoded.size()))
+        {
+          itkExceptionMacro("Could not successfully read " << this->GetFileName());
+        }
+        this->DecodePayloadCodec(encoded.data(), encoded.size(), buffer);
+        continue;
+      }
+      this->ReadCBORData(buffer, source, dataHead.argument);
+      if (this->m_PayloadFilters.IsEnabled())
+      {
+        this->DecodePayloadFilters(buffer);
+      }
+      continue;
+    }
+
+    itemBuffer.clear();
+    if (!wasm::CopyCBORItem(source, itemBuffer))
+    {
+      itkExceptionMacro("Could not successfully read " << this->GetFileName());
+    }
+    if (key == "metadata")
+    {
+      // The metadata of a bundle member follows the metadata it shares
+      // with the bundle
+      const std::string & sharedMetadata = this->m_BundleTableOfContents.metadata;
+      if (this->m_BundleMember.sharedMetadata &&
+          !wasm::ReadCBORMetaDataDictionary(reinterpret_cast< const unsigned char * >( sharedMetadata.data() ), sharedMetadata.size(), this->GetMetaDataDictionary(), m_MetaDataKeyFilter))
+      {
+        itkExceptionMacro("Unexpected bundle metadata in " << this->GetFileName());
+      }
+      // Decoded from the encoded bytes, without an item tree
+      if (!wasm::ReadCBORMetaDataDictionary(itemBuffer.data(), itemBuffer.size(), this->GetMetaDataDictionary(), m_MetaDataKeyFilter))
+      {
+        itkExceptionMacro("Unexpected cbor metadata entry in " << this->GetFileName());
+      }
+      ++informationKeysRead;
+      continue;
+    }
+    struct cbor_load_result result;
+    cbor_item_t * value = cbor_load(itemBuffer.data(), itemBuffer.size(), &result);
+    if (result.error.code != CBOR_ERR_NONE)
+    {
+      itkExceptionMacro("There was an error while reading the cbor " << key << " entry of " << this->GetFileName() << " near byte " << result.error.position);
+    }
+    try
+    {
+      if (key == "payloadFilters")
+      {
+        this->m_PayloadFilters = wasm::ReadPayloadFilters(value);
+      }
+      else if (key == "intensityStatistics")
+      {
+        this->m_IntensityStatistics = wasm::ReadIntensityStatistics(value);
+      }
+      else
+      {
+        ReadCBORIndexItem(this, key, value);
+        // The payloadFilters entry precedes the spacing and the size
+        if ((key == "spacing" || key == "size") && this->m_PayloadFilters.codec == wasm::PayloadCodec::HTJ2K)
+        {
+          ReduceCBORIndexResolution(this, key, this->m_ResolutionReduction);
+        }
+      }
+    }
+    catch (const std::runtime_error & error)
+    {
+      cbor_decref(&value);
+      itkExceptionMacro("Could not read " << this->GetFileName() << ": " << error.what());
+    }
+    catch (...)
+    {
+      cbor_decref(&value);
+      throw;
+    }
+    cbor_decref(&value);
+    if (std::find(std::begin(informationKeys), std::end(informationKeys), key) != std::end(informationKeys))
+    {
+      ++informationKeysRead;
+    }
+  }
+}
+
+void
+WasmImageIO
+::ReadCBORData( void *buffer, wasm::CBORSource & source, uint64_t dataSize )
+{
+  const SizeValueType numberOfBytesToBeRead =
+    static_cast< SizeValueType >( this->GetImageSizeInBytes() );
+  if (dataSize < numberOfBytesToBeRead)
+  {
+    itkExceptionMacro("Read failed: the cbor data of " << this->GetFileName() << " is smaller than the image");
+  }
+
+  if (!this->RequestedToStream())
+  {
+    if (!source.Read(buffer, numberOfBytesToBeRead) || !source.Skip(dataSize - numberOfBytesToBeRead))
+    {
+      itkExceptionMacro("Could not successfully read " << this->GetFileName());
+    }
+    return;
+  }
+
+  // Runs of the IORegion are in increasing order in the byte string
+  auto bufferBytes = static_cast< char * >( buffer );
+  uint64_t position = 0;
+  this->ForEachIORegionRun([&](uint64_t offset, size_t lineBytes) {
+    if (!source.Skip(offset - position) || !source.Read(bufferBytes, lineBytes))
+    {
+      itkExceptionMacro("Could not successfully read the image region from " << this->GetFileName());
+    }
+    bufferBytes += lineBytes;
+    position = offset + lineBytes;
+  });
+  if (!source.Skip(dataSize - position))
+  {
+    itkExceptionMacro("Could not successfully read " << this->GetFileName());
+  }
+}
+
+
+void
+WasmImageIO
+::ReadCBORRuns( void *buffer, wasm::CBORSource & source, uint64_t dataSize )
+{
+  try
+  {
+    wasm::ValidatePayloadFilters(this->m_PayloadFilters, this->GetPayloadLayout());
+  }
+  catch (const std::runtime_error & error)
+  {
+    itkExceptionMacro("Could not read " << this->GetFileName() << ": " << error.what());
+  }
+
+  // The runs are read in pieces and filled into the buffer
+  wasm::PayloadRunDecoder decoder(this->GetPayloadLayout(), buffer, this->GetImageSizeInBytes());
+  std::vector< unsigned char > piece(static_cast< size_t >( std::min< uint64_t >(dataSize, 256 * 1024) ));
+  uint64_t remaining = dataSize;
+  while (remaining > 0)
+  {
+    const size_t pieceSize = static_cast< size_t >( std::min< uint64_t >(remaining, piece.size()) );
+    if (!source.Read(piece.data(), pieceSize))
+    {
+      itkExceptionMacro("Could not successfully read " << this->GetFileName());
+    }
+    if (!decoder.Decode(piece.data(), pieceSize))
+    {
+      itkExceptionMacro("Read failed: the pixel runs of " << this->GetFileName() << " are larger than the image");
+    }
+    remaining -= pieceSize;
+  }
+  if (!decoder.IsComplete())
+  {
+    itkExceptionMacro("Read failed: the pixel runs of " << this->GetFileName() << " are smaller than the image");
+  }
+}
+
+
+void
+WasmImageIO
+::WriteCBOR(const void *buffer)
+{
+  this->UpdateIntensityStatistics(buffer);
+  // The encoded size lets compressing sinks pledge their content size
+  this->m_EncodedPayload.clear();
+  wasm::CountingCBORSink encodedSize;
+  std::unique_ptr< wasm::CBORSink > sink;
+  try
+  {
+    this->WriteCBOR(buffer, encodedSize);
+    sink = this->CreateCBORSink(encodedSize.GetSize());
+    this->WriteCBOR(buffer, *sink);
+  }
+  catch (...)
+  {
+    this->m_EncodedPayload.clear();
+    throw;
+  }
+  this->m_EncodedPayload.clear();
+  if (!sink->Finish())
+  {
+    itkExceptionMacro("Could not successfully write " << this->GetFileName());
+  }
+}
+
+
+std::unique_ptr< wasm::CBORSink >
+WasmImageIO
+::CreateCBORSink(uint64_t itkNotUsed(encodedSize)) const
+{
+  FILE* file = this->OpenCBORFile();
+  if (file == NULL) {
+    itkExceptionMacro("Could not open file for writing: " << this->GetFileName());
+  }
+  return std::make_unique< wasm::FileCBORSink >(file);
+}
+
+
+FILE *
+WasmImageIO
+::OpenCBORFile() const
+{
+  // Bundle members are appended after the members before them
+  return fopen(this->GetFileName(), this->FileNameIsBundle() ? "ab" : "wb");
+}
+
+
+bool
+WasmImageIO
+::CanStreamWrite()
+{
+  if (this->m_ComputeIntensityStatistics)
+  {
+    // The statistics of the whole image are written in the header
+    return false;
+  }
+  if (wasm::FileNameIsAligned(this->GetFileName(), ".iwi.bin"))
+  {
+    return true;
+  }
+  if (this->FileNameIsBundle())
+  {
+    return false;
+  }
+  // Filter blocks and delta rows can span the pieces of a streamed write
+  return !this->GetPayloadFiltersForWriting().IsEnabled();
+}
+
+
+void
+WasmImageIO
+::WriteCBORRegion(const void *buffer)
+{
+  const uint64_t numberOfBytesToWrite = this->GetImageSizeInBytes();
+  auto bufferBytes = static_cast< const char * >( buffer );
+  this->ForEachIORegionRun([&](uint64_t offset, size_t runBytes) {
+    if (offset == 0)
+    {
+      // The header and the head of the pixel data byte string are written
+      // with the first piece, and each piece appends its pixels
+      this->m_StreamedWriteSink.reset();
+      this->m_PayloadFilters = wasm::PayloadFilters();
+      this->UpdateIntensityStatistics(nullptr);
+      wasm::CountingCBORSink encodedSize;
+      this->WriteCBORHeader(encodedSize, true);
+      encodedSize.WriteByteStringHead(numberOfBytesToWrite);
+      this->m_StreamedWriteSink = this->CreateCBORSink(encodedSize.GetSize() + numberOfBytesToWrite);
+      this->WriteCBORHeader(*this->m_StreamedWriteSink, true);
+      this->m_StreamedWriteSink->WriteByteStringHead(numberOfBytesToWrite);
+      this->m_StreamedWriteOffset = 0;
+      this->m_StreamedWriteFileName = this->GetFileName();
+    }
+    else if (!this->m_StreamedWriteSink || this->m_StreamedWriteFileName != this->GetFileName() ||
+             offset != this->m_StreamedWriteOffset)
+    {
+      this->m_StreamedWriteSink.reset();
+      itkExceptionMacro("The pieces of a streamed write of " << this->GetFileName()
+                        << " must cover the image in file order, e.g. slabs along the slowest dimension");
+    }
+    this->m_StreamedWriteSink->WriteByteStringContent(bufferBytes, runBytes);
+    bufferBytes += runBytes;
+    this->m_StreamedWriteOffset += runBytes;
+  });
+
+  if (this->m_StreamedWriteSink && this->m_StreamedWriteOffset == numberOfBytesToWrite)
+  {
+    std::unique_ptr< wasm::CBORSink > sink = std::move(this->m_StreamedWriteSink);
+    this->m_StreamedWriteFileName.clear();
+    if (!sink->Finish())
+    {
+      itkExceptionMacro("Could not successfully write " << this->GetFileName());
+    }
+  }
+}
+
+
+void
+WasmImageIO
+::WriteCBOR(const void *buffer, wasm::CBORSink & sink)
+{
+  ITK_WASM_TRACE_SCOPE("WasmImageIO::WriteCBOR");
+  this->m_PayloadFilters = buffer != nullptr ? this->GetPayloadFiltersForWriting() : wasm::PayloadFilters();
+  const wasm::PayloadLayout payloadLayout = this->GetPayloadLayout();
+  try
+  {
+    wasm::ValidatePayloadFilters(this->m_PayloadFilters, payloadLayout);
+  }
+  catch (const std::runtime_error & error)
+  {
+    itkExceptionMacro(<< error.what());
+  }
+  const bool filtered = this->m_PayloadFilters.IsEnabled();
+
+  this->WriteCBORHeader(sink, buffer != nullptr);
+
+  if( buffer != nullptr )
+  {
+    // The typed array is streamed from the image buffer
+    const SizeValueType numberOfBytesToWrite =
+      static_cast< SizeValueType >( this->GetImageSizeInBytes() );
+    if (this->m_PayloadFilters.runLength)
+    {
+      const uint64_t runsSize = wasm::GetPayloadRunsSize(payloadLayout, buffer, numberOfBytesToWrite);
+      sink.WriteByteStringHead(runsSize);
+      if (sink.DiscardsContent())
+      {
+        // Only the size of the content is counted
+        sink.WriteByteStringContent(buffer, static_cast< size_t >( runsSize ));
+        return;
+      }
+      wasm::EncodePayloadRuns(sink, payloadLayout, buffer, numberOfBytesToWrite);
+      return;
+    }
+    if (this->m_PayloadFilters.codec != wasm::PayloadCodec::None)
+    {
+      // Encoded once for the counting and the writing sinks of WriteCBOR
+      if (this->m_EncodedPayload.empty())
+      {
+        this->EncodePayloadCodec(buffer, this->m_EncodedPayload);
+      }
+      sink.WriteByteString(this->m_EncodedPayload.data(), this->m_EncodedPayload.size());
+      return;
+    }
+    if (!filtered || sink.DiscardsContent())
+    {
+      sink.WriteByteString(buffer, numberOfBytesToWrite);
+      return;
+    }
+
+    // Filtered blocks are streamed through a block buffer
+    sink.WriteByteStringHead(numberOfBytesToWrite);
+    const size_t blockSize = this->m_PayloadFilters.blockSize;
+    std::vector< unsigned char > block(std::min< uint64_t >(blockSize, numberOfBytesToWrite));
+    std::vector< unsigned char > scratch;
+    for (uint64_t offset = 0; offset < numberOfBytesToWrite; offset += blockSize)
+    {
+      const size_t size = static_cast< size_t >( std::min< uint64_t >(blockSize, numberOfBytesToWrite - offset) );
+      wasm::EncodePayloadBlock(this->m_PayloadFilters, payloadLayout, buffer, offset, size, block.data(), scratch);
+      sink.WriteByteStringContent(block.data(), size);
+    }
+  }
+}
+
+
+void
+WasmImageIO
+::WriteCBORHeader(wasm::CBORSink & sink, bool withData)
+{
+  uint64_t dataTag = 0;
+  if( withData )
+  {
+    // Todo: support endianness
+    // https://www.iana.org/assignments/cbor-tags/cbor-tags.xhtml
+    switch (this->GetComponentType()) {
+      case IOComponentEnum::CHAR:
+        dataTag = 64;
+        break;
+      case IOComponentEnum::UCHAR:
+        dataTag = 64;
+        break;
+      case IOComponentEnum::SHORT:
+        dataTag = 73;
+        break;
+      case IOComponentEnum::USHORT:
+        dataTag = 69;
+        break;
+      case IOComponentEnum::INT:
+        dataTag = 74;
+        break;
+      case IOComponentEnum::UINT:
+        dataTag = 70;
+        break;
+      case IOComponentEnum::LONG:
+        dataTag = 75;
+        break;
+      case IOComponentEnum::ULONG:
+        dataTag = 71;
+        break;
+      case IOComponentEnum::LONGLONG:
+        dataTag = 75;
+        break;
+      case IOComponentEnum::ULONGLONG:
+        dataTag = 71;
+        break;
+      case IOComponentEnum::FLOAT:
+        dataTag = 85;
+        break;
+      case IOComponentEnum::DOUBLE:
+        dataTag = 86;
+        break;
+      default:
+        itkExceptionMacro("Unexpected component type");
+    }
+  }
+
+  const bool filtered = this->m_PayloadFilters.IsEnabled();
+  const bool withStatistics = !this->m_IntensityStatistics.IsEmpty();
+
+  sink.WriteMap((withData ? 7 : 6) + (filtered ? 1 : 0) + (withStatistics ? 1 : 0));
+
+  sink.WriteString("imageType");
+  sink.WriteMap(4);
+  sink.WriteString("dimension");
+  sink.WriteUInt(this->GetNumberOfDimensions());
+  sink.WriteString("componentType");
+  sink.WriteString(WasmComponentTypeFromIOComponentEnum( this->GetComponentType() ));
+  sink.WriteString("pixelType");
+  sink.WriteString(WasmPixelTypeFromIOPixelEnum( this->GetPixelType() ));
+  sink.WriteString("components");
+  sink.WriteUInt(this->GetNumberOfComponents());
+
+  if (filtered)
+  {
+    // Before the image information is complete, so information reads see it
+    sink.WriteString("payloadFilters");
+    wasm::WritePayloadFilters(sink, this->m_PayloadFilters);
+  }
+
+  if (withStatistics)
+  {
+    // Also before the image information is complete
+    sink.WriteString("intensityStatistics");
+    wasm::WriteIntensityStatistics(sink, this->m_IntensityStatistics);
+  }
+
+  const unsigned int dimension = this->GetNumberOfDimensions();
+
+  sink.WriteString("origin");
+  sink.WriteArray(dimension);
+  for( unsigned int ii = 0; ii < dimension; ++ii )
+  {
+    sink.WriteDouble(this->GetOrigin(ii));
+  }
+
+  sink.WriteString("spacing");
+  sink.WriteArray(dimension);
+  for( unsigned int ii = 0; ii < dimension; ++ii )
+  {
+    sink.WriteDouble(this->GetSpacing(ii));
+  }
+
+  std::vector< double > direction( dimension * dimension );
+  for( unsigned int ii = 0; ii < dimension; ++ii )
+    {
+    const std::vector< double > dimensionDirection = this->GetDirection( ii );
+    for( unsigned int jj = 0; jj < dimension; ++jj )
+      {
+      direction[jj + ii*dimension] = dimensionDirection[jj];
+      }
+    }
+  sink.WriteString("direction");
+  sink.WriteTag(86);
+  sink.WriteByteString(direction.data(), direction.size() * sizeof(double));
+
+  sink.WriteString("size");
+  sink.WriteArray(dimension);
+  for( unsigned int ii = 0; ii < dimension; ++ii )
+  {
+    sink.WriteUInt(this->GetDimensions(ii));
+  }
+
+  sink.WriteString("metadata");
+  wasm::WriteCBORMetaDataDictionary(sink, this->m_WritingBundleMember ? this->m_BundleMemberMetaData : this->GetMetaDataDictionary(), m_MetaDataKeyFilter);
+
+  if( withData )
+  {
+    sink.WriteString("data");
+    sink.WriteTag(dataTag);
+  }
+}
+
+
+void
+WasmImageIO
+::UpdateIntensityStatistics(const void *buffer)
+{
+  this->m_IntensityStatistics = wasm::IntensityStatistics();
+  if (!this->m_ComputeIntensityStatistics || buffer == nullptr || this->RequestedToStream())
+  {
+    return;
+  }
+  ITK_WASM_TRACE_SCOPE("WasmImageIO::UpdateIntensityStatistics");
+  try
+  {
+    this->m_IntensityStatistics = wasm::ComputeIntensityStatistics(this->GetComponentType(),
+                                                                   buffer,
+                                                                   this->GetNumberOfComponents(),
+                                                                   this->GetImageSizeInPixels(),
+                                                                   this->m_IntensityHistogramBins);
+  }
+  catch (const std::runtime_error & error)
+  {
+    itkExceptionMacro(<< error.what());
+  }
+}
+
+
+wasm::PayloadFilters
+WasmImageIO
+::GetPayloadFiltersForWriting() const
+{
+  wasm::PayloadFilters filters;
+  switch (this->GetComponentType())
+  {
+    case IOComponentEnum::FLOAT:
+    case IOComponentEnum::DOUBLE:
+      break;
+    default:
+      filters.runLength = this->m_RunLengthPayload;
+  }
+  return filters;
+}
+
+
+void
+WasmImageIO
+::EncodePayloadCodec(const void * itkNotUsed(buffer), std::string & itkNotUsed(encoded)) const
+{
+  itkExceptionMacro("The " << wasm::GetPayloadCodecName(this->m_PayloadFilters.codec)
+                    << " payload codec is not supported by " << this->GetNameOfClass() << ", e.g. use the image-io WasmZstdImageIO");
+}
+
+
+void
+WasmImageIO
+::DecodePayloadCodec(const unsigned char * itkNotUsed(encoded), size_t itkNotUsed(size), void * itkNotUsed(buffer))
+{
+  itkExceptionMacro("Could not read " << this->GetFileName() << ": the " << wasm::GetPayloadCodecName(this->m_PayloadFilters.codec)
+                    << " payload codec is not supported by " << this->GetNameOfClass() << ", e.g. use the image-io WasmZstdImageIO");
+}
+
+
+wasm::PayloadLayout
+WasmImageIO
+::GetPayloadLayout() const
+{
+  wasm::PayloadLayout layout;
+  layout.componentSize = this->GetComponentSize();
+  layout.components = this->GetNumberOfComponents();
+  layout.rowLength = static_cast< uint64_t >( this->GetDimensions(0) ) * layout.components;
+  return layout;
+}
+
+
+void
+WasmImageIO
+::DecodePayloadFilters(void *buffer)
+{
+  const wasm::PayloadLayout layout = this->GetPayloadLayout();
+  try
+  {
+    wasm::ValidatePayloadFilters(this->m_PayloadFilters, layout);
+  }
+  catch (const std::runtime_error & error)
+  {
+    itkExceptionMacro("Could not read " << this->GetFileName() << ": " << error.what());
+  }
+
+  const uint64_t size = this->GetImageSizeInBytes();
+  const size_t blockSize = this->m_PayloadFilters.blockSize;
+  auto bufferBytes = static_cast< unsigned char * >( buffer );
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  const SizeValueType numberOfBlocks = static_cast< SizeValueType >( ( size + blockSize - 1 ) / blockSize );
+  multiThreader->ParallelizeArray(0, numberOfBlocks, [&](SizeValueType block) {
+    std::vector< unsigned char > scratch;
+    const uint64_t offset = static_cast< uint64_t >( block ) * blockSize;
+    const size_t blockBytes = static_cast< size_t >( std::min< uint64_t >(blockSize, size - offset) );
+    wasm::DecodePayloadBlock(this->m_PayloadFilters, layout, bufferBytes + offset, blockBytes, scratch);
+  }, nullptr);
+
+  if (this->m_PayloadFilters.delta)
+  {
+    // Rows are independent once their blocks are decoded
+    const SizeValueType numberOfRows = static_cast< SizeValueType >( size / ( layout.rowLength * layout.componentSize ) );
+    multiThreader->ParallelizeArray(0, numberOfRows, [&](SizeValueType row) {
+      wasm::DecodePayloadRows(this->m_PayloadFilters, layout, buffer, row, 1);
+    }, nullptr);
+  }
+}
+
+
+bool
+WasmImageIO
+::FileNameIsBundle() const
+{
+  return wasm::FileNameIsBundle(this->GetFileName(), ".iwi.bundle");
+}
+
+
+void
+WasmImageIO
+::SelectBundleMember()
+{
+  this->m_BundleTableOfContents = wasm::BundleTableOfContents();
+  this->m_BundleMember = wasm::BundleMember();
+  if (!this->FileNameIsBundle())
+  {
+    return;
+  }
+
+  std::unique_ptr< wasm::RangeReader > reader = wasm::RangeReader::Open(this->GetFileName());
+  if (!reader)
+  {
+    itkExceptionMacro("Could not read file: " << this->GetFileName());
+  }
+  if (!wasm::ReadBundleTableOfContents(*reader, this->m_BundleTableOfContents) || this->m_BundleTableOfContents.bundleType != "Image")
+  {
+    itkExceptionMacro("Expected an image bundle in " << this->GetFileName());
+  }
+  const wasm::BundleMember * member = wasm::FindBundleMember(this->m_BundleTableOfContents, this->m_BundleMemberName, this->m_BundleMemberIndex);
+  if (member == nullptr)
+  {
+    itkExceptionMacro("There is no member " << (this->m_BundleMemberName.empty() ? std::to_string(this->m_BundleMemberIndex) : this->m_BundleMemberName)
+                      << " in " << this->GetFileName() << ", which has " << this->m_BundleTableOfContents.members.size() << " members");
+  }
+  this->m_BundleMember = *member;
+}
+
+
+std::vector< std::string >
+WasmImageIO
+::GetBundleMemberNames() const
+{
+  std::vector< std::string > names;
+  for (const wasm::BundleMember & member : this->m_BundleTableOfContents.members)
+  {
+    names.push_back(member.name);
+  }
+  return names;
+}
+
+
+std::unique_ptr< wasm::RangeReader >
+WasmImageIO
+::OpenRangeReader() const
+{
+  std::unique_ptr< wasm::RangeReader > reader = wasm::RangeReader::Open(this->GetFileName());
+  if (reader && this->FileNameIsBundle())
+  {
+    return wasm::OpenBundleMember(std::move(reader), this->m_BundleMember);
+  }
+  return reader;
+}
+
+
+std::string
+WasmImageIO
+::GetBundleMemberEncodingForWriting() const
+{
+  return "cbor";
+}
+
+
+void
+WasmImageIO
+::WriteBundleMember(const void *buffer)
+{
+  const std::string path = this->GetFileName();
+  wasm::BundleTableOfContents & tableOfContents = this->m_BundleTableOfContents;
+  if (!wasm::ReadBundleForAppending(path, "Image", this->m_AppendToBundle, tableOfContents))
+  {
+    itkExceptionMacro("Expected an image bundle to append to in " << path);
+  }
+
+  wasm::BundleMember member;
+  member.name = this->m_BundleMemberName.empty() ? std::to_string(tableOfContents.members.size()) : this->m_BundleMemberName;
+  member.encoding = this->GetBundleMemberEncodingForWriting();
+  if (wasm::FindBundleMember(tableOfContents, member.name, 0) != nullptr)
+  {
+    itkExceptionMacro("The image bundle " << path << " already has a member named " << member.name);
+  }
+
+  // The shared keys are stored once, with the first member, and omitted
+  // from members with the same values
+  MetaDataDictionary sharedDictionary;
+  if (this->m_BundleMetaDataKeyFilter.IsEnabled())
+  {
+    sharedDictionary = this->GetMetaDataDictionary();
+    this->m_MetaDataKeyFilter.Apply(sharedDictionary);
+    this->m_BundleMetaDataKeyFilter.Apply(sharedDictionary);
+  }
+  std::string sharedMetadata;
+  wasm::MemoryCBORSink sharedSink(sharedMetadata);
+  wasm::WriteCBORMetaDataDictionary(sharedSink, sharedDictionary);
+  if (tableOfContents.members.empty())
+  {
+    tableOfContents.metadata = sharedMetadata;
   }
-}
-
-
-void
-WasmImageIO
-::ReadCBOR( void *buffer, unsigned char * cborBuffer, size_t cborBufferLength )
-{
-  bool cborBufferAllocated = false;
-  size_t length = cborBufferLength;
-  if (cborBuffer == nullptr)
+  member.sharedMetadata = sharedMetadata == tableOfContents.metadata;
+  this->m_BundleMemberMetaData = this->GetMetaDataDictionary();
+  if (member.sharedMetadata)
   {
-    FILE* file = fopen(this->GetFileName(), "rb");
-    if (file == NULL) {
-      itkExceptionMacro("Could not read file: " << this->GetFileName());
-    }
-    fseek(file, 0, SEEK_END);
-    length = (size_t)ftell(file);
-    fseek(file, 0, SEEK_SET);
-    cborBuffer = static_cast< unsigned char *>(malloc(length));
-    cborBufferAllocated = true;
-    if (!fread(cborBuffer, length, 1, file))
+    for (auto itr = sharedDictionary.Begin(); itr != sharedDictionary.End(); ++itr)
     {
-      itkExceptionMacro("Could not successfully read " << this->GetFileName());
+      this->m_BundleMemberMetaData.Erase(itr->first);
     }
-    fclose(file);
   }
 
-  struct cbor_load_result result;
-  cbor_item_t* index = cbor_load(cborBuffer, length, &result);
-  if (cborBufferAllocated)
+  if (!wasm::BeginBundleMember(path, tableOfContents))
   {
-    free(cborBuffer);
+    itkExceptionMacro("Could not open file for writing: " << path);
   }
-  if (result.error.code != CBOR_ERR_NONE) {
-    std::string errorDescription;
-    switch (result.error.code) {
-      case CBOR_ERR_MALFORMATED: {
-        errorDescription = "Malformed data\n";
-        break;
-      }
-      case CBOR_ERR_MEMERROR: {
-        errorDescription = "Memory error -- perhaps the input is too large?\n";
-        break;
-      }
-      case CBOR_ERR_NODATA: {
-        errorDescription = "The input is empty\n";
-        break;
-      }
-      case CBOR_ERR_NOTENOUGHDATA: {
-        errorDescription = "Data seem to be missing -- is the input complete?\n";
-        break;
-      }
-      case CBOR_ERR_SYNTAXERROR: {
-        errorDescription = 
-            "Syntactically malformed data -- see https://tools.ietf.org/html/rfc7049\n";
-        break;
-      }
-      case CBOR_ERR_NONE: {
-        break;
-      }
-    }
-    itkExceptionMacro("" << errorDescription << "There was an error while reading the input near byte " << result.error.position << " (read " << result.read << " bytes in total): ");
+  this->m_WritingBundleMember = true;
+  try
+  {
+    this->WriteCBOR(buffer);
   }
-
-  const size_t indexCount = cbor_map_size(index);
-  const struct cbor_pair * indexHandle = cbor_map_handle(index);
-  for (size_t ii = 0; ii < indexCount; ++ii)
+  catch (...)
   {
-    const std::string_view key(reinterpret_cast<char *>(cbor_string_handle(indexHandle[ii].key)), cbor_string_length(indexHandle[ii].key));
-    if (key == "imageType")
-    {
-      const cbor_item_t * imageTypeItem = indexHandle[ii].value;
-      const size_t imageTypeCount = cbor_map_size(imageTypeItem);
-      const struct cbor_pair * imageTypeHandle = cbor_map_handle(imageTypeItem);
-      for (size_t jj = 0; jj < imageTypeCount; ++jj)
-      {
-        const std::string_view imageTypeKey(reinterpret_cast<char *>(cbor_string_handle(imageTypeHandle[jj].key)), cbor_string_length(imageTypeHandle[jj].key));
-        if (imageTypeKey == "dimension")
-        {
-          const auto dimension = cbor_get_uint32(imageTypeHandle[jj].value);
-          this->SetNumberOfDimensions( dimension );
-        }
-        else if (imageTypeKey == "componentType")
-        {
-          const std::string componentType(reinterpret_cast<char *>(cbor_string_handle(imageTypeHandle[jj].value)), cbor_string_length(imageTypeHandle[jj].value));
-          const ImageIOBase::IOComponentEnum ioComponentType = IOComponentEnumFromWasmComponentType( componentType );
-          this->SetComponentType( ioComponentType );
-        }
-        else if (imageTypeKey == "pixelType")
-        {
-          const std::string pixelType(reinterpret_cast<char *>(cbor_string_handle(imageTypeHandle[jj].value)), cbor_string_length(imageTypeHandle[jj].value));
-          const IOPixelEnum ioPixelType = IOPixelEnumFromWasmPixelType( pixelType );
-          this->SetPixelType( ioPixelType );
-        }
-        else if (imageTypeKey == "components")
-        {
-          const auto components = cbor_get_uint32(imageTypeHandle[jj].value);
-          this->SetNumberOfComponents( components );
-        }
-        else
-        {
-          itkExceptionMacro("Unexpected imageType cbor map key: " << imageTypeKey);
-        }
-      }
-    }
-    else if (key == "origin")
-    {
-      const auto originHandle = cbor_array_handle(indexHandle[ii].value);
-      const size_t originSize = cbor_array_size(indexHandle[ii].value);
-      for( int dim = 0; dim < originSize; ++dim )
-        {
-        const auto item = originHandle[dim];
-        this->SetOrigin( dim, cbor_float_get_float(item) );
-        }
-    }
-    else if (key == "spacing")
-    {
-      const auto spacingHandle = cbor_array_handle(indexHandle[ii].value);
-      const size_t spacingSize = cbor_array_size(indexHandle[ii].value);
-      for( int dim = 0; dim < spacingSize; ++dim )
-        {
-        const auto item = spacingHandle[dim];
-        this->SetSpacing( dim, cbor_float_get_float(item) );
-        }
-    }
-    else if (key == "size")
-    {
-      const auto sizeHandle = cbor_array_handle(indexHandle[ii].value);
-      const size_t sizeSize = cbor_array_size(indexHandle[ii].value);
-      for( int dim = 0; dim < sizeSize; ++dim )
-        {
-        const auto item = sizeHandle[dim];
-        this->SetDimensions( dim, cbor_get_uint64(item) );
-        }
-    }
-    else if (key == "direction")
-    {
-      cbor_item_t * directionItem = cbor_tag_item(indexHandle[ii].value);
-      const double * directionHandle = reinterpret_cast< double * >( cbor_bytestring_handle(directionItem) );
-      const size_t directionSize = cbor_bytestring_length(directionItem);
-      const unsigned int dimension = std::sqrt( directionSize / sizeof(double) );
-      for( unsigned int jj = 0; jj < dimension; ++jj )
-        {
-        std::vector< double > direction( dimension );
-        for( unsigned int kk = 0; kk < dimension; ++kk )
-          {
-          direction[kk] = directionHandle[kk + jj*dimension];
-          }
-        this->SetDirection( jj, direction );
-        }
-    }
-    else if (key == "data")
-    {
-      if( buffer != nullptr )
-      {
-        const SizeValueType numberOfBytesToBeRead =
-          static_cast< SizeValueType >( this->GetImageSizeInBytes() );
-        const cbor_item_t * dataItem = cbor_tag_item(indexHandle[ii].value);
-        const char * dataHandle = reinterpret_cast< char * >( cbor_bytestring_handle(dataItem) );
-        std::memcpy(buffer, dataHandle, numberOfBytesToBeRead);
-      }
-    }
-    else if (key == "metadata")
-    {
-      // todo
-    }
-    else
-    {
-      itkExceptionMacro("Unexpected cbor map key: " << key);
-    }
+    this->m_WritingBundleMember = false;
+    this->m_BundleMemberMetaData = MetaDataDictionary();
+    throw;
   }
+  this->m_WritingBundleMember = false;
+  this->m_BundleMemberMetaData = MetaDataDictionary();
 
-  cbor_decref(&index);
+  if (!wasm::EndBundleMember(path, tableOfContents, member))
+  {
+    itkExceptionMacro("Could not successfully write the table of contents of " << path);
+  }
 }
 
-size_t
+
+void
 WasmImageIO
-::WriteCBOR(const void *buffer, unsigned char ** cborBufferPtr, bool allocateCBORBuffer )
+::ReadAlignedInformation()
 {
-  cbor_item_t * index  = cbor_new_definite_map(7);
-
-  cbor_item_t * imageTypeItem = cbor_new_definite_map(4);
-  cbor_map_add(imageTypeItem,
-    cbor_pair{
-      cbor_move(cbor_build_string("dimension")),
-      cbor_move(cbor_build_uint32(this->GetNumberOfDimensions()))});
-  const std::string componentString = WasmComponentTypeFromIOComponentEnum( this->GetComponentType() );
-  cbor_map_add(imageTypeItem,
-    cbor_pair{
-      cbor_move(cbor_build_string("componentType")),
-      cbor_move(cbor_build_string(componentString.c_str()))});
-  const std::string pixelString = WasmPixelTypeFromIOPixelEnum( this->GetPixelType() );
-  cbor_map_add(imageTypeItem,
-    cbor_pair{
-      cbor_move(cbor_build_string("pixelType")),
-      cbor_move(cbor_build_string(pixelString.c_str()))});
-  cbor_map_add(imageTypeItem,
-    cbor_pair{
-      cbor_move(cbor_build_string("components")),
-      cbor_move(cbor_build_uint32(this->GetNumberOfComponents()))});
-  cbor_map_add(index,
-    cbor_pair{
-      cbor_move(cbor_build_string("imageType")),
-      cbor_move(imageTypeItem)});
+  std::unique_ptr< wasm::RangeReader > reader = wasm::RangeReader::Open(this->GetFileName());
+  if (!reader)
+  {
+    itkExceptionMacro("Could not read file: " << this->GetFileName());
+  }
+  if (!wasm::ReadAlignedFileMetadata(*reader, wasm::AlignedImageFileMagic, this->m_AlignedMetadata))
+  {
+    this->m_AlignedMetadata.clear();
+    itkExceptionMacro("Expected a .iwi.bin header in " << this->GetFileName());
+  }
+  wasm::MemoryCBORSource source(this->m_AlignedMetadata.data(), this->m_AlignedMetadata.size());
+  this->ReadCBOR(nullptr, source);
+}
 
-  const unsigned int dimension = this->GetNumberOfDimensions();
 
-  cbor_item_t * originItem = cbor_new_definite_array(dimension);
-  for( unsigned int ii = 0; ii < dimension; ++ii )
+void
+WasmImageIO
+::ReadAlignedData(void *buffer, uint64_t offset, uint64_t size)
+{
+  if (this->m_PayloadFilters.IsEnabled())
+  {
+    itkExceptionMacro("Unexpected payload filters in " << this->GetFileName());
+  }
+  if (size < this->GetImageSizeInBytes())
   {
-    cbor_array_set(originItem, ii, cbor_move(cbor_build_float8(this->GetOrigin(ii))));
+    itkExceptionMacro("Read failed: the pixel data of " << this->GetFileName() << " is smaller than the image");
   }
-  cbor_map_add(index,
-    cbor_pair{
-      cbor_move(cbor_build_string("origin")),
-      cbor_move(originItem)});
 
-  cbor_item_t * spacingItem = cbor_new_definite_array(dimension);
-  for( unsigned int ii = 0; ii < dimension; ++ii )
+  const std::string path = this->GetFileName();
+  if (this->MapDataFile(path))
   {
-    cbor_array_set(spacingItem, ii, cbor_move(cbor_build_float8(this->GetSpacing(ii))));
+    this->ReadMappedRegion(buffer, offset);
+    return;
   }
-  cbor_map_add(index,
-    cbor_pair{
-      cbor_move(cbor_build_string("spacing")),
-      cbor_move(spacingItem)});
 
-  std::vector< double > direction( dimension * dimension );
-  for( unsigned int ii = 0; ii < dimension; ++ii )
+  // Fetch only the contiguous runs of the IORegion
+  std::unique_ptr< wasm::RangeReader > reader = wasm::RangeReader::Open(path);
+  if (!reader)
+  {
+    itkExceptionMacro("Could not read file: " << path);
+  }
+  auto bufferBytes = static_cast< char * >( buffer );
+  const auto readRun = [&](uint64_t runOffset, size_t runBytes) {
+    if (!reader->Read(offset + runOffset, bufferBytes, runBytes))
     {
-    const std::vector< double > dimensionDirection = this->GetDirection( ii );
-    for( unsigned int jj = 0; jj < dimension; ++jj )
-      {
-      direction[jj + ii*dimension] = dimensionDirection[jj];
-      }
+      itkExceptionMacro(<< "Read failed: " << path << " is smaller than the image region");
     }
-  cbor_item_t * directionItem = cbor_build_bytestring(reinterpret_cast<unsigned char *>(&(direction.at(0))), dimension*dimension*sizeof(double));
-  cbor_item_t * directionTag = cbor_new_tag(86);
-  cbor_tag_set_item(directionTag, cbor_move(directionItem));
-  cbor_map_add(index,
-    cbor_pair{
-      cbor_move(cbor_build_string("direction")),
-      cbor_move(directionTag)});
-
-  cbor_item_t * sizeItem = cbor_new_definite_array(dimension);
-  for( unsigned int ii = 0; ii < dimension; ++ii )
+    bufferBytes += runBytes;
+  };
+  if (this->RequestedToStream())
+  {
+    this->ForEachIORegionRun(readRun);
+  }
+  else
   {
-    cbor_array_set(sizeItem, ii, cbor_move(cbor_build_uint64(this->GetDimensions(ii))));
+    readRun(0, static_cast< size_t >( this->GetImageSizeInBytes() ));
   }
-  cbor_map_add(index,
-    cbor_pair{
-      cbor_move(cbor_build_string("size")),
-      cbor_move(sizeItem)});
+}
 
-  cbor_item_t * metaDataItem = cbor_new_definite_map(0);
-  cbor_map_add(index,
-    cbor_pair{
-      cbor_move(cbor_build_string("metadata")),
-      cbor_move(metaDataItem)});
 
-  if( buffer != nullptr )
+void
+WasmImageIO
+::WriteAligned(const void *buffer)
+{
+  // The pixel data is stored as is, so it can be mapped
+  this->m_PayloadFilters = wasm::PayloadFilters();
+  this->UpdateIntensityStatistics(buffer);
+  const uint64_t dataSize = this->GetImageSizeInBytes();
+  uint64_t dataOffset = 0;
+  const std::string metadata = wasm::EncodeAlignedFileMetadata([&](wasm::CBORSink & sink, uint64_t payloadOffset) {
+    this->WriteCBORHeader(sink, true);
+    wasm::WriteAlignedPayloadLocation(sink, payloadOffset, dataSize);
+  }, dataOffset);
+
+  const ImageIORegion & ioRegion = this->GetIORegion();
+  bool firstPiece = true;
+  if (this->RequestedToStream())
   {
-    const SizeValueType numberOfBytesToWrite =
-      static_cast< SizeValueType >( this->GetImageSizeInBytes() );
-    cbor_item_t * dataItem = cbor_build_bytestring(reinterpret_cast< const unsigned char *>(buffer), numberOfBytesToWrite);
-    uint64_t tag = 0;
-    // Todo: support endianness
-    // https://www.iana.org/assignments/cbor-tags/cbor-tags.xhtml
-    switch (this->GetComponentType()) {
-      case IOComponentEnum::CHAR:
-        tag = 64;
-        break;
-      case IOComponentEnum::UCHAR:
-        tag = 64;
-        break;
-      case IOComponentEnum::SHORT:
-        tag = 73;
-        break;
-      case IOComponentEnum::USHORT:
-        tag = 69;
-        break;
-      case IOComponentEnum::INT:
-        tag = 74;
-        break;
-      case IOComponentEnum::UINT:
-        tag = 70;
-        break;
-      case IOComponentEnum::LONG:
-        tag = 75;
-        break;
-      case IOComponentEnum::ULONG:
-        tag = 71;
-        break;
-      case IOComponentEnum::LONGLONG:
-        tag = 75;
-        break;
-      case IOComponentEnum::ULONGLONG:
-        tag = 71;
-        break;
-      case IOComponentEnum::FLOAT:
-        tag = 85;
-        break;
-      case IOComponentEnum::DOUBLE:
-        tag = 86;
-        break;
-      default:
-        itkExceptionMacro("Unexpected component type");
+    for (unsigned int dim = 0; dim < ioRegion.GetImageDimension(); ++dim)
+    {
+      firstPiece = firstPiece && ioRegion.GetIndex(dim) == 0;
     }
-    cbor_item_t * dataTag = cbor_new_tag(tag);
-    cbor_tag_set_item(dataTag, cbor_move(dataItem));
-    cbor_map_add(index,
-      cbor_pair{
-        cbor_move(cbor_build_string("data")),
-        cbor_move(dataTag)});
   }
 
-  size_t cborBufferSize;
-  size_t length;
-  unsigned char * cborBuffer;
+  const std::string path = this->GetFileName();
+  std::ofstream outputStream;
+  this->OpenFileForWriting( outputStream, path, firstPiece, false );
+  if (firstPiece)
+  {
+    const std::string header = wasm::EncodeAlignedFileHeader(wasm::AlignedImageFileMagic, metadata.size());
+    outputStream.write(header.data(), header.size());
+    outputStream.write(metadata.data(), metadata.size());
+    const std::string padding(dataOffset - header.size() - metadata.size(), '\0');
+    outputStream.write(padding.data(), padding.size());
+  }
 
-  if (allocateCBORBuffer)
+  if (!this->RequestedToStream())
   {
-    length = cbor_serialize_alloc(index, cborBufferPtr, &cborBufferSize);
+    outputStream.write(static_cast< const char * >( buffer ), dataSize);
   }
   else
   {
-    length = cbor_serialize_alloc(index, &cborBuffer, &cborBufferSize);
-    FILE* file = fopen(this->GetFileName(), "wb");
-    fwrite(cborBuffer, 1, length, file);
-    free(cborBuffer);
-    fclose(file);
+    if (firstPiece && dataSize > 0)
+    {
+      // Allocate the file, sparse where supported, for the other pieces
+      outputStream.seekp(dataOffset + dataSize - 1);
+      outputStream.write("\0", 1);
+    }
+    auto bufferBytes = static_cast< const char * >( buffer );
+    this->ForEachIORegionRun([&](uint64_t offset, size_t runBytes) {
+      outputStream.seekp(dataOffset + offset);
+      outputStream.write(bufferBytes, runBytes);
+      bufferBytes += runBytes;
+    });
+  }
+  if (!outputStream)
+  {
+    itkExceptionMacro("Could not successfully write " << path);
   }
+}
 
-  cbor_decref(&index);
-  
-  return length;
+
+bool
+WasmImageIO
+::CanStreamRead()
+{
+  return !this->m_PayloadFilters.IsEnabled();
 }
 
 
@@ -494,6 +1896,8 @@ WasmImageIO
 ::ReadImageInformation()
 {
   this->SetByteOrderToLittleEndian();
+  this->m_PayloadFilters = wasm::PayloadFilters();
+  this->SelectBundleMember();
 
   const std::string path = this->GetFileName();
 
@@ -501,41 +1905,107 @@ WasmImageIO
   if ( ( cborPos != std::string::npos )
        && ( cborPos == path.length() - 5 ) )
   {
-    this->ReadCBOR(nullptr);
+    this->ReadCBORInformation();
+    return;
+  }
+
+  if (this->FileNameIsBundle())
+  {
+    if (this->m_BundleMember.encoding != "cbor")
+    {
+      itkExceptionMacro("The " << this->m_BundleMember.encoding << " bundle member " << this->m_BundleMember.name << " of " << path << " requires WasmZstdImageIO");
+    }
+    this->ReadCBORInformation();
+    return;
+  }
+
+  if (wasm::FileNameIsAligned(path, ".iwi.bin"))
+  {
+    this->ReadAlignedInformation();
     return;
   }
 
   rapidjson::Document document;
-  std::ifstream inputStream;
   const auto indexPath = path + "/index.json";
-  this->OpenFileForReading( inputStream, indexPath.c_str(), true );
-  std::string str((std::istreambuf_iterator<char>(inputStream)),
-                    std::istreambuf_iterator<char>());
-  if (document.Parse(str.c_str()).HasParseError())
+  std::vector< char > index;
+  if (!wasm::ReadRangeResource(indexPath, index))
+    {
+    itkExceptionMacro("Could not read file: " << indexPath);
+    }
+  if (document.Parse(index.data(), index.size()).HasParseError())
     {
     itkExceptionMacro("Could not parse JSON");
     return;
     }
   this->SetJSON(document);
 
+  this->m_ChunkSize.clear();
+  this->m_ChunkCompression = "none";
+  this->m_NumberOfLevels = 1;
+  this->m_ChunkCache.clear();
+  if (document.HasMember("chunks"))
+  {
+    const rapidjson::Value & chunks = document["chunks"];
+    const rapidjson::Value & chunkSize = chunks["chunkSize"];
+    for( rapidjson::Value::ConstValueIterator itr = chunkSize.Begin(); itr != chunkSize.End(); ++itr )
+    {
+      this->m_ChunkSize.push_back(itr->GetUint64());
+    }
+    if (this->m_ChunkSize.size() != this->GetNumberOfDimensions() ||
+        std::find(this->m_ChunkSize.begin(), this->m_ChunkSize.end(), 0) != this->m_ChunkSize.end())
+    {
+      itkExceptionMacro("Unexpected chunk size in " << indexPath);
+    }
+    if (chunks.HasMember("compression"))
+    {
+      this->m_ChunkCompression = chunks["compression"].GetString();
+    }
+    if (chunks.HasMember("levels"))
+    {
+      const rapidjson::Value & levels = chunks["levels"];
+      this->m_NumberOfLevels += levels.Size();
+      if (this->m_Level > 0 && this->m_Level < this->m_NumberOfLevels)
+      {
+        // The level replaces the grid of the full resolution image
+        const rapidjson::Value & level = levels[this->m_Level - 1];
+        for (rapidjson::SizeType ii = 0; ii < level["size"].Size(); ++ii)
+        {
+          this->SetOrigin(ii, level["origin"][ii].GetDouble());
+          this->SetSpacing(ii, level["spacing"][ii].GetDouble());
+          this->SetDimensions(ii, level["size"][ii].GetUint64());
+        }
+      }
+    }
+  }
+  if (this->m_Level >= this->m_NumberOfLevels)
+  {
+    itkExceptionMacro("Level " << this->m_Level << " not found in " << path);
+  }
+
   const unsigned int dimension = this->GetNumberOfDimensions();
   const auto dataPath = path + "/data";
   int count = 0;
 
   const auto directionPath = dataPath +  "/direction.raw";
-  std::ifstream directionStream;
-  this->OpenFileForReading( directionStream, directionPath.c_str(), false );
+  std::unique_ptr< wasm::RangeReader > directionReader = wasm::RangeReader::Open(directionPath);
+  std::vector< double > directionData( dimension * dimension );
+  if (!directionReader || !directionReader->Read(0, directionData.data(), directionData.size() * sizeof(double)))
+  {
+    itkExceptionMacro("Could not read file: " << directionPath);
+  }
   count = 0;
   for( unsigned int jj = 0; jj < dimension; ++jj )
   {
-    std::vector< double > direction( dimension );
-    for( unsigned int ii = 0; ii < dimension; ++ii )
-      {
-      directionStream.read(reinterpret_cast< char * >(&(direction[ii])), sizeof(double));
-      }
+    std::vector< double > direction( directionData.begin() + jj * dimension, directionData.begin() + ( jj + 1 ) * dimension );
     this->SetDirection( count, direction );
     ++count;
   }
+
+  if (this->m_ChunkSize.empty())
+  {
+    // Pixel data is paged in on access by Read
+    this->MapDataFile(dataPath + "/data.raw");
+  }
 }
 
 
@@ -553,18 +2023,77 @@ WasmImageIO
     return;
   }
 
-  const std::string dataFile = (path + "/data/data.raw").c_str();
+  if (this->FileNameIsBundle())
+  {
+    if (this->m_BundleMember.encoding != "cbor")
+    {
+      itkExceptionMacro("The " << this->m_BundleMember.encoding << " bundle member " << this->m_BundleMember.name << " of " << path << " requires WasmZstdImageIO");
+    }
+    this->ReadCBOR(buffer);
+    return;
+  }
+
+  if (wasm::FileNameIsAligned(path, ".iwi.bin"))
+  {
+    if (this->m_AlignedMetadata.empty())
+    {
+      this->ReadAlignedInformation();
+    }
+    // The metadata locates the pixel data
+    wasm::MemoryCBORSource source(this->m_AlignedMetadata.data(), this->m_AlignedMetadata.size());
+    this->ReadCBOR(buffer, source);
+    return;
+  }
+
+  if (!this->m_ChunkSize.empty())
+  {
+    this->ReadChunks(buffer);
+    return;
+  }
+
+  const std::string dataFile = path + "/data/data.raw";
+  if (this->MapDataFile(dataFile))
+  {
+    this->ReadMappedRegion(buffer);
+    return;
+  }
+
+  if (wasm::RangeReader::IsURL(dataFile))
+  {
+    // Fetch only the contiguous runs of the IORegion
+    std::unique_ptr< wasm::RangeReader > reader = wasm::RangeReader::Open(dataFile);
+    if (!reader)
+    {
+      itkExceptionMacro("Could not read file: " << dataFile);
+    }
+    auto bufferBytes = static_cast< char * >( buffer );
+    const auto readRun = [&](uint64_t offset, size_t runBytes) {
+      if (!reader->Read(offset, bufferBytes, runBytes))
+      {
+        itkExceptionMacro(<< "Read failed: " << dataFile << " is smaller than the image region");
+      }
+      bufferBytes += runBytes;
+    };
+    if (this->RequestedToStream())
+    {
+      this->ForEachIORegionRun(readRun);
+    }
+    else
+    {
+      readRun(0, static_cast< size_t >( this->GetImageSizeInBytes() ));
+    }
+    return;
+  }
+
   std::ifstream dataStream;
   this->OpenFileForReading( dataStream, dataFile.c_str() );
 
   if (this->RequestedToStream())
   {
-    this->OpenFileForReading( dataStream, dataFile.c_str() );
     this->StreamReadBufferAsBinary( dataStream, buffer );
   }
   else
   {
-    this->OpenFileForReading( dataStream, dataFile.c_str() );
     const SizeValueType numberOfBytesToBeRead =
       static_cast< SizeValueType >( this->GetImageSizeInBytes() );
     if ( !this->ReadBufferAsBinary( dataStream, buffer, numberOfBytesToBeRead ) )
@@ -641,6 +2170,13 @@ WasmImageIO
 
   document.AddMember( "imageType", imageType.Move(), allocator );
 
+  if (!this->m_IntensityStatistics.IsEmpty())
+    {
+    rapidjson::Value intensityStatistics;
+    wasm::ConvertIntensityStatisticsToJSON(this->m_IntensityStatistics, intensityStatistics, allocator);
+    document.AddMember( "intensityStatistics", intensityStatistics.Move(), allocator );
+    }
+
   rapidjson::Value origin(rapidjson::kArrayType);
   for( unsigned int ii = 0; ii < dimension; ++ii )
     {
@@ -662,7 +2198,7 @@ WasmImageIO
   rapidjson::Value size(rapidjson::kArrayType);
   for( unsigned int ii = 0; ii < dimension; ++ii )
     {
-    size.PushBack(rapidjson::Value().SetInt( this->GetDimensions( ii ) ), allocator);
+    size.PushBack(rapidjson::Value().SetUint64( this->GetDimensions( ii ) ), allocator);
     }
   document.AddMember( "size", size.Move(), allocator );
 
@@ -673,7 +2209,7 @@ WasmImageIO
 
   auto dictionary = this->GetMetaDataDictionary();
   rapidjson::Value metadataJson(rapidjson::kArrayType);
-  wasm::ConvertMetaDataDictionaryToJSON(dictionary, metadataJson, allocator);
+  wasm::ConvertMetaDataDictionaryToJSON(dictionary, metadataJson, allocator, m_MetaDataKeyFilter);
   document.AddMember( "metadata", metadataJson.Move(), allocator );
 
   return document;
@@ -686,7 +2222,7 @@ WasmImageIO
   const std::string path = this->GetFileName();
 
   std::string::size_type cborPos = path.rfind(".cbor");
-  if (cborPos != std::string::npos)
+  if (cborPos != std::string::npos || wasm::FileNameIsAligned(path, ".iwi.bin") || this->FileNameIsBundle())
   {
     return;
   }
@@ -703,6 +2239,37 @@ WasmImageIO
     }
 
   rapidjson::Document document = this->GetJSON();
+  if (!this->m_ChunkSize.empty())
+  {
+    const auto chunksPath = dataPath + "/chunks";
+    if ( !itksys::SystemTools::FileExists(chunksPath, false) )
+      {
+        itksys::SystemTools::MakeDirectory(chunksPath);
+      }
+    if (this->m_Level > 0)
+    {
+      // Levels are added to the index of the full resolution image
+      rapidjson::Document index;
+      std::ifstream inputStream;
+      this->OpenFileForReading( inputStream, indexPath.c_str(), true );
+      std::string str((std::istreambuf_iterator<char>(inputStream)),
+                        std::istreambuf_iterator<char>());
+      inputStream.close();
+      if (index.Parse(str.c_str()).HasParseError())
+        {
+        itkExceptionMacro("Could not parse JSON");
+        }
+      this->SetChunkLevelJSON(index);
+
+      std::ofstream outputStream;
+      this->OpenFileForWriting( outputStream, indexPath.c_str(), true, true );
+      rapidjson::OStreamWrapper ostreamWrapper( outputStream );
+      rapidjson::PrettyWriter< rapidjson::OStreamWrapper > writer( ostreamWrapper );
+      index.Accept( writer );
+      return;
+    }
+    this->SetChunksJSON(document);
+  }
   const unsigned int dimension = this->GetNumberOfDimensions();
 
   const auto directionPath = dataPath + "/direction.raw";
@@ -734,13 +2301,50 @@ void
 WasmImageIO
 ::Write( const void *buffer )
 {
+  // Do not read through a mapping of a data file that is rewritten
+  this->UnmapDataFile();
+
   const std::string path(this->GetFileName());
 
   std::string::size_type cborPos = path.rfind(".cbor");
   if ( ( cborPos != std::string::npos )
        && ( cborPos == path.length() - 5 ) )
   {
-    this->WriteCBOR(buffer);
+    if (this->RequestedToStream())
+    {
+      this->WriteCBORRegion(buffer);
+    }
+    else
+    {
+      this->WriteCBOR(buffer);
+    }
+    return;
+  }
+
+  if (wasm::FileNameIsAligned(path, ".iwi.bin"))
+  {
+    this->WriteAligned(buffer);
+    return;
+  }
+
+  if (this->FileNameIsBundle())
+  {
+    this->WriteBundleMember(buffer);
+    return;
+  }
+
+  // Stored in index.json
+  this->UpdateIntensityStatistics(buffer);
+
+  if (!this->m_ChunkSize.empty())
+  {
+    // Streamed writes after the first only update their chunks
+    const std::string levelPath = path + "/data/chunks/" + std::to_string(this->m_Level);
+    if (!this->RequestedToStream() || !itksys::SystemTools::FileExists(levelPath, false))
+    {
+      this->WriteImageInformation();
+    }
+    this->WriteChunks(buffer);
     return;
   }
 
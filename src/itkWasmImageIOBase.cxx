@@ -40,7 +40,10 @@ WasmImageIOBase::SetImageIO(ImageIOBase * imageIO, bool readImage)
     return;
   }
 
-  imageIO->ReadImageInformation();
+  if (!this->m_ImageInformationRead)
+  {
+    imageIO->ReadImageInformation();
+  }
   auto wasmImageIO = itk::WasmImageIO::New();
 
   const unsigned int dimension = imageIO->GetNumberOfDimensions();
@@ -83,10 +86,14 @@ WasmImageIOBase::SetImageIO(ImageIOBase * imageIO, bool readImage)
     ioRegion.SetSize(dim, imageIO->GetDimensions( dim ));
     }
   imageIO->SetIORegion( ioRegion );
-  this->m_PixelDataContainer->resize( imageIO->GetImageSizeInBytes() );
-  imageIO->Read( reinterpret_cast< void * >( &(this->m_PixelDataContainer->at(0)) ));
+  size_t pixelDataAddress = 0;
+  if (this->m_ReadPixelData)
+  {
+    this->m_PixelDataContainer->resize( imageIO->GetImageSizeInBytes() );
+    imageIO->Read( reinterpret_cast< void * >( &(this->m_PixelDataContainer->at(0)) ));
+    pixelDataAddress = reinterpret_cast< size_t >( &(this->m_PixelDataContainer->at(0)) );
+  }
 
-  const auto pixelDataAddress = reinterpret_cast< size_t >( &(this->m_PixelDataContainer->at(0)) );
   std::ostringstream dataStream;
   dataStream << "data:application/vnd.itk.address,0:";
   dataStream << pixelDataAddress;
@@ -106,6 +113,8 @@ WasmImageIOBase::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
 
+  os << indent << "ReadPixelData: " << (m_ReadPixelData ? "On" : "Off") << std::endl;
+  os << indent << "ImageInformationRead: " << (m_ImageInformationRead ? "On" : "Off") << std::endl;
   os << indent << "DirectionContainer";
   this->m_DirectionContainer->Print(os, indent);
   os << indent << "PixelDataContainer";
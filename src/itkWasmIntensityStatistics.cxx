@@ -0,0 +1,478 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmIntensityStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+
+// Pixels below which an image is not split into more chunks
+constexpr uint64_t MinimumChunkPixels = 64 * 1024;
+
+struct ComponentRange
+{
+  double minimum{ std::numeric_limits<double>::infinity() };
+  double maximum{ -std::numeric_limits<double>::infinity() };
+  double sum{ 0.0 };
+  uint64_t count{ 0 };
+};
+
+SizeValueType
+GetNumberOfChunks(MultiThreaderBase * threader, uint64_t numberOfPixels)
+{
+  const uint64_t chunks = std::min<uint64_t>(threader->GetNumberOfWorkUnits(),
+                                             (numberOfPixels + MinimumChunkPixels - 1) / MinimumChunkPixels);
+  return static_cast<SizeValueType>(std::max<uint64_t>(chunks, 1));
+}
+
+// Bins per unit of intensity, 0 when the range is empty
+double
+GetBinScale(const ComponentStatistics & component, unsigned int bins)
+{
+  const double range = component.maximum - component.minimum;
+  return range > 0.0 ? bins / range : 0.0;
+}
+
+size_t
+GetBin(double value, double minimum, double scale, unsigned int bins)
+{
+  return std::min<size_t>(static_cast<size_t>((value - minimum) * scale), bins - 1);
+}
+
+void
+SetRange(ComponentStatistics & component, const ComponentRange & range, unsigned int bins)
+{
+  if (range.count > 0)
+  {
+    component.minimum = range.minimum;
+    component.maximum = range.maximum;
+    component.mean = range.sum / static_cast<double>(range.count);
+  }
+  component.histogram.assign(bins, 0);
+}
+
+// 8 and 16 bit components are counted by value, and the statistics follow
+// from the counts without a second pass
+template <typename TComponent>
+IntensityStatistics
+ComputeStatisticsByValue(const TComponent * buffer,
+                         unsigned int numberOfComponents,
+                         uint64_t numberOfPixels,
+                         unsigned int bins,
+                         MultiThreaderBase * threader)
+{
+  constexpr size_t numberOfValues = size_t{ 1 } << (8 * sizeof(TComponent));
+  constexpr int lowest = std::numeric_limits<TComponent>::lowest();
+
+  const SizeValueType numberOfChunks = GetNumberOfChunks(threader, numberOfPixels);
+  const uint64_t chunkPixels = (numberOfPixels + numberOfChunks - 1) / numberOfChunks;
+  std::vector<std::vector<uint64_t>> chunkCounts(numberOfChunks);
+  threader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      std::vector<uint64_t> & counts = chunkCounts[chunk];
+      counts.assign(numberOfValues * numberOfComponents, 0);
+      const uint64_t begin = std::min<uint64_t>(chunk * chunkPixels, numberOfPixels);
+      const uint64_t end = std::min<uint64_t>(begin + chunkPixels, numberOfPixels);
+      const TComponent * pixel = buffer + begin * numberOfComponents;
+      for (uint64_t ii = begin; ii < end; ++ii, pixel += numberOfComponents)
+      {
+        for (unsigned int component = 0; component < numberOfComponents; ++component)
+        {
+          ++counts[component * numberOfValues + static_cast<size_t>(static_cast<int>(pixel[component]) - lowest)];
+        }
+      }
+    },
+    nullptr);
+  std::vector<uint64_t> & counts = chunkCounts[0];
+  for (SizeValueType chunk = 1; chunk < numberOfChunks; ++chunk)
+  {
+    std::transform(counts.begin(), counts.end(), chunkCounts[chunk].begin(), counts.begin(), std::plus<uint64_t>());
+  }
+
+  IntensityStatistics statistics;
+  statistics.components.resize(numberOfComponents);
+  for (unsigned int component = 0; component < numberOfComponents; ++component)
+  {
+    const uint64_t * componentCounts = counts.data() + component * numberOfValues;
+    ComponentRange range;
+    for (size_t value = 0; value < numberOfValues; ++value)
+    {
+      if (componentCounts[value] > 0)
+      {
+        const double intensity = static_cast<double>(static_cast<int>(value) + lowest);
+        range.minimum = std::min(range.minimum, intensity);
+        range.maximum = std::max(range.maximum, intensity);
+        range.sum += intensity * static_cast<double>(componentCounts[value]);
+        range.count += componentCounts[value];
+      }
+    }
+    ComponentStatistics & componentStatistics = statistics.components[component];
+    SetRange(componentStatistics, range, bins);
+    const double scale = GetBinScale(componentStatistics, bins);
+    for (size_t value = 0; value < numberOfValues; ++value)
+    {
+      if (componentCounts[value] > 0)
+      {
+        const double intensity = static_cast<double>(static_cast<int>(value) + lowest);
+        componentStatistics.histogram[GetBin(intensity, componentStatistics.minimum, scale, bins)] +=
+          componentCounts[value];
+      }
+    }
+  }
+  return statistics;
+}
+
+// Wider components take a pass for the range and a pass for the histogram
+template <typename TComponent>
+IntensityStatistics
+ComputeStatisticsByRange(const TComponent * buffer,
+                         unsigned int numberOfComponents,
+                         uint64_t numberOfPixels,
+                         unsigned int bins,
+                         MultiThreaderBase * threader)
+{
+  const SizeValueType numberOfChunks = GetNumberOfChunks(threader, numberOfPixels);
+  const uint64_t chunkPixels = (numberOfPixels + numberOfChunks - 1) / numberOfChunks;
+  const auto chunkBounds = [&](SizeValueType chunk, uint64_t & begin, uint64_t & end) {
+    begin = std::min<uint64_t>(chunk * chunkPixels, numberOfPixels);
+    end = std::min<uint64_t>(begin + chunkPixels, numberOfPixels);
+  };
+
+  std::vector<ComponentRange> chunkRanges(numberOfChunks * numberOfComponents);
+  threader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      uint64_t begin = 0;
+      uint64_t end = 0;
+      chunkBounds(chunk, begin, end);
+      for (unsigned int component = 0; component < numberOfComponents; ++component)
+      {
+        ComponentRange & range = chunkRanges[chunk * numberOfComponents + component];
+        const TComponent * value = buffer + begin * numberOfComponents + component;
+        if constexpr (std::is_floating_point_v<TComponent>)
+        {
+          for (uint64_t ii = begin; ii < end; ++ii, value += numberOfComponents)
+          {
+            if (std::isfinite(*value))
+            {
+              range.minimum = std::min<double>(range.minimum, *value);
+              range.maximum = std::max<double>(range.maximum, *value);
+              range.sum += *value;
+              ++range.count;
+            }
+          }
+        }
+        else if (begin < end)
+        {
+          TComponent minimum = std::numeric_limits<TComponent>::max();
+          TComponent maximum = std::numeric_limits<TComponent>::lowest();
+          double sum = 0.0;
+          for (uint64_t ii = begin; ii < end; ++ii, value += numberOfComponents)
+          {
+            minimum = std::min(minimum, *value);
+            maximum = std::max(maximum, *value);
+            sum += static_cast<double>(*value);
+          }
+          range.minimum = static_cast<double>(minimum);
+          range.maximum = static_cast<double>(maximum);
+          range.sum = sum;
+          range.count = end - begin;
+        }
+      }
+    },
+    nullptr);
+
+  IntensityStatistics statistics;
+  statistics.components.resize(numberOfComponents);
+  for (unsigned int component = 0; component < numberOfComponents; ++component)
+  {
+    ComponentRange range;
+    for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      const ComponentRange & chunkRange = chunkRanges[chunk * numberOfComponents + component];
+      range.minimum = std::min(range.minimum, chunkRange.minimum);
+      range.maximum = std::max(range.maximum, chunkRange.maximum);
+      range.sum += chunkRange.sum;
+      range.count += chunkRange.count;
+    }
+    SetRange(statistics.components[component], range, bins);
+  }
+
+  std::vector<std::vector<uint64_t>> chunkHistograms(numberOfChunks);
+  threader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      uint64_t begin = 0;
+      uint64_t end = 0;
+      chunkBounds(chunk, begin, end);
+      std::vector<uint64_t> & histograms = chunkHistograms[chunk];
+      histograms.assign(static_cast<size_t>(bins) * numberOfComponents, 0);
+      for (unsigned int component = 0; component < numberOfComponents; ++component)
+      {
+        const ComponentStatistics & componentStatistics = statistics.components[component];
+        const double minimum = componentStatistics.minimum;
+        const double scale = GetBinScale(componentStatistics, bins);
+        uint64_t * histogram = histograms.data() + static_cast<size_t>(component) * bins;
+        const TComponent * value = buffer + begin * numberOfComponents + component;
+        for (uint64_t ii = begin; ii < end; ++ii, value += numberOfComponents)
+        {
+          if constexpr (std::is_floating_point_v<TComponent>)
+          {
+            if (!std::isfinite(*value))
+            {
+              continue;
+            }
+          }
+          ++histogram[GetBin(static_cast<double>(*value), minimum, scale, bins)];
+        }
+      }
+    },
+    nullptr);
+  for (unsigned int component = 0; component < numberOfComponents; ++component)
+  {
+    std::vector<uint64_t> & histogram = statistics.components[component].histogram;
+    for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      const uint64_t * chunkHistogram = chunkHistograms[chunk].data() + static_cast<size_t>(component) * bins;
+      for (unsigned int bin = 0; bin < bins; ++bin)
+      {
+        histogram[bin] += chunkHistogram[bin];
+      }
+    }
+  }
+  return statistics;
+}
+
+double
+ReadCBORNumber(const cbor_item_t * item)
+{
+  if (cbor_isa_float_ctrl(item) && cbor_float_get_width(item) != CBOR_FLOAT_0)
+  {
+    return cbor_float_get_float(item);
+  }
+  if (cbor_isa_uint(item))
+  {
+    return static_cast<double>(cbor_get_int(item));
+  }
+  if (cbor_isa_negint(item))
+  {
+    return -1.0 - static_cast<double>(cbor_get_int(item));
+  }
+  throw std::runtime_error("Expected an intensityStatistics number");
+}
+
+} // end anonymous namespace
+
+IntensityStatistics
+ComputeIntensityStatistics(IOComponentEnum componentType,
+                           const void * buffer,
+                           unsigned int numberOfComponents,
+                           uint64_t numberOfPixels,
+                           unsigned int bins,
+                           MultiThreaderBase * threader)
+{
+  if (bins == 0)
+  {
+    throw std::runtime_error("The intensity histogram needs at least one bin");
+  }
+  MultiThreaderBase::Pointer defaultThreader;
+  if (threader == nullptr)
+  {
+    defaultThreader = MultiThreaderBase::New();
+    threader = defaultThreader.GetPointer();
+  }
+
+  switch (componentType)
+  {
+    case IOComponentEnum::UCHAR:
+      return ComputeStatisticsByValue(static_cast<const uint8_t *>(buffer), numberOfComponents, numberOfPixels, bins, threader);
+    case IOComponentEnum::CHAR:
+      return ComputeStatisticsByValue(static_cast<const int8_t *>(buffer), numberOfComponents, numberOfPixels, bins, threader);
+    case IOComponentEnum::USHORT:
+      return ComputeStatisticsByValue(static_cast<const uint16_t *>(buffer), numberOfComponents, numberOfPixels, bins, threader);
+    case IOComponentEnum::SHORT:
+      return ComputeStatisticsByValue(static_cast<const int16_t *>(buffer), numberOfComponents, numberOfPixels, bins, threader);
+    case IOComponentEnum::UINT:
+      return ComputeStatisticsByRange(static_cast<const uint32_t *>(buffer), numberOfComponents, numberOfPixels, bins, threader);
+    case IOComponentEnum::INT:
+      return ComputeStatisticsByRange(static_cast<const int32_t *>(buffer), numberOfComponents, numberOfPixels, bins, threader);
+    case IOComponentEnum::ULONG:
+    case IOComponentEnum::ULONGLONG:
+      return ComputeStatisticsByRange(static_cast<const uint64_t *>(buffer), numberOfComponents, numberOfPixels, bins, threader);
+    case IOComponentEnum::LONG:
+    case IOComponentEnum::LONGLONG:
+      return ComputeStatisticsByRange(static_cast<const int64_t *>(buffer), numberOfComponents, numberOfPixels, bins, threader);
+    case IOComponentEnum::FLOAT:
+      return ComputeStatisticsByRange(static_cast<const float *>(buffer), numberOfComponents, numberOfPixels, bins, threader);
+    case IOComponentEnum::DOUBLE:
+      return ComputeStatisticsByRange(static_cast<const double *>(buffer), numberOfComponents, numberOfPixels, bins, threader);
+    default:
+      throw std::runtime_error("Unexpected component type for intensity statistics");
+  }
+}
+
+void
+WriteIntensityStatistics(CBORSink & sink, const IntensityStatistics & statistics)
+{
+  sink.WriteArray(statistics.components.size());
+  for (const ComponentStatistics & component : statistics.components)
+  {
+    sink.WriteMap(4);
+    sink.WriteString("minimum");
+    sink.WriteDouble(component.minimum);
+    sink.WriteString("maximum");
+    sink.WriteDouble(component.maximum);
+    sink.WriteString("mean");
+    sink.WriteDouble(component.mean);
+    sink.WriteString("histogram");
+    sink.WriteArray(component.histogram.size());
+    for (const uint64_t count : component.histogram)
+    {
+      sink.WriteUInt(count);
+    }
+  }
+}
+
+IntensityStatistics
+ReadIntensityStatistics(const cbor_item_t * item)
+{
+  if (!cbor_isa_array(item))
+  {
+    throw std::runtime_error("Expected an intensityStatistics cbor array");
+  }
+  IntensityStatistics statistics;
+  const size_t numberOfComponents = cbor_array_size(item);
+  cbor_item_t ** componentHandle = cbor_array_handle(item);
+  statistics.components.resize(numberOfComponents);
+  for (size_t ii = 0; ii < numberOfComponents; ++ii)
+  {
+    if (!cbor_isa_map(componentHandle[ii]))
+    {
+      throw std::runtime_error("Expected an intensityStatistics component cbor map");
+    }
+    ComponentStatistics & component = statistics.components[ii];
+    const size_t count = cbor_map_size(componentHandle[ii]);
+    const struct cbor_pair * handle = cbor_map_handle(componentHandle[ii]);
+    for (size_t jj = 0; jj < count; ++jj)
+    {
+      const std::string_view key(reinterpret_cast<char *>(cbor_string_handle(handle[jj].key)), cbor_string_length(handle[jj].key));
+      if (key == "minimum")
+      {
+        component.minimum = ReadCBORNumber(handle[jj].value);
+      }
+      else if (key == "maximum")
+      {
+        component.maximum = ReadCBORNumber(handle[jj].value);
+      }
+      else if (key == "mean")
+      {
+        component.mean = ReadCBORNumber(handle[jj].value);
+      }
+      else if (key == "histogram")
+      {
+        if (!cbor_isa_array(handle[jj].value))
+        {
+          throw std::runtime_error("Expected an intensityStatistics histogram cbor array");
+        }
+        const size_t bins = cbor_array_size(handle[jj].value);
+        cbor_item_t ** binHandle = cbor_array_handle(handle[jj].value);
+        component.histogram.resize(bins);
+        for (size_t bin = 0; bin < bins; ++bin)
+        {
+          component.histogram[bin] = cbor_get_int(binHandle[bin]);
+        }
+      }
+      else
+      {
+        throw std::runtime_error("Unexpected intensityStatistics key: " + std::string(key));
+      }
+    }
+  }
+  return statistics;
+}
+
+void
+ConvertIntensityStatisticsToJSON(const IntensityStatistics & statistics,
+                                 rapidjson::Value & statisticsJson,
+                                 rapidjson::Document::AllocatorType & allocator)
+{
+  statisticsJson.SetArray();
+  for (const ComponentStatistics & component : statistics.components)
+  {
+    rapidjson::Value componentJson(rapidjson::kObjectType);
+    componentJson.AddMember("minimum", rapidjson::Value(component.minimum).Move(), allocator);
+    componentJson.AddMember("maximum", rapidjson::Value(component.maximum).Move(), allocator);
+    componentJson.AddMember("mean", rapidjson::Value(component.mean).Move(), allocator);
+    rapidjson::Value histogram(rapidjson::kArrayType);
+    for (const uint64_t count : component.histogram)
+    {
+      histogram.PushBack(rapidjson::Value().SetUint64(count), allocator);
+    }
+    componentJson.AddMember("histogram", histogram.Move(), allocator);
+    statisticsJson.PushBack(componentJson.Move(), allocator);
+  }
+}
+
+IntensityStatistics
+ConvertJSONToIntensityStatistics(const rapidjson::Value & statisticsJson)
+{
+  if (!statisticsJson.IsArray())
+  {
+    throw std::runtime_error("Expected an intensityStatistics JSON array");
+  }
+  IntensityStatistics statistics;
+  for (rapidjson::Value::ConstValueIterator itr = statisticsJson.Begin(); itr != statisticsJson.End(); ++itr)
+  {
+    if (!itr->IsObject() || !itr->HasMember("minimum") || !itr->HasMember("maximum") || !itr->HasMember("mean") ||
+        !itr->HasMember("histogram") || !(*itr)["histogram"].IsArray())
+    {
+      throw std::runtime_error("Unexpected intensityStatistics JSON component");
+    }
+    ComponentStatistics component;
+    component.minimum = (*itr)["minimum"].GetDouble();
+    component.maximum = (*itr)["maximum"].GetDouble();
+    component.mean = (*itr)["mean"].GetDouble();
+    const rapidjson::Value & histogram = (*itr)["histogram"];
+    for (rapidjson::Value::ConstValueIterator bin = histogram.Begin(); bin != histogram.End(); ++bin)
+    {
+      component.histogram.push_back(bin->GetUint64());
+    }
+    statistics.components.push_back(std::move(component));
+  }
+  return statistics;
+}
+
+} // end namespace wasm
+} // end namespace itk
@@ -0,0 +1,727 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmMeshChunks.h"
+#include "itkWasmMeshIO.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+
+constexpr uint64_t None = std::numeric_limits<uint64_t>::max();
+// Leaves are not split further, e.g. when their centroids coincide
+constexpr unsigned int MaximumDepth = 20;
+// Grid cells per axis of the clustering keys, 3 * 21 bits
+constexpr uint64_t MaximumResolution = uint64_t{ 1 } << 21;
+
+template <typename TVisitor>
+void
+VisitComponentType(IOComponentEnum componentType, TVisitor && visitor)
+{
+  switch (componentType)
+  {
+    case IOComponentEnum::UCHAR:
+      visitor(static_cast<unsigned char *>(nullptr));
+      break;
+    case IOComponentEnum::CHAR:
+      visitor(static_cast<signed char *>(nullptr));
+      break;
+    case IOComponentEnum::USHORT:
+      visitor(static_cast<unsigned short *>(nullptr));
+      break;
+    case IOComponentEnum::SHORT:
+      visitor(static_cast<short *>(nullptr));
+      break;
+    case IOComponentEnum::UINT:
+      visitor(static_cast<unsigned int *>(nullptr));
+      break;
+    case IOComponentEnum::INT:
+      visitor(static_cast<int *>(nullptr));
+      break;
+    case IOComponentEnum::ULONG:
+      visitor(static_cast<unsigned long *>(nullptr));
+      break;
+    case IOComponentEnum::LONG:
+      visitor(static_cast<long *>(nullptr));
+      break;
+    case IOComponentEnum::ULONGLONG:
+      visitor(static_cast<unsigned long long *>(nullptr));
+      break;
+    case IOComponentEnum::LONGLONG:
+      visitor(static_cast<long long *>(nullptr));
+      break;
+    case IOComponentEnum::FLOAT:
+      visitor(static_cast<float *>(nullptr));
+      break;
+    case IOComponentEnum::DOUBLE:
+      visitor(static_cast<double *>(nullptr));
+      break;
+    default:
+      throw std::runtime_error("Unexpected point component type");
+  }
+}
+
+std::vector<double>
+DecodeCoordinates(IOComponentEnum componentType, const char * points, uint64_t numberOfComponents)
+{
+  std::vector<double> coordinates(numberOfComponents);
+  VisitComponentType(componentType, [&](auto * tag) {
+    using ComponentType = std::remove_pointer_t<decltype(tag)>;
+    for (uint64_t ii = 0; ii < numberOfComponents; ++ii)
+    {
+      ComponentType component;
+      std::memcpy(&component, points + ii * sizeof(ComponentType), sizeof(ComponentType));
+      coordinates[ii] = static_cast<double>(component);
+    }
+  });
+  return coordinates;
+}
+
+std::vector<char>
+EncodeCoordinates(IOComponentEnum componentType, const std::vector<double> & coordinates)
+{
+  std::vector<char> points;
+  VisitComponentType(componentType, [&](auto * tag) {
+    using ComponentType = std::remove_pointer_t<decltype(tag)>;
+    points.resize(coordinates.size() * sizeof(ComponentType));
+    for (size_t ii = 0; ii < coordinates.size(); ++ii)
+    {
+      ComponentType component;
+      if constexpr (std::is_integral_v<ComponentType>)
+      {
+        component = static_cast<ComponentType>(std::llround(coordinates[ii]));
+      }
+      else
+      {
+        component = static_cast<ComponentType>(coordinates[ii]);
+      }
+      std::memcpy(points.data() + ii * sizeof(ComponentType), &component, sizeof(ComponentType));
+    }
+  });
+  return points;
+}
+
+// Offsets of the cell entries, [type, number of points, point ids...], and
+// of the end of the last one
+template <typename TId>
+std::vector<uint64_t>
+IndexCells(const TId * cells, uint64_t bufferSize, uint64_t numberOfCells, uint64_t numberOfPoints)
+{
+  std::vector<uint64_t> offsets;
+  offsets.reserve(numberOfCells + 1);
+  uint64_t offset = 0;
+  while (offsets.size() < numberOfCells)
+  {
+    if (bufferSize - offset < 2 || cells[offset + 1] > bufferSize - offset - 2)
+    {
+      throw std::runtime_error("Truncated cell buffer");
+    }
+    offsets.push_back(offset);
+    const uint64_t cellPoints = cells[offset + 1];
+    for (uint64_t ii = 0; ii < cellPoints; ++ii)
+    {
+      if (cells[offset + 2 + ii] >= numberOfPoints)
+      {
+        throw std::runtime_error("Cell point id out of range");
+      }
+    }
+    offset += 2 + cellPoints;
+  }
+  offsets.push_back(offset);
+  return offsets;
+}
+
+struct MeshLayout
+{
+  unsigned int    dimension{ 0 };
+  IOComponentEnum pointComponentType{ IOComponentEnum::UNKNOWNCOMPONENTTYPE };
+  size_t          pointSize{ 0 };
+  size_t          pointPixelSize{ 0 };
+  size_t          cellPixelSize{ 0 };
+};
+
+// The buffers of the full resolution, or of a clustered level. The point
+// data and cell data are nullptr when they are dropped.
+template <typename TId>
+struct LevelMesh
+{
+  uint64_t                numberOfPoints{ 0 };
+  const double *          coordinates{ nullptr };
+  const char *            points{ nullptr };
+  const TId *             cells{ nullptr };
+  std::vector<uint64_t>   offsets;
+  const char *            pointData{ nullptr };
+  const char *            cellData{ nullptr };
+  /** Whether the mesh is partitioned by its cells, rather than its points. */
+  bool                    byCells{ false };
+
+  uint64_t
+  GetNumberOfCells() const
+  {
+    return this->offsets.empty() ? 0 : this->offsets.size() - 1;
+  }
+};
+
+// The buffers a clustered level points to
+template <typename TId>
+struct LevelBuffers
+{
+  std::vector<double> coordinates;
+  std::vector<char>   points;
+  std::vector<TId>    cells;
+  std::vector<char>   pointData;
+  std::vector<char>   cellData;
+};
+
+template <typename TId>
+MeshChunk
+BuildChunk(const LevelMesh<TId> &        mesh,
+           const MeshLayout &            layout,
+           uint32_t                      level,
+           uint64_t                      index,
+           const std::vector<uint64_t> & items,
+           std::vector<uint64_t> &       localIds)
+{
+  MeshChunk chunk;
+  chunk.name = std::to_string(level) + "/" + std::to_string(index);
+  chunk.level = level;
+
+  // The points in the order the cells first use them
+  std::vector<uint64_t> chunkPoints;
+  if (mesh.byCells)
+  {
+    std::vector<TId> cells;
+    for (const uint64_t cell : items)
+    {
+      cells.push_back(mesh.cells[mesh.offsets[cell]]);
+      cells.push_back(mesh.cells[mesh.offsets[cell] + 1]);
+      for (uint64_t ii = mesh.offsets[cell] + 2; ii < mesh.offsets[cell + 1]; ++ii)
+      {
+        const uint64_t point = mesh.cells[ii];
+        if (localIds[point] == None)
+        {
+          localIds[point] = chunkPoints.size();
+          chunkPoints.push_back(point);
+        }
+        cells.push_back(static_cast<TId>(localIds[point]));
+      }
+      if (mesh.cellData != nullptr)
+      {
+        const char * pixel = mesh.cellData + cell * layout.cellPixelSize;
+        chunk.cellData.insert(chunk.cellData.end(), pixel, pixel + layout.cellPixelSize);
+      }
+    }
+    for (const uint64_t point : chunkPoints)
+    {
+      localIds[point] = None;
+    }
+    chunk.numberOfCells = items.size();
+    chunk.cellBufferSize = cells.size();
+    chunk.numberOfCellPixels = mesh.cellData != nullptr ? items.size() : 0;
+    chunk.cells.resize(cells.size() * sizeof(TId));
+    std::memcpy(chunk.cells.data(), cells.data(), chunk.cells.size());
+  }
+  else
+  {
+    chunkPoints = items;
+  }
+
+  chunk.numberOfPoints = chunkPoints.size();
+  chunk.numberOfPointPixels = mesh.pointData != nullptr ? chunkPoints.size() : 0;
+  chunk.points.resize(chunkPoints.size() * layout.pointSize);
+  if (mesh.pointData != nullptr)
+  {
+    chunk.pointData.resize(chunkPoints.size() * layout.pointPixelSize);
+  }
+  chunk.bounds.resize(2 * layout.dimension);
+  std::fill(chunk.bounds.begin(), chunk.bounds.begin() + layout.dimension, std::numeric_limits<double>::max());
+  std::fill(chunk.bounds.begin() + layout.dimension, chunk.bounds.end(), std::numeric_limits<double>::lowest());
+  for (size_t ii = 0; ii < chunkPoints.size(); ++ii)
+  {
+    const uint64_t point = chunkPoints[ii];
+    std::memcpy(chunk.points.data() + ii * layout.pointSize, mesh.points + point * layout.pointSize, layout.pointSize);
+    if (mesh.pointData != nullptr)
+    {
+      std::memcpy(chunk.pointData.data() + ii * layout.pointPixelSize,
+                  mesh.pointData + point * layout.pointPixelSize,
+                  layout.pointPixelSize);
+    }
+    for (unsigned int dd = 0; dd < layout.dimension; ++dd)
+    {
+      const double coordinate = mesh.coordinates[point * layout.dimension + dd];
+      chunk.bounds[dd] = std::min(chunk.bounds[dd], coordinate);
+      chunk.bounds[layout.dimension + dd] = std::max(chunk.bounds[layout.dimension + dd], coordinate);
+    }
+  }
+  return chunk;
+}
+
+template <typename TId>
+void
+PartitionLevel(const LevelMesh<TId> & mesh,
+               const MeshLayout &     layout,
+               uint32_t               level,
+               uint64_t               maximumPointsPerChunk,
+               std::vector<MeshChunk> & chunks)
+{
+  const uint64_t numberOfItems = mesh.byCells ? mesh.GetNumberOfCells() : mesh.numberOfPoints;
+  if (numberOfItems == 0)
+  {
+    return;
+  }
+  const unsigned int axes = std::min(layout.dimension, 3u);
+
+  // The cells are placed by the mean of their points
+  std::vector<double> centroids(numberOfItems * axes, 0.0);
+  for (uint64_t item = 0; item < numberOfItems; ++item)
+  {
+    double * centroid = centroids.data() + item * axes;
+    if (!mesh.byCells)
+    {
+      for (unsigned int dd = 0; dd < axes; ++dd)
+      {
+        centroid[dd] = mesh.coordinates[item * layout.dimension + dd];
+      }
+      continue;
+    }
+    const uint64_t begin = mesh.offsets[item] + 2;
+    const uint64_t end = mesh.offsets[item + 1];
+    for (uint64_t ii = begin; ii < end; ++ii)
+    {
+      for (unsigned int dd = 0; dd < axes; ++dd)
+      {
+        centroid[dd] += mesh.coordinates[mesh.cells[ii] * layout.dimension + dd];
+      }
+    }
+    for (unsigned int dd = 0; end > begin && dd < axes; ++dd)
+    {
+      centroid[dd] /= static_cast<double>(end - begin);
+    }
+  }
+
+  struct Node
+  {
+    std::vector<uint64_t> items;
+    double                minimum[3];
+    double                maximum[3];
+    unsigned int          depth{ 0 };
+  };
+  Node root;
+  root.items.resize(numberOfItems);
+  for (uint64_t item = 0; item < numberOfItems; ++item)
+  {
+    root.items[item] = item;
+  }
+  for (unsigned int dd = 0; dd < axes; ++dd)
+  {
+    root.minimum[dd] = std::numeric_limits<double>::max();
+    root.maximum[dd] = std::numeric_limits<double>::lowest();
+    for (uint64_t item = 0; item < numberOfItems; ++item)
+    {
+      root.minimum[dd] = std::min(root.minimum[dd], centroids[item * axes + dd]);
+      root.maximum[dd] = std::max(root.maximum[dd], centroids[item * axes + dd]);
+    }
+  }
+
+  // Number of distinct points of the items of a node
+  std::vector<uint64_t> stamp(mesh.byCells ? mesh.numberOfPoints : 0, None);
+  uint64_t              stampValue = 0;
+  const auto pointsUsed = [&](const std::vector<uint64_t> & items) -> uint64_t {
+    if (!mesh.byCells)
+    {
+      return items.size();
+    }
+    const uint64_t value = stampValue++;
+    uint64_t       used = 0;
+    for (const uint64_t cell : items)
+    {
+      for (uint64_t ii = mesh.offsets[cell] + 2; ii < mesh.offsets[cell + 1]; ++ii)
+      {
+        if (stamp[mesh.cells[ii]] != value)
+        {
+          stamp[mesh.cells[ii]] = value;
+          ++used;
+        }
+      }
+    }
+    return used;
+  };
+
+  // Depth first, with the children in octant order, so the chunks of a
+  // level follow the octree
+  const uint64_t        levelBegin = chunks.size();
+  std::vector<uint64_t> localIds(mesh.byCells ? mesh.numberOfPoints : 0, None);
+  std::vector<Node>     stack;
+  stack.push_back(std::move(root));
+  const unsigned int octants = 1u << axes;
+  while (!stack.empty())
+  {
+    Node node = std::move(stack.back());
+    stack.pop_back();
+    if (node.items.size() > 1 && node.depth < MaximumDepth && pointsUsed(node.items) > maximumPointsPerChunk)
+    {
+      std::vector<Node> children(octants);
+      for (unsigned int octant = 0; octant < octants; ++octant)
+      {
+        children[octant].depth = node.depth + 1;
+        for (unsigned int dd = 0; dd < axes; ++dd)
+        {
+          const double center = 0.5 * (node.minimum[dd] + node.maximum[dd]);
+          const bool   upper = (octant >> dd) & 1;
+          children[octant].minimum[dd] = upper ? center : node.minimum[dd];
+          children[octant].maximum[dd] = upper ? node.maximum[dd] : center;
+        }
+      }
+      for (const uint64_t item : node.items)
+      {
+        unsigned int octant = 0;
+        for (unsigned int dd = 0; dd < axes; ++dd)
+        {
+          if (centroids[item * axes + dd] >= 0.5 * (node.minimum[dd] + node.maximum[dd]))
+          {
+            octant |= 1u << dd;
+          }
+        }
+        children[octant].items.push_back(item);
+      }
+      for (unsigned int octant = octants; octant-- > 0;)
+      {
+        if (!children[octant].items.empty())
+        {
+          stack.push_back(std::move(children[octant]));
+        }
+      }
+      continue;
+    }
+    chunks.push_back(BuildChunk(mesh, layout, level, chunks.size() - levelBegin, node.items, localIds));
+  }
+}
+
+// The points clustered on a grid with about a point per cell at level 0,
+// whose cells double in size with each level
+template <typename TId>
+LevelMesh<TId>
+ClusterPoints(const LevelMesh<TId> & mesh, const MeshLayout & layout, unsigned int level, LevelBuffers<TId> & buffers)
+{
+  const unsigned int axes = std::min(layout.dimension, 3u);
+  double             minimum[3] = { 0.0, 0.0, 0.0 };
+  double             extent[3] = { 0.0, 0.0, 0.0 };
+  unsigned int       extentAxes = 0;
+  for (unsigned int dd = 0; dd < axes; ++dd)
+  {
+    double maximum = std::numeric_limits<double>::lowest();
+    minimum[dd] = std::numeric_limits<double>::max();
+    for (uint64_t point = 0; point < mesh.numberOfPoints; ++point)
+    {
+      minimum[dd] = std::min(minimum[dd], mesh.coordinates[point * layout.dimension + dd]);
+      maximum = std::max(maximum, mesh.coordinates[point * layout.dimension + dd]);
+    }
+    extent[dd] = maximum - minimum[dd];
+    extentAxes += extent[dd] > 0.0 ? 1 : 0;
+  }
+  const double baseResolution =
+    extentAxes > 0 ? std::ceil(std::pow(static_cast<double>(mesh.numberOfPoints), 1.0 / extentAxes)) : 1.0;
+  const uint64_t resolution = std::clamp<uint64_t>(
+    static_cast<uint64_t>(baseResolution) >> std::min(level, 63u), 1, MaximumResolution);
+
+  std::unordered_map<uint64_t, uint64_t> clusterOfKey;
+  std::vector<uint64_t>                  clusterOf(mesh.numberOfPoints);
+  std::vector<uint64_t>                  clusterSize;
+  std::vector<uint64_t>                  firstPoint;
+  for (uint64_t point = 0; point < mesh.numberOfPoints; ++point)
+  {
+    uint64_t key = 0;
+    for (unsigned int dd = axes; dd-- > 0;)
+    {
+      uint64_t cell = 0;
+      if (extent[dd] > 0.0)
+      {
+        const double scaled = (mesh.coordinates[point * layout.dimension + dd] - minimum[dd]) / extent[dd];
+        cell = std::min(static_cast<uint64_t>(scaled * static_cast<double>(resolution)), resolution - 1);
+      }
+      key = key * resolution + cell;
+    }
+    const auto inserted = clusterOfKey.emplace(key, clusterSize.size());
+    if (inserted.second)
+    {
+      clusterSize.push_back(0);
+      firstPoint.push_back(point);
+      buffers.coordinates.resize(buffers.coordinates.size() + layout.dimension, 0.0);
+    }
+    const uint64_t cluster = inserted.first->second;
+    clusterOf[point] = cluster;
+    ++clusterSize[cluster];
+    for (unsigned int dd = 0; dd < layout.dimension; ++dd)
+    {
+      buffers.coordinates[cluster * layout.dimension + dd] += mesh.coordinates[point * layout.dimension + dd];
+    }
+  }
+  const uint64_t numberOfClusters = clusterSize.size();
+  for (uint64_t cluster = 0; cluster < numberOfClusters; ++cluster)
+  {
+    for (unsigned int dd = 0; dd < layout.dimension; ++dd)
+    {
+      buffers.coordinates[cluster * layout.dimension + dd] /= static_cast<double>(clusterSize[cluster]);
+    }
+  }
+  buffers.points = EncodeCoordinates(layout.pointComponentType, buffers.coordinates);
+  if (mesh.pointData != nullptr)
+  {
+    buffers.pointData.resize(numberOfClusters * layout.pointPixelSize);
+    for (uint64_t cluster = 0; cluster < numberOfClusters; ++cluster)
+    {
+      std::memcpy(buffers.pointData.data() + cluster * layout.pointPixelSize,
+                  mesh.pointData + firstPoint[cluster] * layout.pointPixelSize,
+                  layout.pointPixelSize);
+    }
+  }
+
+  LevelMesh<TId> clustered;
+  clustered.numberOfPoints = numberOfClusters;
+  clustered.byCells = mesh.byCells;
+  // Cells that still have distinct points
+  std::vector<uint64_t> stamp(numberOfClusters, None);
+  for (uint64_t cell = 0; cell < mesh.GetNumberOfCells(); ++cell)
+  {
+    bool distinct = true;
+    for (uint64_t ii = mesh.offsets[cell] + 2; distinct && ii < mesh.offsets[cell + 1]; ++ii)
+    {
+      const uint64_t cluster = clusterOf[mesh.cells[ii]];
+      distinct = stamp[cluster] != cell;
+      stamp[cluster] = cell;
+    }
+    if (!distinct)
+    {
+      continue;
+    }
+    clustered.offsets.push_back(buffers.cells.size());
+    buffers.cells.push_back(mesh.cells[mesh.offsets[cell]]);
+    buffers.cells.push_back(mesh.cells[mesh.offsets[cell] + 1]);
+    for (uint64_t ii = mesh.offsets[cell] + 2; ii < mesh.offsets[cell + 1]; ++ii)
+    {
+      buffers.cells.push_back(static_cast<TId>(clusterOf[mesh.cells[ii]]));
+    }
+    if (mesh.cellData != nullptr)
+    {
+      const char * pixel = mesh.cellData + cell * layout.cellPixelSize;
+      buffers.cellData.insert(buffers.cellData.end(), pixel, pixel + layout.cellPixelSize);
+    }
+  }
+  if (!clustered.offsets.empty())
+  {
+    clustered.offsets.push_back(buffers.cells.size());
+  }
+
+  clustered.coordinates = buffers.coordinates.data();
+  clustered.points = buffers.points.data();
+  clustered.cells = buffers.cells.data();
+  clustered.pointData = mesh.pointData != nullptr ? buffers.pointData.data() : nullptr;
+  clustered.cellData = mesh.cellData != nullptr ? buffers.cellData.data() : nullptr;
+  return clustered;
+}
+
+template <typename TId>
+std::vector<MeshChunk>
+PartitionMesh(const MeshIOBase *        meshIO,
+              const std::vector<char> & points,
+              const std::vector<char> & cells,
+              const std::vector<char> & pointData,
+              const std::vector<char> & cellData,
+              uint64_t                  maximumPointsPerChunk,
+              unsigned int              numberOfLevels)
+{
+  MeshLayout layout;
+  layout.dimension = meshIO->GetPointDimension();
+  layout.pointComponentType = meshIO->GetPointComponentType();
+  layout.pointSize = WasmMeshIO::ITKComponentSize(layout.pointComponentType) * layout.dimension;
+  layout.pointPixelSize =
+    WasmMeshIO::ITKComponentSize(meshIO->GetPointPixelComponentType()) * meshIO->GetNumberOfPointPixelComponents();
+  layout.cellPixelSize =
+    WasmMeshIO::ITKComponentSize(meshIO->GetCellPixelComponentType()) * meshIO->GetNumberOfCellPixelComponents();
+
+  LevelMesh<TId> mesh;
+  mesh.numberOfPoints = meshIO->GetNumberOfPoints();
+  if (layout.dimension == 0 || points.size() != mesh.numberOfPoints * layout.pointSize)
+  {
+    throw std::runtime_error("Unexpected points buffer size");
+  }
+  const uint64_t numberOfCells = meshIO->GetNumberOfCells();
+  mesh.cells = reinterpret_cast<const TId *>(cells.data());
+  if (numberOfCells > 0)
+  {
+    mesh.offsets = IndexCells(mesh.cells, cells.size() / sizeof(TId), numberOfCells, mesh.numberOfPoints);
+  }
+  mesh.byCells = numberOfCells > 0;
+  const std::vector<double> coordinates =
+    DecodeCoordinates(layout.pointComponentType, points.data(), mesh.numberOfPoints * layout.dimension);
+  mesh.coordinates = coordinates.data();
+  mesh.points = points.data();
+  if (layout.pointPixelSize > 0 && meshIO->GetNumberOfPointPixels() == mesh.numberOfPoints &&
+      pointData.size() == mesh.numberOfPoints * layout.pointPixelSize)
+  {
+    mesh.pointData = pointData.data();
+  }
+  if (layout.cellPixelSize > 0 && meshIO->GetNumberOfCellPixels() == numberOfCells &&
+      cellData.size() == numberOfCells * layout.cellPixelSize)
+  {
+    mesh.cellData = cellData.data();
+  }
+
+  maximumPointsPerChunk = std::max<uint64_t>(maximumPointsPerChunk, 1);
+  std::vector<MeshChunk> chunks;
+  PartitionLevel(mesh, layout, 0, maximumPointsPerChunk, chunks);
+  for (unsigned int level = 1; level <= numberOfLevels; ++level)
+  {
+    LevelBuffers<TId>    buffers;
+    const LevelMesh<TId> clustered = ClusterPoints(mesh, layout, level, buffers);
+    PartitionLevel(clustered, layout, level, maximumPointsPerChunk, chunks);
+  }
+  return chunks;
+}
+
+} // end anonymous namespace
+
+
+std::vector<MeshChunk>
+PartitionMesh(const MeshIOBase *        meshIO,
+              const std::vector<char> & points,
+              const std::vector<char> & cells,
+              const std::vector<char> & pointData,
+              const std::vector<char> & cellData,
+              uint64_t                  maximumPointsPerChunk,
+              unsigned int              numberOfLevels)
+{
+  // The cell ids are unsigned integers of the cell component size
+  switch (WasmMeshIO::ITKComponentSize(meshIO->GetCellComponentType()))
+  {
+    case 1:
+      return PartitionMesh<uint8_t>(meshIO, points, cells, pointData, cellData, maximumPointsPerChunk, numberOfLevels);
+    case 2:
+      return PartitionMesh<uint16_t>(meshIO, points, cells, pointData, cellData, maximumPointsPerChunk, numberOfLevels);
+    case 4:
+      return PartitionMesh<uint32_t>(meshIO, points, cells, pointData, cellData, maximumPointsPerChunk, numberOfLevels);
+    case 8:
+      return PartitionMesh<uint64_t>(meshIO, points, cells, pointData, cellData, maximumPointsPerChunk, numberOfLevels);
+    default:
+      throw std::runtime_error("Unexpected cell component type");
+  }
+}
+
+
+void
+WriteMeshChunk(const MeshIOBase * meshIO, const MeshChunk & chunk, WasmMeshIO * chunkIO)
+{
+  chunkIO->SetBundleMemberName(chunk.name);
+  chunkIO->SetBundleMemberLevel(chunk.level);
+  chunkIO->SetBundleMemberBounds(chunk.bounds);
+
+  chunkIO->SetPointDimension(meshIO->GetPointDimension());
+  chunkIO->SetPointComponentType(meshIO->GetPointComponentType());
+  chunkIO->SetPointPixelType(meshIO->GetPointPixelType());
+  chunkIO->SetPointPixelComponentType(meshIO->GetPointPixelComponentType());
+  chunkIO->SetNumberOfPointPixelComponents(meshIO->GetNumberOfPointPixelComponents());
+  chunkIO->SetCellComponentType(meshIO->GetCellComponentType());
+  chunkIO->SetCellPixelType(meshIO->GetCellPixelType());
+  chunkIO->SetCellPixelComponentType(meshIO->GetCellPixelComponentType());
+  chunkIO->SetNumberOfCellPixelComponents(meshIO->GetNumberOfCellPixelComponents());
+  chunkIO->SetNumberOfPoints(chunk.numberOfPoints);
+  chunkIO->SetUpdatePoints(chunk.numberOfPoints > 0);
+  chunkIO->SetNumberOfPointPixels(chunk.numberOfPointPixels);
+  chunkIO->SetUpdatePointData(chunk.numberOfPointPixels > 0);
+  chunkIO->SetNumberOfCells(chunk.numberOfCells);
+  chunkIO->SetUpdateCells(chunk.numberOfCells > 0);
+  chunkIO->SetNumberOfCellPixels(chunk.numberOfCellPixels);
+  chunkIO->SetUpdateCellData(chunk.numberOfCellPixels > 0);
+  chunkIO->SetCellBufferSize(chunk.cellBufferSize);
+
+  chunkIO->WriteMeshInformation();
+  const auto buffer = [](const std::vector<char> & data) { return const_cast<char *>(data.data()); };
+  if (chunk.numberOfPoints > 0)
+  {
+    chunkIO->WritePoints(buffer(chunk.points));
+  }
+  if (chunk.numberOfCells > 0)
+  {
+    chunkIO->WriteCells(buffer(chunk.cells));
+  }
+  if (chunk.numberOfPointPixels > 0)
+  {
+    chunkIO->WritePointData(buffer(chunk.pointData));
+  }
+  if (chunk.numberOfCellPixels > 0)
+  {
+    chunkIO->WriteCellData(buffer(chunk.cellData));
+  }
+  chunkIO->Write();
+}
+
+
+std::vector<const BundleMember *>
+SelectMeshChunks(const BundleTableOfContents & tableOfContents, uint32_t level, const std::vector<double> & bounds)
+{
+  std::vector<const BundleMember *> selected;
+  const size_t                      axes = bounds.size() / 2;
+  for (const BundleMember & member : tableOfContents.members)
+  {
+    if (member.bounds.empty() || member.level != level)
+    {
+      continue;
+    }
+    const size_t memberAxes = member.bounds.size() / 2;
+    bool         intersects = true;
+    for (size_t dd = 0; intersects && dd < std::min(axes, memberAxes); ++dd)
+    {
+      intersects = member.bounds[dd] <= bounds[axes + dd] && member.bounds[memberAxes + dd] >= bounds[dd];
+    }
+    if (intersects)
+    {
+      selected.push_back(&member);
+    }
+  }
+  return selected;
+}
+
+
+uint32_t
+GetNumberOfMeshChunkLevels(const BundleTableOfContents & tableOfContents)
+{
+  uint32_t numberOfLevels = 0;
+  for (const BundleMember & member : tableOfContents.members)
+  {
+    if (!member.bounds.empty())
+    {
+      numberOfLevels = std::max(numberOfLevels, member.level + 1);
+    }
+  }
+  return numberOfLevels;
+}
+
+} // end namespace wasm
+} // end namespace itk
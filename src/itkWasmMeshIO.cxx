@@ -22,9 +22,13 @@
 #include "itkIOComponentEnumFromWasmComponentType.h"
 #include "itkWasmPixelTypeFromIOPixelEnum.h"
 #include "itkIOPixelEnumFromWasmPixelType.h"
+#include "itkWasmAlignedFile.h"
+#include "itkWasmRangeReader.h"
+#include "itkWasmTrace.h"
 
 #include "itkMetaDataObject.h"
 #include "itkIOCommon.h"
+#include "itkMultiThreaderBase.h"
 #include "itksys/SystemTools.hxx"
 
 #include "rapidjson/document.h"
@@ -35,16 +39,163 @@
 
 #include "cbor.h"
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__) && !defined(__wasi__)
+#  define ITK_WASM_MESH_IO_MMAP
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 namespace itk
 {
 
+namespace
+{
+// CBOR typed array tag of a component type, or 0 if there is none
+// Todo: support endianness
+// https://www.iana.org/assignments/cbor-tags/cbor-tags.xhtml
+uint64_t
+CBORTypedArrayTag(CommonEnums::IOComponent ioComponent)
+{
+  switch (ioComponent) {
+    case CommonEnums::IOComponent::CHAR:
+    case CommonEnums::IOComponent::UCHAR:
+      return 64;
+    case CommonEnums::IOComponent::SHORT:
+      return 73;
+    case CommonEnums::IOComponent::USHORT:
+      return 69;
+    case CommonEnums::IOComponent::INT:
+      return 74;
+    case CommonEnums::IOComponent::UINT:
+      return 70;
+    case CommonEnums::IOComponent::LONG:
+    case CommonEnums::IOComponent::LONGLONG:
+      return 75;
+    case CommonEnums::IOComponent::ULONG:
+    case CommonEnums::IOComponent::ULONGLONG:
+      return 71;
+    case CommonEnums::IOComponent::FLOAT:
+      return 85;
+    case CommonEnums::IOComponent::DOUBLE:
+      return 86;
+    default:
+      return 0;
+  }
+}
+
+// Element layout of a typed array for the payload filters. The typed array
+// is a single row.
+wasm::PayloadLayout
+MeshPayloadLayout(size_t componentSize, unsigned int components, SizeValueType numberOfBytes)
+{
+  wasm::PayloadLayout layout;
+  layout.componentSize = componentSize;
+  layout.components = components > 0 ? components : 1;
+  layout.rowLength = numberOfBytes / layout.componentSize;
+  return layout;
+}
+
+// Whether a typed array is quantized when written with quantizationBits:
+// float and double points and point data are
+bool
+IsQuantized(unsigned int quantizationBits, std::string_view dataName, CommonEnums::IOComponent ioComponent)
+{
+  return quantizationBits > 0 && (dataName == "points" || dataName == "pointData") &&
+         (ioComponent == CommonEnums::IOComponent::FLOAT || ioComponent == CommonEnums::IOComponent::DOUBLE);
+}
+
+// Component type of the quantized integers
+CommonEnums::IOComponent
+QuantizedComponentType(unsigned int quantizationBits)
+{
+  return quantizationBits == 16 ? CommonEnums::IOComponent::USHORT : CommonEnums::IOComponent::UINT;
+}
+
+// Key of the map entry that precedes a quantized typed array
+std::string
+QuantizationKey(std::string_view dataName)
+{
+  return std::string(dataName) + "Quantization";
+}
+
+// Copy numberOfBytes at offset in a data file through a memory mapping, in
+// chunks copied in parallel so the pages of the file are read concurrently.
+// Returns false if the file cannot be mapped.
+bool
+ReadMappedDataFile(const std::string & dataFile, void * buffer, SizeValueType numberOfBytes, uint64_t offset = 0)
+{
+#ifdef ITK_WASM_MESH_IO_MMAP
+  if (numberOfBytes == 0)
+  {
+    return false;
+  }
+  const int fileDescriptor = open(dataFile.c_str(), O_RDONLY);
+  if (fileDescriptor < 0)
+  {
+    return false;
+  }
+  struct stat fileStatus;
+  if (fstat(fileDescriptor, &fileStatus) != 0 || static_cast< uint64_t >( fileStatus.st_size ) < offset + numberOfBytes)
+  {
+    close(fileDescriptor);
+    return false;
+  }
+  // The mapping starts at the page of the offset
+  const auto pageSize = static_cast< uint64_t >( sysconf(_SC_PAGESIZE) );
+  const uint64_t mappedOffset = offset - offset % pageSize;
+  const auto mappedSize = static_cast< size_t >( offset - mappedOffset + numberOfBytes );
+  void * mappedData = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fileDescriptor, static_cast< off_t >( mappedOffset ));
+  // The mapping stays valid after the descriptor is closed
+  close(fileDescriptor);
+  if (mappedData == MAP_FAILED)
+  {
+    return false;
+  }
+  madvise(mappedData, mappedSize, MADV_WILLNEED);
+
+  constexpr size_t chunkSize = 4 * 1024 * 1024;
+  const auto mappedBytes = static_cast< const char * >( mappedData ) + ( offset - mappedOffset );
+  auto bufferBytes = static_cast< char * >( buffer );
+  const auto bufferSize = static_cast< size_t >( numberOfBytes );
+  const size_t numberOfChunks = ( bufferSize + chunkSize - 1 ) / chunkSize;
+  MultiThreaderBase::New()->ParallelizeArray(0, numberOfChunks, [&](SizeValueType chunk) {
+    const size_t chunkOffset = chunk * chunkSize;
+    std::memcpy(bufferBytes + chunkOffset, mappedBytes + chunkOffset, std::min(chunkSize, bufferSize - chunkOffset));
+  }, nullptr);
+  munmap(mappedData, mappedSize);
+  return true;
+#else
+  (void)dataFile;
+  (void)buffer;
+  (void)numberOfBytes;
+  (void)offset;
+  return false;
+#endif
+}
+} // end anonymous namespace
+
 WasmMeshIO
 ::WasmMeshIO()
 {
   this->AddSupportedWriteExtension(".iwm");
   this->AddSupportedWriteExtension(".iwm.cbor");
+  this->AddSupportedWriteExtension(".iwm.bin");
+  this->AddSupportedWriteExtension(".iwm.bundle");
   this->AddSupportedReadExtension(".iwm");
   this->AddSupportedReadExtension(".iwm.cbor");
+  this->AddSupportedReadExtension(".iwm.bin");
+  this->AddSupportedReadExtension(".iwm.bundle");
 }
 
 
@@ -59,6 +210,15 @@ WasmMeshIO
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "QuantizationBits: " << this->m_QuantizationBits << std::endl;
+  os << indent << "QuantizationMaximumError: " << this->m_QuantizationMaximumError << std::endl;
+  os << indent << "BundleMemberLevel: " << this->m_BundleMemberLevel << std::endl;
+  os << indent << "BundleMemberBounds:";
+  for (const double bound : this->m_BundleMemberBounds)
+  {
+    os << " " << bound;
+  }
+  os << std::endl;
 }
 
 
@@ -220,6 +380,29 @@ WasmMeshIO
     }
 }
 
+void
+WasmMeshIO
+::ReadDataFile(const char * dataPath, void * buffer, SizeValueType numberOfBytesToBeRead)
+{
+  const std::string dataFile = std::string(this->GetFileName()) + "/" + dataPath;
+  if ( ReadMappedDataFile( dataFile, buffer, numberOfBytesToBeRead ) )
+    {
+    return;
+    }
+
+  std::ifstream dataStream;
+  this->OpenFileForReading( dataStream, dataFile.c_str() );
+
+  if ( !this->ReadBufferAsBinary( dataStream, buffer, numberOfBytesToBeRead ) )
+    {
+    itkExceptionMacro(<< "Read failed: Wanted "
+                      << numberOfBytesToBeRead
+                      << " bytes, but read "
+                      << dataStream.gcount() << " bytes.");
+    }
+}
+
+
 bool
 WasmMeshIO
 ::FileNameIsCBOR()
@@ -230,28 +413,172 @@ WasmMeshIO
   {
     return true;
   }
-  return false;
+  return this->FileNameIsAligned() || this->FileNameIsBundle();
+}
+
+
+bool
+WasmMeshIO
+::FileNameIsAligned()
+{
+  return wasm::FileNameIsAligned(this->GetFileName(), ".iwm.bin");
+}
+
+
+bool
+WasmMeshIO
+::FileNameIsBundle() const
+{
+  return wasm::FileNameIsBundle(this->GetFileName(), ".iwm.bundle");
+}
+
+
+void
+WasmMeshIO
+::SelectBundleMember()
+{
+  this->m_BundleTableOfContents = wasm::BundleTableOfContents();
+  this->m_BundleMember = wasm::BundleMember();
+  if (!this->FileNameIsBundle())
+  {
+    return;
+  }
+
+  std::unique_ptr< wasm::RangeReader > reader = wasm::RangeReader::Open(this->GetFileName());
+  if (!reader)
+  {
+    itkExceptionMacro("Could not read file: " << this->GetFileName());
+  }
+  if (!wasm::ReadBundleTableOfContents(*reader, this->m_BundleTableOfContents) || this->m_BundleTableOfContents.bundleType != "Mesh")
+  {
+    itkExceptionMacro("Expected a mesh bundle in " << this->GetFileName());
+  }
+  const wasm::BundleMember * member = wasm::FindBundleMember(this->m_BundleTableOfContents, this->m_BundleMemberName, this->m_BundleMemberIndex);
+  if (member == nullptr)
+  {
+    itkExceptionMacro("There is no member " << (this->m_BundleMemberName.empty() ? std::to_string(this->m_BundleMemberIndex) : this->m_BundleMemberName)
+                      << " in " << this->GetFileName() << ", which has " << this->m_BundleTableOfContents.members.size() << " members");
+  }
+  this->m_BundleMember = *member;
+}
+
+
+std::vector< std::string >
+WasmMeshIO
+::GetBundleMemberNames() const
+{
+  std::vector< std::string > names;
+  for (const wasm::BundleMember & member : this->m_BundleTableOfContents.members)
+  {
+    names.push_back(member.name);
+  }
+  return names;
+}
+
+
+std::unique_ptr< wasm::RangeReader >
+WasmMeshIO
+::OpenRangeReader() const
+{
+  std::unique_ptr< wasm::RangeReader > reader = wasm::RangeReader::Open(this->GetFileName());
+  if (reader && this->FileNameIsBundle())
+  {
+    return wasm::OpenBundleMember(std::move(reader), this->m_BundleMember);
+  }
+  return reader;
 }
 
 
 void
 WasmMeshIO
-::ReadCBORBuffer(const char * dataName, void * buffer, SizeValueType numberOfBytesToBeRead)
+::ReadCBORBuffer(const char * dataName, void * buffer, SizeValueType numberOfBytesToBeRead, IOComponentEnum ioComponent, unsigned int components)
 {
-  cbor_item_t * index = this->m_CBORRoot;
-  if (index == nullptr) {
+  if (!this->m_CBORSource)
+  {
     itkExceptionMacro("Call ReadMeshInformation before reading the data buffer");
   }
-  const size_t indexCount = cbor_map_size(index);
-  const struct cbor_pair * indexHandle = cbor_map_handle(index);
-  for (size_t ii = 0; ii < indexCount; ++ii)
+  auto payload = this->m_CBORPayloads.find(dataName);
+  while (payload == this->m_CBORPayloads.end() && this->m_CBOREntriesRemaining > 0)
   {
-    const std::string_view key(reinterpret_cast<char *>(cbor_string_handle(indexHandle[ii].key)), cbor_string_length(indexHandle[ii].key));
-    if (key == dataName)
+    this->ReadCBOREntry();
+    payload = this->m_CBORPayloads.find(dataName);
+  }
+  if (payload == this->m_CBORPayloads.end())
+  {
+    itkExceptionMacro("Read failed: there is no " << dataName << " entry in " << this->GetFileName());
+  }
+  const CBORPayload & location = payload->second;
+
+  // Quantized components are read into the start of the buffer and
+  // restored in place
+  const size_t componentSize = WasmMeshIO::ITKComponentSize(ioComponent);
+  const uint64_t numberOfValues = numberOfBytesToBeRead / componentSize;
+  const auto quantization = this->m_CBORQuantizations.find(dataName);
+  const bool quantized = quantization != this->m_CBORQuantizations.end();
+  if (quantized)
+  {
+    if (quantization->second.minimum.size() != (components > 0 ? components : 1))
+    {
+      itkExceptionMacro("Read failed: the " << dataName << " quantization of " << this->GetFileName() << " does not match its components");
+    }
+    numberOfBytesToBeRead = numberOfValues * quantization->second.GetComponentSize();
+  }
+  if (location.size < numberOfBytesToBeRead)
+  {
+    itkExceptionMacro("Read failed: the cbor " << dataName << " of " << this->GetFileName() << " is smaller than expected");
+  }
+
+  if (location.aligned)
+  {
+    // The payload of a .iwm.bin file is at its offset in the file
+    const std::string path = this->GetFileName();
+    if (!ReadMappedDataFile(path, buffer, numberOfBytesToBeRead, location.offset))
+    {
+      std::unique_ptr< wasm::RangeReader > reader = wasm::RangeReader::Open(path);
+      if (!reader || !reader->Read(location.offset, buffer, numberOfBytesToBeRead))
+      {
+        itkExceptionMacro("Could not successfully read the " << dataName << " of " << path);
+      }
+    }
+  }
+  else
+  {
+    // The payload is read straight into the buffer, restarting the source if
+    // it has passed the payload
+    if (this->m_CBORSource->GetPosition() > location.offset)
+    {
+      this->m_CBORSource = this->CreateCBORSource();
+    }
+    wasm::CBORSource & source = *this->m_CBORSource;
+    if (!source.Skip(location.offset - source.GetPosition()) || !source.Read(buffer, numberOfBytesToBeRead))
+    {
+      itkExceptionMacro("Could not successfully read the " << dataName << " of " << this->GetFileName());
+    }
+  }
+
+  if (this->m_PayloadFilters.IsEnabled())
+  {
+    const wasm::PayloadLayout layout = MeshPayloadLayout(quantized ? quantization->second.GetComponentSize() : componentSize, components, numberOfBytesToBeRead);
+    try
+    {
+      wasm::ValidatePayloadFilters(this->m_PayloadFilters, layout);
+    }
+    catch (const std::runtime_error & error)
+    {
+      itkExceptionMacro("Could not read " << this->GetFileName() << ": " << error.what());
+    }
+    wasm::DecodePayload(this->m_PayloadFilters, layout, buffer, numberOfBytesToBeRead);
+  }
+
+  if (quantized)
+  {
+    try
+    {
+      wasm::Dequantize(quantization->second, componentSize, buffer, numberOfValues);
+    }
+    catch (const std::runtime_error & error)
     {
-      const cbor_item_t * dataItem = cbor_tag_item(indexHandle[ii].value);
-      const char * dataHandle = reinterpret_cast< char * >( cbor_bytestring_handle(dataItem) );
-      std::memcpy(buffer, dataHandle, numberOfBytesToBeRead);
+      itkExceptionMacro("Could not read " << this->GetFileName() << ": " << error.what());
     }
   }
 }
@@ -259,62 +586,188 @@ WasmMeshIO
 
 void
 WasmMeshIO
-::WriteCBORBuffer(const char * dataName, void * buffer, SizeValueType numberOfBytesToWrite, IOComponentEnum ioComponent)
+::WriteCBORBuffer(const char * dataName, void * buffer, SizeValueType numberOfBytesToWrite, IOComponentEnum ioComponent, unsigned int components)
 {
-  cbor_item_t * index = this->m_CBORRoot;
-  if (index == nullptr) {
+  if (this->m_CBOREncodedSize == 0) {
     itkExceptionMacro("Call WriteMeshInformation before writing the data buffer");
   }
-  cbor_item_t * dataItem = cbor_build_bytestring(reinterpret_cast< const unsigned char *>(buffer), numberOfBytesToWrite);
-  uint64_t tag = 0;
-  // Todo: support endianness
-  // https://www.iana.org/assignments/cbor-tags/cbor-tags.xhtml
-  switch (ioComponent) {
-    case IOComponentEnum::CHAR:
-      tag = 64;
-      break;
-    case IOComponentEnum::UCHAR:
-      tag = 64;
-      break;
-    case IOComponentEnum::SHORT:
-      tag = 73;
-      break;
-    case IOComponentEnum::USHORT:
-      tag = 69;
-      break;
-    case IOComponentEnum::INT:
-      tag = 74;
-      break;
-    case IOComponentEnum::UINT:
-      tag = 70;
-      break;
-    case IOComponentEnum::LONG:
-      tag = 75;
-      break;
-    case IOComponentEnum::ULONG:
-      tag = 71;
-      break;
-    case IOComponentEnum::LONGLONG:
-      tag = 75;
-      break;
-    case IOComponentEnum::ULONGLONG:
-      tag = 71;
-      break;
-    case IOComponentEnum::FLOAT:
-      tag = 85;
-      break;
-    case IOComponentEnum::DOUBLE:
-      tag = 86;
-      break;
-    default:
-      itkExceptionMacro("Unexpected component type");
+  if (numberOfBytesToWrite == 0)
+  {
+    // Empty typed arrays are not declared in the header
+    return;
+  }
+
+  if (this->FileNameIsAligned())
+  {
+    // Written at the offset declared in the metadata
+    const auto location = this->m_CBORPayloads.find(dataName);
+    if (location == this->m_CBORPayloads.end() || location->second.size != numberOfBytesToWrite)
+    {
+      itkExceptionMacro("The " << dataName << " written were not declared by WriteMeshInformation");
+    }
+    std::ofstream outputStream;
+    this->OpenFileForWriting( outputStream, this->GetFileName(), false, false );
+    outputStream.seekp(location->second.offset);
+    outputStream.write(static_cast< const char * >( buffer ), numberOfBytesToWrite);
+    if (!outputStream)
+    {
+      itkExceptionMacro("Could not successfully write the " << dataName << " of " << this->GetFileName());
+    }
+    ++this->m_CBORBufferEntriesWritten;
+    return;
+  }
+
+  std::vector< unsigned char > quantized;
+  if (IsQuantized(this->m_QuantizationBits, dataName, ioComponent))
+  {
+    const size_t componentSize = WasmMeshIO::ITKComponentSize(ioComponent);
+    const uint64_t numberOfValues = numberOfBytesToWrite / componentSize;
+    wasm::Quantization quantization;
+    try
+    {
+      quantization = wasm::ComputeQuantization(this->m_QuantizationBits, componentSize, components > 0 ? components : 1, buffer, numberOfValues);
+    }
+    catch (const std::runtime_error & error)
+    {
+      itkExceptionMacro(<< error.what());
+    }
+    const double error = wasm::QuantizationError(quantization);
+    if (this->m_QuantizationMaximumError > 0.0 && error > this->m_QuantizationMaximumError)
+    {
+      itkExceptionMacro("The " << this->m_QuantizationBits << " bit quantization error of the " << dataName << ", " << error
+                        << ", exceeds the QuantizationMaximumError, " << this->m_QuantizationMaximumError);
+    }
+    quantized.resize(numberOfValues * quantization.GetComponentSize());
+    wasm::Quantize(quantization, componentSize, buffer, numberOfValues, quantized.data());
+
+    this->OpenCBORSink();
+    this->m_CBORSink->WriteString(QuantizationKey(dataName));
+    wasm::WriteQuantization(*this->m_CBORSink, quantization);
+    ++this->m_CBORBufferEntriesWritten;
+
+    // The integers are written as the typed array
+    buffer = quantized.data();
+    numberOfBytesToWrite = quantized.size();
+    ioComponent = QuantizedComponentType(this->m_QuantizationBits);
+  }
+
+  const uint64_t tag = CBORTypedArrayTag(ioComponent);
+  if (tag == 0)
+  {
+    itkExceptionMacro("Unexpected component type");
+  }
+  this->OpenCBORSink();
+  // The typed array is streamed from the buffer
+  this->m_CBORSink->WriteString(dataName);
+  this->m_CBORSink->WriteTag(tag);
+  if (!this->m_PayloadFilters.IsEnabled())
+  {
+    this->m_CBORSink->WriteByteString(buffer, numberOfBytesToWrite);
+    ++this->m_CBORBufferEntriesWritten;
+    return;
+  }
+
+  const wasm::PayloadLayout layout = MeshPayloadLayout(WasmMeshIO::ITKComponentSize(ioComponent), components, numberOfBytesToWrite);
+  try
+  {
+    wasm::ValidatePayloadFilters(this->m_PayloadFilters, layout);
+  }
+  catch (const std::runtime_error & error)
+  {
+    itkExceptionMacro(<< error.what());
+  }
+  this->m_CBORSink->WriteByteStringHead(numberOfBytesToWrite);
+  const size_t blockSize = this->m_PayloadFilters.blockSize;
+  std::vector< unsigned char > block(std::min< uint64_t >(blockSize, numberOfBytesToWrite));
+  std::vector< unsigned char > scratch;
+  for (uint64_t offset = 0; offset < numberOfBytesToWrite; offset += blockSize)
+  {
+    const size_t size = static_cast< size_t >( std::min< uint64_t >(blockSize, numberOfBytesToWrite - offset) );
+    wasm::EncodePayloadBlock(this->m_PayloadFilters, layout, buffer, offset, size, block.data(), scratch);
+    this->m_CBORSink->WriteByteStringContent(block.data(), size);
+  }
+  ++this->m_CBORBufferEntriesWritten;
+}
+
+
+wasm::PayloadFilters
+WasmMeshIO
+::GetPayloadFiltersForWriting() const
+{
+  return wasm::PayloadFilters();
+}
+
+
+void
+WasmMeshIO
+::OpenCBORSink()
+{
+  if (this->m_CBORSink == nullptr)
+  {
+    this->m_CBORSink = this->CreateCBORSink(this->m_CBOREncodedSize);
+    this->WriteCBORHeader(*this->m_CBORSink);
+  }
+}
+
+
+std::unique_ptr<wasm::CBORSink>
+WasmMeshIO
+::CreateCBORSink(uint64_t itkNotUsed(encodedSize))
+{
+  FILE* file = this->OpenCBORFile();
+  if (file == NULL) {
+    itkExceptionMacro("Could not open file for writing: " << this->GetFileName());
   }
-  cbor_item_t * dataTag = cbor_new_tag(tag);
-  cbor_tag_set_item(dataTag, cbor_move(dataItem));
-  cbor_map_add(index,
-    cbor_pair{
-      cbor_move(cbor_build_string(dataName)),
-      cbor_move(dataTag)});
+  return std::make_unique<wasm::FileCBORSink>(file);
+}
+
+
+FILE *
+WasmMeshIO
+::OpenCBORFile() const
+{
+  // Bundle members are appended after the members before them
+  return fopen(this->GetFileName(), this->FileNameIsBundle() ? "ab" : "wb");
+}
+
+
+std::string
+WasmMeshIO
+::GetBundleMemberEncodingForWriting() const
+{
+  return "cbor";
+}
+
+
+SizeValueType
+WasmMeshIO
+::GetPointsSizeInBytes() const
+{
+  return static_cast< SizeValueType >( this->GetNumberOfPoints() * this->GetPointDimension() * ITKComponentSize( this->GetPointComponentType() ) );
+}
+
+
+SizeValueType
+WasmMeshIO
+::GetCellsSizeInBytes() const
+{
+  return static_cast< SizeValueType >( this->GetCellBufferSize() * ITKComponentSize( this->GetCellComponentType() ) );
+}
+
+
+SizeValueType
+WasmMeshIO
+::GetPointDataSizeInBytes() const
+{
+  return static_cast< SizeValueType >( this->GetNumberOfPointPixels() * this->GetNumberOfPointPixelComponents() * ITKComponentSize( this->GetPointPixelComponentType() ) );
+}
+
+
+SizeValueType
+WasmMeshIO
+::GetCellDataSizeInBytes() const
+{
+  return static_cast< SizeValueType >( this->GetNumberOfCellPixels() * this->GetNumberOfCellPixelComponents() * ITKComponentSize( this->GetCellPixelComponentType() ) );
 }
 
 
@@ -346,182 +799,283 @@ WasmMeshIO
 
 void
 WasmMeshIO
-::ReadCBOR( void *buffer, unsigned char * cborBuffer, size_t cborBufferLength )
+::ReadCBOR()
 {
-  bool cborBufferAllocated = false;
-  size_t length = cborBufferLength;
-  if (cborBuffer == nullptr)
+  ITK_WASM_TRACE_SCOPE("WasmMeshIO::ReadCBOR");
+  this->m_CBORPayloads.clear();
+  this->m_CBORQuantizations.clear();
+  this->m_PayloadFilters = wasm::PayloadFilters();
+  this->SelectBundleMember();
+  this->m_CBORSource = this->CreateCBORSource();
+  wasm::CBORHead indexHead;
+  if (!wasm::ReadCBORHead(*this->m_CBORSource, indexHead) || indexHead.majorType != 5)
   {
-    FILE* file = fopen(this->GetFileName(), "rb");
-    if (file == NULL) {
-      itkExceptionMacro("Could not read file: " << this->GetFileName());
-    }
-    fseek(file, 0, SEEK_END);
-    length = (size_t)ftell(file);
-    fseek(file, 0, SEEK_SET);
-    cborBuffer = static_cast< unsigned char *>(malloc(length));
-    cborBufferAllocated = true;
-    if (!fread(cborBuffer, length, 1, file))
+    itkExceptionMacro("Expected a definite-length cbor map in " << this->GetFileName());
+  }
+  this->m_CBOREntriesRemaining = indexHead.argument;
+  this->m_CBORNextEntryPosition = this->m_CBORSource->GetPosition();
+
+  // The mesh information precedes the typed arrays in the files WasmMeshIO
+  // writes, so the typed arrays are indexed as they are reached by the data
+  // reads
+  const std::string_view informationKeys[] = { "meshType", "numberOfPoints", "numberOfPointPixels", "numberOfCells", "numberOfCellPixels", "cellBufferSize" };
+  size_t informationKeysRead = 0;
+  while (this->m_CBOREntriesRemaining > 0 && informationKeysRead < std::size(informationKeys))
+  {
+    const std::string key = this->ReadCBOREntry();
+    if (std::find(std::begin(informationKeys), std::end(informationKeys), key) != std::end(informationKeys))
     {
-      itkExceptionMacro("Could not successfully read " << this->GetFileName());
+      ++informationKeysRead;
+    }
+  }
+}
 
+
+std::string
+WasmMeshIO
+::ReadCBOREntry()
+{
+  wasm::CBORSource & source = *this->m_CBORSource;
+  if (!source.Skip(this->m_CBORNextEntryPosition - source.GetPosition()))
+  {
+    itkExceptionMacro("Could not successfully read " << this->GetFileName());
+  }
+  --this->m_CBOREntriesRemaining;
+
+  wasm::CBORHead keyHead;
+  if (!wasm::ReadCBORHead(source, keyHead) || keyHead.majorType != 3)
+  {
+    itkExceptionMacro("Unexpected cbor map key in " << this->GetFileName());
+  }
+  std::string key(keyHead.argument, '\0');
+  if (!source.Read(key.data(), key.size()))
+  {
+    itkExceptionMacro("Could not successfully read " << this->GetFileName());
+  }
+
+  if (key == "points" || key == "cells" || key == "pointData" || key == "cellData")
+  {
+    // Only the position of the tagged byte string payload is recorded
+    wasm::CBORHead tagHead;
+    wasm::CBORHead dataHead;
+    if (!wasm::ReadCBORHead(source, tagHead) || tagHead.majorType != 6 || !wasm::ReadCBORHead(source, dataHead) || (dataHead.majorType != 2 && dataHead.majorType != 4))
+    {
+      itkExceptionMacro("Unexpected cbor " << key << " entry in " << this->GetFileName());
+    }
+    if (dataHead.majorType == 4)
+    {
+      // The location of a payload of a .iwm.bin file
+      CBORPayload location;
+      location.aligned = true;
+      if (!wasm::ReadAlignedPayloadLocation(source, dataHead, location.offset, location.size))
+      {
+        itkExceptionMacro("Unexpected cbor " << key << " entry in " << this->GetFileName());
+      }
+      this->m_CBORPayloads[key] = location;
+      this->m_CBORNextEntryPosition = source.GetPosition();
+      return key;
     }
-    fclose(file);
+    this->m_CBORPayloads[key] = { source.GetPosition(), dataHead.argument };
+    this->m_CBORNextEntryPosition = source.GetPosition() + dataHead.argument;
+    return key;
   }
 
-  if (this->m_CBORRoot != nullptr) {
-    cbor_decref(&(this->m_CBORRoot));
+  std::vector< unsigned char > itemBuffer;
+  if (!wasm::CopyCBORItem(source, itemBuffer))
+  {
+    itkExceptionMacro("Could not successfully read " << this->GetFileName());
   }
+  this->m_CBORNextEntryPosition = source.GetPosition();
   struct cbor_load_result result;
-  this->m_CBORRoot = cbor_load(cborBuffer, length, &result);
-  if (cborBufferAllocated)
+  cbor_item_t * value = cbor_load(itemBuffer.data(), itemBuffer.size(), &result);
+  if (result.error.code != CBOR_ERR_NONE)
+  {
+    itkExceptionMacro("There was an error while reading the cbor " << key << " entry of " << this->GetFileName() << " near byte " << result.error.position);
+  }
+  try
+  {
+    this->ReadCBORIndexItem(key, value);
+  }
+  catch (...)
+  {
+    cbor_decref(&value);
+    throw;
+  }
+  cbor_decref(&value);
+  return key;
+}
+
+
+std::unique_ptr<wasm::CBORSource>
+WasmMeshIO
+::CreateCBORSource()
+{
+  std::unique_ptr< wasm::RangeReader > reader = this->OpenRangeReader();
+  if (!reader)
   {
-    free(cborBuffer);
+    itkExceptionMacro("Could not read file: " << this->GetFileName());
   }
-  if (result.error.code != CBOR_ERR_NONE) {
-    std::string errorDescription;
-    switch (result.error.code) {
-      case CBOR_ERR_MALFORMATED: {
-        errorDescription = "Malformed data\n";
-        break;
+  if (this->FileNameIsBundle() && this->m_BundleMember.encoding != "cbor")
+  {
+    itkExceptionMacro("The " << this->m_BundleMember.encoding << " bundle member " << this->m_BundleMember.name << " of " << this->GetFileName() << " requires WasmZstdMeshIO");
+  }
+  if (this->FileNameIsAligned())
+  {
+    // The metadata of a .iwm.bin file is decoded as the .iwm.cbor map
+    if (!wasm::ReadAlignedFileMetadata(*reader, wasm::AlignedMeshFileMagic, this->m_AlignedMetadata))
+    {
+      this->m_AlignedMetadata.clear();
+      itkExceptionMacro("Expected a .iwm.bin header in " << this->GetFileName());
+    }
+    return std::make_unique< wasm::MemoryCBORSource >(this->m_AlignedMetadata.data(), this->m_AlignedMetadata.size());
+  }
+  return std::make_unique< wasm::RangeCBORSource >(std::move(reader));
+}
+
+
+
+void
+WasmMeshIO
+::ReadCBORIndexItem(std::string_view key, const cbor_item_t * value)
+{
+  if (key == "meshType")
+  {
+    const cbor_item_t * meshTypeItem = value;
+    const size_t meshTypeCount = cbor_map_size(meshTypeItem);
+    const struct cbor_pair * meshTypeHandle = cbor_map_handle(meshTypeItem);
+    for (size_t jj = 0; jj < meshTypeCount; ++jj)
+    {
+      const std::string_view meshTypeKey(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].key)), cbor_string_length(meshTypeHandle[jj].key));
+      if (meshTypeKey == "dimension")
+      {
+        const auto dimension = static_cast< unsigned int >( cbor_get_int(meshTypeHandle[jj].value) );
+        this->SetPointDimension( dimension );
+      }
+      else if (meshTypeKey == "pointComponentType")
+      {
+        const std::string pointComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
+        const CommonEnums::IOComponent pointIOComponentType = IOComponentEnumFromWasmComponentType( pointComponentType );
+        this->SetPointComponentType( pointIOComponentType );
+      }
+      else if (meshTypeKey == "pointPixelType")
+      {
+        const std::string pointPixelType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
+        const CommonEnums::IOPixel pointIOPixelType = IOPixelEnumFromWasmPixelType( pointPixelType );
+        this->SetPointPixelType( pointIOPixelType );
+      }
+      else if (meshTypeKey == "pointPixelComponentType")
+      {
+        const std::string pointPixelComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
+        const CommonEnums::IOComponent pointPixelIOComponentType = IOComponentEnumFromWasmComponentType( pointPixelComponentType );
+        this->SetPointPixelComponentType( pointPixelIOComponentType );
+      }
+      else if (meshTypeKey == "pointPixelComponents")
+      {
+        const auto components = static_cast< unsigned int >( cbor_get_int(meshTypeHandle[jj].value) );
+        this->SetNumberOfPointPixelComponents( components );
       }
-      case CBOR_ERR_MEMERROR: {
-        errorDescription = "Memory error -- perhaps the input is too large?\n";
-        break;
+      else if (meshTypeKey == "cellComponentType")
+      {
+        const std::string cellComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
+        const CommonEnums::IOComponent cellIOComponentType = IOComponentEnumFromWasmComponentType( cellComponentType );
+        this->SetCellComponentType( cellIOComponentType );
       }
-      case CBOR_ERR_NODATA: {
-        errorDescription = "The input is empty\n";
-        break;
+      else if (meshTypeKey == "cellPixelType")
+      {
+        const std::string cellPixelType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
+        const CommonEnums::IOPixel cellIOPixelType = IOPixelEnumFromWasmPixelType( cellPixelType );
+        this->SetCellPixelType( cellIOPixelType );
       }
-      case CBOR_ERR_NOTENOUGHDATA: {
-        errorDescription = "Data seem to be missing -- is the input complete?\n";
-        break;
+      else if (meshTypeKey == "cellPixelComponentType")
+      {
+        const std::string cellPixelComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
+        const CommonEnums::IOComponent cellPixelIOComponentType = IOComponentEnumFromWasmComponentType( cellPixelComponentType );
+        this->SetCellPixelComponentType( cellPixelIOComponentType );
       }
-      case CBOR_ERR_SYNTAXERROR: {
-        errorDescription = 
-            "Syntactically malformed data -- see https://tools.ietf.org/html/rfc7049\n";
-        break;
+      else if (meshTypeKey == "cellPixelComponents")
+      {
+        const auto components = static_cast< unsigned int >( cbor_get_int(meshTypeHandle[jj].value) );
+        this->SetNumberOfCellPixelComponents( components );
       }
-      case CBOR_ERR_NONE: {
-        break;
+      else
+      {
+        itkExceptionMacro("Unexpected meshType cbor map key: " << meshTypeKey);
       }
     }
-    itkExceptionMacro("" << errorDescription << "There was an error while reading the input near byte " << result.error.position << " (read " << result.read << " bytes in total): ");
   }
-
-  cbor_item_t * index = this->m_CBORRoot;
-  const size_t indexCount = cbor_map_size(index);
-  const struct cbor_pair * indexHandle = cbor_map_handle(index);
-  for (size_t ii = 0; ii < indexCount; ++ii)
+  else if (key == "numberOfPoints")
   {
-    const std::string_view key(reinterpret_cast<char *>(cbor_string_handle(indexHandle[ii].key)), cbor_string_length(indexHandle[ii].key));
-    if (key == "meshType")
-    {
-      const cbor_item_t * meshTypeItem = indexHandle[ii].value;
-      const size_t meshTypeCount = cbor_map_size(meshTypeItem);
-      const struct cbor_pair * meshTypeHandle = cbor_map_handle(meshTypeItem);
-      for (size_t jj = 0; jj < meshTypeCount; ++jj)
+    const auto components = cbor_get_int(value);
+    this->SetNumberOfPoints( components );
+    if ( components )
       {
-        const std::string_view meshTypeKey(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].key)), cbor_string_length(meshTypeHandle[jj].key));
-        if (meshTypeKey == "dimension")
-        {
-          const auto dimension = cbor_get_uint32(meshTypeHandle[jj].value);
-          this->SetPointDimension( dimension );
-        }
-        else if (meshTypeKey == "pointComponentType")
-        {
-          const std::string pointComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
-          const CommonEnums::IOComponent pointIOComponentType = IOComponentEnumFromWasmComponentType( pointComponentType );
-          this->SetPointComponentType( pointIOComponentType );
-        }
-        else if (meshTypeKey == "pointPixelType")
-        {
-          const std::string pointPixelType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
-          const CommonEnums::IOPixel pointIOPixelType = IOPixelEnumFromWasmPixelType( pointPixelType );
-          this->SetPointPixelType( pointIOPixelType );
-        }
-        else if (meshTypeKey == "pointPixelComponentType")
-        {
-          const std::string pointPixelComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
-          const CommonEnums::IOComponent pointPixelIOComponentType = IOComponentEnumFromWasmComponentType( pointPixelComponentType );
-          this->SetPointPixelComponentType( pointPixelIOComponentType );
-        }
-        else if (meshTypeKey == "pointPixelComponents")
-        {
-          const auto components = cbor_get_uint32(meshTypeHandle[jj].value);
-          this->SetNumberOfPointPixelComponents( components );
-        }
-        else if (meshTypeKey == "cellComponentType")
-        {
-          const std::string cellComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
-          const CommonEnums::IOComponent cellIOComponentType = IOComponentEnumFromWasmComponentType( cellComponentType );
-          this->SetCellComponentType( cellIOComponentType );
-        }
-        else if (meshTypeKey == "cellPixelType")
-        {
-          const std::string cellPixelType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
-          const CommonEnums::IOPixel cellIOPixelType = IOPixelEnumFromWasmPixelType( cellPixelType );
-          this->SetCellPixelType( cellIOPixelType );
-        }
-        else if (meshTypeKey == "cellPixelComponentType")
-        {
-          const std::string cellPixelComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
-          const CommonEnums::IOComponent cellPixelIOComponentType = IOComponentEnumFromWasmComponentType( cellPixelComponentType );
-          this->SetCellPixelComponentType( cellPixelIOComponentType );
-        }
-        else if (meshTypeKey == "cellPixelComponents")
-        {
-          const auto components = cbor_get_uint32(meshTypeHandle[jj].value);
-          this->SetNumberOfCellPixelComponents( components );
-        }
-        else
-        {
-          itkExceptionMacro("Unexpected meshType cbor map key: " << meshTypeKey);
-        }
+      this->m_UpdatePoints = true;
+      }
+  }
+  else if (key == "numberOfPointPixels")
+  {
+    const auto components = cbor_get_int(value);
+    this->SetNumberOfPointPixels( components );
+    if ( components )
+      {
+      this->m_UpdatePointData = true;
       }
+  }
+  else if (key == "numberOfCells")
+  {
+    const auto components = cbor_get_int(value);
+    this->SetNumberOfCells( components );
+    if ( components )
+      {
+      this->m_UpdateCells = true;
+      }
+  }
+  else if (key == "numberOfCellPixels")
+  {
+    const auto components = cbor_get_int(value);
+    this->SetNumberOfCellPixels( components );
+    if ( components )
+      {
+      this->m_UpdateCellData = true;
+      }
+  }
+  else if (key == "cellBufferSize")
+  {
+    const auto components = cbor_get_int(value);
+    this->SetCellBufferSize( components );
+  }
+  else if (key == "payloadFilters")
+  {
+    try
+    {
+      this->m_PayloadFilters = wasm::ReadPayloadFilters(value);
     }
-    else if (key == "numberOfPoints")
+    catch (const std::runtime_error & error)
     {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
-      this->SetNumberOfPoints( components );
-      if ( components )
-        {
-        this->m_UpdatePoints = true;
-        }
+      itkExceptionMacro("Could not read " << this->GetFileName() << ": " << error.what());
     }
-    else if (key == "numberOfPointPixels")
+    if (this->m_PayloadFilters.runLength)
     {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
-      this->SetNumberOfPointPixels( components );
-      if ( components )
-        {
-        this->m_UpdatePointData = true;
-        }
+      // Typed arrays are located by their size
+      itkExceptionMacro("Could not read " << this->GetFileName() << ": the runLength payload filter is only supported for images");
     }
-    else if (key == "numberOfCells")
+    if (this->m_PayloadFilters.codec != wasm::PayloadCodec::None)
     {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
-      this->SetNumberOfCells( components );
-      if ( components )
-        {
-        this->m_UpdateCells = true;
-        }
+      itkExceptionMacro("Could not read " << this->GetFileName() << ": payload codecs are only supported for images");
     }
-    else if (key == "numberOfCellPixels")
+  }
+  else if (key == "pointsQuantization" || key == "pointDataQuantization")
+  {
+    const std::string_view dataName = key.substr(0, key.size() - std::string_view("Quantization").size());
+    try
     {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
-      this->SetNumberOfCellPixels( components );
-      if ( components )
-        {
-        this->m_UpdateCellData = true;
-        }
+      this->m_CBORQuantizations[std::string(dataName)] = wasm::ReadQuantization(value);
     }
-    else if (key == "cellBufferSize")
+    catch (const std::runtime_error & error)
     {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
-      this->SetCellBufferSize( components );
+      itkExceptionMacro("Could not read " << this->GetFileName() << ": " << error.what());
     }
- }
+  }
 }
 
 rapidjson::Document
@@ -573,23 +1127,23 @@ WasmMeshIO
   document.AddMember( "meshType", meshType.Move(), allocator );
 
   rapidjson::Value numberOfPoints;
-  numberOfPoints.SetInt( this->GetNumberOfPoints() );
+  numberOfPoints.SetUint64( this->GetNumberOfPoints() );
   document.AddMember( "numberOfPoints", numberOfPoints.Move(), allocator );
 
   rapidjson::Value numberOfPointPixels;
-  numberOfPointPixels.SetInt( this->GetNumberOfPointPixels() );
+  numberOfPointPixels.SetUint64( this->GetNumberOfPointPixels() );
   document.AddMember( "numberOfPointPixels", numberOfPointPixels.Move(), allocator );
 
   rapidjson::Value numberOfCells;
-  numberOfCells.SetInt( this->GetNumberOfCells() );
+  numberOfCells.SetUint64( this->GetNumberOfCells() );
   document.AddMember( "numberOfCells", numberOfCells.Move(), allocator );
 
   rapidjson::Value numberOfCellPixels;
-  numberOfCellPixels.SetInt( this->GetNumberOfCellPixels() );
+  numberOfCellPixels.SetUint64( this->GetNumberOfCellPixels() );
   document.AddMember( "numberOfCellPixels", numberOfCellPixels.Move(), allocator );
 
   rapidjson::Value cellBufferSize;
-  cellBufferSize.SetInt( this->GetCellBufferSize() );
+  cellBufferSize.SetUint64( this->GetCellBufferSize() );
   document.AddMember( "cellBufferSize", cellBufferSize.Move(), allocator );
 
   std::string pointsDataFileString( "data:application/vnd.itk.path,data/points.raw" );
@@ -653,19 +1207,19 @@ WasmMeshIO
   this->SetNumberOfCellPixelComponents( meshType["cellPixelComponents"].GetInt() );
 
   const rapidjson::Value & numberOfPoints = document["numberOfPoints"];
-  this->SetNumberOfPoints( numberOfPoints.GetInt() );
+  this->SetNumberOfPoints( numberOfPoints.GetUint64() );
 
   const rapidjson::Value & numberOfPointPixels = document["numberOfPointPixels"];
-  this->SetNumberOfPointPixels( numberOfPointPixels.GetInt() );
+  this->SetNumberOfPointPixels( numberOfPointPixels.GetUint64() );
 
   const rapidjson::Value & numberOfCells = document["numberOfCells"];
-  this->SetNumberOfCells( numberOfCells.GetInt() );
+  this->SetNumberOfCells( numberOfCells.GetUint64() );
 
   const rapidjson::Value & numberOfCellPixels = document["numberOfCellPixels"];
-  this->SetNumberOfCellPixels( numberOfCellPixels.GetInt() );
+  this->SetNumberOfCellPixels( numberOfCellPixels.GetUint64() );
 
   const rapidjson::Value & cellBufferSize = document["cellBufferSize"];
-  this->SetCellBufferSize( cellBufferSize.GetInt() );
+  this->SetCellBufferSize( cellBufferSize.GetUint64() );
 }
 
 
@@ -673,100 +1227,218 @@ void
 WasmMeshIO
 ::WriteCBOR()
 {
-  if (this->m_CBORRoot != nullptr) {
-    cbor_decref(&(this->m_CBORRoot));
-  }
-  this->m_CBORRoot = cbor_new_definite_map(10);
-
-  cbor_item_t * index = this->m_CBORRoot;
-  cbor_item_t * meshTypeItem = cbor_new_definite_map(9);
-  cbor_map_add(meshTypeItem,
-    cbor_pair{
-      cbor_move(cbor_build_string("dimension")),
-      cbor_move(cbor_build_uint32(this->GetPointDimension()))});
-  std::string componentString = WasmComponentTypeFromIOComponentEnum( this->GetPointComponentType() );
-  cbor_map_add(meshTypeItem,
-    cbor_pair{
-      cbor_move(cbor_build_string("pointComponentType")),
-      cbor_move(cbor_build_string(componentString.c_str()))});
-  std::string pixelString = WasmPixelTypeFromIOPixelEnum( this->GetPointPixelType() );
-  cbor_map_add(meshTypeItem,
-    cbor_pair{
-      cbor_move(cbor_build_string("pointPixelType")),
-      cbor_move(cbor_build_string(pixelString.c_str()))});
-  componentString = WasmComponentTypeFromIOComponentEnum( this->GetPointPixelComponentType() );
-  cbor_map_add(meshTypeItem,
-    cbor_pair{
-      cbor_move(cbor_build_string("pointPixelComponentType")),
-      cbor_move(cbor_build_string(componentString.c_str()))});
-  cbor_map_add(meshTypeItem,
-    cbor_pair{
-      cbor_move(cbor_build_string("pointPixelComponents")),
-      cbor_move(cbor_build_uint32(this->GetNumberOfPointPixelComponents()))});
-  componentString = WasmComponentTypeFromIOComponentEnum( this->GetCellComponentType() );
-  cbor_map_add(meshTypeItem,
-    cbor_pair{
-      cbor_move(cbor_build_string("cellComponentType")),
-      cbor_move(cbor_build_string(componentString.c_str()))});
-  pixelString = WasmPixelTypeFromIOPixelEnum( this->GetCellPixelType() );
-  cbor_map_add(meshTypeItem,
-    cbor_pair{
-      cbor_move(cbor_build_string("cellPixelType")),
-      cbor_move(cbor_build_string(pixelString.c_str()))});
-  componentString = WasmComponentTypeFromIOComponentEnum( this->GetCellPixelComponentType() );
-  cbor_map_add(meshTypeItem,
-    cbor_pair{
-      cbor_move(cbor_build_string("cellPixelComponentType")),
-      cbor_move(cbor_build_string(componentString.c_str()))});
-  cbor_map_add(meshTypeItem,
-    cbor_pair{
-      cbor_move(cbor_build_string("cellPixelComponents")),
-      cbor_move(cbor_build_uint32(this->GetNumberOfCellPixelComponents()))});
-  cbor_map_add(index,
-    cbor_pair{
-      cbor_move(cbor_build_string("meshType")),
-      cbor_move(meshTypeItem)});
-
-  cbor_map_add(index,
-    cbor_pair{
-      cbor_move(cbor_build_string("numberOfPoints")),
-      cbor_move(cbor_build_uint64(this->GetNumberOfPoints()))});
+  ITK_WASM_TRACE_SCOPE("WasmMeshIO::WriteCBOR");
+  if (this->m_QuantizationBits != 0 && this->m_QuantizationBits != 16 && this->m_QuantizationBits != 32)
+  {
+    itkExceptionMacro("QuantizationBits must be 0, 16, or 32, not " << this->m_QuantizationBits);
+  }
+  this->m_CBORSink.reset();
+  this->m_CBORBufferEntries = 0;
+  this->m_CBORBufferEntriesWritten = 0;
+  this->m_CBORPayloads.clear();
+
   if ( this->GetNumberOfPoints() )
     {
     this->m_UpdatePoints = true;
     }
-
-  cbor_map_add(index,
-    cbor_pair{
-      cbor_move(cbor_build_string("numberOfPointPixels")),
-      cbor_move(cbor_build_uint64(this->GetNumberOfPointPixels()))});
   if ( this->GetNumberOfPointPixels() )
     {
     this->m_UpdatePointData = true;
     }
-
-  cbor_map_add(index,
-      cbor_pair{
-        cbor_move(cbor_build_string("numberOfCells")),
-        cbor_move(cbor_build_uint64(this->GetNumberOfCells()))});
   if ( this->GetNumberOfCells() )
     {
     this->m_UpdateCells = true;
     }
-
-  cbor_map_add(index,
-      cbor_pair{
-        cbor_move(cbor_build_string("numberOfCellPixels")),
-        cbor_move(cbor_build_uint64(this->GetNumberOfCellPixels()))});
   if ( this->GetNumberOfCellPixels() )
     {
     this->m_UpdateCellData = true;
     }
 
-  cbor_map_add(index,
-      cbor_pair{
-        cbor_move(cbor_build_string("cellBufferSize")),
-        cbor_move(cbor_build_uint64(this->GetCellBufferSize()))});
+  // The typed arrays follow the header in the order they are written
+  const std::pair< const char *, IOComponentEnum > typedArrays[] = {
+    { "points", this->GetPointComponentType() },
+    { "cells", this->GetCellComponentType() },
+    { "pointData", this->GetPointPixelComponentType() },
+    { "cellData", this->GetCellPixelComponentType() } };
+  const bool updates[] = { this->m_UpdatePoints, this->m_UpdateCells, this->m_UpdatePointData, this->m_UpdateCellData };
+  const SizeValueType sizes[] = { this->GetPointsSizeInBytes(), this->GetCellsSizeInBytes(), this->GetPointDataSizeInBytes(), this->GetCellDataSizeInBytes() };
+  const unsigned int components[] = { this->GetPointDimension(), 1, this->GetNumberOfPointPixelComponents(), this->GetNumberOfCellPixelComponents() };
+  if (this->FileNameIsAligned())
+  {
+    // The typed arrays of a .iwm.bin file are stored as is, without
+    // quantization or payload filters, at aligned offsets after the metadata
+    this->m_PayloadFilters = wasm::PayloadFilters();
+    for (size_t ii = 0; ii < std::size(typedArrays); ++ii)
+    {
+      if (!updates[ii] || sizes[ii] == 0)
+      {
+        continue;
+      }
+      if (CBORTypedArrayTag(typedArrays[ii].second) == 0)
+      {
+        itkExceptionMacro("Unexpected component type");
+      }
+      ++this->m_CBORBufferEntries;
+    }
+    this->m_CBORNumberOfEntries = 6 + this->m_CBORBufferEntries;
+
+    uint64_t firstPayloadOffset = 0;
+    uint64_t fileSize = 0;
+    const std::string metadata = wasm::EncodeAlignedFileMetadata([&](wasm::CBORSink & sink, uint64_t payloadOffset) {
+      this->WriteCBORHeader(sink);
+      fileSize = 0;
+      for (size_t ii = 0; ii < std::size(typedArrays); ++ii)
+      {
+        if (!updates[ii] || sizes[ii] == 0)
+        {
+          continue;
+        }
+        sink.WriteString(typedArrays[ii].first);
+        sink.WriteTag(CBORTypedArrayTag(typedArrays[ii].second));
+        wasm::WriteAlignedPayloadLocation(sink, payloadOffset, sizes[ii]);
+        this->m_CBORPayloads[typedArrays[ii].first] = { payloadOffset, sizes[ii], true };
+        fileSize = payloadOffset + sizes[ii];
+        payloadOffset = wasm::AlignPayloadOffset(fileSize);
+      }
+    }, firstPayloadOffset);
+
+    std::ofstream outputStream;
+    this->OpenFileForWriting( outputStream, this->GetFileName(), true, false );
+    const std::string header = wasm::EncodeAlignedFileHeader(wasm::AlignedMeshFileMagic, metadata.size());
+    outputStream.write(header.data(), header.size());
+    outputStream.write(metadata.data(), metadata.size());
+    if (fileSize > 0)
+    {
+      // Allocate the file, sparse where supported, for the typed arrays
+      outputStream.seekp(fileSize - 1);
+      outputStream.write("\0", 1);
+    }
+    if (!outputStream)
+    {
+      itkExceptionMacro("Could not successfully write " << this->GetFileName());
+    }
+    this->m_CBOREncodedSize = std::max< uint64_t >(fileSize, header.size() + metadata.size());
+    return;
+  }
+  uint64_t typedArraysSize = 0;
+  for (size_t ii = 0; ii < std::size(typedArrays); ++ii)
+  {
+    if (!updates[ii] || sizes[ii] == 0)
+    {
+      continue;
+    }
+    const std::string_view name(typedArrays[ii].first);
+    IOComponentEnum ioComponent = typedArrays[ii].second;
+    uint64_t size = sizes[ii];
+    if (IsQuantized(this->m_QuantizationBits, name, ioComponent))
+    {
+      // The bounds of the quantization entry are encoded at a fixed size
+      wasm::Quantization quantization;
+      quantization.bits = this->m_QuantizationBits;
+      quantization.minimum.assign(components[ii] > 0 ? components[ii] : 1, 0.0);
+      quantization.maximum = quantization.minimum;
+      wasm::CountingCBORSink quantizationSize;
+      quantizationSize.WriteString(QuantizationKey(name));
+      wasm::WriteQuantization(quantizationSize, quantization);
+      typedArraysSize += quantizationSize.GetSize();
+      ++this->m_CBORBufferEntries;
+
+      size = size / WasmMeshIO::ITKComponentSize(ioComponent) * quantization.GetComponentSize();
+      ioComponent = QuantizedComponentType(this->m_QuantizationBits);
+    }
+    const uint64_t tag = CBORTypedArrayTag(ioComponent);
+    if (tag == 0)
+    {
+      itkExceptionMacro("Unexpected component type");
+    }
+    typedArraysSize += wasm::CBORSink::GetHeadSize(name.size()) + name.size() + wasm::CBORSink::GetHeadSize(tag) + wasm::CBORSink::GetHeadSize(size) + size;
+    ++this->m_CBORBufferEntries;
+  }
+  this->m_CBORNumberOfEntries = 6 + this->m_CBORBufferEntries;
+
+  this->m_PayloadFilters = this->GetPayloadFiltersForWriting();
+  if (this->m_PayloadFilters.runLength)
+  {
+    itkExceptionMacro("The runLength payload filter is only supported for images");
+  }
+  if (this->m_PayloadFilters.codec != wasm::PayloadCodec::None)
+  {
+    itkExceptionMacro("Payload codecs are only supported for images");
+  }
+  if (this->m_PayloadFilters.IsEnabled())
+  {
+    ++this->m_CBORNumberOfEntries;
+  }
+
+  if (this->FileNameIsBundle())
+  {
+    // The member is appended by the sink, and added to the table of
+    // contents by Write
+    const std::string path = this->GetFileName();
+    if (!wasm::ReadBundleForAppending(path, "Mesh", this->m_AppendToBundle, this->m_BundleTableOfContents))
+    {
+      itkExceptionMacro("Expected a mesh bundle to append to in " << path);
+    }
+    const std::string name = this->m_BundleMemberName.empty() ? std::to_string(this->m_BundleTableOfContents.members.size()) : this->m_BundleMemberName;
+    if (wasm::FindBundleMember(this->m_BundleTableOfContents, name, 0) != nullptr)
+    {
+      itkExceptionMacro("The mesh bundle " << path << " already has a member named " << name);
+    }
+    if (!wasm::BeginBundleMember(path, this->m_BundleTableOfContents))
+    {
+      itkExceptionMacro("Could not open file for writing: " << path);
+    }
+  }
+
+  wasm::CountingCBORSink headerSize;
+  this->WriteCBORHeader(headerSize);
+  this->m_CBOREncodedSize = headerSize.GetSize() + typedArraysSize;
+}
+
+
+void
+WasmMeshIO
+::WriteCBORHeader(wasm::CBORSink & sink)
+{
+  sink.WriteMap(this->m_CBORNumberOfEntries);
+
+  sink.WriteString("meshType");
+  sink.WriteMap(9);
+  sink.WriteString("dimension");
+  sink.WriteUInt(this->GetPointDimension());
+  sink.WriteString("pointComponentType");
+  sink.WriteString(WasmComponentTypeFromIOComponentEnum( this->GetPointComponentType() ));
+  sink.WriteString("pointPixelType");
+  sink.WriteString(WasmPixelTypeFromIOPixelEnum( this->GetPointPixelType() ));
+  sink.WriteString("pointPixelComponentType");
+  sink.WriteString(WasmComponentTypeFromIOComponentEnum( this->GetPointPixelComponentType() ));
+  sink.WriteString("pointPixelComponents");
+  sink.WriteUInt(this->GetNumberOfPointPixelComponents());
+  sink.WriteString("cellComponentType");
+  sink.WriteString(WasmComponentTypeFromIOComponentEnum( this->GetCellComponentType() ));
+  sink.WriteString("cellPixelType");
+  sink.WriteString(WasmPixelTypeFromIOPixelEnum( this->GetCellPixelType() ));
+  sink.WriteString("cellPixelComponentType");
+  sink.WriteString(WasmComponentTypeFromIOComponentEnum( this->GetCellPixelComponentType() ));
+  sink.WriteString("cellPixelComponents");
+  sink.WriteUInt(this->GetNumberOfCellPixelComponents());
+
+  sink.WriteString("numberOfPoints");
+  sink.WriteUInt(this->GetNumberOfPoints());
+  sink.WriteString("numberOfPointPixels");
+  sink.WriteUInt(this->GetNumberOfPointPixels());
+  sink.WriteString("numberOfCells");
+  sink.WriteUInt(this->GetNumberOfCells());
+  sink.WriteString("numberOfCellPixels");
+  sink.WriteUInt(this->GetNumberOfCellPixels());
+  sink.WriteString("cellBufferSize");
+  sink.WriteUInt(this->GetCellBufferSize());
+
+  if (this->m_PayloadFilters.IsEnabled())
+  {
+    sink.WriteString("payloadFilters");
+    wasm::WritePayloadFilters(sink, this->m_PayloadFilters);
+  }
 }
 
 void
@@ -829,22 +1501,11 @@ WasmMeshIO
 
   if ( this->FileNameIsCBOR() )
   {
-    this->ReadCBORBuffer("points", buffer, numberOfBytesToBeRead);
+    this->ReadCBORBuffer("points", buffer, numberOfBytesToBeRead, this->GetPointComponentType(), this->GetPointDimension());
     return;
   }
 
-  std::ifstream dataStream;
-  const std::string path(this->GetFileName());
-  const std::string dataFile = path + "/data/points.raw";
-  this->OpenFileForReading( dataStream, dataFile.c_str() );
-
-  if ( !this->ReadBufferAsBinary( dataStream, buffer, numberOfBytesToBeRead ) )
-    {
-    itkExceptionMacro(<< "Read failed: Wanted "
-                      << numberOfBytesToBeRead
-                      << " bytes, but read "
-                      << dataStream.gcount() << " bytes.");
-    }
+  this->ReadDataFile("data/points.raw", buffer, numberOfBytesToBeRead);
 }
 
 
@@ -857,23 +1518,11 @@ WasmMeshIO
 
   if ( this->FileNameIsCBOR() )
   {
-    this->ReadCBORBuffer("cells", buffer, numberOfBytesToBeRead);
+    this->ReadCBORBuffer("cells", buffer, numberOfBytesToBeRead, this->GetCellComponentType(), 1);
     return;
   }
 
-  const std::string path(this->GetFileName());
-  const std::string dataPath = "data/cells.raw";
-  std::ifstream dataStream;
-  const std::string dataFile = path + "/" + dataPath;
-  this->OpenFileForReading( dataStream, dataFile.c_str() );
-
-  if ( !this->ReadBufferAsBinary( dataStream, buffer, numberOfBytesToBeRead ) )
-    {
-    itkExceptionMacro(<< "Read failed: Wanted "
-                      << numberOfBytesToBeRead
-                      << " bytes, but read "
-                      << dataStream.gcount() << " bytes.");
-    }
+  this->ReadDataFile("data/cells.raw", buffer, numberOfBytesToBeRead);
 }
 
 
@@ -886,23 +1535,11 @@ WasmMeshIO
 
   if ( this->FileNameIsCBOR() )
   {
-    this->ReadCBORBuffer("pointData", buffer, numberOfBytesToBeRead);
+    this->ReadCBORBuffer("pointData", buffer, numberOfBytesToBeRead, this->GetPointPixelComponentType(), this->GetNumberOfPointPixelComponents());
     return;
   }
 
-  const std::string path(this->GetFileName());
-  const std::string dataPath = "data/pointData.raw";
-  std::ifstream dataStream;
-  const std::string dataFile = path + "/" + dataPath;
-  this->OpenFileForReading( dataStream, dataFile.c_str() );
-
-  if ( !this->ReadBufferAsBinary( dataStream, buffer, numberOfBytesToBeRead ) )
-    {
-    itkExceptionMacro(<< "Read failed: Wanted "
-                      << numberOfBytesToBeRead
-                      << " bytes, but read "
-                      << dataStream.gcount() << " bytes.");
-    }
+  this->ReadDataFile("data/pointData.raw", buffer, numberOfBytesToBeRead);
 }
 
 
@@ -915,23 +1552,11 @@ WasmMeshIO
 
   if ( this->FileNameIsCBOR() )
   {
-    this->ReadCBORBuffer("cellData", buffer, numberOfBytesToBeRead);
+    this->ReadCBORBuffer("cellData", buffer, numberOfBytesToBeRead, this->GetCellPixelComponentType(), this->GetNumberOfCellPixelComponents());
     return;
   }
 
-  const std::string path(this->GetFileName());
-  const std::string dataPath = "data/cellData.raw";
-  std::ifstream dataStream;
-  const std::string dataFile = path + "/" + dataPath;
-  this->OpenFileForReading( dataStream, dataFile.c_str() );
-
-  if ( !this->ReadBufferAsBinary( dataStream, buffer, numberOfBytesToBeRead ) )
-    {
-    itkExceptionMacro(<< "Read failed: Wanted "
-                      << numberOfBytesToBeRead
-                      << " bytes, but read "
-                      << dataStream.gcount() << " bytes.");
-    }
+  this->ReadDataFile("data/cellData.raw", buffer, numberOfBytesToBeRead);
 }
 
 
@@ -1020,11 +1645,11 @@ void
 WasmMeshIO
 ::WritePoints( void *buffer )
 {
-  const SizeValueType numberOfBytes = this->GetNumberOfPoints() * this->GetPointDimension() * ITKComponentSize( this->GetPointComponentType() );
+  const SizeValueType numberOfBytes = this->GetPointsSizeInBytes();
 
   if (this->FileNameIsCBOR())
   {
-    this->WriteCBORBuffer( "points", buffer, numberOfBytes, this->GetPointComponentType() );
+    this->WriteCBORBuffer( "points", buffer, numberOfBytes, this->GetPointComponentType(), this->GetPointDimension() );
     return;
   }
 
@@ -1048,11 +1673,11 @@ void
 WasmMeshIO
 ::WriteCells( void *buffer )
 {
-  const SizeValueType numberOfBytes = this->GetCellBufferSize() * ITKComponentSize( this->GetCellComponentType() );
+  const SizeValueType numberOfBytes = this->GetCellsSizeInBytes();
 
   if (this->FileNameIsCBOR())
   {
-    this->WriteCBORBuffer( "cells", buffer, numberOfBytes, this->GetCellComponentType() );
+    this->WriteCBORBuffer( "cells", buffer, numberOfBytes, this->GetCellComponentType(), 1 );
     return;
   }
 
@@ -1076,11 +1701,11 @@ void
 WasmMeshIO
 ::WritePointData( void *buffer )
 {
-  const SizeValueType numberOfBytes = this->GetNumberOfPointPixels() * this->GetNumberOfPointPixelComponents() * ITKComponentSize( this->GetPointPixelComponentType() );
+  const SizeValueType numberOfBytes = this->GetPointDataSizeInBytes();
 
   if (this->FileNameIsCBOR())
   {
-    this->WriteCBORBuffer( "pointData", buffer, numberOfBytes, this->GetPointPixelComponentType() );
+    this->WriteCBORBuffer( "pointData", buffer, numberOfBytes, this->GetPointPixelComponentType(), this->GetNumberOfPointPixelComponents() );
     return;
   }
 
@@ -1104,11 +1729,11 @@ void
 WasmMeshIO
 ::WriteCellData( void *buffer )
 {
-  const SizeValueType numberOfBytes = this->GetNumberOfPointPixels() * this->GetNumberOfPointPixelComponents() * ITKComponentSize( this->GetCellPixelComponentType() );
+  const SizeValueType numberOfBytes = this->GetCellDataSizeInBytes();
 
   if (this->FileNameIsCBOR())
   {
-    this->WriteCBORBuffer( "cellData", buffer, numberOfBytes, this->GetCellPixelComponentType() );
+    this->WriteCBORBuffer( "cellData", buffer, numberOfBytes, this->GetCellPixelComponentType(), this->GetNumberOfCellPixelComponents() );
     return;
   }
 
@@ -1131,18 +1756,43 @@ void
 WasmMeshIO
 ::Write()
 {
+  if (this->FileNameIsAligned())
+    {
+    const bool complete = this->m_CBORBufferEntriesWritten == this->m_CBORBufferEntries;
+    this->m_CBOREncodedSize = 0;
+    if (!complete)
+      {
+      itkExceptionMacro("Not all of the typed arrays declared by WriteMeshInformation were written to " << this->GetFileName());
+      }
+    return;
+    }
   if (this->FileNameIsCBOR())
     {
-    unsigned char* cborBuffer;
-    size_t cborBufferSize;
-    size_t length = cbor_serialize_alloc(this->m_CBORRoot, &cborBuffer, &cborBufferSize);
-
-    FILE* file = fopen(this->GetFileName(), "wb");
-    fwrite(cborBuffer, 1, length, file);
-    free(cborBuffer);
-    fclose(file);
-
-    cbor_decref(&(this->m_CBORRoot));
+    this->OpenCBORSink();
+    const bool complete = this->m_CBORBufferEntriesWritten == this->m_CBORBufferEntries;
+    const bool written = this->m_CBORSink->Finish();
+    this->m_CBORSink.reset();
+    this->m_CBOREncodedSize = 0;
+    if (!complete)
+      {
+      itkExceptionMacro("Not all of the typed arrays declared by WriteMeshInformation were written to " << this->GetFileName());
+      }
+    if (!written)
+      {
+      itkExceptionMacro("Could not successfully write " << this->GetFileName());
+      }
+    if (this->FileNameIsBundle())
+      {
+      wasm::BundleMember member;
+      member.name = this->m_BundleMemberName.empty() ? std::to_string(this->m_BundleTableOfContents.members.size()) : this->m_BundleMemberName;
+      member.encoding = this->GetBundleMemberEncodingForWriting();
+      member.level = this->m_BundleMemberLevel;
+      member.bounds = this->m_BundleMemberBounds;
+      if (!wasm::EndBundleMember(this->GetFileName(), this->m_BundleTableOfContents, member))
+        {
+        itkExceptionMacro("Could not successfully write the table of contents of " << this->GetFileName());
+        }
+      }
     }
 }
 
@@ -0,0 +1,457 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmMeshReordering.h"
+#include "itkWasmMeshIO.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+
+// Size of the simulated LRU vertex cache
+constexpr size_t CacheSize = 32;
+constexpr uint64_t None = std::numeric_limits<uint64_t>::max();
+
+// Forsyth, "Linear-Speed Vertex Cache Optimisation", 2006
+float
+VertexScore(int64_t cachePosition, uint64_t remainingCells)
+{
+  if (remainingCells == 0)
+  {
+    return -1.0f;
+  }
+  float score = 0.0f;
+  if (cachePosition >= 0)
+  {
+    // The points of the last cell score the same, so its orientation does
+    // not matter
+    if (cachePosition < 3)
+    {
+      score = 0.75f;
+    }
+    else
+    {
+      const float scaled = 1.0f - static_cast<float>(cachePosition - 3) / static_cast<float>(CacheSize - 3);
+      score = std::pow(scaled, 1.5f);
+    }
+  }
+  // Points with few remaining cells are finished first
+  return score + 2.0f / std::sqrt(static_cast<float>(remainingCells));
+}
+
+// Offsets of the cell entries, [type, number of points, point ids...], and
+// of the end of the last one
+template <typename TId>
+std::vector<uint64_t>
+IndexCells(const TId * cells, uint64_t bufferSize, uint64_t numberOfCells, uint64_t numberOfPoints)
+{
+  std::vector<uint64_t> offsets;
+  offsets.reserve(numberOfCells + 1);
+  uint64_t offset = 0;
+  while (offsets.size() < numberOfCells)
+  {
+    if (bufferSize - offset < 2 || cells[offset + 1] > bufferSize - offset - 2)
+    {
+      throw std::runtime_error("Truncated cell buffer");
+    }
+    offsets.push_back(offset);
+    const uint64_t cellPoints = cells[offset + 1];
+    for (uint64_t ii = 0; ii < cellPoints; ++ii)
+    {
+      if (cells[offset + 2 + ii] >= numberOfPoints)
+      {
+        throw std::runtime_error("Cell point id out of range");
+      }
+    }
+    offset += 2 + cellPoints;
+  }
+  offsets.push_back(offset);
+  return offsets;
+}
+
+template <typename TId>
+std::vector<uint64_t>
+VertexCacheOrder(const TId * cells, const std::vector<uint64_t> & offsets, uint64_t numberOfPoints)
+{
+  const uint64_t numberOfCells = offsets.size() - 1;
+  const auto cellBegin = [&](uint64_t cell) { return cells + offsets[cell] + 2; };
+  const auto cellEnd = [&](uint64_t cell) { return cells + offsets[cell + 1]; };
+
+  // The cells not yet emitted of each point, first in adjacency
+  std::vector<uint64_t> remaining(numberOfPoints, 0);
+  for (uint64_t cell = 0; cell < numberOfCells; ++cell)
+  {
+    std::for_each(cellBegin(cell), cellEnd(cell), [&](TId point) { ++remaining[point]; });
+  }
+  std::vector<uint64_t> adjacencyOffsets(numberOfPoints + 1, 0);
+  for (uint64_t point = 0; point < numberOfPoints; ++point)
+  {
+    adjacencyOffsets[point + 1] = adjacencyOffsets[point] + remaining[point];
+  }
+  std::vector<uint64_t> adjacency(adjacencyOffsets.back());
+  {
+    std::vector<uint64_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (uint64_t cell = 0; cell < numberOfCells; ++cell)
+    {
+      std::for_each(cellBegin(cell), cellEnd(cell), [&](TId point) { adjacency[cursor[point]++] = cell; });
+    }
+  }
+
+  std::vector<int64_t> cachePosition(numberOfPoints, -1);
+  std::vector<float> pointScore(numberOfPoints);
+  for (uint64_t point = 0; point < numberOfPoints; ++point)
+  {
+    pointScore[point] = VertexScore(-1, remaining[point]);
+  }
+  std::vector<float> cellScore(numberOfCells, 0.0f);
+  for (uint64_t cell = 0; cell < numberOfCells; ++cell)
+  {
+    std::for_each(cellBegin(cell), cellEnd(cell), [&](TId point) { cellScore[cell] += pointScore[point]; });
+  }
+
+  std::vector<uint64_t> order;
+  order.reserve(numberOfCells);
+  std::vector<char> emitted(numberOfCells, 0);
+  std::vector<uint64_t> cache;
+  std::vector<uint64_t> nextCache;
+  std::vector<uint64_t> stamp(numberOfPoints, None);
+  uint64_t bestCell = None;
+  uint64_t cursor = 0;
+  while (order.size() < numberOfCells)
+  {
+    if (bestCell == None)
+    {
+      // No cell uses the cached points: continue with the next cell
+      while (emitted[cursor])
+      {
+        ++cursor;
+      }
+      bestCell = cursor;
+    }
+    const uint64_t cell = bestCell;
+    emitted[cell] = 1;
+    order.push_back(cell);
+
+    // The cell points move to the front of the cache
+    nextCache.clear();
+    for (const TId * point = cellBegin(cell); point != cellEnd(cell); ++point)
+    {
+      const auto begin = adjacency.begin() + adjacencyOffsets[*point];
+      const auto end = begin + remaining[*point];
+      std::iter_swap(std::find(begin, end, cell), end - 1);
+      --remaining[*point];
+      if (stamp[*point] != cell)
+      {
+        stamp[*point] = cell;
+        nextCache.push_back(*point);
+      }
+    }
+    for (const uint64_t point : cache)
+    {
+      if (stamp[point] != cell)
+      {
+        nextCache.push_back(point);
+      }
+    }
+
+    // Points past the cache size are evicted
+    for (size_t ii = 0; ii < nextCache.size(); ++ii)
+    {
+      const uint64_t point = nextCache[ii];
+      cachePosition[point] = ii < CacheSize ? static_cast<int64_t>(ii) : -1;
+      const float score = VertexScore(cachePosition[point], remaining[point]);
+      const float delta = score - pointScore[point];
+      pointScore[point] = score;
+      for (uint64_t jj = 0; jj < remaining[point]; ++jj)
+      {
+        cellScore[adjacency[adjacencyOffsets[point] + jj]] += delta;
+      }
+    }
+    nextCache.resize(std::min(nextCache.size(), CacheSize));
+    std::swap(cache, nextCache);
+
+    // The best cell that uses a cached point
+    bestCell = None;
+    float bestScore = std::numeric_limits<float>::lowest();
+    for (const uint64_t point : cache)
+    {
+      for (uint64_t jj = 0; jj < remaining[point]; ++jj)
+      {
+        const uint64_t candidate = adjacency[adjacencyOffsets[point] + jj];
+        if (cellScore[candidate] > bestScore)
+        {
+          bestScore = cellScore[candidate];
+          bestCell = candidate;
+        }
+      }
+    }
+  }
+  return order;
+}
+
+template <typename TId>
+std::vector<uint64_t>
+FirstUseOrder(const TId * cells, const std::vector<uint64_t> & offsets, uint64_t numberOfPoints)
+{
+  std::vector<uint64_t> order;
+  order.reserve(numberOfPoints);
+  std::vector<char> used(numberOfPoints, 0);
+  for (uint64_t cell = 0; cell + 1 < offsets.size(); ++cell)
+  {
+    for (uint64_t ii = offsets[cell] + 2; ii < offsets[cell + 1]; ++ii)
+    {
+      if (!used[cells[ii]])
+      {
+        used[cells[ii]] = 1;
+        order.push_back(cells[ii]);
+      }
+    }
+  }
+  for (uint64_t point = 0; point < numberOfPoints; ++point)
+  {
+    if (!used[point])
+    {
+      order.push_back(point);
+    }
+  }
+  return order;
+}
+
+template <typename TCoordinate>
+std::vector<uint64_t>
+MortonOrder(const TCoordinate * points, uint64_t numberOfPoints, unsigned int dimension)
+{
+  // The codes interleave up to 3 coordinates, at most 63 bits
+  const unsigned int dimensions = std::min(dimension, 3u);
+  const unsigned int bits = std::min(63u / std::max(dimensions, 1u), 21u);
+  std::vector<double> minimum(dimensions, std::numeric_limits<double>::max());
+  std::vector<double> maximum(dimensions, std::numeric_limits<double>::lowest());
+  for (uint64_t point = 0; point < numberOfPoints; ++point)
+  {
+    for (unsigned int dd = 0; dd < dimensions; ++dd)
+    {
+      minimum[dd] = std::min(minimum[dd], static_cast<double>(points[point * dimension + dd]));
+      maximum[dd] = std::max(maximum[dd], static_cast<double>(points[point * dimension + dd]));
+    }
+  }
+  const double levels = static_cast<double>((uint64_t{ 1 } << bits) - 1);
+
+  std::vector<std::pair<uint64_t, uint64_t>> codes(numberOfPoints);
+  for (uint64_t point = 0; point < numberOfPoints; ++point)
+  {
+    uint64_t cell[3] = { 0, 0, 0 };
+    for (unsigned int dd = 0; dd < dimensions; ++dd)
+    {
+      const double extent = maximum[dd] - minimum[dd];
+      const double scaled = extent > 0.0 ? (points[point * dimension + dd] - minimum[dd]) / extent : 0.0;
+      cell[dd] = static_cast<uint64_t>(std::clamp(scaled, 0.0, 1.0) * levels);
+    }
+    uint64_t code = 0;
+    for (unsigned int bit = bits; bit-- > 0;)
+    {
+      for (unsigned int dd = 0; dd < dimensions; ++dd)
+      {
+        code = (code << 1) | ((cell[dd] >> bit) & 1);
+      }
+    }
+    codes[point] = { code, point };
+  }
+  std::sort(codes.begin(), codes.end());
+
+  std::vector<uint64_t> order(numberOfPoints);
+  for (uint64_t point = 0; point < numberOfPoints; ++point)
+  {
+    order[point] = codes[point].second;
+  }
+  return order;
+}
+
+// Element ii of the result is element order[ii] of the buffer
+void
+PermuteElements(std::vector<char> & buffer, size_t elementSize, const std::vector<uint64_t> & order)
+{
+  std::vector<char> permuted(buffer.size());
+  for (uint64_t ii = 0; ii < order.size(); ++ii)
+  {
+    std::memcpy(permuted.data() + ii * elementSize, buffer.data() + order[ii] * elementSize, elementSize);
+  }
+  buffer.swap(permuted);
+}
+
+template <typename TId>
+void
+ReorderMesh(const MeshIOBase * meshIO,
+            bool optimizeVertexCache,
+            MeshPointOrder pointOrder,
+            std::vector<char> & points,
+            std::vector<char> & cells,
+            std::vector<char> & pointData,
+            std::vector<char> & cellData)
+{
+  const uint64_t numberOfPoints = meshIO->GetNumberOfPoints();
+  const uint64_t numberOfCells = meshIO->GetNumberOfCells();
+  const auto cellIds = reinterpret_cast<TId *>(cells.data());
+  const std::vector<uint64_t> offsets = IndexCells(cellIds, cells.size() / sizeof(TId), numberOfCells, numberOfPoints);
+
+  const size_t pointSize = WasmMeshIO::ITKComponentSize(meshIO->GetPointComponentType()) * meshIO->GetPointDimension();
+  const size_t pointPixelSize =
+    WasmMeshIO::ITKComponentSize(meshIO->GetPointPixelComponentType()) * meshIO->GetNumberOfPointPixelComponents();
+  const size_t cellPixelSize =
+    WasmMeshIO::ITKComponentSize(meshIO->GetCellPixelComponentType()) * meshIO->GetNumberOfCellPixelComponents();
+  const uint64_t numberOfPointPixels = pointData.empty() ? 0 : meshIO->GetNumberOfPointPixels();
+  const uint64_t numberOfCellPixels = cellData.empty() ? 0 : meshIO->GetNumberOfCellPixels();
+  const bool reorderCells = optimizeVertexCache && (numberOfCellPixels == 0 || numberOfCellPixels == numberOfCells);
+  const bool reorderPoints = pointOrder != MeshPointOrder::Input && points.size() == numberOfPoints * pointSize &&
+                             (numberOfPointPixels == 0 || numberOfPointPixels == numberOfPoints);
+
+  std::vector<uint64_t> cellOrder;
+  if (reorderCells)
+  {
+    cellOrder = VertexCacheOrder(cellIds, offsets, numberOfPoints);
+  }
+  else
+  {
+    cellOrder.resize(numberOfCells);
+    for (uint64_t cell = 0; cell < numberOfCells; ++cell)
+    {
+      cellOrder[cell] = cell;
+    }
+  }
+  // The cell buffer in the new cell order
+  std::vector<char> orderedCells(cells.size());
+  auto orderedIds = reinterpret_cast<TId *>(orderedCells.data());
+  for (const uint64_t cell : cellOrder)
+  {
+    orderedIds = std::copy(cellIds + offsets[cell], cellIds + offsets[cell + 1], orderedIds);
+  }
+  cells.swap(orderedCells);
+  if (reorderCells && numberOfCellPixels > 0)
+  {
+    PermuteElements(cellData, cellPixelSize, cellOrder);
+  }
+  if (!reorderPoints)
+  {
+    return;
+  }
+
+  std::vector<uint64_t> pointOrderIds;
+  const std::vector<uint64_t> orderedOffsets = IndexCells(reinterpret_cast<TId *>(cells.data()), cells.size() / sizeof(TId), numberOfCells, numberOfPoints);
+  if (pointOrder == MeshPointOrder::FirstUse)
+  {
+    pointOrderIds = FirstUseOrder(reinterpret_cast<TId *>(cells.data()), orderedOffsets, numberOfPoints);
+  }
+  else if (meshIO->GetPointComponentType() == IOComponentEnum::FLOAT)
+  {
+    pointOrderIds = MortonOrder(reinterpret_cast<const float *>(points.data()), numberOfPoints, meshIO->GetPointDimension());
+  }
+  else if (meshIO->GetPointComponentType() == IOComponentEnum::DOUBLE)
+  {
+    pointOrderIds = MortonOrder(reinterpret_cast<const double *>(points.data()), numberOfPoints, meshIO->GetPointDimension());
+  }
+  else
+  {
+    throw std::runtime_error("The Morton point order requires float or double points");
+  }
+
+  PermuteElements(points, pointSize, pointOrderIds);
+  if (numberOfPointPixels > 0)
+  {
+    PermuteElements(pointData, pointPixelSize, pointOrderIds);
+  }
+  std::vector<TId> newIds(numberOfPoints);
+  for (uint64_t point = 0; point < numberOfPoints; ++point)
+  {
+    newIds[pointOrderIds[point]] = static_cast<TId>(point);
+  }
+  auto ids = reinterpret_cast<TId *>(cells.data());
+  for (uint64_t cell = 0; cell < numberOfCells; ++cell)
+  {
+    for (uint64_t ii = orderedOffsets[cell] + 2; ii < orderedOffsets[cell + 1]; ++ii)
+    {
+      ids[ii] = newIds[ids[ii]];
+    }
+  }
+}
+
+} // end anonymous namespace
+
+
+MeshPointOrder
+MeshPointOrderFromString(std::string_view name)
+{
+  if (name == "input")
+  {
+    return MeshPointOrder::Input;
+  }
+  if (name == "first-use")
+  {
+    return MeshPointOrder::FirstUse;
+  }
+  if (name == "morton")
+  {
+    return MeshPointOrder::Morton;
+  }
+  throw std::runtime_error("Unknown point order: " + std::string(name));
+}
+
+
+void
+ReorderMesh(const MeshIOBase * meshIO,
+            bool optimizeVertexCache,
+            MeshPointOrder pointOrder,
+            std::vector<char> & points,
+            std::vector<char> & cells,
+            std::vector<char> & pointData,
+            std::vector<char> & cellData)
+{
+  if (!optimizeVertexCache && pointOrder == MeshPointOrder::Input)
+  {
+    return;
+  }
+  // The cell ids are unsigned integers of the cell component size
+  switch (WasmMeshIO::ITKComponentSize(meshIO->GetCellComponentType()))
+  {
+    case 1:
+      ReorderMesh<uint8_t>(meshIO, optimizeVertexCache, pointOrder, points, cells, pointData, cellData);
+      break;
+    case 2:
+      ReorderMesh<uint16_t>(meshIO, optimizeVertexCache, pointOrder, points, cells, pointData, cellData);
+      break;
+    case 4:
+      ReorderMesh<uint32_t>(meshIO, optimizeVertexCache, pointOrder, points, cells, pointData, cellData);
+      break;
+    case 8:
+      ReorderMesh<uint64_t>(meshIO, optimizeVertexCache, pointOrder, points, cells, pointData, cellData);
+      break;
+    default:
+      throw std::runtime_error("Unexpected cell component type");
+  }
+}
+
+} // end namespace wasm
+} // end namespace itk
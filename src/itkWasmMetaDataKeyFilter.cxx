@@ -0,0 +1,99 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmMetaDataKeyFilter.h"
+
+#include <algorithm>
+#include <string>
+
+namespace itk
+{
+namespace wasm
+{
+
+bool
+MetaDataKeyFilter::Accepts(std::string_view key) const
+{
+  const auto matchesKey = [key](const std::string & pattern) { return Matches(pattern, key); };
+  if (!m_IncludePatterns.empty() && std::none_of(m_IncludePatterns.begin(), m_IncludePatterns.end(), matchesKey))
+  {
+    return false;
+  }
+  return std::none_of(m_ExcludePatterns.begin(), m_ExcludePatterns.end(), matchesKey);
+}
+
+void
+MetaDataKeyFilter::Apply(MetaDataDictionary & dictionary) const
+{
+  if (!this->IsEnabled())
+  {
+    return;
+  }
+  std::vector<std::string> rejectedKeys;
+  for (auto itr = dictionary.Begin(); itr != dictionary.End(); ++itr)
+  {
+    if (!this->Accepts(itr->first))
+    {
+      rejectedKeys.push_back(itr->first);
+    }
+  }
+  for (const std::string & key : rejectedKeys)
+  {
+    dictionary.Erase(key);
+  }
+}
+
+bool
+MetaDataKeyFilter::Matches(std::string_view pattern, std::string_view key)
+{
+  // Greedy matching that only backtracks to the last `*`, without recursion
+  size_t patternPosition = 0;
+  size_t keyPosition = 0;
+  size_t starPosition = std::string_view::npos;
+  size_t starKeyPosition = 0;
+  while (keyPosition < key.size())
+  {
+    if (patternPosition < pattern.size() && pattern[patternPosition] == '*')
+    {
+      starPosition = patternPosition++;
+      starKeyPosition = keyPosition;
+    }
+    else if (patternPosition < pattern.size() && (pattern[patternPosition] == '?' || pattern[patternPosition] == key[keyPosition]))
+    {
+      ++patternPosition;
+      ++keyPosition;
+    }
+    else if (starPosition != std::string_view::npos)
+    {
+      // The last `*` matches one more character
+      patternPosition = starPosition + 1;
+      keyPosition = ++starKeyPosition;
+    }
+    else
+    {
+      return false;
+    }
+  }
+  while (patternPosition < pattern.size() && pattern[patternPosition] == '*')
+  {
+    ++patternPosition;
+  }
+  return patternPosition == pattern.size();
+}
+
+} // end namespace wasm
+} // end namespace itk
@@ -0,0 +1,698 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmPayloadFilter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+
+// The loops over a compile-time element size are vectorized by the compiler,
+// including for the wasm simd128 target.
+template <size_t TSize>
+void
+ShuffleBytes(const unsigned char * input, unsigned char * output, size_t numberOfElements)
+{
+  for (size_t byte = 0; byte < TSize; ++byte)
+  {
+    unsigned char * plane = output + byte * numberOfElements;
+    for (size_t ii = 0; ii < numberOfElements; ++ii)
+    {
+      plane[ii] = input[ii * TSize + byte];
+    }
+  }
+}
+
+template <size_t TSize>
+void
+UnshuffleBytes(const unsigned char * input, unsigned char * output, size_t numberOfElements)
+{
+  for (size_t byte = 0; byte < TSize; ++byte)
+  {
+    const unsigned char * plane = input + byte * numberOfElements;
+    for (size_t ii = 0; ii < numberOfElements; ++ii)
+    {
+      output[ii * TSize + byte] = plane[ii];
+    }
+  }
+}
+
+void
+ShuffleBytes(size_t componentSize, const unsigned char * input, unsigned char * output, size_t size)
+{
+  const size_t numberOfElements = size / componentSize;
+  switch (componentSize)
+  {
+    case 2:
+      ShuffleBytes<2>(input, output, numberOfElements);
+      break;
+    case 4:
+      ShuffleBytes<4>(input, output, numberOfElements);
+      break;
+    case 8:
+      ShuffleBytes<8>(input, output, numberOfElements);
+      break;
+    default:
+      std::memcpy(output, input, size);
+  }
+}
+
+void
+UnshuffleBytes(size_t componentSize, const unsigned char * input, unsigned char * output, size_t size)
+{
+  const size_t numberOfElements = size / componentSize;
+  switch (componentSize)
+  {
+    case 2:
+      UnshuffleBytes<2>(input, output, numberOfElements);
+      break;
+    case 4:
+      UnshuffleBytes<4>(input, output, numberOfElements);
+      break;
+    case 8:
+      UnshuffleBytes<8>(input, output, numberOfElements);
+      break;
+    default:
+      std::memcpy(output, input, size);
+  }
+}
+
+// Transpose the 8x8 bit matrix of 8 bytes, Hacker's Delight 7-3. The
+// transpose is its own inverse.
+inline uint64_t
+TransposeBits(uint64_t x)
+{
+  uint64_t t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull;
+  x = x ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull;
+  x = x ^ t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull;
+  x = x ^ t ^ (t << 28);
+  return x;
+}
+
+// Split each byte plane of planeSize bytes into eight bit planes. Bytes past
+// the last multiple of 8 are copied.
+void
+ShuffleBits(const unsigned char * input, unsigned char * output, size_t size, size_t planeSize)
+{
+  const size_t groups = planeSize / 8;
+  for (size_t planeStart = 0; planeStart < size; planeStart += planeSize)
+  {
+    const unsigned char * plane = input + planeStart;
+    unsigned char * bitPlanes = output + planeStart;
+    for (size_t group = 0; group < groups; ++group)
+    {
+      uint64_t bits = 0;
+      for (size_t ii = 0; ii < 8; ++ii)
+      {
+        bits |= static_cast<uint64_t>(plane[group * 8 + ii]) << (8 * ii);
+      }
+      bits = TransposeBits(bits);
+      for (size_t ii = 0; ii < 8; ++ii)
+      {
+        bitPlanes[ii * groups + group] = static_cast<unsigned char>(bits >> (8 * ii));
+      }
+    }
+    std::memcpy(bitPlanes + groups * 8, plane + groups * 8, planeSize - groups * 8);
+  }
+}
+
+void
+UnshuffleBits(const unsigned char * input, unsigned char * output, size_t size, size_t planeSize)
+{
+  const size_t groups = planeSize / 8;
+  for (size_t planeStart = 0; planeStart < size; planeStart += planeSize)
+  {
+    const unsigned char * bitPlanes = input + planeStart;
+    unsigned char * plane = output + planeStart;
+    for (size_t group = 0; group < groups; ++group)
+    {
+      uint64_t bits = 0;
+      for (size_t ii = 0; ii < 8; ++ii)
+      {
+        bits |= static_cast<uint64_t>(bitPlanes[ii * groups + group]) << (8 * ii);
+      }
+      bits = TransposeBits(bits);
+      for (size_t ii = 0; ii < 8; ++ii)
+      {
+        plane[group * 8 + ii] = static_cast<unsigned char>(bits >> (8 * ii));
+      }
+    }
+    std::memcpy(plane + groups * 8, bitPlanes + groups * 8, planeSize - groups * 8);
+  }
+}
+
+template <typename TComponent>
+void
+EncodeDeltaComponents(const PayloadLayout & layout, const void * payload, uint64_t first, size_t count, void * output)
+{
+  const auto components = static_cast<const TComponent *>(payload);
+  auto deltas = static_cast<TComponent *>(output);
+  const uint64_t stride = layout.components;
+  uint64_t index = first;
+  const uint64_t end = first + count;
+  while (index < end)
+  {
+    const uint64_t rowStart = index - index % layout.rowLength;
+    const uint64_t rowEnd = std::min(end, rowStart + layout.rowLength);
+    // Components of the first element of a row are stored as is
+    for (; index < rowEnd && index < rowStart + stride; ++index)
+    {
+      deltas[index - first] = components[index];
+    }
+    for (; index < rowEnd; ++index)
+    {
+      deltas[index - first] = static_cast<TComponent>(components[index] - components[index - stride]);
+    }
+  }
+}
+
+template <typename TComponent>
+void
+DecodeDeltaComponents(const PayloadLayout & layout, void * payload, uint64_t firstRow, uint64_t numberOfRows)
+{
+  auto components = static_cast<TComponent *>(payload);
+  const uint64_t stride = layout.components;
+  for (uint64_t row = firstRow; row < firstRow + numberOfRows; ++row)
+  {
+    TComponent * rowComponents = components + row * layout.rowLength;
+    for (uint64_t ii = stride; ii < layout.rowLength; ++ii)
+    {
+      rowComponents[ii] = static_cast<TComponent>(rowComponents[ii] + rowComponents[ii - stride]);
+    }
+  }
+}
+
+void
+EncodeDelta(const PayloadLayout & layout, const void * payload, uint64_t offset, size_t size, void * output)
+{
+  const uint64_t first = offset / layout.componentSize;
+  const size_t count = size / layout.componentSize;
+  switch (layout.componentSize)
+  {
+    case 1:
+      EncodeDeltaComponents<uint8_t>(layout, payload, first, count, output);
+      break;
+    case 2:
+      EncodeDeltaComponents<uint16_t>(layout, payload, first, count, output);
+      break;
+    case 4:
+      EncodeDeltaComponents<uint32_t>(layout, payload, first, count, output);
+      break;
+    case 8:
+      EncodeDeltaComponents<uint64_t>(layout, payload, first, count, output);
+      break;
+  }
+}
+
+// Bytes of the count that precedes the element of a run
+constexpr size_t RunCountSize = 4;
+
+// The end of the run of elements equal to the element at start, within limit
+template <typename TElement>
+uint64_t
+RunEnd(const unsigned char * bytes, uint64_t start, uint64_t limit)
+{
+  TElement element;
+  std::memcpy(&element, bytes + start * sizeof(TElement), sizeof(TElement));
+  uint64_t end = start + 1;
+  for (; end < limit; ++end)
+  {
+    TElement other;
+    std::memcpy(&other, bytes + end * sizeof(TElement), sizeof(TElement));
+    if (other != element)
+    {
+      break;
+    }
+  }
+  return end;
+}
+
+// Call runFunction with the first element and the count of each run
+template <typename TRunFunction>
+void
+ForEachPayloadRun(const PayloadLayout & layout, const void * payload, uint64_t size, TRunFunction && runFunction)
+{
+  const auto bytes = static_cast<const unsigned char *>(payload);
+  const size_t elementSize = layout.componentSize * layout.components;
+  const uint64_t numberOfElements = size / elementSize;
+  constexpr uint64_t maximumCount = std::numeric_limits<uint32_t>::max();
+  uint64_t start = 0;
+  while (start < numberOfElements)
+  {
+    const uint64_t limit = std::min(numberOfElements, start + maximumCount);
+    uint64_t end = start + 1;
+    switch (elementSize)
+    {
+      case 1:
+        end = RunEnd<uint8_t>(bytes, start, limit);
+        break;
+      case 2:
+        end = RunEnd<uint16_t>(bytes, start, limit);
+        break;
+      case 4:
+        end = RunEnd<uint32_t>(bytes, start, limit);
+        break;
+      case 8:
+        end = RunEnd<uint64_t>(bytes, start, limit);
+        break;
+      default:
+        while (end < limit && std::memcmp(bytes + end * elementSize, bytes + start * elementSize, elementSize) == 0)
+        {
+          ++end;
+        }
+    }
+    runFunction(bytes + start * elementSize, static_cast<uint32_t>(end - start));
+    start = end;
+  }
+}
+
+} // end anonymous namespace
+
+
+const char *
+GetPayloadCodecName(PayloadCodec codec)
+{
+  switch (codec)
+  {
+    case PayloadCodec::HTJ2K:
+      return "htj2k";
+    case PayloadCodec::JPEGXL:
+      return "jpegxl";
+    default:
+      return "none";
+  }
+}
+
+
+PayloadFilters
+AutomaticPayloadFilters(size_t componentSize)
+{
+  PayloadFilters filters;
+  if (componentSize > 1)
+  {
+    filters.shuffle = PayloadShuffle::Byte;
+  }
+  return filters;
+}
+
+
+void
+ValidatePayloadFilters(const PayloadFilters & filters, const PayloadLayout & layout)
+{
+  if (!filters.IsEnabled())
+  {
+    return;
+  }
+  const size_t componentSize = layout.componentSize;
+  if (componentSize != 1 && componentSize != 2 && componentSize != 4 && componentSize != 8)
+  {
+    throw std::runtime_error("Payload filters require 1, 2, 4 or 8 byte components");
+  }
+  if (filters.runLength && (filters.delta || filters.shuffle != PayloadShuffle::None))
+  {
+    throw std::runtime_error("The runLength payload filter is not combined with other filters");
+  }
+  if (filters.codec != PayloadCodec::None && (filters.delta || filters.shuffle != PayloadShuffle::None || filters.runLength))
+  {
+    throw std::runtime_error("The payload codec is not combined with other filters");
+  }
+  if (filters.codec != PayloadCodec::None && (componentSize > 2 || layout.components == 0))
+  {
+    throw std::runtime_error(std::string("The ") + GetPayloadCodecName(filters.codec) + " payload codec requires 8 or 16 bit integer components");
+  }
+  if (filters.runLength && layout.components == 0)
+  {
+    throw std::runtime_error("The runLength payload filter requires elements with components");
+  }
+  if (filters.blockSize == 0 || filters.blockSize % componentSize != 0)
+  {
+    throw std::runtime_error("The payload filter block size must be a multiple of the component size");
+  }
+  if (filters.delta && (layout.components == 0 || layout.rowLength == 0 || layout.rowLength % layout.components != 0))
+  {
+    throw std::runtime_error("The delta payload filter requires rows of whole elements");
+  }
+}
+
+
+void
+EncodePayloadBlock(const PayloadFilters & filters,
+                   const PayloadLayout & layout,
+                   const void * payload,
+                   uint64_t offset,
+                   size_t size,
+                   void * output,
+                   std::vector<unsigned char> & scratch)
+{
+  const unsigned char * input = static_cast<const unsigned char *>(payload) + offset;
+  auto outputBytes = static_cast<unsigned char *>(output);
+  // The deltas, then the byte planes of a bit shuffle
+  const size_t scratchSize = (filters.delta ? size : 0) + (filters.shuffle == PayloadShuffle::Bit ? size : 0);
+  scratch.resize(std::max(scratch.size(), scratchSize));
+  if (filters.delta)
+  {
+    unsigned char * deltas = filters.shuffle != PayloadShuffle::None ? scratch.data() : outputBytes;
+    EncodeDelta(layout, payload, offset, size, deltas);
+    input = deltas;
+  }
+
+  switch (filters.shuffle)
+  {
+    case PayloadShuffle::None:
+      if (input != outputBytes)
+      {
+        std::memcpy(outputBytes, input, size);
+      }
+      break;
+    case PayloadShuffle::Byte:
+      ShuffleBytes(layout.componentSize, input, outputBytes, size);
+      break;
+    case PayloadShuffle::Bit:
+    {
+      unsigned char * bytePlanes = scratch.data() + (filters.delta ? size : 0);
+      ShuffleBytes(layout.componentSize, input, bytePlanes, size);
+      ShuffleBits(bytePlanes, outputBytes, size, size / layout.componentSize);
+      break;
+    }
+  }
+}
+
+
+void
+DecodePayloadBlock(const PayloadFilters & filters,
+                   const PayloadLayout & layout,
+                   void * block,
+                   size_t size,
+                   std::vector<unsigned char> & scratch)
+{
+  auto blockBytes = static_cast<unsigned char *>(block);
+  switch (filters.shuffle)
+  {
+    case PayloadShuffle::None:
+      break;
+    case PayloadShuffle::Byte:
+      scratch.resize(std::max(scratch.size(), size));
+      std::memcpy(scratch.data(), blockBytes, size);
+      UnshuffleBytes(layout.componentSize, scratch.data(), blockBytes, size);
+      break;
+    case PayloadShuffle::Bit:
+      scratch.resize(std::max(scratch.size(), size));
+      UnshuffleBits(blockBytes, scratch.data(), size, size / layout.componentSize);
+      UnshuffleBytes(layout.componentSize, scratch.data(), blockBytes, size);
+      break;
+  }
+}
+
+
+void
+DecodePayloadRows(const PayloadFilters & filters,
+                  const PayloadLayout & layout,
+                  void * payload,
+                  uint64_t firstRow,
+                  uint64_t numberOfRows)
+{
+  if (!filters.delta)
+  {
+    return;
+  }
+  switch (layout.componentSize)
+  {
+    case 1:
+      DecodeDeltaComponents<uint8_t>(layout, payload, firstRow, numberOfRows);
+      break;
+    case 2:
+      DecodeDeltaComponents<uint16_t>(layout, payload, firstRow, numberOfRows);
+      break;
+    case 4:
+      DecodeDeltaComponents<uint32_t>(layout, payload, firstRow, numberOfRows);
+      break;
+    case 8:
+      DecodeDeltaComponents<uint64_t>(layout, payload, firstRow, numberOfRows);
+      break;
+  }
+}
+
+
+void
+DecodePayload(const PayloadFilters & filters, const PayloadLayout & layout, void * payload, uint64_t size)
+{
+  if (!filters.IsEnabled())
+  {
+    return;
+  }
+  std::vector<unsigned char> scratch;
+  auto payloadBytes = static_cast<unsigned char *>(payload);
+  for (uint64_t offset = 0; offset < size; offset += filters.blockSize)
+  {
+    const size_t blockSize = static_cast<size_t>(std::min<uint64_t>(filters.blockSize, size - offset));
+    DecodePayloadBlock(filters, layout, payloadBytes + offset, blockSize, scratch);
+  }
+  const uint64_t rowSize = layout.rowLength * layout.componentSize;
+  DecodePayloadRows(filters, layout, payload, 0, rowSize > 0 ? size / rowSize : 0);
+}
+
+
+uint64_t
+GetPayloadRunsSize(const PayloadLayout & layout, const void * payload, uint64_t size)
+{
+  const size_t runSize = RunCountSize + layout.componentSize * layout.components;
+  uint64_t numberOfRuns = 0;
+  ForEachPayloadRun(layout, payload, size, [&](const unsigned char *, uint32_t) { ++numberOfRuns; });
+  return numberOfRuns * runSize;
+}
+
+
+void
+EncodePayloadRuns(CBORSink & sink, const PayloadLayout & layout, const void * payload, uint64_t size)
+{
+  const size_t elementSize = layout.componentSize * layout.components;
+  // Runs are written to the sink in pieces of about 64 kB
+  std::vector<unsigned char> piece;
+  piece.reserve(64 * 1024 + RunCountSize + elementSize);
+  ForEachPayloadRun(layout, payload, size, [&](const unsigned char * element, uint32_t count) {
+    const unsigned char countBytes[RunCountSize] = { static_cast<unsigned char>(count),
+                                                     static_cast<unsigned char>(count >> 8),
+                                                     static_cast<unsigned char>(count >> 16),
+                                                     static_cast<unsigned char>(count >> 24) };
+    piece.insert(piece.end(), countBytes, countBytes + RunCountSize);
+    piece.insert(piece.end(), element, element + elementSize);
+    if (piece.size() >= 64 * 1024)
+    {
+      sink.WriteByteStringContent(piece.data(), piece.size());
+      piece.clear();
+    }
+  });
+  sink.WriteByteStringContent(piece.data(), piece.size());
+}
+
+
+PayloadRunDecoder::PayloadRunDecoder(const PayloadLayout & layout, void * payload, uint64_t size)
+  : m_Payload(static_cast<unsigned char *>(payload))
+  , m_Size(size)
+  , m_ElementSize(layout.componentSize * layout.components)
+  , m_Run(RunCountSize + layout.componentSize * layout.components)
+{}
+
+
+bool
+PayloadRunDecoder::Decode(const void * encoded, size_t size)
+{
+  auto bytes = static_cast<const unsigned char *>(encoded);
+  const size_t runSize = m_Run.size();
+  while (size > 0)
+  {
+    if (m_Pending == 0 && size >= runSize)
+    {
+      // Whole runs are filled from the encoded bytes
+      if (!this->FillRun(bytes))
+      {
+        return false;
+      }
+      bytes += runSize;
+      size -= runSize;
+      continue;
+    }
+
+    // A run split between pieces is gathered first
+    const size_t copied = std::min(size, runSize - m_Pending);
+    std::memcpy(m_Run.data() + m_Pending, bytes, copied);
+    m_Pending += copied;
+    bytes += copied;
+    size -= copied;
+    if (m_Pending == runSize)
+    {
+      m_Pending = 0;
+      if (!this->FillRun(m_Run.data()))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+
+bool
+PayloadRunDecoder::FillRun(const unsigned char * run)
+{
+  const uint64_t count = static_cast<uint64_t>(run[0]) | (static_cast<uint64_t>(run[1]) << 8) |
+                         (static_cast<uint64_t>(run[2]) << 16) | (static_cast<uint64_t>(run[3]) << 24);
+  const unsigned char * element = run + RunCountSize;
+  const uint64_t runBytes = count * m_ElementSize;
+  if (runBytes > m_Size - m_Offset)
+  {
+    return false;
+  }
+  unsigned char * output = m_Payload + m_Offset;
+  if (m_ElementSize == 1)
+  {
+    std::memset(output, *element, static_cast<size_t>(runBytes));
+  }
+  else if (runBytes > 0)
+  {
+    // The filled prefix of the run is copied onto the rest, doubling
+    std::memcpy(output, element, m_ElementSize);
+    uint64_t filled = m_ElementSize;
+    while (filled < runBytes)
+    {
+      const uint64_t copied = std::min(filled, runBytes - filled);
+      std::memcpy(output + filled, output, static_cast<size_t>(copied));
+      filled += copied;
+    }
+  }
+  m_Offset += runBytes;
+  return true;
+}
+
+
+void
+WritePayloadFilters(CBORSink & sink, const PayloadFilters & filters)
+{
+  const size_t numberOfFilters =
+    (filters.delta ? 1 : 0) + (filters.shuffle != PayloadShuffle::None ? 1 : 0) + (filters.runLength ? 1 : 0);
+  const bool withCodec = filters.codec != PayloadCodec::None;
+  sink.WriteMap(withCodec ? 3 : 2);
+  sink.WriteString("filters");
+  sink.WriteArray(numberOfFilters);
+  if (filters.runLength)
+  {
+    sink.WriteString("runLength");
+  }
+  if (filters.delta)
+  {
+    sink.WriteString("delta");
+  }
+  if (filters.shuffle == PayloadShuffle::Byte)
+  {
+    sink.WriteString("shuffle");
+  }
+  else if (filters.shuffle == PayloadShuffle::Bit)
+  {
+    sink.WriteString("bitshuffle");
+  }
+  sink.WriteString("blockSize");
+  sink.WriteUInt(filters.blockSize);
+  if (withCodec)
+  {
+    sink.WriteString("codec");
+    sink.WriteString(GetPayloadCodecName(filters.codec));
+  }
+}
+
+
+PayloadFilters
+ReadPayloadFilters(const cbor_item_t * item)
+{
+  if (!cbor_isa_map(item))
+  {
+    throw std::runtime_error("Expected a payloadFilters cbor map");
+  }
+  PayloadFilters filters;
+  const size_t count = cbor_map_size(item);
+  const struct cbor_pair * handle = cbor_map_handle(item);
+  for (size_t ii = 0; ii < count; ++ii)
+  {
+    const std::string_view key(reinterpret_cast<char *>(cbor_string_handle(handle[ii].key)), cbor_string_length(handle[ii].key));
+    if (key == "filters")
+    {
+      const size_t numberOfFilters = cbor_array_size(handle[ii].value);
+      cbor_item_t ** filterHandle = cbor_array_handle(handle[ii].value);
+      for (size_t jj = 0; jj < numberOfFilters; ++jj)
+      {
+        const std::string_view name(reinterpret_cast<char *>(cbor_string_handle(filterHandle[jj])), cbor_string_length(filterHandle[jj]));
+        // The delta is applied before the shuffle
+        if (name == "delta" && jj == 0)
+        {
+          filters.delta = true;
+        }
+        else if (name == "shuffle" && filters.shuffle == PayloadShuffle::None)
+        {
+          filters.shuffle = PayloadShuffle::Byte;
+        }
+        else if (name == "bitshuffle" && filters.shuffle == PayloadShuffle::None)
+        {
+          filters.shuffle = PayloadShuffle::Bit;
+        }
+        else if (name == "runLength" && numberOfFilters == 1)
+        {
+          filters.runLength = true;
+        }
+        else
+        {
+          throw std::runtime_error("Unexpected payload filter: " + std::string(name));
+        }
+      }
+    }
+    else if (key == "blockSize")
+    {
+      filters.blockSize = static_cast<size_t>(cbor_get_int(handle[ii].value));
+    }
+    else if (key == "codec")
+    {
+      const std::string_view name(reinterpret_cast<char *>(cbor_string_handle(handle[ii].value)), cbor_string_length(handle[ii].value));
+      if (name == GetPayloadCodecName(PayloadCodec::HTJ2K))
+      {
+        filters.codec = PayloadCodec::HTJ2K;
+      }
+      else if (name == GetPayloadCodecName(PayloadCodec::JPEGXL))
+      {
+        filters.codec = PayloadCodec::JPEGXL;
+      }
+      else
+      {
+        throw std::runtime_error("Unexpected payload codec: " + std::string(name));
+      }
+    }
+  }
+  return filters;
+}
+
+} // end namespace wasm
+} // end namespace itk
@@ -0,0 +1,300 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmQuantization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+
+double
+Step(const Quantization & quantization, size_t component, double levels)
+{
+  return (quantization.maximum[component] - quantization.minimum[component]) / levels;
+}
+
+template <typename TValue>
+void
+ComputeBounds(const TValue * values, uint64_t numberOfValues, Quantization & quantization)
+{
+  const size_t components = quantization.minimum.size();
+  for (uint64_t ii = 0; ii < numberOfValues; ++ii)
+  {
+    const size_t component = ii % components;
+    const double value = values[ii];
+    quantization.minimum[component] = std::min(quantization.minimum[component], value);
+    quantization.maximum[component] = std::max(quantization.maximum[component], value);
+  }
+}
+
+template <typename TValue, typename TQuantized>
+void
+QuantizeValues(const Quantization & quantization, const TValue * values, uint64_t numberOfValues, TQuantized * quantized)
+{
+  const size_t components = quantization.minimum.size();
+  constexpr double levels = static_cast<double>(std::numeric_limits<TQuantized>::max());
+  std::vector<double> inverseSteps(components);
+  for (size_t component = 0; component < components; ++component)
+  {
+    const double step = Step(quantization, component, levels);
+    inverseSteps[component] = step > 0.0 ? 1.0 / step : 0.0;
+  }
+  for (uint64_t element = 0; element < numberOfValues; element += components)
+  {
+    for (size_t component = 0; component < components; ++component)
+    {
+      const double level = (values[element + component] - quantization.minimum[component]) * inverseSteps[component];
+      quantized[element + component] = static_cast<TQuantized>(std::clamp(std::round(level), 0.0, levels));
+    }
+  }
+}
+
+// Chunks of the quantized components are copied out before their values
+// are written, last chunk first, since the values are at least as large and
+// overwrite the quantized components of their own and later chunks only.
+// The forward loop over a chunk is vectorized by the compiler.
+template <typename TValue, typename TQuantized>
+void
+DequantizeValues(const Quantization & quantization, void * buffer, uint64_t numberOfValues)
+{
+  const size_t components = quantization.minimum.size();
+  constexpr double levels = static_cast<double>(std::numeric_limits<TQuantized>::max());
+  std::vector<double> steps(components);
+  for (size_t component = 0; component < components; ++component)
+  {
+    steps[component] = Step(quantization, component, levels);
+  }
+  // A whole number of elements
+  const uint64_t chunkSize = 16384 * components;
+  std::vector<TQuantized> chunk(static_cast<size_t>(std::min(chunkSize, numberOfValues)));
+  auto values = static_cast<TValue *>(buffer);
+  const auto quantized = static_cast<const TQuantized *>(buffer);
+  const uint64_t numberOfChunks = (numberOfValues + chunkSize - 1) / chunkSize;
+  for (uint64_t chunkIndex = numberOfChunks; chunkIndex-- > 0;)
+  {
+    const uint64_t first = chunkIndex * chunkSize;
+    const auto count = static_cast<size_t>(std::min(chunkSize, numberOfValues - first));
+    std::memcpy(chunk.data(), quantized + first, count * sizeof(TQuantized));
+    for (size_t element = 0; element < count; element += components)
+    {
+      for (size_t component = 0; component < components; ++component)
+      {
+        values[first + element + component] = static_cast<TValue>(quantization.minimum[component] + chunk[element + component] * steps[component]);
+      }
+    }
+  }
+}
+
+template <typename TValue>
+void
+QuantizeValues(const Quantization & quantization, const void * values, uint64_t numberOfValues, void * quantized)
+{
+  if (quantization.bits == 16)
+  {
+    QuantizeValues(quantization, static_cast<const TValue *>(values), numberOfValues, static_cast<uint16_t *>(quantized));
+  }
+  else
+  {
+    QuantizeValues(quantization, static_cast<const TValue *>(values), numberOfValues, static_cast<uint32_t *>(quantized));
+  }
+}
+
+template <typename TValue>
+void
+DequantizeValues(const Quantization & quantization, void * buffer, uint64_t numberOfValues)
+{
+  if (quantization.bits == 16)
+  {
+    DequantizeValues<TValue, uint16_t>(quantization, buffer, numberOfValues);
+  }
+  else
+  {
+    DequantizeValues<TValue, uint32_t>(quantization, buffer, numberOfValues);
+  }
+}
+
+void
+ValidateQuantization(const Quantization & quantization, size_t componentSize, uint64_t numberOfValues)
+{
+  if (quantization.bits != 16 && quantization.bits != 32)
+  {
+    throw std::runtime_error("Quantization requires 16 or 32 bits");
+  }
+  if (componentSize != sizeof(float) && componentSize != sizeof(double))
+  {
+    throw std::runtime_error("Quantization requires float or double components");
+  }
+  const size_t components = quantization.minimum.size();
+  if (components == 0 || quantization.maximum.size() != components || numberOfValues % components != 0)
+  {
+    throw std::runtime_error("The quantization bounds do not match the components");
+  }
+}
+
+} // end anonymous namespace
+
+
+Quantization
+ComputeQuantization(unsigned int bits, size_t componentSize, unsigned int components, const void * values, uint64_t numberOfValues)
+{
+  Quantization quantization;
+  quantization.bits = bits;
+  quantization.minimum.assign(components, std::numeric_limits<double>::max());
+  quantization.maximum.assign(components, std::numeric_limits<double>::lowest());
+  ValidateQuantization(quantization, componentSize, numberOfValues);
+  if (componentSize == sizeof(float))
+  {
+    ComputeBounds(static_cast<const float *>(values), numberOfValues, quantization);
+  }
+  else
+  {
+    ComputeBounds(static_cast<const double *>(values), numberOfValues, quantization);
+  }
+  for (size_t component = 0; component < components; ++component)
+  {
+    if (quantization.minimum[component] > quantization.maximum[component])
+    {
+      // No values
+      quantization.minimum[component] = 0.0;
+      quantization.maximum[component] = 0.0;
+    }
+  }
+  return quantization;
+}
+
+
+double
+QuantizationError(const Quantization & quantization)
+{
+  const double levels = quantization.bits == 16 ? 65535.0 : 4294967295.0;
+  double error = 0.0;
+  for (size_t component = 0; component < quantization.minimum.size(); ++component)
+  {
+    error = std::max(error, 0.5 * Step(quantization, component, levels));
+  }
+  return error;
+}
+
+
+void
+Quantize(const Quantization & quantization, size_t componentSize, const void * values, uint64_t numberOfValues, void * quantized)
+{
+  ValidateQuantization(quantization, componentSize, numberOfValues);
+  if (componentSize == sizeof(float))
+  {
+    QuantizeValues<float>(quantization, values, numberOfValues, quantized);
+  }
+  else
+  {
+    QuantizeValues<double>(quantization, values, numberOfValues, quantized);
+  }
+}
+
+
+void
+Dequantize(const Quantization & quantization, size_t componentSize, void * buffer, uint64_t numberOfValues)
+{
+  ValidateQuantization(quantization, componentSize, numberOfValues);
+  if (componentSize == sizeof(float))
+  {
+    DequantizeValues<float>(quantization, buffer, numberOfValues);
+  }
+  else
+  {
+    DequantizeValues<double>(quantization, buffer, numberOfValues);
+  }
+}
+
+
+void
+WriteQuantization(CBORSink & sink, const Quantization & quantization)
+{
+  sink.WriteMap(3);
+  sink.WriteString("bits");
+  sink.WriteUInt(quantization.bits);
+  sink.WriteString("minimum");
+  sink.WriteArray(quantization.minimum.size());
+  for (const double value : quantization.minimum)
+  {
+    sink.WriteDouble(value);
+  }
+  sink.WriteString("maximum");
+  sink.WriteArray(quantization.maximum.size());
+  for (const double value : quantization.maximum)
+  {
+    sink.WriteDouble(value);
+  }
+}
+
+
+Quantization
+ReadQuantization(const cbor_item_t * item)
+{
+  if (!cbor_isa_map(item))
+  {
+    throw std::runtime_error("Expected a quantization cbor map");
+  }
+  Quantization quantization;
+  const size_t count = cbor_map_size(item);
+  const struct cbor_pair * handle = cbor_map_handle(item);
+  for (size_t ii = 0; ii < count; ++ii)
+  {
+    const std::string_view key(reinterpret_cast<char *>(cbor_string_handle(handle[ii].key)), cbor_string_length(handle[ii].key));
+    if (key == "bits")
+    {
+      quantization.bits = static_cast<unsigned int>(cbor_get_int(handle[ii].value));
+    }
+    else if (key == "minimum" || key == "maximum")
+    {
+      if (!cbor_isa_array(handle[ii].value))
+      {
+        throw std::runtime_error("Expected a quantization bounds cbor array");
+      }
+      std::vector<double> & bounds = key == "minimum" ? quantization.minimum : quantization.maximum;
+      const size_t numberOfBounds = cbor_array_size(handle[ii].value);
+      cbor_item_t ** boundHandle = cbor_array_handle(handle[ii].value);
+      for (size_t jj = 0; jj < numberOfBounds; ++jj)
+      {
+        if (!cbor_isa_float_ctrl(boundHandle[jj]))
+        {
+          throw std::runtime_error("Expected a floating point quantization bound");
+        }
+        bounds.push_back(cbor_float_get_float(boundHandle[jj]));
+      }
+    }
+  }
+  if ((quantization.bits != 16 && quantization.bits != 32) || quantization.minimum.empty() ||
+      quantization.minimum.size() != quantization.maximum.size())
+  {
+    throw std::runtime_error("Malformed quantization");
+  }
+  return quantization;
+}
+
+} // end namespace wasm
+} // end namespace itk
@@ -0,0 +1,246 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmRangeReader.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <mutex>
+
+#if defined(ITK_WASM_RANGE_FETCH_IMPORT) && defined(__wasm__)
+// Size in bytes of the resource at the URL, or -1 if it cannot be fetched
+extern "C" __attribute__((import_module("itk_wasm"), import_name("range_size"))) int64_t
+itk_wasm_range_size(const char * url, uint32_t urlLength);
+// Copy up to size bytes of the resource at the URL, from offset, into data.
+// Returns the number of bytes copied, or -1 on error.
+extern "C" __attribute__((import_module("itk_wasm"), import_name("range_fetch"))) int64_t
+itk_wasm_range_fetch(const char * url, uint32_t urlLength, uint64_t offset, void * data, uint32_t size);
+#endif
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+
+class FileRangeReader : public RangeReader
+{
+public:
+  FileRangeReader(FILE * file, uint64_t size)
+    : m_File(file)
+    , m_Size(size)
+  {}
+
+  ~FileRangeReader() override
+  {
+    fclose(m_File);
+  }
+
+  uint64_t
+  GetSize() const override
+  {
+    return m_Size;
+  }
+
+  bool
+  Read(uint64_t offset, void * data, size_t size) override
+  {
+    if (offset > m_Size || size > m_Size - offset)
+    {
+      return false;
+    }
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    return size == 0 ||
+           (fseek(m_File, static_cast<long>(offset), SEEK_SET) == 0 && fread(data, 1, size, m_File) == size);
+  }
+
+private:
+  FILE *     m_File;
+  uint64_t   m_Size;
+  std::mutex m_Mutex;
+};
+
+#if defined(ITK_WASM_RANGE_FETCH_IMPORT) && defined(__wasm__)
+class URLRangeReader : public RangeReader
+{
+public:
+  URLRangeReader(const std::string & url, uint64_t size)
+    : m_URL(url)
+    , m_Size(size)
+  {}
+
+  uint64_t
+  GetSize() const override
+  {
+    return m_Size;
+  }
+
+  bool
+  Read(uint64_t offset, void * data, size_t size) override
+  {
+    if (offset > m_Size || size > m_Size - offset)
+    {
+      return false;
+    }
+    auto bytes = static_cast<char *>(data);
+    while (size > 0)
+    {
+      const auto requestSize =
+        static_cast<uint32_t>(std::min<size_t>(size, std::numeric_limits<uint32_t>::max()));
+      const int64_t fetched =
+        itk_wasm_range_fetch(m_URL.data(), static_cast<uint32_t>(m_URL.size()), offset, bytes, requestSize);
+      if (fetched <= 0 || static_cast<uint64_t>(fetched) > requestSize)
+      {
+        return false;
+      }
+      offset += static_cast<uint64_t>(fetched);
+      bytes += fetched;
+      size -= static_cast<size_t>(fetched);
+    }
+    return true;
+  }
+
+private:
+  const std::string m_URL;
+  uint64_t          m_Size;
+};
+#endif
+
+} // end anonymous namespace
+
+bool
+RangeReader::IsURL(const std::string & name)
+{
+  return name.rfind("http://", 0) == 0 || name.rfind("https://", 0) == 0;
+}
+
+std::unique_ptr<RangeReader>
+RangeReader::Open(const std::string & name)
+{
+  if (IsURL(name))
+  {
+#if defined(ITK_WASM_RANGE_FETCH_IMPORT) && defined(__wasm__)
+    const int64_t size = itk_wasm_range_size(name.data(), static_cast<uint32_t>(name.size()));
+    if (size < 0)
+    {
+      return nullptr;
+    }
+    return std::make_unique<URLRangeReader>(name, static_cast<uint64_t>(size));
+#else
+    return nullptr;
+#endif
+  }
+
+  FILE * file = fopen(name.c_str(), "rb");
+  if (file == nullptr)
+  {
+    return nullptr;
+  }
+  if (fseek(file, 0, SEEK_END) != 0)
+  {
+    fclose(file);
+    return nullptr;
+  }
+  const long size = ftell(file);
+  // Directories open, but cannot be read
+  if (size < 0 || (size > 0 && (fseek(file, 0, SEEK_SET) != 0 || fgetc(file) == EOF)))
+  {
+    fclose(file);
+    return nullptr;
+  }
+  return std::make_unique<FileRangeReader>(file, static_cast<uint64_t>(size));
+}
+
+bool
+ReadRangeResource(const std::string & name, std::vector<char> & contents)
+{
+  std::unique_ptr<RangeReader> reader = RangeReader::Open(name);
+  if (!reader)
+  {
+    return false;
+  }
+  contents.resize(static_cast<size_t>(reader->GetSize()));
+  return reader->Read(0, contents.data(), contents.size());
+}
+
+RangeCBORSource::RangeCBORSource(std::unique_ptr<RangeReader> reader)
+  : m_Reader(std::move(reader))
+{}
+
+bool
+RangeCBORSource::ReadBytes(void * data, size_t size)
+{
+  auto bytes = static_cast<char *>(data);
+  if (m_Offset >= m_BufferOffset && m_Offset < m_BufferOffset + m_Buffer.size())
+  {
+    // Bytes already in the buffer
+    const auto bufferPosition = static_cast<size_t>(m_Offset - m_BufferOffset);
+    const size_t bufferedSize = std::min(size, m_Buffer.size() - bufferPosition);
+    std::memcpy(bytes, m_Buffer.data() + bufferPosition, bufferedSize);
+    bytes += bufferedSize;
+    size -= bufferedSize;
+    m_Offset += bufferedSize;
+  }
+  if (size == 0)
+  {
+    return true;
+  }
+
+  if (size >= BufferSize)
+  {
+    if (!m_Reader->Read(m_Offset, bytes, size))
+    {
+      return false;
+    }
+    m_Offset += size;
+    return true;
+  }
+
+  const uint64_t fileSize = m_Reader->GetSize();
+  if (m_Offset >= fileSize)
+  {
+    return false;
+  }
+  m_Buffer.resize(static_cast<size_t>(std::min<uint64_t>(BufferSize, fileSize - m_Offset)));
+  m_BufferOffset = m_Offset;
+  if (m_Buffer.size() < size || !m_Reader->Read(m_BufferOffset, m_Buffer.data(), m_Buffer.size()))
+  {
+    m_Buffer.clear();
+    return false;
+  }
+  std::memcpy(bytes, m_Buffer.data(), size);
+  m_Offset += size;
+  return true;
+}
+
+bool
+RangeCBORSource::SkipBytes(uint64_t size)
+{
+  if (size > m_Reader->GetSize() - std::min(m_Offset, m_Reader->GetSize()))
+  {
+    return false;
+  }
+  m_Offset += size;
+  return true;
+}
+
+} // end namespace wasm
+} // end namespace itk
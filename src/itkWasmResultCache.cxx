@@ -0,0 +1,104 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmResultCache.h"
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+std::shared_ptr<ResultCacheStore> resultCacheStore;
+} // namespace
+
+MemoryResultCacheStore::MemoryResultCacheStore(size_t capacity)
+  : m_Capacity(capacity)
+{}
+
+std::shared_ptr<const ResultCacheEntry>
+MemoryResultCacheStore::Get(uint64_t key)
+{
+  auto it = m_Index.find(key);
+  if (it == m_Index.end())
+  {
+    return nullptr;
+  }
+  m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+  return it->second->second;
+}
+
+void
+MemoryResultCacheStore::Put(uint64_t key, std::shared_ptr<const ResultCacheEntry> entry)
+{
+  const size_t entrySize = GetResultCacheEntrySize(*entry);
+  if (entrySize > m_Capacity)
+  {
+    return;
+  }
+
+  auto it = m_Index.find(key);
+  if (it != m_Index.end())
+  {
+    m_Size -= GetResultCacheEntrySize(*(it->second->second));
+    m_Entries.erase(it->second);
+    m_Index.erase(it);
+  }
+
+  while (m_Size + entrySize > m_Capacity)
+  {
+    const auto & leastRecentlyUsed = m_Entries.back();
+    m_Size -= GetResultCacheEntrySize(*(leastRecentlyUsed.second));
+    m_Index.erase(leastRecentlyUsed.first);
+    m_Entries.pop_back();
+  }
+
+  m_Entries.emplace_front(key, std::move(entry));
+  m_Index[key] = m_Entries.begin();
+  m_Size += entrySize;
+}
+
+size_t
+GetResultCacheEntrySize(const ResultCacheEntry & entry)
+{
+  size_t size = 0;
+  for (const auto & output : entry)
+  {
+    size += output.second.json.size();
+    for (const auto & array : output.second.arrays)
+    {
+      size += array.second.size();
+    }
+  }
+  return size;
+}
+
+void
+setResultCacheStore(std::shared_ptr<ResultCacheStore> store)
+{
+  resultCacheStore = std::move(store);
+}
+
+ResultCacheStore *
+getResultCacheStore()
+{
+  return resultCacheStore.get();
+}
+
+} // end namespace wasm
+} // end namespace itk
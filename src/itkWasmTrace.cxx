@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmTrace.h"
+
+#ifdef ITK_WASM_TRACE
+#include "rapidjson/ostreamwrapper.h"
+#include "rapidjson/writer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+namespace wasm
+{
+
+#if defined(ITK_WASM_TRACE_IMPORT) && defined(__wasm__)
+extern "C" __attribute__((import_module("itk_wasm"), import_name("trace_event"))) void
+itk_wasm_trace_event(const char * name, const char * category, double startMicroseconds, double durationMicroseconds);
+#endif
+
+namespace
+{
+
+struct TraceEvent
+{
+  std::string name;
+  const char * category;
+  double start;
+  double duration;
+  uint32_t thread;
+};
+
+std::atomic<bool> traceEnabled{ false };
+std::mutex traceMutex;
+std::vector<TraceEvent> traceEvents;
+
+double
+ToMicroseconds(std::chrono::steady_clock::duration duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+// Small, stable track ids, in order of the first span of each thread
+uint32_t
+GetTraceThread()
+{
+  static std::atomic<uint32_t> nextThread{ 1 };
+  thread_local const uint32_t thread = nextThread++;
+  return thread;
+}
+
+void
+RecordEvent(const char * name, const std::string * ownedName, const char * category, double start, double duration)
+{
+#if defined(ITK_WASM_TRACE_IMPORT) && defined(__wasm__)
+  (void)ownedName;
+  itk_wasm_trace_event(name, category, start, duration);
+#else
+  (void)name;
+  const std::lock_guard<std::mutex> lock(traceMutex);
+  traceEvents.push_back({ ownedName != nullptr ? *ownedName : std::string(name), category, start, duration, GetTraceThread() });
+#endif
+}
+
+} // end anonymous namespace
+
+TraceScope
+::TraceScope(const char * name, const char * category)
+  : m_Name(name)
+  , m_Category(category)
+{
+  if (traceEnabled.load(std::memory_order_relaxed))
+  {
+    m_Start = std::chrono::steady_clock::now();
+  }
+}
+
+TraceScope
+::~TraceScope()
+{
+  if (traceEnabled.load(std::memory_order_relaxed) && m_Start.time_since_epoch().count() != 0)
+  {
+    const auto end = std::chrono::steady_clock::now();
+    RecordEvent(m_Name, nullptr, m_Category, ToMicroseconds(m_Start.time_since_epoch()), ToMicroseconds(end - m_Start));
+  }
+}
+
+bool
+TraceScope
+::GetEnabled()
+{
+  return traceEnabled.load(std::memory_order_relaxed);
+}
+
+void
+TraceScope
+::SetEnabled(bool enabled)
+{
+  traceEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void
+TraceScope
+::AddEvent(const std::string & name,
+           const char * category,
+           std::chrono::steady_clock::time_point start,
+           std::chrono::steady_clock::time_point end)
+{
+  if (traceEnabled.load(std::memory_order_relaxed))
+  {
+    RecordEvent(name.c_str(), &name, category, ToMicroseconds(start.time_since_epoch()), ToMicroseconds(end - start));
+  }
+}
+
+void
+TraceScope
+::WriteEvents(std::ostream & stream, const std::string & processName)
+{
+  std::vector<TraceEvent> events;
+  {
+    const std::lock_guard<std::mutex> lock(traceMutex);
+    events.swap(traceEvents);
+  }
+
+  rapidjson::OStreamWrapper ostreamWrapper(stream);
+  rapidjson::Writer<rapidjson::OStreamWrapper> writer(ostreamWrapper);
+  writer.StartObject();
+  writer.Key("traceEvents");
+  writer.StartArray();
+  writer.StartObject();
+  writer.Key("name");
+  writer.String("process_name");
+  writer.Key("ph");
+  writer.String("M");
+  writer.Key("pid");
+  writer.Uint(1);
+  writer.Key("args");
+  writer.StartObject();
+  writer.Key("name");
+  writer.String(processName.c_str(), static_cast<rapidjson::SizeType>(processName.size()));
+  writer.EndObject();
+  writer.EndObject();
+  for (const TraceEvent & event : events)
+  {
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(event.name.c_str(), static_cast<rapidjson::SizeType>(event.name.size()));
+    writer.Key("cat");
+    writer.String(event.category);
+    writer.Key("ph");
+    writer.String("X");
+    writer.Key("ts");
+    writer.Double(event.start);
+    writer.Key("dur");
+    writer.Double(event.duration);
+    writer.Key("pid");
+    writer.Uint(1);
+    writer.Key("tid");
+    writer.Uint(event.thread);
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+  stream << std::endl;
+}
+
+void
+TraceScope
+::ClearEvents()
+{
+  const std::lock_guard<std::mutex> lock(traceMutex);
+  traceEvents.clear();
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,326 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageToWasmImageFilter.h"
+#include "itkWasmImageToImageFilter.h"
+#include "itkMeshToWasmMeshFilter.h"
+#include "itkWasmMeshToMeshFilter.h"
+#include "itkPolyDataToWasmPolyDataFilter.h"
+#include "itkWasmPolyDataToPolyDataFilter.h"
+#include "itkWasmImageIO.h"
+#include "itkWasmZstdImageIO.h"
+#include "itkMetaDataDictionaryJSON.h"
+
+#include "itkImage.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkMesh.h"
+#include "itkMeshToPolyDataFilter.h"
+#include "itkMetaDataObject.h"
+#include "itkPolyData.h"
+#include "itkTriangleCell.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+
+// Throughput of the conversion filters and the image IOs.
+//
+// Results are emitted as JSON for tracking with, e.g.:
+//
+//   WebAssemblyInterfaceBenchmark --benchmark_format=json --benchmark_out=results.json
+
+namespace
+{
+
+constexpr unsigned int Dimension = 3;
+
+template <typename TPixel>
+typename itk::Image<TPixel, Dimension>::Pointer
+MakeImage(itk::SizeValueType side)
+{
+  using ImageType = itk::Image<TPixel, Dimension>;
+  auto image = ImageType::New();
+  typename ImageType::SizeType size;
+  size.Fill(side);
+  image->SetRegions(size);
+  image->Allocate();
+  TPixel * buffer = image->GetBufferPointer();
+  const itk::SizeValueType numberOfPixels = image->GetLargestPossibleRegion().GetNumberOfPixels();
+  for (itk::SizeValueType ii = 0; ii < numberOfPixels; ++ii)
+  {
+    buffer[ii] = static_cast<TPixel>(ii % 251);
+  }
+  return image;
+}
+
+// A strip of triangles, cached per number of cells since large meshes are
+// slow to build
+using MeshType = itk::Mesh<float, 3>;
+using PolyDataType = itk::PolyData<float>;
+
+const MeshType *
+GetTriangleStrip(itk::SizeValueType numberOfCells)
+{
+  static std::map<itk::SizeValueType, MeshType::Pointer> meshes;
+  MeshType::Pointer & mesh = meshes[numberOfCells];
+  if (mesh.IsNull())
+  {
+    mesh = MeshType::New();
+    for (itk::SizeValueType ii = 0; ii < numberOfCells + 2; ++ii)
+    {
+      MeshType::PointType point;
+      point[0] = static_cast<float>(ii / 2);
+      point[1] = static_cast<float>(ii % 2);
+      point[2] = 0.0f;
+      mesh->SetPoint(ii, point);
+    }
+    for (itk::SizeValueType ii = 0; ii < numberOfCells; ++ii)
+    {
+      MeshType::CellAutoPointer cell;
+      cell.TakeOwnership(new itk::TriangleCell<MeshType::CellType>);
+      for (unsigned int jj = 0; jj < 3; ++jj)
+      {
+        cell->SetPointId(jj, ii + jj);
+      }
+      mesh->SetCell(ii, cell);
+    }
+  }
+  return mesh;
+}
+
+const PolyDataType *
+GetTrianglePolyData(itk::SizeValueType numberOfCells)
+{
+  static std::map<itk::SizeValueType, PolyDataType::Pointer> polyDatas;
+  PolyDataType::Pointer & polyData = polyDatas[numberOfCells];
+  if (polyData.IsNull())
+  {
+    auto meshToPolyData = itk::MeshToPolyDataFilter<MeshType>::New();
+    meshToPolyData->SetInput(GetTriangleStrip(numberOfCells));
+    meshToPolyData->Update();
+    polyData = meshToPolyData->GetOutput();
+    polyData->DisconnectPipeline();
+  }
+  return polyData;
+}
+
+std::string
+GetOutputFileName(const std::string & extension)
+{
+  return (std::filesystem::temp_directory_path() / ("WebAssemblyInterfaceBenchmark" + extension)).string();
+}
+
+template <typename TPixel>
+void
+BM_ImageRoundTrip(benchmark::State & state)
+{
+  using ImageType = itk::Image<TPixel, Dimension>;
+  const auto image = MakeImage<TPixel>(static_cast<itk::SizeValueType>(state.range(0)));
+  const bool useDescriptor = state.range(1) != 0;
+  for (auto _ : state)
+  {
+    auto imageToWasm = itk::ImageToWasmImageFilter<ImageType>::New();
+    imageToWasm->SetInput(image);
+    imageToWasm->SetUseDescriptor(useDescriptor);
+    auto wasmToImage = itk::WasmImageToImageFilter<ImageType>::New();
+    wasmToImage->SetInput(imageToWasm->GetOutput());
+    wasmToImage->Update();
+    benchmark::DoNotOptimize(wasmToImage->GetOutput()->GetBufferPointer());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(image->GetPixelContainer()->Size() * sizeof(TPixel)));
+}
+BENCHMARK_TEMPLATE(BM_ImageRoundTrip, uint8_t)
+  ->ArgsProduct({ { 32, 64, 128, 256 }, { 0, 1 } })
+  ->ArgNames({ "side", "descriptor" });
+BENCHMARK_TEMPLATE(BM_ImageRoundTrip, int16_t)
+  ->ArgsProduct({ { 32, 64, 128, 256 }, { 0, 1 } })
+  ->ArgNames({ "side", "descriptor" });
+BENCHMARK_TEMPLATE(BM_ImageRoundTrip, float)
+  ->ArgsProduct({ { 32, 64, 128, 256 }, { 0, 1 } })
+  ->ArgNames({ "side", "descriptor" });
+
+void
+BM_MeshRoundTrip(benchmark::State & state)
+{
+  const auto numberOfCells = static_cast<itk::SizeValueType>(state.range(0));
+  const MeshType * mesh = GetTriangleStrip(numberOfCells);
+  for (auto _ : state)
+  {
+    auto meshToWasm = itk::MeshToWasmMeshFilter<MeshType>::New();
+    meshToWasm->SetInput(mesh);
+    auto wasmToMesh = itk::WasmMeshToMeshFilter<MeshType>::New();
+    wasmToMesh->SetInput(meshToWasm->GetOutput());
+    wasmToMesh->Update();
+    benchmark::DoNotOptimize(wasmToMesh->GetOutput()->GetNumberOfCells());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_MeshRoundTrip)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+
+void
+BM_PolyDataRoundTrip(benchmark::State & state)
+{
+  const auto numberOfCells = static_cast<itk::SizeValueType>(state.range(0));
+  const PolyDataType * polyData = GetTrianglePolyData(numberOfCells);
+  for (auto _ : state)
+  {
+    auto polyDataToWasm = itk::PolyDataToWasmPolyDataFilter<PolyDataType>::New();
+    polyDataToWasm->SetInput(polyData);
+    auto wasmToPolyData = itk::WasmPolyDataToPolyDataFilter<PolyDataType>::New();
+    wasmToPolyData->SetInput(polyDataToWasm->GetOutput());
+    wasmToPolyData->Update();
+    benchmark::DoNotOptimize(wasmToPolyData->GetOutput()->GetPolygons()->Size());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_PolyDataRoundTrip)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+
+// The image IOs, by the extension of the file written and read
+const char * const ImageIOExtensions[] = { ".iwi", ".iwi.cbor", ".iwi.cbor.zst" };
+
+itk::ImageIOBase::Pointer
+CreateImageIO(int64_t extension)
+{
+  if (extension == 2)
+  {
+    return itk::WasmZstdImageIO::New().GetPointer();
+  }
+  return itk::WasmImageIO::New().GetPointer();
+}
+
+void
+BM_ImageIOWrite(benchmark::State & state)
+{
+  using ImageType = itk::Image<int16_t, Dimension>;
+  const auto image = MakeImage<int16_t>(static_cast<itk::SizeValueType>(state.range(0)));
+  const std::string fileName = GetOutputFileName(ImageIOExtensions[state.range(1)]);
+  for (auto _ : state)
+  {
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetImageIO(CreateImageIO(state.range(1)));
+    writer->SetInput(image);
+    writer->SetFileName(fileName);
+    writer->Update();
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(image->GetPixelContainer()->Size() * sizeof(int16_t)));
+  state.SetLabel(ImageIOExtensions[state.range(1)]);
+  std::error_code error;
+  std::filesystem::remove_all(fileName, error);
+}
+BENCHMARK(BM_ImageIOWrite)
+  ->ArgsProduct({ { 64, 128, 256 }, { 0, 1, 2 } })
+  ->ArgNames({ "side", "io" })
+  ->Unit(benchmark::kMillisecond);
+
+void
+BM_ImageIORead(benchmark::State & state)
+{
+  using ImageType = itk::Image<int16_t, Dimension>;
+  const auto image = MakeImage<int16_t>(static_cast<itk::SizeValueType>(state.range(0)));
+  const std::string fileName = GetOutputFileName(ImageIOExtensions[state.range(1)]);
+  {
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetImageIO(CreateImageIO(state.range(1)));
+    writer->SetInput(image);
+    writer->SetFileName(fileName);
+    writer->Update();
+  }
+  for (auto _ : state)
+  {
+    auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetImageIO(CreateImageIO(state.range(1)));
+    reader->SetFileName(fileName);
+    reader->Update();
+    benchmark::DoNotOptimize(reader->GetOutput()->GetBufferPointer());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(image->GetPixelContainer()->Size() * sizeof(int16_t)));
+  state.SetLabel(ImageIOExtensions[state.range(1)]);
+  std::error_code error;
+  std::filesystem::remove_all(fileName, error);
+}
+BENCHMARK(BM_ImageIORead)
+  ->ArgsProduct({ { 64, 128, 256 }, { 0, 1, 2 } })
+  ->ArgNames({ "side", "io" })
+  ->Unit(benchmark::kMillisecond);
+
+// A dictionary of string, integer, floating point and array entries
+itk::MetaDataDictionary
+MakeDictionary(int64_t numberOfEntries)
+{
+  itk::MetaDataDictionary dictionary;
+  for (int64_t ii = 0; ii < numberOfEntries; ++ii)
+  {
+    const std::string key = "key" + std::to_string(ii);
+    switch (ii % 4)
+    {
+      case 0:
+        itk::EncapsulateMetaData<std::string>(dictionary, key, "value" + std::to_string(ii));
+        break;
+      case 1:
+        itk::EncapsulateMetaData<int64_t>(dictionary, key, ii);
+        break;
+      case 2:
+        itk::EncapsulateMetaData<double>(dictionary, key, static_cast<double>(ii) / 3.0);
+        break;
+      default:
+        itk::EncapsulateMetaData<std::vector<double>>(dictionary, key, std::vector<double>(16, static_cast<double>(ii)));
+        break;
+    }
+  }
+  return dictionary;
+}
+
+void
+BM_MetaDataDictionaryToJSON(benchmark::State & state)
+{
+  const itk::MetaDataDictionary dictionary = MakeDictionary(state.range(0));
+  for (auto _ : state)
+  {
+    rapidjson::Document document;
+    rapidjson::Value metadataJson(rapidjson::kArrayType);
+    itk::wasm::ConvertMetaDataDictionaryToJSON(dictionary, metadataJson, document.GetAllocator());
+    benchmark::DoNotOptimize(metadataJson.Size());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_MetaDataDictionaryToJSON)->RangeMultiplier(10)->Range(100, 100000);
+
+void
+BM_JSONToMetaDataDictionary(benchmark::State & state)
+{
+  const itk::MetaDataDictionary dictionary = MakeDictionary(state.range(0));
+  rapidjson::Document document;
+  rapidjson::Value metadataJson(rapidjson::kArrayType);
+  itk::wasm::ConvertMetaDataDictionaryToJSON(dictionary, metadataJson, document.GetAllocator());
+  for (auto _ : state)
+  {
+    itk::MetaDataDictionary converted;
+    itk::wasm::ConvertJSONToMetaDataDictionary(metadataJson, converted);
+    benchmark::DoNotOptimize(converted.GetKeys().size());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_JSONToMetaDataDictionary)->RangeMultiplier(10)->Range(100, 100000);
+
+} // end anonymous namespace
@@ -0,0 +1,107 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkMetaDataDictionaryCBOR.h"
+#include "itkArray.h"
+#include "itkMatrix.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+template <typename TValue>
+bool
+HasValue(const itk::MetaDataDictionary & dictionary, const std::string & key, const TValue & expected)
+{
+  TValue value;
+  if (!itk::ExposeMetaData<TValue>(dictionary, key, value) || !(value == expected))
+  {
+    std::cerr << "Unexpected value of " << key << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // end anonymous namespace
+
+int
+itkMetaDataDictionaryCBORTest(int, char *[])
+{
+  itk::MetaDataDictionary dictionary;
+  itk::EncapsulateMetaData<std::string>(dictionary, "string", "value");
+  itk::EncapsulateMetaData<int>(dictionary, "int", -3);
+  itk::EncapsulateMetaData<long long>(dictionary, "long long", -5000000000ll);
+  itk::EncapsulateMetaData<float>(dictionary, "float", 1.25f);
+  itk::EncapsulateMetaData<double>(dictionary, "double", 2.5);
+  itk::EncapsulateMetaData<bool>(dictionary, "bool", true);
+  itk::EncapsulateMetaData<uint64_t>(dictionary, "uint64", 18000000000000000000ull);
+  itk::EncapsulateMetaData<std::vector<double>>(dictionary, "vector", { 1.5, 2.0 });
+  itk::EncapsulateMetaData<std::vector<std::string>>(dictionary, "strings", { "a", "bc" });
+  itk::EncapsulateMetaData<std::vector<std::vector<int>>>(dictionary, "vector vector", { { 1, 2 }, { 3 } });
+  itk::Array<float> array(2);
+  array[0] = 0.5f;
+  array[1] = -1.0f;
+  itk::EncapsulateMetaData<itk::Array<float>>(dictionary, "array", array);
+  itk::Matrix<double> matrix;
+  matrix.SetIdentity();
+  itk::EncapsulateMetaData<itk::Matrix<double>>(dictionary, "matrix", matrix);
+
+  std::string encoded;
+  itk::wasm::MemoryCBORSink sink(encoded);
+  itk::wasm::WriteCBORMetaDataDictionary(sink, dictionary);
+  ITK_TEST_EXPECT_TRUE(sink.Finish());
+
+  itk::MetaDataDictionary decoded;
+  ITK_TEST_EXPECT_TRUE(itk::wasm::ReadCBORMetaDataDictionary(
+    reinterpret_cast<const unsigned char *>(encoded.data()), encoded.size(), decoded));
+  ITK_TEST_EXPECT_TRUE(HasValue<std::string>(decoded, "string", "value"));
+  ITK_TEST_EXPECT_TRUE(HasValue<int>(decoded, "int", -3));
+  ITK_TEST_EXPECT_TRUE(HasValue<int64_t>(decoded, "long long", -5000000000ll));
+  ITK_TEST_EXPECT_TRUE(HasValue<float>(decoded, "float", 1.25f));
+  ITK_TEST_EXPECT_TRUE(HasValue<double>(decoded, "double", 2.5));
+  ITK_TEST_EXPECT_TRUE(HasValue<bool>(decoded, "bool", true));
+  ITK_TEST_EXPECT_TRUE(HasValue<uint64_t>(decoded, "uint64", 18000000000000000000ull));
+  ITK_TEST_EXPECT_TRUE(HasValue<std::vector<double>>(decoded, "vector", { 1.5, 2.0 }));
+  ITK_TEST_EXPECT_TRUE(HasValue<std::vector<std::string>>(decoded, "strings", { "a", "bc" }));
+  ITK_TEST_EXPECT_TRUE(HasValue<std::vector<std::vector<int>>>(decoded, "vector vector", { { 1, 2 }, { 3 } }));
+  // Arrays and matrices are read as vectors
+  ITK_TEST_EXPECT_TRUE(HasValue<std::vector<float>>(decoded, "array", { 0.5f, -1.0f }));
+  ITK_TEST_EXPECT_TRUE(HasValue<std::vector<std::vector<double>>>(
+    decoded, "matrix", { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } }));
+
+  // Truncated metadata is rejected
+  for (size_t size = 0; size < encoded.size(); ++size)
+  {
+    itk::MetaDataDictionary truncated;
+    ITK_TEST_EXPECT_TRUE(!itk::wasm::ReadCBORMetaDataDictionary(
+      reinterpret_cast<const unsigned char *>(encoded.data()), size, truncated));
+  }
+
+  // Unsupported values, a null and a byte string, are skipped
+  const unsigned char unsupported[] = { 0xa3, 0x61, 'n', 0xf6, 0x61, 'b', 0x41, 0x00, 0x61, 'x', 0x01 };
+  itk::MetaDataDictionary skipped;
+  ITK_TEST_EXPECT_TRUE(itk::wasm::ReadCBORMetaDataDictionary(unsupported, sizeof(unsupported), skipped));
+  ITK_TEST_EXPECT_TRUE(!skipped.HasKey("n") && !skipped.HasKey("b"));
+  ITK_TEST_EXPECT_TRUE(HasValue<int>(skipped, "x", 1));
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkMetaDataDictionaryJSON.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct ApplicationValue
+{
+  int value;
+};
+
+bool
+operator==(const ApplicationValue & first, const ApplicationValue & second)
+{
+  return first.value == second.value;
+}
+
+std::ostream &
+operator<<(std::ostream & os, const ApplicationValue & applicationValue)
+{
+  return os << applicationValue.value;
+}
+
+template <typename TValue>
+bool
+HasValue(const itk::MetaDataDictionary & dictionary, const std::string & key, const TValue & expected)
+{
+  TValue value;
+  if (!itk::ExposeMetaData<TValue>(dictionary, key, value) || !(value == expected))
+  {
+    std::cerr << "Unexpected value of " << key << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // end anonymous namespace
+
+int
+itkMetaDataDictionaryJSONTest(int, char *[])
+{
+  itk::MetaDataDictionary dictionary;
+  itk::EncapsulateMetaData<std::string>(dictionary, "string", "value");
+  itk::EncapsulateMetaData<int>(dictionary, "int", -3);
+  itk::EncapsulateMetaData<unsigned short>(dictionary, "unsigned short", 7);
+  itk::EncapsulateMetaData<double>(dictionary, "double", 2.5);
+  itk::EncapsulateMetaData<bool>(dictionary, "bool", true);
+  itk::EncapsulateMetaData<uint64_t>(dictionary, "uint64", 18000000000000000000ull);
+  itk::EncapsulateMetaData<std::vector<double>>(dictionary, "vector", { 1.5, 2.0 });
+  itk::EncapsulateMetaData<std::vector<std::vector<int>>>(dictionary, "vector vector", { { 1, 2 }, { 3 } });
+  itk::EncapsulateMetaData<ApplicationValue>(dictionary, "application", ApplicationValue{ 5 });
+
+  rapidjson::Document document;
+  rapidjson::Document::AllocatorType & allocator = document.GetAllocator();
+  rapidjson::Value metadataJson(rapidjson::kArrayType);
+  itk::wasm::ConvertMetaDataDictionaryToJSON(dictionary, metadataJson, allocator);
+  // Without a converter, the application entry is skipped
+  ITK_TEST_EXPECT_EQUAL(metadataJson.Size(), 8u);
+
+  itk::wasm::RegisterMetaDataObjectToJSONConverter<ApplicationValue>(
+    [](const ApplicationValue & value, rapidjson::Value & valueJson, rapidjson::Document::AllocatorType &)
+    { valueJson.SetInt(value.value); });
+  metadataJson.SetArray();
+  itk::wasm::ConvertMetaDataDictionaryToJSON(dictionary, metadataJson, allocator);
+  ITK_TEST_EXPECT_EQUAL(metadataJson.Size(), 9u);
+
+  itk::MetaDataDictionary converted;
+  itk::wasm::ConvertJSONToMetaDataDictionary(metadataJson, converted);
+  ITK_TEST_EXPECT_TRUE(HasValue<std::string>(converted, "string", "value"));
+  ITK_TEST_EXPECT_TRUE(HasValue<int>(converted, "int", -3));
+  ITK_TEST_EXPECT_TRUE(HasValue<int>(converted, "unsigned short", 7));
+  ITK_TEST_EXPECT_TRUE(HasValue<double>(converted, "double", 2.5));
+  ITK_TEST_EXPECT_TRUE(HasValue<bool>(converted, "bool", true));
+  ITK_TEST_EXPECT_TRUE(HasValue<uint64_t>(converted, "uint64", 18000000000000000000ull));
+  ITK_TEST_EXPECT_TRUE(HasValue<std::vector<double>>(converted, "vector", { 1.5, 2.0 }));
+  ITK_TEST_EXPECT_TRUE(HasValue<std::vector<std::vector<int>>>(converted, "vector vector", { { 1, 2 }, { 3 } }));
+  ITK_TEST_EXPECT_TRUE(HasValue<int>(converted, "application", 5));
+
+  // Integers of different kinds are widened, and mixed kinds are skipped
+  document.Parse(R"([["widened", [-1, 3000000000]], ["mixed", [1, "one"]], ["empty", []]])");
+  itk::MetaDataDictionary parsed;
+  itk::wasm::ConvertJSONToMetaDataDictionary(document, parsed);
+  ITK_TEST_EXPECT_TRUE(HasValue<std::vector<int64_t>>(parsed, "widened", { -1, 3000000000 }));
+  ITK_TEST_EXPECT_TRUE(!parsed.HasKey("mixed"));
+  ITK_TEST_EXPECT_TRUE(HasValue<std::vector<std::string>>(parsed, "empty", {}));
+
+  ITK_TRY_EXPECT_EXCEPTION(itk::wasm::RegisterJSONToMetaDataObjectConverter(
+    { itk::wasm::JSONMetaDataKind::Int, itk::wasm::JSONMetaDataMaximumDepth + 1 }, {}));
+
+  return EXIT_SUCCESS;
+}
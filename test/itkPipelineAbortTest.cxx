@@ -0,0 +1,112 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkProcessObject.h"
+#include "itkProgressReporter.h"
+#include "itkTestingMacros.h"
+#include "itkWasmExports.h"
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+constexpr unsigned int NumberOfSteps = 100;
+
+// A process object whose work reports its progress with an ITK progress
+// reporter, as filters do
+class AbortTestProcess : public itk::ProcessObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(AbortTestProcess);
+
+  using Self = AbortTestProcess;
+  using Superclass = itk::ProcessObject;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkTypeMacro(AbortTestProcess, ProcessObject);
+
+  void
+  Run()
+  {
+    itk::ProgressReporter progress(this, 0, NumberOfSteps, NumberOfSteps);
+    for (unsigned int step = 0; step < NumberOfSteps; ++step)
+    {
+      progress.CompletedPixel();
+      ++m_CompletedSteps;
+    }
+  }
+
+  unsigned int
+  GetCompletedSteps() const
+  {
+    return m_CompletedSteps;
+  }
+
+protected:
+  AbortTestProcess() = default;
+  ~AbortTestProcess() override = default;
+
+private:
+  unsigned int m_CompletedSteps{ 0 };
+};
+
+int
+AbortPipelineMain(int argc, char * argv[], bool requestAbort, AbortTestProcess * process)
+{
+  itk::wasm::Pipeline pipeline("abort-test", "A test ITK Wasm pipeline abort", argc, argv);
+
+  ITK_WASM_PARSE(pipeline);
+
+  pipeline.abort_on_request(process);
+  if (requestAbort)
+  {
+    // As the host would, e.g. from another thread, while the pipeline runs
+    itk_wasm_request_abort();
+  }
+  ITK_WASM_CATCH_EXCEPTION(pipeline, process->Run());
+
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkPipelineAbortTest(int, char *[])
+{
+  const char * abortArgv[] = {"itkPipelineAbortTest", NULL};
+
+  // A requested abort throws itk::ProcessAborted at the next progress
+  // update, which ITK_WASM_CATCH_EXCEPTION turns into an error exit
+  std::ostringstream errors;
+  std::streambuf * cerrBuffer = std::cerr.rdbuf(errors.rdbuf());
+  auto abortedProcess = AbortTestProcess::New();
+  const int abortedResult = AbortPipelineMain(1, const_cast< char ** >(abortArgv), true, abortedProcess);
+  std::cerr.rdbuf(cerrBuffer);
+  ITK_TEST_EXPECT_TRUE(abortedResult != EXIT_SUCCESS);
+  ITK_TEST_EXPECT_TRUE(abortedProcess->GetCompletedSteps() < NumberOfSteps);
+  ITK_TEST_EXPECT_TRUE(errors.str().find("ProcessAborted") != std::string::npos);
+
+  // The flag is cleared by the next run, which completes
+  auto process = AbortTestProcess::New();
+  ITK_TEST_EXPECT_EQUAL(AbortPipelineMain(1, const_cast< char ** >(abortArgv), false, process), EXIT_SUCCESS);
+  ITK_TEST_EXPECT_EQUAL(process->GetCompletedSteps(), NumberOfSteps);
+  ITK_TEST_EXPECT_TRUE(!itk::wasm::getAbortRequested());
+
+  return EXIT_SUCCESS;
+}
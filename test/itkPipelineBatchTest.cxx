@@ -0,0 +1,74 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkTestingMacros.h"
+
+#include <fstream>
+
+namespace
+{
+int batchEntries = 0;
+
+int
+BatchPipelineMain(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("batch-test", "A test ITK Wasm batch pipeline", argc, argv);
+
+  std::string input;
+  pipeline.add_option("input", input, "The input")->required();
+
+  int value = 0;
+  pipeline.add_option("-v,--value", value, "A value");
+
+  ITK_WASM_PARSE(pipeline);
+
+  ++batchEntries;
+  if (input != "entry" + std::to_string(value))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkPipelineBatchTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters" << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " Manifest" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char * manifestFile = argv[1];
+  {
+    std::ofstream manifest(manifestFile);
+    manifest << R"([["entry1", "--value", "1"], ["entry2", "-v", "2"], ["entry3", "-v", "3"]])";
+  }
+
+  const char * batchArgv[] = {"itkPipelineBatchTest", "--batch", manifestFile, NULL};
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::RunBatch(3, const_cast< char ** >(batchArgv), BatchPipelineMain), EXIT_SUCCESS);
+  ITK_TEST_EXPECT_EQUAL(batchEntries, 3);
+
+  // Without --batch, the main function runs once
+  const char * singleArgv[] = {"itkPipelineBatchTest", "entry4", "-v", "4", NULL};
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::RunBatch(4, const_cast< char ** >(singleArgv), BatchPipelineMain), EXIT_SUCCESS);
+  ITK_TEST_EXPECT_EQUAL(batchEntries, 4);
+
+  return EXIT_SUCCESS;
+}
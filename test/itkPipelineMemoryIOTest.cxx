@@ -30,6 +30,7 @@
 #include "itkMeshToWasmMeshFilter.h"
 #include "itkWasmExports.h"
 #include <cstring>
+#include <vector>
 #include "itkInputMesh.h"
 #include "itkOutputMesh.h"
 #include "itkMesh.h"
@@ -58,6 +59,10 @@ itkPipelineMemoryIOTest(int argc, char * argv[])
   imageToWasmImageFilter->Update();
   auto readWasmImage = imageToWasmImageFilter->GetOutput();
 
+  // Destination region for the output image, bound before the run
+  std::vector<PixelType> boundOutputImageBuffer(readInputImage->GetPixelContainer()->Size());
+  itk_wasm_output_array_bind(0, 0, 0, reinterpret_cast< size_t >(boundOutputImageBuffer.data()), boundOutputImageBuffer.size() * sizeof(PixelType));
+
   auto readWasmImageData = reinterpret_cast< const void * >(readWasmImage->GetImage()->GetBufferPointer());
   const auto readWasmImageDataSize = readWasmImage->GetImage()->GetPixelContainer()->Size();
   const size_t readWasmImageDataPointerAddress = itk_wasm_input_array_alloc(0, 0, 0, readWasmImageDataSize);
@@ -184,6 +189,12 @@ itkPipelineMemoryIOTest(int argc, char * argv[])
 
   ITK_WASM_PARSE(pipeline);
 
+  auto boundImage = ImageType::New();
+  boundImage->SetRegions(inputImage.Get()->GetLargestPossibleRegion());
+  ITK_TEST_EXPECT_TRUE(outputImage.BindBuffer(boundImage));
+  boundImage->Allocate();
+  ITK_TEST_EXPECT_EQUAL(reinterpret_cast< size_t >(boundImage->GetBufferPointer()), reinterpret_cast< size_t >(boundOutputImageBuffer.data()));
+
   outputImage.Set(inputImage.Get());
 
   const std::string inputTextStreamContent{ std::istreambuf_iterator<char>(inputTextStream.Get()),
@@ -0,0 +1,74 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+
+#include "rapidjson/document.h"
+
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+
+int
+itkPipelineTest(int argc, char * argv[]);
+
+// Runs itkPipelineTest with the arguments, which include --profile, and
+// checks the report that the pipeline writes on stderr when it is destroyed
+int
+itkPipelineProfileTest(int argc, char * argv[])
+{
+  std::ostringstream errors;
+  std::streambuf * cerrBuffer = std::cerr.rdbuf(errors.rdbuf());
+  const int result = itkPipelineTest(argc, argv);
+  std::cerr.rdbuf(cerrBuffer);
+  std::cerr << errors.str();
+  ITK_TEST_EXPECT_EQUAL(result, EXIT_SUCCESS);
+
+  // The report is the last line
+  std::istringstream stream(errors.str());
+  std::string line;
+  std::string report;
+  while (std::getline(stream, line))
+  {
+    if (!line.empty())
+    {
+      report = line;
+    }
+  }
+
+  rapidjson::Document document;
+  ITK_TEST_EXPECT_TRUE(!document.Parse(report.c_str()).HasParseError());
+  ITK_TEST_EXPECT_TRUE(document.IsObject());
+  ITK_TEST_EXPECT_TRUE(document.HasMember("name") && document["name"].IsString());
+  ITK_TEST_EXPECT_EQUAL(std::string(document["name"].GetString()), std::string("pipeline-test"));
+  ITK_TEST_EXPECT_TRUE(document.HasMember("profile") && document["profile"].IsArray());
+
+  std::set<std::string> phases;
+  for (const auto & event : document["profile"].GetArray())
+  {
+    ITK_TEST_EXPECT_TRUE(event.IsObject() && event.HasMember("name") && event["name"].IsString());
+    ITK_TEST_EXPECT_TRUE(event.HasMember("seconds") && event["seconds"].IsNumber());
+    ITK_TEST_EXPECT_TRUE(event["seconds"].GetDouble() >= 0.0);
+    phases.insert(event["name"].GetString());
+  }
+  ITK_TEST_EXPECT_EQUAL(phases.count("parse"), 1u);
+  ITK_TEST_EXPECT_EQUAL(phases.count("compute"), 1u);
+  ITK_TEST_EXPECT_EQUAL(phases.count("outputs"), 1u);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkProcessObject.h"
+#include "itkTestingMacros.h"
+
+#include "rapidjson/document.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int NumberOfUpdates = 1000;
+
+// A process object that reports its progress in quick succession
+class ProgressTestProcess : public itk::ProcessObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ProgressTestProcess);
+
+  using Self = ProgressTestProcess;
+  using Superclass = itk::ProcessObject;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkTypeMacro(ProgressTestProcess, ProcessObject);
+
+  void
+  Run()
+  {
+    for (unsigned int update = 1; update <= NumberOfUpdates; ++update)
+    {
+      this->UpdateProgress(static_cast<float>(update) / NumberOfUpdates);
+    }
+  }
+
+protected:
+  ProgressTestProcess() = default;
+  ~ProgressTestProcess() override = default;
+};
+
+int
+ProgressPipelineMain(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("progress-test", "A test ITK Wasm pipeline progress", argc, argv);
+
+  ITK_WASM_PARSE(pipeline);
+
+  auto process = ProgressTestProcess::New();
+  pipeline.observe_progress(process);
+  process->Run();
+
+  return EXIT_SUCCESS;
+}
+
+// Run the pipeline and collect the lines it writes on stderr
+int
+RunProgressPipeline(int argc, const char * argv[], std::vector<std::string> & lines)
+{
+  std::ostringstream errors;
+  std::streambuf * cerrBuffer = std::cerr.rdbuf(errors.rdbuf());
+  const int result = ProgressPipelineMain(argc, const_cast< char ** >(argv));
+  std::cerr.rdbuf(cerrBuffer);
+
+  std::istringstream stream(errors.str());
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    if (!line.empty())
+    {
+      lines.push_back(line);
+    }
+  }
+  return result;
+}
+} // namespace
+
+int
+itkPipelineProgressTest(int, char *[])
+{
+  // Without --progress, nothing is reported
+  const char * quietArgv[] = {"itkPipelineProgressTest", NULL};
+  std::vector<std::string> quietLines;
+  ITK_TEST_EXPECT_EQUAL(RunProgressPipeline(1, quietArgv, quietLines), EXIT_SUCCESS);
+  ITK_TEST_EXPECT_TRUE(quietLines.empty());
+
+  // With --progress, the updates are throttled to one every 100 ms, and the
+  // completion is always reported
+  const char * progressArgv[] = {"itkPipelineProgressTest", "--progress", NULL};
+  std::vector<std::string> lines;
+  ITK_TEST_EXPECT_EQUAL(RunProgressPipeline(2, progressArgv, lines), EXIT_SUCCESS);
+  ITK_TEST_EXPECT_TRUE(lines.size() >= 2);
+  ITK_TEST_EXPECT_TRUE(lines.size() < NumberOfUpdates / 10);
+
+  double lastProgress = 0.0;
+  for (const auto & line : lines)
+  {
+    rapidjson::Document document;
+    ITK_TEST_EXPECT_TRUE(!document.Parse(line.c_str()).HasParseError());
+    ITK_TEST_EXPECT_TRUE(document.IsObject() && document.HasMember("filter") && document["filter"].IsString());
+    ITK_TEST_EXPECT_TRUE(document.HasMember("progress") && document["progress"].IsNumber());
+    ITK_TEST_EXPECT_EQUAL(std::string(document["filter"].GetString()), std::string("ProgressTestProcess"));
+    const double progress = document["progress"].GetDouble();
+    ITK_TEST_EXPECT_TRUE(progress > lastProgress && progress <= 1.0);
+    lastProgress = progress;
+  }
+  ITK_TEST_EXPECT_EQUAL(lastProgress, 1.0);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkImage.h"
+#include "itkInputImage.h"
+#include "itkOutputImage.h"
+#include "itkPipelineStageStore.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using PixelType = float;
+using ImageType = itk::Image<PixelType, Dimension>;
+
+int
+StagePipelineMain(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("stage-test", "A test ITK Wasm pipeline stage", argc, argv);
+
+  using InputImageType = itk::wasm::InputImage<ImageType>;
+  InputImageType inputImage;
+  pipeline.add_option("input-image", inputImage, "The input image")->required()->type_name("INPUT_IMAGE");
+
+  using OutputImageType = itk::wasm::OutputImage<ImageType>;
+  OutputImageType outputImage;
+  pipeline.add_option("output-image", outputImage, "The output image")->required()->type_name("OUTPUT_IMAGE");
+
+  ITK_WASM_PARSE(pipeline);
+
+  outputImage.Set(inputImage.Get());
+
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkPipelineStageTest(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters" << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " InputImage OutputImage" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ITK_TEST_EXPECT_TRUE(itk::wasm::IsStageIdentifier("stage:first"));
+  ITK_TEST_EXPECT_TRUE(!itk::wasm::IsStageIdentifier("stage:"));
+  ITK_TEST_EXPECT_TRUE(!itk::wasm::IsStageIdentifier("first.mha"));
+
+  const char * firstArgv[] = {"itkPipelineStageTest", argv[1], "stage:first", NULL};
+  ITK_TEST_EXPECT_EQUAL(StagePipelineMain(3, const_cast< char ** >(firstArgv)), EXIT_SUCCESS);
+
+  const itk::DataObject * stageImage = itk::wasm::GetStageDataObject("stage:first");
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<const ImageType *>(stageImage) != nullptr);
+  const itk::wasm::StageDataObjectType * stageType = itk::wasm::GetStageDataObjectType("stage:first");
+  ITK_TEST_EXPECT_TRUE(stageType != nullptr);
+  ITK_TEST_EXPECT_EQUAL(stageType->dimension, Dimension);
+  ITK_TEST_EXPECT_EQUAL(stageType->componentType, std::string("float32"));
+  ITK_TEST_EXPECT_EQUAL(stageType->pixelType, std::string("Scalar"));
+  ITK_TEST_EXPECT_EQUAL(stageType->components, 1u);
+
+  const char * secondArgv[] = {"itkPipelineStageTest", "stage:first", "stage:second", NULL};
+  ITK_TEST_EXPECT_EQUAL(StagePipelineMain(3, const_cast< char ** >(secondArgv)), EXIT_SUCCESS);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::GetStageDataObject("stage:second"), stageImage);
+
+  const char * lastArgv[] = {"itkPipelineStageTest", "stage:second", argv[2], NULL};
+  ITK_TEST_EXPECT_EQUAL(StagePipelineMain(3, const_cast< char ** >(lastArgv)), EXIT_SUCCESS);
+
+  ITK_TEST_EXPECT_TRUE(itk::wasm::IsHandleIdentifier("handle:3"));
+  ITK_TEST_EXPECT_TRUE(itk::wasm::IsStageIdentifier("handle:3"));
+  ITK_TEST_EXPECT_TRUE(!itk::wasm::IsHandleIdentifier("handle:"));
+  ITK_TEST_EXPECT_TRUE(!itk::wasm::IsHandleIdentifier("handle:first"));
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::GetHandleIdentifier(3), std::string("handle:3"));
+
+  // Resident data objects are kept until they are released
+  const char * handleArgv[] = {"itkPipelineStageTest", "stage:first", "handle:3", NULL};
+  ITK_TEST_EXPECT_EQUAL(StagePipelineMain(3, const_cast< char ** >(handleArgv)), EXIT_SUCCESS);
+
+  itk::wasm::ClearStageDataObjects();
+  ITK_TEST_EXPECT_TRUE(itk::wasm::GetStageDataObject("stage:first") == nullptr);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::GetStageDataObject("handle:3"), stageImage);
+
+  const char * residentArgv[] = {"itkPipelineStageTest", "handle:3", "stage:resident", NULL};
+  ITK_TEST_EXPECT_EQUAL(StagePipelineMain(3, const_cast< char ** >(residentArgv)), EXIT_SUCCESS);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::GetStageDataObject("stage:resident"), stageImage);
+
+  // Patch a pixel of the resident image in place
+  const PixelType patch = 42.0f;
+  const int64_t patchIndex[Dimension] = { 0, 0 };
+  const uint64_t patchSize[Dimension] = { 1, 1 };
+  const auto modifiedTime = stageImage->GetMTime();
+  ITK_TEST_EXPECT_TRUE(itk::wasm::PatchStageImageRegion("handle:3", patchIndex, patchSize, &patch, sizeof(patch)));
+  ITK_TEST_EXPECT_EQUAL(dynamic_cast<const ImageType *>(stageImage)->GetBufferPointer()[0], patch);
+  ITK_TEST_EXPECT_TRUE(stageImage->GetMTime() > modifiedTime);
+  ITK_TEST_EXPECT_TRUE(!itk::wasm::PatchStageImageRegion("handle:3", patchIndex, patchSize, &patch, 1));
+
+  itk::wasm::ReleaseHandleDataObject(3);
+  ITK_TEST_EXPECT_TRUE(itk::wasm::GetStageDataObject("handle:3") == nullptr);
+  itk::wasm::ClearStageDataObjects();
+
+  return EXIT_SUCCESS;
+}
@@ -17,11 +17,41 @@
  *=========================================================================*/
 #include "itkWasmImageIOFactory.h"
 #include "itkWasmImageIO.h"
+#include "itkWasmAlignedFile.h"
+#include "itkWasmRangeReader.h"
 #include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
+#include "itkBinShrinkImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkMinimumMaximumImageCalculator.h"
 #include "itkTestingMacros.h"
 #include "itkMetaDataObject.h"
 
+#include <algorithm>
+
+namespace
+{
+// Exposes the mapped reads of the directory layout
+class MappedRegionImageIO : public itk::WasmImageIO
+{
+public:
+  using Self = MappedRegionImageIO;
+  using Superclass = itk::WasmImageIO;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkTypeMacro(MappedRegionImageIO, WasmImageIO);
+
+  using Superclass::ForEachIORegionLine;
+  using Superclass::MapDataFile;
+  using Superclass::ReadMappedRegion;
+
+protected:
+  MappedRegionImageIO() = default;
+  ~MappedRegionImageIO() override = default;
+};
+} // namespace
+
 int
 itkWasmImageIOTest(int argc, char * argv[])
 {
@@ -90,5 +120,268 @@ itkWasmImageIOTest(int argc, char * argv[])
 
   ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(wasmReader->GetOutput(), convertedCBORFile));
 
+  // Streamed read of the middle slice of the .iwi.cbor file
+  auto streamingReader = ReaderType::New();
+  streamingReader->SetFileName( imageCBOR );
+  streamingReader->UseStreamingOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamingReader->UpdateOutputInformation());
+  ImageType::RegionType sliceRegion = streamingReader->GetOutput()->GetLargestPossibleRegion();
+  sliceRegion.SetIndex(2, sliceRegion.GetIndex(2) + sliceRegion.GetSize(2) / 2);
+  sliceRegion.SetSize(2, 1);
+  streamingReader->GetOutput()->SetRequestedRegion(sliceRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamingReader->Update());
+  const ImageType * slice = streamingReader->GetOutput();
+  bool sliceMatches = true;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(slice, sliceRegion); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != inputImage->GetPixel(it.GetIndex()))
+    {
+      sliceMatches = false;
+      break;
+    }
+  }
+  ITK_TEST_EXPECT_TRUE(sliceMatches);
+
+  const auto imagesMatch = [](const ImageType * image, const ImageType * expected, const ImageType::RegionType & region) {
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+    {
+      if (it.Get() != expected->GetPixel(it.GetIndex()))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Box in the middle of the directory layout, read line by line from the
+  // mapped data file and with a streamed read
+  const ImageType::RegionType largestRegion = inputImage->GetLargestPossibleRegion();
+  ImageType::RegionType boxRegion = largestRegion;
+  itk::ImageIORegion boxIORegion(Dimension);
+  for (unsigned int dim = 0; dim < Dimension; ++dim)
+  {
+    boxRegion.SetIndex(dim, largestRegion.GetIndex(dim) + largestRegion.GetSize(dim) / 4);
+    boxRegion.SetSize(dim, std::max<itk::SizeValueType>(1, largestRegion.GetSize(dim) / 2));
+    boxIORegion.SetIndex(dim, boxRegion.GetIndex(dim) - largestRegion.GetIndex(dim));
+    boxIORegion.SetSize(dim, boxRegion.GetSize(dim));
+  }
+  auto mappedIO = MappedRegionImageIO::New();
+  mappedIO->SetFileName( imageDirectory );
+  ITK_TRY_EXPECT_NO_EXCEPTION(mappedIO->ReadImageInformation());
+  mappedIO->SetIORegion( boxIORegion );
+  size_t boxLines = 0;
+  uint64_t lastLineOffset = 0;
+  bool boxLinesInOrder = true;
+  mappedIO->ForEachIORegionLine([&](uint64_t offset, size_t lineBytes) {
+    boxLinesInOrder = boxLinesInOrder && (boxLines == 0 || offset > lastLineOffset) && lineBytes == boxRegion.GetSize(0) * sizeof(PixelType);
+    lastLineOffset = offset;
+    ++boxLines;
+  });
+  ITK_TEST_EXPECT_EQUAL(boxLines, boxRegion.GetNumberOfPixels() / boxRegion.GetSize(0));
+  ITK_TEST_EXPECT_TRUE(boxLinesInOrder);
+  if (mappedIO->MapDataFile(std::string(imageDirectory) + "/data/data.raw"))
+  {
+    auto box = ImageType::New();
+    box->CopyInformation( writtenReadImage );
+    box->SetRegions( boxRegion );
+    box->Allocate();
+    ITK_TRY_EXPECT_NO_EXCEPTION(mappedIO->ReadMappedRegion(box->GetBufferPointer()));
+    ITK_TEST_EXPECT_TRUE(imagesMatch(box, writtenReadImage, boxRegion));
+  }
+
+  auto boxReader = ReaderType::New();
+  boxReader->SetFileName( imageDirectory );
+  boxReader->UseStreamingOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(boxReader->UpdateOutputInformation());
+  boxReader->GetOutput()->SetRequestedRegion(boxRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(boxReader->Update());
+  ITK_TEST_EXPECT_TRUE(imagesMatch(boxReader->GetOutput(), writtenReadImage, boxRegion));
+
+  // Chunked directory layout with a downsampled level
+  const std::string directory = imageDirectory;
+  const std::string chunkedDirectory = directory.substr(0, directory.size() - 4) + "Chunked.iwi";
+  auto chunkedIO = itk::WasmImageIO::New();
+  chunkedIO->SetChunkSize({ 16, 16, 4 });
+  auto chunkedWriter = WriterType::New();
+  chunkedWriter->SetImageIO( chunkedIO );
+  chunkedWriter->SetFileName( chunkedDirectory );
+  chunkedWriter->SetInput( inputImage );
+  ITK_TRY_EXPECT_NO_EXCEPTION(chunkedWriter->Update());
+
+  using ShrinkFilterType = itk::BinShrinkImageFilter<ImageType, ImageType>;
+  auto shrinkFilter = ShrinkFilterType::New();
+  shrinkFilter->SetInput( inputImage );
+  shrinkFilter->SetShrinkFactors( 2 );
+  ITK_TRY_EXPECT_NO_EXCEPTION(shrinkFilter->Update());
+  chunkedIO->SetLevel( 1 );
+  chunkedWriter->SetInput( shrinkFilter->GetOutput() );
+  ITK_TRY_EXPECT_NO_EXCEPTION(chunkedWriter->Update());
+
+  auto chunkedReadIO = itk::WasmImageIO::New();
+  auto chunkedReader = ReaderType::New();
+  chunkedReader->SetImageIO( chunkedReadIO );
+  chunkedReader->SetFileName( chunkedDirectory );
+  ITK_TRY_EXPECT_NO_EXCEPTION(chunkedReader->Update());
+  ITK_TEST_EXPECT_EQUAL(chunkedReadIO->GetNumberOfLevels(), 2);
+  ITK_TEST_EXPECT_EQUAL(chunkedReadIO->GetChunkSize()[2], 4);
+  ITK_TEST_EXPECT_TRUE(imagesMatch(chunkedReader->GetOutput(), inputImage, inputImage->GetLargestPossibleRegion()));
+
+  auto chunkedStreamingReader = ReaderType::New();
+  chunkedStreamingReader->SetFileName( chunkedDirectory );
+  chunkedStreamingReader->UseStreamingOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(chunkedStreamingReader->UpdateOutputInformation());
+  chunkedStreamingReader->GetOutput()->SetRequestedRegion(sliceRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(chunkedStreamingReader->Update());
+  ITK_TEST_EXPECT_TRUE(imagesMatch(chunkedStreamingReader->GetOutput(), inputImage, sliceRegion));
+
+  auto levelReadIO = itk::WasmImageIO::New();
+  levelReadIO->SetLevel( 1 );
+  auto levelReader = ReaderType::New();
+  levelReader->SetImageIO( levelReadIO );
+  levelReader->SetFileName( chunkedDirectory );
+  ITK_TRY_EXPECT_NO_EXCEPTION(levelReader->Update());
+  const ImageType * shrunk = shrinkFilter->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(levelReader->GetOutput()->GetLargestPossibleRegion().GetSize(), shrunk->GetLargestPossibleRegion().GetSize());
+  ITK_TEST_EXPECT_TRUE(imagesMatch(levelReader->GetOutput(), shrunk, shrunk->GetLargestPossibleRegion()));
+
+  // Streamed write of the .iwi.cbor file, slab by slab
+  const std::string cbor = imageCBOR;
+  const std::string streamedCBOR = cbor.substr(0, cbor.size() - 9) + "Streamed.iwi.cbor";
+  auto streamingWriter = WriterType::New();
+  streamingWriter->SetFileName( streamedCBOR );
+  streamingWriter->SetInput( inputImage );
+  streamingWriter->SetNumberOfStreamDivisions( 4 );
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamingWriter->Update());
+  ImagePointer streamedImage = nullptr;
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamedImage = itk::ReadImage<ImageType>(streamedCBOR));
+  ITK_TEST_EXPECT_TRUE(imagesMatch(streamedImage, inputImage, inputImage->GetLargestPossibleRegion()));
+
+  // Aligned .iwi.bin file, written whole and slab by slab
+  const std::string alignedFile = cbor.substr(0, cbor.size() - 9) + "Aligned.iwi.bin";
+  auto alignedWriter = WriterType::New();
+  alignedWriter->SetFileName( alignedFile );
+  alignedWriter->SetInput( inputImage );
+  ITK_TRY_EXPECT_NO_EXCEPTION(alignedWriter->Update());
+  ImagePointer alignedImage = nullptr;
+  ITK_TRY_EXPECT_NO_EXCEPTION(alignedImage = itk::ReadImage<ImageType>(alignedFile));
+  ITK_TEST_EXPECT_TRUE(imagesMatch(alignedImage, inputImage, inputImage->GetLargestPossibleRegion()));
+  ITK_TEST_EXPECT_TRUE(alignedImage->GetMetaDataDictionary().HasKey(testEntryKey));
+
+  std::unique_ptr<itk::wasm::RangeReader> alignedReader = itk::wasm::RangeReader::Open(alignedFile);
+  ITK_TEST_EXPECT_TRUE(alignedReader != nullptr);
+  std::vector<unsigned char> alignedMetadata;
+  ITK_TEST_EXPECT_TRUE(itk::wasm::ReadAlignedFileMetadata(*alignedReader, itk::wasm::AlignedImageFileMagic, alignedMetadata));
+  const uint64_t alignedPixelsOffset = alignedReader->GetSize() - inputImage->GetPixelContainer()->Size() * sizeof(PixelType);
+  ITK_TEST_EXPECT_EQUAL(alignedPixelsOffset % itk::wasm::AlignedFilePayloadAlignment, 0);
+  PixelType firstPixel = 0;
+  ITK_TEST_EXPECT_TRUE(alignedReader->Read(alignedPixelsOffset, &firstPixel, sizeof(firstPixel)));
+  ITK_TEST_EXPECT_EQUAL(firstPixel, inputImage->GetBufferPointer()[0]);
+
+  const std::string streamedAlignedFile = cbor.substr(0, cbor.size() - 9) + "StreamedAligned.iwi.bin";
+  alignedWriter->SetFileName( streamedAlignedFile );
+  alignedWriter->SetNumberOfStreamDivisions( 4 );
+  ITK_TRY_EXPECT_NO_EXCEPTION(alignedWriter->Update());
+  auto alignedStreamingReader = ReaderType::New();
+  alignedStreamingReader->SetFileName( streamedAlignedFile );
+  alignedStreamingReader->UseStreamingOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(alignedStreamingReader->UpdateOutputInformation());
+  alignedStreamingReader->GetOutput()->SetRequestedRegion(sliceRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(alignedStreamingReader->Update());
+  ITK_TEST_EXPECT_TRUE(imagesMatch(alignedStreamingReader->GetOutput(), inputImage, sliceRegion));
+
+  // .iwi.bundle file with two members that share the test entry
+  const std::string bundleFile = cbor.substr(0, cbor.size() - 9) + "Bundle.iwi.bundle";
+  itk::wasm::MetaDataKeyFilter bundleKeyFilter;
+  bundleKeyFilter.SetIncludePatterns({ testEntryKey });
+  auto bundleIO = itk::WasmImageIO::New();
+  bundleIO->SetBundleMetaDataKeyFilter( bundleKeyFilter );
+  bundleIO->AppendToBundleOff();
+  bundleIO->SetBundleMemberName( "full" );
+  auto bundleWriter = WriterType::New();
+  bundleWriter->SetImageIO( bundleIO );
+  bundleWriter->SetFileName( bundleFile );
+  bundleWriter->SetInput( inputImage );
+  ITK_TRY_EXPECT_NO_EXCEPTION(bundleWriter->Update());
+  bundleIO->AppendToBundleOn();
+  bundleIO->SetBundleMemberName( "shrunk" );
+  bundleWriter->SetInput( shrinkFilter->GetOutput() );
+  ITK_TRY_EXPECT_NO_EXCEPTION(bundleWriter->Update());
+  ITK_TRY_EXPECT_EXCEPTION(bundleWriter->Update());
+
+  auto bundleReadIO = itk::WasmImageIO::New();
+  bundleReadIO->SetBundleMemberName( "shrunk" );
+  auto bundleReader = ReaderType::New();
+  bundleReader->SetImageIO( bundleReadIO );
+  bundleReader->SetFileName( bundleFile );
+  ITK_TRY_EXPECT_NO_EXCEPTION(bundleReader->Update());
+  ITK_TEST_EXPECT_EQUAL(bundleReadIO->GetBundleMemberNames().size(), 2);
+  ITK_TEST_EXPECT_TRUE(imagesMatch(bundleReader->GetOutput(), shrunk, shrunk->GetLargestPossibleRegion()));
+  ITK_TEST_EXPECT_TRUE(bundleReader->GetOutput()->GetMetaDataDictionary().HasKey(testEntryKey));
+
+  auto bundleIndexReadIO = itk::WasmImageIO::New();
+  bundleIndexReadIO->SetBundleMemberIndex( 0 );
+  auto bundleIndexReader = ReaderType::New();
+  bundleIndexReader->SetImageIO( bundleIndexReadIO );
+  bundleIndexReader->SetFileName( bundleFile );
+  ITK_TRY_EXPECT_NO_EXCEPTION(bundleIndexReader->Update());
+  ITK_TEST_EXPECT_TRUE(imagesMatch(bundleIndexReader->GetOutput(), inputImage, inputImage->GetLargestPossibleRegion()));
+  ITK_TEST_EXPECT_TRUE(bundleIndexReader->GetOutput()->GetMetaDataDictionary().HasKey(testEntryKey));
+  bundleIndexReadIO->SetBundleMemberIndex( 2 );
+  bundleIndexReader->Modified();
+  ITK_TRY_EXPECT_EXCEPTION(bundleIndexReader->Update());
+
+  // Range reads of the .iwi.cbor file, which is a top-level map
+  // Intensity statistics in the header, read with the image information
+  const std::string statisticsFile = cbor.substr(0, cbor.size() - 9) + "Statistics.iwi.cbor";
+  auto statisticsIO = itk::WasmImageIO::New();
+  statisticsIO->ComputeIntensityStatisticsOn();
+  auto statisticsWriter = WriterType::New();
+  statisticsWriter->SetImageIO( statisticsIO );
+  statisticsWriter->SetFileName( statisticsFile );
+  statisticsWriter->SetInput( inputImage );
+  statisticsWriter->SetNumberOfStreamDivisions( 4 );
+  ITK_TRY_EXPECT_NO_EXCEPTION(statisticsWriter->Update());
+  ITK_TEST_EXPECT_EQUAL(statisticsIO->GetIntensityStatistics().components.size(), 1);
+
+  auto statisticsReadIO = itk::WasmImageIO::New();
+  statisticsReadIO->SetFileName( statisticsFile );
+  ITK_TRY_EXPECT_NO_EXCEPTION(statisticsReadIO->ReadImageInformation());
+  const itk::wasm::IntensityStatistics & statistics = statisticsReadIO->GetIntensityStatistics();
+  ITK_TEST_EXPECT_EQUAL(statistics.components.size(), 1);
+  auto minimumMaximum = itk::MinimumMaximumImageCalculator<ImageType>::New();
+  minimumMaximum->SetImage( inputImage );
+  minimumMaximum->Compute();
+  ITK_TEST_EXPECT_EQUAL(statistics.components[0].minimum, minimumMaximum->GetMinimum());
+  ITK_TEST_EXPECT_EQUAL(statistics.components[0].maximum, minimumMaximum->GetMaximum());
+  ITK_TEST_EXPECT_EQUAL(statistics.components[0].histogram.size(), itk::wasm::DefaultIntensityHistogramBins);
+  uint64_t histogramCount = 0;
+  for (const uint64_t count : statistics.components[0].histogram)
+  {
+    histogramCount += count;
+  }
+  ITK_TEST_EXPECT_EQUAL(histogramCount, inputImage->GetLargestPossibleRegion().GetNumberOfPixels());
+
+  const std::string statisticsDirectory = cbor.substr(0, cbor.size() - 9) + "Statistics.iwi";
+  statisticsWriter->SetFileName( statisticsDirectory );
+  ITK_TRY_EXPECT_NO_EXCEPTION(statisticsWriter->Update());
+  statisticsReadIO->SetFileName( statisticsDirectory );
+  ITK_TRY_EXPECT_NO_EXCEPTION(statisticsReadIO->ReadImageInformation());
+  ITK_TEST_EXPECT_EQUAL(statisticsReadIO->GetIntensityStatistics().components[0].mean, statistics.components[0].mean);
+
+  auto plainReadIO = itk::WasmImageIO::New();
+  plainReadIO->SetFileName( imageCBOR );
+  ITK_TRY_EXPECT_NO_EXCEPTION(plainReadIO->ReadImageInformation());
+  ITK_TEST_EXPECT_TRUE(plainReadIO->GetIntensityStatistics().IsEmpty());
+
+  std::unique_ptr<itk::wasm::RangeReader> rangeReader = itk::wasm::RangeReader::Open(imageCBOR);
+  ITK_TEST_EXPECT_TRUE(rangeReader != nullptr);
+  unsigned char cborHead = 0;
+  ITK_TEST_EXPECT_TRUE(rangeReader->Read(0, &cborHead, 1));
+  ITK_TEST_EXPECT_EQUAL(cborHead >> 5, 5);
+  ITK_TEST_EXPECT_TRUE(!rangeReader->Read(rangeReader->GetSize(), &cborHead, 1));
+  ITK_TEST_EXPECT_TRUE(itk::wasm::RangeReader::IsURL("https://example.com/image.iwi"));
+  ITK_TEST_EXPECT_TRUE(!itk::wasm::RangeReader::IsURL(imageCBOR));
+  ITK_TEST_EXPECT_TRUE(itk::wasm::RangeReader::Open(chunkedDirectory) == nullptr);
+
   return EXIT_SUCCESS;
 }
@@ -19,8 +19,14 @@
 #include "itkWasmImageToImageFilter.h"
 
 #include "itkImageFileReader.h"
+#include "itkMetaDataObject.h"
 #include "itkImageFileWriter.h"
 #include "itkTestingMacros.h"
+#include "itkVector.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
 
 int
 itkWasmImageInterfaceTest(int argc, char * argv[])
@@ -60,5 +66,164 @@ itkWasmImageInterfaceTest(int argc, char * argv[])
 
   ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(convertedImage, outputImageFile));
 
+  // Round trip through the binary image descriptor
+  auto imageToDescriptor = ImageToWasmImageFilterType::New();
+  imageToDescriptor->SetInput(inputImage);
+  imageToDescriptor->UseDescriptorOn();
+  imageToDescriptor->Update();
+  ITK_TEST_EXPECT_TRUE(imageToDescriptor->GetOutput()->GetUseDescriptor());
+  ITK_TEST_EXPECT_EQUAL(imageToDescriptor->GetOutput()->GetDescriptor().dimension, Dimension);
+
+  auto descriptorToImage = WasmImageToImageFilterType::New();
+  descriptorToImage->SetInput(imageToDescriptor->GetOutput());
+  descriptorToImage->Update();
+  ImageType::Pointer descriptorImage = descriptorToImage->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(descriptorImage->GetLargestPossibleRegion(), inputImage->GetLargestPossibleRegion());
+  ITK_TEST_EXPECT_EQUAL(descriptorImage->GetOrigin(), inputImage->GetOrigin());
+  ITK_TEST_EXPECT_EQUAL(descriptorImage->GetSpacing(), inputImage->GetSpacing());
+  ITK_TEST_EXPECT_TRUE(std::equal(inputImage->GetBufferPointer(),
+    inputImage->GetBufferPointer() + inputImage->GetPixelContainer()->Size(),
+    descriptorImage->GetBufferPointer()));
+
+  // Other component types are converted on import with a ComponentConversion
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::GetConvertedComponentType(itk::wasm::ComponentConversion::IntegerToInt32, "uint16"), "int32");
+  ITK_TEST_EXPECT_TRUE(itk::wasm::GetConvertedComponentType(itk::wasm::ComponentConversion::IntegerToInt32, "uint32").empty());
+  ITK_TEST_EXPECT_TRUE(itk::wasm::GetConvertedComponentType(itk::wasm::ComponentConversion::ToFloat32, "float32").empty());
+  ITK_TEST_EXPECT_TRUE(itk::wasm::IsConvertedComponentType(itk::wasm::ComponentConversion::Cast, "float64", "uint8"));
+  ITK_TEST_EXPECT_TRUE(!itk::wasm::IsConvertedComponentType(itk::wasm::ComponentConversion::IntegerToInt32, "uint32", "int32"));
+
+  // Float to integer conversions truncate and wrap as JavaScript TypedArray's
+  const float castComponents[] = { 300.7f, -1.5f, std::numeric_limits<float>::quiet_NaN(), 65535.9f, -129.0f, 1.0f, 2.0f, 3.0f, 4e9f };
+  uint8_t castUInt8[9];
+  ITK_TEST_EXPECT_TRUE(itk::wasm::ConvertComponents("float32", castComponents, 9, castUInt8));
+  ITK_TEST_EXPECT_EQUAL(static_cast<int>(castUInt8[0]), 44);
+  ITK_TEST_EXPECT_EQUAL(static_cast<int>(castUInt8[1]), 255);
+  ITK_TEST_EXPECT_EQUAL(static_cast<int>(castUInt8[2]), 0);
+  ITK_TEST_EXPECT_EQUAL(static_cast<int>(castUInt8[3]), 255);
+  ITK_TEST_EXPECT_EQUAL(static_cast<int>(castUInt8[4]), 127);
+  ITK_TEST_EXPECT_EQUAL(static_cast<int>(castUInt8[8]), 0);
+  int32_t castInt32[9];
+  ITK_TEST_EXPECT_TRUE(itk::wasm::ConvertComponents("float32", castComponents, 9, castInt32));
+  ITK_TEST_EXPECT_EQUAL(castInt32[1], -1);
+  ITK_TEST_EXPECT_EQUAL(castInt32[8], -294967296);
+  using FloatImageType = itk::Image<float, Dimension>;
+  using WasmImageToFloatImageFilterType = itk::WasmImageToImageFilter<FloatImageType>;
+  auto descriptorToFloatImage = WasmImageToFloatImageFilterType::New();
+  descriptorToFloatImage->SetInput(imageToDescriptor->GetOutput());
+  bool unexpectedComponentType = false;
+  try
+  {
+    descriptorToFloatImage->Update();
+  }
+  catch (const std::runtime_error &)
+  {
+    unexpectedComponentType = true;
+  }
+  ITK_TEST_EXPECT_TRUE(unexpectedComponentType);
+  descriptorToFloatImage->SetComponentConversion(itk::wasm::ComponentConversion::IntegerToFloat32);
+  descriptorToFloatImage->Update();
+  FloatImageType::Pointer floatImage = descriptorToFloatImage->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(floatImage->GetLargestPossibleRegion(), inputImage->GetLargestPossibleRegion());
+  ITK_TEST_EXPECT_TRUE(std::equal(inputImage->GetBufferPointer(),
+    inputImage->GetBufferPointer() + inputImage->GetPixelContainer()->Size(),
+    floatImage->GetBufferPointer(),
+    [](PixelType pixel, float converted) { return static_cast<float>(pixel) == converted; }));
+
+  // Planar, channel-first, pixel data is interleaved on import
+  using VectorImageType = itk::Image<itk::Vector<float, 3>, 2>;
+  auto vectorImage = VectorImageType::New();
+  VectorImageType::SizeType vectorImageSize;
+  vectorImageSize.Fill(64);
+  vectorImage->SetRegions(vectorImageSize);
+  vectorImage->Allocate();
+  const itk::SizeValueType numberOfPixels = vectorImage->GetLargestPossibleRegion().GetNumberOfPixels();
+  float * vectorImageData = vectorImage->GetBufferPointer()->GetDataPointer();
+  for (itk::SizeValueType ii = 0; ii < numberOfPixels * 3; ++ii)
+  {
+    vectorImageData[ii] = static_cast<float>(ii);
+  }
+  auto vectorImageToPlanar = itk::ImageToWasmImageFilter<VectorImageType>::New();
+  vectorImageToPlanar->SetInput(vectorImage);
+  vectorImageToPlanar->PlanarLayoutOn();
+  vectorImageToPlanar->Update();
+  const float * planarData = vectorImageToPlanar->GetOutput()->GetImage()->GetBufferPointer()->GetDataPointer();
+  ITK_TEST_EXPECT_EQUAL(planarData[1], 3.0f);
+  ITK_TEST_EXPECT_EQUAL(planarData[numberOfPixels], 1.0f);
+  ITK_TEST_EXPECT_EQUAL(planarData[2 * numberOfPixels + 5], 17.0f);
+  auto planarToVectorImage = itk::WasmImageToImageFilter<VectorImageType>::New();
+  planarToVectorImage->SetInput(vectorImageToPlanar->GetOutput());
+  planarToVectorImage->PlanarLayoutOn();
+  planarToVectorImage->Update();
+  ITK_TEST_EXPECT_TRUE(std::equal(vectorImageData,
+    vectorImageData + numberOfPixels * 3,
+    planarToVectorImage->GetOutput()->GetBufferPointer()->GetDataPointer()));
+
+  // A sub-region is output as a strided view of the input buffer, or copied
+  VectorImageType::RegionType subRegion;
+  subRegion.SetIndex(0, 5);
+  subRegion.SetIndex(1, 7);
+  subRegion.SetSize(0, 10);
+  subRegion.SetSize(1, 20);
+  auto subRegionToView = itk::ImageToWasmImageFilter<VectorImageType>::New();
+  subRegionToView->SetInput(vectorImage);
+  subRegionToView->SetOutputRegion(subRegion);
+  subRegionToView->UseStridesOn();
+  subRegionToView->Update();
+  ITK_TEST_EXPECT_TRUE(subRegionToView->GetOutput()->GetHasDataView());
+  ITK_TEST_EXPECT_TRUE(subRegionToView->GetOutput()->GetJSON().find("\"strides\":[3,192]") != std::string::npos);
+  ITK_TEST_EXPECT_EQUAL(subRegionToView->GetOutput()->GetDataViewAddress(),
+                        reinterpret_cast<size_t>(vectorImageData + (7 * 64 + 5) * 3));
+  ITK_TEST_EXPECT_EQUAL(subRegionToView->GetOutput()->GetDataViewSize(), (19 * 64 + 10) * 3 * sizeof(float));
+  auto viewToVectorImage = itk::WasmImageToImageFilter<VectorImageType>::New();
+  viewToVectorImage->SetInput(subRegionToView->GetOutput());
+  viewToVectorImage->Update();
+  auto subRegionCopy = itk::wasm::CopyImageRegion(vectorImage.GetPointer(), subRegion);
+  const itk::SizeValueType subRegionComponents = subRegion.GetNumberOfPixels() * 3;
+  ITK_TEST_EXPECT_EQUAL(viewToVectorImage->GetOutput()->GetLargestPossibleRegion().GetSize(), subRegion.GetSize());
+  VectorImageType::PointType subRegionOrigin;
+  vectorImage->TransformIndexToPhysicalPoint(subRegion.GetIndex(), subRegionOrigin);
+  ITK_TEST_EXPECT_EQUAL(viewToVectorImage->GetOutput()->GetOrigin(), subRegionOrigin);
+  ITK_TEST_EXPECT_TRUE(std::equal(subRegionCopy->GetBufferPointer()->GetDataPointer(),
+    subRegionCopy->GetBufferPointer()->GetDataPointer() + subRegionComponents,
+    viewToVectorImage->GetOutput()->GetBufferPointer()->GetDataPointer()));
+  ITK_TEST_EXPECT_EQUAL(subRegionCopy->GetBufferPointer()->GetDataPointer()[0], static_cast<float>((7 * 64 + 5) * 3));
+
+  auto subRegionToCopy = itk::ImageToWasmImageFilter<VectorImageType>::New();
+  subRegionToCopy->SetInput(vectorImage);
+  subRegionToCopy->SetOutputRegion(subRegion);
+  subRegionToCopy->Update();
+  ITK_TEST_EXPECT_TRUE(!subRegionToCopy->GetOutput()->GetHasDataView());
+  ITK_TEST_EXPECT_TRUE(subRegionToCopy->GetOutput()->GetJSON().find("strides") == std::string::npos);
+  ITK_TEST_EXPECT_TRUE(std::equal(subRegionCopy->GetBufferPointer()->GetDataPointer(),
+    subRegionCopy->GetBufferPointer()->GetDataPointer() + subRegionComponents,
+    subRegionToCopy->GetOutput()->GetImage()->GetBufferPointer()->GetDataPointer()));
+
+  // Metadata is attached to the converted image unless conversion is disabled
+  const std::string metaDataKey = "WasmImageInterfaceTest";
+  const std::string metaDataValue = "metadata";
+  itk::EncapsulateMetaData<std::string>(inputImage->GetMetaDataDictionary(), metaDataKey, metaDataValue);
+  auto metaDataToJSON = ImageToWasmImageFilterType::New();
+  metaDataToJSON->SetInput(inputImage);
+  metaDataToJSON->Update();
+
+  auto jsonToMetaData = WasmImageToImageFilterType::New();
+  jsonToMetaData->SetInput(metaDataToJSON->GetOutput());
+  jsonToMetaData->Update();
+  std::string convertedValue;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData<std::string>(jsonToMetaData->GetOutput()->GetMetaDataDictionary(), metaDataKey, convertedValue));
+  ITK_TEST_EXPECT_EQUAL(convertedValue, metaDataValue);
+
+  auto jsonSkipMetaData = WasmImageToImageFilterType::New();
+  jsonSkipMetaData->SetInput(metaDataToJSON->GetOutput());
+  jsonSkipMetaData->ConvertMetaDataOff();
+  jsonSkipMetaData->Update();
+  ITK_TEST_EXPECT_TRUE(!jsonSkipMetaData->GetOutput()->GetMetaDataDictionary().HasKey(metaDataKey));
+
+  auto skipMetaDataToJSON = ImageToWasmImageFilterType::New();
+  skipMetaDataToJSON->SetInput(inputImage);
+  skipMetaDataToJSON->ConvertMetaDataOff();
+  skipMetaDataToJSON->Update();
+  ITK_TEST_EXPECT_TRUE(skipMetaDataToJSON->GetOutput()->GetJSON().find(metaDataKey) == std::string::npos);
+
   return EXIT_SUCCESS;
 }
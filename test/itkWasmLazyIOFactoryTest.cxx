@@ -0,0 +1,84 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkWasmLazyIOFactory.h"
+#include "itkWasmImageIO.h"
+#include "itkMetaImageIO.h"
+
+#include <iostream>
+
+namespace
+{
+
+unsigned int metaConstructed = 0;
+unsigned int wasmConstructed = 0;
+
+itk::ImageIOBase::Pointer
+CreateMetaImageIO()
+{
+  ++metaConstructed;
+  return itk::MetaImageIO::New().GetPointer();
+}
+
+itk::ImageIOBase::Pointer
+CreateWasmImageIO()
+{
+  ++wasmConstructed;
+  return itk::WasmImageIO::New().GetPointer();
+}
+
+} // end anonymous namespace
+
+int
+itkWasmLazyIOFactoryTest(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " inputImage.mha outputImage.iwi.cbor" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char * inputImageFile = argv[1];
+  const char * outputImageFile = argv[2];
+
+  using LazyImageIOFactory = itk::wasm::LazyImageIOFactory;
+  using FileHeader = itk::wasm::FileHeader;
+  LazyImageIOFactory::RegisterStub({ "wasm", { ".iwi", ".iwi/", ".iwi.cbor" }, [](const FileHeader & header) {
+                                      return header.Has(1, "\x69imageType");
+                                    }, CreateWasmImageIO });
+  LazyImageIOFactory::RegisterStub({ "meta", { ".mha", ".mhd" }, [](const FileHeader & header) {
+                                      return header.StartsWithKeyword("ObjectType") || header.StartsWithKeyword("NDims");
+                                    }, CreateMetaImageIO });
+  // Stubs are registered once per name
+  LazyImageIOFactory::RegisterStub({ "meta", { ".mha" }, nullptr, CreateMetaImageIO });
+  ITK_TEST_EXPECT_EQUAL(LazyImageIOFactory::GetNumberOfStubs(), 2);
+
+  // Only the IO of the matching stub is constructed
+  auto readIO = LazyImageIOFactory::CreateIO(inputImageFile, itk::CommonEnums::IOFileMode::ReadMode);
+  ITK_TEST_EXPECT_TRUE(readIO.IsNotNull());
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<itk::MetaImageIO *>(readIO.GetPointer()) != nullptr);
+  ITK_TEST_EXPECT_EQUAL(metaConstructed, 1);
+  ITK_TEST_EXPECT_EQUAL(wasmConstructed, 0);
+
+  auto writeIO = LazyImageIOFactory::CreateIO(outputImageFile, itk::CommonEnums::IOFileMode::WriteMode);
+  ITK_TEST_EXPECT_TRUE(writeIO.IsNotNull());
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<itk::WasmImageIO *>(writeIO.GetPointer()) != nullptr);
+  ITK_TEST_EXPECT_EQUAL(metaConstructed, 1);
+  ITK_TEST_EXPECT_EQUAL(wasmConstructed, 1);
+
+  return EXIT_SUCCESS;
+}
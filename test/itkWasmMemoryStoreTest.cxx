@@ -0,0 +1,219 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkWasmExports.h"
+#include "rapidjson/document.h"
+#include <cstring>
+#include <thread>
+#include <vector>
+
+int
+itkWasmMemoryStoreTest(int argc, char * argv[])
+{
+  const std::string firstJSON = "{ \"session\": 0 }";
+  const std::string secondJSON = "{ \"session\": 1 }";
+
+  const uint32_t session = itk_wasm_memory_session_create();
+  ITK_TEST_EXPECT_TRUE(session != 0);
+  ITK_TEST_EXPECT_TRUE(itk_wasm_memory_session_create() != session);
+
+  void * firstPointer = reinterpret_cast< void * >( itk_wasm_input_json_alloc(0, 0, firstJSON.size()));
+  std::memcpy(firstPointer, firstJSON.data(), firstJSON.size());
+  void * secondPointer = reinterpret_cast< void * >( itk_wasm_input_json_alloc(session, 0, secondJSON.size()));
+  std::memcpy(secondPointer, secondJSON.data(), secondJSON.size());
+
+  ITK_TEST_EXPECT_TRUE(itk::wasm::getMemoryStoreInputJSON(0, 0) == firstJSON);
+  ITK_TEST_EXPECT_TRUE(itk::wasm::getMemoryStoreInputJSON(session, 0) == secondJSON);
+
+  const size_t arrayAddress = itk_wasm_input_array_alloc(session, 0, 0, 8);
+  ITK_TEST_EXPECT_TRUE(arrayAddress != 0);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::getMemoryInputArrayStore(session).size(), 1);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::getMemoryInputArrayStore(0).size(), 0);
+
+  auto dataObject = itk::WasmDataObject::New();
+  dataObject->SetJSON("{}");
+  itk::wasm::setMemoryStoreOutputDataObject(session, 0, dataObject);
+  itk::wasm::setMemoryStoreOutputArray(session, 0, 0, arrayAddress, 8);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_array_address(session, 0, 0), arrayAddress);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_array_size(session, 0, 0), 8);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_json_size(session, 0), 2);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_exists(session, 0), 1);
+
+  // An optional output that the pipeline did not set has no JSON
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_exists(session, 1), 0);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_json_size(session, 1), 0);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_json_address(session, 1), 0);
+
+  // Memory stats report the bytes held by the stores of a session
+  itk::wasm::resetMemoryPhases();
+  itk::wasm::markMemoryPhase("parse");
+  itk::wasm::markMemoryPhase("parse");
+  const char * statsJSON = reinterpret_cast< const char * >( itk_wasm_memory_stats(session) );
+  rapidjson::Document stats;
+  ITK_TEST_EXPECT_TRUE(!stats.Parse(statsJSON, itk_wasm_memory_stats_size()).HasParseError());
+  ITK_TEST_EXPECT_TRUE(stats["inputArrayStore"].GetUint64() >= 8);
+  ITK_TEST_EXPECT_TRUE(stats["inputJSONStore"].GetUint64() >= secondJSON.size());
+  ITK_TEST_EXPECT_EQUAL(stats["outputArrayStore"].GetUint64(), 8);
+  ITK_TEST_EXPECT_EQUAL(stats["phases"].MemberCount(), 1);
+
+  // Input array handoff moves the buffer out of the store without changing its address
+  ITK_TEST_EXPECT_TRUE(!itk::wasm::getMemoryStoreInputArrayHandoff(session));
+  itk_wasm_input_array_handoff(session, 1);
+  ITK_TEST_EXPECT_TRUE(itk::wasm::getMemoryStoreInputArrayHandoff(session));
+  itk::wasm::InputArrayStoreValueType handoffArray;
+  ITK_TEST_EXPECT_TRUE(itk::wasm::takeMemoryStoreInputArray(session, arrayAddress, handoffArray));
+  ITK_TEST_EXPECT_EQUAL(reinterpret_cast< size_t >(handoffArray.data()), arrayAddress);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::getMemoryInputArrayStore(session).size(), 0);
+  ITK_TEST_EXPECT_TRUE(!itk::wasm::takeMemoryStoreInputArray(session, arrayAddress, handoffArray));
+
+  // Freed input arrays are recycled for allocations of a similar size
+  const size_t pooledAddress = itk_wasm_input_array_alloc(session, 1, 0, 1024);
+  itk_wasm_free_input(session, 1, 0);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::getMemoryInputArrayStore(session).size(), 0);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_input_array_alloc(session, 2, 0, 1000), pooledAddress);
+  itk_wasm_buffer_pool_clear();
+
+  // The pool keeps the most recently released arrays up to its capacity
+  itk_wasm_buffer_pool_capacity(2048);
+  itk_wasm_input_array_alloc(session, 4, 0, 1024);
+  itk_wasm_free_input(session, 4, 0);
+  const size_t recentAddress = itk_wasm_input_array_alloc(session, 5, 0, 1500);
+  itk_wasm_free_input(session, 5, 0);
+  itk_wasm_input_array_alloc(session, 6, 0, 4096);
+  itk_wasm_free_input(session, 6, 0);
+  statsJSON = reinterpret_cast< const char * >( itk_wasm_memory_stats(session) );
+  ITK_TEST_EXPECT_TRUE(!stats.Parse(statsJSON, itk_wasm_memory_stats_size()).HasParseError());
+  ITK_TEST_EXPECT_TRUE(stats["bufferPool"].GetUint64() <= 2048);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_input_array_alloc(session, 7, 0, 1400), recentAddress);
+  itk_wasm_free_input(session, 7, 0);
+  itk_wasm_buffer_pool_capacity(size_t{ 64 } << 20);
+  itk_wasm_buffer_pool_clear();
+
+  // Chunks appended within the reserved capacity keep the array address
+  const size_t reservedAddress = itk_wasm_input_array_reserve(session, 3, 0, 16);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_input_array_append(session, 3, 0, 8), reservedAddress);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_input_array_append(session, 3, 0, 8), reservedAddress + 8);
+  // Chunks past the reserved capacity are rejected
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_input_array_append(session, 3, 0, 1), 0);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::getMemoryInputArrayStore(session).at(std::make_pair(3u, 0u)).size(), 16);
+
+  itk_wasm_free_output(session, 0);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_array_size(session, 0, 0), 0);
+
+  // The host can request an abort through the export or the flag word
+  ITK_TEST_EXPECT_TRUE(!itk::wasm::getAbortRequested());
+  itk_wasm_request_abort();
+  ITK_TEST_EXPECT_TRUE(itk::wasm::getAbortRequested());
+  itk::wasm::clearAbortRequested();
+  *reinterpret_cast< uint32_t * >( itk_wasm_abort_flag_address() ) = 1;
+  ITK_TEST_EXPECT_TRUE(itk::wasm::getAbortRequested());
+  itk::wasm::clearAbortRequested();
+
+  // Identical inputs at different addresses have the same result cache key
+  {
+  const std::string jsonWithAddress = "{ \"data\": \"data:application/vnd.itk.address,0:";
+  const uint32_t cacheSession = itk_wasm_memory_session_create();
+  const uint8_t content[4] = { 1, 2, 3, 4 };
+  const auto stageInputs = [&](size_t arraySize) -> uint64_t {
+    const size_t address = itk_wasm_input_array_alloc(cacheSession, 0, 0, arraySize);
+    std::memcpy(reinterpret_cast< void * >(address), content, sizeof(content));
+    const std::string json = jsonWithAddress + std::to_string(address) + "\" }";
+    std::memcpy(reinterpret_cast< void * >(itk_wasm_input_json_alloc(cacheSession, 0, json.size())), json.data(), json.size());
+    itk::wasm::ContentHash hash;
+    ITK_TEST_EXPECT_TRUE(itk::wasm::hashMemoryStoreInputs(cacheSession, hash));
+    return hash.Digest();
+  };
+  const uint64_t firstKey = stageInputs(sizeof(content));
+  itk_wasm_free_input(cacheSession, 0, 0);
+  itk_wasm_buffer_pool_clear();
+  const uint64_t secondKey = stageInputs(sizeof(content));
+  ITK_TEST_EXPECT_EQUAL(firstKey, secondKey);
+  ITK_TEST_EXPECT_TRUE(stageInputs(sizeof(content) + 1) != firstKey);
+
+  // Cached outputs are published with their arrays
+  auto entry = std::make_shared<itk::wasm::ResultCacheEntry>();
+  (*entry)[0].json = "{ \"cached\": true }";
+  (*entry)[0].arrays[0] = std::vector<uint8_t>(content, content + sizeof(content));
+  itk::wasm::resetMemoryStoreUpdatedOutputs(cacheSession);
+  itk::wasm::setMemoryStoreResultCacheEntry(cacheSession, entry);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_json_size(cacheSession, 0), (*entry)[0].json.size());
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_array_size(cacheSession, 0, 0), sizeof(content));
+  ITK_TEST_EXPECT_EQUAL(std::memcmp(reinterpret_cast< void * >(itk_wasm_output_array_address(cacheSession, 0, 0)), content, sizeof(content)), 0);
+  itk::wasm::ResultCacheEntry collected;
+  ITK_TEST_EXPECT_TRUE(itk::wasm::getMemoryStoreResultCacheEntry(cacheSession, collected));
+  ITK_TEST_EXPECT_TRUE(collected.at(0).json == (*entry)[0].json);
+  ITK_TEST_EXPECT_TRUE(collected.at(0).arrays.at(0) == (*entry)[0].arrays[0]);
+  itk_wasm_memory_session_destroy(cacheSession);
+
+  // The memory store evicts the least recently used entries
+  itk::wasm::MemoryResultCacheStore cacheStore(2 * itk::wasm::GetResultCacheEntrySize(*entry));
+  cacheStore.Put(1, entry);
+  cacheStore.Put(2, entry);
+  ITK_TEST_EXPECT_TRUE(cacheStore.Get(1) != nullptr);
+  cacheStore.Put(3, entry);
+  ITK_TEST_EXPECT_TRUE(cacheStore.Get(2) == nullptr);
+  ITK_TEST_EXPECT_TRUE(cacheStore.Get(1) != nullptr);
+  ITK_TEST_EXPECT_TRUE(cacheStore.Get(3) != nullptr);
+  ITK_TEST_EXPECT_EQUAL(cacheStore.GetSize(), 2 * itk::wasm::GetResultCacheEntrySize(*entry));
+  }
+
+  // Stages publish outputs, and stage and take inputs, from concurrent threads
+  {
+  const uint32_t threadSession = itk_wasm_memory_session_create();
+  constexpr uint32_t numberOfThreads = 8;
+  constexpr uint32_t outputsPerThread = 64;
+  std::vector<std::thread> threads;
+  for (uint32_t thread = 0; thread < numberOfThreads; ++thread)
+  {
+    threads.emplace_back([thread, threadSession]() {
+      for (uint32_t ii = 0; ii < outputsPerThread; ++ii)
+      {
+        const uint32_t index = thread * outputsPerThread + ii;
+        auto threadDataObject = itk::WasmDataObject::New();
+        threadDataObject->SetJSON("{}");
+        itk::wasm::setMemoryStoreOutputDataObject(threadSession, index, threadDataObject);
+        const size_t address = itk_wasm_input_array_alloc(threadSession, index, 0, 32);
+        itk::wasm::setMemoryStoreOutputArray(threadSession, index, 0, address, 32);
+        itk::wasm::InputArrayStoreValueType taken;
+        itk::wasm::takeMemoryStoreInputArray(threadSession, address, taken);
+      }
+    });
+  }
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+  for (uint32_t index = 0; index < numberOfThreads * outputsPerThread; ++index)
+  {
+    ITK_TEST_EXPECT_EQUAL(itk_wasm_output_json_size(threadSession, index), 2);
+    ITK_TEST_EXPECT_EQUAL(itk_wasm_output_array_size(threadSession, index, 0), 32);
+  }
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::getMemoryInputArrayStore(threadSession).size(), 0);
+  itk_wasm_memory_session_destroy(threadSession);
+  }
+
+  // Destroying one session must not affect another
+  itk_wasm_memory_session_destroy(session);
+  ITK_TEST_EXPECT_TRUE(itk::wasm::getMemoryStoreInputJSON(0, 0) == firstJSON);
+  ITK_TEST_EXPECT_TRUE(itk::wasm::getMemoryStoreInputJSON(session, 0).empty());
+
+  itk_wasm_free_all();
+  ITK_TEST_EXPECT_TRUE(itk::wasm::getMemoryStoreInputJSON(0, 0).empty());
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,241 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkWasmMeshChunks.h"
+#include "itkWasmMeshIO.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <vector>
+
+namespace
+{
+
+constexpr uint32_t GridSize = 40;
+constexpr uint32_t NumberOfPoints = GridSize * GridSize;
+constexpr uint32_t NumberOfCells = 2 * (GridSize - 1) * (GridSize - 1);
+constexpr uint32_t TriangleCell = 2;
+constexpr uint64_t MaximumPointsPerChunk = 256;
+
+template <typename T>
+const T *
+Elements(const std::vector<char> & buffer)
+{
+  return reinterpret_cast<const T *>(buffer.data());
+}
+
+template <typename T>
+T *
+Elements(std::vector<char> & buffer)
+{
+  return reinterpret_cast<T *>(buffer.data());
+}
+
+// A grid of triangles in the z = 0 plane. The point data and cell data are
+// the ids of the points and cells.
+struct Mesh
+{
+  std::vector<char> points;
+  std::vector<char> cells;
+  std::vector<char> pointData;
+  std::vector<char> cellData;
+};
+
+Mesh
+Grid()
+{
+  Mesh mesh;
+  mesh.points.resize(NumberOfPoints * 3 * sizeof(float));
+  mesh.pointData.resize(NumberOfPoints * sizeof(uint32_t));
+  for (uint32_t yy = 0; yy < GridSize; ++yy)
+  {
+    for (uint32_t xx = 0; xx < GridSize; ++xx)
+    {
+      const uint32_t point = yy * GridSize + xx;
+      float * coordinates = Elements<float>(mesh.points) + 3 * point;
+      coordinates[0] = static_cast<float>(xx);
+      coordinates[1] = static_cast<float>(yy);
+      coordinates[2] = 0.0f;
+      Elements<uint32_t>(mesh.pointData)[point] = point;
+    }
+  }
+  mesh.cells.resize(NumberOfCells * 5 * sizeof(uint32_t));
+  mesh.cellData.resize(NumberOfCells * sizeof(uint32_t));
+  uint32_t cell = 0;
+  for (uint32_t yy = 0; yy + 1 < GridSize; ++yy)
+  {
+    for (uint32_t xx = 0; xx + 1 < GridSize; ++xx)
+    {
+      const uint32_t corner = yy * GridSize + xx;
+      const uint32_t triangles[2][3] = { { corner, corner + 1, corner + GridSize },
+                                         { corner + 1, corner + GridSize + 1, corner + GridSize } };
+      for (const auto & triangle : triangles)
+      {
+        uint32_t * entry = Elements<uint32_t>(mesh.cells) + 5 * cell;
+        entry[0] = TriangleCell;
+        entry[1] = 3;
+        std::memcpy(entry + 2, triangle, sizeof(triangle));
+        Elements<uint32_t>(mesh.cellData)[cell] = cell;
+        ++cell;
+      }
+    }
+  }
+  return mesh;
+}
+
+// The cells of a full resolution chunk are cells of the grid, whose points
+// are in the bounds of the chunk
+bool
+DescribesGrid(const itk::wasm::MeshChunk & chunk, const Mesh & mesh)
+{
+  const uint32_t * cells = Elements<uint32_t>(chunk.cells);
+  const uint32_t * pointData = Elements<uint32_t>(chunk.pointData);
+  const float *    points = Elements<float>(chunk.points);
+  for (uint64_t ii = 0; ii < chunk.numberOfCells; ++ii)
+  {
+    const uint32_t gridCell = Elements<uint32_t>(chunk.cellData)[ii];
+    for (uint32_t jj = 0; jj < 3; ++jj)
+    {
+      const uint32_t point = cells[5 * ii + 2 + jj];
+      if (pointData[point] != Elements<uint32_t>(mesh.cells)[5 * gridCell + 2 + jj] ||
+          std::memcmp(points + 3 * point, Elements<float>(mesh.points) + 3 * pointData[point], 3 * sizeof(float)) != 0)
+      {
+        std::cerr << "Cell " << ii << " of chunk " << chunk.name << " does not match its cell data" << std::endl;
+        return false;
+      }
+      for (unsigned int dd = 0; dd < 3; ++dd)
+      {
+        if (points[3 * point + dd] < chunk.bounds[dd] || points[3 * point + dd] > chunk.bounds[3 + dd])
+        {
+          std::cerr << "Point " << point << " of chunk " << chunk.name << " is out of its bounds" << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+} // end anonymous namespace
+
+int
+itkWasmMeshChunksTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters" << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputBundleFile" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string bundleFile = argv[1];
+
+  auto meshIO = itk::WasmMeshIO::New();
+  meshIO->SetPointDimension(3);
+  meshIO->SetPointComponentType(itk::IOComponentEnum::FLOAT);
+  meshIO->SetNumberOfPoints(NumberOfPoints);
+  meshIO->SetPointPixelComponentType(itk::IOComponentEnum::UINT);
+  meshIO->SetNumberOfPointPixelComponents(1);
+  meshIO->SetNumberOfPointPixels(NumberOfPoints);
+  meshIO->SetCellComponentType(itk::IOComponentEnum::UINT);
+  meshIO->SetNumberOfCells(NumberOfCells);
+  meshIO->SetCellBufferSize(NumberOfCells * 5);
+  meshIO->SetCellPixelComponentType(itk::IOComponentEnum::UINT);
+  meshIO->SetNumberOfCellPixelComponents(1);
+  meshIO->SetNumberOfCellPixels(NumberOfCells);
+
+  const Mesh mesh = Grid();
+  std::vector<itk::wasm::MeshChunk> chunks;
+  ITK_TRY_EXPECT_NO_EXCEPTION(chunks = itk::wasm::PartitionMesh(meshIO, mesh.points, mesh.cells, mesh.pointData, mesh.cellData, MaximumPointsPerChunk, 2));
+
+  // Each cell is in one chunk of the full resolution
+  std::set<uint32_t> cells;
+  uint64_t           fullResolutionCells = 0;
+  size_t             fullResolutionChunks = 0;
+  uint64_t           coarsePoints[3] = { 0, 0, 0 };
+  for (const itk::wasm::MeshChunk & chunk : chunks)
+  {
+    ITK_TEST_EXPECT_TRUE(chunk.level <= 2);
+    ITK_TEST_EXPECT_TRUE(chunk.numberOfPoints <= MaximumPointsPerChunk);
+    coarsePoints[chunk.level] += chunk.numberOfPoints;
+    if (chunk.level == 0)
+    {
+      ITK_TEST_EXPECT_TRUE(DescribesGrid(chunk, mesh));
+      fullResolutionCells += chunk.numberOfCells;
+      ++fullResolutionChunks;
+      cells.insert(Elements<uint32_t>(chunk.cellData), Elements<uint32_t>(chunk.cellData) + chunk.numberOfCells);
+    }
+  }
+  ITK_TEST_EXPECT_EQUAL(fullResolutionCells, NumberOfCells);
+  ITK_TEST_EXPECT_EQUAL(cells.size(), NumberOfCells);
+  ITK_TEST_EXPECT_TRUE(chunks.size() > 1);
+  // The coarse levels have fewer points
+  std::cout << "Points by level: " << coarsePoints[0] << " " << coarsePoints[1] << " " << coarsePoints[2] << std::endl;
+  ITK_TEST_EXPECT_TRUE(coarsePoints[1] < coarsePoints[0] / 2);
+  ITK_TEST_EXPECT_TRUE(coarsePoints[2] > 0 && coarsePoints[2] < coarsePoints[1] / 2);
+
+  // The chunks are the members of a .iwm.bundle file
+  bool append = false;
+  for (const itk::wasm::MeshChunk & chunk : chunks)
+  {
+    auto chunkIO = itk::WasmMeshIO::New();
+    chunkIO->SetFileName(bundleFile);
+    chunkIO->SetAppendToBundle(append);
+    append = true;
+    ITK_TRY_EXPECT_NO_EXCEPTION(itk::wasm::WriteMeshChunk(meshIO, chunk, chunkIO));
+  }
+
+  itk::wasm::BundleTableOfContents tableOfContents;
+  auto                             reader = itk::wasm::RangeReader::Open(bundleFile);
+  ITK_TEST_EXPECT_TRUE(reader && itk::wasm::ReadBundleTableOfContents(*reader, tableOfContents));
+  ITK_TEST_EXPECT_EQUAL(tableOfContents.members.size(), chunks.size());
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::GetNumberOfMeshChunkLevels(tableOfContents), 3);
+
+  // The chunk of the full resolution at the corner of the grid
+  const std::vector<const itk::wasm::BundleMember *> selected =
+    itk::wasm::SelectMeshChunks(tableOfContents, 0, { 0.0, 0.0, 0.0, 2.0, 2.0, 0.0 });
+  ITK_TEST_EXPECT_EQUAL(selected.size(), 1);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::SelectMeshChunks(tableOfContents, 0, {}).size(), fullResolutionChunks);
+  const itk::wasm::MeshChunk * corner = nullptr;
+  for (const itk::wasm::MeshChunk & chunk : chunks)
+  {
+    if (chunk.name == selected.front()->name)
+    {
+      corner = &chunk;
+    }
+  }
+  ITK_TEST_EXPECT_TRUE(corner != nullptr && corner->bounds == selected.front()->bounds);
+
+  auto memberIO = itk::WasmMeshIO::New();
+  memberIO->SetFileName(bundleFile);
+  memberIO->SetBundleMemberName(selected.front()->name);
+  ITK_TRY_EXPECT_NO_EXCEPTION(memberIO->ReadMeshInformation());
+  ITK_TEST_EXPECT_EQUAL(memberIO->GetNumberOfPoints(), corner->numberOfPoints);
+  ITK_TEST_EXPECT_EQUAL(memberIO->GetNumberOfCells(), corner->numberOfCells);
+  std::vector<char> points(corner->points.size());
+  ITK_TRY_EXPECT_NO_EXCEPTION(memberIO->ReadPoints(points.data()));
+  ITK_TEST_EXPECT_TRUE(points == corner->points);
+
+  // Point ids past the points
+  Mesh malformed = Grid();
+  Elements<uint32_t>(malformed.cells)[2] = NumberOfPoints;
+  ITK_TRY_EXPECT_EXCEPTION(itk::wasm::PartitionMesh(meshIO, malformed.points, malformed.cells, malformed.pointData, malformed.cellData, MaximumPointsPerChunk, 0));
+
+  return EXIT_SUCCESS;
+}
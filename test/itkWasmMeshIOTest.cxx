@@ -22,6 +22,9 @@
 #include "itkTestingMacros.h"
 #include "itkMesh.h"
 
+#include <algorithm>
+#include <cmath>
+
 int
 itkWasmMeshIOTest(int argc, char * argv[])
 {
@@ -80,5 +83,79 @@ itkWasmMeshIOTest(int argc, char * argv[])
   meshWriter->SetFileName(convertedZipFile);
   ITK_TRY_EXPECT_NO_EXCEPTION(meshWriter->Update());
 
+  // Quantized points are restored within half a step of their bounding box
+  meshIO->SetQuantizationBits(16);
+  wasmWriter->SetMeshIO(meshIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(wasmWriter->Update());
+  ITK_TRY_EXPECT_NO_EXCEPTION(wasmReader->Update());
+  const MeshType * quantizedMesh = wasmReader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(quantizedMesh->GetNumberOfPoints(), inputMesh->GetNumberOfPoints());
+  ITK_TEST_EXPECT_EQUAL(quantizedMesh->GetNumberOfCells(), inputMesh->GetNumberOfCells());
+  const auto bounds = inputMesh->GetBoundingBox()->GetBounds();
+  double tolerance = 0.0;
+  for (unsigned int dimension = 0; dimension < Dimension; ++dimension)
+  {
+    tolerance = std::max(tolerance, (bounds[2 * dimension + 1] - bounds[2 * dimension]) / 65535.0);
+  }
+  for (itk::IdentifierType pointId = 0; pointId < inputMesh->GetNumberOfPoints(); ++pointId)
+  {
+    const MeshType::PointType point = inputMesh->GetPoint(pointId);
+    const MeshType::PointType quantizedPoint = quantizedMesh->GetPoint(pointId);
+    for (unsigned int dimension = 0; dimension < Dimension; ++dimension)
+    {
+      if (std::abs(point[dimension] - quantizedPoint[dimension]) > tolerance)
+      {
+        std::cerr << "Quantized point " << pointId << " is " << quantizedPoint << " instead of " << point << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  meshIO->SetQuantizationMaximumError(tolerance / 1000.0);
+  ITK_TRY_EXPECT_EXCEPTION(wasmWriter->Update());
+
+  // Aligned .iwm.bin file, whose typed arrays are stored as is
+  const std::string zip = meshZip;
+  const std::string alignedFile = zip.substr(0, zip.size() - 9) + "Aligned.iwm.bin";
+  auto alignedWriter = WriterType::New();
+  alignedWriter->SetInput(inputMesh);
+  alignedWriter->SetFileName(alignedFile);
+  ITK_TRY_EXPECT_NO_EXCEPTION(alignedWriter->Update());
+  auto alignedReader = ReaderType::New();
+  alignedReader->SetFileName(alignedFile);
+  ITK_TRY_EXPECT_NO_EXCEPTION(alignedReader->Update());
+  const MeshType * alignedMesh = alignedReader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(alignedMesh->GetNumberOfPoints(), inputMesh->GetNumberOfPoints());
+  ITK_TEST_EXPECT_EQUAL(alignedMesh->GetNumberOfCells(), inputMesh->GetNumberOfCells());
+  for (itk::IdentifierType pointId = 0; pointId < inputMesh->GetNumberOfPoints(); ++pointId)
+  {
+    if (alignedMesh->GetPoint(pointId) != inputMesh->GetPoint(pointId))
+    {
+      std::cerr << "Aligned point " << pointId << " is " << alignedMesh->GetPoint(pointId) << " instead of " << inputMesh->GetPoint(pointId) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // .iwm.bundle file with two members, named by their index
+  const std::string bundleFile = zip.substr(0, zip.size() - 9) + "Bundle.iwm.bundle";
+  auto bundleIO = itk::WasmMeshIO::New();
+  bundleIO->AppendToBundleOff();
+  auto bundleWriter = WriterType::New();
+  bundleWriter->SetMeshIO(bundleIO);
+  bundleWriter->SetInput(inputMesh);
+  bundleWriter->SetFileName(bundleFile);
+  ITK_TRY_EXPECT_NO_EXCEPTION(bundleWriter->Update());
+  bundleIO->AppendToBundleOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(bundleWriter->Update());
+  auto bundleReadIO = itk::WasmMeshIO::New();
+  bundleReadIO->SetBundleMemberName("1");
+  auto bundleReader = ReaderType::New();
+  bundleReader->SetMeshIO(bundleReadIO);
+  bundleReader->SetFileName(bundleFile);
+  ITK_TRY_EXPECT_NO_EXCEPTION(bundleReader->Update());
+  ITK_TEST_EXPECT_EQUAL(bundleReadIO->GetBundleMemberNames().size(), 2);
+  ITK_TEST_EXPECT_EQUAL(bundleReader->GetOutput()->GetNumberOfPoints(), inputMesh->GetNumberOfPoints());
+  ITK_TEST_EXPECT_EQUAL(bundleReader->GetOutput()->GetNumberOfCells(), inputMesh->GetNumberOfCells());
+
   return EXIT_SUCCESS;
 }
@@ -22,6 +22,38 @@
 #include "itkMeshFileReader.h"
 #include "itkMeshFileWriter.h"
 #include "itkTestingMacros.h"
+#include "itkTetrahedronCell.h"
+
+#include <algorithm>
+
+namespace
+{
+
+template <typename TMesh>
+bool
+SameCells(const TMesh * expected, const TMesh * actual)
+{
+  if (expected->GetNumberOfCells() != actual->GetNumberOfCells())
+  {
+    std::cerr << "Expected " << expected->GetNumberOfCells() << " cells, got " << actual->GetNumberOfCells() << std::endl;
+    return false;
+  }
+  auto actualIt = actual->GetCells()->Begin();
+  for (auto expectedIt = expected->GetCells()->Begin(); expectedIt != expected->GetCells()->End(); ++expectedIt, ++actualIt)
+  {
+    const auto * expectedCell = expectedIt.Value();
+    const auto * actualCell = actualIt.Value();
+    if (expectedCell->GetNumberOfPoints() != actualCell->GetNumberOfPoints() ||
+        !std::equal(expectedCell->PointIdsBegin(), expectedCell->PointIdsEnd(), actualCell->PointIdsBegin()))
+    {
+      std::cerr << "Cell " << expectedIt.Index() << " differs" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end anonymous namespace
 
 int
 itkWasmMeshInterfaceTest(int argc, char * argv[])
@@ -61,6 +93,34 @@ itkWasmMeshInterfaceTest(int argc, char * argv[])
   ITK_TRY_EXPECT_NO_EXCEPTION(jsonToMeshFilter->Update());
   MeshType::Pointer convertedMesh = jsonToMeshFilter->GetOutput();
   std::cout << "convertedMesh: " << convertedMesh << std::endl;
+  ITK_TEST_EXPECT_TRUE(SameCells<MeshType>(inputMesh, convertedMesh));
+
+  // A single cell type takes the fixed stride path
+  auto tetrahedra = MeshType::New();
+  for (unsigned int ii = 0; ii < 5; ++ii)
+  {
+    MeshType::PointType point;
+    point.Fill(static_cast<double>(ii));
+    point[0] = static_cast<double>(ii % 2);
+    tetrahedra->SetPoint(ii, point);
+  }
+  for (unsigned int ii = 0; ii < 2; ++ii)
+  {
+    MeshType::CellAutoPointer cell;
+    cell.TakeOwnership(new itk::TetrahedronCell<MeshType::CellType>);
+    for (unsigned int jj = 0; jj < 4; ++jj)
+    {
+      cell->SetPointId(jj, ii + jj);
+    }
+    tetrahedra->SetCell(ii, cell);
+  }
+  meshToJSONFilter->SetInput(tetrahedra);
+  ITK_TRY_EXPECT_NO_EXCEPTION(meshToJSONFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(meshToJSONFilter->GetOutput()->GetCellBuffer()->Size(), 12);
+  auto tetrahedraFilter = WasmMeshToMeshFilterType::New();
+  tetrahedraFilter->SetInput(meshToJSONFilter->GetOutput());
+  ITK_TRY_EXPECT_NO_EXCEPTION(tetrahedraFilter->Update());
+  ITK_TEST_EXPECT_TRUE(SameCells<MeshType>(tetrahedra, tetrahedraFilter->GetOutput()));
 
   using WriterType = itk::MeshFileWriter<MeshType>;
   auto writer = WriterType::New();
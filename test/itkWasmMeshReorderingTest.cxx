@@ -0,0 +1,242 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkWasmMeshIO.h"
+#include "itkWasmMeshReordering.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr uint32_t GridSize = 40;
+constexpr uint32_t NumberOfPoints = GridSize * GridSize;
+constexpr uint32_t NumberOfCells = 2 * (GridSize - 1) * (GridSize - 1);
+constexpr uint32_t TriangleCell = 2;
+
+// A grid of triangles, with the points and cells in random order. The point
+// data and cell data are the ids of the points and cells in the grid order.
+struct Mesh
+{
+  std::vector<char> points;
+  std::vector<char> cells;
+  std::vector<char> pointData;
+  std::vector<char> cellData;
+};
+
+template <typename T>
+T *
+Elements(std::vector<char> & buffer)
+{
+  return reinterpret_cast<T *>(buffer.data());
+}
+
+Mesh
+ShuffledGrid(std::vector<float> & gridPoints, std::vector<uint32_t> & gridCells)
+{
+  std::mt19937 generator(1);
+  std::vector<uint32_t> pointOrder(NumberOfPoints);
+  for (uint32_t ii = 0; ii < NumberOfPoints; ++ii)
+  {
+    pointOrder[ii] = ii;
+  }
+  std::shuffle(pointOrder.begin(), pointOrder.end(), generator);
+  std::vector<uint32_t> shuffledIds(NumberOfPoints);
+  for (uint32_t ii = 0; ii < NumberOfPoints; ++ii)
+  {
+    shuffledIds[pointOrder[ii]] = ii;
+  }
+
+  gridPoints.clear();
+  for (uint32_t yy = 0; yy < GridSize; ++yy)
+  {
+    for (uint32_t xx = 0; xx < GridSize; ++xx)
+    {
+      gridPoints.insert(gridPoints.end(), { static_cast<float>(xx), static_cast<float>(yy), 0.0f });
+    }
+  }
+  gridCells.clear();
+  for (uint32_t yy = 0; yy + 1 < GridSize; ++yy)
+  {
+    for (uint32_t xx = 0; xx + 1 < GridSize; ++xx)
+    {
+      const uint32_t corner = yy * GridSize + xx;
+      gridCells.insert(gridCells.end(), { corner, corner + 1, corner + GridSize });
+      gridCells.insert(gridCells.end(), { corner + 1, corner + GridSize + 1, corner + GridSize });
+    }
+  }
+  std::vector<uint32_t> cellOrder(NumberOfCells);
+  for (uint32_t ii = 0; ii < NumberOfCells; ++ii)
+  {
+    cellOrder[ii] = ii;
+  }
+  std::shuffle(cellOrder.begin(), cellOrder.end(), generator);
+
+  Mesh mesh;
+  mesh.points.resize(NumberOfPoints * 3 * sizeof(float));
+  mesh.pointData.resize(NumberOfPoints * sizeof(uint32_t));
+  for (uint32_t ii = 0; ii < NumberOfPoints; ++ii)
+  {
+    std::memcpy(Elements<float>(mesh.points) + 3 * ii, gridPoints.data() + 3 * pointOrder[ii], 3 * sizeof(float));
+    Elements<uint32_t>(mesh.pointData)[ii] = pointOrder[ii];
+  }
+  mesh.cells.resize(NumberOfCells * 5 * sizeof(uint32_t));
+  mesh.cellData.resize(NumberOfCells * sizeof(uint32_t));
+  for (uint32_t ii = 0; ii < NumberOfCells; ++ii)
+  {
+    uint32_t * cell = Elements<uint32_t>(mesh.cells) + 5 * ii;
+    cell[0] = TriangleCell;
+    cell[1] = 3;
+    for (uint32_t jj = 0; jj < 3; ++jj)
+    {
+      cell[2 + jj] = shuffledIds[gridCells[3 * cellOrder[ii] + jj]];
+    }
+    Elements<uint32_t>(mesh.cellData)[ii] = cellOrder[ii];
+  }
+  return mesh;
+}
+
+// The points, cells, and their data still describe the grid
+bool
+DescribesGrid(Mesh & mesh, const std::vector<float> & gridPoints, const std::vector<uint32_t> & gridCells)
+{
+  const uint32_t * pointData = Elements<uint32_t>(mesh.pointData);
+  for (uint32_t ii = 0; ii < NumberOfPoints; ++ii)
+  {
+    if (std::memcmp(Elements<float>(mesh.points) + 3 * ii, gridPoints.data() + 3 * pointData[ii], 3 * sizeof(float)) != 0)
+    {
+      std::cerr << "Point " << ii << " does not match its point data" << std::endl;
+      return false;
+    }
+  }
+  std::vector<uint32_t> cellIds(Elements<uint32_t>(mesh.cellData), Elements<uint32_t>(mesh.cellData) + NumberOfCells);
+  std::sort(cellIds.begin(), cellIds.end());
+  for (uint32_t ii = 0; ii < NumberOfCells; ++ii)
+  {
+    const uint32_t * cell = Elements<uint32_t>(mesh.cells) + 5 * ii;
+    const uint32_t gridCell = Elements<uint32_t>(mesh.cellData)[ii];
+    if (cellIds[ii] != ii || cell[0] != TriangleCell || cell[1] != 3)
+    {
+      std::cerr << "Cell " << ii << " is not a cell of the grid" << std::endl;
+      return false;
+    }
+    for (uint32_t jj = 0; jj < 3; ++jj)
+    {
+      if (pointData[cell[2 + jj]] != gridCells[3 * gridCell + jj])
+      {
+        std::cerr << "Cell " << ii << " does not match its cell data" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Average number of misses of a FIFO cache of 16 points per cell
+double
+CacheMissRatio(Mesh & mesh)
+{
+  std::vector<uint32_t> cache;
+  uint64_t misses = 0;
+  for (uint32_t ii = 0; ii < NumberOfCells; ++ii)
+  {
+    const uint32_t * cell = Elements<uint32_t>(mesh.cells) + 5 * ii;
+    for (uint32_t jj = 0; jj < 3; ++jj)
+    {
+      if (std::find(cache.begin(), cache.end(), cell[2 + jj]) == cache.end())
+      {
+        ++misses;
+        cache.push_back(cell[2 + jj]);
+        if (cache.size() > 16)
+        {
+          cache.erase(cache.begin());
+        }
+      }
+    }
+  }
+  return static_cast<double>(misses) / NumberOfCells;
+}
+
+} // end anonymous namespace
+
+int
+itkWasmMeshReorderingTest(int, char *[])
+{
+  auto meshIO = itk::WasmMeshIO::New();
+  meshIO->SetPointDimension(3);
+  meshIO->SetPointComponentType(itk::IOComponentEnum::FLOAT);
+  meshIO->SetNumberOfPoints(NumberOfPoints);
+  meshIO->SetPointPixelComponentType(itk::IOComponentEnum::UINT);
+  meshIO->SetNumberOfPointPixelComponents(1);
+  meshIO->SetNumberOfPointPixels(NumberOfPoints);
+  meshIO->SetCellComponentType(itk::IOComponentEnum::UINT);
+  meshIO->SetNumberOfCells(NumberOfCells);
+  meshIO->SetCellBufferSize(NumberOfCells * 5);
+  meshIO->SetCellPixelComponentType(itk::IOComponentEnum::UINT);
+  meshIO->SetNumberOfCellPixelComponents(1);
+  meshIO->SetNumberOfCellPixels(NumberOfCells);
+
+  std::vector<float> gridPoints;
+  std::vector<uint32_t> gridCells;
+
+  Mesh mesh = ShuffledGrid(gridPoints, gridCells);
+  const double shuffledMissRatio = CacheMissRatio(mesh);
+  itk::wasm::ReorderMesh(meshIO, true, itk::wasm::MeshPointOrder::FirstUse, mesh.points, mesh.cells, mesh.pointData, mesh.cellData);
+  ITK_TEST_EXPECT_TRUE(DescribesGrid(mesh, gridPoints, gridCells));
+  const double optimizedMissRatio = CacheMissRatio(mesh);
+  std::cout << "Cache miss ratio: " << shuffledMissRatio << " shuffled, " << optimizedMissRatio << " optimized" << std::endl;
+  ITK_TEST_EXPECT_TRUE(optimizedMissRatio < 0.75 * shuffledMissRatio);
+  // The points are numbered in the order the cells first use them
+  uint32_t nextPoint = 0;
+  for (uint32_t ii = 0; ii < NumberOfCells; ++ii)
+  {
+    for (uint32_t jj = 0; jj < 3; ++jj)
+    {
+      const uint32_t point = Elements<uint32_t>(mesh.cells)[5 * ii + 2 + jj];
+      ITK_TEST_EXPECT_TRUE(point <= nextPoint);
+      nextPoint = std::max(nextPoint, point + 1);
+    }
+  }
+
+  mesh = ShuffledGrid(gridPoints, gridCells);
+  itk::wasm::ReorderMesh(meshIO, false, itk::wasm::MeshPointOrder::Morton, mesh.points, mesh.cells, mesh.pointData, mesh.cellData);
+  ITK_TEST_EXPECT_TRUE(DescribesGrid(mesh, gridPoints, gridCells));
+  // The first quadrant of the grid precedes the others
+  const float * firstPoint = Elements<float>(mesh.points);
+  ITK_TEST_EXPECT_TRUE(firstPoint[0] == 0.0f && firstPoint[1] == 0.0f);
+  for (uint32_t ii = 0; ii < NumberOfPoints / 4; ++ii)
+  {
+    const float * point = Elements<float>(mesh.points) + 3 * ii;
+    ITK_TEST_EXPECT_TRUE(point[0] < GridSize / 2 && point[1] < GridSize / 2);
+  }
+
+  ITK_TEST_EXPECT_TRUE(itk::wasm::MeshPointOrderFromString("first-use") == itk::wasm::MeshPointOrder::FirstUse);
+  ITK_TRY_EXPECT_EXCEPTION(itk::wasm::MeshPointOrderFromString("hilbert"));
+
+  // Point ids past the points
+  mesh = ShuffledGrid(gridPoints, gridCells);
+  Elements<uint32_t>(mesh.cells)[2] = NumberOfPoints;
+  ITK_TRY_EXPECT_EXCEPTION(itk::wasm::ReorderMesh(meshIO, true, itk::wasm::MeshPointOrder::Input, mesh.points, mesh.cells, mesh.pointData, mesh.cellData));
+
+  return EXIT_SUCCESS;
+}
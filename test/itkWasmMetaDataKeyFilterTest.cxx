@@ -0,0 +1,92 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkWasmMetaDataKeyFilter.h"
+#include "itkMetaDataDictionaryCBOR.h"
+#include "itkMetaDataDictionaryJSON.h"
+
+#include <string>
+
+int
+itkWasmMetaDataKeyFilterTest(int, char *[])
+{
+  using itk::wasm::MetaDataKeyFilter;
+
+  ITK_TEST_EXPECT_TRUE(MetaDataKeyFilter::Matches("0010|*", "0010|0020"));
+  ITK_TEST_EXPECT_TRUE(!MetaDataKeyFilter::Matches("0010|*", "0008|0020"));
+  ITK_TEST_EXPECT_TRUE(MetaDataKeyFilter::Matches("*|0020", "0010|0020"));
+  ITK_TEST_EXPECT_TRUE(MetaDataKeyFilter::Matches("00?0|*2*", "0010|0020"));
+  ITK_TEST_EXPECT_TRUE(MetaDataKeyFilter::Matches("*", ""));
+  ITK_TEST_EXPECT_TRUE(MetaDataKeyFilter::Matches("a**b", "ab"));
+  ITK_TEST_EXPECT_TRUE(!MetaDataKeyFilter::Matches("a*b", "abc"));
+  ITK_TEST_EXPECT_TRUE(!MetaDataKeyFilter::Matches("", "a"));
+
+  MetaDataKeyFilter keyFilter;
+  ITK_TEST_EXPECT_TRUE(!keyFilter.IsEnabled());
+  ITK_TEST_EXPECT_TRUE(keyFilter.Accepts("any"));
+  keyFilter.SetIncludePatterns({ "0010|*", "origin" });
+  keyFilter.SetExcludePatterns({ "0010|0010" });
+  ITK_TEST_EXPECT_TRUE(keyFilter.IsEnabled());
+  ITK_TEST_EXPECT_TRUE(keyFilter.Accepts("0010|0020"));
+  ITK_TEST_EXPECT_TRUE(keyFilter.Accepts("origin"));
+  ITK_TEST_EXPECT_TRUE(!keyFilter.Accepts("0010|0010"));
+  ITK_TEST_EXPECT_TRUE(!keyFilter.Accepts("0008|0020"));
+
+  itk::MetaDataDictionary dictionary;
+  itk::EncapsulateMetaData<std::string>(dictionary, "0010|0010", "name");
+  itk::EncapsulateMetaData<std::string>(dictionary, "0010|0020", "id");
+  itk::EncapsulateMetaData<std::string>(dictionary, "0008|0020", "date");
+  itk::EncapsulateMetaData<double>(dictionary, "origin", 1.5);
+
+  rapidjson::Document document;
+  rapidjson::Value metadataJson(rapidjson::kArrayType);
+  itk::wasm::ConvertMetaDataDictionaryToJSON(dictionary, metadataJson, document.GetAllocator(), keyFilter);
+  ITK_TEST_EXPECT_EQUAL(metadataJson.Size(), 2u);
+
+  itk::MetaDataDictionary fromJSON;
+  itk::wasm::ConvertJSONToMetaDataDictionary(metadataJson, fromJSON);
+  ITK_TEST_EXPECT_TRUE(fromJSON.HasKey("0010|0020"));
+  ITK_TEST_EXPECT_TRUE(fromJSON.HasKey("origin"));
+
+  MetaDataKeyFilter excludeOrigin;
+  excludeOrigin.SetExcludePatterns({ "origin" });
+  itk::MetaDataDictionary excludedFromJSON;
+  itk::wasm::ConvertJSONToMetaDataDictionary(metadataJson, excludedFromJSON, excludeOrigin);
+  ITK_TEST_EXPECT_TRUE(excludedFromJSON.HasKey("0010|0020"));
+  ITK_TEST_EXPECT_TRUE(!excludedFromJSON.HasKey("origin"));
+
+  std::string encoded;
+  itk::wasm::MemoryCBORSink sink(encoded);
+  itk::wasm::WriteCBORMetaDataDictionary(sink, dictionary, keyFilter);
+  ITK_TEST_EXPECT_TRUE(sink.Finish());
+  itk::MetaDataDictionary fromCBOR;
+  ITK_TEST_EXPECT_TRUE(itk::wasm::ReadCBORMetaDataDictionary(
+    reinterpret_cast<const unsigned char *>(encoded.data()), encoded.size(), fromCBOR, excludeOrigin));
+  ITK_TEST_EXPECT_TRUE(fromCBOR.HasKey("0010|0020"));
+  ITK_TEST_EXPECT_TRUE(!fromCBOR.HasKey("0010|0010"));
+  ITK_TEST_EXPECT_TRUE(!fromCBOR.HasKey("0008|0020"));
+  ITK_TEST_EXPECT_TRUE(!fromCBOR.HasKey("origin"));
+
+  keyFilter.Apply(dictionary);
+  ITK_TEST_EXPECT_TRUE(dictionary.HasKey("0010|0020"));
+  ITK_TEST_EXPECT_TRUE(dictionary.HasKey("origin"));
+  ITK_TEST_EXPECT_TRUE(!dictionary.HasKey("0010|0010"));
+  ITK_TEST_EXPECT_TRUE(!dictionary.HasKey("0008|0020"));
+
+  return EXIT_SUCCESS;
+}
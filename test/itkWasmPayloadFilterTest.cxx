@@ -0,0 +1,153 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkWasmPayloadFilter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+int
+itkWasmPayloadFilterTest(int argc, char * argv[])
+{
+  // Rows of 37 three-component int16 pixels, in blocks that split rows and
+  // are not a multiple of 8 elements
+  itk::wasm::PayloadLayout layout;
+  layout.componentSize = sizeof(int16_t);
+  layout.components = 3;
+  layout.rowLength = 37 * layout.components;
+  const size_t numberOfComponents = layout.rowLength * 29;
+  std::vector< int16_t > payload(numberOfComponents);
+  for (size_t ii = 0; ii < numberOfComponents; ++ii)
+  {
+    payload[ii] = static_cast< int16_t >( ( ii * 7919 ) % 4096 - 2048 );
+  }
+  const size_t size = numberOfComponents * sizeof(int16_t);
+
+  const itk::wasm::PayloadShuffle shuffles[] = { itk::wasm::PayloadShuffle::None, itk::wasm::PayloadShuffle::Byte, itk::wasm::PayloadShuffle::Bit };
+  for (const bool delta : { false, true })
+  {
+    for (const itk::wasm::PayloadShuffle shuffle : shuffles)
+    {
+      itk::wasm::PayloadFilters filters;
+      filters.delta = delta;
+      filters.shuffle = shuffle;
+      filters.blockSize = 1000;
+      ITK_TRY_EXPECT_NO_EXCEPTION(itk::wasm::ValidatePayloadFilters(filters, layout));
+
+      std::vector< int16_t > encoded(numberOfComponents);
+      std::vector< unsigned char > scratch;
+      for (uint64_t offset = 0; offset < size; offset += filters.blockSize)
+      {
+        const size_t blockSize = std::min< uint64_t >(filters.blockSize, size - offset);
+        itk::wasm::EncodePayloadBlock(filters, layout, payload.data(), offset, blockSize, reinterpret_cast< unsigned char * >( encoded.data() ) + offset, scratch);
+      }
+      ITK_TEST_EXPECT_EQUAL(filters.IsEnabled(), encoded != payload);
+
+      itk::wasm::DecodePayload(filters, layout, encoded.data(), size);
+      ITK_TEST_EXPECT_TRUE(encoded == payload);
+    }
+  }
+
+  // The byte shuffle groups the low bytes before the high bytes
+  const uint16_t pair[] = { 0x0102, 0x0304 };
+  unsigned char shuffled[4];
+  std::vector< unsigned char > scratch;
+  itk::wasm::PayloadLayout pairLayout;
+  pairLayout.componentSize = sizeof(uint16_t);
+  pairLayout.rowLength = 2;
+  itk::wasm::EncodePayloadBlock(itk::wasm::AutomaticPayloadFilters(sizeof(uint16_t)), pairLayout, pair, 0, sizeof(pair), shuffled, scratch);
+  ITK_TEST_EXPECT_EQUAL(shuffled[0], 0x02);
+  ITK_TEST_EXPECT_EQUAL(shuffled[1], 0x04);
+  ITK_TEST_EXPECT_EQUAL(shuffled[2], 0x01);
+  ITK_TEST_EXPECT_EQUAL(shuffled[3], 0x03);
+
+  ITK_TEST_EXPECT_TRUE(!itk::wasm::AutomaticPayloadFilters(1).IsEnabled());
+
+  itk::wasm::PayloadFilters misaligned;
+  misaligned.shuffle = itk::wasm::PayloadShuffle::Byte;
+  misaligned.blockSize = 3;
+  ITK_TRY_EXPECT_EXCEPTION(itk::wasm::ValidatePayloadFilters(misaligned, layout));
+
+  // Runs of a mostly background label map of two-component uint8 pixels,
+  // decoded in pieces that split runs
+  itk::wasm::PayloadLayout labelLayout;
+  labelLayout.componentSize = sizeof(uint8_t);
+  labelLayout.components = 2;
+  labelLayout.rowLength = 64 * labelLayout.components;
+  std::vector< uint8_t > labels(labelLayout.rowLength * 64);
+  std::fill(labels.begin() + 1000, labels.begin() + 1400, 7);
+  labels[3001] = 3;
+  itk::wasm::PayloadFilters runLength;
+  runLength.runLength = true;
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::wasm::ValidatePayloadFilters(runLength, labelLayout));
+  const uint64_t runsSize = itk::wasm::GetPayloadRunsSize(labelLayout, labels.data(), labels.size());
+  ITK_TEST_EXPECT_EQUAL(runsSize, 5 * ( 4 + labelLayout.components ));
+  std::string runs;
+  itk::wasm::MemoryCBORSink runsSink(runs);
+  itk::wasm::EncodePayloadRuns(runsSink, labelLayout, labels.data(), labels.size());
+  ITK_TEST_EXPECT_EQUAL(runs.size(), runsSize);
+  std::vector< uint8_t > decodedLabels(labels.size());
+  itk::wasm::PayloadRunDecoder decoder(labelLayout, decodedLabels.data(), decodedLabels.size());
+  for (size_t offset = 0; offset < runs.size(); offset += 4)
+  {
+    ITK_TEST_EXPECT_TRUE(decoder.Decode(runs.data() + offset, std::min< size_t >(4, runs.size() - offset)));
+  }
+  ITK_TEST_EXPECT_TRUE(decoder.IsComplete());
+  ITK_TEST_EXPECT_TRUE(decodedLabels == labels);
+
+  // Runs that overflow the payload are rejected
+  std::vector< uint8_t > shortLabels(labels.size() / 2);
+  itk::wasm::PayloadRunDecoder shortDecoder(labelLayout, shortLabels.data(), shortLabels.size());
+  ITK_TEST_EXPECT_TRUE(!shortDecoder.Decode(runs.data(), runs.size()));
+
+  itk::wasm::PayloadFilters combined = runLength;
+  combined.delta = true;
+  ITK_TRY_EXPECT_EXCEPTION(itk::wasm::ValidatePayloadFilters(combined, labelLayout));
+
+  // Codecs of 8 and 16 bit components, recorded in the payloadFilters entry
+  itk::wasm::PayloadFilters htj2k;
+  htj2k.codec = itk::wasm::PayloadCodec::HTJ2K;
+  ITK_TEST_EXPECT_TRUE(htj2k.IsEnabled());
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::wasm::ValidatePayloadFilters(htj2k, layout));
+  itk::wasm::PayloadLayout floatLayout = layout;
+  floatLayout.componentSize = sizeof(float);
+  ITK_TRY_EXPECT_EXCEPTION(itk::wasm::ValidatePayloadFilters(htj2k, floatLayout));
+  itk::wasm::PayloadFilters shuffledCodec = htj2k;
+  shuffledCodec.shuffle = itk::wasm::PayloadShuffle::Byte;
+  ITK_TRY_EXPECT_EXCEPTION(itk::wasm::ValidatePayloadFilters(shuffledCodec, layout));
+
+  for (const itk::wasm::PayloadCodec codec : { itk::wasm::PayloadCodec::HTJ2K, itk::wasm::PayloadCodec::JPEGXL })
+  {
+    itk::wasm::PayloadFilters written;
+    written.codec = codec;
+    std::string encodedFilters;
+    itk::wasm::MemoryCBORSink filtersSink(encodedFilters);
+    itk::wasm::WritePayloadFilters(filtersSink, written);
+    struct cbor_load_result result;
+    cbor_item_t * item = cbor_load(reinterpret_cast< const unsigned char * >( encodedFilters.data() ), encodedFilters.size(), &result);
+    ITK_TEST_EXPECT_EQUAL(result.error.code, CBOR_ERR_NONE);
+    const itk::wasm::PayloadFilters read = itk::wasm::ReadPayloadFilters(item);
+    cbor_decref(&item);
+    ITK_TEST_EXPECT_TRUE(read.codec == codec);
+    ITK_TEST_EXPECT_TRUE(!read.delta && read.shuffle == itk::wasm::PayloadShuffle::None && !read.runLength);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPointSetToWasmPointSetFilter.h"
+#include "itkWasmPointSetToPointSetFilter.h"
+
+#include "itkMesh.h"
+#include "itkPointSet.h"
+#include "itkMeshFileReader.h"
+#include "itkMeshFileWriter.h"
+#include "itkTestingMacros.h"
+
+int
+itkWasmPointSetInterfaceTest(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters" << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " InputMesh OutputMesh" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char * inputMeshFile = argv[1];
+  const char * outputMeshFile = argv[2];
+
+  constexpr unsigned int Dimension = 3;
+  using PixelType = float;
+  using PointSetType = itk::PointSet<PixelType, Dimension>;
+  using MeshType = itk::Mesh<PixelType, Dimension, PointSetType::MeshTraits>;
+
+  using ReaderType = itk::MeshFileReader<MeshType>;
+  auto reader = ReaderType::New();
+  reader->SetFileName(inputMeshFile);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  MeshType::Pointer inputMesh = reader->GetOutput();
+
+  auto inputPointSet = PointSetType::New();
+  inputPointSet->SetPoints(inputMesh->GetPoints());
+  inputPointSet->SetPointData(inputMesh->GetPointData());
+  std::cout << "inputPointSet: " << inputPointSet << std::endl;
+
+  using PointSetToWasmPointSetFilterType = itk::PointSetToWasmPointSetFilter<PointSetType>;
+  auto pointSetToWasmFilter = PointSetToWasmPointSetFilterType::New();
+  pointSetToWasmFilter->SetInput(inputPointSet);
+  ITK_TRY_EXPECT_NO_EXCEPTION(pointSetToWasmFilter->Update());
+  auto pointSetWasm = pointSetToWasmFilter->GetOutput();
+
+  std::cout << "PointSet JSON: " << pointSetWasm->GetJSON() << std::endl;
+
+  using WasmPointSetToPointSetFilterType = itk::WasmPointSetToPointSetFilter<PointSetType>;
+  auto wasmToPointSetFilter = WasmPointSetToPointSetFilterType::New();
+  wasmToPointSetFilter->SetInput(pointSetWasm);
+  ITK_TRY_EXPECT_NO_EXCEPTION(wasmToPointSetFilter->Update());
+  PointSetType::Pointer convertedPointSet = wasmToPointSetFilter->GetOutput();
+  std::cout << "convertedPointSet: " << convertedPointSet << std::endl;
+
+  ITK_TEST_EXPECT_EQUAL(convertedPointSet->GetNumberOfPoints(), inputPointSet->GetNumberOfPoints());
+  for (PointSetType::PointIdentifier pointId = 0; pointId < inputPointSet->GetNumberOfPoints(); ++pointId)
+  {
+    if (convertedPointSet->GetPoint(pointId) != inputPointSet->GetPoint(pointId))
+    {
+      std::cerr << "Point " << pointId << " differs" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  auto outputMesh = MeshType::New();
+  outputMesh->SetPoints(convertedPointSet->GetPoints());
+  outputMesh->SetPointData(convertedPointSet->GetPointData());
+
+  using WriterType = itk::MeshFileWriter<MeshType>;
+  auto writer = WriterType::New();
+  writer->SetFileName(outputMeshFile);
+  writer->SetInput(outputMesh);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  return EXIT_SUCCESS;
+}
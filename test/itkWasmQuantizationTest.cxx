@@ -0,0 +1,85 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkWasmQuantization.h"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+template <typename TValue>
+bool
+RoundTrips(unsigned int bits, double maximumError)
+{
+  // Three-component points over more than one dequantization chunk
+  const unsigned int components = 3;
+  const size_t numberOfValues = 3 * 20000;
+  std::vector<TValue> values(numberOfValues);
+  for (size_t ii = 0; ii < numberOfValues; ++ii)
+  {
+    values[ii] = static_cast<TValue>(std::sin(0.001 * ii) * (ii % components + 1) * 100.0);
+  }
+  // The last component is constant
+  for (size_t ii = components - 1; ii < numberOfValues; ii += components)
+  {
+    values[ii] = static_cast<TValue>(7.5);
+  }
+
+  const itk::wasm::Quantization quantization =
+    itk::wasm::ComputeQuantization(bits, sizeof(TValue), components, values.data(), numberOfValues);
+  if (itk::wasm::QuantizationError(quantization) > maximumError)
+  {
+    std::cerr << "Quantization error " << itk::wasm::QuantizationError(quantization) << " exceeds " << maximumError << std::endl;
+    return false;
+  }
+
+  // Restored in place, from the quantized components at the start of the buffer
+  std::vector<TValue> restored(numberOfValues);
+  itk::wasm::Quantize(quantization, sizeof(TValue), values.data(), numberOfValues, restored.data());
+  itk::wasm::Dequantize(quantization, sizeof(TValue), restored.data(), numberOfValues);
+  for (size_t ii = 0; ii < numberOfValues; ++ii)
+  {
+    if (std::abs(static_cast<double>(restored[ii]) - values[ii]) > maximumError)
+    {
+      std::cerr << "Value " << ii << " restored as " << restored[ii] << " instead of " << values[ii] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end anonymous namespace
+
+int
+itkWasmQuantizationTest(int, char *[])
+{
+  ITK_TEST_EXPECT_TRUE(RoundTrips<float>(16, 0.01));
+  ITK_TEST_EXPECT_TRUE(RoundTrips<float>(32, 1e-4));
+  ITK_TEST_EXPECT_TRUE(RoundTrips<double>(16, 0.01));
+  ITK_TEST_EXPECT_TRUE(RoundTrips<double>(32, 1e-6));
+
+  const float value = 1.0f;
+  ITK_TRY_EXPECT_EXCEPTION(itk::wasm::ComputeQuantization(8, sizeof(float), 1, &value, 1));
+  ITK_TRY_EXPECT_EXCEPTION(itk::wasm::ComputeQuantization(16, sizeof(int16_t), 1, &value, 1));
+
+  return EXIT_SUCCESS;
+}
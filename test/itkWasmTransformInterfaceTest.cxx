@@ -0,0 +1,101 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTransformToWasmTransformFilter.h"
+#include "itkWasmTransformToTransformFilter.h"
+
+#include "itkDisplacementFieldTransform.h"
+#include "itkVersorRigid3DTransform.h"
+#include "itkTestingMacros.h"
+
+int
+itkWasmTransformInterfaceTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 3;
+  using BaseTransformType = itk::Transform<double, Dimension, Dimension>;
+
+  using VersorTransformType = itk::VersorRigid3DTransform<double>;
+  auto versorTransform = VersorTransformType::New();
+  VersorTransformType::ParametersType versorParameters(versorTransform->GetNumberOfParameters());
+  versorParameters[0] = 0.1;
+  versorParameters[1] = 0.2;
+  versorParameters[2] = 0.05;
+  versorParameters[3] = 10.0;
+  versorParameters[4] = -5.0;
+  versorParameters[5] = 2.5;
+  versorTransform->SetParameters(versorParameters);
+  VersorTransformType::FixedParametersType versorCenter(Dimension);
+  versorCenter.Fill(4.0);
+  versorTransform->SetFixedParameters(versorCenter);
+
+  using TransformToWasmTransformFilterType = itk::TransformToWasmTransformFilter<BaseTransformType>;
+  auto transformToWasmFilter = TransformToWasmTransformFilterType::New();
+  transformToWasmFilter->SetInput(versorTransform);
+  ITK_TRY_EXPECT_NO_EXCEPTION(transformToWasmFilter->Update());
+  auto versorWasm = transformToWasmFilter->GetOutput();
+  std::cout << "Transform JSON: " << versorWasm->GetJSON() << std::endl;
+
+  using WasmTransformToTransformFilterType = itk::WasmTransformToTransformFilter<BaseTransformType>;
+  auto wasmToTransformFilter = WasmTransformToTransformFilterType::New();
+  wasmToTransformFilter->SetInput(versorWasm);
+  ITK_TRY_EXPECT_NO_EXCEPTION(wasmToTransformFilter->Update());
+  const BaseTransformType * convertedVersor = wasmToTransformFilter->GetOutput()->Get();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<const VersorTransformType *>(convertedVersor) != nullptr);
+  ITK_TEST_EXPECT_EQUAL(convertedVersor->GetParameters(), versorTransform->GetParameters());
+  ITK_TEST_EXPECT_EQUAL(convertedVersor->GetFixedParameters(), versorTransform->GetFixedParameters());
+
+  using DisplacementFieldTransformType = itk::DisplacementFieldTransform<double, Dimension>;
+  using DisplacementFieldType = DisplacementFieldTransformType::DisplacementFieldType;
+  auto displacementField = DisplacementFieldType::New();
+  DisplacementFieldType::SizeType size;
+  size[0] = 8;
+  size[1] = 6;
+  size[2] = 4;
+  displacementField->SetRegions(size);
+  DisplacementFieldType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = 1.0;
+  spacing[2] = 2.0;
+  displacementField->SetSpacing(spacing);
+  displacementField->Allocate();
+  DisplacementFieldType::PixelType displacement;
+  displacement[0] = 1.0;
+  displacement[1] = -2.0;
+  displacement[2] = 0.5;
+  displacementField->FillBuffer(displacement);
+  auto displacementFieldTransform = DisplacementFieldTransformType::New();
+  displacementFieldTransform->SetDisplacementField(displacementField);
+
+  transformToWasmFilter->SetInput(displacementFieldTransform);
+  ITK_TRY_EXPECT_NO_EXCEPTION(transformToWasmFilter->Update());
+  auto displacementFieldWasm = transformToWasmFilter->GetOutput();
+  std::cout << "Displacement field transform JSON: " << displacementFieldWasm->GetJSON() << std::endl;
+
+  wasmToTransformFilter->SetInput(displacementFieldWasm);
+  ITK_TRY_EXPECT_NO_EXCEPTION(wasmToTransformFilter->Update());
+  const auto * convertedDisplacementFieldTransform =
+    dynamic_cast<const DisplacementFieldTransformType *>(wasmToTransformFilter->GetOutput()->Get());
+  ITK_TEST_EXPECT_TRUE(convertedDisplacementFieldTransform != nullptr);
+  const DisplacementFieldType * convertedField = convertedDisplacementFieldTransform->GetDisplacementField();
+  ITK_TEST_EXPECT_EQUAL(convertedField->GetLargestPossibleRegion().GetSize(), size);
+  ITK_TEST_EXPECT_EQUAL(convertedField->GetSpacing(), spacing);
+  // The field pixel buffer is imported, not copied
+  ITK_TEST_EXPECT_EQUAL(static_cast<const void *>(convertedField->GetBufferPointer()),
+                        static_cast<const void *>(displacementField->GetBufferPointer()));
+
+  return EXIT_SUCCESS;
+}